@@ -298,6 +298,95 @@ static gchar* G_GNUC_UNUSED flpigeon_to_string(FlValue* value) {
   }
   return g_strdup("null");
 }
+static void G_GNUC_UNUSED flpigeon_write_uint8(GByteArray* buffer,
+                                               uint8_t value) {
+  g_byte_array_append(buffer, &value, sizeof(uint8_t));
+}
+static void G_GNUC_UNUSED flpigeon_write_alignment(GByteArray* buffer,
+                                                   size_t alignment) {
+  while (buffer->len % alignment != 0) {
+    flpigeon_write_uint8(buffer, 0);
+  }
+}
+static void G_GNUC_UNUSED flpigeon_write_null(GByteArray* buffer) {
+  flpigeon_write_uint8(buffer, 0);
+}
+static void G_GNUC_UNUSED flpigeon_write_bool(GByteArray* buffer,
+                                              gboolean value) {
+  flpigeon_write_uint8(buffer, value ? 1 : 2);
+}
+static void G_GNUC_UNUSED flpigeon_write_int(GByteArray* buffer,
+                                             int64_t value) {
+  if (value >= INT32_MIN && value <= INT32_MAX) {
+    int32_t value32 = static_cast<int32_t>(value);
+    flpigeon_write_uint8(buffer, 3);
+    g_byte_array_append(buffer, reinterpret_cast<uint8_t*>(&value32),
+                        sizeof(int32_t));
+  } else {
+    flpigeon_write_uint8(buffer, 4);
+    g_byte_array_append(buffer, reinterpret_cast<uint8_t*>(&value),
+                        sizeof(int64_t));
+  }
+}
+static void G_GNUC_UNUSED flpigeon_write_double(GByteArray* buffer,
+                                                double value) {
+  flpigeon_write_uint8(buffer, 6);
+  flpigeon_write_alignment(buffer, 8);
+  g_byte_array_append(buffer, reinterpret_cast<uint8_t*>(&value),
+                      sizeof(double));
+}
+static void G_GNUC_UNUSED flpigeon_write_string(FlStandardMessageCodec* codec,
+                                                GByteArray* buffer,
+                                                const gchar* value) {
+  size_t length = strlen(value);
+  flpigeon_write_uint8(buffer, 7);
+  fl_standard_message_codec_write_size(codec, buffer, length);
+  g_byte_array_append(buffer, reinterpret_cast<const uint8_t*>(value), length);
+}
+static void G_GNUC_UNUSED flpigeon_write_typed_list(
+    FlStandardMessageCodec* codec, GByteArray* buffer, uint8_t type,
+    const void* data, size_t length, size_t element_size) {
+  flpigeon_write_uint8(buffer, type);
+  fl_standard_message_codec_write_size(codec, buffer, length);
+  flpigeon_write_alignment(buffer, element_size);
+  g_byte_array_append(buffer, static_cast<const uint8_t*>(data),
+                      length * element_size);
+}
+static void G_GNUC_UNUSED
+flpigeon_write_uint8_list(FlStandardMessageCodec* codec, GByteArray* buffer,
+                          const uint8_t* value, size_t length) {
+  flpigeon_write_typed_list(codec, buffer, 8, value, length, sizeof(uint8_t));
+}
+static void G_GNUC_UNUSED
+flpigeon_write_int32_list(FlStandardMessageCodec* codec, GByteArray* buffer,
+                          const int32_t* value, size_t length) {
+  flpigeon_write_typed_list(codec, buffer, 9, value, length, sizeof(int32_t));
+}
+static void G_GNUC_UNUSED
+flpigeon_write_int64_list(FlStandardMessageCodec* codec, GByteArray* buffer,
+                          const int64_t* value, size_t length) {
+  flpigeon_write_typed_list(codec, buffer, 10, value, length, sizeof(int64_t));
+}
+static void G_GNUC_UNUSED
+flpigeon_write_float_list(FlStandardMessageCodec* codec, GByteArray* buffer,
+                          const double* value, size_t length) {
+  flpigeon_write_typed_list(codec, buffer, 11, value, length, sizeof(double));
+}
+static void G_GNUC_UNUSED
+flpigeon_write_float32_list(FlStandardMessageCodec* codec, GByteArray* buffer,
+                            const float* value, size_t length) {
+  flpigeon_write_typed_list(codec, buffer, 14, value, length, sizeof(float));
+}
+static void G_GNUC_UNUSED flpigeon_write_list_header(
+    FlStandardMessageCodec* codec, GByteArray* buffer, size_t length) {
+  flpigeon_write_uint8(buffer, 12);
+  fl_standard_message_codec_write_size(codec, buffer, length);
+}
+static void G_GNUC_UNUSED flpigeon_write_enum(GByteArray* buffer, uint8_t type,
+                                              int64_t value) {
+  flpigeon_write_uint8(buffer, type);
+  flpigeon_write_int(buffer, value);
+}
 
 struct _PigeonExamplePackageMessageData {
   GObject parent_instance;
@@ -374,24 +463,6 @@ FlValue* pigeon_example_package_message_data_get_data(
   return self->data;
 }
 
-static FlValue* pigeon_example_package_message_data_to_list(
-    PigeonExamplePackageMessageData* self) {
-  FlValue* values = fl_value_new_list();
-  fl_value_append_take(values, self->name != nullptr
-                                   ? fl_value_new_string(self->name)
-                                   : fl_value_new_null());
-  fl_value_append_take(values,
-                       self->message_description != nullptr
-                           ? fl_value_new_string(self->message_description)
-                           : fl_value_new_null());
-  fl_value_append_take(values,
-                       fl_value_new_custom(pigeon_example_package_code_type_id,
-                                           fl_value_new_int(self->code),
-                                           (GDestroyNotify)fl_value_unref));
-  fl_value_append_take(values, fl_value_ref(self->data));
-  return values;
-}
-
 static PigeonExamplePackageMessageData*
 pigeon_example_package_message_data_new_from_list(FlValue* values) {
   FlValue* value0 = fl_value_get_list_value(values, 0);
@@ -506,9 +577,23 @@ pigeon_example_package_message_codec_write_pigeon_example_package_message_data(
     PigeonExamplePackageMessageData* value, GError** error) {
   uint8_t type = pigeon_example_package_message_data_type_id;
   g_byte_array_append(buffer, &type, sizeof(uint8_t));
-  g_autoptr(FlValue) values =
-      pigeon_example_package_message_data_to_list(value);
-  return fl_standard_message_codec_write_value(codec, buffer, values, error);
+  flpigeon_write_list_header(codec, buffer, 4);
+  if (value->name == nullptr) {
+    flpigeon_write_null(buffer);
+  } else {
+    flpigeon_write_string(codec, buffer, value->name);
+  }
+  if (value->message_description == nullptr) {
+    flpigeon_write_null(buffer);
+  } else {
+    flpigeon_write_string(codec, buffer, value->message_description);
+  }
+  flpigeon_write_enum(buffer, pigeon_example_package_code_type_id, value->code);
+  if (!fl_standard_message_codec_write_value(codec, buffer, value->data,
+                                             error)) {
+    return FALSE;
+  }
+  return TRUE;
 }
 
 static gboolean pigeon_example_package_message_codec_write_value(
@@ -844,7 +929,7 @@ G_DEFINE_TYPE(PigeonExamplePackageExampleHostApi,
 static void pigeon_example_package_example_host_api_dispose(GObject* object) {
   PigeonExamplePackageExampleHostApi* self =
       PIGEON_EXAMPLE_PACKAGE_EXAMPLE_HOST_API(object);
-  if (self->user_data != nullptr) {
+  if (self->user_data != nullptr && self->user_data_free_func != nullptr) {
     self->user_data_free_func(self->user_data);
   }
   self->user_data = nullptr;
@@ -4,9 +4,9 @@
 
 export 'dart:typed_data' show Float64List, Int32List, Int64List, Uint8List;
 
-export 'src/cpp/cpp_generator.dart' show CppOptions;
+export 'src/cpp/cpp_generator.dart' show CppEventChannelOptions, CppEventOverflowPolicy, CppOptions;
 export 'src/dart/dart_generator.dart' show DartOptions;
-export 'src/gobject/gobject_generator.dart' show GObjectOptions;
+export 'src/gobject/gobject_generator.dart' show GObjectEventChannelOptions, GObjectOptions;
 export 'src/java/java_generator.dart' show JavaOptions;
 export 'src/kotlin/kotlin_generator.dart'
     show KotlinEventChannelOptions, KotlinOptions, KotlinProxyApiOptions;
@@ -5,7 +5,9 @@
 import 'package:collection/collection.dart' show ListEquality;
 import 'package:meta/meta.dart';
 
+import 'cpp/cpp_generator.dart' show CppEventChannelOptions;
 import 'generator_tools.dart';
+import 'gobject/gobject_generator.dart' show GObjectEventChannelOptions;
 import 'kotlin/kotlin_generator.dart' show KotlinEventChannelOptions, KotlinProxyApiOptions;
 import 'pigeon_lib.dart';
 import 'swift/swift_generator.dart' show SwiftEventChannelOptions, SwiftProxyApiOptions;
@@ -41,6 +43,7 @@ class Method extends Node {
     this.objcSelector = '',
     this.swiftFunction = '',
     this.taskQueueType = TaskQueueType.serial,
+    this.chunkSize,
     this.documentationComments = const <String>[],
   });
 
@@ -68,6 +71,12 @@ class Method extends Node {
   /// Specifies how handlers are dispatched with respect to threading.
   TaskQueueType taskQueueType;
 
+  /// The maximum size of the chunks that the `Uint8List` arguments and return
+  /// value are sent in, if the method has a `@ChunkedBytes` annotation.
+  ///
+  /// See [TypeDeclaration.isChunked].
+  int? chunkSize;
+
   /// List of documentation comments, separated by line.
   ///
   /// Lines should not include the comment marker itself, but should include any
@@ -104,14 +113,19 @@ class AstHostApi extends Api {
     required super.methods,
     super.documentationComments = const <String>[],
     this.dartHostTestHandler,
+    this.multiplexChannel = false,
   });
 
   /// The name of the Dart test interface to generate to help with testing.
   String? dartHostTestHandler;
 
+  /// Whether all methods are sent on a single channel, prefixed with the index
+  /// of the method in [methods].
+  bool multiplexChannel;
+
   @override
   String toString() {
-    return '(HostApi name:$name methods:$methods documentationComments:$documentationComments dartHostTestHandler:$dartHostTestHandler)';
+    return '(HostApi name:$name methods:$methods documentationComments:$documentationComments dartHostTestHandler:$dartHostTestHandler multiplexChannel:$multiplexChannel)';
   }
 }
 
@@ -342,6 +356,8 @@ class AstEventChannelApi extends Api {
     required super.methods,
     this.kotlinOptions,
     this.swiftOptions,
+    this.gobjectOptions,
+    this.cppOptions,
     super.documentationComments = const <String>[],
   });
 
@@ -351,6 +367,12 @@ class AstEventChannelApi extends Api {
   /// Options for Swift generated code for Event Channels.
   final SwiftEventChannelOptions? swiftOptions;
 
+  /// Options for GObject generated code for Event Channels.
+  final GObjectEventChannelOptions? gobjectOptions;
+
+  /// Options for C++ generated code for Event Channels.
+  final CppEventChannelOptions? cppOptions;
+
   @override
   String toString() {
     return '(EventChannelApi name:$name methods:$methods documentationComments:$documentationComments)';
@@ -452,6 +474,8 @@ class TypeDeclaration {
     this.associatedClass,
     this.associatedProxyApi,
     this.typeArguments = const <TypeDeclaration>[],
+    this.isColumnar = false,
+    this.isChunked = false,
   });
 
   /// Void constructor.
@@ -461,7 +485,9 @@ class TypeDeclaration {
       associatedEnum = null,
       associatedClass = null,
       associatedProxyApi = null,
-      typeArguments = const <TypeDeclaration>[];
+      typeArguments = const <TypeDeclaration>[],
+      isColumnar = false,
+      isChunked = false;
 
   /// The base name of the [TypeDeclaration] (ex `Foo` to `Foo<Bar>?`).
   final String baseName;
@@ -493,6 +519,23 @@ class TypeDeclaration {
   /// Associated [AstProxyApi], if any.
   final AstProxyApi? associatedProxyApi;
 
+  /// Whether the type is a list of a `@Columnar` class that is sent as one
+  /// list per field of the class, rather than as a list of objects.
+  ///
+  /// This is only set on the arguments and return values of HostApi and
+  /// FlutterApi methods.
+  final bool isColumnar;
+
+  /// The `@Columnar` class of the elements of the list, if [isColumnar].
+  Class? get columnarClass => isColumnar ? typeArguments.first.associatedClass : null;
+
+  /// Whether the type is a `Uint8List` that is sent in chunks, which the host
+  /// reads or writes through a stream, rather than in a single message.
+  ///
+  /// This is only set on the arguments and return values of HostApi methods
+  /// with a `@ChunkedBytes` annotation.
+  final bool isChunked;
+
   @override
   int get hashCode {
     // This has to be implemented because TypeDeclaration is used as a Key to a
@@ -500,6 +543,8 @@ class TypeDeclaration {
     var hash = 17;
     hash = hash * 37 + baseName.hashCode;
     hash = hash * 37 + isNullable.hashCode;
+    hash = hash * 37 + isColumnar.hashCode;
+    hash = hash * 37 + isChunked.hashCode;
     for (final TypeDeclaration typeArgument in typeArguments) {
       hash = hash * 37 + typeArgument.hashCode;
     }
@@ -514,6 +559,8 @@ class TypeDeclaration {
       return other is TypeDeclaration &&
           baseName == other.baseName &&
           isNullable == other.isNullable &&
+          isColumnar == other.isColumnar &&
+          isChunked == other.isChunked &&
           _listEquals(typeArguments, other.typeArguments) &&
           isEnum == other.isEnum &&
           isClass == other.isClass &&
@@ -530,6 +577,8 @@ class TypeDeclaration {
       isNullable: isNullable,
       associatedEnum: enumDefinition,
       typeArguments: typeArguments,
+      isColumnar: isColumnar,
+      isChunked: isChunked,
     );
   }
 
@@ -541,6 +590,8 @@ class TypeDeclaration {
       isNullable: isNullable,
       associatedClass: classDefinition,
       typeArguments: typeArguments,
+      isColumnar: isColumnar,
+      isChunked: isChunked,
     );
   }
 
@@ -552,6 +603,8 @@ class TypeDeclaration {
       isNullable: isNullable,
       associatedProxyApi: proxyApiDefinition,
       typeArguments: typeArguments,
+      isColumnar: isColumnar,
+      isChunked: isChunked,
     );
   }
 
@@ -564,13 +617,43 @@ class TypeDeclaration {
       associatedClass: associatedClass,
       associatedEnum: associatedEnum,
       associatedProxyApi: associatedProxyApi,
+      isColumnar: isColumnar,
+      isChunked: isChunked,
+    );
+  }
+
+  /// Returns a new [TypeDeclaration] that is sent as columns, see [isColumnar].
+  TypeDeclaration copyWithColumnar() {
+    return TypeDeclaration(
+      baseName: baseName,
+      isNullable: isNullable,
+      typeArguments: typeArguments,
+      associatedClass: associatedClass,
+      associatedEnum: associatedEnum,
+      associatedProxyApi: associatedProxyApi,
+      isColumnar: true,
+      isChunked: isChunked,
+    );
+  }
+
+  /// Returns a new [TypeDeclaration] that is sent in chunks, see [isChunked].
+  TypeDeclaration copyWithChunked() {
+    return TypeDeclaration(
+      baseName: baseName,
+      isNullable: isNullable,
+      typeArguments: typeArguments,
+      associatedClass: associatedClass,
+      associatedEnum: associatedEnum,
+      associatedProxyApi: associatedProxyApi,
+      isColumnar: isColumnar,
+      isChunked: true,
     );
   }
 
   @override
   String toString() {
     final typeArgumentsStr = typeArguments.isEmpty ? '' : ' typeArguments:$typeArguments';
-    return '(TypeDeclaration baseName:$baseName isNullable:$isNullable$typeArgumentsStr isEnum:$isEnum isClass:$isClass isProxyApi:$isProxyApi)';
+    return '(TypeDeclaration baseName:$baseName isNullable:$isNullable$typeArgumentsStr isEnum:$isEnum isClass:$isClass isProxyApi:$isProxyApi isColumnar:$isColumnar isChunked:$isChunked)';
   }
 }
 
@@ -695,6 +778,7 @@ class Class extends Node {
     this.isSealed = false,
     this.isReferenced = true,
     this.isSwiftClass = false,
+    this.isColumnar = false,
     this.documentationComments = const <String>[],
   });
 
@@ -727,6 +811,10 @@ class Class extends Node {
   /// Defaults to false, which would represent a struct.
   bool isSwiftClass;
 
+  /// Whether lists of the class are sent as one list per field by HostApi and
+  /// FlutterApi methods.
+  bool isColumnar;
+
   /// List of documentation comments, separated by line.
   ///
   /// Lines should not include the comment marker itself, but should include any
@@ -736,7 +824,7 @@ class Class extends Node {
 
   @override
   String toString() {
-    return '(Class name:$name fields:$fields superClass:$superClassName children:$children isSealed:$isSealed isReferenced:$isReferenced documentationComments:$documentationComments)';
+    return '(Class name:$name fields:$fields superClass:$superClassName children:$children isSealed:$isSealed isReferenced:$isReferenced isColumnar:$isColumnar documentationComments:$documentationComments)';
   }
 }
 
@@ -24,6 +24,19 @@ const String _standardCodecSerializer = '::flutter::StandardCodecSerializer';
 /// The name of the codec serializer.
 const String _codecSerializerName = '${classNamePrefix}CodecSerializer';
 
+/// The name of the codec serializer used by ProxyApis.
+const String _proxyApiCodecSerializerName = '${classNamePrefix}ProxyApiCodecSerializer';
+
+/// The name of the variable that holds the encoded arguments of a Flutter
+/// method.
+const String _flutterMethodArgumentsName = 'encoded_api_arguments';
+
+/// The name of the class that holds the ProxyApi instances.
+const String _instanceManagerClassName = '${proxyApiClassNamePrefix}InstanceManager';
+
+/// The C++ type of a ProxyApi instance.
+const String _proxyApiInstanceType = 'std::shared_ptr<void>';
+
 const String _overflowClassName = '${classNamePrefix}CodecOverflow';
 
 final NamedType _overflowType = NamedType(
@@ -51,6 +64,9 @@ class CppOptions {
     this.namespace,
     this.copyrightHeader,
     this.headerOutPath,
+    this.typedCollections,
+    this.tableDrivenDispatch,
+    this.coroutines,
   });
 
   /// The path to the header that will get placed in the source file (example:
@@ -66,6 +82,37 @@ class CppOptions {
   /// The path to the output header file location.
   final String? headerOutPath;
 
+  /// Determines if data class fields that are lists or maps of non-nullable
+  /// `bool`, `int`, `double` or `String` values use `std::vector` and
+  /// `std::unordered_map` rather than `EncodableList` and `EncodableMap`.
+  ///
+  /// When enabled, these fields are decoded directly into the typed
+  /// containers. Host and Flutter API method arguments and results still use
+  /// `EncodableList` and `EncodableMap`. This is false by default.
+  final bool? typedCollections;
+
+  /// Determines if host APIs register their message handlers from a static
+  /// table of their methods, rather than with a handler written out for each
+  /// method.
+  ///
+  /// Each method then only gets a small function that decodes its arguments
+  /// and calls it, and one shared handler builds the channel names, catches
+  /// exceptions and replies to errors. This makes the generated code for APIs
+  /// with many methods smaller and quicker to set up. The channels and
+  /// messages are the same either way. This is false by default.
+  final bool? tableDrivenDispatch;
+
+  /// Determines if the generated APIs use C++20 coroutines for asynchronous
+  /// calls, which needs the generated code to be compiled as C++20.
+  ///
+  /// Each Flutter API method gets an overload without the `on_success` and
+  /// `on_error` callbacks that returns a `PigeonFlutterApiCall`. A coroutine
+  /// can `co_await` it to send the message and resume with the reply, as an
+  /// `ErrorOr` of the return value. Asynchronous host API methods return a
+  /// `PigeonTask` instead of taking a callback, so they can be implemented as
+  /// coroutines. This is false by default.
+  final bool? coroutines;
+
   /// Creates a [CppOptions] from a Map representation where:
   /// `x = CppOptions.fromMap(x.toMap())`.
   static CppOptions fromMap(Map<String, Object> map) {
@@ -74,6 +121,9 @@ class CppOptions {
       namespace: map['namespace'] as String?,
       copyrightHeader: map['copyrightHeader'] as Iterable<String>?,
       headerOutPath: map['cppHeaderOut'] as String?,
+      typedCollections: map['typedCollections'] as bool?,
+      tableDrivenDispatch: map['tableDrivenDispatch'] as bool?,
+      coroutines: map['coroutines'] as bool?,
     );
   }
 
@@ -84,6 +134,9 @@ class CppOptions {
       if (headerIncludePath != null) 'headerIncludePath': headerIncludePath!,
       if (namespace != null) 'namespace': namespace!,
       if (copyrightHeader != null) 'copyrightHeader': copyrightHeader!,
+      if (typedCollections != null) 'typedCollections': typedCollections!,
+      if (tableDrivenDispatch != null) 'tableDrivenDispatch': tableDrivenDispatch!,
+      if (coroutines != null) 'coroutines': coroutines!,
     };
     return result;
   }
@@ -95,6 +148,56 @@ class CppOptions {
   }
 }
 
+/// What the C++ event sinks of an event channel do with an event that is added
+/// while their queue is full.
+enum CppEventOverflowPolicy {
+  /// The oldest queued event is dropped to make room.
+  dropOldest,
+
+  /// The thread adding the event waits until there is room.
+  ///
+  /// Events added on the platform thread never wait, since that is the thread
+  /// that sends the queued events.
+  block,
+}
+
+/// Options for C++ generated code for Event Channels.
+class CppEventChannelOptions {
+  /// Construct a [CppEventChannelOptions].
+  const CppEventChannelOptions({
+    this.maxBatchSize = 1,
+    this.maxQueuedEvents = 0,
+    this.overflowPolicy = CppEventOverflowPolicy.dropOldest,
+  });
+
+  /// The maximum number of events that are sent in a single platform message.
+  ///
+  /// When this is greater than 1, queued events are sent in lists of up to
+  /// [maxBatchSize] events. A partial batch is sent when the sink is flushed,
+  /// or before an error or the end of the stream. The generated Dart code
+  /// unpacks the list, so listeners still receive the events one at a time.
+  ///
+  /// Defaults to 1, which sends every event on its own.
+  final int maxBatchSize;
+
+  /// The maximum number of events that are waiting to be sent.
+  ///
+  /// Events added from other threads wait in a queue until they are sent from
+  /// the platform thread, and [overflowPolicy] decides what happens when the
+  /// queue is full. Must be 0 or at least [maxBatchSize].
+  ///
+  /// Defaults to 0, which doesn't limit the queue.
+  final int maxQueuedEvents;
+
+  /// What happens to an event that is added while the queue is full.
+  ///
+  /// Defaults to [CppEventOverflowPolicy.dropOldest].
+  final CppEventOverflowPolicy overflowPolicy;
+
+  /// Whether events are collected into batches.
+  bool get isBatched => maxBatchSize > 1;
+}
+
 /// Options that control how C++ code will be generated.
 ///
 /// For internal use only.
@@ -107,6 +210,9 @@ class InternalCppOptions extends InternalOptions {
     this.namespace,
     this.copyrightHeader,
     this.headerOutPath,
+    this.typedCollections = false,
+    this.tableDrivenDispatch = false,
+    this.coroutines = false,
   });
 
   /// Creates InternalCppOptions from CppOptions.
@@ -118,7 +224,10 @@ class InternalCppOptions extends InternalOptions {
   }) : headerIncludePath = options.headerIncludePath ?? path.basename(cppHeaderOut),
        namespace = options.namespace,
        copyrightHeader = options.copyrightHeader ?? copyrightHeader,
-       headerOutPath = options.headerOutPath;
+       headerOutPath = options.headerOutPath,
+       typedCollections = options.typedCollections ?? false,
+       tableDrivenDispatch = options.tableDrivenDispatch ?? false,
+       coroutines = options.coroutines ?? false;
 
   /// The path to the header that will get placed in the source file (example:
   /// "foo.h").
@@ -138,6 +247,18 @@ class InternalCppOptions extends InternalOptions {
 
   /// The path to the output header file location.
   final String? headerOutPath;
+
+  /// Determines if fully typed list and map fields of data classes use
+  /// `std::vector` and `std::unordered_map`.
+  final bool typedCollections;
+
+  /// Determines if host APIs register their message handlers from a static
+  /// table of their methods.
+  final bool tableDrivenDispatch;
+
+  /// Determines if Flutter API calls can be awaited and asynchronous host API
+  /// methods are coroutines.
+  final bool coroutines;
 }
 
 /// Class that manages all Cpp code generation.
@@ -209,10 +330,58 @@ class CppHeaderGenerator extends StructuredGenerator<InternalCppOptions> {
       'flutter/basic_message_channel.h',
       'flutter/binary_messenger.h',
       'flutter/encodable_value.h',
+      if (root.containsEventChannel) ...<String>[
+        'flutter/event_sink.h',
+        'flutter/event_stream_handler.h',
+      ],
       'flutter/standard_message_codec.h',
     ]);
     indent.newln();
-    _writeSystemHeaderIncludeBlock(indent, <String>['map', 'string', 'optional', 'ostream']);
+    _writeSystemHeaderIncludeBlock(indent, <String>[
+      'map',
+      'string',
+      'optional',
+      'ostream',
+      if (generatorOptions.typedCollections) 'unordered_map',
+      if (_hasTaskQueueMethods(root)) ...<String>[
+        'condition_variable',
+        'deque',
+        'functional',
+        'memory',
+        'mutex',
+        'thread',
+      ],
+      if (root.containsEventChannel) ...<String>[
+        'algorithm',
+        'condition_variable',
+        'deque',
+        'functional',
+        'memory',
+        'mutex',
+        'thread',
+        'variant',
+      ],
+      if (root.containsProxyApi) ...<String>[
+        'atomic',
+        'functional',
+        'memory',
+        'mutex',
+        'unordered_map',
+        'vector',
+      ],
+      if (_hasCoroutineHostMethods(generatorOptions, root)) ...<String>[
+        'coroutine',
+        'exception',
+        'utility',
+      ],
+      if (_hasFlutterApiMethods(root)) ...<String>['memory', 'utility'],
+      if (hasChunkedBytesMethods(root)) ...<String>['functional', 'memory', 'vector'],
+      if (_hasAwaitableFlutterMethods(generatorOptions, root)) ...<String>[
+        'coroutine',
+        'memory',
+        'vector',
+      ],
+    ]);
     indent.newln();
     if (generatorOptions.namespace != null) {
       indent.writeln('namespace ${generatorOptions.namespace} {');
@@ -255,14 +424,150 @@ class CppHeaderGenerator extends StructuredGenerator<InternalCppOptions> {
     required String dartPackageName,
   }) {
     _writeFlutterError(indent);
-    if (root.containsHostApi) {
+    if (root.containsHostApi ||
+        root.containsProxyApi ||
+        _hasAwaitableFlutterMethods(generatorOptions, root)) {
       _writeErrorOr(
         indent,
         friends: root.apis
-            .where((Api api) => api is AstFlutterApi || api is AstHostApi)
+            .where((Api api) => api is AstFlutterApi || api is AstHostApi || api is AstProxyApi)
             .map((Api api) => api.name),
       );
     }
+    if (_hasTaskQueueMethods(root)) {
+      _writeTaskQueue(indent);
+    }
+    if (hasChunkedBytesMethods(root)) {
+      _writeByteStreamReader(indent);
+    }
+    if (_hasCoroutineHostMethods(generatorOptions, root)) {
+      _writeTask(indent);
+    }
+    if (_hasFlutterApiMethods(root)) {
+      _writeFlutterMethodChannel(indent);
+    }
+    if (_hasAwaitableFlutterMethods(generatorOptions, root)) {
+      _writeFlutterApiCall(indent);
+    }
+    if (root.containsEventChannel) {
+      _writeEventChannelSupport(indent);
+    }
+  }
+
+  @override
+  void writeInstanceManager(
+    InternalCppOptions generatorOptions,
+    Root root,
+    Indent indent, {
+    required String dartPackageName,
+  }) {
+    indent.format('''
+
+class $_proxyApiCodecSerializerName;
+
+// Maintains the instances used to communicate with the corresponding objects
+// in Dart.
+//
+// Instances are type-erased, so any native object can be added. Each instance
+// is held with a strong reference until Dart releases it, and with a weak
+// reference after that. Once an instance that Dart has released is destroyed,
+// ReleaseDestroyedInstances tells Dart to release its Dart instance too.
+//
+// The methods may be called from any thread unless noted otherwise. The
+// instances are split across shards that each have their own mutex, so calls
+// on different threads rarely wait for each other.
+class $_instanceManagerClassName {
+ public:
+\t// The identifiers of instances added on the host start at this value, so
+\t// that they never collide with the identifiers Dart assigns.
+\tstatic constexpr int64_t kMinHostCreatedIdentifier = 65536;
+
+\t// Creates an instance manager and sets up the handlers Dart uses to release
+\t// instances on |binary_messenger|.
+\texplicit $_instanceManagerClassName(::flutter::BinaryMessenger* binary_messenger);
+\t~$_instanceManagerClassName();
+
+\t$_instanceManagerClassName(const $_instanceManagerClassName&) = delete;
+\t$_instanceManagerClassName& operator=(const $_instanceManagerClassName&) = delete;
+
+\t// The codec used by the ProxyApis, which sends the instances in this
+\t// instance manager as their identifiers.
+\tconst ::flutter::StandardMessageCodec& GetCodec() const;
+
+\t// Adds |instance|, which was created for the Dart instance with
+\t// |identifier|. Returns false if the instance or the identifier has already
+\t// been added.
+\tbool AddDartCreatedInstance($_proxyApiInstanceType instance, int64_t identifier);
+\t// Adds |instance|, which was created on the host, and returns its new
+\t// identifier. Returns -1 if the instance has already been added.
+\tint64_t AddHostCreatedInstance($_proxyApiInstanceType instance);
+\t// Returns the instance with |identifier|, or nullptr if there is none.
+\t$_proxyApiInstanceType GetInstance(int64_t identifier) const;
+\t// Returns the identifier of |instance|, or -1 if it has not been added.
+\t//
+\t// This is called when the instance is sent to Dart, so the instance is held
+\t// with a strong reference again until Dart releases it.
+\tint64_t GetIdentifier(const void* instance);
+\t// Returns true if |instance| has been added.
+\tbool ContainsInstance(const void* instance) const;
+\t// Releases the strong reference to the instance with |identifier|, since it
+\t// is no longer used in Dart.
+\tvoid Remove(int64_t identifier);
+\t// Removes all of the instances, without telling Dart.
+\tvoid Clear();
+\t// Tells Dart to release the instances that have been destroyed since Dart
+\t// released them, and returns how many there were.
+\t//
+\t// The destroyed instances are collected from every shard and then sent in
+\t// one removeStrongReferences message. This sends a message, so it must be
+\t// called on the platform thread; it is also called after each instance Dart
+\t// releases.
+\tsize_t ReleaseDestroyedInstances();
+
+ private:
+\tstatic constexpr size_t kShardCount = 16;
+
+\tstruct Entry {
+\t\tconst void* instance = nullptr;
+\t\t$_proxyApiInstanceType strong_reference;
+\t\tstd::weak_ptr<void> weak_reference;
+\t\t// Whether the identifier is in released_identifiers.
+\t\tbool is_released = false;
+\t};
+
+\t// The instances whose identifiers map to this shard.
+\tstruct IdentifierShard {
+\t\tmutable std::mutex mutex;
+\t\tstd::unordered_map<int64_t, Entry> entries;
+\t\t// Identifiers whose strong reference was released, which are checked by
+\t\t// ReleaseDestroyedInstances.
+\t\tstd::vector<int64_t> released_identifiers;
+\t};
+
+\t// The identifiers of the instances whose addresses map to this shard.
+\t//
+\t// When both kinds of shard are locked, the instance shard is always locked
+\t// first.
+\tstruct InstanceShard {
+\t\tmutable std::mutex mutex;
+\t\tstd::unordered_map<const void*, int64_t> identifiers;
+\t};
+
+\tIdentifierShard& GetIdentifierShard(int64_t identifier) const;
+\tInstanceShard& GetInstanceShard(const void* instance) const;
+\t// Returns the identifier |instance| was added with, or -1 if it has not
+\t// been added, with |shard| locked. The address of a destroyed instance can
+\t// be reused, so an identifier whose instance is gone doesn't count.
+\tint64_t FindIdentifier(const InstanceShard& shard, const void* instance) const;
+\tbool AddInstance($_proxyApiInstanceType instance, int64_t identifier);
+
+\t::flutter::BinaryMessenger* binary_messenger_;
+\tstd::unique_ptr<$_proxyApiCodecSerializerName> codec_serializer_;
+\tstd::atomic<int64_t> next_identifier_;
+\tmutable IdentifierShard identifier_shards_[kShardCount];
+\tmutable InstanceShard instance_shards_[kShardCount];
+};
+''');
   }
 
   @override
@@ -284,6 +589,84 @@ class CppHeaderGenerator extends StructuredGenerator<InternalCppOptions> {
         isOverflowClass: true,
       );
     }
+    for (final Class classDefinition in root.classes.where((Class x) => x.isColumnar)) {
+      _writeColumnsClass(generatorOptions, root, indent, classDefinition);
+    }
+  }
+
+  /// Writes the declaration of the class that holds a list of the `@Columnar`
+  /// [classDefinition] as one array per field.
+  void _writeColumnsClass(
+    InternalCppOptions generatorOptions,
+    Root root,
+    Indent indent,
+    Class classDefinition,
+  ) {
+    final String className = _columnsClassName(classDefinition);
+    final Iterable<NamedType> orderedFields = getFieldsInSerializationOrder(classDefinition);
+    indent.newln();
+    indent.format('''
+$_commentPrefix Generated class from Pigeon that holds a list of ${classDefinition.name} as one array
+$_commentPrefix per field, which is how host and Flutter API methods send it.
+$_commentPrefix
+$_commentPrefix The values of a field can be read without creating an object for each row.''');
+    indent.write('class $className ');
+    indent.addScoped('{', '};', () {
+      _writeAccessBlock(indent, _ClassAccess.public, () {
+        indent.writeln('$_commentPrefix Constructs an empty list.');
+        _writeFunctionDeclaration(indent, className, isConstructor: true);
+        indent.writeln(
+          '$_commentPrefix Constructs a list from the values of each field, which must all have the',
+        );
+        indent.writeln('$_commentPrefix same length.');
+        _writeFunctionDeclaration(
+          indent,
+          className,
+          isConstructor: true,
+          parameters: orderedFields
+              .map((NamedType field) => '${_columnType(field.type)} ${_makeVariableName(field)}')
+              .toList(),
+        );
+        indent.newln();
+        indent.writeln('$_commentPrefix Returns the number of rows.');
+        _writeFunctionDeclaration(indent, 'size', returnType: 'size_t', isConst: true);
+        for (final field in orderedFields) {
+          indent.newln();
+          addDocumentationComments(indent, field.documentationComments, _docCommentSpec);
+          indent.writeln('$_commentPrefix ${_columnDescription(field)}');
+          _writeFunctionDeclaration(
+            indent,
+            _makeGetterName(field),
+            returnType: 'const ${_columnType(field.type)}&',
+            isConst: true,
+          );
+        }
+      });
+
+      _writeAccessBlock(indent, _ClassAccess.private, () {
+        _writeFunctionDeclaration(
+          indent,
+          'FromEncodableList',
+          returnType: className,
+          parameters: <String>['::flutter::EncodableList&& list'],
+          isStatic: true,
+        );
+        for (final Api api in root.apis.where(
+          (Api api) => api is AstFlutterApi || api is AstHostApi,
+        )) {
+          indent.writeln('friend class ${api.name};');
+        }
+        if (generatorOptions.namespace?.endsWith('_pigeontest') ?? false) {
+          indent.writeln(
+            'friend class ${_pascalCaseFromSnakeCase(generatorOptions.namespace!.replaceAll('_pigeontest', ''))}Test;',
+          );
+        }
+        indent.newln();
+        indent.writeln('$_commentPrefix The column of each field, in the order they are sent.');
+        indent.writeln('::flutter::EncodableList columns_;');
+      });
+    }, nestCount: 0);
+    indent.newln();
   }
 
   @override
@@ -332,6 +715,7 @@ class CppHeaderGenerator extends StructuredGenerator<InternalCppOptions> {
             classDefinition,
             requiredFields,
             'Constructs an object setting all non-nullable fields.',
+            typedCollections: generatorOptions.typedCollections,
           );
         }
         // All-field constructor.
@@ -341,6 +725,7 @@ class CppHeaderGenerator extends StructuredGenerator<InternalCppOptions> {
           classDefinition,
           orderedFields,
           'Constructs an object setting all fields.',
+          typedCollections: generatorOptions.typedCollections,
         );
 
         // If any fields are pointer type, then the class requires a custom
@@ -388,9 +773,9 @@ class CppHeaderGenerator extends StructuredGenerator<InternalCppOptions> {
 
         for (final field in orderedFields) {
           addDocumentationComments(indent, field.documentationComments, _docCommentSpec);
-          final HostDatatype baseDatatype = getFieldHostDatatype(
+          final HostDatatype baseDatatype = _fieldHostDatatype(
             field,
-            _baseCppTypeForBuiltinDartType,
+            typedCollections: generatorOptions.typedCollections,
           );
           // Declare a getter and setter.
           _writeFunctionDeclaration(
@@ -418,6 +803,14 @@ class CppHeaderGenerator extends StructuredGenerator<InternalCppOptions> {
               parameters: <String>['${_unownedArgumentType(nonNullType)} value_arg'],
             );
           }
+          if (_hasMoveSetter(baseDatatype)) {
+            _writeFunctionDeclaration(
+              indent,
+              setterName,
+              returnType: _voidType,
+              parameters: <String>['${baseDatatype.datatype}&& value_arg'],
+            );
+          }
           indent.newln();
         }
 
@@ -446,13 +839,33 @@ class CppHeaderGenerator extends StructuredGenerator<InternalCppOptions> {
       });
 
       _writeAccessBlock(indent, _ClassAccess.private, () {
+        // The codec serializer decodes fields directly into the members, so
+        // needs a default constructor even when there are required fields.
+        if (!isOverflowClass &&
+            orderedFields.any((NamedType field) => !field.type.isNullable)) {
+          _writeFunctionDeclaration(
+            indent,
+            classDefinition.name,
+            isConstructor: true,
+            defaultImpl: true,
+          );
+        }
         _writeFunctionDeclaration(
           indent,
           'FromEncodableList',
           returnType: isOverflowClass ? '::flutter::EncodableValue' : classDefinition.name,
-          parameters: <String>['const ::flutter::EncodableList& list'],
+          parameters: <String>['::flutter::EncodableList&& list'],
           isStatic: true,
         );
+        if (!isOverflowClass) {
+          _writeFunctionDeclaration(
+            indent,
+            'FromEncodableList',
+            returnType: classDefinition.name,
+            parameters: <String>['::flutter::EncodableList&& list'],
+            isStatic: true,
+          );
+        }
         _writeFunctionDeclaration(
           indent,
           'ToEncodableList',
@@ -486,9 +899,9 @@ class CppHeaderGenerator extends StructuredGenerator<InternalCppOptions> {
         }
 
         for (final field in orderedFields) {
-          final HostDatatype hostDatatype = getFieldHostDatatype(
+          final HostDatatype hostDatatype = _fieldHostDatatype(
             field,
-            _baseCppTypeForBuiltinDartType,
+            typedCollections: generatorOptions.typedCollections,
           );
           indent.writeln('${_fieldType(hostDatatype)} ${_makeInstanceVariableName(field)};');
         }
@@ -542,6 +955,206 @@ class CppHeaderGenerator extends StructuredGenerator<InternalCppOptions> {
           isOverride: true,
         );
       });
+      final Iterable<EnumeratedType> streamDecodedClasses = _streamDecodedClasses(root);
+      if (streamDecodedClasses.isNotEmpty) {
+        _writeAccessBlock(indent, _ClassAccess.private, () {
+          const streamParameter = '::flutter::ByteStreamReader* stream';
+          indent.writeln(
+            '$_commentPrefix Each of these reads a value that was written with the given type',
+          );
+          indent.writeln(
+            '$_commentPrefix directly from the stream, without building an intermediate',
+          );
+          indent.writeln(
+            '$_commentPrefix EncodableValue for it. Values written with any other type are',
+          );
+          indent.writeln('$_commentPrefix read with ReadValueOfType and converted.');
+          _writeFunctionDeclaration(
+            indent,
+            'ReadEncodedFieldList',
+            returnType: 'bool',
+            parameters: <String>[
+              streamParameter,
+              'size_t field_count',
+              '::flutter::EncodableList* list',
+            ],
+            isConst: true,
+          );
+          for (final (String name, String type) in _streamDecodedBuiltinTypes) {
+            _writeFunctionDeclaration(
+              indent,
+              'ReadEncoded$name',
+              returnType: type,
+              parameters: <String>['uint8_t type', streamParameter],
+              isConst: true,
+            );
+          }
+          indent.writeln('template <typename T>');
+          _writeFunctionDeclaration(
+            indent,
+            'ReadEncodedTypedData',
+            returnType: 'std::vector<T>',
+            parameters: <String>['uint8_t type', streamParameter],
+            isConst: true,
+          );
+          if (generatorOptions.typedCollections) {
+            indent.writeln('template <typename T>');
+            _writeFunctionDeclaration(
+              indent,
+              'ReadEncodedElement',
+              returnType: 'T',
+              parameters: <String>[streamParameter],
+              isConst: true,
+            );
+            indent.writeln('template <typename T>');
+            _writeFunctionDeclaration(
+              indent,
+              'ReadEncodedVector',
+              returnType: 'std::vector<T>',
+              parameters: <String>['uint8_t type', streamParameter],
+              isConst: true,
+            );
+            indent.writeln('template <typename K, typename V>');
+            _writeFunctionDeclaration(
+              indent,
+              'ReadEncodedUnorderedMap',
+              returnType: 'std::unordered_map<K, V>',
+              parameters: <String>['uint8_t type', streamParameter],
+              isConst: true,
+            );
+          }
+          for (final EnumeratedType customType in streamDecodedClasses) {
+            _writeFunctionDeclaration(
+              indent,
+              'Read${customType.name}',
+              returnType: customType.name,
+              parameters: <String>['uint8_t type', streamParameter],
+              isConst: true,
+            );
+          }
+          indent.newln();
+          const writerParameter = '::flutter::ByteStreamWriter* stream';
+          indent.writeln(
+            '$_commentPrefix Each of these writes a value directly to the stream, producing the',
+          );
+          indent.writeln(
+            '$_commentPrefix same bytes as WriteValue would for the EncodableValue that it',
+          );
+          indent.writeln('$_commentPrefix converts to.');
+          for (final (String name, String type) in _streamDecodedBuiltinTypes) {
+            _writeFunctionDeclaration(
+              indent,
+              'WriteEncoded$name',
+              returnType: _voidType,
+              parameters: <String>[_streamWriterValueParameter(type), writerParameter],
+              isConst: true,
+            );
+          }
+          indent.writeln('template <typename T>');
+          _writeFunctionDeclaration(
+            indent,
+            'WriteEncodedTypedData',
+            returnType: _voidType,
+            parameters: <String>['const std::vector<T>& value', writerParameter],
+            isConst: true,
+          );
+          _writeFunctionDeclaration(
+            indent,
+            'WriteEncodedList',
+            returnType: _voidType,
+            parameters: <String>['const ::flutter::EncodableList& value', writerParameter],
+            isConst: true,
+          );
+          _writeFunctionDeclaration(
+            indent,
+            'WriteEncodedMap',
+            returnType: _voidType,
+            parameters: <String>['const ::flutter::EncodableMap& value', writerParameter],
+            isConst: true,
+          );
+          if (generatorOptions.typedCollections) {
+            indent.writeln('template <typename T>');
+            _writeFunctionDeclaration(
+              indent,
+              'WriteEncodedElement',
+              returnType: _voidType,
+              parameters: <String>['const T& value', writerParameter],
+              isConst: true,
+            );
+            indent.writeln('template <typename T>');
+            _writeFunctionDeclaration(
+              indent,
+              'WriteEncodedVector',
+              returnType: _voidType,
+              parameters: <String>['const std::vector<T>& value', writerParameter],
+              isConst: true,
+            );
+            indent.writeln('template <typename K, typename V>');
+            _writeFunctionDeclaration(
+              indent,
+              'WriteEncodedUnorderedMap',
+              returnType: _voidType,
+              parameters: <String>['const std::unordered_map<K, V>& value', writerParameter],
+              isConst: true,
+            );
+          }
+          for (final EnumeratedType customType in streamDecodedClasses) {
+            _writeFunctionDeclaration(
+              indent,
+              'WriteFields',
+              returnType: _voidType,
+              parameters: <String>['const ${customType.name}& value', writerParameter],
+              isConst: true,
+            );
+          }
+        });
+      }
+    }, nestCount: 0);
+    indent.newln();
+    if (root.containsProxyApi) {
+      _writeProxyApiCodecSerializer(indent);
+    }
+  }
+
+  void _writeProxyApiCodecSerializer(Indent indent) {
+    indent.writeln(
+      '$_commentPrefix Sends the ProxyApi instances in an instance manager as their identifiers.',
+    );
+    indent.write('class $_proxyApiCodecSerializerName : public $_codecSerializerName ');
+    indent.addScoped('{', '};', () {
+      _writeAccessBlock(indent, _ClassAccess.public, () {
+        _writeFunctionDeclaration(
+          indent,
+          _proxyApiCodecSerializerName,
+          isConstructor: true,
+          parameters: <String>['$_instanceManagerClassName* instance_manager'],
+        );
+        indent.newln();
+        _writeFunctionDeclaration(
+          indent,
+          'WriteValue',
+          returnType: _voidType,
+          parameters: <String>[
+            'const ::flutter::EncodableValue& value',
+            '::flutter::ByteStreamWriter* stream',
+          ],
+          isConst: true,
+          isOverride: true,
+        );
+      });
+      indent.writeScoped(' protected:', '', () {
+        _writeFunctionDeclaration(
+          indent,
+          'ReadValueOfType',
+          returnType: '::flutter::EncodableValue',
+          parameters: <String>['uint8_t type', '::flutter::ByteStreamReader* stream'],
+          isConst: true,
+          isOverride: true,
+        );
+      });
+      _writeAccessBlock(indent, _ClassAccess.private, () {
+        indent.writeln('$_instanceManagerClassName* instance_manager_;');
+      });
     }, nestCount: 0);
     indent.newln();
   }
@@ -586,32 +1199,23 @@ class CppHeaderGenerator extends StructuredGenerator<InternalCppOptions> {
           isStatic: true,
         );
         for (final Method func in api.methods) {
-          final HostDatatype returnType = getHostDatatype(
-            func.returnType,
-            _baseCppTypeForBuiltinDartType,
-          );
-          addDocumentationComments(indent, func.documentationComments, _docCommentSpec);
-
-          final Iterable<String> argTypes = func.parameters.map((NamedType arg) {
-            final HostDatatype hostType = getFieldHostDatatype(arg, _baseCppTypeForBuiltinDartType);
-            return _flutterApiArgumentType(hostType);
-          });
-          final Iterable<String> argNames = indexMap(func.parameters, _getArgumentName);
-          final parameters = <String>[
-            ...map2(argTypes, argNames, (String x, String y) => '$x $y'),
-            ..._flutterApiCallbackParameters(returnType),
-          ];
-          _writeFunctionDeclaration(
-            indent,
-            _makeMethodName(func),
-            returnType: _voidType,
-            parameters: parameters,
-          );
+          _writeFlutterMethodDeclaration(indent, func);
+          if (generatorOptions.coroutines) {
+            _writeAwaitableFlutterMethodDeclaration(indent, func);
+          }
         }
       });
       indent.addScoped(' private:', null, () {
         indent.writeln('::flutter::BinaryMessenger* binary_messenger_;');
         indent.writeln('std::string message_channel_suffix_;');
+        if (api.methods.isNotEmpty) {
+          indent.writeln('$_commentPrefix The channel of each method, created on its first call.');
+        }
+        for (final Method func in api.methods) {
+          indent.writeln(
+            'std::shared_ptr<PigeonInternalFlutterMethodChannel> ${_makeChannelVariableName(func)};',
+          );
+        }
       });
     }, nestCount: 0);
     indent.newln();
@@ -654,46 +1258,11 @@ class CppHeaderGenerator extends StructuredGenerator<InternalCppOptions> {
         // No-op virtual destructor.
         _writeFunctionDeclaration(indent, '~${api.name}', isVirtual: true, inlineNoop: true);
         for (final Method method in api.methods) {
-          final HostDatatype returnType = getHostDatatype(
-            method.returnType,
-            _baseCppTypeForBuiltinDartType,
-          );
-          final String returnTypeName = _hostApiReturnType(returnType);
-
-          final parameters = <String>[];
-          if (method.parameters.isNotEmpty) {
-            final Iterable<String> argTypes = method.parameters.map((NamedType arg) {
-              final HostDatatype hostType = getFieldHostDatatype(
-                arg,
-                _baseCppTypeForBuiltinDartType,
-              );
-              return _hostApiArgumentType(hostType);
-            });
-            final Iterable<String> argNames = method.parameters.map(
-              (NamedType e) => _makeVariableName(e),
-            );
-            parameters.addAll(
-              map2(argTypes, argNames, (String argType, String argName) {
-                return '$argType $argName';
-              }),
-            );
-          }
-
-          addDocumentationComments(indent, method.documentationComments, _docCommentSpec);
-          final String methodReturn;
-          if (method.isAsynchronous) {
-            methodReturn = _voidType;
-            parameters.add('std::function<void($returnTypeName reply)> result');
-          } else {
-            methodReturn = returnTypeName;
-          }
-          _writeFunctionDeclaration(
+          _writeHostMethodDeclaration(
             indent,
-            _makeMethodName(method),
-            returnType: methodReturn,
-            parameters: parameters,
-            isVirtual: true,
-            isPureVirtual: true,
+            method,
+            method.parameters,
+            coroutine: generatorOptions.coroutines,
           );
         }
         indent.newln();
@@ -725,6 +1294,24 @@ class CppHeaderGenerator extends StructuredGenerator<InternalCppOptions> {
             'const std::string& message_channel_suffix',
           ],
         );
+        if (api.methods.any(_usesTaskQueue)) {
+          indent.writeln(
+            '$_commentPrefix Sets up an instance of `${api.name}` to handle messages through the `binary_messenger`, '
+            'running the methods that use a background task queue on `task_queue`, or on the platform thread if it is null.',
+          );
+          _writeFunctionDeclaration(
+            indent,
+            'SetUp',
+            returnType: _voidType,
+            isStatic: true,
+            parameters: <String>[
+              '::flutter::BinaryMessenger* binary_messenger',
+              '${api.name}* api',
+              'const std::string& message_channel_suffix',
+              'std::shared_ptr<PigeonTaskQueue> task_queue',
+            ],
+          );
+        }
         _writeFunctionDeclaration(
           indent,
           'WrapError',
@@ -743,7 +1330,242 @@ class CppHeaderGenerator extends StructuredGenerator<InternalCppOptions> {
       _writeAccessBlock(indent, _ClassAccess.protected, () {
         indent.writeln('${api.name}() = default;');
       });
+      if (_usesHostMethodTable(generatorOptions, api)) {
+        _writeAccessBlock(indent, _ClassAccess.private, () {
+          indent.writeln(
+            '$_commentPrefix Decodes the arguments of a message for one method, calls it and replies. '
+            'These are the entries of the table that `SetUp` registers.',
+          );
+          for (final Method method in api.methods) {
+            _writeFunctionDeclaration(
+              indent,
+              _hostMethodHandlerName(method),
+              returnType: _voidType,
+              isStatic: true,
+              parameters: <String>[
+                '${api.name}* api',
+                'const ::flutter::EncodableValue& message',
+                'const ::flutter::MessageReply<::flutter::EncodableValue>& reply',
+              ],
+            );
+          }
+        });
+      }
+    }, nestCount: 0);
+  }
+
+  @override
+  void writeProxyApi(
+    InternalCppOptions generatorOptions,
+    Root root,
+    Indent indent,
+    AstProxyApi api, {
+    required String dartPackageName,
+  }) {
+    const generatedMessages = <String>[
+      ' Generated class from Pigeon that represents a ProxyApi, whose instances are',
+      ' held in a $_instanceManagerClassName.',
+    ];
+    addDocumentationComments(
+      indent,
+      api.documentationComments,
+      _docCommentSpec,
+      generatorComments: generatedMessages,
+    );
+    indent.write('class ${api.name} ');
+    indent.addScoped('{', '};', () {
+      _writeAccessBlock(indent, _ClassAccess.public, () {
+        indent.writeln(
+          '$_commentPrefix Creates an object to call the ${api.name} methods in Dart, for the',
+        );
+        indent.writeln('$_commentPrefix instances in |instance_manager|.');
+        _writeFunctionDeclaration(
+          indent,
+          api.name,
+          parameters: <String>[
+            '::flutter::BinaryMessenger* binary_messenger',
+            'std::shared_ptr<$_instanceManagerClassName> instance_manager',
+          ],
+        );
+        // Prevent copying/assigning.
+        _writeFunctionDeclaration(
+          indent,
+          api.name,
+          parameters: <String>['const ${api.name}&'],
+          deleted: true,
+        );
+        _writeFunctionDeclaration(
+          indent,
+          'operator=',
+          returnType: '${api.name}&',
+          parameters: <String>['const ${api.name}&'],
+          deleted: true,
+        );
+        // No-op virtual destructor.
+        _writeFunctionDeclaration(indent, '~${api.name}', isVirtual: true, inlineNoop: true);
+        for (final Constructor constructor in api.constructors) {
+          _writeHostMethodDeclaration(
+            indent,
+            _proxyApiConstructorMethod(api, constructor),
+            <NamedType>[...api.unattachedFields, ...constructor.parameters],
+          );
+        }
+        for (final ApiField field in api.attachedFields) {
+          _writeHostMethodDeclaration(indent, _proxyApiAttachedFieldMethod(field), <NamedType>[
+            if (!field.isStatic) _proxyApiInstanceParameter(api),
+          ]);
+        }
+        for (final Method method in api.hostMethods) {
+          _writeHostMethodDeclaration(indent, method, <NamedType>[
+            if (!method.isStatic) _proxyApiInstanceParameter(api),
+            ...method.parameters,
+          ]);
+        }
+        for (final (Method func, String channelMethodName) in _proxyApiFlutterMethods(api)) {
+          if (channelMethodName == _proxyApiNewInstanceMethodName) {
+            indent.writeln(
+              '$_commentPrefix Adds |pigeon_instance| to the instance manager and creates the',
+            );
+            indent.writeln(
+              '$_commentPrefix corresponding Dart instance. Nothing is sent if Dart already has an',
+            );
+            indent.writeln('$_commentPrefix instance for it.');
+          }
+          _writeFlutterMethodDeclaration(
+            indent,
+            func,
+            leadingParameters: <String>['const $_proxyApiInstanceType& pigeon_instance'],
+          );
+        }
+        if (api.hasAnyHostMessageCalls()) {
+          indent.newln();
+          indent.writeln(
+            '$_commentPrefix Sets up an instance of `${api.name}` to handle messages through the `binary_messenger`.',
+          );
+          _writeFunctionDeclaration(
+            indent,
+            'SetUp',
+            returnType: _voidType,
+            isStatic: true,
+            parameters: <String>[
+              '::flutter::BinaryMessenger* binary_messenger',
+              '${api.name}* api',
+            ],
+          );
+          _writeFunctionDeclaration(
+            indent,
+            'WrapError',
+            returnType: '::flutter::EncodableValue',
+            isStatic: true,
+            parameters: <String>['std::string_view error_message'],
+          );
+          _writeFunctionDeclaration(
+            indent,
+            'WrapError',
+            returnType: '::flutter::EncodableValue',
+            isStatic: true,
+            parameters: <String>['const FlutterError& error'],
+          );
+        }
+      });
+      indent.addScoped(' private:', null, () {
+        indent.writeln('::flutter::BinaryMessenger* binary_messenger_;');
+        indent.writeln('std::shared_ptr<$_instanceManagerClassName> instance_manager_;');
+      });
     }, nestCount: 0);
+    indent.newln();
+  }
+
+  /// Writes the declaration of the function that sends the Flutter method
+  /// [func] to Dart, with [leadingParameters] before the method's own.
+  void _writeFlutterMethodDeclaration(
+    Indent indent,
+    Method func, {
+    List<String> leadingParameters = const <String>[],
+  }) {
+    final HostDatatype returnType = _getHostDatatype(
+      func.returnType,
+      _baseCppTypeForBuiltinDartType,
+    );
+    addDocumentationComments(indent, func.documentationComments, _docCommentSpec);
+
+    final Iterable<String> argTypes = func.parameters.map((NamedType arg) {
+      final HostDatatype hostType = _getFieldHostDatatype(arg, _baseCppTypeForBuiltinDartType);
+      return _flutterApiArgumentType(hostType);
+    });
+    final Iterable<String> argNames = indexMap(func.parameters, _getArgumentName);
+    final parameters = <String>[
+      ...leadingParameters,
+      ...map2(argTypes, argNames, (String x, String y) => '$x $y'),
+      ..._flutterApiCallbackParameters(returnType),
+    ];
+    _writeFunctionDeclaration(
+      indent,
+      _makeMethodName(func),
+      returnType: _voidType,
+      parameters: parameters,
+    );
+  }
+
+  /// Writes the declaration of the overload of the Flutter method [func] that
+  /// can be co_awaited.
+  void _writeAwaitableFlutterMethodDeclaration(Indent indent, Method func) {
+    final HostDatatype returnType = _getHostDatatype(
+      func.returnType,
+      _baseCppTypeForBuiltinDartType,
+    );
+    final List<String> parameters = indexMap(func.parameters, (int i, NamedType arg) {
+      final HostDatatype hostType = _getFieldHostDatatype(arg, _baseCppTypeForBuiltinDartType);
+      return '${_flutterApiArgumentType(hostType)} ${_getArgumentName(i, arg)}';
+    }).toList();
+    _writeFunctionDeclaration(
+      indent,
+      _makeMethodName(func),
+      returnType: 'PigeonFlutterApiCall<${_hostApiReturnType(returnType)}>',
+      parameters: parameters,
+    );
+  }
+
+  /// Writes the declaration of the pure virtual function that implements the
+  /// host method [method], which is called with [parameters].
+  ///
+  /// If [coroutine] is true, asynchronous methods return a `PigeonTask`
+  /// rather than taking a callback.
+  void _writeHostMethodDeclaration(
+    Indent indent,
+    Method method,
+    Iterable<NamedType> parameters, {
+    bool coroutine = false,
+  }) {
+    final HostDatatype returnType = _getHostDatatype(
+      method.returnType,
+      _baseCppTypeForBuiltinDartType,
+    );
+    final String returnTypeName = _hostApiReturnType(returnType);
+
+    final List<String> parameterStrings = parameters.map((NamedType arg) {
+      final HostDatatype hostType = _getFieldHostDatatype(arg, _baseCppTypeForBuiltinDartType);
+      return '${_hostApiArgumentType(hostType)} ${_makeVariableName(arg)}';
+    }).toList();
+
+    addDocumentationComments(indent, method.documentationComments, _docCommentSpec);
+    final String methodReturn;
+    if (method.isAsynchronous && coroutine) {
+      methodReturn = 'PigeonTask<$returnTypeName>';
+    } else if (method.isAsynchronous) {
+      methodReturn = _voidType;
+      parameterStrings.add('std::function<void($returnTypeName reply)> result');
+    } else {
+      methodReturn = returnTypeName;
+    }
+    _writeFunctionDeclaration(
+      indent,
+      _makeMethodName(method),
+      returnType: methodReturn,
+      parameters: parameterStrings,
+      isVirtual: true,
+      isPureVirtual: true,
+    );
   }
 
   void _writeClassConstructor(
@@ -751,10 +1573,14 @@ class CppHeaderGenerator extends StructuredGenerator<InternalCppOptions> {
     Indent indent,
     Class classDefinition,
     Iterable<NamedType> params,
-    String docComment,
-  ) {
+    String docComment, {
+    required bool typedCollections,
+  }) {
     final List<String> paramStrings = params.map((NamedType param) {
-      final HostDatatype hostDatatype = getFieldHostDatatype(param, _baseCppTypeForBuiltinDartType);
+      final HostDatatype hostDatatype = _fieldHostDatatype(
+        param,
+        typedCollections: typedCollections,
+      );
       return '${_hostApiArgumentType(hostDatatype)} ${_makeVariableName(param)}';
     }).toList();
     indent.writeln('$_commentPrefix $docComment');
@@ -764,6 +1590,25 @@ class CppHeaderGenerator extends StructuredGenerator<InternalCppOptions> {
       isConstructor: true,
       parameters: paramStrings,
     );
+    // Add a variant that takes ownership of the movable values, so that
+    // callers passing temporaries don't pay for a copy of each of them.
+    if (params.any(
+      (NamedType param) =>
+          _isMovableField(_fieldHostDatatype(param, typedCollections: typedCollections)),
+    )) {
+      _writeFunctionDeclaration(
+        indent,
+        classDefinition.name,
+        isConstructor: true,
+        parameters: params.map((NamedType param) {
+          final HostDatatype hostDatatype = _fieldHostDatatype(
+            param,
+            typedCollections: typedCollections,
+          );
+          return '${_rvalueArgumentType(hostDatatype)} ${_makeVariableName(param)}';
+        }).toList(),
+      );
+    }
     indent.newln();
   }
 
@@ -799,7 +1644,7 @@ class FlutterError {
 template<class T> class ErrorOr {
  public:
 \tErrorOr(const T& rhs) : v_(rhs) {}
-\tErrorOr(const T&& rhs) : v_(std::move(rhs)) {}
+\tErrorOr(T&& rhs) : v_(std::move(rhs)) {}
 \tErrorOr(const FlutterError& rhs) : v_(rhs) {}
 \tErrorOr(const FlutterError&& rhs) : v_(std::move(rhs)) {}
 
@@ -817,6 +1662,600 @@ $friendLines
 ''');
   }
 
+  void _writeByteStreamReader(Indent indent) {
+    indent.format('''
+
+// A stream of bytes that is read one chunk at a time.
+//
+// Host API methods with a @ChunkedBytes annotation take their Uint8List
+// arguments and return their Uint8List result as readers, so that the whole
+// payload doesn't have to be held in memory at once.
+class ByteStreamReader {
+ public:
+\tvirtual ~ByteStreamReader() = default;
+
+\t// Reads the next chunk of at most |max_size| bytes, and passes it to
+\t// |on_chunk| once it is available or passes an error to |on_error|. An empty
+\t// chunk marks the end of the stream.
+\t//
+\t// The stream may be destroyed by the callback that receives its end or an
+\t// error, so it must not be used after calling that callback.
+\tvirtual void ReadChunk(size_t max_size, std::function<void(std::vector<uint8_t> chunk)> on_chunk, std::function<void(const FlutterError& error)> on_error) = 0;
+};''');
+  }
+
+  void _writeTaskQueue(Indent indent) {
+    indent.format('''
+
+// Runs the handlers of host API methods that use a background task queue.
+//
+// Pass an implementation to the `SetUp` of an API to choose the thread its
+// methods are handled on; without one, they are handled on the platform
+// thread.
+class PigeonTaskQueue {
+ public:
+	virtual ~PigeonTaskQueue() = default;
+
+	// Runs |task| off the platform thread. Tasks must run one at a time, in the
+	// order they were posted.
+	virtual void Post(std::function<void()> task) = 0;
+
+	// Runs |send_reply|, which sends the reply to a message handled on this
+	// queue, on the platform thread. It is called from the thread the reply was
+	// created on, and the messenger only accepts replies on the platform thread.
+	virtual void PostReply(std::function<void()> send_reply) = 0;
+};
+
+// A PigeonTaskQueue that runs tasks in order on a worker thread that it owns,
+// and sends replies from a task posted through |post_to_platform_thread|, which
+// must run it on the platform thread.
+//
+// The tasks already posted when the queue is destroyed still run before the
+// worker thread exits.
+class PigeonSerialTaskQueue : public PigeonTaskQueue {
+ public:
+	explicit PigeonSerialTaskQueue(
+		std::function<void(std::function<void()> task)> post_to_platform_thread)
+		: state_(std::make_shared<State>()),
+			post_to_platform_thread_(std::move(post_to_platform_thread)) {
+		thread_ = std::thread([state = state_]() { Run(*state); });
+	}
+
+	~PigeonSerialTaskQueue() override {
+		{
+			std::lock_guard<std::mutex> lock(state_->mutex);
+			state_->stopping = true;
+		}
+		state_->condition.notify_one();
+		// A task can release the last reference to the queue, and the worker
+		// thread can't join itself.
+		if (thread_.get_id() == std::this_thread::get_id()) {
+			thread_.detach();
+		} else {
+			thread_.join();
+		}
+	}
+
+	void Post(std::function<void()> task) override {
+		{
+			std::lock_guard<std::mutex> lock(state_->mutex);
+			state_->tasks.push_back(std::move(task));
+		}
+		state_->condition.notify_one();
+	}
+
+	void PostReply(std::function<void()> send_reply) override {
+		post_to_platform_thread_(std::move(send_reply));
+	}
+
+ private:
+	// The state shared with the worker thread, which outlives the queue if the
+	// thread is detached.
+	struct State {
+		std::mutex mutex;
+		std::condition_variable condition;
+		std::deque<std::function<void()>> tasks;
+		bool stopping = false;
+	};
+
+	static void Run(State& state) {
+		std::unique_lock<std::mutex> lock(state.mutex);
+		while (true) {
+			state.condition.wait(lock, [&state]() {
+				return state.stopping || !state.tasks.empty();
+			});
+			if (state.tasks.empty()) {
+				return;
+			}
+			std::function<void()> task = std::move(state.tasks.front());
+			state.tasks.pop_front();
+			lock.unlock();
+			task();
+			// Releases the task's captures, which can include the queue, before
+			// taking the lock again.
+			task = nullptr;
+			lock.lock();
+		}
+	}
+
+	std::shared_ptr<State> state_;
+	std::function<void(std::function<void()> task)> post_to_platform_thread_;
+	std::thread thread_;
+};
+''');
+  }
+
+  void _writeTask(Indent indent) {
+    indent.format('''
+
+// The result of an asynchronous host API method implemented as a coroutine.
+//
+// The coroutine starts running when it is called, and can be co_awaited by
+// other coroutines. The arguments of a host API method are only valid until
+// it first suspends, so copy any that are needed after a co_await. Exceptions
+// are rethrown to the coroutine awaiting the task; the generated message
+// handlers reply to them with an error.
+template <typename T>
+class PigeonTask {
+ public:
+	class promise_type {
+	 public:
+		PigeonTask get_return_object() {
+			return PigeonTask(std::coroutine_handle<promise_type>::from_promise(*this));
+		}
+		std::suspend_never initial_suspend() noexcept { return {}; }
+		// Stays suspended, so that the task can take the result, and resumes the
+		// coroutine awaiting the task, if any.
+		auto final_suspend() noexcept {
+			struct FinalAwaiter {
+				bool await_ready() noexcept { return false; }
+				std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> handle) noexcept {
+					std::coroutine_handle<> awaiting = handle.promise().awaiting_;
+					return awaiting ? awaiting : std::noop_coroutine();
+				}
+				void await_resume() noexcept {}
+			};
+			return FinalAwaiter{};
+		}
+		void return_value(T value) { result_.emplace(std::move(value)); }
+		void unhandled_exception() { exception_ = std::current_exception(); }
+
+	 private:
+		friend class PigeonTask;
+		std::optional<T> result_;
+		std::exception_ptr exception_;
+		std::coroutine_handle<> awaiting_;
+	};
+
+	PigeonTask(PigeonTask&& other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+	PigeonTask& operator=(PigeonTask&& other) = delete;
+	~PigeonTask() {
+		if (handle_) {
+			handle_.destroy();
+		}
+	}
+
+	bool await_ready() const noexcept { return handle_.done(); }
+	void await_suspend(std::coroutine_handle<> awaiting) noexcept {
+		handle_.promise().awaiting_ = awaiting;
+	}
+	T await_resume() {
+		promise_type& promise = handle_.promise();
+		if (promise.exception_) {
+			std::rethrow_exception(promise.exception_);
+		}
+		return std::move(*promise.result_);
+	}
+
+ private:
+	explicit PigeonTask(std::coroutine_handle<promise_type> handle) : handle_(handle) {}
+
+	std::coroutine_handle<promise_type> handle_;
+};
+''');
+  }
+
+  void _writeFlutterMethodChannel(Indent indent) {
+    indent.format('''
+
+// The channel of a Flutter API method, which the API creates on the first call
+// to the method and reuses for the calls after it.
+//
+// It is shared with the replies to those calls, which use its name to report
+// connection errors.
+class PigeonInternalFlutterMethodChannel {
+ public:
+	PigeonInternalFlutterMethodChannel(::flutter::BinaryMessenger* binary_messenger, std::string name, const ::flutter::MessageCodec<::flutter::EncodableValue>* codec)
+		: name_(std::move(name)), channel_(binary_messenger, name_, codec) {}
+
+	const std::string& name() const { return name_; }
+	::flutter::BasicMessageChannel<>& channel() { return channel_; }
+
+ private:
+	std::string name_;
+	::flutter::BasicMessageChannel<> channel_;
+};''');
+  }
+
+  void _writeFlutterApiCall(Indent indent) {
+    indent.format('''
+
+// A call to a Flutter API method, which sends the message when it is
+// co_awaited and resumes the awaiting coroutine with the result once Dart
+// replies.
+//
+// The message is encoded when the method is called, so the arguments don't
+// need to outlive the call. The call must be co_awaited at most once.
+template <typename T>
+class PigeonFlutterApiCall {
+ public:
+	// Returns the result for the reply to a message sent on |channel_name|.
+	using ReplyDecoder = T (*)(const std::string& channel_name, const uint8_t* reply, size_t reply_size);
+
+	PigeonFlutterApiCall(::flutter::BinaryMessenger* binary_messenger, std::shared_ptr<PigeonInternalFlutterMethodChannel> channel, std::unique_ptr<std::vector<uint8_t>> message, ReplyDecoder decode_reply)
+		: binary_messenger_(binary_messenger), channel_(std::move(channel)), message_(std::move(message)), decode_reply_(decode_reply) {}
+
+	bool await_ready() const noexcept { return false; }
+	void await_suspend(std::coroutine_handle<> awaiting) {
+		// The reply only captures two pointers, so unlike the callbacks of the
+		// other overload it fits in the std::function without an allocation.
+		binary_messenger_->Send(channel_->name(), message_->data(), message_->size(), [this, awaiting](const uint8_t* reply, size_t reply_size) {
+			result_.emplace(decode_reply_(channel_->name(), reply, reply_size));
+			awaiting.resume();
+		});
+	}
+	T await_resume() { return std::move(*result_); }
+
+ private:
+	::flutter::BinaryMessenger* binary_messenger_;
+	std::shared_ptr<PigeonInternalFlutterMethodChannel> channel_;
+	std::unique_ptr<std::vector<uint8_t>> message_;
+	ReplyDecoder decode_reply_;
+	std::optional<T> result_;
+};
+''');
+  }
+
+  void _writeEventChannelSupport(Indent indent) {
+    indent.format('''
+
+// What a PigeonEventSink does with an event that is added from another thread
+// while its queue of unsent events is full.
+enum class PigeonEventOverflowPolicy {
+	// The oldest queued event is dropped to make room.
+	kDropOldest,
+	// The thread adding the event waits until there is room.
+	kBlock
+};
+
+// Options for how a PigeonEventSink sends its events.
+struct PigeonEventSinkOptions {
+	// The maximum number of events sent in one message. When this is greater
+	// than 1, every message is a list of events.
+	size_t max_batch_size = 1;
+	// The maximum number of events that are waiting to be sent, or 0 for no
+	// limit. Events added on the platform thread are never dropped or blocked.
+	size_t max_queued_events = 0;
+	PigeonEventOverflowPolicy overflow_policy =
+		PigeonEventOverflowPolicy::kDropOldest;
+	// Runs a task on the platform thread. When this is set, events added on
+	// other threads are sent from a task posted through it; otherwise they are
+	// sent the next time the sink is used on the platform thread.
+	std::function<void(std::function<void()> task)> post_to_platform_thread;
+};
+
+// Sends the events of an event channel stream to Flutter.
+//
+// Events can be added from any thread, but messages are only sent from the
+// platform thread, which is the thread the stream was listened to on. Events
+// added on the platform thread are sent as soon as they fill a batch; call
+// Flush to send a partial batch. Events added on other threads wait in a queue
+// until they are sent from the platform thread, where a posted task sends all
+// of them, including a partial batch.
+template <typename T>
+class PigeonEventSink {
+ public:
+	using Encoder = ::flutter::EncodableValue (*)(const T& event);
+
+	PigeonEventSink(
+		std::unique_ptr<::flutter::EventSink<::flutter::EncodableValue>> sink,
+		PigeonEventSinkOptions options,
+		Encoder encode)
+		: state_(std::make_shared<State>(std::move(sink), std::move(options))),
+			encode_(encode) {}
+
+	PigeonEventSink(const PigeonEventSink&) = delete;
+	PigeonEventSink& operator=(const PigeonEventSink&) = delete;
+
+	// Adds |event| to the stream.
+	void Success(const T& event) { Add(state_, Entry(encode_(event))); }
+
+	// Adds an error to the stream, after the events that were already added.
+	void Error(const std::string& code,
+		const std::string& message = "",
+		const ::flutter::EncodableValue& details = ::flutter::EncodableValue()) {
+		Add(state_, Entry(FlutterError(code, message, details)));
+	}
+
+	// Ends the stream, after the events that were already added.
+	void EndOfStream() { Add(state_, Entry(EndOfStreamEntry())); }
+
+	// Sends all of the queued events, including a partial batch. Must be called
+	// on the platform thread.
+	void Flush() { Send(*state_, true); }
+
+	// The number of events that were dropped because the queue was full.
+	size_t dropped_event_count() const {
+		std::lock_guard<std::mutex> lock(state_->mutex);
+		return state_->dropped_event_count;
+	}
+
+ private:
+	template <typename U>
+	friend class PigeonInternalEventStreamHandler;
+
+	struct EndOfStreamEntry {};
+	using Entry =
+		std::variant<::flutter::EncodableValue, FlutterError, EndOfStreamEntry>;
+
+	// The state shared with the tasks posted to the platform thread.
+	struct State {
+		State(std::unique_ptr<::flutter::EventSink<::flutter::EncodableValue>> sink,
+			PigeonEventSinkOptions options)
+			: sink(std::move(sink)),
+				options(std::move(options)),
+				platform_thread_id(std::this_thread::get_id()) {}
+
+		std::mutex mutex;
+		std::condition_variable space_available;
+		// Only used on the platform thread.
+		std::unique_ptr<::flutter::EventSink<::flutter::EncodableValue>> sink;
+		const PigeonEventSinkOptions options;
+		const std::thread::id platform_thread_id;
+		std::deque<Entry> entries;
+		// The number of events, as opposed to errors, in |entries|.
+		size_t queued_event_count = 0;
+		size_t dropped_event_count = 0;
+		bool send_posted = false;
+		// Whether the stream was ended or cancelled.
+		bool closed = false;
+	};
+
+	static void Add(const std::shared_ptr<State>& state, Entry entry) {
+		const bool is_event =
+			std::holds_alternative<::flutter::EncodableValue>(entry);
+		const bool on_platform_thread =
+			std::this_thread::get_id() == state->platform_thread_id;
+		const PigeonEventSinkOptions& options = state->options;
+		bool post_send = false;
+		{
+			std::unique_lock<std::mutex> lock(state->mutex);
+			if (is_event && !on_platform_thread && options.max_queued_events > 0) {
+				if (options.overflow_policy == PigeonEventOverflowPolicy::kBlock) {
+					state->space_available.wait(lock, [&state, &options]() {
+						return state->closed ||
+							state->queued_event_count < options.max_queued_events;
+					});
+				} else if (state->queued_event_count >= options.max_queued_events) {
+					state->entries.erase(std::find_if(
+						state->entries.begin(), state->entries.end(),
+						[](const Entry& queued) {
+							return std::holds_alternative<::flutter::EncodableValue>(queued);
+						}));
+					state->queued_event_count--;
+					state->dropped_event_count++;
+				}
+			}
+			if (state->closed) {
+				return;
+			}
+			state->closed = std::holds_alternative<EndOfStreamEntry>(entry);
+			state->entries.push_back(std::move(entry));
+			if (is_event) {
+				state->queued_event_count++;
+			}
+			if (!on_platform_thread && options.post_to_platform_thread &&
+				!state->send_posted) {
+				state->send_posted = true;
+				post_send = true;
+			}
+		}
+		if (on_platform_thread) {
+			Send(*state, false);
+		} else if (post_send) {
+			options.post_to_platform_thread([state]() {
+				{
+					std::lock_guard<std::mutex> lock(state->mutex);
+					state->send_posted = false;
+				}
+				Send(*state, true);
+			});
+		}
+	}
+
+	// Sends the queued entries. Unless |flush| is set, trailing events that
+	// don't fill a batch stay queued.
+	static void Send(State& state, bool flush) {
+		const size_t max_batch_size = state.options.max_batch_size;
+		while (true) {
+			::flutter::EncodableList batch;
+			std::optional<Entry> entry;
+			{
+				std::lock_guard<std::mutex> lock(state.mutex);
+				size_t event_count = 0;
+				while (event_count < state.entries.size() &&
+					event_count < max_batch_size &&
+					std::holds_alternative<::flutter::EncodableValue>(
+						state.entries[event_count])) {
+					event_count++;
+				}
+				if (!state.sink || state.entries.empty() ||
+					(!flush && event_count < max_batch_size &&
+						event_count == state.entries.size())) {
+					return;
+				}
+				if (event_count == 0) {
+					entry = std::move(state.entries.front());
+					state.entries.pop_front();
+				} else {
+					batch.reserve(event_count);
+					for (size_t i = 0; i < event_count; i++) {
+						batch.push_back(std::get<::flutter::EncodableValue>(
+							std::move(state.entries.front())));
+						state.entries.pop_front();
+					}
+					state.queued_event_count -= event_count;
+				}
+			}
+			state.space_available.notify_all();
+			if (!entry) {
+				if (max_batch_size > 1) {
+					state.sink->Success(::flutter::EncodableValue(std::move(batch)));
+				} else {
+					state.sink->Success(batch[0]);
+				}
+			} else if (const FlutterError* error = std::get_if<FlutterError>(&*entry)) {
+				state.sink->Error(error->code(), error->message(), error->details());
+			} else {
+				state.sink->EndOfStream();
+			}
+		}
+	}
+
+	// Stops sending events, and wakes the threads waiting to add one. Called on
+	// the platform thread when Flutter stops listening.
+	void Cancel() {
+		{
+			std::lock_guard<std::mutex> lock(state_->mutex);
+			state_->closed = true;
+			state_->sink = nullptr;
+			state_->entries.clear();
+			state_->queued_event_count = 0;
+		}
+		state_->space_available.notify_all();
+	}
+
+	std::shared_ptr<State> state_;
+	const Encoder encode_;
+};
+
+// Handles the listen and cancel requests of an event channel stream.
+template <typename T>
+class PigeonEventStreamHandler {
+ public:
+	virtual ~PigeonEventStreamHandler() = default;
+
+	// Called on the platform thread when Flutter starts listening to the
+	// stream. Events added to |sink| are sent until OnCancel is called.
+	virtual void OnListen(std::shared_ptr<PigeonEventSink<T>> sink) = 0;
+
+	// Called on the platform thread when Flutter stops listening to the stream.
+	virtual void OnCancel() {}
+};
+
+// Adapts a PigeonEventStreamHandler to the StreamHandler of an EventChannel.
+template <typename T>
+class PigeonInternalEventStreamHandler
+	: public ::flutter::StreamHandler<::flutter::EncodableValue> {
+ public:
+	PigeonInternalEventStreamHandler(
+		PigeonEventSinkOptions options,
+		typename PigeonEventSink<T>::Encoder encode,
+		std::shared_ptr<PigeonEventStreamHandler<T>> handler)
+		: options_(std::move(options)),
+			encode_(encode),
+			handler_(std::move(handler)) {}
+
+	~PigeonInternalEventStreamHandler() override {
+		if (sink_) {
+			sink_->Cancel();
+		}
+	}
+
+ protected:
+	std::unique_ptr<::flutter::StreamHandlerError<::flutter::EncodableValue>>
+	OnListenInternal(
+		const ::flutter::EncodableValue* arguments,
+		std::unique_ptr<::flutter::EventSink<::flutter::EncodableValue>>&& events)
+		override {
+		if (sink_) {
+			sink_->Cancel();
+		}
+		sink_ = std::make_shared<PigeonEventSink<T>>(std::move(events), options_,
+			encode_);
+		handler_->OnListen(sink_);
+		return nullptr;
+	}
+
+	std::unique_ptr<::flutter::StreamHandlerError<::flutter::EncodableValue>>
+	OnCancelInternal(const ::flutter::EncodableValue* arguments) override {
+		if (sink_) {
+			sink_->Cancel();
+			sink_ = nullptr;
+		}
+		handler_->OnCancel();
+		return nullptr;
+	}
+
+ private:
+	const PigeonEventSinkOptions options_;
+	const typename PigeonEventSink<T>::Encoder encode_;
+	std::shared_ptr<PigeonEventStreamHandler<T>> handler_;
+	std::shared_ptr<PigeonEventSink<T>> sink_;
+};
+''');
+  }
+
+  @override
+  void writeEventChannelApi(
+    InternalCppOptions generatorOptions,
+    Root root,
+    Indent indent,
+    AstEventChannelApi api, {
+    required String dartPackageName,
+  }) {
+    for (final Method func in api.methods) {
+      final String eventType = getHostDatatype(
+        func.returnType,
+        _baseCppTypeForBuiltinDartType,
+      ).datatype;
+      final handlerName = '${_pascalCaseFromCamelCase(func.name)}StreamHandler';
+      addDocumentationComments(
+        indent,
+        func.documentationComments,
+        _docCommentSpec,
+        generatorComments: <String>[
+          ' Generated class from Pigeon that handles the `${func.name}` stream of ${api.name}.',
+        ],
+      );
+      indent.write('class $handlerName : public PigeonEventStreamHandler<$eventType> ');
+      indent.addScoped('{', '};', () {
+        _writeAccessBlock(indent, _ClassAccess.public, () {
+          indent.writeln(
+            '$_commentPrefix Sets `stream_handler` to handle the stream on the channel for `instance_name`, or removes the handler if it is null.',
+          );
+          indent.writeln('$_commentPrefix');
+          indent.writeln(
+            '$_commentPrefix If `post_to_platform_thread` is set, it is used to send the events that are added on other threads.',
+          );
+          _writeFunctionDeclaration(
+            indent,
+            'Register',
+            returnType: _voidType,
+            isStatic: true,
+            parameters: <String>[
+              '::flutter::BinaryMessenger* binary_messenger',
+              'std::shared_ptr<$handlerName> stream_handler',
+              'const std::string& instance_name = ""',
+              'std::function<void(std::function<void()> task)> post_to_platform_thread = nullptr',
+            ],
+          );
+        });
+      }, nestCount: 0);
+      indent.newln();
+    }
+  }
+
   @override
   void writeCloseNamespace(
     InternalCppOptions generatorOptions,
@@ -867,7 +2306,9 @@ class CppSourceGenerator extends StructuredGenerator<InternalCppOptions> {
       'flutter/basic_message_channel.h',
       'flutter/binary_messenger.h',
       'flutter/encodable_value.h',
+      if (root.containsEventChannel) 'flutter/event_channel.h',
       'flutter/standard_message_codec.h',
+      if (root.containsEventChannel) 'flutter/standard_method_codec.h',
     ]);
     indent.newln();
     _writeSystemHeaderIncludeBlock(indent, <String>[
@@ -877,6 +2318,17 @@ class CppSourceGenerator extends StructuredGenerator<InternalCppOptions> {
       'string',
       'optional',
       'sstream',
+      if (_hasTaskQueueMethods(root)) 'vector',
+      if (root.containsProxyApi) ...<String>['cstdint', 'utility', 'vector'],
+      if (_streamDecodedClasses(root).isNotEmpty) ...<String>[
+        'any',
+        'stdexcept',
+        'type_traits',
+        'utility',
+      ],
+      if (_hasCoroutineHostMethods(generatorOptions, root)) ...<String>['coroutine', 'exception'],
+      if (hasChunkedBytesMethods(root)) ...<String>['functional', 'memory', 'vector'],
+      if (root.classes.any((Class x) => x.isColumnar)) ...<String>['stdexcept', 'utility'],
     ]);
     indent.newln();
   }
@@ -926,17 +2378,681 @@ class CppSourceGenerator extends StructuredGenerator<InternalCppOptions> {
       },
     );
     indent.writeln('namespace {');
-    _writeDeepEquals(indent);
-    _writeDeepHash(indent);
-    _writeDeepToString(indent);
+    _writeDeepEquals(indent, typedCollections: generatorOptions.typedCollections);
+    _writeDeepHash(indent, typedCollections: generatorOptions.typedCollections);
+    _writeDeepToString(indent, typedCollections: generatorOptions.typedCollections);
+    if (generatorOptions.typedCollections) {
+      _writeTypedCollectionConversions(indent);
+    }
+    if (_hasTaskQueueMethods(root)) {
+      _writeTaskQueueSupport(indent);
+    }
+    if (root.apis.whereType<AstHostApi>().any(
+      (AstHostApi api) => _usesHostMethodTable(generatorOptions, api),
+    )) {
+      _writeHostMethodTableSupport(indent, usesTaskQueues: _hasTaskQueueMethods(root));
+    }
+    if (_hasCoroutineHostMethods(generatorOptions, root)) {
+      _writeCoroutineHostMethodSupport(indent);
+    }
+    if (hasChunkedBytesMethods(root)) {
+      _writeChunkedBytesSupport(indent);
+    }
     indent.writeln('}  // namespace');
   }
 
-  @override
-  void writeDataClass(
-    InternalCppOptions generatorOptions,
-    Root root,
-    Indent indent,
+  /// Writes the classes that move the Uint8Lists of `@ChunkedBytes` methods
+  /// to and from Dart in chunks.
+  void _writeChunkedBytesSupport(Indent indent) {
+    indent.format('''
+// Reads a Uint8List argument by requesting each chunk from Dart on the channel
+// that it sent in place of the bytes.
+class PigeonInternalChannelByteStreamReader : public ByteStreamReader {
+ public:
+	PigeonInternalChannelByteStreamReader(
+			::flutter::BinaryMessenger* binary_messenger, std::string channel_name)
+			: binary_messenger_(binary_messenger),
+				channel_name_(std::move(channel_name)) {}
+
+	void ReadChunk(
+			size_t max_size,
+			std::function<void(std::vector<uint8_t> chunk)> on_chunk,
+			std::function<void(const FlutterError& error)> on_error) override {
+		std::unique_ptr<std::vector<uint8_t>> message =
+				::flutter::StandardMessageCodec::GetInstance().EncodeMessage(
+						EncodableValue(static_cast<int64_t>(max_size)));
+		// The callbacks can destroy this reader, so the reply doesn't use it.
+		binary_messenger_->Send(
+				channel_name_, message->data(), message->size(),
+				[channel_name = channel_name_, on_chunk = std::move(on_chunk),
+				 on_error = std::move(on_error)](const uint8_t* reply, size_t reply_size) {
+					std::unique_ptr<EncodableValue> response =
+							::flutter::StandardMessageCodec::GetInstance().DecodeMessage(
+									reply, reply_size);
+					auto* chunk = response ? std::get_if<std::vector<uint8_t>>(response.get()) : nullptr;
+					if (chunk == nullptr) {
+						on_error(CreateConnectionError(channel_name));
+						return;
+					}
+					on_chunk(std::move(*chunk));
+				});
+	}
+
+ private:
+	::flutter::BinaryMessenger* binary_messenger_;
+	std::string channel_name_;
+};
+
+// The streams that a host method returned in place of Uint8Lists, which Dart
+// reads by ID in chunks until it reaches the end.
+class PigeonInternalByteStreams
+		: public std::enable_shared_from_this<PigeonInternalByteStreams> {
+ public:
+	// Takes ownership of |stream| until it is read to the end or fails, and
+	// returns the ID that Dart reads it by.
+	int64_t Add(std::unique_ptr<ByteStreamReader> stream) {
+		const int64_t id = next_id_++;
+		streams_[id] = std::move(stream);
+		return id;
+	}
+
+	// Replies to |message|, a request of [stream ID, maximum size], with the
+	// next chunk of the stream.
+	void ReadChunk(const EncodableValue& message,
+			const ::flutter::MessageReply<EncodableValue>& reply) {
+		const auto& args = std::get<EncodableList>(message);
+		const int64_t id = args.at(0).LongValue();
+		const int64_t max_size = args.at(1).LongValue();
+		auto it = streams_.find(id);
+		if (it == streams_.end()) {
+			reply(EncodableValue(EncodableList{
+					EncodableValue("unknown-stream"),
+					EncodableValue("No stream with ID " + std::to_string(id) + "."),
+					EncodableValue()}));
+			return;
+		}
+		std::weak_ptr<PigeonInternalByteStreams> weak_self = weak_from_this();
+		// Removing the stream destroys the callback that removes it, so each
+		// callback replies first and only uses locals afterwards.
+		it->second->ReadChunk(
+				static_cast<size_t>(max_size),
+				[weak_self, id, reply](std::vector<uint8_t> chunk) {
+					const bool is_end = chunk.empty();
+					reply(EncodableValue(EncodableList{EncodableValue(std::move(chunk))}));
+					std::shared_ptr<PigeonInternalByteStreams> self = weak_self.lock();
+					if (is_end && self) {
+						const int64_t stream_id = id;
+						self->streams_.erase(stream_id);
+					}
+				},
+				[weak_self, id, reply](const FlutterError& error) {
+					reply(EncodableValue(EncodableList{
+							EncodableValue(error.code()), EncodableValue(error.message()),
+							error.details()}));
+					std::shared_ptr<PigeonInternalByteStreams> self = weak_self.lock();
+					if (self) {
+						const int64_t stream_id = id;
+						self->streams_.erase(stream_id);
+					}
+				});
+	}
+
+ private:
+	std::map<int64_t, std::unique_ptr<ByteStreamReader>> streams_;
+	int64_t next_id_ = 0;
+};
+''');
+  }
+
+  /// Writes the helper that replies to a message once the `PigeonTask`
+  /// returned by a coroutine host method completes.
+  void _writeCoroutineHostMethodSupport(Indent indent) {
+    indent.format('''
+// A coroutine that nothing awaits, which frees itself when it completes.
+struct PigeonInternalDetachedTask {
+	struct promise_type {
+		PigeonInternalDetachedTask get_return_object() { return {}; }
+		std::suspend_never initial_suspend() noexcept { return {}; }
+		std::suspend_never final_suspend() noexcept { return {}; }
+		void return_void() {}
+		void unhandled_exception() { std::terminate(); }
+	};
+};
+
+// Awaits |task| and calls |on_done| with its result, or with an error for the
+// exception it threw.
+//
+// |task| is taken by value so that it lives in this coroutine's frame, and the
+// message handler can return before the method completes.
+template <typename T, typename OnDone>
+PigeonInternalDetachedTask PigeonInternalReplyWhenDone(PigeonTask<T> task,
+	OnDone on_done) {
+	std::optional<T> result;
+	try {
+		result.emplace(co_await task);
+	} catch (const std::exception& exception) {
+		result.emplace(FlutterError(exception.what(), "Error"));
+	}
+	on_done(std::move(*result));
+}
+''');
+  }
+
+  /// Writes the table entry type and the shared `SetUp` of table-driven host
+  /// APIs.
+  ///
+  /// The dispatcher is a template, so it and its handler lambda are compiled
+  /// once per API rather than once per method.
+  void _writeHostMethodTableSupport(Indent indent, {required bool usesTaskQueues}) {
+    final taskQueueField = usesTaskQueues
+        ? '''
+	// Whether the method runs on the API's task queue.
+	bool uses_task_queue;
+'''
+        : '';
+    final taskQueueParameter = usesTaskQueues
+        ? ',\n\tstd::shared_ptr<PigeonTaskQueue> task_queue'
+        : '';
+    final setHandler = usesTaskQueues
+        ? '''
+		if (method.uses_task_queue) {
+			PigeonInternalSetTaskQueueMessageHandler(binary_messenger, channel_name,
+				&Api::GetCodec(), task_queue, std::move(handler));
+			continue;
+		}
+'''
+        : '';
+    indent.format('''
+// An entry in the table of a host API's methods.
+template <typename Api>
+struct PigeonInternalHostMethod {
+	// The method's name, which ends its channel name.
+	const char* name;
+	// Decodes the arguments of a message, calls the method and replies.
+	void (*handle)(Api* api, const EncodableValue& message,
+		const ::flutter::MessageReply<EncodableValue>& reply);
+$taskQueueField};
+
+// Sets up |api| to handle the messages for each of |methods|, on the channels
+// named |channel_prefix| followed by the method name and suffix.
+//
+// Clears the handlers if |api| is null.
+template <typename Api, size_t N>
+void PigeonInternalSetUpHostMethods(
+	::flutter::BinaryMessenger* binary_messenger, Api* api,
+	const char* channel_prefix, const std::string& message_channel_suffix,
+	const PigeonInternalHostMethod<Api> (&methods)[N]$taskQueueParameter) {
+	std::string channel_name(channel_prefix);
+	const size_t prefix_length = channel_name.size();
+	for (const PigeonInternalHostMethod<Api>& method : methods) {
+		channel_name.resize(prefix_length);
+		channel_name.append(method.name);
+		if (!message_channel_suffix.empty()) {
+			channel_name.push_back('.');
+			channel_name.append(message_channel_suffix);
+		}
+		if (api == nullptr) {
+			binary_messenger->SetMessageHandler(channel_name, nullptr);
+			continue;
+		}
+		::flutter::MessageHandler<EncodableValue> handler =
+			[api, handle = method.handle](
+				const EncodableValue& message,
+				const ::flutter::MessageReply<EncodableValue>& reply) {
+				try {
+					handle(api, message, reply);
+				} catch (const std::exception& exception) {
+					// As in the handlers of APIs without a table, this errs on the
+					// side of replying twice rather than not at all.
+					reply(Api::WrapError(exception.what()));
+				}
+			};
+$setHandler		BasicMessageChannel<>(binary_messenger, channel_name, &Api::GetCodec())
+			.SetMessageHandler(std::move(handler));
+	}
+}
+''');
+  }
+
+  void _writeTaskQueueSupport(Indent indent) {
+    indent.format('''
+// Sets |handler| to handle the messages on |channel_name| on |task_queue|, or
+// on the platform thread if |task_queue| is null.
+//
+// Messages are decoded, handled and their replies encoded on the queue, and
+// the encoded replies are sent through PigeonTaskQueue::PostReply.
+void PigeonInternalSetTaskQueueMessageHandler(
+	::flutter::BinaryMessenger* binary_messenger,
+	const std::string& channel_name,
+	const ::flutter::StandardMessageCodec* codec,
+	std::shared_ptr<PigeonTaskQueue> task_queue,
+	::flutter::MessageHandler<EncodableValue> handler) {
+	if (!task_queue) {
+		BasicMessageChannel<> channel(binary_messenger, channel_name, codec);
+		channel.SetMessageHandler(std::move(handler));
+		return;
+	}
+	binary_messenger->SetMessageHandler(channel_name,
+		[codec, task_queue, handler = std::move(handler)](
+			const uint8_t* message, size_t message_size,
+			::flutter::BinaryReply binary_reply) {
+			// The message is only valid during this call, so the task gets a copy.
+			task_queue->Post([codec, task_queue, handler,
+				bytes = std::vector<uint8_t>(message, message + message_size),
+				binary_reply = std::move(binary_reply)]() {
+				std::unique_ptr<EncodableValue> decoded = codec->DecodeMessage(bytes);
+				if (!decoded) {
+					task_queue->PostReply([binary_reply]() { binary_reply(nullptr, 0); });
+					return;
+				}
+				handler(*decoded, [codec, task_queue, binary_reply](const EncodableValue& response) {
+					std::shared_ptr<std::vector<uint8_t>> encoded = codec->EncodeMessage(response);
+					task_queue->PostReply([binary_reply, encoded]() {
+						binary_reply(encoded->data(), encoded->size());
+					});
+				});
+			});
+		});
+}
+''');
+  }
+
+  @override
+  void writeInstanceManager(
+    InternalCppOptions generatorOptions,
+    Root root,
+    Indent indent, {
+    required String dartPackageName,
+  }) {
+    const manager = _instanceManagerClassName;
+    indent.format('''
+
+const ::flutter::StandardMessageCodec& $manager::GetCodec() const {
+\treturn ::flutter::StandardMessageCodec::GetInstance(codec_serializer_.get());
+}
+
+$manager::IdentifierShard& $manager::GetIdentifierShard(int64_t identifier) const {
+\treturn identifier_shards_[static_cast<uint64_t>(identifier) % kShardCount];
+}
+
+$manager::InstanceShard& $manager::GetInstanceShard(const void* instance) const {
+\t// The low bits of an address are the same for every allocation, so they are
+\t// skipped.
+\treturn instance_shards_[(reinterpret_cast<uintptr_t>(instance) >> 4) % kShardCount];
+}
+
+int64_t $manager::FindIdentifier(const InstanceShard& shard, const void* instance) const {
+\tauto it = shard.identifiers.find(instance);
+\tif (it == shard.identifiers.end()) {
+\t\treturn -1;
+\t}
+\tconst IdentifierShard& identifier_shard = GetIdentifierShard(it->second);
+\tstd::lock_guard<std::mutex> lock(identifier_shard.mutex);
+\tauto entry = identifier_shard.entries.find(it->second);
+\tif (entry == identifier_shard.entries.end() ||
+\t\t\t(entry->second.strong_reference == nullptr && entry->second.weak_reference.expired())) {
+\t\treturn -1;
+\t}
+\treturn it->second;
+}
+
+bool $manager::AddInstance($_proxyApiInstanceType instance, int64_t identifier) {
+\tInstanceShard& instance_shard = GetInstanceShard(instance.get());
+\tstd::lock_guard<std::mutex> instance_lock(instance_shard.mutex);
+\tif (FindIdentifier(instance_shard, instance.get()) >= 0) {
+\t\treturn false;
+\t}
+\tIdentifierShard& identifier_shard = GetIdentifierShard(identifier);
+\t{
+\t\tstd::lock_guard<std::mutex> identifier_lock(identifier_shard.mutex);
+\t\tEntry& entry = identifier_shard.entries[identifier];
+\t\tif (entry.strong_reference != nullptr || !entry.weak_reference.expired()) {
+\t\t\treturn false;
+\t\t}
+\t\tentry.instance = instance.get();
+\t\tentry.weak_reference = instance;
+\t\tentry.strong_reference = instance;
+\t}
+\tinstance_shard.identifiers[instance.get()] = identifier;
+\treturn true;
+}
+
+bool $manager::AddDartCreatedInstance($_proxyApiInstanceType instance, int64_t identifier) {
+\tif (instance == nullptr || identifier < 0) {
+\t\treturn false;
+\t}
+\treturn AddInstance(std::move(instance), identifier);
+}
+
+int64_t $manager::AddHostCreatedInstance($_proxyApiInstanceType instance) {
+\tif (instance == nullptr) {
+\t\treturn -1;
+\t}
+\tconst int64_t identifier = next_identifier_.fetch_add(1);
+\treturn AddInstance(std::move(instance), identifier) ? identifier : -1;
+}
+
+$_proxyApiInstanceType $manager::GetInstance(int64_t identifier) const {
+\tconst IdentifierShard& shard = GetIdentifierShard(identifier);
+\tstd::lock_guard<std::mutex> lock(shard.mutex);
+\tauto it = shard.entries.find(identifier);
+\treturn it != shard.entries.end() ? it->second.weak_reference.lock() : nullptr;
+}
+
+int64_t $manager::GetIdentifier(const void* instance) {
+\tInstanceShard& instance_shard = GetInstanceShard(instance);
+\tstd::lock_guard<std::mutex> instance_lock(instance_shard.mutex);
+\tauto it = instance_shard.identifiers.find(instance);
+\tif (it == instance_shard.identifiers.end()) {
+\t\treturn -1;
+\t}
+\tIdentifierShard& identifier_shard = GetIdentifierShard(it->second);
+\tstd::lock_guard<std::mutex> identifier_lock(identifier_shard.mutex);
+\tauto entry = identifier_shard.entries.find(it->second);
+\tif (entry == identifier_shard.entries.end()) {
+\t\treturn -1;
+\t}
+\tif (entry->second.strong_reference == nullptr) {
+\t\tentry->second.strong_reference = entry->second.weak_reference.lock();
+\t\tif (entry->second.strong_reference == nullptr) {
+\t\t\treturn -1;
+\t\t}
+\t}
+\treturn it->second;
+}
+
+bool $manager::ContainsInstance(const void* instance) const {
+\tconst InstanceShard& shard = GetInstanceShard(instance);
+\tstd::lock_guard<std::mutex> lock(shard.mutex);
+\treturn FindIdentifier(shard, instance) >= 0;
+}
+
+void $manager::Remove(int64_t identifier) {
+\t// The reference is released once the lock is no longer held, since this
+\t// may destroy the instance.
+\t$_proxyApiInstanceType strong_reference;
+\tIdentifierShard& shard = GetIdentifierShard(identifier);
+\tstd::lock_guard<std::mutex> lock(shard.mutex);
+\tauto it = shard.entries.find(identifier);
+\tif (it == shard.entries.end() || it->second.strong_reference == nullptr) {
+\t\treturn;
+\t}
+\tstrong_reference = std::move(it->second.strong_reference);
+\tif (!it->second.is_released) {
+\t\tit->second.is_released = true;
+\t\tshard.released_identifiers.push_back(identifier);
+\t}
+}
+
+void $manager::Clear() {
+\t// The references are released once no lock is held, since this may destroy
+\t// instances.
+\tstd::vector<std::unordered_map<int64_t, Entry>> entries;
+\tfor (InstanceShard& shard : instance_shards_) {
+\t\tstd::lock_guard<std::mutex> lock(shard.mutex);
+\t\tshard.identifiers.clear();
+\t}
+\tfor (IdentifierShard& shard : identifier_shards_) {
+\t\tstd::lock_guard<std::mutex> lock(shard.mutex);
+\t\tentries.push_back(std::move(shard.entries));
+\t\tshard.entries.clear();
+\t\tshard.released_identifiers.clear();
+\t}
+}
+''');
+  }
+
+  @override
+  void writeInstanceManagerApi(
+    InternalCppOptions generatorOptions,
+    Root root,
+    Indent indent, {
+    required String dartPackageName,
+  }) {
+    const manager = _instanceManagerClassName;
+    final String removeStrongReferenceChannelName = makeRemoveStrongReferenceChannelName(
+      dartPackageName,
+    );
+    final String removeStrongReferencesChannelName = makeRemoveStrongReferencesChannelName(
+      dartPackageName,
+    );
+    final String clearChannelName = makeClearChannelName(dartPackageName);
+    const codec = '&::flutter::StandardMessageCodec::GetInstance()';
+    indent.format('''
+$manager::$manager(::flutter::BinaryMessenger* binary_messenger)
+ : binary_messenger_(binary_messenger),
+\t\tcodec_serializer_(std::make_unique<$_proxyApiCodecSerializerName>(this)),
+\t\tnext_identifier_(kMinHostCreatedIdentifier) {
+\tBasicMessageChannel<> remove_strong_reference_channel(
+\t\t\tbinary_messenger, "$removeStrongReferenceChannelName", $codec);
+\tremove_strong_reference_channel.SetMessageHandler([this](const EncodableValue& message, const ::flutter::MessageReply<EncodableValue>& reply) {
+\t\ttry {
+\t\t\tconst auto& args = std::get<EncodableList>(message);
+\t\t\tRemove(args.at(0).LongValue());
+\t\t\treply(EncodableValue(EncodableList{EncodableValue()}));
+\t\t} catch (const std::exception& exception) {
+\t\t\treply(EncodableValue(EncodableList{
+\t\t\t\tEncodableValue(std::string(exception.what())),
+\t\t\t\tEncodableValue("Error"),
+\t\t\t\tEncodableValue()
+\t\t\t}));
+\t\t\treturn;
+\t\t}
+\t\t// Dart may have released the last reference to the instance.
+\t\tReleaseDestroyedInstances();
+\t});
+\tBasicMessageChannel<> clear_channel(binary_messenger, "$clearChannelName", $codec);
+\tclear_channel.SetMessageHandler([this](const EncodableValue& message, const ::flutter::MessageReply<EncodableValue>& reply) {
+\t\tClear();
+\t\treply(EncodableValue(EncodableList{EncodableValue()}));
+\t});
+}
+
+$manager::~$manager() {
+\tBasicMessageChannel<> remove_strong_reference_channel(
+\t\t\tbinary_messenger_, "$removeStrongReferenceChannelName", $codec);
+\tremove_strong_reference_channel.SetMessageHandler(nullptr);
+\tBasicMessageChannel<> clear_channel(binary_messenger_, "$clearChannelName", $codec);
+\tclear_channel.SetMessageHandler(nullptr);
+\tClear();
+}
+
+size_t $manager::ReleaseDestroyedInstances() {
+\tstd::vector<std::pair<int64_t, const void*>> destroyed;
+\tfor (IdentifierShard& shard : identifier_shards_) {
+\t\tstd::lock_guard<std::mutex> lock(shard.mutex);
+\t\tsize_t released_count = 0;
+\t\tfor (int64_t identifier : shard.released_identifiers) {
+\t\t\tauto it = shard.entries.find(identifier);
+\t\t\tif (it == shard.entries.end()) {
+\t\t\t\tcontinue;
+\t\t\t}
+\t\t\tEntry& entry = it->second;
+\t\t\tif (entry.strong_reference != nullptr) {
+\t\t\t\t// The instance was sent to Dart again.
+\t\t\t\tentry.is_released = false;
+\t\t\t} else if (entry.weak_reference.expired()) {
+\t\t\t\tdestroyed.emplace_back(identifier, entry.instance);
+\t\t\t\tshard.entries.erase(it);
+\t\t\t} else {
+\t\t\t\tshard.released_identifiers[released_count++] = identifier;
+\t\t\t}
+\t\t}
+\t\tshard.released_identifiers.resize(released_count);
+\t}
+\tif (destroyed.empty()) {
+\t\treturn 0;
+\t}
+
+\tstd::vector<int64_t> identifiers;
+\tidentifiers.reserve(destroyed.size());
+\tfor (const auto& [identifier, instance] : destroyed) {
+\t\tInstanceShard& shard = GetInstanceShard(instance);
+\t\tstd::lock_guard<std::mutex> lock(shard.mutex);
+\t\tauto it = shard.identifiers.find(instance);
+\t\t// The address may already belong to an instance added since.
+\t\tif (it != shard.identifiers.end() && it->second == identifier) {
+\t\t\tshard.identifiers.erase(it);
+\t\t}
+\t\tidentifiers.push_back(identifier);
+\t}
+\t// All of the identifiers are sent to Dart in a single message.
+\tBasicMessageChannel<> channel(binary_messenger_, "$removeStrongReferencesChannelName", $codec);
+\tchannel.Send(EncodableValue(EncodableList{EncodableValue(std::move(identifiers))}));
+\treturn destroyed.size();
+}
+''');
+    if (root.apis.whereType<AstProxyApi>().any(
+      (AstProxyApi api) => api.constructors.isNotEmpty || api.attachedFields.isNotEmpty,
+    )) {
+      indent.format('''
+namespace {
+// Returns the reply to a ProxyApi constructor or attached field, adding the
+// instance in |output| with the |identifier| Dart assigned to it.
+EncodableValue PigeonInternalNewInstanceReply(
+\t\t$manager* instance_manager,
+\t\tconst ErrorOr<$_proxyApiInstanceType>& output,
+\t\tint64_t identifier) {
+\tif (output.has_error()) {
+\t\treturn EncodableValue(EncodableList{
+\t\t\tEncodableValue(output.error().code()),
+\t\t\tEncodableValue(output.error().message()),
+\t\t\toutput.error().details()
+\t\t});
+\t}
+\tif (output.value() == nullptr) {
+\t\treturn EncodableValue(EncodableList{
+\t\t\tEncodableValue("null-instance-error"),
+\t\t\tEncodableValue("No instance was created"),
+\t\t\tEncodableValue()
+\t\t});
+\t}
+\tif (!instance_manager->AddDartCreatedInstance(output.value(), identifier)) {
+\t\treturn EncodableValue(EncodableList{
+\t\t\tEncodableValue("instance-manager-error"),
+\t\t\tEncodableValue("The instance or identifier has already been added"),
+\t\t\tEncodableValue()
+\t\t});
+\t}
+\treturn EncodableValue(EncodableList{EncodableValue()});
+}
+}  // namespace
+''');
+    }
+  }
+
+  @override
+  void writeDataClasses(
+    InternalCppOptions generatorOptions,
+    Root root,
+    Indent indent, {
+    required String dartPackageName,
+  }) {
+    super.writeDataClasses(generatorOptions, root, indent, dartPackageName: dartPackageName);
+    for (final Class classDefinition in root.classes.where((Class x) => x.isColumnar)) {
+      _writeColumnsClass(indent, classDefinition);
+    }
+  }
+
+  /// Writes the definitions of the class that holds a list of the `@Columnar`
+  /// [classDefinition] as one array per field.
+  void _writeColumnsClass(Indent indent, Class classDefinition) {
+    final String className = _columnsClassName(classDefinition);
+    final List<NamedType> orderedFields = getFieldsInSerializationOrder(classDefinition).toList();
+    indent.writeln('$_commentPrefix $className');
+    indent.newln();
+    _writeFunctionDefinition(
+      indent,
+      className,
+      scope: className,
+      initializers: <String>[
+        '$className(${orderedFields.map((NamedType field) => '${_columnType(field.type, includeFlutterNamespace: false)}()').join(', ')})',
+      ],
+    );
+    _writeFunctionDefinition(
+      indent,
+      className,
+      scope: className,
+      parameters: orderedFields
+          .map(
+            (NamedType field) =>
+                '${_columnType(field.type, includeFlutterNamespace: false)} ${_makeVariableName(field)}',
+          )
+          .toList(),
+      body: () {
+        // The columns are moved in one at a time, since an initializer list
+        // would copy them.
+        indent.writeln('columns_.reserve(${orderedFields.length});');
+        for (final field in orderedFields) {
+          indent.writeln('columns_.emplace_back(std::move(${_makeVariableName(field)}));');
+        }
+      },
+    );
+    _writeFunctionDefinition(
+      indent,
+      'size',
+      scope: className,
+      returnType: 'size_t',
+      isConst: true,
+      body: () {
+        indent.writeln('return ${_makeGetterName(orderedFields.first)}().size();');
+      },
+    );
+    enumerate(orderedFields, (int index, NamedType field) {
+      final String columnType = _columnType(field.type, includeFlutterNamespace: false);
+      _writeFunctionDefinition(
+        indent,
+        _makeGetterName(field),
+        scope: className,
+        returnType: 'const $columnType&',
+        isConst: true,
+        body: () {
+          indent.writeln('return std::get<$columnType>(columns_[$index]);');
+        },
+      );
+    });
+    _writeFunctionDefinition(
+      indent,
+      'FromEncodableList',
+      scope: className,
+      returnType: className,
+      parameters: <String>['EncodableList&& list'],
+      body: () {
+        indent.writeScoped('if (list.size() != ${orderedFields.length}) {', '}', () {
+          indent.writeln(
+            'throw std::runtime_error("Expected ${orderedFields.length} columns of ${classDefinition.name}, but got " + std::to_string(list.size()));',
+          );
+        });
+        // The getters and size() rely on every column having the expected type
+        // and the same length.
+        enumerate(orderedFields, (int index, NamedType field) {
+          final String columnType = _columnType(field.type, includeFlutterNamespace: false);
+          final columnName = '${_makeVariableName(field)}_column';
+          indent.writeln('const auto* $columnName = std::get_if<$columnType>(&list[$index]);');
+          final String condition = index == 0
+              ? '$columnName == nullptr'
+              : '$columnName == nullptr || $columnName->size() != size';
+          indent.writeScoped('if ($condition) {', '}', () {
+            indent.writeln(
+              'throw std::runtime_error("The ${_makeVariableName(field)} column of ${classDefinition.name} does not match the other columns.");',
+            );
+          });
+          if (index == 0) {
+            indent.writeln('const size_t size = $columnName->size();');
+          }
+        });
+        indent.writeln('$className columns;');
+        indent.writeln('columns.columns_ = std::move(list);');
+        indent.writeln('return columns;');
+      },
+    );
+  }
+
+  @override
+  void writeDataClass(
+    InternalCppOptions generatorOptions,
+    Root root,
+    Indent indent,
     Class classDefinition, {
     required String dartPackageName,
   }) {
@@ -949,17 +3065,35 @@ class CppSourceGenerator extends StructuredGenerator<InternalCppOptions> {
     );
     // Minimal constructor, if needed.
     if (requiredFields.length != orderedFields.length) {
-      _writeClassConstructor(root, indent, classDefinition, requiredFields);
+      _writeClassConstructor(
+        root,
+        indent,
+        classDefinition,
+        requiredFields,
+        typedCollections: generatorOptions.typedCollections,
+      );
     }
     // All-field constructor.
-    _writeClassConstructor(root, indent, classDefinition, orderedFields);
+    _writeClassConstructor(
+      root,
+      indent,
+      classDefinition,
+      orderedFields,
+      typedCollections: generatorOptions.typedCollections,
+    );
 
     // Custom copy/assign to handle pointer fields, if necessary.
     if (orderedFields.any(
       (NamedType field) =>
           _isPointerField(getFieldHostDatatype(field, _baseCppTypeForBuiltinDartType)),
     )) {
-      _writeCopyConstructor(root, indent, classDefinition, orderedFields);
+      _writeCopyConstructor(
+        root,
+        indent,
+        classDefinition,
+        orderedFields,
+        typedCollections: generatorOptions.typedCollections,
+      );
       _writeAssignmentOperator(root, indent, classDefinition, orderedFields);
     }
 
@@ -1080,7 +3214,32 @@ class CppSourceGenerator extends StructuredGenerator<InternalCppOptions> {
     );
   }
 
-  void _writeDeepEquals(Indent indent) {
+  void _writeDeepEquals(Indent indent, {required bool typedCollections}) {
+    final String unorderedMapDeclaration = typedCollections
+        ? '''
+
+template <typename K, typename V>
+bool PigeonInternalDeepEquals(const std::unordered_map<K, V>& a, const std::unordered_map<K, V>& b);
+'''
+        : '';
+    final String unorderedMapDefinition = typedCollections
+        ? '''
+
+template <typename K, typename V>
+bool PigeonInternalDeepEquals(const std::unordered_map<K, V>& a, const std::unordered_map<K, V>& b) {
+  if (a.size() != b.size()) {
+    return false;
+  }
+  for (const auto& kv : a) {
+    auto it = b.find(kv.first);
+    if (it == b.end() || !PigeonInternalDeepEquals(kv.second, it->second)) {
+      return false;
+    }
+  }
+  return true;
+}
+'''
+        : '';
     indent.format('''
 template<typename T>
 bool PigeonInternalDeepEquals(const T& a, const T& b);
@@ -1092,7 +3251,7 @@ bool PigeonInternalDeepEquals(const std::vector<T>& a, const std::vector<T>& b);
 
 template<typename K, typename V>
 bool PigeonInternalDeepEquals(const std::map<K, V>& a, const std::map<K, V>& b);
-
+$unorderedMapDeclaration
 template<typename T>
 bool PigeonInternalDeepEquals(const std::optional<T>& a, const std::optional<T>& b);
 
@@ -1142,7 +3301,7 @@ bool PigeonInternalDeepEquals(const std::map<K, V>& a, const std::map<K, V>& b)
   }
   return true;
 }
-
+$unorderedMapDefinition
 bool PigeonInternalDeepEquals(const double& a, const double& b) {
   // Normalize -0.0 to 0.0 and handle NaN equality.
   return (a == b) || (std::isnan(a) && std::isnan(b));
@@ -1186,7 +3345,27 @@ bool PigeonInternalDeepEquals(const ::flutter::EncodableValue& a, const ::flutte
 ''');
   }
 
-  void _writeDeepHash(Indent indent) {
+  void _writeDeepHash(Indent indent, {required bool typedCollections}) {
+    final String unorderedMapDeclaration = typedCollections
+        ? '''
+
+template <typename K, typename V>
+size_t PigeonInternalDeepHash(const std::unordered_map<K, V>& v);
+'''
+        : '';
+    final String unorderedMapDefinition = typedCollections
+        ? '''
+
+template <typename K, typename V>
+size_t PigeonInternalDeepHash(const std::unordered_map<K, V>& v) {
+  size_t result = 0;
+  for (const auto& kv : v) {
+    result += ((PigeonInternalDeepHash(kv.first) * 31) ^ PigeonInternalDeepHash(kv.second));
+  }
+  return result;
+}
+'''
+        : '';
     indent.format('''
 template <typename T>
 size_t PigeonInternalDeepHash(const T& v);
@@ -1198,7 +3377,7 @@ size_t PigeonInternalDeepHash(const std::vector<T>& v);
 
 template <typename K, typename V>
 size_t PigeonInternalDeepHash(const std::map<K, V>& v);
-
+$unorderedMapDeclaration
 template <typename T>
 size_t PigeonInternalDeepHash(const std::optional<T>& v);
 
@@ -1229,7 +3408,7 @@ size_t PigeonInternalDeepHash(const std::map<K, V>& v) {
   }
   return result;
 }
-
+$unorderedMapDefinition
 size_t PigeonInternalDeepHash(const double& v) {
   if (std::isnan(v)) {
     // Normalize NaN to a consistent hash.
@@ -1281,7 +3460,34 @@ size_t PigeonInternalDeepHash(const ::flutter::EncodableValue& v) {
 ''');
   }
 
-  void _writeDeepToString(Indent indent) {
+  void _writeDeepToString(Indent indent, {required bool typedCollections}) {
+    final String unorderedMapDeclaration = typedCollections
+        ? '''
+
+template <typename K, typename V>
+std::string PigeonInternalToString(const std::unordered_map<K, V>& v);
+'''
+        : '';
+    final String unorderedMapDefinition = typedCollections
+        ? r'''
+
+template <typename K, typename V>
+std::string PigeonInternalToString(const std::unordered_map<K, V>& v) {
+  std::stringstream ss;
+  ss << "{";
+  bool first = true;
+  for (const auto& kv : v) {
+    if (!first) {
+      ss << ", ";
+    }
+    first = false;
+    ss << PigeonInternalToString(kv.first) << ": " << PigeonInternalToString(kv.second);
+  }
+  ss << "}";
+  return ss.str();
+}
+'''
+        : '';
     indent.format(r'''
 template <typename T>
 std::string PigeonInternalToString(const T& v);
@@ -1293,6 +3499,9 @@ std::string PigeonInternalToString(const std::vector<T>& v);
 
 template <typename K, typename V>
 std::string PigeonInternalToString(const std::map<K, V>& v);
+''' +
+        unorderedMapDeclaration +
+        r'''
 
 template <typename T>
 std::string PigeonInternalToString(const std::optional<T>& v);
@@ -1346,6 +3555,9 @@ std::string PigeonInternalToString(const std::map<K, V>& v) {
   ss << "}";
   return ss.str();
 }
+''' +
+        unorderedMapDefinition +
+        r'''
 
 template <typename T>
 std::string PigeonInternalToString(const std::optional<T>& v) {
@@ -1378,6 +3590,63 @@ std::string PigeonInternalToString(const ::flutter::EncodableValue& v) {
 ''');
   }
 
+  /// Writes the conversions between typed collection fields and the
+  /// EncodableValues that hold them in a data class's encodable list.
+  void _writeTypedCollectionConversions(Indent indent) {
+    indent.format('''
+template <typename T>
+T PigeonInternalElementFromEncodable(const EncodableValue& value) {
+  if constexpr (std::is_same_v<T, int64_t>) {
+    return value.LongValue();
+  } else {
+    return std::get<T>(value);
+  }
+}
+
+template <typename T>
+std::vector<T> PigeonInternalVectorFromEncodable(const EncodableValue& value) {
+  const EncodableList& list = std::get<EncodableList>(value);
+  std::vector<T> result;
+  result.reserve(list.size());
+  for (const EncodableValue& element : list) {
+    result.push_back(PigeonInternalElementFromEncodable<T>(element));
+  }
+  return result;
+}
+
+template <typename K, typename V>
+std::unordered_map<K, V> PigeonInternalUnorderedMapFromEncodable(const EncodableValue& value) {
+  const EncodableMap& map = std::get<EncodableMap>(value);
+  std::unordered_map<K, V> result;
+  result.reserve(map.size());
+  for (const auto& kv : map) {
+    result.emplace(PigeonInternalElementFromEncodable<K>(kv.first),
+                   PigeonInternalElementFromEncodable<V>(kv.second));
+  }
+  return result;
+}
+
+template <typename T>
+EncodableValue PigeonInternalToEncodableValue(const std::vector<T>& v) {
+  EncodableList list;
+  list.reserve(v.size());
+  for (const T& element : v) {
+    list.push_back(EncodableValue(element));
+  }
+  return EncodableValue(std::move(list));
+}
+
+template <typename K, typename V>
+EncodableValue PigeonInternalToEncodableValue(const std::unordered_map<K, V>& v) {
+  EncodableMap map;
+  for (const auto& kv : v) {
+    map.emplace(EncodableValue(kv.first), EncodableValue(kv.second));
+  }
+  return EncodableValue(std::move(map));
+}
+''');
+  }
+
   @override
   void writeClassEncode(
     InternalCppOptions generatorOptions,
@@ -1400,13 +3669,21 @@ std::string PigeonInternalToString(const ::flutter::EncodableValue& v) {
             field,
             _shortBaseCppTypeForBuiltinDartType,
           );
-          final String encodableValue = _wrappedHostApiArgumentExpression(
-            root,
-            _makeInstanceVariableName(field),
-            field.type,
-            hostDatatype,
-            true,
-          );
+          final String instanceVariableName = _makeInstanceVariableName(field);
+          final String encodableValue;
+          if (generatorOptions.typedCollections && _typedCollectionType(field.type) != null) {
+            encodableValue = field.type.isNullable
+                ? '$instanceVariableName ? PigeonInternalToEncodableValue(*$instanceVariableName) : EncodableValue()'
+                : 'PigeonInternalToEncodableValue($instanceVariableName)';
+          } else {
+            encodableValue = _wrappedHostApiArgumentExpression(
+              root,
+              instanceVariableName,
+              field.type,
+              hostDatatype,
+              true,
+            );
+          }
           indent.writeln('list.push_back($encodableValue);');
         }
         indent.writeln('return list;');
@@ -1414,6 +3691,47 @@ std::string PigeonInternalToString(const ::flutter::EncodableValue& v) {
     );
   }
 
+  /// Returns the expression to convert the EncodableValue [encodable] to the
+  /// value of [field].
+  ///
+  /// If [move] is true, the value is moved out of [encodable] where that is
+  /// cheaper than copying it.
+  ///
+  /// If [typedCollections] is true, typed collection fields are converted
+  /// element by element into their native C++ containers.
+  String _decodedFieldValueExpression(
+    NamedType field,
+    String encodable, {
+    bool move = false,
+    bool typedCollections = false,
+  }) {
+    final List<String>? typedCollectionArguments = typedCollections
+        ? _typedCollectionArguments(field.type)
+        : null;
+    if (typedCollectionArguments != null) {
+      final conversion = field.type.baseName == 'List'
+          ? 'PigeonInternalVectorFromEncodable'
+          : 'PigeonInternalUnorderedMapFromEncodable';
+      return '$conversion<${typedCollectionArguments.join(', ')}>($encodable)';
+    }
+    final HostDatatype hostDatatype = getFieldHostDatatype(
+      field,
+      _shortBaseCppTypeForBuiltinDartType,
+    );
+    final bool moveValue = move && _isMovableField(_nonNullableType(hostDatatype));
+    if (field.type.baseName == 'Object') {
+      return moveValue ? 'std::move($encodable)' : encodable;
+    } else if (moveValue && field.type.isClass) {
+      return 'std::move(std::any_cast<${hostDatatype.datatype}&>(std::get<CustomEncodableValue>($encodable)))';
+    } else if (field.type.isClass || field.type.isEnum) {
+      return _classReferenceFromEncodableValue(hostDatatype, encodable);
+    } else if (moveValue) {
+      return 'std::move(std::get<${hostDatatype.datatype}>($encodable))';
+    } else {
+      return 'std::get<${hostDatatype.datatype}>($encodable)';
+    }
+  }
+
   @override
   void writeClassDecode(
     InternalCppOptions generatorOptions,
@@ -1422,24 +3740,6 @@ std::string PigeonInternalToString(const ::flutter::EncodableValue& v) {
     Class classDefinition, {
     required String dartPackageName,
   }) {
-    // Returns the expression to convert the given EncodableValue to a field
-    // value.
-    String getValueExpression(NamedType field, String encodable) {
-      if (field.type.baseName == 'Object') {
-        return encodable;
-      } else {
-        final HostDatatype hostDatatype = getFieldHostDatatype(
-          field,
-          _shortBaseCppTypeForBuiltinDartType,
-        );
-        if (field.type.isClass || field.type.isEnum) {
-          return _classReferenceFromEncodableValue(hostDatatype, encodable);
-        } else {
-          return 'std::get<${hostDatatype.datatype}>($encodable)';
-        }
-      }
-    }
-
     _writeFunctionDefinition(
       indent,
       'FromEncodableList',
@@ -1461,7 +3761,14 @@ std::string PigeonInternalToString(const ::flutter::EncodableValue& v) {
 
         // Non-nullable fields must be set via the constructor.
         String constructorArgs = nonNullableFields
-            .map((_IndexedField param) => getValueExpression(param.field, 'list[${param.index}]'))
+            .map(
+              (_IndexedField param) =>
+                  _decodedFieldValueExpression(
+                    param.field,
+                    'list[${param.index}]',
+                    typedCollections: generatorOptions.typedCollections,
+                  ),
+            )
             .join(',\n\t');
         if (constructorArgs.isNotEmpty) {
           constructorArgs = '(\n\t$constructorArgs)';
@@ -1477,7 +3784,11 @@ std::string PigeonInternalToString(const ::flutter::EncodableValue& v) {
           final encodableFieldName = '${_encodablePrefix}_${_makeVariableName(field)}';
           indent.writeln('auto& $encodableFieldName = list[${entry.index}];');
 
-          final String valueExpression = getValueExpression(field, encodableFieldName);
+          final String valueExpression = _decodedFieldValueExpression(
+            field,
+            encodableFieldName,
+            typedCollections: generatorOptions.typedCollections,
+          );
           indent.writeScoped('if (!$encodableFieldName.IsNull()) {', '}', () {
             indent.writeln('$instanceVariable.$setterName($valueExpression);');
           });
@@ -1489,7 +3800,70 @@ std::string PigeonInternalToString(const ::flutter::EncodableValue& v) {
         indent.writeln('return $instanceVariable;');
       },
     );
-  }
+
+    // The consuming variant, used when decoding from the wire, where the list
+    // is a temporary whose elements can be moved out rather than deep-copied.
+    _writeFunctionDefinition(
+      indent,
+      'FromEncodableList',
+      scope: classDefinition.name,
+      returnType: classDefinition.name,
+      parameters: <String>['EncodableList&& list'],
+      body: () {
+        const instanceVariable = 'decoded';
+        final Iterable<_IndexedField> indexedFields = indexMap(
+          getFieldsInSerializationOrder(classDefinition),
+          (int index, NamedType field) => _IndexedField(index, field),
+        );
+        String constructorArgs = indexedFields
+            .where((_IndexedField field) => !field.field.type.isNullable)
+            .map(
+              (_IndexedField param) =>
+                  _decodedFieldValueExpression(
+                    param.field,
+                    'list[${param.index}]',
+                    move: true,
+                    typedCollections: generatorOptions.typedCollections,
+                  ),
+            )
+            .join(',\n\t');
+        if (constructorArgs.isNotEmpty) {
+          constructorArgs = '(\n\t$constructorArgs)';
+        }
+        indent.format('${classDefinition.name} $instanceVariable$constructorArgs;');
+
+        // Nullable fields are assigned directly rather than via setters, since
+        // the string setters can't take ownership of their argument.
+        for (final entry in indexedFields.where(
+          (_IndexedField field) => field.field.type.isNullable,
+        )) {
+          final NamedType field = entry.field;
+          final HostDatatype hostDatatype = getFieldHostDatatype(
+            field,
+            _shortBaseCppTypeForBuiltinDartType,
+          );
+          final encodableFieldName = '${_encodablePrefix}_${_makeVariableName(field)}';
+          indent.writeln('auto& $encodableFieldName = list[${entry.index}];');
+
+          String valueExpression = _decodedFieldValueExpression(
+            field,
+            encodableFieldName,
+            move: true,
+            typedCollections: generatorOptions.typedCollections,
+          );
+          if (_isPointerField(hostDatatype)) {
+            valueExpression = 'std::make_unique<${hostDatatype.datatype}>($valueExpression)';
+          }
+          indent.writeScoped('if (!$encodableFieldName.IsNull()) {', '}', () {
+            indent.writeln(
+              '$instanceVariable.${_makeInstanceVariableName(field)} = $valueExpression;',
+            );
+          });
+        }
+        indent.writeln('return $instanceVariable;');
+      },
+    );
+  }
 
   void _writeCodecOverflowUtilities(
     InternalCppOptions generatorOptions,
@@ -1579,6 +3953,11 @@ EncodableValue $_overflowClassName::FromEncodableList(
         dartPackageName: dartPackageName,
       );
     }
+    final Iterable<EnumeratedType> streamDecodedClasses = _streamDecodedClasses(root);
+    if (streamDecodedClasses.isNotEmpty) {
+      _writeStreamDecodingConstants(indent);
+      _writeCustomValueHelpers(indent);
+    }
     _writeFunctionDefinition(indent, _codecSerializerName, scope: _codecSerializerName);
     _writeFunctionDefinition(
       indent,
@@ -1595,10 +3974,23 @@ EncodableValue $_overflowClassName::FromEncodableList(
             if (customType.enumeration < maximumCodecFieldKey) {
               indent.write('case ${customType.enumeration}: ');
               indent.nest(1, () {
-                _writeCodecDecode(indent, customType, 'ReadValue(stream)');
+                if (customType.type == CustomTypes.customClass) {
+                  indent.addScoped('{', '}', () {
+                    indent.writeln('EncodableValue value;');
+                    indent.writeln(
+                      'PigeonInternalSetCustomValue(Read${customType.name}(type, stream), &value);',
+                    );
+                    indent.writeln('return value;');
+                  });
+                } else {
+                  _writeCodecDecode(indent, customType, 'ReadValue(stream)');
+                }
               });
             }
           }
+          if (streamDecodedClasses.isNotEmpty) {
+            _writeCollectionDecoding(indent);
+          }
           if (root.requiresOverflowClass) {
             indent.write('case $maximumCodecFieldKey:');
             _writeCodecDecode(indent, _enumeratedOverflow, 'ReadValue(stream)');
@@ -1640,6 +4032,14 @@ EncodableValue $_overflowClassName::FromEncodableList(
               indent.write('if (custom_value->type() == typeid(${customType.name})) ');
               indent.addScoped('{', '}', () {
                 indent.writeln('stream->WriteByte($enumeration);');
+                if (customType.type == CustomTypes.customClass &&
+                    enumeration < maximumCodecFieldKey) {
+                  indent.writeln(
+                    'WriteFields(std::any_cast<const ${customType.name}&>(*custom_value), stream);',
+                  );
+                  indent.writeln('return;');
+                  return;
+                }
                 if (enumeration == maximumCodecFieldKey) {
                   indent.writeln(
                     'const auto wrap = $_overflowClassName(${customType.enumeration - maximumCodecFieldKey}, $encodeString);',
@@ -1654,177 +4054,1443 @@ EncodableValue $_overflowClassName::FromEncodableList(
         indent.writeln('$_standardCodecSerializer::WriteValue(value, stream);');
       },
     );
+    if (streamDecodedClasses.isNotEmpty) {
+      final bool typedCollections = generatorOptions.typedCollections;
+      _writeStreamDecodingHelpers(indent);
+      if (typedCollections) {
+        _writeStreamTypedCollectionDecodingHelpers(indent);
+      }
+      for (final EnumeratedType customType in streamDecodedClasses) {
+        _writeStreamDecodedClassReader(
+          indent,
+          customType,
+          streamDecodedClasses,
+          typedCollections: typedCollections,
+        );
+      }
+      _writeStreamEncodingHelpers(indent);
+      if (typedCollections) {
+        _writeStreamTypedCollectionEncodingHelpers(indent);
+      }
+      for (final EnumeratedType customType in streamDecodedClasses) {
+        _writeStreamEncodedClassWriter(
+          indent,
+          customType,
+          enumeratedTypes,
+          typedCollections: typedCollections,
+        );
+      }
+    }
+    if (root.containsProxyApi) {
+      _writeProxyApiCodecSerializer(indent);
+    }
   }
 
-  @override
-  void writeFlutterApi(
-    InternalCppOptions generatorOptions,
-    Root root,
-    Indent indent,
-    AstFlutterApi api, {
-    required String dartPackageName,
-  }) {
-    indent.writeln(
-      '$_commentPrefix Generated class from Pigeon that represents Flutter messages that can be called from C++.',
-    );
+  void _writeProxyApiCodecSerializer(Indent indent) {
     _writeFunctionDefinition(
       indent,
-      api.name,
-      scope: api.name,
-      parameters: <String>['::flutter::BinaryMessenger* binary_messenger'],
-      initializers: <String>['binary_messenger_(binary_messenger)', 'message_channel_suffix_("")'],
+      _proxyApiCodecSerializerName,
+      scope: _proxyApiCodecSerializerName,
+      parameters: <String>['$_instanceManagerClassName* instance_manager'],
+      initializers: <String>['instance_manager_(instance_manager)'],
     );
     _writeFunctionDefinition(
       indent,
-      api.name,
-      scope: api.name,
-      parameters: <String>[
-        '::flutter::BinaryMessenger* binary_messenger',
-        'const std::string& message_channel_suffix',
-      ],
-      initializers: <String>[
-        'binary_messenger_(binary_messenger)',
-        'message_channel_suffix_(message_channel_suffix.length() > 0 ? std::string(".") + message_channel_suffix : "")',
-      ],
+      'ReadValueOfType',
+      scope: _proxyApiCodecSerializerName,
+      returnType: 'EncodableValue',
+      parameters: <String>['uint8_t type', '::flutter::ByteStreamReader* stream'],
+      isConst: true,
+      body: () {
+        indent.writeScoped('if (type == $proxyApiCodecInstanceManagerKey) {', '}', () {
+          indent.writeln('const EncodableValue identifier = ReadValue(stream);');
+          indent.writeln(
+            'return CustomEncodableValue(instance_manager_->GetInstance(identifier.LongValue()));',
+          );
+        });
+        indent.writeln('return $_codecSerializerName::ReadValueOfType(type, stream);');
+      },
     );
     _writeFunctionDefinition(
       indent,
-      'GetCodec',
-      scope: api.name,
-      returnType: 'const ::flutter::StandardMessageCodec&',
+      'WriteValue',
+      scope: _proxyApiCodecSerializerName,
+      returnType: _voidType,
+      parameters: <String>['const EncodableValue& value', '::flutter::ByteStreamWriter* stream'],
+      isConst: true,
       body: () {
-        indent.writeln(
-          'return ::flutter::StandardMessageCodec::GetInstance(&$_codecSerializerName::GetInstance());',
+        indent.write(
+          'if (const CustomEncodableValue* custom_value = std::get_if<CustomEncodableValue>(&value)) ',
         );
+        indent.addScoped('{', '}', () {
+          indent.write('if (custom_value->type() == typeid($_proxyApiInstanceType)) ');
+          indent.addScoped('{', '}', () {
+            indent.writeln(
+              'const int64_t identifier = instance_manager_->GetIdentifier('
+              'std::any_cast<const $_proxyApiInstanceType&>(*custom_value).get());',
+            );
+            indent.writeln(
+              '$_commentPrefix Instances that are not in the instance manager are sent as null.',
+            );
+            indent.writeScoped('if (identifier < 0) {', '}', () {
+              indent.writeln('$_codecSerializerName::WriteValue(EncodableValue(), stream);');
+              indent.writeln('return;');
+            });
+            indent.writeln('stream->WriteByte($proxyApiCodecInstanceManagerKey);');
+            indent.writeln('WriteValue(EncodableValue(identifier), stream);');
+            indent.writeln('return;');
+          });
+        });
+        indent.writeln('$_codecSerializerName::WriteValue(value, stream);');
       },
     );
-    for (final Method func in api.methods) {
-      final HostDatatype returnType = getHostDatatype(
-        func.returnType,
-        _shortBaseCppTypeForBuiltinDartType,
-      );
+  }
 
-      // Determine the input parameter list, saved in a structured form for later
-      // use as platform channel call arguments.
-      final Iterable<_HostNamedType> hostParameters = indexMap(func.parameters, (
-        int i,
-        NamedType arg,
-      ) {
-        final HostDatatype hostType = getFieldHostDatatype(
-          arg,
-          _shortBaseCppTypeForBuiltinDartType,
+  /// Writes the standard codec type bytes used by the stream decoding helpers.
+  void _writeStreamDecodingConstants(Indent indent) {
+    indent.writeln('namespace {');
+    indent.writeln(
+      '$_commentPrefix The type bytes that ::flutter::StandardCodecSerializer writes before the values that are read from and written to the stream directly.',
+    );
+    for (final (String name, int value) in <(String, int)>[
+      ('Null', 0),
+      ('True', 1),
+      ('False', 2),
+      ('Int32', 3),
+      ('Int64', 4),
+      ('Float64', 6),
+      ('String', 7),
+      ('UInt8List', 8),
+      ('Int32List', 9),
+      ('Int64List', 10),
+      ('Float64List', 11),
+      ('List', 12),
+      ('Map', 13),
+    ]) {
+      indent.writeln('constexpr uint8_t kEncoded$name = $value;');
+    }
+    indent.writeln('}  // namespace');
+    indent.newln();
+  }
+
+  /// Writes the helpers that store data classes in [EncodableValue]s without
+  /// copying them.
+  ///
+  /// `CustomEncodableValue` can only be constructed by copying a `std::any`,
+  /// and has no move constructor, so wrapping a decoded or returned data class
+  /// in one, or moving an `EncodableValue` holding one, copies every field of
+  /// the class. These move the `std::any` instead.
+  void _writeCustomValueHelpers(Indent indent) {
+    indent.writeln('namespace {');
+    indent.writeln('$_commentPrefix Sets |encodable| to a CustomEncodableValue holding |value|.');
+    indent.writeln('template <typename T>');
+    _writeFunctionDefinition(
+      indent,
+      'PigeonInternalSetCustomValue',
+      returnType: _voidType,
+      parameters: <String>['T&& value', 'EncodableValue* encodable'],
+      body: () {
+        indent.writeln('std::any& any = encodable->emplace<CustomEncodableValue>(std::any());');
+        indent.writeln('any.emplace<std::decay_t<T>>(std::forward<T>(value));');
+      },
+    );
+    indent.writeln('$_commentPrefix Moves |source| into |destination| without copying the value of a');
+    indent.writeln('$_commentPrefix CustomEncodableValue, which moving the EncodableValue would do.');
+    _writeFunctionDefinition(
+      indent,
+      'PigeonInternalMoveValue',
+      returnType: _voidType,
+      parameters: <String>['EncodableValue&& source', 'EncodableValue* destination'],
+      body: () {
+        indent.writeScoped(
+          'if (CustomEncodableValue* custom_value = std::get_if<CustomEncodableValue>(&source)) {',
+          '}',
+          () {
+            indent.writeln(
+              'std::any& any = destination->emplace<CustomEncodableValue>(std::any());',
+            );
+            indent.writeln('any.swap(*custom_value);');
+            indent.writeln('return;');
+          },
         );
-        return _HostNamedType(_getSafeArgumentName(i, arg), hostType, arg.type);
+        indent.writeln('*destination = std::move(source);');
+      },
+    );
+    indent.writeln('}  // namespace');
+    indent.newln();
+  }
+
+  /// Writes the `ReadValueOfType` cases for lists and maps, which are read
+  /// here rather than by the standard codec so that data class elements are
+  /// moved into the collection instead of copied.
+  void _writeCollectionDecoding(Indent indent) {
+    indent.write('case kEncodedList: ');
+    indent.addScoped('{', '}', () {
+      indent.writeln('const size_t size = ReadSize(stream);');
+      indent.writeln('EncodableList list(size);');
+      indent.writeScoped('for (EncodableValue& element : list) {', '}', () {
+        indent.writeln('PigeonInternalMoveValue(ReadValue(stream), &element);');
       });
-      final parameters = <String>[
-        ...hostParameters.map(
-          (_HostNamedType arg) => '${_flutterApiArgumentType(arg.hostType)} ${arg.name}',
-        ),
-        ..._flutterApiCallbackParameters(returnType),
-      ];
-      _writeFunctionDefinition(
-        indent,
-        _makeMethodName(func),
-        scope: api.name,
-        returnType: _voidType,
-        parameters: parameters,
-        body: () {
+      indent.writeln('return EncodableValue(std::move(list));');
+    });
+    indent.write('case kEncodedMap: ');
+    indent.addScoped('{', '}', () {
+      indent.writeln('const size_t size = ReadSize(stream);');
+      indent.writeln('EncodableMap map;');
+      indent.writeScoped('for (size_t i = 0; i < size; ++i) {', '}', () {
+        indent.writeln('EncodableValue key = ReadValue(stream);');
+        indent.writeln('EncodableValue value = ReadValue(stream);');
+        indent.writeln('auto [entry, inserted] = map.try_emplace(std::move(key));');
+        indent.writeScoped('if (inserted) {', '}', () {
+          indent.writeln('PigeonInternalMoveValue(std::move(value), &entry->second);');
+        });
+      });
+      indent.writeln('return EncodableValue(std::move(map));');
+    });
+  }
+
+  /// Writes the codec serializer methods that read builtin values directly
+  /// from the stream.
+  void _writeStreamDecodingHelpers(Indent indent) {
+    const streamParameter = '::flutter::ByteStreamReader* stream';
+    _writeFunctionDefinition(
+      indent,
+      'ReadEncodedFieldList',
+      scope: _codecSerializerName,
+      returnType: 'bool',
+      parameters: <String>[streamParameter, 'size_t field_count', 'EncodableList* list'],
+      isConst: true,
+      body: () {
+        indent.writeln('const uint8_t type = stream->ReadByte();');
+        indent.writeScoped('if (type == kEncodedList) {', '} else {', () {
+          indent.writeln('const size_t size = ReadSize(stream);');
+          indent.writeScoped('if (size == field_count) {', '}', () {
+            indent.writeln('return true;');
+          });
           indent.writeln(
-            'const std::string channel_name = "${makeChannelName(api, func, dartPackageName)}" + message_channel_suffix_;',
+            '$_commentPrefix The fields don\'t match this version of the class, so leave it to',
           );
+          indent.writeln('$_commentPrefix FromEncodableList to decide how to handle them.');
+          indent.writeln('list->reserve(size);');
+          indent.writeScoped('for (size_t i = 0; i < size; ++i) {', '}', () {
+            indent.writeln('list->push_back(ReadValue(stream));');
+          });
+        });
+        indent.nest(1, () {
+          indent.writeln('*list = std::get<EncodableList>(ReadValueOfType(type, stream));');
+        });
+        indent.writeln('}');
+        indent.writeScoped('if (list->size() < field_count) {', '}', () {
           indent.writeln(
-            'BasicMessageChannel<> channel(binary_messenger_, '
-            'channel_name, &GetCodec());',
+            'throw std::runtime_error("Expected " + std::to_string(field_count) + " data class fields, but got " + std::to_string(list->size()));',
           );
+        });
+        indent.writeln('return false;');
+      },
+    );
+    _writeFunctionDefinition(
+      indent,
+      'ReadEncodedBool',
+      scope: _codecSerializerName,
+      returnType: 'bool',
+      parameters: <String>['uint8_t type', streamParameter],
+      isConst: true,
+      body: () {
+        indent.writeScoped('if (type == kEncodedTrue) {', '}', () {
+          indent.writeln('return true;');
+        });
+        indent.writeScoped('if (type == kEncodedFalse) {', '}', () {
+          indent.writeln('return false;');
+        });
+        indent.writeln('return std::get<bool>(ReadValueOfType(type, stream));');
+      },
+    );
+    _writeFunctionDefinition(
+      indent,
+      'ReadEncodedInt64',
+      scope: _codecSerializerName,
+      returnType: 'int64_t',
+      parameters: <String>['uint8_t type', streamParameter],
+      isConst: true,
+      body: () {
+        indent.writeScoped('if (type == kEncodedInt64) {', '}', () {
+          indent.writeln('return stream->ReadInt64();');
+        });
+        indent.writeln(
+          '$_commentPrefix StandardMessageCodec writes ints that fit in 32 bits as int32.',
+        );
+        indent.writeScoped('if (type == kEncodedInt32) {', '}', () {
+          indent.writeln('return stream->ReadInt32();');
+        });
+        indent.writeln('return ReadValueOfType(type, stream).LongValue();');
+      },
+    );
+    _writeFunctionDefinition(
+      indent,
+      'ReadEncodedDouble',
+      scope: _codecSerializerName,
+      returnType: 'double',
+      parameters: <String>['uint8_t type', streamParameter],
+      isConst: true,
+      body: () {
+        indent.writeScoped('if (type != kEncodedFloat64) {', '}', () {
+          indent.writeln('return std::get<double>(ReadValueOfType(type, stream));');
+        });
+        indent.writeln('stream->ReadAlignment(8);');
+        indent.writeln('return stream->ReadDouble();');
+      },
+    );
+    _writeFunctionDefinition(
+      indent,
+      'ReadEncodedString',
+      scope: _codecSerializerName,
+      returnType: 'std::string',
+      parameters: <String>['uint8_t type', streamParameter],
+      isConst: true,
+      body: () {
+        indent.writeScoped('if (type != kEncodedString) {', '}', () {
+          indent.writeln('return std::get<std::string>(ReadValueOfType(type, stream));');
+        });
+        indent.writeln(r"std::string value(ReadSize(stream), '\0');");
+        indent.writeln(
+          'stream->ReadBytes(reinterpret_cast<uint8_t*>(value.data()), value.size());',
+        );
+        indent.writeln('return value;');
+      },
+    );
+    indent.writeln('template <typename T>');
+    _writeFunctionDefinition(
+      indent,
+      'ReadEncodedTypedData',
+      scope: _codecSerializerName,
+      returnType: 'std::vector<T>',
+      parameters: <String>['uint8_t type', streamParameter],
+      isConst: true,
+      body: () {
+        indent.format('''
+constexpr uint8_t expected_type =
+	std::is_same_v<T, uint8_t> ? kEncodedUInt8List
+	: std::is_same_v<T, int32_t> ? kEncodedInt32List
+	: std::is_same_v<T, int64_t> ? kEncodedInt64List
+	: kEncodedFloat64List;''');
+        indent.writeScoped('if (type != expected_type) {', '}', () {
+          indent.writeln('return std::get<std::vector<T>>(ReadValueOfType(type, stream));');
+        });
+        indent.writeln('std::vector<T> value(ReadSize(stream));');
+        indent.writeScoped('if (sizeof(T) > 1) {', '}', () {
+          indent.writeln('stream->ReadAlignment(sizeof(T));');
+        });
+        indent.writeln(
+          'stream->ReadBytes(reinterpret_cast<uint8_t*>(value.data()), value.size() * sizeof(T));',
+        );
+        indent.writeln('return value;');
+      },
+    );
+  }
 
-          // Convert arguments to EncodableValue versions.
-          const argumentListVariableName = 'encoded_api_arguments';
-          indent.write('EncodableValue $argumentListVariableName = ');
-          if (func.parameters.isEmpty) {
-            indent.addln('EncodableValue();');
-          } else {
-            indent.addScoped('EncodableValue(EncodableList{', '});', () {
-              for (final param in hostParameters) {
-                final String encodedArgument = _wrappedHostApiArgumentExpression(
-                  root,
-                  param.name,
-                  param.originalType,
-                  param.hostType,
-                  false,
-                );
-                indent.writeln('$encodedArgument,');
-              }
-            });
-          }
-
-          indent.write(
-            'channel.Send($argumentListVariableName, '
-            // ignore: missing_whitespace_between_adjacent_strings
-            '[channel_name, on_success = std::move(on_success), on_error = std::move(on_error)]'
-            '(const uint8_t* reply, size_t reply_size) ',
-          );
-          indent.addScoped('{', '});', () {
-            String successCallbackArgument;
-            successCallbackArgument = 'return_value';
-            final encodedReplyName = 'encodable_$successCallbackArgument';
-            final listReplyName = 'list_$successCallbackArgument';
-            indent.writeln(
-              'std::unique_ptr<EncodableValue> response = GetCodec().DecodeMessage(reply, reply_size);',
-            );
-            indent.writeln('const auto& $encodedReplyName = *response;');
-            indent.writeln(
-              'const auto* $listReplyName = std::get_if<EncodableList>(&$encodedReplyName);',
-            );
-            indent.writeScoped('if ($listReplyName) {', '} ', () {
-              indent.writeScoped('if ($listReplyName->size() > 1) {', '} ', () {
-                indent.writeln(
-                  'on_error(FlutterError(std::get<std::string>($listReplyName->at(0)), std::get<std::string>($listReplyName->at(1)), $listReplyName->at(2)));',
-                );
-              }, addTrailingNewline: false);
-              indent.addScoped('else {', '}', () {
-                if (func.returnType.isVoid) {
-                  successCallbackArgument = '';
-                } else {
-                  _writeEncodableValueArgumentUnwrapping(
-                    indent,
-                    root,
-                    returnType,
-                    argName: successCallbackArgument,
-                    encodableArgName: '$listReplyName->at(0)',
-                    apiType: ApiType.flutter,
+  /// Writes the codec serializer methods that read typed collections directly
+  /// from the stream into their native C++ containers.
+  void _writeStreamTypedCollectionDecodingHelpers(Indent indent) {
+    const streamParameter = '::flutter::ByteStreamReader* stream';
+    indent.writeln('template <typename T>');
+    _writeFunctionDefinition(
+      indent,
+      'ReadEncodedElement',
+      scope: _codecSerializerName,
+      returnType: 'T',
+      parameters: <String>[streamParameter],
+      isConst: true,
+      body: () {
+        indent.writeln('const uint8_t type = stream->ReadByte();');
+        indent.format('''
+if constexpr (std::is_same_v<T, bool>) {
+	return ReadEncodedBool(type, stream);
+} else if constexpr (std::is_same_v<T, int64_t>) {
+	return ReadEncodedInt64(type, stream);
+} else if constexpr (std::is_same_v<T, double>) {
+	return ReadEncodedDouble(type, stream);
+} else {
+	return ReadEncodedString(type, stream);
+}''');
+      },
+    );
+    indent.writeln('template <typename T>');
+    _writeFunctionDefinition(
+      indent,
+      'ReadEncodedVector',
+      scope: _codecSerializerName,
+      returnType: 'std::vector<T>',
+      parameters: <String>['uint8_t type', streamParameter],
+      isConst: true,
+      body: () {
+        indent.writeScoped('if (type != kEncodedList) {', '}', () {
+          indent.writeln(
+            'return PigeonInternalVectorFromEncodable<T>(ReadValueOfType(type, stream));',
+          );
+        });
+        indent.writeln('const size_t size = ReadSize(stream);');
+        indent.writeln('std::vector<T> value;');
+        indent.writeln('value.reserve(size);');
+        indent.writeScoped('for (size_t i = 0; i < size; ++i) {', '}', () {
+          indent.writeln('value.push_back(ReadEncodedElement<T>(stream));');
+        });
+        indent.writeln('return value;');
+      },
+    );
+    indent.writeln('template <typename K, typename V>');
+    _writeFunctionDefinition(
+      indent,
+      'ReadEncodedUnorderedMap',
+      scope: _codecSerializerName,
+      returnType: 'std::unordered_map<K, V>',
+      parameters: <String>['uint8_t type', streamParameter],
+      isConst: true,
+      body: () {
+        indent.writeScoped('if (type != kEncodedMap) {', '}', () {
+          indent.writeln(
+            'return PigeonInternalUnorderedMapFromEncodable<K, V>(ReadValueOfType(type, stream));',
+          );
+        });
+        indent.writeln('const size_t size = ReadSize(stream);');
+        indent.writeln('std::unordered_map<K, V> value;');
+        indent.writeln('value.reserve(size);');
+        indent.writeScoped('for (size_t i = 0; i < size; ++i) {', '}', () {
+          indent.writeln(
+            '$_commentPrefix The key must be read before the value, and argument evaluation order is unspecified.',
+          );
+          indent.writeln('K key = ReadEncodedElement<K>(stream);');
+          indent.writeln('value.emplace(std::move(key), ReadEncodedElement<V>(stream));');
+        });
+        indent.writeln('return value;');
+      },
+    );
+  }
+
+  /// Writes the codec serializer method that reads [customType] directly from
+  /// the stream into its fields.
+  void _writeStreamDecodedClassReader(
+    Indent indent,
+    EnumeratedType customType,
+    Iterable<EnumeratedType> streamDecodedClasses, {
+    required bool typedCollections,
+  }) {
+    final Class classDefinition = customType.associatedClass!;
+    final List<NamedType> fields = getFieldsInSerializationOrder(classDefinition).toList();
+    _writeFunctionDefinition(
+      indent,
+      'Read${customType.name}',
+      scope: _codecSerializerName,
+      returnType: customType.name,
+      parameters: <String>['uint8_t type', '::flutter::ByteStreamReader* stream'],
+      isConst: true,
+      body: () {
+        indent.writeScoped('if (type != ${customType.enumeration}) {', '}', () {
+          indent.writeln(
+            'return std::move(std::any_cast<${customType.name}&>(std::get<CustomEncodableValue>(ReadValueOfType(type, stream))));',
+          );
+        });
+        indent.writeln('EncodableList list;');
+        indent.writeScoped(
+          'if (!ReadEncodedFieldList(stream, ${fields.length}, &list)) {',
+          '}',
+          () {
+            indent.writeln('return ${customType.name}::FromEncodableList(std::move(list));');
+          },
+        );
+        const instanceVariable = 'decoded';
+        indent.writeln('${customType.name} $instanceVariable;');
+        var declaredFieldType = false;
+        for (final field in fields) {
+          final HostDatatype hostDatatype = getFieldHostDatatype(
+            field,
+            _shortBaseCppTypeForBuiltinDartType,
+          );
+          final member = '$instanceVariable.${_makeInstanceVariableName(field)}';
+          String wrapValue(String value) => _isPointerField(hostDatatype)
+              ? 'std::make_unique<${hostDatatype.datatype}>($value)'
+              : value;
+          final String? reader = _streamReaderName(
+            field.type,
+            streamDecodedClasses,
+            typedCollections: typedCollections,
+          );
+          if (reader != null && !field.type.isNullable) {
+            indent.writeln('$member = ${wrapValue('$reader(stream->ReadByte(), stream)')};');
+          } else if (reader != null) {
+            indent.writeln(
+              '${declaredFieldType ? '' : 'uint8_t '}field_type = stream->ReadByte();',
+            );
+            declaredFieldType = true;
+            indent.writeScoped('if (field_type != kEncodedNull) {', '}', () {
+              indent.writeln('$member = ${wrapValue('$reader(field_type, stream)')};');
+            });
+          } else {
+            final encodableFieldName = '${_encodablePrefix}_${_makeVariableName(field)}';
+            indent.writeln('EncodableValue $encodableFieldName = ReadValue(stream);');
+            final String valueExpression = wrapValue(
+              _decodedFieldValueExpression(
+                field,
+                encodableFieldName,
+                move: true,
+                typedCollections: typedCollections,
+              ),
+            );
+            if (field.type.isNullable) {
+              indent.writeScoped('if (!$encodableFieldName.IsNull()) {', '}', () {
+                indent.writeln('$member = $valueExpression;');
+              });
+            } else {
+              indent.writeln('$member = $valueExpression;');
+            }
+          }
+        }
+        indent.writeln('return $instanceVariable;');
+      },
+    );
+  }
+
+  /// Writes the codec serializer methods that write builtin values directly
+  /// to the stream.
+  void _writeStreamEncodingHelpers(Indent indent) {
+    const streamParameter = '::flutter::ByteStreamWriter* stream';
+    _writeFunctionDefinition(
+      indent,
+      'WriteEncodedBool',
+      scope: _codecSerializerName,
+      returnType: _voidType,
+      parameters: <String>[_streamWriterValueParameter('bool'), streamParameter],
+      isConst: true,
+      body: () {
+        indent.writeln('stream->WriteByte(value ? kEncodedTrue : kEncodedFalse);');
+      },
+    );
+    _writeFunctionDefinition(
+      indent,
+      'WriteEncodedInt64',
+      scope: _codecSerializerName,
+      returnType: _voidType,
+      parameters: <String>[_streamWriterValueParameter('int64_t'), streamParameter],
+      isConst: true,
+      body: () {
+        indent.writeln('stream->WriteByte(kEncodedInt64);');
+        indent.writeln('stream->WriteInt64(value);');
+      },
+    );
+    _writeFunctionDefinition(
+      indent,
+      'WriteEncodedDouble',
+      scope: _codecSerializerName,
+      returnType: _voidType,
+      parameters: <String>[_streamWriterValueParameter('double'), streamParameter],
+      isConst: true,
+      body: () {
+        indent.writeln('stream->WriteByte(kEncodedFloat64);');
+        indent.writeln('stream->WriteAlignment(8);');
+        indent.writeln('stream->WriteDouble(value);');
+      },
+    );
+    _writeFunctionDefinition(
+      indent,
+      'WriteEncodedString',
+      scope: _codecSerializerName,
+      returnType: _voidType,
+      parameters: <String>[_streamWriterValueParameter('std::string'), streamParameter],
+      isConst: true,
+      body: () {
+        indent.writeln('stream->WriteByte(kEncodedString);');
+        indent.writeln('WriteSize(value.size(), stream);');
+        indent.writeScoped('if (!value.empty()) {', '}', () {
+          indent.writeln(
+            'stream->WriteBytes(reinterpret_cast<const uint8_t*>(value.data()), value.size());',
+          );
+        });
+      },
+    );
+    indent.writeln('template <typename T>');
+    _writeFunctionDefinition(
+      indent,
+      'WriteEncodedTypedData',
+      scope: _codecSerializerName,
+      returnType: _voidType,
+      parameters: <String>['const std::vector<T>& value', streamParameter],
+      isConst: true,
+      body: () {
+        indent.format('''
+stream->WriteByte(
+	std::is_same_v<T, uint8_t> ? kEncodedUInt8List
+	: std::is_same_v<T, int32_t> ? kEncodedInt32List
+	: std::is_same_v<T, int64_t> ? kEncodedInt64List
+	: kEncodedFloat64List);''');
+        indent.writeln('WriteSize(value.size(), stream);');
+        indent.writeScoped('if (sizeof(T) > 1) {', '}', () {
+          indent.writeln('stream->WriteAlignment(sizeof(T));');
+        });
+        indent.writeScoped('if (!value.empty()) {', '}', () {
+          indent.writeln(
+            'stream->WriteBytes(reinterpret_cast<const uint8_t*>(value.data()), value.size() * sizeof(T));',
+          );
+        });
+      },
+    );
+    _writeFunctionDefinition(
+      indent,
+      'WriteEncodedList',
+      scope: _codecSerializerName,
+      returnType: _voidType,
+      parameters: <String>['const EncodableList& value', streamParameter],
+      isConst: true,
+      body: () {
+        indent.writeln('stream->WriteByte(kEncodedList);');
+        indent.writeln('WriteSize(value.size(), stream);');
+        indent.writeScoped('for (const EncodableValue& element : value) {', '}', () {
+          indent.writeln('WriteValue(element, stream);');
+        });
+      },
+    );
+    _writeFunctionDefinition(
+      indent,
+      'WriteEncodedMap',
+      scope: _codecSerializerName,
+      returnType: _voidType,
+      parameters: <String>['const EncodableMap& value', streamParameter],
+      isConst: true,
+      body: () {
+        indent.writeln('stream->WriteByte(kEncodedMap);');
+        indent.writeln('WriteSize(value.size(), stream);');
+        indent.writeScoped('for (const auto& [key, element] : value) {', '}', () {
+          indent.writeln('WriteValue(key, stream);');
+          indent.writeln('WriteValue(element, stream);');
+        });
+      },
+    );
+  }
+
+  /// Writes the codec serializer methods that write typed collections
+  /// directly to the stream, in the same format as the EncodableList or
+  /// EncodableMap that they convert to.
+  void _writeStreamTypedCollectionEncodingHelpers(Indent indent) {
+    const streamParameter = '::flutter::ByteStreamWriter* stream';
+    indent.writeln('template <typename T>');
+    _writeFunctionDefinition(
+      indent,
+      'WriteEncodedElement',
+      scope: _codecSerializerName,
+      returnType: _voidType,
+      parameters: <String>['const T& value', streamParameter],
+      isConst: true,
+      body: () {
+        indent.format('''
+if constexpr (std::is_same_v<T, bool>) {
+	WriteEncodedBool(value, stream);
+} else if constexpr (std::is_same_v<T, int64_t>) {
+	WriteEncodedInt64(value, stream);
+} else if constexpr (std::is_same_v<T, double>) {
+	WriteEncodedDouble(value, stream);
+} else {
+	WriteEncodedString(value, stream);
+}''');
+      },
+    );
+    indent.writeln('template <typename T>');
+    _writeFunctionDefinition(
+      indent,
+      'WriteEncodedVector',
+      scope: _codecSerializerName,
+      returnType: _voidType,
+      parameters: <String>['const std::vector<T>& value', streamParameter],
+      isConst: true,
+      body: () {
+        indent.writeln('stream->WriteByte(kEncodedList);');
+        indent.writeln('WriteSize(value.size(), stream);');
+        indent.writeScoped('for (const T& element : value) {', '}', () {
+          indent.writeln('WriteEncodedElement(element, stream);');
+        });
+      },
+    );
+    indent.writeln('template <typename K, typename V>');
+    _writeFunctionDefinition(
+      indent,
+      'WriteEncodedUnorderedMap',
+      scope: _codecSerializerName,
+      returnType: _voidType,
+      parameters: <String>['const std::unordered_map<K, V>& value', streamParameter],
+      isConst: true,
+      body: () {
+        indent.writeln('stream->WriteByte(kEncodedMap);');
+        indent.writeln('WriteSize(value.size(), stream);');
+        indent.writeScoped('for (const auto& [key, element] : value) {', '}', () {
+          indent.writeln('WriteEncodedElement(key, stream);');
+          indent.writeln('WriteEncodedElement(element, stream);');
+        });
+      },
+    );
+  }
+
+  /// Writes the codec serializer method that writes the fields of
+  /// [customType] directly to the stream, in the same format as its encodable
+  /// list.
+  void _writeStreamEncodedClassWriter(
+    Indent indent,
+    EnumeratedType customType,
+    Iterable<EnumeratedType> enumeratedTypes, {
+    required bool typedCollections,
+  }) {
+    final Class classDefinition = customType.associatedClass!;
+    final List<NamedType> fields = getFieldsInSerializationOrder(classDefinition).toList();
+    _writeFunctionDefinition(
+      indent,
+      'WriteFields',
+      scope: _codecSerializerName,
+      returnType: _voidType,
+      parameters: <String>[
+        'const ${customType.name}& value',
+        '::flutter::ByteStreamWriter* stream',
+      ],
+      isConst: true,
+      body: () {
+        indent.writeln('stream->WriteByte(kEncodedList);');
+        indent.writeln('WriteSize(${fields.length}, stream);');
+        for (final field in fields) {
+          final HostDatatype hostDatatype = getFieldHostDatatype(
+            field,
+            _shortBaseCppTypeForBuiltinDartType,
+          );
+          final member = 'value.${_makeInstanceVariableName(field)}';
+          final fieldValue = hostDatatype.isNullable || _isPointerField(hostDatatype)
+              ? '*$member'
+              : member;
+          void writeField() {
+            _writeStreamEncodedValue(
+              indent,
+              field.type,
+              fieldValue,
+              enumeratedTypes,
+              typedCollections: typedCollections,
+            );
+          }
+
+          if (field.type.isNullable) {
+            indent.writeScoped('if ($member) {', '} else {', writeField);
+            indent.nest(1, () {
+              indent.writeln('stream->WriteByte(kEncodedNull);');
+            });
+            indent.writeln('}');
+          } else {
+            writeField();
+          }
+        }
+      },
+    );
+  }
+
+  /// Writes the statements that write [value], a non-null value of [type],
+  /// directly to the stream.
+  void _writeStreamEncodedValue(
+    Indent indent,
+    TypeDeclaration type,
+    String value,
+    Iterable<EnumeratedType> enumeratedTypes, {
+    bool typedCollections = false,
+  }) {
+    if (type.isClass || type.isEnum) {
+      final EnumeratedType? customType = enumeratedTypes
+          .where((EnumeratedType customType) => customType.name == type.baseName)
+          .firstOrNull;
+      if (customType == null || customType.enumeration >= maximumCodecFieldKey) {
+        indent.writeln('WriteValue(CustomEncodableValue($value), stream);');
+      } else if (type.isEnum) {
+        indent.writeln('stream->WriteByte(${customType.enumeration});');
+        indent.writeln('WriteValue(EncodableValue(static_cast<int>($value)), stream);');
+      } else {
+        indent.writeln('stream->WriteByte(${customType.enumeration});');
+        indent.writeln('WriteFields($value, stream);');
+      }
+      return;
+    }
+    final String writer = switch (type.baseName) {
+      'bool' => 'WriteEncodedBool',
+      'int' => 'WriteEncodedInt64',
+      'double' => 'WriteEncodedDouble',
+      'String' => 'WriteEncodedString',
+      'Uint8List' || 'Int32List' || 'Int64List' || 'Float64List' => 'WriteEncodedTypedData',
+      'List' when typedCollections && _typedCollectionType(type) != null => 'WriteEncodedVector',
+      'Map' when typedCollections && _typedCollectionType(type) != null =>
+        'WriteEncodedUnorderedMap',
+      'List' => 'WriteEncodedList',
+      'Map' => 'WriteEncodedMap',
+      _ => 'WriteValue',
+    };
+    indent.writeln('$writer($value, stream);');
+  }
+
+  @override
+  void writeFlutterApi(
+    InternalCppOptions generatorOptions,
+    Root root,
+    Indent indent,
+    AstFlutterApi api, {
+    required String dartPackageName,
+  }) {
+    indent.writeln(
+      '$_commentPrefix Generated class from Pigeon that represents Flutter messages that can be called from C++.',
+    );
+    _writeFunctionDefinition(
+      indent,
+      api.name,
+      scope: api.name,
+      parameters: <String>['::flutter::BinaryMessenger* binary_messenger'],
+      initializers: <String>['binary_messenger_(binary_messenger)', 'message_channel_suffix_("")'],
+    );
+    _writeFunctionDefinition(
+      indent,
+      api.name,
+      scope: api.name,
+      parameters: <String>[
+        '::flutter::BinaryMessenger* binary_messenger',
+        'const std::string& message_channel_suffix',
+      ],
+      initializers: <String>[
+        'binary_messenger_(binary_messenger)',
+        'message_channel_suffix_(message_channel_suffix.length() > 0 ? std::string(".") + message_channel_suffix : "")',
+      ],
+    );
+    _writeFunctionDefinition(
+      indent,
+      'GetCodec',
+      scope: api.name,
+      returnType: 'const ::flutter::StandardMessageCodec&',
+      body: () {
+        indent.writeln(
+          'return ::flutter::StandardMessageCodec::GetInstance(&$_codecSerializerName::GetInstance());',
+        );
+      },
+    );
+    for (final Method func in api.methods) {
+      final HostDatatype returnType = _getHostDatatype(
+        func.returnType,
+        _shortBaseCppTypeForBuiltinDartType,
+      );
+
+      // Determine the input parameter list, saved in a structured form for later
+      // use as platform channel call arguments.
+      final Iterable<_HostNamedType> hostParameters = indexMap(func.parameters, (
+        int i,
+        NamedType arg,
+      ) {
+        final HostDatatype hostType = _getFieldHostDatatype(
+          arg,
+          _shortBaseCppTypeForBuiltinDartType,
+        );
+        return _HostNamedType(_getSafeArgumentName(i, arg), hostType, arg.type);
+      });
+      final parameters = <String>[
+        ...hostParameters.map(
+          (_HostNamedType arg) => '${_flutterApiArgumentType(arg.hostType)} ${arg.name}',
+        ),
+        ..._flutterApiCallbackParameters(returnType),
+      ];
+      _writeFunctionDefinition(
+        indent,
+        _makeMethodName(func),
+        scope: api.name,
+        returnType: _voidType,
+        parameters: parameters,
+        body: () {
+          _writeFlutterMethodBody(
+            indent,
+            root,
+            func,
+            channelName: '"${makeChannelName(api, func, dartPackageName)}" + message_channel_suffix_',
+            channelVariable: _makeChannelVariableName(func),
+            hostParameters: hostParameters,
+          );
+        },
+      );
+      if (generatorOptions.coroutines) {
+        _writeFunctionDefinition(
+          indent,
+          _makeMethodName(func),
+          scope: api.name,
+          returnType: 'PigeonFlutterApiCall<${_hostApiReturnType(returnType)}>',
+          parameters: hostParameters
+              .map((_HostNamedType arg) => '${_flutterApiArgumentType(arg.hostType)} ${arg.name}')
+              .toList(),
+          body: () {
+            _writeAwaitableFlutterMethodBody(
+              indent,
+              root,
+              func,
+              channelName:
+                  '"${makeChannelName(api, func, dartPackageName)}" + message_channel_suffix_',
+              channelVariable: _makeChannelVariableName(func),
+              hostParameters: hostParameters,
+            );
+          },
+        );
+      }
+    }
+  }
+
+  /// Writes the body of a function that sends the Flutter method [func] on the
+  /// channel named by the expression [channelName].
+  ///
+  /// If [channelVariable] is set, the channel is the
+  /// `PigeonInternalFlutterMethodChannel` held in that member, which is created
+  /// on the first call. Otherwise a channel is created for the call.
+  ///
+  /// The message holds [leadingArguments], which are already encoded, followed
+  /// by [hostParameters]. It is encoded with [codec], and the reply is decoded
+  /// with [replyCodec] in a callback that also captures [replyCaptures].
+  void _writeFlutterMethodBody(
+    Indent indent,
+    Root root,
+    Method func, {
+    required String channelName,
+    String? channelVariable,
+    required Iterable<_HostNamedType> hostParameters,
+    List<String> leadingArguments = const <String>[],
+    String codec = '&GetCodec()',
+    String replyCodec = 'GetCodec()',
+    List<String> replyCaptures = const <String>[],
+  }) {
+    final HostDatatype returnType = _getHostDatatype(
+      func.returnType,
+      _shortBaseCppTypeForBuiltinDartType,
+    );
+    if (channelVariable != null) {
+      _writeFlutterMethodChannelCreation(
+        indent,
+        channelVariable: channelVariable,
+        channelName: channelName,
+        codec: codec,
+      );
+    } else {
+      indent.writeln('const std::string channel_name = $channelName;');
+      indent.writeln('BasicMessageChannel<> channel(binary_messenger_, channel_name, $codec);');
+    }
+    _writeFlutterMethodArguments(
+      indent,
+      root,
+      hostParameters: hostParameters,
+      leadingArguments: leadingArguments,
+    );
+
+    final String captures = <String>[
+      if (channelVariable != null) 'channel = $channelVariable' else 'channel_name',
+      ...replyCaptures,
+      'on_success = std::move(on_success)',
+      'on_error = std::move(on_error)',
+    ].join(', ');
+    final String send = channelVariable != null ? '$channelVariable->channel().Send' : 'channel.Send';
+    indent.write(
+      '$send($_flutterMethodArgumentsName, '
+      '[$captures](const uint8_t* reply, size_t reply_size) ',
+    );
+    indent.addScoped('{', '});', () {
+      String successCallbackArgument;
+      successCallbackArgument = 'return_value';
+      final encodedReplyName = 'encodable_$successCallbackArgument';
+      final listReplyName = 'list_$successCallbackArgument';
+      indent.writeln(
+        'std::unique_ptr<EncodableValue> response = $replyCodec.DecodeMessage(reply, reply_size);',
+      );
+      indent.writeln('const auto& $encodedReplyName = *response;');
+      indent.writeln(
+        'const auto* $listReplyName = std::get_if<EncodableList>(&$encodedReplyName);',
+      );
+      indent.writeScoped('if ($listReplyName) {', '} ', () {
+        indent.writeScoped('if ($listReplyName->size() > 1) {', '} ', () {
+          indent.writeln(
+            'on_error(FlutterError(std::get<std::string>($listReplyName->at(0)), std::get<std::string>($listReplyName->at(1)), $listReplyName->at(2)));',
+          );
+        }, addTrailingNewline: false);
+        indent.addScoped('else {', '}', () {
+          if (func.returnType.isVoid) {
+            successCallbackArgument = '';
+          } else {
+            _writeEncodableValueArgumentUnwrapping(
+              indent,
+              root,
+              returnType,
+              argName: successCallbackArgument,
+              encodableArgName: '$listReplyName->at(0)',
+              apiType: ApiType.flutter,
+            );
+          }
+          indent.writeln('on_success($successCallbackArgument);');
+        });
+      }, addTrailingNewline: false);
+      indent.addScoped('else {', '} ', () {
+        indent.writeln(
+          'on_error(CreateConnectionError(${channelVariable != null ? 'channel->name()' : 'channel_name'}));',
+        );
+      });
+    });
+  }
+
+  /// Writes the creation of the `PigeonInternalFlutterMethodChannel` named by
+  /// [channelName] into the member [channelVariable] if it hasn't been created
+  /// by an earlier call.
+  void _writeFlutterMethodChannelCreation(
+    Indent indent, {
+    required String channelVariable,
+    required String channelName,
+    String codec = '&GetCodec()',
+  }) {
+    indent.writeScoped('if (!$channelVariable) {', '}', () {
+      indent.writeln(
+        '$channelVariable = std::make_shared<PigeonInternalFlutterMethodChannel>(binary_messenger_, $channelName, $codec);',
+      );
+    });
+  }
+
+  /// Writes the declaration of [_flutterMethodArgumentsName], the message of a
+  /// Flutter method that holds [leadingArguments], which are already encoded,
+  /// followed by [hostParameters].
+  void _writeFlutterMethodArguments(
+    Indent indent,
+    Root root, {
+    required Iterable<_HostNamedType> hostParameters,
+    List<String> leadingArguments = const <String>[],
+  }) {
+    // Convert arguments to EncodableValue versions.
+    indent.write('EncodableValue $_flutterMethodArgumentsName = ');
+    if (leadingArguments.isEmpty && hostParameters.isEmpty) {
+      indent.addln('EncodableValue();');
+    } else {
+      indent.addScoped('EncodableValue(EncodableList{', '});', () {
+        for (final argument in leadingArguments) {
+          indent.writeln('$argument,');
+        }
+        for (final param in hostParameters) {
+          final String encodedArgument = _wrappedHostApiArgumentExpression(
+            root,
+            param.name,
+            param.originalType,
+            param.hostType,
+            false,
+          );
+          indent.writeln('$encodedArgument,');
+        }
+      });
+    }
+  }
+
+  /// Writes the body of the overload of the Flutter method [func] that returns
+  /// a `PigeonFlutterApiCall` for the channel named by [channelName], which is
+  /// held in the member [channelVariable].
+  ///
+  /// The reply is decoded by a function rather than a callback capturing the
+  /// channel name and callbacks, so awaiting the call doesn't allocate
+  /// anything beyond the message.
+  void _writeAwaitableFlutterMethodBody(
+    Indent indent,
+    Root root,
+    Method func, {
+    required String channelName,
+    required String channelVariable,
+    required Iterable<_HostNamedType> hostParameters,
+  }) {
+    final HostDatatype returnType = _getHostDatatype(
+      func.returnType,
+      _shortBaseCppTypeForBuiltinDartType,
+    );
+    final String resultType = _hostApiReturnType(returnType);
+    _writeFlutterMethodChannelCreation(
+      indent,
+      channelVariable: channelVariable,
+      channelName: channelName,
+    );
+    _writeFlutterMethodArguments(indent, root, hostParameters: hostParameters);
+    indent.writeln(
+      'return PigeonFlutterApiCall<$resultType>(binary_messenger_, $channelVariable, '
+      'GetCodec().EncodeMessage($_flutterMethodArgumentsName), '
+      '[](const std::string& channel_name, const uint8_t* reply, size_t reply_size) -> $resultType {',
+    );
+    indent.nest(1, () {
+      indent.writeln(
+        'std::unique_ptr<EncodableValue> response = GetCodec().DecodeMessage(reply, reply_size);',
+      );
+      indent.writeln(
+        'const auto* list_return_value = std::get_if<EncodableList>(response.get());',
+      );
+      indent.writeScoped('if (!list_return_value) {', '}', () {
+        indent.writeln('return CreateConnectionError(channel_name);');
+      });
+      indent.writeScoped('if (list_return_value->size() > 1) {', '}', () {
+        indent.writeln(
+          'return FlutterError(std::get<std::string>(list_return_value->at(0)), std::get<std::string>(list_return_value->at(1)), list_return_value->at(2));',
+        );
+      });
+      if (func.returnType.isVoid) {
+        indent.writeln('return std::nullopt;');
+      } else {
+        _writeEncodableValueArgumentUnwrapping(
+          indent,
+          root,
+          returnType,
+          argName: 'return_value',
+          encodableArgName: 'list_return_value->at(0)',
+          apiType: ApiType.flutter,
+        );
+        if (returnType.isNullable) {
+          indent.writeln(
+            'return return_value ? std::optional<${returnType.datatype}>(*return_value) : std::nullopt;',
+          );
+        } else {
+          indent.writeln('return return_value;');
+        }
+      }
+    });
+    indent.writeln('});');
+  }
+
+  @override
+  void writeHostApi(
+    InternalCppOptions generatorOptions,
+    Root root,
+    Indent indent,
+    AstHostApi api, {
+    required String dartPackageName,
+  }) {
+    indent.writeln('/// The codec used by ${api.name}.');
+    _writeFunctionDefinition(
+      indent,
+      'GetCodec',
+      scope: api.name,
+      returnType: 'const ::flutter::StandardMessageCodec&',
+      body: () {
+        indent.writeln(
+          'return ::flutter::StandardMessageCodec::GetInstance(&$_codecSerializerName::GetInstance());',
+        );
+      },
+    );
+    indent.writeln(
+      '$_commentPrefix Sets up an instance of `${api.name}` to handle messages through the `binary_messenger`.',
+    );
+    _writeFunctionDefinition(
+      indent,
+      'SetUp',
+      scope: api.name,
+      returnType: _voidType,
+      parameters: <String>['::flutter::BinaryMessenger* binary_messenger', '${api.name}* api'],
+      body: () {
+        indent.writeln('${api.name}::SetUp(binary_messenger, api, "");');
+      },
+    );
+    final bool usesTaskQueues = api.methods.any(_usesTaskQueue);
+    final bool usesTable = _usesHostMethodTable(generatorOptions, api);
+    if (usesTaskQueues) {
+      _writeFunctionDefinition(
+        indent,
+        'SetUp',
+        scope: api.name,
+        returnType: _voidType,
+        parameters: <String>[
+          '::flutter::BinaryMessenger* binary_messenger',
+          '${api.name}* api',
+          'const std::string& message_channel_suffix',
+        ],
+        body: () {
+          indent.writeln(
+            '${api.name}::SetUp(binary_messenger, api, message_channel_suffix, nullptr);',
+          );
+        },
+      );
+    }
+    _writeFunctionDefinition(
+      indent,
+      'SetUp',
+      scope: api.name,
+      returnType: _voidType,
+      parameters: <String>[
+        '::flutter::BinaryMessenger* binary_messenger',
+        '${api.name}* api',
+        'const std::string& message_channel_suffix',
+        if (usesTaskQueues) 'std::shared_ptr<PigeonTaskQueue> task_queue',
+      ],
+      body: () {
+        if (usesTable) {
+          _writeHostMethodTable(
+            indent,
+            api,
+            dartPackageName: dartPackageName,
+            usesTaskQueues: _hasTaskQueueMethods(root),
+          );
+          return;
+        }
+        indent.writeln(
+          'const std::string prepended_suffix = message_channel_suffix.length() > 0 ? std::string(".") + message_channel_suffix : "";',
+        );
+        for (final Method method in api.methods) {
+          final String channelName = makeChannelName(api, method, dartPackageName);
+          final bool usesTaskQueue = _usesTaskQueue(method);
+          indent.writeScoped('{', '}', () {
+            if (usesTaskQueue) {
+              indent.writeln(
+                'const std::string channel_name = "$channelName" + prepended_suffix;',
+              );
+            } else {
+              indent.writeln(
+                'BasicMessageChannel<> channel(binary_messenger, '
+                '"$channelName" + prepended_suffix, &GetCodec());',
+              );
+            }
+            final bool readsChunks = method.parameters.any(
+              (Parameter param) => param.type.isChunked,
+            );
+            final bool servesChunks = method.returnType.isChunked;
+            if (servesChunks) {
+              indent.writeln(
+                'BasicMessageChannel<> chunks_channel(binary_messenger, '
+                '"$channelName" + prepended_suffix + "$chunkChannelSuffix", &GetCodec());',
+              );
+            }
+            indent.writeScoped('if (api != nullptr) {', '} else {', () {
+              if (servesChunks) {
+                indent.writeln(
+                  'auto streams = std::make_shared<PigeonInternalByteStreams>();',
+                );
+              }
+              final captures = <String>[
+                'api',
+                if (readsChunks) 'binary_messenger',
+                if (servesChunks) 'streams',
+              ];
+              final handlerParameters =
+                  '[${captures.join(', ')}](const EncodableValue& message, const ::flutter::MessageReply<EncodableValue>& reply) ';
+              if (usesTaskQueue) {
+                // The handler is the same, but is run on the task queue.
+                indent.write(
+                  'PigeonInternalSetTaskQueueMessageHandler(binary_messenger, channel_name, &GetCodec(), task_queue, $handlerParameters',
+                );
+              } else {
+                indent.write('channel.SetMessageHandler($handlerParameters');
+              }
+              indent.addScoped('{', '});', () {
+                _writeHostMethodHandlerBody(indent, () {
+                  final List<String> methodArguments = _writeHostMethodArgumentUnwrapping(
+                    indent,
+                    root,
+                    method.parameters,
                   );
-                }
-                indent.writeln('on_success($successCallbackArgument);');
+                  _writeHostMethodCall(
+                    indent,
+                    root,
+                    method,
+                    methodArguments,
+                    coroutine: generatorOptions.coroutines,
+                  );
+                });
               });
-            }, addTrailingNewline: false);
-            indent.addScoped('else {', '} ', () {
-              indent.writeln('on_error(CreateConnectionError(channel_name));');
+              if (servesChunks) {
+                indent.writeScoped(
+                  'chunks_channel.SetMessageHandler([streams](const EncodableValue& message, const ::flutter::MessageReply<EncodableValue>& reply) {',
+                  '});',
+                  () {
+                    indent.writeln('streams->ReadChunk(message, reply);');
+                  },
+                );
+              }
+            });
+            indent.addScoped(null, '}', () {
+              if (usesTaskQueue) {
+                indent.writeln('binary_messenger->SetMessageHandler(channel_name, nullptr);');
+              } else {
+                indent.writeln('channel.SetMessageHandler(nullptr);');
+              }
+              if (servesChunks) {
+                indent.writeln('chunks_channel.SetMessageHandler(nullptr);');
+              }
             });
           });
+        }
+      },
+    );
+
+    if (usesTable) {
+      for (final Method method in api.methods) {
+        _writeFunctionDefinition(
+          indent,
+          _hostMethodHandlerName(method),
+          scope: api.name,
+          returnType: _voidType,
+          parameters: <String>[
+            '${api.name}* api',
+            'const EncodableValue& message',
+            'const ::flutter::MessageReply<EncodableValue>& reply',
+          ],
+          body: () {
+            final List<String> methodArguments = _writeHostMethodArgumentUnwrapping(
+              indent,
+              root,
+              method.parameters,
+            );
+            _writeHostMethodCall(
+              indent,
+              root,
+              method,
+              methodArguments,
+              coroutine: generatorOptions.coroutines,
+            );
+          },
+        );
+      }
+    }
+
+    _writeWrapErrorDefinitions(indent, api.name);
+  }
+
+  /// Writes the body of the `SetUp` of a table-driven host API, which
+  /// registers the handlers in a static table of [api]'s methods.
+  void _writeHostMethodTable(
+    Indent indent,
+    AstHostApi api, {
+    required String dartPackageName,
+    required bool usesTaskQueues,
+  }) {
+    indent.writeScoped(
+      'static constexpr PigeonInternalHostMethod<${api.name}> kMethods[] = {',
+      '};',
+      () {
+        for (final Method method in api.methods) {
+          final String taskQueueFlag = usesTaskQueues ? ', ${_usesTaskQueue(method)}' : '';
+          indent.writeln(
+            '{"${method.name}", &${api.name}::${_hostMethodHandlerName(method)}$taskQueueFlag},',
+          );
+        }
+      },
+    );
+    final String channelPrefix = makeChannelNameWithStrings(
+      apiName: api.name,
+      methodName: '',
+      dartPackageName: dartPackageName,
+    );
+    final taskQueueArgument = usesTaskQueues
+        ? (api.methods.any(_usesTaskQueue) ? ', task_queue' : ', nullptr')
+        : '';
+    indent.writeln(
+      'PigeonInternalSetUpHostMethods(binary_messenger, api, "$channelPrefix", '
+      'message_channel_suffix, kMethods$taskQueueArgument);',
+    );
+  }
+
+  @override
+  void writeProxyApi(
+    InternalCppOptions generatorOptions,
+    Root root,
+    Indent indent,
+    AstProxyApi api, {
+    required String dartPackageName,
+  }) {
+    _writeFunctionDefinition(
+      indent,
+      api.name,
+      scope: api.name,
+      parameters: <String>[
+        '::flutter::BinaryMessenger* binary_messenger',
+        'std::shared_ptr<$_instanceManagerClassName> instance_manager',
+      ],
+      initializers: <String>[
+        'binary_messenger_(binary_messenger)',
+        'instance_manager_(std::move(instance_manager))',
+      ],
+    );
+    if (api.hasAnyHostMessageCalls()) {
+      _writeProxyApiSetUp(indent, root, api, dartPackageName: dartPackageName);
+      _writeWrapErrorDefinitions(indent, api.name);
+    }
+    for (final (Method func, String channelMethodName) in _proxyApiFlutterMethods(api)) {
+      final HostDatatype returnType = _getHostDatatype(
+        func.returnType,
+        _shortBaseCppTypeForBuiltinDartType,
+      );
+      final Iterable<_HostNamedType> hostParameters = indexMap(func.parameters, (
+        int i,
+        NamedType arg,
+      ) {
+        final HostDatatype hostType = _getFieldHostDatatype(
+          arg,
+          _shortBaseCppTypeForBuiltinDartType,
+        );
+        return _HostNamedType(_getSafeArgumentName(i, arg), hostType, arg.type);
+      });
+      final bool isNewInstance = channelMethodName == _proxyApiNewInstanceMethodName;
+      final String channelName = makeChannelNameWithStrings(
+        apiName: api.name,
+        methodName: channelMethodName,
+        dartPackageName: dartPackageName,
+      );
+      _writeFunctionDefinition(
+        indent,
+        _makeMethodName(func),
+        scope: api.name,
+        returnType: _voidType,
+        parameters: <String>[
+          'const $_proxyApiInstanceType& pigeon_instance',
+          ...hostParameters.map(
+            (_HostNamedType arg) => '${_flutterApiArgumentType(arg.hostType)} ${arg.name}',
+          ),
+          ..._flutterApiCallbackParameters(returnType),
+        ],
+        body: () {
+          if (isNewInstance) {
+            indent.writeln(
+              'const int64_t pigeon_identifier = instance_manager_->AddHostCreatedInstance(pigeon_instance);',
+            );
+            indent.writeScoped('if (pigeon_identifier < 0) {', '}', () {
+              indent.writeln(
+                '$_commentPrefix Dart already has an instance, so there is nothing to send.',
+              );
+              indent.writeln('on_success();');
+              indent.writeln('return;');
+            });
+          } else {
+            indent.writeScoped(
+              'if (!instance_manager_->ContainsInstance(pigeon_instance.get())) {',
+              '}',
+              () {
+                indent.writeln(
+                  'on_error(FlutterError("missing-instance-error", "Callback to ${api.name}.${func.name} '
+                  'failed because the native instance was not in the instance manager."));',
+                );
+                indent.writeln('return;');
+              },
+            );
+          }
+          _writeFlutterMethodBody(
+            indent,
+            root,
+            func,
+            channelName: '"$channelName"',
+            hostParameters: hostParameters,
+            leadingArguments: <String>[
+              if (isNewInstance)
+                'EncodableValue(pigeon_identifier)'
+              else
+                'CustomEncodableValue(pigeon_instance)',
+            ],
+            codec: '&instance_manager_->GetCodec()',
+            replyCodec: 'instance_manager->GetCodec()',
+            replyCaptures: <String>['instance_manager = instance_manager_'],
+          );
         },
       );
     }
   }
 
-  @override
-  void writeHostApi(
-    InternalCppOptions generatorOptions,
-    Root root,
+  /// Writes the `SetUp` function of [api], which sets up the handlers for its
+  /// constructors, attached fields and host methods.
+  void _writeProxyApiSetUp(
     Indent indent,
-    AstHostApi api, {
+    Root root,
+    AstProxyApi api, {
     required String dartPackageName,
   }) {
-    indent.writeln('/// The codec used by ${api.name}.');
-    _writeFunctionDefinition(
-      indent,
-      'GetCodec',
-      scope: api.name,
-      returnType: 'const ::flutter::StandardMessageCodec&',
-      body: () {
-        indent.writeln(
-          'return ::flutter::StandardMessageCodec::GetInstance(&$_codecSerializerName::GetInstance());',
-        );
-      },
+    String channelName(String methodName) => makeChannelNameWithStrings(
+      apiName: api.name,
+      methodName: methodName,
+      dartPackageName: dartPackageName,
     );
     indent.writeln(
       '$_commentPrefix Sets up an instance of `${api.name}` to handle messages through the `binary_messenger`.',
@@ -1836,116 +5502,98 @@ EncodableValue $_overflowClassName::FromEncodableList(
       returnType: _voidType,
       parameters: <String>['::flutter::BinaryMessenger* binary_messenger', '${api.name}* api'],
       body: () {
-        indent.writeln('${api.name}::SetUp(binary_messenger, api, "");');
-      },
-    );
-    _writeFunctionDefinition(
-      indent,
-      'SetUp',
-      scope: api.name,
-      returnType: _voidType,
-      parameters: <String>[
-        '::flutter::BinaryMessenger* binary_messenger',
-        '${api.name}* api',
-        'const std::string& message_channel_suffix',
-      ],
-      body: () {
+        // Instances are only sent as identifiers once there is an instance
+        // manager, so handlers are cleared with the plain codec.
         indent.writeln(
-          'const std::string prepended_suffix = message_channel_suffix.length() > 0 ? std::string(".") + message_channel_suffix : "";',
+          'const ::flutter::StandardMessageCodec* codec = api != nullptr '
+          '? &api->instance_manager_->GetCodec() '
+          ': &::flutter::StandardMessageCodec::GetInstance(&$_codecSerializerName::GetInstance());',
         );
-        for (final Method method in api.methods) {
-          final String channelName = makeChannelName(api, method, dartPackageName);
-          indent.writeScoped('{', '}', () {
+        for (final Constructor constructor in api.constructors) {
+          final String constructorChannelName = channelName(_proxyApiConstructorName(constructor));
+          _writeProxyApiMessageHandler(indent, constructorChannelName, () {
+            final List<String> arguments = _writeHostMethodArgumentUnwrapping(
+              indent,
+              root,
+              <NamedType>[
+                _proxyApiIdentifierParameter(),
+                ...api.unattachedFields,
+                ...constructor.parameters,
+              ],
+            );
+            final Method method = _proxyApiConstructorMethod(api, constructor);
             indent.writeln(
-              'BasicMessageChannel<> channel(binary_messenger, '
-              '"$channelName" + prepended_suffix, &GetCodec());',
+              'ErrorOr<$_proxyApiInstanceType> output = '
+              'api->${_makeMethodName(method)}(${arguments.skip(1).join(', ')});',
             );
-            indent.writeScoped('if (api != nullptr) {', '} else {', () {
-              indent.write(
-                'channel.SetMessageHandler([api](const EncodableValue& message, const ::flutter::MessageReply<EncodableValue>& reply) ',
-              );
-              indent.addScoped('{', '});', () {
-                indent.writeScoped('try {', '}', () {
-                  final methodArgument = <String>[];
-                  if (method.parameters.isNotEmpty) {
-                    indent.writeln('const auto& args = std::get<EncodableList>(message);');
-
-                    enumerate(method.parameters, (int index, NamedType arg) {
-                      final HostDatatype hostType = getHostDatatype(
-                        arg.type,
-                        (TypeDeclaration x) => _shortBaseCppTypeForBuiltinDartType(x),
-                      );
-                      final String argName = _getSafeArgumentName(index, arg);
-
-                      final encodableArgName = '${_encodablePrefix}_$argName';
-                      indent.writeln('const auto& $encodableArgName = args.at($index);');
-                      if (!arg.type.isNullable) {
-                        indent.writeScoped('if ($encodableArgName.IsNull()) {', '}', () {
-                          indent.writeln('reply(WrapError("$argName unexpectedly null."));');
-                          indent.writeln('return;');
-                        });
-                      }
-                      _writeEncodableValueArgumentUnwrapping(
-                        indent,
-                        root,
-                        hostType,
-                        argName: argName,
-                        encodableArgName: encodableArgName,
-                        apiType: ApiType.host,
-                      );
-                      final unwrapEnum = arg.type.isEnum && arg.type.isNullable
-                          ? ' ? &(*$argName) : nullptr'
-                          : '';
-                      methodArgument.add('$argName$unwrapEnum');
-                    });
-                  }
-
-                  final HostDatatype returnType = getHostDatatype(
-                    method.returnType,
-                    _shortBaseCppTypeForBuiltinDartType,
-                  );
-                  final String returnTypeName = _hostApiReturnType(returnType);
-                  if (method.isAsynchronous) {
-                    methodArgument.add(
-                      '[reply]($returnTypeName&& output) {${indent.newline}'
-                      '${_wrapResponse(indent, root, method.returnType, prefix: '\t')}${indent.newline}'
-                      '}',
-                    );
-                  }
-                  final call = 'api->${_makeMethodName(method)}(${methodArgument.join(', ')})';
-                  if (method.isAsynchronous) {
-                    indent.format('$call;');
-                  } else {
-                    indent.writeln('$returnTypeName output = $call;');
-                    indent.format(_wrapResponse(indent, root, method.returnType));
-                  }
-                }, addTrailingNewline: false);
-                indent.add(' catch (const std::exception& exception) ');
-                indent.addScoped('{', '}', () {
-                  // There is a potential here for `reply` to be called twice, which
-                  // is a violation of the API contract, because there's no way of
-                  // knowing whether or not the plugin code called `reply` before
-                  // throwing. Since use of `@async` suggests that the reply is
-                  // probably not sent within the scope of the stack, err on the
-                  // side of potential double-call rather than no call (which is
-                  // also an API violation) so that unexpected errors have a better
-                  // chance of being caught and handled in a useful way.
-                  indent.writeln('reply(WrapError(exception.what()));');
-                });
-              });
-            });
-            indent.addScoped(null, '}', () {
-              indent.writeln('channel.SetMessageHandler(nullptr);');
-            });
+            indent.writeln(
+              'reply(PigeonInternalNewInstanceReply(api->instance_manager_.get(), output, ${arguments.first}));',
+            );
+          });
+        }
+        for (final ApiField field in api.attachedFields) {
+          _writeProxyApiMessageHandler(indent, channelName(field.name), () {
+            final List<String> arguments = _writeHostMethodArgumentUnwrapping(
+              indent,
+              root,
+              <NamedType>[
+                if (!field.isStatic) _proxyApiInstanceParameter(api),
+                _proxyApiIdentifierParameter(),
+              ],
+            );
+            final Method method = _proxyApiAttachedFieldMethod(field);
+            indent.writeln(
+              'ErrorOr<$_proxyApiInstanceType> output = '
+              'api->${_makeMethodName(method)}(${arguments.take(arguments.length - 1).join(', ')});',
+            );
+            indent.writeln(
+              'reply(PigeonInternalNewInstanceReply(api->instance_manager_.get(), output, ${arguments.last}));',
+            );
+          });
+        }
+        for (final Method method in api.hostMethods) {
+          _writeProxyApiMessageHandler(indent, channelName(method.name), () {
+            final List<String> arguments = _writeHostMethodArgumentUnwrapping(
+              indent,
+              root,
+              <NamedType>[
+                if (!method.isStatic) _proxyApiInstanceParameter(api),
+                ...method.parameters,
+              ],
+            );
+            _writeHostMethodCall(indent, root, method, arguments);
           });
         }
       },
     );
+  }
+
+  /// Writes the code that sets the handler for the ProxyApi channel
+  /// [channelName], which runs [body] when `api` is set.
+  void _writeProxyApiMessageHandler(Indent indent, String channelName, void Function() body) {
+    indent.writeScoped('{', '}', () {
+      indent.writeln('BasicMessageChannel<> channel(binary_messenger, "$channelName", codec);');
+      indent.writeScoped('if (api != nullptr) {', '} else {', () {
+        indent.write(
+          'channel.SetMessageHandler([api](const EncodableValue& message, '
+          'const ::flutter::MessageReply<EncodableValue>& reply) ',
+        );
+        indent.addScoped('{', '});', () {
+          _writeHostMethodHandlerBody(indent, body);
+        });
+      });
+      indent.addScoped(null, '}', () {
+        indent.writeln('channel.SetMessageHandler(nullptr);');
+      });
+    });
+  }
 
+  /// Writes the `WrapError` functions of the API class [apiName].
+  void _writeWrapErrorDefinitions(Indent indent, String apiName) {
     _writeFunctionDefinition(
       indent,
       'WrapError',
-      scope: api.name,
+      scope: apiName,
       returnType: 'EncodableValue',
       parameters: <String>['std::string_view error_message'],
       body: () {
@@ -1960,7 +5608,7 @@ return EncodableValue(EncodableList{
     _writeFunctionDefinition(
       indent,
       'WrapError',
-      scope: api.name,
+      scope: apiName,
       returnType: 'EncodableValue',
       parameters: <String>['const FlutterError& error'],
       body: () {
@@ -1974,16 +5622,130 @@ return EncodableValue(EncodableList{
     );
   }
 
+  /// Writes the body of a message handler, which runs [body] and replies with
+  /// an error if it throws.
+  void _writeHostMethodHandlerBody(Indent indent, void Function() body) {
+    indent.writeScoped('try {', '}', body, addTrailingNewline: false);
+    indent.add(' catch (const std::exception& exception) ');
+    indent.addScoped('{', '}', () {
+      // There is a potential here for `reply` to be called twice, which
+      // is a violation of the API contract, because there's no way of
+      // knowing whether or not the plugin code called `reply` before
+      // throwing. Since use of `@async` suggests that the reply is
+      // probably not sent within the scope of the stack, err on the
+      // side of potential double-call rather than no call (which is
+      // also an API violation) so that unexpected errors have a better
+      // chance of being caught and handled in a useful way.
+      indent.writeln('reply(WrapError(exception.what()));');
+    });
+  }
+
+  /// Writes the code to decode [parameters] from the `message` a handler
+  /// received, replying with an error if a non-nullable one is null, and
+  /// returns the arguments to pass for them.
+  List<String> _writeHostMethodArgumentUnwrapping(
+    Indent indent,
+    Root root,
+    Iterable<NamedType> parameters,
+  ) {
+    final methodArguments = <String>[];
+    if (parameters.isEmpty) {
+      return methodArguments;
+    }
+    indent.writeln('const auto& args = std::get<EncodableList>(message);');
+    enumerate(parameters, (int index, NamedType arg) {
+      final HostDatatype hostType = _getHostDatatype(
+        arg.type,
+        (TypeDeclaration x) => _shortBaseCppTypeForBuiltinDartType(x),
+      );
+      final String argName = _getSafeArgumentName(index, arg);
+
+      final encodableArgName = '${_encodablePrefix}_$argName';
+      indent.writeln('const auto& $encodableArgName = args.at($index);');
+      if (!arg.type.isNullable) {
+        indent.writeScoped('if ($encodableArgName.IsNull()) {', '}', () {
+          indent.writeln('reply(WrapError("$argName unexpectedly null."));');
+          indent.writeln('return;');
+        });
+      }
+      _writeEncodableValueArgumentUnwrapping(
+        indent,
+        root,
+        hostType,
+        argName: argName,
+        encodableArgName: encodableArgName,
+        apiType: ApiType.host,
+      );
+      if (hostType is _ChunkedBytesHostDatatype) {
+        methodArguments.add('std::move($argName)');
+        return;
+      }
+      final unwrapEnum = arg.type.isEnum && arg.type.isNullable ? ' ? &(*$argName) : nullptr' : '';
+      methodArguments.add('$argName$unwrapEnum');
+    });
+    return methodArguments;
+  }
+
+  /// Writes the code that calls the host method [method] on `api` with
+  /// [methodArguments], and replies with its result.
+  ///
+  /// If [coroutine] is true, an asynchronous method returns a `PigeonTask`,
+  /// which is awaited to reply.
+  void _writeHostMethodCall(
+    Indent indent,
+    Root root,
+    Method method,
+    List<String> methodArguments, {
+    bool coroutine = false,
+  }) {
+    final HostDatatype returnType = _getHostDatatype(
+      method.returnType,
+      _shortBaseCppTypeForBuiltinDartType,
+    );
+    final String returnTypeName = _hostApiReturnType(returnType);
+    // Chunked return values are kept in the `streams` of the method's handler.
+    final replyCaptures = method.returnType.isChunked ? '[reply, streams]' : '[reply]';
+    if (method.isAsynchronous && coroutine) {
+      indent.format(
+        'PigeonInternalReplyWhenDone(api->${_makeMethodName(method)}(${methodArguments.join(', ')}), '
+        '$replyCaptures($returnTypeName&& output) {${indent.newline}'
+        '${_wrapResponse(indent, root, method.returnType, prefix: '\t')}${indent.newline}'
+        '});',
+      );
+      return;
+    }
+    final arguments = <String>[...methodArguments];
+    if (method.isAsynchronous) {
+      arguments.add(
+        '$replyCaptures($returnTypeName&& output) {${indent.newline}'
+        '${_wrapResponse(indent, root, method.returnType, prefix: '\t')}${indent.newline}'
+        '}',
+      );
+    }
+    final call = 'api->${_makeMethodName(method)}(${arguments.join(', ')})';
+    if (method.isAsynchronous) {
+      indent.format('$call;');
+    } else {
+      indent.writeln('$returnTypeName output = $call;');
+      indent.format(_wrapResponse(indent, root, method.returnType));
+    }
+  }
+
   void _writeClassConstructor(
     Root root,
     Indent indent,
     Class classDefinition,
-    Iterable<NamedType> params,
-  ) {
+    Iterable<NamedType> params, {
+    required bool typedCollections,
+  }) {
     final Iterable<_HostNamedType> hostParams = params.map((NamedType param) {
       return _HostNamedType(
         _makeVariableName(param),
-        getFieldHostDatatype(param, _shortBaseCppTypeForBuiltinDartType),
+        _fieldHostDatatype(
+          param,
+          typedCollections: typedCollections,
+          includeFlutterNamespace: false,
+        ),
         param.type,
       );
     });
@@ -2004,19 +5766,39 @@ return EncodableValue(EncodableList{
       parameters: paramStrings,
       initializers: initializerStrings,
     );
+
+    // The variant taking ownership of movable values; see the header.
+    if (hostParams.any((_HostNamedType param) => _isMovableField(param.hostType))) {
+      _writeFunctionDefinition(
+        indent,
+        classDefinition.name,
+        scope: classDefinition.name,
+        parameters: hostParams
+            .map((_HostNamedType param) => '${_rvalueArgumentType(param.hostType)} ${param.name}')
+            .toList(),
+        initializers: hostParams
+            .map(
+              (_HostNamedType param) =>
+                  '${param.name}_(${_fieldValueExpression(param.hostType, param.name, move: _isMovableField(param.hostType))})',
+            )
+            .toList(),
+      );
+    }
   }
 
   void _writeCopyConstructor(
     Root root,
     Indent indent,
     Class classDefinition,
-    Iterable<NamedType> fields,
-  ) {
+    Iterable<NamedType> fields, {
+    required bool typedCollections,
+  }) {
     final List<String> initializerStrings = fields.map((NamedType param) {
       final String fieldName = _makeInstanceVariableName(param);
-      final HostDatatype hostType = getFieldHostDatatype(
+      final HostDatatype hostType = _fieldHostDatatype(
         param,
-        _shortBaseCppTypeForBuiltinDartType,
+        typedCollections: typedCollections,
+        includeFlutterNamespace: false,
       );
       return '$fieldName(${_fieldValueExpression(hostType, 'other.$fieldName', sourceIsField: true)})';
     }).toList();
@@ -2073,9 +5855,10 @@ return EncodableValue(EncodableList{
     Class classDefinition,
     NamedType field,
   ) {
-    final HostDatatype hostDatatype = getFieldHostDatatype(
+    final HostDatatype hostDatatype = _fieldHostDatatype(
       field,
-      _shortBaseCppTypeForBuiltinDartType,
+      typedCollections: generatorOptions.typedCollections,
+      includeFlutterNamespace: false,
     );
     final String instanceVariableName = _makeInstanceVariableName(field);
     final String setterName = _makeSetterName(field);
@@ -2094,17 +5877,19 @@ return EncodableValue(EncodableList{
 
     // Writes a setter treating the type as [type], to allow generating multiple
     // setter variants.
-    void writeSetter(HostDatatype type) {
+    void writeSetter(HostDatatype type, {bool move = false}) {
       const setterArgumentName = 'value_arg';
       _writeFunctionDefinition(
         indent,
         setterName,
         scope: classDefinition.name,
         returnType: _voidType,
-        parameters: <String>['${_unownedArgumentType(type)} $setterArgumentName'],
+        parameters: <String>[
+          '${move ? '${type.datatype}&&' : _unownedArgumentType(type)} $setterArgumentName',
+        ],
         body: () {
           indent.writeln(
-            '$instanceVariableName = ${_fieldValueExpression(type, setterArgumentName)};',
+            '$instanceVariableName = ${_fieldValueExpression(type, setterArgumentName, move: move)};',
           );
         },
       );
@@ -2125,6 +5910,9 @@ return EncodableValue(EncodableList{
       // Write the non-nullable variant; see _writeCppHeaderDataClass.
       writeSetter(_nonNullableType(hostDatatype));
     }
+    if (_hasMoveSetter(hostDatatype)) {
+      writeSetter(_nonNullableType(hostDatatype), move: true);
+    }
 
     indent.newln();
   }
@@ -2136,7 +5924,20 @@ return EncodableValue(EncodableList{
   /// itself, but for other values this handles the conversion between an
   /// argument type (a pointer or value/reference) and the field type
   /// (a std::optional or std::unique_ptr).
-  String _fieldValueExpression(HostDatatype type, String variable, {bool sourceIsField = false}) {
+  ///
+  /// If [move] is true, [variable] is a non-nullable rvalue reference whose
+  /// value is moved into the field.
+  String _fieldValueExpression(
+    HostDatatype type,
+    String variable, {
+    bool sourceIsField = false,
+    bool move = false,
+  }) {
+    if (move) {
+      assert(!type.isNullable);
+      final movedValue = 'std::move($variable)';
+      return _isPointerField(type) ? 'std::make_unique<${type.datatype}>($movedValue)' : movedValue;
+    }
     if (_isPointerField(type)) {
       final constructor = 'std::make_unique<${type.datatype}>';
       // If the source is a pointer field, it always needs dereferencing.
@@ -2161,26 +5962,40 @@ return EncodableValue(EncodableList{
       errorCondition = 'output.has_value()';
       errorGetter = 'value';
     } else {
-      final HostDatatype hostType = getHostDatatype(
+      final HostDatatype hostType = _getHostDatatype(
         returnType,
         _shortBaseCppTypeForBuiltinDartType,
       );
 
       const extractedValue = 'std::move(output).TakeValue()';
       final wrapperType = hostType.isBuiltin ? 'EncodableValue' : 'CustomEncodableValue';
-      if (returnType.isNullable) {
+      // Data classes are moved into the reply rather than copied, see
+      // _writeCustomValueHelpers.
+      final bool movesCustomValue = returnType.isClass && _streamDecodedClasses(root).isNotEmpty;
+      String wrapValue(String value, String valuePrefix) => movesCustomValue
+          ? '''
+${valuePrefix}wrapped.emplace_back();
+${valuePrefix}PigeonInternalSetCustomValue($value, &wrapped.back());'''
+          : '${valuePrefix}wrapped.push_back($wrapperType($value));';
+      if (hostType is _ColumnsHostDatatype) {
+        // The columns are moved into the reply.
+        nonErrorPath = '${prefix}wrapped.push_back(EncodableValue($extractedValue.columns_));';
+      } else if (hostType is _ChunkedBytesHostDatatype) {
+        // Dart reads the stream by the ID that is sent in its place.
+        nonErrorPath = '${prefix}wrapped.push_back(EncodableValue(streams->Add($extractedValue)));';
+      } else if (returnType.isNullable) {
         // The value is a std::optional, so needs an extra layer of
         // handling.
         nonErrorPath =
             '''
 ${prefix}auto output_optional = $extractedValue;
 ${prefix}if (output_optional) {
-$prefix\twrapped.push_back($wrapperType(std::move(output_optional).value()));
+${wrapValue('std::move(output_optional).value()', '$prefix\t')}
 $prefix} else {
 $prefix\twrapped.push_back($nullValue);
 $prefix}''';
       } else {
-        nonErrorPath = '${prefix}wrapped.push_back($wrapperType($extractedValue));';
+        nonErrorPath = wrapValue(extractedValue, prefix);
       }
       errorCondition = 'output.has_error()';
       errorGetter = 'error';
@@ -2199,6 +6014,72 @@ $nonErrorPath
 ${prefix}reply(EncodableValue(std::move(wrapped)));''';
   }
 
+  @override
+  void writeEventChannelApi(
+    InternalCppOptions generatorOptions,
+    Root root,
+    Indent indent,
+    AstEventChannelApi api, {
+    required String dartPackageName,
+  }) {
+    final CppEventChannelOptions options = api.cppOptions ?? const CppEventChannelOptions();
+    final overflowPolicy = switch (options.overflowPolicy) {
+      CppEventOverflowPolicy.dropOldest => 'kDropOldest',
+      CppEventOverflowPolicy.block => 'kBlock',
+    };
+    for (final Method func in api.methods) {
+      final HostDatatype eventType = getHostDatatype(
+        func.returnType,
+        _baseCppTypeForBuiltinDartType,
+      );
+      final String encodedEvent;
+      if (!eventType.isBuiltin) {
+        encodedEvent = 'CustomEncodableValue(event)';
+      } else if (func.returnType.baseName == 'Object') {
+        encodedEvent = 'event';
+      } else {
+        encodedEvent = 'EncodableValue(event)';
+      }
+      _writeFunctionDefinition(
+        indent,
+        'Register',
+        scope: '${_pascalCaseFromCamelCase(func.name)}StreamHandler',
+        returnType: _voidType,
+        parameters: <String>[
+          '::flutter::BinaryMessenger* binary_messenger',
+          'std::shared_ptr<${_pascalCaseFromCamelCase(func.name)}StreamHandler> stream_handler',
+          'const std::string& instance_name',
+          'std::function<void(std::function<void()> task)> post_to_platform_thread',
+        ],
+        body: () {
+          indent.writeln(
+            'std::string channel_name = "${makeChannelName(api, func, dartPackageName)}";',
+          );
+          indent.writeScoped('if (!instance_name.empty()) {', '}', () {
+            indent.writeln('channel_name += "." + instance_name;');
+          });
+          indent.format('''
+::flutter::EventChannel<EncodableValue> channel(
+	binary_messenger, channel_name,
+	&::flutter::StandardMethodCodec::GetInstance(&$_codecSerializerName::GetInstance()));
+if (!stream_handler) {
+	channel.SetStreamHandler(nullptr);
+	return;
+}
+PigeonEventSinkOptions options;
+options.max_batch_size = ${options.maxBatchSize};
+options.max_queued_events = ${options.maxQueuedEvents};
+options.overflow_policy = PigeonEventOverflowPolicy::$overflowPolicy;
+options.post_to_platform_thread = std::move(post_to_platform_thread);
+channel.SetStreamHandler(std::make_unique<PigeonInternalEventStreamHandler<${eventType.datatype}>>(
+	std::move(options),
+	[](const ${eventType.datatype}& event) -> EncodableValue { return $encodedEvent; },
+	std::move(stream_handler)));''');
+        },
+      );
+    }
+  }
+
   @override
   void writeCloseNamespace(
     InternalCppOptions generatorOptions,
@@ -2220,6 +6101,9 @@ ${prefix}reply(EncodableValue(std::move(wrapped)));''';
     HostDatatype hostType,
     bool isNestedClass,
   ) {
+    if (hostType is _ColumnsHostDatatype) {
+      return 'EncodableValue($variableName.columns_)';
+    }
     final String encodableValue;
     if (!hostType.isBuiltin) {
       final nonNullValue = hostType.isNullable || (!hostType.isEnum && isNestedClass)
@@ -2251,6 +6135,21 @@ ${prefix}reply(EncodableValue(std::move(wrapped)));''';
     required String encodableArgName,
     required ApiType apiType,
   }) {
+    if (hostType is _ColumnsHostDatatype) {
+      // The message was decoded for this call, so the columns are moved out of
+      // it rather than copied.
+      indent.writeln(
+        'const auto $argName = ${hostType.datatype}::FromEncodableList(std::move(std::get<EncodableList>(const_cast<EncodableValue&>($encodableArgName))));',
+      );
+      return;
+    }
+    if (hostType is _ChunkedBytesHostDatatype) {
+      // Dart sends the name of the channel it serves the chunks on.
+      indent.writeln(
+        'std::unique_ptr<ByteStreamReader> $argName = std::make_unique<PigeonInternalChannelByteStreamReader>(binary_messenger, std::get<std::string>($encodableArgName));',
+      );
+      return;
+    }
     if (hostType.isNullable) {
       // Nullable arguments are always pointers, with nullptr corresponding to
       // null.
@@ -2312,6 +6211,197 @@ if (!$encodableArgName.IsNull()) {
   }
 }
 
+/// Returns the [HostDatatype] for [type], like [getHostDatatype], except that
+/// ProxyApi instances are type-erased.
+HostDatatype _getHostDatatype(
+  TypeDeclaration type,
+  String? Function(TypeDeclaration) builtinResolver,
+) {
+  if (type.isProxyApi) {
+    return _proxyApiHostDatatype(type);
+  }
+  if (type.isColumnar) {
+    return _ColumnsHostDatatype(type.columnarClass!);
+  }
+  if (type.isChunked) {
+    return _ChunkedBytesHostDatatype();
+  }
+  return getHostDatatype(type, builtinResolver);
+}
+
+/// Returns the [HostDatatype] for [field], like [getFieldHostDatatype], except
+/// that ProxyApi instances are type-erased.
+HostDatatype _getFieldHostDatatype(
+  NamedType field,
+  String? Function(TypeDeclaration) builtinResolver,
+) {
+  if (field.type.isProxyApi) {
+    return _proxyApiHostDatatype(field.type);
+  }
+  if (field.type.isColumnar) {
+    return _ColumnsHostDatatype(field.type.columnarClass!);
+  }
+  if (field.type.isChunked) {
+    return _ChunkedBytesHostDatatype();
+  }
+  return getFieldHostDatatype(field, builtinResolver);
+}
+
+/// The [HostDatatype] of a list of a `@Columnar` class, which the APIs take
+/// and return as the class's columns class.
+class _ColumnsHostDatatype extends HostDatatype {
+  _ColumnsHostDatatype(Class columnarClass)
+    : super(
+        datatype: _columnsClassName(columnarClass),
+        isBuiltin: false,
+        isNullable: false,
+        isEnum: false,
+      );
+}
+
+/// The [HostDatatype] of a `Uint8List` that a `@ChunkedBytes` host API method
+/// takes or returns, which is read from a `ByteStreamReader`.
+class _ChunkedBytesHostDatatype extends HostDatatype {
+  _ChunkedBytesHostDatatype()
+    : super(
+        datatype: 'std::unique_ptr<ByteStreamReader>',
+        isBuiltin: false,
+        isNullable: false,
+        isEnum: false,
+      );
+}
+
+/// Returns the name of the class that holds a list of the `@Columnar`
+/// [classDefinition] as one array per field.
+String _columnsClassName(Class classDefinition) => '${classDefinition.name}Columns';
+
+/// Returns the C++ type of the array that holds the values of a field of
+/// [type] in a `@Columnar` class, which is the type the codec decodes it to.
+String _columnType(TypeDeclaration type, {bool includeFlutterNamespace = true}) {
+  return switch (type.baseName) {
+    'bool' => 'std::vector<uint8_t>',
+    'int' => 'std::vector<int64_t>',
+    'double' => 'std::vector<double>',
+    _ => '${includeFlutterNamespace ? '::flutter::' : ''}EncodableList',
+  };
+}
+
+/// Returns the comment for the accessor of the column of [field] in a
+/// `@Columnar` class.
+String _columnDescription(NamedType field) {
+  final String name = _makeVariableName(field);
+  return switch (field.type.baseName) {
+    'bool' => 'The $name of each row, as 1 for true and 0 for false.',
+    'String' => 'The $name of each row, as std::string values.',
+    _ => 'The $name of each row.',
+  };
+}
+
+HostDatatype _proxyApiHostDatatype(TypeDeclaration type) {
+  return HostDatatype(
+    datatype: _proxyApiInstanceType,
+    isBuiltin: false,
+    isNullable: type.isNullable,
+    isEnum: false,
+  );
+}
+
+/// The name of the Flutter method that creates the Dart instance for a
+/// ProxyApi instance created on the host.
+const String _proxyApiNewInstanceMethodName = '${classMemberNamePrefix}newInstance';
+
+/// Returns the host method that implements [constructor] of [api], which
+/// returns the new instance.
+Method _proxyApiConstructorMethod(AstProxyApi api, Constructor constructor) {
+  return Method(
+    name: constructor.name.isNotEmpty ? constructor.name : 'pigeonDefaultConstructor',
+    returnType: TypeDeclaration(baseName: api.name, isNullable: false, associatedProxyApi: api),
+    parameters: constructor.parameters,
+    location: ApiLocation.host,
+    documentationComments: constructor.documentationComments,
+  );
+}
+
+/// Returns the name of the channel method for [constructor].
+String _proxyApiConstructorName(Constructor constructor) {
+  return constructor.name.isNotEmpty
+      ? constructor.name
+      : '${classMemberNamePrefix}defaultConstructor';
+}
+
+/// Returns the host method that returns the instance for the attached
+/// [field].
+Method _proxyApiAttachedFieldMethod(ApiField field) {
+  return Method(
+    name: field.name,
+    returnType: field.type,
+    parameters: <Parameter>[],
+    location: ApiLocation.host,
+    isStatic: field.isStatic,
+    documentationComments: field.documentationComments,
+  );
+}
+
+/// Returns the parameter for the instance a ProxyApi method is called on.
+Parameter _proxyApiInstanceParameter(AstProxyApi api) {
+  return Parameter(
+    name: '${classMemberNamePrefix}instance',
+    type: TypeDeclaration(baseName: api.name, isNullable: false, associatedProxyApi: api),
+  );
+}
+
+/// Returns the parameter for the identifier Dart assigns to a new instance.
+Parameter _proxyApiIdentifierParameter() {
+  return Parameter(
+    name: '${classMemberNamePrefix}identifier',
+    type: const TypeDeclaration(baseName: 'int', isNullable: false),
+  );
+}
+
+/// Returns the Flutter methods of [api], with the name of the channel method
+/// each is sent on.
+///
+/// This includes the method that creates a Dart instance, if [api] can be
+/// created on the host. Dart replies with null for methods that aren't
+/// required and aren't implemented, so those return nullable values.
+List<(Method, String)> _proxyApiFlutterMethods(AstProxyApi api) {
+  return <(Method, String)>[
+    if (api.hasCallbackConstructor())
+      (
+        Method(
+          name: 'pigeonNewInstance',
+          returnType: const TypeDeclaration.voidDeclaration(),
+          parameters: api.unattachedFields
+              .map((ApiField field) => Parameter(name: field.name, type: field.type))
+              .toList(),
+          location: ApiLocation.flutter,
+        ),
+        _proxyApiNewInstanceMethodName,
+      ),
+    for (final Method method in api.flutterMethods)
+      (
+        Method(
+          name: method.name,
+          returnType: method.isRequired || method.returnType.isVoid
+              ? method.returnType
+              : TypeDeclaration(
+                  baseName: method.returnType.baseName,
+                  isNullable: true,
+                  typeArguments: method.returnType.typeArguments,
+                  associatedEnum: method.returnType.associatedEnum,
+                  associatedClass: method.returnType.associatedClass,
+                  associatedProxyApi: method.returnType.associatedProxyApi,
+                ),
+          parameters: method.parameters,
+          location: method.location,
+          isRequired: method.isRequired,
+          documentationComments: method.documentationComments,
+        ),
+        method.name,
+      ),
+  ];
+}
+
 /// Contains information about a host function argument.
 ///
 /// This is comparable to a [NamedType], but has already gone through host type
@@ -2350,6 +6440,48 @@ HostDatatype _nonNullableType(HostDatatype type) {
   );
 }
 
+bool _usesTaskQueue(Method method) =>
+    method.taskQueueType == TaskQueueType.serialBackgroundThread;
+
+bool _hasTaskQueueMethods(Root root) => root.apis.any(
+  (Api api) => api is AstHostApi && api.methods.any(_usesTaskQueue),
+);
+
+/// Whether [method] sends its `Uint8List` arguments and return value in
+/// chunks.
+bool _hasChunkedBytes(Method method) => method.chunkSize != null;
+
+/// Whether [api] registers its methods from a table, see
+/// [InternalCppOptions.tableDrivenDispatch].
+///
+/// The handlers in the table don't have the messenger, which `@ChunkedBytes`
+/// methods need to read their arguments, so APIs with those methods set up
+/// each of them directly.
+bool _usesHostMethodTable(InternalCppOptions options, AstHostApi api) =>
+    options.tableDrivenDispatch && api.methods.isNotEmpty && !api.methods.any(_hasChunkedBytes);
+
+bool _hasFlutterApiMethods(Root root) =>
+    root.apis.any((Api api) => api is AstFlutterApi && api.methods.isNotEmpty);
+
+/// Whether any Flutter API methods can be awaited with
+/// [InternalCppOptions.coroutines].
+bool _hasAwaitableFlutterMethods(InternalCppOptions options, Root root) =>
+    options.coroutines &&
+    root.apis.any((Api api) => api is AstFlutterApi && api.methods.isNotEmpty);
+
+/// Whether any host API methods are coroutines with
+/// [InternalCppOptions.coroutines].
+bool _hasCoroutineHostMethods(InternalCppOptions options, Root root) =>
+    options.coroutines &&
+    root.apis.any(
+      (Api api) => api is AstHostApi && api.methods.any((Method method) => method.isAsynchronous),
+    );
+
+/// Returns the name of the static function that handles the messages for the
+/// host API method [method] when using table-driven dispatch.
+String _hostMethodHandlerName(Method method) =>
+    'PigeonInternalHandle${_makeMethodName(method)}';
+
 String _pascalCaseFromCamelCase(String camelCase) =>
     camelCase[0].toUpperCase() + camelCase.substring(1);
 
@@ -2370,6 +6502,9 @@ String _pascalCaseFromSnakeCase(String snakeCase) {
 
 String _makeMethodName(Method method) => _pascalCaseFromCamelCase(method.name);
 
+String _makeChannelVariableName(Method method) =>
+    '${_snakeCaseFromCamelCase(method.name)}_channel_';
+
 String _makeGetterName(NamedType field) => _snakeCaseFromCamelCase(field.name);
 
 String _makeSetterName(NamedType field) => 'set_${_snakeCaseFromCamelCase(field.name)}';
@@ -2432,6 +6567,66 @@ String? _baseCppTypeForBuiltinDartType(
   }
 }
 
+/// The C++ types of the values that typed collection fields can hold.
+const Map<String, String> _typedCollectionElementTypes = <String, String>{
+  'bool': 'bool',
+  'int': 'int64_t',
+  'double': 'double',
+  'String': 'std::string',
+};
+
+/// Returns the C++ types of the elements of the list [type], or of the keys
+/// and values of the map [type], if they are all non-nullable values that a
+/// typed collection can hold. Returns null otherwise.
+List<String>? _typedCollectionArguments(TypeDeclaration type) {
+  final int argumentCount = switch (type.baseName) {
+    'List' => 1,
+    'Map' => 2,
+    _ => 0,
+  };
+  if (argumentCount == 0 || type.typeArguments.length != argumentCount) {
+    return null;
+  }
+  final arguments = <String>[];
+  for (final TypeDeclaration argument in type.typeArguments) {
+    final String? cppType = argument.isNullable
+        ? null
+        : _typedCollectionElementTypes[argument.baseName];
+    if (cppType == null) {
+      return null;
+    }
+    arguments.add(cppType);
+  }
+  return arguments;
+}
+
+/// Returns the C++ container type used for a data class field of [type] when
+/// typed collections are enabled, or null if [type] isn't a typed collection.
+String? _typedCollectionType(TypeDeclaration type) {
+  final List<String>? arguments = _typedCollectionArguments(type);
+  if (arguments == null) {
+    return null;
+  }
+  return type.baseName == 'List'
+      ? 'std::vector<${arguments.single}>'
+      : 'std::unordered_map<${arguments.join(', ')}>';
+}
+
+/// Returns the [HostDatatype] of the data class [field].
+///
+/// If [typedCollections] is true, fully typed lists and maps of builtin values
+/// use native C++ containers; see [CppOptions.typedCollections].
+HostDatatype _fieldHostDatatype(
+  NamedType field, {
+  required bool typedCollections,
+  bool includeFlutterNamespace = true,
+}) {
+  return getFieldHostDatatype(field, (TypeDeclaration type) {
+    return (typedCollections ? _typedCollectionType(type) : null) ??
+        _baseCppTypeForBuiltinDartType(type, includeFlutterNamespace: includeFlutterNamespace);
+  });
+}
+
 /// Returns the C++ type to use in a value context (variable declaration,
 /// pass-by-value, etc.) for the given C++ base type.
 String _valueType(HostDatatype type) {
@@ -2454,6 +6649,101 @@ bool _isPointerField(HostDatatype type) {
   return !type.isBuiltin && !type.isEnum;
 }
 
+/// Returns the data classes that the codec serializer decodes directly from the
+/// stream.
+///
+/// Classes that are wrapped in the overflow class are decoded via their
+/// encodable list instead.
+Iterable<EnumeratedType> _streamDecodedClasses(Root root) {
+  return getEnumeratedTypes(root, excludeSealedClasses: true).where(
+    (EnumeratedType customType) =>
+        customType.type == CustomTypes.customClass &&
+        customType.enumeration < maximumCodecFieldKey,
+  );
+}
+
+/// The names and C++ types of the builtin values that the codec serializer
+/// reads directly from the stream, other than typed data.
+const List<(String, String)> _streamDecodedBuiltinTypes = <(String, String)>[
+  ('Bool', 'bool'),
+  ('Int64', 'int64_t'),
+  ('Double', 'double'),
+  ('String', 'std::string'),
+];
+
+/// Returns the parameter for the value passed to the codec serializer method
+/// that writes a builtin value of the C++ [type] directly to the stream.
+String _streamWriterValueParameter(String type) {
+  return type == 'std::string' ? 'const std::string& value' : '$type value';
+}
+
+/// Returns the codec serializer method that reads a value of [type] directly
+/// from the stream, or null if values of [type] are read as an EncodableValue.
+///
+/// If [typedCollections] is true, typed collections are read directly into
+/// their native C++ containers.
+String? _streamReaderName(
+  TypeDeclaration type,
+  Iterable<EnumeratedType> streamDecodedClasses, {
+  bool typedCollections = false,
+}) {
+  final List<String>? typedCollectionArguments = typedCollections
+      ? _typedCollectionArguments(type)
+      : null;
+  if (typedCollectionArguments != null) {
+    final reader = type.baseName == 'List' ? 'ReadEncodedVector' : 'ReadEncodedUnorderedMap';
+    return '$reader<${typedCollectionArguments.join(', ')}>';
+  }
+  switch (type.baseName) {
+    case 'bool':
+      return 'ReadEncodedBool';
+    case 'int':
+      return 'ReadEncodedInt64';
+    case 'double':
+      return 'ReadEncodedDouble';
+    case 'String':
+      return 'ReadEncodedString';
+    case 'Uint8List':
+      return 'ReadEncodedTypedData<uint8_t>';
+    case 'Int32List':
+      return 'ReadEncodedTypedData<int32_t>';
+    case 'Int64List':
+      return 'ReadEncodedTypedData<int64_t>';
+    case 'Float64List':
+      return 'ReadEncodedTypedData<double>';
+  }
+  if (type.isClass &&
+      streamDecodedClasses.any((EnumeratedType customType) => customType.name == type.baseName)) {
+    return 'Read${type.baseName}';
+  }
+  return null;
+}
+
+/// Returns true if a non-nullable value of [type] is worth moving, rather than
+/// copying, into a data class field.
+bool _isMovableField(HostDatatype type) {
+  return !type.isNullable && !_isPodType(type) && !type.isEnum;
+}
+
+/// Returns true if a field of [type] gets a setter overload taking an rvalue
+/// reference.
+///
+/// Strings are excluded since their setters take `std::string_view`, and an
+/// overload taking `std::string&&` would make calls with string literals
+/// ambiguous.
+bool _hasMoveSetter(HostDatatype type) {
+  return _isMovableField(_nonNullableType(type)) && type.datatype != 'std::string';
+}
+
+/// Returns the C++ type to use for a constructor argument that takes ownership
+/// of its value, for the given type.
+///
+/// Nullable and POD values are passed the same way as in the copying
+/// constructor, so that the two overloads only differ in the movable values.
+String _rvalueArgumentType(HostDatatype type) {
+  return _isMovableField(type) ? '${type.datatype}&&' : _hostApiArgumentType(type);
+}
+
 /// Returns the C++ type to use in an argument context without ownership
 /// transfer for the given base type.
 String _unownedArgumentType(HostDatatype type) {
@@ -2472,6 +6762,10 @@ String _unownedArgumentType(HostDatatype type) {
 /// to the host API implementation when the actual type is `std::string*` is
 /// needlessly complicated, so it uses `std::string` directly.
 String _hostApiArgumentType(HostDatatype type) {
+  if (type is _ChunkedBytesHostDatatype) {
+    // The method takes ownership of the reader.
+    return type.datatype;
+  }
   final String baseType = type.datatype;
   if (_isPodType(type)) {
     return type.isNullable ? 'const $baseType*' : baseType;
@@ -2540,8 +6834,9 @@ String _getGuardName(String? headerFileName) {
 }
 
 void _writeSystemHeaderIncludeBlock(Indent indent, List<String> headers) {
-  headers.sort();
-  for (final header in headers) {
+  // Several features can need the same header, so each is only included once.
+  final List<String> uniqueHeaders = headers.toSet().toList()..sort();
+  for (final header in uniqueHeaders) {
     indent.writeln('#include <$header>');
   }
 }
@@ -173,10 +173,14 @@ class DartGenerator extends StructuredGenerator<InternalDartOptions> {
     required String dartPackageName,
   }) {
     indent.writeln("import 'dart:async';");
-    if (root.containsProxyApi) {
+    if (root.containsProxyApi || _containsBatchedEventChannel(root)) {
       indent.writeln("import 'dart:io' show Platform;");
     }
-    indent.writeln("import 'dart:typed_data' show Float64List, Int32List, Int64List;");
+    indent.writeln(
+      hasChunkedBytesMethods(root)
+          ? "import 'dart:typed_data' show BytesBuilder, Float64List, Int32List, Int64List;"
+          : "import 'dart:typed_data' show Float64List, Int32List, Int64List;",
+    );
     indent.newln();
 
     indent.writeln("import 'package:flutter/services.dart';");
@@ -614,8 +618,12 @@ final BinaryMessenger? ${varNamePrefix}binaryMessenger;
           parameters: func.parameters,
           returnType: func.returnType,
           documentationComments: func.documentationComments,
-          channelName: makeChannelName(api, func, dartPackageName),
+          channelName: api.multiplexChannel
+              ? makeMultiplexedChannelName(api, dartPackageName)
+              : makeChannelName(api, func, dartPackageName),
           addSuffixVariable: true,
+          multiplexedMethodIndex: api.multiplexChannel ? api.methods.indexOf(func) : null,
+          chunkSize: func.chunkSize,
         );
       }
     });
@@ -645,18 +653,46 @@ final BinaryMessenger? ${varNamePrefix}binaryMessenger;
           'returned broadcast stream multiple times instead.',
         ],
       );
-      indent.format('''
-      Stream<${func.returnType.baseName}> ${func.name}(${_getMethodParameterSignature(func.parameters, addTrailingComma: true)} {String instanceName = ''}) {
+      final String returnType = func.returnType.baseName;
+      final String signature =
+          "Stream<$returnType> ${func.name}(${_getMethodParameterSignature(func.parameters, addTrailingComma: true)} {String instanceName = ''})";
+      final channelName = "'${makeChannelName(api, func, dartPackageName)}\$instanceName'";
+      final batchedPlatformChecks = <String>[
+        if (api.gobjectOptions?.isBatched ?? false) 'Platform.isLinux',
+        if (api.cppOptions?.isBatched ?? false) 'Platform.isWindows',
+      ];
+      if (batchedPlatformChecks.isNotEmpty) {
+        // The GObject and C++ generated code can send a list of events in
+        // each message.
+        indent.format('''
+      $signature {
+        if (instanceName.isNotEmpty) {
+          instanceName = '.\$instanceName';
+        }
+        final EventChannel ${func.name}Channel =
+            EventChannel($channelName, $_pigeonMethodChannelCodec);
+        return ${func.name}Channel.receiveBroadcastStream().expand((dynamic event) {
+          if (${batchedPlatformChecks.join(' || ')}) {
+            return (event as List<Object?>).cast<$returnType>();
+          }
+          return <$returnType>[event as $returnType];
+        });
+      }
+    ''');
+      } else {
+        indent.format('''
+      $signature {
         if (instanceName.isNotEmpty) {
           instanceName = '.\$instanceName';
         }
         final EventChannel ${func.name}Channel =
-            EventChannel('${makeChannelName(api, func, dartPackageName)}\$instanceName', $_pigeonMethodChannelCodec);
+            EventChannel($channelName, $_pigeonMethodChannelCodec);
         return ${func.name}Channel.receiveBroadcastStream().map((dynamic event) {
-          return event as ${func.returnType.baseName};
+          return event as $returnType;
         });
       }
     ''');
+      }
     }
   }
 
@@ -772,6 +808,37 @@ final BinaryMessenger? ${varNamePrefix}binaryMessenger;
                           return '(instanceManager ?? $dartInstanceManagerClassName.instance).remove(${safeArgumentNames.single})';
                         },
                   );
+                  // Hosts that release several instances at once send them in
+                  // a single message.
+                  writeFlutterMethodMessageHandler(
+                    messageHandlerIndent,
+                    name: 'removeStrongReferencesName',
+                    parameters: <Parameter>[
+                      Parameter(
+                        name: 'identifiers',
+                        type: const TypeDeclaration(
+                          baseName: 'List',
+                          isNullable: false,
+                          typeArguments: <TypeDeclaration>[
+                            TypeDeclaration(baseName: 'int', isNullable: false),
+                          ],
+                        ),
+                      ),
+                    ],
+                    returnType: const TypeDeclaration.voidDeclaration(),
+                    channelName: makeRemoveStrongReferencesChannelName(dartPackageName),
+                    isMockHandler: false,
+                    isAsynchronous: false,
+                    nullHandlerExpression: '${classMemberNamePrefix}clearHandlers',
+                    onCreateApiCall:
+                        (
+                          String methodName,
+                          Iterable<Parameter> parameters,
+                          Iterable<String> safeArgumentNames,
+                        ) {
+                          return '(instanceManager ?? $dartInstanceManagerClassName.instance).removeAll(${safeArgumentNames.single})';
+                        },
+                  );
                   builder.statements.add(cb.Code(messageHandlerIndent.toString()));
                 }).statements,
               );
@@ -1045,6 +1112,10 @@ final BinaryMessenger? ${varNamePrefix}binaryMessenger;
       _writeDeepEquals(indent);
       _writeDeepHash(indent);
     }
+    _writeColumnsHelpers(root, indent);
+    if (hasChunkedBytesMethods(root)) {
+      _writeChunkHelpers(indent);
+    }
     if (root.containsProxyApi) {
       proxy_api_helper.writeProxyApiPigeonOverrides(
         indent,
@@ -1142,6 +1213,177 @@ int _deepHash(Object? value) {
 ''');
   }
 
+  /// Writes the functions that convert lists of `@Columnar` classes to and
+  /// from their columns, for the directions they are sent in.
+  void _writeColumnsHelpers(Root root, Indent indent) {
+    final encodedClasses = <Class>{};
+    final decodedClasses = <Class>{};
+    for (final Api api in root.apis) {
+      if (api is! AstHostApi && api is! AstFlutterApi) {
+        continue;
+      }
+      // Host API arguments and Flutter API return values are sent from Dart.
+      final Set<Class> sentClasses = api is AstHostApi ? encodedClasses : decodedClasses;
+      final Set<Class> receivedClasses = api is AstHostApi ? decodedClasses : encodedClasses;
+      for (final Method method in api.methods) {
+        for (final Parameter parameter in method.parameters) {
+          if (parameter.type.isColumnar) {
+            sentClasses.add(parameter.type.columnarClass!);
+          }
+        }
+        if (method.returnType.isColumnar) {
+          receivedClasses.add(method.returnType.columnarClass!);
+        }
+      }
+    }
+    for (final Class classDefinition in root.classes) {
+      if (encodedClasses.contains(classDefinition)) {
+        _writeColumnsEncoder(indent, classDefinition);
+      }
+      if (decodedClasses.contains(classDefinition)) {
+        _writeColumnsDecoder(indent, classDefinition);
+      }
+    }
+  }
+
+  /// Writes the function that converts a list of the `@Columnar`
+  /// [classDefinition] to one typed list per field.
+  void _writeColumnsEncoder(Indent indent, Class classDefinition) {
+    final String className = classDefinition.name;
+    final Iterable<NamedType> fields = getFieldsInSerializationOrder(classDefinition);
+    indent.newln();
+    indent.writeScoped(
+      'List<Object?> ${_columnsEncoderName(classDefinition)}(List<$className> rows) {',
+      '}',
+      () {
+        for (final field in fields) {
+          final String columnType = _columnType(field.type);
+          final String column = _columnVariableName(field);
+          final String constructor = field.type.baseName == 'String'
+              ? "$columnType.filled(rows.length, '')"
+              : '$columnType(rows.length)';
+          indent.writeln('final $columnType $column = $constructor;');
+        }
+        indent.writeScoped('for (int index = 0; index < rows.length; index++) {', '}', () {
+          indent.writeln('final $className row = rows[index];');
+          for (final field in fields) {
+            final value = field.type.baseName == 'bool'
+                ? 'row.${field.name} ? 1 : 0'
+                : 'row.${field.name}';
+            indent.writeln('${_columnVariableName(field)}[index] = $value;');
+          }
+        });
+        indent.writeln(
+          'return <Object?>[${fields.map(_columnVariableName).join(', ')}];',
+        );
+      },
+    );
+  }
+
+  /// Writes the function that converts the typed list per field sent for a
+  /// list of the `@Columnar` [classDefinition] back to a list of objects.
+  void _writeColumnsDecoder(Indent indent, Class classDefinition) {
+    final String className = classDefinition.name;
+    final Iterable<NamedType> fields = getFieldsInSerializationOrder(classDefinition);
+    indent.newln();
+    indent.writeScoped(
+      'List<$className> ${_columnsDecoderName(classDefinition)}(Object? value) {',
+      '}',
+      () {
+        indent.writeln('final List<Object?> columns = value! as List<Object?>;');
+        enumerate(fields, (int index, NamedType field) {
+          final String columnType = field.type.baseName == 'String'
+              ? 'List<Object?>'
+              : _columnType(field.type);
+          indent.writeln(
+            'final $columnType ${_columnVariableName(field)} = columns[$index]! as $columnType;',
+          );
+        });
+        indent.writeScoped(
+          'return List<$className>.generate(${_columnVariableName(fields.first)}.length, (int index) {',
+          '});',
+          () {
+            indent.writeScoped('return $className(', ');', () {
+              for (final field in fields) {
+                final column = '${_columnVariableName(field)}[index]';
+                final String value = switch (field.type.baseName) {
+                  'bool' => '$column != 0',
+                  'String' => '$column! as String',
+                  _ => column,
+                };
+                indent.writeln('${field.name}: $value,');
+              }
+            });
+          },
+        );
+      },
+    );
+  }
+
+  /// Writes the functions that send the `Uint8List` arguments of
+  /// `@ChunkedBytes` methods to the host and read their return values, one
+  /// chunk at a time.
+  void _writeChunkHelpers(Indent indent) {
+    indent.newln();
+    indent.format('''
+int _nextChunkTransferId = 0;
+
+/// Serves [data] to the host on [channelName], which requests the next chunk
+/// of at most the number of bytes in each message until it reaches the end.
+///
+/// The chunks are views of [data] of at most [chunkSize] bytes, so nothing is
+/// copied until a chunk is sent.
+BasicMessageChannel<Object?> _serveChunks(
+  String channelName,
+  Uint8List data,
+  int chunkSize,
+  BinaryMessenger? binaryMessenger,
+) {
+  final channel = BasicMessageChannel<Object?>(
+    channelName,
+    const StandardMessageCodec(),
+    binaryMessenger: binaryMessenger,
+  );
+  int offset = 0;
+  channel.setMessageHandler((Object? message) async {
+    final int requested = message! as int;
+    final int size = requested < chunkSize ? requested : chunkSize;
+    final int end = data.length - offset < size ? data.length : offset + size;
+    final Uint8List chunk = Uint8List.sublistView(data, offset, end);
+    offset = end;
+    return chunk;
+  });
+  return channel;
+}
+
+/// Reads the stream [streamId] that a host method returned, by requesting
+/// chunks of at most [chunkSize] bytes on [channelName] until an empty chunk
+/// marks its end.
+Future<Uint8List> _readChunks(
+  String channelName,
+  int streamId,
+  int chunkSize,
+  BinaryMessenger? binaryMessenger,
+) async {
+  final channel = BasicMessageChannel<Object?>(
+    channelName,
+    const StandardMessageCodec(),
+    binaryMessenger: binaryMessenger,
+  );
+  final builder = BytesBuilder(copy: false);
+  while (true) {
+    final replyList = await channel.send(<Object?>[streamId, chunkSize]) as List<Object?>?;
+    final chunk =
+        _extractReplyValueOrThrow(replyList, channelName, isNullValid: false)! as Uint8List;
+    if (chunk.isEmpty) {
+      return builder.takeBytes();
+    }
+    builder.add(chunk);
+  }
+}
+''');
+  }
+
   static void _writeExtractReplyValueOrThrow(Indent indent) {
     indent.newln();
     indent.format('''
@@ -1237,6 +1479,8 @@ if (wrapped == null) {
     required List<String> documentationComments,
     required String channelName,
     required bool addSuffixVariable,
+    int? multiplexedMethodIndex,
+    int? chunkSize,
   }) {
     addDocumentationComments(indent, documentationComments, docCommentSpec);
     final String argSignature = _getMethodParameterSignature(parameters);
@@ -1248,11 +1492,20 @@ if (wrapped == null) {
         parameters: parameters,
         returnType: returnType,
         addSuffixVariable: addSuffixVariable,
+        multiplexedMethodIndex: multiplexedMethodIndex,
+        chunkSize: chunkSize,
       );
     });
   }
 
   /// Writes the message call to a host method to [indent].
+  ///
+  /// If [multiplexedMethodIndex] is set, [channelName] is the channel shared
+  /// by every method of the API and the index is sent ahead of the arguments.
+  ///
+  /// If [chunkSize] is set, the chunked `Uint8List` arguments are served to
+  /// the host in chunks of at most that size while the call is in progress,
+  /// and a chunked return value is read from the host the same way.
   static void writeHostMethodMessageCall(
     Indent indent, {
     required String channelName,
@@ -1260,13 +1513,28 @@ if (wrapped == null) {
     required TypeDeclaration returnType,
     required bool addSuffixVariable,
     bool insideAsyncMethod = true,
+    int? multiplexedMethodIndex,
+    int? chunkSize,
   }) {
+    // The channels that serve the chunked arguments, by argument name.
+    final chunkChannels = <String, String>{};
     var sendArgument = 'null';
-    if (parameters.isNotEmpty) {
-      final Iterable<String> argExpressions = indexMap(parameters, (int index, NamedType type) {
-        final String name = getParameterName(index, type);
-        return name;
-      });
+    if (parameters.isNotEmpty || multiplexedMethodIndex != null) {
+      final argExpressions = <String>[
+        if (multiplexedMethodIndex != null) '$multiplexedMethodIndex',
+        ...indexMap(parameters, (int index, NamedType type) {
+          final String name = getParameterName(index, type);
+          if (type.type.isChunked) {
+            final chunkChannel = '$varNamePrefix${name}Chunks';
+            chunkChannels[name] = chunkChannel;
+            // The host reads the argument from the channel with this name.
+            return '$chunkChannel.name';
+          }
+          return type.type.isColumnar
+              ? '${_columnsEncoderName(type.type.columnarClass!)}($name)'
+              : name;
+        }),
+      ];
       sendArgument = '<Object?>[${argExpressions.join(', ')}]';
     }
     final channelSuffix = addSuffixVariable ? '\$$_suffixVarName' : '';
@@ -1277,6 +1545,26 @@ if (wrapped == null) {
       indent.writeln('$pigeonChannelCodec,');
       indent.writeln('binaryMessenger: ${varNamePrefix}binaryMessenger,');
     });
+    chunkChannels.forEach((String name, String chunkChannel) {
+      indent.writeScoped(
+        'final BasicMessageChannel<Object?> $chunkChannel = _serveChunks(',
+        ');',
+        () {
+          indent.writeln(
+            "'\$${varNamePrefix}channelName$chunkChannelSuffix.\${_nextChunkTransferId++}',",
+          );
+          indent.writeln('$name,');
+          indent.writeln('$chunkSize,');
+          indent.writeln('${varNamePrefix}binaryMessenger,');
+        },
+      );
+    });
+    // The arguments are served until the call, including reading a chunked
+    // return value, is complete.
+    if (chunkChannels.isNotEmpty) {
+      indent.writeln('try {');
+      indent.inc();
+    }
 
     const sendFutureVar = '${varNamePrefix}sendFuture';
     indent.writeln(
@@ -1303,6 +1591,16 @@ _extractReplyValueOrThrow(
 ''';
     if (returnType.isVoid) {
       indent.format('$extractCall;');
+    } else if (returnType.isChunked) {
+      const accessor = '${varNamePrefix}replyValue';
+      indent.format('final Object? $accessor = $extractCall;');
+      indent.format('''
+return await _readChunks(
+\t\t'\$${varNamePrefix}channelName$chunkChannelSuffix',
+\t\t$accessor! as int,
+\t\t$chunkSize,
+\t\t${varNamePrefix}binaryMessenger,
+);''');
     } else {
       const accessor = '${varNamePrefix}replyValue';
       indent.format('final Object? $accessor = $extractCall;');
@@ -1313,6 +1611,15 @@ _extractReplyValueOrThrow(
       indent.dec();
       indent.writeln('}();');
     }
+
+    if (chunkChannels.isNotEmpty) {
+      indent.dec();
+      indent.writeScoped('} finally {', '}', () {
+        for (final String chunkChannel in chunkChannels.values) {
+          indent.writeln('$chunkChannel.setMessageHandler(null);');
+        }
+      });
+    }
   }
 
   /// Writes the message call handler for a Flutter method to [indent].
@@ -1388,7 +1695,9 @@ _extractReplyValueOrThrow(
                 indent.writeln('final $returnTypeString output = $call;');
               }
 
-              const returnExpression = 'output';
+              final returnExpression = returnType.isColumnar
+                  ? '${_columnsEncoderName(returnType.columnarClass!)}(output)'
+                  : 'output';
               final returnStatement = isMockHandler
                   ? 'return <Object?>[$returnExpression];'
                   : 'return wrapResponse(result: $returnExpression);';
@@ -1424,6 +1733,15 @@ cb.Reference refer(TypeDeclaration type, {bool asFuture = false}) {
   return cb.refer(asFuture ? 'Future<$symbol>' : symbol);
 }
 
+/// Returns true if [root] has an event channel API which the GObject or C++
+/// generated code sends in batches.
+bool _containsBatchedEventChannel(Root root) {
+  return root.apis.whereType<AstEventChannelApi>().any(
+    (AstEventChannelApi api) =>
+        (api.gobjectOptions?.isBatched ?? false) || (api.cppOptions?.isBatched ?? false),
+  );
+}
+
 String _escapeForDartSingleQuotedString(String raw) {
   return raw.replaceAll(r'\', r'\\').replaceAll(r'$', r'\$').replaceAll(r"'", r"\'");
 }
@@ -1442,6 +1760,9 @@ String _makeGenericTypeArguments(TypeDeclaration type) {
 /// Casts a value to the expected type, considering nullability, and generic
 /// types.
 String _castValue(String value, TypeDeclaration type) {
+  if (type.isColumnar) {
+    return '${_columnsDecoderName(type.columnarClass!)}($value)';
+  }
   final String typeWithTypeArgs = _makeGenericTypeArguments(type);
   final nullAssert = type.isNullable ? '' : '!';
   value = '$value$nullAssert';
@@ -1464,6 +1785,28 @@ String _castValue(String value, TypeDeclaration type) {
   return '($valueWithTypeCast)$castCall';
 }
 
+/// Returns the name of the function that converts a list of the `@Columnar`
+/// [classDefinition] to its columns.
+String _columnsEncoderName(Class classDefinition) => '_encode${classDefinition.name}Columns';
+
+/// Returns the name of the function that converts the columns of a list of the
+/// `@Columnar` [classDefinition] back to a list.
+String _columnsDecoderName(Class classDefinition) => '_decode${classDefinition.name}Columns';
+
+/// Returns the Dart type of the list that holds the values of a field of
+/// [type] in a `@Columnar` class.
+String _columnType(TypeDeclaration type) {
+  return switch (type.baseName) {
+    'bool' => 'Uint8List',
+    'int' => 'Int64List',
+    'double' => 'Float64List',
+    _ => 'List<String>',
+  };
+}
+
+/// Returns the name of the variable that holds the column of [field].
+String _columnVariableName(NamedType field) => '${field.name}Column';
+
 /// Returns an argument name that can be used in a context where it is possible to collide.
 String _getSafeArgumentName(int count, NamedType field) =>
     field.name.isEmpty ? 'arg$count' : 'arg_${field.name}';
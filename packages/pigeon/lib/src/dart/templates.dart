@@ -161,6 +161,16 @@ class $dartInstanceManagerClassName {
     return _strongInstances.remove(identifier) as T?;
   }
 
+  /// Removes each of [identifiers] and its associated strongly referenced
+  /// instance, if present, from the manager.
+  ///
+  /// See [remove].
+  void removeAll(List<int> identifiers) {
+    for (final int identifier in identifiers) {
+      remove(identifier);
+    }
+  }
+
   /// Retrieves the instance associated with identifier.
   ///
   /// The value returned is chosen from the following order:
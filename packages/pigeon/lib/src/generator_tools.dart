@@ -15,7 +15,7 @@ import 'generator.dart';
 /// The current version of pigeon.
 ///
 /// This must match the version in pubspec.yaml.
-const String pigeonVersion = '27.1.1';
+const String pigeonVersion = '28.0.0';
 
 /// Default plugin package name.
 const String defaultPluginPackageName = 'dev.flutter.pigeon';
@@ -209,6 +209,25 @@ String makeChannelNameWithStrings({
   return 'dev.flutter.pigeon.$dartPackageName.$apiName.$methodName';
 }
 
+/// Create the generated channel name shared by all methods of an [api] that
+/// uses a multiplexed channel.
+String makeMultiplexedChannelName(Api api, String dartPackageName) {
+  return 'dev.flutter.pigeon.$dartPackageName.${api.name}';
+}
+
+/// The suffix added to the channel name of a `@ChunkedBytes` method to get the
+/// channel that its chunks are read on.
+///
+/// Dart reads the streams the host returns on this channel, and serves each
+/// `Uint8List` argument on this channel followed by `.<id>`. The channel's
+/// message suffix goes before it.
+const String chunkChannelSuffix = '.chunks';
+
+/// Returns true if [root] has a method with a `@ChunkedBytes` annotation.
+bool hasChunkedBytesMethods(Root root) {
+  return root.apis.any((Api api) => api.methods.any((Method method) => method.chunkSize != null));
+}
+
 // TODO(tarrinneal): Determine whether HostDataType is needed.
 
 /// Represents the mapping of a Dart datatype to a Host datatype.
@@ -853,6 +872,18 @@ String makeRemoveStrongReferenceChannelName(String dartPackageName) {
   );
 }
 
+/// The channel name for the `removeStrongReferences` method of the
+/// `InstanceManager` API, which releases several instances in one message.
+///
+/// This ensures the channel name is the same for all languages.
+String makeRemoveStrongReferencesChannelName(String dartPackageName) {
+  return makeChannelNameWithStrings(
+    apiName: '${classNamePrefix}InstanceManager',
+    methodName: 'removeStrongReferences',
+    dartPackageName: dartPackageName,
+  );
+}
+
 /// The channel name for the `clear` method of the `InstanceManager` API.
 ///
 /// This ensures the channel name is the same for all languages.
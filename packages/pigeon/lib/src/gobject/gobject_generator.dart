@@ -8,6 +8,7 @@ import '../ast.dart';
 import '../functional.dart';
 import '../generator.dart';
 import '../generator_tools.dart';
+import '../types/task_queue.dart';
 
 /// Documentation comment spec.
 const DocumentCommentSpecification _docCommentSpec = DocumentCommentSpecification(
@@ -22,6 +23,13 @@ const String _codecBaseName = 'MessageCodec';
 /// Name of the standard codec from the Flutter SDK.
 const String _standardCodecName = 'FlStandardMessageCodec';
 
+/// Name for the stream that reads the Uint8List arguments of @ChunkedBytes
+/// methods.
+const String _chunkedInputStreamName = 'ChunkedInputStream';
+
+/// Name for the class that manages ProxyApi instances.
+const String _instanceManagerBaseName = '${proxyApiClassNamePrefix}InstanceManager';
+
 /// Options that control how GObject code will be generated.
 class GObjectOptions {
   /// Creates a [GObjectOptions] object
@@ -30,6 +38,7 @@ class GObjectOptions {
     this.module,
     this.copyrightHeader,
     this.headerOutPath,
+    this.typedDataAsGBytes,
   });
 
   /// The path to the header that will get placed in the source file (example:
@@ -45,6 +54,14 @@ class GObjectOptions {
   /// The path to the output header file location.
   final String? headerOutPath;
 
+  /// Determines if typed data fields in data classes (`Uint8List`,
+  /// `Int32List`, etc.) are stored in a `GBytes`.
+  ///
+  /// When enabled, decoded typed data refers to the memory of the received
+  /// message rather than being copied, and a `*_get_*_bytes()` accessor is
+  /// generated for each of these fields. This is false by default.
+  final bool? typedDataAsGBytes;
+
   /// Creates a [GObjectOptions] from a Map representation where:
   /// `x = GObjectOptions.fromMap(x.toMap())`.
   static GObjectOptions fromMap(Map<String, Object> map) {
@@ -54,6 +71,7 @@ class GObjectOptions {
       module: map['module'] as String?,
       copyrightHeader: copyrightHeader?.cast<String>(),
       headerOutPath: map['gobjectHeaderOut'] as String?,
+      typedDataAsGBytes: map['typedDataAsGBytes'] as bool?,
     );
   }
 
@@ -64,6 +82,7 @@ class GObjectOptions {
       if (headerIncludePath != null) 'header': headerIncludePath!,
       if (module != null) 'module': module!,
       if (copyrightHeader != null) 'copyrightHeader': copyrightHeader!,
+      if (typedDataAsGBytes != null) 'typedDataAsGBytes': typedDataAsGBytes!,
     };
     return result;
   }
@@ -85,6 +104,7 @@ class InternalGObjectOptions extends InternalOptions {
     this.module,
     this.copyrightHeader,
     this.headerOutPath,
+    this.typedDataAsGBytes = false,
   });
 
   /// Creates InternalGObjectOptions from GObjectOptions.
@@ -96,7 +116,8 @@ class InternalGObjectOptions extends InternalOptions {
   }) : headerIncludePath = options.headerIncludePath ?? path.basename(gobjectHeaderOut),
        module = options.module,
        copyrightHeader = options.copyrightHeader ?? copyrightHeader,
-       headerOutPath = options.headerOutPath;
+       headerOutPath = options.headerOutPath,
+       typedDataAsGBytes = options.typedDataAsGBytes ?? false;
 
   /// The path to the header that will get placed in the source file (example:
   /// "foo.h").
@@ -116,6 +137,36 @@ class InternalGObjectOptions extends InternalOptions {
 
   /// The path to the output header file location.
   final String? headerOutPath;
+
+  /// Determines if typed data fields in data classes are stored in a `GBytes`.
+  final bool typedDataAsGBytes;
+}
+
+/// Options that control how GObject code will be generated for a specific
+/// event channel API.
+class GObjectEventChannelOptions {
+  /// Construct a [GObjectEventChannelOptions].
+  const GObjectEventChannelOptions({this.maxBatchSize = 1, this.maxBatchLatencyMilliseconds = 0});
+
+  /// The maximum number of events that are sent in a single platform message.
+  ///
+  /// When this is greater than 1, events sent to a sink are collected into a
+  /// list which is sent once it holds [maxBatchSize] events, or once
+  /// [maxBatchLatencyMilliseconds] have passed since the first event was
+  /// added. The generated Dart code unpacks the list, so listeners still
+  /// receive the events one at a time.
+  ///
+  /// Defaults to 1, which sends every event as soon as it is added.
+  final int maxBatchSize;
+
+  /// The maximum time in milliseconds that an event is held in a batch before
+  /// it is sent.
+  ///
+  /// Defaults to 0, which sends a batch once the main loop is idle.
+  final int maxBatchLatencyMilliseconds;
+
+  /// Whether events are collected into batches.
+  bool get isBatched => maxBatchSize > 1;
 }
 
 /// Class that manages all GObject code generation.
@@ -232,6 +283,30 @@ class GObjectHeaderGenerator extends StructuredGenerator<InternalGObjectOptions>
     });
   }
 
+  @override
+  void writeDataClasses(
+    InternalGObjectOptions generatorOptions,
+    Root root,
+    Indent indent, {
+    required String dartPackageName,
+  }) {
+    // Sealed classes are written first as their subclasses need the complete
+    // parent type.
+    final Iterable<Class> classes = <Class>[
+      ...root.classes.where((Class classDefinition) => classDefinition.isSealed),
+      ...root.classes.where((Class classDefinition) => !classDefinition.isSealed),
+    ];
+    for (final Class classDefinition in classes) {
+      writeDataClass(
+        generatorOptions,
+        root,
+        indent,
+        classDefinition,
+        dartPackageName: dartPackageName,
+      );
+    }
+  }
+
   @override
   void writeDataClass(
     InternalGObjectOptions generatorOptions,
@@ -249,10 +324,33 @@ class GObjectHeaderGenerator extends StructuredGenerator<InternalGObjectOptions>
       '$className:',
       '',
       ...classDefinition.documentationComments,
+      if (classDefinition.isSealed) ...<String>[
+        if (classDefinition.documentationComments.isNotEmpty) '',
+        'This is an abstract type, values are one of its subclasses:',
+        for (final Class child in classDefinition.children)
+          '#${_getClassName(module, child.name)}',
+      ],
     ], _docCommentSpec);
 
+    if (classDefinition.isSealed) {
+      indent.newln();
+      _writeDeclareDerivableType(indent, module, classDefinition.name);
+
+      indent.newln();
+      indent.writeScoped('struct _${className}Class {', '};', () {
+        indent.writeln('GObjectClass parent_class;');
+      });
+      return;
+    }
+
     indent.newln();
-    _writeDeclareFinalType(indent, module, classDefinition.name);
+    final Class? superClass = classDefinition.superClass;
+    _writeDeclareFinalType(
+      indent,
+      module,
+      classDefinition.name,
+      parentClassName: superClass != null ? _getClassName(module, superClass.name) : 'GObject',
+    );
 
     indent.newln();
     final constructorArgs = <String>[];
@@ -283,6 +381,23 @@ class GObjectHeaderGenerator extends StructuredGenerator<InternalGObjectOptions>
 
     indent.writeln("$className* ${methodPrefix}_new(${constructorArgs.join(', ')});");
 
+    indent.newln();
+    addDocumentationComments(indent, <String>[
+      '${methodPrefix}_new_take:',
+      ...constructorFieldCommentLines,
+      '',
+      'Creates a new #${classDefinition.name} object.',
+      '',
+      'This takes ownership of the string, list, map, object and typed data',
+      'values instead of copying them. Typed data must have been allocated with',
+      'g_malloc().',
+      '',
+      'Returns: a new #$className',
+    ], _docCommentSpec);
+    indent.writeln(
+      "$className* ${methodPrefix}_new_take(${_getTakeConstructorArgs(module, classDefinition).join(', ')});",
+    );
+
     for (final NamedType field in classDefinition.fields) {
       final String fieldName = _getFieldName(field.name);
       final String returnType = _getType(module, field.type);
@@ -305,6 +420,20 @@ class GObjectHeaderGenerator extends StructuredGenerator<InternalGObjectOptions>
         if (_isNumericListType(field.type)) 'size_t* length',
       ];
       indent.writeln('$returnType ${methodPrefix}_get_$fieldName(${getterArgs.join(', ')});');
+
+      if (generatorOptions.typedDataAsGBytes && _isNumericListType(field.type)) {
+        indent.newln();
+        addDocumentationComments(indent, <String>[
+          '${methodPrefix}_get_${fieldName}_bytes',
+          '@object: a #$className.',
+          '',
+          'Gets the value of the ${field.name} field of @object as a #GBytes. For a',
+          'decoded object this refers to the memory of the received message.',
+          '',
+          'Returns: (transfer none): the field value.',
+        ], _docCommentSpec);
+        indent.writeln('GBytes* ${methodPrefix}_get_${fieldName}_bytes($className* object);');
+      }
     }
 
     indent.newln();
@@ -324,7 +453,9 @@ class GObjectHeaderGenerator extends StructuredGenerator<InternalGObjectOptions>
       '${methodPrefix}_hash:',
       '@object: a #$className.',
       '',
-      'Calculates a hash code for a #$className object.',
+      'Calculates a hash code for a #$className object. The hash code is only',
+      'calculated once, so the list and map values of @object must not be',
+      'modified after it is created.',
       '',
       'Returns: the hash code.',
     ], _docCommentSpec);
@@ -340,6 +471,236 @@ class GObjectHeaderGenerator extends StructuredGenerator<InternalGObjectOptions>
       'Returns: (transfer full): a new string, free with g_free().',
     ], _docCommentSpec);
     indent.writeln('gchar* ${methodPrefix}_to_string($className* object);');
+
+    if (classDefinition.isColumnar) {
+      _writeColumnsClass(indent, module, classDefinition);
+    }
+  }
+
+  // Writes the declaration of the type that holds a list of the @Columnar
+  // class [classDefinition] as one array per field.
+  void _writeColumnsClass(Indent indent, String module, Class classDefinition) {
+    final String columnsName = _getColumnsName(classDefinition);
+    final String className = _getClassName(module, classDefinition.name);
+    final String columnsClassName = _getClassName(module, columnsName);
+    final String methodPrefix = _getMethodPrefix(module, columnsName);
+
+    indent.newln();
+    addDocumentationComments(indent, <String>[
+      '$columnsClassName:',
+      '',
+      'A list of #$className sent by host and Flutter API methods as one array',
+      'per field. The values of a field can be read without creating an object',
+      'for each row.',
+    ], _docCommentSpec);
+
+    indent.newln();
+    _writeDeclareFinalType(indent, module, columnsName);
+
+    indent.newln();
+    addDocumentationComments(indent, <String>[
+      '${methodPrefix}_new:',
+      for (final NamedType field in classDefinition.fields)
+        '${_getFieldName(field.name)}: the ${field.name} field of each row.',
+      'length: the number of rows.',
+      '',
+      'Creates a new #$columnsClassName object, copying the values.',
+      '',
+      'Returns: a new #$columnsClassName',
+    ], _docCommentSpec);
+    final constructorArgs = <String>[
+      for (final NamedType field in classDefinition.fields)
+        '${_getColumnType(field.type)} ${_getFieldName(field.name)}',
+      'size_t length',
+    ];
+    indent.writeln("$columnsClassName* ${methodPrefix}_new(${constructorArgs.join(', ')});");
+
+    indent.newln();
+    addDocumentationComments(indent, <String>[
+      '${methodPrefix}_get_length',
+      '@object: a #$columnsClassName.',
+      '',
+      'Gets the number of rows in @object.',
+      '',
+      'Returns: the number of rows.',
+    ], _docCommentSpec);
+    indent.writeln('size_t ${methodPrefix}_get_length($columnsClassName* object);');
+
+    for (final NamedType field in classDefinition.fields) {
+      final String fieldName = _getFieldName(field.name);
+      final bool isString = field.type.baseName == 'String';
+
+      indent.newln();
+      addDocumentationComments(indent, <String>[
+        '${methodPrefix}_get_$fieldName',
+        '@object: a #$columnsClassName.',
+        if (isString) '@index: the row to get the value of.',
+        '',
+        if (isString)
+          'Gets the ${field.name} field of row @index of @object.'
+        else ...<String>[
+          'Gets the ${field.name} field of every row of @object, as an array with',
+          '${methodPrefix}_get_length() values.',
+        ],
+        if (field.type.baseName == 'bool') 'Each value is 1 for TRUE and 0 for FALSE.',
+        '',
+        'Returns: (transfer none): the field ${isString ? 'value' : 'values'}.',
+      ], _docCommentSpec);
+      final getterArgs = <String>['$columnsClassName* object', if (isString) 'size_t index'];
+      indent.writeln(
+        '${_getColumnType(field.type, isElementType: isString)} ${methodPrefix}_get_$fieldName(${getterArgs.join(', ')});',
+      );
+    }
+  }
+
+  @override
+  void writeInstanceManager(
+    InternalGObjectOptions generatorOptions,
+    Root root,
+    Indent indent, {
+    required String dartPackageName,
+  }) {
+    final String module = _getModule(generatorOptions, dartPackageName);
+    final String className = _getClassName(module, _instanceManagerBaseName);
+    final String methodPrefix = _getMethodPrefix(module, _instanceManagerBaseName);
+
+    indent.newln();
+    addDocumentationComments(indent, <String>[
+      '$className:',
+      '',
+      'Maintains the instances used to communicate with the corresponding objects',
+      'in Dart.',
+      '',
+      'Each instance is stored with a strong reference until Dart releases it, and',
+      'with a weak reference that is used to tell Dart when the instance has been',
+      'finalized. Finalized instances are released in Dart in batches, with one',
+      'message for the instances finalized before the main loop runs.',
+      '',
+      'The functions of an instance manager may be called from any thread.',
+    ], _docCommentSpec);
+
+    indent.newln();
+    _writeDeclareFinalType(indent, module, _instanceManagerBaseName);
+
+    indent.newln();
+    addDocumentationComments(indent, <String>[
+      '${_getInstanceManagerTypeId(module)}:',
+      '',
+      'The custom type ID used by the codec to encode instances in the instance',
+      'manager.',
+    ], _docCommentSpec);
+    indent.writeln('extern const int ${_getInstanceManagerTypeId(module)};');
+
+    indent.newln();
+    addDocumentationComments(indent, <String>[
+      '${methodPrefix}_new:',
+      '@messenger: an #FlBinaryMessenger.',
+      '',
+      'Creates a new instance manager and connects the handlers Dart uses to',
+      'release instances.',
+      '',
+      'Returns: a new #$className',
+    ], _docCommentSpec);
+    indent.writeln('$className* ${methodPrefix}_new(FlBinaryMessenger* messenger);');
+
+    indent.newln();
+    addDocumentationComments(indent, <String>[
+      '${methodPrefix}_add_dart_created_instance:',
+      '@instance_manager: a #$className.',
+      '@instance: the instance to add.',
+      '@identifier: the identifier Dart uses for @instance.',
+      '',
+      'Adds an instance that was created from Dart.',
+      '',
+      'Returns: %TRUE if the instance was added, or %FALSE if @identifier or',
+      '@instance has already been added.',
+    ], _docCommentSpec);
+    indent.writeln(
+      'gboolean ${methodPrefix}_add_dart_created_instance($className* instance_manager, GObject* instance, int64_t identifier);',
+    );
+
+    indent.newln();
+    addDocumentationComments(indent, <String>[
+      '${methodPrefix}_add_host_created_instance:',
+      '@instance_manager: a #$className.',
+      '@instance: the instance to add.',
+      '',
+      'Adds an instance that was created on the host, and assigns it a new',
+      'identifier.',
+      '',
+      'Returns: the identifier for @instance, or -1 if it has already been added.',
+    ], _docCommentSpec);
+    indent.writeln(
+      'int64_t ${methodPrefix}_add_host_created_instance($className* instance_manager, GObject* instance);',
+    );
+
+    indent.newln();
+    addDocumentationComments(indent, <String>[
+      '${methodPrefix}_get_instance:',
+      '@instance_manager: a #$className.',
+      '@identifier: the identifier of the instance.',
+      '',
+      'Gets the instance associated with @identifier.',
+      '',
+      'Returns: (transfer full) (allow-none): a new reference to the instance, or',
+      '%NULL if not found.',
+    ], _docCommentSpec);
+    indent.writeln(
+      'GObject* ${methodPrefix}_get_instance($className* instance_manager, int64_t identifier);',
+    );
+
+    indent.newln();
+    addDocumentationComments(indent, <String>[
+      '${methodPrefix}_get_identifier:',
+      '@instance_manager: a #$className.',
+      '@instance: the instance to look up.',
+      '@identifier: location to write the identifier of @instance.',
+      '',
+      'Gets the identifier associated with @instance. If Dart had released the',
+      'instance, the instance manager holds a strong reference to it again.',
+      '',
+      'Returns: %TRUE if @instance is in the instance manager.',
+    ], _docCommentSpec);
+    indent.writeln(
+      'gboolean ${methodPrefix}_get_identifier($className* instance_manager, GObject* instance, int64_t* identifier);',
+    );
+
+    indent.newln();
+    addDocumentationComments(indent, <String>[
+      '${methodPrefix}_contains_instance:',
+      '@instance_manager: a #$className.',
+      '@instance: the instance to look up.',
+      '',
+      'Checks if @instance is in the instance manager.',
+      '',
+      'Returns: %TRUE if @instance is in the instance manager.',
+    ], _docCommentSpec);
+    indent.writeln(
+      'gboolean ${methodPrefix}_contains_instance($className* instance_manager, GObject* instance);',
+    );
+
+    indent.newln();
+    addDocumentationComments(indent, <String>[
+      '${methodPrefix}_remove:',
+      '@instance_manager: a #$className.',
+      '@identifier: the identifier of the instance.',
+      '',
+      'Removes the strong reference to the instance associated with @identifier.',
+      'The instance stays in the instance manager until it is finalized.',
+    ], _docCommentSpec);
+    indent.writeln(
+      'void ${methodPrefix}_remove($className* instance_manager, int64_t identifier);',
+    );
+
+    indent.newln();
+    addDocumentationComments(indent, <String>[
+      '${methodPrefix}_clear:',
+      '@instance_manager: a #$className.',
+      '',
+      'Removes all instances from the instance manager, without releasing them',
+      'in Dart.',
+    ], _docCommentSpec);
+    indent.writeln('void ${methodPrefix}_clear($className* instance_manager);');
   }
 
   @override
@@ -597,6 +958,12 @@ class GObjectHeaderGenerator extends StructuredGenerator<InternalGObjectOptions>
       '@user_data_free_func: (allow-none): a function which gets called to free @user_data, or %NULL.',
       '',
       'Connects the method handlers in the ${api.name} API.',
+      if (api.methods.any((Method method) => _usesTaskQueue(api, method))) ...<String>[
+        '',
+        'Methods with a serial background task queue are called one at a time on',
+        'a thread owned by this API. Their responses are sent from the thread-default',
+        'main context at the time this is called.',
+      ],
     ], _docCommentSpec);
     indent.writeln(
       'void ${methodPrefix}_set_method_handlers(FlBinaryMessenger* messenger, const gchar* suffix, const $vtableName* vtable, gpointer user_data, GDestroyNotify user_data_free_func);',
@@ -743,258 +1110,564 @@ class GObjectHeaderGenerator extends StructuredGenerator<InternalGObjectOptions>
   }
 
   @override
-  void writeCloseNamespace(
+  void writeEventChannelApi(
     InternalGObjectOptions generatorOptions,
     Root root,
-    Indent indent, {
+    Indent indent,
+    AstEventChannelApi api, {
     required String dartPackageName,
   }) {
-    indent.newln();
-    indent.writeln('G_END_DECLS');
+    final String module = _getModule(generatorOptions, dartPackageName);
+    final String methodPrefix = _getMethodPrefix(module, api.name);
+    final String vtableName = _getVTableName(module, api.name);
+    final GObjectEventChannelOptions options =
+        api.gobjectOptions ?? const GObjectEventChannelOptions();
 
     indent.newln();
-    final String guardName = _getGuardName(generatorOptions.headerIncludePath);
-    indent.writeln('#endif  // $guardName');
-  }
-}
-
-/// Writes GObject source (.cc) file to sink.
-class GObjectSourceGenerator extends StructuredGenerator<InternalGObjectOptions> {
-  /// Constructor.
-  const GObjectSourceGenerator();
+    _writeDeclareFinalType(indent, module, api.name);
 
-  @override
-  void writeFilePrologue(
-    InternalGObjectOptions generatorOptions,
-    Root root,
-    Indent indent, {
-    required String dartPackageName,
-  }) {
-    if (generatorOptions.copyrightHeader != null) {
-      addLines(indent, generatorOptions.copyrightHeader!, linePrefix: '// ');
+    for (final Method method in api.methods) {
+      _writeEventSinkClass(indent, module, api, method, options);
     }
-    indent.writeln('// ${getGeneratedCodeWarning()}');
-    indent.writeln('// $seeAlsoWarning');
-  }
 
-  @override
-  void writeFileImports(
-    InternalGObjectOptions generatorOptions,
-    Root root,
-    Indent indent, {
-    required String dartPackageName,
-  }) {
     indent.newln();
-    indent.writeln('#include <cmath>');
+    addDocumentationComments(indent, <String>[
+      '$vtableName:',
+      '',
+      'Table of functions exposed by ${api.name} to be implemented by the API provider.',
+      '',
+      'The *_on_listen functions are called when Dart starts listening to a',
+      'stream, and are passed a sink to send the events with. The *_on_cancel',
+      'functions are called when Dart stops listening, and may be %NULL.',
+    ], _docCommentSpec);
+    indent.writeScoped('typedef struct {', '} $vtableName;', () {
+      for (final Method method in api.methods) {
+        final String methodName = _getMethodName(method.name);
+        final String sinkClassName = _getClassName(module, _getEventSinkName(api.name, method.name));
+        indent.writeln(
+          'void (*${methodName}_on_listen)($sinkClassName* sink, gpointer user_data);',
+        );
+        indent.writeln('void (*${methodName}_on_cancel)(gpointer user_data);');
+      }
+    });
+
     indent.newln();
-    indent.writeln('#include <string.h>');
-    indent.writeln('#include "${generatorOptions.headerIncludePath}"');
+    addDocumentationComments(indent, <String>[
+      '${methodPrefix}_set_stream_handlers:',
+      '',
+      '@messenger: an #FlBinaryMessenger.',
+      '@suffix: (allow-none): a suffix to add to the API or %NULL for none.',
+      '@vtable: implementations of the streams in this API.',
+      '@user_data: (closure): user data to pass to the functions in @vtable.',
+      '@user_data_free_func: (allow-none): a function which gets called to free @user_data, or %NULL.',
+      '',
+      'Connects the stream handlers in the ${api.name} API.',
+    ], _docCommentSpec);
+    indent.writeln(
+      'void ${methodPrefix}_set_stream_handlers(FlBinaryMessenger* messenger, const gchar* suffix, const $vtableName* vtable, gpointer user_data, GDestroyNotify user_data_free_func);',
+    );
 
-    _writeHashHelpers(indent);
-    _writeDeepEquals(indent);
-    _writeDeepHash(indent);
-    _writeDeepToString(indent);
+    indent.newln();
+    addDocumentationComments(indent, <String>[
+      '${methodPrefix}_clear_stream_handlers:',
+      '',
+      '@messenger: an #FlBinaryMessenger.',
+      '@suffix: (allow-none): a suffix to add to the API or %NULL for none.',
+      '',
+      'Clears the stream handlers in the ${api.name} API.',
+    ], _docCommentSpec);
+    indent.writeln(
+      'void ${methodPrefix}_clear_stream_handlers(FlBinaryMessenger* messenger, const gchar* suffix);',
+    );
   }
 
-  @override
-  void writeDataClass(
-    InternalGObjectOptions generatorOptions,
-    Root root,
+  // Writes the sink class used to send the events of an event channel method.
+  void _writeEventSinkClass(
     Indent indent,
-    Class classDefinition, {
-    required String dartPackageName,
-  }) {
-    final String module = _getModule(generatorOptions, dartPackageName);
-    final String snakeModule = _snakeCaseFromCamelCase(module);
-    final String className = _getClassName(module, classDefinition.name);
-    final String snakeClassName = _snakeCaseFromCamelCase(classDefinition.name);
+    String module,
+    AstEventChannelApi api,
+    Method method,
+    GObjectEventChannelOptions options,
+  ) {
+    final String sinkName = _getEventSinkName(api.name, method.name);
+    final String sinkClassName = _getClassName(module, sinkName);
+    final String sinkMethodPrefix = _getMethodPrefix(module, sinkName);
 
-    final String methodPrefix = _getMethodPrefix(module, classDefinition.name);
-    final String testMacro = '${snakeModule}_IS_$snakeClassName'.toUpperCase();
+    indent.newln();
+    addDocumentationComments(indent, <String>[
+      '$sinkClassName:',
+      '',
+      'Sends events to the listener of ${api.name}.${method.name}. The functions',
+      'of a sink must only be called on the main thread.',
+      if (options.isBatched) ...<String>[
+        '',
+        'Events are sent in batches of up to ${options.maxBatchSize} events, which are held',
+        'for at most ${options.maxBatchLatencyMilliseconds}ms. Events that are waiting when the',
+        'listener cancels the stream, or that are added after it does, are dropped.',
+      ],
+    ], _docCommentSpec);
 
     indent.newln();
-    _writeObjectStruct(indent, module, classDefinition.name, () {
-      for (final NamedType field in classDefinition.fields) {
-        final String fieldName = _getFieldName(field.name);
-        final String fieldType = _getType(module, field.type, isOutput: true);
-        indent.writeln('$fieldType $fieldName;');
-        if (_isNumericListType(field.type)) {
-          indent.writeln('size_t ${fieldName}_length;');
-        }
-      }
-    });
+    _writeDeclareFinalType(indent, module, sinkName);
 
+    final String valueType = _getType(module, method.returnType);
+    final sendArgs = <String>[
+      '$sinkClassName* sink',
+      '$valueType value',
+      if (_isNumericListType(method.returnType)) 'size_t value_length',
+    ];
     indent.newln();
-    _writeDefineType(indent, module, classDefinition.name);
+    addDocumentationComments(indent, <String>[
+      '${sinkMethodPrefix}_success:',
+      '@sink: a #$sinkClassName.',
+      '@value: the event to send.',
+      if (_isNumericListType(method.returnType)) '@value_length: length of @value.',
+      '',
+      'Sends an event to the listener of ${api.name}.${method.name}.',
+    ], _docCommentSpec);
+    indent.writeln("void ${sinkMethodPrefix}_success(${sendArgs.join(', ')});");
 
     indent.newln();
-    _writeDispose(indent, module, classDefinition.name, () {
-      var haveSelf = false;
-      for (final NamedType field in classDefinition.fields) {
-        final String fieldName = _getFieldName(field.name);
-        final String? clear = _getClearFunction(field.type, 'self->$fieldName');
-        if (clear != null) {
-          if (!haveSelf) {
-            _writeCastSelf(indent, module, classDefinition.name, 'object');
-            haveSelf = true;
-          }
-          indent.writeln('$clear;');
-        }
-      }
-    });
+    addDocumentationComments(indent, <String>[
+      '${sinkMethodPrefix}_error:',
+      '@sink: a #$sinkClassName.',
+      '@code: error code.',
+      '@message: error message.',
+      '@details: (allow-none): error details or %NULL.',
+      '',
+      'Sends an error to the listener of ${api.name}.${method.name}.',
+    ], _docCommentSpec);
+    indent.writeln(
+      'void ${sinkMethodPrefix}_error($sinkClassName* sink, const gchar* code, const gchar* message, FlValue* details);',
+    );
 
     indent.newln();
-    _writeInit(indent, module, classDefinition.name, () {});
+    addDocumentationComments(indent, <String>[
+      '${sinkMethodPrefix}_end_of_stream:',
+      '@sink: a #$sinkClassName.',
+      '',
+      'Indicates to the listener of ${api.name}.${method.name} that no more',
+      'events will be sent.',
+    ], _docCommentSpec);
+    indent.writeln('void ${sinkMethodPrefix}_end_of_stream($sinkClassName* sink);');
+
+    if (options.isBatched) {
+      indent.newln();
+      addDocumentationComments(indent, <String>[
+        '${sinkMethodPrefix}_flush:',
+        '@sink: a #$sinkClassName.',
+        '',
+        'Sends the events that are waiting to be sent in a batch.',
+      ], _docCommentSpec);
+      indent.writeln('void ${sinkMethodPrefix}_flush($sinkClassName* sink);');
+    }
+  }
+
+  @override
+  void writeProxyApi(
+    InternalGObjectOptions generatorOptions,
+    Root root,
+    Indent indent,
+    AstProxyApi api, {
+    required String dartPackageName,
+  }) {
+    final String module = _getModule(generatorOptions, dartPackageName);
+    final String className = _getClassName(module, api.name);
+    final String methodPrefix = _getMethodPrefix(module, api.name);
+    final String vtableName = _getVTableName(module, api.name);
+    final String instanceManagerClassName = _getClassName(module, _instanceManagerBaseName);
 
     indent.newln();
-    _writeClassInit(indent, module, classDefinition.name, () {});
+    addDocumentationComments(indent, <String>[
+      '$className:',
+      '',
+      ...api.documentationComments,
+    ], _docCommentSpec);
 
-    final constructorArgs = <String>[];
-    for (final NamedType field in classDefinition.fields) {
-      final String fieldName = _getFieldName(field.name);
-      constructorArgs.add('${_getType(module, field.type)} $fieldName');
-      if (_isNumericListType(field.type)) {
-        constructorArgs.add('size_t ${fieldName}_length');
+    indent.newln();
+    _writeDeclareFinalType(indent, module, api.name);
+
+    if (api.hasAnyHostMessageCalls()) {
+      final bool hasAsyncMethod = api.hostMethods.any((Method method) => method.isAsynchronous);
+      if (hasAsyncMethod) {
+        indent.newln();
+        _writeDeclareFinalType(indent, module, '${api.name}ResponseHandle');
+      }
+
+      for (final Method method in api.hostMethods.where(
+        (Method method) => !method.isAsynchronous,
+      )) {
+        _writeHostApiRespondClass(indent, module, api, method);
+      }
+
+      indent.newln();
+      _writeProxyApiVTable(indent, module, api);
+
+      indent.newln();
+      addDocumentationComments(indent, <String>[
+        '${methodPrefix}_set_method_handlers:',
+        '',
+        '@messenger: an #FlBinaryMessenger.',
+        '@instance_manager: the #$instanceManagerClassName that holds the instances.',
+        '@vtable: implementations of the methods in this API.',
+        '@user_data: (closure): user data to pass to the functions in @vtable.',
+        '@user_data_free_func: (allow-none): a function which gets called to free @user_data, or %NULL.',
+        '',
+        'Connects the method handlers in the ${api.name} API. Instances created by',
+        'the constructors and attached fields in @vtable are added to',
+        '@instance_manager.',
+      ], _docCommentSpec);
+      indent.writeln(
+        'void ${methodPrefix}_set_method_handlers(FlBinaryMessenger* messenger, $instanceManagerClassName* instance_manager, const $vtableName* vtable, gpointer user_data, GDestroyNotify user_data_free_func);',
+      );
+
+      indent.newln();
+      addDocumentationComments(indent, <String>[
+        '${methodPrefix}_clear_method_handlers:',
+        '',
+        '@messenger: an #FlBinaryMessenger.',
+        '',
+        'Clears the method handlers in the ${api.name} API.',
+      ], _docCommentSpec);
+      indent.writeln('void ${methodPrefix}_clear_method_handlers(FlBinaryMessenger* messenger);');
+
+      for (final Method method in api.hostMethods.where(
+        (Method method) => method.isAsynchronous,
+      )) {
+        _writeHostApiRespondFunctionPrototype(indent, module, api, method);
       }
     }
+
+    final List<(Method, String)> flutterMethods = _getProxyApiFlutterMethods(api);
+    for (final (Method method, _) in flutterMethods) {
+      _writeFlutterApiRespondClass(indent, module, api, method);
+    }
+
     indent.newln();
-    indent.writeScoped("$className* ${methodPrefix}_new(${constructorArgs.join(', ')}) {", '}', () {
-      _writeObjectNew(indent, module, classDefinition.name);
-      for (final NamedType field in classDefinition.fields) {
-        final String fieldName = _getFieldName(field.name);
-        final String value = _referenceValue(
-          module,
-          field.type,
-          fieldName,
-          lengthVariableName: '${fieldName}_length',
-        );
+    addDocumentationComments(indent, <String>[
+      '${methodPrefix}_new:',
+      '@messenger: an #FlBinaryMessenger.',
+      '@instance_manager: the #$instanceManagerClassName that holds the instances.',
+      '',
+      'Creates a new object to call the ${api.name} methods in Dart.',
+      '',
+      'Returns: a new #$className',
+    ], _docCommentSpec);
+    indent.writeln(
+      '$className* ${methodPrefix}_new(FlBinaryMessenger* messenger, $instanceManagerClassName* instance_manager);',
+    );
 
-        if (_isNullablePrimitiveType(field.type)) {
-          final String primitiveType = _getType(module, field.type, primitive: true);
-          indent.writeScoped('if ($value != nullptr) {', '}', () {
-            indent.writeln(
-              'self->$fieldName = static_cast<$primitiveType*>(malloc(sizeof($primitiveType)));',
-            );
-            indent.writeln('*self->$fieldName = *$value;');
-          });
-          indent.writeScoped('else {', '}', () {
-            indent.writeln('self->$fieldName = nullptr;');
-          });
-        } else if (field.type.isNullable) {
-          indent.writeScoped('if ($fieldName != nullptr) {', '}', () {
-            indent.writeln('self->$fieldName = $value;');
-            if (_isNumericListType(field.type)) {
-              indent.writeln('self->${fieldName}_length = ${fieldName}_length;');
-            }
-          });
-          indent.writeScoped('else {', '}', () {
-            indent.writeln('self->$fieldName = nullptr;');
-            if (_isNumericListType(field.type)) {
-              indent.writeln('self->${fieldName}_length = 0;');
-            }
-          });
-        } else {
-          indent.writeln('self->$fieldName = $value;');
-          if (_isNumericListType(field.type)) {
-            indent.writeln('self->${fieldName}_length = ${fieldName}_length;');
-          }
+    for (final (Method method, _) in flutterMethods) {
+      final String methodName = _getMethodName(method.name);
+      final String responseClassName = _getClassName(
+        module,
+        _getResponseName(api.name, method.name),
+      );
+      final bool isNewInstance = method.name == _proxyApiNewInstanceMethodName;
+
+      final asyncArgs = <String>['$className* api', 'GObject* pigeon_instance'];
+      final methodParameterCommentLines = <String>[];
+      for (final Parameter param in method.parameters) {
+        final String paramName = _snakeCaseFromCamelCase(param.name);
+        asyncArgs.add('${_getType(module, param.type)} $paramName');
+        methodParameterCommentLines.add(
+          '@$paramName: ${param.type.isNullable ? '(allow-none): ' : ''}${isNewInstance ? 'value of the field' : 'parameter for this method'}.',
+        );
+        if (_isNumericListType(param.type)) {
+          asyncArgs.add('size_t ${paramName}_length');
+          methodParameterCommentLines.add('@${paramName}_length: length of $paramName.');
         }
       }
-      indent.writeln('return self;');
-    });
-
-    for (final NamedType field in classDefinition.fields) {
-      final String fieldName = _getFieldName(field.name);
-      final String returnType = _getType(module, field.type);
+      asyncArgs.addAll(<String>[
+        'GCancellable* cancellable',
+        'GAsyncReadyCallback callback',
+        'gpointer user_data',
+      ]);
+      indent.newln();
+      addDocumentationComments(indent, <String>[
+        '${methodPrefix}_$methodName:',
+        '@api: a #$className.',
+        if (isNewInstance)
+          '@pigeon_instance: the instance to create a Dart instance for.'
+        else
+          '@pigeon_instance: the instance to call this method on.',
+        ...methodParameterCommentLines,
+        '@cancellable: (allow-none): a #GCancellable or %NULL.',
+        '@callback: (scope async): (allow-none): a #GAsyncReadyCallback to call when the call is complete or %NULL to ignore the response.',
+        '@user_data: (closure): user data to pass to @callback.',
+        '',
+        if (isNewInstance) ...<String>[
+          'Adds @pigeon_instance to the instance manager and creates the',
+          'corresponding Dart instance. Nothing is sent if Dart already has an',
+          'instance for @pigeon_instance.',
+        ] else
+          ...method.documentationComments,
+      ], _docCommentSpec);
+      indent.writeln("void ${methodPrefix}_$methodName(${asyncArgs.join(', ')});");
 
       indent.newln();
-      final getterArgs = <String>[
-        '$className* self',
-        if (_isNumericListType(field.type)) 'size_t* length',
-      ];
-      indent.writeScoped(
-        '$returnType ${methodPrefix}_get_$fieldName(${getterArgs.join(', ')}) {',
-        '}',
-        () {
-          indent.writeln(
-            'g_return_val_if_fail($testMacro(self), ${_getDefaultValue(module, field.type)});',
-          );
-          if (_isNumericListType(field.type)) {
-            indent.writeln('*length = self->${fieldName}_length;');
-          }
-          indent.writeln('return self->$fieldName;');
-        },
+      addDocumentationComments(indent, <String>[
+        '${methodPrefix}_${methodName}_finish:',
+        '@api: a #$className.',
+        '@result: a #GAsyncResult.',
+        '@error: (allow-none): #GError location to store the error occurring, or %NULL to ignore.',
+        '',
+        'Completes a ${methodPrefix}_$methodName() call.',
+        '',
+        'Returns: a #$responseClassName or %NULL on error.',
+      ], _docCommentSpec);
+      indent.writeln(
+        '$responseClassName* ${methodPrefix}_${methodName}_finish($className* api, GAsyncResult* result, GError** error);',
       );
     }
+  }
 
-    indent.newln();
-    indent.writeScoped('static FlValue* ${methodPrefix}_to_list($className* self) {', '}', () {
-      indent.writeln('FlValue* values = fl_value_new_list();');
-      for (final NamedType field in classDefinition.fields) {
-        final String fieldName = _getFieldName(field.name);
-        indent.writeln(
-          'fl_value_append_take(values, ${_makeFlValue(root, module, field.type, 'self->$fieldName', lengthVariableName: 'self->${fieldName}_length')});',
+  // Writes the vtable for a ProxyApi.
+  void _writeProxyApiVTable(Indent indent, String module, AstProxyApi api) {
+    final String className = _getClassName(module, api.name);
+    final String vtableName = _getVTableName(module, api.name);
+
+    addDocumentationComments(indent, <String>[
+      '$vtableName:',
+      '',
+      'Table of functions exposed by ${api.name} to be implemented by the API provider.',
+      '',
+      'Constructors and attached fields return a new instance, or %NULL and set',
+      'the error if the instance could not be created.',
+    ], _docCommentSpec);
+    indent.writeScoped('typedef struct {', '} $vtableName;', () {
+      for (final Constructor constructor in api.constructors) {
+        final String methodName = _getMethodName(_getProxyApiConstructorName(constructor));
+        final List<String> methodArgs = _getProxyApiParameterArgs(module, <NamedType>[
+          ...api.unattachedFields,
+          ...constructor.parameters,
+        ]);
+        methodArgs.addAll(<String>['GError** error', 'gpointer user_data']);
+        indent.writeln("GObject* (*$methodName)(${methodArgs.join(', ')});");
+      }
+      for (final ApiField field in api.attachedFields) {
+        final String methodName = _getMethodName(field.name);
+        final methodArgs = <String>[
+          if (!field.isStatic) 'GObject* pigeon_instance',
+          'GError** error',
+          'gpointer user_data',
+        ];
+        indent.writeln("GObject* (*$methodName)(${methodArgs.join(', ')});");
+      }
+      for (final Method method in api.hostMethods) {
+        final String methodName = _getMethodName(method.name);
+        final String responseClassName = _getClassName(
+          module,
+          _getResponseName(api.name, method.name),
         );
+        final List<String> methodArgs = _getProxyApiParameterArgs(module, <NamedType>[
+          if (!method.isStatic) _getProxyApiInstanceParameter(api),
+          ...method.parameters,
+        ]);
+        methodArgs.addAll(<String>[
+          if (method.isAsynchronous) '${className}ResponseHandle* response_handle',
+          'gpointer user_data',
+        ]);
+        final returnType = method.isAsynchronous ? 'void' : '$responseClassName*';
+        indent.writeln("$returnType (*$methodName)(${methodArgs.join(', ')});");
       }
-      indent.writeln('return values;');
     });
+  }
 
+  @override
+  void writeCloseNamespace(
+    InternalGObjectOptions generatorOptions,
+    Root root,
+    Indent indent, {
+    required String dartPackageName,
+  }) {
     indent.newln();
-    indent.writeScoped(
-      'static $className* ${methodPrefix}_new_from_list(FlValue* values) {',
-      '}',
-      () {
-        final args = <String>[];
-        for (var i = 0; i < classDefinition.fields.length; i++) {
-          final NamedType field = classDefinition.fields[i];
-          final String fieldName = _getFieldName(field.name);
-          final String fieldType = _getType(module, field.type);
-          final String fieldValue = _fromFlValue(module, field.type, 'value$i');
-          indent.writeln('FlValue* value$i = fl_value_get_list_value(values, $i);');
-          args.add(fieldName);
-          if (_isNullablePrimitiveType(field.type)) {
-            indent.writeln('$fieldType $fieldName = nullptr;');
-            indent.writeln(
-              '${_getType(module, field.type, isOutput: true, primitive: true)} ${fieldName}_value;',
-            );
-            indent.writeScoped('if (fl_value_get_type(value$i) != FL_VALUE_TYPE_NULL) {', '}', () {
-              indent.writeln('${fieldName}_value = $fieldValue;');
-              indent.writeln('$fieldName = &${fieldName}_value;');
-            });
-          } else if (field.type.isNullable) {
-            indent.writeln('$fieldType $fieldName = nullptr;');
-            if (_isNumericListType(field.type)) {
-              indent.writeln('size_t ${fieldName}_length = 0;');
-              args.add('${fieldName}_length');
-            }
-            indent.writeScoped('if (fl_value_get_type(value$i) != FL_VALUE_TYPE_NULL) {', '}', () {
-              indent.writeln('$fieldName = $fieldValue;');
-              if (_isNumericListType(field.type)) {
-                indent.writeln('${fieldName}_length = fl_value_get_length(value$i);');
-              }
-            });
-          } else {
-            indent.writeln('$fieldType $fieldName = $fieldValue;');
-            if (_isNumericListType(field.type)) {
-              indent.writeln('size_t ${fieldName}_length = fl_value_get_length(value$i);');
-              args.add('${fieldName}_length');
-            }
-          }
-        }
-        indent.writeln('return ${methodPrefix}_new(${args.join(', ')});');
-      },
-    );
+    indent.writeln('G_END_DECLS');
 
-    _writeClassEquality(
-      generatorOptions,
-      root,
+    indent.newln();
+    final String guardName = _getGuardName(generatorOptions.headerIncludePath);
+    indent.writeln('#endif  // $guardName');
+  }
+}
+
+/// Writes GObject source (.cc) file to sink.
+class GObjectSourceGenerator extends StructuredGenerator<InternalGObjectOptions> {
+  /// Constructor.
+  const GObjectSourceGenerator();
+
+  @override
+  void writeFilePrologue(
+    InternalGObjectOptions generatorOptions,
+    Root root,
+    Indent indent, {
+    required String dartPackageName,
+  }) {
+    if (generatorOptions.copyrightHeader != null) {
+      addLines(indent, generatorOptions.copyrightHeader!, linePrefix: '// ');
+    }
+    indent.writeln('// ${getGeneratedCodeWarning()}');
+    indent.writeln('// $seeAlsoWarning');
+  }
+
+  @override
+  void writeFileImports(
+    InternalGObjectOptions generatorOptions,
+    Root root,
+    Indent indent, {
+    required String dartPackageName,
+  }) {
+    indent.newln();
+    indent.writeln('#include <cmath>');
+    indent.newln();
+    indent.writeln('#include <string.h>');
+    indent.writeln('#include "${generatorOptions.headerIncludePath}"');
+
+    _writeHashHelpers(indent);
+    _writeDeepHash(indent);
+    _writeDeepEquals(indent);
+    _writeDeepToString(indent);
+    _writeEncodeHelpers(indent);
+    _writeDecodeHelpers(indent);
+    if (hasChunkedBytesMethods(root)) {
+      _writeChunkedInputStream(indent, _getModule(generatorOptions, dartPackageName));
+    }
+  }
+
+  // Writes the stream that reads a Uint8List argument of a @ChunkedBytes
+  // method by requesting each chunk from Dart.
+  void _writeChunkedInputStream(Indent indent, String module) {
+    final String className = _getClassName(module, _chunkedInputStreamName);
+    final String methodPrefix = _getMethodPrefix(module, _chunkedInputStreamName);
+
+    indent.newln();
+    indent.writeln(
+      '// Reads a Uint8List argument from the channel that Dart sent in place of the bytes.',
+    );
+    _writeDeclareFinalType(
       indent,
-      classDefinition,
-      dartPackageName: dartPackageName,
+      module,
+      _chunkedInputStreamName,
+      parentClassName: 'GInputStream',
+    );
+
+    indent.newln();
+    _writeObjectStruct(indent, module, _chunkedInputStreamName, () {
+      indent.writeln('FlBasicMessageChannel* channel;');
+    }, parentClassName: 'GInputStream');
+
+    indent.newln();
+    _writeDefineType(indent, module, _chunkedInputStreamName, parentType: 'G_TYPE_INPUT_STREAM');
+
+    indent.newln();
+    indent.writeln('// The buffer that a chunk is read into.');
+    indent.writeScoped('typedef struct {', '} ${className}Read;', () {
+      indent.writeln('void* buffer;');
+      indent.writeln('gsize count;');
+    });
+
+    indent.newln();
+    _writeDispose(indent, module, _chunkedInputStreamName, () {
+      _writeCastSelf(indent, module, _chunkedInputStreamName, 'object');
+      indent.writeln('g_clear_object(&self->channel);');
+    });
+
+    indent.newln();
+    indent.writeln('// Chunks arrive as messages from Dart, so they can only be read asynchronously.');
+    indent.writeScoped(
+      'static gssize ${methodPrefix}_read(GInputStream* stream, void* buffer, gsize count, GCancellable* cancellable, GError** error) {',
+      '}',
+      () {
+        indent.writeln(
+          'g_set_error_literal(error, G_IO_ERROR, G_IO_ERROR_NOT_SUPPORTED, "Chunked streams can only be read asynchronously");',
+        );
+        indent.writeln('return -1;');
+      },
+    );
+
+    indent.newln();
+    indent.writeScoped(
+      'static void ${methodPrefix}_read_cb(GObject* object, GAsyncResult* result, gpointer user_data) {',
+      '}',
+      () {
+        indent.writeln('g_autoptr(GTask) task = G_TASK(user_data);');
+        indent.writeln('${className}Read* read = static_cast<${className}Read*>(g_task_get_task_data(task));');
+        indent.writeln('GError* error = nullptr;');
+        indent.writeln(
+          'g_autoptr(FlValue) chunk = fl_basic_message_channel_send_finish(FL_BASIC_MESSAGE_CHANNEL(object), result, &error);',
+        );
+        indent.writeScoped('if (chunk == nullptr) {', '}', () {
+          indent.writeln('g_task_return_error(task, error);');
+          indent.writeln('return;');
+        });
+        indent.writeScoped('if (fl_value_get_type(chunk) != FL_VALUE_TYPE_UINT8_LIST) {', '}', () {
+          indent.writeln(
+            'g_task_return_new_error(task, G_IO_ERROR, G_IO_ERROR_INVALID_DATA, "Unexpected chunk received");',
+          );
+          indent.writeln('return;');
+        });
+        indent.newln();
+        indent.writeln('size_t length = MIN(fl_value_get_length(chunk), read->count);');
+        indent.writeln('memcpy(read->buffer, fl_value_get_uint8_list(chunk), length);');
+        indent.writeln('g_task_return_int(task, length);');
+      },
+    );
+
+    indent.newln();
+    indent.writeScoped(
+      'static void ${methodPrefix}_read_async(GInputStream* stream, void* buffer, gsize count, int io_priority, GCancellable* cancellable, GAsyncReadyCallback callback, gpointer user_data) {',
+      '}',
+      () {
+        _writeCastSelf(indent, module, _chunkedInputStreamName, 'stream');
+        indent.writeln('GTask* task = g_task_new(self, cancellable, callback, user_data);');
+        indent.writeln('${className}Read* read = g_new(${className}Read, 1);');
+        indent.writeln('read->buffer = buffer;');
+        indent.writeln('read->count = count;');
+        indent.writeln('g_task_set_task_data(task, read, g_free);');
+        indent.newln();
+        indent.writeln('// Dart replies with a chunk of at most this many bytes.');
+        indent.writeln('g_autoptr(FlValue) message = fl_value_new_int(count);');
+        indent.writeln(
+          'fl_basic_message_channel_send(self->channel, message, cancellable, ${methodPrefix}_read_cb, task);',
+        );
+      },
+    );
+
+    indent.newln();
+    indent.writeScoped(
+      'static gssize ${methodPrefix}_read_finish(GInputStream* stream, GAsyncResult* result, GError** error) {',
+      '}',
+      () {
+        indent.writeln('return g_task_propagate_int(G_TASK(result), error);');
+      },
+    );
+
+    indent.newln();
+    _writeInit(indent, module, _chunkedInputStreamName, () {});
+
+    indent.newln();
+    _writeClassInit(indent, module, _chunkedInputStreamName, () {
+      indent.writeln('G_INPUT_STREAM_CLASS(klass)->read_fn = ${methodPrefix}_read;');
+      indent.writeln('G_INPUT_STREAM_CLASS(klass)->read_async = ${methodPrefix}_read_async;');
+      indent.writeln('G_INPUT_STREAM_CLASS(klass)->read_finish = ${methodPrefix}_read_finish;');
+    });
+
+    indent.newln();
+    indent.writeScoped(
+      'static $className* ${methodPrefix}_new(FlBinaryMessenger* messenger, const gchar* channel_name) {',
+      '}',
+      () {
+        _writeObjectNew(indent, module, _chunkedInputStreamName);
+        indent.writeln('g_autoptr(FlStandardMessageCodec) codec = fl_standard_message_codec_new();');
+        indent.writeln(
+          'self->channel = fl_basic_message_channel_new(messenger, channel_name, FL_MESSAGE_CODEC(codec));',
+        );
+        indent.writeln('return self;');
+      },
     );
   }
 
-  void _writeClassEquality(
+  @override
+  void writeDataClass(
     InternalGObjectOptions generatorOptions,
     Root root,
     Indent indent,
@@ -1008,710 +1681,3466 @@ class GObjectSourceGenerator extends StructuredGenerator<InternalGObjectOptions>
 
     final String methodPrefix = _getMethodPrefix(module, classDefinition.name);
     final String testMacro = '${snakeModule}_IS_$snakeClassName'.toUpperCase();
+    final bool useGBytes =
+        generatorOptions.typedDataAsGBytes && _hasNumericListField(classDefinition);
+
+    if (classDefinition.isSealed) {
+      _writeSealedClass(indent, module, classDefinition);
+      return;
+    }
 
+    final Class? superClass = classDefinition.superClass;
+    final String parentClassName = superClass != null
+        ? _getClassName(module, superClass.name)
+        : 'GObject';
     indent.newln();
-    indent.writeScoped('gboolean ${methodPrefix}_equals($className* a, $className* b) {', '}', () {
-      indent.writeScoped('if (a == b) {', '}', () {
-        indent.writeln('return TRUE;');
-      });
-      indent.writeScoped('if (a == nullptr || b == nullptr) {', '}', () {
-        indent.writeln('return FALSE;');
-      });
+    _writeObjectStruct(indent, module, classDefinition.name, () {
       for (final NamedType field in classDefinition.fields) {
         final String fieldName = _getFieldName(field.name);
-        if (field.type.isClass) {
-          final String fieldMethodPrefix = _getMethodPrefix(module, field.type.baseName);
-          indent.writeScoped(
-            'if (!${fieldMethodPrefix}_equals(a->$fieldName, b->$fieldName)) {',
-            '}',
-            () {
-              indent.writeln('return FALSE;');
-            },
+        if (useGBytes && _isNumericListType(field.type)) {
+          // The data is owned by the GBytes, so is read-only.
+          indent.writeln('${_getType(module, field.type)} $fieldName;');
+          indent.writeln('size_t ${fieldName}_length;');
+          indent.writeln('GBytes* ${fieldName}_bytes;');
+          continue;
+        }
+        final String fieldType = _getType(
+          module,
+          field.type,
+          isOutput: true,
+          primitive: _isNullablePrimitiveType(field.type),
+        );
+        indent.writeln('$fieldType $fieldName;');
+        if (_isNumericListType(field.type)) {
+          indent.writeln('size_t ${fieldName}_length;');
+        }
+      }
+      final Iterable<NamedType> nullablePrimitiveFields = classDefinition.fields.where(
+        (NamedType field) => _isNullablePrimitiveType(field.type),
+      );
+      if (nullablePrimitiveFields.isNotEmpty) {
+        indent.writeln('// Nullable primitive fields are stored inline, with a bit for each');
+        indent.writeln('// to record if it has a value.');
+        for (final NamedType field in nullablePrimitiveFields) {
+          indent.writeln('guint ${_getPresenceName(_getFieldName(field.name))} : 1;');
+        }
+      }
+      indent.writeln('// Hash code, calculated the first time it is needed.');
+      indent.writeln('guint ${classMemberNamePrefix}hash;');
+      indent.writeln('gint ${classMemberNamePrefix}hash_set;');
+    }, parentClassName: parentClassName);
+
+    indent.newln();
+    _writeDefineType(
+      indent,
+      module,
+      classDefinition.name,
+      parentType: superClass != null
+          ? '${_getMethodPrefix(module, superClass.name)}_get_type()'
+          : 'G_TYPE_OBJECT',
+    );
+
+    indent.newln();
+    _writeDispose(indent, module, classDefinition.name, () {
+      var haveSelf = false;
+      for (final NamedType field in classDefinition.fields) {
+        final String fieldName = _getFieldName(field.name);
+        final String? clear = _isNumericListType(field.type)
+            ? useGBytes
+                  ? 'g_clear_pointer(&self->${fieldName}_bytes, g_bytes_unref)'
+                  : 'g_clear_pointer(&self->$fieldName, g_free)'
+            : _getClearFunction(field.type, 'self->$fieldName');
+        if (clear != null) {
+          if (!haveSelf) {
+            _writeCastSelf(indent, module, classDefinition.name, 'object');
+            haveSelf = true;
+          }
+          indent.writeln('$clear;');
+        }
+      }
+    });
+
+    indent.newln();
+    _writeInit(indent, module, classDefinition.name, () {});
+
+    indent.newln();
+    _writeClassInit(indent, module, classDefinition.name, () {});
+
+    final constructorArgs = <String>[];
+    for (final NamedType field in classDefinition.fields) {
+      final String fieldName = _getFieldName(field.name);
+      constructorArgs.add('${_getType(module, field.type)} $fieldName');
+      if (_isNumericListType(field.type)) {
+        constructorArgs.add('size_t ${fieldName}_length');
+      }
+    }
+    final String takeConstructorArgs = _getTakeConstructorArgs(module, classDefinition).join(', ');
+    if (useGBytes) {
+      _writeNewWithBytes(module, indent, classDefinition);
+      for (final copy in <bool>[true, false]) {
+        final String constructorName = copy ? '${methodPrefix}_new' : '${methodPrefix}_new_take';
+        indent.newln();
+        indent.writeScoped(
+          "$className* $constructorName(${copy ? constructorArgs.join(', ') : takeConstructorArgs}) {",
+          '}',
+          () {
+            final args = <String>[];
+            for (final NamedType field in classDefinition.fields) {
+              final String fieldName = _getFieldName(field.name);
+              if (_isNumericListType(field.type)) {
+                final String elementType = _getType(module, field.type, isElementType: true);
+                final newBytes = copy ? 'g_bytes_new' : 'g_bytes_new_take';
+                args.add(
+                  '$fieldName != nullptr ? $newBytes($fieldName, ${fieldName}_length * sizeof($elementType)) : nullptr',
+                );
+              } else {
+                args.add(copy ? _copyFieldValue(module, field) : fieldName);
+              }
+            }
+            indent.writeln('return ${methodPrefix}_new_with_bytes(${args.join(', ')});');
+          },
+        );
+      }
+    } else {
+      indent.newln();
+      indent.writeScoped("$className* ${methodPrefix}_new(${constructorArgs.join(', ')}) {", '}', () {
+        _writeObjectNew(indent, module, classDefinition.name);
+        _writeConstructorFields(module, indent, classDefinition);
+        indent.writeln('return self;');
+      });
+
+      indent.newln();
+      indent.writeScoped("$className* ${methodPrefix}_new_take($takeConstructorArgs) {", '}', () {
+        _writeObjectNew(indent, module, classDefinition.name);
+        _writeConstructorFields(module, indent, classDefinition, takeOwnership: true);
+        indent.writeln('return self;');
+      });
+    }
+
+    for (final NamedType field in classDefinition.fields) {
+      final String fieldName = _getFieldName(field.name);
+      final String returnType = _getType(module, field.type);
+
+      indent.newln();
+      final getterArgs = <String>[
+        '$className* self',
+        if (_isNumericListType(field.type)) 'size_t* length',
+      ];
+      indent.writeScoped(
+        '$returnType ${methodPrefix}_get_$fieldName(${getterArgs.join(', ')}) {',
+        '}',
+        () {
+          indent.writeln(
+            'g_return_val_if_fail($testMacro(self), ${_getDefaultValue(module, field.type)});',
           );
-        } else if (field.type.isEnum) {
-          if (field.type.isNullable) {
-            indent.writeScoped(
-              'if ((a->$fieldName == nullptr) != (b->$fieldName == nullptr)) {',
-              '}',
-              () {
-                indent.writeln('return FALSE;');
-              },
-            );
-            indent.writeScoped(
-              'if (a->$fieldName != nullptr && *a->$fieldName != *b->$fieldName) {',
-              '}',
-              () {
-                indent.writeln('return FALSE;');
-              },
+          if (_isNumericListType(field.type)) {
+            indent.writeln('*length = self->${fieldName}_length;');
+          }
+          if (_isNullablePrimitiveType(field.type)) {
+            indent.writeln(
+              'return self->${_getPresenceName(fieldName)} ? &self->$fieldName : nullptr;',
             );
           } else {
-            indent.writeScoped('if (a->$fieldName != b->$fieldName) {', '}', () {
-              indent.writeln('return FALSE;');
-            });
+            indent.writeln('return self->$fieldName;');
           }
-        } else if (_isNumericListType(field.type)) {
-          indent.writeScoped('if (a->$fieldName != b->$fieldName) {', '}', () {
-            indent.writeScoped(
-              'if (a->$fieldName == nullptr || b->$fieldName == nullptr) {',
-              '}',
-              () {
-                indent.writeln('return FALSE;');
-              },
-            );
-            indent.writeScoped('if (a->${fieldName}_length != b->${fieldName}_length) {', '}', () {
-              indent.writeln('return FALSE;');
-            });
-            if (field.type.baseName == 'Float32List' || field.type.baseName == 'Float64List') {
-              indent.writeScoped('for (size_t i = 0; i < a->${fieldName}_length; i++) {', '}', () {
-                indent.writeScoped(
-                  'if (!flpigeon_equals_double(a->$fieldName[i], b->$fieldName[i])) {',
-                  '}',
-                  () {
-                    indent.writeln('return FALSE;');
-                  },
-                );
-              });
-            } else {
-              final elementSize = field.type.baseName == 'Uint8List'
-                  ? 'sizeof(uint8_t)'
-                  : field.type.baseName == 'Int32List'
-                  ? 'sizeof(int32_t)'
-                  : 'sizeof(int64_t)';
-              indent.writeScoped(
-                'if (memcmp(a->$fieldName, b->$fieldName, a->${fieldName}_length * $elementSize) != 0) {',
-                '}',
-                () {
-                  indent.writeln('return FALSE;');
-                },
-              );
-            }
-          });
-        } else if (field.type.baseName == 'bool' || field.type.baseName == 'int') {
-          if (field.type.isNullable) {
-            indent.writeScoped(
-              'if ((a->$fieldName == nullptr) != (b->$fieldName == nullptr)) {',
-              '}',
-              () {
-                indent.writeln('return FALSE;');
-              },
-            );
+        },
+      );
+    }
+
+    if (useGBytes) {
+      for (final NamedType field in classDefinition.fields) {
+        if (!_isNumericListType(field.type)) {
+          continue;
+        }
+        final String fieldName = _getFieldName(field.name);
+        indent.newln();
+        indent.writeScoped('GBytes* ${methodPrefix}_get_${fieldName}_bytes($className* self) {', '}', () {
+          indent.writeln('g_return_val_if_fail($testMacro(self), nullptr);');
+          indent.writeln('return self->${fieldName}_bytes;');
+        });
+      }
+    }
+
+    // Strings and typed data are read straight out of the message into memory
+    // owned by the new object, so they are only copied once.
+    indent.newln();
+    indent.writeScoped(
+      'static $className* ${methodPrefix}_new_from_buffer($_standardCodecName* codec, GBytes* buffer, size_t* offset, GError** error) {',
+      '}',
+      () {
+        indent.writeln('uint32_t n_values;');
+        indent.writeScoped(
+          'if (!flpigeon_read_list_header(codec, buffer, offset, ${classDefinition.fields.length}, &n_values, error)) {',
+          '}',
+          () {
+            indent.writeln('return nullptr;');
+          },
+        );
+        final args = <String>[];
+        final flValueFields = <int>[];
+        for (var i = 0; i < classDefinition.fields.length; i++) {
+          final NamedType field = classDefinition.fields[i];
+          final String fieldName = _getFieldName(field.name);
+          final String nullable = field.type.isNullable ? 'TRUE' : 'FALSE';
+          if (useGBytes && _isNumericListType(field.type)) {
+            // Typed data is not copied out of the message, the field refers
+            // to a slice of it instead.
+            final String elementType = _getType(module, field.type, isElementType: true);
+            indent.writeln('g_autoptr(GBytes) $fieldName = nullptr;');
             indent.writeScoped(
-              'if (a->$fieldName != nullptr && *a->$fieldName != *b->$fieldName) {',
+              'if (!flpigeon_read_typed_data(codec, buffer, offset, ${_getTypedDataTypeCode(field.type)}, sizeof($elementType), $nullable, &$fieldName, error)) {',
               '}',
               () {
-                indent.writeln('return FALSE;');
+                indent.writeln('return nullptr;');
               },
             );
-          } else {
-            indent.writeScoped('if (a->$fieldName != b->$fieldName) {', '}', () {
-              indent.writeln('return FALSE;');
-            });
-          }
-        } else if (field.type.baseName == 'double') {
-          if (field.type.isNullable) {
+            args.add('static_cast<GBytes*>(g_steal_pointer(&$fieldName))');
+          } else if (_isNumericListType(field.type)) {
+            final String elementType = _getType(module, field.type, isElementType: true);
+            indent.writeln('g_autofree $elementType* $fieldName = nullptr;');
+            indent.writeln('size_t ${fieldName}_length;');
             indent.writeScoped(
-              'if ((a->$fieldName == nullptr) != (b->$fieldName == nullptr)) {',
+              'if (!flpigeon_read_typed_list(codec, buffer, offset, ${_getTypedDataTypeCode(field.type)}, sizeof($elementType), $nullable, reinterpret_cast<gpointer*>(&$fieldName), &${fieldName}_length, error)) {',
               '}',
               () {
-                indent.writeln('return FALSE;');
+                indent.writeln('return nullptr;');
               },
             );
+            args.add('static_cast<$elementType*>(g_steal_pointer(&$fieldName))');
+            args.add('${fieldName}_length');
+          } else if (field.type.baseName == 'String') {
+            indent.writeln('g_autofree gchar* $fieldName = nullptr;');
             indent.writeScoped(
-              'if (a->$fieldName != nullptr && !flpigeon_equals_double(*a->$fieldName, *b->$fieldName)) {',
+              'if (!flpigeon_read_string(codec, buffer, offset, $nullable, &$fieldName, error)) {',
               '}',
               () {
-                indent.writeln('return FALSE;');
+                indent.writeln('return nullptr;');
               },
             );
+            args.add('static_cast<gchar*>(g_steal_pointer(&$fieldName))');
           } else {
-            indent.writeScoped(
-              'if (!flpigeon_equals_double(a->$fieldName, b->$fieldName)) {',
-              '}',
-              () {
-                indent.writeln('return FALSE;');
-              },
+            indent.writeln(
+              'g_autoptr(FlValue) value$i = fl_standard_message_codec_read_value(codec, buffer, offset, error);',
             );
+            indent.writeScoped('if (value$i == nullptr) {', '}', () {
+              indent.writeln('return nullptr;');
+            });
+            flValueFields.add(i);
+            args.add(fieldName);
           }
-        } else if (field.type.baseName == 'String') {
-          indent.writeScoped('if (g_strcmp0(a->$fieldName, b->$fieldName) != 0) {', '}', () {
-            indent.writeln('return FALSE;');
-          });
-        } else {
-          indent.writeScoped('if (!flpigeon_deep_equals(a->$fieldName, b->$fieldName)) {', '}', () {
-            indent.writeln('return FALSE;');
-          });
         }
-      }
-      indent.writeln('return TRUE;');
+        // Values added to the class by a newer version of the sender are
+        // ignored.
+        indent.writeScoped(
+          'if (!flpigeon_skip_values(codec, buffer, offset, n_values - ${classDefinition.fields.length}, error)) {',
+          '}',
+          () {
+            indent.writeln('return nullptr;');
+          },
+        );
+        // Once all the values are read nothing can fail, so the references
+        // taken here can't leak.
+        for (final i in flValueFields) {
+          _writeFieldFromFlValue(module, indent, classDefinition.fields[i], 'value$i');
+        }
+        indent.writeln(
+          'return ${methodPrefix}_${useGBytes ? 'new_with_bytes' : 'new_take'}(${args.join(', ')});',
+        );
+      },
+    );
+
+    _writeClassEquality(
+      generatorOptions,
+      root,
+      indent,
+      classDefinition,
+      dartPackageName: dartPackageName,
+    );
+
+    if (classDefinition.isColumnar) {
+      _writeColumnsClass(indent, module, classDefinition);
+    }
+  }
+
+  // Writes the type that holds a list of the @Columnar class
+  // [classDefinition] as one array per field.
+  //
+  // The columns are kept in the FlValue list that is sent, so the typed data
+  // received in a message is read in place.
+  void _writeColumnsClass(Indent indent, String module, Class classDefinition) {
+    final String columnsName = _getColumnsName(classDefinition);
+    final String columnsClassName = _getClassName(module, columnsName);
+    final String methodPrefix = _getMethodPrefix(module, columnsName);
+    final String testMacro =
+        '${_snakeCaseFromCamelCase(module)}_IS_${_snakeCaseFromCamelCase(columnsName)}'
+            .toUpperCase();
+
+    indent.newln();
+    _writeObjectStruct(indent, module, columnsName, () {
+      indent.writeln('FlValue* columns;');
     });
 
     indent.newln();
-    indent.writeScoped('guint ${methodPrefix}_hash($className* self) {', '}', () {
-      indent.writeln('g_return_val_if_fail($testMacro(self), 0);');
-      indent.writeln('guint result = 0;');
-      for (final NamedType field in classDefinition.fields) {
-        final String fieldName = _getFieldName(field.name);
-        if (field.type.isClass) {
-          final String fieldMethodPrefix = _getMethodPrefix(module, field.type.baseName);
-          indent.writeln('result = result * 31 + ${fieldMethodPrefix}_hash(self->$fieldName);');
-        } else if (field.type.isEnum) {
-          if (field.type.isNullable) {
-            indent.writeln(
-              'result = result * 31 + (self->$fieldName != nullptr ? static_cast<guint>(*self->$fieldName) : 0);',
-            );
-          } else {
-            indent.writeln('result = result * 31 + static_cast<guint>(self->$fieldName);');
-          }
-        } else if (_isNumericListType(field.type)) {
-          indent.writeScoped('{', '}', () {
-            indent.writeln('size_t len = self->${fieldName}_length;');
-            final String elementTypeName = _getType(module, field.type, isElementType: true);
-            indent.writeln('const $elementTypeName* data = self->$fieldName;');
-            indent.writeScoped('if (data != nullptr) {', '}', () {
-              indent.writeScoped('for (size_t i = 0; i < len; i++) {', '}', () {
-                if (field.type.baseName == 'Int64List') {
-                  indent.writeln(
-                    'result = result * 31 + static_cast<guint>(data[i] ^ (data[i] >> 32));',
-                  );
-                } else if (field.type.baseName == 'Float32List' ||
-                    field.type.baseName == 'Float64List') {
-                  indent.writeln('result = result * 31 + flpigeon_hash_double(data[i]);');
-                } else {
-                  indent.writeln('result = result * 31 + static_cast<guint>(data[i]);');
-                }
-              });
-            });
-          });
-        } else if (field.type.baseName == 'bool' || field.type.baseName == 'int') {
-          if (field.type.isNullable) {
-            indent.writeln(
-              'result = result * 31 + (self->$fieldName != nullptr ? static_cast<guint>(*self->$fieldName) : 0);',
-            );
-          } else {
-            indent.writeln('result = result * 31 + static_cast<guint>(self->$fieldName);');
-          }
-        } else if (field.type.baseName == 'double') {
-          if (field.type.isNullable) {
-            indent.writeln(
-              'result = result * 31 + (self->$fieldName != nullptr ? flpigeon_hash_double(*self->$fieldName) : 0);',
-            );
-          } else {
-            indent.writeln('result = result * 31 + flpigeon_hash_double(self->$fieldName);');
-          }
-        } else if (field.type.baseName == 'String') {
-          indent.writeln(
-            'result = result * 31 + (self->$fieldName != nullptr ? g_str_hash(self->$fieldName) : 0);',
-          );
-        } else {
-          indent.writeln('result = result * 31 + flpigeon_deep_hash(self->$fieldName);');
-        }
-      }
-      indent.writeln('return result;');
+    _writeDefineType(indent, module, columnsName);
+
+    indent.newln();
+    _writeDispose(indent, module, columnsName, () {
+      _writeCastSelf(indent, module, columnsName, 'object');
+      indent.writeln('g_clear_pointer(&self->columns, fl_value_unref);');
     });
 
     indent.newln();
-    indent.writeScoped('gchar* ${methodPrefix}_to_string($className* self) {', '}', () {
-      indent.writeln('g_return_val_if_fail($testMacro(self), NULL);');
-      indent.writeln('GString* str = g_string_new("${classDefinition.name}(");');
+    _writeInit(indent, module, columnsName, () {});
 
-      enumerate(classDefinition.fields, (int index, NamedType field) {
-        final String fieldName = _getFieldName(field.name);
-        final comma = index == 0 ? '' : ', ';
-        indent.writeln('g_string_append(str, "$comma${_getFieldName(field.name)}: ");');
+    indent.newln();
+    _writeClassInit(indent, module, columnsName, () {});
 
-        if (field.type.isClass) {
-          final String fieldMethodPrefix = _getMethodPrefix(module, field.type.baseName);
-          _writeAppendValueOrNull(
-            indent,
-            fieldName: fieldName,
-            nonNullBuilder: () {
+    final constructorArgs = <String>[
+      for (final NamedType field in classDefinition.fields)
+        '${_getColumnType(field.type)} ${_getFieldName(field.name)}',
+      'size_t length',
+    ];
+    indent.newln();
+    indent.writeScoped(
+      "$columnsClassName* ${methodPrefix}_new(${constructorArgs.join(', ')}) {",
+      '}',
+      () {
+        _writeObjectNew(indent, module, columnsName);
+        indent.writeln('self->columns = fl_value_new_list();');
+        for (final NamedType field in classDefinition.fields) {
+          final String fieldName = _getFieldName(field.name);
+          if (field.type.baseName == 'String') {
+            indent.writeln('FlValue* ${fieldName}_column = fl_value_new_list();');
+            indent.writeScoped('for (size_t i = 0; i < length; i++) {', '}', () {
               indent.writeln(
-                'gchar* field_str = ${fieldMethodPrefix}_to_string(self->$fieldName);',
+                'fl_value_append_take(${fieldName}_column, fl_value_new_string($fieldName[i]));',
               );
-              indent.writeln('g_string_append(str, field_str);');
-              indent.writeln('g_free(field_str);');
-            },
-          );
-        } else if (field.type.baseName == 'String') {
-          _writeAppendValueOrNull(
-            indent,
-            fieldName: fieldName,
-            nonNullBuilder: () {
-              indent.writeln('g_string_append_printf(str, "\\"%s\\"", self->$fieldName);');
-            },
-          );
-        } else if (field.type.isEnum) {
-          if (field.type.isNullable) {
-            _writeAppendValueOrNull(
-              indent,
-              fieldName: fieldName,
-              nonNullBuilder: () {
-                indent.writeln(
-                  'g_string_append_printf(str, "%d", static_cast<int>(*self->$fieldName));',
-                );
-              },
-            );
+            });
+            indent.writeln('fl_value_append_take(self->columns, ${fieldName}_column);');
           } else {
+            final String newFunction = switch (field.type.baseName) {
+              'bool' => 'fl_value_new_uint8_list',
+              'int' => 'fl_value_new_int64_list',
+              _ => 'fl_value_new_float_list',
+            };
             indent.writeln(
-              'g_string_append_printf(str, "%d", static_cast<int>(self->$fieldName));',
-            );
-          }
-        } else if (_isNumericListType(field.type)) {
-          _writeAppendValueOrNull(
-            indent,
-            fieldName: fieldName,
-            nonNullBuilder: () {
-              indent.writeln('g_string_append(str, "[");');
-              indent.writeln('size_t len = self->${fieldName}_length;');
-              final String elementTypeName = _getType(module, field.type, isElementType: true);
-              indent.writeln('const $elementTypeName* data = self->$fieldName;');
-              indent.writeScoped('for (size_t i = 0; i < len; i++) {', '}', () {
-                indent.writeScoped('if (i > 0) {', '}', () {
-                  indent.writeln('g_string_append(str, ", ");');
-                });
-                if (field.type.baseName == 'Int64List') {
-                  indent.writeln('g_string_append_printf(str, "%" G_GINT64_FORMAT, data[i]);');
-                } else if (field.type.baseName == 'Float32List' ||
-                    field.type.baseName == 'Float64List') {
-                  indent.writeln('g_string_append_printf(str, "%g", data[i]);');
-                } else {
-                  indent.writeln('g_string_append_printf(str, "%d", static_cast<int>(data[i]));');
-                }
-              });
-              indent.writeln('g_string_append(str, "]");');
-            },
-          );
-        } else if (field.type.baseName == 'bool') {
-          if (field.type.isNullable) {
-            _writeAppendValueOrNull(
-              indent,
-              fieldName: fieldName,
-              nonNullBuilder: () {
-                indent.writeln('g_string_append(str, *self->$fieldName ? "true" : "false");');
-              },
+              'fl_value_append_take(self->columns, $newFunction($fieldName, length));',
             );
-          } else {
-            indent.writeln('g_string_append(str, self->$fieldName ? "true" : "false");');
           }
-        } else if (field.type.baseName == 'int') {
-          if (field.type.isNullable) {
-            _writeAppendValueOrNull(
-              indent,
-              fieldName: fieldName,
-              nonNullBuilder: () {
-                indent.writeln(
-                  'g_string_append_printf(str, "%" G_GINT64_FORMAT, *self->$fieldName);',
+        }
+        indent.writeln('return self;');
+      },
+    );
+
+    indent.newln();
+    indent.writeScoped(
+      'static $columnsClassName* G_GNUC_UNUSED ${methodPrefix}_new_from_list(FlValue* columns) {',
+      '}',
+      () {
+        _writeObjectNew(indent, module, columnsName);
+        indent.writeln('self->columns = fl_value_ref(columns);');
+        indent.writeln('return self;');
+      },
+    );
+
+    indent.newln();
+    indent.writeScoped(
+      'static FlValue* G_GNUC_UNUSED ${methodPrefix}_get_list($columnsClassName* self) {',
+      '}',
+      () {
+        indent.writeln('return self->columns;');
+      },
+    );
+
+    indent.newln();
+    indent.writeScoped(
+      'size_t ${methodPrefix}_get_length($columnsClassName* self) {',
+      '}',
+      () {
+        indent.writeln('g_return_val_if_fail($testMacro(self), 0);');
+        indent.writeln('return fl_value_get_length(fl_value_get_list_value(self->columns, 0));');
+      },
+    );
+
+    for (var i = 0; i < classDefinition.fields.length; i++) {
+      final NamedType field = classDefinition.fields[i];
+      final String fieldName = _getFieldName(field.name);
+      final bool isString = field.type.baseName == 'String';
+      final getterArgs = <String>['$columnsClassName* self', if (isString) 'size_t index'];
+
+      indent.newln();
+      indent.writeScoped(
+        "${_getColumnType(field.type, isElementType: isString)} ${methodPrefix}_get_$fieldName(${getterArgs.join(', ')}) {",
+        '}',
+        () {
+          indent.writeln('g_return_val_if_fail($testMacro(self), nullptr);');
+          indent.writeln('FlValue* column = fl_value_get_list_value(self->columns, $i);');
+          final String value = switch (field.type.baseName) {
+            'bool' => 'fl_value_get_uint8_list(column)',
+            'int' => 'fl_value_get_int64_list(column)',
+            'double' => 'fl_value_get_float_list(column)',
+            _ => 'fl_value_get_string(fl_value_get_list_value(column, index))',
+          };
+          indent.writeln('return $value;');
+        },
+      );
+    }
+  }
+
+  // Writes the abstract parent type of the subclasses of sealed class
+  // [classDefinition].
+  void _writeSealedClass(Indent indent, String module, Class classDefinition) {
+    final String className = _getClassName(module, classDefinition.name);
+    final String methodPrefix = _getMethodPrefix(module, classDefinition.name);
+    final String upperModule = _snakeCaseFromCamelCase(module).toUpperCase();
+
+    indent.newln();
+    indent.writeln('G_DEFINE_ABSTRACT_TYPE($className, $methodPrefix, G_TYPE_OBJECT)');
+
+    indent.newln();
+    _writeInit(indent, module, classDefinition.name, () {});
+
+    indent.newln();
+    _writeClassInit(indent, module, classDefinition.name, () {}, hasDispose: false);
+
+    // Values are encoded with the type id of their subclass.
+    indent.newln();
+    indent.writeScoped(
+      'static int G_GNUC_UNUSED ${methodPrefix}_get_custom_type_id($className* value) {',
+      '}',
+      () {
+        for (final Class child in classDefinition.children) {
+          final String testMacro =
+              '${upperModule}_IS_${_snakeCaseFromCamelCase(child.name).toUpperCase()}';
+          indent.writeScoped('if ($testMacro(value)) {', '}', () {
+            indent.writeln('return ${_getMethodPrefix(module, child.name)}_type_id;');
+          });
+        }
+        indent.writeln('g_return_val_if_reached(-1);');
+      },
+    );
+  }
+
+  // Writes the conversion of the FlValue in [valueVariableName] to a local
+  // variable for [field]. Object and FlValue values are referenced, so they
+  // can be passed to a constructor that takes ownership of them.
+  void _writeFieldFromFlValue(
+    String module,
+    Indent indent,
+    NamedType field,
+    String valueVariableName,
+  ) {
+    final String fieldName = _getFieldName(field.name);
+    final String fieldType = _getType(module, field.type);
+    final String fieldValue;
+    if (field.type.isClass) {
+      final String castMacro = _getClassCastMacro(module, field.type.baseName);
+      fieldValue =
+          '$castMacro(g_object_ref(fl_value_get_custom_value_object($valueVariableName)))';
+    } else if (_isFlValueWrappedType(field.type)) {
+      fieldValue = 'fl_value_ref($valueVariableName)';
+    } else {
+      fieldValue = _fromFlValue(module, field.type, valueVariableName);
+    }
+    if (_isNullablePrimitiveType(field.type)) {
+      indent.writeln('$fieldType $fieldName = nullptr;');
+      indent.writeln(
+        '${_getType(module, field.type, isOutput: true, primitive: true)} ${fieldName}_value;',
+      );
+      indent.writeScoped(
+        'if (fl_value_get_type($valueVariableName) != FL_VALUE_TYPE_NULL) {',
+        '}',
+        () {
+          indent.writeln('${fieldName}_value = $fieldValue;');
+          indent.writeln('$fieldName = &${fieldName}_value;');
+        },
+      );
+    } else if (field.type.isNullable) {
+      indent.writeln('$fieldType $fieldName = nullptr;');
+      indent.writeScoped(
+        'if (fl_value_get_type($valueVariableName) != FL_VALUE_TYPE_NULL) {',
+        '}',
+        () {
+          indent.writeln('$fieldName = $fieldValue;');
+        },
+      );
+    } else {
+      indent.writeln('$fieldType $fieldName = $fieldValue;');
+    }
+  }
+
+  // Writes the assignment of the constructor arguments to the fields of a new
+  // data class object in `self`.
+  //
+  // If [useGBytes] is true, typed data arguments are a `GBytes` that is owned
+  // by the object. If [takeOwnership] is true, the object takes ownership of
+  // the other arguments instead of copying them.
+  void _writeConstructorFields(
+    String module,
+    Indent indent,
+    Class classDefinition, {
+    bool useGBytes = false,
+    bool takeOwnership = false,
+  }) {
+    for (final NamedType field in classDefinition.fields) {
+      final String fieldName = _getFieldName(field.name);
+      if (useGBytes && _isNumericListType(field.type)) {
+        final String elementType = _getType(module, field.type, isElementType: true);
+        indent.writeScoped('if ($fieldName != nullptr) {', '}', () {
+          indent.writeln('self->${fieldName}_bytes = $fieldName;');
+          indent.writeln(
+            'self->$fieldName = static_cast<const $elementType*>(g_bytes_get_data($fieldName, nullptr));',
+          );
+          indent.writeln(
+            'self->${fieldName}_length = g_bytes_get_size($fieldName) / sizeof($elementType);',
+          );
+        });
+        indent.writeScoped('else {', '}', () {
+          indent.writeln('self->${fieldName}_bytes = nullptr;');
+          indent.writeln('self->$fieldName = nullptr;');
+          indent.writeln('self->${fieldName}_length = 0;');
+        });
+        continue;
+      }
+      final String value = takeOwnership
+          ? fieldName
+          : _referenceValue(
+              module,
+              field.type,
+              fieldName,
+              lengthVariableName: '${fieldName}_length',
+            );
+
+      if (_isNullablePrimitiveType(field.type)) {
+        indent.writeScoped('if ($value != nullptr) {', '}', () {
+          indent.writeln('self->$fieldName = *$value;');
+          indent.writeln('self->${_getPresenceName(fieldName)} = TRUE;');
+        });
+        indent.writeScoped('else {', '}', () {
+          indent.writeln('self->${_getPresenceName(fieldName)} = FALSE;');
+        });
+      } else if (field.type.isNullable && (!takeOwnership || _isNumericListType(field.type))) {
+        // A value that is taken is stored as it is, null or not.
+        indent.writeScoped('if ($fieldName != nullptr) {', '}', () {
+          indent.writeln('self->$fieldName = $value;');
+          if (_isNumericListType(field.type)) {
+            indent.writeln('self->${fieldName}_length = ${fieldName}_length;');
+          }
+        });
+        indent.writeScoped('else {', '}', () {
+          indent.writeln('self->$fieldName = nullptr;');
+          if (_isNumericListType(field.type)) {
+            indent.writeln('self->${fieldName}_length = 0;');
+          }
+        });
+      } else {
+        indent.writeln('self->$fieldName = $value;');
+        if (_isNumericListType(field.type)) {
+          indent.writeln('self->${fieldName}_length = ${fieldName}_length;');
+        }
+      }
+    }
+  }
+
+  // Writes a constructor that takes ownership of a `GBytes` for each typed
+  // data field, and of the other values, rather than copying the data.
+  void _writeNewWithBytes(String module, Indent indent, Class classDefinition) {
+    final String className = _getClassName(module, classDefinition.name);
+    final String methodPrefix = _getMethodPrefix(module, classDefinition.name);
+    final args = <String>[];
+    for (final NamedType field in classDefinition.fields) {
+      final String fieldName = _getFieldName(field.name);
+      args.add(
+        _isNumericListType(field.type)
+            ? 'GBytes* $fieldName'
+            : '${_getType(module, field.type, isOutput: true)} $fieldName',
+      );
+    }
+    indent.newln();
+    indent.writeScoped(
+      "static $className* ${methodPrefix}_new_with_bytes(${args.join(', ')}) {",
+      '}',
+      () {
+        _writeObjectNew(indent, module, classDefinition.name);
+        _writeConstructorFields(
+          module,
+          indent,
+          classDefinition,
+          useGBytes: true,
+          takeOwnership: true,
+        );
+        indent.writeln('return self;');
+      },
+    );
+  }
+
+  void _writeClassEquality(
+    InternalGObjectOptions generatorOptions,
+    Root root,
+    Indent indent,
+    Class classDefinition, {
+    required String dartPackageName,
+  }) {
+    final String module = _getModule(generatorOptions, dartPackageName);
+    final String snakeModule = _snakeCaseFromCamelCase(module);
+    final String className = _getClassName(module, classDefinition.name);
+    final String snakeClassName = _snakeCaseFromCamelCase(classDefinition.name);
+
+    final String methodPrefix = _getMethodPrefix(module, classDefinition.name);
+    final String testMacro = '${snakeModule}_IS_$snakeClassName'.toUpperCase();
+
+    indent.newln();
+    indent.writeScoped('gboolean ${methodPrefix}_equals($className* a, $className* b) {', '}', () {
+      indent.writeScoped('if (a == b) {', '}', () {
+        indent.writeln('return TRUE;');
+      });
+      indent.writeScoped('if (a == nullptr || b == nullptr) {', '}', () {
+        indent.writeln('return FALSE;');
+      });
+      indent.writeln('// Objects with different hash codes are not equal.');
+      indent.writeScoped(
+        'if (g_atomic_int_get(&a->${classMemberNamePrefix}hash_set) && g_atomic_int_get(&b->${classMemberNamePrefix}hash_set) && a->${classMemberNamePrefix}hash != b->${classMemberNamePrefix}hash) {',
+        '}',
+        () {
+          indent.writeln('return FALSE;');
+        },
+      );
+      for (final NamedType field in classDefinition.fields) {
+        final String fieldName = _getFieldName(field.name);
+        if (field.type.isClass) {
+          final String fieldMethodPrefix = _getMethodPrefix(module, field.type.baseName);
+          indent.writeScoped(
+            'if (!${fieldMethodPrefix}_equals(a->$fieldName, b->$fieldName)) {',
+            '}',
+            () {
+              indent.writeln('return FALSE;');
+            },
+          );
+        } else if (field.type.isEnum) {
+          if (field.type.isNullable) {
+            final String presenceName = _getPresenceName(fieldName);
+            indent.writeScoped('if (a->$presenceName != b->$presenceName) {', '}', () {
+              indent.writeln('return FALSE;');
+            });
+            indent.writeScoped(
+              'if (a->$presenceName && a->$fieldName != b->$fieldName) {',
+              '}',
+              () {
+                indent.writeln('return FALSE;');
+              },
+            );
+          } else {
+            indent.writeScoped('if (a->$fieldName != b->$fieldName) {', '}', () {
+              indent.writeln('return FALSE;');
+            });
+          }
+        } else if (_isNumericListType(field.type)) {
+          // In GBytes mode empty data may have a null pointer, so the GBytes
+          // is what determines if the value is null.
+          final presenceName = generatorOptions.typedDataAsGBytes
+              ? '${fieldName}_bytes'
+              : fieldName;
+          indent.writeScoped('if (a->$presenceName != b->$presenceName) {', '}', () {
+            indent.writeScoped(
+              'if (a->$presenceName == nullptr || b->$presenceName == nullptr) {',
+              '}',
+              () {
+                indent.writeln('return FALSE;');
+              },
+            );
+            indent.writeScoped('if (a->${fieldName}_length != b->${fieldName}_length) {', '}', () {
+              indent.writeln('return FALSE;');
+            });
+            if (field.type.baseName == 'Float32List' || field.type.baseName == 'Float64List') {
+              indent.writeScoped('for (size_t i = 0; i < a->${fieldName}_length; i++) {', '}', () {
+                indent.writeScoped(
+                  'if (!flpigeon_equals_double(a->$fieldName[i], b->$fieldName[i])) {',
+                  '}',
+                  () {
+                    indent.writeln('return FALSE;');
+                  },
                 );
+              });
+            } else {
+              final elementSize = field.type.baseName == 'Uint8List'
+                  ? 'sizeof(uint8_t)'
+                  : field.type.baseName == 'Int32List'
+                  ? 'sizeof(int32_t)'
+                  : 'sizeof(int64_t)';
+              indent.writeScoped(
+                'if (memcmp(a->$fieldName, b->$fieldName, a->${fieldName}_length * $elementSize) != 0) {',
+                '}',
+                () {
+                  indent.writeln('return FALSE;');
+                },
+              );
+            }
+          });
+        } else if (field.type.baseName == 'bool' || field.type.baseName == 'int') {
+          if (field.type.isNullable) {
+            final String presenceName = _getPresenceName(fieldName);
+            indent.writeScoped('if (a->$presenceName != b->$presenceName) {', '}', () {
+              indent.writeln('return FALSE;');
+            });
+            indent.writeScoped(
+              'if (a->$presenceName && a->$fieldName != b->$fieldName) {',
+              '}',
+              () {
+                indent.writeln('return FALSE;');
               },
             );
           } else {
-            indent.writeln('g_string_append_printf(str, "%" G_GINT64_FORMAT, self->$fieldName);');
+            indent.writeScoped('if (a->$fieldName != b->$fieldName) {', '}', () {
+              indent.writeln('return FALSE;');
+            });
           }
         } else if (field.type.baseName == 'double') {
           if (field.type.isNullable) {
-            _writeAppendValueOrNull(
-              indent,
-              fieldName: fieldName,
-              nonNullBuilder: () {
-                indent.writeln('g_string_append_printf(str, "%g", *self->$fieldName);');
+            final String presenceName = _getPresenceName(fieldName);
+            indent.writeScoped('if (a->$presenceName != b->$presenceName) {', '}', () {
+              indent.writeln('return FALSE;');
+            });
+            indent.writeScoped(
+              'if (a->$presenceName && !flpigeon_equals_double(a->$fieldName, b->$fieldName)) {',
+              '}',
+              () {
+                indent.writeln('return FALSE;');
               },
             );
           } else {
-            indent.writeln('g_string_append_printf(str, "%g", self->$fieldName);');
+            indent.writeScoped(
+              'if (!flpigeon_equals_double(a->$fieldName, b->$fieldName)) {',
+              '}',
+              () {
+                indent.writeln('return FALSE;');
+              },
+            );
           }
+        } else if (field.type.baseName == 'String') {
+          indent.writeScoped('if (g_strcmp0(a->$fieldName, b->$fieldName) != 0) {', '}', () {
+            indent.writeln('return FALSE;');
+          });
         } else {
-          _writeAppendValueOrNull(
-            indent,
-            fieldName: fieldName,
-            nonNullBuilder: () {
-              indent.writeln('gchar* val_str = flpigeon_to_string(self->$fieldName);');
-              indent.writeln('g_string_append(str, val_str);');
-              indent.writeln('g_free(val_str);');
-            },
+          indent.writeScoped('if (!flpigeon_deep_equals(a->$fieldName, b->$fieldName)) {', '}', () {
+            indent.writeln('return FALSE;');
+          });
+        }
+      }
+      indent.writeln('return TRUE;');
+    });
+
+    indent.newln();
+    indent.writeScoped('guint ${methodPrefix}_hash($className* self) {', '}', () {
+      indent.writeln('g_return_val_if_fail($testMacro(self), 0);');
+      indent.writeScoped('if (g_atomic_int_get(&self->${classMemberNamePrefix}hash_set)) {', '}', () {
+        indent.writeln('return self->${classMemberNamePrefix}hash;');
+      });
+      indent.writeln('guint result = 0;');
+      for (final NamedType field in classDefinition.fields) {
+        final String fieldName = _getFieldName(field.name);
+        if (field.type.isClass) {
+          final String fieldMethodPrefix = _getMethodPrefix(module, field.type.baseName);
+          indent.writeln('result = result * 31 + ${fieldMethodPrefix}_hash(self->$fieldName);');
+        } else if (field.type.isEnum) {
+          if (field.type.isNullable) {
+            indent.writeln(
+              'result = result * 31 + (self->${_getPresenceName(fieldName)} ? static_cast<guint>(self->$fieldName) : 0);',
+            );
+          } else {
+            indent.writeln('result = result * 31 + static_cast<guint>(self->$fieldName);');
+          }
+        } else if (_isNumericListType(field.type)) {
+          indent.writeScoped('{', '}', () {
+            indent.writeln('size_t len = self->${fieldName}_length;');
+            final String elementTypeName = _getType(module, field.type, isElementType: true);
+            indent.writeln('const $elementTypeName* data = self->$fieldName;');
+            indent.writeScoped('if (data != nullptr) {', '}', () {
+              indent.writeScoped('for (size_t i = 0; i < len; i++) {', '}', () {
+                if (field.type.baseName == 'Int64List') {
+                  indent.writeln(
+                    'result = result * 31 + static_cast<guint>(data[i] ^ (data[i] >> 32));',
+                  );
+                } else if (field.type.baseName == 'Float32List' ||
+                    field.type.baseName == 'Float64List') {
+                  indent.writeln('result = result * 31 + flpigeon_hash_double(data[i]);');
+                } else {
+                  indent.writeln('result = result * 31 + static_cast<guint>(data[i]);');
+                }
+              });
+            });
+          });
+        } else if (field.type.baseName == 'bool' || field.type.baseName == 'int') {
+          if (field.type.isNullable) {
+            indent.writeln(
+              'result = result * 31 + (self->${_getPresenceName(fieldName)} ? static_cast<guint>(self->$fieldName) : 0);',
+            );
+          } else {
+            indent.writeln('result = result * 31 + static_cast<guint>(self->$fieldName);');
+          }
+        } else if (field.type.baseName == 'double') {
+          if (field.type.isNullable) {
+            indent.writeln(
+              'result = result * 31 + (self->${_getPresenceName(fieldName)} ? flpigeon_hash_double(self->$fieldName) : 0);',
+            );
+          } else {
+            indent.writeln('result = result * 31 + flpigeon_hash_double(self->$fieldName);');
+          }
+        } else if (field.type.baseName == 'String') {
+          indent.writeln(
+            'result = result * 31 + (self->$fieldName != nullptr ? g_str_hash(self->$fieldName) : 0);',
+          );
+        } else {
+          indent.writeln('result = result * 31 + flpigeon_deep_hash(self->$fieldName);');
+        }
+      }
+      indent.writeln('self->${classMemberNamePrefix}hash = result;');
+      indent.writeln('g_atomic_int_set(&self->${classMemberNamePrefix}hash_set, TRUE);');
+      indent.writeln('return result;');
+    });
+
+    indent.newln();
+    indent.writeScoped('gchar* ${methodPrefix}_to_string($className* self) {', '}', () {
+      indent.writeln('g_return_val_if_fail($testMacro(self), NULL);');
+      indent.writeln('GString* str = g_string_new("${classDefinition.name}(");');
+
+      enumerate(classDefinition.fields, (int index, NamedType field) {
+        final String fieldName = _getFieldName(field.name);
+        final comma = index == 0 ? '' : ', ';
+        indent.writeln('g_string_append(str, "$comma${_getFieldName(field.name)}: ");');
+
+        if (field.type.isClass) {
+          final String fieldMethodPrefix = _getMethodPrefix(module, field.type.baseName);
+          _writeAppendValueOrNull(
+            indent,
+            fieldName: fieldName,
+            nonNullBuilder: () {
+              indent.writeln(
+                'gchar* field_str = ${fieldMethodPrefix}_to_string(self->$fieldName);',
+              );
+              indent.writeln('g_string_append(str, field_str);');
+              indent.writeln('g_free(field_str);');
+            },
+          );
+        } else if (field.type.baseName == 'String') {
+          _writeAppendValueOrNull(
+            indent,
+            fieldName: fieldName,
+            nonNullBuilder: () {
+              indent.writeln('g_string_append_printf(str, "\\"%s\\"", self->$fieldName);');
+            },
+          );
+        } else if (field.type.isEnum) {
+          if (field.type.isNullable) {
+            _writeAppendValueOrNull(
+              indent,
+              fieldName: fieldName,
+              isInline: true,
+              nonNullBuilder: () {
+                indent.writeln(
+                  'g_string_append_printf(str, "%d", static_cast<int>(self->$fieldName));',
+                );
+              },
+            );
+          } else {
+            indent.writeln(
+              'g_string_append_printf(str, "%d", static_cast<int>(self->$fieldName));',
+            );
+          }
+        } else if (_isNumericListType(field.type)) {
+          _writeAppendValueOrNull(
+            indent,
+            fieldName: generatorOptions.typedDataAsGBytes ? '${fieldName}_bytes' : fieldName,
+            nonNullBuilder: () {
+              indent.writeln('g_string_append(str, "[");');
+              indent.writeln('size_t len = self->${fieldName}_length;');
+              final String elementTypeName = _getType(module, field.type, isElementType: true);
+              indent.writeln('const $elementTypeName* data = self->$fieldName;');
+              indent.writeScoped('for (size_t i = 0; i < len; i++) {', '}', () {
+                indent.writeScoped('if (i > 0) {', '}', () {
+                  indent.writeln('g_string_append(str, ", ");');
+                });
+                if (field.type.baseName == 'Int64List') {
+                  indent.writeln('g_string_append_printf(str, "%" G_GINT64_FORMAT, data[i]);');
+                } else if (field.type.baseName == 'Float32List' ||
+                    field.type.baseName == 'Float64List') {
+                  indent.writeln('g_string_append_printf(str, "%g", data[i]);');
+                } else {
+                  indent.writeln('g_string_append_printf(str, "%d", static_cast<int>(data[i]));');
+                }
+              });
+              indent.writeln('g_string_append(str, "]");');
+            },
+          );
+        } else if (field.type.baseName == 'bool') {
+          if (field.type.isNullable) {
+            _writeAppendValueOrNull(
+              indent,
+              fieldName: fieldName,
+              isInline: true,
+              nonNullBuilder: () {
+                indent.writeln('g_string_append(str, self->$fieldName ? "true" : "false");');
+              },
+            );
+          } else {
+            indent.writeln('g_string_append(str, self->$fieldName ? "true" : "false");');
+          }
+        } else if (field.type.baseName == 'int') {
+          if (field.type.isNullable) {
+            _writeAppendValueOrNull(
+              indent,
+              fieldName: fieldName,
+              isInline: true,
+              nonNullBuilder: () {
+                indent.writeln(
+                  'g_string_append_printf(str, "%" G_GINT64_FORMAT, self->$fieldName);',
+                );
+              },
+            );
+          } else {
+            indent.writeln('g_string_append_printf(str, "%" G_GINT64_FORMAT, self->$fieldName);');
+          }
+        } else if (field.type.baseName == 'double') {
+          if (field.type.isNullable) {
+            _writeAppendValueOrNull(
+              indent,
+              fieldName: fieldName,
+              isInline: true,
+              nonNullBuilder: () {
+                indent.writeln('g_string_append_printf(str, "%g", self->$fieldName);');
+              },
+            );
+          } else {
+            indent.writeln('g_string_append_printf(str, "%g", self->$fieldName);');
+          }
+        } else {
+          _writeAppendValueOrNull(
+            indent,
+            fieldName: fieldName,
+            nonNullBuilder: () {
+              indent.writeln('gchar* val_str = flpigeon_to_string(self->$fieldName);');
+              indent.writeln('g_string_append(str, val_str);');
+              indent.writeln('g_free(val_str);');
+            },
+          );
+        }
+      });
+
+      indent.writeln('g_string_append(str, ")");');
+      indent.writeln('return g_string_free(str, FALSE);');
+    });
+  }
+
+  @override
+  void writeGeneralCodec(
+    InternalGObjectOptions generatorOptions,
+    Root root,
+    Indent indent, {
+    required String dartPackageName,
+  }) {
+    final String module = _getModule(generatorOptions, dartPackageName);
+    final String codecClassName = _getClassName(module, _codecBaseName);
+    final String codecMethodPrefix = _getMethodPrefix(module, _codecBaseName);
+
+    final Iterable<EnumeratedType> customTypes = getEnumeratedTypes(
+      root,
+      excludeSealedClasses: true,
+    );
+    final bool hasProxyApis = root.apis.any((Api api) => api is AstProxyApi);
+    final String instanceManagerClassName = _getClassName(module, _instanceManagerBaseName);
+    final String instanceManagerMethodPrefix = _getMethodPrefix(module, _instanceManagerBaseName);
+    final String instanceManagerTypeId = _getInstanceManagerTypeId(module);
+
+    indent.newln();
+    _writeObjectStruct(indent, module, _codecBaseName, () {
+      if (hasProxyApis) {
+        indent.writeln('// Instance manager used to encode and decode ProxyApi instances.');
+        indent.writeln('$instanceManagerClassName* instance_manager;');
+      }
+    }, parentClassName: _standardCodecName);
+
+    indent.newln();
+    _writeDefineType(
+      indent,
+      module,
+      _codecBaseName,
+      parentType: 'fl_standard_message_codec_get_type()',
+    );
+
+    indent.newln();
+    for (final customType in customTypes) {
+      final String customTypeId = _getCustomTypeId(module, customType);
+      indent.writeln('const int $customTypeId = ${customType.enumeration};');
+    }
+
+    // Data classes are written field by field, so a class that has a field of
+    // a class written later in the file needs that writer declared up front.
+    final writtenClasses = <String>{};
+    final forwardDeclaredClasses = <String>{};
+    for (final customType in customTypes) {
+      if (customType.type != CustomTypes.customClass) {
+        continue;
+      }
+      writtenClasses.add(customType.name);
+      final Class classDefinition = customType.associatedClass!;
+      for (final NamedType field in classDefinition.fields) {
+        if (field.type.isClass && !writtenClasses.contains(field.type.baseName)) {
+          forwardDeclaredClasses.add(field.type.baseName);
+        }
+      }
+    }
+    for (final customType in customTypes) {
+      if (forwardDeclaredClasses.contains(customType.name)) {
+        final String customTypeName = _getClassName(module, customType.name);
+        final String snakeCustomTypeName = _snakeCaseFromCamelCase(customTypeName);
+        indent.newln();
+        indent.writeln(
+          'static gboolean ${codecMethodPrefix}_write_$snakeCustomTypeName($_standardCodecName* codec, GByteArray* buffer, $customTypeName* value, GError** error);',
+        );
+      }
+    }
+
+    for (final customType in customTypes) {
+      final String customTypeName = _getClassName(module, customType.name);
+      final String snakeCustomTypeName = _snakeCaseFromCamelCase(customTypeName);
+      final String customTypeId = _getCustomTypeId(module, customType);
+
+      indent.newln();
+      final valueType = customType.type == CustomTypes.customClass
+          ? '$customTypeName*'
+          : 'FlValue*';
+      indent.writeScoped(
+        'static gboolean ${codecMethodPrefix}_write_$snakeCustomTypeName($_standardCodecName* codec, GByteArray* buffer, $valueType value, GError** error) {',
+        '}',
+        () {
+          indent.writeln('uint8_t type = $customTypeId;');
+          indent.writeln('g_byte_array_append(buffer, &type, sizeof(uint8_t));');
+          if (customType.type == CustomTypes.customClass) {
+            _writeClassFieldsEncoder(
+              generatorOptions,
+              root,
+              indent,
+              module,
+              codecMethodPrefix,
+              customType.associatedClass!,
+            );
+          } else if (customType.type == CustomTypes.customEnum) {
+            indent.writeln(
+              'return fl_standard_message_codec_write_value(codec, buffer, value, error);',
+            );
+          }
+        },
+      );
+    }
+
+    if (hasProxyApis) {
+      indent.newln();
+      indent.writeScoped(
+        'static gboolean ${codecMethodPrefix}_write_instance($_standardCodecName* codec, GByteArray* buffer, GObject* instance, GError** error) {',
+        '}',
+        () {
+          _writeCastSelf(indent, module, _codecBaseName, 'codec');
+          indent.writeln('int64_t identifier;');
+          indent.writeScoped(
+            'if (self->instance_manager == nullptr || !${instanceManagerMethodPrefix}_get_identifier(self->instance_manager, instance, &identifier)) {',
+            '}',
+            () {
+              indent.writeln(
+                'g_set_error(error, FL_MESSAGE_CODEC_ERROR, FL_MESSAGE_CODEC_ERROR_FAILED, "Instance of %s is not in the instance manager", G_OBJECT_TYPE_NAME(instance));',
+              );
+              indent.writeln('return FALSE;');
+            },
+          );
+          indent.newln();
+          indent.writeln('uint8_t type = $instanceManagerTypeId;');
+          indent.writeln('g_byte_array_append(buffer, &type, sizeof(uint8_t));');
+          indent.writeln('g_autoptr(FlValue) value = fl_value_new_int(identifier);');
+          indent.writeln(
+            'return fl_standard_message_codec_write_value(codec, buffer, value, error);',
+          );
+        },
+      );
+    }
+
+    indent.newln();
+    indent.writeScoped(
+      'static gboolean ${codecMethodPrefix}_write_value($_standardCodecName* codec, GByteArray* buffer, FlValue* value, GError** error) {',
+      '}',
+      () {
+        indent.writeScoped('if (fl_value_get_type(value) == FL_VALUE_TYPE_CUSTOM) {', '}', () {
+          indent.writeScoped('switch (fl_value_get_custom_type(value)) {', '}', () {
+            if (hasProxyApis) {
+              indent.writeln('case $instanceManagerTypeId:');
+              indent.nest(1, () {
+                indent.writeln(
+                  'return ${codecMethodPrefix}_write_instance(codec, buffer, fl_value_get_custom_value_object(value), error);',
+                );
+              });
+            }
+            for (final customType in customTypes) {
+              final String customTypeId = _getCustomTypeId(module, customType);
+              indent.writeln('case $customTypeId:');
+              indent.nest(1, () {
+                final String customTypeName = _getClassName(module, customType.name);
+                final String snakeCustomTypeName = _snakeCaseFromCamelCase(customTypeName);
+                final String castMacro = _getClassCastMacro(module, customType.name);
+                if (customType.type == CustomTypes.customClass) {
+                  indent.writeln(
+                    'return ${codecMethodPrefix}_write_$snakeCustomTypeName(codec, buffer, $castMacro(fl_value_get_custom_value_object(value)), error);',
+                  );
+                } else if (customType.type == CustomTypes.customEnum) {
+                  indent.writeln(
+                    'return ${codecMethodPrefix}_write_$snakeCustomTypeName(codec, buffer, reinterpret_cast<FlValue*>(const_cast<gpointer>(fl_value_get_custom_value(value))), error);',
+                  );
+                }
+              });
+            }
+          });
+        });
+
+        indent.newln();
+        indent.writeln(
+          'return FL_STANDARD_MESSAGE_CODEC_CLASS(${codecMethodPrefix}_parent_class)->write_value(codec, buffer, value, error);',
+        );
+      },
+    );
+
+    for (final customType in customTypes) {
+      final String customTypeName = _getClassName(module, customType.name);
+      final String snakeCustomTypeName = _snakeCaseFromCamelCase(customTypeName);
+      final String customTypeId = _getCustomTypeId(module, customType);
+      indent.newln();
+      indent.writeScoped(
+        'static FlValue* ${codecMethodPrefix}_read_$snakeCustomTypeName($_standardCodecName* codec, GBytes* buffer, size_t* offset, GError** error) {',
+        '}',
+        () {
+          if (customType.type == CustomTypes.customClass) {
+            indent.writeln(
+              'g_autoptr($customTypeName) value = ${snakeCustomTypeName}_new_from_buffer(codec, buffer, offset, error);',
+            );
+            indent.writeScoped('if (value == nullptr) {', '}', () {
+              indent.writeln('return nullptr;');
+            });
+            indent.newln();
+            indent.writeln('return fl_value_new_custom_object($customTypeId, G_OBJECT(value));');
+          } else if (customType.type == CustomTypes.customEnum) {
+            indent.writeln(
+              'return fl_value_new_custom($customTypeId, fl_standard_message_codec_read_value(codec, buffer, offset, error), (GDestroyNotify)fl_value_unref);',
+            );
+          }
+        },
+      );
+    }
+
+    if (hasProxyApis) {
+      indent.newln();
+      indent.writeScoped(
+        'static FlValue* ${codecMethodPrefix}_read_instance($_standardCodecName* codec, GBytes* buffer, size_t* offset, GError** error) {',
+        '}',
+        () {
+          _writeCastSelf(indent, module, _codecBaseName, 'codec');
+          indent.writeln(
+            'g_autoptr(FlValue) identifier = fl_standard_message_codec_read_value(codec, buffer, offset, error);',
+          );
+          indent.writeScoped('if (identifier == nullptr) {', '}', () {
+            indent.writeln('return nullptr;');
+          });
+          indent.writeScoped('if (fl_value_get_type(identifier) != FL_VALUE_TYPE_INT) {', '}', () {
+            indent.writeln(
+              'g_set_error(error, FL_MESSAGE_CODEC_ERROR, FL_MESSAGE_CODEC_ERROR_FAILED, "Invalid instance identifier received");',
+            );
+            indent.writeln('return nullptr;');
+          });
+          indent.newln();
+          indent.writeln(
+            'GObject* instance = self->instance_manager != nullptr ? ${instanceManagerMethodPrefix}_get_instance(self->instance_manager, fl_value_get_int(identifier)) : nullptr;',
+          );
+          indent.writeScoped('if (instance == nullptr) {', '}', () {
+            indent.writeln(
+              'g_set_error(error, FL_MESSAGE_CODEC_ERROR, FL_MESSAGE_CODEC_ERROR_FAILED, "Failed to find instance with identifier: %" G_GINT64_FORMAT, fl_value_get_int(identifier));',
+            );
+            indent.writeln('return nullptr;');
+          });
+          indent.newln();
+          indent.writeln('return fl_value_new_custom_object_take($instanceManagerTypeId, instance);');
+        },
+      );
+    }
+
+    indent.newln();
+    indent.writeScoped(
+      'static FlValue* ${codecMethodPrefix}_read_value_of_type($_standardCodecName* codec, GBytes* buffer, size_t* offset, int type, GError** error) {',
+      '}',
+      () {
+        indent.writeScoped('switch (type) {', '}', () {
+          if (hasProxyApis) {
+            indent.writeln('case $instanceManagerTypeId:');
+            indent.nest(1, () {
+              indent.writeln(
+                'return ${codecMethodPrefix}_read_instance(codec, buffer, offset, error);',
+              );
+            });
+          }
+          for (final customType in customTypes) {
+            final String customTypeName = _getClassName(module, customType.name);
+            final String customTypeId = _getCustomTypeId(module, customType);
+            final String snakeCustomTypeName = _snakeCaseFromCamelCase(customTypeName);
+            indent.writeln('case $customTypeId:');
+            indent.nest(1, () {
+              indent.writeln(
+                'return ${codecMethodPrefix}_read_$snakeCustomTypeName(codec, buffer, offset, error);',
+              );
+            });
+          }
+
+          indent.writeln('default:');
+          indent.nest(1, () {
+            indent.writeln(
+              'return FL_STANDARD_MESSAGE_CODEC_CLASS(${codecMethodPrefix}_parent_class)->read_value_of_type(codec, buffer, offset, type, error);',
+            );
+          });
+        });
+      },
+    );
+
+    if (hasProxyApis) {
+      indent.newln();
+      _writeDispose(indent, module, _codecBaseName, () {
+        _writeCastSelf(indent, module, _codecBaseName, 'object');
+        indent.writeln('g_clear_object(&self->instance_manager);');
+      });
+    }
+
+    indent.newln();
+    _writeInit(indent, module, _codecBaseName, () {});
+
+    indent.newln();
+    _writeClassInit(indent, module, _codecBaseName, () {
+      indent.writeln(
+        'FL_STANDARD_MESSAGE_CODEC_CLASS(klass)->write_value = ${codecMethodPrefix}_write_value;',
+      );
+      indent.writeln(
+        'FL_STANDARD_MESSAGE_CODEC_CLASS(klass)->read_value_of_type = ${codecMethodPrefix}_read_value_of_type;',
+      );
+    }, hasDispose: hasProxyApis);
+
+    indent.newln();
+    indent.writeScoped('static $codecClassName* ${codecMethodPrefix}_new() {', '}', () {
+      _writeObjectNew(indent, module, _codecBaseName);
+      indent.writeln('return self;');
+    });
+
+    if (hasProxyApis) {
+      indent.newln();
+      indent.writeScoped(
+        'static $codecClassName* G_GNUC_UNUSED ${codecMethodPrefix}_new_with_instance_manager($instanceManagerClassName* instance_manager) {',
+        '}',
+        () {
+          _writeObjectNew(indent, module, _codecBaseName);
+          indent.writeln(
+            'self->instance_manager = ${_getClassCastMacro(module, _instanceManagerBaseName)}(g_object_ref(instance_manager));',
+          );
+          indent.writeln('return self;');
+        },
+      );
+    }
+  }
+
+  // Writes the fields of the data class in [value] to [buffer] as a list, in
+  // the same format FlStandardMessageCodec uses, without first converting the
+  // object to an FlValue.
+  void _writeClassFieldsEncoder(
+    InternalGObjectOptions generatorOptions,
+    Root root,
+    Indent indent,
+    String module,
+    String codecMethodPrefix,
+    Class classDefinition,
+  ) {
+    indent.writeln(
+      'flpigeon_write_list_header(codec, buffer, ${classDefinition.fields.length});',
+    );
+    for (final NamedType field in classDefinition.fields) {
+      final String fieldName = _getFieldName(field.name);
+      final fieldValue = 'value->$fieldName';
+      final TypeDeclaration type = field.type;
+
+      // Fields that are written through the codec can fail and return an error.
+      String? fallibleWrite;
+      String? infallibleWrite;
+      if (type.isClass) {
+        final String snakeClassName = _snakeCaseFromCamelCase(_getClassName(module, type.baseName));
+        fallibleWrite =
+            '${codecMethodPrefix}_write_$snakeClassName(codec, buffer, $fieldValue, error)';
+      } else if (type.isEnum) {
+        final String customTypeId = _getCustomTypeIdFromDeclaration(root, type, module);
+        infallibleWrite = 'flpigeon_write_enum(buffer, $customTypeId, $fieldValue)';
+      } else if (_isFlValueWrappedType(type)) {
+        fallibleWrite = 'fl_standard_message_codec_write_value(codec, buffer, $fieldValue, error)';
+      } else if (type.baseName == 'bool') {
+        infallibleWrite = 'flpigeon_write_bool(buffer, $fieldValue)';
+      } else if (type.baseName == 'int') {
+        infallibleWrite = 'flpigeon_write_int(buffer, $fieldValue)';
+      } else if (type.baseName == 'double') {
+        infallibleWrite = 'flpigeon_write_double(buffer, $fieldValue)';
+      } else if (type.baseName == 'String') {
+        infallibleWrite = 'flpigeon_write_string(codec, buffer, $fieldValue)';
+      } else if (_isNumericListType(type)) {
+        final String writeFunction = switch (type.baseName) {
+          'Uint8List' => 'flpigeon_write_uint8_list',
+          'Int32List' => 'flpigeon_write_int32_list',
+          'Int64List' => 'flpigeon_write_int64_list',
+          'Float32List' => 'flpigeon_write_float32_list',
+          _ => 'flpigeon_write_float_list',
+        };
+        infallibleWrite = '$writeFunction(codec, buffer, $fieldValue, ${fieldValue}_length)';
+      } else {
+        throw Exception('Unknown type ${type.baseName}');
+      }
+
+      if (type.isNullable) {
+        final String nullCondition = _isNullablePrimitiveType(type)
+            ? '!value->${_getPresenceName(fieldName)}'
+            : generatorOptions.typedDataAsGBytes && _isNumericListType(type)
+            ? '${fieldValue}_bytes == nullptr'
+            : '$fieldValue == nullptr';
+        indent.writeScoped('if ($nullCondition) {', '}', () {
+          indent.writeln('flpigeon_write_null(buffer);');
+        }, addTrailingNewline: false);
+        if (fallibleWrite != null) {
+          indent.addScoped(' else if (!$fallibleWrite) {', '}', () {
+            indent.writeln('return FALSE;');
+          });
+        } else {
+          indent.addScoped(' else {', '}', () {
+            indent.writeln('$infallibleWrite;');
+          });
+        }
+      } else if (fallibleWrite != null) {
+        indent.writeScoped('if (!$fallibleWrite) {', '}', () {
+          indent.writeln('return FALSE;');
+        });
+      } else {
+        indent.writeln('$infallibleWrite;');
+      }
+    }
+    indent.writeln('return TRUE;');
+  }
+
+  @override
+  void writeFlutterApi(
+    InternalGObjectOptions generatorOptions,
+    Root root,
+    Indent indent,
+    Api api, {
+    required String dartPackageName,
+  }) {
+    final String module = _getModule(generatorOptions, dartPackageName);
+    final String className = _getClassName(module, api.name);
+    final String methodPrefix = _getMethodPrefix(module, api.name);
+    final String codecClassName = _getClassName(module, _codecBaseName);
+    final String codecMethodPrefix = _getMethodPrefix(module, _codecBaseName);
+
+    indent.newln();
+    _writeObjectStruct(indent, module, api.name, () {
+      indent.writeln('FlBinaryMessenger* messenger;');
+      indent.writeln('gchar *suffix;');
+      indent.writeln('$codecClassName* codec;');
+      if (api.methods.isNotEmpty) {
+        indent.newln();
+        indent.writeln('// The channel of each method, created on its first call.');
+        for (final Method method in api.methods) {
+          indent.writeln('FlBasicMessageChannel* ${_getMethodName(method.name)}_channel;');
+        }
+      }
+    });
+
+    indent.newln();
+    _writeDefineType(indent, module, api.name);
+
+    indent.newln();
+    _writeDispose(indent, module, api.name, () {
+      _writeCastSelf(indent, module, api.name, 'object');
+      indent.writeln('g_clear_object(&self->messenger);');
+      indent.writeln('g_clear_pointer(&self->suffix, g_free);');
+      indent.writeln('g_clear_object(&self->codec);');
+      for (final Method method in api.methods) {
+        indent.writeln('g_clear_object(&self->${_getMethodName(method.name)}_channel);');
+      }
+    });
+
+    indent.newln();
+    _writeInit(indent, module, api.name, () {});
+
+    indent.newln();
+    _writeClassInit(indent, module, api.name, () {});
+
+    indent.newln();
+    indent.writeScoped(
+      '$className* ${methodPrefix}_new(FlBinaryMessenger* messenger, const gchar* suffix) {',
+      '}',
+      () {
+        _writeObjectNew(indent, module, api.name);
+        indent.writeln('self->messenger = FL_BINARY_MESSENGER(g_object_ref(messenger));');
+        indent.writeln(
+          'self->suffix = suffix != nullptr ? g_strdup_printf(".%s", suffix) : g_strdup("");',
+        );
+        indent.writeln('self->codec = ${codecMethodPrefix}_new();');
+        indent.writeln('return self;');
+      },
+    );
+
+    for (final Method method in api.methods) {
+      final String methodName = _getMethodName(method.name);
+      final String responseName = _getResponseName(api.name, method.name);
+      final String responseClassName = _getClassName(module, responseName);
+      final String responseMethodPrefix = _getMethodPrefix(module, responseName);
+      final channelField = 'self->${methodName}_channel';
+
+      _writeFlutterApiResponseClass(indent, module, api, method);
+
+      indent.newln();
+      indent.writeScoped(
+        'static void ${methodPrefix}_${methodName}_cb(GObject* object, GAsyncResult* result, gpointer user_data) {',
+        '}',
+        () {
+          indent.writeln('GTask* task = G_TASK(user_data);');
+          indent.writeln('g_task_return_pointer(task, result, g_object_unref);');
+        },
+      );
+
+      final asyncArgs = <String>['$className* self'];
+      for (final Parameter param in method.parameters) {
+        final String name = _snakeCaseFromCamelCase(param.name);
+        asyncArgs.add('${_getType(module, param.type)} $name');
+        if (_isNumericListType(param.type)) {
+          asyncArgs.add('size_t ${name}_length');
+        }
+      }
+      asyncArgs.addAll(<String>[
+        'GCancellable* cancellable',
+        'GAsyncReadyCallback callback',
+        'gpointer user_data',
+      ]);
+      indent.newln();
+      indent.writeScoped("void ${methodPrefix}_$methodName(${asyncArgs.join(', ')}) {", '}', () {
+        indent.writeln('g_autoptr(FlValue) args = fl_value_new_list();');
+        for (final Parameter param in method.parameters) {
+          final String name = _snakeCaseFromCamelCase(param.name);
+          final String value = _makeFlValue(
+            root,
+            module,
+            param.type,
+            name,
+            lengthVariableName: '${name}_length',
+          );
+          indent.writeln('fl_value_append_take(args, $value);');
+        }
+        final String channelName = makeChannelName(api, method, dartPackageName);
+        indent.writeScoped('if ($channelField == nullptr) {', '}', () {
+          indent.writeln(
+            'g_autofree gchar* channel_name = g_strdup_printf("$channelName%s", self->suffix);',
+          );
+          indent.writeln(
+            '$channelField = fl_basic_message_channel_new(self->messenger, channel_name, FL_MESSAGE_CODEC(self->codec));',
+          );
+        });
+        indent.writeln('GTask* task = g_task_new(self, cancellable, callback, user_data);');
+        indent.writeln('g_task_set_task_data(task, g_object_ref($channelField), g_object_unref);');
+        indent.writeln(
+          'fl_basic_message_channel_send($channelField, args, cancellable, ${methodPrefix}_${methodName}_cb, task);',
+        );
+      });
+
+      final finishArgs = <String>['$className* self', 'GAsyncResult* result', 'GError** error'];
+      indent.newln();
+      indent.writeScoped(
+        "$responseClassName* ${methodPrefix}_${methodName}_finish(${finishArgs.join(', ')}) {",
+        '}',
+        () {
+          indent.writeln('g_autoptr(GTask) task = G_TASK(result);');
+          indent.writeln(
+            'GAsyncResult* r = G_ASYNC_RESULT(g_task_propagate_pointer(task, nullptr));',
+          );
+          indent.writeln(
+            'FlBasicMessageChannel* channel = FL_BASIC_MESSAGE_CHANNEL(g_task_get_task_data(task));',
+          );
+          indent.writeln(
+            'g_autoptr(FlValue) response = fl_basic_message_channel_send_finish(channel, r, error);',
+          );
+          indent.writeScoped('if (response == nullptr) { ', '}', () {
+            indent.writeln('return nullptr;');
+          });
+          indent.writeln('return ${responseMethodPrefix}_new(response);');
+        },
+      );
+    }
+  }
+
+  // Writes the class that holds the response from Dart to [method] of [api].
+  void _writeFlutterApiResponseClass(Indent indent, String module, Api api, Method method) {
+    final String responseName = _getResponseName(api.name, method.name);
+    final String responseClassName = _getClassName(module, responseName);
+    final String responseMethodPrefix = _getMethodPrefix(module, responseName);
+    final String testResponseMacro =
+        '${_snakeCaseFromCamelCase(module)}_IS_${_snakeCaseFromCamelCase(responseName)}'
+            .toUpperCase();
+
+    indent.newln();
+    _writeObjectStruct(indent, module, responseName, () {
+      indent.writeln('FlValue* error;');
+      if (!method.returnType.isVoid) {
+        indent.writeln('FlValue* return_value;');
+        if (_isNullablePrimitiveType(method.returnType)) {
+          final String primitiveType = _getType(module, method.returnType, primitive: true);
+          indent.writeln('$primitiveType return_value_;');
+        } else if (method.returnType.isColumnar) {
+          indent.writeln('${_getType(module, method.returnType)} return_value_;');
+        }
+      }
+    });
+
+    indent.newln();
+    _writeDefineType(indent, module, responseName);
+
+    indent.newln();
+    _writeDispose(indent, module, responseName, () {
+      _writeCastSelf(indent, module, responseName, 'object');
+      indent.writeln('g_clear_pointer(&self->error, fl_value_unref);');
+      if (!method.returnType.isVoid) {
+        indent.writeln('g_clear_pointer(&self->return_value, fl_value_unref);');
+      }
+      if (method.returnType.isColumnar) {
+        indent.writeln('g_clear_object(&self->return_value_);');
+      }
+    });
+
+    indent.newln();
+    _writeInit(indent, module, responseName, () {});
+
+    indent.newln();
+    _writeClassInit(indent, module, responseName, () {});
+
+    indent.newln();
+    indent.writeScoped(
+      'static $responseClassName* ${responseMethodPrefix}_new(FlValue* response) {',
+      '}',
+      () {
+        _writeObjectNew(indent, module, responseName);
+        indent.writeScoped('if (fl_value_get_length(response) > 1) {', '}', () {
+          indent.writeln('self->error = fl_value_ref(response);');
+        });
+        if (!method.returnType.isVoid) {
+          indent.writeScoped('else {', '}', () {
+            indent.writeln('FlValue* value = fl_value_get_list_value(response, 0);');
+            indent.writeln('self->return_value = fl_value_ref(value);');
+            if (method.returnType.isColumnar) {
+              final String columnsName = _getColumnsName(method.returnType.columnarClass!);
+              indent.writeln(
+                'self->return_value_ = ${_getMethodPrefix(module, columnsName)}_new_from_list(value);',
+              );
+            }
+          });
+        }
+        indent.writeln('return self;');
+      },
+    );
+
+    indent.newln();
+    indent.writeScoped(
+      'gboolean ${responseMethodPrefix}_is_error($responseClassName* self) {',
+      '}',
+      () {
+        indent.writeln('g_return_val_if_fail($testResponseMacro(self), FALSE);');
+        indent.writeln('return self->error != nullptr;');
+      },
+    );
+
+    indent.newln();
+    indent.writeScoped(
+      'const gchar* ${responseMethodPrefix}_get_error_code($responseClassName* self) {',
+      '}',
+      () {
+        indent.writeln('g_return_val_if_fail($testResponseMacro(self), nullptr);');
+        indent.writeln('g_assert(${responseMethodPrefix}_is_error(self));');
+        indent.writeln('return fl_value_get_string(fl_value_get_list_value(self->error, 0));');
+      },
+    );
+
+    indent.newln();
+    indent.writeScoped(
+      'const gchar* ${responseMethodPrefix}_get_error_message($responseClassName* self) {',
+      '}',
+      () {
+        indent.writeln('g_return_val_if_fail($testResponseMacro(self), nullptr);');
+        indent.writeln('g_assert(${responseMethodPrefix}_is_error(self));');
+        indent.writeln('return fl_value_get_string(fl_value_get_list_value(self->error, 1));');
+      },
+    );
+
+    indent.newln();
+    indent.writeScoped(
+      'FlValue* ${responseMethodPrefix}_get_error_details($responseClassName* self) {',
+      '}',
+      () {
+        indent.writeln('g_return_val_if_fail($testResponseMacro(self), nullptr);');
+        indent.writeln('g_assert(${responseMethodPrefix}_is_error(self));');
+        indent.writeln('return fl_value_get_list_value(self->error, 2);');
+      },
+    );
+
+    if (!method.returnType.isVoid) {
+      final String primitiveType = _getType(module, method.returnType, primitive: true);
+
+      indent.newln();
+      final returnType = _isNullablePrimitiveType(method.returnType)
+          ? '$primitiveType*'
+          : primitiveType;
+      indent.writeScoped(
+        '$returnType ${responseMethodPrefix}_get_return_value($responseClassName* self${_isNumericListType(method.returnType) ? ', size_t* return_value_length' : ''}) {',
+        '}',
+        () {
+          indent.writeln(
+            'g_return_val_if_fail($testResponseMacro(self), ${_getDefaultValue(module, method.returnType)});',
+          );
+          indent.writeln('g_assert(!${responseMethodPrefix}_is_error(self));');
+          if (method.returnType.isNullable) {
+            indent.writeScoped(
+              'if (fl_value_get_type(self->return_value) == FL_VALUE_TYPE_NULL) {',
+              '}',
+              () {
+                indent.writeln('return nullptr;');
+              },
+            );
+          }
+          if (_isNumericListType(method.returnType)) {
+            indent.writeScoped('if (return_value_length != nullptr) {', '}', () {
+              indent.writeln('*return_value_length = fl_value_get_length(self->return_value);');
+            });
+          }
+          if (_isNullablePrimitiveType(method.returnType)) {
+            indent.writeln(
+              'self->return_value_ = ${_fromFlValue(module, method.returnType, 'self->return_value')};',
+            );
+            indent.writeln('return &self->return_value_;');
+          } else if (method.returnType.isColumnar) {
+            indent.writeln('return self->return_value_;');
+          } else {
+            indent.writeln(
+              'return ${_fromFlValue(module, method.returnType, 'self->return_value')};',
+            );
+          }
+        },
+      );
+    }
+  }
+
+  @override
+  void writeHostApi(
+    InternalGObjectOptions generatorOptions,
+    Root root,
+    Indent indent,
+    Api api, {
+    required String dartPackageName,
+  }) {
+    final String module = _getModule(generatorOptions, dartPackageName);
+    final String className = _getClassName(module, api.name);
+
+    final String methodPrefix = _getMethodPrefix(module, api.name);
+    final String vtableName = _getVTableName(module, api.name);
+
+    final String codecClassName = _getClassName(module, _codecBaseName);
+    final String codecMethodPrefix = _getMethodPrefix(module, _codecBaseName);
+
+    final bool hasAsyncMethod = api.methods.any((Method method) => method.isAsynchronous);
+    final bool hasBackgroundMethod = api.methods.any(
+      (Method method) => _usesTaskQueue(api, method),
+    );
+    final bool hasAsyncBackgroundMethod = api.methods.any(
+      (Method method) => method.isAsynchronous && _usesTaskQueue(api, method),
+    );
+    final bool readsChunks = api.methods.any(
+      (Method method) => method.parameters.any((Parameter param) => param.type.isChunked),
+    );
+    final bool servesChunks = api.methods.any((Method method) => method.returnType.isChunked);
+    final taskName = '${className}Task';
+    if (hasBackgroundMethod) {
+      indent.newln();
+      indent.writeln('// A message to $className that is handled on its task queue.');
+      indent.writeln('typedef struct _$taskName $taskName;');
+      indent.writeScoped('struct _$taskName {', '};', () {
+        indent.writeln('$className* api;');
+        indent.writeln('FlBinaryMessenger* messenger;');
+        indent.writeln('FlBinaryMessengerResponseHandle* response_handle;');
+        indent.writeln('GBytes* message;');
+        indent.writeln('GBytes* response;');
+        indent.writeln('void (*handler)($taskName* task, FlValue* message_);');
+      });
+    }
+    if (hasAsyncBackgroundMethod) {
+      indent.newln();
+      indent.writeln(
+        'static void ${methodPrefix}_task_respond($taskName* task, FlValue* response);',
+      );
+    }
+
+    if (hasAsyncMethod) {
+      indent.newln();
+      _writeObjectStruct(indent, module, '${api.name}ResponseHandle', () {
+        indent.writeln('FlBasicMessageChannel* channel;');
+        indent.writeln('FlBasicMessageChannelResponseHandle* response_handle;');
+        if (hasAsyncBackgroundMethod) {
+          indent.writeln('$taskName* task;');
+        }
+        if (servesChunks) {
+          indent.writeln('$className* api;');
+        }
+      });
+
+      indent.newln();
+      _writeDefineType(indent, module, '${api.name}ResponseHandle');
+
+      indent.newln();
+      _writeDispose(indent, module, '${api.name}ResponseHandle', () {
+        _writeCastSelf(indent, module, '${api.name}ResponseHandle', 'object');
+        indent.writeln('g_clear_object(&self->channel);');
+        indent.writeln('g_clear_object(&self->response_handle);');
+        if (servesChunks) {
+          indent.writeln('g_clear_object(&self->api);');
+        }
+        if (hasAsyncBackgroundMethod) {
+          // Handles dropped without a response still release the message.
+          indent.writeScoped('if (self->task != nullptr) {', '}', () {
+            indent.writeln('${methodPrefix}_task_respond(self->task, nullptr);');
+            indent.writeln('self->task = nullptr;');
+          });
+        }
+      });
+
+      indent.newln();
+      _writeInit(indent, module, '${api.name}ResponseHandle', () {});
+
+      indent.newln();
+      _writeClassInit(indent, module, '${api.name}ResponseHandle', () {});
+
+      if (api.methods.any(
+        (Method method) => method.isAsynchronous && !_usesTaskQueue(api, method),
+      )) {
+        indent.newln();
+        indent.writeScoped(
+          'static ${className}ResponseHandle* ${methodPrefix}_response_handle_new(FlBasicMessageChannel* channel, FlBasicMessageChannelResponseHandle* response_handle) {',
+          '}',
+          () {
+            _writeObjectNew(indent, module, '${api.name}ResponseHandle');
+            indent.writeln('self->channel = FL_BASIC_MESSAGE_CHANNEL(g_object_ref(channel));');
+            indent.writeln(
+              'self->response_handle = FL_BASIC_MESSAGE_CHANNEL_RESPONSE_HANDLE(g_object_ref(response_handle));',
+            );
+            indent.writeln('return self;');
+          },
+        );
+      }
+
+      if (hasAsyncBackgroundMethod) {
+        indent.newln();
+        indent.writeScoped(
+          'static ${className}ResponseHandle* ${methodPrefix}_response_handle_new_for_task($taskName* task) {',
+          '}',
+          () {
+            _writeObjectNew(indent, module, '${api.name}ResponseHandle');
+            indent.writeln('self->task = task;');
+            indent.writeln('return self;');
+          },
+        );
+      }
+    }
+
+    for (final Method method in api.methods) {
+      _writeHostApiResponseClass(root, indent, module, api, method);
+    }
+
+    indent.newln();
+    _writeObjectStruct(indent, module, api.name, () {
+      indent.writeln('const ${className}VTable* vtable;');
+      indent.writeln('gpointer user_data;');
+      indent.writeln('GDestroyNotify user_data_free_func;');
+      if (hasBackgroundMethod) {
+        indent.writeln('GThreadPool* task_queue;');
+        indent.writeln('GMainContext* context;');
+      }
+      if (readsChunks) {
+        indent.writeln('FlBinaryMessenger* messenger;');
+      }
+      if (servesChunks) {
+        indent.writeln('GHashTable* streams;');
+        indent.writeln('guint next_stream_id;');
+      }
+    });
+
+    indent.newln();
+    _writeDefineType(indent, module, api.name);
+
+    indent.newln();
+    _writeDispose(indent, module, api.name, () {
+      _writeCastSelf(indent, module, api.name, 'object');
+      if (hasBackgroundMethod) {
+        indent.writeScoped('if (self->task_queue != nullptr) {', '}', () {
+          indent.writeln('g_thread_pool_free(self->task_queue, FALSE, TRUE);');
+          indent.writeln('self->task_queue = nullptr;');
+        });
+        indent.writeln('g_clear_pointer(&self->context, g_main_context_unref);');
+      }
+      if (readsChunks) {
+        indent.writeScoped('if (self->messenger != nullptr) {', '}', () {
+          indent.writeln(
+            'g_object_remove_weak_pointer(G_OBJECT(self->messenger), reinterpret_cast<gpointer*>(&self->messenger));',
+          );
+          indent.writeln('self->messenger = nullptr;');
+        });
+      }
+      if (servesChunks) {
+        indent.writeln('g_clear_pointer(&self->streams, g_hash_table_unref);');
+      }
+      indent.writeScoped(
+        'if (self->user_data != nullptr && self->user_data_free_func != nullptr) {',
+        '}',
+        () {
+          indent.writeln('self->user_data_free_func(self->user_data);');
+        },
+      );
+      indent.writeln('self->user_data = nullptr;');
+    });
+
+    indent.newln();
+    _writeInit(indent, module, api.name, () {});
+
+    indent.newln();
+    _writeClassInit(indent, module, api.name, () {});
+
+    if (hasBackgroundMethod) {
+      _writeTaskQueueFunctions(
+        indent,
+        module,
+        api,
+        codecClassName: codecClassName,
+        codecMethodPrefix: codecMethodPrefix,
+      );
+    }
+
+    indent.newln();
+    indent.writeScoped(
+      'static $className* ${methodPrefix}_new(const $vtableName* vtable, gpointer user_data, GDestroyNotify user_data_free_func) {',
+      '}',
+      () {
+        _writeObjectNew(indent, module, api.name);
+        indent.writeln('self->vtable = vtable;');
+        indent.writeln('self->user_data = user_data;');
+        indent.writeln('self->user_data_free_func = user_data_free_func;');
+        if (hasBackgroundMethod) {
+          // A single thread keeps the queue serial.
+          indent.writeln(
+            'self->task_queue = g_thread_pool_new(${methodPrefix}_task_run, nullptr, 1, FALSE, nullptr);',
+          );
+          indent.writeln('self->context = g_main_context_ref_thread_default();');
+        }
+        if (servesChunks) {
+          // The streams returned in place of Uint8Lists, by the ID Dart reads them by.
+          indent.writeln(
+            'self->streams = g_hash_table_new_full(g_direct_hash, g_direct_equal, nullptr, g_object_unref);',
+          );
+        }
+        indent.writeln('return self;');
+      },
+    );
+
+    for (final Method method in api.methods) {
+      final String methodName = _getMethodName(method.name);
+      final String responseName = _getResponseName(api.name, method.name);
+      final String responseClassName = _getClassName(module, responseName);
+      final bool usesTaskQueue = _usesTaskQueue(api, method);
+
+      indent.newln();
+      indent.writeScoped(
+        usesTaskQueue
+            ? 'static void ${methodPrefix}_${methodName}_cb($taskName* task, FlValue* message_) {'
+            : 'static void ${methodPrefix}_${methodName}_cb(FlBasicMessageChannel* channel, FlValue* message_, FlBasicMessageChannelResponseHandle* response_handle, gpointer user_data) {',
+        '}',
+        () {
+          if (usesTaskQueue) {
+            indent.writeln('$className* self = task->api;');
+          } else {
+            _writeCastSelf(indent, module, api.name, 'user_data');
+          }
+
+          indent.newln();
+          indent.writeScoped(
+            'if (self->vtable == nullptr || self->vtable->$methodName == nullptr) {',
+            '}',
+            () {
+              if (usesTaskQueue) {
+                indent.writeln('${methodPrefix}_task_respond(task, nullptr);');
+              }
+              indent.writeln('return;');
+            },
+          );
+
+          indent.newln();
+          // Multiplexed messages carry the method index ahead of the arguments.
+          final int argumentOffset = api is AstHostApi && api.multiplexChannel ? 1 : 0;
+          final List<String> methodArgs = _writeArgsFromMessage(
+            indent,
+            module,
+            method.parameters,
+            argumentOffset: argumentOffset,
+          );
+          if (method.isAsynchronous) {
+            final vfuncArgs = <String>[];
+            vfuncArgs.addAll(methodArgs);
+            vfuncArgs.addAll(<String>['handle', 'self->user_data']);
+            indent.writeln(
+              usesTaskQueue
+                  ? 'g_autoptr(${className}ResponseHandle) handle = ${methodPrefix}_response_handle_new_for_task(task);'
+                  : 'g_autoptr(${className}ResponseHandle) handle = ${methodPrefix}_response_handle_new(channel, response_handle);',
+            );
+            if (method.returnType.isChunked) {
+              // The returned stream is kept by the API until Dart reads it.
+              indent.writeln(
+                'handle->api = ${_getClassCastMacro(module, api.name)}(g_object_ref(self));',
+              );
+            }
+            indent.writeln("self->vtable->$methodName(${vfuncArgs.join(', ')});");
+          } else {
+            final vfuncArgs = <String>[];
+            vfuncArgs.addAll(methodArgs);
+            vfuncArgs.add('self->user_data');
+            indent.writeln(
+              "g_autoptr($responseClassName) response = self->vtable->$methodName(${vfuncArgs.join(', ')});",
+            );
+            indent.writeScoped('if (response == nullptr) {', '}', () {
+              indent.writeln(
+                'g_warning("No response returned to %s.%s", "${api.name}", "${method.name}");',
+              );
+              if (usesTaskQueue) {
+                indent.writeln('${methodPrefix}_task_respond(task, nullptr);');
+              }
+              indent.writeln('return;');
+            });
+
+            indent.newln();
+            if (usesTaskQueue) {
+              indent.writeln('${methodPrefix}_task_respond(task, response->value);');
+              return;
+            }
+            indent.writeln('g_autoptr(GError) error = NULL;');
+            indent.writeScoped(
+              'if (!fl_basic_message_channel_respond(channel, response_handle, response->value, &error)) {',
+              '}',
+              () {
+                indent.writeln(
+                  'g_warning("Failed to send response to %s.%s: %s", "${api.name}", "${method.name}", error->message);',
+                );
+              },
+            );
+          }
+        },
+      );
+
+      if (usesTaskQueue) {
+        indent.newln();
+        indent.writeScoped(
+          'static void ${methodPrefix}_${methodName}_queue_cb(FlBinaryMessenger* messenger, const gchar* channel, GBytes* message, FlBinaryMessengerResponseHandle* response_handle, gpointer user_data) {',
+          '}',
+          () {
+            _writeCastSelf(indent, module, api.name, 'user_data');
+            indent.writeln(
+              '${methodPrefix}_queue_task(self, messenger, response_handle, message, ${methodPrefix}_${methodName}_cb);',
+            );
+          },
+        );
+      }
+    }
+
+    if (servesChunks) {
+      _writeChunksHandler(indent, module, api);
+    }
+
+    final bool multiplexChannel = api is AstHostApi && api.multiplexChannel;
+    if (multiplexChannel) {
+      indent.newln();
+      indent.writeScoped(
+        'static void ${methodPrefix}_respond_message_error(FlBasicMessageChannel* channel, FlBasicMessageChannelResponseHandle* response_handle, const gchar* code, const gchar* message) {',
+        '}',
+        () {
+          indent.writeln('g_autoptr(FlValue) response = fl_value_new_list();');
+          indent.writeln('fl_value_append_take(response, fl_value_new_string(code));');
+          indent.writeln('fl_value_append_take(response, fl_value_new_string(message));');
+          indent.writeln('fl_value_append_take(response, fl_value_new_null());');
+          indent.writeln('g_autoptr(GError) error = nullptr;');
+          indent.writeScoped(
+            'if (!fl_basic_message_channel_respond(channel, response_handle, response, &error)) {',
+            '}',
+            () {
+              indent.writeln(
+                'g_warning("Failed to send response to %s: %s", "${api.name}", error->message);',
+              );
+            },
+          );
+        },
+      );
+
+      indent.newln();
+      indent.writeScoped(
+        'static void ${methodPrefix}_message_cb(FlBasicMessageChannel* channel, FlValue* message_, FlBasicMessageChannelResponseHandle* response_handle, gpointer user_data) {',
+        '}',
+        () {
+          indent.writeScoped(
+            'if (fl_value_get_type(message_) != FL_VALUE_TYPE_LIST || fl_value_get_length(message_) == 0 || fl_value_get_type(fl_value_get_list_value(message_, 0)) != FL_VALUE_TYPE_INT) {',
+            '}',
+            () {
+              // The caller is still waiting for a reply, so the error is sent
+              // back rather than only logged.
+              indent.writeln(
+                '${methodPrefix}_respond_message_error(channel, response_handle, "malformed-message", "Malformed message received for ${api.name}.");',
+              );
+              indent.writeln('return;');
+            },
+          );
+
+          indent.newln();
+          indent.writeln(
+            'int64_t method_index = fl_value_get_int(fl_value_get_list_value(message_, 0));',
+          );
+          indent.writeScoped('switch (method_index) {', '}', () {
+            enumerate(api.methods, (int index, Method method) {
+              final String methodName = _getMethodName(method.name);
+              indent.writeln('case $index:');
+              indent.nest(1, () {
+                indent.writeln(
+                  '${methodPrefix}_${methodName}_cb(channel, message_, response_handle, user_data);',
+                );
+                indent.writeln('return;');
+              });
+            });
+          });
+
+          indent.newln();
+          indent.writeln(
+            'g_autofree gchar* error_message = g_strdup_printf("Unknown method index %" G_GINT64_FORMAT " received for ${api.name}.", method_index);',
+          );
+          indent.writeln(
+            '${methodPrefix}_respond_message_error(channel, response_handle, "unknown-method", error_message);',
+          );
+        },
+      );
+    }
+
+    indent.newln();
+    indent.writeScoped(
+      'void ${methodPrefix}_set_method_handlers(FlBinaryMessenger* messenger, const gchar* suffix, const $vtableName* vtable, gpointer user_data, GDestroyNotify user_data_free_func) {',
+      '}',
+      () {
+        indent.writeln(
+          'g_autofree gchar* dot_suffix = suffix != nullptr ? g_strdup_printf(".%s", suffix) : g_strdup("");',
+        );
+        indent.writeln(
+          'g_autoptr($className) api_data = ${methodPrefix}_new(vtable, user_data, user_data_free_func);',
+        );
+        if (readsChunks) {
+          // Chunked arguments are read from Dart with the messenger.
+          indent.writeln('api_data->messenger = messenger;');
+          indent.writeln(
+            'g_object_add_weak_pointer(G_OBJECT(messenger), reinterpret_cast<gpointer*>(&api_data->messenger));',
+          );
+        }
+
+        indent.newln();
+        indent.writeln('g_autoptr($codecClassName) codec = ${codecMethodPrefix}_new();');
+        if (multiplexChannel) {
+          final String channelName = makeMultiplexedChannelName(api, dartPackageName);
+          indent.writeln(
+            'g_autofree gchar* channel_name = g_strdup_printf("$channelName%s", dot_suffix);',
+          );
+          indent.writeln(
+            'g_autoptr(FlBasicMessageChannel) channel = fl_basic_message_channel_new(messenger, channel_name, FL_MESSAGE_CODEC(codec));',
+          );
+          indent.writeln(
+            'fl_basic_message_channel_set_message_handler(channel, ${methodPrefix}_message_cb, g_object_ref(api_data), g_object_unref);',
+          );
+          return;
+        }
+        for (final Method method in api.methods) {
+          final String methodName = _getMethodName(method.name);
+          final String channelName = makeChannelName(api, method, dartPackageName);
+          indent.writeln(
+            'g_autofree gchar* ${methodName}_channel_name = g_strdup_printf("$channelName%s", dot_suffix);',
+          );
+          if (_usesTaskQueue(api, method)) {
+            // Messages are decoded on the task queue, so they are received
+            // as raw bytes.
+            indent.writeln(
+              'fl_binary_messenger_set_message_handler_on_channel(messenger, ${methodName}_channel_name, ${methodPrefix}_${methodName}_queue_cb, g_object_ref(api_data), g_object_unref);',
+            );
+            continue;
+          }
+          indent.writeln(
+            'g_autoptr(FlBasicMessageChannel) ${methodName}_channel = fl_basic_message_channel_new(messenger, ${methodName}_channel_name, FL_MESSAGE_CODEC(codec));',
+          );
+          indent.writeln(
+            'fl_basic_message_channel_set_message_handler(${methodName}_channel, ${methodPrefix}_${methodName}_cb, g_object_ref(api_data), g_object_unref);',
+          );
+          if (method.returnType.isChunked) {
+            indent.writeln(
+              'g_autofree gchar* ${methodName}_chunks_channel_name = g_strdup_printf("$channelName%s$chunkChannelSuffix", dot_suffix);',
+            );
+            indent.writeln(
+              'g_autoptr(FlBasicMessageChannel) ${methodName}_chunks_channel = fl_basic_message_channel_new(messenger, ${methodName}_chunks_channel_name, FL_MESSAGE_CODEC(codec));',
+            );
+            indent.writeln(
+              'fl_basic_message_channel_set_message_handler(${methodName}_chunks_channel, ${methodPrefix}_chunks_cb, g_object_ref(api_data), g_object_unref);',
+            );
+          }
+        }
+      },
+    );
+
+    indent.newln();
+    indent.writeScoped(
+      'void ${methodPrefix}_clear_method_handlers(FlBinaryMessenger* messenger, const gchar* suffix) {',
+      '}',
+      () {
+        indent.writeln(
+          'g_autofree gchar* dot_suffix = suffix != nullptr ? g_strdup_printf(".%s", suffix) : g_strdup("");',
+        );
+
+        indent.newln();
+        indent.writeln('g_autoptr($codecClassName) codec = ${codecMethodPrefix}_new();');
+        if (multiplexChannel) {
+          final String channelName = makeMultiplexedChannelName(api, dartPackageName);
+          indent.writeln(
+            'g_autofree gchar* channel_name = g_strdup_printf("$channelName%s", dot_suffix);',
+          );
+          indent.writeln(
+            'g_autoptr(FlBasicMessageChannel) channel = fl_basic_message_channel_new(messenger, channel_name, FL_MESSAGE_CODEC(codec));',
+          );
+          indent.writeln(
+            'fl_basic_message_channel_set_message_handler(channel, nullptr, nullptr, nullptr);',
+          );
+          return;
+        }
+        for (final Method method in api.methods) {
+          final String methodName = _getMethodName(method.name);
+          final String channelName = makeChannelName(api, method, dartPackageName);
+          indent.writeln(
+            'g_autofree gchar* ${methodName}_channel_name = g_strdup_printf("$channelName%s", dot_suffix);',
+          );
+          if (_usesTaskQueue(api, method)) {
+            indent.writeln(
+              'fl_binary_messenger_set_message_handler_on_channel(messenger, ${methodName}_channel_name, nullptr, nullptr, nullptr);',
+            );
+            continue;
+          }
+          indent.writeln(
+            'g_autoptr(FlBasicMessageChannel) ${methodName}_channel = fl_basic_message_channel_new(messenger, ${methodName}_channel_name, FL_MESSAGE_CODEC(codec));',
+          );
+          indent.writeln(
+            'fl_basic_message_channel_set_message_handler(${methodName}_channel, nullptr, nullptr, nullptr);',
+          );
+          if (method.returnType.isChunked) {
+            indent.writeln(
+              'g_autofree gchar* ${methodName}_chunks_channel_name = g_strdup_printf("$channelName%s$chunkChannelSuffix", dot_suffix);',
+            );
+            indent.writeln(
+              'g_autoptr(FlBasicMessageChannel) ${methodName}_chunks_channel = fl_basic_message_channel_new(messenger, ${methodName}_chunks_channel_name, FL_MESSAGE_CODEC(codec));',
+            );
+            indent.writeln(
+              'fl_basic_message_channel_set_message_handler(${methodName}_chunks_channel, nullptr, nullptr, nullptr);',
+            );
+          }
+        }
+      },
+    );
+
+    for (final Method method in api.methods.where((Method method) => method.isAsynchronous)) {
+      final String returnType = _getType(module, method.returnType);
+      final String methodName = _getMethodName(method.name);
+      final String responseName = _getResponseName(api.name, method.name);
+      final String responseClassName = _getClassName(module, responseName);
+      final String responseMethodPrefix = _getMethodPrefix(module, responseName);
+
+      void writeRespond() {
+        if (_usesTaskQueue(api, method)) {
+          indent.writeln('${methodPrefix}_task_respond(response_handle->task, response->value);');
+          indent.writeln('response_handle->task = nullptr;');
+          return;
+        }
+        indent.writeln('g_autoptr(GError) error = nullptr;');
+        indent.writeScoped(
+          'if (!fl_basic_message_channel_respond(response_handle->channel, response_handle->response_handle, response->value, &error)) {',
+          '}',
+          () {
+            indent.writeln(
+              'g_warning("Failed to send response to %s.%s: %s", "${api.name}", "${method.name}", error->message);',
+            );
+          },
+        );
+      }
+
+      indent.newln();
+      final respondArgs = <String>[
+        '${className}ResponseHandle* response_handle',
+        if (returnType != 'void') '$returnType return_value',
+        if (_isNumericListType(method.returnType)) 'size_t return_value_length',
+      ];
+      indent.writeScoped(
+        "void ${methodPrefix}_respond_$methodName(${respondArgs.join(', ')}) {",
+        '}',
+        () {
+          if (method.returnType.isChunked) {
+            // Dart reads the stream by this ID on the method's chunks channel.
+            indent.writeln('guint stream_id = response_handle->api->next_stream_id++;');
+            indent.writeln(
+              'g_hash_table_insert(response_handle->api->streams, GUINT_TO_POINTER(stream_id), g_object_ref(return_value));',
+            );
+          }
+          final returnArgs = <String>[
+            if (method.returnType.isChunked)
+              'stream_id'
+            else if (returnType != 'void')
+              'return_value',
+            if (_isNumericListType(method.returnType)) 'return_value_length',
+          ];
+          indent.writeln(
+            'g_autoptr($responseClassName) response = ${responseMethodPrefix}_new(${returnArgs.join(', ')});',
+          );
+          writeRespond();
+        },
+      );
+
+      indent.newln();
+      final respondErrorArgs = <String>[
+        '${className}ResponseHandle* response_handle',
+        'const gchar* code',
+        'const gchar* message',
+        'FlValue* details',
+      ];
+      indent.writeScoped(
+        "void ${methodPrefix}_respond_error_$methodName(${respondErrorArgs.join(', ')}) {",
+        '}',
+        () {
+          indent.writeln(
+            'g_autoptr($responseClassName) response = ${responseMethodPrefix}_new_error(code, message, details);',
+          );
+          writeRespond();
+        },
+      );
+    }
+  }
+
+  // Writes the handler that replies to Dart's requests for the next chunk of
+  // a stream returned by a @ChunkedBytes method of [api].
+  void _writeChunksHandler(Indent indent, String module, Api api) {
+    final String className = _getClassName(module, api.name);
+    final String methodPrefix = _getMethodPrefix(module, api.name);
+    final readName = '${className}ChunkRead';
+
+    indent.newln();
+    indent.writeln('// A request from Dart for the next chunk of a stream.');
+    indent.writeScoped('typedef struct {', '} $readName;', () {
+      indent.writeln('$className* api;');
+      indent.writeln('FlBasicMessageChannel* channel;');
+      indent.writeln('FlBasicMessageChannelResponseHandle* response_handle;');
+      indent.writeln('guint stream_id;');
+    });
+
+    indent.newln();
+    indent.writeScoped('static void ${methodPrefix}_chunk_read_free($readName* read) {', '}', () {
+      indent.writeln('g_object_unref(read->api);');
+      indent.writeln('g_object_unref(read->channel);');
+      indent.writeln('g_object_unref(read->response_handle);');
+      indent.writeln('g_free(read);');
+    });
+
+    indent.newln();
+    indent.writeScoped(
+      'static void ${methodPrefix}_chunk_read_cb(GObject* object, GAsyncResult* result, gpointer user_data) {',
+      '}',
+      () {
+        indent.writeln('$readName* read = static_cast<$readName*>(user_data);');
+        indent.writeln('g_autoptr(GError) error = nullptr;');
+        indent.writeln(
+          'g_autoptr(GBytes) chunk = g_input_stream_read_bytes_finish(G_INPUT_STREAM(object), result, &error);',
+        );
+        indent.writeln('g_autoptr(FlValue) response = fl_value_new_list();');
+        indent.writeScoped('if (chunk != nullptr) {', '}', () {
+          indent.writeln('fl_value_append_take(response, fl_value_new_uint8_list_from_bytes(chunk));');
+        }, addTrailingNewline: false);
+        indent.addScoped(' else {', '}', () {
+          indent.writeln('fl_value_append_take(response, fl_value_new_string("read-error"));');
+          indent.writeln('fl_value_append_take(response, fl_value_new_string(error->message));');
+          indent.writeln('fl_value_append_take(response, fl_value_new_null());');
+        });
+        indent.newln();
+        indent.writeln('// The stream is released once it is read to the end or fails.');
+        indent.writeScoped('if (chunk == nullptr || g_bytes_get_size(chunk) == 0) {', '}', () {
+          indent.writeln(
+            'g_hash_table_remove(read->api->streams, GUINT_TO_POINTER(read->stream_id));',
+          );
+        });
+        indent.newln();
+        indent.writeln('g_autoptr(GError) respond_error = nullptr;');
+        indent.writeScoped(
+          'if (!fl_basic_message_channel_respond(read->channel, read->response_handle, response, &respond_error)) {',
+          '}',
+          () {
+            indent.writeln(
+              'g_warning("Failed to send chunk of %s stream: %s", "${api.name}", respond_error->message);',
+            );
+          },
+        );
+        indent.writeln('${methodPrefix}_chunk_read_free(read);');
+      },
+    );
+
+    indent.newln();
+    indent.writeScoped(
+      'static void ${methodPrefix}_chunks_cb(FlBasicMessageChannel* channel, FlValue* message_, FlBasicMessageChannelResponseHandle* response_handle, gpointer user_data) {',
+      '}',
+      () {
+        _writeCastSelf(indent, module, api.name, 'user_data');
+        indent.newln();
+        indent.writeln(
+          'guint stream_id = fl_value_get_int(fl_value_get_list_value(message_, 0));',
+        );
+        indent.writeln('int64_t max_size = fl_value_get_int(fl_value_get_list_value(message_, 1));');
+        indent.writeln(
+          'GInputStream* stream = static_cast<GInputStream*>(g_hash_table_lookup(self->streams, GUINT_TO_POINTER(stream_id)));',
+        );
+        indent.writeScoped('if (stream == nullptr) {', '}', () {
+          indent.writeln('g_autoptr(FlValue) response = fl_value_new_list();');
+          indent.writeln('fl_value_append_take(response, fl_value_new_string("unknown-stream"));');
+          indent.writeln(
+            'fl_value_append_take(response, fl_value_new_string("No stream with the requested ID."));',
+          );
+          indent.writeln('fl_value_append_take(response, fl_value_new_null());');
+          indent.writeln('g_autoptr(GError) error = nullptr;');
+          indent.writeScoped(
+            'if (!fl_basic_message_channel_respond(channel, response_handle, response, &error)) {',
+            '}',
+            () {
+              indent.writeln(
+                'g_warning("Failed to send chunk of %s stream: %s", "${api.name}", error->message);',
+              );
+            },
+          );
+          indent.writeln('return;');
+        });
+        indent.newln();
+        indent.writeln('$readName* read = g_new($readName, 1);');
+        indent.writeln('read->api = ${_getClassCastMacro(module, api.name)}(g_object_ref(self));');
+        indent.writeln('read->channel = FL_BASIC_MESSAGE_CHANNEL(g_object_ref(channel));');
+        indent.writeln(
+          'read->response_handle = FL_BASIC_MESSAGE_CHANNEL_RESPONSE_HANDLE(g_object_ref(response_handle));',
+        );
+        indent.writeln('read->stream_id = stream_id;');
+        indent.writeln(
+          'g_input_stream_read_bytes_async(stream, max_size, G_PRIORITY_DEFAULT, nullptr, ${methodPrefix}_chunk_read_cb, read);',
+        );
+      },
+    );
+  }
+
+  // Writes the class used to respond to [method] of [api].
+  //
+  // Responses to asynchronous methods are created by the generated respond
+  // functions, so their class is private to the source file.
+  void _writeHostApiResponseClass(Root root, Indent indent, String module, Api api, Method method) {
+    final String responseName = _getResponseName(api.name, method.name);
+    final String responseClassName = _getClassName(module, responseName);
+    final String responseMethodPrefix = _getMethodPrefix(module, responseName);
+
+    if (method.isAsynchronous) {
+      indent.newln();
+      _writeDeclareFinalType(indent, module, responseName);
+    }
+
+    indent.newln();
+    _writeObjectStruct(indent, module, responseName, () {
+      indent.writeln('FlValue* value;');
+    });
+
+    indent.newln();
+    _writeDefineType(indent, module, responseName);
+
+    indent.newln();
+    _writeDispose(indent, module, responseName, () {
+      _writeCastSelf(indent, module, responseName, 'object');
+      indent.writeln('g_clear_pointer(&self->value, fl_value_unref);');
+    });
+
+    indent.newln();
+    _writeInit(indent, module, responseName, () {});
+
+    indent.newln();
+    _writeClassInit(indent, module, responseName, () {});
+
+    final String returnType = _getType(module, method.returnType);
+    indent.newln();
+    final constructorArgs = <String>[
+      if (method.returnType.isChunked)
+        'guint stream_id'
+      else if (returnType != 'void')
+        '$returnType return_value',
+      if (_isNumericListType(method.returnType)) 'size_t return_value_length',
+    ];
+    indent.writeScoped(
+      "${method.isAsynchronous ? 'static ' : ''}$responseClassName* ${responseMethodPrefix}_new(${constructorArgs.join(', ')}) {",
+      '}',
+      () {
+        _writeObjectNew(indent, module, responseName);
+        indent.writeln('self->value = fl_value_new_list();');
+        if (method.returnType.isChunked) {
+          indent.writeln('fl_value_append_take(self->value, fl_value_new_int(stream_id));');
+        } else {
+          indent.writeln(
+            "fl_value_append_take(self->value, ${_makeFlValue(root, module, method.returnType, 'return_value', lengthVariableName: 'return_value_length')});",
+          );
+        }
+        indent.writeln('return self;');
+      },
+    );
+
+    indent.newln();
+    indent.writeScoped(
+      '${method.isAsynchronous ? 'static ' : ''}$responseClassName* ${responseMethodPrefix}_new_error(const gchar* code, const gchar* message, FlValue* details) {',
+      '}',
+      () {
+        _writeObjectNew(indent, module, responseName);
+        indent.writeln('self->value = fl_value_new_list();');
+        indent.writeln('fl_value_append_take(self->value, fl_value_new_string(code));');
+        indent.writeln(
+          'fl_value_append_take(self->value, fl_value_new_string(message != nullptr ? message : ""));',
+        );
+        indent.writeln(
+          'fl_value_append_take(self->value, details != nullptr ? fl_value_ref(details) : fl_value_new_null());',
+        );
+        indent.writeln('return self;');
+      },
+    );
+  }
+
+  @override
+  void writeEventChannelApi(
+    InternalGObjectOptions generatorOptions,
+    Root root,
+    Indent indent,
+    AstEventChannelApi api, {
+    required String dartPackageName,
+  }) {
+    final String module = _getModule(generatorOptions, dartPackageName);
+    final String className = _getClassName(module, api.name);
+    final String methodPrefix = _getMethodPrefix(module, api.name);
+    final String vtableName = _getVTableName(module, api.name);
+    final GObjectEventChannelOptions options =
+        api.gobjectOptions ?? const GObjectEventChannelOptions();
+
+    final String codecClassName = _getClassName(module, _codecBaseName);
+    final String codecMethodPrefix = _getMethodPrefix(module, _codecBaseName);
+
+    for (final Method method in api.methods) {
+      _writeEventSink(root, indent, module, api, method, options);
+    }
+
+    indent.newln();
+    _writeObjectStruct(indent, module, api.name, () {
+      indent.writeln('const $vtableName* vtable;');
+      indent.writeln('gpointer user_data;');
+      indent.writeln('GDestroyNotify user_data_free_func;');
+      if (options.isBatched) {
+        indent.newln();
+        indent.writeln('// The sinks of the streams being listened to, which are stopped when');
+        indent.writeln('// the listener cancels them.');
+        for (final Method method in api.methods) {
+          final String sinkClassName = _getClassName(
+            module,
+            _getEventSinkName(api.name, method.name),
+          );
+          indent.writeln('$sinkClassName* ${_getMethodName(method.name)}_sink;');
+        }
+      }
+    });
+
+    indent.newln();
+    _writeDefineType(indent, module, api.name);
+
+    indent.newln();
+    _writeDispose(indent, module, api.name, () {
+      _writeCastSelf(indent, module, api.name, 'object');
+      indent.writeScoped(
+        'if (self->user_data != nullptr && self->user_data_free_func != nullptr) {',
+        '}',
+        () {
+          indent.writeln('self->user_data_free_func(self->user_data);');
+        },
+      );
+      indent.writeln('self->user_data = nullptr;');
+      if (options.isBatched) {
+        for (final Method method in api.methods) {
+          indent.writeln('g_clear_object(&self->${_getMethodName(method.name)}_sink);');
+        }
+      }
+    });
+
+    indent.newln();
+    _writeInit(indent, module, api.name, () {});
+
+    indent.newln();
+    _writeClassInit(indent, module, api.name, () {});
+
+    indent.newln();
+    indent.writeScoped(
+      'static $className* ${methodPrefix}_new(const $vtableName* vtable, gpointer user_data, GDestroyNotify user_data_free_func) {',
+      '}',
+      () {
+        _writeObjectNew(indent, module, api.name);
+        indent.writeln('self->vtable = vtable;');
+        indent.writeln('self->user_data = user_data;');
+        indent.writeln('self->user_data_free_func = user_data_free_func;');
+        indent.writeln('return self;');
+      },
+    );
+
+    for (final Method method in api.methods) {
+      final String methodName = _getMethodName(method.name);
+      final String sinkName = _getEventSinkName(api.name, method.name);
+      final String sinkClassName = _getClassName(module, sinkName);
+      final String sinkMethodPrefix = _getMethodPrefix(module, sinkName);
+
+      indent.newln();
+      indent.writeScoped(
+        'static FlMethodErrorResponse* ${methodPrefix}_${methodName}_listen_cb(FlEventChannel* channel, FlValue* args, gpointer user_data) {',
+        '}',
+        () {
+          _writeCastSelf(indent, module, api.name, 'user_data');
+          indent.newln();
+          indent.writeScoped(
+            'if (self->vtable == nullptr || self->vtable->${methodName}_on_listen == nullptr) {',
+            '}',
+            () {
+              indent.writeln('return nullptr;');
+            },
+          );
+          indent.newln();
+          indent.writeln('g_autoptr($sinkClassName) sink = ${sinkMethodPrefix}_new(channel);');
+          if (options.isBatched) {
+            indent.writeln('g_set_object(&self->${methodName}_sink, sink);');
+          }
+          indent.writeln('self->vtable->${methodName}_on_listen(sink, self->user_data);');
+          indent.writeln('return nullptr;');
+        },
+      );
+
+      indent.newln();
+      indent.writeScoped(
+        'static FlMethodErrorResponse* ${methodPrefix}_${methodName}_cancel_cb(FlEventChannel* channel, FlValue* args, gpointer user_data) {',
+        '}',
+        () {
+          _writeCastSelf(indent, module, api.name, 'user_data');
+          indent.newln();
+          if (options.isBatched) {
+            indent.writeScoped('if (self->${methodName}_sink != nullptr) {', '}', () {
+              indent.writeln('${sinkMethodPrefix}_cancel(self->${methodName}_sink);');
+              indent.writeln('g_clear_object(&self->${methodName}_sink);');
+            });
+          }
+          indent.writeScoped(
+            'if (self->vtable != nullptr && self->vtable->${methodName}_on_cancel != nullptr) {',
+            '}',
+            () {
+              indent.writeln('self->vtable->${methodName}_on_cancel(self->user_data);');
+            },
+          );
+          indent.writeln('return nullptr;');
+        },
+      );
+    }
+
+    indent.newln();
+    indent.writeScoped(
+      'void ${methodPrefix}_set_stream_handlers(FlBinaryMessenger* messenger, const gchar* suffix, const $vtableName* vtable, gpointer user_data, GDestroyNotify user_data_free_func) {',
+      '}',
+      () {
+        indent.writeln(
+          'g_autofree gchar* dot_suffix = suffix != nullptr ? g_strdup_printf(".%s", suffix) : g_strdup("");',
+        );
+        indent.writeln(
+          'g_autoptr($className) api_data = ${methodPrefix}_new(vtable, user_data, user_data_free_func);',
+        );
+
+        indent.newln();
+        indent.writeln('g_autoptr($codecClassName) message_codec = ${codecMethodPrefix}_new();');
+        indent.writeln(
+          'g_autoptr(FlStandardMethodCodec) codec = fl_standard_method_codec_new_with_message_codec(FL_STANDARD_MESSAGE_CODEC(message_codec));',
+        );
+        for (final Method method in api.methods) {
+          final String methodName = _getMethodName(method.name);
+          final String channelName = makeChannelName(api, method, dartPackageName);
+          indent.writeln(
+            'g_autofree gchar* ${methodName}_channel_name = g_strdup_printf("$channelName%s", dot_suffix);',
+          );
+          indent.writeln(
+            'g_autoptr(FlEventChannel) ${methodName}_channel = fl_event_channel_new(messenger, ${methodName}_channel_name, FL_METHOD_CODEC(codec));',
+          );
+          indent.writeln(
+            'fl_event_channel_set_stream_handlers(${methodName}_channel, ${methodPrefix}_${methodName}_listen_cb, ${methodPrefix}_${methodName}_cancel_cb, g_object_ref(api_data), g_object_unref);',
+          );
+        }
+      },
+    );
+
+    indent.newln();
+    indent.writeScoped(
+      'void ${methodPrefix}_clear_stream_handlers(FlBinaryMessenger* messenger, const gchar* suffix) {',
+      '}',
+      () {
+        indent.writeln(
+          'g_autofree gchar* dot_suffix = suffix != nullptr ? g_strdup_printf(".%s", suffix) : g_strdup("");',
+        );
+
+        indent.newln();
+        indent.writeln('g_autoptr($codecClassName) message_codec = ${codecMethodPrefix}_new();');
+        indent.writeln(
+          'g_autoptr(FlStandardMethodCodec) codec = fl_standard_method_codec_new_with_message_codec(FL_STANDARD_MESSAGE_CODEC(message_codec));',
+        );
+        for (final Method method in api.methods) {
+          final String methodName = _getMethodName(method.name);
+          final String channelName = makeChannelName(api, method, dartPackageName);
+          indent.writeln(
+            'g_autofree gchar* ${methodName}_channel_name = g_strdup_printf("$channelName%s", dot_suffix);',
+          );
+          indent.writeln(
+            'g_autoptr(FlEventChannel) ${methodName}_channel = fl_event_channel_new(messenger, ${methodName}_channel_name, FL_METHOD_CODEC(codec));',
+          );
+          indent.writeln(
+            'fl_event_channel_set_stream_handlers(${methodName}_channel, nullptr, nullptr, nullptr, nullptr);',
+          );
+        }
+      },
+    );
+  }
+
+  // Writes the sink class used to send the events of an event channel method.
+  void _writeEventSink(
+    Root root,
+    Indent indent,
+    String module,
+    AstEventChannelApi api,
+    Method method,
+    GObjectEventChannelOptions options,
+  ) {
+    final String sinkName = _getEventSinkName(api.name, method.name);
+    final String sinkClassName = _getClassName(module, sinkName);
+    final String sinkMethodPrefix = _getMethodPrefix(module, sinkName);
+    final String testMacro =
+        '${_snakeCaseFromCamelCase(module)}_IS_${_snakeCaseFromCamelCase(sinkName)}'.toUpperCase();
+
+    indent.newln();
+    _writeObjectStruct(indent, module, sinkName, () {
+      indent.writeln('FlEventChannel* channel;');
+      if (options.isBatched) {
+        indent.newln();
+        indent.writeln('// Events waiting to be sent and the source that sends them.');
+        indent.writeln('FlValue* batch;');
+        indent.writeln('guint flush_source_id;');
+        indent.writeln('// Whether the listener cancelled the stream.');
+        indent.writeln('gboolean cancelled;');
+      }
+    });
+
+    indent.newln();
+    _writeDefineType(indent, module, sinkName);
+
+    indent.newln();
+    _writeDispose(indent, module, sinkName, () {
+      _writeCastSelf(indent, module, sinkName, 'object');
+      if (options.isBatched) {
+        indent.writeln('g_clear_pointer(&self->batch, fl_value_unref);');
+      }
+      indent.writeln('g_clear_object(&self->channel);');
+    });
+
+    indent.newln();
+    _writeInit(indent, module, sinkName, () {});
+
+    indent.newln();
+    _writeClassInit(indent, module, sinkName, () {});
+
+    indent.newln();
+    indent.writeScoped(
+      'static $sinkClassName* ${sinkMethodPrefix}_new(FlEventChannel* channel) {',
+      '}',
+      () {
+        _writeObjectNew(indent, module, sinkName);
+        indent.writeln('self->channel = FL_EVENT_CHANNEL(g_object_ref(channel));');
+        indent.writeln('return self;');
+      },
+    );
+
+    indent.newln();
+    indent.writeScoped(
+      'static void ${sinkMethodPrefix}_send($sinkClassName* self, FlValue* event) {',
+      '}',
+      () {
+        indent.writeln('g_autoptr(GError) error = nullptr;');
+        indent.writeScoped(
+          'if (!fl_event_channel_send(self->channel, event, nullptr, &error)) {',
+          '}',
+          () {
+            indent.writeln(
+              'g_warning("Failed to send event to %s.%s: %s", "${api.name}", "${method.name}", error->message);',
+            );
+          },
+        );
+      },
+    );
+
+    if (options.isBatched) {
+      indent.newln();
+      indent.writeScoped('void ${sinkMethodPrefix}_flush($sinkClassName* self) {', '}', () {
+        indent.writeln('g_return_if_fail($testMacro(self));');
+        indent.newln();
+        indent.writeln('g_clear_handle_id(&self->flush_source_id, g_source_remove);');
+        indent.writeScoped('if (self->batch == nullptr) {', '}', () {
+          indent.writeln('return;');
+        });
+        indent.writeln('g_autoptr(FlValue) batch = self->batch;');
+        indent.writeln('self->batch = nullptr;');
+        indent.writeln('${sinkMethodPrefix}_send(self, batch);');
+      });
+
+      indent.newln();
+      indent.writeScoped('static gboolean ${sinkMethodPrefix}_flush_cb(gpointer user_data) {', '}', () {
+        _writeCastSelf(indent, module, sinkName, 'user_data');
+        indent.writeln('self->flush_source_id = 0;');
+        indent.writeln('${sinkMethodPrefix}_flush(self);');
+        indent.writeln('return G_SOURCE_REMOVE;');
+      });
+
+      indent.newln();
+      indent.writeScoped('static void ${sinkMethodPrefix}_cancel($sinkClassName* self) {', '}', () {
+        indent.writeln('self->cancelled = TRUE;');
+        indent.writeln('g_clear_handle_id(&self->flush_source_id, g_source_remove);');
+        indent.writeln('g_clear_pointer(&self->batch, fl_value_unref);');
+      });
+
+      indent.newln();
+      indent.writeScoped(
+        'static void ${sinkMethodPrefix}_add($sinkClassName* self, FlValue* event) {',
+        '}',
+        () {
+          indent.writeScoped('if (self->cancelled) {', '}', () {
+            indent.writeln('fl_value_unref(event);');
+            indent.writeln('return;');
+          });
+          indent.writeScoped('if (self->batch == nullptr) {', '}', () {
+            indent.writeln('self->batch = fl_value_new_list();');
+          });
+          indent.writeln('fl_value_append_take(self->batch, event);');
+          indent.writeScoped(
+            'if (fl_value_get_length(self->batch) >= ${options.maxBatchSize}) {',
+            '}',
+            () {
+              indent.writeln('${sinkMethodPrefix}_flush(self);');
+            },
+            addTrailingNewline: false,
           );
+          indent.addScoped(' else if (self->flush_source_id == 0) {', '}', () {
+            // The source holds a reference so that pending events are not
+            // lost when the sink is released.
+            indent.writeln(
+              'self->flush_source_id = g_timeout_add_full(G_PRIORITY_DEFAULT, ${options.maxBatchLatencyMilliseconds}, ${sinkMethodPrefix}_flush_cb, g_object_ref(self), g_object_unref);',
+            );
+          });
+        },
+      );
+    }
+
+    final String valueType = _getType(module, method.returnType);
+    final sendArgs = <String>[
+      '$sinkClassName* self',
+      '$valueType value',
+      if (_isNumericListType(method.returnType)) 'size_t value_length',
+    ];
+    indent.newln();
+    indent.writeScoped("void ${sinkMethodPrefix}_success(${sendArgs.join(', ')}) {", '}', () {
+      indent.writeln('g_return_if_fail($testMacro(self));');
+      indent.newln();
+      final String event = _makeFlValue(
+        root,
+        module,
+        method.returnType,
+        'value',
+        lengthVariableName: 'value_length',
+      );
+      if (options.isBatched) {
+        indent.writeln('${sinkMethodPrefix}_add(self, $event);');
+      } else {
+        indent.writeln('g_autoptr(FlValue) event = $event;');
+        indent.writeln('${sinkMethodPrefix}_send(self, event);');
+      }
+    });
+
+    indent.newln();
+    indent.writeScoped(
+      'void ${sinkMethodPrefix}_error($sinkClassName* self, const gchar* code, const gchar* message, FlValue* details) {',
+      '}',
+      () {
+        indent.writeln('g_return_if_fail($testMacro(self));');
+        indent.newln();
+        if (options.isBatched) {
+          // Events that were sent before the error are delivered first.
+          indent.writeln('${sinkMethodPrefix}_flush(self);');
         }
-      });
+        indent.writeln('g_autoptr(GError) error = nullptr;');
+        indent.writeScoped(
+          'if (!fl_event_channel_send_error(self->channel, code, message, details, nullptr, &error)) {',
+          '}',
+          () {
+            indent.writeln(
+              'g_warning("Failed to send error to %s.%s: %s", "${api.name}", "${method.name}", error->message);',
+            );
+          },
+        );
+      },
+    );
 
-      indent.writeln('g_string_append(str, ")");');
-      indent.writeln('return g_string_free(str, FALSE);');
+    indent.newln();
+    indent.writeScoped('void ${sinkMethodPrefix}_end_of_stream($sinkClassName* self) {', '}', () {
+      indent.writeln('g_return_if_fail($testMacro(self));');
+      indent.newln();
+      if (options.isBatched) {
+        indent.writeln('${sinkMethodPrefix}_flush(self);');
+      }
+      indent.writeln('g_autoptr(GError) error = nullptr;');
+      indent.writeScoped(
+        'if (!fl_event_channel_send_end_of_stream(self->channel, nullptr, &error)) {',
+        '}',
+        () {
+          indent.writeln(
+            'g_warning("Failed to send end of stream to %s.%s: %s", "${api.name}", "${method.name}", error->message);',
+          );
+        },
+      );
     });
   }
 
   @override
-  void writeGeneralCodec(
+  void writeInstanceManager(
     InternalGObjectOptions generatorOptions,
     Root root,
     Indent indent, {
     required String dartPackageName,
   }) {
     final String module = _getModule(generatorOptions, dartPackageName);
-    final String codecClassName = _getClassName(module, _codecBaseName);
-    final String codecMethodPrefix = _getMethodPrefix(module, _codecBaseName);
+    final String className = _getClassName(module, _instanceManagerBaseName);
+    final String methodPrefix = _getMethodPrefix(module, _instanceManagerBaseName);
+    final entryName = '${className}Entry';
+    final String testMacro =
+        '${_snakeCaseFromCamelCase(module)}_IS_${_snakeCaseFromCamelCase(_instanceManagerBaseName)}'
+            .toUpperCase();
 
-    final Iterable<EnumeratedType> customTypes = getEnumeratedTypes(
-      root,
-      excludeSealedClasses: true,
+    indent.newln();
+    indent.writeln(
+      'const int ${_getInstanceManagerTypeId(module)} = $proxyApiCodecInstanceManagerKey;',
     );
 
     indent.newln();
-    _writeObjectStruct(indent, module, _codecBaseName, () {}, parentClassName: _standardCodecName);
+    indent.writeln('// Identifiers of instances created on the host start at this value, so they');
+    indent.writeln('// never collide with the identifiers assigned by Dart.');
+    indent.writeln(
+      'static const int64_t ${methodPrefix}_min_host_created_identifier = 65536;',
+    );
 
     indent.newln();
-    _writeDefineType(
-      indent,
-      module,
-      _codecBaseName,
-      parentType: 'fl_standard_message_codec_get_type()',
-    );
+    indent.writeln('// An instance in the instance manager.');
+    indent.writeScoped('typedef struct {', '} $entryName;', () {
+      indent.writeln('// Only dereferenced through instance_ref unless the instance is held, as');
+      indent.writeln('// it may be finalized on another thread.');
+      indent.writeln('GObject* instance;');
+      indent.writeln('GWeakRef instance_ref;');
+      indent.writeln('int64_t identifier;');
+      indent.writeln('// TRUE until Dart releases the instance.');
+      indent.writeln('gboolean has_strong_reference;');
+    });
 
     indent.newln();
-    for (final customType in customTypes) {
-      final String customTypeId = _getCustomTypeId(module, customType);
-      indent.writeln('const int $customTypeId = ${customType.enumeration};');
-    }
+    _writeObjectStruct(indent, module, _instanceManagerBaseName, () {
+      indent.writeln('FlBinaryMessenger* messenger;');
+      indent.newln();
+      indent.writeln('// Protects the fields below, as instances may be finalized on any thread.');
+      indent.writeln('GMutex mutex;');
+      indent.writeln('GHashTable* entries_by_identifier;');
+      indent.writeln('GHashTable* entries_by_instance;');
+      indent.writeln('int64_t next_identifier;');
+      indent.writeln('// Identifiers of finalized instances waiting to be released in Dart.');
+      indent.writeln('GArray* finalized_identifiers;');
+      indent.writeln('guint release_source_id;');
+    });
 
-    for (final customType in customTypes) {
-      final String customTypeName = _getClassName(module, customType.name);
-      final String snakeCustomTypeName = _snakeCaseFromCamelCase(customTypeName);
-      final String customTypeId = _getCustomTypeId(module, customType);
+    indent.newln();
+    _writeDefineType(indent, module, _instanceManagerBaseName);
+
+    indent.newln();
+    indent.writeScoped('static void ${methodPrefix}_entry_free(gpointer data) {', '}', () {
+      indent.writeln('$entryName* entry = static_cast<$entryName*>(data);');
+      indent.writeln('g_weak_ref_clear(&entry->instance_ref);');
+      indent.writeln('g_free(entry);');
+    });
 
+    indent.newln();
+    indent.writeln('// Releases the finalized instances in Dart.');
+    indent.writeScoped('static gboolean ${methodPrefix}_release_cb(gpointer user_data) {', '}', () {
+      _writeCastSelf(indent, module, _instanceManagerBaseName, 'user_data');
       indent.newln();
-      final valueType = customType.type == CustomTypes.customClass
-          ? '$customTypeName*'
-          : 'FlValue*';
-      indent.writeScoped(
-        'static gboolean ${codecMethodPrefix}_write_$snakeCustomTypeName($_standardCodecName* codec, GByteArray* buffer, $valueType value, GError** error) {',
-        '}',
-        () {
-          indent.writeln('uint8_t type = $customTypeId;');
-          indent.writeln('g_byte_array_append(buffer, &type, sizeof(uint8_t));');
-          if (customType.type == CustomTypes.customClass) {
-            indent.writeln('g_autoptr(FlValue) values = ${snakeCustomTypeName}_to_list(value);');
-            indent.writeln(
-              'return fl_standard_message_codec_write_value(codec, buffer, values, error);',
-            );
-          } else if (customType.type == CustomTypes.customEnum) {
-            indent.writeln(
-              'return fl_standard_message_codec_write_value(codec, buffer, value, error);',
-            );
-          }
-        },
+      indent.writeln('g_autoptr(GArray) identifiers = nullptr;');
+      indent.writeScoped('{', '}', () {
+        indent.writeln('g_autoptr(GMutexLocker) locker = g_mutex_locker_new(&self->mutex);');
+        indent.writeln('identifiers = self->finalized_identifiers;');
+        indent.writeln(
+          'self->finalized_identifiers = g_array_new(FALSE, FALSE, sizeof(int64_t));',
+        );
+        indent.writeln('self->release_source_id = 0;');
+      });
+      indent.newln();
+      indent.writeln('// All of the identifiers are sent in a single message.');
+      indent.writeln('g_autoptr(FlValue) message = fl_value_new_list();');
+      indent.writeln(
+        'fl_value_append_take(message, fl_value_new_int64_list(reinterpret_cast<const int64_t*>(identifiers->data), identifiers->len));',
       );
-    }
+      indent.newln();
+      indent.writeln('// The message is sent without an FlBasicMessageChannel, as creating one');
+      indent.writeln('// registers it on the messenger.');
+      indent.writeln('g_autoptr(FlStandardMessageCodec) codec = fl_standard_message_codec_new();');
+      indent.writeln('g_autoptr(GError) error = nullptr;');
+      indent.writeln(
+        'g_autoptr(GBytes) data = fl_message_codec_encode_message(FL_MESSAGE_CODEC(codec), message, &error);',
+      );
+      indent.writeScoped('if (data == nullptr) {', '}', () {
+        indent.writeln(
+          'g_warning("Failed to encode message to %s: %s", "${makeRemoveStrongReferencesChannelName(dartPackageName)}", error->message);',
+        );
+        indent.writeln('return G_SOURCE_REMOVE;');
+      });
+      indent.writeln(
+        'fl_binary_messenger_send_on_channel(self->messenger, "${makeRemoveStrongReferencesChannelName(dartPackageName)}", data, nullptr, nullptr, nullptr);',
+      );
+      indent.newln();
+      indent.writeln('return G_SOURCE_REMOVE;');
+    });
 
     indent.newln();
     indent.writeScoped(
-      'static gboolean ${codecMethodPrefix}_write_value($_standardCodecName* codec, GByteArray* buffer, FlValue* value, GError** error) {',
+      'static void ${methodPrefix}_instance_finalized_cb(gpointer user_data, GObject* where_the_object_was) {',
       '}',
       () {
-        indent.writeScoped('if (fl_value_get_type(value) == FL_VALUE_TYPE_CUSTOM) {', '}', () {
-          indent.writeScoped('switch (fl_value_get_custom_type(value)) {', '}', () {
-            for (final customType in customTypes) {
-              final String customTypeId = _getCustomTypeId(module, customType);
-              indent.writeln('case $customTypeId:');
-              indent.nest(1, () {
-                final String customTypeName = _getClassName(module, customType.name);
-                final String snakeCustomTypeName = _snakeCaseFromCamelCase(customTypeName);
-                final String castMacro = _getClassCastMacro(module, customType.name);
-                if (customType.type == CustomTypes.customClass) {
-                  indent.writeln(
-                    'return ${codecMethodPrefix}_write_$snakeCustomTypeName(codec, buffer, $castMacro(fl_value_get_custom_value_object(value)), error);',
-                  );
-                } else if (customType.type == CustomTypes.customEnum) {
-                  indent.writeln(
-                    'return ${codecMethodPrefix}_write_$snakeCustomTypeName(codec, buffer, reinterpret_cast<FlValue*>(const_cast<gpointer>(fl_value_get_custom_value(value))), error);',
-                  );
-                }
-              });
-            }
-          });
+        indent.writeln('$className* self = static_cast<$className*>(user_data);');
+        indent.newln();
+        indent.writeln('g_autoptr(GMutexLocker) locker = g_mutex_locker_new(&self->mutex);');
+        indent.writeln(
+          '$entryName* entry = static_cast<$entryName*>(g_hash_table_lookup(self->entries_by_instance, where_the_object_was));',
+        );
+        indent.writeln('// Instances removed by clear are not released in Dart.');
+        indent.writeScoped('if (entry == nullptr) {', '}', () {
+          indent.writeln('return;');
+        });
+        indent.newln();
+        indent.writeln('g_array_append_val(self->finalized_identifiers, entry->identifier);');
+        indent.writeln('// A single idle callback releases the instances finalized before it runs.');
+        indent.writeScoped('if (self->release_source_id == 0) {', '}', () {
+          indent.writeln(
+            'self->release_source_id = g_idle_add_full(G_PRIORITY_DEFAULT_IDLE, ${methodPrefix}_release_cb, g_object_ref(self), g_object_unref);',
+          );
         });
+        indent.writeln('g_hash_table_remove(self->entries_by_instance, where_the_object_was);');
+        indent.writeln('g_hash_table_remove(self->entries_by_identifier, &entry->identifier);');
+      },
+    );
+
+    indent.newln();
+    indent.writeln('// Adds [instance] with [identifier]. The mutex must be held.');
+    indent.writeScoped(
+      'static void ${methodPrefix}_add_instance($className* self, GObject* instance, int64_t identifier) {',
+      '}',
+      () {
+        indent.writeln('$entryName* entry = g_new0($entryName, 1);');
+        indent.writeln('entry->instance = instance;');
+        indent.writeln('g_weak_ref_init(&entry->instance_ref, instance);');
+        indent.writeln('entry->identifier = identifier;');
+        indent.writeln('entry->has_strong_reference = TRUE;');
+        indent.writeln('g_object_ref(instance);');
+        indent.writeln(
+          'g_object_weak_ref(instance, ${methodPrefix}_instance_finalized_cb, self);',
+        );
+        indent.writeln(
+          'g_hash_table_insert(self->entries_by_identifier, &entry->identifier, entry);',
+        );
+        indent.writeln('g_hash_table_insert(self->entries_by_instance, instance, entry);');
+      },
+    );
+
+    indent.newln();
+    indent.writeScoped(
+      'gboolean ${methodPrefix}_add_dart_created_instance($className* self, GObject* instance, int64_t identifier) {',
+      '}',
+      () {
+        indent.writeln('g_return_val_if_fail($testMacro(self), FALSE);');
+        indent.writeln('g_return_val_if_fail(G_IS_OBJECT(instance), FALSE);');
+        indent.writeln('g_return_val_if_fail(identifier >= 0, FALSE);');
+        indent.newln();
+        indent.writeln('g_autoptr(GMutexLocker) locker = g_mutex_locker_new(&self->mutex);');
+        indent.writeScoped(
+          'if (g_hash_table_contains(self->entries_by_identifier, &identifier) || g_hash_table_contains(self->entries_by_instance, instance)) {',
+          '}',
+          () {
+            indent.writeln('return FALSE;');
+          },
+        );
+        indent.writeln('${methodPrefix}_add_instance(self, instance, identifier);');
+        indent.writeln('return TRUE;');
+      },
+    );
+
+    indent.newln();
+    indent.writeScoped(
+      'int64_t ${methodPrefix}_add_host_created_instance($className* self, GObject* instance) {',
+      '}',
+      () {
+        indent.writeln('g_return_val_if_fail($testMacro(self), -1);');
+        indent.writeln('g_return_val_if_fail(G_IS_OBJECT(instance), -1);');
+        indent.newln();
+        indent.writeln('g_autoptr(GMutexLocker) locker = g_mutex_locker_new(&self->mutex);');
+        indent.writeScoped(
+          'if (g_hash_table_contains(self->entries_by_instance, instance)) {',
+          '}',
+          () {
+            indent.writeln('return -1;');
+          },
+        );
+        indent.writeln('int64_t identifier = self->next_identifier++;');
+        indent.writeln('${methodPrefix}_add_instance(self, instance, identifier);');
+        indent.writeln('return identifier;');
+      },
+    );
 
+    indent.newln();
+    indent.writeScoped(
+      'GObject* ${methodPrefix}_get_instance($className* self, int64_t identifier) {',
+      '}',
+      () {
+        indent.writeln('g_return_val_if_fail($testMacro(self), nullptr);');
         indent.newln();
+        indent.writeln('g_autoptr(GMutexLocker) locker = g_mutex_locker_new(&self->mutex);');
         indent.writeln(
-          'return FL_STANDARD_MESSAGE_CODEC_CLASS(${codecMethodPrefix}_parent_class)->write_value(codec, buffer, value, error);',
+          '$entryName* entry = static_cast<$entryName*>(g_hash_table_lookup(self->entries_by_identifier, &identifier));',
+        );
+        indent.writeln('// A new reference is taken under the lock, so the instance cannot be');
+        indent.writeln('// finalized on another thread before it is returned.');
+        indent.writeln(
+          'return entry != nullptr ? static_cast<GObject*>(g_weak_ref_get(&entry->instance_ref)) : nullptr;',
         );
       },
     );
 
-    for (final customType in customTypes) {
-      final String customTypeName = _getClassName(module, customType.name);
-      final String snakeCustomTypeName = _snakeCaseFromCamelCase(customTypeName);
-      final String customTypeId = _getCustomTypeId(module, customType);
-      indent.newln();
-      indent.writeScoped(
-        'static FlValue* ${codecMethodPrefix}_read_$snakeCustomTypeName($_standardCodecName* codec, GBytes* buffer, size_t* offset, GError** error) {',
-        '}',
-        () {
-          if (customType.type == CustomTypes.customClass) {
-            indent.writeln(
-              'g_autoptr(FlValue) values = fl_standard_message_codec_read_value(codec, buffer, offset, error);',
-            );
-            indent.writeScoped('if (values == nullptr) {', '}', () {
-              indent.writeln('return nullptr;');
-            });
-            indent.newln();
-            indent.writeln(
-              'g_autoptr($customTypeName) value = ${snakeCustomTypeName}_new_from_list(values);',
-            );
-            indent.writeScoped('if (value == nullptr) {', '}', () {
-              indent.writeln(
-                'g_set_error(error, FL_MESSAGE_CODEC_ERROR, FL_MESSAGE_CODEC_ERROR_FAILED, "Invalid data received for MessageData");',
-              );
-              indent.writeln('return nullptr;');
-            });
-            indent.newln();
-            indent.writeln('return fl_value_new_custom_object($customTypeId, G_OBJECT(value));');
-          } else if (customType.type == CustomTypes.customEnum) {
-            indent.writeln(
-              'return fl_value_new_custom($customTypeId, fl_standard_message_codec_read_value(codec, buffer, offset, error), (GDestroyNotify)fl_value_unref);',
-            );
-          }
-        },
-      );
-    }
+    indent.newln();
+    indent.writeScoped(
+      'gboolean ${methodPrefix}_get_identifier($className* self, GObject* instance, int64_t* identifier) {',
+      '}',
+      () {
+        indent.writeln('g_return_val_if_fail($testMacro(self), FALSE);');
+        indent.newln();
+        indent.writeln('g_autoptr(GMutexLocker) locker = g_mutex_locker_new(&self->mutex);');
+        indent.writeln(
+          '$entryName* entry = static_cast<$entryName*>(g_hash_table_lookup(self->entries_by_instance, instance));',
+        );
+        indent.writeScoped('if (entry == nullptr) {', '}', () {
+          indent.writeln('return FALSE;');
+        });
+        indent.writeln('// The instance is being sent to Dart, so it is held again until Dart');
+        indent.writeln('// releases it, unless it is already being finalized on another thread.');
+        indent.writeScoped('if (!entry->has_strong_reference) {', '}', () {
+          indent.writeln('// The new reference from g_weak_ref_get is the one that is held.');
+          indent.writeScoped('if (g_weak_ref_get(&entry->instance_ref) == nullptr) {', '}', () {
+            indent.writeln('return FALSE;');
+          });
+          indent.writeln('entry->has_strong_reference = TRUE;');
+        });
+        indent.writeln('*identifier = entry->identifier;');
+        indent.writeln('return TRUE;');
+      },
+    );
 
     indent.newln();
     indent.writeScoped(
-      'static FlValue* ${codecMethodPrefix}_read_value_of_type($_standardCodecName* codec, GBytes* buffer, size_t* offset, int type, GError** error) {',
+      'gboolean ${methodPrefix}_contains_instance($className* self, GObject* instance) {',
       '}',
       () {
-        indent.writeScoped('switch (type) {', '}', () {
-          for (final customType in customTypes) {
-            final String customTypeName = _getClassName(module, customType.name);
-            final String customTypeId = _getCustomTypeId(module, customType);
-            final String snakeCustomTypeName = _snakeCaseFromCamelCase(customTypeName);
-            indent.writeln('case $customTypeId:');
-            indent.nest(1, () {
-              indent.writeln(
-                'return ${codecMethodPrefix}_read_$snakeCustomTypeName(codec, buffer, offset, error);',
-              );
-            });
-          }
+        indent.writeln('g_return_val_if_fail($testMacro(self), FALSE);');
+        indent.newln();
+        indent.writeln('g_autoptr(GMutexLocker) locker = g_mutex_locker_new(&self->mutex);');
+        indent.writeln('return g_hash_table_contains(self->entries_by_instance, instance);');
+      },
+    );
+
+    indent.newln();
+    indent.writeScoped(
+      'void ${methodPrefix}_remove($className* self, int64_t identifier) {',
+      '}',
+      () {
+        indent.writeln('g_return_if_fail($testMacro(self));');
+        indent.newln();
+        indent.writeln('GObject* instance = nullptr;');
+        indent.writeScoped('{', '}', () {
+          indent.writeln('g_autoptr(GMutexLocker) locker = g_mutex_locker_new(&self->mutex);');
+          indent.writeln(
+            '$entryName* entry = static_cast<$entryName*>(g_hash_table_lookup(self->entries_by_identifier, &identifier));',
+          );
+          indent.writeScoped(
+            'if (entry != nullptr && entry->has_strong_reference) {',
+            '}',
+            () {
+              indent.writeln('entry->has_strong_reference = FALSE;');
+              indent.writeln('instance = entry->instance;');
+            },
+          );
+        });
+        indent.newln();
+        indent.writeln('// Released without the lock held, as this may finalize the instance.');
+        indent.writeScoped('if (instance != nullptr) {', '}', () {
+          indent.writeln('g_object_unref(instance);');
+        });
+      },
+    );
 
-          indent.writeln('default:');
-          indent.nest(1, () {
+    indent.newln();
+    indent.writeScoped('void ${methodPrefix}_clear($className* self) {', '}', () {
+      indent.writeln('g_return_if_fail($testMacro(self));');
+      indent.newln();
+      indent.writeln('// The references are released once the lock is no longer held.');
+      indent.writeln(
+        'g_autoptr(GPtrArray) references = g_ptr_array_new_with_free_func(g_object_unref);',
+      );
+      indent.writeScoped('{', '}', () {
+        indent.writeln('g_autoptr(GMutexLocker) locker = g_mutex_locker_new(&self->mutex);');
+        indent.writeln('GHashTableIter iter;');
+        indent.writeln('gpointer value;');
+        indent.writeln('g_hash_table_iter_init(&iter, self->entries_by_identifier);');
+        indent.writeScoped('while (g_hash_table_iter_next(&iter, nullptr, &value)) {', '}', () {
+          indent.writeln('$entryName* entry = static_cast<$entryName*>(value);');
+          indent.writeln('// Instances being finalized on another thread keep their weak reference,');
+          indent.writeln('// and are ignored once they are no longer in the instance manager.');
+          indent.writeln(
+            'GObject* instance = static_cast<GObject*>(g_weak_ref_get(&entry->instance_ref));',
+          );
+          indent.writeScoped('if (instance != nullptr) {', '}', () {
             indent.writeln(
-              'return FL_STANDARD_MESSAGE_CODEC_CLASS(${codecMethodPrefix}_parent_class)->read_value_of_type(codec, buffer, offset, type, error);',
+              'g_object_weak_unref(instance, ${methodPrefix}_instance_finalized_cb, self);',
             );
+            indent.writeln('g_ptr_array_add(references, instance);');
+          });
+          indent.writeScoped('if (entry->has_strong_reference) {', '}', () {
+            indent.writeln('g_ptr_array_add(references, entry->instance);');
           });
         });
-      },
-    );
+        indent.writeln('g_hash_table_remove_all(self->entries_by_instance);');
+        indent.writeln('g_hash_table_remove_all(self->entries_by_identifier);');
+      });
+    });
 
     indent.newln();
-    _writeInit(indent, module, _codecBaseName, () {});
+    _writeDispose(indent, module, _instanceManagerBaseName, () {
+      _writeCastSelf(indent, module, _instanceManagerBaseName, 'object');
+      indent.writeScoped('if (self->messenger != nullptr) {', '}', () {
+        indent.writeln(
+          'fl_binary_messenger_set_message_handler_on_channel(self->messenger, "${makeRemoveStrongReferenceChannelName(dartPackageName)}", nullptr, nullptr, nullptr);',
+        );
+        indent.writeln(
+          'fl_binary_messenger_set_message_handler_on_channel(self->messenger, "${makeClearChannelName(dartPackageName)}", nullptr, nullptr, nullptr);',
+        );
+      });
+      indent.writeScoped('if (self->entries_by_identifier != nullptr) {', '}', () {
+        indent.writeln('${methodPrefix}_clear(self);');
+      });
+      indent.writeln('g_clear_object(&self->messenger);');
+      indent.writeln('g_clear_pointer(&self->entries_by_identifier, g_hash_table_unref);');
+      indent.writeln('g_clear_pointer(&self->entries_by_instance, g_hash_table_unref);');
+      indent.writeln('g_clear_pointer(&self->finalized_identifiers, g_array_unref);');
+    });
 
     indent.newln();
-    _writeClassInit(indent, module, _codecBaseName, () {
+    _writeInit(indent, module, _instanceManagerBaseName, () {
       indent.writeln(
-        'FL_STANDARD_MESSAGE_CODEC_CLASS(klass)->write_value = ${codecMethodPrefix}_write_value;',
+        'self->entries_by_identifier = g_hash_table_new_full(g_int64_hash, g_int64_equal, nullptr, ${methodPrefix}_entry_free);',
       );
       indent.writeln(
-        'FL_STANDARD_MESSAGE_CODEC_CLASS(klass)->read_value_of_type = ${codecMethodPrefix}_read_value_of_type;',
+        'self->entries_by_instance = g_hash_table_new(g_direct_hash, g_direct_equal);',
+      );
+      indent.writeln('self->next_identifier = ${methodPrefix}_min_host_created_identifier;');
+      indent.writeln(
+        'self->finalized_identifiers = g_array_new(FALSE, FALSE, sizeof(int64_t));',
       );
-    }, hasDispose: false);
+    });
 
     indent.newln();
-    indent.writeScoped('static $codecClassName* ${codecMethodPrefix}_new() {', '}', () {
-      _writeObjectNew(indent, module, _codecBaseName);
-      indent.writeln('return self;');
-    });
+    _writeClassInit(indent, module, _instanceManagerBaseName, () {});
   }
 
   @override
-  void writeFlutterApi(
+  void writeInstanceManagerApi(
     InternalGObjectOptions generatorOptions,
     Root root,
-    Indent indent,
-    Api api, {
+    Indent indent, {
     required String dartPackageName,
   }) {
     final String module = _getModule(generatorOptions, dartPackageName);
-    final String className = _getClassName(module, api.name);
-    final String methodPrefix = _getMethodPrefix(module, api.name);
-    final String codecClassName = _getClassName(module, _codecBaseName);
-    final String codecMethodPrefix = _getMethodPrefix(module, _codecBaseName);
-
-    indent.newln();
-    _writeObjectStruct(indent, module, api.name, () {
-      indent.writeln('FlBinaryMessenger* messenger;');
-      indent.writeln('gchar *suffix;');
-    });
+    final String className = _getClassName(module, _instanceManagerBaseName);
+    final String methodPrefix = _getMethodPrefix(module, _instanceManagerBaseName);
 
     indent.newln();
-    _writeDefineType(indent, module, api.name);
+    indent.writeScoped(
+      'static void ${methodPrefix}_respond(FlBasicMessageChannel* channel, FlBasicMessageChannelResponseHandle* response_handle, const gchar* method_name) {',
+      '}',
+      () {
+        indent.writeln('g_autoptr(FlValue) response = fl_value_new_list();');
+        indent.writeln('fl_value_append_take(response, fl_value_new_null());');
+        indent.writeln('g_autoptr(GError) error = nullptr;');
+        indent.writeScoped(
+          'if (!fl_basic_message_channel_respond(channel, response_handle, response, &error)) {',
+          '}',
+          () {
+            indent.writeln(
+              'g_warning("Failed to send response to %s.%s: %s", "${classNamePrefix}InstanceManager", method_name, error->message);',
+            );
+          },
+        );
+      },
+    );
 
     indent.newln();
-    _writeDispose(indent, module, api.name, () {
-      _writeCastSelf(indent, module, api.name, 'object');
-      indent.writeln('g_clear_object(&self->messenger);');
-      indent.writeln('g_clear_pointer(&self->suffix, g_free);');
-    });
+    indent.writeScoped(
+      'static void ${methodPrefix}_remove_strong_reference_cb(FlBasicMessageChannel* channel, FlValue* message_, FlBasicMessageChannelResponseHandle* response_handle, gpointer user_data) {',
+      '}',
+      () {
+        _writeCastSelf(indent, module, _instanceManagerBaseName, 'user_data');
+        indent.writeln('FlValue* value0 = fl_value_get_list_value(message_, 0);');
+        indent.writeln('${methodPrefix}_remove(self, fl_value_get_int(value0));');
+        indent.writeln(
+          '${methodPrefix}_respond(channel, response_handle, "removeStrongReference");',
+        );
+      },
+    );
 
     indent.newln();
-    _writeInit(indent, module, api.name, () {});
+    indent.writeScoped(
+      'static void ${methodPrefix}_clear_cb(FlBasicMessageChannel* channel, FlValue* message_, FlBasicMessageChannelResponseHandle* response_handle, gpointer user_data) {',
+      '}',
+      () {
+        _writeCastSelf(indent, module, _instanceManagerBaseName, 'user_data');
+        indent.writeln('${methodPrefix}_clear(self);');
+        indent.writeln('${methodPrefix}_respond(channel, response_handle, "clear");');
+      },
+    );
 
     indent.newln();
-    _writeClassInit(indent, module, api.name, () {});
+    indent.writeScoped('$className* ${methodPrefix}_new(FlBinaryMessenger* messenger) {', '}', () {
+      _writeObjectNew(indent, module, _instanceManagerBaseName);
+      indent.writeln('self->messenger = FL_BINARY_MESSENGER(g_object_ref(messenger));');
+      indent.newln();
+      indent.writeln('// The handlers are cleared when the instance manager is disposed, so they');
+      indent.writeln('// do not hold a reference to it.');
+      indent.writeln('g_autoptr(FlStandardMessageCodec) codec = fl_standard_message_codec_new();');
+      indent.writeln(
+        'g_autoptr(FlBasicMessageChannel) remove_strong_reference_channel = fl_basic_message_channel_new(messenger, "${makeRemoveStrongReferenceChannelName(dartPackageName)}", FL_MESSAGE_CODEC(codec));',
+      );
+      indent.writeln(
+        'fl_basic_message_channel_set_message_handler(remove_strong_reference_channel, ${methodPrefix}_remove_strong_reference_cb, self, nullptr);',
+      );
+      indent.writeln(
+        'g_autoptr(FlBasicMessageChannel) clear_channel = fl_basic_message_channel_new(messenger, "${makeClearChannelName(dartPackageName)}", FL_MESSAGE_CODEC(codec));',
+      );
+      indent.writeln(
+        'fl_basic_message_channel_set_message_handler(clear_channel, ${methodPrefix}_clear_cb, self, nullptr);',
+      );
+      indent.writeln('return self;');
+    });
 
     indent.newln();
+    indent.writeln('// Returns the response to a ProxyApi constructor or attached field, adding');
+    indent.writeln('// the [instance] it created with the [identifier] Dart assigned to it.');
     indent.writeScoped(
-      '$className* ${methodPrefix}_new(FlBinaryMessenger* messenger, const gchar* suffix) {',
+      'static FlValue* G_GNUC_UNUSED ${methodPrefix}_new_instance_response($className* self, GObject* instance, int64_t identifier, GError* error) {',
       '}',
       () {
-        _writeObjectNew(indent, module, api.name);
-        indent.writeln('self->messenger = FL_BINARY_MESSENGER(g_object_ref(messenger));');
-        indent.writeln(
-          'self->suffix = suffix != nullptr ? g_strdup_printf(".%s", suffix) : g_strdup("");',
+        indent.writeln('FlValue* response = fl_value_new_list();');
+        indent.writeln('const gchar* code = nullptr;');
+        indent.writeln('const gchar* message = nullptr;');
+        indent.writeScoped('if (instance == nullptr) {', '}', () {
+          indent.writeln(
+            'code = error != nullptr ? g_quark_to_string(error->domain) : "null-instance-error";',
+          );
+          indent.writeln(
+            'message = error != nullptr ? error->message : "No instance was created";',
+          );
+        }, addTrailingNewline: false);
+        indent.addScoped(
+          ' else if (!${methodPrefix}_add_dart_created_instance(self, instance, identifier)) {',
+          '}',
+          () {
+            indent.writeln('code = "instance-manager-error";');
+            indent.writeln('message = "The instance or identifier has already been added";');
+          },
         );
-        indent.writeln('return self;');
+        indent.writeScoped('if (code == nullptr) {', '}', () {
+          indent.writeln('fl_value_append_take(response, fl_value_new_null());');
+        }, addTrailingNewline: false);
+        indent.addScoped(' else {', '}', () {
+          indent.writeln('fl_value_append_take(response, fl_value_new_string(code));');
+          indent.writeln('fl_value_append_take(response, fl_value_new_string(message));');
+          indent.writeln('fl_value_append_take(response, fl_value_new_null());');
+        });
+        indent.writeln('return response;');
       },
     );
+  }
 
-    for (final Method method in api.methods) {
-      final String methodName = _getMethodName(method.name);
-      final String responseName = _getResponseName(api.name, method.name);
-      final String responseClassName = _getClassName(module, responseName);
-      final String responseMethodPrefix = _getMethodPrefix(module, responseName);
-      final String testResponseMacro =
-          '${_snakeCaseFromCamelCase(module)}_IS_${_snakeCaseFromCamelCase(responseName)}'
-              .toUpperCase();
+  @override
+  void writeProxyApi(
+    InternalGObjectOptions generatorOptions,
+    Root root,
+    Indent indent,
+    AstProxyApi api, {
+    required String dartPackageName,
+  }) {
+    final String module = _getModule(generatorOptions, dartPackageName);
+    final String className = _getClassName(module, api.name);
+    final String methodPrefix = _getMethodPrefix(module, api.name);
+    final String vtableName = _getVTableName(module, api.name);
+    final String codecClassName = _getClassName(module, _codecBaseName);
+    final String codecMethodPrefix = _getMethodPrefix(module, _codecBaseName);
+    final String instanceManagerClassName = _getClassName(module, _instanceManagerBaseName);
+    final String instanceManagerMethodPrefix = _getMethodPrefix(module, _instanceManagerBaseName);
+    final bool hasHostMessageCalls = api.hasAnyHostMessageCalls();
 
+    if (api.hostMethods.any((Method method) => method.isAsynchronous)) {
       indent.newln();
-      _writeObjectStruct(indent, module, responseName, () {
-        indent.writeln('FlValue* error;');
-        if (!method.returnType.isVoid) {
-          indent.writeln('FlValue* return_value;');
-          if (_isNullablePrimitiveType(method.returnType)) {
-            final String primitiveType = _getType(module, method.returnType, primitive: true);
-            indent.writeln('$primitiveType return_value_;');
-          }
-        }
+      _writeObjectStruct(indent, module, '${api.name}ResponseHandle', () {
+        indent.writeln('FlBasicMessageChannel* channel;');
+        indent.writeln('FlBasicMessageChannelResponseHandle* response_handle;');
       });
 
       indent.newln();
-      _writeDefineType(indent, module, responseName);
+      _writeDefineType(indent, module, '${api.name}ResponseHandle');
 
       indent.newln();
-      _writeDispose(indent, module, responseName, () {
-        _writeCastSelf(indent, module, responseName, 'object');
-        indent.writeln('g_clear_pointer(&self->error, fl_value_unref);');
-        if (!method.returnType.isVoid) {
-          indent.writeln('g_clear_pointer(&self->return_value, fl_value_unref);');
-        }
+      _writeDispose(indent, module, '${api.name}ResponseHandle', () {
+        _writeCastSelf(indent, module, '${api.name}ResponseHandle', 'object');
+        indent.writeln('g_clear_object(&self->channel);');
+        indent.writeln('g_clear_object(&self->response_handle);');
       });
 
       indent.newln();
-      _writeInit(indent, module, responseName, () {});
+      _writeInit(indent, module, '${api.name}ResponseHandle', () {});
 
       indent.newln();
-      _writeClassInit(indent, module, responseName, () {});
+      _writeClassInit(indent, module, '${api.name}ResponseHandle', () {});
 
       indent.newln();
       indent.writeScoped(
-        'static $responseClassName* ${responseMethodPrefix}_new(FlValue* response) {',
+        'static ${className}ResponseHandle* ${methodPrefix}_response_handle_new(FlBasicMessageChannel* channel, FlBasicMessageChannelResponseHandle* response_handle) {',
         '}',
         () {
-          _writeObjectNew(indent, module, responseName);
-          indent.writeScoped('if (fl_value_get_length(response) > 1) {', '}', () {
-            indent.writeln('self->error = fl_value_ref(response);');
-          });
-          if (!method.returnType.isVoid) {
-            indent.writeScoped('else {', '}', () {
-              indent.writeln('FlValue* value = fl_value_get_list_value(response, 0);');
-              indent.writeln('self->return_value = fl_value_ref(value);');
-            });
-          }
+          _writeObjectNew(indent, module, '${api.name}ResponseHandle');
+          indent.writeln('self->channel = FL_BASIC_MESSAGE_CHANNEL(g_object_ref(channel));');
+          indent.writeln(
+            'self->response_handle = FL_BASIC_MESSAGE_CHANNEL_RESPONSE_HANDLE(g_object_ref(response_handle));',
+          );
           indent.writeln('return self;');
         },
       );
+    }
 
-      indent.newln();
-      indent.writeScoped(
-        'gboolean ${responseMethodPrefix}_is_error($responseClassName* self) {',
-        '}',
-        () {
-          indent.writeln('g_return_val_if_fail($testResponseMacro(self), FALSE);');
-          indent.writeln('return self->error != nullptr;');
-        },
-      );
-
-      indent.newln();
-      indent.writeScoped(
-        'const gchar* ${responseMethodPrefix}_get_error_code($responseClassName* self) {',
-        '}',
-        () {
-          indent.writeln('g_return_val_if_fail($testResponseMacro(self), nullptr);');
-          indent.writeln('g_assert(${responseMethodPrefix}_is_error(self));');
-          indent.writeln('return fl_value_get_string(fl_value_get_list_value(self->error, 0));');
-        },
-      );
+    for (final Method method in api.hostMethods) {
+      _writeHostApiResponseClass(root, indent, module, api, method);
+    }
 
-      indent.newln();
-      indent.writeScoped(
-        'const gchar* ${responseMethodPrefix}_get_error_message($responseClassName* self) {',
-        '}',
-        () {
-          indent.writeln('g_return_val_if_fail($testResponseMacro(self), nullptr);');
-          indent.writeln('g_assert(${responseMethodPrefix}_is_error(self));');
-          indent.writeln('return fl_value_get_string(fl_value_get_list_value(self->error, 1));');
-        },
-      );
+    final List<(Method, String)> flutterMethods = _getProxyApiFlutterMethods(api);
+    for (final (Method method, _) in flutterMethods) {
+      _writeFlutterApiResponseClass(indent, module, api, method);
+    }
 
-      indent.newln();
-      indent.writeScoped(
-        'FlValue* ${responseMethodPrefix}_get_error_details($responseClassName* self) {',
-        '}',
-        () {
-          indent.writeln('g_return_val_if_fail($testResponseMacro(self), nullptr);');
-          indent.writeln('g_assert(${responseMethodPrefix}_is_error(self));');
-          indent.writeln('return fl_value_get_list_value(self->error, 2);');
-        },
-      );
+    indent.newln();
+    _writeObjectStruct(indent, module, api.name, () {
+      indent.writeln('FlBinaryMessenger* messenger;');
+      indent.writeln('$instanceManagerClassName* instance_manager;');
+      if (hasHostMessageCalls) {
+        indent.writeln('const $vtableName* vtable;');
+        indent.writeln('gpointer user_data;');
+        indent.writeln('GDestroyNotify user_data_free_func;');
+      }
+    });
 
-      if (!method.returnType.isVoid) {
-        final String primitiveType = _getType(module, method.returnType, primitive: true);
+    indent.newln();
+    _writeDefineType(indent, module, api.name);
 
-        indent.newln();
-        final returnType = _isNullablePrimitiveType(method.returnType)
-            ? '$primitiveType*'
-            : primitiveType;
+    indent.newln();
+    _writeDispose(indent, module, api.name, () {
+      _writeCastSelf(indent, module, api.name, 'object');
+      indent.writeln('g_clear_object(&self->messenger);');
+      indent.writeln('g_clear_object(&self->instance_manager);');
+      if (hasHostMessageCalls) {
         indent.writeScoped(
-          '$returnType ${responseMethodPrefix}_get_return_value($responseClassName* self${_isNumericListType(method.returnType) ? ', size_t* return_value_length' : ''}) {',
+          'if (self->user_data != nullptr && self->user_data_free_func != nullptr) {',
           '}',
           () {
-            indent.writeln(
-              'g_return_val_if_fail($testResponseMacro(self), ${_getDefaultValue(module, method.returnType)});',
-            );
-            indent.writeln('g_assert(!${responseMethodPrefix}_is_error(self));');
-            if (method.returnType.isNullable) {
-              indent.writeScoped(
-                'if (fl_value_get_type(self->return_value) == FL_VALUE_TYPE_NULL) {',
-                '}',
-                () {
-                  indent.writeln('return nullptr;');
-                },
-              );
-            }
-            if (_isNumericListType(method.returnType)) {
-              indent.writeScoped('if (return_value_length != nullptr) {', '}', () {
-                indent.writeln('*return_value_length = fl_value_get_length(self->return_value);');
-              });
-            }
-            if (_isNullablePrimitiveType(method.returnType)) {
-              indent.writeln(
-                'self->return_value_ = ${_fromFlValue(module, method.returnType, 'self->return_value')};',
-              );
-              indent.writeln('return &self->return_value_;');
-            } else {
-              indent.writeln(
-                'return ${_fromFlValue(module, method.returnType, 'self->return_value')};',
-              );
-            }
+            indent.writeln('self->user_data_free_func(self->user_data);');
           },
         );
+        indent.writeln('self->user_data = nullptr;');
       }
+    });
+
+    indent.newln();
+    _writeInit(indent, module, api.name, () {});
+
+    indent.newln();
+    _writeClassInit(indent, module, api.name, () {});
+
+    indent.newln();
+    indent.writeScoped(
+      '$className* ${methodPrefix}_new(FlBinaryMessenger* messenger, $instanceManagerClassName* instance_manager) {',
+      '}',
+      () {
+        _writeObjectNew(indent, module, api.name);
+        indent.writeln('self->messenger = FL_BINARY_MESSENGER(g_object_ref(messenger));');
+        indent.writeln(
+          'self->instance_manager = ${_getClassCastMacro(module, _instanceManagerBaseName)}(g_object_ref(instance_manager));',
+        );
+        indent.writeln('return self;');
+      },
+    );
+
+    if (hasHostMessageCalls) {
+      _writeProxyApiMethodHandlers(
+        indent,
+        api,
+        module: module,
+        dartPackageName: dartPackageName,
+      );
+    }
+
+    for (final (Method method, String channelMethodName) in flutterMethods) {
+      final String methodName = _getMethodName(method.name);
+      final String responseName = _getResponseName(api.name, method.name);
+      final String responseClassName = _getClassName(module, responseName);
+      final String responseMethodPrefix = _getMethodPrefix(module, responseName);
+      final bool isNewInstance = method.name == _proxyApiNewInstanceMethodName;
 
       indent.newln();
       indent.writeScoped(
@@ -1723,22 +5152,49 @@ class GObjectSourceGenerator extends StructuredGenerator<InternalGObjectOptions>
         },
       );
 
-      final asyncArgs = <String>['$className* self'];
-      for (final Parameter param in method.parameters) {
-        final String name = _snakeCaseFromCamelCase(param.name);
-        asyncArgs.add('${_getType(module, param.type)} $name');
-        if (_isNumericListType(param.type)) {
-          asyncArgs.add('size_t ${name}_length');
-        }
-      }
-      asyncArgs.addAll(<String>[
+      final asyncArgs = <String>[
+        '$className* self',
+        'GObject* pigeon_instance',
+        ..._getProxyApiParameterArgs(module, method.parameters),
         'GCancellable* cancellable',
         'GAsyncReadyCallback callback',
         'gpointer user_data',
-      ]);
+      ];
       indent.newln();
       indent.writeScoped("void ${methodPrefix}_$methodName(${asyncArgs.join(', ')}) {", '}', () {
+        indent.writeln('GTask* task = g_task_new(self, cancellable, callback, user_data);');
+        if (isNewInstance) {
+          indent.writeScoped(
+            'if (${instanceManagerMethodPrefix}_contains_instance(self->instance_manager, pigeon_instance)) {',
+            '}',
+            () {
+              indent.writeln('// Dart already has an instance, so there is nothing to send.');
+              indent.writeln('g_task_return_pointer(task, nullptr, nullptr);');
+              indent.writeln('return;');
+            },
+          );
+          indent.writeln(
+            'int64_t pigeon_identifier = ${instanceManagerMethodPrefix}_add_host_created_instance(self->instance_manager, pigeon_instance);',
+          );
+        } else {
+          indent.writeScoped(
+            'if (!${instanceManagerMethodPrefix}_contains_instance(self->instance_manager, pigeon_instance)) {',
+            '}',
+            () {
+              indent.writeln(
+                'g_task_return_new_error(task, G_IO_ERROR, G_IO_ERROR_NOT_FOUND, "Callback to %s.%s failed because the native instance was not in the instance manager", "${api.name}", "${method.name}");',
+              );
+              indent.writeln('return;');
+            },
+          );
+        }
+        indent.newln();
         indent.writeln('g_autoptr(FlValue) args = fl_value_new_list();');
+        indent.writeln(
+          isNewInstance
+              ? 'fl_value_append_take(args, fl_value_new_int(pigeon_identifier));'
+              : 'fl_value_append_take(args, fl_value_new_custom_object(${_getInstanceManagerTypeId(module)}, pigeon_instance));',
+        );
         for (final Parameter param in method.parameters) {
           final String name = _snakeCaseFromCamelCase(param.name);
           final String value = _makeFlValue(
@@ -1750,38 +5206,50 @@ class GObjectSourceGenerator extends StructuredGenerator<InternalGObjectOptions>
           );
           indent.writeln('fl_value_append_take(args, $value);');
         }
-        final String channelName = makeChannelName(api, method, dartPackageName);
+        final String channelName = makeChannelNameWithStrings(
+          apiName: api.name,
+          methodName: channelMethodName,
+          dartPackageName: dartPackageName,
+        );
         indent.writeln(
-          'g_autofree gchar* channel_name = g_strdup_printf("$channelName%s", self->suffix);',
+          'g_autoptr($codecClassName) codec = ${codecMethodPrefix}_new_with_instance_manager(self->instance_manager);',
         );
-        indent.writeln('g_autoptr($codecClassName) codec = ${codecMethodPrefix}_new();');
         indent.writeln(
-          'FlBasicMessageChannel* channel = fl_basic_message_channel_new(self->messenger, channel_name, FL_MESSAGE_CODEC(codec));',
+          'FlBasicMessageChannel* channel = fl_basic_message_channel_new(self->messenger, "$channelName", FL_MESSAGE_CODEC(codec));',
         );
-        indent.writeln('GTask* task = g_task_new(self, cancellable, callback, user_data);');
         indent.writeln('g_task_set_task_data(task, channel, g_object_unref);');
         indent.writeln(
           'fl_basic_message_channel_send(channel, args, cancellable, ${methodPrefix}_${methodName}_cb, task);',
         );
       });
 
-      final finishArgs = <String>['$className* self', 'GAsyncResult* result', 'GError** error'];
       indent.newln();
       indent.writeScoped(
-        "$responseClassName* ${methodPrefix}_${methodName}_finish(${finishArgs.join(', ')}) {",
+        '$responseClassName* ${methodPrefix}_${methodName}_finish($className* self, GAsyncResult* result, GError** error) {',
         '}',
         () {
           indent.writeln('g_autoptr(GTask) task = G_TASK(result);');
+          indent.writeScoped('if (g_task_had_error(task)) {', '}', () {
+            indent.writeln('g_task_propagate_pointer(task, error);');
+            indent.writeln('return nullptr;');
+          });
           indent.writeln(
             'GAsyncResult* r = G_ASYNC_RESULT(g_task_propagate_pointer(task, nullptr));',
           );
+          if (isNewInstance) {
+            indent.writeScoped('if (r == nullptr) {', '}', () {
+              indent.writeln('g_autoptr(FlValue) response = fl_value_new_list();');
+              indent.writeln('fl_value_append_take(response, fl_value_new_null());');
+              indent.writeln('return ${responseMethodPrefix}_new(response);');
+            });
+          }
           indent.writeln(
             'FlBasicMessageChannel* channel = FL_BASIC_MESSAGE_CHANNEL(g_task_get_task_data(task));',
           );
           indent.writeln(
             'g_autoptr(FlValue) response = fl_basic_message_channel_send_finish(channel, r, error);',
           );
-          indent.writeScoped('if (response == nullptr) { ', '}', () {
+          indent.writeScoped('if (response == nullptr) {', '}', () {
             indent.writeln('return nullptr;');
           });
           indent.writeln('return ${responseMethodPrefix}_new(response);');
@@ -1790,283 +5258,160 @@ class GObjectSourceGenerator extends StructuredGenerator<InternalGObjectOptions>
     }
   }
 
-  @override
-  void writeHostApi(
-    InternalGObjectOptions generatorOptions,
-    Root root,
+  // Writes the handlers for the messages Dart sends to a ProxyApi, and the
+  // functions that connect them.
+  void _writeProxyApiMethodHandlers(
     Indent indent,
-    Api api, {
+    AstProxyApi api, {
+    required String module,
     required String dartPackageName,
   }) {
-    final String module = _getModule(generatorOptions, dartPackageName);
     final String className = _getClassName(module, api.name);
-
     final String methodPrefix = _getMethodPrefix(module, api.name);
     final String vtableName = _getVTableName(module, api.name);
-
     final String codecClassName = _getClassName(module, _codecBaseName);
     final String codecMethodPrefix = _getMethodPrefix(module, _codecBaseName);
+    final String instanceManagerClassName = _getClassName(module, _instanceManagerBaseName);
+    final String instanceManagerMethodPrefix = _getMethodPrefix(module, _instanceManagerBaseName);
 
-    final bool hasAsyncMethod = api.methods.any((Method method) => method.isAsynchronous);
-    if (hasAsyncMethod) {
-      indent.newln();
-      _writeObjectStruct(indent, module, '${api.name}ResponseHandle', () {
-        indent.writeln('FlBasicMessageChannel* channel;');
-        indent.writeln('FlBasicMessageChannelResponseHandle* response_handle;');
-      });
-
-      indent.newln();
-      _writeDefineType(indent, module, '${api.name}ResponseHandle');
-
-      indent.newln();
-      _writeDispose(indent, module, '${api.name}ResponseHandle', () {
-        _writeCastSelf(indent, module, '${api.name}ResponseHandle', 'object');
-        indent.writeln('g_clear_object(&self->channel);');
-        indent.writeln('g_clear_object(&self->response_handle);');
-      });
-
-      indent.newln();
-      _writeInit(indent, module, '${api.name}ResponseHandle', () {});
-
-      indent.newln();
-      _writeClassInit(indent, module, '${api.name}ResponseHandle', () {});
+    // The handlers for each message, with the name of the method in the
+    // channel name.
+    final handlers = <(String, String)>[];
 
+    void writeHandler(String methodName, void Function() func) {
       indent.newln();
       indent.writeScoped(
-        'static ${className}ResponseHandle* ${methodPrefix}_response_handle_new(FlBasicMessageChannel* channel, FlBasicMessageChannelResponseHandle* response_handle) {',
+        'static void ${methodPrefix}_${methodName}_cb(FlBasicMessageChannel* channel, FlValue* message_, FlBasicMessageChannelResponseHandle* response_handle, gpointer user_data) {',
         '}',
         () {
-          _writeObjectNew(indent, module, '${api.name}ResponseHandle');
-          indent.writeln('self->channel = FL_BASIC_MESSAGE_CHANNEL(g_object_ref(channel));');
-          indent.writeln(
-            'self->response_handle = FL_BASIC_MESSAGE_CHANNEL_RESPONSE_HANDLE(g_object_ref(response_handle));',
+          _writeCastSelf(indent, module, api.name, 'user_data');
+          indent.newln();
+          indent.writeScoped(
+            'if (self->vtable == nullptr || self->vtable->$methodName == nullptr) {',
+            '}',
+            () {
+              indent.writeln('return;');
+            },
           );
-          indent.writeln('return self;');
+          indent.newln();
+          func();
         },
       );
     }
 
-    for (final Method method in api.methods) {
-      final String responseName = _getResponseName(api.name, method.name);
-      final String responseClassName = _getClassName(module, responseName);
-      final String responseMethodPrefix = _getMethodPrefix(module, responseName);
-
-      if (method.isAsynchronous) {
-        indent.newln();
-        _writeDeclareFinalType(indent, module, responseName);
-      }
-
-      indent.newln();
-      _writeObjectStruct(indent, module, responseName, () {
-        indent.writeln('FlValue* value;');
-      });
-
-      indent.newln();
-      _writeDefineType(indent, module, responseName);
-
-      indent.newln();
-      _writeDispose(indent, module, responseName, () {
-        _writeCastSelf(indent, module, responseName, 'object');
-        indent.writeln('g_clear_pointer(&self->value, fl_value_unref);');
-      });
-
-      indent.newln();
-      _writeInit(indent, module, responseName, () {});
-
-      indent.newln();
-      _writeClassInit(indent, module, responseName, () {});
-
-      final String returnType = _getType(module, method.returnType);
-      indent.newln();
-      final constructorArgs = <String>[
-        if (returnType != 'void') '$returnType return_value',
-        if (_isNumericListType(method.returnType)) 'size_t return_value_length',
-      ];
-      indent.writeScoped(
-        "${method.isAsynchronous ? 'static ' : ''}$responseClassName* ${responseMethodPrefix}_new(${constructorArgs.join(', ')}) {",
-        '}',
-        () {
-          _writeObjectNew(indent, module, responseName);
-          indent.writeln('self->value = fl_value_new_list();');
-          indent.writeln(
-            "fl_value_append_take(self->value, ${_makeFlValue(root, module, method.returnType, 'return_value', lengthVariableName: 'return_value_length')});",
-          );
-          indent.writeln('return self;');
-        },
-      );
-
-      indent.newln();
+    void writeRespond(String methodName, String value) {
+      indent.writeln('g_autoptr(GError) error = NULL;');
       indent.writeScoped(
-        '${method.isAsynchronous ? 'static ' : ''}$responseClassName* ${responseMethodPrefix}_new_error(const gchar* code, const gchar* message, FlValue* details) {',
+        'if (!fl_basic_message_channel_respond(channel, response_handle, $value, &error)) {',
         '}',
         () {
-          _writeObjectNew(indent, module, responseName);
-          indent.writeln('self->value = fl_value_new_list();');
-          indent.writeln('fl_value_append_take(self->value, fl_value_new_string(code));');
           indent.writeln(
-            'fl_value_append_take(self->value, fl_value_new_string(message != nullptr ? message : ""));',
+            'g_warning("Failed to send response to %s.%s: %s", "${api.name}", "$methodName", error->message);',
           );
-          indent.writeln(
-            'fl_value_append_take(self->value, details != nullptr ? fl_value_ref(details) : fl_value_new_null());',
-          );
-          indent.writeln('return self;');
         },
       );
     }
 
-    indent.newln();
-    _writeObjectStruct(indent, module, api.name, () {
-      indent.writeln('const ${className}VTable* vtable;');
-      indent.writeln('gpointer user_data;');
-      indent.writeln('GDestroyNotify user_data_free_func;');
-    });
-
-    indent.newln();
-    _writeDefineType(indent, module, api.name);
-
-    indent.newln();
-    _writeDispose(indent, module, api.name, () {
-      _writeCastSelf(indent, module, api.name, 'object');
-      indent.writeScoped('if (self->user_data != nullptr) {', '}', () {
-        indent.writeln('self->user_data_free_func(self->user_data);');
+    for (final Constructor constructor in api.constructors) {
+      final String channelMethodName = _getProxyApiConstructorName(constructor);
+      final String methodName = _getMethodName(channelMethodName);
+      handlers.add((methodName, channelMethodName));
+      writeHandler(methodName, () {
+        final List<String> methodArgs = _writeArgsFromMessage(indent, module, <Parameter>[
+          _getProxyApiIdentifierParameter(),
+          ...api.unattachedFields.map(
+            (ApiField field) => Parameter(name: field.name, type: field.type),
+          ),
+          ...constructor.parameters,
+        ]);
+        indent.writeln('g_autoptr(GError) create_error = nullptr;');
+        indent.writeln(
+          "g_autoptr(GObject) instance = self->vtable->$methodName(${<String>[...methodArgs.skip(1), '&create_error', 'self->user_data'].join(', ')});",
+        );
+        indent.writeln(
+          'g_autoptr(FlValue) response = ${instanceManagerMethodPrefix}_new_instance_response(self->instance_manager, instance, pigeon_identifier, create_error);',
+        );
+        writeRespond(channelMethodName, 'response');
       });
-      indent.writeln('self->user_data = nullptr;');
-    });
-
-    indent.newln();
-    _writeInit(indent, module, api.name, () {});
-
-    indent.newln();
-    _writeClassInit(indent, module, api.name, () {});
+    }
 
-    indent.newln();
-    indent.writeScoped(
-      'static $className* ${methodPrefix}_new(const $vtableName* vtable, gpointer user_data, GDestroyNotify user_data_free_func) {',
-      '}',
-      () {
-        _writeObjectNew(indent, module, api.name);
-        indent.writeln('self->vtable = vtable;');
-        indent.writeln('self->user_data = user_data;');
-        indent.writeln('self->user_data_free_func = user_data_free_func;');
-        indent.writeln('return self;');
-      },
-    );
+    for (final ApiField field in api.attachedFields) {
+      final String methodName = _getMethodName(field.name);
+      handlers.add((methodName, field.name));
+      writeHandler(methodName, () {
+        final List<String> methodArgs = _writeArgsFromMessage(indent, module, <Parameter>[
+          if (!field.isStatic) _getProxyApiInstanceParameter(api),
+          _getProxyApiIdentifierParameter(),
+        ]);
+        indent.writeln('g_autoptr(GError) create_error = nullptr;');
+        indent.writeln(
+          "g_autoptr(GObject) instance = self->vtable->$methodName(${<String>[if (!field.isStatic) methodArgs.first, '&create_error', 'self->user_data'].join(', ')});",
+        );
+        indent.writeln(
+          'g_autoptr(FlValue) response = ${instanceManagerMethodPrefix}_new_instance_response(self->instance_manager, instance, pigeon_identifier, create_error);',
+        );
+        writeRespond(field.name, 'response');
+      });
+    }
 
-    for (final Method method in api.methods) {
+    for (final Method method in api.hostMethods) {
       final String methodName = _getMethodName(method.name);
-      final String responseName = _getResponseName(api.name, method.name);
-      final String responseClassName = _getClassName(module, responseName);
-
-      indent.newln();
-      indent.writeScoped(
-        'static void ${methodPrefix}_${methodName}_cb(FlBasicMessageChannel* channel, FlValue* message_, FlBasicMessageChannelResponseHandle* response_handle, gpointer user_data) {',
-        '}',
-        () {
-          _writeCastSelf(indent, module, api.name, 'user_data');
-
-          indent.newln();
-          indent.writeScoped(
-            'if (self->vtable == nullptr || self->vtable->$methodName == nullptr) {',
-            '}',
-            () {
-              indent.writeln('return;');
-            },
-          );
-
-          indent.newln();
-          final methodArgs = <String>[];
-          for (var i = 0; i < method.parameters.length; i++) {
-            final Parameter param = method.parameters[i];
-            final String paramName = _snakeCaseFromCamelCase(param.name);
-            final String paramType = _getType(module, param.type);
-            indent.writeln('FlValue* value$i = fl_value_get_list_value(message_, $i);');
-            if (_isNullablePrimitiveType(param.type)) {
-              final String primitiveType = _getType(module, param.type, primitive: true);
-              indent.writeln('$paramType $paramName = nullptr;');
-              indent.writeln('$primitiveType ${paramName}_value;');
-              indent.writeScoped(
-                'if (fl_value_get_type(value$i) != FL_VALUE_TYPE_NULL) {',
-                '}',
-                () {
-                  final String paramValue = _fromFlValue(
-                    module,
-                    method.parameters[i].type,
-                    'value$i',
-                  );
-                  indent.writeln('${paramName}_value = $paramValue;');
-                  indent.writeln('$paramName = &${paramName}_value;');
-                },
-              );
-            } else {
-              final String paramValue = _fromFlValue(module, method.parameters[i].type, 'value$i');
-              indent.writeln('$paramType $paramName = $paramValue;');
-            }
-            methodArgs.add(paramName);
-            if (_isNumericListType(method.parameters[i].type)) {
-              indent.writeln('size_t ${paramName}_length = fl_value_get_length(value$i);');
-              methodArgs.add('${paramName}_length');
-            }
-          }
-          if (method.isAsynchronous) {
-            final vfuncArgs = <String>[];
-            vfuncArgs.addAll(methodArgs);
-            vfuncArgs.addAll(<String>['handle', 'self->user_data']);
-            indent.writeln(
-              'g_autoptr(${className}ResponseHandle) handle = ${methodPrefix}_response_handle_new(channel, response_handle);',
-            );
-            indent.writeln("self->vtable->$methodName(${vfuncArgs.join(', ')});");
-          } else {
-            final vfuncArgs = <String>[];
-            vfuncArgs.addAll(methodArgs);
-            vfuncArgs.add('self->user_data');
-            indent.writeln(
-              "g_autoptr($responseClassName) response = self->vtable->$methodName(${vfuncArgs.join(', ')});",
-            );
-            indent.writeScoped('if (response == nullptr) {', '}', () {
-              indent.writeln(
-                'g_warning("No response returned to %s.%s", "${api.name}", "${method.name}");',
-              );
-              indent.writeln('return;');
-            });
-
-            indent.newln();
-            indent.writeln('g_autoptr(GError) error = NULL;');
-            indent.writeScoped(
-              'if (!fl_basic_message_channel_respond(channel, response_handle, response->value, &error)) {',
-              '}',
-              () {
-                indent.writeln(
-                  'g_warning("Failed to send response to %s.%s: %s", "${api.name}", "${method.name}", error->message);',
-                );
-              },
-            );
-          }
-        },
+      final String responseClassName = _getClassName(
+        module,
+        _getResponseName(api.name, method.name),
       );
+      handlers.add((methodName, method.name));
+      writeHandler(methodName, () {
+        final List<String> methodArgs = _writeArgsFromMessage(indent, module, <Parameter>[
+          if (!method.isStatic) _getProxyApiInstanceParameter(api),
+          ...method.parameters,
+        ]);
+        if (method.isAsynchronous) {
+          indent.writeln(
+            'g_autoptr(${className}ResponseHandle) handle = ${methodPrefix}_response_handle_new(channel, response_handle);',
+          );
+          indent.writeln(
+            "self->vtable->$methodName(${<String>[...methodArgs, 'handle', 'self->user_data'].join(', ')});",
+          );
+          return;
+        }
+        indent.writeln(
+          "g_autoptr($responseClassName) response = self->vtable->$methodName(${<String>[...methodArgs, 'self->user_data'].join(', ')});",
+        );
+        indent.writeScoped('if (response == nullptr) {', '}', () {
+          indent.writeln(
+            'g_warning("No response returned to %s.%s", "${api.name}", "${method.name}");',
+          );
+          indent.writeln('return;');
+        });
+        indent.newln();
+        writeRespond(method.name, 'response->value');
+      });
     }
 
     indent.newln();
     indent.writeScoped(
-      'void ${methodPrefix}_set_method_handlers(FlBinaryMessenger* messenger, const gchar* suffix, const $vtableName* vtable, gpointer user_data, GDestroyNotify user_data_free_func) {',
+      'void ${methodPrefix}_set_method_handlers(FlBinaryMessenger* messenger, $instanceManagerClassName* instance_manager, const $vtableName* vtable, gpointer user_data, GDestroyNotify user_data_free_func) {',
       '}',
       () {
         indent.writeln(
-          'g_autofree gchar* dot_suffix = suffix != nullptr ? g_strdup_printf(".%s", suffix) : g_strdup("");',
+          'g_autoptr($className) api_data = ${methodPrefix}_new(messenger, instance_manager);',
         );
+        indent.writeln('api_data->vtable = vtable;');
+        indent.writeln('api_data->user_data = user_data;');
+        indent.writeln('api_data->user_data_free_func = user_data_free_func;');
+        indent.newln();
         indent.writeln(
-          'g_autoptr($className) api_data = ${methodPrefix}_new(vtable, user_data, user_data_free_func);',
+          'g_autoptr($codecClassName) codec = ${codecMethodPrefix}_new_with_instance_manager(instance_manager);',
         );
-
-        indent.newln();
-        indent.writeln('g_autoptr($codecClassName) codec = ${codecMethodPrefix}_new();');
-        for (final Method method in api.methods) {
-          final String methodName = _getMethodName(method.name);
-          final String channelName = makeChannelName(api, method, dartPackageName);
-          indent.writeln(
-            'g_autofree gchar* ${methodName}_channel_name = g_strdup_printf("$channelName%s", dot_suffix);',
+        for (final (String methodName, String channelMethodName) in handlers) {
+          final String channelName = makeChannelNameWithStrings(
+            apiName: api.name,
+            methodName: channelMethodName,
+            dartPackageName: dartPackageName,
           );
           indent.writeln(
-            'g_autoptr(FlBasicMessageChannel) ${methodName}_channel = fl_basic_message_channel_new(messenger, ${methodName}_channel_name, FL_MESSAGE_CODEC(codec));',
+            'g_autoptr(FlBasicMessageChannel) ${methodName}_channel = fl_basic_message_channel_new(messenger, "$channelName", FL_MESSAGE_CODEC(codec));',
           );
           indent.writeln(
             'fl_basic_message_channel_set_message_handler(${methodName}_channel, ${methodPrefix}_${methodName}_cb, g_object_ref(api_data), g_object_unref);',
@@ -2077,23 +5422,18 @@ class GObjectSourceGenerator extends StructuredGenerator<InternalGObjectOptions>
 
     indent.newln();
     indent.writeScoped(
-      'void ${methodPrefix}_clear_method_handlers(FlBinaryMessenger* messenger, const gchar* suffix) {',
+      'void ${methodPrefix}_clear_method_handlers(FlBinaryMessenger* messenger) {',
       '}',
       () {
-        indent.writeln(
-          'g_autofree gchar* dot_suffix = suffix != nullptr ? g_strdup_printf(".%s", suffix) : g_strdup("");',
-        );
-
-        indent.newln();
         indent.writeln('g_autoptr($codecClassName) codec = ${codecMethodPrefix}_new();');
-        for (final Method method in api.methods) {
-          final String methodName = _getMethodName(method.name);
-          final String channelName = makeChannelName(api, method, dartPackageName);
-          indent.writeln(
-            'g_autofree gchar* ${methodName}_channel_name = g_strdup_printf("$channelName%s", dot_suffix);',
+        for (final (String methodName, String channelMethodName) in handlers) {
+          final String channelName = makeChannelNameWithStrings(
+            apiName: api.name,
+            methodName: channelMethodName,
+            dartPackageName: dartPackageName,
           );
           indent.writeln(
-            'g_autoptr(FlBasicMessageChannel) ${methodName}_channel = fl_basic_message_channel_new(messenger, ${methodName}_channel_name, FL_MESSAGE_CODEC(codec));',
+            'g_autoptr(FlBasicMessageChannel) ${methodName}_channel = fl_basic_message_channel_new(messenger, "$channelName", FL_MESSAGE_CODEC(codec));',
           );
           indent.writeln(
             'fl_basic_message_channel_set_message_handler(${methodName}_channel, nullptr, nullptr, nullptr);',
@@ -2102,13 +5442,26 @@ class GObjectSourceGenerator extends StructuredGenerator<InternalGObjectOptions>
       },
     );
 
-    for (final Method method in api.methods.where((Method method) => method.isAsynchronous)) {
+    for (final Method method in api.hostMethods.where((Method method) => method.isAsynchronous)) {
       final String returnType = _getType(module, method.returnType);
       final String methodName = _getMethodName(method.name);
       final String responseName = _getResponseName(api.name, method.name);
       final String responseClassName = _getClassName(module, responseName);
       final String responseMethodPrefix = _getMethodPrefix(module, responseName);
 
+      void writeHandleRespond() {
+        indent.writeln('g_autoptr(GError) error = nullptr;');
+        indent.writeScoped(
+          'if (!fl_basic_message_channel_respond(response_handle->channel, response_handle->response_handle, response->value, &error)) {',
+          '}',
+          () {
+            indent.writeln(
+              'g_warning("Failed to send response to %s.%s: %s", "${api.name}", "${method.name}", error->message);',
+            );
+          },
+        );
+      }
+
       indent.newln();
       final respondArgs = <String>[
         '${className}ResponseHandle* response_handle',
@@ -2126,43 +5479,19 @@ class GObjectSourceGenerator extends StructuredGenerator<InternalGObjectOptions>
           indent.writeln(
             'g_autoptr($responseClassName) response = ${responseMethodPrefix}_new(${returnArgs.join(', ')});',
           );
-          indent.writeln('g_autoptr(GError) error = nullptr;');
-          indent.writeScoped(
-            'if (!fl_basic_message_channel_respond(response_handle->channel, response_handle->response_handle, response->value, &error)) {',
-            '}',
-            () {
-              indent.writeln(
-                'g_warning("Failed to send response to %s.%s: %s", "${api.name}", "${method.name}", error->message);',
-              );
-            },
-          );
+          writeHandleRespond();
         },
       );
 
       indent.newln();
-      final respondErrorArgs = <String>[
-        '${className}ResponseHandle* response_handle',
-        'const gchar* code',
-        'const gchar* message',
-        'FlValue* details',
-      ];
       indent.writeScoped(
-        "void ${methodPrefix}_respond_error_$methodName(${respondErrorArgs.join(', ')}) {",
+        'void ${methodPrefix}_respond_error_$methodName(${className}ResponseHandle* response_handle, const gchar* code, const gchar* message, FlValue* details) {',
         '}',
         () {
           indent.writeln(
             'g_autoptr($responseClassName) response = ${responseMethodPrefix}_new_error(code, message, details);',
           );
-          indent.writeln('g_autoptr(GError) error = nullptr;');
-          indent.writeScoped(
-            'if (!fl_basic_message_channel_respond(response_handle->channel, response_handle->response_handle, response->value, &error)) {',
-            '}',
-            () {
-              indent.writeln(
-                'g_warning("Failed to send response to %s.%s: %s", "${api.name}", "${method.name}", error->message);',
-              );
-            },
-          );
+          writeHandleRespond();
         },
       );
     }
@@ -2202,6 +5531,18 @@ void _writeDeclareFinalType(
   );
 }
 
+// Writes the GObject macro to declare a new type that can be subclassed.
+void _writeDeclareDerivableType(Indent indent, String module, String name) {
+  final String upperModule = _snakeCaseFromCamelCase(module).toUpperCase();
+  final String className = _getClassName(module, name);
+  final String upperSnakeClassName = _snakeCaseFromCamelCase(name).toUpperCase();
+  final String methodPrefix = _getMethodPrefix(module, name);
+
+  indent.writeln(
+    'G_DECLARE_DERIVABLE_TYPE($className, $methodPrefix, $upperModule, $upperSnakeClassName, GObject)',
+  );
+}
+
 // Writes the GObject macro to define a new type.
 void _writeDefineType(
   Indent indent,
@@ -2355,6 +5696,11 @@ String _getCustomTypeId(String module, EnumeratedType customType) {
   return customTypeId;
 }
 
+// Returns the custom type id used to encode instances in the instance manager.
+String _getInstanceManagerTypeId(String module) {
+  return '${_getMethodPrefix(module, _instanceManagerBaseName)}_type_id';
+}
+
 // Returns an enumeration value in C++ form.
 String _getEnumValue(String module, String enumName, String memberName) {
   final String snakeEnumName = _snakeCaseFromCamelCase(enumName);
@@ -2370,7 +5716,13 @@ String _getType(
   bool primitive = false,
   bool isElementType = false,
 }) {
-  if (type.isClass) {
+  if (type.isProxyApi) {
+    return 'GObject*';
+  } else if (type.isColumnar) {
+    return '${_getClassName(module, _getColumnsName(type.columnarClass!))}*';
+  } else if (type.isChunked) {
+    return 'GInputStream*';
+  } else if (type.isClass) {
     return '${_getClassName(module, type.baseName)}*';
   } else if (type.isEnum) {
     final String name = _getClassName(module, type.baseName);
@@ -2417,8 +5769,30 @@ String _getType(
   }
 }
 
+// Returns the name of the type that holds a list of the @Columnar class
+// [classDefinition] as one array per field.
+String _getColumnsName(Class classDefinition) {
+  return '${classDefinition.name}Columns';
+}
+
+// Returns the C type of an array of the values of a field of [type] in a
+// columns type, or of a single value if [isElementType] is set.
+String _getColumnType(TypeDeclaration type, {bool isElementType = false}) {
+  return switch (type.baseName) {
+    'bool' => 'const uint8_t*',
+    'int' => 'const int64_t*',
+    'double' => 'const double*',
+    _ => isElementType ? 'const gchar*' : 'const gchar* const*',
+  };
+}
+
 // Returns true if [type] is a *List typed numeric list type.
+//
+// Chunked Uint8Lists are streams, so they don't have a length.
 bool _isNumericListType(TypeDeclaration type) {
+  if (type.isChunked) {
+    return false;
+  }
   return type.baseName == 'Uint8List' ||
       type.baseName == 'Int32List' ||
       type.baseName == 'Int64List' ||
@@ -2438,6 +5812,52 @@ bool _isNullablePrimitiveType(TypeDeclaration type) {
       type.baseName == 'double';
 }
 
+// Returns the arguments of the `_new_take` constructor of [classDefinition].
+List<String> _getTakeConstructorArgs(String module, Class classDefinition) {
+  final args = <String>[];
+  for (final NamedType field in classDefinition.fields) {
+    final String fieldName = _getFieldName(field.name);
+    args.add('${_getType(module, field.type, isOutput: true)} $fieldName');
+    if (_isNumericListType(field.type)) {
+      args.add('size_t ${fieldName}_length');
+    }
+  }
+  return args;
+}
+
+// Returns code to copy the value of [field] so it can be passed to a
+// constructor that takes ownership of it.
+String _copyFieldValue(String module, NamedType field) {
+  final String fieldName = _getFieldName(field.name);
+  final String value = _referenceValue(
+    module,
+    field.type,
+    fieldName,
+    lengthVariableName: '${fieldName}_length',
+  );
+  if (value == fieldName || !field.type.isNullable) {
+    return value;
+  }
+  return '$fieldName != nullptr ? $value : nullptr';
+}
+
+// Returns true if [classDefinition] has any typed numeric list fields.
+bool _hasNumericListField(Class classDefinition) {
+  return classDefinition.fields.any((NamedType field) => _isNumericListType(field.type));
+}
+
+// Returns the FlStandardMessageCodec type code for the typed numeric list [type].
+int _getTypedDataTypeCode(TypeDeclaration type) {
+  return switch (type.baseName) {
+    'Uint8List' => 8,
+    'Int32List' => 9,
+    'Int64List' => 10,
+    'Float64List' => 11,
+    'Float32List' => 14,
+    _ => throw Exception('Unknown type ${type.baseName}'),
+  };
+}
+
 // Whether [type] is a type that needs to stay an FlValue* since it can't be
 // expressed as a more concrete type.
 bool _isFlValueWrappedType(TypeDeclaration type) {
@@ -2446,22 +5866,26 @@ bool _isFlValueWrappedType(TypeDeclaration type) {
 
 // Returns code to clear a value stored in [variableName], or null if no function required.
 String? _getClearFunction(TypeDeclaration type, String variableName) {
-  if (type.isClass) {
+  if (type.isClass || type.isProxyApi) {
     return 'g_clear_object(&$variableName)';
   } else if (_isFlValueWrappedType(type)) {
     return 'g_clear_pointer(&$variableName, fl_value_unref)';
   } else if (type.baseName == 'String') {
     return 'g_clear_pointer(&$variableName, g_free)';
-  } else if (_isNullablePrimitiveType(type)) {
-    return 'g_clear_pointer(&$variableName, g_free)';
   } else {
     return null;
   }
 }
 
+// Returns the name of the bit that records if the nullable primitive field
+// [fieldName] of a data class has a value.
+String _getPresenceName(String fieldName) {
+  return 'has_$fieldName';
+}
+
 // Returns code for the default value for [type].
 String _getDefaultValue(String module, TypeDeclaration type, {bool primitive = false}) {
-  if (type.isClass || (type.isNullable && !primitive)) {
+  if (type.isClass || type.isProxyApi || (type.isNullable && !primitive)) {
     return 'nullptr';
   } else if (type.isEnum) {
     final String enumName = _getClassName(module, type.baseName);
@@ -2494,7 +5918,9 @@ String _referenceValue(
   String variableName, {
   String? lengthVariableName,
 }) {
-  if (type.isClass) {
+  if (type.isProxyApi) {
+    return 'g_object_ref($variableName)';
+  } else if (type.isClass) {
     final String castMacro = _getClassCastMacro(module, type.baseName);
     return '$castMacro(g_object_ref($variableName))';
   } else if (_isFlValueWrappedType(type)) {
@@ -2538,9 +5964,19 @@ String _makeFlValue(
   String? lengthVariableName,
 }) {
   final String value;
-  if (type.isClass) {
+  if (type.isProxyApi) {
+    value =
+        'fl_value_new_custom_object(${_getInstanceManagerTypeId(module)}, G_OBJECT($variableName))';
+  } else if (type.isClass && type.associatedClass!.isSealed) {
+    final String methodPrefix = _getMethodPrefix(module, type.baseName);
+    value =
+        'fl_value_new_custom_object(${methodPrefix}_get_custom_type_id($variableName), G_OBJECT($variableName))';
+  } else if (type.isClass) {
     final String customTypeId = _getCustomTypeIdFromDeclaration(root, type, module);
     value = 'fl_value_new_custom_object($customTypeId, G_OBJECT($variableName))';
+  } else if (type.isColumnar) {
+    final String methodPrefix = _getMethodPrefix(module, _getColumnsName(type.columnarClass!));
+    value = 'fl_value_ref(${methodPrefix}_get_list($variableName))';
   } else if (type.isEnum) {
     final String customTypeId = _getCustomTypeIdFromDeclaration(root, type, module);
     value =
@@ -2586,7 +6022,9 @@ String _makeFlValue(
 
 // Returns code to convert the FlValue stored in [variableName] to a native data type.
 String _fromFlValue(String module, TypeDeclaration type, String variableName) {
-  if (type.isClass) {
+  if (type.isProxyApi) {
+    return 'fl_value_get_custom_value_object($variableName)';
+  } else if (type.isClass) {
     final String castMacro = _getClassCastMacro(module, type.baseName);
     return '$castMacro(fl_value_get_custom_value_object($variableName))';
   } else if (type.isEnum) {
@@ -2603,27 +6041,312 @@ String _fromFlValue(String module, TypeDeclaration type, String variableName) {
   } else if (type.baseName == 'String') {
     return 'fl_value_get_string($variableName)';
   } else if (type.baseName == 'Uint8List') {
-    return 'fl_value_get_uint8_list($variableName)';
+    return _typedListData(type, 'uint8_t', 'fl_value_get_uint8_list($variableName)');
   } else if (type.baseName == 'Int32List') {
-    return 'fl_value_get_int32_list($variableName)';
+    return _typedListData(type, 'int32_t', 'fl_value_get_int32_list($variableName)');
   } else if (type.baseName == 'Int64List') {
-    return 'fl_value_get_int64_list($variableName)';
+    return _typedListData(type, 'int64_t', 'fl_value_get_int64_list($variableName)');
   } else if (type.baseName == 'Float32List') {
     // TODO(stuartmorgan): Support Float32List.
     return 'nullptr';
   } else if (type.baseName == 'Float64List') {
-    return 'fl_value_get_float_list($variableName)';
+    return _typedListData(type, 'double', 'fl_value_get_float_list($variableName)');
   } else {
     throw Exception('Unknown type ${type.baseName}');
   }
 }
 
+// Returns code for the [data] of a typed list with [elementType] elements,
+// keeping empty lists distinct from null if [type] is nullable.
+String _typedListData(TypeDeclaration type, String elementType, String data) {
+  if (!type.isNullable) {
+    return data;
+  }
+  return 'static_cast<const $elementType*>(flpigeon_get_typed_list_data($data))';
+}
+
+// Writes code to read [parameters] from the list in `message_`, starting at
+// [argumentOffset].
+//
+// Returns the arguments to pass to the vtable function for the parameters.
+List<String> _writeArgsFromMessage(
+  Indent indent,
+  String module,
+  List<Parameter> parameters, {
+  int argumentOffset = 0,
+}) {
+  final methodArgs = <String>[];
+  for (var i = 0; i < parameters.length; i++) {
+    final Parameter param = parameters[i];
+    final String paramName = _snakeCaseFromCamelCase(param.name);
+    final String paramType = _getType(module, param.type);
+    indent.writeln('FlValue* value$i = fl_value_get_list_value(message_, ${i + argumentOffset});');
+    if (_isNullablePrimitiveType(param.type)) {
+      final String primitiveType = _getType(module, param.type, primitive: true);
+      indent.writeln('$paramType $paramName = nullptr;');
+      indent.writeln('$primitiveType ${paramName}_value;');
+      indent.writeScoped('if (fl_value_get_type(value$i) != FL_VALUE_TYPE_NULL) {', '}', () {
+        final String paramValue = _fromFlValue(module, param.type, 'value$i');
+        indent.writeln('${paramName}_value = $paramValue;');
+        indent.writeln('$paramName = &${paramName}_value;');
+      });
+    } else if (param.type.isColumnar) {
+      final String columnsName = _getColumnsName(param.type.columnarClass!);
+      indent.writeln(
+        'g_autoptr(${_getClassName(module, columnsName)}) $paramName = ${_getMethodPrefix(module, columnsName)}_new_from_list(value$i);',
+      );
+    } else if (param.type.isChunked) {
+      // Dart sends the name of the channel it serves the chunks on.
+      indent.writeln(
+        'g_autoptr(GInputStream) $paramName = G_INPUT_STREAM(${_getMethodPrefix(module, _chunkedInputStreamName)}_new(self->messenger, fl_value_get_string(value$i)));',
+      );
+    } else if (param.type.isNullable && _isNumericListType(param.type)) {
+      indent.writeln('$paramType $paramName = nullptr;');
+      indent.writeln('size_t ${paramName}_length = 0;');
+      indent.writeScoped('if (fl_value_get_type(value$i) != FL_VALUE_TYPE_NULL) {', '}', () {
+        indent.writeln('$paramName = ${_fromFlValue(module, param.type, 'value$i')};');
+        indent.writeln('${paramName}_length = fl_value_get_length(value$i);');
+      });
+    } else {
+      final String paramValue = _fromFlValue(module, param.type, 'value$i');
+      indent.writeln('$paramType $paramName = $paramValue;');
+    }
+    methodArgs.add(paramName);
+    if (_isNumericListType(param.type)) {
+      if (!param.type.isNullable) {
+        indent.writeln('size_t ${paramName}_length = fl_value_get_length(value$i);');
+      }
+      methodArgs.add('${paramName}_length');
+    }
+  }
+  return methodArgs;
+}
+
 // Returns the name of a GObject class used to send responses to [methodName].
 String _getResponseName(String name, String methodName) {
   final String upperMethodName = methodName[0].toUpperCase() + methodName.substring(1);
   return '$name${upperMethodName}Response';
 }
 
+// Returns the name of a GObject class used to send the events of [methodName].
+String _getEventSinkName(String name, String methodName) {
+  final String upperMethodName = methodName[0].toUpperCase() + methodName.substring(1);
+  return '$name${upperMethodName}EventSink';
+}
+
+// The name of the method that creates a Dart instance for an instance of a
+// ProxyApi that was created on the host.
+const String _proxyApiNewInstanceMethodName = 'pigeonNewInstance';
+
+// Returns the name of [constructor] of a ProxyApi, as used in channel names.
+String _getProxyApiConstructorName(Constructor constructor) {
+  return constructor.name.isNotEmpty
+      ? constructor.name
+      : '${classMemberNamePrefix}defaultConstructor';
+}
+
+// Returns the parameter for the instance a ProxyApi method is called on.
+Parameter _getProxyApiInstanceParameter(AstProxyApi api) {
+  return Parameter(
+    name: '${classMemberNamePrefix}instance',
+    type: TypeDeclaration(baseName: api.name, isNullable: false, associatedProxyApi: api),
+  );
+}
+
+// Returns the parameter for the identifier Dart assigns to a new instance.
+Parameter _getProxyApiIdentifierParameter() {
+  return Parameter(
+    name: '${classMemberNamePrefix}identifier',
+    type: const TypeDeclaration(baseName: 'int', isNullable: false),
+  );
+}
+
+// Returns the C arguments used to pass [parameters].
+List<String> _getProxyApiParameterArgs(String module, Iterable<NamedType> parameters) {
+  final args = <String>[];
+  for (final parameter in parameters) {
+    final String name = _snakeCaseFromCamelCase(parameter.name);
+    args.add('${_getType(module, parameter.type)} $name');
+    if (_isNumericListType(parameter.type)) {
+      args.add('size_t ${name}_length');
+    }
+  }
+  return args;
+}
+
+// Returns the methods of [api] that are called in Dart, along with the name
+// of each method in its channel name.
+//
+// Methods that Dart does not need to implement return null when they are not
+// implemented, so their return values are nullable.
+List<(Method, String)> _getProxyApiFlutterMethods(AstProxyApi api) {
+  return <(Method, String)>[
+    if (api.hasCallbackConstructor())
+      (
+        Method(
+          name: _proxyApiNewInstanceMethodName,
+          returnType: const TypeDeclaration.voidDeclaration(),
+          parameters: api.unattachedFields
+              .map((ApiField field) => Parameter(name: field.name, type: field.type))
+              .toList(),
+          location: ApiLocation.flutter,
+        ),
+        '${classMemberNamePrefix}newInstance',
+      ),
+    for (final Method method in api.flutterMethods)
+      (
+        Method(
+          name: method.name,
+          returnType: method.isRequired || method.returnType.isVoid
+              ? method.returnType
+              : TypeDeclaration(
+                  baseName: method.returnType.baseName,
+                  isNullable: true,
+                  typeArguments: method.returnType.typeArguments,
+                  associatedEnum: method.returnType.associatedEnum,
+                  associatedClass: method.returnType.associatedClass,
+                  associatedProxyApi: method.returnType.associatedProxyApi,
+                ),
+          parameters: method.parameters,
+          location: method.location,
+          isRequired: method.isRequired,
+          isAsynchronous: method.isAsynchronous,
+          documentationComments: method.documentationComments,
+        ),
+        method.name,
+      ),
+  ];
+}
+
+// Returns true if [method] is handled on the task queue of [api] rather than
+// on the main loop.
+//
+// Multiplexed APIs are excluded since the method index can only be read once
+// the message is decoded.
+bool _usesTaskQueue(Api api, Method method) {
+  return method.taskQueueType == TaskQueueType.serialBackgroundThread &&
+      !(api is AstHostApi && api.multiplexChannel);
+}
+
+// Writes the functions that run messages to [api] on its task queue.
+//
+// Each message is decoded and handled on the queue's thread, and the encoded
+// response is sent back from the main context the handlers were set on.
+void _writeTaskQueueFunctions(
+  Indent indent,
+  String module,
+  Api api, {
+  required String codecClassName,
+  required String codecMethodPrefix,
+}) {
+  final String className = _getClassName(module, api.name);
+  final String methodPrefix = _getMethodPrefix(module, api.name);
+  final String castMacro = _getClassCastMacro(module, api.name);
+  final taskName = '${className}Task';
+
+  indent.newln();
+  indent.writeScoped('static void ${methodPrefix}_task_free(gpointer data) {', '}', () {
+    indent.writeln('$taskName* task = static_cast<$taskName*>(data);');
+    indent.writeln('g_object_unref(task->api);');
+    indent.writeln('g_object_unref(task->messenger);');
+    indent.writeln('g_object_unref(task->response_handle);');
+    indent.writeln('g_bytes_unref(task->message);');
+    indent.writeln('g_clear_pointer(&task->response, g_bytes_unref);');
+    indent.writeln('g_free(task);');
+  });
+
+  indent.newln();
+  indent.writeScoped(
+    'static gboolean ${methodPrefix}_task_send_response_cb(gpointer user_data) {',
+    '}',
+    () {
+      indent.writeln('$taskName* task = static_cast<$taskName*>(user_data);');
+      indent.writeln('g_autoptr(GError) error = nullptr;');
+      indent.writeScoped(
+        'if (!fl_binary_messenger_send_response(task->messenger, task->response_handle, task->response, &error)) {',
+        '}',
+        () {
+          indent.writeln(
+            'g_warning("Failed to send response to %s: %s", "${api.name}", error->message);',
+          );
+        },
+      );
+      indent.writeln('return G_SOURCE_REMOVE;');
+    },
+  );
+
+  indent.newln();
+  indent.writeln('// Sends [response] to [task], or an empty response if it is nullptr.');
+  indent.writeln('//');
+  indent.writeln('// This can be called from any thread.');
+  indent.writeScoped(
+    'static void ${methodPrefix}_task_respond($taskName* task, FlValue* response) {',
+    '}',
+    () {
+      indent.writeScoped('if (response != nullptr) {', '}', () {
+        indent.writeln('g_autoptr($codecClassName) codec = ${codecMethodPrefix}_new();');
+        indent.writeln('g_autoptr(GError) error = nullptr;');
+        indent.writeln(
+          'task->response = fl_message_codec_encode_message(FL_MESSAGE_CODEC(codec), response, &error);',
+        );
+        indent.writeScoped('if (task->response == nullptr) {', '}', () {
+          indent.writeln(
+            'g_warning("Failed to encode response to %s: %s", "${api.name}", error->message);',
+          );
+        });
+      });
+
+      indent.newln();
+      indent.writeln('g_autoptr(GSource) source = g_idle_source_new();');
+      indent.writeln(
+        'g_source_set_callback(source, ${methodPrefix}_task_send_response_cb, task, ${methodPrefix}_task_free);',
+      );
+      indent.writeln('g_source_attach(source, task->api->context);');
+    },
+  );
+
+  indent.newln();
+  indent.writeScoped(
+    'static void ${methodPrefix}_task_run(gpointer data, gpointer user_data) {',
+    '}',
+    () {
+      indent.writeln('$taskName* task = static_cast<$taskName*>(data);');
+      indent.writeln('g_autoptr($codecClassName) codec = ${codecMethodPrefix}_new();');
+      indent.writeln('g_autoptr(GError) error = nullptr;');
+      indent.writeln(
+        'g_autoptr(FlValue) message_ = fl_message_codec_decode_message(FL_MESSAGE_CODEC(codec), task->message, &error);',
+      );
+      indent.writeScoped('if (message_ == nullptr) {', '}', () {
+        indent.writeln(
+          'g_warning("Failed to decode message to %s: %s", "${api.name}", error->message);',
+        );
+        indent.writeln('${methodPrefix}_task_respond(task, nullptr);');
+        indent.writeln('return;');
+      });
+
+      indent.newln();
+      indent.writeln('task->handler(task, message_);');
+    },
+  );
+
+  indent.newln();
+  indent.writeScoped(
+    'static void ${methodPrefix}_queue_task($className* self, FlBinaryMessenger* messenger, FlBinaryMessengerResponseHandle* response_handle, GBytes* message, void (*handler)($taskName* task, FlValue* message_)) {',
+    '}',
+    () {
+      indent.writeln('$taskName* task = g_new0($taskName, 1);');
+      indent.writeln('task->api = $castMacro(g_object_ref(self));');
+      indent.writeln('task->messenger = FL_BINARY_MESSENGER(g_object_ref(messenger));');
+      indent.writeln(
+        'task->response_handle = FL_BINARY_MESSENGER_RESPONSE_HANDLE(g_object_ref(response_handle));',
+      );
+      indent.writeln('task->message = g_bytes_ref(message);');
+      indent.writeln('task->handler = handler;');
+      indent.writeln('g_thread_pool_push(self->task_queue, task, nullptr);');
+    },
+  );
+}
+
 void _writeHashHelpers(Indent indent) {
   indent.writeScoped('static guint G_GNUC_UNUSED flpigeon_hash_double(double v) {', '}', () {
     indent.writeScoped('if (std::isnan(v)) {', '}', () {
@@ -2645,7 +6368,30 @@ void _writeHashHelpers(Indent indent) {
   );
 }
 
+// The number of entries above which maps are compared using a hash table
+// rather than by comparing every pair of keys.
+const int _deepEqualsMapHashThreshold = 8;
+
 void _writeDeepEquals(Indent indent) {
+  indent.writeln('static gboolean G_GNUC_UNUSED flpigeon_deep_equals(FlValue* a, FlValue* b);');
+  indent.writeScoped(
+    'static guint G_GNUC_UNUSED flpigeon_deep_hash_cb(gconstpointer value) {',
+    '}',
+    () {
+      indent.writeln(
+        'return flpigeon_deep_hash(static_cast<FlValue*>(const_cast<gpointer>(value)));',
+      );
+    },
+  );
+  indent.writeScoped(
+    'static gboolean G_GNUC_UNUSED flpigeon_deep_equals_cb(gconstpointer a, gconstpointer b) {',
+    '}',
+    () {
+      indent.writeln(
+        'return flpigeon_deep_equals(static_cast<FlValue*>(const_cast<gpointer>(a)), static_cast<FlValue*>(const_cast<gpointer>(b)));',
+      );
+    },
+  );
   indent.writeScoped(
     'static gboolean G_GNUC_UNUSED flpigeon_deep_equals(FlValue* a, FlValue* b) {',
     '}',
@@ -2721,27 +6467,52 @@ void _writeDeepEquals(Indent indent) {
         indent.writeln('  if (len != fl_value_get_length(b)) {');
         indent.writeln('    return FALSE;');
         indent.writeln('  }');
-        indent.writeScoped('  for (size_t i = 0; i < len; i++) {', '}', () {
-          indent.writeln('FlValue* key = fl_value_get_map_key(a, i);');
-          indent.writeln('FlValue* val = fl_value_get_map_value(a, i);');
-          indent.writeln('gboolean found = FALSE;');
-          indent.writeScoped('for (size_t j = 0; j < len; j++) {', '}', () {
-            indent.writeln('FlValue* b_key = fl_value_get_map_key(b, j);');
-            indent.writeScoped('if (flpigeon_deep_equals(key, b_key)) {', '}', () {
-              indent.writeln('FlValue* b_val = fl_value_get_map_value(b, j);');
-              indent.writeln('if (flpigeon_deep_equals(val, b_val)) {');
-              indent.nest(1, () {
-                indent.writeln('found = TRUE;');
-                indent.writeln('break;');
-              });
-              indent.writeln('} else {');
-              indent.nest(1, () {
-                indent.writeln('return FALSE;');
+        indent.writeln('  // Small maps are compared pair by pair, larger maps by looking up');
+        indent.writeln('  // each key in a hash table of the entries in b.');
+        indent.writeScoped('  if (len <= $_deepEqualsMapHashThreshold) {', '}', () {
+          indent.writeScoped('for (size_t i = 0; i < len; i++) {', '}', () {
+            indent.writeln('FlValue* key = fl_value_get_map_key(a, i);');
+            indent.writeln('FlValue* val = fl_value_get_map_value(a, i);');
+            indent.writeln('gboolean found = FALSE;');
+            indent.writeScoped('for (size_t j = 0; j < len; j++) {', '}', () {
+              indent.writeln('FlValue* b_key = fl_value_get_map_key(b, j);');
+              indent.writeScoped('if (flpigeon_deep_equals(key, b_key)) {', '}', () {
+                indent.writeln('FlValue* b_val = fl_value_get_map_value(b, j);');
+                indent.writeln('if (flpigeon_deep_equals(val, b_val)) {');
+                indent.nest(1, () {
+                  indent.writeln('found = TRUE;');
+                  indent.writeln('break;');
+                });
+                indent.writeln('} else {');
+                indent.nest(1, () {
+                  indent.writeln('return FALSE;');
+                });
+                indent.writeln('}');
               });
-              indent.writeln('}');
             });
+            indent.writeln('if (!found) {');
+            indent.writeln('  return FALSE;');
+            indent.writeln('}');
           });
-          indent.writeln('if (!found) {');
+          indent.writeln('return TRUE;');
+        });
+        indent.writeln(
+          '  g_autoptr(GHashTable) b_entries = g_hash_table_new(flpigeon_deep_hash_cb, flpigeon_deep_equals_cb);',
+        );
+        indent.writeln('  // Inserted last to first, so the first of any equal keys is used.');
+        indent.writeScoped('  for (size_t i = len; i > 0; i--) {', '}', () {
+          indent.writeln(
+            'g_hash_table_insert(b_entries, fl_value_get_map_key(b, i - 1), fl_value_get_map_value(b, i - 1));',
+          );
+        });
+        indent.writeScoped('  for (size_t i = 0; i < len; i++) {', '}', () {
+          indent.writeln('gpointer b_val;');
+          indent.writeln(
+            'if (!g_hash_table_lookup_extended(b_entries, fl_value_get_map_key(a, i), nullptr, &b_val) ||',
+          );
+          indent.writeln(
+            '    !flpigeon_deep_equals(fl_value_get_map_value(a, i), static_cast<FlValue*>(b_val))) {',
+          );
           indent.writeln('  return FALSE;');
           indent.writeln('}');
         });
@@ -2943,12 +6714,212 @@ static gchar* G_GNUC_UNUSED flpigeon_to_string(FlValue* value) {
 ''');
 }
 
+// Writes helpers that encode values directly into a buffer, in the same format
+// as FlStandardMessageCodec.
+void _writeEncodeHelpers(Indent indent) {
+  indent.format(r'''
+static void G_GNUC_UNUSED flpigeon_write_uint8(GByteArray* buffer, uint8_t value) {
+  g_byte_array_append(buffer, &value, sizeof(uint8_t));
+}
+static void G_GNUC_UNUSED flpigeon_write_alignment(GByteArray* buffer, size_t alignment) {
+  while (buffer->len % alignment != 0) {
+    flpigeon_write_uint8(buffer, 0);
+  }
+}
+static void G_GNUC_UNUSED flpigeon_write_null(GByteArray* buffer) {
+  flpigeon_write_uint8(buffer, 0);
+}
+static void G_GNUC_UNUSED flpigeon_write_bool(GByteArray* buffer, gboolean value) {
+  flpigeon_write_uint8(buffer, value ? 1 : 2);
+}
+static void G_GNUC_UNUSED flpigeon_write_int(GByteArray* buffer, int64_t value) {
+  if (value >= INT32_MIN && value <= INT32_MAX) {
+    int32_t value32 = static_cast<int32_t>(value);
+    flpigeon_write_uint8(buffer, 3);
+    g_byte_array_append(buffer, reinterpret_cast<uint8_t*>(&value32), sizeof(int32_t));
+  } else {
+    flpigeon_write_uint8(buffer, 4);
+    g_byte_array_append(buffer, reinterpret_cast<uint8_t*>(&value), sizeof(int64_t));
+  }
+}
+static void G_GNUC_UNUSED flpigeon_write_double(GByteArray* buffer, double value) {
+  flpigeon_write_uint8(buffer, 6);
+  flpigeon_write_alignment(buffer, 8);
+  g_byte_array_append(buffer, reinterpret_cast<uint8_t*>(&value), sizeof(double));
+}
+static void G_GNUC_UNUSED flpigeon_write_string(FlStandardMessageCodec* codec, GByteArray* buffer, const gchar* value) {
+  size_t length = strlen(value);
+  flpigeon_write_uint8(buffer, 7);
+  fl_standard_message_codec_write_size(codec, buffer, length);
+  g_byte_array_append(buffer, reinterpret_cast<const uint8_t*>(value), length);
+}
+static void G_GNUC_UNUSED flpigeon_write_typed_list(FlStandardMessageCodec* codec, GByteArray* buffer, uint8_t type, const void* data, size_t length, size_t element_size) {
+  flpigeon_write_uint8(buffer, type);
+  fl_standard_message_codec_write_size(codec, buffer, length);
+  flpigeon_write_alignment(buffer, element_size);
+  g_byte_array_append(buffer, static_cast<const uint8_t*>(data), length * element_size);
+}
+static void G_GNUC_UNUSED flpigeon_write_uint8_list(FlStandardMessageCodec* codec, GByteArray* buffer, const uint8_t* value, size_t length) {
+  flpigeon_write_typed_list(codec, buffer, 8, value, length, sizeof(uint8_t));
+}
+static void G_GNUC_UNUSED flpigeon_write_int32_list(FlStandardMessageCodec* codec, GByteArray* buffer, const int32_t* value, size_t length) {
+  flpigeon_write_typed_list(codec, buffer, 9, value, length, sizeof(int32_t));
+}
+static void G_GNUC_UNUSED flpigeon_write_int64_list(FlStandardMessageCodec* codec, GByteArray* buffer, const int64_t* value, size_t length) {
+  flpigeon_write_typed_list(codec, buffer, 10, value, length, sizeof(int64_t));
+}
+static void G_GNUC_UNUSED flpigeon_write_float_list(FlStandardMessageCodec* codec, GByteArray* buffer, const double* value, size_t length) {
+  flpigeon_write_typed_list(codec, buffer, 11, value, length, sizeof(double));
+}
+static void G_GNUC_UNUSED flpigeon_write_float32_list(FlStandardMessageCodec* codec, GByteArray* buffer, const float* value, size_t length) {
+  flpigeon_write_typed_list(codec, buffer, 14, value, length, sizeof(float));
+}
+static void G_GNUC_UNUSED flpigeon_write_list_header(FlStandardMessageCodec* codec, GByteArray* buffer, size_t length) {
+  flpigeon_write_uint8(buffer, 12);
+  fl_standard_message_codec_write_size(codec, buffer, length);
+}
+static void G_GNUC_UNUSED flpigeon_write_enum(GByteArray* buffer, uint8_t type, int64_t value) {
+  flpigeon_write_uint8(buffer, type);
+  flpigeon_write_int(buffer, value);
+}
+''');
+}
+
+// Writes helpers that decode data class fields directly from a buffer, in the
+// same format as FlStandardMessageCodec.
+void _writeDecodeHelpers(Indent indent) {
+  indent.format(r'''
+static gboolean G_GNUC_UNUSED flpigeon_read_uint8(GBytes* buffer, size_t* offset, uint8_t* value, GError** error) {
+  size_t size;
+  const uint8_t* data = static_cast<const uint8_t*>(g_bytes_get_data(buffer, &size));
+  if (*offset >= size) {
+    g_set_error(error, FL_MESSAGE_CODEC_ERROR, FL_MESSAGE_CODEC_ERROR_OUT_OF_DATA, "Unexpected end of data");
+    return FALSE;
+  }
+  *value = data[*offset];
+  (*offset)++;
+  return TRUE;
+}
+static gboolean G_GNUC_UNUSED flpigeon_read_list_header(FlStandardMessageCodec* codec, GBytes* buffer, size_t* offset, uint32_t min_length, uint32_t* length, GError** error) {
+  uint8_t type;
+  if (!flpigeon_read_uint8(buffer, offset, &type, error)) {
+    return FALSE;
+  }
+  if (type != 12) {
+    g_set_error(error, FL_MESSAGE_CODEC_ERROR, FL_MESSAGE_CODEC_ERROR_FAILED, "Expected list, got type %d", type);
+    return FALSE;
+  }
+  if (!fl_standard_message_codec_read_size(codec, buffer, offset, length, error)) {
+    return FALSE;
+  }
+  if (*length < min_length) {
+    g_set_error(error, FL_MESSAGE_CODEC_ERROR, FL_MESSAGE_CODEC_ERROR_FAILED, "Expected list of at least %u values, got %u", min_length, *length);
+    return FALSE;
+  }
+  return TRUE;
+}
+static gboolean G_GNUC_UNUSED flpigeon_skip_values(FlStandardMessageCodec* codec, GBytes* buffer, size_t* offset, uint32_t count, GError** error) {
+  for (uint32_t i = 0; i < count; i++) {
+    g_autoptr(FlValue) value = fl_standard_message_codec_read_value(codec, buffer, offset, error);
+    if (value == nullptr) {
+      return FALSE;
+    }
+  }
+  return TRUE;
+}
+static gboolean G_GNUC_UNUSED flpigeon_read_typed_data(FlStandardMessageCodec* codec, GBytes* buffer, size_t* offset, uint8_t expected_type, size_t element_size, gboolean nullable, GBytes** value, GError** error) {
+  uint8_t type;
+  if (!flpigeon_read_uint8(buffer, offset, &type, error)) {
+    return FALSE;
+  }
+  if (type == 0 && nullable) {
+    *value = nullptr;
+    return TRUE;
+  }
+  if (type != expected_type) {
+    g_set_error(error, FL_MESSAGE_CODEC_ERROR, FL_MESSAGE_CODEC_ERROR_FAILED, "Expected typed data of type %d, got type %d", expected_type, type);
+    return FALSE;
+  }
+  uint32_t length;
+  if (!fl_standard_message_codec_read_size(codec, buffer, offset, &length, error)) {
+    return FALSE;
+  }
+  while (*offset % element_size != 0) {
+    (*offset)++;
+  }
+  size_t data_size = static_cast<size_t>(length) * element_size;
+  if (*offset + data_size > g_bytes_get_size(buffer)) {
+    g_set_error(error, FL_MESSAGE_CODEC_ERROR, FL_MESSAGE_CODEC_ERROR_OUT_OF_DATA, "Unexpected end of data");
+    return FALSE;
+  }
+  *value = g_bytes_new_from_bytes(buffer, *offset, data_size);
+  *offset += data_size;
+  return TRUE;
+}
+static gboolean G_GNUC_UNUSED flpigeon_read_typed_list(FlStandardMessageCodec* codec, GBytes* buffer, size_t* offset, uint8_t expected_type, size_t element_size, gboolean nullable, gpointer* value, size_t* length, GError** error) {
+  g_autoptr(GBytes) data = nullptr;
+  if (!flpigeon_read_typed_data(codec, buffer, offset, expected_type, element_size, nullable, &data, error)) {
+    return FALSE;
+  }
+  if (data == nullptr) {
+    *value = nullptr;
+    *length = 0;
+    return TRUE;
+  }
+  size_t data_size;
+  gconstpointer d = g_bytes_get_data(data, &data_size);
+  // Empty lists are allocated too, so they are distinct from null.
+  *value = g_malloc(data_size > 0 ? data_size : 1);
+  memcpy(*value, d, data_size);
+  *length = data_size / element_size;
+  return TRUE;
+}
+static gboolean G_GNUC_UNUSED flpigeon_read_string(FlStandardMessageCodec* codec, GBytes* buffer, size_t* offset, gboolean nullable, gchar** value, GError** error) {
+  uint8_t type;
+  if (!flpigeon_read_uint8(buffer, offset, &type, error)) {
+    return FALSE;
+  }
+  if (type == 0 && nullable) {
+    *value = nullptr;
+    return TRUE;
+  }
+  if (type != 7) {
+    g_set_error(error, FL_MESSAGE_CODEC_ERROR, FL_MESSAGE_CODEC_ERROR_FAILED, "Expected string, got type %d", type);
+    return FALSE;
+  }
+  uint32_t length;
+  if (!fl_standard_message_codec_read_size(codec, buffer, offset, &length, error)) {
+    return FALSE;
+  }
+  size_t size;
+  const uint8_t* data = static_cast<const uint8_t*>(g_bytes_get_data(buffer, &size));
+  if (*offset + length > size) {
+    g_set_error(error, FL_MESSAGE_CODEC_ERROR, FL_MESSAGE_CODEC_ERROR_OUT_OF_DATA, "Unexpected end of data");
+    return FALSE;
+  }
+  *value = g_strndup(reinterpret_cast<const gchar*>(data + *offset), length);
+  *offset += length;
+  return TRUE;
+}
+// FlValue has no data for an empty typed list, so empty lists point at a
+// buffer of their own to keep them distinct from null.
+static gconstpointer G_GNUC_UNUSED flpigeon_get_typed_list_data(gconstpointer data) {
+  static const int64_t empty = 0;
+  return data != nullptr ? data : &empty;
+}
+''');
+}
+
 void _writeAppendValueOrNull(
   Indent indent, {
   required String fieldName,
+  bool isInline = false,
   required void Function() nonNullBuilder,
 }) {
-  indent.writeScoped('if (self->$fieldName != nullptr) {', '}', nonNullBuilder);
+  final condition = isInline
+      ? 'self->${_getPresenceName(fieldName)}'
+      : 'self->$fieldName != nullptr';
+  indent.writeScoped('if ($condition) {', '}', nonNullBuilder);
   indent.writeScoped('else {', '}', () {
     indent.writeln('g_string_append(str, "null");');
   });
@@ -97,6 +97,7 @@ class HostApi {
   /// Parametric constructor for [HostApi].
   const HostApi({
     @Deprecated('Mock/fake the generated Dart API instead.') this.dartHostTestHandler,
+    this.multiplexChannel = false,
   });
 
   /// The name of an interface generated for tests. Implement this
@@ -114,6 +115,16 @@ class HostApi {
   /// Defaults to `null` in which case no handler will be generated.
   @Deprecated('Mock/fake the generated Dart API instead.')
   final String? dartHostTestHandler;
+
+  /// Whether all methods of this API share a single platform channel.
+  ///
+  /// By default each method is registered on its own channel. When this is
+  /// `true`, calls are sent on one channel named after the API and carry the
+  /// index of the method as the first element of the message, which reduces
+  /// the number of channels that need to be registered at startup.
+  ///
+  /// Currently only supported by the Dart and GObject generators.
+  final bool multiplexChannel;
 }
 
 /// Metadata to annotate a Pigeon API implemented by Flutter.
@@ -180,13 +191,24 @@ class ProxyApi {
 /// defined return type of the method definition.
 class EventChannelApi {
   /// Constructor.
-  const EventChannelApi({this.kotlinOptions, this.swiftOptions});
+  const EventChannelApi({
+    this.kotlinOptions,
+    this.swiftOptions,
+    this.gobjectOptions,
+    this.cppOptions,
+  });
 
   /// Options for Kotlin generated code for Event Channels.
   final KotlinEventChannelOptions? kotlinOptions;
 
   /// Options for Swift generated code for Event Channels.
   final SwiftEventChannelOptions? swiftOptions;
+
+  /// Options for GObject generated code for Event Channels.
+  final GObjectEventChannelOptions? gobjectOptions;
+
+  /// Options for C++ generated code for Event Channels.
+  final CppEventChannelOptions? cppOptions;
 }
 
 /// Metadata to annotation methods to control the selector used for objc output.
@@ -222,6 +244,47 @@ class SwiftClass {
   const SwiftClass();
 }
 
+/// Metadata to annotate data classes whose lists are sent column by column.
+///
+/// When a `List` of the class is an argument or return value of a [HostApi] or
+/// [FlutterApi] method, it is sent as one typed list per field rather than as
+/// a list of objects. The C++ and GObject generators expose it as a columns
+/// type with an accessor for each field, so that the rows can be read without
+/// creating an object for each of them.
+///
+/// The fields of the class must be non-nullable `bool`, `int`, `double` or
+/// `String` values, and the lists must be non-nullable with non-nullable
+/// elements. Lists in other places, such as the fields of data classes, are
+/// sent as a list of objects.
+///
+/// Currently only supported by the Dart, C++ and GObject generators.
+class Columnar {
+  /// Constructor.
+  const Columnar();
+}
+
+/// Metadata to annotate [HostApi] methods whose `Uint8List` arguments and
+/// return value are sent in chunks rather than in a single message.
+///
+/// The host reads each argument as a stream, which requests the next chunk of
+/// at most [chunkSize] bytes from Dart when it needs it, and returns a stream
+/// that Dart reads the same way. This keeps the memory the host needs for a
+/// large payload to about one chunk, rather than several copies of the whole
+/// payload. In C++ the streams are `ByteStreamReader`s, and in GObject they are
+/// `GInputStream`s.
+///
+/// The method must be `@async`, and its `Uint8List` arguments and return value
+/// must be non-nullable.
+///
+/// Currently only supported by the Dart, C++ and GObject generators.
+class ChunkedBytes {
+  /// Constructor.
+  const ChunkedBytes({this.chunkSize = 65536});
+
+  /// The maximum number of bytes sent in one message.
+  final int chunkSize;
+}
+
 /// Metadata annotation to control how handlers are dispatched for HostApi's.
 /// Note that the TaskQueue API might not be available on the target version of
 /// Flutter, see also:
@@ -216,6 +216,30 @@ void _errorOnSealedClass(List<Error> errors, String generator, Root root) {
   }
 }
 
+void _errorOnMultiplexedHostApi(List<Error> errors, String generator, Root root) {
+  if (root.apis.any((Api api) => api is AstHostApi && api.multiplexChannel)) {
+    errors.add(Error(message: '$generator does not support multiplexed HostApi channels'));
+  }
+}
+
+void _errorOnColumnarList(List<Error> errors, String generator, Root root) {
+  if (root.apis.any(
+    (Api api) => api.methods.any(
+      (Method method) =>
+          method.returnType.isColumnar ||
+          method.parameters.any((Parameter parameter) => parameter.type.isColumnar),
+    ),
+  )) {
+    errors.add(Error(message: '$generator does not support lists of @Columnar classes'));
+  }
+}
+
+void _errorOnChunkedBytes(List<Error> errors, String generator, Root root) {
+  if (root.apis.any((Api api) => api.methods.any((Method method) => method.chunkSize != null))) {
+    errors.add(Error(message: '$generator does not support @ChunkedBytes methods'));
+  }
+}
+
 void _errorOnInheritedClass(List<Error> errors, String generator, Root root) {
   if (root.classes.any((Class element) => element.superClass != null)) {
     errors.add(Error(message: '$generator does not support inheritance in classes'));
@@ -350,6 +374,9 @@ class ObjcGeneratorAdapter implements GeneratorAdapter {
     _errorOnEventChannelApi(errors, languageString, root);
     _errorOnSealedClass(errors, languageString, root);
     _errorOnInheritedClass(errors, languageString, root);
+    _errorOnMultiplexedHostApi(errors, languageString, root);
+    _errorOnColumnarList(errors, languageString, root);
+    _errorOnChunkedBytes(errors, languageString, root);
     return errors;
   }
 }
@@ -384,6 +411,9 @@ class JavaGeneratorAdapter implements GeneratorAdapter {
     _errorOnEventChannelApi(errors, languageString, root);
     _errorOnSealedClass(errors, languageString, root);
     _errorOnInheritedClass(errors, languageString, root);
+    _errorOnMultiplexedHostApi(errors, languageString, root);
+    _errorOnColumnarList(errors, languageString, root);
+    _errorOnChunkedBytes(errors, languageString, root);
     return errors;
   }
 }
@@ -427,6 +457,9 @@ class SwiftGeneratorAdapter implements GeneratorAdapter {
         }
       }
     }
+    _errorOnMultiplexedHostApi(errors, languageString, root);
+    _errorOnColumnarList(errors, languageString, root);
+    _errorOnChunkedBytes(errors, languageString, root);
     return errors;
   }
 }
@@ -467,9 +500,24 @@ class CppGeneratorAdapter implements GeneratorAdapter {
   @override
   List<Error> validate(InternalPigeonOptions options, Root root) {
     final errors = <Error>[];
-    _errorOnEventChannelApi(errors, languageString, root);
     _errorOnSealedClass(errors, languageString, root);
     _errorOnInheritedClass(errors, languageString, root);
+    _errorOnMultiplexedHostApi(errors, languageString, root);
+    for (final AstEventChannelApi api in root.apis.whereType<AstEventChannelApi>()) {
+      final CppEventChannelOptions? cppOptions = api.cppOptions;
+      if (cppOptions != null &&
+          (cppOptions.maxBatchSize < 1 ||
+              cppOptions.maxQueuedEvents < 0 ||
+              (cppOptions.maxQueuedEvents > 0 &&
+                  cppOptions.maxQueuedEvents < cppOptions.maxBatchSize))) {
+        errors.add(
+          Error(
+            message:
+                'Invalid C++ event channel options for ${api.name}: maxBatchSize must be at least 1 and maxQueuedEvents must be 0 or at least maxBatchSize.',
+          ),
+        );
+      }
+    }
     return errors;
   }
 }
@@ -520,9 +568,32 @@ class GObjectGeneratorAdapter implements GeneratorAdapter {
         ),
       );
     }
-    _errorOnEventChannelApi(errors, languageString, root);
-    _errorOnSealedClass(errors, languageString, root);
-    _errorOnInheritedClass(errors, languageString, root);
+    // Sealed classes are only supported as the type of API values, since
+    // equality and encoding of fields would need to dispatch on the subclass.
+    for (final Class classDefinition in root.classes) {
+      for (final NamedType field in classDefinition.fields) {
+        if (field.type.associatedClass?.isSealed ?? false) {
+          errors.add(
+            Error(
+              message:
+                  '$languageString does not support fields of sealed class types, found in ${classDefinition.name}.${field.name}',
+            ),
+          );
+        }
+      }
+    }
+    for (final AstEventChannelApi api in root.apis.whereType<AstEventChannelApi>()) {
+      final GObjectEventChannelOptions? gobjectOptions = api.gobjectOptions;
+      if (gobjectOptions != null &&
+          (gobjectOptions.maxBatchSize < 1 || gobjectOptions.maxBatchLatencyMilliseconds < 0)) {
+        errors.add(
+          Error(
+            message:
+                'Invalid batching options for ${api.name}: maxBatchSize must be at least 1 and maxBatchLatencyMilliseconds must not be negative.',
+          ),
+        );
+      }
+    }
 
     return errors;
   }
@@ -533,6 +604,9 @@ class KotlinGeneratorAdapter implements GeneratorAdapter {
   /// Constructor for [KotlinGeneratorAdapter].
   const KotlinGeneratorAdapter();
 
+  /// A string representing the name of the language being generated.
+  static const String languageString = 'Kotlin';
+
   @override
   List<FileType> get fileTypeList => const <FileType>[FileType.na];
 
@@ -555,7 +629,13 @@ class KotlinGeneratorAdapter implements GeneratorAdapter {
       _openSink(options.kotlinOptions?.kotlinOut, basePath: options.basePath ?? '');
 
   @override
-  List<Error> validate(InternalPigeonOptions options, Root root) => <Error>[];
+  List<Error> validate(InternalPigeonOptions options, Root root) {
+    final errors = <Error>[];
+    _errorOnMultiplexedHostApi(errors, languageString, root);
+    _errorOnColumnarList(errors, languageString, root);
+    _errorOnChunkedBytes(errors, languageString, root);
+    return errors;
+  }
 }
 
 dart_ast.Annotation? _findMetadata(dart_ast.NodeList<dart_ast.Annotation> metadata, String query) {
@@ -569,11 +649,98 @@ bool _hasMetadata(dart_ast.NodeList<dart_ast.Annotation> metadata, String query)
   return _findMetadata(metadata, query) != null;
 }
 
+/// Returns true if [type] is a list of a `@Columnar` class that HostApi and
+/// FlutterApi methods send as columns.
+bool _isColumnarList(TypeDeclaration type) {
+  return type.baseName == 'List' &&
+      !type.isNullable &&
+      type.typeArguments.length == 1 &&
+      !type.typeArguments.first.isNullable &&
+      (type.typeArguments.first.associatedClass?.isColumnar ?? false);
+}
+
+/// Returns true if [type] is a list of a `@Columnar` class that can't be sent
+/// as columns because the list or its elements are nullable.
+bool _isNullableColumnarList(TypeDeclaration type) {
+  return type.baseName == 'List' &&
+      !type.isColumnar &&
+      type.typeArguments.length == 1 &&
+      (type.typeArguments.first.associatedClass?.isColumnar ?? false);
+}
+
+/// Returns true if [type] is a `Uint8List` that a `@ChunkedBytes` HostApi
+/// method sends in chunks.
+bool _isChunkableBytes(TypeDeclaration type) {
+  return type.baseName == 'Uint8List' && !type.isNullable;
+}
+
+/// The types of the fields of a `@Columnar` class.
+const Set<String> _columnarFieldTypes = <String>{'bool', 'int', 'double', 'String'};
+
 extension _ObjectAs on Object {
   /// A convenience for chaining calls with casts.
   T? asNullable<T>() => this as T?;
 }
 
+/// Validates the `@ChunkedBytes` [method] of [api].
+List<Error> _validateChunkedBytesMethod(Api api, Method method, String source) {
+  final result = <Error>[];
+  final int? lineNumber = _calculateLineNumberNullable(source, method.offset);
+  final location = 'in method "${method.name}" in API: "${api.name}"';
+  if (api is! AstHostApi) {
+    result.add(
+      Error(
+        message: '@ChunkedBytes is only supported on HostApi methods, $location',
+        lineNumber: lineNumber,
+      ),
+    );
+    return result;
+  }
+  if (!method.isAsynchronous) {
+    result.add(
+      Error(message: '@ChunkedBytes methods must be @async, $location', lineNumber: lineNumber),
+    );
+  }
+  if (method.taskQueueType == TaskQueueType.serialBackgroundThread) {
+    result.add(
+      Error(
+        message:
+            '@ChunkedBytes methods cannot use TaskQueueType.serialBackgroundThread, $location',
+        lineNumber: lineNumber,
+      ),
+    );
+  }
+  if (method.chunkSize! <= 0) {
+    result.add(
+      Error(
+        message: 'The chunkSize of @ChunkedBytes must be positive, $location',
+        lineNumber: lineNumber,
+      ),
+    );
+  }
+  final types = <TypeDeclaration>[
+    method.returnType,
+    ...method.parameters.map((Parameter parameter) => parameter.type),
+  ];
+  if (types.any((TypeDeclaration type) => type.baseName == 'Uint8List' && type.isNullable)) {
+    result.add(
+      Error(
+        message:
+            'The Uint8List arguments and return value of @ChunkedBytes methods must be non-nullable, $location',
+        lineNumber: lineNumber,
+      ),
+    );
+  } else if (!types.any((TypeDeclaration type) => type.isChunked)) {
+    result.add(
+      Error(
+        message: '@ChunkedBytes methods must take or return a Uint8List, $location',
+        lineNumber: lineNumber,
+      ),
+    );
+  }
+  return result;
+}
+
 List<Error> _validateAst(Root root, String source) {
   final result = <Error>[];
   final List<String> customClasses = root.classes.map((Class x) => x.name).toList();
@@ -667,6 +834,31 @@ List<Error> _validateAst(Root root, String source) {
     }
   }
 
+  for (final Class classDefinition in root.classes.where((Class x) => x.isColumnar)) {
+    if (classDefinition.isSealed || classDefinition.superClass != null) {
+      result.add(
+        Error(
+          message:
+              '@Columnar class "${classDefinition.name}" must not be sealed or extend another class.',
+        ),
+      );
+    }
+    if (classDefinition.fields.isEmpty) {
+      result.add(Error(message: '@Columnar class "${classDefinition.name}" must have fields.'));
+    }
+    for (final NamedType field in classDefinition.fields) {
+      if (field.type.isNullable || !_columnarFieldTypes.contains(field.type.baseName)) {
+        result.add(
+          Error(
+            message:
+                'Field "${field.name}" of @Columnar class "${classDefinition.name}" must be a non-nullable bool, int, double or String.',
+            lineNumber: _calculateLineNumberNullable(source, field.offset),
+          ),
+        );
+      }
+    }
+  }
+
   var containsEventChannelApi = false;
 
   for (final Api api in root.apis) {
@@ -687,6 +879,50 @@ List<Error> _validateAst(Root root, String source) {
       }
       containsEventChannelApi = true;
     }
+    if (api is AstHostApi && api.multiplexChannel && api.dartHostTestHandler != null) {
+      result.add(
+        Error(
+          message:
+              'HostApi "${api.name}" cannot use both multiplexChannel and dartHostTestHandler.',
+        ),
+      );
+    }
+    if (api is AstHostApi &&
+        api.multiplexChannel &&
+        api.methods.any(
+          (Method method) => method.taskQueueType == TaskQueueType.serialBackgroundThread,
+        )) {
+      result.add(
+        Error(
+          message:
+              'HostApi "${api.name}" cannot use both multiplexChannel and TaskQueueType.serialBackgroundThread.',
+        ),
+      );
+    }
+    if (api is AstHostApi &&
+        api.dartHostTestHandler != null &&
+        api.methods.any(
+          (Method method) =>
+              method.returnType.isColumnar ||
+              method.parameters.any((Parameter parameter) => parameter.type.isColumnar),
+        )) {
+      result.add(
+        Error(
+          message:
+              'HostApi "${api.name}" cannot use both dartHostTestHandler and lists of @Columnar classes.',
+        ),
+      );
+    }
+    if (api is AstHostApi &&
+        (api.multiplexChannel || api.dartHostTestHandler != null) &&
+        api.methods.any((Method method) => method.chunkSize != null)) {
+      result.add(
+        Error(
+          message:
+              'HostApi "${api.name}" cannot use @ChunkedBytes methods with multiplexChannel or dartHostTestHandler.',
+        ),
+      );
+    }
     if (api is AstProxyApi) {
       result.addAll(
         _validateProxyApi(
@@ -711,6 +947,25 @@ List<Error> _validateAst(Root root, String source) {
           ),
         );
       }
+      if (api is AstHostApi || api is AstFlutterApi) {
+        for (final TypeDeclaration type in <TypeDeclaration>[
+          method.returnType,
+          ...method.parameters.map((Parameter parameter) => parameter.type),
+        ]) {
+          if (_isNullableColumnarList(type)) {
+            result.add(
+              Error(
+                message:
+                    'Lists of @Columnar class "${type.typeArguments.first.baseName}" must be non-nullable with non-nullable elements, in method "${method.name}" in API: "${api.name}"',
+                lineNumber: _calculateLineNumberNullable(source, method.offset),
+              ),
+            );
+          }
+        }
+      }
+      if (method.chunkSize != null) {
+        result.addAll(_validateChunkedBytesMethod(api, method, source));
+      }
       if (api is AstEventChannelApi && method.parameters.isNotEmpty) {
         result.add(
           Error(
@@ -1194,6 +1449,30 @@ class RootBuilder extends dart_ast_visitor.RecursiveAstVisitor<Object?> {
       for (final Method func in api.methods) {
         func.parameters = _attachAssociatedDefinitions(func.parameters);
         func.returnType = _attachAssociatedDefinition(func.returnType);
+        if (api is AstHostApi || api is AstFlutterApi) {
+          func.parameters = func.parameters
+              .map(
+                (Parameter parameter) => _isColumnarList(parameter.type)
+                    ? parameter.copyWithType(parameter.type.copyWithColumnar())
+                    : parameter,
+              )
+              .toList();
+          if (_isColumnarList(func.returnType)) {
+            func.returnType = func.returnType.copyWithColumnar();
+          }
+        }
+        if (api is AstHostApi && func.chunkSize != null) {
+          func.parameters = func.parameters
+              .map(
+                (Parameter parameter) => _isChunkableBytes(parameter.type)
+                    ? parameter.copyWithType(parameter.type.copyWithChunked())
+                    : parameter,
+              )
+              .toList();
+          if (_isChunkableBytes(func.returnType)) {
+            func.returnType = func.returnType.copyWithChunked();
+          }
+        }
       }
       if (api is AstProxyApi) {
         for (final Constructor constructor in api.constructors) {
@@ -1299,6 +1578,9 @@ class RootBuilder extends dart_ast_visitor.RecursiveAstVisitor<Object?> {
       return expression.value;
     } else if (expression is dart_ast.SimpleIdentifier) {
       return expression.name;
+    } else if (expression is dart_ast.PrefixedIdentifier) {
+      // An enum value, such as `CppEventOverflowPolicy.block`.
+      return expression.identifier.name;
     } else if (expression is dart_ast.ListLiteral) {
       final list = <dynamic>[];
       for (final dart_ast.CollectionElement element in expression.elements) {
@@ -1394,6 +1676,7 @@ class RootBuilder extends dart_ast_visitor.RecursiveAstVisitor<Object?> {
           (dart_ast.Annotation element) => element.name.name == 'HostApi',
         );
         String? dartHostTestHandler;
+        var multiplexChannel = false;
         if (hostApi.arguments != null) {
           for (final dart_ast.Expression expression in hostApi.arguments!.arguments) {
             if (expression is dart_ast.NamedExpression) {
@@ -1402,6 +1685,11 @@ class RootBuilder extends dart_ast_visitor.RecursiveAstVisitor<Object?> {
                 if (dartHostTestHandlerExpression is dart_ast.SimpleStringLiteral) {
                   dartHostTestHandler = dartHostTestHandlerExpression.value;
                 }
+              } else if (expression.name.label.name == 'multiplexChannel') {
+                final dart_ast.Expression multiplexChannelExpression = expression.expression;
+                if (multiplexChannelExpression is dart_ast.BooleanLiteral) {
+                  multiplexChannel = multiplexChannelExpression.value;
+                }
               }
             }
           }
@@ -1411,6 +1699,7 @@ class RootBuilder extends dart_ast_visitor.RecursiveAstVisitor<Object?> {
           name: node.namePart.typeName.lexeme,
           methods: <Method>[],
           dartHostTestHandler: dartHostTestHandler,
+          multiplexChannel: multiplexChannel,
           documentationComments: _documentationCommentsParser(node.documentationComment?.tokens),
         );
       } else if (_hasMetadata(node.metadata, 'FlutterApi')) {
@@ -1524,6 +1813,8 @@ class RootBuilder extends dart_ast_visitor.RecursiveAstVisitor<Object?> {
 
         SwiftEventChannelOptions? swiftOptions;
         KotlinEventChannelOptions? kotlinOptions;
+        GObjectEventChannelOptions? gobjectOptions;
+        CppEventChannelOptions? cppOptions;
         final swiftOptionsMap = annotationMap['swiftOptions'] as Map<String, Object?>?;
         if (swiftOptionsMap != null) {
           swiftOptions = SwiftEventChannelOptions(
@@ -1536,11 +1827,32 @@ class RootBuilder extends dart_ast_visitor.RecursiveAstVisitor<Object?> {
             includeSharedClasses: kotlinOptionsMap['includeSharedClasses'] as bool? ?? true,
           );
         }
+        final gobjectOptionsMap = annotationMap['gobjectOptions'] as Map<String, Object?>?;
+        if (gobjectOptionsMap != null) {
+          gobjectOptions = GObjectEventChannelOptions(
+            maxBatchSize: gobjectOptionsMap['maxBatchSize'] as int? ?? 1,
+            maxBatchLatencyMilliseconds:
+                gobjectOptionsMap['maxBatchLatencyMilliseconds'] as int? ?? 0,
+          );
+        }
+        final cppOptionsMap = annotationMap['cppOptions'] as Map<String, Object?>?;
+        if (cppOptionsMap != null) {
+          final overflowPolicy = cppOptionsMap['overflowPolicy'] as String?;
+          cppOptions = CppEventChannelOptions(
+            maxBatchSize: cppOptionsMap['maxBatchSize'] as int? ?? 1,
+            maxQueuedEvents: cppOptionsMap['maxQueuedEvents'] as int? ?? 0,
+            overflowPolicy: overflowPolicy == null
+                ? CppEventOverflowPolicy.dropOldest
+                : CppEventOverflowPolicy.values.byName(overflowPolicy),
+          );
+        }
         _currentApi = AstEventChannelApi(
           name: node.namePart.typeName.lexeme,
           methods: <Method>[],
           swiftOptions: swiftOptions,
           kotlinOptions: kotlinOptions,
+          gobjectOptions: gobjectOptions,
+          cppOptions: cppOptions,
           documentationComments: _documentationCommentsParser(node.documentationComment?.tokens),
         );
       }
@@ -1553,6 +1865,7 @@ class RootBuilder extends dart_ast_visitor.RecursiveAstVisitor<Object?> {
             node.extendsClause?.superclass.name.toString(),
         isSealed: node.sealedKeyword != null,
         isSwiftClass: _hasMetadata(node.metadata, 'SwiftClass'),
+        isColumnar: _hasMetadata(node.metadata, 'Columnar'),
         documentationComments: _documentationCommentsParser(node.documentationComment?.tokens),
       );
     }
@@ -1649,6 +1962,37 @@ class RootBuilder extends dart_ast_visitor.RecursiveAstVisitor<Object?> {
     return null;
   }
 
+  /// Returns the chunk size of the `@ChunkedBytes` annotation of [node], or
+  /// null if it doesn't have one.
+  int? _parseChunkSize(dart_ast.MethodDeclaration node) {
+    final dart_ast.Annotation? annotation = _findMetadata(node.metadata, 'ChunkedBytes');
+    if (annotation == null) {
+      return null;
+    }
+    // The default of ChunkedBytes.chunkSize.
+    var chunkSize = 65536;
+    final Iterable<dart_ast.NamedExpression> arguments =
+        annotation.arguments?.arguments.whereType<dart_ast.NamedExpression>() ??
+        const <dart_ast.NamedExpression>[];
+    for (final argument in arguments) {
+      if (argument.name.label.name != 'chunkSize') {
+        continue;
+      }
+      final dart_ast.Expression expression = argument.expression;
+      if (expression is dart_ast.IntegerLiteral && expression.value != null) {
+        chunkSize = expression.value!;
+      } else {
+        _errors.add(
+          Error(
+            message: 'The chunkSize of @ChunkedBytes must be an integer literal.',
+            lineNumber: calculateLineNumber(source, argument.offset),
+          ),
+        );
+      }
+    }
+    return chunkSize;
+  }
+
   @override
   Object? visitMethodDeclaration(dart_ast.MethodDeclaration node) {
     final dart_ast.FormalParameterList parameters = node.parameters!;
@@ -1680,6 +2024,7 @@ class RootBuilder extends dart_ast_visitor.RecursiveAstVisitor<Object?> {
           )?.expression.asNullable<dart_ast.PrefixedIdentifier>()?.name;
     final TaskQueueType taskQueueType =
         _stringToEnum(TaskQueueType.values, taskQueueTypeName) ?? TaskQueueType.serial;
+    final int? chunkSize = _parseChunkSize(node);
 
     if (_currentApi != null) {
       // Methods without named return types aren't supported.
@@ -1729,6 +2074,7 @@ class RootBuilder extends dart_ast_visitor.RecursiveAstVisitor<Object?> {
             swiftFunction: swiftFunction,
             offset: node.offset,
             taskQueueType: taskQueueType,
+            chunkSize: chunkSize,
             documentationComments: _documentationCommentsParser(node.documentationComment?.tokens),
           ),
         );
@@ -0,0 +1,21 @@
+// Copyright 2013 The Flutter Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// This file is an example pigeon file that is used in compilation, unit, mock
+// handler, and e2e tests.
+
+import 'package:pigeon/pigeon.dart';
+
+@HostApi()
+abstract class ChunkedBytesHostApi {
+  /// Returns the passed bytes, to test streaming them in both directions.
+  @async
+  @ChunkedBytes(chunkSize: 4)
+  Uint8List echoBytes(Uint8List data);
+
+  /// Returns the number of bytes passed.
+  @async
+  @ChunkedBytes()
+  int countBytes(Uint8List data);
+}
@@ -0,0 +1,42 @@
+// Copyright 2013 The Flutter Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// This file is an example pigeon file that is used in compilation, unit, mock
+// handler, and e2e tests.
+
+import 'package:pigeon/pigeon.dart';
+
+/// A sample in a trace, which is sent in bulk as one list per field.
+@Columnar()
+class TracePoint {
+  TracePoint({
+    required this.timestamp,
+    required this.value,
+    required this.isValid,
+    required this.label,
+  });
+
+  int timestamp;
+  double value;
+  bool isValid;
+  String label;
+}
+
+@HostApi()
+abstract class ColumnarHostApi {
+  /// Returns the passed points, to test sending them in both directions.
+  List<TracePoint> echoPoints(List<TracePoint> points);
+
+  /// Returns the sum of the values of the valid points.
+  double sumValidValues(List<TracePoint> points);
+
+  @async
+  List<TracePoint> echoPointsAsync(List<TracePoint> points);
+}
+
+@FlutterApi()
+abstract class ColumnarFlutterApi {
+  /// Returns the passed points, to test sending them in both directions.
+  List<TracePoint> echoPoints(List<TracePoint> points);
+}
@@ -129,7 +129,10 @@ class ClassEvent extends PlatformEvent {
   final EventAllNullableTypes value;
 }
 
-@EventChannelApi()
+// Batching is enabled to exercise the batched sinks on Linux.
+@EventChannelApi(
+  gobjectOptions: GObjectEventChannelOptions(maxBatchSize: 8, maxBatchLatencyMilliseconds: 5),
+)
 abstract class EventChannelMethods {
   int streamInts();
   PlatformEvent streamEvents();
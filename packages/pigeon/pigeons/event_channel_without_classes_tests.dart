@@ -9,6 +9,8 @@ import 'package:pigeon/pigeon.dart';
 @EventChannelApi(
   swiftOptions: SwiftEventChannelOptions(includeSharedClasses: false),
   kotlinOptions: KotlinEventChannelOptions(includeSharedClasses: false),
+  // Batching is exercised by the C++ unit tests.
+  cppOptions: CppEventChannelOptions(maxBatchSize: 4, maxQueuedEvents: 64),
 )
 abstract class EventChannelMethods {
   int streamIntsAgain();
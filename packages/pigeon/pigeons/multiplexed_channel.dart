@@ -0,0 +1,36 @@
+// Copyright 2013 The Flutter Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// This file is an example pigeon file that is used in compilation, unit, mock
+// handler, and e2e tests.
+
+import 'package:pigeon/pigeon.dart';
+
+/// An API whose methods all share a single multiplexed channel.
+@HostApi(multiplexChannel: true)
+abstract class MultiplexedHostApi {
+  int subtract(int x, int y);
+
+  String echoString(String aString);
+
+  void noop();
+
+  @async
+  int? echoAsyncNullableInt(int? anInt);
+}
+
+/// The same API as [MultiplexedHostApi], using one channel per method.
+///
+/// Used as a baseline when benchmarking channel registration.
+@HostApi()
+abstract class PerMethodChannelHostApi {
+  int subtract(int x, int y);
+
+  String echoString(String aString);
+
+  void noop();
+
+  @async
+  int? echoAsyncNullableInt(int? anInt);
+}
@@ -0,0 +1,23 @@
+// Copyright 2013 The Flutter Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// This file is an example pigeon file that is used in compilation, unit, mock
+// handler, and e2e tests.
+
+import 'package:pigeon/pigeon.dart';
+
+/// An API with methods handled on a background task queue, and one handled on
+/// the platform thread.
+@HostApi()
+abstract class TaskQueueHostApi {
+  @TaskQueue(type: TaskQueueType.serialBackgroundThread)
+  int add(int x, int y);
+
+  @TaskQueue(type: TaskQueueType.serialBackgroundThread)
+  @async
+  String echoAsyncString(String aString);
+
+  /// Handled on the platform thread, since it has no TaskQueue annotation.
+  int subtract(int x, int y);
+}
@@ -39,6 +39,7 @@ enum TargetGenerator {
 const Set<TargetGenerator> proxyApiSupportedLanguages = <TargetGenerator>{
   TargetGenerator.kotlin,
   TargetGenerator.swift,
+  TargetGenerator.gobject,
 };
 
 /// Sets up and runs the integration tests.
@@ -2709,7 +2710,7 @@ void runPigeonIntegrationTests(TargetGenerator targetGenerator) {
 
   testWidgets('task queue handlers run on a background thread', (_) async {
     final api = HostIntegrationCoreApi();
-    // Currently only Android and iOS have task queue support. See
+    // Currently only Android, iOS, Linux, and Windows have task queue support. See
     // https://github.com/flutter/flutter/issues/93945
     // Rather than skip the test, this changes the expectation, so that there
     // is test coverage of the code path, even though the actual backgrounding
@@ -2718,13 +2719,19 @@ void runPigeonIntegrationTests(TargetGenerator targetGenerator) {
     // background is not supported.
     final bool taskQueuesSupported =
         defaultTargetPlatform == TargetPlatform.android ||
-        defaultTargetPlatform == TargetPlatform.iOS;
+        defaultTargetPlatform == TargetPlatform.iOS ||
+        defaultTargetPlatform == TargetPlatform.linux ||
+        defaultTargetPlatform == TargetPlatform.windows;
     expect(await api.taskQueueIsBackgroundThread(), taskQueuesSupported);
   });
 
   /// Event channels
 
-  const eventChannelSupported = <TargetGenerator>[TargetGenerator.kotlin, TargetGenerator.swift];
+  const eventChannelSupported = <TargetGenerator>[
+    TargetGenerator.kotlin,
+    TargetGenerator.swift,
+    TargetGenerator.gobject,
+  ];
 
   testWidgets('event channel sends continuous ints', (_) async {
     final Stream<int> events = streamInts();
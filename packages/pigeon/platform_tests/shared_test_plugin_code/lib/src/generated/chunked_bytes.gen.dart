@@ -0,0 +1,201 @@
+// Copyright 2013 The Flutter Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// Autogenerated from Pigeon, do not edit directly.
+// See also: https://pub.dev/packages/pigeon
+// ignore_for_file: unused_import, unused_shown_name
+// ignore_for_file: public_member_api_docs, non_constant_identifier_names, avoid_as, omit_local_variable_types, omit_obvious_local_variable_types
+
+import 'dart:async';
+import 'dart:typed_data' show BytesBuilder, Float64List, Int32List, Int64List;
+
+import 'package:flutter/services.dart';
+import 'package:meta/meta.dart' show immutable, protected, visibleForTesting;
+
+Object? _extractReplyValueOrThrow(
+  List<Object?>? replyList,
+  String channelName, {
+  required bool isNullValid,
+}) {
+  if (replyList == null) {
+    throw PlatformException(
+      code: 'channel-error',
+      message: 'Unable to establish connection on channel: "$channelName".',
+    );
+  } else if (replyList.length > 1) {
+    throw PlatformException(
+      code: replyList[0]! as String,
+      message: replyList[1] as String?,
+      details: replyList[2],
+    );
+  } else if (!isNullValid && (replyList.isNotEmpty && replyList[0] == null)) {
+    throw PlatformException(
+      code: 'null-error',
+      message: 'Host platform returned null value for non-null return value.',
+    );
+  }
+  return replyList.firstOrNull;
+}
+
+int _nextChunkTransferId = 0;
+
+/// Serves [data] to the host on [channelName], which requests the next chunk
+/// of at most the number of bytes in each message until it reaches the end.
+///
+/// The chunks are views of [data] of at most [chunkSize] bytes, so nothing is
+/// copied until a chunk is sent.
+BasicMessageChannel<Object?> _serveChunks(
+  String channelName,
+  Uint8List data,
+  int chunkSize,
+  BinaryMessenger? binaryMessenger,
+) {
+  final channel = BasicMessageChannel<Object?>(
+    channelName,
+    const StandardMessageCodec(),
+    binaryMessenger: binaryMessenger,
+  );
+  int offset = 0;
+  channel.setMessageHandler((Object? message) async {
+    final int requested = message! as int;
+    final int size = requested < chunkSize ? requested : chunkSize;
+    final int end = data.length - offset < size ? data.length : offset + size;
+    final Uint8List chunk = Uint8List.sublistView(data, offset, end);
+    offset = end;
+    return chunk;
+  });
+  return channel;
+}
+
+/// Reads the stream [streamId] that a host method returned, by requesting
+/// chunks of at most [chunkSize] bytes on [channelName] until an empty chunk
+/// marks its end.
+Future<Uint8List> _readChunks(
+  String channelName,
+  int streamId,
+  int chunkSize,
+  BinaryMessenger? binaryMessenger,
+) async {
+  final channel = BasicMessageChannel<Object?>(
+    channelName,
+    const StandardMessageCodec(),
+    binaryMessenger: binaryMessenger,
+  );
+  final builder = BytesBuilder(copy: false);
+  while (true) {
+    final replyList = await channel.send(<Object?>[streamId, chunkSize]) as List<Object?>?;
+    final chunk =
+        _extractReplyValueOrThrow(replyList, channelName, isNullValid: false)! as Uint8List;
+    if (chunk.isEmpty) {
+      return builder.takeBytes();
+    }
+    builder.add(chunk);
+  }
+}
+
+class _PigeonCodec extends StandardMessageCodec {
+  const _PigeonCodec();
+  @override
+  void writeValue(WriteBuffer buffer, Object? value) {
+    if (value is int) {
+      buffer.putUint8(4);
+      buffer.putInt64(value);
+    } else {
+      super.writeValue(buffer, value);
+    }
+  }
+
+  @override
+  Object? readValueOfType(int type, ReadBuffer buffer) {
+    switch (type) {
+      default:
+        return super.readValueOfType(type, buffer);
+    }
+  }
+}
+
+class ChunkedBytesHostApi {
+  /// Constructor for [ChunkedBytesHostApi]. The [binaryMessenger] named argument is
+  /// available for dependency injection. If it is left null, the default
+  /// BinaryMessenger will be used which routes to the host platform.
+  ChunkedBytesHostApi({BinaryMessenger? binaryMessenger, String messageChannelSuffix = ''})
+    : pigeonVar_binaryMessenger = binaryMessenger,
+      pigeonVar_messageChannelSuffix = messageChannelSuffix.isNotEmpty
+          ? '.$messageChannelSuffix'
+          : '';
+  final BinaryMessenger? pigeonVar_binaryMessenger;
+
+  static const MessageCodec<Object?> pigeonChannelCodec = _PigeonCodec();
+
+  final String pigeonVar_messageChannelSuffix;
+
+  /// Returns the passed bytes, to test streaming them in both directions.
+  Future<Uint8List> echoBytes(Uint8List data) async {
+    final pigeonVar_channelName =
+        'dev.flutter.pigeon.pigeon_integration_tests.ChunkedBytesHostApi.echoBytes$pigeonVar_messageChannelSuffix';
+    final pigeonVar_channel = BasicMessageChannel<Object?>(
+      pigeonVar_channelName,
+      pigeonChannelCodec,
+      binaryMessenger: pigeonVar_binaryMessenger,
+    );
+    final BasicMessageChannel<Object?> pigeonVar_dataChunks = _serveChunks(
+      '$pigeonVar_channelName.chunks.${_nextChunkTransferId++}',
+      data,
+      4,
+      pigeonVar_binaryMessenger,
+    );
+    try {
+      final Future<Object?> pigeonVar_sendFuture = pigeonVar_channel.send(<Object?>[
+        pigeonVar_dataChunks.name,
+      ]);
+      final pigeonVar_replyList = await pigeonVar_sendFuture as List<Object?>?;
+
+      final Object? pigeonVar_replyValue = _extractReplyValueOrThrow(
+        pigeonVar_replyList,
+        pigeonVar_channelName,
+        isNullValid: false,
+      );
+      return await _readChunks(
+        '$pigeonVar_channelName.chunks',
+        pigeonVar_replyValue! as int,
+        4,
+        pigeonVar_binaryMessenger,
+      );
+    } finally {
+      pigeonVar_dataChunks.setMessageHandler(null);
+    }
+  }
+
+  /// Returns the number of bytes passed.
+  Future<int> countBytes(Uint8List data) async {
+    final pigeonVar_channelName =
+        'dev.flutter.pigeon.pigeon_integration_tests.ChunkedBytesHostApi.countBytes$pigeonVar_messageChannelSuffix';
+    final pigeonVar_channel = BasicMessageChannel<Object?>(
+      pigeonVar_channelName,
+      pigeonChannelCodec,
+      binaryMessenger: pigeonVar_binaryMessenger,
+    );
+    final BasicMessageChannel<Object?> pigeonVar_dataChunks = _serveChunks(
+      '$pigeonVar_channelName.chunks.${_nextChunkTransferId++}',
+      data,
+      65536,
+      pigeonVar_binaryMessenger,
+    );
+    try {
+      final Future<Object?> pigeonVar_sendFuture = pigeonVar_channel.send(<Object?>[
+        pigeonVar_dataChunks.name,
+      ]);
+      final pigeonVar_replyList = await pigeonVar_sendFuture as List<Object?>?;
+
+      final Object? pigeonVar_replyValue = _extractReplyValueOrThrow(
+        pigeonVar_replyList,
+        pigeonVar_channelName,
+        isNullValid: false,
+      );
+      return pigeonVar_replyValue! as int;
+    } finally {
+      pigeonVar_dataChunks.setMessageHandler(null);
+    }
+  }
+}
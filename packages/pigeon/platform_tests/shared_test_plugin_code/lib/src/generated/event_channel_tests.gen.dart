@@ -8,6 +8,7 @@
 // ignore_for_file: public_member_api_docs, non_constant_identifier_names, avoid_as, omit_local_variable_types, omit_obvious_local_variable_types
 
 import 'dart:async';
+import 'dart:io' show Platform;
 import 'dart:typed_data' show Float64List, Int32List, Int64List;
 
 import 'package:flutter/services.dart';
@@ -677,8 +678,11 @@ Stream<int> streamInts({String instanceName = ''}) {
     'dev.flutter.pigeon.pigeon_integration_tests.EventChannelMethods.streamInts$instanceName',
     pigeonMethodCodec,
   );
-  return streamIntsChannel.receiveBroadcastStream().map((dynamic event) {
-    return event as int;
+  return streamIntsChannel.receiveBroadcastStream().expand((dynamic event) {
+    if (Platform.isLinux) {
+      return (event as List<Object?>).cast<int>();
+    }
+    return <int>[event as int];
   });
 }
 
@@ -696,8 +700,11 @@ Stream<PlatformEvent> streamEvents({String instanceName = ''}) {
     'dev.flutter.pigeon.pigeon_integration_tests.EventChannelMethods.streamEvents$instanceName',
     pigeonMethodCodec,
   );
-  return streamEventsChannel.receiveBroadcastStream().map((dynamic event) {
-    return event as PlatformEvent;
+  return streamEventsChannel.receiveBroadcastStream().expand((dynamic event) {
+    if (Platform.isLinux) {
+      return (event as List<Object?>).cast<PlatformEvent>();
+    }
+    return <PlatformEvent>[event as PlatformEvent];
   });
 }
 
@@ -715,7 +722,10 @@ Stream<int> streamConsistentNumbers({String instanceName = ''}) {
     'dev.flutter.pigeon.pigeon_integration_tests.EventChannelMethods.streamConsistentNumbers$instanceName',
     pigeonMethodCodec,
   );
-  return streamConsistentNumbersChannel.receiveBroadcastStream().map((dynamic event) {
-    return event as int;
+  return streamConsistentNumbersChannel.receiveBroadcastStream().expand((dynamic event) {
+    if (Platform.isLinux) {
+      return (event as List<Object?>).cast<int>();
+    }
+    return <int>[event as int];
   });
 }
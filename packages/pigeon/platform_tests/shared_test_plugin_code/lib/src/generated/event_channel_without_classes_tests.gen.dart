@@ -8,6 +8,7 @@
 // ignore_for_file: public_member_api_docs, non_constant_identifier_names, avoid_as, omit_local_variable_types, omit_obvious_local_variable_types
 
 import 'dart:async';
+import 'dart:io' show Platform;
 import 'dart:typed_data' show Float64List, Int32List, Int64List;
 
 import 'package:flutter/services.dart';
@@ -50,7 +51,10 @@ Stream<int> streamIntsAgain({String instanceName = ''}) {
     'dev.flutter.pigeon.pigeon_integration_tests.EventChannelMethods.streamIntsAgain$instanceName',
     pigeonMethodCodec,
   );
-  return streamIntsAgainChannel.receiveBroadcastStream().map((dynamic event) {
-    return event as int;
+  return streamIntsAgainChannel.receiveBroadcastStream().expand((dynamic event) {
+    if (Platform.isWindows) {
+      return (event as List<Object?>).cast<int>();
+    }
+    return <int>[event as int];
   });
 }
@@ -431,6 +431,16 @@ class PigeonInstanceManager {
     return _strongInstances.remove(identifier) as T?;
   }
 
+  /// Removes each of [identifiers] and its associated strongly referenced
+  /// instance, if present, from the manager.
+  ///
+  /// See [remove].
+  void removeAll(List<int> identifiers) {
+    for (final int identifier in identifiers) {
+      remove(identifier);
+    }
+  }
+
   /// Retrieves the instance associated with identifier.
   ///
   /// The value returned is chosen from the following order:
@@ -537,6 +547,31 @@ class _PigeonInternalInstanceManagerApi {
         });
       }
     }
+    {
+      final pigeonVar_channel = BasicMessageChannel<Object?>(
+        'dev.flutter.pigeon.pigeon_integration_tests.PigeonInternalInstanceManager.removeStrongReferences',
+        pigeonChannelCodec,
+        binaryMessenger: binaryMessenger,
+      );
+      if (pigeon_clearHandlers) {
+        pigeonVar_channel.setMessageHandler(null);
+      } else {
+        pigeonVar_channel.setMessageHandler((Object? message) async {
+          final List<Object?> args = message! as List<Object?>;
+          final List<int> arg_identifiers = (args[0]! as List<Object?>).cast<int>();
+          try {
+            (instanceManager ?? PigeonInstanceManager.instance).removeAll(arg_identifiers);
+            return wrapResponse(empty: true);
+          } on PlatformException catch (e) {
+            return wrapResponse(error: e);
+          } catch (e) {
+            return wrapResponse(
+              error: PlatformException(code: 'error', message: e.toString()),
+            );
+          }
+        });
+      }
+    }
   }
 
   Future<void> removeStrongReference(int identifier) async {
@@ -91,6 +91,21 @@ void main() {
       expect(instanceManager.containsIdentifier(0), isFalse);
     });
 
+    test('removeAll', () {
+      final instanceManager = PigeonInstanceManager(onWeakReferenceRemoved: (_) {});
+
+      final object0 = CopyableObject(pigeon_instanceManager: instanceManager);
+      final object1 = CopyableObject(pigeon_instanceManager: instanceManager);
+
+      instanceManager.addHostCreatedInstance(object0, 0);
+      instanceManager.addHostCreatedInstance(object1, 1);
+      instanceManager.removeWeakReference(object0);
+      instanceManager.removeWeakReference(object1);
+      instanceManager.removeAll(<int>[0, 1]);
+      expect(instanceManager.containsIdentifier(0), isFalse);
+      expect(instanceManager.containsIdentifier(1), isFalse);
+    });
+
     test('remove throws AssertionError if weak reference still exists', () {
       final instanceManager = PigeonInstanceManager(onWeakReferenceRemoved: (_) {});
 
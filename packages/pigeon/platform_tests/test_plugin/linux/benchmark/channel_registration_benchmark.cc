@@ -0,0 +1,154 @@
+// Copyright 2013 The Flutter Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Compares the cost of registering host API handlers on one channel per method
+// against a single multiplexed channel per API.
+//
+// Each API is registered under many message channel suffixes so that the
+// per-channel cost dominates. Handlers are registered on a fake messenger, so
+// the reported RSS covers the plugin side of each registration (channel
+// objects, channel names and handler closures), not engine bookkeeping.
+
+#include <flutter_linux/flutter_linux.h>
+#include <unistd.h>
+
+#include <cstdio>
+
+#include "pigeon/core_tests.gen.h"
+#include "pigeon/multiplexed_channel.gen.h"
+#include "test/utils/fake_host_messenger.h"
+
+namespace {
+
+constexpr int kInstanceCount = 1000;
+constexpr int kCallCount = 100000;
+
+// Returns the resident set size of this process in bytes.
+size_t resident_set_size() {
+  FILE* file = fopen("/proc/self/statm", "r");
+  if (file == nullptr) {
+    return 0;
+  }
+  unsigned long size = 0;
+  unsigned long resident = 0;
+  int count = fscanf(file, "%lu %lu", &size, &resident);
+  fclose(file);
+  if (count != 2) {
+    return 0;
+  }
+  return static_cast<size_t>(resident) * sysconf(_SC_PAGESIZE);
+}
+
+typedef void (*SetHandlersFunc)(FlBinaryMessenger* messenger,
+                                const gchar* suffix);
+
+void set_multiplexed_handlers(FlBinaryMessenger* messenger,
+                              const gchar* suffix) {
+  static MultiplexedChannelPigeonTestMultiplexedHostApiVTable vtable = {};
+  multiplexed_channel_pigeon_test_multiplexed_host_api_set_method_handlers(
+      messenger, suffix, &vtable, nullptr, nullptr);
+}
+
+void set_per_method_handlers(FlBinaryMessenger* messenger,
+                             const gchar* suffix) {
+  static MultiplexedChannelPigeonTestPerMethodChannelHostApiVTable vtable = {};
+  multiplexed_channel_pigeon_test_per_method_channel_host_api_set_method_handlers(
+      messenger, suffix, &vtable, nullptr, nullptr);
+}
+
+void set_core_api_handlers(FlBinaryMessenger* messenger, const gchar* suffix) {
+  static CoreTestsPigeonTestHostIntegrationCoreApiVTable vtable = {};
+  core_tests_pigeon_test_host_integration_core_api_set_method_handlers(
+      messenger, suffix, &vtable, nullptr, nullptr);
+}
+
+void run_registration_benchmark(const char* name, SetHandlersFunc func) {
+  g_autoptr(FlStandardMessageCodec) codec = fl_standard_message_codec_new();
+  g_autoptr(FakeHostMessenger) messenger =
+      fake_host_messenger_new(FL_MESSAGE_CODEC(codec));
+
+  size_t rss_before = resident_set_size();
+  gint64 start = g_get_monotonic_time();
+  for (int i = 0; i < kInstanceCount; i++) {
+    g_autofree gchar* suffix = g_strdup_printf("%d", i);
+    func(FL_BINARY_MESSENGER(messenger), suffix);
+  }
+  gint64 elapsed = g_get_monotonic_time() - start;
+  size_t rss_after = resident_set_size();
+
+  printf("%-28s %10.2f us/instance %10.1f KiB RSS/instance\n", name,
+         static_cast<double>(elapsed) / kInstanceCount,
+         (static_cast<double>(rss_after) - static_cast<double>(rss_before)) /
+             1024 / kInstanceCount);
+}
+
+MultiplexedChannelPigeonTestMultiplexedHostApiSubtractResponse*
+multiplexed_subtract(int64_t x, int64_t y, gpointer user_data) {
+  return multiplexed_channel_pigeon_test_multiplexed_host_api_subtract_response_new(
+      x - y);
+}
+
+MultiplexedChannelPigeonTestPerMethodChannelHostApiSubtractResponse*
+per_method_subtract(int64_t x, int64_t y, gpointer user_data) {
+  return multiplexed_channel_pigeon_test_per_method_channel_host_api_subtract_response_new(
+      x - y);
+}
+
+void ignore_reply(FlValue* reply, gpointer user_data) {}
+
+void run_call_benchmark(const char* name, FakeHostMessenger* messenger,
+                        const gchar* channel, FlValue* message) {
+  gint64 start = g_get_monotonic_time();
+  for (int i = 0; i < kCallCount; i++) {
+    fake_host_messenger_send_host_message(messenger, channel, message,
+                                          ignore_reply, nullptr);
+  }
+  gint64 elapsed = g_get_monotonic_time() - start;
+  printf("%-28s %10.3f us/call\n", name,
+         static_cast<double>(elapsed) / kCallCount);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  printf("Registering %d instances of each API:\n", kInstanceCount);
+  run_registration_benchmark("MultiplexedHostApi", set_multiplexed_handlers);
+  run_registration_benchmark("PerMethodChannelHostApi",
+                             set_per_method_handlers);
+  run_registration_benchmark("HostIntegrationCoreApi", set_core_api_handlers);
+
+  g_autoptr(FlStandardMessageCodec) codec = fl_standard_message_codec_new();
+  g_autoptr(FakeHostMessenger) messenger =
+      fake_host_messenger_new(FL_MESSAGE_CODEC(codec));
+  static MultiplexedChannelPigeonTestMultiplexedHostApiVTable
+      multiplexed_vtable = {.subtract = multiplexed_subtract};
+  multiplexed_channel_pigeon_test_multiplexed_host_api_set_method_handlers(
+      FL_BINARY_MESSENGER(messenger), nullptr, &multiplexed_vtable, nullptr,
+      nullptr);
+  static MultiplexedChannelPigeonTestPerMethodChannelHostApiVTable
+      per_method_vtable = {.subtract = per_method_subtract};
+  multiplexed_channel_pigeon_test_per_method_channel_host_api_set_method_handlers(
+      FL_BINARY_MESSENGER(messenger), nullptr, &per_method_vtable, nullptr,
+      nullptr);
+
+  printf("\nCalling subtract %d times:\n", kCallCount);
+  g_autoptr(FlValue) multiplexed_message = fl_value_new_list();
+  fl_value_append_take(multiplexed_message, fl_value_new_int(0));
+  fl_value_append_take(multiplexed_message, fl_value_new_int(30));
+  fl_value_append_take(multiplexed_message, fl_value_new_int(10));
+  run_call_benchmark(
+      "MultiplexedHostApi", messenger,
+      "dev.flutter.pigeon.pigeon_integration_tests.MultiplexedHostApi",
+      multiplexed_message);
+  g_autoptr(FlValue) per_method_message = fl_value_new_list();
+  fl_value_append_take(per_method_message, fl_value_new_int(30));
+  fl_value_append_take(per_method_message, fl_value_new_int(10));
+  run_call_benchmark(
+      "PerMethodChannelHostApi", messenger,
+      "dev.flutter.pigeon.pigeon_integration_tests.PerMethodChannelHostApi."
+      "subtract",
+      per_method_message);
+
+  return 0;
+}
@@ -0,0 +1,98 @@
+// Copyright 2013 The Flutter Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Measures the cost of the ProxyApi instance manager operations: adding host
+// created instances, looking instances up in both directions and releasing
+// them.
+//
+// Releases are measured end to end: dropping the last native reference
+// finalizes the instance and the queued identifiers are sent to Dart from the
+// main loop, so the release time includes flushing that queue.
+
+#include <flutter_linux/flutter_linux.h>
+
+#include <cstdio>
+#include <vector>
+
+#include "pigeon/proxy_api_tests.gen.h"
+#include "test/utils/fake_host_messenger.h"
+
+namespace {
+
+constexpr int kInstanceCount = 100000;
+
+void count_release(const gchar* channel, GBytes* message, gpointer user_data) {
+  (*static_cast<int*>(user_data))++;
+}
+
+void print_result(const char* name, gint64 elapsed) {
+  printf("%-28s %10.3f us/op\n", name,
+         static_cast<double>(elapsed) / kInstanceCount);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  g_autoptr(FlStandardMessageCodec) codec = fl_standard_message_codec_new();
+  g_autoptr(FakeHostMessenger) messenger =
+      fake_host_messenger_new(FL_MESSAGE_CODEC(codec));
+  int release_count = 0;
+  fake_host_messenger_set_dart_message_handler(messenger, count_release,
+                                               &release_count);
+  g_autoptr(ProxyApiTestsPigeonTestPigeonInstanceManager) instance_manager =
+      proxy_api_tests_pigeon_test_pigeon_instance_manager_new(
+          FL_BINARY_MESSENGER(messenger));
+
+  std::vector<GObject*> instances(kInstanceCount);
+  for (int i = 0; i < kInstanceCount; i++) {
+    instances[i] = G_OBJECT(g_object_new(G_TYPE_OBJECT, nullptr));
+  }
+  std::vector<int64_t> identifiers(kInstanceCount);
+
+  printf("Using %d instances:\n", kInstanceCount);
+
+  gint64 start = g_get_monotonic_time();
+  for (int i = 0; i < kInstanceCount; i++) {
+    identifiers[i] =
+        proxy_api_tests_pigeon_test_pigeon_instance_manager_add_host_created_instance(
+            instance_manager, instances[i]);
+  }
+  print_result("add_host_created_instance", g_get_monotonic_time() - start);
+
+  start = g_get_monotonic_time();
+  for (int i = 0; i < kInstanceCount; i++) {
+    g_autoptr(GObject) instance =
+        proxy_api_tests_pigeon_test_pigeon_instance_manager_get_instance(
+            instance_manager, identifiers[i]);
+  }
+  print_result("get_instance", g_get_monotonic_time() - start);
+
+  start = g_get_monotonic_time();
+  for (int i = 0; i < kInstanceCount; i++) {
+    int64_t identifier;
+    proxy_api_tests_pigeon_test_pigeon_instance_manager_get_identifier(
+        instance_manager, instances[i], &identifier);
+  }
+  print_result("get_identifier", g_get_monotonic_time() - start);
+
+  // Drop the strong references held by the instance manager, then the last
+  // native references, so that every instance is finalized and released.
+  start = g_get_monotonic_time();
+  for (int i = 0; i < kInstanceCount; i++) {
+    proxy_api_tests_pigeon_test_pigeon_instance_manager_remove(
+        instance_manager, identifiers[i]);
+    g_object_unref(instances[i]);
+  }
+  while (g_main_context_iteration(nullptr, FALSE)) {
+  }
+  print_result("release", g_get_monotonic_time() - start);
+
+  if (release_count != kInstanceCount) {
+    fprintf(stderr, "Expected %d releases, got %d\n", kInstanceCount,
+            release_count);
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,76 @@
+// Copyright 2013 The Flutter Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Measures how the cost of comparing data classes that hold maps scales with
+// the number of map entries.
+//
+// The maps hold the same entries inserted in opposite orders, so each key has
+// to be looked up rather than found at the same index. Building the maps is
+// not timed; it is quadratic in the number of entries as FlValue checks for an
+// existing key on every insert, so the largest size takes a while to set up.
+
+#include <flutter_linux/flutter_linux.h>
+
+#include <cstdio>
+
+#include "pigeon/core_tests.gen.h"
+
+namespace {
+
+constexpr int64_t kMapSizes[] = {10, 1000, 100000};
+
+CoreTestsPigeonTestAllNullableTypes* create_all_nullable_types_with_map(
+    FlValue* map) {
+  return core_tests_pigeon_test_all_nullable_types_new(
+      nullptr, nullptr, nullptr, nullptr, nullptr, 0, nullptr, 0, nullptr, 0,
+      nullptr, 0, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,
+      nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,
+      map, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr);
+}
+
+FlValue* create_int_map(int64_t size, bool reversed) {
+  FlValue* map = fl_value_new_map();
+  for (int64_t i = 0; i < size; i++) {
+    int64_t key = reversed ? size - 1 - i : i;
+    g_autofree gchar* value = g_strdup_printf("%" G_GINT64_FORMAT, key);
+    fl_value_set_take(map, fl_value_new_int(key), fl_value_new_string(value));
+  }
+  return map;
+}
+
+void run_equals_benchmark(int64_t size) {
+  g_autoptr(FlValue) map1 = create_int_map(size, false);
+  g_autoptr(FlValue) map2 = create_int_map(size, true);
+  g_autoptr(CoreTestsPigeonTestAllNullableTypes) all1 =
+      create_all_nullable_types_with_map(map1);
+  g_autoptr(CoreTestsPigeonTestAllNullableTypes) all2 =
+      create_all_nullable_types_with_map(map2);
+
+  // Keep the total work roughly constant across sizes.
+  int64_t iterations = MAX(1, 1000000 / size);
+  gint64 start = g_get_monotonic_time();
+  for (int64_t i = 0; i < iterations; i++) {
+    if (!core_tests_pigeon_test_all_nullable_types_equals(all1, all2)) {
+      fprintf(stderr, "Maps of %" G_GINT64_FORMAT " entries not equal\n",
+              size);
+      return;
+    }
+  }
+  gint64 elapsed = g_get_monotonic_time() - start;
+
+  printf("%8" G_GINT64_FORMAT " entries %14.3f us/equals %10.4f us/entry\n",
+         size, static_cast<double>(elapsed) / iterations,
+         static_cast<double>(elapsed) / iterations / size);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  printf("Comparing AllNullableTypes with a map field:\n");
+  for (int64_t size : kMapSizes) {
+    run_equals_benchmark(size);
+  }
+
+  return 0;
+}
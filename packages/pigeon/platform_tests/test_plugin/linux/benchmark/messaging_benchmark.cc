@@ -0,0 +1,604 @@
+// Copyright 2013 The Flutter Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Measures the throughput and heap allocations of the echo methods of
+// HostIntegrationCoreApi, including their nullable and asynchronous variants,
+// and prints them as JSON so that the results can be compared across pigeon
+// releases.
+//
+// Host API methods can't take Int32List, Int64List or Float64List, so those
+// are measured as the typed data fields of AllNullableTypes.
+//
+// Every echo shape is measured for three operations:
+//   encode:     encoding the message with the generated codec, as Dart would.
+//   decode:     decoding the message, as the generated handler does.
+//   round_trip: sending the message through the fake messenger to the test
+//               plugin, which includes encoding the message, the handler
+//               decoding it and encoding the reply, and decoding the reply.
+//
+// Shapes whose size can vary are measured with payloads from 8 B to 16 MiB.
+// Maps stop at 64 KiB, since inserting into an FlValue map checks for an
+// existing key, which makes building and decoding a map quadratic in its size.
+//
+// Allocations are counted by wrapping the C library allocator, which GLib
+// uses for g_malloc() and friends.
+
+#include <flutter_linux/flutter_linux.h>
+
+#include <atomic>
+#include <cstdio>
+
+#include "pigeon/core_tests.gen.h"
+#include "test/utils/fake_host_messenger.h"
+#include "test_plugin_private.h"
+
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* pointer, size_t size);
+}
+
+namespace {
+
+constexpr size_t kPayloadSizes[] = {8, 1024, 64 * 1024, 1024 * 1024,
+                                    16 * 1024 * 1024};
+constexpr size_t kMaxMapPayloadSize = 64 * 1024;
+
+// Each measurement processes about this many bytes of payload, within the
+// iteration limits below.
+constexpr size_t kBytesPerMeasurement = 64 * 1024 * 1024;
+constexpr size_t kMinIterations = 3;
+constexpr size_t kMaxIterations = 100000;
+
+constexpr char kChannelPrefix[] =
+    "dev.flutter.pigeon.pigeon_integration_tests.HostIntegrationCoreApi.";
+
+std::atomic<size_t> allocation_count(0);
+
+// Creates the argument of an echo method with |count| elements.
+typedef FlValue* (*CreateArgumentFunc)(size_t count);
+
+typedef struct {
+  // The name of the method in the Dart API.
+  const char* method;
+  CreateArgumentFunc create_argument;
+  // The approximate encoded size of each element, or 0 if the size of the
+  // argument doesn't vary.
+  size_t element_size;
+  // The size of the largest payload the shape is measured with.
+  size_t max_payload_size;
+  // Describes the argument when it isn't the one the method is named for, or
+  // nullptr.
+  const char* argument;
+} EchoShape;
+
+typedef struct {
+  double ops_per_second;
+  double allocations_per_op;
+} Measurement;
+
+FlMessageCodec* create_codec() {
+  return FL_MESSAGE_CODEC(
+      g_object_new(core_tests_pigeon_test_message_codec_get_type(), nullptr));
+}
+
+FlValue* new_an_enum(size_t index) {
+  return fl_value_new_custom(core_tests_pigeon_test_an_enum_type_id,
+                             fl_value_new_int(index % 5),
+                             (GDestroyNotify)fl_value_unref);
+}
+
+CoreTestsPigeonTestAllNullableTypes* create_all_nullable_types(int64_t value) {
+  return core_tests_pigeon_test_all_nullable_types_new(
+      nullptr, &value, nullptr, nullptr, nullptr, 0, nullptr, 0, nullptr, 0,
+      nullptr, 0, nullptr, nullptr, "a string", nullptr, nullptr, nullptr,
+      nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,
+      nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,
+      nullptr);
+}
+
+FlValue* new_all_nullable_types(size_t index) {
+  g_autoptr(CoreTestsPigeonTestAllNullableTypes) object =
+      create_all_nullable_types(index);
+  return fl_value_new_custom_object(
+      core_tests_pigeon_test_all_nullable_types_type_id, G_OBJECT(object));
+}
+
+CoreTestsPigeonTestAllTypes* create_all_types() {
+  static const uint8_t bytes[] = {1, 2, 3};
+  static const int32_t int32s[] = {-1, 0, 1};
+  static const int64_t int64s[] = {G_MININT64, 0, G_MAXINT64};
+  static const double doubles[] = {0.5, -1.25};
+  g_autoptr(FlValue) an_object = fl_value_new_int(7);
+  g_autoptr(FlValue) list = fl_value_new_list();
+  fl_value_append_take(list, fl_value_new_string("hello"));
+  g_autoptr(FlValue) map = fl_value_new_map();
+  fl_value_set_string_take(map, "key", fl_value_new_string("value"));
+  g_autoptr(FlValue) empty_list = fl_value_new_list();
+  g_autoptr(FlValue) empty_map = fl_value_new_map();
+  return core_tests_pigeon_test_all_types_new(
+      TRUE, 42, G_MAXINT64, 3.14, bytes, G_N_ELEMENTS(bytes), int32s,
+      G_N_ELEMENTS(int32s), int64s, G_N_ELEMENTS(int64s), doubles,
+      G_N_ELEMENTS(doubles), PIGEON_INTEGRATION_TESTS_AN_ENUM_FORTY_TWO,
+      PIGEON_INTEGRATION_TESTS_ANOTHER_ENUM_JUST_IN_CASE, "a string", an_object,
+      list, list, empty_list, empty_list, empty_list, empty_list, list,
+      empty_list, empty_list, map, map, empty_map, empty_map, map, empty_map,
+      empty_map);
+}
+
+FlValue* create_all_types_argument(size_t count) {
+  g_autoptr(CoreTestsPigeonTestAllTypes) object = create_all_types();
+  return fl_value_new_custom_object(core_tests_pigeon_test_all_types_type_id,
+                                    G_OBJECT(object));
+}
+
+FlValue* create_all_nullable_types_argument(size_t count) {
+  return new_all_nullable_types(count);
+}
+
+FlValue* create_all_nullable_types_without_recursion_argument(size_t count) {
+  int64_t value = 42;
+  g_autoptr(CoreTestsPigeonTestAllNullableTypesWithoutRecursion) object =
+      core_tests_pigeon_test_all_nullable_types_without_recursion_new(
+          nullptr, &value, nullptr, nullptr, nullptr, 0, nullptr, 0, nullptr,
+          0, nullptr, 0, nullptr, nullptr, "a string", nullptr, nullptr,
+          nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,
+          nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,
+          nullptr);
+  return fl_value_new_custom_object(
+      core_tests_pigeon_test_all_nullable_types_without_recursion_type_id,
+      G_OBJECT(object));
+}
+
+FlValue* create_class_wrapper_argument(size_t count) {
+  g_autoptr(CoreTestsPigeonTestAllNullableTypes) all_nullable_types =
+      create_all_nullable_types(42);
+  g_autoptr(CoreTestsPigeonTestAllTypes) all_types = create_all_types();
+  g_autoptr(FlValue) class_list = fl_value_new_list();
+  g_autoptr(FlValue) class_map = fl_value_new_map();
+  g_autoptr(CoreTestsPigeonTestAllClassesWrapper) object =
+      core_tests_pigeon_test_all_classes_wrapper_new(
+          all_nullable_types, nullptr, all_types, class_list, nullptr,
+          class_map, nullptr);
+  return fl_value_new_custom_object(
+      core_tests_pigeon_test_all_classes_wrapper_type_id, G_OBJECT(object));
+}
+
+// Creates an AllNullableTypes whose typed data field of |type| holds |count|
+// zeroed elements.
+FlValue* new_typed_data_argument(FlValueType type, size_t count) {
+  int64_t value = 42;
+  g_autofree int32_t* int32s =
+      type == FL_VALUE_TYPE_INT32_LIST ? g_new0(int32_t, count) : nullptr;
+  g_autofree int64_t* int64s =
+      type == FL_VALUE_TYPE_INT64_LIST ? g_new0(int64_t, count) : nullptr;
+  g_autofree double* doubles =
+      type == FL_VALUE_TYPE_FLOAT_LIST ? g_new0(double, count) : nullptr;
+  g_autoptr(CoreTestsPigeonTestAllNullableTypes) object =
+      core_tests_pigeon_test_all_nullable_types_new(
+          nullptr, &value, nullptr, nullptr, nullptr, 0, int32s,
+          int32s != nullptr ? count : 0, int64s, int64s != nullptr ? count : 0,
+          doubles, doubles != nullptr ? count : 0, nullptr, nullptr,
+          "a string", nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,
+          nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,
+          nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr);
+  return fl_value_new_custom_object(
+      core_tests_pigeon_test_all_nullable_types_type_id, G_OBJECT(object));
+}
+
+FlValue* create_int32_list_argument(size_t count) {
+  return new_typed_data_argument(FL_VALUE_TYPE_INT32_LIST, count);
+}
+
+FlValue* create_int64_list_argument(size_t count) {
+  return new_typed_data_argument(FL_VALUE_TYPE_INT64_LIST, count);
+}
+
+FlValue* create_float64_list_argument(size_t count) {
+  return new_typed_data_argument(FL_VALUE_TYPE_FLOAT_LIST, count);
+}
+
+FlValue* create_null_argument(size_t count) { return fl_value_new_null(); }
+
+FlValue* create_int_argument(size_t count) { return fl_value_new_int(42); }
+
+FlValue* create_double_argument(size_t count) {
+  return fl_value_new_float(3.14);
+}
+
+FlValue* create_bool_argument(size_t count) { return fl_value_new_bool(TRUE); }
+
+FlValue* create_enum_argument(size_t count) {
+  return new_an_enum(PIGEON_INTEGRATION_TESTS_AN_ENUM_FORTY_TWO);
+}
+
+FlValue* create_another_enum_argument(size_t count) {
+  return fl_value_new_custom(
+      core_tests_pigeon_test_another_enum_type_id,
+      fl_value_new_int(PIGEON_INTEGRATION_TESTS_ANOTHER_ENUM_JUST_IN_CASE),
+      (GDestroyNotify)fl_value_unref);
+}
+
+FlValue* create_string_argument(size_t count) {
+  g_autofree gchar* value = g_strnfill(count, 'a');
+  return fl_value_new_string(value);
+}
+
+FlValue* create_uint8_list_argument(size_t count) {
+  g_autofree uint8_t* value = static_cast<uint8_t*>(g_malloc0(count));
+  return fl_value_new_uint8_list(value, count);
+}
+
+FlValue* create_int_list_argument(size_t count) {
+  FlValue* list = fl_value_new_list();
+  for (size_t i = 0; i < count; i++) {
+    fl_value_append_take(list, fl_value_new_int(i));
+  }
+  return list;
+}
+
+FlValue* create_string_list_argument(size_t count) {
+  FlValue* list = fl_value_new_list();
+  for (size_t i = 0; i < count; i++) {
+    fl_value_append_take(list, fl_value_new_string("a string"));
+  }
+  return list;
+}
+
+FlValue* create_double_list_argument(size_t count) {
+  FlValue* list = fl_value_new_list();
+  for (size_t i = 0; i < count; i++) {
+    fl_value_append_take(list, fl_value_new_float(i * 0.5));
+  }
+  return list;
+}
+
+FlValue* create_bool_list_argument(size_t count) {
+  FlValue* list = fl_value_new_list();
+  for (size_t i = 0; i < count; i++) {
+    fl_value_append_take(list, fl_value_new_bool(i % 2 == 0));
+  }
+  return list;
+}
+
+FlValue* create_enum_list_argument(size_t count) {
+  FlValue* list = fl_value_new_list();
+  for (size_t i = 0; i < count; i++) {
+    fl_value_append_take(list, new_an_enum(i));
+  }
+  return list;
+}
+
+FlValue* create_class_list_argument(size_t count) {
+  FlValue* list = fl_value_new_list();
+  for (size_t i = 0; i < count; i++) {
+    fl_value_append_take(list, new_all_nullable_types(i));
+  }
+  return list;
+}
+
+FlValue* create_int_map_argument(size_t count) {
+  FlValue* map = fl_value_new_map();
+  for (size_t i = 0; i < count; i++) {
+    fl_value_set_take(map, fl_value_new_int(i), fl_value_new_int(i));
+  }
+  return map;
+}
+
+FlValue* create_string_map_argument(size_t count) {
+  FlValue* map = fl_value_new_map();
+  for (size_t i = 0; i < count; i++) {
+    g_autofree gchar* key = g_strdup_printf("key%zu", i);
+    fl_value_set_string_take(map, key, fl_value_new_string("value"));
+  }
+  return map;
+}
+
+// AnEnum only has five values, so the map always has five entries.
+FlValue* create_enum_map_argument(size_t count) {
+  FlValue* map = fl_value_new_map();
+  for (size_t i = 0; i < 5; i++) {
+    fl_value_set_take(map, new_an_enum(i), new_an_enum(i + 1));
+  }
+  return map;
+}
+
+FlValue* create_class_map_argument(size_t count) {
+  FlValue* map = fl_value_new_map();
+  for (size_t i = 0; i < count; i++) {
+    fl_value_set_take(map, fl_value_new_int(i), new_all_nullable_types(i));
+  }
+  return map;
+}
+
+// Every echo method, with one entry per argument shape.
+const EchoShape kEchoShapes[] = {
+    {"echoInt", create_int_argument, 0, 0, nullptr},
+    {"echoDouble", create_double_argument, 0, 0, nullptr},
+    {"echoBool", create_bool_argument, 0, 0, nullptr},
+    {"echoEnum", create_enum_argument, 0, 0, nullptr},
+    {"echoAnotherEnum", create_another_enum_argument, 0, 0, nullptr},
+    {"echoAllTypes", create_all_types_argument, 0, 0, nullptr},
+    {"echoAllNullableTypes", create_all_nullable_types_argument, 0, 0,
+     nullptr},
+    {"echoAllNullableTypesWithoutRecursion",
+     create_all_nullable_types_without_recursion_argument, 0, 0, nullptr},
+    {"echoClassWrapper", create_class_wrapper_argument, 0, 0, nullptr},
+    {"echoEnumMap", create_enum_map_argument, 0, 0, nullptr},
+    {"echoNonNullEnumMap", create_enum_map_argument, 0, 0, nullptr},
+    {"echoString", create_string_argument, 1, G_MAXSIZE, nullptr},
+    {"echoUint8List", create_uint8_list_argument, 1, G_MAXSIZE, nullptr},
+    {"echoAllNullableTypes", create_int32_list_argument, 4, G_MAXSIZE,
+     "Int32List"},
+    {"echoAllNullableTypes", create_int64_list_argument, 8, G_MAXSIZE,
+     "Int64List"},
+    {"echoAllNullableTypes", create_float64_list_argument, 8, G_MAXSIZE,
+     "Float64List"},
+    {"echoObject", create_string_argument, 1, G_MAXSIZE, nullptr},
+    {"echoList", create_int_list_argument, 5, G_MAXSIZE, nullptr},
+    {"echoStringList", create_string_list_argument, 10, G_MAXSIZE, nullptr},
+    {"echoIntList", create_int_list_argument, 5, G_MAXSIZE, nullptr},
+    {"echoDoubleList", create_double_list_argument, 16, G_MAXSIZE, nullptr},
+    {"echoBoolList", create_bool_list_argument, 1, G_MAXSIZE, nullptr},
+    {"echoEnumList", create_enum_list_argument, 6, G_MAXSIZE, nullptr},
+    {"echoNonNullEnumList", create_enum_list_argument, 6, G_MAXSIZE, nullptr},
+    {"echoClassList", create_class_list_argument, 55, G_MAXSIZE, nullptr},
+    {"echoNonNullClassList", create_class_list_argument, 55, G_MAXSIZE,
+     nullptr},
+    {"echoMap", create_int_map_argument, 10, kMaxMapPayloadSize, nullptr},
+    {"echoStringMap", create_string_map_argument, 18, kMaxMapPayloadSize,
+     nullptr},
+    {"echoIntMap", create_int_map_argument, 10, kMaxMapPayloadSize, nullptr},
+    {"echoClassMap", create_class_map_argument, 60, kMaxMapPayloadSize,
+     nullptr},
+    {"echoNonNullStringMap", create_string_map_argument, 18,
+     kMaxMapPayloadSize, nullptr},
+    {"echoNonNullIntMap", create_int_map_argument, 10, kMaxMapPayloadSize,
+     nullptr},
+    {"echoNonNullClassMap", create_class_map_argument, 60, kMaxMapPayloadSize,
+     nullptr},
+
+    // Nullable variants, which unwrap the argument into a pointer.
+    {"echoNullableInt", create_int_argument, 0, 0, nullptr},
+    {"echoNullableInt", create_null_argument, 0, 0, "null"},
+    {"echoNullableDouble", create_double_argument, 0, 0, nullptr},
+    {"echoNullableBool", create_bool_argument, 0, 0, nullptr},
+    {"echoNullableEnum", create_enum_argument, 0, 0, nullptr},
+    {"echoAnotherNullableEnum", create_another_enum_argument, 0, 0, nullptr},
+    {"echoNullableEnumMap", create_enum_map_argument, 0, 0, nullptr},
+    {"echoNullableNonNullEnumMap", create_enum_map_argument, 0, 0, nullptr},
+    {"echoNullableString", create_string_argument, 1, G_MAXSIZE, nullptr},
+    {"echoNullableString", create_null_argument, 0, 0, "null"},
+    {"echoNullableUint8List", create_uint8_list_argument, 1, G_MAXSIZE,
+     nullptr},
+    {"echoNullableObject", create_string_argument, 1, G_MAXSIZE, nullptr},
+    {"echoNullableList", create_int_list_argument, 5, G_MAXSIZE, nullptr},
+    {"echoNullableEnumList", create_enum_list_argument, 6, G_MAXSIZE, nullptr},
+    {"echoNullableNonNullEnumList", create_enum_list_argument, 6, G_MAXSIZE,
+     nullptr},
+    {"echoNullableClassList", create_class_list_argument, 55, G_MAXSIZE,
+     nullptr},
+    {"echoNullableNonNullClassList", create_class_list_argument, 55,
+     G_MAXSIZE, nullptr},
+    {"echoNullableMap", create_int_map_argument, 10, kMaxMapPayloadSize,
+     nullptr},
+    {"echoNullableStringMap", create_string_map_argument, 18,
+     kMaxMapPayloadSize, nullptr},
+    {"echoNullableIntMap", create_int_map_argument, 10, kMaxMapPayloadSize,
+     nullptr},
+    {"echoNullableClassMap", create_class_map_argument, 60,
+     kMaxMapPayloadSize, nullptr},
+    {"echoNullableNonNullStringMap", create_string_map_argument, 18,
+     kMaxMapPayloadSize, nullptr},
+    {"echoNullableNonNullIntMap", create_int_map_argument, 10,
+     kMaxMapPayloadSize, nullptr},
+    {"echoNullableNonNullClassMap", create_class_map_argument, 60,
+     kMaxMapPayloadSize, nullptr},
+
+    // Asynchronous variants, which reply through a response handle.
+    {"echoAsyncInt", create_int_argument, 0, 0, nullptr},
+    {"echoAsyncDouble", create_double_argument, 0, 0, nullptr},
+    {"echoAsyncBool", create_bool_argument, 0, 0, nullptr},
+    {"echoAsyncEnum", create_enum_argument, 0, 0, nullptr},
+    {"echoAnotherAsyncEnum", create_another_enum_argument, 0, 0, nullptr},
+    {"echoAsyncAllTypes", create_all_types_argument, 0, 0, nullptr},
+    {"echoAsyncEnumMap", create_enum_map_argument, 0, 0, nullptr},
+    {"echoAsyncString", create_string_argument, 1, G_MAXSIZE, nullptr},
+    {"echoAsyncUint8List", create_uint8_list_argument, 1, G_MAXSIZE, nullptr},
+    {"echoAsyncObject", create_string_argument, 1, G_MAXSIZE, nullptr},
+    {"echoAsyncList", create_int_list_argument, 5, G_MAXSIZE, nullptr},
+    {"echoAsyncEnumList", create_enum_list_argument, 6, G_MAXSIZE, nullptr},
+    {"echoAsyncClassList", create_class_list_argument, 55, G_MAXSIZE,
+     nullptr},
+    {"echoAsyncMap", create_int_map_argument, 10, kMaxMapPayloadSize, nullptr},
+    {"echoAsyncStringMap", create_string_map_argument, 18, kMaxMapPayloadSize,
+     nullptr},
+    {"echoAsyncIntMap", create_int_map_argument, 10, kMaxMapPayloadSize,
+     nullptr},
+    {"echoAsyncClassMap", create_class_map_argument, 60, kMaxMapPayloadSize,
+     nullptr},
+
+    // Asynchronous nullable variants.
+    {"echoAsyncNullableInt", create_int_argument, 0, 0, nullptr},
+    {"echoAsyncNullableInt", create_null_argument, 0, 0, "null"},
+    {"echoAsyncNullableDouble", create_double_argument, 0, 0, nullptr},
+    {"echoAsyncNullableBool", create_bool_argument, 0, 0, nullptr},
+    {"echoAsyncNullableEnum", create_enum_argument, 0, 0, nullptr},
+    {"echoAnotherAsyncNullableEnum", create_another_enum_argument, 0, 0,
+     nullptr},
+    {"echoAsyncNullableAllNullableTypes", create_all_nullable_types_argument,
+     0, 0, nullptr},
+    {"echoAsyncNullableAllNullableTypesWithoutRecursion",
+     create_all_nullable_types_without_recursion_argument, 0, 0, nullptr},
+    {"echoAsyncNullableEnumMap", create_enum_map_argument, 0, 0, nullptr},
+    {"echoAsyncNullableString", create_string_argument, 1, G_MAXSIZE,
+     nullptr},
+    {"echoAsyncNullableUint8List", create_uint8_list_argument, 1, G_MAXSIZE,
+     nullptr},
+    {"echoAsyncNullableObject", create_string_argument, 1, G_MAXSIZE,
+     nullptr},
+    {"echoAsyncNullableList", create_int_list_argument, 5, G_MAXSIZE,
+     nullptr},
+    {"echoAsyncNullableEnumList", create_enum_list_argument, 6, G_MAXSIZE,
+     nullptr},
+    {"echoAsyncNullableClassList", create_class_list_argument, 55, G_MAXSIZE,
+     nullptr},
+    {"echoAsyncNullableMap", create_int_map_argument, 10, kMaxMapPayloadSize,
+     nullptr},
+    {"echoAsyncNullableStringMap", create_string_map_argument, 18,
+     kMaxMapPayloadSize, nullptr},
+    {"echoAsyncNullableIntMap", create_int_map_argument, 10,
+     kMaxMapPayloadSize, nullptr},
+    {"echoAsyncNullableClassMap", create_class_map_argument, 60,
+     kMaxMapPayloadSize, nullptr},
+};
+
+template <typename Operation>
+Measurement measure(size_t iterations, Operation operation) {
+  size_t allocations_before = allocation_count.load();
+  gint64 start = g_get_monotonic_time();
+  for (size_t i = 0; i < iterations; i++) {
+    operation();
+  }
+  gint64 elapsed = MAX(g_get_monotonic_time() - start, 1);
+  size_t allocations = allocation_count.load() - allocations_before;
+  return {static_cast<double>(iterations) * G_USEC_PER_SEC / elapsed,
+          static_cast<double>(allocations) / iterations};
+}
+
+void print_measurement(const char* name, const Measurement& measurement,
+                       const char* separator) {
+  printf(
+      "      \"%s\": {\"ops_per_second\": %.1f, \"allocations_per_op\": "
+      "%.2f}%s\n",
+      name, measurement.ops_per_second, measurement.allocations_per_op,
+      separator);
+}
+
+typedef struct {
+  FlMessageCodec* codec;
+  GBytes* expected_reply;
+  gboolean echoed;
+} ReplyCheck;
+
+void check_reply(FlValue* reply, gpointer user_data) {
+  ReplyCheck* check = static_cast<ReplyCheck*>(user_data);
+  g_autoptr(GBytes) encoded_reply =
+      fl_message_codec_encode_message(check->codec, reply, nullptr);
+  check->echoed = encoded_reply != nullptr &&
+                  g_bytes_equal(encoded_reply, check->expected_reply);
+}
+
+void ignore_reply(FlValue* reply, gpointer user_data) {}
+
+// Measures |shape| with an argument of |count| elements, and prints the
+// results as a JSON object.
+//
+// Returns false if the reply to the message isn't the message itself.
+bool run_benchmark(FakeHostMessenger* messenger, FlMessageCodec* codec,
+                   const EchoShape& shape, size_t count, bool is_first) {
+  g_autoptr(FlValue) message = fl_value_new_list();
+  fl_value_append_take(message, shape.create_argument(count));
+  g_autoptr(GBytes) encoded_message =
+      fl_message_codec_encode_message(codec, message, nullptr);
+  size_t payload_size = g_bytes_get_size(encoded_message);
+  size_t iterations = CLAMP(kBytesPerMeasurement / payload_size,
+                            kMinIterations, kMaxIterations);
+  g_autofree gchar* channel =
+      g_strdup_printf("%s%s", kChannelPrefix, shape.method);
+
+  // The reply to an echo is encoded exactly like the message.
+  ReplyCheck check = {codec, encoded_message, FALSE};
+  fake_host_messenger_send_host_message(messenger, channel, message,
+                                        check_reply, &check);
+
+  Measurement encode = measure(iterations, [&]() {
+    g_autoptr(GBytes) encoded =
+        fl_message_codec_encode_message(codec, message, nullptr);
+  });
+  Measurement decode = measure(iterations, [&]() {
+    g_autoptr(FlValue) decoded =
+        fl_message_codec_decode_message(codec, encoded_message, nullptr);
+  });
+  Measurement round_trip = measure(iterations, [&]() {
+    fake_host_messenger_send_host_message(messenger, channel, message,
+                                          ignore_reply, nullptr);
+  });
+
+  printf("%s    {\n", is_first ? "" : ",\n");
+  printf("      \"method\": \"%s\",\n", shape.method);
+  if (shape.argument != nullptr) {
+    printf("      \"argument\": \"%s\",\n", shape.argument);
+  }
+  printf("      \"payload_bytes\": %zu,\n", payload_size);
+  printf("      \"iterations\": %zu,\n", iterations);
+  print_measurement("encode", encode, ",");
+  print_measurement("decode", decode, ",");
+  print_measurement("round_trip", round_trip, "");
+  printf("    }");
+  fflush(stdout);
+  return check.echoed;
+}
+
+}  // namespace
+
+extern "C" {
+
+void* malloc(size_t size) noexcept {
+  allocation_count.fetch_add(1, std::memory_order_relaxed);
+  return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size) noexcept {
+  allocation_count.fetch_add(1, std::memory_order_relaxed);
+  return __libc_calloc(count, size);
+}
+
+void* realloc(void* pointer, size_t size) noexcept {
+  if (pointer == nullptr) {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+  }
+  return __libc_realloc(pointer, size);
+}
+
+}  // extern "C"
+
+int main(int argc, char** argv) {
+  g_autoptr(FlMessageCodec) codec = create_codec();
+  g_autoptr(FakeHostMessenger) messenger = fake_host_messenger_new(codec);
+  g_autoptr(TestPlugin) plugin =
+      test_plugin_new(FL_BINARY_MESSENGER(messenger));
+
+  bool echoed = true;
+  bool is_first = true;
+  printf("{\n");
+  printf("  \"api\": \"HostIntegrationCoreApi\",\n");
+  printf("  \"generator\": \"gobject\",\n");
+  printf("  \"results\": [\n");
+  for (const EchoShape& shape : kEchoShapes) {
+    if (shape.element_size == 0) {
+      echoed = run_benchmark(messenger, codec, shape, 1, is_first) && echoed;
+      is_first = false;
+      continue;
+    }
+    size_t last_count = 0;
+    for (size_t payload_size : kPayloadSizes) {
+      size_t count = MAX(payload_size / shape.element_size, 1);
+      if (payload_size > shape.max_payload_size || count == last_count) {
+        continue;
+      }
+      echoed =
+          run_benchmark(messenger, codec, shape, count, is_first) && echoed;
+      is_first = false;
+      last_count = count;
+    }
+  }
+  printf("\n  ]\n}\n");
+
+  if (!echoed) {
+    fprintf(stderr, "Not every argument was echoed\n");
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,112 @@
+// Copyright 2013 The Flutter Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Counts the heap allocations made when decoding an AllNullableTypes message.
+//
+// The message is decoded once with every nullable primitive field set and
+// once with them all null. Nullable primitives are stored inline in the data
+// class, so both decodes should make the same number of allocations; when each
+// value had its own allocation the first decode made one more per field.
+//
+// Allocations are counted by wrapping the C library allocator, which GLib
+// uses for g_malloc() and friends.
+
+#include <flutter_linux/flutter_linux.h>
+
+#include <atomic>
+#include <cstdio>
+
+#include "pigeon/core_tests.gen.h"
+
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* pointer, size_t size);
+}
+
+namespace {
+
+constexpr int kDecodeCount = 100000;
+
+std::atomic<size_t> allocation_count(0);
+
+FlMessageCodec* create_codec() {
+  return FL_MESSAGE_CODEC(
+      g_object_new(core_tests_pigeon_test_message_codec_get_type(), nullptr));
+}
+
+GBytes* encode_all_nullable_types(FlMessageCodec* codec, gboolean set_fields) {
+  gboolean a_bool = TRUE;
+  int64_t an_int = 42;
+  int64_t an_int64 = G_MAXINT64;
+  double a_double = 3.14;
+  CoreTestsPigeonTestAnEnum an_enum =
+      PIGEON_INTEGRATION_TESTS_AN_ENUM_FORTY_TWO;
+  CoreTestsPigeonTestAnotherEnum another_enum =
+      PIGEON_INTEGRATION_TESTS_ANOTHER_ENUM_JUST_IN_CASE;
+  g_autoptr(CoreTestsPigeonTestAllNullableTypes) object =
+      core_tests_pigeon_test_all_nullable_types_new(
+          set_fields ? &a_bool : nullptr, set_fields ? &an_int : nullptr,
+          set_fields ? &an_int64 : nullptr, set_fields ? &a_double : nullptr,
+          nullptr, 0, nullptr, 0, nullptr, 0, nullptr, 0,
+          set_fields ? &an_enum : nullptr,
+          set_fields ? &another_enum : nullptr, "a string", nullptr, nullptr,
+          nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,
+          nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,
+          nullptr, nullptr, nullptr, nullptr);
+  g_autoptr(FlValue) value = fl_value_new_custom_object(
+      core_tests_pigeon_test_all_nullable_types_type_id, G_OBJECT(object));
+  return fl_message_codec_encode_message(codec, value, nullptr);
+}
+
+void run_decode_benchmark(const char* name, FlMessageCodec* codec,
+                          GBytes* message) {
+  size_t allocations_before = allocation_count.load();
+  gint64 start = g_get_monotonic_time();
+  for (int i = 0; i < kDecodeCount; i++) {
+    g_autoptr(FlValue) value =
+        fl_message_codec_decode_message(codec, message, nullptr);
+  }
+  gint64 elapsed = g_get_monotonic_time() - start;
+  size_t allocations = allocation_count.load() - allocations_before;
+
+  printf("%-28s %10.3f us/decode %10.2f allocations/decode\n", name,
+         static_cast<double>(elapsed) / kDecodeCount,
+         static_cast<double>(allocations) / kDecodeCount);
+}
+
+}  // namespace
+
+extern "C" {
+
+void* malloc(size_t size) noexcept {
+  allocation_count.fetch_add(1, std::memory_order_relaxed);
+  return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size) noexcept {
+  allocation_count.fetch_add(1, std::memory_order_relaxed);
+  return __libc_calloc(count, size);
+}
+
+void* realloc(void* pointer, size_t size) noexcept {
+  if (pointer == nullptr) {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+  }
+  return __libc_realloc(pointer, size);
+}
+
+}  // extern "C"
+
+int main(int argc, char** argv) {
+  g_autoptr(FlMessageCodec) codec = create_codec();
+  g_autoptr(GBytes) set_message = encode_all_nullable_types(codec, TRUE);
+  g_autoptr(GBytes) null_message = encode_all_nullable_types(codec, FALSE);
+
+  printf("Decoding AllNullableTypes %d times:\n", kDecodeCount);
+  run_decode_benchmark("primitives set", codec, set_message);
+  run_decode_benchmark("primitives null", codec, null_message);
+
+  return 0;
+}
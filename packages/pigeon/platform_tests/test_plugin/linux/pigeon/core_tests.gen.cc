@@ -27,6 +27,91 @@ static guint G_GNUC_UNUSED flpigeon_hash_double(double v) {
 static gboolean G_GNUC_UNUSED flpigeon_equals_double(double a, double b) {
   return (a == b) || (std::isnan(a) && std::isnan(b));
 }
+static guint G_GNUC_UNUSED flpigeon_deep_hash(FlValue* value) {
+  if (value == nullptr) {
+    return 0;
+  }
+  switch (fl_value_get_type(value)) {
+    case FL_VALUE_TYPE_NULL:
+      return 0;
+    case FL_VALUE_TYPE_BOOL:
+      return fl_value_get_bool(value) ? 1231 : 1237;
+    case FL_VALUE_TYPE_INT: {
+      int64_t v = fl_value_get_int(value);
+      return static_cast<guint>(v ^ (v >> 32));
+    }
+    case FL_VALUE_TYPE_FLOAT:
+      return flpigeon_hash_double(fl_value_get_float(value));
+    case FL_VALUE_TYPE_STRING:
+      return g_str_hash(fl_value_get_string(value));
+    case FL_VALUE_TYPE_UINT8_LIST: {
+      guint result = 1;
+      size_t len = fl_value_get_length(value);
+      const uint8_t* data = fl_value_get_uint8_list(value);
+      for (size_t i = 0; i < len; i++) {
+        result = result * 31 + data[i];
+      }
+      return result;
+    }
+    case FL_VALUE_TYPE_INT32_LIST: {
+      guint result = 1;
+      size_t len = fl_value_get_length(value);
+      const int32_t* data = fl_value_get_int32_list(value);
+      for (size_t i = 0; i < len; i++) {
+        result = result * 31 + static_cast<guint>(data[i]);
+      }
+      return result;
+    }
+    case FL_VALUE_TYPE_INT64_LIST: {
+      guint result = 1;
+      size_t len = fl_value_get_length(value);
+      const int64_t* data = fl_value_get_int64_list(value);
+      for (size_t i = 0; i < len; i++) {
+        result = result * 31 + static_cast<guint>(data[i] ^ (data[i] >> 32));
+      }
+      return result;
+    }
+    case FL_VALUE_TYPE_FLOAT_LIST: {
+      guint result = 1;
+      size_t len = fl_value_get_length(value);
+      const double* data = fl_value_get_float_list(value);
+      for (size_t i = 0; i < len; i++) {
+        result = result * 31 + flpigeon_hash_double(data[i]);
+      }
+      return result;
+    }
+    case FL_VALUE_TYPE_LIST: {
+      guint result = 1;
+      size_t len = fl_value_get_length(value);
+      for (size_t i = 0; i < len; i++) {
+        result =
+            result * 31 + flpigeon_deep_hash(fl_value_get_list_value(value, i));
+      }
+      return result;
+    }
+    case FL_VALUE_TYPE_MAP: {
+      guint result = 0;
+      size_t len = fl_value_get_length(value);
+      for (size_t i = 0; i < len; i++) {
+        result += ((flpigeon_deep_hash(fl_value_get_map_key(value, i)) * 31) ^
+                   flpigeon_deep_hash(fl_value_get_map_value(value, i)));
+      }
+      return result;
+    }
+    default:
+      return static_cast<guint>(fl_value_get_type(value));
+  }
+  return 0;
+}
+static gboolean G_GNUC_UNUSED flpigeon_deep_equals(FlValue* a, FlValue* b);
+static guint G_GNUC_UNUSED flpigeon_deep_hash_cb(gconstpointer value) {
+  return flpigeon_deep_hash(static_cast<FlValue*>(const_cast<gpointer>(value)));
+}
+static gboolean G_GNUC_UNUSED flpigeon_deep_equals_cb(gconstpointer a,
+                                                      gconstpointer b) {
+  return flpigeon_deep_equals(static_cast<FlValue*>(const_cast<gpointer>(a)),
+                              static_cast<FlValue*>(const_cast<gpointer>(b)));
+}
 static gboolean G_GNUC_UNUSED flpigeon_deep_equals(FlValue* a, FlValue* b) {
   if (a == b) {
     return TRUE;
@@ -94,23 +179,44 @@ static gboolean G_GNUC_UNUSED flpigeon_deep_equals(FlValue* a, FlValue* b) {
       if (len != fl_value_get_length(b)) {
         return FALSE;
       }
-      for (size_t i = 0; i < len; i++) {
-        FlValue* key = fl_value_get_map_key(a, i);
-        FlValue* val = fl_value_get_map_value(a, i);
-        gboolean found = FALSE;
-        for (size_t j = 0; j < len; j++) {
-          FlValue* b_key = fl_value_get_map_key(b, j);
-          if (flpigeon_deep_equals(key, b_key)) {
-            FlValue* b_val = fl_value_get_map_value(b, j);
-            if (flpigeon_deep_equals(val, b_val)) {
-              found = TRUE;
-              break;
-            } else {
-              return FALSE;
+      // Small maps are compared pair by pair, larger maps by looking up
+      // each key in a hash table of the entries in b.
+      if (len <= 8) {
+        for (size_t i = 0; i < len; i++) {
+          FlValue* key = fl_value_get_map_key(a, i);
+          FlValue* val = fl_value_get_map_value(a, i);
+          gboolean found = FALSE;
+          for (size_t j = 0; j < len; j++) {
+            FlValue* b_key = fl_value_get_map_key(b, j);
+            if (flpigeon_deep_equals(key, b_key)) {
+              FlValue* b_val = fl_value_get_map_value(b, j);
+              if (flpigeon_deep_equals(val, b_val)) {
+                found = TRUE;
+                break;
+              } else {
+                return FALSE;
+              }
             }
           }
+          if (!found) {
+            return FALSE;
+          }
         }
-        if (!found) {
+        return TRUE;
+      }
+      g_autoptr(GHashTable) b_entries =
+          g_hash_table_new(flpigeon_deep_hash_cb, flpigeon_deep_equals_cb);
+      // Inserted last to first, so the first of any equal keys is used.
+      for (size_t i = len; i > 0; i--) {
+        g_hash_table_insert(b_entries, fl_value_get_map_key(b, i - 1),
+                            fl_value_get_map_value(b, i - 1));
+      }
+      for (size_t i = 0; i < len; i++) {
+        gpointer b_val;
+        if (!g_hash_table_lookup_extended(
+                b_entries, fl_value_get_map_key(a, i), nullptr, &b_val) ||
+            !flpigeon_deep_equals(fl_value_get_map_value(a, i),
+                                  static_cast<FlValue*>(b_val))) {
           return FALSE;
         }
       }
@@ -121,82 +227,6 @@ static gboolean G_GNUC_UNUSED flpigeon_deep_equals(FlValue* a, FlValue* b) {
   }
   return FALSE;
 }
-static guint G_GNUC_UNUSED flpigeon_deep_hash(FlValue* value) {
-  if (value == nullptr) {
-    return 0;
-  }
-  switch (fl_value_get_type(value)) {
-    case FL_VALUE_TYPE_NULL:
-      return 0;
-    case FL_VALUE_TYPE_BOOL:
-      return fl_value_get_bool(value) ? 1231 : 1237;
-    case FL_VALUE_TYPE_INT: {
-      int64_t v = fl_value_get_int(value);
-      return static_cast<guint>(v ^ (v >> 32));
-    }
-    case FL_VALUE_TYPE_FLOAT:
-      return flpigeon_hash_double(fl_value_get_float(value));
-    case FL_VALUE_TYPE_STRING:
-      return g_str_hash(fl_value_get_string(value));
-    case FL_VALUE_TYPE_UINT8_LIST: {
-      guint result = 1;
-      size_t len = fl_value_get_length(value);
-      const uint8_t* data = fl_value_get_uint8_list(value);
-      for (size_t i = 0; i < len; i++) {
-        result = result * 31 + data[i];
-      }
-      return result;
-    }
-    case FL_VALUE_TYPE_INT32_LIST: {
-      guint result = 1;
-      size_t len = fl_value_get_length(value);
-      const int32_t* data = fl_value_get_int32_list(value);
-      for (size_t i = 0; i < len; i++) {
-        result = result * 31 + static_cast<guint>(data[i]);
-      }
-      return result;
-    }
-    case FL_VALUE_TYPE_INT64_LIST: {
-      guint result = 1;
-      size_t len = fl_value_get_length(value);
-      const int64_t* data = fl_value_get_int64_list(value);
-      for (size_t i = 0; i < len; i++) {
-        result = result * 31 + static_cast<guint>(data[i] ^ (data[i] >> 32));
-      }
-      return result;
-    }
-    case FL_VALUE_TYPE_FLOAT_LIST: {
-      guint result = 1;
-      size_t len = fl_value_get_length(value);
-      const double* data = fl_value_get_float_list(value);
-      for (size_t i = 0; i < len; i++) {
-        result = result * 31 + flpigeon_hash_double(data[i]);
-      }
-      return result;
-    }
-    case FL_VALUE_TYPE_LIST: {
-      guint result = 1;
-      size_t len = fl_value_get_length(value);
-      for (size_t i = 0; i < len; i++) {
-        result =
-            result * 31 + flpigeon_deep_hash(fl_value_get_list_value(value, i));
-      }
-      return result;
-    }
-    case FL_VALUE_TYPE_MAP: {
-      guint result = 0;
-      size_t len = fl_value_get_length(value);
-      for (size_t i = 0; i < len; i++) {
-        result += ((flpigeon_deep_hash(fl_value_get_map_key(value, i)) * 31) ^
-                   flpigeon_deep_hash(fl_value_get_map_value(value, i)));
-      }
-      return result;
-    }
-    default:
-      return static_cast<guint>(fl_value_get_type(value));
-  }
-  return 0;
-}
 static gchar* G_GNUC_UNUSED flpigeon_to_string(FlValue* value) {
   if (value == nullptr) {
     return g_strdup("null");
@@ -299,11 +329,253 @@ static gchar* G_GNUC_UNUSED flpigeon_to_string(FlValue* value) {
   }
   return g_strdup("null");
 }
+static void G_GNUC_UNUSED flpigeon_write_uint8(GByteArray* buffer,
+                                               uint8_t value) {
+  g_byte_array_append(buffer, &value, sizeof(uint8_t));
+}
+static void G_GNUC_UNUSED flpigeon_write_alignment(GByteArray* buffer,
+                                                   size_t alignment) {
+  while (buffer->len % alignment != 0) {
+    flpigeon_write_uint8(buffer, 0);
+  }
+}
+static void G_GNUC_UNUSED flpigeon_write_null(GByteArray* buffer) {
+  flpigeon_write_uint8(buffer, 0);
+}
+static void G_GNUC_UNUSED flpigeon_write_bool(GByteArray* buffer,
+                                              gboolean value) {
+  flpigeon_write_uint8(buffer, value ? 1 : 2);
+}
+static void G_GNUC_UNUSED flpigeon_write_int(GByteArray* buffer,
+                                             int64_t value) {
+  if (value >= INT32_MIN && value <= INT32_MAX) {
+    int32_t value32 = static_cast<int32_t>(value);
+    flpigeon_write_uint8(buffer, 3);
+    g_byte_array_append(buffer, reinterpret_cast<uint8_t*>(&value32),
+                        sizeof(int32_t));
+  } else {
+    flpigeon_write_uint8(buffer, 4);
+    g_byte_array_append(buffer, reinterpret_cast<uint8_t*>(&value),
+                        sizeof(int64_t));
+  }
+}
+static void G_GNUC_UNUSED flpigeon_write_double(GByteArray* buffer,
+                                                double value) {
+  flpigeon_write_uint8(buffer, 6);
+  flpigeon_write_alignment(buffer, 8);
+  g_byte_array_append(buffer, reinterpret_cast<uint8_t*>(&value),
+                      sizeof(double));
+}
+static void G_GNUC_UNUSED flpigeon_write_string(FlStandardMessageCodec* codec,
+                                                GByteArray* buffer,
+                                                const gchar* value) {
+  size_t length = strlen(value);
+  flpigeon_write_uint8(buffer, 7);
+  fl_standard_message_codec_write_size(codec, buffer, length);
+  g_byte_array_append(buffer, reinterpret_cast<const uint8_t*>(value), length);
+}
+static void G_GNUC_UNUSED flpigeon_write_typed_list(
+    FlStandardMessageCodec* codec, GByteArray* buffer, uint8_t type,
+    const void* data, size_t length, size_t element_size) {
+  flpigeon_write_uint8(buffer, type);
+  fl_standard_message_codec_write_size(codec, buffer, length);
+  flpigeon_write_alignment(buffer, element_size);
+  g_byte_array_append(buffer, static_cast<const uint8_t*>(data),
+                      length * element_size);
+}
+static void G_GNUC_UNUSED
+flpigeon_write_uint8_list(FlStandardMessageCodec* codec, GByteArray* buffer,
+                          const uint8_t* value, size_t length) {
+  flpigeon_write_typed_list(codec, buffer, 8, value, length, sizeof(uint8_t));
+}
+static void G_GNUC_UNUSED
+flpigeon_write_int32_list(FlStandardMessageCodec* codec, GByteArray* buffer,
+                          const int32_t* value, size_t length) {
+  flpigeon_write_typed_list(codec, buffer, 9, value, length, sizeof(int32_t));
+}
+static void G_GNUC_UNUSED
+flpigeon_write_int64_list(FlStandardMessageCodec* codec, GByteArray* buffer,
+                          const int64_t* value, size_t length) {
+  flpigeon_write_typed_list(codec, buffer, 10, value, length, sizeof(int64_t));
+}
+static void G_GNUC_UNUSED
+flpigeon_write_float_list(FlStandardMessageCodec* codec, GByteArray* buffer,
+                          const double* value, size_t length) {
+  flpigeon_write_typed_list(codec, buffer, 11, value, length, sizeof(double));
+}
+static void G_GNUC_UNUSED
+flpigeon_write_float32_list(FlStandardMessageCodec* codec, GByteArray* buffer,
+                            const float* value, size_t length) {
+  flpigeon_write_typed_list(codec, buffer, 14, value, length, sizeof(float));
+}
+static void G_GNUC_UNUSED flpigeon_write_list_header(
+    FlStandardMessageCodec* codec, GByteArray* buffer, size_t length) {
+  flpigeon_write_uint8(buffer, 12);
+  fl_standard_message_codec_write_size(codec, buffer, length);
+}
+static void G_GNUC_UNUSED flpigeon_write_enum(GByteArray* buffer, uint8_t type,
+                                              int64_t value) {
+  flpigeon_write_uint8(buffer, type);
+  flpigeon_write_int(buffer, value);
+}
+static gboolean G_GNUC_UNUSED flpigeon_read_uint8(GBytes* buffer,
+                                                  size_t* offset,
+                                                  uint8_t* value,
+                                                  GError** error) {
+  size_t size;
+  const uint8_t* data =
+      static_cast<const uint8_t*>(g_bytes_get_data(buffer, &size));
+  if (*offset >= size) {
+    g_set_error(error, FL_MESSAGE_CODEC_ERROR,
+                FL_MESSAGE_CODEC_ERROR_OUT_OF_DATA, "Unexpected end of data");
+    return FALSE;
+  }
+  *value = data[*offset];
+  (*offset)++;
+  return TRUE;
+}
+static gboolean G_GNUC_UNUSED flpigeon_read_list_header(
+    FlStandardMessageCodec* codec, GBytes* buffer, size_t* offset,
+    uint32_t min_length, uint32_t* length, GError** error) {
+  uint8_t type;
+  if (!flpigeon_read_uint8(buffer, offset, &type, error)) {
+    return FALSE;
+  }
+  if (type != 12) {
+    g_set_error(error, FL_MESSAGE_CODEC_ERROR, FL_MESSAGE_CODEC_ERROR_FAILED,
+                "Expected list, got type %d", type);
+    return FALSE;
+  }
+  if (!fl_standard_message_codec_read_size(codec, buffer, offset, length,
+                                           error)) {
+    return FALSE;
+  }
+  if (*length < min_length) {
+    g_set_error(error, FL_MESSAGE_CODEC_ERROR, FL_MESSAGE_CODEC_ERROR_FAILED,
+                "Expected list of at least %u values, got %u", min_length,
+                *length);
+    return FALSE;
+  }
+  return TRUE;
+}
+static gboolean G_GNUC_UNUSED flpigeon_skip_values(
+    FlStandardMessageCodec* codec, GBytes* buffer, size_t* offset,
+    uint32_t count, GError** error) {
+  for (uint32_t i = 0; i < count; i++) {
+    g_autoptr(FlValue) value =
+        fl_standard_message_codec_read_value(codec, buffer, offset, error);
+    if (value == nullptr) {
+      return FALSE;
+    }
+  }
+  return TRUE;
+}
+static gboolean G_GNUC_UNUSED flpigeon_read_typed_data(
+    FlStandardMessageCodec* codec, GBytes* buffer, size_t* offset,
+    uint8_t expected_type, size_t element_size, gboolean nullable,
+    GBytes** value, GError** error) {
+  uint8_t type;
+  if (!flpigeon_read_uint8(buffer, offset, &type, error)) {
+    return FALSE;
+  }
+  if (type == 0 && nullable) {
+    *value = nullptr;
+    return TRUE;
+  }
+  if (type != expected_type) {
+    g_set_error(error, FL_MESSAGE_CODEC_ERROR, FL_MESSAGE_CODEC_ERROR_FAILED,
+                "Expected typed data of type %d, got type %d", expected_type,
+                type);
+    return FALSE;
+  }
+  uint32_t length;
+  if (!fl_standard_message_codec_read_size(codec, buffer, offset, &length,
+                                           error)) {
+    return FALSE;
+  }
+  while (*offset % element_size != 0) {
+    (*offset)++;
+  }
+  size_t data_size = static_cast<size_t>(length) * element_size;
+  if (*offset + data_size > g_bytes_get_size(buffer)) {
+    g_set_error(error, FL_MESSAGE_CODEC_ERROR,
+                FL_MESSAGE_CODEC_ERROR_OUT_OF_DATA, "Unexpected end of data");
+    return FALSE;
+  }
+  *value = g_bytes_new_from_bytes(buffer, *offset, data_size);
+  *offset += data_size;
+  return TRUE;
+}
+static gboolean G_GNUC_UNUSED flpigeon_read_typed_list(
+    FlStandardMessageCodec* codec, GBytes* buffer, size_t* offset,
+    uint8_t expected_type, size_t element_size, gboolean nullable,
+    gpointer* value, size_t* length, GError** error) {
+  g_autoptr(GBytes) data = nullptr;
+  if (!flpigeon_read_typed_data(codec, buffer, offset, expected_type,
+                                element_size, nullable, &data, error)) {
+    return FALSE;
+  }
+  if (data == nullptr) {
+    *value = nullptr;
+    *length = 0;
+    return TRUE;
+  }
+  size_t data_size;
+  gconstpointer d = g_bytes_get_data(data, &data_size);
+  // Empty lists are allocated too, so they are distinct from null.
+  *value = g_malloc(data_size > 0 ? data_size : 1);
+  memcpy(*value, d, data_size);
+  *length = data_size / element_size;
+  return TRUE;
+}
+static gboolean G_GNUC_UNUSED flpigeon_read_string(
+    FlStandardMessageCodec* codec, GBytes* buffer, size_t* offset,
+    gboolean nullable, gchar** value, GError** error) {
+  uint8_t type;
+  if (!flpigeon_read_uint8(buffer, offset, &type, error)) {
+    return FALSE;
+  }
+  if (type == 0 && nullable) {
+    *value = nullptr;
+    return TRUE;
+  }
+  if (type != 7) {
+    g_set_error(error, FL_MESSAGE_CODEC_ERROR, FL_MESSAGE_CODEC_ERROR_FAILED,
+                "Expected string, got type %d", type);
+    return FALSE;
+  }
+  uint32_t length;
+  if (!fl_standard_message_codec_read_size(codec, buffer, offset, &length,
+                                           error)) {
+    return FALSE;
+  }
+  size_t size;
+  const uint8_t* data =
+      static_cast<const uint8_t*>(g_bytes_get_data(buffer, &size));
+  if (*offset + length > size) {
+    g_set_error(error, FL_MESSAGE_CODEC_ERROR,
+                FL_MESSAGE_CODEC_ERROR_OUT_OF_DATA, "Unexpected end of data");
+    return FALSE;
+  }
+  *value = g_strndup(reinterpret_cast<const gchar*>(data + *offset), length);
+  *offset += length;
+  return TRUE;
+}
+// FlValue has no data for an empty typed list, so empty lists point at a
+// buffer of their own to keep them distinct from null.
+static gconstpointer G_GNUC_UNUSED
+flpigeon_get_typed_list_data(gconstpointer data) {
+  static const int64_t empty = 0;
+  return data != nullptr ? data : &empty;
+}
 
 struct _CoreTestsPigeonTestUnusedClass {
   GObject parent_instance;
 
   FlValue* a_field;
+  // Hash code, calculated the first time it is needed.
+  guint pigeon_hash;
+  gint pigeon_hash_set;
 };
 
 G_DEFINE_TYPE(CoreTestsPigeonTestUnusedClass,
@@ -337,29 +609,42 @@ CoreTestsPigeonTestUnusedClass* core_tests_pigeon_test_unused_class_new(
   return self;
 }
 
+CoreTestsPigeonTestUnusedClass* core_tests_pigeon_test_unused_class_new_take(
+    FlValue* a_field) {
+  CoreTestsPigeonTestUnusedClass* self = CORE_TESTS_PIGEON_TEST_UNUSED_CLASS(
+      g_object_new(core_tests_pigeon_test_unused_class_get_type(), nullptr));
+  self->a_field = a_field;
+  return self;
+}
+
 FlValue* core_tests_pigeon_test_unused_class_get_a_field(
     CoreTestsPigeonTestUnusedClass* self) {
   g_return_val_if_fail(CORE_TESTS_PIGEON_TEST_IS_UNUSED_CLASS(self), nullptr);
   return self->a_field;
 }
 
-static FlValue* core_tests_pigeon_test_unused_class_to_list(
-    CoreTestsPigeonTestUnusedClass* self) {
-  FlValue* values = fl_value_new_list();
-  fl_value_append_take(values, self->a_field != nullptr
-                                   ? fl_value_ref(self->a_field)
-                                   : fl_value_new_null());
-  return values;
-}
-
 static CoreTestsPigeonTestUnusedClass*
-core_tests_pigeon_test_unused_class_new_from_list(FlValue* values) {
-  FlValue* value0 = fl_value_get_list_value(values, 0);
+core_tests_pigeon_test_unused_class_new_from_buffer(
+    FlStandardMessageCodec* codec, GBytes* buffer, size_t* offset,
+    GError** error) {
+  uint32_t n_values;
+  if (!flpigeon_read_list_header(codec, buffer, offset, 1, &n_values,
+                                 error)) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value0 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value0 == nullptr) {
+    return nullptr;
+  }
+  if (!flpigeon_skip_values(codec, buffer, offset, n_values - 1, error)) {
+    return nullptr;
+  }
   FlValue* a_field = nullptr;
   if (fl_value_get_type(value0) != FL_VALUE_TYPE_NULL) {
-    a_field = value0;
+    a_field = fl_value_ref(value0);
   }
-  return core_tests_pigeon_test_unused_class_new(a_field);
+  return core_tests_pigeon_test_unused_class_new_take(a_field);
 }
 
 gboolean core_tests_pigeon_test_unused_class_equals(
@@ -370,6 +655,12 @@ gboolean core_tests_pigeon_test_unused_class_equals(
   if (a == nullptr || b == nullptr) {
     return FALSE;
   }
+  // Objects with different hash codes are not equal.
+  if (g_atomic_int_get(&a->pigeon_hash_set) &&
+      g_atomic_int_get(&b->pigeon_hash_set) &&
+      a->pigeon_hash != b->pigeon_hash) {
+    return FALSE;
+  }
   if (!flpigeon_deep_equals(a->a_field, b->a_field)) {
     return FALSE;
   }
@@ -379,8 +670,13 @@ gboolean core_tests_pigeon_test_unused_class_equals(
 guint core_tests_pigeon_test_unused_class_hash(
     CoreTestsPigeonTestUnusedClass* self) {
   g_return_val_if_fail(CORE_TESTS_PIGEON_TEST_IS_UNUSED_CLASS(self), 0);
+  if (g_atomic_int_get(&self->pigeon_hash_set)) {
+    return self->pigeon_hash;
+  }
   guint result = 0;
   result = result * 31 + flpigeon_deep_hash(self->a_field);
+  self->pigeon_hash = result;
+  g_atomic_int_set(&self->pigeon_hash_set, TRUE);
   return result;
 }
 
@@ -435,6 +731,9 @@ struct _CoreTestsPigeonTestAllTypes {
   FlValue* object_map;
   FlValue* list_map;
   FlValue* map_map;
+  // Hash code, calculated the first time it is needed.
+  guint pigeon_hash;
+  gint pigeon_hash_set;
 };
 
 G_DEFINE_TYPE(CoreTestsPigeonTestAllTypes, core_tests_pigeon_test_all_types,
@@ -442,6 +741,10 @@ G_DEFINE_TYPE(CoreTestsPigeonTestAllTypes, core_tests_pigeon_test_all_types,
 
 static void core_tests_pigeon_test_all_types_dispose(GObject* object) {
   CoreTestsPigeonTestAllTypes* self = CORE_TESTS_PIGEON_TEST_ALL_TYPES(object);
+  g_clear_pointer(&self->a_byte_array, g_free);
+  g_clear_pointer(&self->a4_byte_array, g_free);
+  g_clear_pointer(&self->a8_byte_array, g_free);
+  g_clear_pointer(&self->a_float_array, g_free);
   g_clear_pointer(&self->a_string, g_free);
   g_clear_pointer(&self->an_object, fl_value_unref);
   g_clear_pointer(&self->list, fl_value_unref);
@@ -529,6 +832,55 @@ CoreTestsPigeonTestAllTypes* core_tests_pigeon_test_all_types_new(
   return self;
 }
 
+CoreTestsPigeonTestAllTypes* core_tests_pigeon_test_all_types_new_take(
+    gboolean a_bool, int64_t an_int, int64_t an_int64, double a_double,
+    uint8_t* a_byte_array, size_t a_byte_array_length, int32_t* a4_byte_array,
+    size_t a4_byte_array_length, int64_t* a8_byte_array,
+    size_t a8_byte_array_length, double* a_float_array,
+    size_t a_float_array_length, CoreTestsPigeonTestAnEnum an_enum,
+    CoreTestsPigeonTestAnotherEnum another_enum, gchar* a_string,
+    FlValue* an_object, FlValue* list, FlValue* string_list, FlValue* int_list,
+    FlValue* double_list, FlValue* bool_list, FlValue* enum_list,
+    FlValue* object_list, FlValue* list_list, FlValue* map_list, FlValue* map,
+    FlValue* string_map, FlValue* int_map, FlValue* enum_map,
+    FlValue* object_map, FlValue* list_map, FlValue* map_map) {
+  CoreTestsPigeonTestAllTypes* self = CORE_TESTS_PIGEON_TEST_ALL_TYPES(
+      g_object_new(core_tests_pigeon_test_all_types_get_type(), nullptr));
+  self->a_bool = a_bool;
+  self->an_int = an_int;
+  self->an_int64 = an_int64;
+  self->a_double = a_double;
+  self->a_byte_array = a_byte_array;
+  self->a_byte_array_length = a_byte_array_length;
+  self->a4_byte_array = a4_byte_array;
+  self->a4_byte_array_length = a4_byte_array_length;
+  self->a8_byte_array = a8_byte_array;
+  self->a8_byte_array_length = a8_byte_array_length;
+  self->a_float_array = a_float_array;
+  self->a_float_array_length = a_float_array_length;
+  self->an_enum = an_enum;
+  self->another_enum = another_enum;
+  self->a_string = a_string;
+  self->an_object = an_object;
+  self->list = list;
+  self->string_list = string_list;
+  self->int_list = int_list;
+  self->double_list = double_list;
+  self->bool_list = bool_list;
+  self->enum_list = enum_list;
+  self->object_list = object_list;
+  self->list_list = list_list;
+  self->map_list = map_list;
+  self->map = map;
+  self->string_map = string_map;
+  self->int_map = int_map;
+  self->enum_map = enum_map;
+  self->object_map = object_map;
+  self->list_map = list_map;
+  self->map_map = map_map;
+  return self;
+}
+
 gboolean core_tests_pigeon_test_all_types_get_a_bool(
     CoreTestsPigeonTestAllTypes* self) {
   g_return_val_if_fail(CORE_TESTS_PIGEON_TEST_IS_ALL_TYPES(self), FALSE);
@@ -704,128 +1056,211 @@ FlValue* core_tests_pigeon_test_all_types_get_map_map(
   return self->map_map;
 }
 
-static FlValue* core_tests_pigeon_test_all_types_to_list(
-    CoreTestsPigeonTestAllTypes* self) {
-  FlValue* values = fl_value_new_list();
-  fl_value_append_take(values, fl_value_new_bool(self->a_bool));
-  fl_value_append_take(values, fl_value_new_int(self->an_int));
-  fl_value_append_take(values, fl_value_new_int(self->an_int64));
-  fl_value_append_take(values, fl_value_new_float(self->a_double));
-  fl_value_append_take(
-      values,
-      fl_value_new_uint8_list(self->a_byte_array, self->a_byte_array_length));
-  fl_value_append_take(
-      values,
-      fl_value_new_int32_list(self->a4_byte_array, self->a4_byte_array_length));
-  fl_value_append_take(
-      values,
-      fl_value_new_int64_list(self->a8_byte_array, self->a8_byte_array_length));
-  fl_value_append_take(
-      values,
-      fl_value_new_float_list(self->a_float_array, self->a_float_array_length));
-  fl_value_append_take(
-      values, fl_value_new_custom(core_tests_pigeon_test_an_enum_type_id,
-                                  fl_value_new_int(self->an_enum),
-                                  (GDestroyNotify)fl_value_unref));
-  fl_value_append_take(
-      values, fl_value_new_custom(core_tests_pigeon_test_another_enum_type_id,
-                                  fl_value_new_int(self->another_enum),
-                                  (GDestroyNotify)fl_value_unref));
-  fl_value_append_take(values, fl_value_new_string(self->a_string));
-  fl_value_append_take(values, fl_value_ref(self->an_object));
-  fl_value_append_take(values, fl_value_ref(self->list));
-  fl_value_append_take(values, fl_value_ref(self->string_list));
-  fl_value_append_take(values, fl_value_ref(self->int_list));
-  fl_value_append_take(values, fl_value_ref(self->double_list));
-  fl_value_append_take(values, fl_value_ref(self->bool_list));
-  fl_value_append_take(values, fl_value_ref(self->enum_list));
-  fl_value_append_take(values, fl_value_ref(self->object_list));
-  fl_value_append_take(values, fl_value_ref(self->list_list));
-  fl_value_append_take(values, fl_value_ref(self->map_list));
-  fl_value_append_take(values, fl_value_ref(self->map));
-  fl_value_append_take(values, fl_value_ref(self->string_map));
-  fl_value_append_take(values, fl_value_ref(self->int_map));
-  fl_value_append_take(values, fl_value_ref(self->enum_map));
-  fl_value_append_take(values, fl_value_ref(self->object_map));
-  fl_value_append_take(values, fl_value_ref(self->list_map));
-  fl_value_append_take(values, fl_value_ref(self->map_map));
-  return values;
-}
-
 static CoreTestsPigeonTestAllTypes*
-core_tests_pigeon_test_all_types_new_from_list(FlValue* values) {
-  FlValue* value0 = fl_value_get_list_value(values, 0);
+core_tests_pigeon_test_all_types_new_from_buffer(FlStandardMessageCodec* codec,
+                                                 GBytes* buffer, size_t* offset,
+                                                 GError** error) {
+  uint32_t n_values;
+  if (!flpigeon_read_list_header(codec, buffer, offset, 28, &n_values,
+                                 error)) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value0 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value0 == nullptr) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value1 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value1 == nullptr) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value2 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value2 == nullptr) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value3 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value3 == nullptr) {
+    return nullptr;
+  }
+  g_autofree uint8_t* a_byte_array = nullptr;
+  size_t a_byte_array_length;
+  if (!flpigeon_read_typed_list(codec, buffer, offset, 8, sizeof(uint8_t),
+                                FALSE,
+                                reinterpret_cast<gpointer*>(&a_byte_array),
+                                &a_byte_array_length, error)) {
+    return nullptr;
+  }
+  g_autofree int32_t* a4_byte_array = nullptr;
+  size_t a4_byte_array_length;
+  if (!flpigeon_read_typed_list(codec, buffer, offset, 9, sizeof(int32_t),
+                                FALSE,
+                                reinterpret_cast<gpointer*>(&a4_byte_array),
+                                &a4_byte_array_length, error)) {
+    return nullptr;
+  }
+  g_autofree int64_t* a8_byte_array = nullptr;
+  size_t a8_byte_array_length;
+  if (!flpigeon_read_typed_list(codec, buffer, offset, 10, sizeof(int64_t),
+                                FALSE,
+                                reinterpret_cast<gpointer*>(&a8_byte_array),
+                                &a8_byte_array_length, error)) {
+    return nullptr;
+  }
+  g_autofree double* a_float_array = nullptr;
+  size_t a_float_array_length;
+  if (!flpigeon_read_typed_list(codec, buffer, offset, 11, sizeof(double),
+                                FALSE,
+                                reinterpret_cast<gpointer*>(&a_float_array),
+                                &a_float_array_length, error)) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value8 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value8 == nullptr) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value9 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value9 == nullptr) {
+    return nullptr;
+  }
+  g_autofree gchar* a_string = nullptr;
+  if (!flpigeon_read_string(codec, buffer, offset, FALSE, &a_string, error)) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value11 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value11 == nullptr) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value12 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value12 == nullptr) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value13 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value13 == nullptr) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value14 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value14 == nullptr) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value15 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value15 == nullptr) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value16 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value16 == nullptr) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value17 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value17 == nullptr) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value18 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value18 == nullptr) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value19 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value19 == nullptr) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value20 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value20 == nullptr) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value21 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value21 == nullptr) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value22 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value22 == nullptr) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value23 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value23 == nullptr) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value24 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value24 == nullptr) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value25 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value25 == nullptr) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value26 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value26 == nullptr) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value27 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value27 == nullptr) {
+    return nullptr;
+  }
+  if (!flpigeon_skip_values(codec, buffer, offset, n_values - 28, error)) {
+    return nullptr;
+  }
   gboolean a_bool = fl_value_get_bool(value0);
-  FlValue* value1 = fl_value_get_list_value(values, 1);
   int64_t an_int = fl_value_get_int(value1);
-  FlValue* value2 = fl_value_get_list_value(values, 2);
   int64_t an_int64 = fl_value_get_int(value2);
-  FlValue* value3 = fl_value_get_list_value(values, 3);
   double a_double = fl_value_get_float(value3);
-  FlValue* value4 = fl_value_get_list_value(values, 4);
-  const uint8_t* a_byte_array = fl_value_get_uint8_list(value4);
-  size_t a_byte_array_length = fl_value_get_length(value4);
-  FlValue* value5 = fl_value_get_list_value(values, 5);
-  const int32_t* a4_byte_array = fl_value_get_int32_list(value5);
-  size_t a4_byte_array_length = fl_value_get_length(value5);
-  FlValue* value6 = fl_value_get_list_value(values, 6);
-  const int64_t* a8_byte_array = fl_value_get_int64_list(value6);
-  size_t a8_byte_array_length = fl_value_get_length(value6);
-  FlValue* value7 = fl_value_get_list_value(values, 7);
-  const double* a_float_array = fl_value_get_float_list(value7);
-  size_t a_float_array_length = fl_value_get_length(value7);
-  FlValue* value8 = fl_value_get_list_value(values, 8);
   CoreTestsPigeonTestAnEnum an_enum = static_cast<CoreTestsPigeonTestAnEnum>(
       fl_value_get_int(reinterpret_cast<FlValue*>(
           const_cast<gpointer>(fl_value_get_custom_value(value8)))));
-  FlValue* value9 = fl_value_get_list_value(values, 9);
   CoreTestsPigeonTestAnotherEnum another_enum =
       static_cast<CoreTestsPigeonTestAnotherEnum>(
           fl_value_get_int(reinterpret_cast<FlValue*>(
               const_cast<gpointer>(fl_value_get_custom_value(value9)))));
-  FlValue* value10 = fl_value_get_list_value(values, 10);
-  const gchar* a_string = fl_value_get_string(value10);
-  FlValue* value11 = fl_value_get_list_value(values, 11);
-  FlValue* an_object = value11;
-  FlValue* value12 = fl_value_get_list_value(values, 12);
-  FlValue* list = value12;
-  FlValue* value13 = fl_value_get_list_value(values, 13);
-  FlValue* string_list = value13;
-  FlValue* value14 = fl_value_get_list_value(values, 14);
-  FlValue* int_list = value14;
-  FlValue* value15 = fl_value_get_list_value(values, 15);
-  FlValue* double_list = value15;
-  FlValue* value16 = fl_value_get_list_value(values, 16);
-  FlValue* bool_list = value16;
-  FlValue* value17 = fl_value_get_list_value(values, 17);
-  FlValue* enum_list = value17;
-  FlValue* value18 = fl_value_get_list_value(values, 18);
-  FlValue* object_list = value18;
-  FlValue* value19 = fl_value_get_list_value(values, 19);
-  FlValue* list_list = value19;
-  FlValue* value20 = fl_value_get_list_value(values, 20);
-  FlValue* map_list = value20;
-  FlValue* value21 = fl_value_get_list_value(values, 21);
-  FlValue* map = value21;
-  FlValue* value22 = fl_value_get_list_value(values, 22);
-  FlValue* string_map = value22;
-  FlValue* value23 = fl_value_get_list_value(values, 23);
-  FlValue* int_map = value23;
-  FlValue* value24 = fl_value_get_list_value(values, 24);
-  FlValue* enum_map = value24;
-  FlValue* value25 = fl_value_get_list_value(values, 25);
-  FlValue* object_map = value25;
-  FlValue* value26 = fl_value_get_list_value(values, 26);
-  FlValue* list_map = value26;
-  FlValue* value27 = fl_value_get_list_value(values, 27);
-  FlValue* map_map = value27;
-  return core_tests_pigeon_test_all_types_new(
-      a_bool, an_int, an_int64, a_double, a_byte_array, a_byte_array_length,
-      a4_byte_array, a4_byte_array_length, a8_byte_array, a8_byte_array_length,
-      a_float_array, a_float_array_length, an_enum, another_enum, a_string,
-      an_object, list, string_list, int_list, double_list, bool_list, enum_list,
-      object_list, list_list, map_list, map, string_map, int_map, enum_map,
-      object_map, list_map, map_map);
+  FlValue* an_object = fl_value_ref(value11);
+  FlValue* list = fl_value_ref(value12);
+  FlValue* string_list = fl_value_ref(value13);
+  FlValue* int_list = fl_value_ref(value14);
+  FlValue* double_list = fl_value_ref(value15);
+  FlValue* bool_list = fl_value_ref(value16);
+  FlValue* enum_list = fl_value_ref(value17);
+  FlValue* object_list = fl_value_ref(value18);
+  FlValue* list_list = fl_value_ref(value19);
+  FlValue* map_list = fl_value_ref(value20);
+  FlValue* map = fl_value_ref(value21);
+  FlValue* string_map = fl_value_ref(value22);
+  FlValue* int_map = fl_value_ref(value23);
+  FlValue* enum_map = fl_value_ref(value24);
+  FlValue* object_map = fl_value_ref(value25);
+  FlValue* list_map = fl_value_ref(value26);
+  FlValue* map_map = fl_value_ref(value27);
+  return core_tests_pigeon_test_all_types_new_take(
+      a_bool, an_int, an_int64, a_double,
+      static_cast<uint8_t*>(g_steal_pointer(&a_byte_array)),
+      a_byte_array_length,
+      static_cast<int32_t*>(g_steal_pointer(&a4_byte_array)),
+      a4_byte_array_length,
+      static_cast<int64_t*>(g_steal_pointer(&a8_byte_array)),
+      a8_byte_array_length,
+      static_cast<double*>(g_steal_pointer(&a_float_array)),
+      a_float_array_length, an_enum, another_enum,
+      static_cast<gchar*>(g_steal_pointer(&a_string)), an_object, list,
+      string_list, int_list, double_list, bool_list, enum_list, object_list,
+      list_list, map_list, map, string_map, int_map, enum_map, object_map,
+      list_map, map_map);
 }
 
 gboolean core_tests_pigeon_test_all_types_equals(
@@ -836,6 +1271,12 @@ gboolean core_tests_pigeon_test_all_types_equals(
   if (a == nullptr || b == nullptr) {
     return FALSE;
   }
+  // Objects with different hash codes are not equal.
+  if (g_atomic_int_get(&a->pigeon_hash_set) &&
+      g_atomic_int_get(&b->pigeon_hash_set) &&
+      a->pigeon_hash != b->pigeon_hash) {
+    return FALSE;
+  }
   if (a->a_bool != b->a_bool) {
     return FALSE;
   }
@@ -962,6 +1403,9 @@ gboolean core_tests_pigeon_test_all_types_equals(
 
 guint core_tests_pigeon_test_all_types_hash(CoreTestsPigeonTestAllTypes* self) {
   g_return_val_if_fail(CORE_TESTS_PIGEON_TEST_IS_ALL_TYPES(self), 0);
+  if (g_atomic_int_get(&self->pigeon_hash_set)) {
+    return self->pigeon_hash;
+  }
   guint result = 0;
   result = result * 31 + static_cast<guint>(self->a_bool);
   result = result * 31 + static_cast<guint>(self->an_int);
@@ -1024,6 +1468,8 @@ guint core_tests_pigeon_test_all_types_hash(CoreTestsPigeonTestAllTypes* self) {
   result = result * 31 + flpigeon_deep_hash(self->object_map);
   result = result * 31 + flpigeon_deep_hash(self->list_map);
   result = result * 31 + flpigeon_deep_hash(self->map_map);
+  self->pigeon_hash = result;
+  g_atomic_int_set(&self->pigeon_hash_set, TRUE);
   return result;
 }
 
@@ -1252,10 +1698,10 @@ gchar* core_tests_pigeon_test_all_types_to_string(
 struct _CoreTestsPigeonTestAllNullableTypes {
   GObject parent_instance;
 
-  gboolean* a_nullable_bool;
-  int64_t* a_nullable_int;
-  int64_t* a_nullable_int64;
-  double* a_nullable_double;
+  gboolean a_nullable_bool;
+  int64_t a_nullable_int;
+  int64_t a_nullable_int64;
+  double a_nullable_double;
   uint8_t* a_nullable_byte_array;
   size_t a_nullable_byte_array_length;
   int32_t* a_nullable4_byte_array;
@@ -1264,8 +1710,8 @@ struct _CoreTestsPigeonTestAllNullableTypes {
   size_t a_nullable8_byte_array_length;
   double* a_nullable_float_array;
   size_t a_nullable_float_array_length;
-  CoreTestsPigeonTestAnEnum* a_nullable_enum;
-  CoreTestsPigeonTestAnotherEnum* another_nullable_enum;
+  CoreTestsPigeonTestAnEnum a_nullable_enum;
+  CoreTestsPigeonTestAnotherEnum another_nullable_enum;
   gchar* a_nullable_string;
   FlValue* a_nullable_object;
   CoreTestsPigeonTestAllNullableTypes* all_nullable_types;
@@ -1287,6 +1733,17 @@ struct _CoreTestsPigeonTestAllNullableTypes {
   FlValue* list_map;
   FlValue* map_map;
   FlValue* recursive_class_map;
+  // Nullable primitive fields are stored inline, with a bit for each
+  // to record if it has a value.
+  guint has_a_nullable_bool : 1;
+  guint has_a_nullable_int : 1;
+  guint has_a_nullable_int64 : 1;
+  guint has_a_nullable_double : 1;
+  guint has_a_nullable_enum : 1;
+  guint has_another_nullable_enum : 1;
+  // Hash code, calculated the first time it is needed.
+  guint pigeon_hash;
+  gint pigeon_hash_set;
 };
 
 G_DEFINE_TYPE(CoreTestsPigeonTestAllNullableTypes,
@@ -1295,12 +1752,10 @@ G_DEFINE_TYPE(CoreTestsPigeonTestAllNullableTypes,
 static void core_tests_pigeon_test_all_nullable_types_dispose(GObject* object) {
   CoreTestsPigeonTestAllNullableTypes* self =
       CORE_TESTS_PIGEON_TEST_ALL_NULLABLE_TYPES(object);
-  g_clear_pointer(&self->a_nullable_bool, g_free);
-  g_clear_pointer(&self->a_nullable_int, g_free);
-  g_clear_pointer(&self->a_nullable_int64, g_free);
-  g_clear_pointer(&self->a_nullable_double, g_free);
-  g_clear_pointer(&self->a_nullable_enum, g_free);
-  g_clear_pointer(&self->another_nullable_enum, g_free);
+  g_clear_pointer(&self->a_nullable_byte_array, g_free);
+  g_clear_pointer(&self->a_nullable4_byte_array, g_free);
+  g_clear_pointer(&self->a_nullable8_byte_array, g_free);
+  g_clear_pointer(&self->a_nullable_float_array, g_free);
   g_clear_pointer(&self->a_nullable_string, g_free);
   g_clear_pointer(&self->a_nullable_object, fl_value_unref);
   g_clear_object(&self->all_nullable_types);
@@ -1357,28 +1812,28 @@ core_tests_pigeon_test_all_nullable_types_new(
       CORE_TESTS_PIGEON_TEST_ALL_NULLABLE_TYPES(g_object_new(
           core_tests_pigeon_test_all_nullable_types_get_type(), nullptr));
   if (a_nullable_bool != nullptr) {
-    self->a_nullable_bool = static_cast<gboolean*>(malloc(sizeof(gboolean)));
-    *self->a_nullable_bool = *a_nullable_bool;
+    self->a_nullable_bool = *a_nullable_bool;
+    self->has_a_nullable_bool = TRUE;
   } else {
-    self->a_nullable_bool = nullptr;
+    self->has_a_nullable_bool = FALSE;
   }
   if (a_nullable_int != nullptr) {
-    self->a_nullable_int = static_cast<int64_t*>(malloc(sizeof(int64_t)));
-    *self->a_nullable_int = *a_nullable_int;
+    self->a_nullable_int = *a_nullable_int;
+    self->has_a_nullable_int = TRUE;
   } else {
-    self->a_nullable_int = nullptr;
+    self->has_a_nullable_int = FALSE;
   }
   if (a_nullable_int64 != nullptr) {
-    self->a_nullable_int64 = static_cast<int64_t*>(malloc(sizeof(int64_t)));
-    *self->a_nullable_int64 = *a_nullable_int64;
+    self->a_nullable_int64 = *a_nullable_int64;
+    self->has_a_nullable_int64 = TRUE;
   } else {
-    self->a_nullable_int64 = nullptr;
+    self->has_a_nullable_int64 = FALSE;
   }
   if (a_nullable_double != nullptr) {
-    self->a_nullable_double = static_cast<double*>(malloc(sizeof(double)));
-    *self->a_nullable_double = *a_nullable_double;
+    self->a_nullable_double = *a_nullable_double;
+    self->has_a_nullable_double = TRUE;
   } else {
-    self->a_nullable_double = nullptr;
+    self->has_a_nullable_double = FALSE;
   }
   if (a_nullable_byte_array != nullptr) {
     self->a_nullable_byte_array = static_cast<uint8_t*>(
@@ -1420,18 +1875,16 @@ core_tests_pigeon_test_all_nullable_types_new(
     self->a_nullable_float_array_length = 0;
   }
   if (a_nullable_enum != nullptr) {
-    self->a_nullable_enum = static_cast<CoreTestsPigeonTestAnEnum*>(
-        malloc(sizeof(CoreTestsPigeonTestAnEnum)));
-    *self->a_nullable_enum = *a_nullable_enum;
+    self->a_nullable_enum = *a_nullable_enum;
+    self->has_a_nullable_enum = TRUE;
   } else {
-    self->a_nullable_enum = nullptr;
+    self->has_a_nullable_enum = FALSE;
   }
   if (another_nullable_enum != nullptr) {
-    self->another_nullable_enum = static_cast<CoreTestsPigeonTestAnotherEnum*>(
-        malloc(sizeof(CoreTestsPigeonTestAnotherEnum)));
-    *self->another_nullable_enum = *another_nullable_enum;
+    self->another_nullable_enum = *another_nullable_enum;
+    self->has_another_nullable_enum = TRUE;
   } else {
-    self->another_nullable_enum = nullptr;
+    self->has_another_nullable_enum = FALSE;
   }
   if (a_nullable_string != nullptr) {
     self->a_nullable_string = g_strdup(a_nullable_string);
@@ -1542,32 +1995,141 @@ core_tests_pigeon_test_all_nullable_types_new(
   return self;
 }
 
+CoreTestsPigeonTestAllNullableTypes*
+core_tests_pigeon_test_all_nullable_types_new_take(
+    gboolean* a_nullable_bool, int64_t* a_nullable_int,
+    int64_t* a_nullable_int64, double* a_nullable_double,
+    uint8_t* a_nullable_byte_array, size_t a_nullable_byte_array_length,
+    int32_t* a_nullable4_byte_array, size_t a_nullable4_byte_array_length,
+    int64_t* a_nullable8_byte_array, size_t a_nullable8_byte_array_length,
+    double* a_nullable_float_array, size_t a_nullable_float_array_length,
+    CoreTestsPigeonTestAnEnum* a_nullable_enum,
+    CoreTestsPigeonTestAnotherEnum* another_nullable_enum,
+    gchar* a_nullable_string, FlValue* a_nullable_object,
+    CoreTestsPigeonTestAllNullableTypes* all_nullable_types, FlValue* list,
+    FlValue* string_list, FlValue* int_list, FlValue* double_list,
+    FlValue* bool_list, FlValue* enum_list, FlValue* object_list,
+    FlValue* list_list, FlValue* map_list, FlValue* recursive_class_list,
+    FlValue* map, FlValue* string_map, FlValue* int_map, FlValue* enum_map,
+    FlValue* object_map, FlValue* list_map, FlValue* map_map,
+    FlValue* recursive_class_map) {
+  CoreTestsPigeonTestAllNullableTypes* self =
+      CORE_TESTS_PIGEON_TEST_ALL_NULLABLE_TYPES(g_object_new(
+          core_tests_pigeon_test_all_nullable_types_get_type(), nullptr));
+  if (a_nullable_bool != nullptr) {
+    self->a_nullable_bool = *a_nullable_bool;
+    self->has_a_nullable_bool = TRUE;
+  } else {
+    self->has_a_nullable_bool = FALSE;
+  }
+  if (a_nullable_int != nullptr) {
+    self->a_nullable_int = *a_nullable_int;
+    self->has_a_nullable_int = TRUE;
+  } else {
+    self->has_a_nullable_int = FALSE;
+  }
+  if (a_nullable_int64 != nullptr) {
+    self->a_nullable_int64 = *a_nullable_int64;
+    self->has_a_nullable_int64 = TRUE;
+  } else {
+    self->has_a_nullable_int64 = FALSE;
+  }
+  if (a_nullable_double != nullptr) {
+    self->a_nullable_double = *a_nullable_double;
+    self->has_a_nullable_double = TRUE;
+  } else {
+    self->has_a_nullable_double = FALSE;
+  }
+  if (a_nullable_byte_array != nullptr) {
+    self->a_nullable_byte_array = a_nullable_byte_array;
+    self->a_nullable_byte_array_length = a_nullable_byte_array_length;
+  } else {
+    self->a_nullable_byte_array = nullptr;
+    self->a_nullable_byte_array_length = 0;
+  }
+  if (a_nullable4_byte_array != nullptr) {
+    self->a_nullable4_byte_array = a_nullable4_byte_array;
+    self->a_nullable4_byte_array_length = a_nullable4_byte_array_length;
+  } else {
+    self->a_nullable4_byte_array = nullptr;
+    self->a_nullable4_byte_array_length = 0;
+  }
+  if (a_nullable8_byte_array != nullptr) {
+    self->a_nullable8_byte_array = a_nullable8_byte_array;
+    self->a_nullable8_byte_array_length = a_nullable8_byte_array_length;
+  } else {
+    self->a_nullable8_byte_array = nullptr;
+    self->a_nullable8_byte_array_length = 0;
+  }
+  if (a_nullable_float_array != nullptr) {
+    self->a_nullable_float_array = a_nullable_float_array;
+    self->a_nullable_float_array_length = a_nullable_float_array_length;
+  } else {
+    self->a_nullable_float_array = nullptr;
+    self->a_nullable_float_array_length = 0;
+  }
+  if (a_nullable_enum != nullptr) {
+    self->a_nullable_enum = *a_nullable_enum;
+    self->has_a_nullable_enum = TRUE;
+  } else {
+    self->has_a_nullable_enum = FALSE;
+  }
+  if (another_nullable_enum != nullptr) {
+    self->another_nullable_enum = *another_nullable_enum;
+    self->has_another_nullable_enum = TRUE;
+  } else {
+    self->has_another_nullable_enum = FALSE;
+  }
+  self->a_nullable_string = a_nullable_string;
+  self->a_nullable_object = a_nullable_object;
+  self->all_nullable_types = all_nullable_types;
+  self->list = list;
+  self->string_list = string_list;
+  self->int_list = int_list;
+  self->double_list = double_list;
+  self->bool_list = bool_list;
+  self->enum_list = enum_list;
+  self->object_list = object_list;
+  self->list_list = list_list;
+  self->map_list = map_list;
+  self->recursive_class_list = recursive_class_list;
+  self->map = map;
+  self->string_map = string_map;
+  self->int_map = int_map;
+  self->enum_map = enum_map;
+  self->object_map = object_map;
+  self->list_map = list_map;
+  self->map_map = map_map;
+  self->recursive_class_map = recursive_class_map;
+  return self;
+}
+
 gboolean* core_tests_pigeon_test_all_nullable_types_get_a_nullable_bool(
     CoreTestsPigeonTestAllNullableTypes* self) {
   g_return_val_if_fail(CORE_TESTS_PIGEON_TEST_IS_ALL_NULLABLE_TYPES(self),
                        nullptr);
-  return self->a_nullable_bool;
+  return self->has_a_nullable_bool ? &self->a_nullable_bool : nullptr;
 }
 
 int64_t* core_tests_pigeon_test_all_nullable_types_get_a_nullable_int(
     CoreTestsPigeonTestAllNullableTypes* self) {
   g_return_val_if_fail(CORE_TESTS_PIGEON_TEST_IS_ALL_NULLABLE_TYPES(self),
                        nullptr);
-  return self->a_nullable_int;
+  return self->has_a_nullable_int ? &self->a_nullable_int : nullptr;
 }
 
 int64_t* core_tests_pigeon_test_all_nullable_types_get_a_nullable_int64(
     CoreTestsPigeonTestAllNullableTypes* self) {
   g_return_val_if_fail(CORE_TESTS_PIGEON_TEST_IS_ALL_NULLABLE_TYPES(self),
                        nullptr);
-  return self->a_nullable_int64;
+  return self->has_a_nullable_int64 ? &self->a_nullable_int64 : nullptr;
 }
 
 double* core_tests_pigeon_test_all_nullable_types_get_a_nullable_double(
     CoreTestsPigeonTestAllNullableTypes* self) {
   g_return_val_if_fail(CORE_TESTS_PIGEON_TEST_IS_ALL_NULLABLE_TYPES(self),
                        nullptr);
-  return self->a_nullable_double;
+  return self->has_a_nullable_double ? &self->a_nullable_double : nullptr;
 }
 
 const uint8_t*
@@ -1611,7 +2173,7 @@ core_tests_pigeon_test_all_nullable_types_get_a_nullable_enum(
     CoreTestsPigeonTestAllNullableTypes* self) {
   g_return_val_if_fail(CORE_TESTS_PIGEON_TEST_IS_ALL_NULLABLE_TYPES(self),
                        nullptr);
-  return self->a_nullable_enum;
+  return self->has_a_nullable_enum ? &self->a_nullable_enum : nullptr;
 }
 
 CoreTestsPigeonTestAnotherEnum*
@@ -1619,7 +2181,8 @@ core_tests_pigeon_test_all_nullable_types_get_another_nullable_enum(
     CoreTestsPigeonTestAllNullableTypes* self) {
   g_return_val_if_fail(CORE_TESTS_PIGEON_TEST_IS_ALL_NULLABLE_TYPES(self),
                        nullptr);
-  return self->another_nullable_enum;
+  return self->has_another_nullable_enum ? &self->another_nullable_enum
+                                         : nullptr;
 }
 
 const gchar* core_tests_pigeon_test_all_nullable_types_get_a_nullable_string(
@@ -1770,183 +2333,209 @@ FlValue* core_tests_pigeon_test_all_nullable_types_get_recursive_class_map(
   return self->recursive_class_map;
 }
 
-static FlValue* core_tests_pigeon_test_all_nullable_types_to_list(
-    CoreTestsPigeonTestAllNullableTypes* self) {
-  FlValue* values = fl_value_new_list();
-  fl_value_append_take(values, self->a_nullable_bool != nullptr
-                                   ? fl_value_new_bool(*self->a_nullable_bool)
-                                   : fl_value_new_null());
-  fl_value_append_take(values, self->a_nullable_int != nullptr
-                                   ? fl_value_new_int(*self->a_nullable_int)
-                                   : fl_value_new_null());
-  fl_value_append_take(values, self->a_nullable_int64 != nullptr
-                                   ? fl_value_new_int(*self->a_nullable_int64)
-                                   : fl_value_new_null());
-  fl_value_append_take(values,
-                       self->a_nullable_double != nullptr
-                           ? fl_value_new_float(*self->a_nullable_double)
-                           : fl_value_new_null());
-  fl_value_append_take(
-      values, self->a_nullable_byte_array != nullptr
-                  ? fl_value_new_uint8_list(self->a_nullable_byte_array,
-                                            self->a_nullable_byte_array_length)
-                  : fl_value_new_null());
-  fl_value_append_take(
-      values, self->a_nullable4_byte_array != nullptr
-                  ? fl_value_new_int32_list(self->a_nullable4_byte_array,
-                                            self->a_nullable4_byte_array_length)
-                  : fl_value_new_null());
-  fl_value_append_take(
-      values, self->a_nullable8_byte_array != nullptr
-                  ? fl_value_new_int64_list(self->a_nullable8_byte_array,
-                                            self->a_nullable8_byte_array_length)
-                  : fl_value_new_null());
-  fl_value_append_take(
-      values, self->a_nullable_float_array != nullptr
-                  ? fl_value_new_float_list(self->a_nullable_float_array,
-                                            self->a_nullable_float_array_length)
-                  : fl_value_new_null());
-  fl_value_append_take(
-      values,
-      self->a_nullable_enum != nullptr
-          ? fl_value_new_custom(core_tests_pigeon_test_an_enum_type_id,
-                                fl_value_new_int(*self->a_nullable_enum),
-                                (GDestroyNotify)fl_value_unref)
-          : fl_value_new_null());
-  fl_value_append_take(
-      values,
-      self->another_nullable_enum != nullptr
-          ? fl_value_new_custom(core_tests_pigeon_test_another_enum_type_id,
-                                fl_value_new_int(*self->another_nullable_enum),
-                                (GDestroyNotify)fl_value_unref)
-          : fl_value_new_null());
-  fl_value_append_take(values,
-                       self->a_nullable_string != nullptr
-                           ? fl_value_new_string(self->a_nullable_string)
-                           : fl_value_new_null());
-  fl_value_append_take(values, self->a_nullable_object != nullptr
-                                   ? fl_value_ref(self->a_nullable_object)
-                                   : fl_value_new_null());
-  fl_value_append_take(
-      values, self->all_nullable_types != nullptr
-                  ? fl_value_new_custom_object(
-                        core_tests_pigeon_test_all_nullable_types_type_id,
-                        G_OBJECT(self->all_nullable_types))
-                  : fl_value_new_null());
-  fl_value_append_take(values, self->list != nullptr ? fl_value_ref(self->list)
-                                                     : fl_value_new_null());
-  fl_value_append_take(values, self->string_list != nullptr
-                                   ? fl_value_ref(self->string_list)
-                                   : fl_value_new_null());
-  fl_value_append_take(values, self->int_list != nullptr
-                                   ? fl_value_ref(self->int_list)
-                                   : fl_value_new_null());
-  fl_value_append_take(values, self->double_list != nullptr
-                                   ? fl_value_ref(self->double_list)
-                                   : fl_value_new_null());
-  fl_value_append_take(values, self->bool_list != nullptr
-                                   ? fl_value_ref(self->bool_list)
-                                   : fl_value_new_null());
-  fl_value_append_take(values, self->enum_list != nullptr
-                                   ? fl_value_ref(self->enum_list)
-                                   : fl_value_new_null());
-  fl_value_append_take(values, self->object_list != nullptr
-                                   ? fl_value_ref(self->object_list)
-                                   : fl_value_new_null());
-  fl_value_append_take(values, self->list_list != nullptr
-                                   ? fl_value_ref(self->list_list)
-                                   : fl_value_new_null());
-  fl_value_append_take(values, self->map_list != nullptr
-                                   ? fl_value_ref(self->map_list)
-                                   : fl_value_new_null());
-  fl_value_append_take(values, self->recursive_class_list != nullptr
-                                   ? fl_value_ref(self->recursive_class_list)
-                                   : fl_value_new_null());
-  fl_value_append_take(values, self->map != nullptr ? fl_value_ref(self->map)
-                                                    : fl_value_new_null());
-  fl_value_append_take(values, self->string_map != nullptr
-                                   ? fl_value_ref(self->string_map)
-                                   : fl_value_new_null());
-  fl_value_append_take(values, self->int_map != nullptr
-                                   ? fl_value_ref(self->int_map)
-                                   : fl_value_new_null());
-  fl_value_append_take(values, self->enum_map != nullptr
-                                   ? fl_value_ref(self->enum_map)
-                                   : fl_value_new_null());
-  fl_value_append_take(values, self->object_map != nullptr
-                                   ? fl_value_ref(self->object_map)
-                                   : fl_value_new_null());
-  fl_value_append_take(values, self->list_map != nullptr
-                                   ? fl_value_ref(self->list_map)
-                                   : fl_value_new_null());
-  fl_value_append_take(values, self->map_map != nullptr
-                                   ? fl_value_ref(self->map_map)
-                                   : fl_value_new_null());
-  fl_value_append_take(values, self->recursive_class_map != nullptr
-                                   ? fl_value_ref(self->recursive_class_map)
-                                   : fl_value_new_null());
-  return values;
-}
-
 static CoreTestsPigeonTestAllNullableTypes*
-core_tests_pigeon_test_all_nullable_types_new_from_list(FlValue* values) {
-  FlValue* value0 = fl_value_get_list_value(values, 0);
+core_tests_pigeon_test_all_nullable_types_new_from_buffer(
+    FlStandardMessageCodec* codec, GBytes* buffer, size_t* offset,
+    GError** error) {
+  uint32_t n_values;
+  if (!flpigeon_read_list_header(codec, buffer, offset, 31, &n_values,
+                                 error)) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value0 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value0 == nullptr) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value1 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value1 == nullptr) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value2 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value2 == nullptr) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value3 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value3 == nullptr) {
+    return nullptr;
+  }
+  g_autofree uint8_t* a_nullable_byte_array = nullptr;
+  size_t a_nullable_byte_array_length;
+  if (!flpigeon_read_typed_list(
+      codec, buffer, offset, 8, sizeof(uint8_t), TRUE,
+      reinterpret_cast<gpointer*>(&a_nullable_byte_array),
+      &a_nullable_byte_array_length, error)) {
+    return nullptr;
+  }
+  g_autofree int32_t* a_nullable4_byte_array = nullptr;
+  size_t a_nullable4_byte_array_length;
+  if (!flpigeon_read_typed_list(
+      codec, buffer, offset, 9, sizeof(int32_t), TRUE,
+      reinterpret_cast<gpointer*>(&a_nullable4_byte_array),
+      &a_nullable4_byte_array_length, error)) {
+    return nullptr;
+  }
+  g_autofree int64_t* a_nullable8_byte_array = nullptr;
+  size_t a_nullable8_byte_array_length;
+  if (!flpigeon_read_typed_list(
+      codec, buffer, offset, 10, sizeof(int64_t), TRUE,
+      reinterpret_cast<gpointer*>(&a_nullable8_byte_array),
+      &a_nullable8_byte_array_length, error)) {
+    return nullptr;
+  }
+  g_autofree double* a_nullable_float_array = nullptr;
+  size_t a_nullable_float_array_length;
+  if (!flpigeon_read_typed_list(
+      codec, buffer, offset, 11, sizeof(double), TRUE,
+      reinterpret_cast<gpointer*>(&a_nullable_float_array),
+      &a_nullable_float_array_length, error)) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value8 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value8 == nullptr) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value9 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value9 == nullptr) {
+    return nullptr;
+  }
+  g_autofree gchar* a_nullable_string = nullptr;
+  if (!flpigeon_read_string(codec, buffer, offset, TRUE, &a_nullable_string,
+                            error)) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value11 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value11 == nullptr) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value12 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value12 == nullptr) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value13 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value13 == nullptr) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value14 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value14 == nullptr) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value15 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value15 == nullptr) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value16 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value16 == nullptr) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value17 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value17 == nullptr) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value18 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value18 == nullptr) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value19 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value19 == nullptr) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value20 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value20 == nullptr) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value21 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value21 == nullptr) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value22 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value22 == nullptr) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value23 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value23 == nullptr) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value24 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value24 == nullptr) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value25 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value25 == nullptr) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value26 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value26 == nullptr) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value27 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value27 == nullptr) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value28 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value28 == nullptr) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value29 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value29 == nullptr) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value30 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value30 == nullptr) {
+    return nullptr;
+  }
+  if (!flpigeon_skip_values(codec, buffer, offset, n_values - 31, error)) {
+    return nullptr;
+  }
   gboolean* a_nullable_bool = nullptr;
   gboolean a_nullable_bool_value;
   if (fl_value_get_type(value0) != FL_VALUE_TYPE_NULL) {
     a_nullable_bool_value = fl_value_get_bool(value0);
     a_nullable_bool = &a_nullable_bool_value;
   }
-  FlValue* value1 = fl_value_get_list_value(values, 1);
   int64_t* a_nullable_int = nullptr;
   int64_t a_nullable_int_value;
   if (fl_value_get_type(value1) != FL_VALUE_TYPE_NULL) {
     a_nullable_int_value = fl_value_get_int(value1);
     a_nullable_int = &a_nullable_int_value;
   }
-  FlValue* value2 = fl_value_get_list_value(values, 2);
   int64_t* a_nullable_int64 = nullptr;
   int64_t a_nullable_int64_value;
   if (fl_value_get_type(value2) != FL_VALUE_TYPE_NULL) {
     a_nullable_int64_value = fl_value_get_int(value2);
     a_nullable_int64 = &a_nullable_int64_value;
   }
-  FlValue* value3 = fl_value_get_list_value(values, 3);
   double* a_nullable_double = nullptr;
   double a_nullable_double_value;
   if (fl_value_get_type(value3) != FL_VALUE_TYPE_NULL) {
     a_nullable_double_value = fl_value_get_float(value3);
     a_nullable_double = &a_nullable_double_value;
   }
-  FlValue* value4 = fl_value_get_list_value(values, 4);
-  const uint8_t* a_nullable_byte_array = nullptr;
-  size_t a_nullable_byte_array_length = 0;
-  if (fl_value_get_type(value4) != FL_VALUE_TYPE_NULL) {
-    a_nullable_byte_array = fl_value_get_uint8_list(value4);
-    a_nullable_byte_array_length = fl_value_get_length(value4);
-  }
-  FlValue* value5 = fl_value_get_list_value(values, 5);
-  const int32_t* a_nullable4_byte_array = nullptr;
-  size_t a_nullable4_byte_array_length = 0;
-  if (fl_value_get_type(value5) != FL_VALUE_TYPE_NULL) {
-    a_nullable4_byte_array = fl_value_get_int32_list(value5);
-    a_nullable4_byte_array_length = fl_value_get_length(value5);
-  }
-  FlValue* value6 = fl_value_get_list_value(values, 6);
-  const int64_t* a_nullable8_byte_array = nullptr;
-  size_t a_nullable8_byte_array_length = 0;
-  if (fl_value_get_type(value6) != FL_VALUE_TYPE_NULL) {
-    a_nullable8_byte_array = fl_value_get_int64_list(value6);
-    a_nullable8_byte_array_length = fl_value_get_length(value6);
-  }
-  FlValue* value7 = fl_value_get_list_value(values, 7);
-  const double* a_nullable_float_array = nullptr;
-  size_t a_nullable_float_array_length = 0;
-  if (fl_value_get_type(value7) != FL_VALUE_TYPE_NULL) {
-    a_nullable_float_array = fl_value_get_float_list(value7);
-    a_nullable_float_array_length = fl_value_get_length(value7);
-  }
-  FlValue* value8 = fl_value_get_list_value(values, 8);
   CoreTestsPigeonTestAnEnum* a_nullable_enum = nullptr;
   CoreTestsPigeonTestAnEnum a_nullable_enum_value;
   if (fl_value_get_type(value8) != FL_VALUE_TYPE_NULL) {
@@ -1955,7 +2544,6 @@ core_tests_pigeon_test_all_nullable_types_new_from_list(FlValue* values) {
             const_cast<gpointer>(fl_value_get_custom_value(value8)))));
     a_nullable_enum = &a_nullable_enum_value;
   }
-  FlValue* value9 = fl_value_get_list_value(values, 9);
   CoreTestsPigeonTestAnotherEnum* another_nullable_enum = nullptr;
   CoreTestsPigeonTestAnotherEnum another_nullable_enum_value;
   if (fl_value_get_type(value9) != FL_VALUE_TYPE_NULL) {
@@ -1964,123 +2552,102 @@ core_tests_pigeon_test_all_nullable_types_new_from_list(FlValue* values) {
             const_cast<gpointer>(fl_value_get_custom_value(value9)))));
     another_nullable_enum = &another_nullable_enum_value;
   }
-  FlValue* value10 = fl_value_get_list_value(values, 10);
-  const gchar* a_nullable_string = nullptr;
-  if (fl_value_get_type(value10) != FL_VALUE_TYPE_NULL) {
-    a_nullable_string = fl_value_get_string(value10);
-  }
-  FlValue* value11 = fl_value_get_list_value(values, 11);
   FlValue* a_nullable_object = nullptr;
   if (fl_value_get_type(value11) != FL_VALUE_TYPE_NULL) {
-    a_nullable_object = value11;
+    a_nullable_object = fl_value_ref(value11);
   }
-  FlValue* value12 = fl_value_get_list_value(values, 12);
   CoreTestsPigeonTestAllNullableTypes* all_nullable_types = nullptr;
   if (fl_value_get_type(value12) != FL_VALUE_TYPE_NULL) {
     all_nullable_types = CORE_TESTS_PIGEON_TEST_ALL_NULLABLE_TYPES(
-        fl_value_get_custom_value_object(value12));
+        g_object_ref(fl_value_get_custom_value_object(value12)));
   }
-  FlValue* value13 = fl_value_get_list_value(values, 13);
   FlValue* list = nullptr;
   if (fl_value_get_type(value13) != FL_VALUE_TYPE_NULL) {
-    list = value13;
+    list = fl_value_ref(value13);
   }
-  FlValue* value14 = fl_value_get_list_value(values, 14);
   FlValue* string_list = nullptr;
   if (fl_value_get_type(value14) != FL_VALUE_TYPE_NULL) {
-    string_list = value14;
+    string_list = fl_value_ref(value14);
   }
-  FlValue* value15 = fl_value_get_list_value(values, 15);
   FlValue* int_list = nullptr;
   if (fl_value_get_type(value15) != FL_VALUE_TYPE_NULL) {
-    int_list = value15;
+    int_list = fl_value_ref(value15);
   }
-  FlValue* value16 = fl_value_get_list_value(values, 16);
   FlValue* double_list = nullptr;
   if (fl_value_get_type(value16) != FL_VALUE_TYPE_NULL) {
-    double_list = value16;
+    double_list = fl_value_ref(value16);
   }
-  FlValue* value17 = fl_value_get_list_value(values, 17);
   FlValue* bool_list = nullptr;
   if (fl_value_get_type(value17) != FL_VALUE_TYPE_NULL) {
-    bool_list = value17;
+    bool_list = fl_value_ref(value17);
   }
-  FlValue* value18 = fl_value_get_list_value(values, 18);
   FlValue* enum_list = nullptr;
   if (fl_value_get_type(value18) != FL_VALUE_TYPE_NULL) {
-    enum_list = value18;
+    enum_list = fl_value_ref(value18);
   }
-  FlValue* value19 = fl_value_get_list_value(values, 19);
   FlValue* object_list = nullptr;
   if (fl_value_get_type(value19) != FL_VALUE_TYPE_NULL) {
-    object_list = value19;
+    object_list = fl_value_ref(value19);
   }
-  FlValue* value20 = fl_value_get_list_value(values, 20);
   FlValue* list_list = nullptr;
   if (fl_value_get_type(value20) != FL_VALUE_TYPE_NULL) {
-    list_list = value20;
+    list_list = fl_value_ref(value20);
   }
-  FlValue* value21 = fl_value_get_list_value(values, 21);
   FlValue* map_list = nullptr;
   if (fl_value_get_type(value21) != FL_VALUE_TYPE_NULL) {
-    map_list = value21;
+    map_list = fl_value_ref(value21);
   }
-  FlValue* value22 = fl_value_get_list_value(values, 22);
   FlValue* recursive_class_list = nullptr;
   if (fl_value_get_type(value22) != FL_VALUE_TYPE_NULL) {
-    recursive_class_list = value22;
+    recursive_class_list = fl_value_ref(value22);
   }
-  FlValue* value23 = fl_value_get_list_value(values, 23);
   FlValue* map = nullptr;
   if (fl_value_get_type(value23) != FL_VALUE_TYPE_NULL) {
-    map = value23;
+    map = fl_value_ref(value23);
   }
-  FlValue* value24 = fl_value_get_list_value(values, 24);
   FlValue* string_map = nullptr;
   if (fl_value_get_type(value24) != FL_VALUE_TYPE_NULL) {
-    string_map = value24;
+    string_map = fl_value_ref(value24);
   }
-  FlValue* value25 = fl_value_get_list_value(values, 25);
   FlValue* int_map = nullptr;
   if (fl_value_get_type(value25) != FL_VALUE_TYPE_NULL) {
-    int_map = value25;
+    int_map = fl_value_ref(value25);
   }
-  FlValue* value26 = fl_value_get_list_value(values, 26);
   FlValue* enum_map = nullptr;
   if (fl_value_get_type(value26) != FL_VALUE_TYPE_NULL) {
-    enum_map = value26;
+    enum_map = fl_value_ref(value26);
   }
-  FlValue* value27 = fl_value_get_list_value(values, 27);
   FlValue* object_map = nullptr;
   if (fl_value_get_type(value27) != FL_VALUE_TYPE_NULL) {
-    object_map = value27;
+    object_map = fl_value_ref(value27);
   }
-  FlValue* value28 = fl_value_get_list_value(values, 28);
   FlValue* list_map = nullptr;
   if (fl_value_get_type(value28) != FL_VALUE_TYPE_NULL) {
-    list_map = value28;
+    list_map = fl_value_ref(value28);
   }
-  FlValue* value29 = fl_value_get_list_value(values, 29);
   FlValue* map_map = nullptr;
   if (fl_value_get_type(value29) != FL_VALUE_TYPE_NULL) {
-    map_map = value29;
+    map_map = fl_value_ref(value29);
   }
-  FlValue* value30 = fl_value_get_list_value(values, 30);
   FlValue* recursive_class_map = nullptr;
   if (fl_value_get_type(value30) != FL_VALUE_TYPE_NULL) {
-    recursive_class_map = value30;
+    recursive_class_map = fl_value_ref(value30);
   }
-  return core_tests_pigeon_test_all_nullable_types_new(
+  return core_tests_pigeon_test_all_nullable_types_new_take(
       a_nullable_bool, a_nullable_int, a_nullable_int64, a_nullable_double,
-      a_nullable_byte_array, a_nullable_byte_array_length,
-      a_nullable4_byte_array, a_nullable4_byte_array_length,
-      a_nullable8_byte_array, a_nullable8_byte_array_length,
-      a_nullable_float_array, a_nullable_float_array_length, a_nullable_enum,
-      another_nullable_enum, a_nullable_string, a_nullable_object,
-      all_nullable_types, list, string_list, int_list, double_list, bool_list,
-      enum_list, object_list, list_list, map_list, recursive_class_list, map,
-      string_map, int_map, enum_map, object_map, list_map, map_map,
-      recursive_class_map);
+      static_cast<uint8_t*>(g_steal_pointer(&a_nullable_byte_array)),
+      a_nullable_byte_array_length,
+      static_cast<int32_t*>(g_steal_pointer(&a_nullable4_byte_array)),
+      a_nullable4_byte_array_length,
+      static_cast<int64_t*>(g_steal_pointer(&a_nullable8_byte_array)),
+      a_nullable8_byte_array_length,
+      static_cast<double*>(g_steal_pointer(&a_nullable_float_array)),
+      a_nullable_float_array_length, a_nullable_enum, another_nullable_enum,
+      static_cast<gchar*>(g_steal_pointer(&a_nullable_string)),
+      a_nullable_object, all_nullable_types, list, string_list, int_list,
+      double_list, bool_list, enum_list, object_list, list_list, map_list,
+      recursive_class_list, map, string_map, int_map, enum_map, object_map,
+      list_map, map_map, recursive_class_map);
 }
 
 gboolean core_tests_pigeon_test_all_nullable_types_equals(
@@ -2092,32 +2659,35 @@ gboolean core_tests_pigeon_test_all_nullable_types_equals(
   if (a == nullptr || b == nullptr) {
     return FALSE;
   }
-  if ((a->a_nullable_bool == nullptr) != (b->a_nullable_bool == nullptr)) {
+  // Objects with different hash codes are not equal.
+  if (g_atomic_int_get(&a->pigeon_hash_set) &&
+      g_atomic_int_get(&b->pigeon_hash_set) &&
+      a->pigeon_hash != b->pigeon_hash) {
     return FALSE;
   }
-  if (a->a_nullable_bool != nullptr &&
-      *a->a_nullable_bool != *b->a_nullable_bool) {
+  if (a->has_a_nullable_bool != b->has_a_nullable_bool) {
     return FALSE;
   }
-  if ((a->a_nullable_int == nullptr) != (b->a_nullable_int == nullptr)) {
+  if (a->has_a_nullable_bool && a->a_nullable_bool != b->a_nullable_bool) {
     return FALSE;
   }
-  if (a->a_nullable_int != nullptr &&
-      *a->a_nullable_int != *b->a_nullable_int) {
+  if (a->has_a_nullable_int != b->has_a_nullable_int) {
     return FALSE;
   }
-  if ((a->a_nullable_int64 == nullptr) != (b->a_nullable_int64 == nullptr)) {
+  if (a->has_a_nullable_int && a->a_nullable_int != b->a_nullable_int) {
     return FALSE;
   }
-  if (a->a_nullable_int64 != nullptr &&
-      *a->a_nullable_int64 != *b->a_nullable_int64) {
+  if (a->has_a_nullable_int64 != b->has_a_nullable_int64) {
     return FALSE;
   }
-  if ((a->a_nullable_double == nullptr) != (b->a_nullable_double == nullptr)) {
+  if (a->has_a_nullable_int64 && a->a_nullable_int64 != b->a_nullable_int64) {
     return FALSE;
   }
-  if (a->a_nullable_double != nullptr &&
-      !flpigeon_equals_double(*a->a_nullable_double, *b->a_nullable_double)) {
+  if (a->has_a_nullable_double != b->has_a_nullable_double) {
+    return FALSE;
+  }
+  if (a->has_a_nullable_double &&
+      !flpigeon_equals_double(a->a_nullable_double, b->a_nullable_double)) {
     return FALSE;
   }
   if (a->a_nullable_byte_array != b->a_nullable_byte_array) {
@@ -2174,19 +2744,17 @@ gboolean core_tests_pigeon_test_all_nullable_types_equals(
       }
     }
   }
-  if ((a->a_nullable_enum == nullptr) != (b->a_nullable_enum == nullptr)) {
+  if (a->has_a_nullable_enum != b->has_a_nullable_enum) {
     return FALSE;
   }
-  if (a->a_nullable_enum != nullptr &&
-      *a->a_nullable_enum != *b->a_nullable_enum) {
+  if (a->has_a_nullable_enum && a->a_nullable_enum != b->a_nullable_enum) {
     return FALSE;
   }
-  if ((a->another_nullable_enum == nullptr) !=
-      (b->another_nullable_enum == nullptr)) {
+  if (a->has_another_nullable_enum != b->has_another_nullable_enum) {
     return FALSE;
   }
-  if (a->another_nullable_enum != nullptr &&
-      *a->another_nullable_enum != *b->another_nullable_enum) {
+  if (a->has_another_nullable_enum &&
+      a->another_nullable_enum != b->another_nullable_enum) {
     return FALSE;
   }
   if (g_strcmp0(a->a_nullable_string, b->a_nullable_string) != 0) {
@@ -2259,18 +2827,21 @@ gboolean core_tests_pigeon_test_all_nullable_types_equals(
 guint core_tests_pigeon_test_all_nullable_types_hash(
     CoreTestsPigeonTestAllNullableTypes* self) {
   g_return_val_if_fail(CORE_TESTS_PIGEON_TEST_IS_ALL_NULLABLE_TYPES(self), 0);
+  if (g_atomic_int_get(&self->pigeon_hash_set)) {
+    return self->pigeon_hash;
+  }
   guint result = 0;
-  result = result * 31 + (self->a_nullable_bool != nullptr
-                              ? static_cast<guint>(*self->a_nullable_bool)
+  result = result * 31 + (self->has_a_nullable_bool
+                              ? static_cast<guint>(self->a_nullable_bool)
                               : 0);
-  result = result * 31 + (self->a_nullable_int != nullptr
-                              ? static_cast<guint>(*self->a_nullable_int)
+  result = result * 31 + (self->has_a_nullable_int
+                              ? static_cast<guint>(self->a_nullable_int)
                               : 0);
-  result = result * 31 + (self->a_nullable_int64 != nullptr
-                              ? static_cast<guint>(*self->a_nullable_int64)
+  result = result * 31 + (self->has_a_nullable_int64
+                              ? static_cast<guint>(self->a_nullable_int64)
                               : 0);
-  result = result * 31 + (self->a_nullable_double != nullptr
-                              ? flpigeon_hash_double(*self->a_nullable_double)
+  result = result * 31 + (self->has_a_nullable_double
+                              ? flpigeon_hash_double(self->a_nullable_double)
                               : 0);
   {
     size_t len = self->a_nullable_byte_array_length;
@@ -2308,11 +2879,11 @@ guint core_tests_pigeon_test_all_nullable_types_hash(
       }
     }
   }
-  result = result * 31 + (self->a_nullable_enum != nullptr
-                              ? static_cast<guint>(*self->a_nullable_enum)
+  result = result * 31 + (self->has_a_nullable_enum
+                              ? static_cast<guint>(self->a_nullable_enum)
                               : 0);
-  result = result * 31 + (self->another_nullable_enum != nullptr
-                              ? static_cast<guint>(*self->another_nullable_enum)
+  result = result * 31 + (self->has_another_nullable_enum
+                              ? static_cast<guint>(self->another_nullable_enum)
                               : 0);
   result = result * 31 + (self->a_nullable_string != nullptr
                               ? g_str_hash(self->a_nullable_string)
@@ -2338,6 +2909,8 @@ guint core_tests_pigeon_test_all_nullable_types_hash(
   result = result * 31 + flpigeon_deep_hash(self->list_map);
   result = result * 31 + flpigeon_deep_hash(self->map_map);
   result = result * 31 + flpigeon_deep_hash(self->recursive_class_map);
+  self->pigeon_hash = result;
+  g_atomic_int_set(&self->pigeon_hash_set, TRUE);
   return result;
 }
 
@@ -2347,26 +2920,26 @@ gchar* core_tests_pigeon_test_all_nullable_types_to_string(
                        NULL);
   GString* str = g_string_new("AllNullableTypes(");
   g_string_append(str, "a_nullable_bool: ");
-  if (self->a_nullable_bool != nullptr) {
-    g_string_append(str, *self->a_nullable_bool ? "true" : "false");
+  if (self->has_a_nullable_bool) {
+    g_string_append(str, self->a_nullable_bool ? "true" : "false");
   } else {
     g_string_append(str, "null");
   }
   g_string_append(str, ", a_nullable_int: ");
-  if (self->a_nullable_int != nullptr) {
-    g_string_append_printf(str, "%" G_GINT64_FORMAT, *self->a_nullable_int);
+  if (self->has_a_nullable_int) {
+    g_string_append_printf(str, "%" G_GINT64_FORMAT, self->a_nullable_int);
   } else {
     g_string_append(str, "null");
   }
   g_string_append(str, ", a_nullable_int64: ");
-  if (self->a_nullable_int64 != nullptr) {
-    g_string_append_printf(str, "%" G_GINT64_FORMAT, *self->a_nullable_int64);
+  if (self->has_a_nullable_int64) {
+    g_string_append_printf(str, "%" G_GINT64_FORMAT, self->a_nullable_int64);
   } else {
     g_string_append(str, "null");
   }
   g_string_append(str, ", a_nullable_double: ");
-  if (self->a_nullable_double != nullptr) {
-    g_string_append_printf(str, "%g", *self->a_nullable_double);
+  if (self->has_a_nullable_double) {
+    g_string_append_printf(str, "%g", self->a_nullable_double);
   } else {
     g_string_append(str, "null");
   }
@@ -2431,15 +3004,15 @@ gchar* core_tests_pigeon_test_all_nullable_types_to_string(
     g_string_append(str, "null");
   }
   g_string_append(str, ", a_nullable_enum: ");
-  if (self->a_nullable_enum != nullptr) {
-    g_string_append_printf(str, "%d", static_cast<int>(*self->a_nullable_enum));
+  if (self->has_a_nullable_enum) {
+    g_string_append_printf(str, "%d", static_cast<int>(self->a_nullable_enum));
   } else {
     g_string_append(str, "null");
   }
   g_string_append(str, ", another_nullable_enum: ");
-  if (self->another_nullable_enum != nullptr) {
+  if (self->has_another_nullable_enum) {
     g_string_append_printf(str, "%d",
-                           static_cast<int>(*self->another_nullable_enum));
+                           static_cast<int>(self->another_nullable_enum));
   } else {
     g_string_append(str, "null");
   }
@@ -2617,10 +3190,10 @@ gchar* core_tests_pigeon_test_all_nullable_types_to_string(
 struct _CoreTestsPigeonTestAllNullableTypesWithoutRecursion {
   GObject parent_instance;
 
-  gboolean* a_nullable_bool;
-  int64_t* a_nullable_int;
-  int64_t* a_nullable_int64;
-  double* a_nullable_double;
+  gboolean a_nullable_bool;
+  int64_t a_nullable_int;
+  int64_t a_nullable_int64;
+  double a_nullable_double;
   uint8_t* a_nullable_byte_array;
   size_t a_nullable_byte_array_length;
   int32_t* a_nullable4_byte_array;
@@ -2629,8 +3202,8 @@ struct _CoreTestsPigeonTestAllNullableTypesWithoutRecursion {
   size_t a_nullable8_byte_array_length;
   double* a_nullable_float_array;
   size_t a_nullable_float_array_length;
-  CoreTestsPigeonTestAnEnum* a_nullable_enum;
-  CoreTestsPigeonTestAnotherEnum* another_nullable_enum;
+  CoreTestsPigeonTestAnEnum a_nullable_enum;
+  CoreTestsPigeonTestAnotherEnum another_nullable_enum;
   gchar* a_nullable_string;
   FlValue* a_nullable_object;
   FlValue* list;
@@ -2649,6 +3222,17 @@ struct _CoreTestsPigeonTestAllNullableTypesWithoutRecursion {
   FlValue* object_map;
   FlValue* list_map;
   FlValue* map_map;
+  // Nullable primitive fields are stored inline, with a bit for each
+  // to record if it has a value.
+  guint has_a_nullable_bool : 1;
+  guint has_a_nullable_int : 1;
+  guint has_a_nullable_int64 : 1;
+  guint has_a_nullable_double : 1;
+  guint has_a_nullable_enum : 1;
+  guint has_another_nullable_enum : 1;
+  // Hash code, calculated the first time it is needed.
+  guint pigeon_hash;
+  gint pigeon_hash_set;
 };
 
 G_DEFINE_TYPE(CoreTestsPigeonTestAllNullableTypesWithoutRecursion,
@@ -2659,12 +3243,10 @@ static void core_tests_pigeon_test_all_nullable_types_without_recursion_dispose(
     GObject* object) {
   CoreTestsPigeonTestAllNullableTypesWithoutRecursion* self =
       CORE_TESTS_PIGEON_TEST_ALL_NULLABLE_TYPES_WITHOUT_RECURSION(object);
-  g_clear_pointer(&self->a_nullable_bool, g_free);
-  g_clear_pointer(&self->a_nullable_int, g_free);
-  g_clear_pointer(&self->a_nullable_int64, g_free);
-  g_clear_pointer(&self->a_nullable_double, g_free);
-  g_clear_pointer(&self->a_nullable_enum, g_free);
-  g_clear_pointer(&self->another_nullable_enum, g_free);
+  g_clear_pointer(&self->a_nullable_byte_array, g_free);
+  g_clear_pointer(&self->a_nullable4_byte_array, g_free);
+  g_clear_pointer(&self->a_nullable8_byte_array, g_free);
+  g_clear_pointer(&self->a_nullable_float_array, g_free);
   g_clear_pointer(&self->a_nullable_string, g_free);
   g_clear_pointer(&self->a_nullable_object, fl_value_unref);
   g_clear_pointer(&self->list, fl_value_unref);
@@ -2719,28 +3301,28 @@ core_tests_pigeon_test_all_nullable_types_without_recursion_new(
           core_tests_pigeon_test_all_nullable_types_without_recursion_get_type(),
           nullptr));
   if (a_nullable_bool != nullptr) {
-    self->a_nullable_bool = static_cast<gboolean*>(malloc(sizeof(gboolean)));
-    *self->a_nullable_bool = *a_nullable_bool;
+    self->a_nullable_bool = *a_nullable_bool;
+    self->has_a_nullable_bool = TRUE;
   } else {
-    self->a_nullable_bool = nullptr;
+    self->has_a_nullable_bool = FALSE;
   }
   if (a_nullable_int != nullptr) {
-    self->a_nullable_int = static_cast<int64_t*>(malloc(sizeof(int64_t)));
-    *self->a_nullable_int = *a_nullable_int;
+    self->a_nullable_int = *a_nullable_int;
+    self->has_a_nullable_int = TRUE;
   } else {
-    self->a_nullable_int = nullptr;
+    self->has_a_nullable_int = FALSE;
   }
   if (a_nullable_int64 != nullptr) {
-    self->a_nullable_int64 = static_cast<int64_t*>(malloc(sizeof(int64_t)));
-    *self->a_nullable_int64 = *a_nullable_int64;
+    self->a_nullable_int64 = *a_nullable_int64;
+    self->has_a_nullable_int64 = TRUE;
   } else {
-    self->a_nullable_int64 = nullptr;
+    self->has_a_nullable_int64 = FALSE;
   }
   if (a_nullable_double != nullptr) {
-    self->a_nullable_double = static_cast<double*>(malloc(sizeof(double)));
-    *self->a_nullable_double = *a_nullable_double;
+    self->a_nullable_double = *a_nullable_double;
+    self->has_a_nullable_double = TRUE;
   } else {
-    self->a_nullable_double = nullptr;
+    self->has_a_nullable_double = FALSE;
   }
   if (a_nullable_byte_array != nullptr) {
     self->a_nullable_byte_array = static_cast<uint8_t*>(
@@ -2782,18 +3364,16 @@ core_tests_pigeon_test_all_nullable_types_without_recursion_new(
     self->a_nullable_float_array_length = 0;
   }
   if (a_nullable_enum != nullptr) {
-    self->a_nullable_enum = static_cast<CoreTestsPigeonTestAnEnum*>(
-        malloc(sizeof(CoreTestsPigeonTestAnEnum)));
-    *self->a_nullable_enum = *a_nullable_enum;
+    self->a_nullable_enum = *a_nullable_enum;
+    self->has_a_nullable_enum = TRUE;
   } else {
-    self->a_nullable_enum = nullptr;
+    self->has_a_nullable_enum = FALSE;
   }
   if (another_nullable_enum != nullptr) {
-    self->another_nullable_enum = static_cast<CoreTestsPigeonTestAnotherEnum*>(
-        malloc(sizeof(CoreTestsPigeonTestAnotherEnum)));
-    *self->another_nullable_enum = *another_nullable_enum;
+    self->another_nullable_enum = *another_nullable_enum;
+    self->has_another_nullable_enum = TRUE;
   } else {
-    self->another_nullable_enum = nullptr;
+    self->has_another_nullable_enum = FALSE;
   }
   if (a_nullable_string != nullptr) {
     self->a_nullable_string = g_strdup(a_nullable_string);
@@ -2888,13 +3468,118 @@ core_tests_pigeon_test_all_nullable_types_without_recursion_new(
   return self;
 }
 
+CoreTestsPigeonTestAllNullableTypesWithoutRecursion*
+core_tests_pigeon_test_all_nullable_types_without_recursion_new_take(
+    gboolean* a_nullable_bool, int64_t* a_nullable_int,
+    int64_t* a_nullable_int64, double* a_nullable_double,
+    uint8_t* a_nullable_byte_array, size_t a_nullable_byte_array_length,
+    int32_t* a_nullable4_byte_array, size_t a_nullable4_byte_array_length,
+    int64_t* a_nullable8_byte_array, size_t a_nullable8_byte_array_length,
+    double* a_nullable_float_array, size_t a_nullable_float_array_length,
+    CoreTestsPigeonTestAnEnum* a_nullable_enum,
+    CoreTestsPigeonTestAnotherEnum* another_nullable_enum,
+    gchar* a_nullable_string, FlValue* a_nullable_object, FlValue* list,
+    FlValue* string_list, FlValue* int_list, FlValue* double_list,
+    FlValue* bool_list, FlValue* enum_list, FlValue* object_list,
+    FlValue* list_list, FlValue* map_list, FlValue* map, FlValue* string_map,
+    FlValue* int_map, FlValue* enum_map, FlValue* object_map, FlValue* list_map,
+    FlValue* map_map) {
+  CoreTestsPigeonTestAllNullableTypesWithoutRecursion* self =
+      CORE_TESTS_PIGEON_TEST_ALL_NULLABLE_TYPES_WITHOUT_RECURSION(g_object_new(
+          core_tests_pigeon_test_all_nullable_types_without_recursion_get_type(),
+          nullptr));
+  if (a_nullable_bool != nullptr) {
+    self->a_nullable_bool = *a_nullable_bool;
+    self->has_a_nullable_bool = TRUE;
+  } else {
+    self->has_a_nullable_bool = FALSE;
+  }
+  if (a_nullable_int != nullptr) {
+    self->a_nullable_int = *a_nullable_int;
+    self->has_a_nullable_int = TRUE;
+  } else {
+    self->has_a_nullable_int = FALSE;
+  }
+  if (a_nullable_int64 != nullptr) {
+    self->a_nullable_int64 = *a_nullable_int64;
+    self->has_a_nullable_int64 = TRUE;
+  } else {
+    self->has_a_nullable_int64 = FALSE;
+  }
+  if (a_nullable_double != nullptr) {
+    self->a_nullable_double = *a_nullable_double;
+    self->has_a_nullable_double = TRUE;
+  } else {
+    self->has_a_nullable_double = FALSE;
+  }
+  if (a_nullable_byte_array != nullptr) {
+    self->a_nullable_byte_array = a_nullable_byte_array;
+    self->a_nullable_byte_array_length = a_nullable_byte_array_length;
+  } else {
+    self->a_nullable_byte_array = nullptr;
+    self->a_nullable_byte_array_length = 0;
+  }
+  if (a_nullable4_byte_array != nullptr) {
+    self->a_nullable4_byte_array = a_nullable4_byte_array;
+    self->a_nullable4_byte_array_length = a_nullable4_byte_array_length;
+  } else {
+    self->a_nullable4_byte_array = nullptr;
+    self->a_nullable4_byte_array_length = 0;
+  }
+  if (a_nullable8_byte_array != nullptr) {
+    self->a_nullable8_byte_array = a_nullable8_byte_array;
+    self->a_nullable8_byte_array_length = a_nullable8_byte_array_length;
+  } else {
+    self->a_nullable8_byte_array = nullptr;
+    self->a_nullable8_byte_array_length = 0;
+  }
+  if (a_nullable_float_array != nullptr) {
+    self->a_nullable_float_array = a_nullable_float_array;
+    self->a_nullable_float_array_length = a_nullable_float_array_length;
+  } else {
+    self->a_nullable_float_array = nullptr;
+    self->a_nullable_float_array_length = 0;
+  }
+  if (a_nullable_enum != nullptr) {
+    self->a_nullable_enum = *a_nullable_enum;
+    self->has_a_nullable_enum = TRUE;
+  } else {
+    self->has_a_nullable_enum = FALSE;
+  }
+  if (another_nullable_enum != nullptr) {
+    self->another_nullable_enum = *another_nullable_enum;
+    self->has_another_nullable_enum = TRUE;
+  } else {
+    self->has_another_nullable_enum = FALSE;
+  }
+  self->a_nullable_string = a_nullable_string;
+  self->a_nullable_object = a_nullable_object;
+  self->list = list;
+  self->string_list = string_list;
+  self->int_list = int_list;
+  self->double_list = double_list;
+  self->bool_list = bool_list;
+  self->enum_list = enum_list;
+  self->object_list = object_list;
+  self->list_list = list_list;
+  self->map_list = map_list;
+  self->map = map;
+  self->string_map = string_map;
+  self->int_map = int_map;
+  self->enum_map = enum_map;
+  self->object_map = object_map;
+  self->list_map = list_map;
+  self->map_map = map_map;
+  return self;
+}
+
 gboolean*
 core_tests_pigeon_test_all_nullable_types_without_recursion_get_a_nullable_bool(
     CoreTestsPigeonTestAllNullableTypesWithoutRecursion* self) {
   g_return_val_if_fail(
       CORE_TESTS_PIGEON_TEST_IS_ALL_NULLABLE_TYPES_WITHOUT_RECURSION(self),
       nullptr);
-  return self->a_nullable_bool;
+  return self->has_a_nullable_bool ? &self->a_nullable_bool : nullptr;
 }
 
 int64_t*
@@ -2903,7 +3588,7 @@ core_tests_pigeon_test_all_nullable_types_without_recursion_get_a_nullable_int(
   g_return_val_if_fail(
       CORE_TESTS_PIGEON_TEST_IS_ALL_NULLABLE_TYPES_WITHOUT_RECURSION(self),
       nullptr);
-  return self->a_nullable_int;
+  return self->has_a_nullable_int ? &self->a_nullable_int : nullptr;
 }
 
 int64_t*
@@ -2912,7 +3597,7 @@ core_tests_pigeon_test_all_nullable_types_without_recursion_get_a_nullable_int64
   g_return_val_if_fail(
       CORE_TESTS_PIGEON_TEST_IS_ALL_NULLABLE_TYPES_WITHOUT_RECURSION(self),
       nullptr);
-  return self->a_nullable_int64;
+  return self->has_a_nullable_int64 ? &self->a_nullable_int64 : nullptr;
 }
 
 double*
@@ -2921,7 +3606,7 @@ core_tests_pigeon_test_all_nullable_types_without_recursion_get_a_nullable_doubl
   g_return_val_if_fail(
       CORE_TESTS_PIGEON_TEST_IS_ALL_NULLABLE_TYPES_WITHOUT_RECURSION(self),
       nullptr);
-  return self->a_nullable_double;
+  return self->has_a_nullable_double ? &self->a_nullable_double : nullptr;
 }
 
 const uint8_t*
@@ -2970,7 +3655,7 @@ core_tests_pigeon_test_all_nullable_types_without_recursion_get_a_nullable_enum(
   g_return_val_if_fail(
       CORE_TESTS_PIGEON_TEST_IS_ALL_NULLABLE_TYPES_WITHOUT_RECURSION(self),
       nullptr);
-  return self->a_nullable_enum;
+  return self->has_a_nullable_enum ? &self->a_nullable_enum : nullptr;
 }
 
 CoreTestsPigeonTestAnotherEnum*
@@ -2979,7 +3664,8 @@ core_tests_pigeon_test_all_nullable_types_without_recursion_get_another_nullable
   g_return_val_if_fail(
       CORE_TESTS_PIGEON_TEST_IS_ALL_NULLABLE_TYPES_WITHOUT_RECURSION(self),
       nullptr);
-  return self->another_nullable_enum;
+  return self->has_another_nullable_enum ? &self->another_nullable_enum
+                                         : nullptr;
 }
 
 const gchar*
@@ -3142,173 +3828,194 @@ core_tests_pigeon_test_all_nullable_types_without_recursion_get_map_map(
   return self->map_map;
 }
 
-static FlValue*
-core_tests_pigeon_test_all_nullable_types_without_recursion_to_list(
-    CoreTestsPigeonTestAllNullableTypesWithoutRecursion* self) {
-  FlValue* values = fl_value_new_list();
-  fl_value_append_take(values, self->a_nullable_bool != nullptr
-                                   ? fl_value_new_bool(*self->a_nullable_bool)
-                                   : fl_value_new_null());
-  fl_value_append_take(values, self->a_nullable_int != nullptr
-                                   ? fl_value_new_int(*self->a_nullable_int)
-                                   : fl_value_new_null());
-  fl_value_append_take(values, self->a_nullable_int64 != nullptr
-                                   ? fl_value_new_int(*self->a_nullable_int64)
-                                   : fl_value_new_null());
-  fl_value_append_take(values,
-                       self->a_nullable_double != nullptr
-                           ? fl_value_new_float(*self->a_nullable_double)
-                           : fl_value_new_null());
-  fl_value_append_take(
-      values, self->a_nullable_byte_array != nullptr
-                  ? fl_value_new_uint8_list(self->a_nullable_byte_array,
-                                            self->a_nullable_byte_array_length)
-                  : fl_value_new_null());
-  fl_value_append_take(
-      values, self->a_nullable4_byte_array != nullptr
-                  ? fl_value_new_int32_list(self->a_nullable4_byte_array,
-                                            self->a_nullable4_byte_array_length)
-                  : fl_value_new_null());
-  fl_value_append_take(
-      values, self->a_nullable8_byte_array != nullptr
-                  ? fl_value_new_int64_list(self->a_nullable8_byte_array,
-                                            self->a_nullable8_byte_array_length)
-                  : fl_value_new_null());
-  fl_value_append_take(
-      values, self->a_nullable_float_array != nullptr
-                  ? fl_value_new_float_list(self->a_nullable_float_array,
-                                            self->a_nullable_float_array_length)
-                  : fl_value_new_null());
-  fl_value_append_take(
-      values,
-      self->a_nullable_enum != nullptr
-          ? fl_value_new_custom(core_tests_pigeon_test_an_enum_type_id,
-                                fl_value_new_int(*self->a_nullable_enum),
-                                (GDestroyNotify)fl_value_unref)
-          : fl_value_new_null());
-  fl_value_append_take(
-      values,
-      self->another_nullable_enum != nullptr
-          ? fl_value_new_custom(core_tests_pigeon_test_another_enum_type_id,
-                                fl_value_new_int(*self->another_nullable_enum),
-                                (GDestroyNotify)fl_value_unref)
-          : fl_value_new_null());
-  fl_value_append_take(values,
-                       self->a_nullable_string != nullptr
-                           ? fl_value_new_string(self->a_nullable_string)
-                           : fl_value_new_null());
-  fl_value_append_take(values, self->a_nullable_object != nullptr
-                                   ? fl_value_ref(self->a_nullable_object)
-                                   : fl_value_new_null());
-  fl_value_append_take(values, self->list != nullptr ? fl_value_ref(self->list)
-                                                     : fl_value_new_null());
-  fl_value_append_take(values, self->string_list != nullptr
-                                   ? fl_value_ref(self->string_list)
-                                   : fl_value_new_null());
-  fl_value_append_take(values, self->int_list != nullptr
-                                   ? fl_value_ref(self->int_list)
-                                   : fl_value_new_null());
-  fl_value_append_take(values, self->double_list != nullptr
-                                   ? fl_value_ref(self->double_list)
-                                   : fl_value_new_null());
-  fl_value_append_take(values, self->bool_list != nullptr
-                                   ? fl_value_ref(self->bool_list)
-                                   : fl_value_new_null());
-  fl_value_append_take(values, self->enum_list != nullptr
-                                   ? fl_value_ref(self->enum_list)
-                                   : fl_value_new_null());
-  fl_value_append_take(values, self->object_list != nullptr
-                                   ? fl_value_ref(self->object_list)
-                                   : fl_value_new_null());
-  fl_value_append_take(values, self->list_list != nullptr
-                                   ? fl_value_ref(self->list_list)
-                                   : fl_value_new_null());
-  fl_value_append_take(values, self->map_list != nullptr
-                                   ? fl_value_ref(self->map_list)
-                                   : fl_value_new_null());
-  fl_value_append_take(values, self->map != nullptr ? fl_value_ref(self->map)
-                                                    : fl_value_new_null());
-  fl_value_append_take(values, self->string_map != nullptr
-                                   ? fl_value_ref(self->string_map)
-                                   : fl_value_new_null());
-  fl_value_append_take(values, self->int_map != nullptr
-                                   ? fl_value_ref(self->int_map)
-                                   : fl_value_new_null());
-  fl_value_append_take(values, self->enum_map != nullptr
-                                   ? fl_value_ref(self->enum_map)
-                                   : fl_value_new_null());
-  fl_value_append_take(values, self->object_map != nullptr
-                                   ? fl_value_ref(self->object_map)
-                                   : fl_value_new_null());
-  fl_value_append_take(values, self->list_map != nullptr
-                                   ? fl_value_ref(self->list_map)
-                                   : fl_value_new_null());
-  fl_value_append_take(values, self->map_map != nullptr
-                                   ? fl_value_ref(self->map_map)
-                                   : fl_value_new_null());
-  return values;
-}
-
 static CoreTestsPigeonTestAllNullableTypesWithoutRecursion*
-core_tests_pigeon_test_all_nullable_types_without_recursion_new_from_list(
-    FlValue* values) {
-  FlValue* value0 = fl_value_get_list_value(values, 0);
+core_tests_pigeon_test_all_nullable_types_without_recursion_new_from_buffer(
+    FlStandardMessageCodec* codec, GBytes* buffer, size_t* offset,
+    GError** error) {
+  uint32_t n_values;
+  if (!flpigeon_read_list_header(codec, buffer, offset, 28, &n_values,
+                                 error)) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value0 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value0 == nullptr) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value1 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value1 == nullptr) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value2 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value2 == nullptr) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value3 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value3 == nullptr) {
+    return nullptr;
+  }
+  g_autofree uint8_t* a_nullable_byte_array = nullptr;
+  size_t a_nullable_byte_array_length;
+  if (!flpigeon_read_typed_list(
+      codec, buffer, offset, 8, sizeof(uint8_t), TRUE,
+      reinterpret_cast<gpointer*>(&a_nullable_byte_array),
+      &a_nullable_byte_array_length, error)) {
+    return nullptr;
+  }
+  g_autofree int32_t* a_nullable4_byte_array = nullptr;
+  size_t a_nullable4_byte_array_length;
+  if (!flpigeon_read_typed_list(
+      codec, buffer, offset, 9, sizeof(int32_t), TRUE,
+      reinterpret_cast<gpointer*>(&a_nullable4_byte_array),
+      &a_nullable4_byte_array_length, error)) {
+    return nullptr;
+  }
+  g_autofree int64_t* a_nullable8_byte_array = nullptr;
+  size_t a_nullable8_byte_array_length;
+  if (!flpigeon_read_typed_list(
+      codec, buffer, offset, 10, sizeof(int64_t), TRUE,
+      reinterpret_cast<gpointer*>(&a_nullable8_byte_array),
+      &a_nullable8_byte_array_length, error)) {
+    return nullptr;
+  }
+  g_autofree double* a_nullable_float_array = nullptr;
+  size_t a_nullable_float_array_length;
+  if (!flpigeon_read_typed_list(
+      codec, buffer, offset, 11, sizeof(double), TRUE,
+      reinterpret_cast<gpointer*>(&a_nullable_float_array),
+      &a_nullable_float_array_length, error)) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value8 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value8 == nullptr) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value9 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value9 == nullptr) {
+    return nullptr;
+  }
+  g_autofree gchar* a_nullable_string = nullptr;
+  if (!flpigeon_read_string(codec, buffer, offset, TRUE, &a_nullable_string,
+                            error)) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value11 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value11 == nullptr) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value12 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value12 == nullptr) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value13 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value13 == nullptr) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value14 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value14 == nullptr) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value15 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value15 == nullptr) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value16 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value16 == nullptr) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value17 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value17 == nullptr) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value18 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value18 == nullptr) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value19 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value19 == nullptr) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value20 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value20 == nullptr) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value21 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value21 == nullptr) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value22 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value22 == nullptr) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value23 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value23 == nullptr) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value24 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value24 == nullptr) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value25 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value25 == nullptr) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value26 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value26 == nullptr) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value27 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value27 == nullptr) {
+    return nullptr;
+  }
+  if (!flpigeon_skip_values(codec, buffer, offset, n_values - 28, error)) {
+    return nullptr;
+  }
   gboolean* a_nullable_bool = nullptr;
   gboolean a_nullable_bool_value;
   if (fl_value_get_type(value0) != FL_VALUE_TYPE_NULL) {
     a_nullable_bool_value = fl_value_get_bool(value0);
     a_nullable_bool = &a_nullable_bool_value;
   }
-  FlValue* value1 = fl_value_get_list_value(values, 1);
   int64_t* a_nullable_int = nullptr;
   int64_t a_nullable_int_value;
   if (fl_value_get_type(value1) != FL_VALUE_TYPE_NULL) {
     a_nullable_int_value = fl_value_get_int(value1);
     a_nullable_int = &a_nullable_int_value;
   }
-  FlValue* value2 = fl_value_get_list_value(values, 2);
   int64_t* a_nullable_int64 = nullptr;
   int64_t a_nullable_int64_value;
   if (fl_value_get_type(value2) != FL_VALUE_TYPE_NULL) {
     a_nullable_int64_value = fl_value_get_int(value2);
     a_nullable_int64 = &a_nullable_int64_value;
   }
-  FlValue* value3 = fl_value_get_list_value(values, 3);
   double* a_nullable_double = nullptr;
   double a_nullable_double_value;
   if (fl_value_get_type(value3) != FL_VALUE_TYPE_NULL) {
     a_nullable_double_value = fl_value_get_float(value3);
     a_nullable_double = &a_nullable_double_value;
   }
-  FlValue* value4 = fl_value_get_list_value(values, 4);
-  const uint8_t* a_nullable_byte_array = nullptr;
-  size_t a_nullable_byte_array_length = 0;
-  if (fl_value_get_type(value4) != FL_VALUE_TYPE_NULL) {
-    a_nullable_byte_array = fl_value_get_uint8_list(value4);
-    a_nullable_byte_array_length = fl_value_get_length(value4);
-  }
-  FlValue* value5 = fl_value_get_list_value(values, 5);
-  const int32_t* a_nullable4_byte_array = nullptr;
-  size_t a_nullable4_byte_array_length = 0;
-  if (fl_value_get_type(value5) != FL_VALUE_TYPE_NULL) {
-    a_nullable4_byte_array = fl_value_get_int32_list(value5);
-    a_nullable4_byte_array_length = fl_value_get_length(value5);
-  }
-  FlValue* value6 = fl_value_get_list_value(values, 6);
-  const int64_t* a_nullable8_byte_array = nullptr;
-  size_t a_nullable8_byte_array_length = 0;
-  if (fl_value_get_type(value6) != FL_VALUE_TYPE_NULL) {
-    a_nullable8_byte_array = fl_value_get_int64_list(value6);
-    a_nullable8_byte_array_length = fl_value_get_length(value6);
-  }
-  FlValue* value7 = fl_value_get_list_value(values, 7);
-  const double* a_nullable_float_array = nullptr;
-  size_t a_nullable_float_array_length = 0;
-  if (fl_value_get_type(value7) != FL_VALUE_TYPE_NULL) {
-    a_nullable_float_array = fl_value_get_float_list(value7);
-    a_nullable_float_array_length = fl_value_get_length(value7);
-  }
-  FlValue* value8 = fl_value_get_list_value(values, 8);
   CoreTestsPigeonTestAnEnum* a_nullable_enum = nullptr;
   CoreTestsPigeonTestAnEnum a_nullable_enum_value;
   if (fl_value_get_type(value8) != FL_VALUE_TYPE_NULL) {
@@ -3317,7 +4024,6 @@ core_tests_pigeon_test_all_nullable_types_without_recursion_new_from_list(
             const_cast<gpointer>(fl_value_get_custom_value(value8)))));
     a_nullable_enum = &a_nullable_enum_value;
   }
-  FlValue* value9 = fl_value_get_list_value(values, 9);
   CoreTestsPigeonTestAnotherEnum* another_nullable_enum = nullptr;
   CoreTestsPigeonTestAnotherEnum another_nullable_enum_value;
   if (fl_value_get_type(value9) != FL_VALUE_TYPE_NULL) {
@@ -3326,106 +4032,88 @@ core_tests_pigeon_test_all_nullable_types_without_recursion_new_from_list(
             const_cast<gpointer>(fl_value_get_custom_value(value9)))));
     another_nullable_enum = &another_nullable_enum_value;
   }
-  FlValue* value10 = fl_value_get_list_value(values, 10);
-  const gchar* a_nullable_string = nullptr;
-  if (fl_value_get_type(value10) != FL_VALUE_TYPE_NULL) {
-    a_nullable_string = fl_value_get_string(value10);
-  }
-  FlValue* value11 = fl_value_get_list_value(values, 11);
   FlValue* a_nullable_object = nullptr;
   if (fl_value_get_type(value11) != FL_VALUE_TYPE_NULL) {
-    a_nullable_object = value11;
+    a_nullable_object = fl_value_ref(value11);
   }
-  FlValue* value12 = fl_value_get_list_value(values, 12);
   FlValue* list = nullptr;
   if (fl_value_get_type(value12) != FL_VALUE_TYPE_NULL) {
-    list = value12;
+    list = fl_value_ref(value12);
   }
-  FlValue* value13 = fl_value_get_list_value(values, 13);
   FlValue* string_list = nullptr;
   if (fl_value_get_type(value13) != FL_VALUE_TYPE_NULL) {
-    string_list = value13;
+    string_list = fl_value_ref(value13);
   }
-  FlValue* value14 = fl_value_get_list_value(values, 14);
   FlValue* int_list = nullptr;
   if (fl_value_get_type(value14) != FL_VALUE_TYPE_NULL) {
-    int_list = value14;
+    int_list = fl_value_ref(value14);
   }
-  FlValue* value15 = fl_value_get_list_value(values, 15);
   FlValue* double_list = nullptr;
   if (fl_value_get_type(value15) != FL_VALUE_TYPE_NULL) {
-    double_list = value15;
+    double_list = fl_value_ref(value15);
   }
-  FlValue* value16 = fl_value_get_list_value(values, 16);
   FlValue* bool_list = nullptr;
   if (fl_value_get_type(value16) != FL_VALUE_TYPE_NULL) {
-    bool_list = value16;
+    bool_list = fl_value_ref(value16);
   }
-  FlValue* value17 = fl_value_get_list_value(values, 17);
   FlValue* enum_list = nullptr;
   if (fl_value_get_type(value17) != FL_VALUE_TYPE_NULL) {
-    enum_list = value17;
+    enum_list = fl_value_ref(value17);
   }
-  FlValue* value18 = fl_value_get_list_value(values, 18);
   FlValue* object_list = nullptr;
   if (fl_value_get_type(value18) != FL_VALUE_TYPE_NULL) {
-    object_list = value18;
+    object_list = fl_value_ref(value18);
   }
-  FlValue* value19 = fl_value_get_list_value(values, 19);
   FlValue* list_list = nullptr;
   if (fl_value_get_type(value19) != FL_VALUE_TYPE_NULL) {
-    list_list = value19;
+    list_list = fl_value_ref(value19);
   }
-  FlValue* value20 = fl_value_get_list_value(values, 20);
   FlValue* map_list = nullptr;
   if (fl_value_get_type(value20) != FL_VALUE_TYPE_NULL) {
-    map_list = value20;
+    map_list = fl_value_ref(value20);
   }
-  FlValue* value21 = fl_value_get_list_value(values, 21);
   FlValue* map = nullptr;
   if (fl_value_get_type(value21) != FL_VALUE_TYPE_NULL) {
-    map = value21;
+    map = fl_value_ref(value21);
   }
-  FlValue* value22 = fl_value_get_list_value(values, 22);
   FlValue* string_map = nullptr;
   if (fl_value_get_type(value22) != FL_VALUE_TYPE_NULL) {
-    string_map = value22;
+    string_map = fl_value_ref(value22);
   }
-  FlValue* value23 = fl_value_get_list_value(values, 23);
   FlValue* int_map = nullptr;
   if (fl_value_get_type(value23) != FL_VALUE_TYPE_NULL) {
-    int_map = value23;
+    int_map = fl_value_ref(value23);
   }
-  FlValue* value24 = fl_value_get_list_value(values, 24);
   FlValue* enum_map = nullptr;
   if (fl_value_get_type(value24) != FL_VALUE_TYPE_NULL) {
-    enum_map = value24;
+    enum_map = fl_value_ref(value24);
   }
-  FlValue* value25 = fl_value_get_list_value(values, 25);
   FlValue* object_map = nullptr;
   if (fl_value_get_type(value25) != FL_VALUE_TYPE_NULL) {
-    object_map = value25;
+    object_map = fl_value_ref(value25);
   }
-  FlValue* value26 = fl_value_get_list_value(values, 26);
   FlValue* list_map = nullptr;
   if (fl_value_get_type(value26) != FL_VALUE_TYPE_NULL) {
-    list_map = value26;
+    list_map = fl_value_ref(value26);
   }
-  FlValue* value27 = fl_value_get_list_value(values, 27);
   FlValue* map_map = nullptr;
   if (fl_value_get_type(value27) != FL_VALUE_TYPE_NULL) {
-    map_map = value27;
+    map_map = fl_value_ref(value27);
   }
-  return core_tests_pigeon_test_all_nullable_types_without_recursion_new(
+  return core_tests_pigeon_test_all_nullable_types_without_recursion_new_take(
       a_nullable_bool, a_nullable_int, a_nullable_int64, a_nullable_double,
-      a_nullable_byte_array, a_nullable_byte_array_length,
-      a_nullable4_byte_array, a_nullable4_byte_array_length,
-      a_nullable8_byte_array, a_nullable8_byte_array_length,
-      a_nullable_float_array, a_nullable_float_array_length, a_nullable_enum,
-      another_nullable_enum, a_nullable_string, a_nullable_object, list,
-      string_list, int_list, double_list, bool_list, enum_list, object_list,
-      list_list, map_list, map, string_map, int_map, enum_map, object_map,
-      list_map, map_map);
+      static_cast<uint8_t*>(g_steal_pointer(&a_nullable_byte_array)),
+      a_nullable_byte_array_length,
+      static_cast<int32_t*>(g_steal_pointer(&a_nullable4_byte_array)),
+      a_nullable4_byte_array_length,
+      static_cast<int64_t*>(g_steal_pointer(&a_nullable8_byte_array)),
+      a_nullable8_byte_array_length,
+      static_cast<double*>(g_steal_pointer(&a_nullable_float_array)),
+      a_nullable_float_array_length, a_nullable_enum, another_nullable_enum,
+      static_cast<gchar*>(g_steal_pointer(&a_nullable_string)),
+      a_nullable_object, list, string_list, int_list, double_list, bool_list,
+      enum_list, object_list, list_list, map_list, map, string_map, int_map,
+      enum_map, object_map, list_map, map_map);
 }
 
 gboolean core_tests_pigeon_test_all_nullable_types_without_recursion_equals(
@@ -3437,32 +4125,35 @@ gboolean core_tests_pigeon_test_all_nullable_types_without_recursion_equals(
   if (a == nullptr || b == nullptr) {
     return FALSE;
   }
-  if ((a->a_nullable_bool == nullptr) != (b->a_nullable_bool == nullptr)) {
+  // Objects with different hash codes are not equal.
+  if (g_atomic_int_get(&a->pigeon_hash_set) &&
+      g_atomic_int_get(&b->pigeon_hash_set) &&
+      a->pigeon_hash != b->pigeon_hash) {
     return FALSE;
   }
-  if (a->a_nullable_bool != nullptr &&
-      *a->a_nullable_bool != *b->a_nullable_bool) {
+  if (a->has_a_nullable_bool != b->has_a_nullable_bool) {
     return FALSE;
   }
-  if ((a->a_nullable_int == nullptr) != (b->a_nullable_int == nullptr)) {
+  if (a->has_a_nullable_bool && a->a_nullable_bool != b->a_nullable_bool) {
     return FALSE;
   }
-  if (a->a_nullable_int != nullptr &&
-      *a->a_nullable_int != *b->a_nullable_int) {
+  if (a->has_a_nullable_int != b->has_a_nullable_int) {
     return FALSE;
   }
-  if ((a->a_nullable_int64 == nullptr) != (b->a_nullable_int64 == nullptr)) {
+  if (a->has_a_nullable_int && a->a_nullable_int != b->a_nullable_int) {
     return FALSE;
   }
-  if (a->a_nullable_int64 != nullptr &&
-      *a->a_nullable_int64 != *b->a_nullable_int64) {
+  if (a->has_a_nullable_int64 != b->has_a_nullable_int64) {
     return FALSE;
   }
-  if ((a->a_nullable_double == nullptr) != (b->a_nullable_double == nullptr)) {
+  if (a->has_a_nullable_int64 && a->a_nullable_int64 != b->a_nullable_int64) {
     return FALSE;
   }
-  if (a->a_nullable_double != nullptr &&
-      !flpigeon_equals_double(*a->a_nullable_double, *b->a_nullable_double)) {
+  if (a->has_a_nullable_double != b->has_a_nullable_double) {
+    return FALSE;
+  }
+  if (a->has_a_nullable_double &&
+      !flpigeon_equals_double(a->a_nullable_double, b->a_nullable_double)) {
     return FALSE;
   }
   if (a->a_nullable_byte_array != b->a_nullable_byte_array) {
@@ -3519,19 +4210,17 @@ gboolean core_tests_pigeon_test_all_nullable_types_without_recursion_equals(
       }
     }
   }
-  if ((a->a_nullable_enum == nullptr) != (b->a_nullable_enum == nullptr)) {
+  if (a->has_a_nullable_enum != b->has_a_nullable_enum) {
     return FALSE;
   }
-  if (a->a_nullable_enum != nullptr &&
-      *a->a_nullable_enum != *b->a_nullable_enum) {
+  if (a->has_a_nullable_enum && a->a_nullable_enum != b->a_nullable_enum) {
     return FALSE;
   }
-  if ((a->another_nullable_enum == nullptr) !=
-      (b->another_nullable_enum == nullptr)) {
+  if (a->has_another_nullable_enum != b->has_another_nullable_enum) {
     return FALSE;
   }
-  if (a->another_nullable_enum != nullptr &&
-      *a->another_nullable_enum != *b->another_nullable_enum) {
+  if (a->has_another_nullable_enum &&
+      a->another_nullable_enum != b->another_nullable_enum) {
     return FALSE;
   }
   if (g_strcmp0(a->a_nullable_string, b->a_nullable_string) != 0) {
@@ -3595,18 +4284,21 @@ guint core_tests_pigeon_test_all_nullable_types_without_recursion_hash(
     CoreTestsPigeonTestAllNullableTypesWithoutRecursion* self) {
   g_return_val_if_fail(
       CORE_TESTS_PIGEON_TEST_IS_ALL_NULLABLE_TYPES_WITHOUT_RECURSION(self), 0);
+  if (g_atomic_int_get(&self->pigeon_hash_set)) {
+    return self->pigeon_hash;
+  }
   guint result = 0;
-  result = result * 31 + (self->a_nullable_bool != nullptr
-                              ? static_cast<guint>(*self->a_nullable_bool)
+  result = result * 31 + (self->has_a_nullable_bool
+                              ? static_cast<guint>(self->a_nullable_bool)
                               : 0);
-  result = result * 31 + (self->a_nullable_int != nullptr
-                              ? static_cast<guint>(*self->a_nullable_int)
+  result = result * 31 + (self->has_a_nullable_int
+                              ? static_cast<guint>(self->a_nullable_int)
                               : 0);
-  result = result * 31 + (self->a_nullable_int64 != nullptr
-                              ? static_cast<guint>(*self->a_nullable_int64)
+  result = result * 31 + (self->has_a_nullable_int64
+                              ? static_cast<guint>(self->a_nullable_int64)
                               : 0);
-  result = result * 31 + (self->a_nullable_double != nullptr
-                              ? flpigeon_hash_double(*self->a_nullable_double)
+  result = result * 31 + (self->has_a_nullable_double
+                              ? flpigeon_hash_double(self->a_nullable_double)
                               : 0);
   {
     size_t len = self->a_nullable_byte_array_length;
@@ -3644,11 +4336,11 @@ guint core_tests_pigeon_test_all_nullable_types_without_recursion_hash(
       }
     }
   }
-  result = result * 31 + (self->a_nullable_enum != nullptr
-                              ? static_cast<guint>(*self->a_nullable_enum)
+  result = result * 31 + (self->has_a_nullable_enum
+                              ? static_cast<guint>(self->a_nullable_enum)
                               : 0);
-  result = result * 31 + (self->another_nullable_enum != nullptr
-                              ? static_cast<guint>(*self->another_nullable_enum)
+  result = result * 31 + (self->has_another_nullable_enum
+                              ? static_cast<guint>(self->another_nullable_enum)
                               : 0);
   result = result * 31 + (self->a_nullable_string != nullptr
                               ? g_str_hash(self->a_nullable_string)
@@ -3670,6 +4362,8 @@ guint core_tests_pigeon_test_all_nullable_types_without_recursion_hash(
   result = result * 31 + flpigeon_deep_hash(self->object_map);
   result = result * 31 + flpigeon_deep_hash(self->list_map);
   result = result * 31 + flpigeon_deep_hash(self->map_map);
+  self->pigeon_hash = result;
+  g_atomic_int_set(&self->pigeon_hash_set, TRUE);
   return result;
 }
 
@@ -3680,26 +4374,26 @@ gchar* core_tests_pigeon_test_all_nullable_types_without_recursion_to_string(
       NULL);
   GString* str = g_string_new("AllNullableTypesWithoutRecursion(");
   g_string_append(str, "a_nullable_bool: ");
-  if (self->a_nullable_bool != nullptr) {
-    g_string_append(str, *self->a_nullable_bool ? "true" : "false");
+  if (self->has_a_nullable_bool) {
+    g_string_append(str, self->a_nullable_bool ? "true" : "false");
   } else {
     g_string_append(str, "null");
   }
   g_string_append(str, ", a_nullable_int: ");
-  if (self->a_nullable_int != nullptr) {
-    g_string_append_printf(str, "%" G_GINT64_FORMAT, *self->a_nullable_int);
+  if (self->has_a_nullable_int) {
+    g_string_append_printf(str, "%" G_GINT64_FORMAT, self->a_nullable_int);
   } else {
     g_string_append(str, "null");
   }
   g_string_append(str, ", a_nullable_int64: ");
-  if (self->a_nullable_int64 != nullptr) {
-    g_string_append_printf(str, "%" G_GINT64_FORMAT, *self->a_nullable_int64);
+  if (self->has_a_nullable_int64) {
+    g_string_append_printf(str, "%" G_GINT64_FORMAT, self->a_nullable_int64);
   } else {
     g_string_append(str, "null");
   }
   g_string_append(str, ", a_nullable_double: ");
-  if (self->a_nullable_double != nullptr) {
-    g_string_append_printf(str, "%g", *self->a_nullable_double);
+  if (self->has_a_nullable_double) {
+    g_string_append_printf(str, "%g", self->a_nullable_double);
   } else {
     g_string_append(str, "null");
   }
@@ -3764,15 +4458,15 @@ gchar* core_tests_pigeon_test_all_nullable_types_without_recursion_to_string(
     g_string_append(str, "null");
   }
   g_string_append(str, ", a_nullable_enum: ");
-  if (self->a_nullable_enum != nullptr) {
-    g_string_append_printf(str, "%d", static_cast<int>(*self->a_nullable_enum));
+  if (self->has_a_nullable_enum) {
+    g_string_append_printf(str, "%d", static_cast<int>(self->a_nullable_enum));
   } else {
     g_string_append(str, "null");
   }
   g_string_append(str, ", another_nullable_enum: ");
-  if (self->another_nullable_enum != nullptr) {
+  if (self->has_another_nullable_enum) {
     g_string_append_printf(str, "%d",
-                           static_cast<int>(*self->another_nullable_enum));
+                           static_cast<int>(self->another_nullable_enum));
   } else {
     g_string_append(str, "null");
   }
@@ -3933,6 +4627,9 @@ struct _CoreTestsPigeonTestAllClassesWrapper {
   FlValue* nullable_class_list;
   FlValue* class_map;
   FlValue* nullable_class_map;
+  // Hash code, calculated the first time it is needed.
+  guint pigeon_hash;
+  gint pigeon_hash_set;
 };
 
 G_DEFINE_TYPE(CoreTestsPigeonTestAllClassesWrapper,
@@ -4002,6 +4699,32 @@ core_tests_pigeon_test_all_classes_wrapper_new(
   return self;
 }
 
+CoreTestsPigeonTestAllClassesWrapper*
+core_tests_pigeon_test_all_classes_wrapper_new_take(
+    CoreTestsPigeonTestAllNullableTypes* all_nullable_types,
+    CoreTestsPigeonTestAllNullableTypesWithoutRecursion*
+        all_nullable_types_without_recursion,
+    CoreTestsPigeonTestAllTypes* all_types, FlValue* class_list,
+    FlValue* nullable_class_list, FlValue* class_map,
+    FlValue* nullable_class_map) {
+  CoreTestsPigeonTestAllClassesWrapper* self =
+      CORE_TESTS_PIGEON_TEST_ALL_CLASSES_WRAPPER(g_object_new(
+          core_tests_pigeon_test_all_classes_wrapper_get_type(), nullptr));
+  self->all_nullable_types = all_nullable_types;
+  if (all_nullable_types_without_recursion != nullptr) {
+    self->all_nullable_types_without_recursion =
+        all_nullable_types_without_recursion;
+  } else {
+    self->all_nullable_types_without_recursion = nullptr;
+  }
+  self->all_types = all_types;
+  self->class_list = class_list;
+  self->nullable_class_list = nullable_class_list;
+  self->class_map = class_map;
+  self->nullable_class_map = nullable_class_map;
+  return self;
+}
+
 CoreTestsPigeonTestAllNullableTypes*
 core_tests_pigeon_test_all_classes_wrapper_get_all_nullable_types(
     CoreTestsPigeonTestAllClassesWrapper* self) {
@@ -4054,72 +4777,79 @@ FlValue* core_tests_pigeon_test_all_classes_wrapper_get_nullable_class_map(
   return self->nullable_class_map;
 }
 
-static FlValue* core_tests_pigeon_test_all_classes_wrapper_to_list(
-    CoreTestsPigeonTestAllClassesWrapper* self) {
-  FlValue* values = fl_value_new_list();
-  fl_value_append_take(values,
-                       fl_value_new_custom_object(
-                           core_tests_pigeon_test_all_nullable_types_type_id,
-                           G_OBJECT(self->all_nullable_types)));
-  fl_value_append_take(
-      values,
-      self->all_nullable_types_without_recursion != nullptr
-          ? fl_value_new_custom_object(
-                core_tests_pigeon_test_all_nullable_types_without_recursion_type_id,
-                G_OBJECT(self->all_nullable_types_without_recursion))
-          : fl_value_new_null());
-  fl_value_append_take(
-      values,
-      self->all_types != nullptr
-          ? fl_value_new_custom_object(core_tests_pigeon_test_all_types_type_id,
-                                       G_OBJECT(self->all_types))
-          : fl_value_new_null());
-  fl_value_append_take(values, fl_value_ref(self->class_list));
-  fl_value_append_take(values, self->nullable_class_list != nullptr
-                                   ? fl_value_ref(self->nullable_class_list)
-                                   : fl_value_new_null());
-  fl_value_append_take(values, fl_value_ref(self->class_map));
-  fl_value_append_take(values, self->nullable_class_map != nullptr
-                                   ? fl_value_ref(self->nullable_class_map)
-                                   : fl_value_new_null());
-  return values;
-}
-
 static CoreTestsPigeonTestAllClassesWrapper*
-core_tests_pigeon_test_all_classes_wrapper_new_from_list(FlValue* values) {
-  FlValue* value0 = fl_value_get_list_value(values, 0);
+core_tests_pigeon_test_all_classes_wrapper_new_from_buffer(
+    FlStandardMessageCodec* codec, GBytes* buffer, size_t* offset,
+    GError** error) {
+  uint32_t n_values;
+  if (!flpigeon_read_list_header(codec, buffer, offset, 7, &n_values,
+                                 error)) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value0 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value0 == nullptr) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value1 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value1 == nullptr) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value2 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value2 == nullptr) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value3 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value3 == nullptr) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value4 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value4 == nullptr) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value5 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value5 == nullptr) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value6 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value6 == nullptr) {
+    return nullptr;
+  }
+  if (!flpigeon_skip_values(codec, buffer, offset, n_values - 7, error)) {
+    return nullptr;
+  }
   CoreTestsPigeonTestAllNullableTypes* all_nullable_types =
       CORE_TESTS_PIGEON_TEST_ALL_NULLABLE_TYPES(
-          fl_value_get_custom_value_object(value0));
-  FlValue* value1 = fl_value_get_list_value(values, 1);
+          g_object_ref(fl_value_get_custom_value_object(value0)));
   CoreTestsPigeonTestAllNullableTypesWithoutRecursion*
       all_nullable_types_without_recursion = nullptr;
   if (fl_value_get_type(value1) != FL_VALUE_TYPE_NULL) {
     all_nullable_types_without_recursion =
         CORE_TESTS_PIGEON_TEST_ALL_NULLABLE_TYPES_WITHOUT_RECURSION(
-            fl_value_get_custom_value_object(value1));
+            g_object_ref(fl_value_get_custom_value_object(value1)));
   }
-  FlValue* value2 = fl_value_get_list_value(values, 2);
   CoreTestsPigeonTestAllTypes* all_types = nullptr;
   if (fl_value_get_type(value2) != FL_VALUE_TYPE_NULL) {
     all_types = CORE_TESTS_PIGEON_TEST_ALL_TYPES(
-        fl_value_get_custom_value_object(value2));
+        g_object_ref(fl_value_get_custom_value_object(value2)));
   }
-  FlValue* value3 = fl_value_get_list_value(values, 3);
-  FlValue* class_list = value3;
-  FlValue* value4 = fl_value_get_list_value(values, 4);
+  FlValue* class_list = fl_value_ref(value3);
   FlValue* nullable_class_list = nullptr;
   if (fl_value_get_type(value4) != FL_VALUE_TYPE_NULL) {
-    nullable_class_list = value4;
+    nullable_class_list = fl_value_ref(value4);
   }
-  FlValue* value5 = fl_value_get_list_value(values, 5);
-  FlValue* class_map = value5;
-  FlValue* value6 = fl_value_get_list_value(values, 6);
+  FlValue* class_map = fl_value_ref(value5);
   FlValue* nullable_class_map = nullptr;
   if (fl_value_get_type(value6) != FL_VALUE_TYPE_NULL) {
-    nullable_class_map = value6;
+    nullable_class_map = fl_value_ref(value6);
   }
-  return core_tests_pigeon_test_all_classes_wrapper_new(
+  return core_tests_pigeon_test_all_classes_wrapper_new_take(
       all_nullable_types, all_nullable_types_without_recursion, all_types,
       class_list, nullable_class_list, class_map, nullable_class_map);
 }
@@ -4133,6 +4863,12 @@ gboolean core_tests_pigeon_test_all_classes_wrapper_equals(
   if (a == nullptr || b == nullptr) {
     return FALSE;
   }
+  // Objects with different hash codes are not equal.
+  if (g_atomic_int_get(&a->pigeon_hash_set) &&
+      g_atomic_int_get(&b->pigeon_hash_set) &&
+      a->pigeon_hash != b->pigeon_hash) {
+    return FALSE;
+  }
   if (!core_tests_pigeon_test_all_nullable_types_equals(
           a->all_nullable_types, b->all_nullable_types)) {
     return FALSE;
@@ -4163,6 +4899,9 @@ gboolean core_tests_pigeon_test_all_classes_wrapper_equals(
 guint core_tests_pigeon_test_all_classes_wrapper_hash(
     CoreTestsPigeonTestAllClassesWrapper* self) {
   g_return_val_if_fail(CORE_TESTS_PIGEON_TEST_IS_ALL_CLASSES_WRAPPER(self), 0);
+  if (g_atomic_int_get(&self->pigeon_hash_set)) {
+    return self->pigeon_hash;
+  }
   guint result = 0;
   result = result * 31 + core_tests_pigeon_test_all_nullable_types_hash(
                              self->all_nullable_types);
@@ -4174,6 +4913,8 @@ guint core_tests_pigeon_test_all_classes_wrapper_hash(
   result = result * 31 + flpigeon_deep_hash(self->nullable_class_list);
   result = result * 31 + flpigeon_deep_hash(self->class_map);
   result = result * 31 + flpigeon_deep_hash(self->nullable_class_map);
+  self->pigeon_hash = result;
+  g_atomic_int_set(&self->pigeon_hash_set, TRUE);
   return result;
 }
 
@@ -4250,6 +4991,9 @@ struct _CoreTestsPigeonTestTestMessage {
   GObject parent_instance;
 
   FlValue* test_list;
+  // Hash code, calculated the first time it is needed.
+  guint pigeon_hash;
+  gint pigeon_hash_set;
 };
 
 G_DEFINE_TYPE(CoreTestsPigeonTestTestMessage,
@@ -4283,29 +5027,42 @@ CoreTestsPigeonTestTestMessage* core_tests_pigeon_test_test_message_new(
   return self;
 }
 
+CoreTestsPigeonTestTestMessage* core_tests_pigeon_test_test_message_new_take(
+    FlValue* test_list) {
+  CoreTestsPigeonTestTestMessage* self = CORE_TESTS_PIGEON_TEST_TEST_MESSAGE(
+      g_object_new(core_tests_pigeon_test_test_message_get_type(), nullptr));
+  self->test_list = test_list;
+  return self;
+}
+
 FlValue* core_tests_pigeon_test_test_message_get_test_list(
     CoreTestsPigeonTestTestMessage* self) {
   g_return_val_if_fail(CORE_TESTS_PIGEON_TEST_IS_TEST_MESSAGE(self), nullptr);
   return self->test_list;
 }
 
-static FlValue* core_tests_pigeon_test_test_message_to_list(
-    CoreTestsPigeonTestTestMessage* self) {
-  FlValue* values = fl_value_new_list();
-  fl_value_append_take(values, self->test_list != nullptr
-                                   ? fl_value_ref(self->test_list)
-                                   : fl_value_new_null());
-  return values;
-}
-
 static CoreTestsPigeonTestTestMessage*
-core_tests_pigeon_test_test_message_new_from_list(FlValue* values) {
-  FlValue* value0 = fl_value_get_list_value(values, 0);
+core_tests_pigeon_test_test_message_new_from_buffer(
+    FlStandardMessageCodec* codec, GBytes* buffer, size_t* offset,
+    GError** error) {
+  uint32_t n_values;
+  if (!flpigeon_read_list_header(codec, buffer, offset, 1, &n_values,
+                                 error)) {
+    return nullptr;
+  }
+  g_autoptr(FlValue) value0 =
+      fl_standard_message_codec_read_value(codec, buffer, offset, error);
+  if (value0 == nullptr) {
+    return nullptr;
+  }
+  if (!flpigeon_skip_values(codec, buffer, offset, n_values - 1, error)) {
+    return nullptr;
+  }
   FlValue* test_list = nullptr;
   if (fl_value_get_type(value0) != FL_VALUE_TYPE_NULL) {
-    test_list = value0;
+    test_list = fl_value_ref(value0);
   }
-  return core_tests_pigeon_test_test_message_new(test_list);
+  return core_tests_pigeon_test_test_message_new_take(test_list);
 }
 
 gboolean core_tests_pigeon_test_test_message_equals(
@@ -4316,6 +5073,12 @@ gboolean core_tests_pigeon_test_test_message_equals(
   if (a == nullptr || b == nullptr) {
     return FALSE;
   }
+  // Objects with different hash codes are not equal.
+  if (g_atomic_int_get(&a->pigeon_hash_set) &&
+      g_atomic_int_get(&b->pigeon_hash_set) &&
+      a->pigeon_hash != b->pigeon_hash) {
+    return FALSE;
+  }
   if (!flpigeon_deep_equals(a->test_list, b->test_list)) {
     return FALSE;
   }
@@ -4325,8 +5088,13 @@ gboolean core_tests_pigeon_test_test_message_equals(
 guint core_tests_pigeon_test_test_message_hash(
     CoreTestsPigeonTestTestMessage* self) {
   g_return_val_if_fail(CORE_TESTS_PIGEON_TEST_IS_TEST_MESSAGE(self), 0);
+  if (g_atomic_int_get(&self->pigeon_hash_set)) {
+    return self->pigeon_hash;
+  }
   guint result = 0;
   result = result * 31 + flpigeon_deep_hash(self->test_list);
+  self->pigeon_hash = result;
+  g_atomic_int_set(&self->pigeon_hash_set, TRUE);
   return result;
 }
 
@@ -4388,9 +5156,14 @@ core_tests_pigeon_test_message_codec_write_core_tests_pigeon_test_unused_class(
     CoreTestsPigeonTestUnusedClass* value, GError** error) {
   uint8_t type = core_tests_pigeon_test_unused_class_type_id;
   g_byte_array_append(buffer, &type, sizeof(uint8_t));
-  g_autoptr(FlValue) values =
-      core_tests_pigeon_test_unused_class_to_list(value);
-  return fl_standard_message_codec_write_value(codec, buffer, values, error);
+  flpigeon_write_list_header(codec, buffer, 1);
+  if (value->a_field == nullptr) {
+    flpigeon_write_null(buffer);
+  } else if (!fl_standard_message_codec_write_value(codec, buffer,
+                                                    value->a_field, error)) {
+    return FALSE;
+  }
+  return TRUE;
 }
 
 static gboolean
@@ -4399,8 +5172,93 @@ core_tests_pigeon_test_message_codec_write_core_tests_pigeon_test_all_types(
     CoreTestsPigeonTestAllTypes* value, GError** error) {
   uint8_t type = core_tests_pigeon_test_all_types_type_id;
   g_byte_array_append(buffer, &type, sizeof(uint8_t));
-  g_autoptr(FlValue) values = core_tests_pigeon_test_all_types_to_list(value);
-  return fl_standard_message_codec_write_value(codec, buffer, values, error);
+  flpigeon_write_list_header(codec, buffer, 28);
+  flpigeon_write_bool(buffer, value->a_bool);
+  flpigeon_write_int(buffer, value->an_int);
+  flpigeon_write_int(buffer, value->an_int64);
+  flpigeon_write_double(buffer, value->a_double);
+  flpigeon_write_uint8_list(codec, buffer, value->a_byte_array,
+                            value->a_byte_array_length);
+  flpigeon_write_int32_list(codec, buffer, value->a4_byte_array,
+                            value->a4_byte_array_length);
+  flpigeon_write_int64_list(codec, buffer, value->a8_byte_array,
+                            value->a8_byte_array_length);
+  flpigeon_write_float_list(codec, buffer, value->a_float_array,
+                            value->a_float_array_length);
+  flpigeon_write_enum(buffer, core_tests_pigeon_test_an_enum_type_id,
+                      value->an_enum);
+  flpigeon_write_enum(buffer, core_tests_pigeon_test_another_enum_type_id,
+                      value->another_enum);
+  flpigeon_write_string(codec, buffer, value->a_string);
+  if (!fl_standard_message_codec_write_value(codec, buffer, value->an_object,
+                                             error)) {
+    return FALSE;
+  }
+  if (!fl_standard_message_codec_write_value(codec, buffer, value->list,
+                                             error)) {
+    return FALSE;
+  }
+  if (!fl_standard_message_codec_write_value(codec, buffer, value->string_list,
+                                             error)) {
+    return FALSE;
+  }
+  if (!fl_standard_message_codec_write_value(codec, buffer, value->int_list,
+                                             error)) {
+    return FALSE;
+  }
+  if (!fl_standard_message_codec_write_value(codec, buffer, value->double_list,
+                                             error)) {
+    return FALSE;
+  }
+  if (!fl_standard_message_codec_write_value(codec, buffer, value->bool_list,
+                                             error)) {
+    return FALSE;
+  }
+  if (!fl_standard_message_codec_write_value(codec, buffer, value->enum_list,
+                                             error)) {
+    return FALSE;
+  }
+  if (!fl_standard_message_codec_write_value(codec, buffer, value->object_list,
+                                             error)) {
+    return FALSE;
+  }
+  if (!fl_standard_message_codec_write_value(codec, buffer, value->list_list,
+                                             error)) {
+    return FALSE;
+  }
+  if (!fl_standard_message_codec_write_value(codec, buffer, value->map_list,
+                                             error)) {
+    return FALSE;
+  }
+  if (!fl_standard_message_codec_write_value(codec, buffer, value->map,
+                                             error)) {
+    return FALSE;
+  }
+  if (!fl_standard_message_codec_write_value(codec, buffer, value->string_map,
+                                             error)) {
+    return FALSE;
+  }
+  if (!fl_standard_message_codec_write_value(codec, buffer, value->int_map,
+                                             error)) {
+    return FALSE;
+  }
+  if (!fl_standard_message_codec_write_value(codec, buffer, value->enum_map,
+                                             error)) {
+    return FALSE;
+  }
+  if (!fl_standard_message_codec_write_value(codec, buffer, value->object_map,
+                                             error)) {
+    return FALSE;
+  }
+  if (!fl_standard_message_codec_write_value(codec, buffer, value->list_map,
+                                             error)) {
+    return FALSE;
+  }
+  if (!fl_standard_message_codec_write_value(codec, buffer, value->map_map,
+                                             error)) {
+    return FALSE;
+  }
+  return TRUE;
 }
 
 static gboolean
@@ -4409,9 +5267,194 @@ core_tests_pigeon_test_message_codec_write_core_tests_pigeon_test_all_nullable_t
     CoreTestsPigeonTestAllNullableTypes* value, GError** error) {
   uint8_t type = core_tests_pigeon_test_all_nullable_types_type_id;
   g_byte_array_append(buffer, &type, sizeof(uint8_t));
-  g_autoptr(FlValue) values =
-      core_tests_pigeon_test_all_nullable_types_to_list(value);
-  return fl_standard_message_codec_write_value(codec, buffer, values, error);
+  flpigeon_write_list_header(codec, buffer, 31);
+  if (!value->has_a_nullable_bool) {
+    flpigeon_write_null(buffer);
+  } else {
+    flpigeon_write_bool(buffer, value->a_nullable_bool);
+  }
+  if (!value->has_a_nullable_int) {
+    flpigeon_write_null(buffer);
+  } else {
+    flpigeon_write_int(buffer, value->a_nullable_int);
+  }
+  if (!value->has_a_nullable_int64) {
+    flpigeon_write_null(buffer);
+  } else {
+    flpigeon_write_int(buffer, value->a_nullable_int64);
+  }
+  if (!value->has_a_nullable_double) {
+    flpigeon_write_null(buffer);
+  } else {
+    flpigeon_write_double(buffer, value->a_nullable_double);
+  }
+  if (value->a_nullable_byte_array == nullptr) {
+    flpigeon_write_null(buffer);
+  } else {
+    flpigeon_write_uint8_list(codec, buffer, value->a_nullable_byte_array,
+                              value->a_nullable_byte_array_length);
+  }
+  if (value->a_nullable4_byte_array == nullptr) {
+    flpigeon_write_null(buffer);
+  } else {
+    flpigeon_write_int32_list(codec, buffer, value->a_nullable4_byte_array,
+                              value->a_nullable4_byte_array_length);
+  }
+  if (value->a_nullable8_byte_array == nullptr) {
+    flpigeon_write_null(buffer);
+  } else {
+    flpigeon_write_int64_list(codec, buffer, value->a_nullable8_byte_array,
+                              value->a_nullable8_byte_array_length);
+  }
+  if (value->a_nullable_float_array == nullptr) {
+    flpigeon_write_null(buffer);
+  } else {
+    flpigeon_write_float_list(codec, buffer, value->a_nullable_float_array,
+                              value->a_nullable_float_array_length);
+  }
+  if (!value->has_a_nullable_enum) {
+    flpigeon_write_null(buffer);
+  } else {
+    flpigeon_write_enum(buffer, core_tests_pigeon_test_an_enum_type_id,
+                        value->a_nullable_enum);
+  }
+  if (!value->has_another_nullable_enum) {
+    flpigeon_write_null(buffer);
+  } else {
+    flpigeon_write_enum(buffer, core_tests_pigeon_test_another_enum_type_id,
+                        value->another_nullable_enum);
+  }
+  if (value->a_nullable_string == nullptr) {
+    flpigeon_write_null(buffer);
+  } else {
+    flpigeon_write_string(codec, buffer, value->a_nullable_string);
+  }
+  if (value->a_nullable_object == nullptr) {
+    flpigeon_write_null(buffer);
+  } else if (!fl_standard_message_codec_write_value(codec, buffer,
+                                                    value->a_nullable_object,
+                                                    error)) {
+    return FALSE;
+  }
+  if (value->all_nullable_types == nullptr) {
+    flpigeon_write_null(buffer);
+  } else if (!core_tests_pigeon_test_message_codec_write_core_tests_pigeon_test_all_nullable_types(
+                 codec, buffer, value->all_nullable_types, error)) {
+    return FALSE;
+  }
+  if (value->list == nullptr) {
+    flpigeon_write_null(buffer);
+  } else if (!fl_standard_message_codec_write_value(codec, buffer, value->list,
+                                                    error)) {
+    return FALSE;
+  }
+  if (value->string_list == nullptr) {
+    flpigeon_write_null(buffer);
+  } else if (!fl_standard_message_codec_write_value(codec, buffer,
+                                                    value->string_list,
+                                                    error)) {
+    return FALSE;
+  }
+  if (value->int_list == nullptr) {
+    flpigeon_write_null(buffer);
+  } else if (!fl_standard_message_codec_write_value(codec, buffer,
+                                                    value->int_list, error)) {
+    return FALSE;
+  }
+  if (value->double_list == nullptr) {
+    flpigeon_write_null(buffer);
+  } else if (!fl_standard_message_codec_write_value(codec, buffer,
+                                                    value->double_list,
+                                                    error)) {
+    return FALSE;
+  }
+  if (value->bool_list == nullptr) {
+    flpigeon_write_null(buffer);
+  } else if (!fl_standard_message_codec_write_value(codec, buffer,
+                                                    value->bool_list, error)) {
+    return FALSE;
+  }
+  if (value->enum_list == nullptr) {
+    flpigeon_write_null(buffer);
+  } else if (!fl_standard_message_codec_write_value(codec, buffer,
+                                                    value->enum_list, error)) {
+    return FALSE;
+  }
+  if (value->object_list == nullptr) {
+    flpigeon_write_null(buffer);
+  } else if (!fl_standard_message_codec_write_value(codec, buffer,
+                                                    value->object_list,
+                                                    error)) {
+    return FALSE;
+  }
+  if (value->list_list == nullptr) {
+    flpigeon_write_null(buffer);
+  } else if (!fl_standard_message_codec_write_value(codec, buffer,
+                                                    value->list_list, error)) {
+    return FALSE;
+  }
+  if (value->map_list == nullptr) {
+    flpigeon_write_null(buffer);
+  } else if (!fl_standard_message_codec_write_value(codec, buffer,
+                                                    value->map_list, error)) {
+    return FALSE;
+  }
+  if (value->recursive_class_list == nullptr) {
+    flpigeon_write_null(buffer);
+  } else if (!fl_standard_message_codec_write_value(
+                 codec, buffer, value->recursive_class_list, error)) {
+    return FALSE;
+  }
+  if (value->map == nullptr) {
+    flpigeon_write_null(buffer);
+  } else if (!fl_standard_message_codec_write_value(codec, buffer, value->map,
+                                                    error)) {
+    return FALSE;
+  }
+  if (value->string_map == nullptr) {
+    flpigeon_write_null(buffer);
+  } else if (!fl_standard_message_codec_write_value(codec, buffer,
+                                                    value->string_map, error)) {
+    return FALSE;
+  }
+  if (value->int_map == nullptr) {
+    flpigeon_write_null(buffer);
+  } else if (!fl_standard_message_codec_write_value(codec, buffer,
+                                                    value->int_map, error)) {
+    return FALSE;
+  }
+  if (value->enum_map == nullptr) {
+    flpigeon_write_null(buffer);
+  } else if (!fl_standard_message_codec_write_value(codec, buffer,
+                                                    value->enum_map, error)) {
+    return FALSE;
+  }
+  if (value->object_map == nullptr) {
+    flpigeon_write_null(buffer);
+  } else if (!fl_standard_message_codec_write_value(codec, buffer,
+                                                    value->object_map, error)) {
+    return FALSE;
+  }
+  if (value->list_map == nullptr) {
+    flpigeon_write_null(buffer);
+  } else if (!fl_standard_message_codec_write_value(codec, buffer,
+                                                    value->list_map, error)) {
+    return FALSE;
+  }
+  if (value->map_map == nullptr) {
+    flpigeon_write_null(buffer);
+  } else if (!fl_standard_message_codec_write_value(codec, buffer,
+                                                    value->map_map, error)) {
+    return FALSE;
+  }
+  if (value->recursive_class_map == nullptr) {
+    flpigeon_write_null(buffer);
+  } else if (!fl_standard_message_codec_write_value(codec, buffer,
+                                                    value->recursive_class_map,
+                                                    error)) {
+    return FALSE;
+  }
+  return TRUE;
 }
 
 static gboolean
@@ -4422,10 +5465,175 @@ core_tests_pigeon_test_message_codec_write_core_tests_pigeon_test_all_nullable_t
   uint8_t type =
       core_tests_pigeon_test_all_nullable_types_without_recursion_type_id;
   g_byte_array_append(buffer, &type, sizeof(uint8_t));
-  g_autoptr(FlValue) values =
-      core_tests_pigeon_test_all_nullable_types_without_recursion_to_list(
-          value);
-  return fl_standard_message_codec_write_value(codec, buffer, values, error);
+  flpigeon_write_list_header(codec, buffer, 28);
+  if (!value->has_a_nullable_bool) {
+    flpigeon_write_null(buffer);
+  } else {
+    flpigeon_write_bool(buffer, value->a_nullable_bool);
+  }
+  if (!value->has_a_nullable_int) {
+    flpigeon_write_null(buffer);
+  } else {
+    flpigeon_write_int(buffer, value->a_nullable_int);
+  }
+  if (!value->has_a_nullable_int64) {
+    flpigeon_write_null(buffer);
+  } else {
+    flpigeon_write_int(buffer, value->a_nullable_int64);
+  }
+  if (!value->has_a_nullable_double) {
+    flpigeon_write_null(buffer);
+  } else {
+    flpigeon_write_double(buffer, value->a_nullable_double);
+  }
+  if (value->a_nullable_byte_array == nullptr) {
+    flpigeon_write_null(buffer);
+  } else {
+    flpigeon_write_uint8_list(codec, buffer, value->a_nullable_byte_array,
+                              value->a_nullable_byte_array_length);
+  }
+  if (value->a_nullable4_byte_array == nullptr) {
+    flpigeon_write_null(buffer);
+  } else {
+    flpigeon_write_int32_list(codec, buffer, value->a_nullable4_byte_array,
+                              value->a_nullable4_byte_array_length);
+  }
+  if (value->a_nullable8_byte_array == nullptr) {
+    flpigeon_write_null(buffer);
+  } else {
+    flpigeon_write_int64_list(codec, buffer, value->a_nullable8_byte_array,
+                              value->a_nullable8_byte_array_length);
+  }
+  if (value->a_nullable_float_array == nullptr) {
+    flpigeon_write_null(buffer);
+  } else {
+    flpigeon_write_float_list(codec, buffer, value->a_nullable_float_array,
+                              value->a_nullable_float_array_length);
+  }
+  if (!value->has_a_nullable_enum) {
+    flpigeon_write_null(buffer);
+  } else {
+    flpigeon_write_enum(buffer, core_tests_pigeon_test_an_enum_type_id,
+                        value->a_nullable_enum);
+  }
+  if (!value->has_another_nullable_enum) {
+    flpigeon_write_null(buffer);
+  } else {
+    flpigeon_write_enum(buffer, core_tests_pigeon_test_another_enum_type_id,
+                        value->another_nullable_enum);
+  }
+  if (value->a_nullable_string == nullptr) {
+    flpigeon_write_null(buffer);
+  } else {
+    flpigeon_write_string(codec, buffer, value->a_nullable_string);
+  }
+  if (value->a_nullable_object == nullptr) {
+    flpigeon_write_null(buffer);
+  } else if (!fl_standard_message_codec_write_value(codec, buffer,
+                                                    value->a_nullable_object,
+                                                    error)) {
+    return FALSE;
+  }
+  if (value->list == nullptr) {
+    flpigeon_write_null(buffer);
+  } else if (!fl_standard_message_codec_write_value(codec, buffer, value->list,
+                                                    error)) {
+    return FALSE;
+  }
+  if (value->string_list == nullptr) {
+    flpigeon_write_null(buffer);
+  } else if (!fl_standard_message_codec_write_value(codec, buffer,
+                                                    value->string_list,
+                                                    error)) {
+    return FALSE;
+  }
+  if (value->int_list == nullptr) {
+    flpigeon_write_null(buffer);
+  } else if (!fl_standard_message_codec_write_value(codec, buffer,
+                                                    value->int_list, error)) {
+    return FALSE;
+  }
+  if (value->double_list == nullptr) {
+    flpigeon_write_null(buffer);
+  } else if (!fl_standard_message_codec_write_value(codec, buffer,
+                                                    value->double_list,
+                                                    error)) {
+    return FALSE;
+  }
+  if (value->bool_list == nullptr) {
+    flpigeon_write_null(buffer);
+  } else if (!fl_standard_message_codec_write_value(codec, buffer,
+                                                    value->bool_list, error)) {
+    return FALSE;
+  }
+  if (value->enum_list == nullptr) {
+    flpigeon_write_null(buffer);
+  } else if (!fl_standard_message_codec_write_value(codec, buffer,
+                                                    value->enum_list, error)) {
+    return FALSE;
+  }
+  if (value->object_list == nullptr) {
+    flpigeon_write_null(buffer);
+  } else if (!fl_standard_message_codec_write_value(codec, buffer,
+                                                    value->object_list,
+                                                    error)) {
+    return FALSE;
+  }
+  if (value->list_list == nullptr) {
+    flpigeon_write_null(buffer);
+  } else if (!fl_standard_message_codec_write_value(codec, buffer,
+                                                    value->list_list, error)) {
+    return FALSE;
+  }
+  if (value->map_list == nullptr) {
+    flpigeon_write_null(buffer);
+  } else if (!fl_standard_message_codec_write_value(codec, buffer,
+                                                    value->map_list, error)) {
+    return FALSE;
+  }
+  if (value->map == nullptr) {
+    flpigeon_write_null(buffer);
+  } else if (!fl_standard_message_codec_write_value(codec, buffer, value->map,
+                                                    error)) {
+    return FALSE;
+  }
+  if (value->string_map == nullptr) {
+    flpigeon_write_null(buffer);
+  } else if (!fl_standard_message_codec_write_value(codec, buffer,
+                                                    value->string_map, error)) {
+    return FALSE;
+  }
+  if (value->int_map == nullptr) {
+    flpigeon_write_null(buffer);
+  } else if (!fl_standard_message_codec_write_value(codec, buffer,
+                                                    value->int_map, error)) {
+    return FALSE;
+  }
+  if (value->enum_map == nullptr) {
+    flpigeon_write_null(buffer);
+  } else if (!fl_standard_message_codec_write_value(codec, buffer,
+                                                    value->enum_map, error)) {
+    return FALSE;
+  }
+  if (value->object_map == nullptr) {
+    flpigeon_write_null(buffer);
+  } else if (!fl_standard_message_codec_write_value(codec, buffer,
+                                                    value->object_map, error)) {
+    return FALSE;
+  }
+  if (value->list_map == nullptr) {
+    flpigeon_write_null(buffer);
+  } else if (!fl_standard_message_codec_write_value(codec, buffer,
+                                                    value->list_map, error)) {
+    return FALSE;
+  }
+  if (value->map_map == nullptr) {
+    flpigeon_write_null(buffer);
+  } else if (!fl_standard_message_codec_write_value(codec, buffer,
+                                                    value->map_map, error)) {
+    return FALSE;
+  }
+  return TRUE;
 }
 
 static gboolean
@@ -4434,9 +5642,47 @@ core_tests_pigeon_test_message_codec_write_core_tests_pigeon_test_all_classes_wr
     CoreTestsPigeonTestAllClassesWrapper* value, GError** error) {
   uint8_t type = core_tests_pigeon_test_all_classes_wrapper_type_id;
   g_byte_array_append(buffer, &type, sizeof(uint8_t));
-  g_autoptr(FlValue) values =
-      core_tests_pigeon_test_all_classes_wrapper_to_list(value);
-  return fl_standard_message_codec_write_value(codec, buffer, values, error);
+  flpigeon_write_list_header(codec, buffer, 7);
+  if (!core_tests_pigeon_test_message_codec_write_core_tests_pigeon_test_all_nullable_types(
+          codec, buffer, value->all_nullable_types, error)) {
+    return FALSE;
+  }
+  if (value->all_nullable_types_without_recursion == nullptr) {
+    flpigeon_write_null(buffer);
+  } else if (!core_tests_pigeon_test_message_codec_write_core_tests_pigeon_test_all_nullable_types_without_recursion(
+                 codec, buffer, value->all_nullable_types_without_recursion,
+                 error)) {
+    return FALSE;
+  }
+  if (value->all_types == nullptr) {
+    flpigeon_write_null(buffer);
+  } else if (!core_tests_pigeon_test_message_codec_write_core_tests_pigeon_test_all_types(
+                 codec, buffer, value->all_types, error)) {
+    return FALSE;
+  }
+  if (!fl_standard_message_codec_write_value(codec, buffer, value->class_list,
+                                             error)) {
+    return FALSE;
+  }
+  if (value->nullable_class_list == nullptr) {
+    flpigeon_write_null(buffer);
+  } else if (!fl_standard_message_codec_write_value(codec, buffer,
+                                                    value->nullable_class_list,
+                                                    error)) {
+    return FALSE;
+  }
+  if (!fl_standard_message_codec_write_value(codec, buffer, value->class_map,
+                                             error)) {
+    return FALSE;
+  }
+  if (value->nullable_class_map == nullptr) {
+    flpigeon_write_null(buffer);
+  } else if (!fl_standard_message_codec_write_value(codec, buffer,
+                                                    value->nullable_class_map,
+                                                    error)) {
+    return FALSE;
+  }
+  return TRUE;
 }
 
 static gboolean
@@ -4445,9 +5691,14 @@ core_tests_pigeon_test_message_codec_write_core_tests_pigeon_test_test_message(
     CoreTestsPigeonTestTestMessage* value, GError** error) {
   uint8_t type = core_tests_pigeon_test_test_message_type_id;
   g_byte_array_append(buffer, &type, sizeof(uint8_t));
-  g_autoptr(FlValue) values =
-      core_tests_pigeon_test_test_message_to_list(value);
-  return fl_standard_message_codec_write_value(codec, buffer, values, error);
+  flpigeon_write_list_header(codec, buffer, 1);
+  if (value->test_list == nullptr) {
+    flpigeon_write_null(buffer);
+  } else if (!fl_standard_message_codec_write_value(codec, buffer,
+                                                    value->test_list, error)) {
+    return FALSE;
+  }
+  return TRUE;
 }
 
 static gboolean core_tests_pigeon_test_message_codec_write_value(
@@ -4535,17 +5786,10 @@ static FlValue*
 core_tests_pigeon_test_message_codec_read_core_tests_pigeon_test_unused_class(
     FlStandardMessageCodec* codec, GBytes* buffer, size_t* offset,
     GError** error) {
-  g_autoptr(FlValue) values =
-      fl_standard_message_codec_read_value(codec, buffer, offset, error);
-  if (values == nullptr) {
-    return nullptr;
-  }
-
   g_autoptr(CoreTestsPigeonTestUnusedClass) value =
-      core_tests_pigeon_test_unused_class_new_from_list(values);
+      core_tests_pigeon_test_unused_class_new_from_buffer(codec, buffer, offset,
+                                                          error);
   if (value == nullptr) {
-    g_set_error(error, FL_MESSAGE_CODEC_ERROR, FL_MESSAGE_CODEC_ERROR_FAILED,
-                "Invalid data received for MessageData");
     return nullptr;
   }
 
@@ -4557,17 +5801,10 @@ static FlValue*
 core_tests_pigeon_test_message_codec_read_core_tests_pigeon_test_all_types(
     FlStandardMessageCodec* codec, GBytes* buffer, size_t* offset,
     GError** error) {
-  g_autoptr(FlValue) values =
-      fl_standard_message_codec_read_value(codec, buffer, offset, error);
-  if (values == nullptr) {
-    return nullptr;
-  }
-
   g_autoptr(CoreTestsPigeonTestAllTypes) value =
-      core_tests_pigeon_test_all_types_new_from_list(values);
+      core_tests_pigeon_test_all_types_new_from_buffer(codec, buffer, offset,
+                                                       error);
   if (value == nullptr) {
-    g_set_error(error, FL_MESSAGE_CODEC_ERROR, FL_MESSAGE_CODEC_ERROR_FAILED,
-                "Invalid data received for MessageData");
     return nullptr;
   }
 
@@ -4579,17 +5816,10 @@ static FlValue*
 core_tests_pigeon_test_message_codec_read_core_tests_pigeon_test_all_nullable_types(
     FlStandardMessageCodec* codec, GBytes* buffer, size_t* offset,
     GError** error) {
-  g_autoptr(FlValue) values =
-      fl_standard_message_codec_read_value(codec, buffer, offset, error);
-  if (values == nullptr) {
-    return nullptr;
-  }
-
   g_autoptr(CoreTestsPigeonTestAllNullableTypes) value =
-      core_tests_pigeon_test_all_nullable_types_new_from_list(values);
+      core_tests_pigeon_test_all_nullable_types_new_from_buffer(codec, buffer,
+                                                                offset, error);
   if (value == nullptr) {
-    g_set_error(error, FL_MESSAGE_CODEC_ERROR, FL_MESSAGE_CODEC_ERROR_FAILED,
-                "Invalid data received for MessageData");
     return nullptr;
   }
 
@@ -4601,18 +5831,9 @@ static FlValue*
 core_tests_pigeon_test_message_codec_read_core_tests_pigeon_test_all_nullable_types_without_recursion(
     FlStandardMessageCodec* codec, GBytes* buffer, size_t* offset,
     GError** error) {
-  g_autoptr(FlValue) values =
-      fl_standard_message_codec_read_value(codec, buffer, offset, error);
-  if (values == nullptr) {
-    return nullptr;
-  }
-
-  g_autoptr(CoreTestsPigeonTestAllNullableTypesWithoutRecursion) value =
-      core_tests_pigeon_test_all_nullable_types_without_recursion_new_from_list(
-          values);
+  g_autoptr(CoreTestsPigeonTestAllNullableTypesWithoutRecursion) value = core_tests_pigeon_test_all_nullable_types_without_recursion_new_from_buffer(
+      codec, buffer, offset, error);
   if (value == nullptr) {
-    g_set_error(error, FL_MESSAGE_CODEC_ERROR, FL_MESSAGE_CODEC_ERROR_FAILED,
-                "Invalid data received for MessageData");
     return nullptr;
   }
 
@@ -4625,17 +5846,10 @@ static FlValue*
 core_tests_pigeon_test_message_codec_read_core_tests_pigeon_test_all_classes_wrapper(
     FlStandardMessageCodec* codec, GBytes* buffer, size_t* offset,
     GError** error) {
-  g_autoptr(FlValue) values =
-      fl_standard_message_codec_read_value(codec, buffer, offset, error);
-  if (values == nullptr) {
-    return nullptr;
-  }
-
   g_autoptr(CoreTestsPigeonTestAllClassesWrapper) value =
-      core_tests_pigeon_test_all_classes_wrapper_new_from_list(values);
+      core_tests_pigeon_test_all_classes_wrapper_new_from_buffer(codec, buffer,
+                                                                 offset, error);
   if (value == nullptr) {
-    g_set_error(error, FL_MESSAGE_CODEC_ERROR, FL_MESSAGE_CODEC_ERROR_FAILED,
-                "Invalid data received for MessageData");
     return nullptr;
   }
 
@@ -4647,17 +5861,10 @@ static FlValue*
 core_tests_pigeon_test_message_codec_read_core_tests_pigeon_test_test_message(
     FlStandardMessageCodec* codec, GBytes* buffer, size_t* offset,
     GError** error) {
-  g_autoptr(FlValue) values =
-      fl_standard_message_codec_read_value(codec, buffer, offset, error);
-  if (values == nullptr) {
-    return nullptr;
-  }
-
   g_autoptr(CoreTestsPigeonTestTestMessage) value =
-      core_tests_pigeon_test_test_message_new_from_list(values);
+      core_tests_pigeon_test_test_message_new_from_buffer(codec, buffer, offset,
+                                                          error);
   if (value == nullptr) {
-    g_set_error(error, FL_MESSAGE_CODEC_ERROR, FL_MESSAGE_CODEC_ERROR_FAILED,
-                "Invalid data received for MessageData");
     return nullptr;
   }
 
@@ -4718,6 +5925,20 @@ core_tests_pigeon_test_message_codec_new() {
   return self;
 }
 
+// A message to CoreTestsPigeonTestHostIntegrationCoreApi that is handled on its
+// task queue.
+typedef struct _CoreTestsPigeonTestHostIntegrationCoreApiTask
+    CoreTestsPigeonTestHostIntegrationCoreApiTask;
+struct _CoreTestsPigeonTestHostIntegrationCoreApiTask {
+  CoreTestsPigeonTestHostIntegrationCoreApi* api;
+  FlBinaryMessenger* messenger;
+  FlBinaryMessengerResponseHandle* response_handle;
+  GBytes* message;
+  GBytes* response;
+  void (*handler)(CoreTestsPigeonTestHostIntegrationCoreApiTask* task,
+                  FlValue* message_);
+};
+
 struct _CoreTestsPigeonTestHostIntegrationCoreApiResponseHandle {
   GObject parent_instance;
 
@@ -16178,6 +17399,8 @@ struct _CoreTestsPigeonTestHostIntegrationCoreApi {
   const CoreTestsPigeonTestHostIntegrationCoreApiVTable* vtable;
   gpointer user_data;
   GDestroyNotify user_data_free_func;
+  GThreadPool* task_queue;
+  GMainContext* context;
 };
 
 G_DEFINE_TYPE(CoreTestsPigeonTestHostIntegrationCoreApi,
@@ -16187,7 +17410,12 @@ static void core_tests_pigeon_test_host_integration_core_api_dispose(
     GObject* object) {
   CoreTestsPigeonTestHostIntegrationCoreApi* self =
       CORE_TESTS_PIGEON_TEST_HOST_INTEGRATION_CORE_API(object);
-  if (self->user_data != nullptr) {
+  if (self->task_queue != nullptr) {
+    g_thread_pool_free(self->task_queue, FALSE, TRUE);
+    self->task_queue = nullptr;
+  }
+  g_clear_pointer(&self->context, g_main_context_unref);
+  if (self->user_data != nullptr && self->user_data_free_func != nullptr) {
     self->user_data_free_func(self->user_data);
   }
   self->user_data = nullptr;
@@ -16204,6 +17432,95 @@ static void core_tests_pigeon_test_host_integration_core_api_class_init(
       core_tests_pigeon_test_host_integration_core_api_dispose;
 }
 
+static void core_tests_pigeon_test_host_integration_core_api_task_free(
+    gpointer data) {
+  CoreTestsPigeonTestHostIntegrationCoreApiTask* task =
+      static_cast<CoreTestsPigeonTestHostIntegrationCoreApiTask*>(data);
+  g_object_unref(task->api);
+  g_object_unref(task->messenger);
+  g_object_unref(task->response_handle);
+  g_bytes_unref(task->message);
+  g_clear_pointer(&task->response, g_bytes_unref);
+  g_free(task);
+}
+
+static gboolean
+core_tests_pigeon_test_host_integration_core_api_task_send_response_cb(
+    gpointer user_data) {
+  CoreTestsPigeonTestHostIntegrationCoreApiTask* task =
+      static_cast<CoreTestsPigeonTestHostIntegrationCoreApiTask*>(user_data);
+  g_autoptr(GError) error = nullptr;
+  if (!fl_binary_messenger_send_response(task->messenger, task->response_handle,
+                                         task->response, &error)) {
+    g_warning("Failed to send response to %s: %s", "HostIntegrationCoreApi",
+              error->message);
+  }
+  return G_SOURCE_REMOVE;
+}
+
+// Sends [response] to [task], or an empty response if it is nullptr.
+//
+// This can be called from any thread.
+static void core_tests_pigeon_test_host_integration_core_api_task_respond(
+    CoreTestsPigeonTestHostIntegrationCoreApiTask* task, FlValue* response) {
+  if (response != nullptr) {
+    g_autoptr(CoreTestsPigeonTestMessageCodec) codec =
+        core_tests_pigeon_test_message_codec_new();
+    g_autoptr(GError) error = nullptr;
+    task->response = fl_message_codec_encode_message(FL_MESSAGE_CODEC(codec),
+                                                     response, &error);
+    if (task->response == nullptr) {
+      g_warning("Failed to encode response to %s: %s", "HostIntegrationCoreApi",
+                error->message);
+    }
+  }
+
+  g_autoptr(GSource) source = g_idle_source_new();
+  g_source_set_callback(
+      source,
+      core_tests_pigeon_test_host_integration_core_api_task_send_response_cb,
+      task, core_tests_pigeon_test_host_integration_core_api_task_free);
+  g_source_attach(source, task->api->context);
+}
+
+static void core_tests_pigeon_test_host_integration_core_api_task_run(
+    gpointer data, gpointer user_data) {
+  CoreTestsPigeonTestHostIntegrationCoreApiTask* task =
+      static_cast<CoreTestsPigeonTestHostIntegrationCoreApiTask*>(data);
+  g_autoptr(CoreTestsPigeonTestMessageCodec) codec =
+      core_tests_pigeon_test_message_codec_new();
+  g_autoptr(GError) error = nullptr;
+  g_autoptr(FlValue) message_ = fl_message_codec_decode_message(
+      FL_MESSAGE_CODEC(codec), task->message, &error);
+  if (message_ == nullptr) {
+    g_warning("Failed to decode message to %s: %s", "HostIntegrationCoreApi",
+              error->message);
+    core_tests_pigeon_test_host_integration_core_api_task_respond(task,
+                                                                  nullptr);
+    return;
+  }
+
+  task->handler(task, message_);
+}
+
+static void core_tests_pigeon_test_host_integration_core_api_queue_task(
+    CoreTestsPigeonTestHostIntegrationCoreApi* self,
+    FlBinaryMessenger* messenger,
+    FlBinaryMessengerResponseHandle* response_handle, GBytes* message,
+    void (*handler)(CoreTestsPigeonTestHostIntegrationCoreApiTask* task,
+                    FlValue* message_)) {
+  CoreTestsPigeonTestHostIntegrationCoreApiTask* task =
+      g_new0(CoreTestsPigeonTestHostIntegrationCoreApiTask, 1);
+  task->api =
+      CORE_TESTS_PIGEON_TEST_HOST_INTEGRATION_CORE_API(g_object_ref(self));
+  task->messenger = FL_BINARY_MESSENGER(g_object_ref(messenger));
+  task->response_handle =
+      FL_BINARY_MESSENGER_RESPONSE_HANDLE(g_object_ref(response_handle));
+  task->message = g_bytes_ref(message);
+  task->handler = handler;
+  g_thread_pool_push(self->task_queue, task, nullptr);
+}
+
 static CoreTestsPigeonTestHostIntegrationCoreApi*
 core_tests_pigeon_test_host_integration_core_api_new(
     const CoreTestsPigeonTestHostIntegrationCoreApiVTable* vtable,
@@ -16215,6 +17532,10 @@ core_tests_pigeon_test_host_integration_core_api_new(
   self->vtable = vtable;
   self->user_data = user_data;
   self->user_data_free_func = user_data_free_func;
+  self->task_queue = g_thread_pool_new(
+      core_tests_pigeon_test_host_integration_core_api_task_run, nullptr, 1,
+      FALSE, nullptr);
+  self->context = g_main_context_ref_thread_default();
   return self;
 }
 
@@ -17719,8 +19040,13 @@ core_tests_pigeon_test_host_integration_core_api_echo_nullable_uint8_list_cb(
   }
 
   FlValue* value0 = fl_value_get_list_value(message_, 0);
-  const uint8_t* a_nullable_uint8_list = fl_value_get_uint8_list(value0);
-  size_t a_nullable_uint8_list_length = fl_value_get_length(value0);
+  const uint8_t* a_nullable_uint8_list = nullptr;
+  size_t a_nullable_uint8_list_length = 0;
+  if (fl_value_get_type(value0) != FL_VALUE_TYPE_NULL) {
+    a_nullable_uint8_list = static_cast<const uint8_t*>(
+        flpigeon_get_typed_list_data(fl_value_get_uint8_list(value0)));
+    a_nullable_uint8_list_length = fl_value_get_length(value0);
+  }
   g_autoptr(
       CoreTestsPigeonTestHostIntegrationCoreApiEchoNullableUint8ListResponse)
       response = self->vtable->echo_nullable_uint8_list(
@@ -18912,8 +20238,13 @@ core_tests_pigeon_test_host_integration_core_api_echo_async_nullable_uint8_list_
   }
 
   FlValue* value0 = fl_value_get_list_value(message_, 0);
-  const uint8_t* a_uint8_list = fl_value_get_uint8_list(value0);
-  size_t a_uint8_list_length = fl_value_get_length(value0);
+  const uint8_t* a_uint8_list = nullptr;
+  size_t a_uint8_list_length = 0;
+  if (fl_value_get_type(value0) != FL_VALUE_TYPE_NULL) {
+    a_uint8_list = static_cast<const uint8_t*>(
+        flpigeon_get_typed_list_data(fl_value_get_uint8_list(value0)));
+    a_uint8_list_length = fl_value_get_length(value0);
+  }
   g_autoptr(CoreTestsPigeonTestHostIntegrationCoreApiResponseHandle) handle =
       core_tests_pigeon_test_host_integration_core_api_response_handle_new(
           channel, response_handle);
@@ -19191,13 +20522,13 @@ core_tests_pigeon_test_host_integration_core_api_default_is_main_thread_cb(
 
 static void
 core_tests_pigeon_test_host_integration_core_api_task_queue_is_background_thread_cb(
-    FlBasicMessageChannel* channel, FlValue* message_,
-    FlBasicMessageChannelResponseHandle* response_handle, gpointer user_data) {
-  CoreTestsPigeonTestHostIntegrationCoreApi* self =
-      CORE_TESTS_PIGEON_TEST_HOST_INTEGRATION_CORE_API(user_data);
+    CoreTestsPigeonTestHostIntegrationCoreApiTask* task, FlValue* message_) {
+  CoreTestsPigeonTestHostIntegrationCoreApi* self = task->api;
 
   if (self->vtable == nullptr ||
       self->vtable->task_queue_is_background_thread == nullptr) {
+    core_tests_pigeon_test_host_integration_core_api_task_respond(task,
+                                                                  nullptr);
     return;
   }
 
@@ -19207,15 +20538,24 @@ core_tests_pigeon_test_host_integration_core_api_task_queue_is_background_thread
   if (response == nullptr) {
     g_warning("No response returned to %s.%s", "HostIntegrationCoreApi",
               "taskQueueIsBackgroundThread");
+    core_tests_pigeon_test_host_integration_core_api_task_respond(task,
+                                                                  nullptr);
     return;
   }
 
-  g_autoptr(GError) error = NULL;
-  if (!fl_basic_message_channel_respond(channel, response_handle,
-                                        response->value, &error)) {
-    g_warning("Failed to send response to %s.%s: %s", "HostIntegrationCoreApi",
-              "taskQueueIsBackgroundThread", error->message);
-  }
+  core_tests_pigeon_test_host_integration_core_api_task_respond(
+      task, response->value);
+}
+
+static void
+core_tests_pigeon_test_host_integration_core_api_task_queue_is_background_thread_queue_cb(
+    FlBinaryMessenger* messenger, const gchar* channel, GBytes* message,
+    FlBinaryMessengerResponseHandle* response_handle, gpointer user_data) {
+  CoreTestsPigeonTestHostIntegrationCoreApi* self =
+      CORE_TESTS_PIGEON_TEST_HOST_INTEGRATION_CORE_API(user_data);
+  core_tests_pigeon_test_host_integration_core_api_queue_task(
+      self, messenger, response_handle, message,
+      core_tests_pigeon_test_host_integration_core_api_task_queue_is_background_thread_cb);
 }
 
 static void
@@ -19961,8 +21301,13 @@ core_tests_pigeon_test_host_integration_core_api_call_flutter_echo_nullable_uint
   }
 
   FlValue* value0 = fl_value_get_list_value(message_, 0);
-  const uint8_t* list = fl_value_get_uint8_list(value0);
-  size_t list_length = fl_value_get_length(value0);
+  const uint8_t* list = nullptr;
+  size_t list_length = 0;
+  if (fl_value_get_type(value0) != FL_VALUE_TYPE_NULL) {
+    list = static_cast<const uint8_t*>(
+        flpigeon_get_typed_list_data(fl_value_get_uint8_list(value0)));
+    list_length = fl_value_get_length(value0);
+  }
   g_autoptr(CoreTestsPigeonTestHostIntegrationCoreApiResponseHandle) handle =
       core_tests_pigeon_test_host_integration_core_api_response_handle_new(
           channel, response_handle);
@@ -21632,13 +22977,9 @@ void core_tests_pigeon_test_host_integration_core_api_set_method_handlers(
           "dev.flutter.pigeon.pigeon_integration_tests.HostIntegrationCoreApi."
           "taskQueueIsBackgroundThread%s",
           dot_suffix);
-  g_autoptr(FlBasicMessageChannel) task_queue_is_background_thread_channel =
-      fl_basic_message_channel_new(messenger,
-                                   task_queue_is_background_thread_channel_name,
-                                   FL_MESSAGE_CODEC(codec));
-  fl_basic_message_channel_set_message_handler(
-      task_queue_is_background_thread_channel,
-      core_tests_pigeon_test_host_integration_core_api_task_queue_is_background_thread_cb,
+  fl_binary_messenger_set_message_handler_on_channel(
+      messenger, task_queue_is_background_thread_channel_name,
+      core_tests_pigeon_test_host_integration_core_api_task_queue_is_background_thread_queue_cb,
       g_object_ref(api_data), g_object_unref);
   g_autofree gchar* call_flutter_noop_channel_name = g_strdup_printf(
       "dev.flutter.pigeon.pigeon_integration_tests.HostIntegrationCoreApi."
@@ -23401,12 +24742,9 @@ void core_tests_pigeon_test_host_integration_core_api_clear_method_handlers(
           "dev.flutter.pigeon.pigeon_integration_tests.HostIntegrationCoreApi."
           "taskQueueIsBackgroundThread%s",
           dot_suffix);
-  g_autoptr(FlBasicMessageChannel) task_queue_is_background_thread_channel =
-      fl_basic_message_channel_new(messenger,
-                                   task_queue_is_background_thread_channel_name,
-                                   FL_MESSAGE_CODEC(codec));
-  fl_basic_message_channel_set_message_handler(
-      task_queue_is_background_thread_channel, nullptr, nullptr, nullptr);
+  fl_binary_messenger_set_message_handler_on_channel(
+      messenger, task_queue_is_background_thread_channel_name, nullptr, nullptr,
+      nullptr);
   g_autofree gchar* call_flutter_noop_channel_name = g_strdup_printf(
       "dev.flutter.pigeon.pigeon_integration_tests.HostIntegrationCoreApi."
       "callFlutterNoop%s",
@@ -27019,6 +28357,61 @@ struct _CoreTestsPigeonTestFlutterIntegrationCoreApi {
 
   FlBinaryMessenger* messenger;
   gchar* suffix;
+  CoreTestsPigeonTestMessageCodec* codec;
+
+  // The channel of each method, created on its first call.
+  FlBasicMessageChannel* noop_channel;
+  FlBasicMessageChannel* throw_error_channel;
+  FlBasicMessageChannel* throw_error_from_void_channel;
+  FlBasicMessageChannel* echo_all_types_channel;
+  FlBasicMessageChannel* echo_all_nullable_types_channel;
+  FlBasicMessageChannel* send_multiple_nullable_types_channel;
+  FlBasicMessageChannel* echo_all_nullable_types_without_recursion_channel;
+  FlBasicMessageChannel* send_multiple_nullable_types_without_recursion_channel;
+  FlBasicMessageChannel* echo_bool_channel;
+  FlBasicMessageChannel* echo_int_channel;
+  FlBasicMessageChannel* echo_double_channel;
+  FlBasicMessageChannel* echo_string_channel;
+  FlBasicMessageChannel* echo_uint8_list_channel;
+  FlBasicMessageChannel* echo_list_channel;
+  FlBasicMessageChannel* echo_enum_list_channel;
+  FlBasicMessageChannel* echo_class_list_channel;
+  FlBasicMessageChannel* echo_non_null_enum_list_channel;
+  FlBasicMessageChannel* echo_non_null_class_list_channel;
+  FlBasicMessageChannel* echo_map_channel;
+  FlBasicMessageChannel* echo_string_map_channel;
+  FlBasicMessageChannel* echo_int_map_channel;
+  FlBasicMessageChannel* echo_enum_map_channel;
+  FlBasicMessageChannel* echo_class_map_channel;
+  FlBasicMessageChannel* echo_non_null_string_map_channel;
+  FlBasicMessageChannel* echo_non_null_int_map_channel;
+  FlBasicMessageChannel* echo_non_null_enum_map_channel;
+  FlBasicMessageChannel* echo_non_null_class_map_channel;
+  FlBasicMessageChannel* echo_enum_channel;
+  FlBasicMessageChannel* echo_another_enum_channel;
+  FlBasicMessageChannel* echo_nullable_bool_channel;
+  FlBasicMessageChannel* echo_nullable_int_channel;
+  FlBasicMessageChannel* echo_nullable_double_channel;
+  FlBasicMessageChannel* echo_nullable_string_channel;
+  FlBasicMessageChannel* echo_nullable_uint8_list_channel;
+  FlBasicMessageChannel* echo_nullable_list_channel;
+  FlBasicMessageChannel* echo_nullable_enum_list_channel;
+  FlBasicMessageChannel* echo_nullable_class_list_channel;
+  FlBasicMessageChannel* echo_nullable_non_null_enum_list_channel;
+  FlBasicMessageChannel* echo_nullable_non_null_class_list_channel;
+  FlBasicMessageChannel* echo_nullable_map_channel;
+  FlBasicMessageChannel* echo_nullable_string_map_channel;
+  FlBasicMessageChannel* echo_nullable_int_map_channel;
+  FlBasicMessageChannel* echo_nullable_enum_map_channel;
+  FlBasicMessageChannel* echo_nullable_class_map_channel;
+  FlBasicMessageChannel* echo_nullable_non_null_string_map_channel;
+  FlBasicMessageChannel* echo_nullable_non_null_int_map_channel;
+  FlBasicMessageChannel* echo_nullable_non_null_enum_map_channel;
+  FlBasicMessageChannel* echo_nullable_non_null_class_map_channel;
+  FlBasicMessageChannel* echo_nullable_enum_channel;
+  FlBasicMessageChannel* echo_another_nullable_enum_channel;
+  FlBasicMessageChannel* noop_async_channel;
+  FlBasicMessageChannel* echo_async_string_channel;
 };
 
 G_DEFINE_TYPE(CoreTestsPigeonTestFlutterIntegrationCoreApi,
@@ -27031,6 +28424,59 @@ static void core_tests_pigeon_test_flutter_integration_core_api_dispose(
       CORE_TESTS_PIGEON_TEST_FLUTTER_INTEGRATION_CORE_API(object);
   g_clear_object(&self->messenger);
   g_clear_pointer(&self->suffix, g_free);
+  g_clear_object(&self->codec);
+  g_clear_object(&self->noop_channel);
+  g_clear_object(&self->throw_error_channel);
+  g_clear_object(&self->throw_error_from_void_channel);
+  g_clear_object(&self->echo_all_types_channel);
+  g_clear_object(&self->echo_all_nullable_types_channel);
+  g_clear_object(&self->send_multiple_nullable_types_channel);
+  g_clear_object(&self->echo_all_nullable_types_without_recursion_channel);
+  g_clear_object(&self->send_multiple_nullable_types_without_recursion_channel);
+  g_clear_object(&self->echo_bool_channel);
+  g_clear_object(&self->echo_int_channel);
+  g_clear_object(&self->echo_double_channel);
+  g_clear_object(&self->echo_string_channel);
+  g_clear_object(&self->echo_uint8_list_channel);
+  g_clear_object(&self->echo_list_channel);
+  g_clear_object(&self->echo_enum_list_channel);
+  g_clear_object(&self->echo_class_list_channel);
+  g_clear_object(&self->echo_non_null_enum_list_channel);
+  g_clear_object(&self->echo_non_null_class_list_channel);
+  g_clear_object(&self->echo_map_channel);
+  g_clear_object(&self->echo_string_map_channel);
+  g_clear_object(&self->echo_int_map_channel);
+  g_clear_object(&self->echo_enum_map_channel);
+  g_clear_object(&self->echo_class_map_channel);
+  g_clear_object(&self->echo_non_null_string_map_channel);
+  g_clear_object(&self->echo_non_null_int_map_channel);
+  g_clear_object(&self->echo_non_null_enum_map_channel);
+  g_clear_object(&self->echo_non_null_class_map_channel);
+  g_clear_object(&self->echo_enum_channel);
+  g_clear_object(&self->echo_another_enum_channel);
+  g_clear_object(&self->echo_nullable_bool_channel);
+  g_clear_object(&self->echo_nullable_int_channel);
+  g_clear_object(&self->echo_nullable_double_channel);
+  g_clear_object(&self->echo_nullable_string_channel);
+  g_clear_object(&self->echo_nullable_uint8_list_channel);
+  g_clear_object(&self->echo_nullable_list_channel);
+  g_clear_object(&self->echo_nullable_enum_list_channel);
+  g_clear_object(&self->echo_nullable_class_list_channel);
+  g_clear_object(&self->echo_nullable_non_null_enum_list_channel);
+  g_clear_object(&self->echo_nullable_non_null_class_list_channel);
+  g_clear_object(&self->echo_nullable_map_channel);
+  g_clear_object(&self->echo_nullable_string_map_channel);
+  g_clear_object(&self->echo_nullable_int_map_channel);
+  g_clear_object(&self->echo_nullable_enum_map_channel);
+  g_clear_object(&self->echo_nullable_class_map_channel);
+  g_clear_object(&self->echo_nullable_non_null_string_map_channel);
+  g_clear_object(&self->echo_nullable_non_null_int_map_channel);
+  g_clear_object(&self->echo_nullable_non_null_enum_map_channel);
+  g_clear_object(&self->echo_nullable_non_null_class_map_channel);
+  g_clear_object(&self->echo_nullable_enum_channel);
+  g_clear_object(&self->echo_another_nullable_enum_channel);
+  g_clear_object(&self->noop_async_channel);
+  g_clear_object(&self->echo_async_string_channel);
   G_OBJECT_CLASS(
       core_tests_pigeon_test_flutter_integration_core_api_parent_class)
       ->dispose(object);
@@ -27055,6 +28501,7 @@ core_tests_pigeon_test_flutter_integration_core_api_new(
   self->messenger = FL_BINARY_MESSENGER(g_object_ref(messenger));
   self->suffix =
       suffix != nullptr ? g_strdup_printf(".%s", suffix) : g_strdup("");
+  self->codec = core_tests_pigeon_test_message_codec_new();
   return self;
 }
 
@@ -27163,18 +28610,18 @@ void core_tests_pigeon_test_flutter_integration_core_api_noop(
     GCancellable* cancellable, GAsyncReadyCallback callback,
     gpointer user_data) {
   g_autoptr(FlValue) args = fl_value_new_list();
-  g_autofree gchar* channel_name = g_strdup_printf(
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "noop%s",
-      self->suffix);
-  g_autoptr(CoreTestsPigeonTestMessageCodec) codec =
-      core_tests_pigeon_test_message_codec_new();
-  FlBasicMessageChannel* channel = fl_basic_message_channel_new(
-      self->messenger, channel_name, FL_MESSAGE_CODEC(codec));
+  if (self->noop_channel == nullptr) {
+    g_autofree gchar* channel_name = g_strdup_printf(
+        "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
+        "noop%s",
+        self->suffix);
+    self->noop_channel = fl_basic_message_channel_new(
+        self->messenger, channel_name, FL_MESSAGE_CODEC(self->codec));
+  }
   GTask* task = g_task_new(self, cancellable, callback, user_data);
-  g_task_set_task_data(task, channel, g_object_unref);
+  g_task_set_task_data(task, g_object_ref(self->noop_channel), g_object_unref);
   fl_basic_message_channel_send(
-      channel, args, cancellable,
+      self->noop_channel, args, cancellable,
       core_tests_pigeon_test_flutter_integration_core_api_noop_cb, task);
 }
 
@@ -27325,18 +28772,19 @@ void core_tests_pigeon_test_flutter_integration_core_api_throw_error(
     GCancellable* cancellable, GAsyncReadyCallback callback,
     gpointer user_data) {
   g_autoptr(FlValue) args = fl_value_new_list();
-  g_autofree gchar* channel_name = g_strdup_printf(
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "throwError%s",
-      self->suffix);
-  g_autoptr(CoreTestsPigeonTestMessageCodec) codec =
-      core_tests_pigeon_test_message_codec_new();
-  FlBasicMessageChannel* channel = fl_basic_message_channel_new(
-      self->messenger, channel_name, FL_MESSAGE_CODEC(codec));
+  if (self->throw_error_channel == nullptr) {
+    g_autofree gchar* channel_name = g_strdup_printf(
+        "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
+        "throwError%s",
+        self->suffix);
+    self->throw_error_channel = fl_basic_message_channel_new(
+        self->messenger, channel_name, FL_MESSAGE_CODEC(self->codec));
+  }
   GTask* task = g_task_new(self, cancellable, callback, user_data);
-  g_task_set_task_data(task, channel, g_object_unref);
+  g_task_set_task_data(task, g_object_ref(self->throw_error_channel),
+                       g_object_unref);
   fl_basic_message_channel_send(
-      channel, args, cancellable,
+      self->throw_error_channel, args, cancellable,
       core_tests_pigeon_test_flutter_integration_core_api_throw_error_cb, task);
 }
 
@@ -27472,18 +28920,19 @@ void core_tests_pigeon_test_flutter_integration_core_api_throw_error_from_void(
     GCancellable* cancellable, GAsyncReadyCallback callback,
     gpointer user_data) {
   g_autoptr(FlValue) args = fl_value_new_list();
-  g_autofree gchar* channel_name = g_strdup_printf(
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "throwErrorFromVoid%s",
-      self->suffix);
-  g_autoptr(CoreTestsPigeonTestMessageCodec) codec =
-      core_tests_pigeon_test_message_codec_new();
-  FlBasicMessageChannel* channel = fl_basic_message_channel_new(
-      self->messenger, channel_name, FL_MESSAGE_CODEC(codec));
+  if (self->throw_error_from_void_channel == nullptr) {
+    g_autofree gchar* channel_name = g_strdup_printf(
+        "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
+        "throwErrorFromVoid%s",
+        self->suffix);
+    self->throw_error_from_void_channel = fl_basic_message_channel_new(
+        self->messenger, channel_name, FL_MESSAGE_CODEC(self->codec));
+  }
   GTask* task = g_task_new(self, cancellable, callback, user_data);
-  g_task_set_task_data(task, channel, g_object_unref);
+  g_task_set_task_data(task, g_object_ref(self->throw_error_from_void_channel),
+                       g_object_unref);
   fl_basic_message_channel_send(
-      channel, args, cancellable,
+      self->throw_error_from_void_channel, args, cancellable,
       core_tests_pigeon_test_flutter_integration_core_api_throw_error_from_void_cb,
       task);
 }
@@ -27637,18 +29086,19 @@ void core_tests_pigeon_test_flutter_integration_core_api_echo_all_types(
   fl_value_append_take(
       args, fl_value_new_custom_object(core_tests_pigeon_test_all_types_type_id,
                                        G_OBJECT(everything)));
-  g_autofree gchar* channel_name = g_strdup_printf(
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoAllTypes%s",
-      self->suffix);
-  g_autoptr(CoreTestsPigeonTestMessageCodec) codec =
-      core_tests_pigeon_test_message_codec_new();
-  FlBasicMessageChannel* channel = fl_basic_message_channel_new(
-      self->messenger, channel_name, FL_MESSAGE_CODEC(codec));
+  if (self->echo_all_types_channel == nullptr) {
+    g_autofree gchar* channel_name = g_strdup_printf(
+        "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
+        "echoAllTypes%s",
+        self->suffix);
+    self->echo_all_types_channel = fl_basic_message_channel_new(
+        self->messenger, channel_name, FL_MESSAGE_CODEC(self->codec));
+  }
   GTask* task = g_task_new(self, cancellable, callback, user_data);
-  g_task_set_task_data(task, channel, g_object_unref);
+  g_task_set_task_data(task, g_object_ref(self->echo_all_types_channel),
+                       g_object_unref);
   fl_basic_message_channel_send(
-      channel, args, cancellable,
+      self->echo_all_types_channel, args, cancellable,
       core_tests_pigeon_test_flutter_integration_core_api_echo_all_types_cb,
       task);
 }
@@ -27815,18 +29265,20 @@ void core_tests_pigeon_test_flutter_integration_core_api_echo_all_nullable_types
                       core_tests_pigeon_test_all_nullable_types_type_id,
                       G_OBJECT(everything))
                 : fl_value_new_null());
-  g_autofree gchar* channel_name = g_strdup_printf(
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoAllNullableTypes%s",
-      self->suffix);
-  g_autoptr(CoreTestsPigeonTestMessageCodec) codec =
-      core_tests_pigeon_test_message_codec_new();
-  FlBasicMessageChannel* channel = fl_basic_message_channel_new(
-      self->messenger, channel_name, FL_MESSAGE_CODEC(codec));
+  if (self->echo_all_nullable_types_channel == nullptr) {
+    g_autofree gchar* channel_name = g_strdup_printf(
+        "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
+        "echoAllNullableTypes%s",
+        self->suffix);
+    self->echo_all_nullable_types_channel = fl_basic_message_channel_new(
+        self->messenger, channel_name, FL_MESSAGE_CODEC(self->codec));
+  }
   GTask* task = g_task_new(self, cancellable, callback, user_data);
-  g_task_set_task_data(task, channel, g_object_unref);
+  g_task_set_task_data(task,
+                       g_object_ref(self->echo_all_nullable_types_channel),
+                       g_object_unref);
   fl_basic_message_channel_send(
-      channel, args, cancellable,
+      self->echo_all_nullable_types_channel, args, cancellable,
       core_tests_pigeon_test_flutter_integration_core_api_echo_all_nullable_types_cb,
       task);
 }
@@ -27995,18 +29447,20 @@ void core_tests_pigeon_test_flutter_integration_core_api_send_multiple_nullable_
   fl_value_append_take(args, a_nullable_string != nullptr
                                  ? fl_value_new_string(a_nullable_string)
                                  : fl_value_new_null());
-  g_autofree gchar* channel_name = g_strdup_printf(
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "sendMultipleNullableTypes%s",
-      self->suffix);
-  g_autoptr(CoreTestsPigeonTestMessageCodec) codec =
-      core_tests_pigeon_test_message_codec_new();
-  FlBasicMessageChannel* channel = fl_basic_message_channel_new(
-      self->messenger, channel_name, FL_MESSAGE_CODEC(codec));
+  if (self->send_multiple_nullable_types_channel == nullptr) {
+    g_autofree gchar* channel_name = g_strdup_printf(
+        "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
+        "sendMultipleNullableTypes%s",
+        self->suffix);
+    self->send_multiple_nullable_types_channel = fl_basic_message_channel_new(
+        self->messenger, channel_name, FL_MESSAGE_CODEC(self->codec));
+  }
   GTask* task = g_task_new(self, cancellable, callback, user_data);
-  g_task_set_task_data(task, channel, g_object_unref);
+  g_task_set_task_data(
+      task, g_object_ref(self->send_multiple_nullable_types_channel),
+      g_object_unref);
   fl_basic_message_channel_send(
-      channel, args, cancellable,
+      self->send_multiple_nullable_types_channel, args, cancellable,
       core_tests_pigeon_test_flutter_integration_core_api_send_multiple_nullable_types_cb,
       task);
 }
@@ -28176,18 +29630,23 @@ void core_tests_pigeon_test_flutter_integration_core_api_echo_all_nullable_types
                 core_tests_pigeon_test_all_nullable_types_without_recursion_type_id,
                 G_OBJECT(everything))
           : fl_value_new_null());
-  g_autofree gchar* channel_name = g_strdup_printf(
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoAllNullableTypesWithoutRecursion%s",
-      self->suffix);
-  g_autoptr(CoreTestsPigeonTestMessageCodec) codec =
-      core_tests_pigeon_test_message_codec_new();
-  FlBasicMessageChannel* channel = fl_basic_message_channel_new(
-      self->messenger, channel_name, FL_MESSAGE_CODEC(codec));
+  if (self->echo_all_nullable_types_without_recursion_channel == nullptr) {
+    g_autofree gchar* channel_name = g_strdup_printf(
+        "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
+        "echoAllNullableTypesWithoutRecursion%s",
+        self->suffix);
+    self->echo_all_nullable_types_without_recursion_channel =
+        fl_basic_message_channel_new(self->messenger, channel_name,
+                                     FL_MESSAGE_CODEC(self->codec));
+  }
   GTask* task = g_task_new(self, cancellable, callback, user_data);
-  g_task_set_task_data(task, channel, g_object_unref);
+  g_task_set_task_data(
+      task,
+      g_object_ref(self->echo_all_nullable_types_without_recursion_channel),
+      g_object_unref);
   fl_basic_message_channel_send(
-      channel, args, cancellable,
+      self->echo_all_nullable_types_without_recursion_channel, args,
+      cancellable,
       core_tests_pigeon_test_flutter_integration_core_api_echo_all_nullable_types_without_recursion_cb,
       task);
 }
@@ -28356,18 +29815,23 @@ void core_tests_pigeon_test_flutter_integration_core_api_send_multiple_nullable_
   fl_value_append_take(args, a_nullable_string != nullptr
                                  ? fl_value_new_string(a_nullable_string)
                                  : fl_value_new_null());
-  g_autofree gchar* channel_name = g_strdup_printf(
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "sendMultipleNullableTypesWithoutRecursion%s",
-      self->suffix);
-  g_autoptr(CoreTestsPigeonTestMessageCodec) codec =
-      core_tests_pigeon_test_message_codec_new();
-  FlBasicMessageChannel* channel = fl_basic_message_channel_new(
-      self->messenger, channel_name, FL_MESSAGE_CODEC(codec));
+  if (self->send_multiple_nullable_types_without_recursion_channel == nullptr) {
+    g_autofree gchar* channel_name = g_strdup_printf(
+        "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
+        "sendMultipleNullableTypesWithoutRecursion%s",
+        self->suffix);
+    self->send_multiple_nullable_types_without_recursion_channel =
+        fl_basic_message_channel_new(self->messenger, channel_name,
+                                     FL_MESSAGE_CODEC(self->codec));
+  }
   GTask* task = g_task_new(self, cancellable, callback, user_data);
-  g_task_set_task_data(task, channel, g_object_unref);
+  g_task_set_task_data(
+      task,
+      g_object_ref(self->send_multiple_nullable_types_without_recursion_channel),
+      g_object_unref);
   fl_basic_message_channel_send(
-      channel, args, cancellable,
+      self->send_multiple_nullable_types_without_recursion_channel, args,
+      cancellable,
       core_tests_pigeon_test_flutter_integration_core_api_send_multiple_nullable_types_without_recursion_cb,
       task);
 }
@@ -28516,18 +29980,19 @@ void core_tests_pigeon_test_flutter_integration_core_api_echo_bool(
     gpointer user_data) {
   g_autoptr(FlValue) args = fl_value_new_list();
   fl_value_append_take(args, fl_value_new_bool(a_bool));
-  g_autofree gchar* channel_name = g_strdup_printf(
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoBool%s",
-      self->suffix);
-  g_autoptr(CoreTestsPigeonTestMessageCodec) codec =
-      core_tests_pigeon_test_message_codec_new();
-  FlBasicMessageChannel* channel = fl_basic_message_channel_new(
-      self->messenger, channel_name, FL_MESSAGE_CODEC(codec));
+  if (self->echo_bool_channel == nullptr) {
+    g_autofree gchar* channel_name = g_strdup_printf(
+        "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
+        "echoBool%s",
+        self->suffix);
+    self->echo_bool_channel = fl_basic_message_channel_new(
+        self->messenger, channel_name, FL_MESSAGE_CODEC(self->codec));
+  }
   GTask* task = g_task_new(self, cancellable, callback, user_data);
-  g_task_set_task_data(task, channel, g_object_unref);
+  g_task_set_task_data(task, g_object_ref(self->echo_bool_channel),
+                       g_object_unref);
   fl_basic_message_channel_send(
-      channel, args, cancellable,
+      self->echo_bool_channel, args, cancellable,
       core_tests_pigeon_test_flutter_integration_core_api_echo_bool_cb, task);
 }
 
@@ -28675,18 +30140,19 @@ void core_tests_pigeon_test_flutter_integration_core_api_echo_int(
     gpointer user_data) {
   g_autoptr(FlValue) args = fl_value_new_list();
   fl_value_append_take(args, fl_value_new_int(an_int));
-  g_autofree gchar* channel_name = g_strdup_printf(
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoInt%s",
-      self->suffix);
-  g_autoptr(CoreTestsPigeonTestMessageCodec) codec =
-      core_tests_pigeon_test_message_codec_new();
-  FlBasicMessageChannel* channel = fl_basic_message_channel_new(
-      self->messenger, channel_name, FL_MESSAGE_CODEC(codec));
+  if (self->echo_int_channel == nullptr) {
+    g_autofree gchar* channel_name = g_strdup_printf(
+        "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
+        "echoInt%s",
+        self->suffix);
+    self->echo_int_channel = fl_basic_message_channel_new(
+        self->messenger, channel_name, FL_MESSAGE_CODEC(self->codec));
+  }
   GTask* task = g_task_new(self, cancellable, callback, user_data);
-  g_task_set_task_data(task, channel, g_object_unref);
+  g_task_set_task_data(task, g_object_ref(self->echo_int_channel),
+                       g_object_unref);
   fl_basic_message_channel_send(
-      channel, args, cancellable,
+      self->echo_int_channel, args, cancellable,
       core_tests_pigeon_test_flutter_integration_core_api_echo_int_cb, task);
 }
 
@@ -28835,18 +30301,19 @@ void core_tests_pigeon_test_flutter_integration_core_api_echo_double(
     gpointer user_data) {
   g_autoptr(FlValue) args = fl_value_new_list();
   fl_value_append_take(args, fl_value_new_float(a_double));
-  g_autofree gchar* channel_name = g_strdup_printf(
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoDouble%s",
-      self->suffix);
-  g_autoptr(CoreTestsPigeonTestMessageCodec) codec =
-      core_tests_pigeon_test_message_codec_new();
-  FlBasicMessageChannel* channel = fl_basic_message_channel_new(
-      self->messenger, channel_name, FL_MESSAGE_CODEC(codec));
+  if (self->echo_double_channel == nullptr) {
+    g_autofree gchar* channel_name = g_strdup_printf(
+        "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
+        "echoDouble%s",
+        self->suffix);
+    self->echo_double_channel = fl_basic_message_channel_new(
+        self->messenger, channel_name, FL_MESSAGE_CODEC(self->codec));
+  }
   GTask* task = g_task_new(self, cancellable, callback, user_data);
-  g_task_set_task_data(task, channel, g_object_unref);
+  g_task_set_task_data(task, g_object_ref(self->echo_double_channel),
+                       g_object_unref);
   fl_basic_message_channel_send(
-      channel, args, cancellable,
+      self->echo_double_channel, args, cancellable,
       core_tests_pigeon_test_flutter_integration_core_api_echo_double_cb, task);
 }
 
@@ -28995,18 +30462,19 @@ void core_tests_pigeon_test_flutter_integration_core_api_echo_string(
     gpointer user_data) {
   g_autoptr(FlValue) args = fl_value_new_list();
   fl_value_append_take(args, fl_value_new_string(a_string));
-  g_autofree gchar* channel_name = g_strdup_printf(
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoString%s",
-      self->suffix);
-  g_autoptr(CoreTestsPigeonTestMessageCodec) codec =
-      core_tests_pigeon_test_message_codec_new();
-  FlBasicMessageChannel* channel = fl_basic_message_channel_new(
-      self->messenger, channel_name, FL_MESSAGE_CODEC(codec));
+  if (self->echo_string_channel == nullptr) {
+    g_autofree gchar* channel_name = g_strdup_printf(
+        "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
+        "echoString%s",
+        self->suffix);
+    self->echo_string_channel = fl_basic_message_channel_new(
+        self->messenger, channel_name, FL_MESSAGE_CODEC(self->codec));
+  }
   GTask* task = g_task_new(self, cancellable, callback, user_data);
-  g_task_set_task_data(task, channel, g_object_unref);
+  g_task_set_task_data(task, g_object_ref(self->echo_string_channel),
+                       g_object_unref);
   fl_basic_message_channel_send(
-      channel, args, cancellable,
+      self->echo_string_channel, args, cancellable,
       core_tests_pigeon_test_flutter_integration_core_api_echo_string_cb, task);
 }
 
@@ -29160,18 +30628,19 @@ void core_tests_pigeon_test_flutter_integration_core_api_echo_uint8_list(
     gpointer user_data) {
   g_autoptr(FlValue) args = fl_value_new_list();
   fl_value_append_take(args, fl_value_new_uint8_list(list, list_length));
-  g_autofree gchar* channel_name = g_strdup_printf(
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoUint8List%s",
-      self->suffix);
-  g_autoptr(CoreTestsPigeonTestMessageCodec) codec =
-      core_tests_pigeon_test_message_codec_new();
-  FlBasicMessageChannel* channel = fl_basic_message_channel_new(
-      self->messenger, channel_name, FL_MESSAGE_CODEC(codec));
+  if (self->echo_uint8_list_channel == nullptr) {
+    g_autofree gchar* channel_name = g_strdup_printf(
+        "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
+        "echoUint8List%s",
+        self->suffix);
+    self->echo_uint8_list_channel = fl_basic_message_channel_new(
+        self->messenger, channel_name, FL_MESSAGE_CODEC(self->codec));
+  }
   GTask* task = g_task_new(self, cancellable, callback, user_data);
-  g_task_set_task_data(task, channel, g_object_unref);
+  g_task_set_task_data(task, g_object_ref(self->echo_uint8_list_channel),
+                       g_object_unref);
   fl_basic_message_channel_send(
-      channel, args, cancellable,
+      self->echo_uint8_list_channel, args, cancellable,
       core_tests_pigeon_test_flutter_integration_core_api_echo_uint8_list_cb,
       task);
 }
@@ -29320,18 +30789,19 @@ void core_tests_pigeon_test_flutter_integration_core_api_echo_list(
     gpointer user_data) {
   g_autoptr(FlValue) args = fl_value_new_list();
   fl_value_append_take(args, fl_value_ref(list));
-  g_autofree gchar* channel_name = g_strdup_printf(
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoList%s",
-      self->suffix);
-  g_autoptr(CoreTestsPigeonTestMessageCodec) codec =
-      core_tests_pigeon_test_message_codec_new();
-  FlBasicMessageChannel* channel = fl_basic_message_channel_new(
-      self->messenger, channel_name, FL_MESSAGE_CODEC(codec));
+  if (self->echo_list_channel == nullptr) {
+    g_autofree gchar* channel_name = g_strdup_printf(
+        "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
+        "echoList%s",
+        self->suffix);
+    self->echo_list_channel = fl_basic_message_channel_new(
+        self->messenger, channel_name, FL_MESSAGE_CODEC(self->codec));
+  }
   GTask* task = g_task_new(self, cancellable, callback, user_data);
-  g_task_set_task_data(task, channel, g_object_unref);
+  g_task_set_task_data(task, g_object_ref(self->echo_list_channel),
+                       g_object_unref);
   fl_basic_message_channel_send(
-      channel, args, cancellable,
+      self->echo_list_channel, args, cancellable,
       core_tests_pigeon_test_flutter_integration_core_api_echo_list_cb, task);
 }
 
@@ -29481,18 +30951,19 @@ void core_tests_pigeon_test_flutter_integration_core_api_echo_enum_list(
     gpointer user_data) {
   g_autoptr(FlValue) args = fl_value_new_list();
   fl_value_append_take(args, fl_value_ref(enum_list));
-  g_autofree gchar* channel_name = g_strdup_printf(
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoEnumList%s",
-      self->suffix);
-  g_autoptr(CoreTestsPigeonTestMessageCodec) codec =
-      core_tests_pigeon_test_message_codec_new();
-  FlBasicMessageChannel* channel = fl_basic_message_channel_new(
-      self->messenger, channel_name, FL_MESSAGE_CODEC(codec));
+  if (self->echo_enum_list_channel == nullptr) {
+    g_autofree gchar* channel_name = g_strdup_printf(
+        "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
+        "echoEnumList%s",
+        self->suffix);
+    self->echo_enum_list_channel = fl_basic_message_channel_new(
+        self->messenger, channel_name, FL_MESSAGE_CODEC(self->codec));
+  }
   GTask* task = g_task_new(self, cancellable, callback, user_data);
-  g_task_set_task_data(task, channel, g_object_unref);
+  g_task_set_task_data(task, g_object_ref(self->echo_enum_list_channel),
+                       g_object_unref);
   fl_basic_message_channel_send(
-      channel, args, cancellable,
+      self->echo_enum_list_channel, args, cancellable,
       core_tests_pigeon_test_flutter_integration_core_api_echo_enum_list_cb,
       task);
 }
@@ -29643,18 +31114,19 @@ void core_tests_pigeon_test_flutter_integration_core_api_echo_class_list(
     gpointer user_data) {
   g_autoptr(FlValue) args = fl_value_new_list();
   fl_value_append_take(args, fl_value_ref(class_list));
-  g_autofree gchar* channel_name = g_strdup_printf(
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoClassList%s",
-      self->suffix);
-  g_autoptr(CoreTestsPigeonTestMessageCodec) codec =
-      core_tests_pigeon_test_message_codec_new();
-  FlBasicMessageChannel* channel = fl_basic_message_channel_new(
-      self->messenger, channel_name, FL_MESSAGE_CODEC(codec));
+  if (self->echo_class_list_channel == nullptr) {
+    g_autofree gchar* channel_name = g_strdup_printf(
+        "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
+        "echoClassList%s",
+        self->suffix);
+    self->echo_class_list_channel = fl_basic_message_channel_new(
+        self->messenger, channel_name, FL_MESSAGE_CODEC(self->codec));
+  }
   GTask* task = g_task_new(self, cancellable, callback, user_data);
-  g_task_set_task_data(task, channel, g_object_unref);
+  g_task_set_task_data(task, g_object_ref(self->echo_class_list_channel),
+                       g_object_unref);
   fl_basic_message_channel_send(
-      channel, args, cancellable,
+      self->echo_class_list_channel, args, cancellable,
       core_tests_pigeon_test_flutter_integration_core_api_echo_class_list_cb,
       task);
 }
@@ -29812,18 +31284,20 @@ void core_tests_pigeon_test_flutter_integration_core_api_echo_non_null_enum_list
     gpointer user_data) {
   g_autoptr(FlValue) args = fl_value_new_list();
   fl_value_append_take(args, fl_value_ref(enum_list));
-  g_autofree gchar* channel_name = g_strdup_printf(
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoNonNullEnumList%s",
-      self->suffix);
-  g_autoptr(CoreTestsPigeonTestMessageCodec) codec =
-      core_tests_pigeon_test_message_codec_new();
-  FlBasicMessageChannel* channel = fl_basic_message_channel_new(
-      self->messenger, channel_name, FL_MESSAGE_CODEC(codec));
+  if (self->echo_non_null_enum_list_channel == nullptr) {
+    g_autofree gchar* channel_name = g_strdup_printf(
+        "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
+        "echoNonNullEnumList%s",
+        self->suffix);
+    self->echo_non_null_enum_list_channel = fl_basic_message_channel_new(
+        self->messenger, channel_name, FL_MESSAGE_CODEC(self->codec));
+  }
   GTask* task = g_task_new(self, cancellable, callback, user_data);
-  g_task_set_task_data(task, channel, g_object_unref);
+  g_task_set_task_data(task,
+                       g_object_ref(self->echo_non_null_enum_list_channel),
+                       g_object_unref);
   fl_basic_message_channel_send(
-      channel, args, cancellable,
+      self->echo_non_null_enum_list_channel, args, cancellable,
       core_tests_pigeon_test_flutter_integration_core_api_echo_non_null_enum_list_cb,
       task);
 }
@@ -29981,18 +31455,20 @@ void core_tests_pigeon_test_flutter_integration_core_api_echo_non_null_class_lis
     gpointer user_data) {
   g_autoptr(FlValue) args = fl_value_new_list();
   fl_value_append_take(args, fl_value_ref(class_list));
-  g_autofree gchar* channel_name = g_strdup_printf(
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoNonNullClassList%s",
-      self->suffix);
-  g_autoptr(CoreTestsPigeonTestMessageCodec) codec =
-      core_tests_pigeon_test_message_codec_new();
-  FlBasicMessageChannel* channel = fl_basic_message_channel_new(
-      self->messenger, channel_name, FL_MESSAGE_CODEC(codec));
+  if (self->echo_non_null_class_list_channel == nullptr) {
+    g_autofree gchar* channel_name = g_strdup_printf(
+        "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
+        "echoNonNullClassList%s",
+        self->suffix);
+    self->echo_non_null_class_list_channel = fl_basic_message_channel_new(
+        self->messenger, channel_name, FL_MESSAGE_CODEC(self->codec));
+  }
   GTask* task = g_task_new(self, cancellable, callback, user_data);
-  g_task_set_task_data(task, channel, g_object_unref);
+  g_task_set_task_data(task,
+                       g_object_ref(self->echo_non_null_class_list_channel),
+                       g_object_unref);
   fl_basic_message_channel_send(
-      channel, args, cancellable,
+      self->echo_non_null_class_list_channel, args, cancellable,
       core_tests_pigeon_test_flutter_integration_core_api_echo_non_null_class_list_cb,
       task);
 }
@@ -30141,18 +31617,19 @@ void core_tests_pigeon_test_flutter_integration_core_api_echo_map(
     gpointer user_data) {
   g_autoptr(FlValue) args = fl_value_new_list();
   fl_value_append_take(args, fl_value_ref(map));
-  g_autofree gchar* channel_name = g_strdup_printf(
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoMap%s",
-      self->suffix);
-  g_autoptr(CoreTestsPigeonTestMessageCodec) codec =
-      core_tests_pigeon_test_message_codec_new();
-  FlBasicMessageChannel* channel = fl_basic_message_channel_new(
-      self->messenger, channel_name, FL_MESSAGE_CODEC(codec));
+  if (self->echo_map_channel == nullptr) {
+    g_autofree gchar* channel_name = g_strdup_printf(
+        "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
+        "echoMap%s",
+        self->suffix);
+    self->echo_map_channel = fl_basic_message_channel_new(
+        self->messenger, channel_name, FL_MESSAGE_CODEC(self->codec));
+  }
   GTask* task = g_task_new(self, cancellable, callback, user_data);
-  g_task_set_task_data(task, channel, g_object_unref);
+  g_task_set_task_data(task, g_object_ref(self->echo_map_channel),
+                       g_object_unref);
   fl_basic_message_channel_send(
-      channel, args, cancellable,
+      self->echo_map_channel, args, cancellable,
       core_tests_pigeon_test_flutter_integration_core_api_echo_map_cb, task);
 }
 
@@ -30302,18 +31779,19 @@ void core_tests_pigeon_test_flutter_integration_core_api_echo_string_map(
     gpointer user_data) {
   g_autoptr(FlValue) args = fl_value_new_list();
   fl_value_append_take(args, fl_value_ref(string_map));
-  g_autofree gchar* channel_name = g_strdup_printf(
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoStringMap%s",
-      self->suffix);
-  g_autoptr(CoreTestsPigeonTestMessageCodec) codec =
-      core_tests_pigeon_test_message_codec_new();
-  FlBasicMessageChannel* channel = fl_basic_message_channel_new(
-      self->messenger, channel_name, FL_MESSAGE_CODEC(codec));
+  if (self->echo_string_map_channel == nullptr) {
+    g_autofree gchar* channel_name = g_strdup_printf(
+        "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
+        "echoStringMap%s",
+        self->suffix);
+    self->echo_string_map_channel = fl_basic_message_channel_new(
+        self->messenger, channel_name, FL_MESSAGE_CODEC(self->codec));
+  }
   GTask* task = g_task_new(self, cancellable, callback, user_data);
-  g_task_set_task_data(task, channel, g_object_unref);
+  g_task_set_task_data(task, g_object_ref(self->echo_string_map_channel),
+                       g_object_unref);
   fl_basic_message_channel_send(
-      channel, args, cancellable,
+      self->echo_string_map_channel, args, cancellable,
       core_tests_pigeon_test_flutter_integration_core_api_echo_string_map_cb,
       task);
 }
@@ -30463,18 +31941,19 @@ void core_tests_pigeon_test_flutter_integration_core_api_echo_int_map(
     gpointer user_data) {
   g_autoptr(FlValue) args = fl_value_new_list();
   fl_value_append_take(args, fl_value_ref(int_map));
-  g_autofree gchar* channel_name = g_strdup_printf(
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoIntMap%s",
-      self->suffix);
-  g_autoptr(CoreTestsPigeonTestMessageCodec) codec =
-      core_tests_pigeon_test_message_codec_new();
-  FlBasicMessageChannel* channel = fl_basic_message_channel_new(
-      self->messenger, channel_name, FL_MESSAGE_CODEC(codec));
+  if (self->echo_int_map_channel == nullptr) {
+    g_autofree gchar* channel_name = g_strdup_printf(
+        "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
+        "echoIntMap%s",
+        self->suffix);
+    self->echo_int_map_channel = fl_basic_message_channel_new(
+        self->messenger, channel_name, FL_MESSAGE_CODEC(self->codec));
+  }
   GTask* task = g_task_new(self, cancellable, callback, user_data);
-  g_task_set_task_data(task, channel, g_object_unref);
+  g_task_set_task_data(task, g_object_ref(self->echo_int_map_channel),
+                       g_object_unref);
   fl_basic_message_channel_send(
-      channel, args, cancellable,
+      self->echo_int_map_channel, args, cancellable,
       core_tests_pigeon_test_flutter_integration_core_api_echo_int_map_cb,
       task);
 }
@@ -30625,18 +32104,19 @@ void core_tests_pigeon_test_flutter_integration_core_api_echo_enum_map(
     gpointer user_data) {
   g_autoptr(FlValue) args = fl_value_new_list();
   fl_value_append_take(args, fl_value_ref(enum_map));
-  g_autofree gchar* channel_name = g_strdup_printf(
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoEnumMap%s",
-      self->suffix);
-  g_autoptr(CoreTestsPigeonTestMessageCodec) codec =
-      core_tests_pigeon_test_message_codec_new();
-  FlBasicMessageChannel* channel = fl_basic_message_channel_new(
-      self->messenger, channel_name, FL_MESSAGE_CODEC(codec));
+  if (self->echo_enum_map_channel == nullptr) {
+    g_autofree gchar* channel_name = g_strdup_printf(
+        "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
+        "echoEnumMap%s",
+        self->suffix);
+    self->echo_enum_map_channel = fl_basic_message_channel_new(
+        self->messenger, channel_name, FL_MESSAGE_CODEC(self->codec));
+  }
   GTask* task = g_task_new(self, cancellable, callback, user_data);
-  g_task_set_task_data(task, channel, g_object_unref);
+  g_task_set_task_data(task, g_object_ref(self->echo_enum_map_channel),
+                       g_object_unref);
   fl_basic_message_channel_send(
-      channel, args, cancellable,
+      self->echo_enum_map_channel, args, cancellable,
       core_tests_pigeon_test_flutter_integration_core_api_echo_enum_map_cb,
       task);
 }
@@ -30787,18 +32267,19 @@ void core_tests_pigeon_test_flutter_integration_core_api_echo_class_map(
     gpointer user_data) {
   g_autoptr(FlValue) args = fl_value_new_list();
   fl_value_append_take(args, fl_value_ref(class_map));
-  g_autofree gchar* channel_name = g_strdup_printf(
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoClassMap%s",
-      self->suffix);
-  g_autoptr(CoreTestsPigeonTestMessageCodec) codec =
-      core_tests_pigeon_test_message_codec_new();
-  FlBasicMessageChannel* channel = fl_basic_message_channel_new(
-      self->messenger, channel_name, FL_MESSAGE_CODEC(codec));
+  if (self->echo_class_map_channel == nullptr) {
+    g_autofree gchar* channel_name = g_strdup_printf(
+        "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
+        "echoClassMap%s",
+        self->suffix);
+    self->echo_class_map_channel = fl_basic_message_channel_new(
+        self->messenger, channel_name, FL_MESSAGE_CODEC(self->codec));
+  }
   GTask* task = g_task_new(self, cancellable, callback, user_data);
-  g_task_set_task_data(task, channel, g_object_unref);
+  g_task_set_task_data(task, g_object_ref(self->echo_class_map_channel),
+                       g_object_unref);
   fl_basic_message_channel_send(
-      channel, args, cancellable,
+      self->echo_class_map_channel, args, cancellable,
       core_tests_pigeon_test_flutter_integration_core_api_echo_class_map_cb,
       task);
 }
@@ -30956,18 +32437,20 @@ void core_tests_pigeon_test_flutter_integration_core_api_echo_non_null_string_ma
     gpointer user_data) {
   g_autoptr(FlValue) args = fl_value_new_list();
   fl_value_append_take(args, fl_value_ref(string_map));
-  g_autofree gchar* channel_name = g_strdup_printf(
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoNonNullStringMap%s",
-      self->suffix);
-  g_autoptr(CoreTestsPigeonTestMessageCodec) codec =
-      core_tests_pigeon_test_message_codec_new();
-  FlBasicMessageChannel* channel = fl_basic_message_channel_new(
-      self->messenger, channel_name, FL_MESSAGE_CODEC(codec));
+  if (self->echo_non_null_string_map_channel == nullptr) {
+    g_autofree gchar* channel_name = g_strdup_printf(
+        "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
+        "echoNonNullStringMap%s",
+        self->suffix);
+    self->echo_non_null_string_map_channel = fl_basic_message_channel_new(
+        self->messenger, channel_name, FL_MESSAGE_CODEC(self->codec));
+  }
   GTask* task = g_task_new(self, cancellable, callback, user_data);
-  g_task_set_task_data(task, channel, g_object_unref);
+  g_task_set_task_data(task,
+                       g_object_ref(self->echo_non_null_string_map_channel),
+                       g_object_unref);
   fl_basic_message_channel_send(
-      channel, args, cancellable,
+      self->echo_non_null_string_map_channel, args, cancellable,
       core_tests_pigeon_test_flutter_integration_core_api_echo_non_null_string_map_cb,
       task);
 }
@@ -31124,18 +32607,19 @@ void core_tests_pigeon_test_flutter_integration_core_api_echo_non_null_int_map(
     gpointer user_data) {
   g_autoptr(FlValue) args = fl_value_new_list();
   fl_value_append_take(args, fl_value_ref(int_map));
-  g_autofree gchar* channel_name = g_strdup_printf(
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoNonNullIntMap%s",
-      self->suffix);
-  g_autoptr(CoreTestsPigeonTestMessageCodec) codec =
-      core_tests_pigeon_test_message_codec_new();
-  FlBasicMessageChannel* channel = fl_basic_message_channel_new(
-      self->messenger, channel_name, FL_MESSAGE_CODEC(codec));
+  if (self->echo_non_null_int_map_channel == nullptr) {
+    g_autofree gchar* channel_name = g_strdup_printf(
+        "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
+        "echoNonNullIntMap%s",
+        self->suffix);
+    self->echo_non_null_int_map_channel = fl_basic_message_channel_new(
+        self->messenger, channel_name, FL_MESSAGE_CODEC(self->codec));
+  }
   GTask* task = g_task_new(self, cancellable, callback, user_data);
-  g_task_set_task_data(task, channel, g_object_unref);
+  g_task_set_task_data(task, g_object_ref(self->echo_non_null_int_map_channel),
+                       g_object_unref);
   fl_basic_message_channel_send(
-      channel, args, cancellable,
+      self->echo_non_null_int_map_channel, args, cancellable,
       core_tests_pigeon_test_flutter_integration_core_api_echo_non_null_int_map_cb,
       task);
 }
@@ -31292,18 +32776,19 @@ void core_tests_pigeon_test_flutter_integration_core_api_echo_non_null_enum_map(
     gpointer user_data) {
   g_autoptr(FlValue) args = fl_value_new_list();
   fl_value_append_take(args, fl_value_ref(enum_map));
-  g_autofree gchar* channel_name = g_strdup_printf(
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoNonNullEnumMap%s",
-      self->suffix);
-  g_autoptr(CoreTestsPigeonTestMessageCodec) codec =
-      core_tests_pigeon_test_message_codec_new();
-  FlBasicMessageChannel* channel = fl_basic_message_channel_new(
-      self->messenger, channel_name, FL_MESSAGE_CODEC(codec));
+  if (self->echo_non_null_enum_map_channel == nullptr) {
+    g_autofree gchar* channel_name = g_strdup_printf(
+        "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
+        "echoNonNullEnumMap%s",
+        self->suffix);
+    self->echo_non_null_enum_map_channel = fl_basic_message_channel_new(
+        self->messenger, channel_name, FL_MESSAGE_CODEC(self->codec));
+  }
   GTask* task = g_task_new(self, cancellable, callback, user_data);
-  g_task_set_task_data(task, channel, g_object_unref);
+  g_task_set_task_data(task, g_object_ref(self->echo_non_null_enum_map_channel),
+                       g_object_unref);
   fl_basic_message_channel_send(
-      channel, args, cancellable,
+      self->echo_non_null_enum_map_channel, args, cancellable,
       core_tests_pigeon_test_flutter_integration_core_api_echo_non_null_enum_map_cb,
       task);
 }
@@ -31461,18 +32946,20 @@ void core_tests_pigeon_test_flutter_integration_core_api_echo_non_null_class_map
     gpointer user_data) {
   g_autoptr(FlValue) args = fl_value_new_list();
   fl_value_append_take(args, fl_value_ref(class_map));
-  g_autofree gchar* channel_name = g_strdup_printf(
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoNonNullClassMap%s",
-      self->suffix);
-  g_autoptr(CoreTestsPigeonTestMessageCodec) codec =
-      core_tests_pigeon_test_message_codec_new();
-  FlBasicMessageChannel* channel = fl_basic_message_channel_new(
-      self->messenger, channel_name, FL_MESSAGE_CODEC(codec));
+  if (self->echo_non_null_class_map_channel == nullptr) {
+    g_autofree gchar* channel_name = g_strdup_printf(
+        "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
+        "echoNonNullClassMap%s",
+        self->suffix);
+    self->echo_non_null_class_map_channel = fl_basic_message_channel_new(
+        self->messenger, channel_name, FL_MESSAGE_CODEC(self->codec));
+  }
   GTask* task = g_task_new(self, cancellable, callback, user_data);
-  g_task_set_task_data(task, channel, g_object_unref);
+  g_task_set_task_data(task,
+                       g_object_ref(self->echo_non_null_class_map_channel),
+                       g_object_unref);
   fl_basic_message_channel_send(
-      channel, args, cancellable,
+      self->echo_non_null_class_map_channel, args, cancellable,
       core_tests_pigeon_test_flutter_integration_core_api_echo_non_null_class_map_cb,
       task);
 }
@@ -31626,18 +33113,19 @@ void core_tests_pigeon_test_flutter_integration_core_api_echo_enum(
       args, fl_value_new_custom(core_tests_pigeon_test_an_enum_type_id,
                                 fl_value_new_int(an_enum),
                                 (GDestroyNotify)fl_value_unref));
-  g_autofree gchar* channel_name = g_strdup_printf(
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoEnum%s",
-      self->suffix);
-  g_autoptr(CoreTestsPigeonTestMessageCodec) codec =
-      core_tests_pigeon_test_message_codec_new();
-  FlBasicMessageChannel* channel = fl_basic_message_channel_new(
-      self->messenger, channel_name, FL_MESSAGE_CODEC(codec));
+  if (self->echo_enum_channel == nullptr) {
+    g_autofree gchar* channel_name = g_strdup_printf(
+        "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
+        "echoEnum%s",
+        self->suffix);
+    self->echo_enum_channel = fl_basic_message_channel_new(
+        self->messenger, channel_name, FL_MESSAGE_CODEC(self->codec));
+  }
   GTask* task = g_task_new(self, cancellable, callback, user_data);
-  g_task_set_task_data(task, channel, g_object_unref);
+  g_task_set_task_data(task, g_object_ref(self->echo_enum_channel),
+                       g_object_unref);
   fl_basic_message_channel_send(
-      channel, args, cancellable,
+      self->echo_enum_channel, args, cancellable,
       core_tests_pigeon_test_flutter_integration_core_api_echo_enum_cb, task);
 }
 
@@ -31793,18 +33281,19 @@ void core_tests_pigeon_test_flutter_integration_core_api_echo_another_enum(
       args, fl_value_new_custom(core_tests_pigeon_test_another_enum_type_id,
                                 fl_value_new_int(another_enum),
                                 (GDestroyNotify)fl_value_unref));
-  g_autofree gchar* channel_name = g_strdup_printf(
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoAnotherEnum%s",
-      self->suffix);
-  g_autoptr(CoreTestsPigeonTestMessageCodec) codec =
-      core_tests_pigeon_test_message_codec_new();
-  FlBasicMessageChannel* channel = fl_basic_message_channel_new(
-      self->messenger, channel_name, FL_MESSAGE_CODEC(codec));
+  if (self->echo_another_enum_channel == nullptr) {
+    g_autofree gchar* channel_name = g_strdup_printf(
+        "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
+        "echoAnotherEnum%s",
+        self->suffix);
+    self->echo_another_enum_channel = fl_basic_message_channel_new(
+        self->messenger, channel_name, FL_MESSAGE_CODEC(self->codec));
+  }
   GTask* task = g_task_new(self, cancellable, callback, user_data);
-  g_task_set_task_data(task, channel, g_object_unref);
+  g_task_set_task_data(task, g_object_ref(self->echo_another_enum_channel),
+                       g_object_unref);
   fl_basic_message_channel_send(
-      channel, args, cancellable,
+      self->echo_another_enum_channel, args, cancellable,
       core_tests_pigeon_test_flutter_integration_core_api_echo_another_enum_cb,
       task);
 }
@@ -31967,18 +33456,19 @@ void core_tests_pigeon_test_flutter_integration_core_api_echo_nullable_bool(
   g_autoptr(FlValue) args = fl_value_new_list();
   fl_value_append_take(args, a_bool != nullptr ? fl_value_new_bool(*a_bool)
                                                : fl_value_new_null());
-  g_autofree gchar* channel_name = g_strdup_printf(
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoNullableBool%s",
-      self->suffix);
-  g_autoptr(CoreTestsPigeonTestMessageCodec) codec =
-      core_tests_pigeon_test_message_codec_new();
-  FlBasicMessageChannel* channel = fl_basic_message_channel_new(
-      self->messenger, channel_name, FL_MESSAGE_CODEC(codec));
+  if (self->echo_nullable_bool_channel == nullptr) {
+    g_autofree gchar* channel_name = g_strdup_printf(
+        "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
+        "echoNullableBool%s",
+        self->suffix);
+    self->echo_nullable_bool_channel = fl_basic_message_channel_new(
+        self->messenger, channel_name, FL_MESSAGE_CODEC(self->codec));
+  }
   GTask* task = g_task_new(self, cancellable, callback, user_data);
-  g_task_set_task_data(task, channel, g_object_unref);
+  g_task_set_task_data(task, g_object_ref(self->echo_nullable_bool_channel),
+                       g_object_unref);
   fl_basic_message_channel_send(
-      channel, args, cancellable,
+      self->echo_nullable_bool_channel, args, cancellable,
       core_tests_pigeon_test_flutter_integration_core_api_echo_nullable_bool_cb,
       task);
 }
@@ -32136,18 +33626,19 @@ void core_tests_pigeon_test_flutter_integration_core_api_echo_nullable_int(
   g_autoptr(FlValue) args = fl_value_new_list();
   fl_value_append_take(args, an_int != nullptr ? fl_value_new_int(*an_int)
                                                : fl_value_new_null());
-  g_autofree gchar* channel_name = g_strdup_printf(
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoNullableInt%s",
-      self->suffix);
-  g_autoptr(CoreTestsPigeonTestMessageCodec) codec =
-      core_tests_pigeon_test_message_codec_new();
-  FlBasicMessageChannel* channel = fl_basic_message_channel_new(
-      self->messenger, channel_name, FL_MESSAGE_CODEC(codec));
+  if (self->echo_nullable_int_channel == nullptr) {
+    g_autofree gchar* channel_name = g_strdup_printf(
+        "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
+        "echoNullableInt%s",
+        self->suffix);
+    self->echo_nullable_int_channel = fl_basic_message_channel_new(
+        self->messenger, channel_name, FL_MESSAGE_CODEC(self->codec));
+  }
   GTask* task = g_task_new(self, cancellable, callback, user_data);
-  g_task_set_task_data(task, channel, g_object_unref);
+  g_task_set_task_data(task, g_object_ref(self->echo_nullable_int_channel),
+                       g_object_unref);
   fl_basic_message_channel_send(
-      channel, args, cancellable,
+      self->echo_nullable_int_channel, args, cancellable,
       core_tests_pigeon_test_flutter_integration_core_api_echo_nullable_int_cb,
       task);
 }
@@ -32310,18 +33801,19 @@ void core_tests_pigeon_test_flutter_integration_core_api_echo_nullable_double(
   g_autoptr(FlValue) args = fl_value_new_list();
   fl_value_append_take(args, a_double != nullptr ? fl_value_new_float(*a_double)
                                                  : fl_value_new_null());
-  g_autofree gchar* channel_name = g_strdup_printf(
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoNullableDouble%s",
-      self->suffix);
-  g_autoptr(CoreTestsPigeonTestMessageCodec) codec =
-      core_tests_pigeon_test_message_codec_new();
-  FlBasicMessageChannel* channel = fl_basic_message_channel_new(
-      self->messenger, channel_name, FL_MESSAGE_CODEC(codec));
+  if (self->echo_nullable_double_channel == nullptr) {
+    g_autofree gchar* channel_name = g_strdup_printf(
+        "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
+        "echoNullableDouble%s",
+        self->suffix);
+    self->echo_nullable_double_channel = fl_basic_message_channel_new(
+        self->messenger, channel_name, FL_MESSAGE_CODEC(self->codec));
+  }
   GTask* task = g_task_new(self, cancellable, callback, user_data);
-  g_task_set_task_data(task, channel, g_object_unref);
+  g_task_set_task_data(task, g_object_ref(self->echo_nullable_double_channel),
+                       g_object_unref);
   fl_basic_message_channel_send(
-      channel, args, cancellable,
+      self->echo_nullable_double_channel, args, cancellable,
       core_tests_pigeon_test_flutter_integration_core_api_echo_nullable_double_cb,
       task);
 }
@@ -32482,18 +33974,19 @@ void core_tests_pigeon_test_flutter_integration_core_api_echo_nullable_string(
   g_autoptr(FlValue) args = fl_value_new_list();
   fl_value_append_take(args, a_string != nullptr ? fl_value_new_string(a_string)
                                                  : fl_value_new_null());
-  g_autofree gchar* channel_name = g_strdup_printf(
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoNullableString%s",
-      self->suffix);
-  g_autoptr(CoreTestsPigeonTestMessageCodec) codec =
-      core_tests_pigeon_test_message_codec_new();
-  FlBasicMessageChannel* channel = fl_basic_message_channel_new(
-      self->messenger, channel_name, FL_MESSAGE_CODEC(codec));
+  if (self->echo_nullable_string_channel == nullptr) {
+    g_autofree gchar* channel_name = g_strdup_printf(
+        "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
+        "echoNullableString%s",
+        self->suffix);
+    self->echo_nullable_string_channel = fl_basic_message_channel_new(
+        self->messenger, channel_name, FL_MESSAGE_CODEC(self->codec));
+  }
   GTask* task = g_task_new(self, cancellable, callback, user_data);
-  g_task_set_task_data(task, channel, g_object_unref);
+  g_task_set_task_data(task, g_object_ref(self->echo_nullable_string_channel),
+                       g_object_unref);
   fl_basic_message_channel_send(
-      channel, args, cancellable,
+      self->echo_nullable_string_channel, args, cancellable,
       core_tests_pigeon_test_flutter_integration_core_api_echo_nullable_string_cb,
       task);
 }
@@ -32642,7 +34135,8 @@ core_tests_pigeon_test_flutter_integration_core_api_echo_nullable_uint8_list_res
   if (return_value_length != nullptr) {
     *return_value_length = fl_value_get_length(self->return_value);
   }
-  return fl_value_get_uint8_list(self->return_value);
+  return static_cast<const uint8_t*>(
+      flpigeon_get_typed_list_data(fl_value_get_uint8_list(self->return_value)));
 }
 
 static void
@@ -32660,18 +34154,20 @@ void core_tests_pigeon_test_flutter_integration_core_api_echo_nullable_uint8_lis
   fl_value_append_take(args, list != nullptr
                                  ? fl_value_new_uint8_list(list, list_length)
                                  : fl_value_new_null());
-  g_autofree gchar* channel_name = g_strdup_printf(
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoNullableUint8List%s",
-      self->suffix);
-  g_autoptr(CoreTestsPigeonTestMessageCodec) codec =
-      core_tests_pigeon_test_message_codec_new();
-  FlBasicMessageChannel* channel = fl_basic_message_channel_new(
-      self->messenger, channel_name, FL_MESSAGE_CODEC(codec));
+  if (self->echo_nullable_uint8_list_channel == nullptr) {
+    g_autofree gchar* channel_name = g_strdup_printf(
+        "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
+        "echoNullableUint8List%s",
+        self->suffix);
+    self->echo_nullable_uint8_list_channel = fl_basic_message_channel_new(
+        self->messenger, channel_name, FL_MESSAGE_CODEC(self->codec));
+  }
   GTask* task = g_task_new(self, cancellable, callback, user_data);
-  g_task_set_task_data(task, channel, g_object_unref);
+  g_task_set_task_data(task,
+                       g_object_ref(self->echo_nullable_uint8_list_channel),
+                       g_object_unref);
   fl_basic_message_channel_send(
-      channel, args, cancellable,
+      self->echo_nullable_uint8_list_channel, args, cancellable,
       core_tests_pigeon_test_flutter_integration_core_api_echo_nullable_uint8_list_cb,
       task);
 }
@@ -32832,18 +34328,19 @@ void core_tests_pigeon_test_flutter_integration_core_api_echo_nullable_list(
   g_autoptr(FlValue) args = fl_value_new_list();
   fl_value_append_take(
       args, list != nullptr ? fl_value_ref(list) : fl_value_new_null());
-  g_autofree gchar* channel_name = g_strdup_printf(
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoNullableList%s",
-      self->suffix);
-  g_autoptr(CoreTestsPigeonTestMessageCodec) codec =
-      core_tests_pigeon_test_message_codec_new();
-  FlBasicMessageChannel* channel = fl_basic_message_channel_new(
-      self->messenger, channel_name, FL_MESSAGE_CODEC(codec));
+  if (self->echo_nullable_list_channel == nullptr) {
+    g_autofree gchar* channel_name = g_strdup_printf(
+        "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
+        "echoNullableList%s",
+        self->suffix);
+    self->echo_nullable_list_channel = fl_basic_message_channel_new(
+        self->messenger, channel_name, FL_MESSAGE_CODEC(self->codec));
+  }
   GTask* task = g_task_new(self, cancellable, callback, user_data);
-  g_task_set_task_data(task, channel, g_object_unref);
+  g_task_set_task_data(task, g_object_ref(self->echo_nullable_list_channel),
+                       g_object_unref);
   fl_basic_message_channel_send(
-      channel, args, cancellable,
+      self->echo_nullable_list_channel, args, cancellable,
       core_tests_pigeon_test_flutter_integration_core_api_echo_nullable_list_cb,
       task);
 }
@@ -33005,18 +34502,20 @@ void core_tests_pigeon_test_flutter_integration_core_api_echo_nullable_enum_list
   g_autoptr(FlValue) args = fl_value_new_list();
   fl_value_append_take(args, enum_list != nullptr ? fl_value_ref(enum_list)
                                                   : fl_value_new_null());
-  g_autofree gchar* channel_name = g_strdup_printf(
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoNullableEnumList%s",
-      self->suffix);
-  g_autoptr(CoreTestsPigeonTestMessageCodec) codec =
-      core_tests_pigeon_test_message_codec_new();
-  FlBasicMessageChannel* channel = fl_basic_message_channel_new(
-      self->messenger, channel_name, FL_MESSAGE_CODEC(codec));
+  if (self->echo_nullable_enum_list_channel == nullptr) {
+    g_autofree gchar* channel_name = g_strdup_printf(
+        "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
+        "echoNullableEnumList%s",
+        self->suffix);
+    self->echo_nullable_enum_list_channel = fl_basic_message_channel_new(
+        self->messenger, channel_name, FL_MESSAGE_CODEC(self->codec));
+  }
   GTask* task = g_task_new(self, cancellable, callback, user_data);
-  g_task_set_task_data(task, channel, g_object_unref);
+  g_task_set_task_data(task,
+                       g_object_ref(self->echo_nullable_enum_list_channel),
+                       g_object_unref);
   fl_basic_message_channel_send(
-      channel, args, cancellable,
+      self->echo_nullable_enum_list_channel, args, cancellable,
       core_tests_pigeon_test_flutter_integration_core_api_echo_nullable_enum_list_cb,
       task);
 }
@@ -33178,18 +34677,20 @@ void core_tests_pigeon_test_flutter_integration_core_api_echo_nullable_class_lis
   g_autoptr(FlValue) args = fl_value_new_list();
   fl_value_append_take(args, class_list != nullptr ? fl_value_ref(class_list)
                                                    : fl_value_new_null());
-  g_autofree gchar* channel_name = g_strdup_printf(
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoNullableClassList%s",
-      self->suffix);
-  g_autoptr(CoreTestsPigeonTestMessageCodec) codec =
-      core_tests_pigeon_test_message_codec_new();
-  FlBasicMessageChannel* channel = fl_basic_message_channel_new(
-      self->messenger, channel_name, FL_MESSAGE_CODEC(codec));
+  if (self->echo_nullable_class_list_channel == nullptr) {
+    g_autofree gchar* channel_name = g_strdup_printf(
+        "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
+        "echoNullableClassList%s",
+        self->suffix);
+    self->echo_nullable_class_list_channel = fl_basic_message_channel_new(
+        self->messenger, channel_name, FL_MESSAGE_CODEC(self->codec));
+  }
   GTask* task = g_task_new(self, cancellable, callback, user_data);
-  g_task_set_task_data(task, channel, g_object_unref);
+  g_task_set_task_data(task,
+                       g_object_ref(self->echo_nullable_class_list_channel),
+                       g_object_unref);
   fl_basic_message_channel_send(
-      channel, args, cancellable,
+      self->echo_nullable_class_list_channel, args, cancellable,
       core_tests_pigeon_test_flutter_integration_core_api_echo_nullable_class_list_cb,
       task);
 }
@@ -33352,18 +34853,21 @@ void core_tests_pigeon_test_flutter_integration_core_api_echo_nullable_non_null_
   g_autoptr(FlValue) args = fl_value_new_list();
   fl_value_append_take(args, enum_list != nullptr ? fl_value_ref(enum_list)
                                                   : fl_value_new_null());
-  g_autofree gchar* channel_name = g_strdup_printf(
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoNullableNonNullEnumList%s",
-      self->suffix);
-  g_autoptr(CoreTestsPigeonTestMessageCodec) codec =
-      core_tests_pigeon_test_message_codec_new();
-  FlBasicMessageChannel* channel = fl_basic_message_channel_new(
-      self->messenger, channel_name, FL_MESSAGE_CODEC(codec));
+  if (self->echo_nullable_non_null_enum_list_channel == nullptr) {
+    g_autofree gchar* channel_name = g_strdup_printf(
+        "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
+        "echoNullableNonNullEnumList%s",
+        self->suffix);
+    self->echo_nullable_non_null_enum_list_channel =
+        fl_basic_message_channel_new(self->messenger, channel_name,
+                                     FL_MESSAGE_CODEC(self->codec));
+  }
   GTask* task = g_task_new(self, cancellable, callback, user_data);
-  g_task_set_task_data(task, channel, g_object_unref);
+  g_task_set_task_data(
+      task, g_object_ref(self->echo_nullable_non_null_enum_list_channel),
+      g_object_unref);
   fl_basic_message_channel_send(
-      channel, args, cancellable,
+      self->echo_nullable_non_null_enum_list_channel, args, cancellable,
       core_tests_pigeon_test_flutter_integration_core_api_echo_nullable_non_null_enum_list_cb,
       task);
 }
@@ -33526,18 +35030,21 @@ void core_tests_pigeon_test_flutter_integration_core_api_echo_nullable_non_null_
   g_autoptr(FlValue) args = fl_value_new_list();
   fl_value_append_take(args, class_list != nullptr ? fl_value_ref(class_list)
                                                    : fl_value_new_null());
-  g_autofree gchar* channel_name = g_strdup_printf(
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoNullableNonNullClassList%s",
-      self->suffix);
-  g_autoptr(CoreTestsPigeonTestMessageCodec) codec =
-      core_tests_pigeon_test_message_codec_new();
-  FlBasicMessageChannel* channel = fl_basic_message_channel_new(
-      self->messenger, channel_name, FL_MESSAGE_CODEC(codec));
+  if (self->echo_nullable_non_null_class_list_channel == nullptr) {
+    g_autofree gchar* channel_name = g_strdup_printf(
+        "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
+        "echoNullableNonNullClassList%s",
+        self->suffix);
+    self->echo_nullable_non_null_class_list_channel =
+        fl_basic_message_channel_new(self->messenger, channel_name,
+                                     FL_MESSAGE_CODEC(self->codec));
+  }
   GTask* task = g_task_new(self, cancellable, callback, user_data);
-  g_task_set_task_data(task, channel, g_object_unref);
+  g_task_set_task_data(
+      task, g_object_ref(self->echo_nullable_non_null_class_list_channel),
+      g_object_unref);
   fl_basic_message_channel_send(
-      channel, args, cancellable,
+      self->echo_nullable_non_null_class_list_channel, args, cancellable,
       core_tests_pigeon_test_flutter_integration_core_api_echo_nullable_non_null_class_list_cb,
       task);
 }
@@ -33693,18 +35200,19 @@ void core_tests_pigeon_test_flutter_integration_core_api_echo_nullable_map(
   g_autoptr(FlValue) args = fl_value_new_list();
   fl_value_append_take(
       args, map != nullptr ? fl_value_ref(map) : fl_value_new_null());
-  g_autofree gchar* channel_name = g_strdup_printf(
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoNullableMap%s",
-      self->suffix);
-  g_autoptr(CoreTestsPigeonTestMessageCodec) codec =
-      core_tests_pigeon_test_message_codec_new();
-  FlBasicMessageChannel* channel = fl_basic_message_channel_new(
-      self->messenger, channel_name, FL_MESSAGE_CODEC(codec));
+  if (self->echo_nullable_map_channel == nullptr) {
+    g_autofree gchar* channel_name = g_strdup_printf(
+        "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
+        "echoNullableMap%s",
+        self->suffix);
+    self->echo_nullable_map_channel = fl_basic_message_channel_new(
+        self->messenger, channel_name, FL_MESSAGE_CODEC(self->codec));
+  }
   GTask* task = g_task_new(self, cancellable, callback, user_data);
-  g_task_set_task_data(task, channel, g_object_unref);
+  g_task_set_task_data(task, g_object_ref(self->echo_nullable_map_channel),
+                       g_object_unref);
   fl_basic_message_channel_send(
-      channel, args, cancellable,
+      self->echo_nullable_map_channel, args, cancellable,
       core_tests_pigeon_test_flutter_integration_core_api_echo_nullable_map_cb,
       task);
 }
@@ -33866,18 +35374,20 @@ void core_tests_pigeon_test_flutter_integration_core_api_echo_nullable_string_ma
   g_autoptr(FlValue) args = fl_value_new_list();
   fl_value_append_take(args, string_map != nullptr ? fl_value_ref(string_map)
                                                    : fl_value_new_null());
-  g_autofree gchar* channel_name = g_strdup_printf(
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoNullableStringMap%s",
-      self->suffix);
-  g_autoptr(CoreTestsPigeonTestMessageCodec) codec =
-      core_tests_pigeon_test_message_codec_new();
-  FlBasicMessageChannel* channel = fl_basic_message_channel_new(
-      self->messenger, channel_name, FL_MESSAGE_CODEC(codec));
+  if (self->echo_nullable_string_map_channel == nullptr) {
+    g_autofree gchar* channel_name = g_strdup_printf(
+        "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
+        "echoNullableStringMap%s",
+        self->suffix);
+    self->echo_nullable_string_map_channel = fl_basic_message_channel_new(
+        self->messenger, channel_name, FL_MESSAGE_CODEC(self->codec));
+  }
   GTask* task = g_task_new(self, cancellable, callback, user_data);
-  g_task_set_task_data(task, channel, g_object_unref);
+  g_task_set_task_data(task,
+                       g_object_ref(self->echo_nullable_string_map_channel),
+                       g_object_unref);
   fl_basic_message_channel_send(
-      channel, args, cancellable,
+      self->echo_nullable_string_map_channel, args, cancellable,
       core_tests_pigeon_test_flutter_integration_core_api_echo_nullable_string_map_cb,
       task);
 }
@@ -34038,18 +35548,19 @@ void core_tests_pigeon_test_flutter_integration_core_api_echo_nullable_int_map(
   g_autoptr(FlValue) args = fl_value_new_list();
   fl_value_append_take(
       args, int_map != nullptr ? fl_value_ref(int_map) : fl_value_new_null());
-  g_autofree gchar* channel_name = g_strdup_printf(
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoNullableIntMap%s",
-      self->suffix);
-  g_autoptr(CoreTestsPigeonTestMessageCodec) codec =
-      core_tests_pigeon_test_message_codec_new();
-  FlBasicMessageChannel* channel = fl_basic_message_channel_new(
-      self->messenger, channel_name, FL_MESSAGE_CODEC(codec));
+  if (self->echo_nullable_int_map_channel == nullptr) {
+    g_autofree gchar* channel_name = g_strdup_printf(
+        "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
+        "echoNullableIntMap%s",
+        self->suffix);
+    self->echo_nullable_int_map_channel = fl_basic_message_channel_new(
+        self->messenger, channel_name, FL_MESSAGE_CODEC(self->codec));
+  }
   GTask* task = g_task_new(self, cancellable, callback, user_data);
-  g_task_set_task_data(task, channel, g_object_unref);
+  g_task_set_task_data(task, g_object_ref(self->echo_nullable_int_map_channel),
+                       g_object_unref);
   fl_basic_message_channel_send(
-      channel, args, cancellable,
+      self->echo_nullable_int_map_channel, args, cancellable,
       core_tests_pigeon_test_flutter_integration_core_api_echo_nullable_int_map_cb,
       task);
 }
@@ -34211,18 +35722,19 @@ void core_tests_pigeon_test_flutter_integration_core_api_echo_nullable_enum_map(
   g_autoptr(FlValue) args = fl_value_new_list();
   fl_value_append_take(
       args, enum_map != nullptr ? fl_value_ref(enum_map) : fl_value_new_null());
-  g_autofree gchar* channel_name = g_strdup_printf(
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoNullableEnumMap%s",
-      self->suffix);
-  g_autoptr(CoreTestsPigeonTestMessageCodec) codec =
-      core_tests_pigeon_test_message_codec_new();
-  FlBasicMessageChannel* channel = fl_basic_message_channel_new(
-      self->messenger, channel_name, FL_MESSAGE_CODEC(codec));
+  if (self->echo_nullable_enum_map_channel == nullptr) {
+    g_autofree gchar* channel_name = g_strdup_printf(
+        "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
+        "echoNullableEnumMap%s",
+        self->suffix);
+    self->echo_nullable_enum_map_channel = fl_basic_message_channel_new(
+        self->messenger, channel_name, FL_MESSAGE_CODEC(self->codec));
+  }
   GTask* task = g_task_new(self, cancellable, callback, user_data);
-  g_task_set_task_data(task, channel, g_object_unref);
+  g_task_set_task_data(task, g_object_ref(self->echo_nullable_enum_map_channel),
+                       g_object_unref);
   fl_basic_message_channel_send(
-      channel, args, cancellable,
+      self->echo_nullable_enum_map_channel, args, cancellable,
       core_tests_pigeon_test_flutter_integration_core_api_echo_nullable_enum_map_cb,
       task);
 }
@@ -34384,18 +35896,20 @@ void core_tests_pigeon_test_flutter_integration_core_api_echo_nullable_class_map
   g_autoptr(FlValue) args = fl_value_new_list();
   fl_value_append_take(args, class_map != nullptr ? fl_value_ref(class_map)
                                                   : fl_value_new_null());
-  g_autofree gchar* channel_name = g_strdup_printf(
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoNullableClassMap%s",
-      self->suffix);
-  g_autoptr(CoreTestsPigeonTestMessageCodec) codec =
-      core_tests_pigeon_test_message_codec_new();
-  FlBasicMessageChannel* channel = fl_basic_message_channel_new(
-      self->messenger, channel_name, FL_MESSAGE_CODEC(codec));
+  if (self->echo_nullable_class_map_channel == nullptr) {
+    g_autofree gchar* channel_name = g_strdup_printf(
+        "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
+        "echoNullableClassMap%s",
+        self->suffix);
+    self->echo_nullable_class_map_channel = fl_basic_message_channel_new(
+        self->messenger, channel_name, FL_MESSAGE_CODEC(self->codec));
+  }
   GTask* task = g_task_new(self, cancellable, callback, user_data);
-  g_task_set_task_data(task, channel, g_object_unref);
+  g_task_set_task_data(task,
+                       g_object_ref(self->echo_nullable_class_map_channel),
+                       g_object_unref);
   fl_basic_message_channel_send(
-      channel, args, cancellable,
+      self->echo_nullable_class_map_channel, args, cancellable,
       core_tests_pigeon_test_flutter_integration_core_api_echo_nullable_class_map_cb,
       task);
 }
@@ -34558,18 +36072,21 @@ void core_tests_pigeon_test_flutter_integration_core_api_echo_nullable_non_null_
   g_autoptr(FlValue) args = fl_value_new_list();
   fl_value_append_take(args, string_map != nullptr ? fl_value_ref(string_map)
                                                    : fl_value_new_null());
-  g_autofree gchar* channel_name = g_strdup_printf(
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoNullableNonNullStringMap%s",
-      self->suffix);
-  g_autoptr(CoreTestsPigeonTestMessageCodec) codec =
-      core_tests_pigeon_test_message_codec_new();
-  FlBasicMessageChannel* channel = fl_basic_message_channel_new(
-      self->messenger, channel_name, FL_MESSAGE_CODEC(codec));
+  if (self->echo_nullable_non_null_string_map_channel == nullptr) {
+    g_autofree gchar* channel_name = g_strdup_printf(
+        "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
+        "echoNullableNonNullStringMap%s",
+        self->suffix);
+    self->echo_nullable_non_null_string_map_channel =
+        fl_basic_message_channel_new(self->messenger, channel_name,
+                                     FL_MESSAGE_CODEC(self->codec));
+  }
   GTask* task = g_task_new(self, cancellable, callback, user_data);
-  g_task_set_task_data(task, channel, g_object_unref);
+  g_task_set_task_data(
+      task, g_object_ref(self->echo_nullable_non_null_string_map_channel),
+      g_object_unref);
   fl_basic_message_channel_send(
-      channel, args, cancellable,
+      self->echo_nullable_non_null_string_map_channel, args, cancellable,
       core_tests_pigeon_test_flutter_integration_core_api_echo_nullable_non_null_string_map_cb,
       task);
 }
@@ -34732,18 +36249,20 @@ void core_tests_pigeon_test_flutter_integration_core_api_echo_nullable_non_null_
   g_autoptr(FlValue) args = fl_value_new_list();
   fl_value_append_take(
       args, int_map != nullptr ? fl_value_ref(int_map) : fl_value_new_null());
-  g_autofree gchar* channel_name = g_strdup_printf(
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoNullableNonNullIntMap%s",
-      self->suffix);
-  g_autoptr(CoreTestsPigeonTestMessageCodec) codec =
-      core_tests_pigeon_test_message_codec_new();
-  FlBasicMessageChannel* channel = fl_basic_message_channel_new(
-      self->messenger, channel_name, FL_MESSAGE_CODEC(codec));
+  if (self->echo_nullable_non_null_int_map_channel == nullptr) {
+    g_autofree gchar* channel_name = g_strdup_printf(
+        "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
+        "echoNullableNonNullIntMap%s",
+        self->suffix);
+    self->echo_nullable_non_null_int_map_channel = fl_basic_message_channel_new(
+        self->messenger, channel_name, FL_MESSAGE_CODEC(self->codec));
+  }
   GTask* task = g_task_new(self, cancellable, callback, user_data);
-  g_task_set_task_data(task, channel, g_object_unref);
+  g_task_set_task_data(
+      task, g_object_ref(self->echo_nullable_non_null_int_map_channel),
+      g_object_unref);
   fl_basic_message_channel_send(
-      channel, args, cancellable,
+      self->echo_nullable_non_null_int_map_channel, args, cancellable,
       core_tests_pigeon_test_flutter_integration_core_api_echo_nullable_non_null_int_map_cb,
       task);
 }
@@ -34906,18 +36425,21 @@ void core_tests_pigeon_test_flutter_integration_core_api_echo_nullable_non_null_
   g_autoptr(FlValue) args = fl_value_new_list();
   fl_value_append_take(
       args, enum_map != nullptr ? fl_value_ref(enum_map) : fl_value_new_null());
-  g_autofree gchar* channel_name = g_strdup_printf(
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoNullableNonNullEnumMap%s",
-      self->suffix);
-  g_autoptr(CoreTestsPigeonTestMessageCodec) codec =
-      core_tests_pigeon_test_message_codec_new();
-  FlBasicMessageChannel* channel = fl_basic_message_channel_new(
-      self->messenger, channel_name, FL_MESSAGE_CODEC(codec));
+  if (self->echo_nullable_non_null_enum_map_channel == nullptr) {
+    g_autofree gchar* channel_name = g_strdup_printf(
+        "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
+        "echoNullableNonNullEnumMap%s",
+        self->suffix);
+    self->echo_nullable_non_null_enum_map_channel =
+        fl_basic_message_channel_new(self->messenger, channel_name,
+                                     FL_MESSAGE_CODEC(self->codec));
+  }
   GTask* task = g_task_new(self, cancellable, callback, user_data);
-  g_task_set_task_data(task, channel, g_object_unref);
+  g_task_set_task_data(
+      task, g_object_ref(self->echo_nullable_non_null_enum_map_channel),
+      g_object_unref);
   fl_basic_message_channel_send(
-      channel, args, cancellable,
+      self->echo_nullable_non_null_enum_map_channel, args, cancellable,
       core_tests_pigeon_test_flutter_integration_core_api_echo_nullable_non_null_enum_map_cb,
       task);
 }
@@ -35080,18 +36602,21 @@ void core_tests_pigeon_test_flutter_integration_core_api_echo_nullable_non_null_
   g_autoptr(FlValue) args = fl_value_new_list();
   fl_value_append_take(args, class_map != nullptr ? fl_value_ref(class_map)
                                                   : fl_value_new_null());
-  g_autofree gchar* channel_name = g_strdup_printf(
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoNullableNonNullClassMap%s",
-      self->suffix);
-  g_autoptr(CoreTestsPigeonTestMessageCodec) codec =
-      core_tests_pigeon_test_message_codec_new();
-  FlBasicMessageChannel* channel = fl_basic_message_channel_new(
-      self->messenger, channel_name, FL_MESSAGE_CODEC(codec));
+  if (self->echo_nullable_non_null_class_map_channel == nullptr) {
+    g_autofree gchar* channel_name = g_strdup_printf(
+        "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
+        "echoNullableNonNullClassMap%s",
+        self->suffix);
+    self->echo_nullable_non_null_class_map_channel =
+        fl_basic_message_channel_new(self->messenger, channel_name,
+                                     FL_MESSAGE_CODEC(self->codec));
+  }
   GTask* task = g_task_new(self, cancellable, callback, user_data);
-  g_task_set_task_data(task, channel, g_object_unref);
+  g_task_set_task_data(
+      task, g_object_ref(self->echo_nullable_non_null_class_map_channel),
+      g_object_unref);
   fl_basic_message_channel_send(
-      channel, args, cancellable,
+      self->echo_nullable_non_null_class_map_channel, args, cancellable,
       core_tests_pigeon_test_flutter_integration_core_api_echo_nullable_non_null_class_map_cb,
       task);
 }
@@ -35260,18 +36785,19 @@ void core_tests_pigeon_test_flutter_integration_core_api_echo_nullable_enum(
                                       fl_value_new_int(*an_enum),
                                       (GDestroyNotify)fl_value_unref)
                 : fl_value_new_null());
-  g_autofree gchar* channel_name = g_strdup_printf(
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoNullableEnum%s",
-      self->suffix);
-  g_autoptr(CoreTestsPigeonTestMessageCodec) codec =
-      core_tests_pigeon_test_message_codec_new();
-  FlBasicMessageChannel* channel = fl_basic_message_channel_new(
-      self->messenger, channel_name, FL_MESSAGE_CODEC(codec));
+  if (self->echo_nullable_enum_channel == nullptr) {
+    g_autofree gchar* channel_name = g_strdup_printf(
+        "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
+        "echoNullableEnum%s",
+        self->suffix);
+    self->echo_nullable_enum_channel = fl_basic_message_channel_new(
+        self->messenger, channel_name, FL_MESSAGE_CODEC(self->codec));
+  }
   GTask* task = g_task_new(self, cancellable, callback, user_data);
-  g_task_set_task_data(task, channel, g_object_unref);
+  g_task_set_task_data(task, g_object_ref(self->echo_nullable_enum_channel),
+                       g_object_unref);
   fl_basic_message_channel_send(
-      channel, args, cancellable,
+      self->echo_nullable_enum_channel, args, cancellable,
       core_tests_pigeon_test_flutter_integration_core_api_echo_nullable_enum_cb,
       task);
 }
@@ -35442,18 +36968,20 @@ void core_tests_pigeon_test_flutter_integration_core_api_echo_another_nullable_e
                                 fl_value_new_int(*another_enum),
                                 (GDestroyNotify)fl_value_unref)
           : fl_value_new_null());
-  g_autofree gchar* channel_name = g_strdup_printf(
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoAnotherNullableEnum%s",
-      self->suffix);
-  g_autoptr(CoreTestsPigeonTestMessageCodec) codec =
-      core_tests_pigeon_test_message_codec_new();
-  FlBasicMessageChannel* channel = fl_basic_message_channel_new(
-      self->messenger, channel_name, FL_MESSAGE_CODEC(codec));
+  if (self->echo_another_nullable_enum_channel == nullptr) {
+    g_autofree gchar* channel_name = g_strdup_printf(
+        "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
+        "echoAnotherNullableEnum%s",
+        self->suffix);
+    self->echo_another_nullable_enum_channel = fl_basic_message_channel_new(
+        self->messenger, channel_name, FL_MESSAGE_CODEC(self->codec));
+  }
   GTask* task = g_task_new(self, cancellable, callback, user_data);
-  g_task_set_task_data(task, channel, g_object_unref);
+  g_task_set_task_data(task,
+                       g_object_ref(self->echo_another_nullable_enum_channel),
+                       g_object_unref);
   fl_basic_message_channel_send(
-      channel, args, cancellable,
+      self->echo_another_nullable_enum_channel, args, cancellable,
       core_tests_pigeon_test_flutter_integration_core_api_echo_another_nullable_enum_cb,
       task);
 }
@@ -35583,18 +37111,19 @@ void core_tests_pigeon_test_flutter_integration_core_api_noop_async(
     GCancellable* cancellable, GAsyncReadyCallback callback,
     gpointer user_data) {
   g_autoptr(FlValue) args = fl_value_new_list();
-  g_autofree gchar* channel_name = g_strdup_printf(
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "noopAsync%s",
-      self->suffix);
-  g_autoptr(CoreTestsPigeonTestMessageCodec) codec =
-      core_tests_pigeon_test_message_codec_new();
-  FlBasicMessageChannel* channel = fl_basic_message_channel_new(
-      self->messenger, channel_name, FL_MESSAGE_CODEC(codec));
+  if (self->noop_async_channel == nullptr) {
+    g_autofree gchar* channel_name = g_strdup_printf(
+        "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
+        "noopAsync%s",
+        self->suffix);
+    self->noop_async_channel = fl_basic_message_channel_new(
+        self->messenger, channel_name, FL_MESSAGE_CODEC(self->codec));
+  }
   GTask* task = g_task_new(self, cancellable, callback, user_data);
-  g_task_set_task_data(task, channel, g_object_unref);
+  g_task_set_task_data(task, g_object_ref(self->noop_async_channel),
+                       g_object_unref);
   fl_basic_message_channel_send(
-      channel, args, cancellable,
+      self->noop_async_channel, args, cancellable,
       core_tests_pigeon_test_flutter_integration_core_api_noop_async_cb, task);
 }
 
@@ -35745,18 +37274,19 @@ void core_tests_pigeon_test_flutter_integration_core_api_echo_async_string(
     gpointer user_data) {
   g_autoptr(FlValue) args = fl_value_new_list();
   fl_value_append_take(args, fl_value_new_string(a_string));
-  g_autofree gchar* channel_name = g_strdup_printf(
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoAsyncString%s",
-      self->suffix);
-  g_autoptr(CoreTestsPigeonTestMessageCodec) codec =
-      core_tests_pigeon_test_message_codec_new();
-  FlBasicMessageChannel* channel = fl_basic_message_channel_new(
-      self->messenger, channel_name, FL_MESSAGE_CODEC(codec));
+  if (self->echo_async_string_channel == nullptr) {
+    g_autofree gchar* channel_name = g_strdup_printf(
+        "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
+        "echoAsyncString%s",
+        self->suffix);
+    self->echo_async_string_channel = fl_basic_message_channel_new(
+        self->messenger, channel_name, FL_MESSAGE_CODEC(self->codec));
+  }
   GTask* task = g_task_new(self, cancellable, callback, user_data);
-  g_task_set_task_data(task, channel, g_object_unref);
+  g_task_set_task_data(task, g_object_ref(self->echo_async_string_channel),
+                       g_object_unref);
   fl_basic_message_channel_send(
-      channel, args, cancellable,
+      self->echo_async_string_channel, args, cancellable,
       core_tests_pigeon_test_flutter_integration_core_api_echo_async_string_cb,
       task);
 }
@@ -35848,7 +37378,7 @@ G_DEFINE_TYPE(CoreTestsPigeonTestHostTrivialApi,
 static void core_tests_pigeon_test_host_trivial_api_dispose(GObject* object) {
   CoreTestsPigeonTestHostTrivialApi* self =
       CORE_TESTS_PIGEON_TEST_HOST_TRIVIAL_API(object);
-  if (self->user_data != nullptr) {
+  if (self->user_data != nullptr && self->user_data_free_func != nullptr) {
     self->user_data_free_func(self->user_data);
   }
   self->user_data = nullptr;
@@ -36123,7 +37653,7 @@ G_DEFINE_TYPE(CoreTestsPigeonTestHostSmallApi,
 static void core_tests_pigeon_test_host_small_api_dispose(GObject* object) {
   CoreTestsPigeonTestHostSmallApi* self =
       CORE_TESTS_PIGEON_TEST_HOST_SMALL_API(object);
-  if (self->user_data != nullptr) {
+  if (self->user_data != nullptr && self->user_data_free_func != nullptr) {
     self->user_data_free_func(self->user_data);
   }
   self->user_data = nullptr;
@@ -36303,6 +37833,11 @@ struct _CoreTestsPigeonTestFlutterSmallApi {
 
   FlBinaryMessenger* messenger;
   gchar* suffix;
+  CoreTestsPigeonTestMessageCodec* codec;
+
+  // The channel of each method, created on its first call.
+  FlBasicMessageChannel* echo_wrapped_list_channel;
+  FlBasicMessageChannel* echo_string_channel;
 };
 
 G_DEFINE_TYPE(CoreTestsPigeonTestFlutterSmallApi,
@@ -36313,6 +37848,9 @@ static void core_tests_pigeon_test_flutter_small_api_dispose(GObject* object) {
       CORE_TESTS_PIGEON_TEST_FLUTTER_SMALL_API(object);
   g_clear_object(&self->messenger);
   g_clear_pointer(&self->suffix, g_free);
+  g_clear_object(&self->codec);
+  g_clear_object(&self->echo_wrapped_list_channel);
+  g_clear_object(&self->echo_string_channel);
   G_OBJECT_CLASS(core_tests_pigeon_test_flutter_small_api_parent_class)
       ->dispose(object);
 }
@@ -36335,6 +37873,7 @@ core_tests_pigeon_test_flutter_small_api_new(FlBinaryMessenger* messenger,
   self->messenger = FL_BINARY_MESSENGER(g_object_ref(messenger));
   self->suffix =
       suffix != nullptr ? g_strdup_printf(".%s", suffix) : g_strdup("");
+  self->codec = core_tests_pigeon_test_message_codec_new();
   return self;
 }
 
@@ -36467,18 +38006,19 @@ void core_tests_pigeon_test_flutter_small_api_echo_wrapped_list(
   fl_value_append_take(
       args, fl_value_new_custom_object(
                 core_tests_pigeon_test_test_message_type_id, G_OBJECT(msg)));
-  g_autofree gchar* channel_name = g_strdup_printf(
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterSmallApi."
-      "echoWrappedList%s",
-      self->suffix);
-  g_autoptr(CoreTestsPigeonTestMessageCodec) codec =
-      core_tests_pigeon_test_message_codec_new();
-  FlBasicMessageChannel* channel = fl_basic_message_channel_new(
-      self->messenger, channel_name, FL_MESSAGE_CODEC(codec));
+  if (self->echo_wrapped_list_channel == nullptr) {
+    g_autofree gchar* channel_name = g_strdup_printf(
+        "dev.flutter.pigeon.pigeon_integration_tests.FlutterSmallApi."
+        "echoWrappedList%s",
+        self->suffix);
+    self->echo_wrapped_list_channel = fl_basic_message_channel_new(
+        self->messenger, channel_name, FL_MESSAGE_CODEC(self->codec));
+  }
   GTask* task = g_task_new(self, cancellable, callback, user_data);
-  g_task_set_task_data(task, channel, g_object_unref);
+  g_task_set_task_data(task, g_object_ref(self->echo_wrapped_list_channel),
+                       g_object_unref);
   fl_basic_message_channel_send(
-      channel, args, cancellable,
+      self->echo_wrapped_list_channel, args, cancellable,
       core_tests_pigeon_test_flutter_small_api_echo_wrapped_list_cb, task);
 }
 
@@ -36616,18 +38156,19 @@ void core_tests_pigeon_test_flutter_small_api_echo_string(
     gpointer user_data) {
   g_autoptr(FlValue) args = fl_value_new_list();
   fl_value_append_take(args, fl_value_new_string(a_string));
-  g_autofree gchar* channel_name = g_strdup_printf(
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterSmallApi.echoString%"
-      "s",
-      self->suffix);
-  g_autoptr(CoreTestsPigeonTestMessageCodec) codec =
-      core_tests_pigeon_test_message_codec_new();
-  FlBasicMessageChannel* channel = fl_basic_message_channel_new(
-      self->messenger, channel_name, FL_MESSAGE_CODEC(codec));
+  if (self->echo_string_channel == nullptr) {
+    g_autofree gchar* channel_name = g_strdup_printf(
+        "dev.flutter.pigeon.pigeon_integration_tests.FlutterSmallApi."
+        "echoString%s",
+        self->suffix);
+    self->echo_string_channel = fl_basic_message_channel_new(
+        self->messenger, channel_name, FL_MESSAGE_CODEC(self->codec));
+  }
   GTask* task = g_task_new(self, cancellable, callback, user_data);
-  g_task_set_task_data(task, channel, g_object_unref);
+  g_task_set_task_data(task, g_object_ref(self->echo_string_channel),
+                       g_object_unref);
   fl_basic_message_channel_send(
-      channel, args, cancellable,
+      self->echo_string_channel, args, cancellable,
       core_tests_pigeon_test_flutter_small_api_echo_string_cb, task);
 }
 
@@ -58,6 +58,21 @@ G_DECLARE_FINAL_TYPE(CoreTestsPigeonTestUnusedClass,
 CoreTestsPigeonTestUnusedClass* core_tests_pigeon_test_unused_class_new(
     FlValue* a_field);
 
+/**
+ * core_tests_pigeon_test_unused_class_new_take:
+ * a_field: field in this object.
+ *
+ * Creates a new #UnusedClass object.
+ *
+ * This takes ownership of the string, list, map, object and typed data
+ * values instead of copying them. Typed data must have been allocated with
+ * g_malloc().
+ *
+ * Returns: a new #CoreTestsPigeonTestUnusedClass
+ */
+CoreTestsPigeonTestUnusedClass* core_tests_pigeon_test_unused_class_new_take(
+    FlValue* a_field);
+
 /**
  * core_tests_pigeon_test_unused_class_get_a_field
  * @object: a #CoreTestsPigeonTestUnusedClass.
@@ -85,7 +100,9 @@ gboolean core_tests_pigeon_test_unused_class_equals(
  * core_tests_pigeon_test_unused_class_hash:
  * @object: a #CoreTestsPigeonTestUnusedClass.
  *
- * Calculates a hash code for a #CoreTestsPigeonTestUnusedClass object.
+ * Calculates a hash code for a #CoreTestsPigeonTestUnusedClass object. The hash
+ * code is only calculated once, so the list and map values of @object must not
+ * be modified after it is created.
  *
  * Returns: the hash code.
  */
@@ -166,6 +183,62 @@ CoreTestsPigeonTestAllTypes* core_tests_pigeon_test_all_types_new(
     FlValue* string_map, FlValue* int_map, FlValue* enum_map,
     FlValue* object_map, FlValue* list_map, FlValue* map_map);
 
+/**
+ * core_tests_pigeon_test_all_types_new_take:
+ * a_bool: field in this object.
+ * an_int: field in this object.
+ * an_int64: field in this object.
+ * a_double: field in this object.
+ * a_byte_array: field in this object.
+ * a_byte_array_length: length of @a_byte_array.
+ * a4_byte_array: field in this object.
+ * a4_byte_array_length: length of @a4_byte_array.
+ * a8_byte_array: field in this object.
+ * a8_byte_array_length: length of @a8_byte_array.
+ * a_float_array: field in this object.
+ * a_float_array_length: length of @a_float_array.
+ * an_enum: field in this object.
+ * another_enum: field in this object.
+ * a_string: field in this object.
+ * an_object: field in this object.
+ * list: field in this object.
+ * string_list: field in this object.
+ * int_list: field in this object.
+ * double_list: field in this object.
+ * bool_list: field in this object.
+ * enum_list: field in this object.
+ * object_list: field in this object.
+ * list_list: field in this object.
+ * map_list: field in this object.
+ * map: field in this object.
+ * string_map: field in this object.
+ * int_map: field in this object.
+ * enum_map: field in this object.
+ * object_map: field in this object.
+ * list_map: field in this object.
+ * map_map: field in this object.
+ *
+ * Creates a new #AllTypes object.
+ *
+ * This takes ownership of the string, list, map, object and typed data
+ * values instead of copying them. Typed data must have been allocated with
+ * g_malloc().
+ *
+ * Returns: a new #CoreTestsPigeonTestAllTypes
+ */
+CoreTestsPigeonTestAllTypes* core_tests_pigeon_test_all_types_new_take(
+    gboolean a_bool, int64_t an_int, int64_t an_int64, double a_double,
+    uint8_t* a_byte_array, size_t a_byte_array_length, int32_t* a4_byte_array,
+    size_t a4_byte_array_length, int64_t* a8_byte_array,
+    size_t a8_byte_array_length, double* a_float_array,
+    size_t a_float_array_length, CoreTestsPigeonTestAnEnum an_enum,
+    CoreTestsPigeonTestAnotherEnum another_enum, gchar* a_string,
+    FlValue* an_object, FlValue* list, FlValue* string_list, FlValue* int_list,
+    FlValue* double_list, FlValue* bool_list, FlValue* enum_list,
+    FlValue* object_list, FlValue* list_list, FlValue* map_list, FlValue* map,
+    FlValue* string_map, FlValue* int_map, FlValue* enum_map,
+    FlValue* object_map, FlValue* list_map, FlValue* map_map);
+
 /**
  * core_tests_pigeon_test_all_types_get_a_bool
  * @object: a #CoreTestsPigeonTestAllTypes.
@@ -495,7 +568,9 @@ gboolean core_tests_pigeon_test_all_types_equals(
  * core_tests_pigeon_test_all_types_hash:
  * @object: a #CoreTestsPigeonTestAllTypes.
  *
- * Calculates a hash code for a #CoreTestsPigeonTestAllTypes object.
+ * Calculates a hash code for a #CoreTestsPigeonTestAllTypes object. The hash
+ * code is only calculated once, so the list and map values of @object must not
+ * be modified after it is created.
  *
  * Returns: the hash code.
  */
@@ -584,6 +659,71 @@ core_tests_pigeon_test_all_nullable_types_new(
     FlValue* object_map, FlValue* list_map, FlValue* map_map,
     FlValue* recursive_class_map);
 
+/**
+ * core_tests_pigeon_test_all_nullable_types_new_take:
+ * a_nullable_bool: field in this object.
+ * a_nullable_int: field in this object.
+ * a_nullable_int64: field in this object.
+ * a_nullable_double: field in this object.
+ * a_nullable_byte_array: field in this object.
+ * a_nullable_byte_array_length: length of @a_nullable_byte_array.
+ * a_nullable4_byte_array: field in this object.
+ * a_nullable4_byte_array_length: length of @a_nullable4_byte_array.
+ * a_nullable8_byte_array: field in this object.
+ * a_nullable8_byte_array_length: length of @a_nullable8_byte_array.
+ * a_nullable_float_array: field in this object.
+ * a_nullable_float_array_length: length of @a_nullable_float_array.
+ * a_nullable_enum: field in this object.
+ * another_nullable_enum: field in this object.
+ * a_nullable_string: field in this object.
+ * a_nullable_object: field in this object.
+ * all_nullable_types: field in this object.
+ * list: field in this object.
+ * string_list: field in this object.
+ * int_list: field in this object.
+ * double_list: field in this object.
+ * bool_list: field in this object.
+ * enum_list: field in this object.
+ * object_list: field in this object.
+ * list_list: field in this object.
+ * map_list: field in this object.
+ * recursive_class_list: field in this object.
+ * map: field in this object.
+ * string_map: field in this object.
+ * int_map: field in this object.
+ * enum_map: field in this object.
+ * object_map: field in this object.
+ * list_map: field in this object.
+ * map_map: field in this object.
+ * recursive_class_map: field in this object.
+ *
+ * Creates a new #AllNullableTypes object.
+ *
+ * This takes ownership of the string, list, map, object and typed data
+ * values instead of copying them. Typed data must have been allocated with
+ * g_malloc().
+ *
+ * Returns: a new #CoreTestsPigeonTestAllNullableTypes
+ */
+CoreTestsPigeonTestAllNullableTypes*
+core_tests_pigeon_test_all_nullable_types_new_take(
+    gboolean* a_nullable_bool, int64_t* a_nullable_int,
+    int64_t* a_nullable_int64, double* a_nullable_double,
+    uint8_t* a_nullable_byte_array, size_t a_nullable_byte_array_length,
+    int32_t* a_nullable4_byte_array, size_t a_nullable4_byte_array_length,
+    int64_t* a_nullable8_byte_array, size_t a_nullable8_byte_array_length,
+    double* a_nullable_float_array, size_t a_nullable_float_array_length,
+    CoreTestsPigeonTestAnEnum* a_nullable_enum,
+    CoreTestsPigeonTestAnotherEnum* another_nullable_enum,
+    gchar* a_nullable_string, FlValue* a_nullable_object,
+    CoreTestsPigeonTestAllNullableTypes* all_nullable_types, FlValue* list,
+    FlValue* string_list, FlValue* int_list, FlValue* double_list,
+    FlValue* bool_list, FlValue* enum_list, FlValue* object_list,
+    FlValue* list_list, FlValue* map_list, FlValue* recursive_class_list,
+    FlValue* map, FlValue* string_map, FlValue* int_map, FlValue* enum_map,
+    FlValue* object_map, FlValue* list_map, FlValue* map_map,
+    FlValue* recursive_class_map);
+
 /**
  * core_tests_pigeon_test_all_nullable_types_get_a_nullable_bool
  * @object: a #CoreTestsPigeonTestAllNullableTypes.
@@ -953,7 +1093,9 @@ gboolean core_tests_pigeon_test_all_nullable_types_equals(
  * core_tests_pigeon_test_all_nullable_types_hash:
  * @object: a #CoreTestsPigeonTestAllNullableTypes.
  *
- * Calculates a hash code for a #CoreTestsPigeonTestAllNullableTypes object.
+ * Calculates a hash code for a #CoreTestsPigeonTestAllNullableTypes object. The
+ * hash code is only calculated once, so the list and map values of @object must
+ * not be modified after it is created.
  *
  * Returns: the hash code.
  */
@@ -1041,6 +1183,66 @@ core_tests_pigeon_test_all_nullable_types_without_recursion_new(
     FlValue* int_map, FlValue* enum_map, FlValue* object_map, FlValue* list_map,
     FlValue* map_map);
 
+/**
+ * core_tests_pigeon_test_all_nullable_types_without_recursion_new_take:
+ * a_nullable_bool: field in this object.
+ * a_nullable_int: field in this object.
+ * a_nullable_int64: field in this object.
+ * a_nullable_double: field in this object.
+ * a_nullable_byte_array: field in this object.
+ * a_nullable_byte_array_length: length of @a_nullable_byte_array.
+ * a_nullable4_byte_array: field in this object.
+ * a_nullable4_byte_array_length: length of @a_nullable4_byte_array.
+ * a_nullable8_byte_array: field in this object.
+ * a_nullable8_byte_array_length: length of @a_nullable8_byte_array.
+ * a_nullable_float_array: field in this object.
+ * a_nullable_float_array_length: length of @a_nullable_float_array.
+ * a_nullable_enum: field in this object.
+ * another_nullable_enum: field in this object.
+ * a_nullable_string: field in this object.
+ * a_nullable_object: field in this object.
+ * list: field in this object.
+ * string_list: field in this object.
+ * int_list: field in this object.
+ * double_list: field in this object.
+ * bool_list: field in this object.
+ * enum_list: field in this object.
+ * object_list: field in this object.
+ * list_list: field in this object.
+ * map_list: field in this object.
+ * map: field in this object.
+ * string_map: field in this object.
+ * int_map: field in this object.
+ * enum_map: field in this object.
+ * object_map: field in this object.
+ * list_map: field in this object.
+ * map_map: field in this object.
+ *
+ * Creates a new #AllNullableTypesWithoutRecursion object.
+ *
+ * This takes ownership of the string, list, map, object and typed data
+ * values instead of copying them. Typed data must have been allocated with
+ * g_malloc().
+ *
+ * Returns: a new #CoreTestsPigeonTestAllNullableTypesWithoutRecursion
+ */
+CoreTestsPigeonTestAllNullableTypesWithoutRecursion*
+core_tests_pigeon_test_all_nullable_types_without_recursion_new_take(
+    gboolean* a_nullable_bool, int64_t* a_nullable_int,
+    int64_t* a_nullable_int64, double* a_nullable_double,
+    uint8_t* a_nullable_byte_array, size_t a_nullable_byte_array_length,
+    int32_t* a_nullable4_byte_array, size_t a_nullable4_byte_array_length,
+    int64_t* a_nullable8_byte_array, size_t a_nullable8_byte_array_length,
+    double* a_nullable_float_array, size_t a_nullable_float_array_length,
+    CoreTestsPigeonTestAnEnum* a_nullable_enum,
+    CoreTestsPigeonTestAnotherEnum* another_nullable_enum,
+    gchar* a_nullable_string, FlValue* a_nullable_object, FlValue* list,
+    FlValue* string_list, FlValue* int_list, FlValue* double_list,
+    FlValue* bool_list, FlValue* enum_list, FlValue* object_list,
+    FlValue* list_list, FlValue* map_list, FlValue* map, FlValue* string_map,
+    FlValue* int_map, FlValue* enum_map, FlValue* object_map, FlValue* list_map,
+    FlValue* map_map);
+
 /**
  * core_tests_pigeon_test_all_nullable_types_without_recursion_get_a_nullable_bool
  * @object: a #CoreTestsPigeonTestAllNullableTypesWithoutRecursion.
@@ -1402,7 +1604,9 @@ gboolean core_tests_pigeon_test_all_nullable_types_without_recursion_equals(
  * @object: a #CoreTestsPigeonTestAllNullableTypesWithoutRecursion.
  *
  * Calculates a hash code for a
- * #CoreTestsPigeonTestAllNullableTypesWithoutRecursion object.
+ * #CoreTestsPigeonTestAllNullableTypesWithoutRecursion object. The hash code is
+ * only calculated once, so the list and map values of @object must not be
+ * modified after it is created.
  *
  * Returns: the hash code.
  */
@@ -1458,6 +1662,33 @@ core_tests_pigeon_test_all_classes_wrapper_new(
     FlValue* nullable_class_list, FlValue* class_map,
     FlValue* nullable_class_map);
 
+/**
+ * core_tests_pigeon_test_all_classes_wrapper_new_take:
+ * all_nullable_types: field in this object.
+ * all_nullable_types_without_recursion: field in this object.
+ * all_types: field in this object.
+ * class_list: field in this object.
+ * nullable_class_list: field in this object.
+ * class_map: field in this object.
+ * nullable_class_map: field in this object.
+ *
+ * Creates a new #AllClassesWrapper object.
+ *
+ * This takes ownership of the string, list, map, object and typed data
+ * values instead of copying them. Typed data must have been allocated with
+ * g_malloc().
+ *
+ * Returns: a new #CoreTestsPigeonTestAllClassesWrapper
+ */
+CoreTestsPigeonTestAllClassesWrapper*
+core_tests_pigeon_test_all_classes_wrapper_new_take(
+    CoreTestsPigeonTestAllNullableTypes* all_nullable_types,
+    CoreTestsPigeonTestAllNullableTypesWithoutRecursion*
+        all_nullable_types_without_recursion,
+    CoreTestsPigeonTestAllTypes* all_types, FlValue* class_list,
+    FlValue* nullable_class_list, FlValue* class_map,
+    FlValue* nullable_class_map);
+
 /**
  * core_tests_pigeon_test_all_classes_wrapper_get_all_nullable_types
  * @object: a #CoreTestsPigeonTestAllClassesWrapper.
@@ -1556,6 +1787,8 @@ gboolean core_tests_pigeon_test_all_classes_wrapper_equals(
  * @object: a #CoreTestsPigeonTestAllClassesWrapper.
  *
  * Calculates a hash code for a #CoreTestsPigeonTestAllClassesWrapper object.
+ * The hash code is only calculated once, so the list and map values of @object
+ * must not be modified after it is created.
  *
  * Returns: the hash code.
  */
@@ -1595,6 +1828,21 @@ G_DECLARE_FINAL_TYPE(CoreTestsPigeonTestTestMessage,
 CoreTestsPigeonTestTestMessage* core_tests_pigeon_test_test_message_new(
     FlValue* test_list);
 
+/**
+ * core_tests_pigeon_test_test_message_new_take:
+ * test_list: field in this object.
+ *
+ * Creates a new #TestMessage object.
+ *
+ * This takes ownership of the string, list, map, object and typed data
+ * values instead of copying them. Typed data must have been allocated with
+ * g_malloc().
+ *
+ * Returns: a new #CoreTestsPigeonTestTestMessage
+ */
+CoreTestsPigeonTestTestMessage* core_tests_pigeon_test_test_message_new_take(
+    FlValue* test_list);
+
 /**
  * core_tests_pigeon_test_test_message_get_test_list
  * @object: a #CoreTestsPigeonTestTestMessage.
@@ -1622,7 +1870,9 @@ gboolean core_tests_pigeon_test_test_message_equals(
  * core_tests_pigeon_test_test_message_hash:
  * @object: a #CoreTestsPigeonTestTestMessage.
  *
- * Calculates a hash code for a #CoreTestsPigeonTestTestMessage object.
+ * Calculates a hash code for a #CoreTestsPigeonTestTestMessage object. The hash
+ * code is only calculated once, so the list and map values of @object must not
+ * be modified after it is created.
  *
  * Returns: the hash code.
  */
@@ -4520,6 +4770,10 @@ typedef struct {
  * @user_data, or %NULL.
  *
  * Connects the method handlers in the HostIntegrationCoreApi API.
+ *
+ * Methods with a serial background task queue are called one at a time on
+ * a thread owned by this API. Their responses are sent from the thread-default
+ * main context at the time this is called.
  */
 void core_tests_pigeon_test_host_integration_core_api_set_method_handlers(
     FlBinaryMessenger* messenger, const gchar* suffix,
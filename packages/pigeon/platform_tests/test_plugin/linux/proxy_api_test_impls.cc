@@ -0,0 +1,1834 @@
+// Copyright 2013 The Flutter Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "proxy_api_test_impls.h"
+
+#include "pigeon/proxy_api_tests.gen.h"
+
+struct _ProxyApiTestImpls {
+  GObject parent_instance;
+
+  FlBinaryMessenger* messenger;
+
+  ProxyApiTestsPigeonTestPigeonInstanceManager* instance_manager;
+
+  // Calls the Flutter methods of ProxyApiTestClass instances.
+  ProxyApiTestsPigeonTestProxyApiTestClass* flutter_api;
+
+  GCancellable* cancellable;
+};
+
+G_DEFINE_TYPE(ProxyApiTestImpls, proxy_api_test_impls, G_TYPE_OBJECT)
+
+// The native instances are plain GObjects, as the tests only check that
+// instances are passed between Dart and the host.
+static GObject* new_instance() {
+  return G_OBJECT(g_object_new(G_TYPE_OBJECT, nullptr));
+}
+
+static GObject* test_class_default_constructor(
+    gboolean a_bool, int64_t an_int, double a_double, const gchar* a_string,
+    const uint8_t* a_uint8_list, size_t a_uint8_list_length, FlValue* a_list,
+    FlValue* a_map, ProxyApiTestsPigeonTestProxyApiTestEnum an_enum,
+    GObject* a_proxy_api, gboolean* a_nullable_bool, int64_t* a_nullable_int,
+    double* a_nullable_double, const gchar* a_nullable_string,
+    const uint8_t* a_nullable_uint8_list, size_t a_nullable_uint8_list_length,
+    FlValue* a_nullable_list, FlValue* a_nullable_map,
+    ProxyApiTestsPigeonTestProxyApiTestEnum* a_nullable_enum,
+    GObject* a_nullable_proxy_api, gboolean bool_param, int64_t int_param,
+    double double_param, const gchar* string_param,
+    const uint8_t* a_uint8_list_param, size_t a_uint8_list_param_length,
+    FlValue* list_param, FlValue* map_param,
+    ProxyApiTestsPigeonTestProxyApiTestEnum enum_param,
+    GObject* proxy_api_param, gboolean* nullable_bool_param,
+    int64_t* nullable_int_param, double* nullable_double_param,
+    const gchar* nullable_string_param,
+    const uint8_t* nullable_uint8_list_param,
+    size_t nullable_uint8_list_param_length, FlValue* nullable_list_param,
+    FlValue* nullable_map_param,
+    ProxyApiTestsPigeonTestProxyApiTestEnum* nullable_enum_param,
+    GObject* nullable_proxy_api_param, GError** error, gpointer user_data) {
+  return new_instance();
+}
+
+static GObject* test_class_named_constructor(
+    gboolean a_bool, int64_t an_int, double a_double, const gchar* a_string,
+    const uint8_t* a_uint8_list, size_t a_uint8_list_length, FlValue* a_list,
+    FlValue* a_map, ProxyApiTestsPigeonTestProxyApiTestEnum an_enum,
+    GObject* a_proxy_api, gboolean* a_nullable_bool, int64_t* a_nullable_int,
+    double* a_nullable_double, const gchar* a_nullable_string,
+    const uint8_t* a_nullable_uint8_list, size_t a_nullable_uint8_list_length,
+    FlValue* a_nullable_list, FlValue* a_nullable_map,
+    ProxyApiTestsPigeonTestProxyApiTestEnum* a_nullable_enum,
+    GObject* a_nullable_proxy_api, GError** error, gpointer user_data) {
+  return new_instance();
+}
+
+static GObject* attached_field(
+    GObject* pigeon_instance, GError** error, gpointer user_data) {
+  return new_instance();
+}
+
+static GObject* static_attached_field(GError** error, gpointer user_data) {
+  return new_instance();
+}
+
+static ProxyApiTestsPigeonTestProxyApiTestClassNoopResponse* noop(
+    GObject* pigeon_instance, gpointer user_data) {
+  return proxy_api_tests_pigeon_test_proxy_api_test_class_noop_response_new();
+}
+
+static ProxyApiTestsPigeonTestProxyApiTestClassThrowErrorResponse* throw_error(
+    GObject* pigeon_instance, gpointer user_data) {
+  return proxy_api_tests_pigeon_test_proxy_api_test_class_throw_error_response_new_error(
+      "An error", "", nullptr);
+}
+
+static ProxyApiTestsPigeonTestProxyApiTestClassThrowErrorFromVoidResponse*
+throw_error_from_void(GObject* pigeon_instance, gpointer user_data) {
+  return proxy_api_tests_pigeon_test_proxy_api_test_class_throw_error_from_void_response_new_error(
+      "An error", "", nullptr);
+}
+
+static ProxyApiTestsPigeonTestProxyApiTestClassThrowFlutterErrorResponse*
+throw_flutter_error(GObject* pigeon_instance, gpointer user_data) {
+  g_autoptr(FlValue) details = fl_value_new_string("details");
+  return proxy_api_tests_pigeon_test_proxy_api_test_class_throw_flutter_error_response_new_error(
+      "code", "message", details);
+}
+
+static ProxyApiTestsPigeonTestProxyApiTestClassEchoIntResponse* echo_int(
+    GObject* pigeon_instance, int64_t an_int, gpointer user_data) {
+  return proxy_api_tests_pigeon_test_proxy_api_test_class_echo_int_response_new(
+      an_int);
+}
+
+static ProxyApiTestsPigeonTestProxyApiTestClassEchoDoubleResponse* echo_double(
+    GObject* pigeon_instance, double a_double, gpointer user_data) {
+  return proxy_api_tests_pigeon_test_proxy_api_test_class_echo_double_response_new(
+      a_double);
+}
+
+static ProxyApiTestsPigeonTestProxyApiTestClassEchoBoolResponse* echo_bool(
+    GObject* pigeon_instance, gboolean a_bool, gpointer user_data) {
+  return proxy_api_tests_pigeon_test_proxy_api_test_class_echo_bool_response_new(
+      a_bool);
+}
+
+static ProxyApiTestsPigeonTestProxyApiTestClassEchoStringResponse* echo_string(
+    GObject* pigeon_instance, const gchar* a_string, gpointer user_data) {
+  return proxy_api_tests_pigeon_test_proxy_api_test_class_echo_string_response_new(
+      a_string);
+}
+
+static ProxyApiTestsPigeonTestProxyApiTestClassEchoUint8ListResponse*
+echo_uint8_list(GObject* pigeon_instance, const uint8_t* a_uint8_list,
+                size_t a_uint8_list_length, gpointer user_data) {
+  return proxy_api_tests_pigeon_test_proxy_api_test_class_echo_uint8_list_response_new(
+      a_uint8_list, a_uint8_list_length);
+}
+
+static ProxyApiTestsPigeonTestProxyApiTestClassEchoObjectResponse* echo_object(
+    GObject* pigeon_instance, FlValue* an_object, gpointer user_data) {
+  return proxy_api_tests_pigeon_test_proxy_api_test_class_echo_object_response_new(
+      an_object);
+}
+
+static ProxyApiTestsPigeonTestProxyApiTestClassEchoListResponse* echo_list(
+    GObject* pigeon_instance, FlValue* a_list, gpointer user_data) {
+  return proxy_api_tests_pigeon_test_proxy_api_test_class_echo_list_response_new(
+      a_list);
+}
+
+static ProxyApiTestsPigeonTestProxyApiTestClassEchoProxyApiListResponse*
+echo_proxy_api_list(GObject* pigeon_instance, FlValue* a_list,
+                    gpointer user_data) {
+  return proxy_api_tests_pigeon_test_proxy_api_test_class_echo_proxy_api_list_response_new(
+      a_list);
+}
+
+static ProxyApiTestsPigeonTestProxyApiTestClassEchoMapResponse* echo_map(
+    GObject* pigeon_instance, FlValue* a_map, gpointer user_data) {
+  return proxy_api_tests_pigeon_test_proxy_api_test_class_echo_map_response_new(
+      a_map);
+}
+
+static ProxyApiTestsPigeonTestProxyApiTestClassEchoProxyApiMapResponse*
+echo_proxy_api_map(GObject* pigeon_instance, FlValue* a_map,
+                   gpointer user_data) {
+  return proxy_api_tests_pigeon_test_proxy_api_test_class_echo_proxy_api_map_response_new(
+      a_map);
+}
+
+static ProxyApiTestsPigeonTestProxyApiTestClassEchoEnumResponse*
+echo_enum(GObject* pigeon_instance,
+          ProxyApiTestsPigeonTestProxyApiTestEnum an_enum, gpointer user_data) {
+  return proxy_api_tests_pigeon_test_proxy_api_test_class_echo_enum_response_new(
+      an_enum);
+}
+
+static ProxyApiTestsPigeonTestProxyApiTestClassEchoProxyApiResponse*
+echo_proxy_api(GObject* pigeon_instance, GObject* a_proxy_api,
+               gpointer user_data) {
+  return proxy_api_tests_pigeon_test_proxy_api_test_class_echo_proxy_api_response_new(
+      a_proxy_api);
+}
+
+static ProxyApiTestsPigeonTestProxyApiTestClassEchoNullableIntResponse*
+echo_nullable_int(GObject* pigeon_instance, int64_t* a_nullable_int,
+                  gpointer user_data) {
+  return proxy_api_tests_pigeon_test_proxy_api_test_class_echo_nullable_int_response_new(
+      a_nullable_int);
+}
+
+static ProxyApiTestsPigeonTestProxyApiTestClassEchoNullableDoubleResponse*
+echo_nullable_double(GObject* pigeon_instance, double* a_nullable_double,
+                     gpointer user_data) {
+  return proxy_api_tests_pigeon_test_proxy_api_test_class_echo_nullable_double_response_new(
+      a_nullable_double);
+}
+
+static ProxyApiTestsPigeonTestProxyApiTestClassEchoNullableBoolResponse*
+echo_nullable_bool(GObject* pigeon_instance, gboolean* a_nullable_bool,
+                   gpointer user_data) {
+  return proxy_api_tests_pigeon_test_proxy_api_test_class_echo_nullable_bool_response_new(
+      a_nullable_bool);
+}
+
+static ProxyApiTestsPigeonTestProxyApiTestClassEchoNullableStringResponse*
+echo_nullable_string(GObject* pigeon_instance, const gchar* a_nullable_string,
+                     gpointer user_data) {
+  return proxy_api_tests_pigeon_test_proxy_api_test_class_echo_nullable_string_response_new(
+      a_nullable_string);
+}
+
+static ProxyApiTestsPigeonTestProxyApiTestClassEchoNullableUint8ListResponse*
+echo_nullable_uint8_list(GObject* pigeon_instance,
+                         const uint8_t* a_nullable_uint8_list,
+                         size_t a_nullable_uint8_list_length,
+                         gpointer user_data) {
+  return proxy_api_tests_pigeon_test_proxy_api_test_class_echo_nullable_uint8_list_response_new(
+      a_nullable_uint8_list, a_nullable_uint8_list_length);
+}
+
+static ProxyApiTestsPigeonTestProxyApiTestClassEchoNullableObjectResponse*
+echo_nullable_object(GObject* pigeon_instance, FlValue* a_nullable_object,
+                     gpointer user_data) {
+  return proxy_api_tests_pigeon_test_proxy_api_test_class_echo_nullable_object_response_new(
+      a_nullable_object);
+}
+
+static ProxyApiTestsPigeonTestProxyApiTestClassEchoNullableListResponse*
+echo_nullable_list(GObject* pigeon_instance, FlValue* a_nullable_list,
+                   gpointer user_data) {
+  return proxy_api_tests_pigeon_test_proxy_api_test_class_echo_nullable_list_response_new(
+      a_nullable_list);
+}
+
+static ProxyApiTestsPigeonTestProxyApiTestClassEchoNullableMapResponse*
+echo_nullable_map(GObject* pigeon_instance, FlValue* a_nullable_map,
+                  gpointer user_data) {
+  return proxy_api_tests_pigeon_test_proxy_api_test_class_echo_nullable_map_response_new(
+      a_nullable_map);
+}
+
+static ProxyApiTestsPigeonTestProxyApiTestClassEchoNullableEnumResponse*
+echo_nullable_enum(GObject* pigeon_instance,
+                   ProxyApiTestsPigeonTestProxyApiTestEnum* a_nullable_enum,
+                   gpointer user_data) {
+  return proxy_api_tests_pigeon_test_proxy_api_test_class_echo_nullable_enum_response_new(
+      a_nullable_enum);
+}
+
+static ProxyApiTestsPigeonTestProxyApiTestClassEchoNullableProxyApiResponse*
+echo_nullable_proxy_api(GObject* pigeon_instance, GObject* a_nullable_proxy_api,
+                        gpointer user_data) {
+  return proxy_api_tests_pigeon_test_proxy_api_test_class_echo_nullable_proxy_api_response_new(
+      a_nullable_proxy_api);
+}
+
+static void noop_async(
+    GObject* pigeon_instance,
+    ProxyApiTestsPigeonTestProxyApiTestClassResponseHandle* response_handle,
+    gpointer user_data) {
+  proxy_api_tests_pigeon_test_proxy_api_test_class_respond_noop_async(
+      response_handle);
+}
+
+static void echo_async_int(
+    GObject* pigeon_instance, int64_t an_int,
+    ProxyApiTestsPigeonTestProxyApiTestClassResponseHandle* response_handle,
+    gpointer user_data) {
+  proxy_api_tests_pigeon_test_proxy_api_test_class_respond_echo_async_int(
+      response_handle, an_int);
+}
+
+static void echo_async_double(
+    GObject* pigeon_instance, double a_double,
+    ProxyApiTestsPigeonTestProxyApiTestClassResponseHandle* response_handle,
+    gpointer user_data) {
+  proxy_api_tests_pigeon_test_proxy_api_test_class_respond_echo_async_double(
+      response_handle, a_double);
+}
+
+static void echo_async_bool(
+    GObject* pigeon_instance, gboolean a_bool,
+    ProxyApiTestsPigeonTestProxyApiTestClassResponseHandle* response_handle,
+    gpointer user_data) {
+  proxy_api_tests_pigeon_test_proxy_api_test_class_respond_echo_async_bool(
+      response_handle, a_bool);
+}
+
+static void echo_async_string(
+    GObject* pigeon_instance, const gchar* a_string,
+    ProxyApiTestsPigeonTestProxyApiTestClassResponseHandle* response_handle,
+    gpointer user_data) {
+  proxy_api_tests_pigeon_test_proxy_api_test_class_respond_echo_async_string(
+      response_handle, a_string);
+}
+
+static void echo_async_uint8_list(
+    GObject* pigeon_instance, const uint8_t* a_uint8_list,
+    size_t a_uint8_list_length,
+    ProxyApiTestsPigeonTestProxyApiTestClassResponseHandle* response_handle,
+    gpointer user_data) {
+  proxy_api_tests_pigeon_test_proxy_api_test_class_respond_echo_async_uint8_list(
+      response_handle, a_uint8_list, a_uint8_list_length);
+}
+
+static void echo_async_object(
+    GObject* pigeon_instance, FlValue* an_object,
+    ProxyApiTestsPigeonTestProxyApiTestClassResponseHandle* response_handle,
+    gpointer user_data) {
+  proxy_api_tests_pigeon_test_proxy_api_test_class_respond_echo_async_object(
+      response_handle, an_object);
+}
+
+static void echo_async_list(
+    GObject* pigeon_instance, FlValue* a_list,
+    ProxyApiTestsPigeonTestProxyApiTestClassResponseHandle* response_handle,
+    gpointer user_data) {
+  proxy_api_tests_pigeon_test_proxy_api_test_class_respond_echo_async_list(
+      response_handle, a_list);
+}
+
+static void echo_async_map(
+    GObject* pigeon_instance, FlValue* a_map,
+    ProxyApiTestsPigeonTestProxyApiTestClassResponseHandle* response_handle,
+    gpointer user_data) {
+  proxy_api_tests_pigeon_test_proxy_api_test_class_respond_echo_async_map(
+      response_handle, a_map);
+}
+
+static void echo_async_enum(
+    GObject* pigeon_instance, ProxyApiTestsPigeonTestProxyApiTestEnum an_enum,
+    ProxyApiTestsPigeonTestProxyApiTestClassResponseHandle* response_handle,
+    gpointer user_data) {
+  proxy_api_tests_pigeon_test_proxy_api_test_class_respond_echo_async_enum(
+      response_handle, an_enum);
+}
+
+static void throw_async_error(
+    GObject* pigeon_instance,
+    ProxyApiTestsPigeonTestProxyApiTestClassResponseHandle* response_handle,
+    gpointer user_data) {
+  proxy_api_tests_pigeon_test_proxy_api_test_class_respond_error_throw_async_error(
+      response_handle, "An error", "", nullptr);
+}
+
+static void throw_async_error_from_void(
+    GObject* pigeon_instance,
+    ProxyApiTestsPigeonTestProxyApiTestClassResponseHandle* response_handle,
+    gpointer user_data) {
+  proxy_api_tests_pigeon_test_proxy_api_test_class_respond_error_throw_async_error_from_void(
+      response_handle, "An error", "", nullptr);
+}
+
+static void throw_async_flutter_error(
+    GObject* pigeon_instance,
+    ProxyApiTestsPigeonTestProxyApiTestClassResponseHandle* response_handle,
+    gpointer user_data) {
+  g_autoptr(FlValue) details = fl_value_new_string("details");
+  proxy_api_tests_pigeon_test_proxy_api_test_class_respond_error_throw_async_flutter_error(
+      response_handle, "code", "message", details);
+}
+
+static void echo_async_nullable_int(
+    GObject* pigeon_instance, int64_t* an_int,
+    ProxyApiTestsPigeonTestProxyApiTestClassResponseHandle* response_handle,
+    gpointer user_data) {
+  proxy_api_tests_pigeon_test_proxy_api_test_class_respond_echo_async_nullable_int(
+      response_handle, an_int);
+}
+
+static void echo_async_nullable_double(
+    GObject* pigeon_instance, double* a_double,
+    ProxyApiTestsPigeonTestProxyApiTestClassResponseHandle* response_handle,
+    gpointer user_data) {
+  proxy_api_tests_pigeon_test_proxy_api_test_class_respond_echo_async_nullable_double(
+      response_handle, a_double);
+}
+
+static void echo_async_nullable_bool(
+    GObject* pigeon_instance, gboolean* a_bool,
+    ProxyApiTestsPigeonTestProxyApiTestClassResponseHandle* response_handle,
+    gpointer user_data) {
+  proxy_api_tests_pigeon_test_proxy_api_test_class_respond_echo_async_nullable_bool(
+      response_handle, a_bool);
+}
+
+static void echo_async_nullable_string(
+    GObject* pigeon_instance, const gchar* a_string,
+    ProxyApiTestsPigeonTestProxyApiTestClassResponseHandle* response_handle,
+    gpointer user_data) {
+  proxy_api_tests_pigeon_test_proxy_api_test_class_respond_echo_async_nullable_string(
+      response_handle, a_string);
+}
+
+static void echo_async_nullable_uint8_list(
+    GObject* pigeon_instance, const uint8_t* a_uint8_list,
+    size_t a_uint8_list_length,
+    ProxyApiTestsPigeonTestProxyApiTestClassResponseHandle* response_handle,
+    gpointer user_data) {
+  proxy_api_tests_pigeon_test_proxy_api_test_class_respond_echo_async_nullable_uint8_list(
+      response_handle, a_uint8_list, a_uint8_list_length);
+}
+
+static void echo_async_nullable_object(
+    GObject* pigeon_instance, FlValue* an_object,
+    ProxyApiTestsPigeonTestProxyApiTestClassResponseHandle* response_handle,
+    gpointer user_data) {
+  proxy_api_tests_pigeon_test_proxy_api_test_class_respond_echo_async_nullable_object(
+      response_handle, an_object);
+}
+
+static void echo_async_nullable_list(
+    GObject* pigeon_instance, FlValue* a_list,
+    ProxyApiTestsPigeonTestProxyApiTestClassResponseHandle* response_handle,
+    gpointer user_data) {
+  proxy_api_tests_pigeon_test_proxy_api_test_class_respond_echo_async_nullable_list(
+      response_handle, a_list);
+}
+
+static void echo_async_nullable_map(
+    GObject* pigeon_instance, FlValue* a_map,
+    ProxyApiTestsPigeonTestProxyApiTestClassResponseHandle* response_handle,
+    gpointer user_data) {
+  proxy_api_tests_pigeon_test_proxy_api_test_class_respond_echo_async_nullable_map(
+      response_handle, a_map);
+}
+
+static void echo_async_nullable_enum(
+    GObject* pigeon_instance, ProxyApiTestsPigeonTestProxyApiTestEnum* an_enum,
+    ProxyApiTestsPigeonTestProxyApiTestClassResponseHandle* response_handle,
+    gpointer user_data) {
+  proxy_api_tests_pigeon_test_proxy_api_test_class_respond_echo_async_nullable_enum(
+      response_handle, an_enum);
+}
+
+static ProxyApiTestsPigeonTestProxyApiTestClassStaticNoopResponse* static_noop(
+    gpointer user_data) {
+  return proxy_api_tests_pigeon_test_proxy_api_test_class_static_noop_response_new();
+}
+
+static ProxyApiTestsPigeonTestProxyApiTestClassEchoStaticStringResponse*
+echo_static_string(const gchar* a_string, gpointer user_data) {
+  return proxy_api_tests_pigeon_test_proxy_api_test_class_echo_static_string_response_new(
+      a_string);
+}
+
+static void static_async_noop(
+    ProxyApiTestsPigeonTestProxyApiTestClassResponseHandle* response_handle,
+    gpointer user_data) {
+  proxy_api_tests_pigeon_test_proxy_api_test_class_respond_static_async_noop(
+      response_handle);
+}
+
+static void flutter_noop_cb(
+    GObject* object, GAsyncResult* result, gpointer user_data) {
+  g_autoptr(ProxyApiTestsPigeonTestProxyApiTestClassResponseHandle)
+      response_handle =
+          PROXY_API_TESTS_PIGEON_TEST_PROXY_API_TEST_CLASS_RESPONSE_HANDLE(
+              user_data);
+
+  g_autoptr(GError) error = nullptr;
+  g_autoptr(
+      ProxyApiTestsPigeonTestProxyApiTestClassFlutterNoopResponse)
+      response =
+          proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_noop_finish(
+              PROXY_API_TESTS_PIGEON_TEST_PROXY_API_TEST_CLASS(object), result,
+              &error);
+  if (response == nullptr) {
+    proxy_api_tests_pigeon_test_proxy_api_test_class_respond_error_call_flutter_noop(
+        response_handle, "Internal Error", error->message, nullptr);
+    return;
+  }
+  if (proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_noop_response_is_error(
+          response)) {
+    proxy_api_tests_pigeon_test_proxy_api_test_class_respond_error_call_flutter_noop(
+        response_handle,
+        proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_noop_response_get_error_code(
+            response),
+        proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_noop_response_get_error_message(
+            response),
+        proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_noop_response_get_error_details(
+            response));
+    return;
+  }
+
+  proxy_api_tests_pigeon_test_proxy_api_test_class_respond_call_flutter_noop(
+      response_handle);
+}
+
+static void call_flutter_noop(
+    GObject* pigeon_instance,
+    ProxyApiTestsPigeonTestProxyApiTestClassResponseHandle* response_handle,
+    gpointer user_data) {
+  ProxyApiTestImpls* self = PROXY_API_TEST_IMPLS(user_data);
+
+  proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_noop(
+      self->flutter_api, pigeon_instance, self->cancellable, flutter_noop_cb,
+      g_object_ref(response_handle));
+}
+
+static void flutter_throw_error_cb(
+    GObject* object, GAsyncResult* result, gpointer user_data) {
+  g_autoptr(ProxyApiTestsPigeonTestProxyApiTestClassResponseHandle)
+      response_handle =
+          PROXY_API_TESTS_PIGEON_TEST_PROXY_API_TEST_CLASS_RESPONSE_HANDLE(
+              user_data);
+
+  g_autoptr(GError) error = nullptr;
+  g_autoptr(
+      ProxyApiTestsPigeonTestProxyApiTestClassFlutterThrowErrorResponse)
+      response =
+          proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_throw_error_finish(
+              PROXY_API_TESTS_PIGEON_TEST_PROXY_API_TEST_CLASS(object), result,
+              &error);
+  if (response == nullptr) {
+    proxy_api_tests_pigeon_test_proxy_api_test_class_respond_error_call_flutter_throw_error(
+        response_handle, "Internal Error", error->message, nullptr);
+    return;
+  }
+  if (proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_throw_error_response_is_error(
+          response)) {
+    proxy_api_tests_pigeon_test_proxy_api_test_class_respond_error_call_flutter_throw_error(
+        response_handle,
+        proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_throw_error_response_get_error_code(
+            response),
+        proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_throw_error_response_get_error_message(
+            response),
+        proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_throw_error_response_get_error_details(
+            response));
+    return;
+  }
+
+  proxy_api_tests_pigeon_test_proxy_api_test_class_respond_call_flutter_throw_error(
+      response_handle,
+      proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_throw_error_response_get_return_value(
+          response));
+}
+
+static void call_flutter_throw_error(
+    GObject* pigeon_instance,
+    ProxyApiTestsPigeonTestProxyApiTestClassResponseHandle* response_handle,
+    gpointer user_data) {
+  ProxyApiTestImpls* self = PROXY_API_TEST_IMPLS(user_data);
+
+  proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_throw_error(
+      self->flutter_api, pigeon_instance, self->cancellable,
+      flutter_throw_error_cb, g_object_ref(response_handle));
+}
+
+static void flutter_throw_error_from_void_cb(
+    GObject* object, GAsyncResult* result, gpointer user_data) {
+  g_autoptr(ProxyApiTestsPigeonTestProxyApiTestClassResponseHandle)
+      response_handle =
+          PROXY_API_TESTS_PIGEON_TEST_PROXY_API_TEST_CLASS_RESPONSE_HANDLE(
+              user_data);
+
+  g_autoptr(GError) error = nullptr;
+  g_autoptr(
+      ProxyApiTestsPigeonTestProxyApiTestClassFlutterThrowErrorFromVoidResponse)
+      response =
+          proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_throw_error_from_void_finish(
+              PROXY_API_TESTS_PIGEON_TEST_PROXY_API_TEST_CLASS(object), result,
+              &error);
+  if (response == nullptr) {
+    proxy_api_tests_pigeon_test_proxy_api_test_class_respond_error_call_flutter_throw_error_from_void(
+        response_handle, "Internal Error", error->message, nullptr);
+    return;
+  }
+  if (proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_throw_error_from_void_response_is_error(
+          response)) {
+    proxy_api_tests_pigeon_test_proxy_api_test_class_respond_error_call_flutter_throw_error_from_void(
+        response_handle,
+        proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_throw_error_from_void_response_get_error_code(
+            response),
+        proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_throw_error_from_void_response_get_error_message(
+            response),
+        proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_throw_error_from_void_response_get_error_details(
+            response));
+    return;
+  }
+
+  proxy_api_tests_pigeon_test_proxy_api_test_class_respond_call_flutter_throw_error_from_void(
+      response_handle);
+}
+
+static void call_flutter_throw_error_from_void(
+    GObject* pigeon_instance,
+    ProxyApiTestsPigeonTestProxyApiTestClassResponseHandle* response_handle,
+    gpointer user_data) {
+  ProxyApiTestImpls* self = PROXY_API_TEST_IMPLS(user_data);
+
+  proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_throw_error_from_void(
+      self->flutter_api, pigeon_instance, self->cancellable,
+      flutter_throw_error_from_void_cb, g_object_ref(response_handle));
+}
+
+static void flutter_echo_bool_cb(
+    GObject* object, GAsyncResult* result, gpointer user_data) {
+  g_autoptr(ProxyApiTestsPigeonTestProxyApiTestClassResponseHandle)
+      response_handle =
+          PROXY_API_TESTS_PIGEON_TEST_PROXY_API_TEST_CLASS_RESPONSE_HANDLE(
+              user_data);
+
+  g_autoptr(GError) error = nullptr;
+  g_autoptr(
+      ProxyApiTestsPigeonTestProxyApiTestClassFlutterEchoBoolResponse)
+      response =
+          proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_bool_finish(
+              PROXY_API_TESTS_PIGEON_TEST_PROXY_API_TEST_CLASS(object), result,
+              &error);
+  if (response == nullptr) {
+    proxy_api_tests_pigeon_test_proxy_api_test_class_respond_error_call_flutter_echo_bool(
+        response_handle, "Internal Error", error->message, nullptr);
+    return;
+  }
+  if (proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_bool_response_is_error(
+          response)) {
+    proxy_api_tests_pigeon_test_proxy_api_test_class_respond_error_call_flutter_echo_bool(
+        response_handle,
+        proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_bool_response_get_error_code(
+            response),
+        proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_bool_response_get_error_message(
+            response),
+        proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_bool_response_get_error_details(
+            response));
+    return;
+  }
+
+  proxy_api_tests_pigeon_test_proxy_api_test_class_respond_call_flutter_echo_bool(
+      response_handle,
+      proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_bool_response_get_return_value(
+          response));
+}
+
+static void call_flutter_echo_bool(
+    GObject* pigeon_instance, gboolean a_bool,
+    ProxyApiTestsPigeonTestProxyApiTestClassResponseHandle* response_handle,
+    gpointer user_data) {
+  ProxyApiTestImpls* self = PROXY_API_TEST_IMPLS(user_data);
+
+  proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_bool(
+      self->flutter_api, pigeon_instance, a_bool, self->cancellable,
+      flutter_echo_bool_cb, g_object_ref(response_handle));
+}
+
+static void flutter_echo_int_cb(
+    GObject* object, GAsyncResult* result, gpointer user_data) {
+  g_autoptr(ProxyApiTestsPigeonTestProxyApiTestClassResponseHandle)
+      response_handle =
+          PROXY_API_TESTS_PIGEON_TEST_PROXY_API_TEST_CLASS_RESPONSE_HANDLE(
+              user_data);
+
+  g_autoptr(GError) error = nullptr;
+  g_autoptr(
+      ProxyApiTestsPigeonTestProxyApiTestClassFlutterEchoIntResponse)
+      response =
+          proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_int_finish(
+              PROXY_API_TESTS_PIGEON_TEST_PROXY_API_TEST_CLASS(object), result,
+              &error);
+  if (response == nullptr) {
+    proxy_api_tests_pigeon_test_proxy_api_test_class_respond_error_call_flutter_echo_int(
+        response_handle, "Internal Error", error->message, nullptr);
+    return;
+  }
+  if (proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_int_response_is_error(
+          response)) {
+    proxy_api_tests_pigeon_test_proxy_api_test_class_respond_error_call_flutter_echo_int(
+        response_handle,
+        proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_int_response_get_error_code(
+            response),
+        proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_int_response_get_error_message(
+            response),
+        proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_int_response_get_error_details(
+            response));
+    return;
+  }
+
+  proxy_api_tests_pigeon_test_proxy_api_test_class_respond_call_flutter_echo_int(
+      response_handle,
+      proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_int_response_get_return_value(
+          response));
+}
+
+static void call_flutter_echo_int(
+    GObject* pigeon_instance, int64_t an_int,
+    ProxyApiTestsPigeonTestProxyApiTestClassResponseHandle* response_handle,
+    gpointer user_data) {
+  ProxyApiTestImpls* self = PROXY_API_TEST_IMPLS(user_data);
+
+  proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_int(
+      self->flutter_api, pigeon_instance, an_int, self->cancellable,
+      flutter_echo_int_cb, g_object_ref(response_handle));
+}
+
+static void flutter_echo_double_cb(
+    GObject* object, GAsyncResult* result, gpointer user_data) {
+  g_autoptr(ProxyApiTestsPigeonTestProxyApiTestClassResponseHandle)
+      response_handle =
+          PROXY_API_TESTS_PIGEON_TEST_PROXY_API_TEST_CLASS_RESPONSE_HANDLE(
+              user_data);
+
+  g_autoptr(GError) error = nullptr;
+  g_autoptr(
+      ProxyApiTestsPigeonTestProxyApiTestClassFlutterEchoDoubleResponse)
+      response =
+          proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_double_finish(
+              PROXY_API_TESTS_PIGEON_TEST_PROXY_API_TEST_CLASS(object), result,
+              &error);
+  if (response == nullptr) {
+    proxy_api_tests_pigeon_test_proxy_api_test_class_respond_error_call_flutter_echo_double(
+        response_handle, "Internal Error", error->message, nullptr);
+    return;
+  }
+  if (proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_double_response_is_error(
+          response)) {
+    proxy_api_tests_pigeon_test_proxy_api_test_class_respond_error_call_flutter_echo_double(
+        response_handle,
+        proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_double_response_get_error_code(
+            response),
+        proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_double_response_get_error_message(
+            response),
+        proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_double_response_get_error_details(
+            response));
+    return;
+  }
+
+  proxy_api_tests_pigeon_test_proxy_api_test_class_respond_call_flutter_echo_double(
+      response_handle,
+      proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_double_response_get_return_value(
+          response));
+}
+
+static void call_flutter_echo_double(
+    GObject* pigeon_instance, double a_double,
+    ProxyApiTestsPigeonTestProxyApiTestClassResponseHandle* response_handle,
+    gpointer user_data) {
+  ProxyApiTestImpls* self = PROXY_API_TEST_IMPLS(user_data);
+
+  proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_double(
+      self->flutter_api, pigeon_instance, a_double, self->cancellable,
+      flutter_echo_double_cb, g_object_ref(response_handle));
+}
+
+static void flutter_echo_string_cb(
+    GObject* object, GAsyncResult* result, gpointer user_data) {
+  g_autoptr(ProxyApiTestsPigeonTestProxyApiTestClassResponseHandle)
+      response_handle =
+          PROXY_API_TESTS_PIGEON_TEST_PROXY_API_TEST_CLASS_RESPONSE_HANDLE(
+              user_data);
+
+  g_autoptr(GError) error = nullptr;
+  g_autoptr(
+      ProxyApiTestsPigeonTestProxyApiTestClassFlutterEchoStringResponse)
+      response =
+          proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_string_finish(
+              PROXY_API_TESTS_PIGEON_TEST_PROXY_API_TEST_CLASS(object), result,
+              &error);
+  if (response == nullptr) {
+    proxy_api_tests_pigeon_test_proxy_api_test_class_respond_error_call_flutter_echo_string(
+        response_handle, "Internal Error", error->message, nullptr);
+    return;
+  }
+  if (proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_string_response_is_error(
+          response)) {
+    proxy_api_tests_pigeon_test_proxy_api_test_class_respond_error_call_flutter_echo_string(
+        response_handle,
+        proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_string_response_get_error_code(
+            response),
+        proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_string_response_get_error_message(
+            response),
+        proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_string_response_get_error_details(
+            response));
+    return;
+  }
+
+  proxy_api_tests_pigeon_test_proxy_api_test_class_respond_call_flutter_echo_string(
+      response_handle,
+      proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_string_response_get_return_value(
+          response));
+}
+
+static void call_flutter_echo_string(
+    GObject* pigeon_instance, const gchar* a_string,
+    ProxyApiTestsPigeonTestProxyApiTestClassResponseHandle* response_handle,
+    gpointer user_data) {
+  ProxyApiTestImpls* self = PROXY_API_TEST_IMPLS(user_data);
+
+  proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_string(
+      self->flutter_api, pigeon_instance, a_string, self->cancellable,
+      flutter_echo_string_cb, g_object_ref(response_handle));
+}
+
+static void flutter_echo_uint8_list_cb(
+    GObject* object, GAsyncResult* result, gpointer user_data) {
+  g_autoptr(ProxyApiTestsPigeonTestProxyApiTestClassResponseHandle)
+      response_handle =
+          PROXY_API_TESTS_PIGEON_TEST_PROXY_API_TEST_CLASS_RESPONSE_HANDLE(
+              user_data);
+
+  g_autoptr(GError) error = nullptr;
+  g_autoptr(
+      ProxyApiTestsPigeonTestProxyApiTestClassFlutterEchoUint8ListResponse)
+      response =
+          proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_uint8_list_finish(
+              PROXY_API_TESTS_PIGEON_TEST_PROXY_API_TEST_CLASS(object), result,
+              &error);
+  if (response == nullptr) {
+    proxy_api_tests_pigeon_test_proxy_api_test_class_respond_error_call_flutter_echo_uint8_list(
+        response_handle, "Internal Error", error->message, nullptr);
+    return;
+  }
+  if (proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_uint8_list_response_is_error(
+          response)) {
+    proxy_api_tests_pigeon_test_proxy_api_test_class_respond_error_call_flutter_echo_uint8_list(
+        response_handle,
+        proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_uint8_list_response_get_error_code(
+            response),
+        proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_uint8_list_response_get_error_message(
+            response),
+        proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_uint8_list_response_get_error_details(
+            response));
+    return;
+  }
+
+  size_t return_value_length;
+  const uint8_t* return_value =
+      proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_uint8_list_response_get_return_value(
+          response, &return_value_length);
+  proxy_api_tests_pigeon_test_proxy_api_test_class_respond_call_flutter_echo_uint8_list(
+      response_handle, return_value, return_value_length);
+}
+
+static void call_flutter_echo_uint8_list(
+    GObject* pigeon_instance, const uint8_t* a_uint8_list,
+    size_t a_uint8_list_length,
+    ProxyApiTestsPigeonTestProxyApiTestClassResponseHandle* response_handle,
+    gpointer user_data) {
+  ProxyApiTestImpls* self = PROXY_API_TEST_IMPLS(user_data);
+
+  proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_uint8_list(
+      self->flutter_api, pigeon_instance, a_uint8_list, a_uint8_list_length,
+      self->cancellable, flutter_echo_uint8_list_cb,
+      g_object_ref(response_handle));
+}
+
+static void flutter_echo_list_cb(
+    GObject* object, GAsyncResult* result, gpointer user_data) {
+  g_autoptr(ProxyApiTestsPigeonTestProxyApiTestClassResponseHandle)
+      response_handle =
+          PROXY_API_TESTS_PIGEON_TEST_PROXY_API_TEST_CLASS_RESPONSE_HANDLE(
+              user_data);
+
+  g_autoptr(GError) error = nullptr;
+  g_autoptr(
+      ProxyApiTestsPigeonTestProxyApiTestClassFlutterEchoListResponse)
+      response =
+          proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_list_finish(
+              PROXY_API_TESTS_PIGEON_TEST_PROXY_API_TEST_CLASS(object), result,
+              &error);
+  if (response == nullptr) {
+    proxy_api_tests_pigeon_test_proxy_api_test_class_respond_error_call_flutter_echo_list(
+        response_handle, "Internal Error", error->message, nullptr);
+    return;
+  }
+  if (proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_list_response_is_error(
+          response)) {
+    proxy_api_tests_pigeon_test_proxy_api_test_class_respond_error_call_flutter_echo_list(
+        response_handle,
+        proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_list_response_get_error_code(
+            response),
+        proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_list_response_get_error_message(
+            response),
+        proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_list_response_get_error_details(
+            response));
+    return;
+  }
+
+  proxy_api_tests_pigeon_test_proxy_api_test_class_respond_call_flutter_echo_list(
+      response_handle,
+      proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_list_response_get_return_value(
+          response));
+}
+
+static void call_flutter_echo_list(
+    GObject* pigeon_instance, FlValue* a_list,
+    ProxyApiTestsPigeonTestProxyApiTestClassResponseHandle* response_handle,
+    gpointer user_data) {
+  ProxyApiTestImpls* self = PROXY_API_TEST_IMPLS(user_data);
+
+  proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_list(
+      self->flutter_api, pigeon_instance, a_list, self->cancellable,
+      flutter_echo_list_cb, g_object_ref(response_handle));
+}
+
+static void flutter_echo_proxy_api_list_cb(
+    GObject* object, GAsyncResult* result, gpointer user_data) {
+  g_autoptr(ProxyApiTestsPigeonTestProxyApiTestClassResponseHandle)
+      response_handle =
+          PROXY_API_TESTS_PIGEON_TEST_PROXY_API_TEST_CLASS_RESPONSE_HANDLE(
+              user_data);
+
+  g_autoptr(GError) error = nullptr;
+  g_autoptr(
+      ProxyApiTestsPigeonTestProxyApiTestClassFlutterEchoProxyApiListResponse)
+      response =
+          proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_proxy_api_list_finish(
+              PROXY_API_TESTS_PIGEON_TEST_PROXY_API_TEST_CLASS(object), result,
+              &error);
+  if (response == nullptr) {
+    proxy_api_tests_pigeon_test_proxy_api_test_class_respond_error_call_flutter_echo_proxy_api_list(
+        response_handle, "Internal Error", error->message, nullptr);
+    return;
+  }
+  if (proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_proxy_api_list_response_is_error(
+          response)) {
+    proxy_api_tests_pigeon_test_proxy_api_test_class_respond_error_call_flutter_echo_proxy_api_list(
+        response_handle,
+        proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_proxy_api_list_response_get_error_code(
+            response),
+        proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_proxy_api_list_response_get_error_message(
+            response),
+        proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_proxy_api_list_response_get_error_details(
+            response));
+    return;
+  }
+
+  proxy_api_tests_pigeon_test_proxy_api_test_class_respond_call_flutter_echo_proxy_api_list(
+      response_handle,
+      proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_proxy_api_list_response_get_return_value(
+          response));
+}
+
+static void call_flutter_echo_proxy_api_list(
+    GObject* pigeon_instance, FlValue* a_list,
+    ProxyApiTestsPigeonTestProxyApiTestClassResponseHandle* response_handle,
+    gpointer user_data) {
+  ProxyApiTestImpls* self = PROXY_API_TEST_IMPLS(user_data);
+
+  proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_proxy_api_list(
+      self->flutter_api, pigeon_instance, a_list, self->cancellable,
+      flutter_echo_proxy_api_list_cb, g_object_ref(response_handle));
+}
+
+static void flutter_echo_map_cb(
+    GObject* object, GAsyncResult* result, gpointer user_data) {
+  g_autoptr(ProxyApiTestsPigeonTestProxyApiTestClassResponseHandle)
+      response_handle =
+          PROXY_API_TESTS_PIGEON_TEST_PROXY_API_TEST_CLASS_RESPONSE_HANDLE(
+              user_data);
+
+  g_autoptr(GError) error = nullptr;
+  g_autoptr(
+      ProxyApiTestsPigeonTestProxyApiTestClassFlutterEchoMapResponse)
+      response =
+          proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_map_finish(
+              PROXY_API_TESTS_PIGEON_TEST_PROXY_API_TEST_CLASS(object), result,
+              &error);
+  if (response == nullptr) {
+    proxy_api_tests_pigeon_test_proxy_api_test_class_respond_error_call_flutter_echo_map(
+        response_handle, "Internal Error", error->message, nullptr);
+    return;
+  }
+  if (proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_map_response_is_error(
+          response)) {
+    proxy_api_tests_pigeon_test_proxy_api_test_class_respond_error_call_flutter_echo_map(
+        response_handle,
+        proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_map_response_get_error_code(
+            response),
+        proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_map_response_get_error_message(
+            response),
+        proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_map_response_get_error_details(
+            response));
+    return;
+  }
+
+  proxy_api_tests_pigeon_test_proxy_api_test_class_respond_call_flutter_echo_map(
+      response_handle,
+      proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_map_response_get_return_value(
+          response));
+}
+
+static void call_flutter_echo_map(
+    GObject* pigeon_instance, FlValue* a_map,
+    ProxyApiTestsPigeonTestProxyApiTestClassResponseHandle* response_handle,
+    gpointer user_data) {
+  ProxyApiTestImpls* self = PROXY_API_TEST_IMPLS(user_data);
+
+  proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_map(
+      self->flutter_api, pigeon_instance, a_map, self->cancellable,
+      flutter_echo_map_cb, g_object_ref(response_handle));
+}
+
+static void flutter_echo_proxy_api_map_cb(
+    GObject* object, GAsyncResult* result, gpointer user_data) {
+  g_autoptr(ProxyApiTestsPigeonTestProxyApiTestClassResponseHandle)
+      response_handle =
+          PROXY_API_TESTS_PIGEON_TEST_PROXY_API_TEST_CLASS_RESPONSE_HANDLE(
+              user_data);
+
+  g_autoptr(GError) error = nullptr;
+  g_autoptr(
+      ProxyApiTestsPigeonTestProxyApiTestClassFlutterEchoProxyApiMapResponse)
+      response =
+          proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_proxy_api_map_finish(
+              PROXY_API_TESTS_PIGEON_TEST_PROXY_API_TEST_CLASS(object), result,
+              &error);
+  if (response == nullptr) {
+    proxy_api_tests_pigeon_test_proxy_api_test_class_respond_error_call_flutter_echo_proxy_api_map(
+        response_handle, "Internal Error", error->message, nullptr);
+    return;
+  }
+  if (proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_proxy_api_map_response_is_error(
+          response)) {
+    proxy_api_tests_pigeon_test_proxy_api_test_class_respond_error_call_flutter_echo_proxy_api_map(
+        response_handle,
+        proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_proxy_api_map_response_get_error_code(
+            response),
+        proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_proxy_api_map_response_get_error_message(
+            response),
+        proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_proxy_api_map_response_get_error_details(
+            response));
+    return;
+  }
+
+  proxy_api_tests_pigeon_test_proxy_api_test_class_respond_call_flutter_echo_proxy_api_map(
+      response_handle,
+      proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_proxy_api_map_response_get_return_value(
+          response));
+}
+
+static void call_flutter_echo_proxy_api_map(
+    GObject* pigeon_instance, FlValue* a_map,
+    ProxyApiTestsPigeonTestProxyApiTestClassResponseHandle* response_handle,
+    gpointer user_data) {
+  ProxyApiTestImpls* self = PROXY_API_TEST_IMPLS(user_data);
+
+  proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_proxy_api_map(
+      self->flutter_api, pigeon_instance, a_map, self->cancellable,
+      flutter_echo_proxy_api_map_cb, g_object_ref(response_handle));
+}
+
+static void flutter_echo_enum_cb(
+    GObject* object, GAsyncResult* result, gpointer user_data) {
+  g_autoptr(ProxyApiTestsPigeonTestProxyApiTestClassResponseHandle)
+      response_handle =
+          PROXY_API_TESTS_PIGEON_TEST_PROXY_API_TEST_CLASS_RESPONSE_HANDLE(
+              user_data);
+
+  g_autoptr(GError) error = nullptr;
+  g_autoptr(
+      ProxyApiTestsPigeonTestProxyApiTestClassFlutterEchoEnumResponse)
+      response =
+          proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_enum_finish(
+              PROXY_API_TESTS_PIGEON_TEST_PROXY_API_TEST_CLASS(object), result,
+              &error);
+  if (response == nullptr) {
+    proxy_api_tests_pigeon_test_proxy_api_test_class_respond_error_call_flutter_echo_enum(
+        response_handle, "Internal Error", error->message, nullptr);
+    return;
+  }
+  if (proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_enum_response_is_error(
+          response)) {
+    proxy_api_tests_pigeon_test_proxy_api_test_class_respond_error_call_flutter_echo_enum(
+        response_handle,
+        proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_enum_response_get_error_code(
+            response),
+        proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_enum_response_get_error_message(
+            response),
+        proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_enum_response_get_error_details(
+            response));
+    return;
+  }
+
+  proxy_api_tests_pigeon_test_proxy_api_test_class_respond_call_flutter_echo_enum(
+      response_handle,
+      proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_enum_response_get_return_value(
+          response));
+}
+
+static void call_flutter_echo_enum(
+    GObject* pigeon_instance, ProxyApiTestsPigeonTestProxyApiTestEnum an_enum,
+    ProxyApiTestsPigeonTestProxyApiTestClassResponseHandle* response_handle,
+    gpointer user_data) {
+  ProxyApiTestImpls* self = PROXY_API_TEST_IMPLS(user_data);
+
+  proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_enum(
+      self->flutter_api, pigeon_instance, an_enum, self->cancellable,
+      flutter_echo_enum_cb, g_object_ref(response_handle));
+}
+
+static void flutter_echo_proxy_api_cb(
+    GObject* object, GAsyncResult* result, gpointer user_data) {
+  g_autoptr(ProxyApiTestsPigeonTestProxyApiTestClassResponseHandle)
+      response_handle =
+          PROXY_API_TESTS_PIGEON_TEST_PROXY_API_TEST_CLASS_RESPONSE_HANDLE(
+              user_data);
+
+  g_autoptr(GError) error = nullptr;
+  g_autoptr(
+      ProxyApiTestsPigeonTestProxyApiTestClassFlutterEchoProxyApiResponse)
+      response =
+          proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_proxy_api_finish(
+              PROXY_API_TESTS_PIGEON_TEST_PROXY_API_TEST_CLASS(object), result,
+              &error);
+  if (response == nullptr) {
+    proxy_api_tests_pigeon_test_proxy_api_test_class_respond_error_call_flutter_echo_proxy_api(
+        response_handle, "Internal Error", error->message, nullptr);
+    return;
+  }
+  if (proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_proxy_api_response_is_error(
+          response)) {
+    proxy_api_tests_pigeon_test_proxy_api_test_class_respond_error_call_flutter_echo_proxy_api(
+        response_handle,
+        proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_proxy_api_response_get_error_code(
+            response),
+        proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_proxy_api_response_get_error_message(
+            response),
+        proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_proxy_api_response_get_error_details(
+            response));
+    return;
+  }
+
+  proxy_api_tests_pigeon_test_proxy_api_test_class_respond_call_flutter_echo_proxy_api(
+      response_handle,
+      proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_proxy_api_response_get_return_value(
+          response));
+}
+
+static void call_flutter_echo_proxy_api(
+    GObject* pigeon_instance, GObject* a_proxy_api,
+    ProxyApiTestsPigeonTestProxyApiTestClassResponseHandle* response_handle,
+    gpointer user_data) {
+  ProxyApiTestImpls* self = PROXY_API_TEST_IMPLS(user_data);
+
+  proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_proxy_api(
+      self->flutter_api, pigeon_instance, a_proxy_api, self->cancellable,
+      flutter_echo_proxy_api_cb, g_object_ref(response_handle));
+}
+
+static void flutter_echo_nullable_bool_cb(
+    GObject* object, GAsyncResult* result, gpointer user_data) {
+  g_autoptr(ProxyApiTestsPigeonTestProxyApiTestClassResponseHandle)
+      response_handle =
+          PROXY_API_TESTS_PIGEON_TEST_PROXY_API_TEST_CLASS_RESPONSE_HANDLE(
+              user_data);
+
+  g_autoptr(GError) error = nullptr;
+  g_autoptr(
+      ProxyApiTestsPigeonTestProxyApiTestClassFlutterEchoNullableBoolResponse)
+      response =
+          proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_nullable_bool_finish(
+              PROXY_API_TESTS_PIGEON_TEST_PROXY_API_TEST_CLASS(object), result,
+              &error);
+  if (response == nullptr) {
+    proxy_api_tests_pigeon_test_proxy_api_test_class_respond_error_call_flutter_echo_nullable_bool(
+        response_handle, "Internal Error", error->message, nullptr);
+    return;
+  }
+  if (proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_nullable_bool_response_is_error(
+          response)) {
+    proxy_api_tests_pigeon_test_proxy_api_test_class_respond_error_call_flutter_echo_nullable_bool(
+        response_handle,
+        proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_nullable_bool_response_get_error_code(
+            response),
+        proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_nullable_bool_response_get_error_message(
+            response),
+        proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_nullable_bool_response_get_error_details(
+            response));
+    return;
+  }
+
+  proxy_api_tests_pigeon_test_proxy_api_test_class_respond_call_flutter_echo_nullable_bool(
+      response_handle,
+      proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_nullable_bool_response_get_return_value(
+          response));
+}
+
+static void call_flutter_echo_nullable_bool(
+    GObject* pigeon_instance, gboolean* a_bool,
+    ProxyApiTestsPigeonTestProxyApiTestClassResponseHandle* response_handle,
+    gpointer user_data) {
+  ProxyApiTestImpls* self = PROXY_API_TEST_IMPLS(user_data);
+
+  proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_nullable_bool(
+      self->flutter_api, pigeon_instance, a_bool, self->cancellable,
+      flutter_echo_nullable_bool_cb, g_object_ref(response_handle));
+}
+
+static void flutter_echo_nullable_int_cb(
+    GObject* object, GAsyncResult* result, gpointer user_data) {
+  g_autoptr(ProxyApiTestsPigeonTestProxyApiTestClassResponseHandle)
+      response_handle =
+          PROXY_API_TESTS_PIGEON_TEST_PROXY_API_TEST_CLASS_RESPONSE_HANDLE(
+              user_data);
+
+  g_autoptr(GError) error = nullptr;
+  g_autoptr(
+      ProxyApiTestsPigeonTestProxyApiTestClassFlutterEchoNullableIntResponse)
+      response =
+          proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_nullable_int_finish(
+              PROXY_API_TESTS_PIGEON_TEST_PROXY_API_TEST_CLASS(object), result,
+              &error);
+  if (response == nullptr) {
+    proxy_api_tests_pigeon_test_proxy_api_test_class_respond_error_call_flutter_echo_nullable_int(
+        response_handle, "Internal Error", error->message, nullptr);
+    return;
+  }
+  if (proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_nullable_int_response_is_error(
+          response)) {
+    proxy_api_tests_pigeon_test_proxy_api_test_class_respond_error_call_flutter_echo_nullable_int(
+        response_handle,
+        proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_nullable_int_response_get_error_code(
+            response),
+        proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_nullable_int_response_get_error_message(
+            response),
+        proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_nullable_int_response_get_error_details(
+            response));
+    return;
+  }
+
+  proxy_api_tests_pigeon_test_proxy_api_test_class_respond_call_flutter_echo_nullable_int(
+      response_handle,
+      proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_nullable_int_response_get_return_value(
+          response));
+}
+
+static void call_flutter_echo_nullable_int(
+    GObject* pigeon_instance, int64_t* an_int,
+    ProxyApiTestsPigeonTestProxyApiTestClassResponseHandle* response_handle,
+    gpointer user_data) {
+  ProxyApiTestImpls* self = PROXY_API_TEST_IMPLS(user_data);
+
+  proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_nullable_int(
+      self->flutter_api, pigeon_instance, an_int, self->cancellable,
+      flutter_echo_nullable_int_cb, g_object_ref(response_handle));
+}
+
+static void flutter_echo_nullable_double_cb(
+    GObject* object, GAsyncResult* result, gpointer user_data) {
+  g_autoptr(ProxyApiTestsPigeonTestProxyApiTestClassResponseHandle)
+      response_handle =
+          PROXY_API_TESTS_PIGEON_TEST_PROXY_API_TEST_CLASS_RESPONSE_HANDLE(
+              user_data);
+
+  g_autoptr(GError) error = nullptr;
+  g_autoptr(
+      ProxyApiTestsPigeonTestProxyApiTestClassFlutterEchoNullableDoubleResponse)
+      response =
+          proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_nullable_double_finish(
+              PROXY_API_TESTS_PIGEON_TEST_PROXY_API_TEST_CLASS(object), result,
+              &error);
+  if (response == nullptr) {
+    proxy_api_tests_pigeon_test_proxy_api_test_class_respond_error_call_flutter_echo_nullable_double(
+        response_handle, "Internal Error", error->message, nullptr);
+    return;
+  }
+  if (proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_nullable_double_response_is_error(
+          response)) {
+    proxy_api_tests_pigeon_test_proxy_api_test_class_respond_error_call_flutter_echo_nullable_double(
+        response_handle,
+        proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_nullable_double_response_get_error_code(
+            response),
+        proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_nullable_double_response_get_error_message(
+            response),
+        proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_nullable_double_response_get_error_details(
+            response));
+    return;
+  }
+
+  proxy_api_tests_pigeon_test_proxy_api_test_class_respond_call_flutter_echo_nullable_double(
+      response_handle,
+      proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_nullable_double_response_get_return_value(
+          response));
+}
+
+static void call_flutter_echo_nullable_double(
+    GObject* pigeon_instance, double* a_double,
+    ProxyApiTestsPigeonTestProxyApiTestClassResponseHandle* response_handle,
+    gpointer user_data) {
+  ProxyApiTestImpls* self = PROXY_API_TEST_IMPLS(user_data);
+
+  proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_nullable_double(
+      self->flutter_api, pigeon_instance, a_double, self->cancellable,
+      flutter_echo_nullable_double_cb, g_object_ref(response_handle));
+}
+
+static void flutter_echo_nullable_string_cb(
+    GObject* object, GAsyncResult* result, gpointer user_data) {
+  g_autoptr(ProxyApiTestsPigeonTestProxyApiTestClassResponseHandle)
+      response_handle =
+          PROXY_API_TESTS_PIGEON_TEST_PROXY_API_TEST_CLASS_RESPONSE_HANDLE(
+              user_data);
+
+  g_autoptr(GError) error = nullptr;
+  g_autoptr(
+      ProxyApiTestsPigeonTestProxyApiTestClassFlutterEchoNullableStringResponse)
+      response =
+          proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_nullable_string_finish(
+              PROXY_API_TESTS_PIGEON_TEST_PROXY_API_TEST_CLASS(object), result,
+              &error);
+  if (response == nullptr) {
+    proxy_api_tests_pigeon_test_proxy_api_test_class_respond_error_call_flutter_echo_nullable_string(
+        response_handle, "Internal Error", error->message, nullptr);
+    return;
+  }
+  if (proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_nullable_string_response_is_error(
+          response)) {
+    proxy_api_tests_pigeon_test_proxy_api_test_class_respond_error_call_flutter_echo_nullable_string(
+        response_handle,
+        proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_nullable_string_response_get_error_code(
+            response),
+        proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_nullable_string_response_get_error_message(
+            response),
+        proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_nullable_string_response_get_error_details(
+            response));
+    return;
+  }
+
+  proxy_api_tests_pigeon_test_proxy_api_test_class_respond_call_flutter_echo_nullable_string(
+      response_handle,
+      proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_nullable_string_response_get_return_value(
+          response));
+}
+
+static void call_flutter_echo_nullable_string(
+    GObject* pigeon_instance, const gchar* a_string,
+    ProxyApiTestsPigeonTestProxyApiTestClassResponseHandle* response_handle,
+    gpointer user_data) {
+  ProxyApiTestImpls* self = PROXY_API_TEST_IMPLS(user_data);
+
+  proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_nullable_string(
+      self->flutter_api, pigeon_instance, a_string, self->cancellable,
+      flutter_echo_nullable_string_cb, g_object_ref(response_handle));
+}
+
+static void flutter_echo_nullable_uint8_list_cb(
+    GObject* object, GAsyncResult* result, gpointer user_data) {
+  g_autoptr(ProxyApiTestsPigeonTestProxyApiTestClassResponseHandle)
+      response_handle =
+          PROXY_API_TESTS_PIGEON_TEST_PROXY_API_TEST_CLASS_RESPONSE_HANDLE(
+              user_data);
+
+  g_autoptr(GError) error = nullptr;
+  g_autoptr(
+      ProxyApiTestsPigeonTestProxyApiTestClassFlutterEchoNullableUint8ListResponse)
+      response =
+          proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_nullable_uint8_list_finish(
+              PROXY_API_TESTS_PIGEON_TEST_PROXY_API_TEST_CLASS(object), result,
+              &error);
+  if (response == nullptr) {
+    proxy_api_tests_pigeon_test_proxy_api_test_class_respond_error_call_flutter_echo_nullable_uint8_list(
+        response_handle, "Internal Error", error->message, nullptr);
+    return;
+  }
+  if (proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_nullable_uint8_list_response_is_error(
+          response)) {
+    proxy_api_tests_pigeon_test_proxy_api_test_class_respond_error_call_flutter_echo_nullable_uint8_list(
+        response_handle,
+        proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_nullable_uint8_list_response_get_error_code(
+            response),
+        proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_nullable_uint8_list_response_get_error_message(
+            response),
+        proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_nullable_uint8_list_response_get_error_details(
+            response));
+    return;
+  }
+
+  size_t return_value_length;
+  const uint8_t* return_value =
+      proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_nullable_uint8_list_response_get_return_value(
+          response, &return_value_length);
+  proxy_api_tests_pigeon_test_proxy_api_test_class_respond_call_flutter_echo_nullable_uint8_list(
+      response_handle, return_value, return_value_length);
+}
+
+static void call_flutter_echo_nullable_uint8_list(
+    GObject* pigeon_instance, const uint8_t* a_uint8_list,
+    size_t a_uint8_list_length,
+    ProxyApiTestsPigeonTestProxyApiTestClassResponseHandle* response_handle,
+    gpointer user_data) {
+  ProxyApiTestImpls* self = PROXY_API_TEST_IMPLS(user_data);
+
+  proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_nullable_uint8_list(
+      self->flutter_api, pigeon_instance, a_uint8_list, a_uint8_list_length,
+      self->cancellable, flutter_echo_nullable_uint8_list_cb,
+      g_object_ref(response_handle));
+}
+
+static void flutter_echo_nullable_list_cb(
+    GObject* object, GAsyncResult* result, gpointer user_data) {
+  g_autoptr(ProxyApiTestsPigeonTestProxyApiTestClassResponseHandle)
+      response_handle =
+          PROXY_API_TESTS_PIGEON_TEST_PROXY_API_TEST_CLASS_RESPONSE_HANDLE(
+              user_data);
+
+  g_autoptr(GError) error = nullptr;
+  g_autoptr(
+      ProxyApiTestsPigeonTestProxyApiTestClassFlutterEchoNullableListResponse)
+      response =
+          proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_nullable_list_finish(
+              PROXY_API_TESTS_PIGEON_TEST_PROXY_API_TEST_CLASS(object), result,
+              &error);
+  if (response == nullptr) {
+    proxy_api_tests_pigeon_test_proxy_api_test_class_respond_error_call_flutter_echo_nullable_list(
+        response_handle, "Internal Error", error->message, nullptr);
+    return;
+  }
+  if (proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_nullable_list_response_is_error(
+          response)) {
+    proxy_api_tests_pigeon_test_proxy_api_test_class_respond_error_call_flutter_echo_nullable_list(
+        response_handle,
+        proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_nullable_list_response_get_error_code(
+            response),
+        proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_nullable_list_response_get_error_message(
+            response),
+        proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_nullable_list_response_get_error_details(
+            response));
+    return;
+  }
+
+  proxy_api_tests_pigeon_test_proxy_api_test_class_respond_call_flutter_echo_nullable_list(
+      response_handle,
+      proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_nullable_list_response_get_return_value(
+          response));
+}
+
+static void call_flutter_echo_nullable_list(
+    GObject* pigeon_instance, FlValue* a_list,
+    ProxyApiTestsPigeonTestProxyApiTestClassResponseHandle* response_handle,
+    gpointer user_data) {
+  ProxyApiTestImpls* self = PROXY_API_TEST_IMPLS(user_data);
+
+  proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_nullable_list(
+      self->flutter_api, pigeon_instance, a_list, self->cancellable,
+      flutter_echo_nullable_list_cb, g_object_ref(response_handle));
+}
+
+static void flutter_echo_nullable_map_cb(
+    GObject* object, GAsyncResult* result, gpointer user_data) {
+  g_autoptr(ProxyApiTestsPigeonTestProxyApiTestClassResponseHandle)
+      response_handle =
+          PROXY_API_TESTS_PIGEON_TEST_PROXY_API_TEST_CLASS_RESPONSE_HANDLE(
+              user_data);
+
+  g_autoptr(GError) error = nullptr;
+  g_autoptr(
+      ProxyApiTestsPigeonTestProxyApiTestClassFlutterEchoNullableMapResponse)
+      response =
+          proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_nullable_map_finish(
+              PROXY_API_TESTS_PIGEON_TEST_PROXY_API_TEST_CLASS(object), result,
+              &error);
+  if (response == nullptr) {
+    proxy_api_tests_pigeon_test_proxy_api_test_class_respond_error_call_flutter_echo_nullable_map(
+        response_handle, "Internal Error", error->message, nullptr);
+    return;
+  }
+  if (proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_nullable_map_response_is_error(
+          response)) {
+    proxy_api_tests_pigeon_test_proxy_api_test_class_respond_error_call_flutter_echo_nullable_map(
+        response_handle,
+        proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_nullable_map_response_get_error_code(
+            response),
+        proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_nullable_map_response_get_error_message(
+            response),
+        proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_nullable_map_response_get_error_details(
+            response));
+    return;
+  }
+
+  proxy_api_tests_pigeon_test_proxy_api_test_class_respond_call_flutter_echo_nullable_map(
+      response_handle,
+      proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_nullable_map_response_get_return_value(
+          response));
+}
+
+static void call_flutter_echo_nullable_map(
+    GObject* pigeon_instance, FlValue* a_map,
+    ProxyApiTestsPigeonTestProxyApiTestClassResponseHandle* response_handle,
+    gpointer user_data) {
+  ProxyApiTestImpls* self = PROXY_API_TEST_IMPLS(user_data);
+
+  proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_nullable_map(
+      self->flutter_api, pigeon_instance, a_map, self->cancellable,
+      flutter_echo_nullable_map_cb, g_object_ref(response_handle));
+}
+
+static void flutter_echo_nullable_enum_cb(
+    GObject* object, GAsyncResult* result, gpointer user_data) {
+  g_autoptr(ProxyApiTestsPigeonTestProxyApiTestClassResponseHandle)
+      response_handle =
+          PROXY_API_TESTS_PIGEON_TEST_PROXY_API_TEST_CLASS_RESPONSE_HANDLE(
+              user_data);
+
+  g_autoptr(GError) error = nullptr;
+  g_autoptr(
+      ProxyApiTestsPigeonTestProxyApiTestClassFlutterEchoNullableEnumResponse)
+      response =
+          proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_nullable_enum_finish(
+              PROXY_API_TESTS_PIGEON_TEST_PROXY_API_TEST_CLASS(object), result,
+              &error);
+  if (response == nullptr) {
+    proxy_api_tests_pigeon_test_proxy_api_test_class_respond_error_call_flutter_echo_nullable_enum(
+        response_handle, "Internal Error", error->message, nullptr);
+    return;
+  }
+  if (proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_nullable_enum_response_is_error(
+          response)) {
+    proxy_api_tests_pigeon_test_proxy_api_test_class_respond_error_call_flutter_echo_nullable_enum(
+        response_handle,
+        proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_nullable_enum_response_get_error_code(
+            response),
+        proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_nullable_enum_response_get_error_message(
+            response),
+        proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_nullable_enum_response_get_error_details(
+            response));
+    return;
+  }
+
+  proxy_api_tests_pigeon_test_proxy_api_test_class_respond_call_flutter_echo_nullable_enum(
+      response_handle,
+      proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_nullable_enum_response_get_return_value(
+          response));
+}
+
+static void call_flutter_echo_nullable_enum(
+    GObject* pigeon_instance, ProxyApiTestsPigeonTestProxyApiTestEnum* an_enum,
+    ProxyApiTestsPigeonTestProxyApiTestClassResponseHandle* response_handle,
+    gpointer user_data) {
+  ProxyApiTestImpls* self = PROXY_API_TEST_IMPLS(user_data);
+
+  proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_nullable_enum(
+      self->flutter_api, pigeon_instance, an_enum, self->cancellable,
+      flutter_echo_nullable_enum_cb, g_object_ref(response_handle));
+}
+
+static void flutter_echo_nullable_proxy_api_cb(
+    GObject* object, GAsyncResult* result, gpointer user_data) {
+  g_autoptr(ProxyApiTestsPigeonTestProxyApiTestClassResponseHandle)
+      response_handle =
+          PROXY_API_TESTS_PIGEON_TEST_PROXY_API_TEST_CLASS_RESPONSE_HANDLE(
+              user_data);
+
+  g_autoptr(GError) error = nullptr;
+  g_autoptr(
+      ProxyApiTestsPigeonTestProxyApiTestClassFlutterEchoNullableProxyApiResponse)
+      response =
+          proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_nullable_proxy_api_finish(
+              PROXY_API_TESTS_PIGEON_TEST_PROXY_API_TEST_CLASS(object), result,
+              &error);
+  if (response == nullptr) {
+    proxy_api_tests_pigeon_test_proxy_api_test_class_respond_error_call_flutter_echo_nullable_proxy_api(
+        response_handle, "Internal Error", error->message, nullptr);
+    return;
+  }
+  if (proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_nullable_proxy_api_response_is_error(
+          response)) {
+    proxy_api_tests_pigeon_test_proxy_api_test_class_respond_error_call_flutter_echo_nullable_proxy_api(
+        response_handle,
+        proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_nullable_proxy_api_response_get_error_code(
+            response),
+        proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_nullable_proxy_api_response_get_error_message(
+            response),
+        proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_nullable_proxy_api_response_get_error_details(
+            response));
+    return;
+  }
+
+  proxy_api_tests_pigeon_test_proxy_api_test_class_respond_call_flutter_echo_nullable_proxy_api(
+      response_handle,
+      proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_nullable_proxy_api_response_get_return_value(
+          response));
+}
+
+static void call_flutter_echo_nullable_proxy_api(
+    GObject* pigeon_instance, GObject* a_proxy_api,
+    ProxyApiTestsPigeonTestProxyApiTestClassResponseHandle* response_handle,
+    gpointer user_data) {
+  ProxyApiTestImpls* self = PROXY_API_TEST_IMPLS(user_data);
+
+  proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_nullable_proxy_api(
+      self->flutter_api, pigeon_instance, a_proxy_api, self->cancellable,
+      flutter_echo_nullable_proxy_api_cb, g_object_ref(response_handle));
+}
+
+static void flutter_noop_async_cb(
+    GObject* object, GAsyncResult* result, gpointer user_data) {
+  g_autoptr(ProxyApiTestsPigeonTestProxyApiTestClassResponseHandle)
+      response_handle =
+          PROXY_API_TESTS_PIGEON_TEST_PROXY_API_TEST_CLASS_RESPONSE_HANDLE(
+              user_data);
+
+  g_autoptr(GError) error = nullptr;
+  g_autoptr(
+      ProxyApiTestsPigeonTestProxyApiTestClassFlutterNoopAsyncResponse)
+      response =
+          proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_noop_async_finish(
+              PROXY_API_TESTS_PIGEON_TEST_PROXY_API_TEST_CLASS(object), result,
+              &error);
+  if (response == nullptr) {
+    proxy_api_tests_pigeon_test_proxy_api_test_class_respond_error_call_flutter_noop_async(
+        response_handle, "Internal Error", error->message, nullptr);
+    return;
+  }
+  if (proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_noop_async_response_is_error(
+          response)) {
+    proxy_api_tests_pigeon_test_proxy_api_test_class_respond_error_call_flutter_noop_async(
+        response_handle,
+        proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_noop_async_response_get_error_code(
+            response),
+        proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_noop_async_response_get_error_message(
+            response),
+        proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_noop_async_response_get_error_details(
+            response));
+    return;
+  }
+
+  proxy_api_tests_pigeon_test_proxy_api_test_class_respond_call_flutter_noop_async(
+      response_handle);
+}
+
+static void call_flutter_noop_async(
+    GObject* pigeon_instance,
+    ProxyApiTestsPigeonTestProxyApiTestClassResponseHandle* response_handle,
+    gpointer user_data) {
+  ProxyApiTestImpls* self = PROXY_API_TEST_IMPLS(user_data);
+
+  proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_noop_async(
+      self->flutter_api, pigeon_instance, self->cancellable,
+      flutter_noop_async_cb, g_object_ref(response_handle));
+}
+
+static void flutter_echo_async_string_cb(
+    GObject* object, GAsyncResult* result, gpointer user_data) {
+  g_autoptr(ProxyApiTestsPigeonTestProxyApiTestClassResponseHandle)
+      response_handle =
+          PROXY_API_TESTS_PIGEON_TEST_PROXY_API_TEST_CLASS_RESPONSE_HANDLE(
+              user_data);
+
+  g_autoptr(GError) error = nullptr;
+  g_autoptr(
+      ProxyApiTestsPigeonTestProxyApiTestClassFlutterEchoAsyncStringResponse)
+      response =
+          proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_async_string_finish(
+              PROXY_API_TESTS_PIGEON_TEST_PROXY_API_TEST_CLASS(object), result,
+              &error);
+  if (response == nullptr) {
+    proxy_api_tests_pigeon_test_proxy_api_test_class_respond_error_call_flutter_echo_async_string(
+        response_handle, "Internal Error", error->message, nullptr);
+    return;
+  }
+  if (proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_async_string_response_is_error(
+          response)) {
+    proxy_api_tests_pigeon_test_proxy_api_test_class_respond_error_call_flutter_echo_async_string(
+        response_handle,
+        proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_async_string_response_get_error_code(
+            response),
+        proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_async_string_response_get_error_message(
+            response),
+        proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_async_string_response_get_error_details(
+            response));
+    return;
+  }
+
+  proxy_api_tests_pigeon_test_proxy_api_test_class_respond_call_flutter_echo_async_string(
+      response_handle,
+      proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_async_string_response_get_return_value(
+          response));
+}
+
+static void call_flutter_echo_async_string(
+    GObject* pigeon_instance, const gchar* a_string,
+    ProxyApiTestsPigeonTestProxyApiTestClassResponseHandle* response_handle,
+    gpointer user_data) {
+  ProxyApiTestImpls* self = PROXY_API_TEST_IMPLS(user_data);
+
+  proxy_api_tests_pigeon_test_proxy_api_test_class_flutter_echo_async_string(
+      self->flutter_api, pigeon_instance, a_string, self->cancellable,
+      flutter_echo_async_string_cb, g_object_ref(response_handle));
+}
+
+static GObject* super_class_default_constructor(GError** error,
+                                                gpointer user_data) {
+  return new_instance();
+}
+
+static ProxyApiTestsPigeonTestProxyApiSuperClassASuperMethodResponse*
+a_super_method(GObject* pigeon_instance, gpointer user_data) {
+  return proxy_api_tests_pigeon_test_proxy_api_super_class_a_super_method_response_new();
+}
+
+static GObject* class_with_api_requirement_default_constructor(
+    GError** error, gpointer user_data) {
+  return new_instance();
+}
+
+static ProxyApiTestsPigeonTestClassWithApiRequirementAMethodResponse* a_method(
+    GObject* pigeon_instance, gpointer user_data) {
+  return proxy_api_tests_pigeon_test_class_with_api_requirement_a_method_response_new();
+}
+
+static ProxyApiTestsPigeonTestProxyApiTestClassVTable test_class_vtable = {
+    .pigeon_default_constructor = test_class_default_constructor,
+    .named_constructor = test_class_named_constructor,
+    .attached_field = attached_field,
+    .static_attached_field = static_attached_field,
+    .noop = noop,
+    .throw_error = throw_error,
+    .throw_error_from_void = throw_error_from_void,
+    .throw_flutter_error = throw_flutter_error,
+    .echo_int = echo_int,
+    .echo_double = echo_double,
+    .echo_bool = echo_bool,
+    .echo_string = echo_string,
+    .echo_uint8_list = echo_uint8_list,
+    .echo_object = echo_object,
+    .echo_list = echo_list,
+    .echo_proxy_api_list = echo_proxy_api_list,
+    .echo_map = echo_map,
+    .echo_proxy_api_map = echo_proxy_api_map,
+    .echo_enum = echo_enum,
+    .echo_proxy_api = echo_proxy_api,
+    .echo_nullable_int = echo_nullable_int,
+    .echo_nullable_double = echo_nullable_double,
+    .echo_nullable_bool = echo_nullable_bool,
+    .echo_nullable_string = echo_nullable_string,
+    .echo_nullable_uint8_list = echo_nullable_uint8_list,
+    .echo_nullable_object = echo_nullable_object,
+    .echo_nullable_list = echo_nullable_list,
+    .echo_nullable_map = echo_nullable_map,
+    .echo_nullable_enum = echo_nullable_enum,
+    .echo_nullable_proxy_api = echo_nullable_proxy_api,
+    .noop_async = noop_async,
+    .echo_async_int = echo_async_int,
+    .echo_async_double = echo_async_double,
+    .echo_async_bool = echo_async_bool,
+    .echo_async_string = echo_async_string,
+    .echo_async_uint8_list = echo_async_uint8_list,
+    .echo_async_object = echo_async_object,
+    .echo_async_list = echo_async_list,
+    .echo_async_map = echo_async_map,
+    .echo_async_enum = echo_async_enum,
+    .throw_async_error = throw_async_error,
+    .throw_async_error_from_void = throw_async_error_from_void,
+    .throw_async_flutter_error = throw_async_flutter_error,
+    .echo_async_nullable_int = echo_async_nullable_int,
+    .echo_async_nullable_double = echo_async_nullable_double,
+    .echo_async_nullable_bool = echo_async_nullable_bool,
+    .echo_async_nullable_string = echo_async_nullable_string,
+    .echo_async_nullable_uint8_list = echo_async_nullable_uint8_list,
+    .echo_async_nullable_object = echo_async_nullable_object,
+    .echo_async_nullable_list = echo_async_nullable_list,
+    .echo_async_nullable_map = echo_async_nullable_map,
+    .echo_async_nullable_enum = echo_async_nullable_enum,
+    .static_noop = static_noop,
+    .echo_static_string = echo_static_string,
+    .static_async_noop = static_async_noop,
+    .call_flutter_noop = call_flutter_noop,
+    .call_flutter_throw_error = call_flutter_throw_error,
+    .call_flutter_throw_error_from_void = call_flutter_throw_error_from_void,
+    .call_flutter_echo_bool = call_flutter_echo_bool,
+    .call_flutter_echo_int = call_flutter_echo_int,
+    .call_flutter_echo_double = call_flutter_echo_double,
+    .call_flutter_echo_string = call_flutter_echo_string,
+    .call_flutter_echo_uint8_list = call_flutter_echo_uint8_list,
+    .call_flutter_echo_list = call_flutter_echo_list,
+    .call_flutter_echo_proxy_api_list = call_flutter_echo_proxy_api_list,
+    .call_flutter_echo_map = call_flutter_echo_map,
+    .call_flutter_echo_proxy_api_map = call_flutter_echo_proxy_api_map,
+    .call_flutter_echo_enum = call_flutter_echo_enum,
+    .call_flutter_echo_proxy_api = call_flutter_echo_proxy_api,
+    .call_flutter_echo_nullable_bool = call_flutter_echo_nullable_bool,
+    .call_flutter_echo_nullable_int = call_flutter_echo_nullable_int,
+    .call_flutter_echo_nullable_double = call_flutter_echo_nullable_double,
+    .call_flutter_echo_nullable_string = call_flutter_echo_nullable_string,
+    .call_flutter_echo_nullable_uint8_list =
+        call_flutter_echo_nullable_uint8_list,
+    .call_flutter_echo_nullable_list = call_flutter_echo_nullable_list,
+    .call_flutter_echo_nullable_map = call_flutter_echo_nullable_map,
+    .call_flutter_echo_nullable_enum = call_flutter_echo_nullable_enum,
+    .call_flutter_echo_nullable_proxy_api =
+        call_flutter_echo_nullable_proxy_api,
+    .call_flutter_noop_async = call_flutter_noop_async,
+    .call_flutter_echo_async_string = call_flutter_echo_async_string};
+
+static ProxyApiTestsPigeonTestProxyApiSuperClassVTable super_class_vtable = {
+    .pigeon_default_constructor = super_class_default_constructor,
+    .a_super_method = a_super_method};
+
+static ProxyApiTestsPigeonTestClassWithApiRequirementVTable
+    class_with_api_requirement_vtable = {
+        .pigeon_default_constructor =
+            class_with_api_requirement_default_constructor,
+        .a_method = a_method};
+
+static void proxy_api_test_impls_dispose(GObject* object) {
+  ProxyApiTestImpls* self = PROXY_API_TEST_IMPLS(object);
+
+  g_cancellable_cancel(self->cancellable);
+
+  proxy_api_tests_pigeon_test_proxy_api_test_class_clear_method_handlers(
+      self->messenger);
+  proxy_api_tests_pigeon_test_proxy_api_super_class_clear_method_handlers(
+      self->messenger);
+  proxy_api_tests_pigeon_test_class_with_api_requirement_clear_method_handlers(
+      self->messenger);
+
+  g_clear_object(&self->flutter_api);
+  g_clear_object(&self->instance_manager);
+  g_clear_object(&self->cancellable);
+
+  G_OBJECT_CLASS(proxy_api_test_impls_parent_class)->dispose(object);
+}
+
+static void proxy_api_test_impls_class_init(ProxyApiTestImplsClass* klass) {
+  G_OBJECT_CLASS(klass)->dispose = proxy_api_test_impls_dispose;
+}
+
+static void proxy_api_test_impls_init(ProxyApiTestImpls* self) {
+  self->cancellable = g_cancellable_new();
+}
+
+ProxyApiTestImpls* proxy_api_test_impls_new(FlBinaryMessenger* messenger) {
+  ProxyApiTestImpls* self = PROXY_API_TEST_IMPLS(
+      g_object_new(proxy_api_test_impls_get_type(), nullptr));
+
+  self->messenger = messenger;
+  self->instance_manager =
+      proxy_api_tests_pigeon_test_pigeon_instance_manager_new(messenger);
+  proxy_api_tests_pigeon_test_proxy_api_test_class_set_method_handlers(
+      messenger, self->instance_manager, &test_class_vtable, self, nullptr);
+  proxy_api_tests_pigeon_test_proxy_api_super_class_set_method_handlers(
+      messenger, self->instance_manager, &super_class_vtable, self, nullptr);
+  proxy_api_tests_pigeon_test_class_with_api_requirement_set_method_handlers(
+      messenger, self->instance_manager, &class_with_api_requirement_vtable,
+      self, nullptr);
+  self->flutter_api = proxy_api_tests_pigeon_test_proxy_api_test_class_new(
+      messenger, self->instance_manager);
+
+  return self;
+}
@@ -0,0 +1,21 @@
+// Copyright 2013 The Flutter Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef PROXY_API_TEST_IMPLS_H_
+#define PROXY_API_TEST_IMPLS_H_
+
+#include <flutter_linux/flutter_linux.h>
+
+G_BEGIN_DECLS
+
+G_DECLARE_FINAL_TYPE(ProxyApiTestImpls, proxy_api_test_impls, PROXY_API_TEST,
+                     IMPLS, GObject)
+
+// Handles the messages of the ProxyApis in proxy_api_tests.dart on
+// |messenger|. The handlers are cleared when the returned object is disposed.
+ProxyApiTestImpls* proxy_api_test_impls_new(FlBinaryMessenger* messenger);
+
+G_END_DECLS
+
+#endif  // PROXY_API_TEST_IMPLS_H_
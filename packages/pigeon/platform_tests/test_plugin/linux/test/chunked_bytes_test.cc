@@ -0,0 +1,190 @@
+// Copyright 2013 The Flutter Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <gtest/gtest.h>
+
+#include "pigeon/chunked_bytes.gen.h"
+#include "test/utils/fake_host_messenger.h"
+
+static constexpr char kEchoBytesChannelName[] =
+    "dev.flutter.pigeon.pigeon_integration_tests.ChunkedBytesHostApi."
+    "echoBytes";
+static constexpr char kCountBytesChannelName[] =
+    "dev.flutter.pigeon.pigeon_integration_tests.ChunkedBytesHostApi."
+    "countBytes";
+static constexpr char kEchoBytesChunksChannelName[] =
+    "dev.flutter.pigeon.pigeon_integration_tests.ChunkedBytesHostApi."
+    "echoBytes.chunks";
+static constexpr char kArgumentChunksChannelName[] = "argument.chunks";
+
+// The size of the chunks that the host reads its arguments in.
+static constexpr gsize kHostChunkSize = 3;
+
+static const uint8_t kBytes[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+
+// Acts as the Dart side of a streamed argument, serving kBytes.
+typedef struct {
+  size_t offset;
+  int requests;
+} DartByteServer;
+
+static FlValue* serve_chunk(const gchar* channel, FlValue* message,
+                            gpointer user_data) {
+  DartByteServer* server = static_cast<DartByteServer*>(user_data);
+  EXPECT_STREQ(channel, kArgumentChunksChannelName);
+  server->requests++;
+  size_t size = MIN(static_cast<size_t>(fl_value_get_int(message)),
+                    sizeof(kBytes) - server->offset);
+  FlValue* chunk = fl_value_new_uint8_list(kBytes + server->offset, size);
+  server->offset += size;
+  return chunk;
+}
+
+// A read of a streamed argument by count_bytes.
+typedef struct {
+  GInputStream* stream;
+  ChunkedBytesPigeonTestChunkedBytesHostApiResponseHandle* response_handle;
+  int64_t count;
+} CountRead;
+
+static void count_read_cb(GObject* object, GAsyncResult* result,
+                          gpointer user_data) {
+  CountRead* read = static_cast<CountRead*>(user_data);
+  g_autoptr(GError) error = nullptr;
+  g_autoptr(GBytes) chunk =
+      g_input_stream_read_bytes_finish(read->stream, result, &error);
+  if (chunk != nullptr && g_bytes_get_size(chunk) > 0) {
+    read->count += g_bytes_get_size(chunk);
+    g_input_stream_read_bytes_async(read->stream, kHostChunkSize,
+                                    G_PRIORITY_DEFAULT, nullptr, count_read_cb,
+                                    read);
+    return;
+  }
+
+  if (chunk == nullptr) {
+    chunked_bytes_pigeon_test_chunked_bytes_host_api_respond_error_count_bytes(
+        read->response_handle, "read-error", error->message, nullptr);
+  } else {
+    chunked_bytes_pigeon_test_chunked_bytes_host_api_respond_count_bytes(
+        read->response_handle, read->count);
+  }
+  g_object_unref(read->stream);
+  g_object_unref(read->response_handle);
+  g_free(read);
+}
+
+static void count_bytes(
+    GInputStream* data,
+    ChunkedBytesPigeonTestChunkedBytesHostApiResponseHandle* response_handle,
+    gpointer user_data) {
+  CountRead* read = g_new0(CountRead, 1);
+  read->stream = G_INPUT_STREAM(g_object_ref(data));
+  read->response_handle =
+      CHUNKED_BYTES_PIGEON_TEST_CHUNKED_BYTES_HOST_API_RESPONSE_HANDLE(
+          g_object_ref(response_handle));
+  g_input_stream_read_bytes_async(read->stream, kHostChunkSize,
+                                  G_PRIORITY_DEFAULT, nullptr, count_read_cb,
+                                  read);
+}
+
+static void echo_bytes(
+    GInputStream* data,
+    ChunkedBytesPigeonTestChunkedBytesHostApiResponseHandle* response_handle,
+    gpointer user_data) {
+  // The argument is streamed straight back as it is read.
+  chunked_bytes_pigeon_test_chunked_bytes_host_api_respond_echo_bytes(
+      response_handle, data);
+}
+
+static ChunkedBytesPigeonTestChunkedBytesHostApiVTable vtable = {
+    .echo_bytes = echo_bytes, .count_bytes = count_bytes};
+
+static void reply_cb(FlValue* reply, gpointer user_data) {
+  FlValue** result = reinterpret_cast<FlValue**>(user_data);
+  *result = fl_value_ref(reply);
+}
+
+// Sends |message| to the host method on |channel|, and returns the reply once
+// the main loop has delivered it, or nullptr if no reply was sent.
+static FlValue* send_message(FakeHostMessenger* messenger,
+                             const gchar* channel, FlValue* message) {
+  FlValue* result = nullptr;
+  fake_host_messenger_send_host_message(messenger, channel, message, reply_cb,
+                                        &result);
+  while (result == nullptr && g_main_context_iteration(nullptr, FALSE)) {
+  }
+  return result;
+}
+
+static FlValue* argument_message() {
+  FlValue* message = fl_value_new_list();
+  fl_value_append_take(message, fl_value_new_string(kArgumentChunksChannelName));
+  return message;
+}
+
+static FakeHostMessenger* create_messenger(DartByteServer* server) {
+  g_autoptr(FlStandardMessageCodec) codec = fl_standard_message_codec_new();
+  FakeHostMessenger* messenger =
+      fake_host_messenger_new(FL_MESSAGE_CODEC(codec));
+  fake_host_messenger_set_dart_message_responder(messenger, serve_chunk,
+                                                 server);
+  chunked_bytes_pigeon_test_chunked_bytes_host_api_set_method_handlers(
+      FL_BINARY_MESSENGER(messenger), nullptr, &vtable, nullptr, nullptr);
+  return messenger;
+}
+
+TEST(ChunkedBytes, HostApiReadsArgumentInChunks) {
+  DartByteServer server = {};
+  g_autoptr(FakeHostMessenger) messenger = create_messenger(&server);
+  g_autoptr(FlValue) message = argument_message();
+
+  g_autoptr(FlValue) reply =
+      send_message(messenger, kCountBytesChannelName, message);
+
+  ASSERT_NE(reply, nullptr);
+  ASSERT_EQ(fl_value_get_length(reply), 1u);
+  EXPECT_EQ(fl_value_get_int(fl_value_get_list_value(reply, 0)), 10);
+  // Four chunks of at most three bytes, and the empty chunk at the end.
+  EXPECT_EQ(server.requests, 5);
+}
+
+TEST(ChunkedBytes, HostApiReturnsStream) {
+  DartByteServer server = {};
+  g_autoptr(FakeHostMessenger) messenger = create_messenger(&server);
+  g_autoptr(FlValue) message = argument_message();
+
+  g_autoptr(FlValue) reply =
+      send_message(messenger, kEchoBytesChannelName, message);
+  ASSERT_NE(reply, nullptr);
+  ASSERT_EQ(fl_value_get_length(reply), 1u);
+  int64_t stream_id = fl_value_get_int(fl_value_get_list_value(reply, 0));
+
+  g_autoptr(GByteArray) echoed = g_byte_array_new();
+  g_autoptr(FlValue) request = fl_value_new_list();
+  fl_value_append_take(request, fl_value_new_int(stream_id));
+  fl_value_append_take(request, fl_value_new_int(4));
+  while (true) {
+    g_autoptr(FlValue) chunk_reply =
+        send_message(messenger, kEchoBytesChunksChannelName, request);
+    ASSERT_NE(chunk_reply, nullptr);
+    ASSERT_EQ(fl_value_get_length(chunk_reply), 1u);
+    FlValue* chunk = fl_value_get_list_value(chunk_reply, 0);
+    EXPECT_LE(fl_value_get_length(chunk), 4u);
+    if (fl_value_get_length(chunk) == 0) {
+      break;
+    }
+    g_byte_array_append(echoed, fl_value_get_uint8_list(chunk),
+                        fl_value_get_length(chunk));
+  }
+  ASSERT_EQ(echoed->len, sizeof(kBytes));
+  EXPECT_EQ(memcmp(echoed->data, kBytes, sizeof(kBytes)), 0);
+
+  // The stream is released once it has been read to the end.
+  g_autoptr(FlValue) error_reply =
+      send_message(messenger, kEchoBytesChunksChannelName, request);
+  ASSERT_NE(error_reply, nullptr);
+  ASSERT_EQ(fl_value_get_length(error_reply), 3u);
+  EXPECT_STREQ(fl_value_get_string(fl_value_get_list_value(error_reply, 0)),
+               "unknown-stream");
+}
@@ -0,0 +1,192 @@
+// Copyright 2013 The Flutter Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <gtest/gtest.h>
+
+#include "pigeon/columnar.gen.h"
+#include "test/utils/fake_host_messenger.h"
+
+static constexpr char kEchoPointsChannelName[] =
+    "dev.flutter.pigeon.pigeon_integration_tests.ColumnarHostApi.echoPoints";
+static constexpr char kSumValidValuesChannelName[] =
+    "dev.flutter.pigeon.pigeon_integration_tests.ColumnarHostApi."
+    "sumValidValues";
+static constexpr char kEchoPointsAsyncChannelName[] =
+    "dev.flutter.pigeon.pigeon_integration_tests.ColumnarHostApi."
+    "echoPointsAsync";
+
+static ColumnarPigeonTestColumnarHostApiEchoPointsResponse* echo_points(
+    ColumnarPigeonTestTracePointColumns* points, gpointer user_data) {
+  return columnar_pigeon_test_columnar_host_api_echo_points_response_new(
+      points);
+}
+
+static ColumnarPigeonTestColumnarHostApiSumValidValuesResponse*
+sum_valid_values(ColumnarPigeonTestTracePointColumns* points,
+                 gpointer user_data) {
+  size_t length = columnar_pigeon_test_trace_point_columns_get_length(points);
+  const double* values =
+      columnar_pigeon_test_trace_point_columns_get_value(points);
+  const uint8_t* is_valid =
+      columnar_pigeon_test_trace_point_columns_get_is_valid(points);
+  double sum = 0.0;
+  for (size_t i = 0; i < length; i++) {
+    if (is_valid[i]) {
+      sum += values[i];
+    }
+  }
+  return columnar_pigeon_test_columnar_host_api_sum_valid_values_response_new(
+      sum);
+}
+
+static void echo_points_async(
+    ColumnarPigeonTestTracePointColumns* points,
+    ColumnarPigeonTestColumnarHostApiResponseHandle* response_handle,
+    gpointer user_data) {
+  columnar_pigeon_test_columnar_host_api_respond_echo_points_async(
+      response_handle, points);
+}
+
+static ColumnarPigeonTestColumnarHostApiVTable vtable = {
+    .echo_points = echo_points,
+    .sum_valid_values = sum_valid_values,
+    .echo_points_async = echo_points_async};
+
+static const int64_t kTimestamps[] = {10, 20, 30};
+static const double kValues[] = {0.5, 1.5, 2.5};
+static const uint8_t kIsValid[] = {1, 0, 1};
+static const gchar* const kLabels[] = {"a", "b", "c"};
+
+// Returns the columns Dart sends for a list of three points.
+static FlValue* points_columns() {
+  FlValue* columns = fl_value_new_list();
+  fl_value_append_take(columns, fl_value_new_int64_list(kTimestamps, 3));
+  fl_value_append_take(columns, fl_value_new_float_list(kValues, 3));
+  fl_value_append_take(columns, fl_value_new_uint8_list(kIsValid, 3));
+  FlValue* labels = fl_value_new_list();
+  for (size_t i = 0; i < 3; i++) {
+    fl_value_append_take(labels, fl_value_new_string(kLabels[i]));
+  }
+  fl_value_append_take(columns, labels);
+  return columns;
+}
+
+static void reply_cb(FlValue* reply, gpointer user_data) {
+  FlValue** result = reinterpret_cast<FlValue**>(user_data);
+  *result = fl_value_ref(fl_value_get_list_value(reply, 0));
+}
+
+// Sends [columns] as the only argument of the host method on [channel], and
+// returns the result of the reply, or nullptr if no reply was sent.
+static FlValue* send_points(FakeHostMessenger* messenger, const gchar* channel,
+                            FlValue* columns) {
+  g_autoptr(FlValue) message = fl_value_new_list();
+  fl_value_append(message, columns);
+  FlValue* result = nullptr;
+  fake_host_messenger_send_host_message(messenger, channel, message, reply_cb,
+                                        &result);
+  return result;
+}
+
+static FakeHostMessenger* create_messenger() {
+  g_autoptr(FlStandardMessageCodec) codec = fl_standard_message_codec_new();
+  FakeHostMessenger* messenger =
+      fake_host_messenger_new(FL_MESSAGE_CODEC(codec));
+  columnar_pigeon_test_columnar_host_api_set_method_handlers(
+      FL_BINARY_MESSENGER(messenger), nullptr, &vtable, nullptr, nullptr);
+  return messenger;
+}
+
+TEST(Columnar, HostApiReadsColumns) {
+  g_autoptr(FakeHostMessenger) messenger = create_messenger();
+  g_autoptr(FlValue) columns = points_columns();
+
+  g_autoptr(FlValue) result =
+      send_points(messenger, kSumValidValuesChannelName, columns);
+
+  ASSERT_NE(result, nullptr);
+  EXPECT_EQ(fl_value_get_float(result), 3.0);
+}
+
+TEST(Columnar, HostApiReturnsColumns) {
+  g_autoptr(FakeHostMessenger) messenger = create_messenger();
+  g_autoptr(FlValue) columns = points_columns();
+
+  g_autoptr(FlValue) result =
+      send_points(messenger, kEchoPointsChannelName, columns);
+  ASSERT_NE(result, nullptr);
+  EXPECT_TRUE(fl_value_equal(result, columns));
+
+  g_autoptr(FlValue) async_result =
+      send_points(messenger, kEchoPointsAsyncChannelName, columns);
+  ASSERT_NE(async_result, nullptr);
+  EXPECT_TRUE(fl_value_equal(async_result, columns));
+}
+
+TEST(Columnar, EmptyList) {
+  g_autoptr(FakeHostMessenger) messenger = create_messenger();
+  g_autoptr(ColumnarPigeonTestTracePointColumns) points =
+      columnar_pigeon_test_trace_point_columns_new(nullptr, nullptr, nullptr,
+                                                   nullptr, 0);
+  EXPECT_EQ(columnar_pigeon_test_trace_point_columns_get_length(points), 0u);
+
+  g_autoptr(FlValue) columns = fl_value_new_list();
+  fl_value_append_take(columns, fl_value_new_int64_list(nullptr, 0));
+  fl_value_append_take(columns, fl_value_new_float_list(nullptr, 0));
+  fl_value_append_take(columns, fl_value_new_uint8_list(nullptr, 0));
+  fl_value_append_take(columns, fl_value_new_list());
+  g_autoptr(FlValue) result =
+      send_points(messenger, kSumValidValuesChannelName, columns);
+  ASSERT_NE(result, nullptr);
+  EXPECT_EQ(fl_value_get_float(result), 0.0);
+}
+
+TEST(Columnar, ConstructedColumns) {
+  g_autoptr(ColumnarPigeonTestTracePointColumns) points =
+      columnar_pigeon_test_trace_point_columns_new(kTimestamps, kValues,
+                                                   kIsValid, kLabels, 3);
+
+  ASSERT_EQ(columnar_pigeon_test_trace_point_columns_get_length(points), 3u);
+  const int64_t* timestamps =
+      columnar_pigeon_test_trace_point_columns_get_timestamp(points);
+  EXPECT_NE(timestamps, kTimestamps);
+  EXPECT_EQ(timestamps[2], 30);
+  EXPECT_EQ(columnar_pigeon_test_trace_point_columns_get_value(points)[1], 1.5);
+  EXPECT_EQ(columnar_pigeon_test_trace_point_columns_get_is_valid(points)[1],
+            0);
+  EXPECT_STREQ(columnar_pigeon_test_trace_point_columns_get_label(points, 2),
+               "c");
+}
+
+static void dart_message_cb(const gchar* channel, GBytes* message,
+                            gpointer user_data) {
+  FlValue** sent_columns = reinterpret_cast<FlValue**>(user_data);
+  g_autoptr(FlStandardMessageCodec) codec = fl_standard_message_codec_new();
+  g_autoptr(FlValue) args = fl_message_codec_decode_message(
+      FL_MESSAGE_CODEC(codec), message, nullptr);
+  ASSERT_NE(args, nullptr);
+  *sent_columns = fl_value_ref(fl_value_get_list_value(args, 0));
+}
+
+TEST(Columnar, FlutterApiSendsColumns) {
+  g_autoptr(FlStandardMessageCodec) codec = fl_standard_message_codec_new();
+  g_autoptr(FakeHostMessenger) messenger =
+      fake_host_messenger_new(FL_MESSAGE_CODEC(codec));
+  g_autoptr(FlValue) sent_columns = nullptr;
+  fake_host_messenger_set_dart_message_handler(messenger, dart_message_cb,
+                                               &sent_columns);
+  g_autoptr(ColumnarPigeonTestColumnarFlutterApi) api =
+      columnar_pigeon_test_columnar_flutter_api_new(
+          FL_BINARY_MESSENGER(messenger), nullptr);
+  g_autoptr(ColumnarPigeonTestTracePointColumns) points =
+      columnar_pigeon_test_trace_point_columns_new(kTimestamps, kValues,
+                                                   kIsValid, kLabels, 3);
+
+  columnar_pigeon_test_columnar_flutter_api_echo_points(api, points, nullptr,
+                                                        nullptr, nullptr);
+
+  ASSERT_NE(sent_columns, nullptr);
+  g_autoptr(FlValue) columns = points_columns();
+  EXPECT_TRUE(fl_value_equal(sent_columns, columns));
+}
@@ -237,6 +237,94 @@ TEST(Equality, SignedZeroMapValue) {
             core_tests_pigeon_test_all_nullable_types_hash(all2));
 }
 
+static CoreTestsPigeonTestAllNullableTypes* create_all_nullable_types_with_map(
+    FlValue* map) {
+  return core_tests_pigeon_test_all_nullable_types_new(
+      nullptr, nullptr, nullptr, nullptr, nullptr, 0, nullptr, 0, nullptr, 0,
+      nullptr, 0, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,
+      nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,
+      map, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr);
+}
+
+// Creates a map of [size] int keys to string values, inserted in reverse
+// order if [reversed] is true.
+static FlValue* create_int_map(int64_t size, bool reversed) {
+  FlValue* map = fl_value_new_map();
+  for (int64_t i = 0; i < size; i++) {
+    int64_t key = reversed ? size - 1 - i : i;
+    g_autofree gchar* value = g_strdup_printf("%" G_GINT64_FORMAT, key);
+    fl_value_set_take(map, fl_value_new_int(key), fl_value_new_string(value));
+  }
+  return map;
+}
+
+class MapEquality : public ::testing::TestWithParam<int64_t> {};
+
+TEST_P(MapEquality, EqualInAnyOrder) {
+  g_autoptr(FlValue) map1 = create_int_map(GetParam(), false);
+  g_autoptr(FlValue) map2 = create_int_map(GetParam(), true);
+  g_autoptr(CoreTestsPigeonTestAllNullableTypes) all1 =
+      create_all_nullable_types_with_map(map1);
+  g_autoptr(CoreTestsPigeonTestAllNullableTypes) all2 =
+      create_all_nullable_types_with_map(map2);
+
+  EXPECT_TRUE(core_tests_pigeon_test_all_nullable_types_equals(all1, all2));
+  EXPECT_EQ(core_tests_pigeon_test_all_nullable_types_hash(all1),
+            core_tests_pigeon_test_all_nullable_types_hash(all2));
+}
+
+TEST_P(MapEquality, DifferentValue) {
+  g_autoptr(FlValue) map1 = create_int_map(GetParam(), false);
+  g_autoptr(FlValue) map2 = create_int_map(GetParam(), true);
+  fl_value_set_take(map2, fl_value_new_int(GetParam() / 2),
+                    fl_value_new_string("different"));
+  g_autoptr(CoreTestsPigeonTestAllNullableTypes) all1 =
+      create_all_nullable_types_with_map(map1);
+  g_autoptr(CoreTestsPigeonTestAllNullableTypes) all2 =
+      create_all_nullable_types_with_map(map2);
+
+  EXPECT_FALSE(core_tests_pigeon_test_all_nullable_types_equals(all1, all2));
+}
+
+TEST_P(MapEquality, DifferentKey) {
+  g_autoptr(FlValue) map1 = create_int_map(GetParam(), false);
+  g_autoptr(FlValue) map2 = create_int_map(GetParam() - 1, true);
+  fl_value_set_take(map2, fl_value_new_int(-1),
+                    fl_value_new_string("missing"));
+  g_autoptr(CoreTestsPigeonTestAllNullableTypes) all1 =
+      create_all_nullable_types_with_map(map1);
+  g_autoptr(CoreTestsPigeonTestAllNullableTypes) all2 =
+      create_all_nullable_types_with_map(map2);
+
+  EXPECT_FALSE(core_tests_pigeon_test_all_nullable_types_equals(all1, all2));
+}
+
+// Maps of up to eight entries are compared pair by pair, larger ones using a
+// hash table, so both sides of that boundary are covered.
+INSTANTIATE_TEST_SUITE_P(Equality, MapEquality,
+                         ::testing::Values(8, 9, 10, 1000));
+
+TEST(Equality, CachedHash) {
+  g_autoptr(FlValue) map1 = create_int_map(100, false);
+  g_autoptr(FlValue) map2 = create_int_map(100, true);
+  g_autoptr(FlValue) map3 = create_int_map(99, false);
+  g_autoptr(CoreTestsPigeonTestAllNullableTypes) all1 =
+      create_all_nullable_types_with_map(map1);
+  g_autoptr(CoreTestsPigeonTestAllNullableTypes) all2 =
+      create_all_nullable_types_with_map(map2);
+  g_autoptr(CoreTestsPigeonTestAllNullableTypes) all3 =
+      create_all_nullable_types_with_map(map3);
+
+  guint hash = core_tests_pigeon_test_all_nullable_types_hash(all1);
+  EXPECT_EQ(core_tests_pigeon_test_all_nullable_types_hash(all1), hash);
+  EXPECT_EQ(core_tests_pigeon_test_all_nullable_types_hash(all2), hash);
+  EXPECT_NE(core_tests_pigeon_test_all_nullable_types_hash(all3), hash);
+
+  // Equality is unchanged once the hash codes have been cached.
+  EXPECT_TRUE(core_tests_pigeon_test_all_nullable_types_equals(all1, all2));
+  EXPECT_FALSE(core_tests_pigeon_test_all_nullable_types_equals(all1, all3));
+}
+
 TEST(Equality, ToStringSnapshot) {
   g_autoptr(CoreTestsPigeonTestAllNullableTypes) empty_obj =
       create_empty_all_nullable_types();
@@ -0,0 +1,283 @@
+// Copyright 2013 The Flutter Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "pigeon/event_channel_tests.gen.h"
+#include "test/utils/fake_host_messenger.h"
+
+static constexpr char kStreamIntsChannelName[] =
+    "dev.flutter.pigeon.pigeon_integration_tests.EventChannelMethods."
+    "streamInts";
+static constexpr char kStreamEventsChannelName[] =
+    "dev.flutter.pigeon.pigeon_integration_tests.EventChannelMethods."
+    "streamEvents";
+
+// The sinks passed to the stream handlers.
+typedef struct {
+  EventChannelTestsPigeonTestEventChannelMethodsStreamIntsEventSink* ints_sink;
+  EventChannelTestsPigeonTestEventChannelMethodsStreamEventsEventSink*
+      events_sink;
+  int cancel_count;
+} StreamHandlersData;
+
+static void stream_ints_on_listen(
+    EventChannelTestsPigeonTestEventChannelMethodsStreamIntsEventSink* sink,
+    gpointer user_data) {
+  StreamHandlersData* data = static_cast<StreamHandlersData*>(user_data);
+  g_set_object(&data->ints_sink, sink);
+}
+
+static void stream_ints_on_cancel(gpointer user_data) {
+  StreamHandlersData* data = static_cast<StreamHandlersData*>(user_data);
+  data->cancel_count++;
+  g_clear_object(&data->ints_sink);
+}
+
+static void stream_events_on_listen(
+    EventChannelTestsPigeonTestEventChannelMethodsStreamEventsEventSink* sink,
+    gpointer user_data) {
+  StreamHandlersData* data = static_cast<StreamHandlersData*>(user_data);
+  g_set_object(&data->events_sink, sink);
+}
+
+static EventChannelTestsPigeonTestEventChannelMethodsVTable vtable = {
+    .stream_ints_on_listen = stream_ints_on_listen,
+    .stream_ints_on_cancel = stream_ints_on_cancel,
+    .stream_events_on_listen = stream_events_on_listen};
+
+// The messages received on the Dart side of the event channels.
+typedef struct {
+  FlMethodCodec* codec;
+  std::vector<FlValue*> events;
+  std::vector<std::string> error_codes;
+  bool end_of_stream;
+} DartMessages;
+
+static void dart_message_cb(const gchar* channel, GBytes* message,
+                            gpointer user_data) {
+  DartMessages* messages = static_cast<DartMessages*>(user_data);
+  if (message == nullptr) {
+    messages->end_of_stream = true;
+    return;
+  }
+
+  g_autoptr(GError) error = nullptr;
+  g_autoptr(FlMethodResponse) response =
+      fl_method_codec_decode_response(messages->codec, message, &error);
+  ASSERT_NE(response, nullptr);
+  if (FL_IS_METHOD_ERROR_RESPONSE(response)) {
+    messages->error_codes.push_back(fl_method_error_response_get_code(
+        FL_METHOD_ERROR_RESPONSE(response)));
+    return;
+  }
+  FlValue* result = fl_method_response_get_result(response, &error);
+  ASSERT_NE(result, nullptr);
+  messages->events.push_back(fl_value_ref(result));
+}
+
+static void dart_messages_clear(DartMessages* messages) {
+  for (FlValue* event : messages->events) {
+    fl_value_unref(event);
+  }
+  messages->events.clear();
+}
+
+static FlMessageCodec* create_codec() {
+  return FL_MESSAGE_CODEC(g_object_new(
+      event_channel_tests_pigeon_test_message_codec_get_type(), nullptr));
+}
+
+// Sends a method call for [method] from Dart to the event channel [channel].
+static void send_method_call(FakeHostMessenger* messenger,
+                             FlMethodCodec* codec, const gchar* channel,
+                             const gchar* method) {
+  g_autoptr(GError) error = nullptr;
+  g_autoptr(GBytes) message =
+      fl_method_codec_encode_method_call(codec, method, nullptr, &error);
+  ASSERT_NE(message, nullptr);
+  fake_host_messenger_send_host_bytes(messenger, channel, message);
+}
+
+class EventChannelTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    message_codec_ = create_codec();
+    codec_ = fl_standard_method_codec_new_with_message_codec(
+        FL_STANDARD_MESSAGE_CODEC(message_codec_));
+    messenger_ = fake_host_messenger_new(message_codec_);
+    messages_.codec = FL_METHOD_CODEC(codec_);
+    fake_host_messenger_set_dart_message_handler(messenger_, dart_message_cb,
+                                                 &messages_);
+    event_channel_tests_pigeon_test_event_channel_methods_set_stream_handlers(
+        FL_BINARY_MESSENGER(messenger_), nullptr, &vtable, &handlers_,
+        nullptr);
+  }
+
+  void TearDown() override {
+    g_clear_object(&handlers_.ints_sink);
+    g_clear_object(&handlers_.events_sink);
+    g_clear_object(&messenger_);
+    g_clear_object(&codec_);
+    g_clear_object(&message_codec_);
+    dart_messages_clear(&messages_);
+  }
+
+  FlMessageCodec* message_codec_ = nullptr;
+  FlStandardMethodCodec* codec_ = nullptr;
+  FakeHostMessenger* messenger_ = nullptr;
+  StreamHandlersData handlers_ = {};
+  DartMessages messages_ = {};
+};
+
+TEST_F(EventChannelTest, ListenAndCancel) {
+  send_method_call(messenger_, FL_METHOD_CODEC(codec_), kStreamIntsChannelName,
+                   "listen");
+  EXPECT_NE(handlers_.ints_sink, nullptr);
+  EXPECT_EQ(handlers_.events_sink, nullptr);
+
+  send_method_call(messenger_, FL_METHOD_CODEC(codec_), kStreamIntsChannelName,
+                   "cancel");
+  EXPECT_EQ(handlers_.cancel_count, 1);
+  EXPECT_EQ(handlers_.ints_sink, nullptr);
+}
+
+TEST_F(EventChannelTest, FullBatchIsSentImmediately) {
+  send_method_call(messenger_, FL_METHOD_CODEC(codec_), kStreamIntsChannelName,
+                   "listen");
+  ASSERT_NE(handlers_.ints_sink, nullptr);
+
+  for (int64_t i = 0; i < 10; i++) {
+    event_channel_tests_pigeon_test_event_channel_methods_stream_ints_event_sink_success(
+        handlers_.ints_sink, i);
+  }
+  ASSERT_EQ(messages_.events.size(), 1u);
+  FlValue* batch = messages_.events[0];
+  ASSERT_EQ(fl_value_get_type(batch), FL_VALUE_TYPE_LIST);
+  ASSERT_EQ(fl_value_get_length(batch), 8u);
+  for (size_t i = 0; i < 8; i++) {
+    EXPECT_EQ(fl_value_get_int(fl_value_get_list_value(batch, i)),
+              static_cast<int64_t>(i));
+  }
+
+  // The rest of the events are sent once the batch latency has passed.
+  while (messages_.events.size() < 2) {
+    g_main_context_iteration(nullptr, TRUE);
+  }
+  batch = messages_.events[1];
+  ASSERT_EQ(fl_value_get_length(batch), 2u);
+  EXPECT_EQ(fl_value_get_int(fl_value_get_list_value(batch, 0)), 8);
+  EXPECT_EQ(fl_value_get_int(fl_value_get_list_value(batch, 1)), 9);
+}
+
+TEST_F(EventChannelTest, EndOfStreamFlushesBatch) {
+  send_method_call(messenger_, FL_METHOD_CODEC(codec_), kStreamIntsChannelName,
+                   "listen");
+  ASSERT_NE(handlers_.ints_sink, nullptr);
+
+  for (int64_t i = 0; i < 3; i++) {
+    event_channel_tests_pigeon_test_event_channel_methods_stream_ints_event_sink_success(
+        handlers_.ints_sink, i);
+  }
+  EXPECT_TRUE(messages_.events.empty());
+
+  g_autoptr(EventChannelTestsPigeonTestEventChannelMethodsStreamIntsEventSink)
+      sink = handlers_.ints_sink;
+  handlers_.ints_sink = nullptr;
+  event_channel_tests_pigeon_test_event_channel_methods_stream_ints_event_sink_end_of_stream(
+      sink);
+  ASSERT_EQ(messages_.events.size(), 1u);
+  EXPECT_EQ(fl_value_get_length(messages_.events[0]), 3u);
+  EXPECT_TRUE(messages_.end_of_stream);
+}
+
+TEST_F(EventChannelTest, CancelDropsPendingBatch) {
+  send_method_call(messenger_, FL_METHOD_CODEC(codec_), kStreamIntsChannelName,
+                   "listen");
+  ASSERT_NE(handlers_.ints_sink, nullptr);
+  EventChannelTestsPigeonTestEventChannelMethodsStreamIntsEventSink* sink =
+      EVENT_CHANNEL_TESTS_PIGEON_TEST_EVENT_CHANNEL_METHODS_STREAM_INTS_EVENT_SINK(
+          g_object_ref(handlers_.ints_sink));
+  g_object_add_weak_pointer(G_OBJECT(sink), reinterpret_cast<gpointer*>(&sink));
+
+  for (int64_t i = 0; i < 3; i++) {
+    event_channel_tests_pigeon_test_event_channel_methods_stream_ints_event_sink_success(
+        sink, i);
+  }
+  send_method_call(messenger_, FL_METHOD_CODEC(codec_), kStreamIntsChannelName,
+                   "cancel");
+  ASSERT_EQ(handlers_.ints_sink, nullptr);
+
+  // Events added after the cancel are dropped too.
+  event_channel_tests_pigeon_test_event_channel_methods_stream_ints_event_sink_success(
+      sink, 3);
+
+  // Nothing is sent once the batch latency has passed.
+  g_usleep(20 * 1000);
+  while (g_main_context_iteration(nullptr, FALSE)) {
+  }
+  EXPECT_TRUE(messages_.events.empty());
+
+  // The flush source was removed, so it doesn't keep the sink alive.
+  g_object_unref(sink);
+  EXPECT_EQ(sink, nullptr);
+}
+
+TEST_F(EventChannelTest, SealedClassEvents) {
+  send_method_call(messenger_, FL_METHOD_CODEC(codec_),
+                   kStreamEventsChannelName, "listen");
+  ASSERT_NE(handlers_.events_sink, nullptr);
+
+  g_autoptr(EventChannelTestsPigeonTestIntEvent) int_event =
+      event_channel_tests_pigeon_test_int_event_new(42);
+  g_autoptr(EventChannelTestsPigeonTestStringEvent) string_event =
+      event_channel_tests_pigeon_test_string_event_new("hello");
+  event_channel_tests_pigeon_test_event_channel_methods_stream_events_event_sink_success(
+      handlers_.events_sink,
+      EVENT_CHANNEL_TESTS_PIGEON_TEST_PLATFORM_EVENT(int_event));
+  event_channel_tests_pigeon_test_event_channel_methods_stream_events_event_sink_success(
+      handlers_.events_sink,
+      EVENT_CHANNEL_TESTS_PIGEON_TEST_PLATFORM_EVENT(string_event));
+  event_channel_tests_pigeon_test_event_channel_methods_stream_events_event_sink_flush(
+      handlers_.events_sink);
+
+  ASSERT_EQ(messages_.events.size(), 1u);
+  FlValue* batch = messages_.events[0];
+  ASSERT_EQ(fl_value_get_length(batch), 2u);
+
+  FlValue* value0 = fl_value_get_list_value(batch, 0);
+  ASSERT_EQ(fl_value_get_type(value0), FL_VALUE_TYPE_CUSTOM);
+  EXPECT_EQ(fl_value_get_custom_type(value0),
+            event_channel_tests_pigeon_test_int_event_type_id);
+  EXPECT_TRUE(event_channel_tests_pigeon_test_int_event_equals(
+      int_event, EVENT_CHANNEL_TESTS_PIGEON_TEST_INT_EVENT(
+                     fl_value_get_custom_value_object(value0))));
+
+  FlValue* value1 = fl_value_get_list_value(batch, 1);
+  ASSERT_EQ(fl_value_get_type(value1), FL_VALUE_TYPE_CUSTOM);
+  EXPECT_EQ(fl_value_get_custom_type(value1),
+            event_channel_tests_pigeon_test_string_event_type_id);
+  EXPECT_TRUE(EVENT_CHANNEL_TESTS_PIGEON_TEST_IS_PLATFORM_EVENT(
+      fl_value_get_custom_value_object(value1)));
+}
+
+TEST_F(EventChannelTest, ErrorIsSentAfterPendingEvents) {
+  send_method_call(messenger_, FL_METHOD_CODEC(codec_), kStreamIntsChannelName,
+                   "listen");
+  ASSERT_NE(handlers_.ints_sink, nullptr);
+
+  event_channel_tests_pigeon_test_event_channel_methods_stream_ints_event_sink_success(
+      handlers_.ints_sink, 1);
+  event_channel_tests_pigeon_test_event_channel_methods_stream_ints_event_sink_error(
+      handlers_.ints_sink, "code", "message", nullptr);
+
+  // The pending batch is sent before the error.
+  ASSERT_EQ(messages_.events.size(), 1u);
+  EXPECT_EQ(fl_value_get_length(messages_.events[0]), 1u);
+  ASSERT_EQ(messages_.error_codes.size(), 1u);
+  EXPECT_EQ(messages_.error_codes[0], "code");
+}
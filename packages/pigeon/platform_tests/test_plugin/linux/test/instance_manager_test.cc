@@ -0,0 +1,322 @@
+// Copyright 2013 The Flutter Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "pigeon/proxy_api_tests.gen.h"
+#include "test/utils/fake_host_messenger.h"
+
+static constexpr char kRemoveStrongReferenceChannelName[] =
+    "dev.flutter.pigeon.pigeon_integration_tests."
+    "PigeonInternalInstanceManager.removeStrongReference";
+static constexpr char kRemoveStrongReferencesChannelName[] =
+    "dev.flutter.pigeon.pigeon_integration_tests."
+    "PigeonInternalInstanceManager.removeStrongReferences";
+static constexpr char kClearChannelName[] =
+    "dev.flutter.pigeon.pigeon_integration_tests."
+    "PigeonInternalInstanceManager.clear";
+static constexpr char kDefaultConstructorChannelName[] =
+    "dev.flutter.pigeon.pigeon_integration_tests.ProxyApiSuperClass."
+    "pigeon_defaultConstructor";
+static constexpr char kASuperMethodChannelName[] =
+    "dev.flutter.pigeon.pigeon_integration_tests.ProxyApiSuperClass."
+    "aSuperMethod";
+
+// Encodes instances as their identifier, the same way Dart does.
+G_DECLARE_FINAL_TYPE(TestInstanceCodec, test_instance_codec, TEST,
+                     INSTANCE_CODEC, FlStandardMessageCodec)
+
+struct _TestInstanceCodec {
+  FlStandardMessageCodec parent_instance;
+};
+
+G_DEFINE_TYPE(TestInstanceCodec, test_instance_codec,
+              fl_standard_message_codec_get_type())
+
+static gboolean test_instance_codec_write_value(FlStandardMessageCodec* codec,
+                                                GByteArray* buffer,
+                                                FlValue* value,
+                                                GError** error) {
+  if (fl_value_get_type(value) == FL_VALUE_TYPE_CUSTOM &&
+      fl_value_get_custom_type(value) ==
+          proxy_api_tests_pigeon_test_pigeon_instance_manager_type_id) {
+    uint8_t type = proxy_api_tests_pigeon_test_pigeon_instance_manager_type_id;
+    g_byte_array_append(buffer, &type, sizeof(uint8_t));
+    FlValue* identifier = reinterpret_cast<FlValue*>(
+        const_cast<gpointer>(fl_value_get_custom_value(value)));
+    return fl_standard_message_codec_write_value(codec, buffer, identifier,
+                                                 error);
+  }
+  return FL_STANDARD_MESSAGE_CODEC_CLASS(test_instance_codec_parent_class)
+      ->write_value(codec, buffer, value, error);
+}
+
+static void test_instance_codec_init(TestInstanceCodec* self) {}
+
+static void test_instance_codec_class_init(TestInstanceCodecClass* klass) {
+  FL_STANDARD_MESSAGE_CODEC_CLASS(klass)->write_value =
+      test_instance_codec_write_value;
+}
+
+// Returns a value that Dart would send for the instance with [identifier].
+static FlValue* instance_value_new(int64_t identifier) {
+  return fl_value_new_custom(
+      proxy_api_tests_pigeon_test_pigeon_instance_manager_type_id,
+      fl_value_new_int(identifier), (GDestroyNotify)fl_value_unref);
+}
+
+// Records the identifiers of the instances Dart is told to release, one
+// batch per message.
+static void dart_message_cb(const gchar* channel, GBytes* message,
+                            gpointer user_data) {
+  std::vector<std::vector<int64_t>>* released =
+      static_cast<std::vector<std::vector<int64_t>>*>(user_data);
+  ASSERT_STREQ(channel, kRemoveStrongReferencesChannelName);
+  g_autoptr(FlStandardMessageCodec) codec = fl_standard_message_codec_new();
+  g_autoptr(GError) error = nullptr;
+  g_autoptr(FlValue) value =
+      fl_message_codec_decode_message(FL_MESSAGE_CODEC(codec), message, &error);
+  ASSERT_NE(value, nullptr);
+  FlValue* identifiers = fl_value_get_list_value(value, 0);
+  ASSERT_EQ(fl_value_get_type(identifiers), FL_VALUE_TYPE_INT64_LIST);
+  const int64_t* data = fl_value_get_int64_list(identifiers);
+  released->emplace_back(data, data + fl_value_get_length(identifiers));
+}
+
+static void reply_cb(FlValue* reply, gpointer user_data) {
+  FlValue** result = static_cast<FlValue**>(user_data);
+  *result = fl_value_ref(reply);
+}
+
+// The instances passed to the ProxyApiSuperClass handlers.
+typedef struct {
+  GObject* created_instance;
+  GObject* called_instance;
+} SuperClassHandlersData;
+
+static GObject* default_constructor(GError** error, gpointer user_data) {
+  SuperClassHandlersData* data =
+      static_cast<SuperClassHandlersData*>(user_data);
+  data->created_instance = G_OBJECT(g_object_new(G_TYPE_OBJECT, nullptr));
+  return G_OBJECT(g_object_ref(data->created_instance));
+}
+
+static ProxyApiTestsPigeonTestProxyApiSuperClassASuperMethodResponse*
+a_super_method(GObject* pigeon_instance, gpointer user_data) {
+  SuperClassHandlersData* data =
+      static_cast<SuperClassHandlersData*>(user_data);
+  data->called_instance = pigeon_instance;
+  return proxy_api_tests_pigeon_test_proxy_api_super_class_a_super_method_response_new();
+}
+
+static ProxyApiTestsPigeonTestProxyApiSuperClassVTable super_class_vtable = {
+    .pigeon_default_constructor = default_constructor,
+    .a_super_method = a_super_method};
+
+class InstanceManagerTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    codec_ = TEST_INSTANCE_CODEC(
+        g_object_new(test_instance_codec_get_type(), nullptr));
+    messenger_ = fake_host_messenger_new(FL_MESSAGE_CODEC(codec_));
+    fake_host_messenger_set_dart_message_handler(messenger_, dart_message_cb,
+                                                 &released_);
+    instance_manager_ = proxy_api_tests_pigeon_test_pigeon_instance_manager_new(
+        FL_BINARY_MESSENGER(messenger_));
+  }
+
+  void TearDown() override {
+    // Releases still pending would otherwise be sent during a later test.
+    FlushReleases();
+    g_clear_object(&instance_manager_);
+    g_clear_object(&messenger_);
+    g_clear_object(&codec_);
+  }
+
+  // Runs the main loop until the pending releases have been sent.
+  void FlushReleases() {
+    while (g_main_context_iteration(nullptr, FALSE)) {
+    }
+  }
+
+  TestInstanceCodec* codec_ = nullptr;
+  FakeHostMessenger* messenger_ = nullptr;
+  ProxyApiTestsPigeonTestPigeonInstanceManager* instance_manager_ = nullptr;
+  std::vector<std::vector<int64_t>> released_;
+};
+
+TEST_F(InstanceManagerTest, AddHostCreatedInstance) {
+  g_autoptr(GObject) instance = G_OBJECT(g_object_new(G_TYPE_OBJECT, nullptr));
+  int64_t identifier =
+      proxy_api_tests_pigeon_test_pigeon_instance_manager_add_host_created_instance(
+          instance_manager_, instance);
+  EXPECT_GE(identifier, 65536);
+  g_autoptr(GObject) found_instance =
+      proxy_api_tests_pigeon_test_pigeon_instance_manager_get_instance(
+          instance_manager_, identifier);
+  EXPECT_EQ(found_instance, instance);
+  EXPECT_TRUE(
+      proxy_api_tests_pigeon_test_pigeon_instance_manager_contains_instance(
+          instance_manager_, instance));
+
+  int64_t found_identifier = -1;
+  EXPECT_TRUE(
+      proxy_api_tests_pigeon_test_pigeon_instance_manager_get_identifier(
+          instance_manager_, instance, &found_identifier));
+  EXPECT_EQ(found_identifier, identifier);
+
+  // Adding the same instance again fails.
+  EXPECT_EQ(
+      proxy_api_tests_pigeon_test_pigeon_instance_manager_add_host_created_instance(
+          instance_manager_, instance),
+      -1);
+}
+
+TEST_F(InstanceManagerTest, AddDartCreatedInstanceRejectsDuplicates) {
+  g_autoptr(GObject) instance1 =
+      G_OBJECT(g_object_new(G_TYPE_OBJECT, nullptr));
+  g_autoptr(GObject) instance2 =
+      G_OBJECT(g_object_new(G_TYPE_OBJECT, nullptr));
+  EXPECT_TRUE(
+      proxy_api_tests_pigeon_test_pigeon_instance_manager_add_dart_created_instance(
+          instance_manager_, instance1, 0));
+  EXPECT_FALSE(
+      proxy_api_tests_pigeon_test_pigeon_instance_manager_add_dart_created_instance(
+          instance_manager_, instance2, 0));
+  EXPECT_FALSE(
+      proxy_api_tests_pigeon_test_pigeon_instance_manager_add_dart_created_instance(
+          instance_manager_, instance1, 1));
+}
+
+TEST_F(InstanceManagerTest, FinalizedInstancesAreReleasedInDart) {
+  int64_t identifiers[3];
+  for (int i = 0; i < 3; i++) {
+    g_autoptr(GObject) instance =
+        G_OBJECT(g_object_new(G_TYPE_OBJECT, nullptr));
+    identifiers[i] =
+        proxy_api_tests_pigeon_test_pigeon_instance_manager_add_host_created_instance(
+            instance_manager_, instance);
+  }
+  for (int i = 0; i < 3; i++) {
+    proxy_api_tests_pigeon_test_pigeon_instance_manager_remove(
+        instance_manager_, identifiers[i]);
+    EXPECT_EQ(proxy_api_tests_pigeon_test_pigeon_instance_manager_get_instance(
+                  instance_manager_, identifiers[i]),
+              nullptr);
+  }
+
+  // The releases are sent together in one message from the main loop.
+  EXPECT_TRUE(released_.empty());
+  FlushReleases();
+  ASSERT_EQ(released_.size(), 1u);
+  ASSERT_EQ(released_[0].size(), 3u);
+  for (int i = 0; i < 3; i++) {
+    EXPECT_EQ(released_[0][i], identifiers[i]);
+  }
+}
+
+TEST_F(InstanceManagerTest, RemoveStrongReferenceFromDart) {
+  GObject* instance = G_OBJECT(g_object_new(G_TYPE_OBJECT, nullptr));
+  g_object_add_weak_pointer(instance, reinterpret_cast<gpointer*>(&instance));
+  EXPECT_TRUE(
+      proxy_api_tests_pigeon_test_pigeon_instance_manager_add_dart_created_instance(
+          instance_manager_, instance, 7));
+  g_object_unref(instance);
+  ASSERT_NE(instance, nullptr);
+
+  g_autoptr(FlValue) message = fl_value_new_list();
+  fl_value_append_take(message, fl_value_new_int(7));
+  g_autoptr(FlValue) reply = nullptr;
+  fake_host_messenger_send_host_message(
+      messenger_, kRemoveStrongReferenceChannelName, message, reply_cb, &reply);
+  ASSERT_NE(reply, nullptr);
+  EXPECT_EQ(fl_value_get_length(reply), 1u);
+  EXPECT_EQ(instance, nullptr);
+}
+
+TEST_F(InstanceManagerTest, RemoveStrongReferenceFromDartAfterRelease) {
+  // Releasing an instance in Dart must not replace the handler Dart uses to
+  // release instances on the host.
+  GObject* released_instance = G_OBJECT(g_object_new(G_TYPE_OBJECT, nullptr));
+  int64_t released_identifier =
+      proxy_api_tests_pigeon_test_pigeon_instance_manager_add_host_created_instance(
+          instance_manager_, released_instance);
+  g_object_unref(released_instance);
+  proxy_api_tests_pigeon_test_pigeon_instance_manager_remove(
+      instance_manager_, released_identifier);
+  FlushReleases();
+  ASSERT_EQ(released_.size(), 1u);
+
+  GObject* instance = G_OBJECT(g_object_new(G_TYPE_OBJECT, nullptr));
+  g_object_add_weak_pointer(instance, reinterpret_cast<gpointer*>(&instance));
+  EXPECT_TRUE(
+      proxy_api_tests_pigeon_test_pigeon_instance_manager_add_dart_created_instance(
+          instance_manager_, instance, 7));
+  g_object_unref(instance);
+
+  g_autoptr(FlValue) message = fl_value_new_list();
+  fl_value_append_take(message, fl_value_new_int(7));
+  g_autoptr(FlValue) reply = nullptr;
+  fake_host_messenger_send_host_message(
+      messenger_, kRemoveStrongReferenceChannelName, message, reply_cb, &reply);
+  ASSERT_NE(reply, nullptr);
+  EXPECT_EQ(instance, nullptr);
+}
+
+TEST_F(InstanceManagerTest, ClearFromDart) {
+  g_autoptr(GObject) instance = G_OBJECT(g_object_new(G_TYPE_OBJECT, nullptr));
+  proxy_api_tests_pigeon_test_pigeon_instance_manager_add_host_created_instance(
+      instance_manager_, instance);
+
+  g_autoptr(FlValue) message = fl_value_new_list();
+  g_autoptr(FlValue) reply = nullptr;
+  fake_host_messenger_send_host_message(messenger_, kClearChannelName, message,
+                                        reply_cb, &reply);
+  ASSERT_NE(reply, nullptr);
+  EXPECT_FALSE(
+      proxy_api_tests_pigeon_test_pigeon_instance_manager_contains_instance(
+          instance_manager_, instance));
+
+  // Cleared instances are not released in Dart.
+  g_clear_object(&instance);
+  FlushReleases();
+  EXPECT_TRUE(released_.empty());
+}
+
+TEST_F(InstanceManagerTest, ProxyApiMethodHandlers) {
+  SuperClassHandlersData data = {};
+  proxy_api_tests_pigeon_test_proxy_api_super_class_set_method_handlers(
+      FL_BINARY_MESSENGER(messenger_), instance_manager_, &super_class_vtable,
+      &data, nullptr);
+
+  g_autoptr(FlValue) constructor_message = fl_value_new_list();
+  fl_value_append_take(constructor_message, fl_value_new_int(3));
+  g_autoptr(FlValue) constructor_reply = nullptr;
+  fake_host_messenger_send_host_message(
+      messenger_, kDefaultConstructorChannelName, constructor_message, reply_cb,
+      &constructor_reply);
+  ASSERT_NE(constructor_reply, nullptr);
+  EXPECT_EQ(fl_value_get_length(constructor_reply), 1u);
+  ASSERT_NE(data.created_instance, nullptr);
+  g_autoptr(GObject) found_instance =
+      proxy_api_tests_pigeon_test_pigeon_instance_manager_get_instance(
+          instance_manager_, 3);
+  EXPECT_EQ(found_instance, data.created_instance);
+
+  g_autoptr(FlValue) method_message = fl_value_new_list();
+  fl_value_append_take(method_message, instance_value_new(3));
+  g_autoptr(FlValue) method_reply = nullptr;
+  fake_host_messenger_send_host_message(messenger_, kASuperMethodChannelName,
+                                        method_message, reply_cb,
+                                        &method_reply);
+  ASSERT_NE(method_reply, nullptr);
+  EXPECT_EQ(fl_value_get_length(method_reply), 1u);
+  EXPECT_EQ(data.called_instance, data.created_instance);
+
+  proxy_api_tests_pigeon_test_proxy_api_super_class_clear_method_handlers(
+      FL_BINARY_MESSENGER(messenger_));
+  g_object_unref(data.created_instance);
+}
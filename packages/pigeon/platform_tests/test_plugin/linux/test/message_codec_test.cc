@@ -0,0 +1,379 @@
+// Copyright 2013 The Flutter Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <gtest/gtest.h>
+
+#include "pigeon/core_tests.gen.h"
+
+static FlMessageCodec* create_codec() {
+  return FL_MESSAGE_CODEC(
+      g_object_new(core_tests_pigeon_test_message_codec_get_type(), nullptr));
+}
+
+static FlValue* create_int_list(int64_t a, int64_t b) {
+  FlValue* list = fl_value_new_list();
+  fl_value_append_take(list, fl_value_new_int(a));
+  fl_value_append_take(list, fl_value_new_int(b));
+  return list;
+}
+
+static FlValue* create_string_map(const gchar* key, const gchar* value) {
+  FlValue* map = fl_value_new_map();
+  fl_value_set_string_take(map, key, fl_value_new_string(value));
+  return map;
+}
+
+static CoreTestsPigeonTestAllTypes* create_all_types() {
+  static const uint8_t bytes[] = {1, 2, 3};
+  static const int32_t int32s[] = {-1, 0, 1};
+  static const int64_t int64s[] = {G_MININT64, 0, G_MAXINT64};
+  static const double doubles[] = {0.5, -1.25};
+  g_autoptr(FlValue) an_object = fl_value_new_int(7);
+  g_autoptr(FlValue) list = create_int_list(1, 2);
+  g_autoptr(FlValue) string_list = fl_value_new_list();
+  fl_value_append_take(string_list, fl_value_new_string("hello"));
+  g_autoptr(FlValue) int_list = create_int_list(G_MAXINT64, -3);
+  g_autoptr(FlValue) double_list = fl_value_new_list();
+  fl_value_append_take(double_list, fl_value_new_float(2.5));
+  g_autoptr(FlValue) bool_list = fl_value_new_list();
+  fl_value_append_take(bool_list, fl_value_new_bool(FALSE));
+  g_autoptr(FlValue) enum_list = fl_value_new_list();
+  g_autoptr(FlValue) object_list = create_int_list(4, 5);
+  g_autoptr(FlValue) list_list = fl_value_new_list();
+  fl_value_append_take(list_list, create_int_list(6, 7));
+  g_autoptr(FlValue) map_list = fl_value_new_list();
+  fl_value_append_take(map_list, create_string_map("a", "b"));
+  g_autoptr(FlValue) map = create_string_map("c", "d");
+  g_autoptr(FlValue) string_map = create_string_map("e", "f");
+  g_autoptr(FlValue) int_map = fl_value_new_map();
+  fl_value_set_take(int_map, fl_value_new_int(1), fl_value_new_int(2));
+  g_autoptr(FlValue) enum_map = fl_value_new_map();
+  g_autoptr(FlValue) object_map = create_string_map("g", "h");
+  g_autoptr(FlValue) list_map = fl_value_new_map();
+  fl_value_set_take(list_map, fl_value_new_int(1), create_int_list(8, 9));
+  g_autoptr(FlValue) map_map = fl_value_new_map();
+  fl_value_set_take(map_map, fl_value_new_int(1), create_string_map("i", "j"));
+  return core_tests_pigeon_test_all_types_new(
+      TRUE, 42, G_MAXINT64, 3.14, bytes, G_N_ELEMENTS(bytes), int32s,
+      G_N_ELEMENTS(int32s), int64s, G_N_ELEMENTS(int64s), doubles,
+      G_N_ELEMENTS(doubles), PIGEON_INTEGRATION_TESTS_AN_ENUM_FORTY_TWO,
+      PIGEON_INTEGRATION_TESTS_ANOTHER_ENUM_JUST_IN_CASE, "a string",
+      an_object, list, string_list, int_list, double_list, bool_list, enum_list,
+      object_list, list_list, map_list, map, string_map, int_map, enum_map,
+      object_map, list_map, map_map);
+}
+
+// Builds the field list for [object] the way the codec did before data
+// classes were written directly to the buffer.
+static FlValue* all_types_to_list(CoreTestsPigeonTestAllTypes* object) {
+  FlValue* values = fl_value_new_list();
+  size_t length;
+  fl_value_append_take(
+      values,
+      fl_value_new_bool(core_tests_pigeon_test_all_types_get_a_bool(object)));
+  fl_value_append_take(
+      values,
+      fl_value_new_int(core_tests_pigeon_test_all_types_get_an_int(object)));
+  fl_value_append_take(
+      values,
+      fl_value_new_int(core_tests_pigeon_test_all_types_get_an_int64(object)));
+  fl_value_append_take(
+      values, fl_value_new_float(
+                  core_tests_pigeon_test_all_types_get_a_double(object)));
+  const uint8_t* bytes =
+      core_tests_pigeon_test_all_types_get_a_byte_array(object, &length);
+  fl_value_append_take(values, fl_value_new_uint8_list(bytes, length));
+  const int32_t* int32s =
+      core_tests_pigeon_test_all_types_get_a4_byte_array(object, &length);
+  fl_value_append_take(values, fl_value_new_int32_list(int32s, length));
+  const int64_t* int64s =
+      core_tests_pigeon_test_all_types_get_a8_byte_array(object, &length);
+  fl_value_append_take(values, fl_value_new_int64_list(int64s, length));
+  const double* doubles =
+      core_tests_pigeon_test_all_types_get_a_float_array(object, &length);
+  fl_value_append_take(values, fl_value_new_float_list(doubles, length));
+  CoreTestsPigeonTestAnEnum an_enum =
+      core_tests_pigeon_test_all_types_get_an_enum(object);
+  fl_value_append_take(
+      values, fl_value_new_custom(core_tests_pigeon_test_an_enum_type_id,
+                                  fl_value_new_int(an_enum),
+                                  (GDestroyNotify)fl_value_unref));
+  CoreTestsPigeonTestAnotherEnum another_enum =
+      core_tests_pigeon_test_all_types_get_another_enum(object);
+  fl_value_append_take(
+      values, fl_value_new_custom(core_tests_pigeon_test_another_enum_type_id,
+                                  fl_value_new_int(another_enum),
+                                  (GDestroyNotify)fl_value_unref));
+  fl_value_append_take(
+      values, fl_value_new_string(
+                  core_tests_pigeon_test_all_types_get_a_string(object)));
+  FlValue* (*getters[])(CoreTestsPigeonTestAllTypes*) = {
+      core_tests_pigeon_test_all_types_get_an_object,
+      core_tests_pigeon_test_all_types_get_list,
+      core_tests_pigeon_test_all_types_get_string_list,
+      core_tests_pigeon_test_all_types_get_int_list,
+      core_tests_pigeon_test_all_types_get_double_list,
+      core_tests_pigeon_test_all_types_get_bool_list,
+      core_tests_pigeon_test_all_types_get_enum_list,
+      core_tests_pigeon_test_all_types_get_object_list,
+      core_tests_pigeon_test_all_types_get_list_list,
+      core_tests_pigeon_test_all_types_get_map_list,
+      core_tests_pigeon_test_all_types_get_map,
+      core_tests_pigeon_test_all_types_get_string_map,
+      core_tests_pigeon_test_all_types_get_int_map,
+      core_tests_pigeon_test_all_types_get_enum_map,
+      core_tests_pigeon_test_all_types_get_object_map,
+      core_tests_pigeon_test_all_types_get_list_map,
+      core_tests_pigeon_test_all_types_get_map_map,
+  };
+  for (auto getter : getters) {
+    fl_value_append_take(values, fl_value_ref(getter(object)));
+  }
+  return values;
+}
+
+// Encodes a custom object as the type ID followed by its field list.
+static GBytes* encode_as_list(FlMessageCodec* codec, int type_id,
+                              FlValue* values) {
+  g_autoptr(GByteArray) buffer = g_byte_array_new();
+  uint8_t type = type_id;
+  g_byte_array_append(buffer, &type, sizeof(uint8_t));
+  g_autoptr(GError) error = nullptr;
+  EXPECT_TRUE(fl_standard_message_codec_write_value(
+      FL_STANDARD_MESSAGE_CODEC(codec), buffer, values, &error));
+  return g_byte_array_free_to_bytes(static_cast<GByteArray*>(
+      g_steal_pointer(&buffer)));
+}
+
+static GBytes* encode_object(FlMessageCodec* codec, int type_id,
+                             GObject* object) {
+  g_autoptr(FlValue) value = fl_value_new_custom_object(type_id, object);
+  g_autoptr(GError) error = nullptr;
+  GBytes* message = fl_message_codec_encode_message(codec, value, &error);
+  EXPECT_EQ(error, nullptr);
+  return message;
+}
+
+TEST(MessageCodec, AllTypesMatchesListEncoding) {
+  g_autoptr(FlMessageCodec) codec = create_codec();
+  g_autoptr(CoreTestsPigeonTestAllTypes) all_types = create_all_types();
+
+  g_autoptr(GBytes) direct = encode_object(
+      codec, core_tests_pigeon_test_all_types_type_id, G_OBJECT(all_types));
+  g_autoptr(FlValue) values = all_types_to_list(all_types);
+  g_autoptr(GBytes) expected = encode_as_list(
+      codec, core_tests_pigeon_test_all_types_type_id, values);
+
+  EXPECT_TRUE(g_bytes_equal(direct, expected));
+}
+
+TEST(MessageCodec, NullFieldsMatchListEncoding) {
+  g_autoptr(FlMessageCodec) codec = create_codec();
+  g_autoptr(CoreTestsPigeonTestAllNullableTypesWithoutRecursion) all_nullable =
+      core_tests_pigeon_test_all_nullable_types_without_recursion_new(
+          nullptr, nullptr, nullptr, nullptr, nullptr, 0, nullptr, 0, nullptr,
+          0, nullptr, 0, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,
+          nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,
+          nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr);
+
+  g_autoptr(GBytes) direct = encode_object(
+      codec,
+      core_tests_pigeon_test_all_nullable_types_without_recursion_type_id,
+      G_OBJECT(all_nullable));
+  g_autoptr(FlValue) values = fl_value_new_list();
+  for (int i = 0; i < 28; i++) {
+    fl_value_append_take(values, fl_value_new_null());
+  }
+  g_autoptr(GBytes) expected = encode_as_list(
+      codec,
+      core_tests_pigeon_test_all_nullable_types_without_recursion_type_id,
+      values);
+
+  EXPECT_TRUE(g_bytes_equal(direct, expected));
+}
+
+TEST(MessageCodec, IntegersUseSmallestEncoding) {
+  g_autoptr(FlMessageCodec) codec = create_codec();
+  int64_t small = G_MININT32;
+  int64_t large = static_cast<int64_t>(G_MAXINT32) + 1;
+  double a_double = -0.0;
+  g_autoptr(CoreTestsPigeonTestAllNullableTypesWithoutRecursion) all_nullable =
+      core_tests_pigeon_test_all_nullable_types_without_recursion_new(
+          nullptr, &small, &large, &a_double, nullptr, 0, nullptr, 0, nullptr,
+          0, nullptr, 0, nullptr, nullptr, "", nullptr, nullptr, nullptr,
+          nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,
+          nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr);
+
+  g_autoptr(GBytes) direct = encode_object(
+      codec,
+      core_tests_pigeon_test_all_nullable_types_without_recursion_type_id,
+      G_OBJECT(all_nullable));
+  g_autoptr(FlValue) values = fl_value_new_list();
+  fl_value_append_take(values, fl_value_new_null());
+  fl_value_append_take(values, fl_value_new_int(small));
+  fl_value_append_take(values, fl_value_new_int(large));
+  fl_value_append_take(values, fl_value_new_float(a_double));
+  for (int i = 0; i < 6; i++) {
+    fl_value_append_take(values, fl_value_new_null());
+  }
+  fl_value_append_take(values, fl_value_new_string(""));
+  for (int i = 0; i < 17; i++) {
+    fl_value_append_take(values, fl_value_new_null());
+  }
+  g_autoptr(GBytes) expected = encode_as_list(
+      codec,
+      core_tests_pigeon_test_all_nullable_types_without_recursion_type_id,
+      values);
+
+  EXPECT_TRUE(g_bytes_equal(direct, expected));
+}
+
+TEST(MessageCodec, NestedClassesRoundTrip) {
+  g_autoptr(FlMessageCodec) codec = create_codec();
+  g_autoptr(CoreTestsPigeonTestAllTypes) all_types = create_all_types();
+  g_autoptr(FlValue) class_list = fl_value_new_list();
+  fl_value_append_take(class_list,
+                       fl_value_new_custom_object(
+                           core_tests_pigeon_test_all_types_type_id,
+                           G_OBJECT(all_types)));
+  g_autoptr(FlValue) class_map = fl_value_new_map();
+  fl_value_set_take(class_map, fl_value_new_int(1),
+                    fl_value_new_custom_object(
+                        core_tests_pigeon_test_all_types_type_id,
+                        G_OBJECT(all_types)));
+  g_autoptr(CoreTestsPigeonTestAllNullableTypes) all_nullable =
+      core_tests_pigeon_test_all_nullable_types_new(
+          nullptr, nullptr, nullptr, nullptr, nullptr, 0, nullptr, 0, nullptr,
+          0, nullptr, 0, nullptr, nullptr, "nested", nullptr, nullptr, nullptr,
+          nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,
+          nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,
+          nullptr, nullptr, nullptr);
+  g_autoptr(CoreTestsPigeonTestAllClassesWrapper) wrapper =
+      core_tests_pigeon_test_all_classes_wrapper_new(
+          all_nullable, nullptr, all_types, class_list, nullptr, class_map,
+          nullptr);
+
+  g_autoptr(GBytes) message = encode_object(
+      codec, core_tests_pigeon_test_all_classes_wrapper_type_id,
+      G_OBJECT(wrapper));
+  g_autoptr(GError) error = nullptr;
+  g_autoptr(FlValue) decoded =
+      fl_message_codec_decode_message(codec, message, &error);
+  ASSERT_NE(decoded, nullptr);
+  ASSERT_EQ(fl_value_get_type(decoded), FL_VALUE_TYPE_CUSTOM);
+  ASSERT_EQ(fl_value_get_custom_type(decoded),
+            core_tests_pigeon_test_all_classes_wrapper_type_id);
+
+  EXPECT_TRUE(core_tests_pigeon_test_all_classes_wrapper_equals(
+      wrapper, CORE_TESTS_PIGEON_TEST_ALL_CLASSES_WRAPPER(
+                   fl_value_get_custom_value_object(decoded))));
+}
+
+TEST(MessageCodec, AllTypesRoundTrip) {
+  g_autoptr(FlMessageCodec) codec = create_codec();
+  g_autoptr(CoreTestsPigeonTestAllTypes) all_types = create_all_types();
+
+  g_autoptr(GBytes) message = encode_object(
+      codec, core_tests_pigeon_test_all_types_type_id, G_OBJECT(all_types));
+  g_autoptr(GError) error = nullptr;
+  g_autoptr(FlValue) decoded =
+      fl_message_codec_decode_message(codec, message, &error);
+  ASSERT_NE(decoded, nullptr);
+
+  EXPECT_TRUE(core_tests_pigeon_test_all_types_equals(
+      all_types, CORE_TESTS_PIGEON_TEST_ALL_TYPES(
+                     fl_value_get_custom_value_object(decoded))));
+}
+
+TEST(MessageCodec, EmptyFieldsAreNotDecodedAsNull) {
+  g_autoptr(FlMessageCodec) codec = create_codec();
+  static const uint8_t bytes[] = {0};
+  g_autoptr(CoreTestsPigeonTestAllNullableTypesWithoutRecursion) all_nullable =
+      core_tests_pigeon_test_all_nullable_types_without_recursion_new(
+          nullptr, nullptr, nullptr, nullptr, bytes, 0, nullptr, 0, nullptr, 0,
+          nullptr, 0, nullptr, nullptr, "", nullptr, nullptr, nullptr, nullptr,
+          nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,
+          nullptr, nullptr, nullptr, nullptr, nullptr, nullptr);
+
+  g_autoptr(GBytes) message = encode_object(
+      codec,
+      core_tests_pigeon_test_all_nullable_types_without_recursion_type_id,
+      G_OBJECT(all_nullable));
+  g_autoptr(GError) error = nullptr;
+  g_autoptr(FlValue) decoded =
+      fl_message_codec_decode_message(codec, message, &error);
+  ASSERT_NE(decoded, nullptr);
+  CoreTestsPigeonTestAllNullableTypesWithoutRecursion* value =
+      CORE_TESTS_PIGEON_TEST_ALL_NULLABLE_TYPES_WITHOUT_RECURSION(
+          fl_value_get_custom_value_object(decoded));
+
+  size_t length = 1;
+  EXPECT_NE(
+      core_tests_pigeon_test_all_nullable_types_without_recursion_get_a_nullable_byte_array(
+          value, &length),
+      nullptr);
+  EXPECT_EQ(length, 0u);
+  EXPECT_EQ(
+      core_tests_pigeon_test_all_nullable_types_without_recursion_get_a_nullable4_byte_array(
+          value, &length),
+      nullptr);
+  EXPECT_STREQ(
+      core_tests_pigeon_test_all_nullable_types_without_recursion_get_a_nullable_string(
+          value),
+      "");
+}
+
+TEST(MessageCodec, TruncatedMessageFails) {
+  g_autoptr(FlMessageCodec) codec = create_codec();
+  g_autoptr(CoreTestsPigeonTestAllTypes) all_types = create_all_types();
+
+  g_autoptr(GBytes) message = encode_object(
+      codec, core_tests_pigeon_test_all_types_type_id, G_OBJECT(all_types));
+  for (size_t size = 0; size < g_bytes_get_size(message); size++) {
+    g_autoptr(GBytes) truncated = g_bytes_new_from_bytes(message, 0, size);
+    g_autoptr(GError) error = nullptr;
+    g_autoptr(FlValue) decoded =
+        fl_message_codec_decode_message(codec, truncated, &error);
+    EXPECT_EQ(decoded, nullptr);
+    EXPECT_NE(error, nullptr);
+  }
+}
+
+TEST(MessageCodec, ExtraFieldsAreIgnored) {
+  g_autoptr(FlMessageCodec) codec = create_codec();
+  g_autoptr(CoreTestsPigeonTestAllTypes) all_types = create_all_types();
+
+  // A newer version of the class can add fields after the known ones.
+  g_autoptr(FlValue) values = all_types_to_list(all_types);
+  fl_value_append_take(values, fl_value_new_string("new field"));
+  fl_value_append_take(values, create_int_list(10, 11));
+  g_autoptr(GBytes) message = encode_as_list(
+      codec, core_tests_pigeon_test_all_types_type_id, values);
+  g_autoptr(GError) error = nullptr;
+  g_autoptr(FlValue) decoded =
+      fl_message_codec_decode_message(codec, message, &error);
+  ASSERT_NE(decoded, nullptr) << error->message;
+
+  EXPECT_TRUE(core_tests_pigeon_test_all_types_equals(
+      all_types, CORE_TESTS_PIGEON_TEST_ALL_TYPES(
+                     fl_value_get_custom_value_object(decoded))));
+}
+
+TEST(MessageCodec, MissingFieldsFail) {
+  g_autoptr(FlMessageCodec) codec = create_codec();
+  g_autoptr(CoreTestsPigeonTestAllTypes) all_types = create_all_types();
+
+  g_autoptr(FlValue) all_values = all_types_to_list(all_types);
+  g_autoptr(FlValue) values = fl_value_new_list();
+  for (size_t i = 0; i + 1 < fl_value_get_length(all_values); i++) {
+    fl_value_append(values, fl_value_get_list_value(all_values, i));
+  }
+  g_autoptr(GBytes) message = encode_as_list(
+      codec, core_tests_pigeon_test_all_types_type_id, values);
+  g_autoptr(GError) error = nullptr;
+  g_autoptr(FlValue) decoded =
+      fl_message_codec_decode_message(codec, message, &error);
+  EXPECT_EQ(decoded, nullptr);
+  EXPECT_NE(error, nullptr);
+}
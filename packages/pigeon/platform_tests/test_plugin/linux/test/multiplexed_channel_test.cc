@@ -0,0 +1,201 @@
+// Copyright 2013 The Flutter Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <gtest/gtest.h>
+
+#include "pigeon/multiplexed_channel.gen.h"
+#include "test/utils/fake_host_messenger.h"
+
+static constexpr char kMultiplexedChannelName[] =
+    "dev.flutter.pigeon.pigeon_integration_tests.MultiplexedHostApi";
+
+static MultiplexedChannelPigeonTestMultiplexedHostApiSubtractResponse*
+multiplexed_subtract(int64_t x, int64_t y, gpointer user_data) {
+  return multiplexed_channel_pigeon_test_multiplexed_host_api_subtract_response_new(
+      x - y);
+}
+
+static MultiplexedChannelPigeonTestMultiplexedHostApiEchoStringResponse*
+multiplexed_echo_string(const gchar* a_string, gpointer user_data) {
+  return multiplexed_channel_pigeon_test_multiplexed_host_api_echo_string_response_new(
+      a_string);
+}
+
+static MultiplexedChannelPigeonTestMultiplexedHostApiNoopResponse*
+multiplexed_noop(gpointer user_data) {
+  return multiplexed_channel_pigeon_test_multiplexed_host_api_noop_response_new();
+}
+
+static void multiplexed_echo_async_nullable_int(
+    int64_t* an_int,
+    MultiplexedChannelPigeonTestMultiplexedHostApiResponseHandle*
+        response_handle,
+    gpointer user_data) {
+  multiplexed_channel_pigeon_test_multiplexed_host_api_respond_echo_async_nullable_int(
+      response_handle, an_int);
+}
+
+static MultiplexedChannelPigeonTestMultiplexedHostApiVTable multiplexed_vtable =
+    {.subtract = multiplexed_subtract,
+     .echo_string = multiplexed_echo_string,
+     .noop = multiplexed_noop,
+     .echo_async_nullable_int = multiplexed_echo_async_nullable_int};
+
+static MultiplexedChannelPigeonTestPerMethodChannelHostApiSubtractResponse*
+per_method_subtract(int64_t x, int64_t y, gpointer user_data) {
+  return multiplexed_channel_pigeon_test_per_method_channel_host_api_subtract_response_new(
+      x - y);
+}
+
+static MultiplexedChannelPigeonTestPerMethodChannelHostApiVTable
+    per_method_vtable = {.subtract = per_method_subtract};
+
+static void reply_cb(FlValue* reply, gpointer user_data) {
+  FlValue** result = reinterpret_cast<FlValue**>(user_data);
+  *result = fl_value_ref(reply);
+}
+
+// Sends [message] on [channel] and returns the reply, or nullptr if no reply
+// was sent.
+static FlValue* send_message(FakeHostMessenger* messenger,
+                             const gchar* channel, FlValue* message) {
+  FlValue* reply = nullptr;
+  fake_host_messenger_send_host_message(messenger, channel, message, reply_cb,
+                                        &reply);
+  return reply;
+}
+
+TEST(MultiplexedChannel, DispatchesOnMethodIndex) {
+  g_autoptr(FlStandardMessageCodec) codec = fl_standard_message_codec_new();
+  g_autoptr(FakeHostMessenger) messenger =
+      fake_host_messenger_new(FL_MESSAGE_CODEC(codec));
+  multiplexed_channel_pigeon_test_multiplexed_host_api_set_method_handlers(
+      FL_BINARY_MESSENGER(messenger), nullptr, &multiplexed_vtable, nullptr,
+      nullptr);
+
+  g_autoptr(FlValue) subtract_message = fl_value_new_list();
+  fl_value_append_take(subtract_message, fl_value_new_int(0));
+  fl_value_append_take(subtract_message, fl_value_new_int(30));
+  fl_value_append_take(subtract_message, fl_value_new_int(10));
+  g_autoptr(FlValue) subtract_reply =
+      send_message(messenger, kMultiplexedChannelName, subtract_message);
+  ASSERT_NE(subtract_reply, nullptr);
+  EXPECT_EQ(fl_value_get_int(fl_value_get_list_value(subtract_reply, 0)), 20);
+
+  g_autoptr(FlValue) echo_message = fl_value_new_list();
+  fl_value_append_take(echo_message, fl_value_new_int(1));
+  fl_value_append_take(echo_message, fl_value_new_string("hello"));
+  g_autoptr(FlValue) echo_reply =
+      send_message(messenger, kMultiplexedChannelName, echo_message);
+  ASSERT_NE(echo_reply, nullptr);
+  EXPECT_STREQ(
+      fl_value_get_string(fl_value_get_list_value(echo_reply, 0)), "hello");
+
+  g_autoptr(FlValue) noop_message = fl_value_new_list();
+  fl_value_append_take(noop_message, fl_value_new_int(2));
+  g_autoptr(FlValue) noop_reply =
+      send_message(messenger, kMultiplexedChannelName, noop_message);
+  EXPECT_NE(noop_reply, nullptr);
+
+  g_autoptr(FlValue) async_message = fl_value_new_list();
+  fl_value_append_take(async_message, fl_value_new_int(3));
+  fl_value_append_take(async_message, fl_value_new_int(42));
+  g_autoptr(FlValue) async_reply =
+      send_message(messenger, kMultiplexedChannelName, async_message);
+  ASSERT_NE(async_reply, nullptr);
+  EXPECT_EQ(fl_value_get_int(fl_value_get_list_value(async_reply, 0)), 42);
+}
+
+TEST(MultiplexedChannel, DoesNotRegisterPerMethodChannels) {
+  g_autoptr(FlStandardMessageCodec) codec = fl_standard_message_codec_new();
+  g_autoptr(FakeHostMessenger) messenger =
+      fake_host_messenger_new(FL_MESSAGE_CODEC(codec));
+  multiplexed_channel_pigeon_test_multiplexed_host_api_set_method_handlers(
+      FL_BINARY_MESSENGER(messenger), nullptr, &multiplexed_vtable, nullptr,
+      nullptr);
+
+  g_autoptr(FlValue) message = fl_value_new_list();
+  fl_value_append_take(message, fl_value_new_int(30));
+  fl_value_append_take(message, fl_value_new_int(10));
+  g_autoptr(FlValue) reply = send_message(
+      messenger,
+      "dev.flutter.pigeon.pigeon_integration_tests.MultiplexedHostApi."
+      "subtract",
+      message);
+  EXPECT_EQ(reply, nullptr);
+}
+
+TEST(MultiplexedChannel, RepliesWithErrorForUnknownMethodIndex) {
+  g_autoptr(FlStandardMessageCodec) codec = fl_standard_message_codec_new();
+  g_autoptr(FakeHostMessenger) messenger =
+      fake_host_messenger_new(FL_MESSAGE_CODEC(codec));
+  multiplexed_channel_pigeon_test_multiplexed_host_api_set_method_handlers(
+      FL_BINARY_MESSENGER(messenger), nullptr, &multiplexed_vtable, nullptr,
+      nullptr);
+
+  g_autoptr(FlValue) message = fl_value_new_list();
+  fl_value_append_take(message, fl_value_new_int(99));
+  g_autoptr(FlValue) reply =
+      send_message(messenger, kMultiplexedChannelName, message);
+  ASSERT_NE(reply, nullptr);
+  ASSERT_EQ(fl_value_get_length(reply), 3u);
+  EXPECT_STREQ(fl_value_get_string(fl_value_get_list_value(reply, 0)),
+               "unknown-method");
+}
+
+TEST(MultiplexedChannel, RepliesWithErrorForMalformedMessage) {
+  g_autoptr(FlStandardMessageCodec) codec = fl_standard_message_codec_new();
+  g_autoptr(FakeHostMessenger) messenger =
+      fake_host_messenger_new(FL_MESSAGE_CODEC(codec));
+  multiplexed_channel_pigeon_test_multiplexed_host_api_set_method_handlers(
+      FL_BINARY_MESSENGER(messenger), nullptr, &multiplexed_vtable, nullptr,
+      nullptr);
+
+  g_autoptr(FlValue) message = fl_value_new_string("not a list");
+  g_autoptr(FlValue) reply =
+      send_message(messenger, kMultiplexedChannelName, message);
+  ASSERT_NE(reply, nullptr);
+  ASSERT_EQ(fl_value_get_length(reply), 3u);
+  EXPECT_STREQ(fl_value_get_string(fl_value_get_list_value(reply, 0)),
+               "malformed-message");
+}
+
+TEST(MultiplexedChannel, ClearMethodHandlers) {
+  g_autoptr(FlStandardMessageCodec) codec = fl_standard_message_codec_new();
+  g_autoptr(FakeHostMessenger) messenger =
+      fake_host_messenger_new(FL_MESSAGE_CODEC(codec));
+  multiplexed_channel_pigeon_test_multiplexed_host_api_set_method_handlers(
+      FL_BINARY_MESSENGER(messenger), "suffix", &multiplexed_vtable, nullptr,
+      nullptr);
+  multiplexed_channel_pigeon_test_multiplexed_host_api_clear_method_handlers(
+      FL_BINARY_MESSENGER(messenger), "suffix");
+
+  g_autoptr(FlValue) message = fl_value_new_list();
+  fl_value_append_take(message, fl_value_new_int(2));
+  g_autoptr(FlValue) reply = send_message(
+      messenger,
+      "dev.flutter.pigeon.pigeon_integration_tests.MultiplexedHostApi.suffix",
+      message);
+  EXPECT_EQ(reply, nullptr);
+}
+
+TEST(MultiplexedChannel, PerMethodChannelsStillWork) {
+  g_autoptr(FlStandardMessageCodec) codec = fl_standard_message_codec_new();
+  g_autoptr(FakeHostMessenger) messenger =
+      fake_host_messenger_new(FL_MESSAGE_CODEC(codec));
+  multiplexed_channel_pigeon_test_per_method_channel_host_api_set_method_handlers(
+      FL_BINARY_MESSENGER(messenger), nullptr, &per_method_vtable, nullptr,
+      nullptr);
+
+  g_autoptr(FlValue) message = fl_value_new_list();
+  fl_value_append_take(message, fl_value_new_int(30));
+  fl_value_append_take(message, fl_value_new_int(10));
+  g_autoptr(FlValue) reply = send_message(
+      messenger,
+      "dev.flutter.pigeon.pigeon_integration_tests.PerMethodChannelHostApi."
+      "subtract",
+      message);
+  ASSERT_NE(reply, nullptr);
+  EXPECT_EQ(fl_value_get_int(fl_value_get_list_value(reply, 0)), 20);
+}
@@ -61,3 +61,23 @@ TEST(NullFields, BuildReplyWithNulls) {
   EXPECT_EQ(null_fields_pigeon_test_null_fields_search_reply_get_type_(reply),
             nullptr);
 }
+
+TEST(NullFields, BuildReplyTakingValues) {
+  gchar* result = g_strdup("result");
+  FlValue* indices = fl_value_new_list();
+  NullFieldsPigeonTestNullFieldsSearchRequest* request =
+      null_fields_pigeon_test_null_fields_search_request_new("hello", 0);
+  g_autoptr(NullFieldsPigeonTestNullFieldsSearchReply) reply =
+      null_fields_pigeon_test_null_fields_search_reply_new_take(
+          result, nullptr, indices, request, nullptr);
+
+  // The values are not copied.
+  EXPECT_EQ(null_fields_pigeon_test_null_fields_search_reply_get_result(reply),
+            result);
+  EXPECT_EQ(null_fields_pigeon_test_null_fields_search_reply_get_error(reply),
+            nullptr);
+  EXPECT_EQ(null_fields_pigeon_test_null_fields_search_reply_get_indices(reply),
+            indices);
+  EXPECT_EQ(null_fields_pigeon_test_null_fields_search_reply_get_request(reply),
+            request);
+}
@@ -0,0 +1,94 @@
+// Copyright 2013 The Flutter Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include "pigeon/core_tests.gen.h"
+#include "test/utils/fake_host_messenger.h"
+
+static constexpr char kTaskQueueChannelName[] =
+    "dev.flutter.pigeon.pigeon_integration_tests.HostIntegrationCoreApi."
+    "taskQueueIsBackgroundThread";
+
+typedef struct {
+  std::thread::id main_thread_id;
+  std::vector<std::thread::id> handler_thread_ids;
+} TaskQueueTestData;
+
+static CoreTestsPigeonTestHostIntegrationCoreApiTaskQueueIsBackgroundThreadResponse*
+task_queue_is_background_thread(gpointer user_data) {
+  TaskQueueTestData* data = static_cast<TaskQueueTestData*>(user_data);
+  data->handler_thread_ids.push_back(std::this_thread::get_id());
+  return core_tests_pigeon_test_host_integration_core_api_task_queue_is_background_thread_response_new(
+      std::this_thread::get_id() != data->main_thread_id &&
+      !g_main_context_is_owner(g_main_context_default()));
+}
+
+static CoreTestsPigeonTestHostIntegrationCoreApiVTable vtable = {
+    .task_queue_is_background_thread = task_queue_is_background_thread};
+
+static void reply_cb(FlValue* reply, gpointer user_data) {
+  std::vector<FlValue*>* replies =
+      static_cast<std::vector<FlValue*>*>(user_data);
+  replies->push_back(fl_value_ref(reply));
+}
+
+TEST(TaskQueue, HandlersRunOnBackgroundThread) {
+  g_autoptr(FlStandardMessageCodec) codec = fl_standard_message_codec_new();
+  g_autoptr(FakeHostMessenger) messenger =
+      fake_host_messenger_new(FL_MESSAGE_CODEC(codec));
+  TaskQueueTestData data;
+  data.main_thread_id = std::this_thread::get_id();
+  core_tests_pigeon_test_host_integration_core_api_set_method_handlers(
+      FL_BINARY_MESSENGER(messenger), nullptr, &vtable, &data, nullptr);
+
+  constexpr size_t kMessageCount = 3;
+  std::vector<FlValue*> replies;
+  g_autoptr(FlValue) message = fl_value_new_list();
+  for (size_t i = 0; i < kMessageCount; i++) {
+    fake_host_messenger_send_host_message(messenger, kTaskQueueChannelName,
+                                          message, reply_cb, &replies);
+  }
+
+  // Responses are only sent from the main loop.
+  EXPECT_TRUE(replies.empty());
+  while (replies.size() < kMessageCount) {
+    g_main_context_iteration(nullptr, TRUE);
+  }
+
+  ASSERT_EQ(data.handler_thread_ids.size(), kMessageCount);
+  for (const std::thread::id& id : data.handler_thread_ids) {
+    EXPECT_NE(id, data.main_thread_id);
+  }
+  for (FlValue* reply : replies) {
+    ASSERT_EQ(fl_value_get_type(reply), FL_VALUE_TYPE_LIST);
+    EXPECT_TRUE(fl_value_get_bool(fl_value_get_list_value(reply, 0)));
+    fl_value_unref(reply);
+  }
+}
+
+TEST(TaskQueue, ClearedHandlersAreNotQueued) {
+  g_autoptr(FlStandardMessageCodec) codec = fl_standard_message_codec_new();
+  g_autoptr(FakeHostMessenger) messenger =
+      fake_host_messenger_new(FL_MESSAGE_CODEC(codec));
+  TaskQueueTestData data;
+  data.main_thread_id = std::this_thread::get_id();
+  core_tests_pigeon_test_host_integration_core_api_set_method_handlers(
+      FL_BINARY_MESSENGER(messenger), nullptr, &vtable, &data, nullptr);
+  core_tests_pigeon_test_host_integration_core_api_clear_method_handlers(
+      FL_BINARY_MESSENGER(messenger), nullptr);
+
+  std::vector<FlValue*> replies;
+  g_autoptr(FlValue) message = fl_value_new_list();
+  fake_host_messenger_send_host_message(messenger, kTaskQueueChannelName,
+                                        message, reply_cb, &replies);
+  while (g_main_context_iteration(nullptr, FALSE)) {
+  }
+
+  EXPECT_TRUE(replies.empty());
+  EXPECT_TRUE(data.handler_thread_ids.empty());
+}
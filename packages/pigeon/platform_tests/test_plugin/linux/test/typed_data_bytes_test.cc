@@ -0,0 +1,181 @@
+// Copyright 2013 The Flutter Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+#include "pigeon/core_tests_bytes.gen.h"
+
+static FlMessageCodec* create_codec() {
+  return FL_MESSAGE_CODEC(g_object_new(
+      core_tests_bytes_pigeon_test_message_codec_get_type(), nullptr));
+}
+
+static GBytes* encode_object(FlMessageCodec* codec, int type_id,
+                             GObject* object) {
+  g_autoptr(FlValue) value = fl_value_new_custom_object(type_id, object);
+  g_autoptr(GError) error = nullptr;
+  GBytes* message = fl_message_codec_encode_message(codec, value, &error);
+  EXPECT_EQ(error, nullptr);
+  return message;
+}
+
+// Returns true if [bytes] refers to memory inside [message].
+static bool is_slice_of(GBytes* bytes, GBytes* message) {
+  size_t message_size;
+  const uint8_t* message_data =
+      static_cast<const uint8_t*>(g_bytes_get_data(message, &message_size));
+  size_t size;
+  const uint8_t* data =
+      static_cast<const uint8_t*>(g_bytes_get_data(bytes, &size));
+  return data >= message_data && data + size <= message_data + message_size;
+}
+
+static CoreTestsBytesPigeonTestAllNullableTypesWithoutRecursion*
+create_all_nullable_types(const uint8_t* bytes, size_t bytes_length,
+                          const int64_t* int64s, size_t int64s_length) {
+  return core_tests_bytes_pigeon_test_all_nullable_types_without_recursion_new(
+      nullptr, nullptr, nullptr, nullptr, bytes, bytes_length, nullptr, 0,
+      int64s, int64s_length, nullptr, 0, nullptr, nullptr, nullptr, nullptr,
+      nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,
+      nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr);
+}
+
+TEST(TypedDataBytes, DecodedTypedDataSharesMessage) {
+  g_autoptr(FlMessageCodec) codec = create_codec();
+  const uint8_t bytes[] = {1, 2, 3, 4, 5};
+  const int32_t int32s[] = {-1, 0, 1};
+  const int64_t int64s[] = {G_MININT64, G_MAXINT64};
+  const double doubles[] = {0.5, -1.25, 1e300};
+  g_autoptr(FlValue) empty_list = fl_value_new_list();
+  g_autoptr(FlValue) empty_map = fl_value_new_map();
+  g_autoptr(FlValue) an_object = fl_value_new_int(0);
+  g_autoptr(CoreTestsBytesPigeonTestAllTypes) all_types =
+      core_tests_bytes_pigeon_test_all_types_new(
+          TRUE, 1, 2, 3.0, bytes, G_N_ELEMENTS(bytes), int32s,
+          G_N_ELEMENTS(int32s), int64s, G_N_ELEMENTS(int64s), doubles,
+          G_N_ELEMENTS(doubles), PIGEON_INTEGRATION_TESTS_AN_ENUM_TWO,
+          PIGEON_INTEGRATION_TESTS_ANOTHER_ENUM_JUST_IN_CASE, "", an_object,
+          empty_list, empty_list, empty_list, empty_list, empty_list,
+          empty_list, empty_list, empty_list, empty_list, empty_map, empty_map,
+          empty_map, empty_map, empty_map, empty_map, empty_map);
+
+  g_autoptr(GBytes) message =
+      encode_object(codec, core_tests_bytes_pigeon_test_all_types_type_id,
+                    G_OBJECT(all_types));
+  g_autoptr(GError) error = nullptr;
+  g_autoptr(FlValue) decoded =
+      fl_message_codec_decode_message(codec, message, &error);
+  ASSERT_NE(decoded, nullptr);
+  CoreTestsBytesPigeonTestAllTypes* decoded_all_types =
+      CORE_TESTS_BYTES_PIGEON_TEST_ALL_TYPES(
+          fl_value_get_custom_value_object(decoded));
+
+  EXPECT_TRUE(core_tests_bytes_pigeon_test_all_types_equals(all_types,
+                                                            decoded_all_types));
+  EXPECT_TRUE(is_slice_of(
+      core_tests_bytes_pigeon_test_all_types_get_a_byte_array_bytes(
+          decoded_all_types),
+      message));
+  EXPECT_TRUE(is_slice_of(
+      core_tests_bytes_pigeon_test_all_types_get_a4_byte_array_bytes(
+          decoded_all_types),
+      message));
+  EXPECT_TRUE(is_slice_of(
+      core_tests_bytes_pigeon_test_all_types_get_a8_byte_array_bytes(
+          decoded_all_types),
+      message));
+  EXPECT_TRUE(is_slice_of(
+      core_tests_bytes_pigeon_test_all_types_get_a_float_array_bytes(
+          decoded_all_types),
+      message));
+
+  size_t length;
+  const int64_t* decoded_int64s =
+      core_tests_bytes_pigeon_test_all_types_get_a8_byte_array(
+          decoded_all_types, &length);
+  ASSERT_EQ(length, G_N_ELEMENTS(int64s));
+  EXPECT_EQ(decoded_int64s[0], G_MININT64);
+  EXPECT_EQ(decoded_int64s[1], G_MAXINT64);
+}
+
+TEST(TypedDataBytes, DecodedDataOutlivesMessage) {
+  g_autoptr(FlMessageCodec) codec = create_codec();
+  const uint8_t bytes[] = {9, 8, 7};
+  g_autoptr(CoreTestsBytesPigeonTestAllNullableTypesWithoutRecursion)
+      all_nullable =
+          create_all_nullable_types(bytes, G_N_ELEMENTS(bytes), nullptr, 0);
+
+  GBytes* message = encode_object(
+      codec,
+      core_tests_bytes_pigeon_test_all_nullable_types_without_recursion_type_id,
+      G_OBJECT(all_nullable));
+  g_autoptr(GError) error = nullptr;
+  g_autoptr(FlValue) decoded =
+      fl_message_codec_decode_message(codec, message, &error);
+  g_bytes_unref(message);
+  ASSERT_NE(decoded, nullptr);
+
+  size_t length;
+  const uint8_t* decoded_bytes =
+      core_tests_bytes_pigeon_test_all_nullable_types_without_recursion_get_a_nullable_byte_array(
+          CORE_TESTS_BYTES_PIGEON_TEST_ALL_NULLABLE_TYPES_WITHOUT_RECURSION(
+              fl_value_get_custom_value_object(decoded)),
+          &length);
+  ASSERT_EQ(length, G_N_ELEMENTS(bytes));
+  EXPECT_EQ(memcmp(decoded_bytes, bytes, length), 0);
+}
+
+TEST(TypedDataBytes, NullAndEmptyTypedData) {
+  g_autoptr(FlMessageCodec) codec = create_codec();
+  const int64_t empty[] = {0};
+  g_autoptr(CoreTestsBytesPigeonTestAllNullableTypesWithoutRecursion)
+      all_nullable = create_all_nullable_types(nullptr, 0, empty, 0);
+
+  g_autoptr(GBytes) message = encode_object(
+      codec,
+      core_tests_bytes_pigeon_test_all_nullable_types_without_recursion_type_id,
+      G_OBJECT(all_nullable));
+  g_autoptr(GError) error = nullptr;
+  g_autoptr(FlValue) decoded =
+      fl_message_codec_decode_message(codec, message, &error);
+  ASSERT_NE(decoded, nullptr);
+  CoreTestsBytesPigeonTestAllNullableTypesWithoutRecursion* decoded_object =
+      CORE_TESTS_BYTES_PIGEON_TEST_ALL_NULLABLE_TYPES_WITHOUT_RECURSION(
+          fl_value_get_custom_value_object(decoded));
+
+  EXPECT_EQ(
+      core_tests_bytes_pigeon_test_all_nullable_types_without_recursion_get_a_nullable_byte_array_bytes(
+          decoded_object),
+      nullptr);
+  GBytes* empty_bytes =
+      core_tests_bytes_pigeon_test_all_nullable_types_without_recursion_get_a_nullable8_byte_array_bytes(
+          decoded_object);
+  ASSERT_NE(empty_bytes, nullptr);
+  EXPECT_EQ(g_bytes_get_size(empty_bytes), 0u);
+  EXPECT_TRUE(
+      core_tests_bytes_pigeon_test_all_nullable_types_without_recursion_equals(
+          all_nullable, decoded_object));
+}
+
+TEST(TypedDataBytes, TruncatedMessageFails) {
+  g_autoptr(FlMessageCodec) codec = create_codec();
+  const uint8_t bytes[] = {1, 2, 3, 4, 5, 6, 7, 8};
+  g_autoptr(CoreTestsBytesPigeonTestAllNullableTypesWithoutRecursion)
+      all_nullable =
+          create_all_nullable_types(bytes, G_N_ELEMENTS(bytes), nullptr, 0);
+
+  g_autoptr(GBytes) message = encode_object(
+      codec,
+      core_tests_bytes_pigeon_test_all_nullable_types_without_recursion_type_id,
+      G_OBJECT(all_nullable));
+  // Cut the message off in the middle of the byte array.
+  g_autoptr(GBytes) truncated = g_bytes_new_from_bytes(message, 0, 12);
+  g_autoptr(GError) error = nullptr;
+  g_autoptr(FlValue) decoded =
+      fl_message_codec_decode_message(codec, truncated, &error);
+  EXPECT_EQ(decoded, nullptr);
+  EXPECT_NE(error, nullptr);
+}
@@ -9,6 +9,12 @@ struct _FakeHostMessenger {
 
   FlMessageCodec* codec;
   GHashTable* message_handlers;
+
+  FakeHostMessengerDartMessageHandler dart_message_handler;
+  gpointer dart_message_handler_data;
+
+  FakeHostMessengerDartMessageResponder dart_message_responder;
+  gpointer dart_message_responder_data;
 };
 
 G_DECLARE_FINAL_TYPE(FakeHostMessengerResponseHandle,
@@ -83,6 +89,10 @@ static void set_message_handler_on_channel(
     FlBinaryMessengerMessageHandler handler, gpointer user_data,
     GDestroyNotify destroy_notify) {
   FakeHostMessenger* self = FAKE_HOST_MESSENGER(messenger);
+  if (handler == nullptr) {
+    g_hash_table_remove(self->message_handlers, channel);
+    return;
+  }
   g_hash_table_replace(self->message_handlers, g_strdup(channel),
                        message_handler_new(handler, user_data, destroy_notify));
 }
@@ -93,25 +103,59 @@ static gboolean send_response(FlBinaryMessenger* messenger,
   FakeHostMessenger* self = FAKE_HOST_MESSENGER(messenger);
   g_autoptr(FakeHostMessengerResponseHandle) r =
       FAKE_HOST_MESSENGER_RESPONSE_HANDLE(response_handle);
+  if (r->reply_callback == nullptr) {
+    return TRUE;
+  }
+
   g_autoptr(FlValue) reply =
       fl_message_codec_decode_message(self->codec, response, error);
   if (reply == nullptr) {
     return FALSE;
   }
 
-  if (r->reply_callback != nullptr) {
-    r->reply_callback(reply, r->user_data);
-  }
+  r->reply_callback(reply, r->user_data);
 
   return TRUE;
 }
 
 static void send_on_channel(FlBinaryMessenger* messenger, const gchar* channel,
                             GBytes* message, GCancellable* cancellable,
-                            GAsyncReadyCallback callback, gpointer user_data) {}
+                            GAsyncReadyCallback callback, gpointer user_data) {
+  FakeHostMessenger* self = FAKE_HOST_MESSENGER(messenger);
+  if (self->dart_message_handler != nullptr) {
+    self->dart_message_handler(channel, message,
+                               self->dart_message_handler_data);
+  }
+  if (self->dart_message_responder == nullptr || callback == nullptr) {
+    return;
+  }
+
+  g_autoptr(GTask) task = g_task_new(self, cancellable, callback, user_data);
+  GError* error = nullptr;
+  g_autoptr(FlValue) decoded_message =
+      fl_message_codec_decode_message(self->codec, message, &error);
+  if (decoded_message == nullptr) {
+    g_task_return_error(task, error);
+    return;
+  }
+  g_autoptr(FlValue) reply = self->dart_message_responder(
+      channel, decoded_message, self->dart_message_responder_data);
+  GBytes* encoded_reply =
+      fl_message_codec_encode_message(self->codec, reply, &error);
+  if (encoded_reply == nullptr) {
+    g_task_return_error(task, error);
+    return;
+  }
+  g_task_return_pointer(task, encoded_reply,
+                        reinterpret_cast<GDestroyNotify>(g_bytes_unref));
+}
 
 static GBytes* send_on_channel_finish(FlBinaryMessenger* messenger,
                                       GAsyncResult* result, GError** error) {
+  if (G_IS_TASK(result)) {
+    return static_cast<GBytes*>(
+        g_task_propagate_pointer(G_TASK(result), error));
+  }
   return g_bytes_new(nullptr, 0);
 }
 
@@ -181,3 +225,33 @@ void fake_host_messenger_send_host_message(
                            FL_BINARY_MESSENGER_RESPONSE_HANDLE(response_handle),
                            handler->message_handler_data);
 }
+
+void fake_host_messenger_send_host_bytes(FakeHostMessenger* self,
+                                         const gchar* channel,
+                                         GBytes* message) {
+  MessageHandler* handler = static_cast<MessageHandler*>(
+      g_hash_table_lookup(self->message_handlers, channel));
+  if (handler == nullptr) {
+    return;
+  }
+
+  FakeHostMessengerResponseHandle* response_handle =
+      fake_host_messenger_response_handle_new(nullptr, nullptr);
+  handler->message_handler(FL_BINARY_MESSENGER(self), channel, message,
+                           FL_BINARY_MESSENGER_RESPONSE_HANDLE(response_handle),
+                           handler->message_handler_data);
+}
+
+void fake_host_messenger_set_dart_message_handler(
+    FakeHostMessenger* self, FakeHostMessengerDartMessageHandler handler,
+    gpointer user_data) {
+  self->dart_message_handler = handler;
+  self->dart_message_handler_data = user_data;
+}
+
+void fake_host_messenger_set_dart_message_responder(
+    FakeHostMessenger* self, FakeHostMessengerDartMessageResponder responder,
+    gpointer user_data) {
+  self->dart_message_responder = responder;
+  self->dart_message_responder_data = user_data;
+}
@@ -10,6 +10,14 @@
 typedef void (*FakeHostMessengerReplyHandler)(FlValue* reply,
                                               gpointer user_data);
 
+typedef void (*FakeHostMessengerDartMessageHandler)(const gchar* channel,
+                                                    GBytes* message,
+                                                    gpointer user_data);
+
+typedef FlValue* (*FakeHostMessengerDartMessageResponder)(const gchar* channel,
+                                                          FlValue* message,
+                                                          gpointer user_data);
+
 // A BinaryMessenger that allows tests to act as the engine to call host APIs.
 G_DECLARE_FINAL_TYPE(FakeHostMessenger, fake_host_messenger, FAKE,
                      HOST_MESSENGER, GObject)
@@ -25,4 +33,28 @@ void fake_host_messenger_send_host_message(
     FakeHostMessenger* messenger, const gchar* channel, FlValue* message,
     FakeHostMessengerReplyHandler reply_callback, gpointer user_data);
 
+// Calls the registered handler for the given channel with an already encoded
+// message, ignoring the response.
+//
+// This allows a test to send messages that are not encoded with the message
+// codec, such as the method calls used by event channels.
+void fake_host_messenger_send_host_bytes(FakeHostMessenger* messenger,
+                                         const gchar* channel,
+                                         GBytes* message);
+
+// Sets the function that is called with messages sent from the host to the
+// Dart side, such as the events sent on an event channel.
+void fake_host_messenger_set_dart_message_handler(
+    FakeHostMessenger* messenger, FakeHostMessengerDartMessageHandler handler,
+    gpointer user_data);
+
+// Sets the function that replies to messages sent from the host to the Dart
+// side, such as the requests for the chunks of a streamed argument.
+//
+// The messages and replies are encoded with the messenger's codec, and the
+// replies are delivered from the main loop.
+void fake_host_messenger_set_dart_message_responder(
+    FakeHostMessenger* messenger,
+    FakeHostMessengerDartMessageResponder responder, gpointer user_data);
+
 #endif  // PLATFORM_TESTS_TEST_PLUGIN_LINUX_TEST_UTILS_FAKE_HOST_MESSENGER_H_
@@ -12,6 +12,8 @@
 #include <thread>
 
 #include "pigeon/core_tests.gen.h"
+#include "pigeon/event_channel_tests.gen.h"
+#include "proxy_api_test_impls.h"
 #include "test_plugin_private.h"
 
 struct _TestPlugin {
@@ -24,6 +26,8 @@ struct _TestPlugin {
   CoreTestsPigeonTestFlutterSmallApi* flutter_small_api_one;
   CoreTestsPigeonTestFlutterSmallApi* flutter_small_api_two;
 
+  ProxyApiTestImpls* proxy_api_impls;
+
   GCancellable* cancellable;
 
   std::thread::id main_thread_id;
@@ -849,8 +853,11 @@ default_is_main_thread(gpointer user_data) {
 static CoreTestsPigeonTestHostIntegrationCoreApiTaskQueueIsBackgroundThreadResponse*
 task_queue_is_background_thread(gpointer user_data) {
   TestPlugin* self = TEST_PLUGIN(user_data);
+  // The handler must neither be on the platform thread nor be run from an
+  // iteration of the main loop, which is what a main-thread fallback would do.
   return core_tests_pigeon_test_host_integration_core_api_task_queue_is_background_thread_response_new(
-      std::this_thread::get_id() != self->main_thread_id);
+      std::this_thread::get_id() != self->main_thread_id &&
+      !g_main_context_is_owner(g_main_context_default()));
 }
 
 static void noop_cb(GObject* object, GAsyncResult* result, gpointer user_data) {
@@ -3441,6 +3448,155 @@ static void void_void(
 static CoreTestsPigeonTestHostSmallApiVTable host_small_api_vtable = {
     .echo = echo, .void_void = void_void};
 
+// The state of a stream that sends an event every 10ms.
+typedef struct {
+  GObject* sink;
+  int64_t count;
+  int64_t value;
+} StreamData;
+
+static StreamData* stream_data_new(gpointer sink, int64_t value) {
+  StreamData* data = g_new0(StreamData, 1);
+  data->sink = G_OBJECT(g_object_ref(sink));
+  data->value = value;
+  return data;
+}
+
+static void stream_data_free(gpointer user_data) {
+  StreamData* data = static_cast<StreamData*>(user_data);
+  g_object_unref(data->sink);
+  g_free(data);
+}
+
+static gboolean send_int_cb(gpointer user_data) {
+  StreamData* data = static_cast<StreamData*>(user_data);
+  EventChannelTestsPigeonTestEventChannelMethodsStreamIntsEventSink* sink =
+      EVENT_CHANNEL_TESTS_PIGEON_TEST_EVENT_CHANNEL_METHODS_STREAM_INTS_EVENT_SINK(
+          data->sink);
+  if (data->count >= 5) {
+    event_channel_tests_pigeon_test_event_channel_methods_stream_ints_event_sink_end_of_stream(
+        sink);
+    return G_SOURCE_REMOVE;
+  }
+  event_channel_tests_pigeon_test_event_channel_methods_stream_ints_event_sink_success(
+      sink, data->count);
+  data->count++;
+  return G_SOURCE_CONTINUE;
+}
+
+static void stream_ints_on_listen(
+    EventChannelTestsPigeonTestEventChannelMethodsStreamIntsEventSink* sink,
+    gpointer user_data) {
+  g_timeout_add_full(G_PRIORITY_DEFAULT, 10, send_int_cb,
+                     stream_data_new(sink, 0), stream_data_free);
+}
+
+static EventChannelTestsPigeonTestPlatformEvent* create_platform_event(
+    int64_t index) {
+  switch (index) {
+    case 0:
+      return EVENT_CHANNEL_TESTS_PIGEON_TEST_PLATFORM_EVENT(
+          event_channel_tests_pigeon_test_int_event_new(1));
+    case 1:
+      return EVENT_CHANNEL_TESTS_PIGEON_TEST_PLATFORM_EVENT(
+          event_channel_tests_pigeon_test_string_event_new("string"));
+    case 2:
+      return EVENT_CHANNEL_TESTS_PIGEON_TEST_PLATFORM_EVENT(
+          event_channel_tests_pigeon_test_bool_event_new(FALSE));
+    case 3:
+      return EVENT_CHANNEL_TESTS_PIGEON_TEST_PLATFORM_EVENT(
+          event_channel_tests_pigeon_test_double_event_new(3.14));
+    case 4: {
+      g_autoptr(FlValue) value = fl_value_new_bool(TRUE);
+      return EVENT_CHANNEL_TESTS_PIGEON_TEST_PLATFORM_EVENT(
+          event_channel_tests_pigeon_test_objects_event_new(value));
+    }
+    case 5:
+      return EVENT_CHANNEL_TESTS_PIGEON_TEST_PLATFORM_EVENT(
+          event_channel_tests_pigeon_test_enum_event_new(
+              EVENT_CHANNEL_TESTS_PIGEON_TEST_EVENT_ENUM_FORTY_TWO));
+    case 6: {
+      int64_t a_nullable_int = 0;
+      g_autoptr(EventChannelTestsPigeonTestEventAllNullableTypes) value =
+          event_channel_tests_pigeon_test_event_all_nullable_types_new(
+              nullptr, &a_nullable_int, nullptr, nullptr, nullptr, 0, nullptr,
+              0, nullptr, 0, nullptr, 0, nullptr, nullptr, nullptr, nullptr,
+              nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,
+              nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,
+              nullptr, nullptr, nullptr, nullptr, nullptr);
+      return EVENT_CHANNEL_TESTS_PIGEON_TEST_PLATFORM_EVENT(
+          event_channel_tests_pigeon_test_class_event_new(value));
+    }
+    default:
+      return nullptr;
+  }
+}
+
+static gboolean send_event_cb(gpointer user_data) {
+  StreamData* data = static_cast<StreamData*>(user_data);
+  EventChannelTestsPigeonTestEventChannelMethodsStreamEventsEventSink* sink =
+      EVENT_CHANNEL_TESTS_PIGEON_TEST_EVENT_CHANNEL_METHODS_STREAM_EVENTS_EVENT_SINK(
+          data->sink);
+  g_autoptr(EventChannelTestsPigeonTestPlatformEvent) event =
+      create_platform_event(data->count);
+  if (event == nullptr) {
+    event_channel_tests_pigeon_test_event_channel_methods_stream_events_event_sink_end_of_stream(
+        sink);
+    return G_SOURCE_REMOVE;
+  }
+  event_channel_tests_pigeon_test_event_channel_methods_stream_events_event_sink_success(
+      sink, event);
+  data->count++;
+  return G_SOURCE_CONTINUE;
+}
+
+static void stream_events_on_listen(
+    EventChannelTestsPigeonTestEventChannelMethodsStreamEventsEventSink* sink,
+    gpointer user_data) {
+  g_timeout_add_full(G_PRIORITY_DEFAULT, 10, send_event_cb,
+                     stream_data_new(sink, 0), stream_data_free);
+}
+
+static gboolean send_consistent_number_cb(gpointer user_data) {
+  StreamData* data = static_cast<StreamData*>(user_data);
+  EventChannelTestsPigeonTestEventChannelMethodsStreamConsistentNumbersEventSink*
+      sink =
+          EVENT_CHANNEL_TESTS_PIGEON_TEST_EVENT_CHANNEL_METHODS_STREAM_CONSISTENT_NUMBERS_EVENT_SINK(
+              data->sink);
+  if (data->count >= 10) {
+    event_channel_tests_pigeon_test_event_channel_methods_stream_consistent_numbers_event_sink_end_of_stream(
+        sink);
+    return G_SOURCE_REMOVE;
+  }
+  event_channel_tests_pigeon_test_event_channel_methods_stream_consistent_numbers_event_sink_success(
+      sink, data->value);
+  data->count++;
+  return G_SOURCE_CONTINUE;
+}
+
+static void stream_consistent_numbers_on_listen(
+    EventChannelTestsPigeonTestEventChannelMethodsStreamConsistentNumbersEventSink*
+        sink,
+    gpointer user_data) {
+  // Each instance of the stream sends the number it was registered with.
+  int64_t number = user_data != nullptr ? *static_cast<int64_t*>(user_data) : 0;
+  g_timeout_add_full(G_PRIORITY_DEFAULT, 10, send_consistent_number_cb,
+                     stream_data_new(sink, number), stream_data_free);
+}
+
+static EventChannelTestsPigeonTestEventChannelMethodsVTable
+    event_channel_methods_vtable = {
+        .stream_ints_on_listen = stream_ints_on_listen,
+        .stream_events_on_listen = stream_events_on_listen,
+        .stream_consistent_numbers_on_listen =
+            stream_consistent_numbers_on_listen};
+
+static int64_t* new_number(int64_t value) {
+  int64_t* number = g_new(int64_t, 1);
+  *number = value;
+  return number;
+}
+
 static void test_plugin_dispose(GObject* object) {
   TestPlugin* self = TEST_PLUGIN(object);
 
@@ -3452,10 +3608,17 @@ static void test_plugin_dispose(GObject* object) {
                                                               "suffixOne");
   core_tests_pigeon_test_host_small_api_clear_method_handlers(self->messenger,
                                                               "suffixTwo");
+  event_channel_tests_pigeon_test_event_channel_methods_clear_stream_handlers(
+      self->messenger, nullptr);
+  event_channel_tests_pigeon_test_event_channel_methods_clear_stream_handlers(
+      self->messenger, "1");
+  event_channel_tests_pigeon_test_event_channel_methods_clear_stream_handlers(
+      self->messenger, "2");
 
   g_clear_object(&self->flutter_core_api);
   g_clear_object(&self->flutter_small_api_one);
   g_clear_object(&self->flutter_small_api_two);
+  g_clear_object(&self->proxy_api_impls);
   g_clear_object(&self->cancellable);
 
   G_OBJECT_CLASS(test_plugin_parent_class)->dispose(object);
@@ -3469,7 +3632,7 @@ static void test_plugin_init(TestPlugin* self) {
   self->cancellable = g_cancellable_new();
 }
 
-static TestPlugin* test_plugin_new(FlBinaryMessenger* messenger) {
+TestPlugin* test_plugin_new(FlBinaryMessenger* messenger) {
   TestPlugin* self = TEST_PLUGIN(g_object_new(test_plugin_get_type(), nullptr));
 
   self->messenger = messenger;
@@ -3482,6 +3645,12 @@ static TestPlugin* test_plugin_new(FlBinaryMessenger* messenger) {
   core_tests_pigeon_test_host_small_api_set_method_handlers(
       messenger, "suffixTwo", &host_small_api_vtable, g_object_ref(self),
       g_object_unref);
+  event_channel_tests_pigeon_test_event_channel_methods_set_stream_handlers(
+      messenger, nullptr, &event_channel_methods_vtable, nullptr, nullptr);
+  event_channel_tests_pigeon_test_event_channel_methods_set_stream_handlers(
+      messenger, "1", &event_channel_methods_vtable, new_number(1), g_free);
+  event_channel_tests_pigeon_test_event_channel_methods_set_stream_handlers(
+      messenger, "2", &event_channel_methods_vtable, new_number(2), g_free);
   self->flutter_core_api =
       core_tests_pigeon_test_flutter_integration_core_api_new(messenger,
                                                               nullptr);
@@ -3489,6 +3658,7 @@ static TestPlugin* test_plugin_new(FlBinaryMessenger* messenger) {
       core_tests_pigeon_test_flutter_small_api_new(messenger, "suffixOne");
   self->flutter_small_api_two =
       core_tests_pigeon_test_flutter_small_api_new(messenger, "suffixTwo");
+  self->proxy_api_impls = proxy_api_test_impls_new(messenger);
 
   self->main_thread_id = std::this_thread::get_id();
 
@@ -12,3 +12,6 @@
 
 // Handles the getPlatformVersion method call.
 FlMethodResponse* get_platform_version();
+
+// Creates a plugin that handles the messages of the host APIs on |messenger|.
+TestPlugin* test_plugin_new(FlBinaryMessenger* messenger);
@@ -0,0 +1,140 @@
+// Copyright 2013 The Flutter Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Compares the heap allocations and latency of a Flutter API call made with
+// the on_success and on_error callbacks with the same call co_awaited, as
+// generated with CppOptions.coroutines.
+//
+// Dart is replaced by a messenger that replies before Send returns, so every
+// allocation made for a call is counted, including the message, the decoded
+// reply and, for the co_awaited call, the frame of the calling coroutine.
+
+#include <flutter/binary_messenger.h>
+#include <flutter/encodable_value.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "pigeon/core_tests_coroutines.gen.h"
+
+namespace {
+
+using core_tests_coroutines_pigeontest::ErrorOr;
+using core_tests_coroutines_pigeontest::FlutterError;
+using core_tests_coroutines_pigeontest::FlutterSmallApi;
+using core_tests_coroutines_pigeontest::PigeonTask;
+using flutter::EncodableList;
+using flutter::EncodableValue;
+
+constexpr int kWarmUpIterations = 1000;
+constexpr int kIterations = 100000;
+
+// The number of calls to operator new since the program started.
+size_t allocation_count = 0;
+
+}  // namespace
+
+void* operator new(size_t size) {
+  allocation_count++;
+  if (void* pointer = std::malloc(size == 0 ? 1 : size)) {
+    return pointer;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+
+void operator delete(void* pointer, size_t size) noexcept {
+  std::free(pointer);
+}
+
+namespace {
+
+// A messenger that immediately replies to every message with the same
+// encoded reply.
+class ReplyingMessenger : public flutter::BinaryMessenger {
+ public:
+  explicit ReplyingMessenger(const EncodableValue& reply)
+      : reply_(*FlutterSmallApi::GetCodec().EncodeMessage(reply)) {}
+
+  // flutter::BinaryMessenger:
+  void Send(const std::string& channel, const uint8_t* message,
+            size_t message_size,
+            flutter::BinaryReply reply = nullptr) const override {
+    reply(reply_.data(), reply_.size());
+  }
+  void SetMessageHandler(const std::string& channel,
+                         flutter::BinaryMessageHandler handler) override {}
+
+ private:
+  std::vector<uint8_t> reply_;
+};
+
+PigeonTask<ErrorOr<std::string>> CallEchoString(FlutterSmallApi* api,
+                                                const std::string& value) {
+  co_return co_await api->EchoString(value);
+}
+
+// Calls |call| |kIterations| times, and prints the average number of
+// allocations and the median and 99th percentile latency of a call under
+// |name|.
+template <typename Call>
+void RunBenchmark(const char* name, Call call) {
+  for (int i = 0; i < kWarmUpIterations; i++) {
+    call();
+  }
+
+  std::vector<double> latencies_us(kIterations);
+  size_t allocations = 0;
+  for (int i = 0; i < kIterations; i++) {
+    const size_t allocations_before = allocation_count;
+    auto start = std::chrono::steady_clock::now();
+    call();
+    auto end = std::chrono::steady_clock::now();
+    allocations += allocation_count - allocations_before;
+    latencies_us[i] =
+        std::chrono::duration<double, std::micro>(end - start).count();
+  }
+  std::sort(latencies_us.begin(), latencies_us.end());
+
+  printf("  %-10s %6.1f allocations %8.3f us p50 %8.3f us p99\n", name,
+         static_cast<double>(allocations) / kIterations,
+         latencies_us[kIterations / 2], latencies_us[kIterations * 99 / 100]);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  ReplyingMessenger messenger(
+      EncodableValue(EncodableList{EncodableValue("hello")}));
+  FlutterSmallApi api(&messenger);
+  const std::string value("hello");
+  size_t reply_count = 0;
+
+  printf("FlutterSmallApi.echoString, per call:\n");
+  RunBenchmark("callbacks", [&]() {
+    api.EchoString(
+        value, [&reply_count](const std::string& reply) { reply_count++; },
+        [](const FlutterError& error) {});
+  });
+  RunBenchmark("co_await", [&]() {
+    PigeonTask<ErrorOr<std::string>> task = CallEchoString(&api, value);
+    if (task.await_ready() && !task.await_resume().has_error()) {
+      reply_count++;
+    }
+  });
+
+  if (reply_count != 2 * (kWarmUpIterations + kIterations)) {
+    fprintf(stderr, "Not every call was replied to\n");
+    return 1;
+  }
+  return 0;
+}
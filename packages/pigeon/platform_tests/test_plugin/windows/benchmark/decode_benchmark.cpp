@@ -0,0 +1,136 @@
+// Copyright 2013 The Flutter Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Compares decoding data classes by reading their fields directly from the
+// message stream, which is what the generated codec does, with decoding them
+// from an intermediate EncodableList of all of their fields.
+//
+// Each payload is encoded once, and then decoded repeatedly from the same
+// bytes with each codec. Throughput is reported against the encoded size.
+
+#include <flutter/encodable_value.h>
+#include <flutter/standard_message_codec.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "pigeon/core_tests.gen.h"
+#include "test/utils/core_tests_test.h"
+
+namespace {
+
+using core_tests_pigeontest::AllClassesWrapper;
+using core_tests_pigeontest::AllNullableTypes;
+using core_tests_pigeontest::AllTypes;
+using core_tests_pigeontest::AnEnum;
+using core_tests_pigeontest::AnotherEnum;
+using core_tests_pigeontest::CoreTestsTest;
+using core_tests_pigeontest::PigeonInternalCodecSerializer;
+using flutter::CustomEncodableValue;
+using flutter::EncodableList;
+using flutter::EncodableMap;
+using flutter::EncodableValue;
+using flutter::StandardMessageCodec;
+
+// The approximate number of bytes to decode for each payload and codec.
+constexpr size_t kTotalBytes = 256 * 1024 * 1024;
+
+AllTypes CreateAllTypes(size_t data_size) {
+  return AllTypes(
+      true, 42, 0x7FFFFFFFFFFF, 3.5, std::vector<uint8_t>(data_size, 1),
+      std::vector<int32_t>(data_size / 4, 2),
+      std::vector<int64_t>(data_size / 8, 3),
+      std::vector<double>(data_size / 8, 4.5), AnEnum::kFortyTwo,
+      AnotherEnum::kJustInCase, std::string(data_size, 's'), EncodableValue(),
+      EncodableList(), EncodableList(), EncodableList(), EncodableList(),
+      EncodableList(), EncodableList(), EncodableList(), EncodableList(),
+      EncodableList(), EncodableMap(), EncodableMap(), EncodableMap(),
+      EncodableMap(), EncodableMap(), EncodableMap(), EncodableMap());
+}
+
+AllNullableTypes CreateAllNullableTypes() {
+  AllNullableTypes value;
+  value.set_a_nullable_bool(true);
+  value.set_a_nullable_int(1);
+  value.set_a_nullable_int64(2);
+  value.set_a_nullable_double(3.0);
+  value.set_a_nullable_string("a nullable string value");
+  value.set_a_nullable_enum(AnEnum::kTwo);
+  return value;
+}
+
+// Returns a wrapper holding |count| AllNullableTypes and AllTypes objects.
+AllClassesWrapper CreateAllClassesWrapper(int count) {
+  EncodableList class_list;
+  EncodableMap class_map;
+  for (int i = 0; i < count; i++) {
+    class_list.push_back(CustomEncodableValue(CreateAllNullableTypes()));
+    class_map[EncodableValue(i)] = CustomEncodableValue(CreateAllTypes(16));
+  }
+  AllClassesWrapper wrapper(CreateAllNullableTypes(), class_list, class_map);
+  wrapper.set_all_types(CreateAllTypes(16));
+  return wrapper;
+}
+
+double TimeDecodes(const StandardMessageCodec& codec,
+                   const std::vector<uint8_t>& message, int iterations) {
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; i++) {
+    std::unique_ptr<EncodableValue> decoded = codec.DecodeMessage(message);
+    if (decoded->IsNull()) {
+      fprintf(stderr, "Decoded a null value\n");
+    }
+  }
+  return std::chrono::duration<double, std::micro>(
+             std::chrono::steady_clock::now() - start)
+             .count() /
+         iterations;
+}
+
+void RunDecodeBenchmark(const char* name, const EncodableValue& value) {
+  const StandardMessageCodec& stream_codec = StandardMessageCodec::GetInstance(
+      &PigeonInternalCodecSerializer::GetInstance());
+  const StandardMessageCodec& list_codec = StandardMessageCodec::GetInstance(
+      &CoreTestsTest::ListDecodingSerializer::GetInstance());
+  std::vector<uint8_t> message = *stream_codec.EncodeMessage(value);
+
+  int iterations =
+      static_cast<int>(std::max<size_t>(1, kTotalBytes / message.size()));
+  iterations = std::min(iterations, 1000000);
+  double list_us = TimeDecodes(list_codec, message, iterations);
+  double stream_us = TimeDecodes(stream_codec, message, iterations);
+
+  double megabytes = message.size() / (1024.0 * 1024.0);
+  printf("%-28s %10zu B   list %10.3f us (%8.1f MB/s)   stream %10.3f us "
+         "(%8.1f MB/s)\n",
+         name, message.size(), list_us, megabytes / (list_us / 1e6), stream_us,
+         megabytes / (stream_us / 1e6));
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  printf("Decoding data classes from a message:\n");
+  RunDecodeBenchmark("AllNullableTypes",
+                     CustomEncodableValue(CreateAllNullableTypes()));
+  RunDecodeBenchmark("AllNullableTypes (empty)",
+                     CustomEncodableValue(AllNullableTypes()));
+  for (size_t data_size : {16, 4 * 1024, 1024 * 1024}) {
+    std::string name = "AllTypes (" + std::to_string(data_size) + " B data)";
+    RunDecodeBenchmark(name.c_str(),
+                       CustomEncodableValue(CreateAllTypes(data_size)));
+  }
+  for (int count : {10, 1000}) {
+    std::string name = "AllClassesWrapper (" + std::to_string(count) + ")";
+    RunDecodeBenchmark(name.c_str(),
+                       CustomEncodableValue(CreateAllClassesWrapper(count)));
+  }
+
+  return 0;
+}
@@ -0,0 +1,157 @@
+// Copyright 2013 The Flutter Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Measures the rate of Flutter API calls and their heap allocations, from the
+// arguments to the decoded reply.
+//
+// Calls made on one long-lived API instance, which reuses the channel of each
+// method, are compared with calls made on a new instance each time, which has
+// to name and create the channel again as every call used to.
+//
+// Dart is replaced by a messenger that replies before Send returns, so every
+// allocation made for a call is counted, including the message, the reply
+// callbacks and the decoded reply.
+
+#include <flutter/binary_messenger.h>
+#include <flutter/encodable_value.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "pigeon/core_tests.gen.h"
+
+namespace {
+
+using core_tests_pigeontest::FlutterError;
+using core_tests_pigeontest::FlutterIntegrationCoreApi;
+using flutter::EncodableList;
+using flutter::EncodableValue;
+
+constexpr int kWarmUpIterations = 1000;
+constexpr int kIterations = 200000;
+
+// The number of calls to operator new since the program started.
+size_t allocation_count = 0;
+
+}  // namespace
+
+void* operator new(size_t size) {
+  allocation_count++;
+  if (void* pointer = std::malloc(size == 0 ? 1 : size)) {
+    return pointer;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+
+void operator delete(void* pointer, size_t size) noexcept {
+  std::free(pointer);
+}
+
+namespace {
+
+// A messenger that immediately replies to every message with the same
+// encoded reply.
+class ReplyingMessenger : public flutter::BinaryMessenger {
+ public:
+  explicit ReplyingMessenger(const EncodableValue& reply)
+      : reply_(*FlutterIntegrationCoreApi::GetCodec().EncodeMessage(reply)) {}
+
+  // flutter::BinaryMessenger:
+  void Send(const std::string& channel, const uint8_t* message,
+            size_t message_size,
+            flutter::BinaryReply reply = nullptr) const override {
+    reply(reply_.data(), reply_.size());
+  }
+  void SetMessageHandler(const std::string& channel,
+                         flutter::BinaryMessageHandler handler) override {}
+
+ private:
+  std::vector<uint8_t> reply_;
+};
+
+// Calls |call| with an API on |messenger| |kIterations| times, and prints the
+// rate of calls and the average number of allocations per call under |name|.
+//
+// The API is created once unless |instance_per_call| is set.
+//
+// Returns false if not every call was replied to.
+bool RunBenchmark(
+    const char* name, ReplyingMessenger* messenger, bool instance_per_call,
+    const std::function<void(FlutterIntegrationCoreApi*, size_t*)>& call) {
+  FlutterIntegrationCoreApi shared_api(messenger);
+  size_t reply_count = 0;
+  auto call_once = [&]() {
+    if (instance_per_call) {
+      FlutterIntegrationCoreApi api(messenger);
+      call(&api, &reply_count);
+    } else {
+      call(&shared_api, &reply_count);
+    }
+  };
+
+  for (int i = 0; i < kWarmUpIterations; i++) {
+    call_once();
+  }
+
+  const size_t allocations_before = allocation_count;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kIterations; i++) {
+    call_once();
+  }
+  auto end = std::chrono::steady_clock::now();
+  const size_t allocations = allocation_count - allocations_before;
+  const double seconds = std::chrono::duration<double>(end - start).count();
+
+  printf("  %-30s %12.0f calls/s %6.1f allocations\n", name,
+         kIterations / seconds, static_cast<double>(allocations) / kIterations);
+  return reply_count == kWarmUpIterations + kIterations;
+}
+
+void CallNoop(FlutterIntegrationCoreApi* api, size_t* reply_count) {
+  api->Noop([reply_count]() { (*reply_count)++; },
+            [](const FlutterError& error) {});
+}
+
+void CallEchoString(FlutterIntegrationCoreApi* api, size_t* reply_count) {
+  api->EchoString(
+      "hello",
+      [reply_count](const std::string& reply) { (*reply_count)++; },
+      [](const FlutterError& error) {});
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  ReplyingMessenger noop_messenger(
+      EncodableValue(EncodableList{EncodableValue()}));
+  ReplyingMessenger echo_messenger(
+      EncodableValue(EncodableList{EncodableValue("hello")}));
+
+  printf("FlutterIntegrationCoreApi, %d calls:\n", kIterations);
+  bool replied = RunBenchmark("noop", &noop_messenger, false, CallNoop);
+  replied = RunBenchmark("noop, instance per call", &noop_messenger, true,
+                         CallNoop) &&
+            replied;
+  replied = RunBenchmark("echoString", &echo_messenger, false,
+                         CallEchoString) &&
+            replied;
+  replied = RunBenchmark("echoString, instance per call", &echo_messenger,
+                         true, CallEchoString) &&
+            replied;
+
+  if (!replied) {
+    fprintf(stderr, "Not every call was replied to\n");
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,131 @@
+// Copyright 2013 The Flutter Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Compares host APIs whose SetUp writes out a handler for each method with the
+// same APIs generated with CppOptions.tableDrivenDispatch, which register
+// their methods from a table through one shared handler.
+//
+// SetUp is timed for HostIntegrationCoreApi, which has 160 methods, and the
+// cost of handling a message for HostSmallApi.echo, which should be the same
+// for both.
+
+#include <flutter/encodable_value.h>
+
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+
+#include "pigeon/core_tests.gen.h"
+#include "pigeon/core_tests_table.gen.h"
+#include "test/utils/fake_host_messenger.h"
+
+namespace {
+
+namespace table = core_tests_table_pigeontest;
+
+using flutter::EncodableList;
+using flutter::EncodableValue;
+using testing::FakeHostMessenger;
+
+constexpr int kSetUpIterations = 2000;
+constexpr int kMessageIterations = 200000;
+
+constexpr char kEchoChannelName[] =
+    "dev.flutter.pigeon.pigeon_integration_tests.HostSmallApi.echo";
+
+// A task queue for the methods that use one, which never gets a task since
+// the benchmark doesn't send messages to those methods.
+template <typename TaskQueue>
+class UnusedTaskQueue : public TaskQueue {
+ public:
+  void Post(std::function<void()> task) override {}
+  void PostReply(std::function<void()> send_reply) override {}
+};
+
+template <typename Api, typename StringResult, typename FlutterError>
+class EchoSmallApi : public Api {
+ public:
+  void Echo(const std::string& a_string,
+            std::function<void(StringResult reply)> result) override {
+    result(a_string);
+  }
+
+  void VoidVoid(std::function<void(std::optional<FlutterError> reply)> result)
+      override {
+    result(std::nullopt);
+  }
+};
+
+template <typename Function>
+double TimeMicroseconds(int iterations, Function function) {
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; i++) {
+    function();
+  }
+  return std::chrono::duration<double, std::micro>(
+             std::chrono::steady_clock::now() - start)
+             .count() /
+         iterations;
+}
+
+// Times setting up and clearing the handlers of HostIntegrationCoreApi.
+template <typename Api, typename TaskQueue>
+void RunSetUpBenchmark(const char* name) {
+  FakeHostMessenger messenger(&Api::GetCodec());
+  auto task_queue = std::make_shared<UnusedTaskQueue<TaskQueue>>();
+  // SetUp only stores the API pointer in the handlers, and no messages are
+  // sent, so there is no need to implement every method.
+  alignas(Api) unsigned char storage[sizeof(Api)];
+  Api* api = reinterpret_cast<Api*>(storage);
+
+  double set_up_us = TimeMicroseconds(kSetUpIterations, [&]() {
+    Api::SetUp(&messenger, api, "", task_queue);
+  });
+  double clear_us = TimeMicroseconds(
+      kSetUpIterations, [&]() { Api::SetUp(&messenger, nullptr, ""); });
+  printf("  %-14s SetUp %8.1f us   clear %8.1f us\n", name, set_up_us,
+         clear_us);
+}
+
+// Times sending a message to HostSmallApi.echo and decoding its reply.
+template <typename Api, typename StringResult, typename FlutterError>
+void RunMessageBenchmark(const char* name) {
+  FakeHostMessenger messenger(&Api::GetCodec());
+  EchoSmallApi<Api, StringResult, FlutterError> api;
+  Api::SetUp(&messenger, &api);
+  const EncodableValue message(EncodableList{EncodableValue("hello")});
+
+  size_t reply_count = 0;
+  double message_us = TimeMicroseconds(kMessageIterations, [&]() {
+    messenger.SendHostMessage(
+        kEchoChannelName, message,
+        [&reply_count](const EncodableValue& reply) { reply_count++; });
+  });
+  if (reply_count != kMessageIterations) {
+    fprintf(stderr, "Not every message was replied to\n");
+  }
+  printf("  %-14s %8.3f us/message\n", name, message_us);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  printf("HostIntegrationCoreApi (160 methods):\n");
+  RunSetUpBenchmark<core_tests_pigeontest::HostIntegrationCoreApi,
+                    core_tests_pigeontest::PigeonTaskQueue>("per-method");
+  RunSetUpBenchmark<table::HostIntegrationCoreApi, table::PigeonTaskQueue>(
+      "table");
+
+  printf("HostSmallApi.echo:\n");
+  RunMessageBenchmark<core_tests_pigeontest::HostSmallApi,
+                      core_tests_pigeontest::ErrorOr<std::string>,
+                      core_tests_pigeontest::FlutterError>("per-method");
+  RunMessageBenchmark<table::HostSmallApi, table::ErrorOr<std::string>,
+                      table::FlutterError>("table");
+
+  return 0;
+}
@@ -0,0 +1,177 @@
+// Copyright 2013 The Flutter Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Measures the heap allocations and latency of a host API call, from the
+// encoded message to the encoded reply, for the largest data class shapes of
+// HostIntegrationCoreApi.
+//
+// Every allocation made while handling the message is counted, including the
+// implementation's copy of its argument, the channel's and the codec's.
+//
+// The calls are handled by TestPlugin, which implements the whole API and
+// includes the Windows plugin headers, so this benchmark is only built with
+// the Windows plugin (see TEST_PLUGIN_BUILD_BENCHMARKS), and its results are
+// for Windows only.
+
+#include <flutter/encodable_value.h>
+#include <flutter/standard_message_codec.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "pigeon/core_tests.gen.h"
+#include "test/utils/fake_host_messenger.h"
+#include "test_plugin.h"
+
+namespace {
+
+using core_tests_pigeontest::AllNullableTypes;
+using core_tests_pigeontest::AllTypes;
+using core_tests_pigeontest::AnEnum;
+using core_tests_pigeontest::AnotherEnum;
+using core_tests_pigeontest::HostIntegrationCoreApi;
+using flutter::CustomEncodableValue;
+using flutter::EncodableList;
+using flutter::EncodableMap;
+using flutter::EncodableValue;
+using testing::FakeHostMessenger;
+
+constexpr int kWarmUpIterations = 1000;
+constexpr int kIterations = 100000;
+
+constexpr char kChannelPrefix[] =
+    "dev.flutter.pigeon.pigeon_integration_tests.HostIntegrationCoreApi.";
+
+// The number of calls to operator new since the program started.
+size_t allocation_count = 0;
+
+}  // namespace
+
+void* operator new(size_t size) {
+  allocation_count++;
+  if (void* pointer = std::malloc(size == 0 ? 1 : size)) {
+    return pointer;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+
+void operator delete(void* pointer, size_t size) noexcept {
+  std::free(pointer);
+}
+
+namespace {
+
+AllTypes CreateAllTypes() {
+  EncodableList string_list = {EncodableValue("a"), EncodableValue("b")};
+  EncodableMap string_map = {{EncodableValue("key"), EncodableValue("value")}};
+  return AllTypes(
+      true, 42, 0x7FFFFFFFFFFF, 3.5, std::vector<uint8_t>(64, 1),
+      std::vector<int32_t>{4, 5}, std::vector<int64_t>{6},
+      std::vector<double>{7.5, 8.5}, AnEnum::kFortyTwo,
+      AnotherEnum::kJustInCase, "a string that doesn't fit inline",
+      EncodableValue(12), string_list, string_list, EncodableList(),
+      EncodableList(), EncodableList(), EncodableList(), string_list,
+      EncodableList(), EncodableList(), string_map, string_map, EncodableMap(),
+      EncodableMap(), string_map, EncodableMap(), EncodableMap());
+}
+
+AllNullableTypes CreateAllNullableTypes() {
+  AllNullableTypes nested;
+  nested.set_a_nullable_string("nested");
+
+  AllNullableTypes everything;
+  everything.set_a_nullable_bool(false);
+  everything.set_a_nullable_int(-1);
+  everything.set_a_nullable_int64(1);
+  everything.set_a_nullable_double(-0.5);
+  everything.set_a_nullable_byte_array(std::vector<uint8_t>(64, 9));
+  everything.set_a_nullable_enum(AnEnum::kTwo);
+  everything.set_a_nullable_string("a string that doesn't fit inline");
+  everything.set_all_nullable_types(nested);
+  everything.set_list(EncodableList{EncodableValue(1), EncodableValue()});
+  everything.set_recursive_class_list(
+      EncodableList{CustomEncodableValue(nested)});
+  everything.set_int_map(EncodableMap{{EncodableValue(1), EncodableValue(2)}});
+  return everything;
+}
+
+// Calls |method| with |argument| |kIterations| times, and prints the average
+// number of allocations and the median and 99th percentile latency of a call
+// under |name|.
+//
+// Returns false if the reply to the first call isn't the argument.
+bool RunBenchmark(FakeHostMessenger* messenger, const char* name,
+                  const std::string& method, const EncodableValue& argument) {
+  const flutter::StandardMessageCodec& codec =
+      HostIntegrationCoreApi::GetCodec();
+  const std::string channel = kChannelPrefix + method;
+  const EncodableValue message(EncodableList{argument});
+  const std::vector<uint8_t> encoded_message = *codec.EncodeMessage(message);
+
+  // CustomEncodableValues only compare equal to themselves, so the reply is
+  // compared with the expected one once encoded.
+  bool echoed = false;
+  messenger->SendHostMessage(
+      channel, message,
+      [&codec, &echoed, &message](const EncodableValue& reply) {
+        echoed = *codec.EncodeMessage(reply) == *codec.EncodeMessage(message);
+      });
+
+  for (int i = 0; i < kWarmUpIterations; i++) {
+    messenger->SendHostBytes(channel, encoded_message);
+  }
+
+  std::vector<double> latencies_us(kIterations);
+  size_t allocations = 0;
+  for (int i = 0; i < kIterations; i++) {
+    const size_t allocations_before = allocation_count;
+    auto start = std::chrono::steady_clock::now();
+    messenger->SendHostBytes(channel, encoded_message);
+    auto end = std::chrono::steady_clock::now();
+    allocations += allocation_count - allocations_before;
+    latencies_us[i] =
+        std::chrono::duration<double, std::micro>(end - start).count();
+  }
+  std::sort(latencies_us.begin(), latencies_us.end());
+
+  printf("  %-26s %4zu B %6.1f allocations %8.3f us p50 %8.3f us p99\n",
+         name, encoded_message.size(),
+         static_cast<double>(allocations) / kIterations,
+         latencies_us[kIterations / 2], latencies_us[kIterations * 99 / 100]);
+  return echoed;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  FakeHostMessenger messenger(&HostIntegrationCoreApi::GetCodec());
+  test_plugin::TestPlugin plugin(&messenger, nullptr, nullptr);
+  HostIntegrationCoreApi::SetUp(&messenger, &plugin);
+
+  printf("HostIntegrationCoreApi, per call:\n");
+  bool echoed = RunBenchmark(&messenger, "echoAllTypes", "echoAllTypes",
+                             CustomEncodableValue(CreateAllTypes()));
+  echoed = RunBenchmark(&messenger, "echoAllNullableTypes",
+                        "echoAllNullableTypes",
+                        CustomEncodableValue(CreateAllNullableTypes())) &&
+           echoed;
+  echoed = RunBenchmark(&messenger, "echoAllNullableTypes(null)",
+                        "echoAllNullableTypes", EncodableValue()) &&
+           echoed;
+
+  if (!echoed) {
+    fprintf(stderr, "Not every argument was echoed\n");
+    return 1;
+  }
+  return 0;
+}
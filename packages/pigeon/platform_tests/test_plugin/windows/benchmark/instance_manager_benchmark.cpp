@@ -0,0 +1,158 @@
+// Copyright 2013 The Flutter Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Measures the ProxyApi instance manager, first one operation at a time on a
+// single thread, then under contention from several threads.
+//
+// In the multi-threaded runs each thread repeatedly adds an instance, looks
+// it up in both directions and releases it, while another thread sends the
+// releases to Dart as the platform thread would. The throughput counts all
+// four operations.
+
+#include <flutter/standard_message_codec.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "pigeon/proxy_api_tests.gen.h"
+#include "test/utils/fake_host_messenger.h"
+
+namespace {
+
+using proxy_api_tests_pigeontest::PigeonInstanceManager;
+
+constexpr int kInstanceCount = 100000;
+constexpr int kOperationsPerInstance = 4;
+constexpr int kThreadCounts[] = {1, 2, 4, 8};
+
+double ElapsedMicroseconds(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double, std::micro>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+void PrintResult(const char* name, double elapsed_us) {
+  printf("  %-26s %10.3f us/op\n", name, elapsed_us / kInstanceCount);
+}
+
+// Returns a messenger that counts the releases sent to Dart.
+std::unique_ptr<testing::FakeHostMessenger> CreateMessenger(
+    std::atomic<int>* release_count) {
+  auto messenger = std::make_unique<testing::FakeHostMessenger>(
+      &flutter::StandardMessageCodec::GetInstance());
+  messenger->SetDartMessageHandler(
+      [release_count](const std::string& channel, const uint8_t* message,
+                      size_t message_size) { (*release_count)++; });
+  return messenger;
+}
+
+bool RunSingleThreaded() {
+  std::atomic<int> release_count(0);
+  std::unique_ptr<testing::FakeHostMessenger> messenger =
+      CreateMessenger(&release_count);
+  PigeonInstanceManager instance_manager(messenger.get());
+
+  std::vector<std::shared_ptr<void>> instances(kInstanceCount);
+  for (int i = 0; i < kInstanceCount; i++) {
+    instances[i] = std::make_shared<int>(i);
+  }
+  std::vector<int64_t> identifiers(kInstanceCount);
+
+  printf("1 thread, %d instances:\n", kInstanceCount);
+
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kInstanceCount; i++) {
+    identifiers[i] = instance_manager.AddHostCreatedInstance(instances[i]);
+  }
+  PrintResult("AddHostCreatedInstance", ElapsedMicroseconds(start));
+
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kInstanceCount; i++) {
+    instance_manager.GetInstance(identifiers[i]);
+  }
+  PrintResult("GetInstance", ElapsedMicroseconds(start));
+
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kInstanceCount; i++) {
+    instance_manager.GetIdentifier(instances[i].get());
+  }
+  PrintResult("GetIdentifier", ElapsedMicroseconds(start));
+
+  // Drop the strong references held by the instance manager, then the last
+  // native references, so that every instance is destroyed and released.
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kInstanceCount; i++) {
+    instance_manager.Remove(identifiers[i]);
+    instances[i].reset();
+  }
+  instance_manager.ReleaseDestroyedInstances();
+  PrintResult("Remove + release", ElapsedMicroseconds(start));
+
+  return release_count == kInstanceCount;
+}
+
+bool RunMultiThreaded(int thread_count) {
+  std::atomic<int> release_count(0);
+  std::unique_ptr<testing::FakeHostMessenger> messenger =
+      CreateMessenger(&release_count);
+  PigeonInstanceManager instance_manager(messenger.get());
+  const int instances_per_thread = kInstanceCount / thread_count;
+  std::atomic<bool> done(false);
+
+  auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> threads;
+  for (int t = 0; t < thread_count; t++) {
+    threads.emplace_back([&instance_manager, instances_per_thread]() {
+      for (int i = 0; i < instances_per_thread; i++) {
+        auto instance = std::make_shared<int>(i);
+        int64_t identifier = instance_manager.AddHostCreatedInstance(instance);
+        instance_manager.GetInstance(identifier);
+        instance_manager.GetIdentifier(instance.get());
+        instance_manager.Remove(identifier);
+      }
+    });
+  }
+  std::thread platform_thread([&instance_manager, &done]() {
+    while (!done) {
+      instance_manager.ReleaseDestroyedInstances();
+      std::this_thread::yield();
+    }
+  });
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  done = true;
+  platform_thread.join();
+  instance_manager.ReleaseDestroyedInstances();
+  double elapsed_us = ElapsedMicroseconds(start);
+
+  const int operation_count =
+      thread_count * instances_per_thread * kOperationsPerInstance;
+  printf("  %d thread%s %14.0f ops/s\n", thread_count,
+         thread_count == 1 ? " " : "s", operation_count / elapsed_us * 1e6);
+
+  return release_count == thread_count * instances_per_thread;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  bool released_all = RunSingleThreaded();
+
+  printf("Throughput of add, look up and release cycles:\n");
+  for (int thread_count : kThreadCounts) {
+    released_all = RunMultiThreaded(thread_count) && released_all;
+  }
+
+  if (!released_all) {
+    fprintf(stderr, "Not every instance was released in Dart\n");
+    return 1;
+  }
+  return 0;
+}
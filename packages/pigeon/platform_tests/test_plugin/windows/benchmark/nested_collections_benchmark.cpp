@@ -0,0 +1,103 @@
+// Copyright 2013 The Flutter Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Compares decoding data classes that hold nested collections from a list
+// that has to be copied with decoding from one that can be consumed.
+//
+// The payload is an AllClassesWrapper whose class list holds AllNullableTypes
+// objects, each with a list and a map of strings. The copying decode has to
+// duplicate every element, while the consuming decode, which is what the codec
+// uses for values read from a message, moves them into place. Copying the
+// input list for each iteration is not timed.
+
+#include <flutter/encodable_value.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <utility>
+
+#include "pigeon/core_tests.gen.h"
+#include "test/utils/core_tests_test.h"
+
+namespace {
+
+using core_tests_pigeontest::AllClassesWrapper;
+using core_tests_pigeontest::AllNullableTypes;
+using core_tests_pigeontest::CoreTestsTest;
+using flutter::CustomEncodableValue;
+using flutter::EncodableList;
+using flutter::EncodableMap;
+using flutter::EncodableValue;
+
+constexpr int kCollectionSizes[] = {10, 100, 1000};
+constexpr int kTotalElements = 1000000;
+
+// Returns the encodable list for a wrapper holding |size| AllNullableTypes,
+// each holding |size| strings in both a list and a map.
+EncodableList CreateWrapperList(int size) {
+  EncodableList strings;
+  EncodableMap string_map;
+  for (int i = 0; i < size; i++) {
+    // Long enough to not fit in the small string buffer.
+    std::string value = "nested collection value " + std::to_string(i);
+    strings.push_back(EncodableValue(value));
+    string_map[EncodableValue(i)] = EncodableValue(value);
+  }
+  AllNullableTypes element;
+  element.set_string_list(strings);
+  element.set_string_map(string_map);
+
+  EncodableList class_list;
+  for (int i = 0; i < size; i++) {
+    class_list.push_back(CustomEncodableValue(element));
+  }
+  AllClassesWrapper wrapper(AllNullableTypes(), class_list, EncodableMap());
+  return CoreTestsTest::ToList(wrapper);
+}
+
+template <typename Decode>
+double TimeDecodes(const EncodableList& prototype, int iterations,
+                   Decode decode) {
+  std::chrono::steady_clock::duration elapsed{};
+  for (int i = 0; i < iterations; i++) {
+    EncodableList list = prototype;
+    auto start = std::chrono::steady_clock::now();
+    AllClassesWrapper decoded = decode(std::move(list));
+    elapsed += std::chrono::steady_clock::now() - start;
+    if (decoded.class_list().empty()) {
+      fprintf(stderr, "Decoded an empty class list\n");
+    }
+  }
+  return std::chrono::duration<double, std::micro>(elapsed).count() /
+         iterations;
+}
+
+void RunDecodeBenchmark(int size) {
+  EncodableList prototype = CreateWrapperList(size);
+
+  // Keep the total work roughly constant across sizes.
+  int iterations = std::max(1, kTotalElements / (size * size));
+  double copy_us = TimeDecodes(prototype, iterations, [](EncodableList&& list) {
+    return CoreTestsTest::FromList<AllClassesWrapper>(list);
+  });
+  double move_us = TimeDecodes(prototype, iterations, [](EncodableList&& list) {
+    return CoreTestsTest::FromList<AllClassesWrapper>(std::move(list));
+  });
+
+  printf("%6d x %-6d copy %12.3f us/decode   move %12.3f us/decode\n", size,
+         size, copy_us, move_us);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  printf("Decoding AllClassesWrapper with nested collections:\n");
+  for (int size : kCollectionSizes) {
+    RunDecodeBenchmark(size);
+  }
+
+  return 0;
+}
@@ -0,0 +1,139 @@
+// Copyright 2013 The Flutter Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Compares data classes whose lists are EncodableLists with the same classes
+// generated with CppOptions.typedCollections, whose lists are std::vectors.
+//
+// Each payload is an AllTypes whose int or string list holds a million
+// elements. Decoding includes reading every element back out of the decoded
+// list, since that is where the EncodableList representation costs the most.
+
+#include <flutter/encodable_value.h>
+#include <flutter/standard_message_codec.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "pigeon/core_tests.gen.h"
+#include "pigeon/core_tests_typed.gen.h"
+
+namespace {
+
+namespace typed = core_tests_typed_pigeontest;
+
+using core_tests_pigeontest::AllTypes;
+using flutter::CustomEncodableValue;
+using flutter::EncodableList;
+using flutter::EncodableMap;
+using flutter::EncodableValue;
+using flutter::StandardMessageCodec;
+
+constexpr size_t kElementCount = 1000000;
+constexpr int kIterations = 20;
+
+AllTypes CreateAllTypes(const EncodableList& int_list,
+                        const EncodableList& string_list) {
+  return AllTypes(
+      true, 1, 2, 3.5, std::vector<uint8_t>(), std::vector<int32_t>(),
+      std::vector<int64_t>(), std::vector<double>(),
+      core_tests_pigeontest::AnEnum::kOne,
+      core_tests_pigeontest::AnotherEnum::kJustInCase, "", EncodableValue(0),
+      EncodableList(), string_list, int_list, EncodableList(), EncodableList(),
+      EncodableList(), EncodableList(), EncodableList(), EncodableList(),
+      EncodableMap(), EncodableMap(), EncodableMap(), EncodableMap(),
+      EncodableMap(), EncodableMap(), EncodableMap());
+}
+
+// Returns the sum of the ints and string lengths in |value|'s lists.
+int64_t Consume(const AllTypes& value) {
+  int64_t total = 0;
+  for (const EncodableValue& element : value.int_list()) {
+    total += std::get<int64_t>(element);
+  }
+  for (const EncodableValue& element : value.string_list()) {
+    total += std::get<std::string>(element).size();
+  }
+  return total;
+}
+
+int64_t Consume(const typed::AllTypes& value) {
+  int64_t total = 0;
+  for (int64_t element : value.int_list()) {
+    total += element;
+  }
+  for (const std::string& element : value.string_list()) {
+    total += element.size();
+  }
+  return total;
+}
+
+template <typename Function>
+double TimeMicroseconds(Function function) {
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kIterations; i++) {
+    function();
+  }
+  return std::chrono::duration<double, std::micro>(
+             std::chrono::steady_clock::now() - start)
+             .count() /
+         kIterations;
+}
+
+// Times decoding |message| as T with |codec| and reading every element of the
+// decoded lists, then encoding the decoded value again.
+template <typename T>
+void RunBenchmark(const char* name, const StandardMessageCodec& codec,
+                  const std::vector<uint8_t>& message) {
+  int64_t total = 0;
+  double decode_us = TimeMicroseconds([&]() {
+    std::unique_ptr<EncodableValue> decoded = codec.DecodeMessage(message);
+    total += Consume(std::any_cast<const T&>(
+        std::get<CustomEncodableValue>(*decoded)));
+  });
+  std::unique_ptr<EncodableValue> decoded = codec.DecodeMessage(message);
+  size_t encoded_size = 0;
+  double encode_us = TimeMicroseconds(
+      [&]() { encoded_size += codec.EncodeMessage(*decoded)->size(); });
+  if (total == 0 || encoded_size == 0) {
+    fprintf(stderr, "Decoded or encoded nothing\n");
+  }
+  printf("  %-18s decode + read %10.1f us   encode %10.1f us\n", name,
+         decode_us, encode_us);
+}
+
+void RunBenchmarks(const char* name, const EncodableList& int_list,
+                   const EncodableList& string_list) {
+  const StandardMessageCodec& codec = StandardMessageCodec::GetInstance(
+      &core_tests_pigeontest::PigeonInternalCodecSerializer::GetInstance());
+  const StandardMessageCodec& typed_codec = StandardMessageCodec::GetInstance(
+      &typed::PigeonInternalCodecSerializer::GetInstance());
+  std::vector<uint8_t> message = *codec.EncodeMessage(
+      CustomEncodableValue(CreateAllTypes(int_list, string_list)));
+
+  printf("%s (%zu B):\n", name, message.size());
+  RunBenchmark<AllTypes>("EncodableList", codec, message);
+  RunBenchmark<typed::AllTypes>("std::vector", typed_codec, message);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  EncodableList int_list;
+  EncodableList string_list;
+  int_list.reserve(kElementCount);
+  string_list.reserve(kElementCount);
+  for (size_t i = 0; i < kElementCount; i++) {
+    int_list.push_back(EncodableValue(static_cast<int64_t>(i)));
+    string_list.push_back(EncodableValue("string " + std::to_string(i)));
+  }
+
+  RunBenchmarks("1M-element int list", int_list, EncodableList());
+  RunBenchmarks("1M-element string list", EncodableList(), string_list);
+
+  return 0;
+}
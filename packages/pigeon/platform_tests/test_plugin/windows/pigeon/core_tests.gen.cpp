@@ -14,12 +14,17 @@
 #include <flutter/encodable_value.h>
 #include <flutter/standard_message_codec.h>
 
+#include <any>
 #include <cmath>
 #include <limits>
 #include <map>
 #include <optional>
 #include <sstream>
+#include <stdexcept>
 #include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace core_tests_pigeontest {
 using ::flutter::BasicMessageChannel;
@@ -335,6 +340,51 @@ std::string PigeonInternalToString(const ::flutter::EncodableValue& v) {
       v);
 }
 
+// Sets |handler| to handle the messages on |channel_name| on |task_queue|, or
+// on the platform thread if |task_queue| is null.
+//
+// Messages are decoded, handled and their replies encoded on the queue, and
+// the encoded replies are sent through PigeonTaskQueue::PostReply.
+void PigeonInternalSetTaskQueueMessageHandler(
+    ::flutter::BinaryMessenger* binary_messenger,
+    const std::string& channel_name,
+    const ::flutter::StandardMessageCodec* codec,
+    std::shared_ptr<PigeonTaskQueue> task_queue,
+    ::flutter::MessageHandler<EncodableValue> handler) {
+  if (!task_queue) {
+    BasicMessageChannel<> channel(binary_messenger, channel_name, codec);
+    channel.SetMessageHandler(std::move(handler));
+    return;
+  }
+  binary_messenger->SetMessageHandler(
+      channel_name,
+      [codec, task_queue, handler = std::move(handler)](
+          const uint8_t* message, size_t message_size,
+          ::flutter::BinaryReply binary_reply) {
+        // The message is only valid during this call, so the task gets a copy.
+        task_queue->Post(
+            [codec, task_queue, handler,
+             bytes = std::vector<uint8_t>(message, message + message_size),
+             binary_reply = std::move(binary_reply)]() {
+              std::unique_ptr<EncodableValue> decoded =
+                  codec->DecodeMessage(bytes);
+              if (!decoded) {
+                task_queue->PostReply(
+                    [binary_reply]() { binary_reply(nullptr, 0); });
+                return;
+              }
+              handler(*decoded, [codec, task_queue, binary_reply](
+                                    const EncodableValue& response) {
+                std::shared_ptr<std::vector<uint8_t>> encoded =
+                    codec->EncodeMessage(response);
+                task_queue->PostReply([binary_reply, encoded]() {
+                  binary_reply(encoded->data(), encoded->size());
+                });
+              });
+            });
+      });
+}
+
 }  // namespace
 // UnusedClass
 
@@ -357,6 +407,10 @@ void UnusedClass::set_a_field(const EncodableValue& value_arg) {
   a_field_ = value_arg;
 }
 
+void UnusedClass::set_a_field(EncodableValue&& value_arg) {
+  a_field_ = std::move(value_arg);
+}
+
 EncodableList UnusedClass::ToEncodableList() const {
   EncodableList list;
   list.reserve(1);
@@ -373,6 +427,15 @@ UnusedClass UnusedClass::FromEncodableList(const EncodableList& list) {
   return decoded;
 }
 
+UnusedClass UnusedClass::FromEncodableList(EncodableList&& list) {
+  UnusedClass decoded;
+  auto& encodable_a_field = list[0];
+  if (!encodable_a_field.IsNull()) {
+    decoded.a_field_ = std::move(encodable_a_field);
+  }
+  return decoded;
+}
+
 bool UnusedClass::operator==(const UnusedClass& other) const {
   return PigeonInternalDeepEquals(a_field_, other.a_field_);
 }
@@ -450,6 +513,50 @@ AllTypes::AllTypes(bool a_bool, int64_t an_int, int64_t an_int64,
       list_map_(list_map),
       map_map_(map_map) {}
 
+AllTypes::AllTypes(bool a_bool, int64_t an_int, int64_t an_int64,
+                   double a_double, std::vector<uint8_t>&& a_byte_array,
+                   std::vector<int32_t>&& a4_byte_array,
+                   std::vector<int64_t>&& a8_byte_array,
+                   std::vector<double>&& a_float_array, const AnEnum& an_enum,
+                   const AnotherEnum& another_enum, std::string&& a_string,
+                   EncodableValue&& an_object, EncodableList&& list,
+                   EncodableList&& string_list, EncodableList&& int_list,
+                   EncodableList&& double_list, EncodableList&& bool_list,
+                   EncodableList&& enum_list, EncodableList&& object_list,
+                   EncodableList&& list_list, EncodableList&& map_list,
+                   EncodableMap&& map, EncodableMap&& string_map,
+                   EncodableMap&& int_map, EncodableMap&& enum_map,
+                   EncodableMap&& object_map, EncodableMap&& list_map,
+                   EncodableMap&& map_map)
+    : a_bool_(a_bool),
+      an_int_(an_int),
+      an_int64_(an_int64),
+      a_double_(a_double),
+      a_byte_array_(std::move(a_byte_array)),
+      a4_byte_array_(std::move(a4_byte_array)),
+      a8_byte_array_(std::move(a8_byte_array)),
+      a_float_array_(std::move(a_float_array)),
+      an_enum_(an_enum),
+      another_enum_(another_enum),
+      a_string_(std::move(a_string)),
+      an_object_(std::move(an_object)),
+      list_(std::move(list)),
+      string_list_(std::move(string_list)),
+      int_list_(std::move(int_list)),
+      double_list_(std::move(double_list)),
+      bool_list_(std::move(bool_list)),
+      enum_list_(std::move(enum_list)),
+      object_list_(std::move(object_list)),
+      list_list_(std::move(list_list)),
+      map_list_(std::move(map_list)),
+      map_(std::move(map)),
+      string_map_(std::move(string_map)),
+      int_map_(std::move(int_map)),
+      enum_map_(std::move(enum_map)),
+      object_map_(std::move(object_map)),
+      list_map_(std::move(list_map)),
+      map_map_(std::move(map_map)) {}
+
 bool AllTypes::a_bool() const { return a_bool_; }
 
 void AllTypes::set_a_bool(bool value_arg) { a_bool_ = value_arg; }
@@ -474,6 +581,10 @@ void AllTypes::set_a_byte_array(const std::vector<uint8_t>& value_arg) {
   a_byte_array_ = value_arg;
 }
 
+void AllTypes::set_a_byte_array(std::vector<uint8_t>&& value_arg) {
+  a_byte_array_ = std::move(value_arg);
+}
+
 const std::vector<int32_t>& AllTypes::a4_byte_array() const {
   return a4_byte_array_;
 }
@@ -482,6 +593,10 @@ void AllTypes::set_a4_byte_array(const std::vector<int32_t>& value_arg) {
   a4_byte_array_ = value_arg;
 }
 
+void AllTypes::set_a4_byte_array(std::vector<int32_t>&& value_arg) {
+  a4_byte_array_ = std::move(value_arg);
+}
+
 const std::vector<int64_t>& AllTypes::a8_byte_array() const {
   return a8_byte_array_;
 }
@@ -490,6 +605,10 @@ void AllTypes::set_a8_byte_array(const std::vector<int64_t>& value_arg) {
   a8_byte_array_ = value_arg;
 }
 
+void AllTypes::set_a8_byte_array(std::vector<int64_t>&& value_arg) {
+  a8_byte_array_ = std::move(value_arg);
+}
+
 const std::vector<double>& AllTypes::a_float_array() const {
   return a_float_array_;
 }
@@ -498,6 +617,10 @@ void AllTypes::set_a_float_array(const std::vector<double>& value_arg) {
   a_float_array_ = value_arg;
 }
 
+void AllTypes::set_a_float_array(std::vector<double>&& value_arg) {
+  a_float_array_ = std::move(value_arg);
+}
+
 const AnEnum& AllTypes::an_enum() const { return an_enum_; }
 
 void AllTypes::set_an_enum(const AnEnum& value_arg) { an_enum_ = value_arg; }
@@ -520,98 +643,166 @@ void AllTypes::set_an_object(const EncodableValue& value_arg) {
   an_object_ = value_arg;
 }
 
+void AllTypes::set_an_object(EncodableValue&& value_arg) {
+  an_object_ = std::move(value_arg);
+}
+
 const EncodableList& AllTypes::list() const { return list_; }
 
 void AllTypes::set_list(const EncodableList& value_arg) { list_ = value_arg; }
 
+void AllTypes::set_list(EncodableList&& value_arg) {
+  list_ = std::move(value_arg);
+}
+
 const EncodableList& AllTypes::string_list() const { return string_list_; }
 
 void AllTypes::set_string_list(const EncodableList& value_arg) {
   string_list_ = value_arg;
 }
 
+void AllTypes::set_string_list(EncodableList&& value_arg) {
+  string_list_ = std::move(value_arg);
+}
+
 const EncodableList& AllTypes::int_list() const { return int_list_; }
 
 void AllTypes::set_int_list(const EncodableList& value_arg) {
   int_list_ = value_arg;
 }
 
+void AllTypes::set_int_list(EncodableList&& value_arg) {
+  int_list_ = std::move(value_arg);
+}
+
 const EncodableList& AllTypes::double_list() const { return double_list_; }
 
 void AllTypes::set_double_list(const EncodableList& value_arg) {
   double_list_ = value_arg;
 }
 
+void AllTypes::set_double_list(EncodableList&& value_arg) {
+  double_list_ = std::move(value_arg);
+}
+
 const EncodableList& AllTypes::bool_list() const { return bool_list_; }
 
 void AllTypes::set_bool_list(const EncodableList& value_arg) {
   bool_list_ = value_arg;
 }
 
+void AllTypes::set_bool_list(EncodableList&& value_arg) {
+  bool_list_ = std::move(value_arg);
+}
+
 const EncodableList& AllTypes::enum_list() const { return enum_list_; }
 
 void AllTypes::set_enum_list(const EncodableList& value_arg) {
   enum_list_ = value_arg;
 }
 
+void AllTypes::set_enum_list(EncodableList&& value_arg) {
+  enum_list_ = std::move(value_arg);
+}
+
 const EncodableList& AllTypes::object_list() const { return object_list_; }
 
 void AllTypes::set_object_list(const EncodableList& value_arg) {
   object_list_ = value_arg;
 }
 
+void AllTypes::set_object_list(EncodableList&& value_arg) {
+  object_list_ = std::move(value_arg);
+}
+
 const EncodableList& AllTypes::list_list() const { return list_list_; }
 
 void AllTypes::set_list_list(const EncodableList& value_arg) {
   list_list_ = value_arg;
 }
 
+void AllTypes::set_list_list(EncodableList&& value_arg) {
+  list_list_ = std::move(value_arg);
+}
+
 const EncodableList& AllTypes::map_list() const { return map_list_; }
 
 void AllTypes::set_map_list(const EncodableList& value_arg) {
   map_list_ = value_arg;
 }
 
+void AllTypes::set_map_list(EncodableList&& value_arg) {
+  map_list_ = std::move(value_arg);
+}
+
 const EncodableMap& AllTypes::map() const { return map_; }
 
 void AllTypes::set_map(const EncodableMap& value_arg) { map_ = value_arg; }
 
+void AllTypes::set_map(EncodableMap&& value_arg) {
+  map_ = std::move(value_arg);
+}
+
 const EncodableMap& AllTypes::string_map() const { return string_map_; }
 
 void AllTypes::set_string_map(const EncodableMap& value_arg) {
   string_map_ = value_arg;
 }
 
+void AllTypes::set_string_map(EncodableMap&& value_arg) {
+  string_map_ = std::move(value_arg);
+}
+
 const EncodableMap& AllTypes::int_map() const { return int_map_; }
 
 void AllTypes::set_int_map(const EncodableMap& value_arg) {
   int_map_ = value_arg;
 }
 
+void AllTypes::set_int_map(EncodableMap&& value_arg) {
+  int_map_ = std::move(value_arg);
+}
+
 const EncodableMap& AllTypes::enum_map() const { return enum_map_; }
 
 void AllTypes::set_enum_map(const EncodableMap& value_arg) {
   enum_map_ = value_arg;
 }
 
+void AllTypes::set_enum_map(EncodableMap&& value_arg) {
+  enum_map_ = std::move(value_arg);
+}
+
 const EncodableMap& AllTypes::object_map() const { return object_map_; }
 
 void AllTypes::set_object_map(const EncodableMap& value_arg) {
   object_map_ = value_arg;
 }
 
+void AllTypes::set_object_map(EncodableMap&& value_arg) {
+  object_map_ = std::move(value_arg);
+}
+
 const EncodableMap& AllTypes::list_map() const { return list_map_; }
 
 void AllTypes::set_list_map(const EncodableMap& value_arg) {
   list_map_ = value_arg;
 }
 
+void AllTypes::set_list_map(EncodableMap&& value_arg) {
+  list_map_ = std::move(value_arg);
+}
+
 const EncodableMap& AllTypes::map_map() const { return map_map_; }
 
 void AllTypes::set_map_map(const EncodableMap& value_arg) {
   map_map_ = value_arg;
 }
 
+void AllTypes::set_map_map(EncodableMap&& value_arg) {
+  map_map_ = std::move(value_arg);
+}
+
 EncodableList AllTypes::ToEncodableList() const {
   EncodableList list;
   list.reserve(28);
@@ -669,6 +860,37 @@ AllTypes AllTypes::FromEncodableList(const EncodableList& list) {
   return decoded;
 }
 
+AllTypes AllTypes::FromEncodableList(EncodableList&& list) {
+  AllTypes decoded(
+      std::get<bool>(list[0]), std::get<int64_t>(list[1]),
+      std::get<int64_t>(list[2]), std::get<double>(list[3]),
+      std::move(std::get<std::vector<uint8_t>>(list[4])),
+      std::move(std::get<std::vector<int32_t>>(list[5])),
+      std::move(std::get<std::vector<int64_t>>(list[6])),
+      std::move(std::get<std::vector<double>>(list[7])),
+      std::any_cast<const AnEnum&>(std::get<CustomEncodableValue>(list[8])),
+      std::any_cast<const AnotherEnum&>(
+          std::get<CustomEncodableValue>(list[9])),
+      std::move(std::get<std::string>(list[10])), std::move(list[11]),
+      std::move(std::get<EncodableList>(list[12])),
+      std::move(std::get<EncodableList>(list[13])),
+      std::move(std::get<EncodableList>(list[14])),
+      std::move(std::get<EncodableList>(list[15])),
+      std::move(std::get<EncodableList>(list[16])),
+      std::move(std::get<EncodableList>(list[17])),
+      std::move(std::get<EncodableList>(list[18])),
+      std::move(std::get<EncodableList>(list[19])),
+      std::move(std::get<EncodableList>(list[20])),
+      std::move(std::get<EncodableMap>(list[21])),
+      std::move(std::get<EncodableMap>(list[22])),
+      std::move(std::get<EncodableMap>(list[23])),
+      std::move(std::get<EncodableMap>(list[24])),
+      std::move(std::get<EncodableMap>(list[25])),
+      std::move(std::get<EncodableMap>(list[26])),
+      std::move(std::get<EncodableMap>(list[27])));
+  return decoded;
+}
+
 bool AllTypes::operator==(const AllTypes& other) const {
   return PigeonInternalDeepEquals(a_bool_, other.a_bool_) &&
          PigeonInternalDeepEquals(an_int_, other.an_int_) &&
@@ -1103,6 +1325,11 @@ void AllNullableTypes::set_a_nullable_byte_array(
   a_nullable_byte_array_ = value_arg;
 }
 
+void AllNullableTypes::set_a_nullable_byte_array(
+    std::vector<uint8_t>&& value_arg) {
+  a_nullable_byte_array_ = std::move(value_arg);
+}
+
 const std::vector<int32_t>* AllNullableTypes::a_nullable4_byte_array() const {
   return a_nullable4_byte_array_ ? &(*a_nullable4_byte_array_) : nullptr;
 }
@@ -1119,6 +1346,11 @@ void AllNullableTypes::set_a_nullable4_byte_array(
   a_nullable4_byte_array_ = value_arg;
 }
 
+void AllNullableTypes::set_a_nullable4_byte_array(
+    std::vector<int32_t>&& value_arg) {
+  a_nullable4_byte_array_ = std::move(value_arg);
+}
+
 const std::vector<int64_t>* AllNullableTypes::a_nullable8_byte_array() const {
   return a_nullable8_byte_array_ ? &(*a_nullable8_byte_array_) : nullptr;
 }
@@ -1135,6 +1367,11 @@ void AllNullableTypes::set_a_nullable8_byte_array(
   a_nullable8_byte_array_ = value_arg;
 }
 
+void AllNullableTypes::set_a_nullable8_byte_array(
+    std::vector<int64_t>&& value_arg) {
+  a_nullable8_byte_array_ = std::move(value_arg);
+}
+
 const std::vector<double>* AllNullableTypes::a_nullable_float_array() const {
   return a_nullable_float_array_ ? &(*a_nullable_float_array_) : nullptr;
 }
@@ -1150,6 +1387,11 @@ void AllNullableTypes::set_a_nullable_float_array(
   a_nullable_float_array_ = value_arg;
 }
 
+void AllNullableTypes::set_a_nullable_float_array(
+    std::vector<double>&& value_arg) {
+  a_nullable_float_array_ = std::move(value_arg);
+}
+
 const AnEnum* AllNullableTypes::a_nullable_enum() const {
   return a_nullable_enum_ ? &(*a_nullable_enum_) : nullptr;
 }
@@ -1203,6 +1445,10 @@ void AllNullableTypes::set_a_nullable_object(const EncodableValue& value_arg) {
   a_nullable_object_ = value_arg;
 }
 
+void AllNullableTypes::set_a_nullable_object(EncodableValue&& value_arg) {
+  a_nullable_object_ = std::move(value_arg);
+}
+
 const AllNullableTypes* AllNullableTypes::all_nullable_types() const {
   return all_nullable_types_.get();
 }
@@ -1218,6 +1464,11 @@ void AllNullableTypes::set_all_nullable_types(
   all_nullable_types_ = std::make_unique<AllNullableTypes>(value_arg);
 }
 
+void AllNullableTypes::set_all_nullable_types(AllNullableTypes&& value_arg) {
+  all_nullable_types_ =
+      std::make_unique<AllNullableTypes>(std::move(value_arg));
+}
+
 const EncodableList* AllNullableTypes::list() const {
   return list_ ? &(*list_) : nullptr;
 }
@@ -1230,6 +1481,10 @@ void AllNullableTypes::set_list(const EncodableList& value_arg) {
   list_ = value_arg;
 }
 
+void AllNullableTypes::set_list(EncodableList&& value_arg) {
+  list_ = std::move(value_arg);
+}
+
 const EncodableList* AllNullableTypes::string_list() const {
   return string_list_ ? &(*string_list_) : nullptr;
 }
@@ -1243,6 +1498,10 @@ void AllNullableTypes::set_string_list(const EncodableList& value_arg) {
   string_list_ = value_arg;
 }
 
+void AllNullableTypes::set_string_list(EncodableList&& value_arg) {
+  string_list_ = std::move(value_arg);
+}
+
 const EncodableList* AllNullableTypes::int_list() const {
   return int_list_ ? &(*int_list_) : nullptr;
 }
@@ -1256,6 +1515,10 @@ void AllNullableTypes::set_int_list(const EncodableList& value_arg) {
   int_list_ = value_arg;
 }
 
+void AllNullableTypes::set_int_list(EncodableList&& value_arg) {
+  int_list_ = std::move(value_arg);
+}
+
 const EncodableList* AllNullableTypes::double_list() const {
   return double_list_ ? &(*double_list_) : nullptr;
 }
@@ -1269,6 +1532,10 @@ void AllNullableTypes::set_double_list(const EncodableList& value_arg) {
   double_list_ = value_arg;
 }
 
+void AllNullableTypes::set_double_list(EncodableList&& value_arg) {
+  double_list_ = std::move(value_arg);
+}
+
 const EncodableList* AllNullableTypes::bool_list() const {
   return bool_list_ ? &(*bool_list_) : nullptr;
 }
@@ -1282,6 +1549,10 @@ void AllNullableTypes::set_bool_list(const EncodableList& value_arg) {
   bool_list_ = value_arg;
 }
 
+void AllNullableTypes::set_bool_list(EncodableList&& value_arg) {
+  bool_list_ = std::move(value_arg);
+}
+
 const EncodableList* AllNullableTypes::enum_list() const {
   return enum_list_ ? &(*enum_list_) : nullptr;
 }
@@ -1295,6 +1566,10 @@ void AllNullableTypes::set_enum_list(const EncodableList& value_arg) {
   enum_list_ = value_arg;
 }
 
+void AllNullableTypes::set_enum_list(EncodableList&& value_arg) {
+  enum_list_ = std::move(value_arg);
+}
+
 const EncodableList* AllNullableTypes::object_list() const {
   return object_list_ ? &(*object_list_) : nullptr;
 }
@@ -1308,6 +1583,10 @@ void AllNullableTypes::set_object_list(const EncodableList& value_arg) {
   object_list_ = value_arg;
 }
 
+void AllNullableTypes::set_object_list(EncodableList&& value_arg) {
+  object_list_ = std::move(value_arg);
+}
+
 const EncodableList* AllNullableTypes::list_list() const {
   return list_list_ ? &(*list_list_) : nullptr;
 }
@@ -1321,6 +1600,10 @@ void AllNullableTypes::set_list_list(const EncodableList& value_arg) {
   list_list_ = value_arg;
 }
 
+void AllNullableTypes::set_list_list(EncodableList&& value_arg) {
+  list_list_ = std::move(value_arg);
+}
+
 const EncodableList* AllNullableTypes::map_list() const {
   return map_list_ ? &(*map_list_) : nullptr;
 }
@@ -1334,6 +1617,10 @@ void AllNullableTypes::set_map_list(const EncodableList& value_arg) {
   map_list_ = value_arg;
 }
 
+void AllNullableTypes::set_map_list(EncodableList&& value_arg) {
+  map_list_ = std::move(value_arg);
+}
+
 const EncodableList* AllNullableTypes::recursive_class_list() const {
   return recursive_class_list_ ? &(*recursive_class_list_) : nullptr;
 }
@@ -1349,6 +1636,10 @@ void AllNullableTypes::set_recursive_class_list(
   recursive_class_list_ = value_arg;
 }
 
+void AllNullableTypes::set_recursive_class_list(EncodableList&& value_arg) {
+  recursive_class_list_ = std::move(value_arg);
+}
+
 const EncodableMap* AllNullableTypes::map() const {
   return map_ ? &(*map_) : nullptr;
 }
@@ -1361,6 +1652,10 @@ void AllNullableTypes::set_map(const EncodableMap& value_arg) {
   map_ = value_arg;
 }
 
+void AllNullableTypes::set_map(EncodableMap&& value_arg) {
+  map_ = std::move(value_arg);
+}
+
 const EncodableMap* AllNullableTypes::string_map() const {
   return string_map_ ? &(*string_map_) : nullptr;
 }
@@ -1374,6 +1669,10 @@ void AllNullableTypes::set_string_map(const EncodableMap& value_arg) {
   string_map_ = value_arg;
 }
 
+void AllNullableTypes::set_string_map(EncodableMap&& value_arg) {
+  string_map_ = std::move(value_arg);
+}
+
 const EncodableMap* AllNullableTypes::int_map() const {
   return int_map_ ? &(*int_map_) : nullptr;
 }
@@ -1386,6 +1685,10 @@ void AllNullableTypes::set_int_map(const EncodableMap& value_arg) {
   int_map_ = value_arg;
 }
 
+void AllNullableTypes::set_int_map(EncodableMap&& value_arg) {
+  int_map_ = std::move(value_arg);
+}
+
 const EncodableMap* AllNullableTypes::enum_map() const {
   return enum_map_ ? &(*enum_map_) : nullptr;
 }
@@ -1399,6 +1702,10 @@ void AllNullableTypes::set_enum_map(const EncodableMap& value_arg) {
   enum_map_ = value_arg;
 }
 
+void AllNullableTypes::set_enum_map(EncodableMap&& value_arg) {
+  enum_map_ = std::move(value_arg);
+}
+
 const EncodableMap* AllNullableTypes::object_map() const {
   return object_map_ ? &(*object_map_) : nullptr;
 }
@@ -1412,6 +1719,10 @@ void AllNullableTypes::set_object_map(const EncodableMap& value_arg) {
   object_map_ = value_arg;
 }
 
+void AllNullableTypes::set_object_map(EncodableMap&& value_arg) {
+  object_map_ = std::move(value_arg);
+}
+
 const EncodableMap* AllNullableTypes::list_map() const {
   return list_map_ ? &(*list_map_) : nullptr;
 }
@@ -1425,6 +1736,10 @@ void AllNullableTypes::set_list_map(const EncodableMap& value_arg) {
   list_map_ = value_arg;
 }
 
+void AllNullableTypes::set_list_map(EncodableMap&& value_arg) {
+  list_map_ = std::move(value_arg);
+}
+
 const EncodableMap* AllNullableTypes::map_map() const {
   return map_map_ ? &(*map_map_) : nullptr;
 }
@@ -1437,6 +1752,10 @@ void AllNullableTypes::set_map_map(const EncodableMap& value_arg) {
   map_map_ = value_arg;
 }
 
+void AllNullableTypes::set_map_map(EncodableMap&& value_arg) {
+  map_map_ = std::move(value_arg);
+}
+
 const EncodableMap* AllNullableTypes::recursive_class_map() const {
   return recursive_class_map_ ? &(*recursive_class_map_) : nullptr;
 }
@@ -1450,6 +1769,10 @@ void AllNullableTypes::set_recursive_class_map(const EncodableMap& value_arg) {
   recursive_class_map_ = value_arg;
 }
 
+void AllNullableTypes::set_recursive_class_map(EncodableMap&& value_arg) {
+  recursive_class_map_ = std::move(value_arg);
+}
+
 EncodableList AllNullableTypes::ToEncodableList() const {
   EncodableList list;
   list.reserve(31);
@@ -1651,6 +1974,154 @@ AllNullableTypes AllNullableTypes::FromEncodableList(
   return decoded;
 }
 
+AllNullableTypes AllNullableTypes::FromEncodableList(EncodableList&& list) {
+  AllNullableTypes decoded;
+  auto& encodable_a_nullable_bool = list[0];
+  if (!encodable_a_nullable_bool.IsNull()) {
+    decoded.a_nullable_bool_ = std::get<bool>(encodable_a_nullable_bool);
+  }
+  auto& encodable_a_nullable_int = list[1];
+  if (!encodable_a_nullable_int.IsNull()) {
+    decoded.a_nullable_int_ = std::get<int64_t>(encodable_a_nullable_int);
+  }
+  auto& encodable_a_nullable_int64 = list[2];
+  if (!encodable_a_nullable_int64.IsNull()) {
+    decoded.a_nullable_int64_ = std::get<int64_t>(encodable_a_nullable_int64);
+  }
+  auto& encodable_a_nullable_double = list[3];
+  if (!encodable_a_nullable_double.IsNull()) {
+    decoded.a_nullable_double_ = std::get<double>(encodable_a_nullable_double);
+  }
+  auto& encodable_a_nullable_byte_array = list[4];
+  if (!encodable_a_nullable_byte_array.IsNull()) {
+    decoded.a_nullable_byte_array_ = std::move(
+        std::get<std::vector<uint8_t>>(encodable_a_nullable_byte_array));
+  }
+  auto& encodable_a_nullable4_byte_array = list[5];
+  if (!encodable_a_nullable4_byte_array.IsNull()) {
+    decoded.a_nullable4_byte_array_ = std::move(
+        std::get<std::vector<int32_t>>(encodable_a_nullable4_byte_array));
+  }
+  auto& encodable_a_nullable8_byte_array = list[6];
+  if (!encodable_a_nullable8_byte_array.IsNull()) {
+    decoded.a_nullable8_byte_array_ = std::move(
+        std::get<std::vector<int64_t>>(encodable_a_nullable8_byte_array));
+  }
+  auto& encodable_a_nullable_float_array = list[7];
+  if (!encodable_a_nullable_float_array.IsNull()) {
+    decoded.a_nullable_float_array_ = std::move(
+        std::get<std::vector<double>>(encodable_a_nullable_float_array));
+  }
+  auto& encodable_a_nullable_enum = list[8];
+  if (!encodable_a_nullable_enum.IsNull()) {
+    decoded.a_nullable_enum_ = std::any_cast<const AnEnum&>(
+        std::get<CustomEncodableValue>(encodable_a_nullable_enum));
+  }
+  auto& encodable_another_nullable_enum = list[9];
+  if (!encodable_another_nullable_enum.IsNull()) {
+    decoded.another_nullable_enum_ = std::any_cast<const AnotherEnum&>(
+        std::get<CustomEncodableValue>(encodable_another_nullable_enum));
+  }
+  auto& encodable_a_nullable_string = list[10];
+  if (!encodable_a_nullable_string.IsNull()) {
+    decoded.a_nullable_string_ =
+        std::move(std::get<std::string>(encodable_a_nullable_string));
+  }
+  auto& encodable_a_nullable_object = list[11];
+  if (!encodable_a_nullable_object.IsNull()) {
+    decoded.a_nullable_object_ = std::move(encodable_a_nullable_object);
+  }
+  auto& encodable_all_nullable_types = list[12];
+  if (!encodable_all_nullable_types.IsNull()) {
+    decoded.all_nullable_types_ = std::make_unique<AllNullableTypes>(std::move(
+        std::any_cast<AllNullableTypes&>(
+            std::get<CustomEncodableValue>(encodable_all_nullable_types))));
+  }
+  auto& encodable_list = list[13];
+  if (!encodable_list.IsNull()) {
+    decoded.list_ = std::move(std::get<EncodableList>(encodable_list));
+  }
+  auto& encodable_string_list = list[14];
+  if (!encodable_string_list.IsNull()) {
+    decoded.string_list_ =
+        std::move(std::get<EncodableList>(encodable_string_list));
+  }
+  auto& encodable_int_list = list[15];
+  if (!encodable_int_list.IsNull()) {
+    decoded.int_list_ = std::move(std::get<EncodableList>(encodable_int_list));
+  }
+  auto& encodable_double_list = list[16];
+  if (!encodable_double_list.IsNull()) {
+    decoded.double_list_ =
+        std::move(std::get<EncodableList>(encodable_double_list));
+  }
+  auto& encodable_bool_list = list[17];
+  if (!encodable_bool_list.IsNull()) {
+    decoded.bool_list_ =
+        std::move(std::get<EncodableList>(encodable_bool_list));
+  }
+  auto& encodable_enum_list = list[18];
+  if (!encodable_enum_list.IsNull()) {
+    decoded.enum_list_ =
+        std::move(std::get<EncodableList>(encodable_enum_list));
+  }
+  auto& encodable_object_list = list[19];
+  if (!encodable_object_list.IsNull()) {
+    decoded.object_list_ =
+        std::move(std::get<EncodableList>(encodable_object_list));
+  }
+  auto& encodable_list_list = list[20];
+  if (!encodable_list_list.IsNull()) {
+    decoded.list_list_ =
+        std::move(std::get<EncodableList>(encodable_list_list));
+  }
+  auto& encodable_map_list = list[21];
+  if (!encodable_map_list.IsNull()) {
+    decoded.map_list_ = std::move(std::get<EncodableList>(encodable_map_list));
+  }
+  auto& encodable_recursive_class_list = list[22];
+  if (!encodable_recursive_class_list.IsNull()) {
+    decoded.recursive_class_list_ =
+        std::move(std::get<EncodableList>(encodable_recursive_class_list));
+  }
+  auto& encodable_map = list[23];
+  if (!encodable_map.IsNull()) {
+    decoded.map_ = std::move(std::get<EncodableMap>(encodable_map));
+  }
+  auto& encodable_string_map = list[24];
+  if (!encodable_string_map.IsNull()) {
+    decoded.string_map_ =
+        std::move(std::get<EncodableMap>(encodable_string_map));
+  }
+  auto& encodable_int_map = list[25];
+  if (!encodable_int_map.IsNull()) {
+    decoded.int_map_ = std::move(std::get<EncodableMap>(encodable_int_map));
+  }
+  auto& encodable_enum_map = list[26];
+  if (!encodable_enum_map.IsNull()) {
+    decoded.enum_map_ = std::move(std::get<EncodableMap>(encodable_enum_map));
+  }
+  auto& encodable_object_map = list[27];
+  if (!encodable_object_map.IsNull()) {
+    decoded.object_map_ =
+        std::move(std::get<EncodableMap>(encodable_object_map));
+  }
+  auto& encodable_list_map = list[28];
+  if (!encodable_list_map.IsNull()) {
+    decoded.list_map_ = std::move(std::get<EncodableMap>(encodable_list_map));
+  }
+  auto& encodable_map_map = list[29];
+  if (!encodable_map_map.IsNull()) {
+    decoded.map_map_ = std::move(std::get<EncodableMap>(encodable_map_map));
+  }
+  auto& encodable_recursive_class_map = list[30];
+  if (!encodable_recursive_class_map.IsNull()) {
+    decoded.recursive_class_map_ =
+        std::move(std::get<EncodableMap>(encodable_recursive_class_map));
+  }
+  return decoded;
+}
+
 bool AllNullableTypes::operator==(const AllNullableTypes& other) const {
   return PigeonInternalDeepEquals(a_nullable_bool_, other.a_nullable_bool_) &&
          PigeonInternalDeepEquals(a_nullable_int_, other.a_nullable_int_) &&
@@ -2091,6 +2562,11 @@ void AllNullableTypesWithoutRecursion::set_a_nullable_byte_array(
   a_nullable_byte_array_ = value_arg;
 }
 
+void AllNullableTypesWithoutRecursion::set_a_nullable_byte_array(
+    std::vector<uint8_t>&& value_arg) {
+  a_nullable_byte_array_ = std::move(value_arg);
+}
+
 const std::vector<int32_t>*
 AllNullableTypesWithoutRecursion::a_nullable4_byte_array() const {
   return a_nullable4_byte_array_ ? &(*a_nullable4_byte_array_) : nullptr;
@@ -2108,6 +2584,11 @@ void AllNullableTypesWithoutRecursion::set_a_nullable4_byte_array(
   a_nullable4_byte_array_ = value_arg;
 }
 
+void AllNullableTypesWithoutRecursion::set_a_nullable4_byte_array(
+    std::vector<int32_t>&& value_arg) {
+  a_nullable4_byte_array_ = std::move(value_arg);
+}
+
 const std::vector<int64_t>*
 AllNullableTypesWithoutRecursion::a_nullable8_byte_array() const {
   return a_nullable8_byte_array_ ? &(*a_nullable8_byte_array_) : nullptr;
@@ -2125,6 +2606,11 @@ void AllNullableTypesWithoutRecursion::set_a_nullable8_byte_array(
   a_nullable8_byte_array_ = value_arg;
 }
 
+void AllNullableTypesWithoutRecursion::set_a_nullable8_byte_array(
+    std::vector<int64_t>&& value_arg) {
+  a_nullable8_byte_array_ = std::move(value_arg);
+}
+
 const std::vector<double>*
 AllNullableTypesWithoutRecursion::a_nullable_float_array() const {
   return a_nullable_float_array_ ? &(*a_nullable_float_array_) : nullptr;
@@ -2141,6 +2627,11 @@ void AllNullableTypesWithoutRecursion::set_a_nullable_float_array(
   a_nullable_float_array_ = value_arg;
 }
 
+void AllNullableTypesWithoutRecursion::set_a_nullable_float_array(
+    std::vector<double>&& value_arg) {
+  a_nullable_float_array_ = std::move(value_arg);
+}
+
 const AnEnum* AllNullableTypesWithoutRecursion::a_nullable_enum() const {
   return a_nullable_enum_ ? &(*a_nullable_enum_) : nullptr;
 }
@@ -2203,6 +2694,11 @@ void AllNullableTypesWithoutRecursion::set_a_nullable_object(
   a_nullable_object_ = value_arg;
 }
 
+void AllNullableTypesWithoutRecursion::set_a_nullable_object(
+    EncodableValue&& value_arg) {
+  a_nullable_object_ = std::move(value_arg);
+}
+
 const EncodableList* AllNullableTypesWithoutRecursion::list() const {
   return list_ ? &(*list_) : nullptr;
 }
@@ -2217,6 +2713,10 @@ void AllNullableTypesWithoutRecursion::set_list(
   list_ = value_arg;
 }
 
+void AllNullableTypesWithoutRecursion::set_list(EncodableList&& value_arg) {
+  list_ = std::move(value_arg);
+}
+
 const EncodableList* AllNullableTypesWithoutRecursion::string_list() const {
   return string_list_ ? &(*string_list_) : nullptr;
 }
@@ -2232,6 +2732,11 @@ void AllNullableTypesWithoutRecursion::set_string_list(
   string_list_ = value_arg;
 }
 
+void AllNullableTypesWithoutRecursion::set_string_list(
+    EncodableList&& value_arg) {
+  string_list_ = std::move(value_arg);
+}
+
 const EncodableList* AllNullableTypesWithoutRecursion::int_list() const {
   return int_list_ ? &(*int_list_) : nullptr;
 }
@@ -2247,6 +2752,10 @@ void AllNullableTypesWithoutRecursion::set_int_list(
   int_list_ = value_arg;
 }
 
+void AllNullableTypesWithoutRecursion::set_int_list(EncodableList&& value_arg) {
+  int_list_ = std::move(value_arg);
+}
+
 const EncodableList* AllNullableTypesWithoutRecursion::double_list() const {
   return double_list_ ? &(*double_list_) : nullptr;
 }
@@ -2262,6 +2771,11 @@ void AllNullableTypesWithoutRecursion::set_double_list(
   double_list_ = value_arg;
 }
 
+void AllNullableTypesWithoutRecursion::set_double_list(
+    EncodableList&& value_arg) {
+  double_list_ = std::move(value_arg);
+}
+
 const EncodableList* AllNullableTypesWithoutRecursion::bool_list() const {
   return bool_list_ ? &(*bool_list_) : nullptr;
 }
@@ -2277,6 +2791,11 @@ void AllNullableTypesWithoutRecursion::set_bool_list(
   bool_list_ = value_arg;
 }
 
+void AllNullableTypesWithoutRecursion::set_bool_list(
+    EncodableList&& value_arg) {
+  bool_list_ = std::move(value_arg);
+}
+
 const EncodableList* AllNullableTypesWithoutRecursion::enum_list() const {
   return enum_list_ ? &(*enum_list_) : nullptr;
 }
@@ -2292,6 +2811,11 @@ void AllNullableTypesWithoutRecursion::set_enum_list(
   enum_list_ = value_arg;
 }
 
+void AllNullableTypesWithoutRecursion::set_enum_list(
+    EncodableList&& value_arg) {
+  enum_list_ = std::move(value_arg);
+}
+
 const EncodableList* AllNullableTypesWithoutRecursion::object_list() const {
   return object_list_ ? &(*object_list_) : nullptr;
 }
@@ -2307,6 +2831,11 @@ void AllNullableTypesWithoutRecursion::set_object_list(
   object_list_ = value_arg;
 }
 
+void AllNullableTypesWithoutRecursion::set_object_list(
+    EncodableList&& value_arg) {
+  object_list_ = std::move(value_arg);
+}
+
 const EncodableList* AllNullableTypesWithoutRecursion::list_list() const {
   return list_list_ ? &(*list_list_) : nullptr;
 }
@@ -2322,6 +2851,11 @@ void AllNullableTypesWithoutRecursion::set_list_list(
   list_list_ = value_arg;
 }
 
+void AllNullableTypesWithoutRecursion::set_list_list(
+    EncodableList&& value_arg) {
+  list_list_ = std::move(value_arg);
+}
+
 const EncodableList* AllNullableTypesWithoutRecursion::map_list() const {
   return map_list_ ? &(*map_list_) : nullptr;
 }
@@ -2337,6 +2871,10 @@ void AllNullableTypesWithoutRecursion::set_map_list(
   map_list_ = value_arg;
 }
 
+void AllNullableTypesWithoutRecursion::set_map_list(EncodableList&& value_arg) {
+  map_list_ = std::move(value_arg);
+}
+
 const EncodableMap* AllNullableTypesWithoutRecursion::map() const {
   return map_ ? &(*map_) : nullptr;
 }
@@ -2349,6 +2887,10 @@ void AllNullableTypesWithoutRecursion::set_map(const EncodableMap& value_arg) {
   map_ = value_arg;
 }
 
+void AllNullableTypesWithoutRecursion::set_map(EncodableMap&& value_arg) {
+  map_ = std::move(value_arg);
+}
+
 const EncodableMap* AllNullableTypesWithoutRecursion::string_map() const {
   return string_map_ ? &(*string_map_) : nullptr;
 }
@@ -2364,6 +2906,11 @@ void AllNullableTypesWithoutRecursion::set_string_map(
   string_map_ = value_arg;
 }
 
+void AllNullableTypesWithoutRecursion::set_string_map(
+    EncodableMap&& value_arg) {
+  string_map_ = std::move(value_arg);
+}
+
 const EncodableMap* AllNullableTypesWithoutRecursion::int_map() const {
   return int_map_ ? &(*int_map_) : nullptr;
 }
@@ -2378,6 +2925,10 @@ void AllNullableTypesWithoutRecursion::set_int_map(
   int_map_ = value_arg;
 }
 
+void AllNullableTypesWithoutRecursion::set_int_map(EncodableMap&& value_arg) {
+  int_map_ = std::move(value_arg);
+}
+
 const EncodableMap* AllNullableTypesWithoutRecursion::enum_map() const {
   return enum_map_ ? &(*enum_map_) : nullptr;
 }
@@ -2393,6 +2944,10 @@ void AllNullableTypesWithoutRecursion::set_enum_map(
   enum_map_ = value_arg;
 }
 
+void AllNullableTypesWithoutRecursion::set_enum_map(EncodableMap&& value_arg) {
+  enum_map_ = std::move(value_arg);
+}
+
 const EncodableMap* AllNullableTypesWithoutRecursion::object_map() const {
   return object_map_ ? &(*object_map_) : nullptr;
 }
@@ -2408,6 +2963,11 @@ void AllNullableTypesWithoutRecursion::set_object_map(
   object_map_ = value_arg;
 }
 
+void AllNullableTypesWithoutRecursion::set_object_map(
+    EncodableMap&& value_arg) {
+  object_map_ = std::move(value_arg);
+}
+
 const EncodableMap* AllNullableTypesWithoutRecursion::list_map() const {
   return list_map_ ? &(*list_map_) : nullptr;
 }
@@ -2423,6 +2983,10 @@ void AllNullableTypesWithoutRecursion::set_list_map(
   list_map_ = value_arg;
 }
 
+void AllNullableTypesWithoutRecursion::set_list_map(EncodableMap&& value_arg) {
+  list_map_ = std::move(value_arg);
+}
+
 const EncodableMap* AllNullableTypesWithoutRecursion::map_map() const {
   return map_map_ ? &(*map_map_) : nullptr;
 }
@@ -2437,6 +3001,10 @@ void AllNullableTypesWithoutRecursion::set_map_map(
   map_map_ = value_arg;
 }
 
+void AllNullableTypesWithoutRecursion::set_map_map(EncodableMap&& value_arg) {
+  map_map_ = std::move(value_arg);
+}
+
 EncodableList AllNullableTypesWithoutRecursion::ToEncodableList() const {
   EncodableList list;
   list.reserve(28);
@@ -2616,6 +3184,139 @@ AllNullableTypesWithoutRecursion::FromEncodableList(const EncodableList& list) {
   return decoded;
 }
 
+AllNullableTypesWithoutRecursion
+AllNullableTypesWithoutRecursion::FromEncodableList(EncodableList&& list) {
+  AllNullableTypesWithoutRecursion decoded;
+  auto& encodable_a_nullable_bool = list[0];
+  if (!encodable_a_nullable_bool.IsNull()) {
+    decoded.a_nullable_bool_ = std::get<bool>(encodable_a_nullable_bool);
+  }
+  auto& encodable_a_nullable_int = list[1];
+  if (!encodable_a_nullable_int.IsNull()) {
+    decoded.a_nullable_int_ = std::get<int64_t>(encodable_a_nullable_int);
+  }
+  auto& encodable_a_nullable_int64 = list[2];
+  if (!encodable_a_nullable_int64.IsNull()) {
+    decoded.a_nullable_int64_ = std::get<int64_t>(encodable_a_nullable_int64);
+  }
+  auto& encodable_a_nullable_double = list[3];
+  if (!encodable_a_nullable_double.IsNull()) {
+    decoded.a_nullable_double_ = std::get<double>(encodable_a_nullable_double);
+  }
+  auto& encodable_a_nullable_byte_array = list[4];
+  if (!encodable_a_nullable_byte_array.IsNull()) {
+    decoded.a_nullable_byte_array_ = std::move(
+        std::get<std::vector<uint8_t>>(encodable_a_nullable_byte_array));
+  }
+  auto& encodable_a_nullable4_byte_array = list[5];
+  if (!encodable_a_nullable4_byte_array.IsNull()) {
+    decoded.a_nullable4_byte_array_ = std::move(
+        std::get<std::vector<int32_t>>(encodable_a_nullable4_byte_array));
+  }
+  auto& encodable_a_nullable8_byte_array = list[6];
+  if (!encodable_a_nullable8_byte_array.IsNull()) {
+    decoded.a_nullable8_byte_array_ = std::move(
+        std::get<std::vector<int64_t>>(encodable_a_nullable8_byte_array));
+  }
+  auto& encodable_a_nullable_float_array = list[7];
+  if (!encodable_a_nullable_float_array.IsNull()) {
+    decoded.a_nullable_float_array_ = std::move(
+        std::get<std::vector<double>>(encodable_a_nullable_float_array));
+  }
+  auto& encodable_a_nullable_enum = list[8];
+  if (!encodable_a_nullable_enum.IsNull()) {
+    decoded.a_nullable_enum_ = std::any_cast<const AnEnum&>(
+        std::get<CustomEncodableValue>(encodable_a_nullable_enum));
+  }
+  auto& encodable_another_nullable_enum = list[9];
+  if (!encodable_another_nullable_enum.IsNull()) {
+    decoded.another_nullable_enum_ = std::any_cast<const AnotherEnum&>(
+        std::get<CustomEncodableValue>(encodable_another_nullable_enum));
+  }
+  auto& encodable_a_nullable_string = list[10];
+  if (!encodable_a_nullable_string.IsNull()) {
+    decoded.a_nullable_string_ =
+        std::move(std::get<std::string>(encodable_a_nullable_string));
+  }
+  auto& encodable_a_nullable_object = list[11];
+  if (!encodable_a_nullable_object.IsNull()) {
+    decoded.a_nullable_object_ = std::move(encodable_a_nullable_object);
+  }
+  auto& encodable_list = list[12];
+  if (!encodable_list.IsNull()) {
+    decoded.list_ = std::move(std::get<EncodableList>(encodable_list));
+  }
+  auto& encodable_string_list = list[13];
+  if (!encodable_string_list.IsNull()) {
+    decoded.string_list_ =
+        std::move(std::get<EncodableList>(encodable_string_list));
+  }
+  auto& encodable_int_list = list[14];
+  if (!encodable_int_list.IsNull()) {
+    decoded.int_list_ = std::move(std::get<EncodableList>(encodable_int_list));
+  }
+  auto& encodable_double_list = list[15];
+  if (!encodable_double_list.IsNull()) {
+    decoded.double_list_ =
+        std::move(std::get<EncodableList>(encodable_double_list));
+  }
+  auto& encodable_bool_list = list[16];
+  if (!encodable_bool_list.IsNull()) {
+    decoded.bool_list_ =
+        std::move(std::get<EncodableList>(encodable_bool_list));
+  }
+  auto& encodable_enum_list = list[17];
+  if (!encodable_enum_list.IsNull()) {
+    decoded.enum_list_ =
+        std::move(std::get<EncodableList>(encodable_enum_list));
+  }
+  auto& encodable_object_list = list[18];
+  if (!encodable_object_list.IsNull()) {
+    decoded.object_list_ =
+        std::move(std::get<EncodableList>(encodable_object_list));
+  }
+  auto& encodable_list_list = list[19];
+  if (!encodable_list_list.IsNull()) {
+    decoded.list_list_ =
+        std::move(std::get<EncodableList>(encodable_list_list));
+  }
+  auto& encodable_map_list = list[20];
+  if (!encodable_map_list.IsNull()) {
+    decoded.map_list_ = std::move(std::get<EncodableList>(encodable_map_list));
+  }
+  auto& encodable_map = list[21];
+  if (!encodable_map.IsNull()) {
+    decoded.map_ = std::move(std::get<EncodableMap>(encodable_map));
+  }
+  auto& encodable_string_map = list[22];
+  if (!encodable_string_map.IsNull()) {
+    decoded.string_map_ =
+        std::move(std::get<EncodableMap>(encodable_string_map));
+  }
+  auto& encodable_int_map = list[23];
+  if (!encodable_int_map.IsNull()) {
+    decoded.int_map_ = std::move(std::get<EncodableMap>(encodable_int_map));
+  }
+  auto& encodable_enum_map = list[24];
+  if (!encodable_enum_map.IsNull()) {
+    decoded.enum_map_ = std::move(std::get<EncodableMap>(encodable_enum_map));
+  }
+  auto& encodable_object_map = list[25];
+  if (!encodable_object_map.IsNull()) {
+    decoded.object_map_ =
+        std::move(std::get<EncodableMap>(encodable_object_map));
+  }
+  auto& encodable_list_map = list[26];
+  if (!encodable_list_map.IsNull()) {
+    decoded.list_map_ = std::move(std::get<EncodableMap>(encodable_list_map));
+  }
+  auto& encodable_map_map = list[27];
+  if (!encodable_map_map.IsNull()) {
+    decoded.map_map_ = std::move(std::get<EncodableMap>(encodable_map_map));
+  }
+  return decoded;
+}
+
 bool AllNullableTypesWithoutRecursion::operator==(
     const AllNullableTypesWithoutRecursion& other) const {
   return PigeonInternalDeepEquals(a_nullable_bool_, other.a_nullable_bool_) &&
@@ -2883,6 +3584,14 @@ AllClassesWrapper::AllClassesWrapper(const AllNullableTypes& all_nullable_types,
       class_list_(class_list),
       class_map_(class_map) {}
 
+AllClassesWrapper::AllClassesWrapper(AllNullableTypes&& all_nullable_types,
+                                     EncodableList&& class_list,
+                                     EncodableMap&& class_map)
+    : all_nullable_types_(
+          std::make_unique<AllNullableTypes>(std::move(all_nullable_types))),
+      class_list_(std::move(class_list)),
+      class_map_(std::move(class_map)) {}
+
 AllClassesWrapper::AllClassesWrapper(const AllNullableTypes& all_nullable_types,
                                      const AllNullableTypesWithoutRecursion*
                                          all_nullable_types_without_recursion,
@@ -2908,6 +3617,31 @@ AllClassesWrapper::AllClassesWrapper(const AllNullableTypes& all_nullable_types,
                               ? std::optional<EncodableMap>(*nullable_class_map)
                               : std::nullopt) {}
 
+AllClassesWrapper::AllClassesWrapper(AllNullableTypes&& all_nullable_types,
+                                     const AllNullableTypesWithoutRecursion*
+                                         all_nullable_types_without_recursion,
+                                     const AllTypes* all_types,
+                                     EncodableList&& class_list,
+                                     const EncodableList* nullable_class_list,
+                                     EncodableMap&& class_map,
+                                     const EncodableMap* nullable_class_map)
+    : all_nullable_types_(
+          std::make_unique<AllNullableTypes>(std::move(all_nullable_types))),
+      all_nullable_types_without_recursion_(
+          all_nullable_types_without_recursion
+              ? std::make_unique<AllNullableTypesWithoutRecursion>(
+                    *all_nullable_types_without_recursion)
+              : nullptr),
+      all_types_(all_types ? std::make_unique<AllTypes>(*all_types) : nullptr),
+      class_list_(std::move(class_list)),
+      nullable_class_list_(nullable_class_list ? std::optional<EncodableList>(
+                                                     *nullable_class_list)
+                                               : std::nullopt),
+      class_map_(std::move(class_map)),
+      nullable_class_map_(nullable_class_map
+                              ? std::optional<EncodableMap>(*nullable_class_map)
+                              : std::nullopt) {}
+
 AllClassesWrapper::AllClassesWrapper(const AllClassesWrapper& other)
     : all_nullable_types_(
           std::make_unique<AllNullableTypes>(*other.all_nullable_types_)),
@@ -2957,6 +3691,11 @@ void AllClassesWrapper::set_all_nullable_types(
   all_nullable_types_ = std::make_unique<AllNullableTypes>(value_arg);
 }
 
+void AllClassesWrapper::set_all_nullable_types(AllNullableTypes&& value_arg) {
+  all_nullable_types_ =
+      std::make_unique<AllNullableTypes>(std::move(value_arg));
+}
+
 const AllNullableTypesWithoutRecursion*
 AllClassesWrapper::all_nullable_types_without_recursion() const {
   return all_nullable_types_without_recursion_.get();
@@ -2975,6 +3714,12 @@ void AllClassesWrapper::set_all_nullable_types_without_recursion(
       std::make_unique<AllNullableTypesWithoutRecursion>(value_arg);
 }
 
+void AllClassesWrapper::set_all_nullable_types_without_recursion(
+    AllNullableTypesWithoutRecursion&& value_arg) {
+  all_nullable_types_without_recursion_ =
+      std::make_unique<AllNullableTypesWithoutRecursion>(std::move(value_arg));
+}
+
 const AllTypes* AllClassesWrapper::all_types() const {
   return all_types_.get();
 }
@@ -2987,6 +3732,10 @@ void AllClassesWrapper::set_all_types(const AllTypes& value_arg) {
   all_types_ = std::make_unique<AllTypes>(value_arg);
 }
 
+void AllClassesWrapper::set_all_types(AllTypes&& value_arg) {
+  all_types_ = std::make_unique<AllTypes>(std::move(value_arg));
+}
+
 const EncodableList& AllClassesWrapper::class_list() const {
   return class_list_;
 }
@@ -2995,6 +3744,10 @@ void AllClassesWrapper::set_class_list(const EncodableList& value_arg) {
   class_list_ = value_arg;
 }
 
+void AllClassesWrapper::set_class_list(EncodableList&& value_arg) {
+  class_list_ = std::move(value_arg);
+}
+
 const EncodableList* AllClassesWrapper::nullable_class_list() const {
   return nullable_class_list_ ? &(*nullable_class_list_) : nullptr;
 }
@@ -3010,12 +3763,20 @@ void AllClassesWrapper::set_nullable_class_list(
   nullable_class_list_ = value_arg;
 }
 
+void AllClassesWrapper::set_nullable_class_list(EncodableList&& value_arg) {
+  nullable_class_list_ = std::move(value_arg);
+}
+
 const EncodableMap& AllClassesWrapper::class_map() const { return class_map_; }
 
 void AllClassesWrapper::set_class_map(const EncodableMap& value_arg) {
   class_map_ = value_arg;
 }
 
+void AllClassesWrapper::set_class_map(EncodableMap&& value_arg) {
+  class_map_ = std::move(value_arg);
+}
+
 const EncodableMap* AllClassesWrapper::nullable_class_map() const {
   return nullable_class_map_ ? &(*nullable_class_map_) : nullptr;
 }
@@ -3029,6 +3790,10 @@ void AllClassesWrapper::set_nullable_class_map(const EncodableMap& value_arg) {
   nullable_class_map_ = value_arg;
 }
 
+void AllClassesWrapper::set_nullable_class_map(EncodableMap&& value_arg) {
+  nullable_class_map_ = std::move(value_arg);
+}
+
 EncodableList AllClassesWrapper::ToEncodableList() const {
   EncodableList list;
   list.reserve(7);
@@ -3079,6 +3844,38 @@ AllClassesWrapper AllClassesWrapper::FromEncodableList(
   return decoded;
 }
 
+AllClassesWrapper AllClassesWrapper::FromEncodableList(EncodableList&& list) {
+  AllClassesWrapper decoded(std::move(std::any_cast<AllNullableTypes&>(
+                                std::get<CustomEncodableValue>(list[0]))),
+                            std::move(std::get<EncodableList>(list[3])),
+                            std::move(std::get<EncodableMap>(list[5])));
+  auto& encodable_all_nullable_types_without_recursion = list[1];
+  if (!encodable_all_nullable_types_without_recursion.IsNull()) {
+    decoded.all_nullable_types_without_recursion_ =
+        std::make_unique<AllNullableTypesWithoutRecursion>(std::move(
+            std::any_cast<AllNullableTypesWithoutRecursion&>(
+                std::get<CustomEncodableValue>(
+                    encodable_all_nullable_types_without_recursion))));
+  }
+  auto& encodable_all_types = list[2];
+  if (!encodable_all_types.IsNull()) {
+    decoded.all_types_ =
+        std::make_unique<AllTypes>(std::move(std::any_cast<AllTypes&>(
+            std::get<CustomEncodableValue>(encodable_all_types))));
+  }
+  auto& encodable_nullable_class_list = list[4];
+  if (!encodable_nullable_class_list.IsNull()) {
+    decoded.nullable_class_list_ =
+        std::move(std::get<EncodableList>(encodable_nullable_class_list));
+  }
+  auto& encodable_nullable_class_map = list[6];
+  if (!encodable_nullable_class_map.IsNull()) {
+    decoded.nullable_class_map_ =
+        std::move(std::get<EncodableMap>(encodable_nullable_class_map));
+  }
+  return decoded;
+}
+
 bool AllClassesWrapper::operator==(const AllClassesWrapper& other) const {
   return PigeonInternalDeepEquals(all_nullable_types_,
                                   other.all_nullable_types_) &&
@@ -3170,6 +3967,10 @@ void TestMessage::set_test_list(const EncodableList& value_arg) {
   test_list_ = value_arg;
 }
 
+void TestMessage::set_test_list(EncodableList&& value_arg) {
+  test_list_ = std::move(value_arg);
+}
+
 EncodableList TestMessage::ToEncodableList() const {
   EncodableList list;
   list.reserve(1);
@@ -3186,6 +3987,16 @@ TestMessage TestMessage::FromEncodableList(const EncodableList& list) {
   return decoded;
 }
 
+TestMessage TestMessage::FromEncodableList(EncodableList&& list) {
+  TestMessage decoded;
+  auto& encodable_test_list = list[0];
+  if (!encodable_test_list.IsNull()) {
+    decoded.test_list_ =
+        std::move(std::get<EncodableList>(encodable_test_list));
+  }
+  return decoded;
+}
+
 bool TestMessage::operator==(const TestMessage& other) const {
   return PigeonInternalDeepEquals(test_list_, other.test_list_);
 }
@@ -3206,132 +4017,1193 @@ std::ostream& operator<<(std::ostream& os, const TestMessage& obj) {
   if (obj.test_list_) {
     os << PigeonInternalToString(*obj.test_list_);
   } else {
-    os << "null";
+    os << "null";
+  }
+  os << ")";
+  return os;
+}
+
+size_t PigeonInternalDeepHash(const TestMessage& v) { return v.Hash(); }
+
+namespace {
+// The type bytes that ::flutter::StandardCodecSerializer writes before the
+// values that are read from and written to the stream directly.
+constexpr uint8_t kEncodedNull = 0;
+constexpr uint8_t kEncodedTrue = 1;
+constexpr uint8_t kEncodedFalse = 2;
+constexpr uint8_t kEncodedInt32 = 3;
+constexpr uint8_t kEncodedInt64 = 4;
+constexpr uint8_t kEncodedFloat64 = 6;
+constexpr uint8_t kEncodedString = 7;
+constexpr uint8_t kEncodedUInt8List = 8;
+constexpr uint8_t kEncodedInt32List = 9;
+constexpr uint8_t kEncodedInt64List = 10;
+constexpr uint8_t kEncodedFloat64List = 11;
+constexpr uint8_t kEncodedList = 12;
+constexpr uint8_t kEncodedMap = 13;
+}  // namespace
+
+namespace {
+// Sets |encodable| to a CustomEncodableValue holding |value|.
+template <typename T>
+void PigeonInternalSetCustomValue(T&& value, EncodableValue* encodable) {
+  std::any& any = encodable->emplace<CustomEncodableValue>(std::any());
+  any.emplace<std::decay_t<T>>(std::forward<T>(value));
+}
+
+// Moves |source| into |destination| without copying the value of a
+// CustomEncodableValue, which moving the EncodableValue would do.
+void PigeonInternalMoveValue(EncodableValue&& source,
+                             EncodableValue* destination) {
+  if (CustomEncodableValue* custom_value =
+          std::get_if<CustomEncodableValue>(&source)) {
+    std::any& any = destination->emplace<CustomEncodableValue>(std::any());
+    any.swap(*custom_value);
+    return;
+  }
+  *destination = std::move(source);
+}
+
+}  // namespace
+
+PigeonInternalCodecSerializer::PigeonInternalCodecSerializer() {}
+
+EncodableValue PigeonInternalCodecSerializer::ReadValueOfType(
+    uint8_t type, ::flutter::ByteStreamReader* stream) const {
+  switch (type) {
+    case 129: {
+      const auto& encodable_enum_arg = ReadValue(stream);
+      const int64_t enum_arg_value =
+          encodable_enum_arg.IsNull() ? 0 : encodable_enum_arg.LongValue();
+      return encodable_enum_arg.IsNull()
+                 ? EncodableValue()
+                 : CustomEncodableValue(static_cast<AnEnum>(enum_arg_value));
+    }
+    case 130: {
+      const auto& encodable_enum_arg = ReadValue(stream);
+      const int64_t enum_arg_value =
+          encodable_enum_arg.IsNull() ? 0 : encodable_enum_arg.LongValue();
+      return encodable_enum_arg.IsNull()
+                 ? EncodableValue()
+                 : CustomEncodableValue(
+                       static_cast<AnotherEnum>(enum_arg_value));
+    }
+    case 131: {
+      EncodableValue value;
+      PigeonInternalSetCustomValue(ReadUnusedClass(type, stream), &value);
+      return value;
+    }
+    case 132: {
+      EncodableValue value;
+      PigeonInternalSetCustomValue(ReadAllTypes(type, stream), &value);
+      return value;
+    }
+    case 133: {
+      EncodableValue value;
+      PigeonInternalSetCustomValue(ReadAllNullableTypes(type, stream), &value);
+      return value;
+    }
+    case 134: {
+      EncodableValue value;
+      PigeonInternalSetCustomValue(
+          ReadAllNullableTypesWithoutRecursion(type, stream), &value);
+      return value;
+    }
+    case 135: {
+      EncodableValue value;
+      PigeonInternalSetCustomValue(ReadAllClassesWrapper(type, stream), &value);
+      return value;
+    }
+    case 136: {
+      EncodableValue value;
+      PigeonInternalSetCustomValue(ReadTestMessage(type, stream), &value);
+      return value;
+    }
+    case kEncodedList: {
+      const size_t size = ReadSize(stream);
+      EncodableList list(size);
+      for (EncodableValue& element : list) {
+        PigeonInternalMoveValue(ReadValue(stream), &element);
+      }
+      return EncodableValue(std::move(list));
+    }
+    case kEncodedMap: {
+      const size_t size = ReadSize(stream);
+      EncodableMap map;
+      for (size_t i = 0; i < size; ++i) {
+        EncodableValue key = ReadValue(stream);
+        EncodableValue value = ReadValue(stream);
+        auto [entry, inserted] = map.try_emplace(std::move(key));
+        if (inserted) {
+          PigeonInternalMoveValue(std::move(value), &entry->second);
+        }
+      }
+      return EncodableValue(std::move(map));
+    }
+    default:
+      return ::flutter::StandardCodecSerializer::ReadValueOfType(type, stream);
+  }
+}
+
+void PigeonInternalCodecSerializer::WriteValue(
+    const EncodableValue& value, ::flutter::ByteStreamWriter* stream) const {
+  if (const CustomEncodableValue* custom_value =
+          std::get_if<CustomEncodableValue>(&value)) {
+    if (custom_value->type() == typeid(AnEnum)) {
+      stream->WriteByte(129);
+      WriteValue(EncodableValue(
+                     static_cast<int>(std::any_cast<AnEnum>(*custom_value))),
+                 stream);
+      return;
+    }
+    if (custom_value->type() == typeid(AnotherEnum)) {
+      stream->WriteByte(130);
+      WriteValue(EncodableValue(static_cast<int>(
+                     std::any_cast<AnotherEnum>(*custom_value))),
+                 stream);
+      return;
+    }
+    if (custom_value->type() == typeid(UnusedClass)) {
+      stream->WriteByte(131);
+      WriteFields(std::any_cast<const UnusedClass&>(*custom_value), stream);
+      return;
+    }
+    if (custom_value->type() == typeid(AllTypes)) {
+      stream->WriteByte(132);
+      WriteFields(std::any_cast<const AllTypes&>(*custom_value), stream);
+      return;
+    }
+    if (custom_value->type() == typeid(AllNullableTypes)) {
+      stream->WriteByte(133);
+      WriteFields(std::any_cast<const AllNullableTypes&>(*custom_value),
+                  stream);
+      return;
+    }
+    if (custom_value->type() == typeid(AllNullableTypesWithoutRecursion)) {
+      stream->WriteByte(134);
+      WriteFields(std::any_cast<const AllNullableTypesWithoutRecursion&>(
+                      *custom_value),
+                  stream);
+      return;
+    }
+    if (custom_value->type() == typeid(AllClassesWrapper)) {
+      stream->WriteByte(135);
+      WriteFields(std::any_cast<const AllClassesWrapper&>(*custom_value),
+                  stream);
+      return;
+    }
+    if (custom_value->type() == typeid(TestMessage)) {
+      stream->WriteByte(136);
+      WriteFields(std::any_cast<const TestMessage&>(*custom_value), stream);
+      return;
+    }
+  }
+  ::flutter::StandardCodecSerializer::WriteValue(value, stream);
+}
+
+bool PigeonInternalCodecSerializer::ReadEncodedFieldList(
+    ::flutter::ByteStreamReader* stream, size_t field_count,
+    EncodableList* list) const {
+  const uint8_t type = stream->ReadByte();
+  if (type == kEncodedList) {
+    const size_t size = ReadSize(stream);
+    if (size == field_count) {
+      return true;
+    }
+    // The fields don't match this version of the class, so leave it to
+    // FromEncodableList to decide how to handle them.
+    list->reserve(size);
+    for (size_t i = 0; i < size; ++i) {
+      list->push_back(ReadValue(stream));
+    }
+  } else {
+    *list = std::get<EncodableList>(ReadValueOfType(type, stream));
+  }
+  if (list->size() < field_count) {
+    throw std::runtime_error("Expected " + std::to_string(field_count) +
+                             " data class fields, but got " +
+                             std::to_string(list->size()));
+  }
+  return false;
+}
+
+bool PigeonInternalCodecSerializer::ReadEncodedBool(
+    uint8_t type, ::flutter::ByteStreamReader* stream) const {
+  if (type == kEncodedTrue) {
+    return true;
+  }
+  if (type == kEncodedFalse) {
+    return false;
+  }
+  return std::get<bool>(ReadValueOfType(type, stream));
+}
+
+int64_t PigeonInternalCodecSerializer::ReadEncodedInt64(
+    uint8_t type, ::flutter::ByteStreamReader* stream) const {
+  if (type == kEncodedInt64) {
+    return stream->ReadInt64();
+  }
+  // StandardMessageCodec writes ints that fit in 32 bits as int32.
+  if (type == kEncodedInt32) {
+    return stream->ReadInt32();
+  }
+  return ReadValueOfType(type, stream).LongValue();
+}
+
+double PigeonInternalCodecSerializer::ReadEncodedDouble(
+    uint8_t type, ::flutter::ByteStreamReader* stream) const {
+  if (type != kEncodedFloat64) {
+    return std::get<double>(ReadValueOfType(type, stream));
+  }
+  stream->ReadAlignment(8);
+  return stream->ReadDouble();
+}
+
+std::string PigeonInternalCodecSerializer::ReadEncodedString(
+    uint8_t type, ::flutter::ByteStreamReader* stream) const {
+  if (type != kEncodedString) {
+    return std::get<std::string>(ReadValueOfType(type, stream));
+  }
+  std::string value(ReadSize(stream), '\0');
+  stream->ReadBytes(reinterpret_cast<uint8_t*>(value.data()), value.size());
+  return value;
+}
+
+template <typename T>
+std::vector<T> PigeonInternalCodecSerializer::ReadEncodedTypedData(
+    uint8_t type, ::flutter::ByteStreamReader* stream) const {
+  constexpr uint8_t expected_type =
+      std::is_same_v<T, uint8_t>   ? kEncodedUInt8List
+      : std::is_same_v<T, int32_t> ? kEncodedInt32List
+      : std::is_same_v<T, int64_t> ? kEncodedInt64List
+                                   : kEncodedFloat64List;
+  if (type != expected_type) {
+    return std::get<std::vector<T>>(ReadValueOfType(type, stream));
+  }
+  std::vector<T> value(ReadSize(stream));
+  if (sizeof(T) > 1) {
+    stream->ReadAlignment(sizeof(T));
+  }
+  stream->ReadBytes(reinterpret_cast<uint8_t*>(value.data()),
+                    value.size() * sizeof(T));
+  return value;
+}
+
+UnusedClass PigeonInternalCodecSerializer::ReadUnusedClass(
+    uint8_t type, ::flutter::ByteStreamReader* stream) const {
+  if (type != 131) {
+    return std::move(std::any_cast<UnusedClass&>(
+        std::get<CustomEncodableValue>(ReadValueOfType(type, stream))));
+  }
+  EncodableList list;
+  if (!ReadEncodedFieldList(stream, 1, &list)) {
+    return UnusedClass::FromEncodableList(std::move(list));
+  }
+  UnusedClass decoded;
+  EncodableValue encodable_a_field = ReadValue(stream);
+  if (!encodable_a_field.IsNull()) {
+    decoded.a_field_ = std::move(encodable_a_field);
+  }
+  return decoded;
+}
+
+AllTypes PigeonInternalCodecSerializer::ReadAllTypes(
+    uint8_t type, ::flutter::ByteStreamReader* stream) const {
+  if (type != 132) {
+    return std::move(std::any_cast<AllTypes&>(
+        std::get<CustomEncodableValue>(ReadValueOfType(type, stream))));
+  }
+  EncodableList list;
+  if (!ReadEncodedFieldList(stream, 28, &list)) {
+    return AllTypes::FromEncodableList(std::move(list));
+  }
+  AllTypes decoded;
+  decoded.a_bool_ = ReadEncodedBool(stream->ReadByte(), stream);
+  decoded.an_int_ = ReadEncodedInt64(stream->ReadByte(), stream);
+  decoded.an_int64_ = ReadEncodedInt64(stream->ReadByte(), stream);
+  decoded.a_double_ = ReadEncodedDouble(stream->ReadByte(), stream);
+  decoded.a_byte_array_ =
+      ReadEncodedTypedData<uint8_t>(stream->ReadByte(), stream);
+  decoded.a4_byte_array_ =
+      ReadEncodedTypedData<int32_t>(stream->ReadByte(), stream);
+  decoded.a8_byte_array_ =
+      ReadEncodedTypedData<int64_t>(stream->ReadByte(), stream);
+  decoded.a_float_array_ =
+      ReadEncodedTypedData<double>(stream->ReadByte(), stream);
+  EncodableValue encodable_an_enum = ReadValue(stream);
+  decoded.an_enum_ = std::any_cast<const AnEnum&>(
+      std::get<CustomEncodableValue>(encodable_an_enum));
+  EncodableValue encodable_another_enum = ReadValue(stream);
+  decoded.another_enum_ = std::any_cast<const AnotherEnum&>(
+      std::get<CustomEncodableValue>(encodable_another_enum));
+  decoded.a_string_ = ReadEncodedString(stream->ReadByte(), stream);
+  EncodableValue encodable_an_object = ReadValue(stream);
+  decoded.an_object_ = std::move(encodable_an_object);
+  EncodableValue encodable_list = ReadValue(stream);
+  decoded.list_ = std::move(std::get<EncodableList>(encodable_list));
+  EncodableValue encodable_string_list = ReadValue(stream);
+  decoded.string_list_ =
+      std::move(std::get<EncodableList>(encodable_string_list));
+  EncodableValue encodable_int_list = ReadValue(stream);
+  decoded.int_list_ = std::move(std::get<EncodableList>(encodable_int_list));
+  EncodableValue encodable_double_list = ReadValue(stream);
+  decoded.double_list_ =
+      std::move(std::get<EncodableList>(encodable_double_list));
+  EncodableValue encodable_bool_list = ReadValue(stream);
+  decoded.bool_list_ = std::move(std::get<EncodableList>(encodable_bool_list));
+  EncodableValue encodable_enum_list = ReadValue(stream);
+  decoded.enum_list_ = std::move(std::get<EncodableList>(encodable_enum_list));
+  EncodableValue encodable_object_list = ReadValue(stream);
+  decoded.object_list_ =
+      std::move(std::get<EncodableList>(encodable_object_list));
+  EncodableValue encodable_list_list = ReadValue(stream);
+  decoded.list_list_ = std::move(std::get<EncodableList>(encodable_list_list));
+  EncodableValue encodable_map_list = ReadValue(stream);
+  decoded.map_list_ = std::move(std::get<EncodableList>(encodable_map_list));
+  EncodableValue encodable_map = ReadValue(stream);
+  decoded.map_ = std::move(std::get<EncodableMap>(encodable_map));
+  EncodableValue encodable_string_map = ReadValue(stream);
+  decoded.string_map_ = std::move(std::get<EncodableMap>(encodable_string_map));
+  EncodableValue encodable_int_map = ReadValue(stream);
+  decoded.int_map_ = std::move(std::get<EncodableMap>(encodable_int_map));
+  EncodableValue encodable_enum_map = ReadValue(stream);
+  decoded.enum_map_ = std::move(std::get<EncodableMap>(encodable_enum_map));
+  EncodableValue encodable_object_map = ReadValue(stream);
+  decoded.object_map_ = std::move(std::get<EncodableMap>(encodable_object_map));
+  EncodableValue encodable_list_map = ReadValue(stream);
+  decoded.list_map_ = std::move(std::get<EncodableMap>(encodable_list_map));
+  EncodableValue encodable_map_map = ReadValue(stream);
+  decoded.map_map_ = std::move(std::get<EncodableMap>(encodable_map_map));
+  return decoded;
+}
+
+AllNullableTypes PigeonInternalCodecSerializer::ReadAllNullableTypes(
+    uint8_t type, ::flutter::ByteStreamReader* stream) const {
+  if (type != 133) {
+    return std::move(std::any_cast<AllNullableTypes&>(
+        std::get<CustomEncodableValue>(ReadValueOfType(type, stream))));
+  }
+  EncodableList list;
+  if (!ReadEncodedFieldList(stream, 31, &list)) {
+    return AllNullableTypes::FromEncodableList(std::move(list));
+  }
+  AllNullableTypes decoded;
+  uint8_t field_type = stream->ReadByte();
+  if (field_type != kEncodedNull) {
+    decoded.a_nullable_bool_ = ReadEncodedBool(field_type, stream);
+  }
+  field_type = stream->ReadByte();
+  if (field_type != kEncodedNull) {
+    decoded.a_nullable_int_ = ReadEncodedInt64(field_type, stream);
+  }
+  field_type = stream->ReadByte();
+  if (field_type != kEncodedNull) {
+    decoded.a_nullable_int64_ = ReadEncodedInt64(field_type, stream);
+  }
+  field_type = stream->ReadByte();
+  if (field_type != kEncodedNull) {
+    decoded.a_nullable_double_ = ReadEncodedDouble(field_type, stream);
+  }
+  field_type = stream->ReadByte();
+  if (field_type != kEncodedNull) {
+    decoded.a_nullable_byte_array_ =
+        ReadEncodedTypedData<uint8_t>(field_type, stream);
+  }
+  field_type = stream->ReadByte();
+  if (field_type != kEncodedNull) {
+    decoded.a_nullable4_byte_array_ =
+        ReadEncodedTypedData<int32_t>(field_type, stream);
+  }
+  field_type = stream->ReadByte();
+  if (field_type != kEncodedNull) {
+    decoded.a_nullable8_byte_array_ =
+        ReadEncodedTypedData<int64_t>(field_type, stream);
+  }
+  field_type = stream->ReadByte();
+  if (field_type != kEncodedNull) {
+    decoded.a_nullable_float_array_ =
+        ReadEncodedTypedData<double>(field_type, stream);
+  }
+  EncodableValue encodable_a_nullable_enum = ReadValue(stream);
+  if (!encodable_a_nullable_enum.IsNull()) {
+    decoded.a_nullable_enum_ = std::any_cast<const AnEnum&>(
+        std::get<CustomEncodableValue>(encodable_a_nullable_enum));
+  }
+  EncodableValue encodable_another_nullable_enum = ReadValue(stream);
+  if (!encodable_another_nullable_enum.IsNull()) {
+    decoded.another_nullable_enum_ = std::any_cast<const AnotherEnum&>(
+        std::get<CustomEncodableValue>(encodable_another_nullable_enum));
+  }
+  field_type = stream->ReadByte();
+  if (field_type != kEncodedNull) {
+    decoded.a_nullable_string_ = ReadEncodedString(field_type, stream);
+  }
+  EncodableValue encodable_a_nullable_object = ReadValue(stream);
+  if (!encodable_a_nullable_object.IsNull()) {
+    decoded.a_nullable_object_ = std::move(encodable_a_nullable_object);
+  }
+  field_type = stream->ReadByte();
+  if (field_type != kEncodedNull) {
+    decoded.all_nullable_types_ = std::make_unique<AllNullableTypes>(
+        ReadAllNullableTypes(field_type, stream));
+  }
+  EncodableValue encodable_list = ReadValue(stream);
+  if (!encodable_list.IsNull()) {
+    decoded.list_ = std::move(std::get<EncodableList>(encodable_list));
+  }
+  EncodableValue encodable_string_list = ReadValue(stream);
+  if (!encodable_string_list.IsNull()) {
+    decoded.string_list_ =
+        std::move(std::get<EncodableList>(encodable_string_list));
+  }
+  EncodableValue encodable_int_list = ReadValue(stream);
+  if (!encodable_int_list.IsNull()) {
+    decoded.int_list_ = std::move(std::get<EncodableList>(encodable_int_list));
+  }
+  EncodableValue encodable_double_list = ReadValue(stream);
+  if (!encodable_double_list.IsNull()) {
+    decoded.double_list_ =
+        std::move(std::get<EncodableList>(encodable_double_list));
+  }
+  EncodableValue encodable_bool_list = ReadValue(stream);
+  if (!encodable_bool_list.IsNull()) {
+    decoded.bool_list_ =
+        std::move(std::get<EncodableList>(encodable_bool_list));
+  }
+  EncodableValue encodable_enum_list = ReadValue(stream);
+  if (!encodable_enum_list.IsNull()) {
+    decoded.enum_list_ =
+        std::move(std::get<EncodableList>(encodable_enum_list));
+  }
+  EncodableValue encodable_object_list = ReadValue(stream);
+  if (!encodable_object_list.IsNull()) {
+    decoded.object_list_ =
+        std::move(std::get<EncodableList>(encodable_object_list));
+  }
+  EncodableValue encodable_list_list = ReadValue(stream);
+  if (!encodable_list_list.IsNull()) {
+    decoded.list_list_ =
+        std::move(std::get<EncodableList>(encodable_list_list));
+  }
+  EncodableValue encodable_map_list = ReadValue(stream);
+  if (!encodable_map_list.IsNull()) {
+    decoded.map_list_ = std::move(std::get<EncodableList>(encodable_map_list));
+  }
+  EncodableValue encodable_recursive_class_list = ReadValue(stream);
+  if (!encodable_recursive_class_list.IsNull()) {
+    decoded.recursive_class_list_ =
+        std::move(std::get<EncodableList>(encodable_recursive_class_list));
+  }
+  EncodableValue encodable_map = ReadValue(stream);
+  if (!encodable_map.IsNull()) {
+    decoded.map_ = std::move(std::get<EncodableMap>(encodable_map));
+  }
+  EncodableValue encodable_string_map = ReadValue(stream);
+  if (!encodable_string_map.IsNull()) {
+    decoded.string_map_ =
+        std::move(std::get<EncodableMap>(encodable_string_map));
+  }
+  EncodableValue encodable_int_map = ReadValue(stream);
+  if (!encodable_int_map.IsNull()) {
+    decoded.int_map_ = std::move(std::get<EncodableMap>(encodable_int_map));
+  }
+  EncodableValue encodable_enum_map = ReadValue(stream);
+  if (!encodable_enum_map.IsNull()) {
+    decoded.enum_map_ = std::move(std::get<EncodableMap>(encodable_enum_map));
+  }
+  EncodableValue encodable_object_map = ReadValue(stream);
+  if (!encodable_object_map.IsNull()) {
+    decoded.object_map_ =
+        std::move(std::get<EncodableMap>(encodable_object_map));
+  }
+  EncodableValue encodable_list_map = ReadValue(stream);
+  if (!encodable_list_map.IsNull()) {
+    decoded.list_map_ = std::move(std::get<EncodableMap>(encodable_list_map));
+  }
+  EncodableValue encodable_map_map = ReadValue(stream);
+  if (!encodable_map_map.IsNull()) {
+    decoded.map_map_ = std::move(std::get<EncodableMap>(encodable_map_map));
+  }
+  EncodableValue encodable_recursive_class_map = ReadValue(stream);
+  if (!encodable_recursive_class_map.IsNull()) {
+    decoded.recursive_class_map_ =
+        std::move(std::get<EncodableMap>(encodable_recursive_class_map));
+  }
+  return decoded;
+}
+
+AllNullableTypesWithoutRecursion
+PigeonInternalCodecSerializer::ReadAllNullableTypesWithoutRecursion(
+    uint8_t type, ::flutter::ByteStreamReader* stream) const {
+  if (type != 134) {
+    return std::move(std::any_cast<AllNullableTypesWithoutRecursion&>(
+        std::get<CustomEncodableValue>(ReadValueOfType(type, stream))));
+  }
+  EncodableList list;
+  if (!ReadEncodedFieldList(stream, 28, &list)) {
+    return AllNullableTypesWithoutRecursion::FromEncodableList(
+        std::move(list));
+  }
+  AllNullableTypesWithoutRecursion decoded;
+  uint8_t field_type = stream->ReadByte();
+  if (field_type != kEncodedNull) {
+    decoded.a_nullable_bool_ = ReadEncodedBool(field_type, stream);
+  }
+  field_type = stream->ReadByte();
+  if (field_type != kEncodedNull) {
+    decoded.a_nullable_int_ = ReadEncodedInt64(field_type, stream);
+  }
+  field_type = stream->ReadByte();
+  if (field_type != kEncodedNull) {
+    decoded.a_nullable_int64_ = ReadEncodedInt64(field_type, stream);
+  }
+  field_type = stream->ReadByte();
+  if (field_type != kEncodedNull) {
+    decoded.a_nullable_double_ = ReadEncodedDouble(field_type, stream);
+  }
+  field_type = stream->ReadByte();
+  if (field_type != kEncodedNull) {
+    decoded.a_nullable_byte_array_ =
+        ReadEncodedTypedData<uint8_t>(field_type, stream);
+  }
+  field_type = stream->ReadByte();
+  if (field_type != kEncodedNull) {
+    decoded.a_nullable4_byte_array_ =
+        ReadEncodedTypedData<int32_t>(field_type, stream);
+  }
+  field_type = stream->ReadByte();
+  if (field_type != kEncodedNull) {
+    decoded.a_nullable8_byte_array_ =
+        ReadEncodedTypedData<int64_t>(field_type, stream);
+  }
+  field_type = stream->ReadByte();
+  if (field_type != kEncodedNull) {
+    decoded.a_nullable_float_array_ =
+        ReadEncodedTypedData<double>(field_type, stream);
+  }
+  EncodableValue encodable_a_nullable_enum = ReadValue(stream);
+  if (!encodable_a_nullable_enum.IsNull()) {
+    decoded.a_nullable_enum_ = std::any_cast<const AnEnum&>(
+        std::get<CustomEncodableValue>(encodable_a_nullable_enum));
+  }
+  EncodableValue encodable_another_nullable_enum = ReadValue(stream);
+  if (!encodable_another_nullable_enum.IsNull()) {
+    decoded.another_nullable_enum_ = std::any_cast<const AnotherEnum&>(
+        std::get<CustomEncodableValue>(encodable_another_nullable_enum));
+  }
+  field_type = stream->ReadByte();
+  if (field_type != kEncodedNull) {
+    decoded.a_nullable_string_ = ReadEncodedString(field_type, stream);
+  }
+  EncodableValue encodable_a_nullable_object = ReadValue(stream);
+  if (!encodable_a_nullable_object.IsNull()) {
+    decoded.a_nullable_object_ = std::move(encodable_a_nullable_object);
+  }
+  EncodableValue encodable_list = ReadValue(stream);
+  if (!encodable_list.IsNull()) {
+    decoded.list_ = std::move(std::get<EncodableList>(encodable_list));
+  }
+  EncodableValue encodable_string_list = ReadValue(stream);
+  if (!encodable_string_list.IsNull()) {
+    decoded.string_list_ =
+        std::move(std::get<EncodableList>(encodable_string_list));
+  }
+  EncodableValue encodable_int_list = ReadValue(stream);
+  if (!encodable_int_list.IsNull()) {
+    decoded.int_list_ = std::move(std::get<EncodableList>(encodable_int_list));
+  }
+  EncodableValue encodable_double_list = ReadValue(stream);
+  if (!encodable_double_list.IsNull()) {
+    decoded.double_list_ =
+        std::move(std::get<EncodableList>(encodable_double_list));
+  }
+  EncodableValue encodable_bool_list = ReadValue(stream);
+  if (!encodable_bool_list.IsNull()) {
+    decoded.bool_list_ =
+        std::move(std::get<EncodableList>(encodable_bool_list));
+  }
+  EncodableValue encodable_enum_list = ReadValue(stream);
+  if (!encodable_enum_list.IsNull()) {
+    decoded.enum_list_ =
+        std::move(std::get<EncodableList>(encodable_enum_list));
+  }
+  EncodableValue encodable_object_list = ReadValue(stream);
+  if (!encodable_object_list.IsNull()) {
+    decoded.object_list_ =
+        std::move(std::get<EncodableList>(encodable_object_list));
+  }
+  EncodableValue encodable_list_list = ReadValue(stream);
+  if (!encodable_list_list.IsNull()) {
+    decoded.list_list_ =
+        std::move(std::get<EncodableList>(encodable_list_list));
+  }
+  EncodableValue encodable_map_list = ReadValue(stream);
+  if (!encodable_map_list.IsNull()) {
+    decoded.map_list_ = std::move(std::get<EncodableList>(encodable_map_list));
+  }
+  EncodableValue encodable_map = ReadValue(stream);
+  if (!encodable_map.IsNull()) {
+    decoded.map_ = std::move(std::get<EncodableMap>(encodable_map));
+  }
+  EncodableValue encodable_string_map = ReadValue(stream);
+  if (!encodable_string_map.IsNull()) {
+    decoded.string_map_ =
+        std::move(std::get<EncodableMap>(encodable_string_map));
+  }
+  EncodableValue encodable_int_map = ReadValue(stream);
+  if (!encodable_int_map.IsNull()) {
+    decoded.int_map_ = std::move(std::get<EncodableMap>(encodable_int_map));
+  }
+  EncodableValue encodable_enum_map = ReadValue(stream);
+  if (!encodable_enum_map.IsNull()) {
+    decoded.enum_map_ = std::move(std::get<EncodableMap>(encodable_enum_map));
+  }
+  EncodableValue encodable_object_map = ReadValue(stream);
+  if (!encodable_object_map.IsNull()) {
+    decoded.object_map_ =
+        std::move(std::get<EncodableMap>(encodable_object_map));
+  }
+  EncodableValue encodable_list_map = ReadValue(stream);
+  if (!encodable_list_map.IsNull()) {
+    decoded.list_map_ = std::move(std::get<EncodableMap>(encodable_list_map));
+  }
+  EncodableValue encodable_map_map = ReadValue(stream);
+  if (!encodable_map_map.IsNull()) {
+    decoded.map_map_ = std::move(std::get<EncodableMap>(encodable_map_map));
+  }
+  return decoded;
+}
+
+AllClassesWrapper PigeonInternalCodecSerializer::ReadAllClassesWrapper(
+    uint8_t type, ::flutter::ByteStreamReader* stream) const {
+  if (type != 135) {
+    return std::move(std::any_cast<AllClassesWrapper&>(
+        std::get<CustomEncodableValue>(ReadValueOfType(type, stream))));
+  }
+  EncodableList list;
+  if (!ReadEncodedFieldList(stream, 7, &list)) {
+    return AllClassesWrapper::FromEncodableList(std::move(list));
+  }
+  AllClassesWrapper decoded;
+  decoded.all_nullable_types_ = std::make_unique<AllNullableTypes>(
+      ReadAllNullableTypes(stream->ReadByte(), stream));
+  uint8_t field_type = stream->ReadByte();
+  if (field_type != kEncodedNull) {
+    decoded.all_nullable_types_without_recursion_ =
+        std::make_unique<AllNullableTypesWithoutRecursion>(
+            ReadAllNullableTypesWithoutRecursion(field_type, stream));
+  }
+  field_type = stream->ReadByte();
+  if (field_type != kEncodedNull) {
+    decoded.all_types_ =
+        std::make_unique<AllTypes>(ReadAllTypes(field_type, stream));
+  }
+  EncodableValue encodable_class_list = ReadValue(stream);
+  decoded.class_list_ =
+      std::move(std::get<EncodableList>(encodable_class_list));
+  EncodableValue encodable_nullable_class_list = ReadValue(stream);
+  if (!encodable_nullable_class_list.IsNull()) {
+    decoded.nullable_class_list_ =
+        std::move(std::get<EncodableList>(encodable_nullable_class_list));
+  }
+  EncodableValue encodable_class_map = ReadValue(stream);
+  decoded.class_map_ = std::move(std::get<EncodableMap>(encodable_class_map));
+  EncodableValue encodable_nullable_class_map = ReadValue(stream);
+  if (!encodable_nullable_class_map.IsNull()) {
+    decoded.nullable_class_map_ =
+        std::move(std::get<EncodableMap>(encodable_nullable_class_map));
+  }
+  return decoded;
+}
+
+TestMessage PigeonInternalCodecSerializer::ReadTestMessage(
+    uint8_t type, ::flutter::ByteStreamReader* stream) const {
+  if (type != 136) {
+    return std::move(std::any_cast<TestMessage&>(
+        std::get<CustomEncodableValue>(ReadValueOfType(type, stream))));
+  }
+  EncodableList list;
+  if (!ReadEncodedFieldList(stream, 1, &list)) {
+    return TestMessage::FromEncodableList(std::move(list));
+  }
+  TestMessage decoded;
+  EncodableValue encodable_test_list = ReadValue(stream);
+  if (!encodable_test_list.IsNull()) {
+    decoded.test_list_ =
+        std::move(std::get<EncodableList>(encodable_test_list));
+  }
+  return decoded;
+}
+
+void PigeonInternalCodecSerializer::WriteEncodedBool(
+    bool value, ::flutter::ByteStreamWriter* stream) const {
+  stream->WriteByte(value ? kEncodedTrue : kEncodedFalse);
+}
+
+void PigeonInternalCodecSerializer::WriteEncodedInt64(
+    int64_t value, ::flutter::ByteStreamWriter* stream) const {
+  stream->WriteByte(kEncodedInt64);
+  stream->WriteInt64(value);
+}
+
+void PigeonInternalCodecSerializer::WriteEncodedDouble(
+    double value, ::flutter::ByteStreamWriter* stream) const {
+  stream->WriteByte(kEncodedFloat64);
+  stream->WriteAlignment(8);
+  stream->WriteDouble(value);
+}
+
+void PigeonInternalCodecSerializer::WriteEncodedString(
+    const std::string& value, ::flutter::ByteStreamWriter* stream) const {
+  stream->WriteByte(kEncodedString);
+  WriteSize(value.size(), stream);
+  if (!value.empty()) {
+    stream->WriteBytes(reinterpret_cast<const uint8_t*>(value.data()),
+                       value.size());
+  }
+}
+
+template <typename T>
+void PigeonInternalCodecSerializer::WriteEncodedTypedData(
+    const std::vector<T>& value, ::flutter::ByteStreamWriter* stream) const {
+  stream->WriteByte(std::is_same_v<T, uint8_t>   ? kEncodedUInt8List
+                    : std::is_same_v<T, int32_t> ? kEncodedInt32List
+                    : std::is_same_v<T, int64_t> ? kEncodedInt64List
+                                                 : kEncodedFloat64List);
+  WriteSize(value.size(), stream);
+  if (sizeof(T) > 1) {
+    stream->WriteAlignment(sizeof(T));
+  }
+  if (!value.empty()) {
+    stream->WriteBytes(reinterpret_cast<const uint8_t*>(value.data()),
+                       value.size() * sizeof(T));
+  }
+}
+
+void PigeonInternalCodecSerializer::WriteEncodedList(
+    const EncodableList& value, ::flutter::ByteStreamWriter* stream) const {
+  stream->WriteByte(kEncodedList);
+  WriteSize(value.size(), stream);
+  for (const EncodableValue& element : value) {
+    WriteValue(element, stream);
+  }
+}
+
+void PigeonInternalCodecSerializer::WriteEncodedMap(
+    const EncodableMap& value, ::flutter::ByteStreamWriter* stream) const {
+  stream->WriteByte(kEncodedMap);
+  WriteSize(value.size(), stream);
+  for (const auto& [key, element] : value) {
+    WriteValue(key, stream);
+    WriteValue(element, stream);
+  }
+}
+
+void PigeonInternalCodecSerializer::WriteFields(
+    const UnusedClass& value, ::flutter::ByteStreamWriter* stream) const {
+  stream->WriteByte(kEncodedList);
+  WriteSize(1, stream);
+  if (value.a_field_) {
+    WriteValue(*value.a_field_, stream);
+  } else {
+    stream->WriteByte(kEncodedNull);
+  }
+}
+
+void PigeonInternalCodecSerializer::WriteFields(
+    const AllTypes& value, ::flutter::ByteStreamWriter* stream) const {
+  stream->WriteByte(kEncodedList);
+  WriteSize(28, stream);
+  WriteEncodedBool(value.a_bool_, stream);
+  WriteEncodedInt64(value.an_int_, stream);
+  WriteEncodedInt64(value.an_int64_, stream);
+  WriteEncodedDouble(value.a_double_, stream);
+  WriteEncodedTypedData(value.a_byte_array_, stream);
+  WriteEncodedTypedData(value.a4_byte_array_, stream);
+  WriteEncodedTypedData(value.a8_byte_array_, stream);
+  WriteEncodedTypedData(value.a_float_array_, stream);
+  stream->WriteByte(129);
+  WriteValue(EncodableValue(static_cast<int>(value.an_enum_)), stream);
+  stream->WriteByte(130);
+  WriteValue(EncodableValue(static_cast<int>(value.another_enum_)), stream);
+  WriteEncodedString(value.a_string_, stream);
+  WriteValue(value.an_object_, stream);
+  WriteEncodedList(value.list_, stream);
+  WriteEncodedList(value.string_list_, stream);
+  WriteEncodedList(value.int_list_, stream);
+  WriteEncodedList(value.double_list_, stream);
+  WriteEncodedList(value.bool_list_, stream);
+  WriteEncodedList(value.enum_list_, stream);
+  WriteEncodedList(value.object_list_, stream);
+  WriteEncodedList(value.list_list_, stream);
+  WriteEncodedList(value.map_list_, stream);
+  WriteEncodedMap(value.map_, stream);
+  WriteEncodedMap(value.string_map_, stream);
+  WriteEncodedMap(value.int_map_, stream);
+  WriteEncodedMap(value.enum_map_, stream);
+  WriteEncodedMap(value.object_map_, stream);
+  WriteEncodedMap(value.list_map_, stream);
+  WriteEncodedMap(value.map_map_, stream);
+}
+
+void PigeonInternalCodecSerializer::WriteFields(
+    const AllNullableTypes& value, ::flutter::ByteStreamWriter* stream) const {
+  stream->WriteByte(kEncodedList);
+  WriteSize(31, stream);
+  if (value.a_nullable_bool_) {
+    WriteEncodedBool(*value.a_nullable_bool_, stream);
+  } else {
+    stream->WriteByte(kEncodedNull);
+  }
+  if (value.a_nullable_int_) {
+    WriteEncodedInt64(*value.a_nullable_int_, stream);
+  } else {
+    stream->WriteByte(kEncodedNull);
+  }
+  if (value.a_nullable_int64_) {
+    WriteEncodedInt64(*value.a_nullable_int64_, stream);
+  } else {
+    stream->WriteByte(kEncodedNull);
+  }
+  if (value.a_nullable_double_) {
+    WriteEncodedDouble(*value.a_nullable_double_, stream);
+  } else {
+    stream->WriteByte(kEncodedNull);
+  }
+  if (value.a_nullable_byte_array_) {
+    WriteEncodedTypedData(*value.a_nullable_byte_array_, stream);
+  } else {
+    stream->WriteByte(kEncodedNull);
+  }
+  if (value.a_nullable4_byte_array_) {
+    WriteEncodedTypedData(*value.a_nullable4_byte_array_, stream);
+  } else {
+    stream->WriteByte(kEncodedNull);
+  }
+  if (value.a_nullable8_byte_array_) {
+    WriteEncodedTypedData(*value.a_nullable8_byte_array_, stream);
+  } else {
+    stream->WriteByte(kEncodedNull);
+  }
+  if (value.a_nullable_float_array_) {
+    WriteEncodedTypedData(*value.a_nullable_float_array_, stream);
+  } else {
+    stream->WriteByte(kEncodedNull);
+  }
+  if (value.a_nullable_enum_) {
+    stream->WriteByte(129);
+    WriteValue(EncodableValue(static_cast<int>(*value.a_nullable_enum_)),
+               stream);
+  } else {
+    stream->WriteByte(kEncodedNull);
+  }
+  if (value.another_nullable_enum_) {
+    stream->WriteByte(130);
+    WriteValue(EncodableValue(static_cast<int>(*value.another_nullable_enum_)),
+               stream);
+  } else {
+    stream->WriteByte(kEncodedNull);
+  }
+  if (value.a_nullable_string_) {
+    WriteEncodedString(*value.a_nullable_string_, stream);
+  } else {
+    stream->WriteByte(kEncodedNull);
+  }
+  if (value.a_nullable_object_) {
+    WriteValue(*value.a_nullable_object_, stream);
+  } else {
+    stream->WriteByte(kEncodedNull);
+  }
+  if (value.all_nullable_types_) {
+    stream->WriteByte(133);
+    WriteFields(*value.all_nullable_types_, stream);
+  } else {
+    stream->WriteByte(kEncodedNull);
+  }
+  if (value.list_) {
+    WriteEncodedList(*value.list_, stream);
+  } else {
+    stream->WriteByte(kEncodedNull);
+  }
+  if (value.string_list_) {
+    WriteEncodedList(*value.string_list_, stream);
+  } else {
+    stream->WriteByte(kEncodedNull);
+  }
+  if (value.int_list_) {
+    WriteEncodedList(*value.int_list_, stream);
+  } else {
+    stream->WriteByte(kEncodedNull);
+  }
+  if (value.double_list_) {
+    WriteEncodedList(*value.double_list_, stream);
+  } else {
+    stream->WriteByte(kEncodedNull);
+  }
+  if (value.bool_list_) {
+    WriteEncodedList(*value.bool_list_, stream);
+  } else {
+    stream->WriteByte(kEncodedNull);
+  }
+  if (value.enum_list_) {
+    WriteEncodedList(*value.enum_list_, stream);
+  } else {
+    stream->WriteByte(kEncodedNull);
+  }
+  if (value.object_list_) {
+    WriteEncodedList(*value.object_list_, stream);
+  } else {
+    stream->WriteByte(kEncodedNull);
+  }
+  if (value.list_list_) {
+    WriteEncodedList(*value.list_list_, stream);
+  } else {
+    stream->WriteByte(kEncodedNull);
+  }
+  if (value.map_list_) {
+    WriteEncodedList(*value.map_list_, stream);
+  } else {
+    stream->WriteByte(kEncodedNull);
+  }
+  if (value.recursive_class_list_) {
+    WriteEncodedList(*value.recursive_class_list_, stream);
+  } else {
+    stream->WriteByte(kEncodedNull);
+  }
+  if (value.map_) {
+    WriteEncodedMap(*value.map_, stream);
+  } else {
+    stream->WriteByte(kEncodedNull);
+  }
+  if (value.string_map_) {
+    WriteEncodedMap(*value.string_map_, stream);
+  } else {
+    stream->WriteByte(kEncodedNull);
+  }
+  if (value.int_map_) {
+    WriteEncodedMap(*value.int_map_, stream);
+  } else {
+    stream->WriteByte(kEncodedNull);
+  }
+  if (value.enum_map_) {
+    WriteEncodedMap(*value.enum_map_, stream);
+  } else {
+    stream->WriteByte(kEncodedNull);
+  }
+  if (value.object_map_) {
+    WriteEncodedMap(*value.object_map_, stream);
+  } else {
+    stream->WriteByte(kEncodedNull);
+  }
+  if (value.list_map_) {
+    WriteEncodedMap(*value.list_map_, stream);
+  } else {
+    stream->WriteByte(kEncodedNull);
+  }
+  if (value.map_map_) {
+    WriteEncodedMap(*value.map_map_, stream);
+  } else {
+    stream->WriteByte(kEncodedNull);
+  }
+  if (value.recursive_class_map_) {
+    WriteEncodedMap(*value.recursive_class_map_, stream);
+  } else {
+    stream->WriteByte(kEncodedNull);
+  }
+}
+
+void PigeonInternalCodecSerializer::WriteFields(
+    const AllNullableTypesWithoutRecursion& value,
+    ::flutter::ByteStreamWriter* stream) const {
+  stream->WriteByte(kEncodedList);
+  WriteSize(28, stream);
+  if (value.a_nullable_bool_) {
+    WriteEncodedBool(*value.a_nullable_bool_, stream);
+  } else {
+    stream->WriteByte(kEncodedNull);
+  }
+  if (value.a_nullable_int_) {
+    WriteEncodedInt64(*value.a_nullable_int_, stream);
+  } else {
+    stream->WriteByte(kEncodedNull);
+  }
+  if (value.a_nullable_int64_) {
+    WriteEncodedInt64(*value.a_nullable_int64_, stream);
+  } else {
+    stream->WriteByte(kEncodedNull);
+  }
+  if (value.a_nullable_double_) {
+    WriteEncodedDouble(*value.a_nullable_double_, stream);
+  } else {
+    stream->WriteByte(kEncodedNull);
+  }
+  if (value.a_nullable_byte_array_) {
+    WriteEncodedTypedData(*value.a_nullable_byte_array_, stream);
+  } else {
+    stream->WriteByte(kEncodedNull);
+  }
+  if (value.a_nullable4_byte_array_) {
+    WriteEncodedTypedData(*value.a_nullable4_byte_array_, stream);
+  } else {
+    stream->WriteByte(kEncodedNull);
+  }
+  if (value.a_nullable8_byte_array_) {
+    WriteEncodedTypedData(*value.a_nullable8_byte_array_, stream);
+  } else {
+    stream->WriteByte(kEncodedNull);
+  }
+  if (value.a_nullable_float_array_) {
+    WriteEncodedTypedData(*value.a_nullable_float_array_, stream);
+  } else {
+    stream->WriteByte(kEncodedNull);
+  }
+  if (value.a_nullable_enum_) {
+    stream->WriteByte(129);
+    WriteValue(EncodableValue(static_cast<int>(*value.a_nullable_enum_)),
+               stream);
+  } else {
+    stream->WriteByte(kEncodedNull);
+  }
+  if (value.another_nullable_enum_) {
+    stream->WriteByte(130);
+    WriteValue(EncodableValue(static_cast<int>(*value.another_nullable_enum_)),
+               stream);
+  } else {
+    stream->WriteByte(kEncodedNull);
+  }
+  if (value.a_nullable_string_) {
+    WriteEncodedString(*value.a_nullable_string_, stream);
+  } else {
+    stream->WriteByte(kEncodedNull);
+  }
+  if (value.a_nullable_object_) {
+    WriteValue(*value.a_nullable_object_, stream);
+  } else {
+    stream->WriteByte(kEncodedNull);
+  }
+  if (value.list_) {
+    WriteEncodedList(*value.list_, stream);
+  } else {
+    stream->WriteByte(kEncodedNull);
+  }
+  if (value.string_list_) {
+    WriteEncodedList(*value.string_list_, stream);
+  } else {
+    stream->WriteByte(kEncodedNull);
+  }
+  if (value.int_list_) {
+    WriteEncodedList(*value.int_list_, stream);
+  } else {
+    stream->WriteByte(kEncodedNull);
+  }
+  if (value.double_list_) {
+    WriteEncodedList(*value.double_list_, stream);
+  } else {
+    stream->WriteByte(kEncodedNull);
+  }
+  if (value.bool_list_) {
+    WriteEncodedList(*value.bool_list_, stream);
+  } else {
+    stream->WriteByte(kEncodedNull);
+  }
+  if (value.enum_list_) {
+    WriteEncodedList(*value.enum_list_, stream);
+  } else {
+    stream->WriteByte(kEncodedNull);
+  }
+  if (value.object_list_) {
+    WriteEncodedList(*value.object_list_, stream);
+  } else {
+    stream->WriteByte(kEncodedNull);
+  }
+  if (value.list_list_) {
+    WriteEncodedList(*value.list_list_, stream);
+  } else {
+    stream->WriteByte(kEncodedNull);
+  }
+  if (value.map_list_) {
+    WriteEncodedList(*value.map_list_, stream);
+  } else {
+    stream->WriteByte(kEncodedNull);
+  }
+  if (value.map_) {
+    WriteEncodedMap(*value.map_, stream);
+  } else {
+    stream->WriteByte(kEncodedNull);
+  }
+  if (value.string_map_) {
+    WriteEncodedMap(*value.string_map_, stream);
+  } else {
+    stream->WriteByte(kEncodedNull);
+  }
+  if (value.int_map_) {
+    WriteEncodedMap(*value.int_map_, stream);
+  } else {
+    stream->WriteByte(kEncodedNull);
+  }
+  if (value.enum_map_) {
+    WriteEncodedMap(*value.enum_map_, stream);
+  } else {
+    stream->WriteByte(kEncodedNull);
+  }
+  if (value.object_map_) {
+    WriteEncodedMap(*value.object_map_, stream);
+  } else {
+    stream->WriteByte(kEncodedNull);
+  }
+  if (value.list_map_) {
+    WriteEncodedMap(*value.list_map_, stream);
+  } else {
+    stream->WriteByte(kEncodedNull);
+  }
+  if (value.map_map_) {
+    WriteEncodedMap(*value.map_map_, stream);
+  } else {
+    stream->WriteByte(kEncodedNull);
   }
-  os << ")";
-  return os;
 }
 
-size_t PigeonInternalDeepHash(const TestMessage& v) { return v.Hash(); }
-
-PigeonInternalCodecSerializer::PigeonInternalCodecSerializer() {}
-
-EncodableValue PigeonInternalCodecSerializer::ReadValueOfType(
-    uint8_t type, ::flutter::ByteStreamReader* stream) const {
-  switch (type) {
-    case 129: {
-      const auto& encodable_enum_arg = ReadValue(stream);
-      const int64_t enum_arg_value =
-          encodable_enum_arg.IsNull() ? 0 : encodable_enum_arg.LongValue();
-      return encodable_enum_arg.IsNull()
-                 ? EncodableValue()
-                 : CustomEncodableValue(static_cast<AnEnum>(enum_arg_value));
-    }
-    case 130: {
-      const auto& encodable_enum_arg = ReadValue(stream);
-      const int64_t enum_arg_value =
-          encodable_enum_arg.IsNull() ? 0 : encodable_enum_arg.LongValue();
-      return encodable_enum_arg.IsNull()
-                 ? EncodableValue()
-                 : CustomEncodableValue(
-                       static_cast<AnotherEnum>(enum_arg_value));
-    }
-    case 131: {
-      return CustomEncodableValue(UnusedClass::FromEncodableList(
-          std::get<EncodableList>(ReadValue(stream))));
-    }
-    case 132: {
-      return CustomEncodableValue(AllTypes::FromEncodableList(
-          std::get<EncodableList>(ReadValue(stream))));
-    }
-    case 133: {
-      return CustomEncodableValue(AllNullableTypes::FromEncodableList(
-          std::get<EncodableList>(ReadValue(stream))));
-    }
-    case 134: {
-      return CustomEncodableValue(
-          AllNullableTypesWithoutRecursion::FromEncodableList(
-              std::get<EncodableList>(ReadValue(stream))));
-    }
-    case 135: {
-      return CustomEncodableValue(AllClassesWrapper::FromEncodableList(
-          std::get<EncodableList>(ReadValue(stream))));
-    }
-    case 136: {
-      return CustomEncodableValue(TestMessage::FromEncodableList(
-          std::get<EncodableList>(ReadValue(stream))));
-    }
-    default:
-      return ::flutter::StandardCodecSerializer::ReadValueOfType(type, stream);
+void PigeonInternalCodecSerializer::WriteFields(
+    const AllClassesWrapper& value, ::flutter::ByteStreamWriter* stream) const {
+  stream->WriteByte(kEncodedList);
+  WriteSize(7, stream);
+  stream->WriteByte(133);
+  WriteFields(*value.all_nullable_types_, stream);
+  if (value.all_nullable_types_without_recursion_) {
+    stream->WriteByte(134);
+    WriteFields(*value.all_nullable_types_without_recursion_, stream);
+  } else {
+    stream->WriteByte(kEncodedNull);
+  }
+  if (value.all_types_) {
+    stream->WriteByte(132);
+    WriteFields(*value.all_types_, stream);
+  } else {
+    stream->WriteByte(kEncodedNull);
+  }
+  WriteEncodedList(value.class_list_, stream);
+  if (value.nullable_class_list_) {
+    WriteEncodedList(*value.nullable_class_list_, stream);
+  } else {
+    stream->WriteByte(kEncodedNull);
+  }
+  WriteEncodedMap(value.class_map_, stream);
+  if (value.nullable_class_map_) {
+    WriteEncodedMap(*value.nullable_class_map_, stream);
+  } else {
+    stream->WriteByte(kEncodedNull);
   }
 }
 
-void PigeonInternalCodecSerializer::WriteValue(
-    const EncodableValue& value, ::flutter::ByteStreamWriter* stream) const {
-  if (const CustomEncodableValue* custom_value =
-          std::get_if<CustomEncodableValue>(&value)) {
-    if (custom_value->type() == typeid(AnEnum)) {
-      stream->WriteByte(129);
-      WriteValue(EncodableValue(
-                     static_cast<int>(std::any_cast<AnEnum>(*custom_value))),
-                 stream);
-      return;
-    }
-    if (custom_value->type() == typeid(AnotherEnum)) {
-      stream->WriteByte(130);
-      WriteValue(EncodableValue(static_cast<int>(
-                     std::any_cast<AnotherEnum>(*custom_value))),
-                 stream);
-      return;
-    }
-    if (custom_value->type() == typeid(UnusedClass)) {
-      stream->WriteByte(131);
-      WriteValue(
-          EncodableValue(
-              std::any_cast<UnusedClass>(*custom_value).ToEncodableList()),
-          stream);
-      return;
-    }
-    if (custom_value->type() == typeid(AllTypes)) {
-      stream->WriteByte(132);
-      WriteValue(EncodableValue(
-                     std::any_cast<AllTypes>(*custom_value).ToEncodableList()),
-                 stream);
-      return;
-    }
-    if (custom_value->type() == typeid(AllNullableTypes)) {
-      stream->WriteByte(133);
-      WriteValue(
-          EncodableValue(
-              std::any_cast<AllNullableTypes>(*custom_value).ToEncodableList()),
-          stream);
-      return;
-    }
-    if (custom_value->type() == typeid(AllNullableTypesWithoutRecursion)) {
-      stream->WriteByte(134);
-      WriteValue(EncodableValue(std::any_cast<AllNullableTypesWithoutRecursion>(
-                                    *custom_value)
-                                    .ToEncodableList()),
-                 stream);
-      return;
-    }
-    if (custom_value->type() == typeid(AllClassesWrapper)) {
-      stream->WriteByte(135);
-      WriteValue(EncodableValue(std::any_cast<AllClassesWrapper>(*custom_value)
-                                    .ToEncodableList()),
-                 stream);
-      return;
-    }
-    if (custom_value->type() == typeid(TestMessage)) {
-      stream->WriteByte(136);
-      WriteValue(
-          EncodableValue(
-              std::any_cast<TestMessage>(*custom_value).ToEncodableList()),
-          stream);
-      return;
-    }
+void PigeonInternalCodecSerializer::WriteFields(
+    const TestMessage& value, ::flutter::ByteStreamWriter* stream) const {
+  stream->WriteByte(kEncodedList);
+  WriteSize(1, stream);
+  if (value.test_list_) {
+    WriteEncodedList(*value.test_list_, stream);
+  } else {
+    stream->WriteByte(kEncodedNull);
   }
-  ::flutter::StandardCodecSerializer::WriteValue(value, stream);
 }
 
 /// The codec used by HostIntegrationCoreApi.
@@ -3350,6 +5222,14 @@ void HostIntegrationCoreApi::SetUp(::flutter::BinaryMessenger* binary_messenger,
 void HostIntegrationCoreApi::SetUp(::flutter::BinaryMessenger* binary_messenger,
                                    HostIntegrationCoreApi* api,
                                    const std::string& message_channel_suffix) {
+  HostIntegrationCoreApi::SetUp(binary_messenger, api, message_channel_suffix,
+                                nullptr);
+}
+
+void HostIntegrationCoreApi::SetUp(
+    ::flutter::BinaryMessenger* binary_messenger, HostIntegrationCoreApi* api,
+    const std::string& message_channel_suffix,
+    std::shared_ptr<PigeonTaskQueue> task_queue) {
   const std::string prepended_suffix =
       message_channel_suffix.length() > 0
           ? std::string(".") + message_channel_suffix
@@ -3406,8 +5286,9 @@ void HostIntegrationCoreApi::SetUp(::flutter::BinaryMessenger* binary_messenger,
                 return;
               }
               EncodableList wrapped;
-              wrapped.push_back(
-                  CustomEncodableValue(std::move(output).TakeValue()));
+              wrapped.emplace_back();
+              PigeonInternalSetCustomValue(std::move(output).TakeValue(),
+                                           &wrapped.back());
               reply(EncodableValue(std::move(wrapped)));
             } catch (const std::exception& exception) {
               reply(WrapError(exception.what()));
@@ -4385,8 +6266,9 @@ void HostIntegrationCoreApi::SetUp(::flutter::BinaryMessenger* binary_messenger,
                 return;
               }
               EncodableList wrapped;
-              wrapped.push_back(
-                  CustomEncodableValue(std::move(output).TakeValue()));
+              wrapped.emplace_back();
+              PigeonInternalSetCustomValue(std::move(output).TakeValue(),
+                                           &wrapped.back());
               reply(EncodableValue(std::move(wrapped)));
             } catch (const std::exception& exception) {
               reply(WrapError(exception.what()));
@@ -4724,8 +6606,9 @@ void HostIntegrationCoreApi::SetUp(::flutter::BinaryMessenger* binary_messenger,
               EncodableList wrapped;
               auto output_optional = std::move(output).TakeValue();
               if (output_optional) {
-                wrapped.push_back(
-                    CustomEncodableValue(std::move(output_optional).value()));
+                wrapped.emplace_back();
+                PigeonInternalSetCustomValue(std::move(output_optional).value(),
+                                             &wrapped.back());
               } else {
                 wrapped.push_back(EncodableValue());
               }
@@ -4767,8 +6650,9 @@ void HostIntegrationCoreApi::SetUp(::flutter::BinaryMessenger* binary_messenger,
           EncodableList wrapped;
           auto output_optional = std::move(output).TakeValue();
           if (output_optional) {
-            wrapped.push_back(
-                CustomEncodableValue(std::move(output_optional).value()));
+            wrapped.emplace_back();
+            PigeonInternalSetCustomValue(std::move(output_optional).value(),
+                                         &wrapped.back());
           } else {
             wrapped.push_back(EncodableValue());
           }
@@ -4847,8 +6731,9 @@ void HostIntegrationCoreApi::SetUp(::flutter::BinaryMessenger* binary_messenger,
                 return;
               }
               EncodableList wrapped;
-              wrapped.push_back(
-                  CustomEncodableValue(std::move(output).TakeValue()));
+              wrapped.emplace_back();
+              PigeonInternalSetCustomValue(std::move(output).TakeValue(),
+                                           &wrapped.back());
               reply(EncodableValue(std::move(wrapped)));
             } catch (const std::exception& exception) {
               reply(WrapError(exception.what()));
@@ -4888,8 +6773,9 @@ void HostIntegrationCoreApi::SetUp(::flutter::BinaryMessenger* binary_messenger,
                 return;
               }
               EncodableList wrapped;
-              wrapped.push_back(
-                  CustomEncodableValue(std::move(output).TakeValue()));
+              wrapped.emplace_back();
+              PigeonInternalSetCustomValue(std::move(output).TakeValue(),
+                                           &wrapped.back());
               reply(EncodableValue(std::move(wrapped)));
             } catch (const std::exception& exception) {
               reply(WrapError(exception.what()));
@@ -4930,8 +6816,9 @@ void HostIntegrationCoreApi::SetUp(::flutter::BinaryMessenger* binary_messenger,
                 return;
               }
               EncodableList wrapped;
-              wrapped.push_back(
-                  CustomEncodableValue(std::move(output).TakeValue()));
+              wrapped.emplace_back();
+              PigeonInternalSetCustomValue(std::move(output).TakeValue(),
+                                           &wrapped.back());
               reply(EncodableValue(std::move(wrapped)));
             } catch (const std::exception& exception) {
               reply(WrapError(exception.what()));
@@ -6638,8 +8525,9 @@ void HostIntegrationCoreApi::SetUp(::flutter::BinaryMessenger* binary_messenger,
                       return;
                     }
                     EncodableList wrapped;
-                    wrapped.push_back(
-                        CustomEncodableValue(std::move(output).TakeValue()));
+                    wrapped.emplace_back();
+                    PigeonInternalSetCustomValue(std::move(output).TakeValue(),
+                                                 &wrapped.back());
                     reply(EncodableValue(std::move(wrapped)));
                   });
             } catch (const std::exception& exception) {
@@ -6680,8 +8568,9 @@ void HostIntegrationCoreApi::SetUp(::flutter::BinaryMessenger* binary_messenger,
                     EncodableList wrapped;
                     auto output_optional = std::move(output).TakeValue();
                     if (output_optional) {
-                      wrapped.push_back(CustomEncodableValue(
-                          std::move(output_optional).value()));
+                      wrapped.emplace_back();
+                      PigeonInternalSetCustomValue(
+                          std::move(output_optional).value(), &wrapped.back());
                     } else {
                       wrapped.push_back(EncodableValue());
                     }
@@ -6726,8 +8615,9 @@ void HostIntegrationCoreApi::SetUp(::flutter::BinaryMessenger* binary_messenger,
                 EncodableList wrapped;
                 auto output_optional = std::move(output).TakeValue();
                 if (output_optional) {
-                  wrapped.push_back(
-                      CustomEncodableValue(std::move(output_optional).value()));
+                  wrapped.emplace_back();
+                  PigeonInternalSetCustomValue(
+                      std::move(output_optional).value(), &wrapped.back());
                 } else {
                   wrapped.push_back(EncodableValue());
                 }
@@ -7433,14 +9323,13 @@ void HostIntegrationCoreApi::SetUp(::flutter::BinaryMessenger* binary_messenger,
     }
   }
   {
-    BasicMessageChannel<> channel(
-        binary_messenger,
+    const std::string channel_name =
         "dev.flutter.pigeon.pigeon_integration_tests.HostIntegrationCoreApi."
         "taskQueueIsBackgroundThread" +
-            prepended_suffix,
-        &GetCodec());
+        prepended_suffix;
     if (api != nullptr) {
-      channel.SetMessageHandler(
+      PigeonInternalSetTaskQueueMessageHandler(
+          binary_messenger, channel_name, &GetCodec(), task_queue,
           [api](const EncodableValue& message,
                 const ::flutter::MessageReply<EncodableValue>& reply) {
             try {
@@ -7457,7 +9346,7 @@ void HostIntegrationCoreApi::SetUp(::flutter::BinaryMessenger* binary_messenger,
             }
           });
     } else {
-      channel.SetMessageHandler(nullptr);
+      binary_messenger->SetMessageHandler(channel_name, nullptr);
     }
   }
   {
@@ -7582,8 +9471,9 @@ void HostIntegrationCoreApi::SetUp(::flutter::BinaryMessenger* binary_messenger,
                       return;
                     }
                     EncodableList wrapped;
-                    wrapped.push_back(
-                        CustomEncodableValue(std::move(output).TakeValue()));
+                    wrapped.emplace_back();
+                    PigeonInternalSetCustomValue(std::move(output).TakeValue(),
+                                                 &wrapped.back());
                     reply(EncodableValue(std::move(wrapped)));
                   });
             } catch (const std::exception& exception) {
@@ -7624,8 +9514,9 @@ void HostIntegrationCoreApi::SetUp(::flutter::BinaryMessenger* binary_messenger,
                     EncodableList wrapped;
                     auto output_optional = std::move(output).TakeValue();
                     if (output_optional) {
-                      wrapped.push_back(CustomEncodableValue(
-                          std::move(output_optional).value()));
+                      wrapped.emplace_back();
+                      PigeonInternalSetCustomValue(
+                          std::move(output_optional).value(), &wrapped.back());
                     } else {
                       wrapped.push_back(EncodableValue());
                     }
@@ -7670,8 +9561,9 @@ void HostIntegrationCoreApi::SetUp(::flutter::BinaryMessenger* binary_messenger,
                       return;
                     }
                     EncodableList wrapped;
-                    wrapped.push_back(
-                        CustomEncodableValue(std::move(output).TakeValue()));
+                    wrapped.emplace_back();
+                    PigeonInternalSetCustomValue(std::move(output).TakeValue(),
+                                                 &wrapped.back());
                     reply(EncodableValue(std::move(wrapped)));
                   });
             } catch (const std::exception& exception) {
@@ -7713,8 +9605,9 @@ void HostIntegrationCoreApi::SetUp(::flutter::BinaryMessenger* binary_messenger,
                 EncodableList wrapped;
                 auto output_optional = std::move(output).TakeValue();
                 if (output_optional) {
-                  wrapped.push_back(
-                      CustomEncodableValue(std::move(output_optional).value()));
+                  wrapped.emplace_back();
+                  PigeonInternalSetCustomValue(
+                      std::move(output_optional).value(), &wrapped.back());
                 } else {
                   wrapped.push_back(EncodableValue());
                 }
@@ -7759,8 +9652,9 @@ void HostIntegrationCoreApi::SetUp(::flutter::BinaryMessenger* binary_messenger,
                       return;
                     }
                     EncodableList wrapped;
-                    wrapped.push_back(
-                        CustomEncodableValue(std::move(output).TakeValue()));
+                    wrapped.emplace_back();
+                    PigeonInternalSetCustomValue(std::move(output).TakeValue(),
+                                                 &wrapped.back());
                     reply(EncodableValue(std::move(wrapped)));
                   });
             } catch (const std::exception& exception) {
@@ -9528,14 +11422,18 @@ const ::flutter::StandardMessageCodec& FlutterIntegrationCoreApi::GetCodec() {
 void FlutterIntegrationCoreApi::Noop(
     std::function<void(void)>&& on_success,
     std::function<void(const FlutterError&)>&& on_error) {
-  const std::string channel_name =
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "noop" +
-      message_channel_suffix_;
-  BasicMessageChannel<> channel(binary_messenger_, channel_name, &GetCodec());
+  if (!noop_channel_) {
+    noop_channel_ = std::make_shared<PigeonInternalFlutterMethodChannel>(
+        binary_messenger_,
+        "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
+        "noop" +
+            message_channel_suffix_,
+        &GetCodec());
+  }
   EncodableValue encoded_api_arguments = EncodableValue();
-  channel.Send(
-      encoded_api_arguments, [channel_name, on_success = std::move(on_success),
+  noop_channel_->channel().Send(
+      encoded_api_arguments, [channel = noop_channel_,
+                              on_success = std::move(on_success),
                               on_error = std::move(on_error)](
                                  const uint8_t* reply, size_t reply_size) {
         std::unique_ptr<EncodableValue> response =
@@ -9553,7 +11451,7 @@ void FlutterIntegrationCoreApi::Noop(
             on_success();
           }
         } else {
-          on_error(CreateConnectionError(channel_name));
+          on_error(CreateConnectionError(channel->name()));
         }
       });
 }
@@ -9561,14 +11459,18 @@ void FlutterIntegrationCoreApi::Noop(
 void FlutterIntegrationCoreApi::ThrowError(
     std::function<void(const EncodableValue*)>&& on_success,
     std::function<void(const FlutterError&)>&& on_error) {
-  const std::string channel_name =
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "throwError" +
-      message_channel_suffix_;
-  BasicMessageChannel<> channel(binary_messenger_, channel_name, &GetCodec());
+  if (!throw_error_channel_) {
+    throw_error_channel_ = std::make_shared<PigeonInternalFlutterMethodChannel>(
+        binary_messenger_,
+        "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
+        "throwError" +
+            message_channel_suffix_,
+        &GetCodec());
+  }
   EncodableValue encoded_api_arguments = EncodableValue();
-  channel.Send(
-      encoded_api_arguments, [channel_name, on_success = std::move(on_success),
+  throw_error_channel_->channel().Send(
+      encoded_api_arguments, [channel = throw_error_channel_,
+                              on_success = std::move(on_success),
                               on_error = std::move(on_error)](
                                  const uint8_t* reply, size_t reply_size) {
         std::unique_ptr<EncodableValue> response =
@@ -9587,7 +11489,7 @@ void FlutterIntegrationCoreApi::ThrowError(
             on_success(return_value);
           }
         } else {
-          on_error(CreateConnectionError(channel_name));
+          on_error(CreateConnectionError(channel->name()));
         }
       });
 }
@@ -9595,14 +11497,19 @@ void FlutterIntegrationCoreApi::ThrowError(
 void FlutterIntegrationCoreApi::ThrowErrorFromVoid(
     std::function<void(void)>&& on_success,
     std::function<void(const FlutterError&)>&& on_error) {
-  const std::string channel_name =
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "throwErrorFromVoid" +
-      message_channel_suffix_;
-  BasicMessageChannel<> channel(binary_messenger_, channel_name, &GetCodec());
+  if (!throw_error_from_void_channel_) {
+    throw_error_from_void_channel_ =
+        std::make_shared<PigeonInternalFlutterMethodChannel>(
+            binary_messenger_,
+            "dev.flutter.pigeon.pigeon_integration_tests."
+            "FlutterIntegrationCoreApi.throwErrorFromVoid" +
+                message_channel_suffix_,
+            &GetCodec());
+  }
   EncodableValue encoded_api_arguments = EncodableValue();
-  channel.Send(
-      encoded_api_arguments, [channel_name, on_success = std::move(on_success),
+  throw_error_from_void_channel_->channel().Send(
+      encoded_api_arguments, [channel = throw_error_from_void_channel_,
+                              on_success = std::move(on_success),
                               on_error = std::move(on_error)](
                                  const uint8_t* reply, size_t reply_size) {
         std::unique_ptr<EncodableValue> response =
@@ -9620,7 +11527,7 @@ void FlutterIntegrationCoreApi::ThrowErrorFromVoid(
             on_success();
           }
         } else {
-          on_error(CreateConnectionError(channel_name));
+          on_error(CreateConnectionError(channel->name()));
         }
       });
 }
@@ -9629,16 +11536,21 @@ void FlutterIntegrationCoreApi::EchoAllTypes(
     const AllTypes& everything_arg,
     std::function<void(const AllTypes&)>&& on_success,
     std::function<void(const FlutterError&)>&& on_error) {
-  const std::string channel_name =
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoAllTypes" +
-      message_channel_suffix_;
-  BasicMessageChannel<> channel(binary_messenger_, channel_name, &GetCodec());
+  if (!echo_all_types_channel_) {
+    echo_all_types_channel_ =
+        std::make_shared<PigeonInternalFlutterMethodChannel>(
+            binary_messenger_,
+            "dev.flutter.pigeon.pigeon_integration_tests."
+            "FlutterIntegrationCoreApi.echoAllTypes" +
+                message_channel_suffix_,
+            &GetCodec());
+  }
   EncodableValue encoded_api_arguments = EncodableValue(EncodableList{
       CustomEncodableValue(everything_arg),
   });
-  channel.Send(
-      encoded_api_arguments, [channel_name, on_success = std::move(on_success),
+  echo_all_types_channel_->channel().Send(
+      encoded_api_arguments, [channel = echo_all_types_channel_,
+                              on_success = std::move(on_success),
                               on_error = std::move(on_error)](
                                  const uint8_t* reply, size_t reply_size) {
         std::unique_ptr<EncodableValue> response =
@@ -9658,7 +11570,7 @@ void FlutterIntegrationCoreApi::EchoAllTypes(
             on_success(return_value);
           }
         } else {
-          on_error(CreateConnectionError(channel_name));
+          on_error(CreateConnectionError(channel->name()));
         }
       });
 }
@@ -9667,16 +11579,21 @@ void FlutterIntegrationCoreApi::EchoAllNullableTypes(
     const AllNullableTypes* everything_arg,
     std::function<void(const AllNullableTypes*)>&& on_success,
     std::function<void(const FlutterError&)>&& on_error) {
-  const std::string channel_name =
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoAllNullableTypes" +
-      message_channel_suffix_;
-  BasicMessageChannel<> channel(binary_messenger_, channel_name, &GetCodec());
+  if (!echo_all_nullable_types_channel_) {
+    echo_all_nullable_types_channel_ =
+        std::make_shared<PigeonInternalFlutterMethodChannel>(
+            binary_messenger_,
+            "dev.flutter.pigeon.pigeon_integration_tests."
+            "FlutterIntegrationCoreApi.echoAllNullableTypes" +
+                message_channel_suffix_,
+            &GetCodec());
+  }
   EncodableValue encoded_api_arguments = EncodableValue(EncodableList{
       everything_arg ? CustomEncodableValue(*everything_arg) : EncodableValue(),
   });
-  channel.Send(
-      encoded_api_arguments, [channel_name, on_success = std::move(on_success),
+  echo_all_nullable_types_channel_->channel().Send(
+      encoded_api_arguments, [channel = echo_all_nullable_types_channel_,
+                              on_success = std::move(on_success),
                               on_error = std::move(on_error)](
                                  const uint8_t* reply, size_t reply_size) {
         std::unique_ptr<EncodableValue> response =
@@ -9700,7 +11617,7 @@ void FlutterIntegrationCoreApi::EchoAllNullableTypes(
             on_success(return_value);
           }
         } else {
-          on_error(CreateConnectionError(channel_name));
+          on_error(CreateConnectionError(channel->name()));
         }
       });
 }
@@ -9710,11 +11627,15 @@ void FlutterIntegrationCoreApi::SendMultipleNullableTypes(
     const std::string* a_nullable_string_arg,
     std::function<void(const AllNullableTypes&)>&& on_success,
     std::function<void(const FlutterError&)>&& on_error) {
-  const std::string channel_name =
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "sendMultipleNullableTypes" +
-      message_channel_suffix_;
-  BasicMessageChannel<> channel(binary_messenger_, channel_name, &GetCodec());
+  if (!send_multiple_nullable_types_channel_) {
+    send_multiple_nullable_types_channel_ =
+        std::make_shared<PigeonInternalFlutterMethodChannel>(
+            binary_messenger_,
+            "dev.flutter.pigeon.pigeon_integration_tests."
+            "FlutterIntegrationCoreApi.sendMultipleNullableTypes" +
+                message_channel_suffix_,
+            &GetCodec());
+  }
   EncodableValue encoded_api_arguments = EncodableValue(EncodableList{
       a_nullable_bool_arg ? EncodableValue(*a_nullable_bool_arg)
                           : EncodableValue(),
@@ -9723,8 +11644,9 @@ void FlutterIntegrationCoreApi::SendMultipleNullableTypes(
       a_nullable_string_arg ? EncodableValue(*a_nullable_string_arg)
                             : EncodableValue(),
   });
-  channel.Send(
-      encoded_api_arguments, [channel_name, on_success = std::move(on_success),
+  send_multiple_nullable_types_channel_->channel().Send(
+      encoded_api_arguments, [channel = send_multiple_nullable_types_channel_,
+                              on_success = std::move(on_success),
                               on_error = std::move(on_error)](
                                  const uint8_t* reply, size_t reply_size) {
         std::unique_ptr<EncodableValue> response =
@@ -9744,7 +11666,7 @@ void FlutterIntegrationCoreApi::SendMultipleNullableTypes(
             on_success(return_value);
           }
         } else {
-          on_error(CreateConnectionError(channel_name));
+          on_error(CreateConnectionError(channel->name()));
         }
       });
 }
@@ -9753,18 +11675,24 @@ void FlutterIntegrationCoreApi::EchoAllNullableTypesWithoutRecursion(
     const AllNullableTypesWithoutRecursion* everything_arg,
     std::function<void(const AllNullableTypesWithoutRecursion*)>&& on_success,
     std::function<void(const FlutterError&)>&& on_error) {
-  const std::string channel_name =
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoAllNullableTypesWithoutRecursion" +
-      message_channel_suffix_;
-  BasicMessageChannel<> channel(binary_messenger_, channel_name, &GetCodec());
+  if (!echo_all_nullable_types_without_recursion_channel_) {
+    echo_all_nullable_types_without_recursion_channel_ =
+        std::make_shared<PigeonInternalFlutterMethodChannel>(
+            binary_messenger_,
+            "dev.flutter.pigeon.pigeon_integration_tests."
+            "FlutterIntegrationCoreApi.echoAllNullableTypesWithoutRecursion" +
+                message_channel_suffix_,
+            &GetCodec());
+  }
   EncodableValue encoded_api_arguments = EncodableValue(EncodableList{
       everything_arg ? CustomEncodableValue(*everything_arg) : EncodableValue(),
   });
-  channel.Send(
-      encoded_api_arguments, [channel_name, on_success = std::move(on_success),
-                              on_error = std::move(on_error)](
-                                 const uint8_t* reply, size_t reply_size) {
+  echo_all_nullable_types_without_recursion_channel_->channel().Send(
+      encoded_api_arguments,
+      [channel = echo_all_nullable_types_without_recursion_channel_,
+       on_success = std::move(on_success),
+       on_error = std::move(on_error)](
+          const uint8_t* reply, size_t reply_size) {
         std::unique_ptr<EncodableValue> response =
             GetCodec().DecodeMessage(reply, reply_size);
         const auto& encodable_return_value = *response;
@@ -9786,7 +11714,7 @@ void FlutterIntegrationCoreApi::EchoAllNullableTypesWithoutRecursion(
             on_success(return_value);
           }
         } else {
-          on_error(CreateConnectionError(channel_name));
+          on_error(CreateConnectionError(channel->name()));
         }
       });
 }
@@ -9796,11 +11724,16 @@ void FlutterIntegrationCoreApi::SendMultipleNullableTypesWithoutRecursion(
     const std::string* a_nullable_string_arg,
     std::function<void(const AllNullableTypesWithoutRecursion&)>&& on_success,
     std::function<void(const FlutterError&)>&& on_error) {
-  const std::string channel_name =
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "sendMultipleNullableTypesWithoutRecursion" +
-      message_channel_suffix_;
-  BasicMessageChannel<> channel(binary_messenger_, channel_name, &GetCodec());
+  if (!send_multiple_nullable_types_without_recursion_channel_) {
+    send_multiple_nullable_types_without_recursion_channel_ =
+        std::make_shared<PigeonInternalFlutterMethodChannel>(
+            binary_messenger_,
+            "dev.flutter.pigeon.pigeon_integration_tests."
+            "FlutterIntegrationCoreApi."
+            "sendMultipleNullableTypesWithoutRecursion" +
+                message_channel_suffix_,
+            &GetCodec());
+  }
   EncodableValue encoded_api_arguments = EncodableValue(EncodableList{
       a_nullable_bool_arg ? EncodableValue(*a_nullable_bool_arg)
                           : EncodableValue(),
@@ -9809,10 +11742,12 @@ void FlutterIntegrationCoreApi::SendMultipleNullableTypesWithoutRecursion(
       a_nullable_string_arg ? EncodableValue(*a_nullable_string_arg)
                             : EncodableValue(),
   });
-  channel.Send(
-      encoded_api_arguments, [channel_name, on_success = std::move(on_success),
-                              on_error = std::move(on_error)](
-                                 const uint8_t* reply, size_t reply_size) {
+  send_multiple_nullable_types_without_recursion_channel_->channel().Send(
+      encoded_api_arguments,
+      [channel = send_multiple_nullable_types_without_recursion_channel_,
+       on_success = std::move(on_success),
+       on_error = std::move(on_error)](
+          const uint8_t* reply, size_t reply_size) {
         std::unique_ptr<EncodableValue> response =
             GetCodec().DecodeMessage(reply, reply_size);
         const auto& encodable_return_value = *response;
@@ -9831,7 +11766,7 @@ void FlutterIntegrationCoreApi::SendMultipleNullableTypesWithoutRecursion(
             on_success(return_value);
           }
         } else {
-          on_error(CreateConnectionError(channel_name));
+          on_error(CreateConnectionError(channel->name()));
         }
       });
 }
@@ -9839,16 +11774,20 @@ void FlutterIntegrationCoreApi::SendMultipleNullableTypesWithoutRecursion(
 void FlutterIntegrationCoreApi::EchoBool(
     bool a_bool_arg, std::function<void(bool)>&& on_success,
     std::function<void(const FlutterError&)>&& on_error) {
-  const std::string channel_name =
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoBool" +
-      message_channel_suffix_;
-  BasicMessageChannel<> channel(binary_messenger_, channel_name, &GetCodec());
+  if (!echo_bool_channel_) {
+    echo_bool_channel_ = std::make_shared<PigeonInternalFlutterMethodChannel>(
+        binary_messenger_,
+        "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
+        "echoBool" +
+            message_channel_suffix_,
+        &GetCodec());
+  }
   EncodableValue encoded_api_arguments = EncodableValue(EncodableList{
       EncodableValue(a_bool_arg),
   });
-  channel.Send(
-      encoded_api_arguments, [channel_name, on_success = std::move(on_success),
+  echo_bool_channel_->channel().Send(
+      encoded_api_arguments, [channel = echo_bool_channel_,
+                              on_success = std::move(on_success),
                               on_error = std::move(on_error)](
                                  const uint8_t* reply, size_t reply_size) {
         std::unique_ptr<EncodableValue> response =
@@ -9867,7 +11806,7 @@ void FlutterIntegrationCoreApi::EchoBool(
             on_success(return_value);
           }
         } else {
-          on_error(CreateConnectionError(channel_name));
+          on_error(CreateConnectionError(channel->name()));
         }
       });
 }
@@ -9875,16 +11814,20 @@ void FlutterIntegrationCoreApi::EchoBool(
 void FlutterIntegrationCoreApi::EchoInt(
     int64_t an_int_arg, std::function<void(int64_t)>&& on_success,
     std::function<void(const FlutterError&)>&& on_error) {
-  const std::string channel_name =
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoInt" +
-      message_channel_suffix_;
-  BasicMessageChannel<> channel(binary_messenger_, channel_name, &GetCodec());
+  if (!echo_int_channel_) {
+    echo_int_channel_ = std::make_shared<PigeonInternalFlutterMethodChannel>(
+        binary_messenger_,
+        "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
+        "echoInt" +
+            message_channel_suffix_,
+        &GetCodec());
+  }
   EncodableValue encoded_api_arguments = EncodableValue(EncodableList{
       EncodableValue(an_int_arg),
   });
-  channel.Send(
-      encoded_api_arguments, [channel_name, on_success = std::move(on_success),
+  echo_int_channel_->channel().Send(
+      encoded_api_arguments, [channel = echo_int_channel_,
+                              on_success = std::move(on_success),
                               on_error = std::move(on_error)](
                                  const uint8_t* reply, size_t reply_size) {
         std::unique_ptr<EncodableValue> response =
@@ -9903,7 +11846,7 @@ void FlutterIntegrationCoreApi::EchoInt(
             on_success(return_value);
           }
         } else {
-          on_error(CreateConnectionError(channel_name));
+          on_error(CreateConnectionError(channel->name()));
         }
       });
 }
@@ -9911,53 +11854,62 @@ void FlutterIntegrationCoreApi::EchoInt(
 void FlutterIntegrationCoreApi::EchoDouble(
     double a_double_arg, std::function<void(double)>&& on_success,
     std::function<void(const FlutterError&)>&& on_error) {
-  const std::string channel_name =
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoDouble" +
-      message_channel_suffix_;
-  BasicMessageChannel<> channel(binary_messenger_, channel_name, &GetCodec());
+  if (!echo_double_channel_) {
+    echo_double_channel_ = std::make_shared<PigeonInternalFlutterMethodChannel>(
+        binary_messenger_,
+        "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
+        "echoDouble" +
+            message_channel_suffix_,
+        &GetCodec());
+  }
   EncodableValue encoded_api_arguments = EncodableValue(EncodableList{
       EncodableValue(a_double_arg),
   });
-  channel.Send(encoded_api_arguments, [channel_name,
-                                       on_success = std::move(on_success),
-                                       on_error = std::move(on_error)](
-                                          const uint8_t* reply,
-                                          size_t reply_size) {
-    std::unique_ptr<EncodableValue> response =
-        GetCodec().DecodeMessage(reply, reply_size);
-    const auto& encodable_return_value = *response;
-    const auto* list_return_value =
-        std::get_if<EncodableList>(&encodable_return_value);
-    if (list_return_value) {
-      if (list_return_value->size() > 1) {
-        on_error(FlutterError(std::get<std::string>(list_return_value->at(0)),
-                              std::get<std::string>(list_return_value->at(1)),
-                              list_return_value->at(2)));
-      } else {
-        const auto& return_value = std::get<double>(list_return_value->at(0));
-        on_success(return_value);
-      }
-    } else {
-      on_error(CreateConnectionError(channel_name));
-    }
-  });
+  echo_double_channel_->channel().Send(
+      encoded_api_arguments, [channel = echo_double_channel_,
+                              on_success = std::move(on_success),
+                              on_error = std::move(on_error)](
+                                 const uint8_t* reply, size_t reply_size) {
+        std::unique_ptr<EncodableValue> response =
+            GetCodec().DecodeMessage(reply, reply_size);
+        const auto& encodable_return_value = *response;
+        const auto* list_return_value =
+            std::get_if<EncodableList>(&encodable_return_value);
+        if (list_return_value) {
+          if (list_return_value->size() > 1) {
+            on_error(
+                FlutterError(std::get<std::string>(list_return_value->at(0)),
+                             std::get<std::string>(list_return_value->at(1)),
+                             list_return_value->at(2)));
+          } else {
+            const auto& return_value =
+                std::get<double>(list_return_value->at(0));
+            on_success(return_value);
+          }
+        } else {
+          on_error(CreateConnectionError(channel->name()));
+        }
+      });
 }
 
 void FlutterIntegrationCoreApi::EchoString(
     const std::string& a_string_arg,
     std::function<void(const std::string&)>&& on_success,
     std::function<void(const FlutterError&)>&& on_error) {
-  const std::string channel_name =
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoString" +
-      message_channel_suffix_;
-  BasicMessageChannel<> channel(binary_messenger_, channel_name, &GetCodec());
+  if (!echo_string_channel_) {
+    echo_string_channel_ = std::make_shared<PigeonInternalFlutterMethodChannel>(
+        binary_messenger_,
+        "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
+        "echoString" +
+            message_channel_suffix_,
+        &GetCodec());
+  }
   EncodableValue encoded_api_arguments = EncodableValue(EncodableList{
       EncodableValue(a_string_arg),
   });
-  channel.Send(
-      encoded_api_arguments, [channel_name, on_success = std::move(on_success),
+  echo_string_channel_->channel().Send(
+      encoded_api_arguments, [channel = echo_string_channel_,
+                              on_success = std::move(on_success),
                               on_error = std::move(on_error)](
                                  const uint8_t* reply, size_t reply_size) {
         std::unique_ptr<EncodableValue> response =
@@ -9977,7 +11929,7 @@ void FlutterIntegrationCoreApi::EchoString(
             on_success(return_value);
           }
         } else {
-          on_error(CreateConnectionError(channel_name));
+          on_error(CreateConnectionError(channel->name()));
         }
       });
 }
@@ -9986,16 +11938,21 @@ void FlutterIntegrationCoreApi::EchoUint8List(
     const std::vector<uint8_t>& list_arg,
     std::function<void(const std::vector<uint8_t>&)>&& on_success,
     std::function<void(const FlutterError&)>&& on_error) {
-  const std::string channel_name =
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoUint8List" +
-      message_channel_suffix_;
-  BasicMessageChannel<> channel(binary_messenger_, channel_name, &GetCodec());
+  if (!echo_uint8_list_channel_) {
+    echo_uint8_list_channel_ =
+        std::make_shared<PigeonInternalFlutterMethodChannel>(
+            binary_messenger_,
+            "dev.flutter.pigeon.pigeon_integration_tests."
+            "FlutterIntegrationCoreApi.echoUint8List" +
+                message_channel_suffix_,
+            &GetCodec());
+  }
   EncodableValue encoded_api_arguments = EncodableValue(EncodableList{
       EncodableValue(list_arg),
   });
-  channel.Send(
-      encoded_api_arguments, [channel_name, on_success = std::move(on_success),
+  echo_uint8_list_channel_->channel().Send(
+      encoded_api_arguments, [channel = echo_uint8_list_channel_,
+                              on_success = std::move(on_success),
                               on_error = std::move(on_error)](
                                  const uint8_t* reply, size_t reply_size) {
         std::unique_ptr<EncodableValue> response =
@@ -10015,7 +11972,7 @@ void FlutterIntegrationCoreApi::EchoUint8List(
             on_success(return_value);
           }
         } else {
-          on_error(CreateConnectionError(channel_name));
+          on_error(CreateConnectionError(channel->name()));
         }
       });
 }
@@ -10024,16 +11981,20 @@ void FlutterIntegrationCoreApi::EchoList(
     const EncodableList& list_arg,
     std::function<void(const EncodableList&)>&& on_success,
     std::function<void(const FlutterError&)>&& on_error) {
-  const std::string channel_name =
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoList" +
-      message_channel_suffix_;
-  BasicMessageChannel<> channel(binary_messenger_, channel_name, &GetCodec());
+  if (!echo_list_channel_) {
+    echo_list_channel_ = std::make_shared<PigeonInternalFlutterMethodChannel>(
+        binary_messenger_,
+        "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
+        "echoList" +
+            message_channel_suffix_,
+        &GetCodec());
+  }
   EncodableValue encoded_api_arguments = EncodableValue(EncodableList{
       EncodableValue(list_arg),
   });
-  channel.Send(
-      encoded_api_arguments, [channel_name, on_success = std::move(on_success),
+  echo_list_channel_->channel().Send(
+      encoded_api_arguments, [channel = echo_list_channel_,
+                              on_success = std::move(on_success),
                               on_error = std::move(on_error)](
                                  const uint8_t* reply, size_t reply_size) {
         std::unique_ptr<EncodableValue> response =
@@ -10053,7 +12014,7 @@ void FlutterIntegrationCoreApi::EchoList(
             on_success(return_value);
           }
         } else {
-          on_error(CreateConnectionError(channel_name));
+          on_error(CreateConnectionError(channel->name()));
         }
       });
 }
@@ -10062,16 +12023,21 @@ void FlutterIntegrationCoreApi::EchoEnumList(
     const EncodableList& enum_list_arg,
     std::function<void(const EncodableList&)>&& on_success,
     std::function<void(const FlutterError&)>&& on_error) {
-  const std::string channel_name =
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoEnumList" +
-      message_channel_suffix_;
-  BasicMessageChannel<> channel(binary_messenger_, channel_name, &GetCodec());
+  if (!echo_enum_list_channel_) {
+    echo_enum_list_channel_ =
+        std::make_shared<PigeonInternalFlutterMethodChannel>(
+            binary_messenger_,
+            "dev.flutter.pigeon.pigeon_integration_tests."
+            "FlutterIntegrationCoreApi.echoEnumList" +
+                message_channel_suffix_,
+            &GetCodec());
+  }
   EncodableValue encoded_api_arguments = EncodableValue(EncodableList{
       EncodableValue(enum_list_arg),
   });
-  channel.Send(
-      encoded_api_arguments, [channel_name, on_success = std::move(on_success),
+  echo_enum_list_channel_->channel().Send(
+      encoded_api_arguments, [channel = echo_enum_list_channel_,
+                              on_success = std::move(on_success),
                               on_error = std::move(on_error)](
                                  const uint8_t* reply, size_t reply_size) {
         std::unique_ptr<EncodableValue> response =
@@ -10091,7 +12057,7 @@ void FlutterIntegrationCoreApi::EchoEnumList(
             on_success(return_value);
           }
         } else {
-          on_error(CreateConnectionError(channel_name));
+          on_error(CreateConnectionError(channel->name()));
         }
       });
 }
@@ -10100,16 +12066,21 @@ void FlutterIntegrationCoreApi::EchoClassList(
     const EncodableList& class_list_arg,
     std::function<void(const EncodableList&)>&& on_success,
     std::function<void(const FlutterError&)>&& on_error) {
-  const std::string channel_name =
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoClassList" +
-      message_channel_suffix_;
-  BasicMessageChannel<> channel(binary_messenger_, channel_name, &GetCodec());
+  if (!echo_class_list_channel_) {
+    echo_class_list_channel_ =
+        std::make_shared<PigeonInternalFlutterMethodChannel>(
+            binary_messenger_,
+            "dev.flutter.pigeon.pigeon_integration_tests."
+            "FlutterIntegrationCoreApi.echoClassList" +
+                message_channel_suffix_,
+            &GetCodec());
+  }
   EncodableValue encoded_api_arguments = EncodableValue(EncodableList{
       EncodableValue(class_list_arg),
   });
-  channel.Send(
-      encoded_api_arguments, [channel_name, on_success = std::move(on_success),
+  echo_class_list_channel_->channel().Send(
+      encoded_api_arguments, [channel = echo_class_list_channel_,
+                              on_success = std::move(on_success),
                               on_error = std::move(on_error)](
                                  const uint8_t* reply, size_t reply_size) {
         std::unique_ptr<EncodableValue> response =
@@ -10129,7 +12100,7 @@ void FlutterIntegrationCoreApi::EchoClassList(
             on_success(return_value);
           }
         } else {
-          on_error(CreateConnectionError(channel_name));
+          on_error(CreateConnectionError(channel->name()));
         }
       });
 }
@@ -10138,16 +12109,21 @@ void FlutterIntegrationCoreApi::EchoNonNullEnumList(
     const EncodableList& enum_list_arg,
     std::function<void(const EncodableList&)>&& on_success,
     std::function<void(const FlutterError&)>&& on_error) {
-  const std::string channel_name =
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoNonNullEnumList" +
-      message_channel_suffix_;
-  BasicMessageChannel<> channel(binary_messenger_, channel_name, &GetCodec());
+  if (!echo_non_null_enum_list_channel_) {
+    echo_non_null_enum_list_channel_ =
+        std::make_shared<PigeonInternalFlutterMethodChannel>(
+            binary_messenger_,
+            "dev.flutter.pigeon.pigeon_integration_tests."
+            "FlutterIntegrationCoreApi.echoNonNullEnumList" +
+                message_channel_suffix_,
+            &GetCodec());
+  }
   EncodableValue encoded_api_arguments = EncodableValue(EncodableList{
       EncodableValue(enum_list_arg),
   });
-  channel.Send(
-      encoded_api_arguments, [channel_name, on_success = std::move(on_success),
+  echo_non_null_enum_list_channel_->channel().Send(
+      encoded_api_arguments, [channel = echo_non_null_enum_list_channel_,
+                              on_success = std::move(on_success),
                               on_error = std::move(on_error)](
                                  const uint8_t* reply, size_t reply_size) {
         std::unique_ptr<EncodableValue> response =
@@ -10167,7 +12143,7 @@ void FlutterIntegrationCoreApi::EchoNonNullEnumList(
             on_success(return_value);
           }
         } else {
-          on_error(CreateConnectionError(channel_name));
+          on_error(CreateConnectionError(channel->name()));
         }
       });
 }
@@ -10176,16 +12152,21 @@ void FlutterIntegrationCoreApi::EchoNonNullClassList(
     const EncodableList& class_list_arg,
     std::function<void(const EncodableList&)>&& on_success,
     std::function<void(const FlutterError&)>&& on_error) {
-  const std::string channel_name =
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoNonNullClassList" +
-      message_channel_suffix_;
-  BasicMessageChannel<> channel(binary_messenger_, channel_name, &GetCodec());
+  if (!echo_non_null_class_list_channel_) {
+    echo_non_null_class_list_channel_ =
+        std::make_shared<PigeonInternalFlutterMethodChannel>(
+            binary_messenger_,
+            "dev.flutter.pigeon.pigeon_integration_tests."
+            "FlutterIntegrationCoreApi.echoNonNullClassList" +
+                message_channel_suffix_,
+            &GetCodec());
+  }
   EncodableValue encoded_api_arguments = EncodableValue(EncodableList{
       EncodableValue(class_list_arg),
   });
-  channel.Send(
-      encoded_api_arguments, [channel_name, on_success = std::move(on_success),
+  echo_non_null_class_list_channel_->channel().Send(
+      encoded_api_arguments, [channel = echo_non_null_class_list_channel_,
+                              on_success = std::move(on_success),
                               on_error = std::move(on_error)](
                                  const uint8_t* reply, size_t reply_size) {
         std::unique_ptr<EncodableValue> response =
@@ -10205,7 +12186,7 @@ void FlutterIntegrationCoreApi::EchoNonNullClassList(
             on_success(return_value);
           }
         } else {
-          on_error(CreateConnectionError(channel_name));
+          on_error(CreateConnectionError(channel->name()));
         }
       });
 }
@@ -10214,16 +12195,20 @@ void FlutterIntegrationCoreApi::EchoMap(
     const EncodableMap& map_arg,
     std::function<void(const EncodableMap&)>&& on_success,
     std::function<void(const FlutterError&)>&& on_error) {
-  const std::string channel_name =
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoMap" +
-      message_channel_suffix_;
-  BasicMessageChannel<> channel(binary_messenger_, channel_name, &GetCodec());
+  if (!echo_map_channel_) {
+    echo_map_channel_ = std::make_shared<PigeonInternalFlutterMethodChannel>(
+        binary_messenger_,
+        "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
+        "echoMap" +
+            message_channel_suffix_,
+        &GetCodec());
+  }
   EncodableValue encoded_api_arguments = EncodableValue(EncodableList{
       EncodableValue(map_arg),
   });
-  channel.Send(
-      encoded_api_arguments, [channel_name, on_success = std::move(on_success),
+  echo_map_channel_->channel().Send(
+      encoded_api_arguments, [channel = echo_map_channel_,
+                              on_success = std::move(on_success),
                               on_error = std::move(on_error)](
                                  const uint8_t* reply, size_t reply_size) {
         std::unique_ptr<EncodableValue> response =
@@ -10243,7 +12228,7 @@ void FlutterIntegrationCoreApi::EchoMap(
             on_success(return_value);
           }
         } else {
-          on_error(CreateConnectionError(channel_name));
+          on_error(CreateConnectionError(channel->name()));
         }
       });
 }
@@ -10252,16 +12237,21 @@ void FlutterIntegrationCoreApi::EchoStringMap(
     const EncodableMap& string_map_arg,
     std::function<void(const EncodableMap&)>&& on_success,
     std::function<void(const FlutterError&)>&& on_error) {
-  const std::string channel_name =
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoStringMap" +
-      message_channel_suffix_;
-  BasicMessageChannel<> channel(binary_messenger_, channel_name, &GetCodec());
+  if (!echo_string_map_channel_) {
+    echo_string_map_channel_ =
+        std::make_shared<PigeonInternalFlutterMethodChannel>(
+            binary_messenger_,
+            "dev.flutter.pigeon.pigeon_integration_tests."
+            "FlutterIntegrationCoreApi.echoStringMap" +
+                message_channel_suffix_,
+            &GetCodec());
+  }
   EncodableValue encoded_api_arguments = EncodableValue(EncodableList{
       EncodableValue(string_map_arg),
   });
-  channel.Send(
-      encoded_api_arguments, [channel_name, on_success = std::move(on_success),
+  echo_string_map_channel_->channel().Send(
+      encoded_api_arguments, [channel = echo_string_map_channel_,
+                              on_success = std::move(on_success),
                               on_error = std::move(on_error)](
                                  const uint8_t* reply, size_t reply_size) {
         std::unique_ptr<EncodableValue> response =
@@ -10281,7 +12271,7 @@ void FlutterIntegrationCoreApi::EchoStringMap(
             on_success(return_value);
           }
         } else {
-          on_error(CreateConnectionError(channel_name));
+          on_error(CreateConnectionError(channel->name()));
         }
       });
 }
@@ -10290,16 +12280,21 @@ void FlutterIntegrationCoreApi::EchoIntMap(
     const EncodableMap& int_map_arg,
     std::function<void(const EncodableMap&)>&& on_success,
     std::function<void(const FlutterError&)>&& on_error) {
-  const std::string channel_name =
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoIntMap" +
-      message_channel_suffix_;
-  BasicMessageChannel<> channel(binary_messenger_, channel_name, &GetCodec());
+  if (!echo_int_map_channel_) {
+    echo_int_map_channel_ =
+        std::make_shared<PigeonInternalFlutterMethodChannel>(
+            binary_messenger_,
+            "dev.flutter.pigeon.pigeon_integration_tests."
+            "FlutterIntegrationCoreApi.echoIntMap" +
+                message_channel_suffix_,
+            &GetCodec());
+  }
   EncodableValue encoded_api_arguments = EncodableValue(EncodableList{
       EncodableValue(int_map_arg),
   });
-  channel.Send(
-      encoded_api_arguments, [channel_name, on_success = std::move(on_success),
+  echo_int_map_channel_->channel().Send(
+      encoded_api_arguments, [channel = echo_int_map_channel_,
+                              on_success = std::move(on_success),
                               on_error = std::move(on_error)](
                                  const uint8_t* reply, size_t reply_size) {
         std::unique_ptr<EncodableValue> response =
@@ -10319,7 +12314,7 @@ void FlutterIntegrationCoreApi::EchoIntMap(
             on_success(return_value);
           }
         } else {
-          on_error(CreateConnectionError(channel_name));
+          on_error(CreateConnectionError(channel->name()));
         }
       });
 }
@@ -10328,16 +12323,21 @@ void FlutterIntegrationCoreApi::EchoEnumMap(
     const EncodableMap& enum_map_arg,
     std::function<void(const EncodableMap&)>&& on_success,
     std::function<void(const FlutterError&)>&& on_error) {
-  const std::string channel_name =
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoEnumMap" +
-      message_channel_suffix_;
-  BasicMessageChannel<> channel(binary_messenger_, channel_name, &GetCodec());
+  if (!echo_enum_map_channel_) {
+    echo_enum_map_channel_ =
+        std::make_shared<PigeonInternalFlutterMethodChannel>(
+            binary_messenger_,
+            "dev.flutter.pigeon.pigeon_integration_tests."
+            "FlutterIntegrationCoreApi.echoEnumMap" +
+                message_channel_suffix_,
+            &GetCodec());
+  }
   EncodableValue encoded_api_arguments = EncodableValue(EncodableList{
       EncodableValue(enum_map_arg),
   });
-  channel.Send(
-      encoded_api_arguments, [channel_name, on_success = std::move(on_success),
+  echo_enum_map_channel_->channel().Send(
+      encoded_api_arguments, [channel = echo_enum_map_channel_,
+                              on_success = std::move(on_success),
                               on_error = std::move(on_error)](
                                  const uint8_t* reply, size_t reply_size) {
         std::unique_ptr<EncodableValue> response =
@@ -10357,7 +12357,7 @@ void FlutterIntegrationCoreApi::EchoEnumMap(
             on_success(return_value);
           }
         } else {
-          on_error(CreateConnectionError(channel_name));
+          on_error(CreateConnectionError(channel->name()));
         }
       });
 }
@@ -10366,16 +12366,21 @@ void FlutterIntegrationCoreApi::EchoClassMap(
     const EncodableMap& class_map_arg,
     std::function<void(const EncodableMap&)>&& on_success,
     std::function<void(const FlutterError&)>&& on_error) {
-  const std::string channel_name =
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoClassMap" +
-      message_channel_suffix_;
-  BasicMessageChannel<> channel(binary_messenger_, channel_name, &GetCodec());
+  if (!echo_class_map_channel_) {
+    echo_class_map_channel_ =
+        std::make_shared<PigeonInternalFlutterMethodChannel>(
+            binary_messenger_,
+            "dev.flutter.pigeon.pigeon_integration_tests."
+            "FlutterIntegrationCoreApi.echoClassMap" +
+                message_channel_suffix_,
+            &GetCodec());
+  }
   EncodableValue encoded_api_arguments = EncodableValue(EncodableList{
       EncodableValue(class_map_arg),
   });
-  channel.Send(
-      encoded_api_arguments, [channel_name, on_success = std::move(on_success),
+  echo_class_map_channel_->channel().Send(
+      encoded_api_arguments, [channel = echo_class_map_channel_,
+                              on_success = std::move(on_success),
                               on_error = std::move(on_error)](
                                  const uint8_t* reply, size_t reply_size) {
         std::unique_ptr<EncodableValue> response =
@@ -10395,7 +12400,7 @@ void FlutterIntegrationCoreApi::EchoClassMap(
             on_success(return_value);
           }
         } else {
-          on_error(CreateConnectionError(channel_name));
+          on_error(CreateConnectionError(channel->name()));
         }
       });
 }
@@ -10404,16 +12409,21 @@ void FlutterIntegrationCoreApi::EchoNonNullStringMap(
     const EncodableMap& string_map_arg,
     std::function<void(const EncodableMap&)>&& on_success,
     std::function<void(const FlutterError&)>&& on_error) {
-  const std::string channel_name =
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoNonNullStringMap" +
-      message_channel_suffix_;
-  BasicMessageChannel<> channel(binary_messenger_, channel_name, &GetCodec());
+  if (!echo_non_null_string_map_channel_) {
+    echo_non_null_string_map_channel_ =
+        std::make_shared<PigeonInternalFlutterMethodChannel>(
+            binary_messenger_,
+            "dev.flutter.pigeon.pigeon_integration_tests."
+            "FlutterIntegrationCoreApi.echoNonNullStringMap" +
+                message_channel_suffix_,
+            &GetCodec());
+  }
   EncodableValue encoded_api_arguments = EncodableValue(EncodableList{
       EncodableValue(string_map_arg),
   });
-  channel.Send(
-      encoded_api_arguments, [channel_name, on_success = std::move(on_success),
+  echo_non_null_string_map_channel_->channel().Send(
+      encoded_api_arguments, [channel = echo_non_null_string_map_channel_,
+                              on_success = std::move(on_success),
                               on_error = std::move(on_error)](
                                  const uint8_t* reply, size_t reply_size) {
         std::unique_ptr<EncodableValue> response =
@@ -10433,7 +12443,7 @@ void FlutterIntegrationCoreApi::EchoNonNullStringMap(
             on_success(return_value);
           }
         } else {
-          on_error(CreateConnectionError(channel_name));
+          on_error(CreateConnectionError(channel->name()));
         }
       });
 }
@@ -10442,16 +12452,21 @@ void FlutterIntegrationCoreApi::EchoNonNullIntMap(
     const EncodableMap& int_map_arg,
     std::function<void(const EncodableMap&)>&& on_success,
     std::function<void(const FlutterError&)>&& on_error) {
-  const std::string channel_name =
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoNonNullIntMap" +
-      message_channel_suffix_;
-  BasicMessageChannel<> channel(binary_messenger_, channel_name, &GetCodec());
+  if (!echo_non_null_int_map_channel_) {
+    echo_non_null_int_map_channel_ =
+        std::make_shared<PigeonInternalFlutterMethodChannel>(
+            binary_messenger_,
+            "dev.flutter.pigeon.pigeon_integration_tests."
+            "FlutterIntegrationCoreApi.echoNonNullIntMap" +
+                message_channel_suffix_,
+            &GetCodec());
+  }
   EncodableValue encoded_api_arguments = EncodableValue(EncodableList{
       EncodableValue(int_map_arg),
   });
-  channel.Send(
-      encoded_api_arguments, [channel_name, on_success = std::move(on_success),
+  echo_non_null_int_map_channel_->channel().Send(
+      encoded_api_arguments, [channel = echo_non_null_int_map_channel_,
+                              on_success = std::move(on_success),
                               on_error = std::move(on_error)](
                                  const uint8_t* reply, size_t reply_size) {
         std::unique_ptr<EncodableValue> response =
@@ -10471,7 +12486,7 @@ void FlutterIntegrationCoreApi::EchoNonNullIntMap(
             on_success(return_value);
           }
         } else {
-          on_error(CreateConnectionError(channel_name));
+          on_error(CreateConnectionError(channel->name()));
         }
       });
 }
@@ -10480,16 +12495,21 @@ void FlutterIntegrationCoreApi::EchoNonNullEnumMap(
     const EncodableMap& enum_map_arg,
     std::function<void(const EncodableMap&)>&& on_success,
     std::function<void(const FlutterError&)>&& on_error) {
-  const std::string channel_name =
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoNonNullEnumMap" +
-      message_channel_suffix_;
-  BasicMessageChannel<> channel(binary_messenger_, channel_name, &GetCodec());
+  if (!echo_non_null_enum_map_channel_) {
+    echo_non_null_enum_map_channel_ =
+        std::make_shared<PigeonInternalFlutterMethodChannel>(
+            binary_messenger_,
+            "dev.flutter.pigeon.pigeon_integration_tests."
+            "FlutterIntegrationCoreApi.echoNonNullEnumMap" +
+                message_channel_suffix_,
+            &GetCodec());
+  }
   EncodableValue encoded_api_arguments = EncodableValue(EncodableList{
       EncodableValue(enum_map_arg),
   });
-  channel.Send(
-      encoded_api_arguments, [channel_name, on_success = std::move(on_success),
+  echo_non_null_enum_map_channel_->channel().Send(
+      encoded_api_arguments, [channel = echo_non_null_enum_map_channel_,
+                              on_success = std::move(on_success),
                               on_error = std::move(on_error)](
                                  const uint8_t* reply, size_t reply_size) {
         std::unique_ptr<EncodableValue> response =
@@ -10509,7 +12529,7 @@ void FlutterIntegrationCoreApi::EchoNonNullEnumMap(
             on_success(return_value);
           }
         } else {
-          on_error(CreateConnectionError(channel_name));
+          on_error(CreateConnectionError(channel->name()));
         }
       });
 }
@@ -10518,16 +12538,21 @@ void FlutterIntegrationCoreApi::EchoNonNullClassMap(
     const EncodableMap& class_map_arg,
     std::function<void(const EncodableMap&)>&& on_success,
     std::function<void(const FlutterError&)>&& on_error) {
-  const std::string channel_name =
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoNonNullClassMap" +
-      message_channel_suffix_;
-  BasicMessageChannel<> channel(binary_messenger_, channel_name, &GetCodec());
+  if (!echo_non_null_class_map_channel_) {
+    echo_non_null_class_map_channel_ =
+        std::make_shared<PigeonInternalFlutterMethodChannel>(
+            binary_messenger_,
+            "dev.flutter.pigeon.pigeon_integration_tests."
+            "FlutterIntegrationCoreApi.echoNonNullClassMap" +
+                message_channel_suffix_,
+            &GetCodec());
+  }
   EncodableValue encoded_api_arguments = EncodableValue(EncodableList{
       EncodableValue(class_map_arg),
   });
-  channel.Send(
-      encoded_api_arguments, [channel_name, on_success = std::move(on_success),
+  echo_non_null_class_map_channel_->channel().Send(
+      encoded_api_arguments, [channel = echo_non_null_class_map_channel_,
+                              on_success = std::move(on_success),
                               on_error = std::move(on_error)](
                                  const uint8_t* reply, size_t reply_size) {
         std::unique_ptr<EncodableValue> response =
@@ -10547,7 +12572,7 @@ void FlutterIntegrationCoreApi::EchoNonNullClassMap(
             on_success(return_value);
           }
         } else {
-          on_error(CreateConnectionError(channel_name));
+          on_error(CreateConnectionError(channel->name()));
         }
       });
 }
@@ -10555,16 +12580,20 @@ void FlutterIntegrationCoreApi::EchoNonNullClassMap(
 void FlutterIntegrationCoreApi::EchoEnum(
     const AnEnum& an_enum_arg, std::function<void(const AnEnum&)>&& on_success,
     std::function<void(const FlutterError&)>&& on_error) {
-  const std::string channel_name =
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoEnum" +
-      message_channel_suffix_;
-  BasicMessageChannel<> channel(binary_messenger_, channel_name, &GetCodec());
+  if (!echo_enum_channel_) {
+    echo_enum_channel_ = std::make_shared<PigeonInternalFlutterMethodChannel>(
+        binary_messenger_,
+        "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
+        "echoEnum" +
+            message_channel_suffix_,
+        &GetCodec());
+  }
   EncodableValue encoded_api_arguments = EncodableValue(EncodableList{
       CustomEncodableValue(an_enum_arg),
   });
-  channel.Send(
-      encoded_api_arguments, [channel_name, on_success = std::move(on_success),
+  echo_enum_channel_->channel().Send(
+      encoded_api_arguments, [channel = echo_enum_channel_,
+                              on_success = std::move(on_success),
                               on_error = std::move(on_error)](
                                  const uint8_t* reply, size_t reply_size) {
         std::unique_ptr<EncodableValue> response =
@@ -10584,7 +12613,7 @@ void FlutterIntegrationCoreApi::EchoEnum(
             on_success(return_value);
           }
         } else {
-          on_error(CreateConnectionError(channel_name));
+          on_error(CreateConnectionError(channel->name()));
         }
       });
 }
@@ -10593,16 +12622,21 @@ void FlutterIntegrationCoreApi::EchoAnotherEnum(
     const AnotherEnum& another_enum_arg,
     std::function<void(const AnotherEnum&)>&& on_success,
     std::function<void(const FlutterError&)>&& on_error) {
-  const std::string channel_name =
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoAnotherEnum" +
-      message_channel_suffix_;
-  BasicMessageChannel<> channel(binary_messenger_, channel_name, &GetCodec());
+  if (!echo_another_enum_channel_) {
+    echo_another_enum_channel_ =
+        std::make_shared<PigeonInternalFlutterMethodChannel>(
+            binary_messenger_,
+            "dev.flutter.pigeon.pigeon_integration_tests."
+            "FlutterIntegrationCoreApi.echoAnotherEnum" +
+                message_channel_suffix_,
+            &GetCodec());
+  }
   EncodableValue encoded_api_arguments = EncodableValue(EncodableList{
       CustomEncodableValue(another_enum_arg),
   });
-  channel.Send(
-      encoded_api_arguments, [channel_name, on_success = std::move(on_success),
+  echo_another_enum_channel_->channel().Send(
+      encoded_api_arguments, [channel = echo_another_enum_channel_,
+                              on_success = std::move(on_success),
                               on_error = std::move(on_error)](
                                  const uint8_t* reply, size_t reply_size) {
         std::unique_ptr<EncodableValue> response =
@@ -10622,7 +12656,7 @@ void FlutterIntegrationCoreApi::EchoAnotherEnum(
             on_success(return_value);
           }
         } else {
-          on_error(CreateConnectionError(channel_name));
+          on_error(CreateConnectionError(channel->name()));
         }
       });
 }
@@ -10630,52 +12664,63 @@ void FlutterIntegrationCoreApi::EchoAnotherEnum(
 void FlutterIntegrationCoreApi::EchoNullableBool(
     const bool* a_bool_arg, std::function<void(const bool*)>&& on_success,
     std::function<void(const FlutterError&)>&& on_error) {
-  const std::string channel_name =
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoNullableBool" +
-      message_channel_suffix_;
-  BasicMessageChannel<> channel(binary_messenger_, channel_name, &GetCodec());
+  if (!echo_nullable_bool_channel_) {
+    echo_nullable_bool_channel_ =
+        std::make_shared<PigeonInternalFlutterMethodChannel>(
+            binary_messenger_,
+            "dev.flutter.pigeon.pigeon_integration_tests."
+            "FlutterIntegrationCoreApi.echoNullableBool" +
+                message_channel_suffix_,
+            &GetCodec());
+  }
   EncodableValue encoded_api_arguments = EncodableValue(EncodableList{
       a_bool_arg ? EncodableValue(*a_bool_arg) : EncodableValue(),
   });
-  channel.Send(encoded_api_arguments, [channel_name,
-                                       on_success = std::move(on_success),
-                                       on_error = std::move(on_error)](
-                                          const uint8_t* reply,
-                                          size_t reply_size) {
-    std::unique_ptr<EncodableValue> response =
-        GetCodec().DecodeMessage(reply, reply_size);
-    const auto& encodable_return_value = *response;
-    const auto* list_return_value =
-        std::get_if<EncodableList>(&encodable_return_value);
-    if (list_return_value) {
-      if (list_return_value->size() > 1) {
-        on_error(FlutterError(std::get<std::string>(list_return_value->at(0)),
-                              std::get<std::string>(list_return_value->at(1)),
-                              list_return_value->at(2)));
-      } else {
-        const auto* return_value = std::get_if<bool>(&list_return_value->at(0));
-        on_success(return_value);
-      }
-    } else {
-      on_error(CreateConnectionError(channel_name));
-    }
-  });
+  echo_nullable_bool_channel_->channel().Send(
+      encoded_api_arguments, [channel = echo_nullable_bool_channel_,
+                              on_success = std::move(on_success),
+                              on_error = std::move(on_error)](
+                                 const uint8_t* reply, size_t reply_size) {
+        std::unique_ptr<EncodableValue> response =
+            GetCodec().DecodeMessage(reply, reply_size);
+        const auto& encodable_return_value = *response;
+        const auto* list_return_value =
+            std::get_if<EncodableList>(&encodable_return_value);
+        if (list_return_value) {
+          if (list_return_value->size() > 1) {
+            on_error(
+                FlutterError(std::get<std::string>(list_return_value->at(0)),
+                             std::get<std::string>(list_return_value->at(1)),
+                             list_return_value->at(2)));
+          } else {
+            const auto* return_value =
+                std::get_if<bool>(&list_return_value->at(0));
+            on_success(return_value);
+          }
+        } else {
+          on_error(CreateConnectionError(channel->name()));
+        }
+      });
 }
 
 void FlutterIntegrationCoreApi::EchoNullableInt(
     const int64_t* an_int_arg, std::function<void(const int64_t*)>&& on_success,
     std::function<void(const FlutterError&)>&& on_error) {
-  const std::string channel_name =
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoNullableInt" +
-      message_channel_suffix_;
-  BasicMessageChannel<> channel(binary_messenger_, channel_name, &GetCodec());
+  if (!echo_nullable_int_channel_) {
+    echo_nullable_int_channel_ =
+        std::make_shared<PigeonInternalFlutterMethodChannel>(
+            binary_messenger_,
+            "dev.flutter.pigeon.pigeon_integration_tests."
+            "FlutterIntegrationCoreApi.echoNullableInt" +
+                message_channel_suffix_,
+            &GetCodec());
+  }
   EncodableValue encoded_api_arguments = EncodableValue(EncodableList{
       an_int_arg ? EncodableValue(*an_int_arg) : EncodableValue(),
   });
-  channel.Send(
-      encoded_api_arguments, [channel_name, on_success = std::move(on_success),
+  echo_nullable_int_channel_->channel().Send(
+      encoded_api_arguments, [channel = echo_nullable_int_channel_,
+                              on_success = std::move(on_success),
                               on_error = std::move(on_error)](
                                  const uint8_t* reply, size_t reply_size) {
         std::unique_ptr<EncodableValue> response =
@@ -10695,7 +12740,7 @@ void FlutterIntegrationCoreApi::EchoNullableInt(
             on_success(return_value);
           }
         } else {
-          on_error(CreateConnectionError(channel_name));
+          on_error(CreateConnectionError(channel->name()));
         }
       });
 }
@@ -10703,16 +12748,21 @@ void FlutterIntegrationCoreApi::EchoNullableInt(
 void FlutterIntegrationCoreApi::EchoNullableDouble(
     const double* a_double_arg, std::function<void(const double*)>&& on_success,
     std::function<void(const FlutterError&)>&& on_error) {
-  const std::string channel_name =
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoNullableDouble" +
-      message_channel_suffix_;
-  BasicMessageChannel<> channel(binary_messenger_, channel_name, &GetCodec());
+  if (!echo_nullable_double_channel_) {
+    echo_nullable_double_channel_ =
+        std::make_shared<PigeonInternalFlutterMethodChannel>(
+            binary_messenger_,
+            "dev.flutter.pigeon.pigeon_integration_tests."
+            "FlutterIntegrationCoreApi.echoNullableDouble" +
+                message_channel_suffix_,
+            &GetCodec());
+  }
   EncodableValue encoded_api_arguments = EncodableValue(EncodableList{
       a_double_arg ? EncodableValue(*a_double_arg) : EncodableValue(),
   });
-  channel.Send(
-      encoded_api_arguments, [channel_name, on_success = std::move(on_success),
+  echo_nullable_double_channel_->channel().Send(
+      encoded_api_arguments, [channel = echo_nullable_double_channel_,
+                              on_success = std::move(on_success),
                               on_error = std::move(on_error)](
                                  const uint8_t* reply, size_t reply_size) {
         std::unique_ptr<EncodableValue> response =
@@ -10732,7 +12782,7 @@ void FlutterIntegrationCoreApi::EchoNullableDouble(
             on_success(return_value);
           }
         } else {
-          on_error(CreateConnectionError(channel_name));
+          on_error(CreateConnectionError(channel->name()));
         }
       });
 }
@@ -10741,16 +12791,21 @@ void FlutterIntegrationCoreApi::EchoNullableString(
     const std::string* a_string_arg,
     std::function<void(const std::string*)>&& on_success,
     std::function<void(const FlutterError&)>&& on_error) {
-  const std::string channel_name =
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoNullableString" +
-      message_channel_suffix_;
-  BasicMessageChannel<> channel(binary_messenger_, channel_name, &GetCodec());
+  if (!echo_nullable_string_channel_) {
+    echo_nullable_string_channel_ =
+        std::make_shared<PigeonInternalFlutterMethodChannel>(
+            binary_messenger_,
+            "dev.flutter.pigeon.pigeon_integration_tests."
+            "FlutterIntegrationCoreApi.echoNullableString" +
+                message_channel_suffix_,
+            &GetCodec());
+  }
   EncodableValue encoded_api_arguments = EncodableValue(EncodableList{
       a_string_arg ? EncodableValue(*a_string_arg) : EncodableValue(),
   });
-  channel.Send(
-      encoded_api_arguments, [channel_name, on_success = std::move(on_success),
+  echo_nullable_string_channel_->channel().Send(
+      encoded_api_arguments, [channel = echo_nullable_string_channel_,
+                              on_success = std::move(on_success),
                               on_error = std::move(on_error)](
                                  const uint8_t* reply, size_t reply_size) {
         std::unique_ptr<EncodableValue> response =
@@ -10770,7 +12825,7 @@ void FlutterIntegrationCoreApi::EchoNullableString(
             on_success(return_value);
           }
         } else {
-          on_error(CreateConnectionError(channel_name));
+          on_error(CreateConnectionError(channel->name()));
         }
       });
 }
@@ -10779,16 +12834,21 @@ void FlutterIntegrationCoreApi::EchoNullableUint8List(
     const std::vector<uint8_t>* list_arg,
     std::function<void(const std::vector<uint8_t>*)>&& on_success,
     std::function<void(const FlutterError&)>&& on_error) {
-  const std::string channel_name =
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoNullableUint8List" +
-      message_channel_suffix_;
-  BasicMessageChannel<> channel(binary_messenger_, channel_name, &GetCodec());
+  if (!echo_nullable_uint8_list_channel_) {
+    echo_nullable_uint8_list_channel_ =
+        std::make_shared<PigeonInternalFlutterMethodChannel>(
+            binary_messenger_,
+            "dev.flutter.pigeon.pigeon_integration_tests."
+            "FlutterIntegrationCoreApi.echoNullableUint8List" +
+                message_channel_suffix_,
+            &GetCodec());
+  }
   EncodableValue encoded_api_arguments = EncodableValue(EncodableList{
       list_arg ? EncodableValue(*list_arg) : EncodableValue(),
   });
-  channel.Send(
-      encoded_api_arguments, [channel_name, on_success = std::move(on_success),
+  echo_nullable_uint8_list_channel_->channel().Send(
+      encoded_api_arguments, [channel = echo_nullable_uint8_list_channel_,
+                              on_success = std::move(on_success),
                               on_error = std::move(on_error)](
                                  const uint8_t* reply, size_t reply_size) {
         std::unique_ptr<EncodableValue> response =
@@ -10808,7 +12868,7 @@ void FlutterIntegrationCoreApi::EchoNullableUint8List(
             on_success(return_value);
           }
         } else {
-          on_error(CreateConnectionError(channel_name));
+          on_error(CreateConnectionError(channel->name()));
         }
       });
 }
@@ -10817,16 +12877,21 @@ void FlutterIntegrationCoreApi::EchoNullableList(
     const EncodableList* list_arg,
     std::function<void(const EncodableList*)>&& on_success,
     std::function<void(const FlutterError&)>&& on_error) {
-  const std::string channel_name =
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoNullableList" +
-      message_channel_suffix_;
-  BasicMessageChannel<> channel(binary_messenger_, channel_name, &GetCodec());
+  if (!echo_nullable_list_channel_) {
+    echo_nullable_list_channel_ =
+        std::make_shared<PigeonInternalFlutterMethodChannel>(
+            binary_messenger_,
+            "dev.flutter.pigeon.pigeon_integration_tests."
+            "FlutterIntegrationCoreApi.echoNullableList" +
+                message_channel_suffix_,
+            &GetCodec());
+  }
   EncodableValue encoded_api_arguments = EncodableValue(EncodableList{
       list_arg ? EncodableValue(*list_arg) : EncodableValue(),
   });
-  channel.Send(
-      encoded_api_arguments, [channel_name, on_success = std::move(on_success),
+  echo_nullable_list_channel_->channel().Send(
+      encoded_api_arguments, [channel = echo_nullable_list_channel_,
+                              on_success = std::move(on_success),
                               on_error = std::move(on_error)](
                                  const uint8_t* reply, size_t reply_size) {
         std::unique_ptr<EncodableValue> response =
@@ -10846,7 +12911,7 @@ void FlutterIntegrationCoreApi::EchoNullableList(
             on_success(return_value);
           }
         } else {
-          on_error(CreateConnectionError(channel_name));
+          on_error(CreateConnectionError(channel->name()));
         }
       });
 }
@@ -10855,16 +12920,21 @@ void FlutterIntegrationCoreApi::EchoNullableEnumList(
     const EncodableList* enum_list_arg,
     std::function<void(const EncodableList*)>&& on_success,
     std::function<void(const FlutterError&)>&& on_error) {
-  const std::string channel_name =
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoNullableEnumList" +
-      message_channel_suffix_;
-  BasicMessageChannel<> channel(binary_messenger_, channel_name, &GetCodec());
+  if (!echo_nullable_enum_list_channel_) {
+    echo_nullable_enum_list_channel_ =
+        std::make_shared<PigeonInternalFlutterMethodChannel>(
+            binary_messenger_,
+            "dev.flutter.pigeon.pigeon_integration_tests."
+            "FlutterIntegrationCoreApi.echoNullableEnumList" +
+                message_channel_suffix_,
+            &GetCodec());
+  }
   EncodableValue encoded_api_arguments = EncodableValue(EncodableList{
       enum_list_arg ? EncodableValue(*enum_list_arg) : EncodableValue(),
   });
-  channel.Send(
-      encoded_api_arguments, [channel_name, on_success = std::move(on_success),
+  echo_nullable_enum_list_channel_->channel().Send(
+      encoded_api_arguments, [channel = echo_nullable_enum_list_channel_,
+                              on_success = std::move(on_success),
                               on_error = std::move(on_error)](
                                  const uint8_t* reply, size_t reply_size) {
         std::unique_ptr<EncodableValue> response =
@@ -10884,7 +12954,7 @@ void FlutterIntegrationCoreApi::EchoNullableEnumList(
             on_success(return_value);
           }
         } else {
-          on_error(CreateConnectionError(channel_name));
+          on_error(CreateConnectionError(channel->name()));
         }
       });
 }
@@ -10893,16 +12963,21 @@ void FlutterIntegrationCoreApi::EchoNullableClassList(
     const EncodableList* class_list_arg,
     std::function<void(const EncodableList*)>&& on_success,
     std::function<void(const FlutterError&)>&& on_error) {
-  const std::string channel_name =
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoNullableClassList" +
-      message_channel_suffix_;
-  BasicMessageChannel<> channel(binary_messenger_, channel_name, &GetCodec());
+  if (!echo_nullable_class_list_channel_) {
+    echo_nullable_class_list_channel_ =
+        std::make_shared<PigeonInternalFlutterMethodChannel>(
+            binary_messenger_,
+            "dev.flutter.pigeon.pigeon_integration_tests."
+            "FlutterIntegrationCoreApi.echoNullableClassList" +
+                message_channel_suffix_,
+            &GetCodec());
+  }
   EncodableValue encoded_api_arguments = EncodableValue(EncodableList{
       class_list_arg ? EncodableValue(*class_list_arg) : EncodableValue(),
   });
-  channel.Send(
-      encoded_api_arguments, [channel_name, on_success = std::move(on_success),
+  echo_nullable_class_list_channel_->channel().Send(
+      encoded_api_arguments, [channel = echo_nullable_class_list_channel_,
+                              on_success = std::move(on_success),
                               on_error = std::move(on_error)](
                                  const uint8_t* reply, size_t reply_size) {
         std::unique_ptr<EncodableValue> response =
@@ -10922,7 +12997,7 @@ void FlutterIntegrationCoreApi::EchoNullableClassList(
             on_success(return_value);
           }
         } else {
-          on_error(CreateConnectionError(channel_name));
+          on_error(CreateConnectionError(channel->name()));
         }
       });
 }
@@ -10931,18 +13006,24 @@ void FlutterIntegrationCoreApi::EchoNullableNonNullEnumList(
     const EncodableList* enum_list_arg,
     std::function<void(const EncodableList*)>&& on_success,
     std::function<void(const FlutterError&)>&& on_error) {
-  const std::string channel_name =
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoNullableNonNullEnumList" +
-      message_channel_suffix_;
-  BasicMessageChannel<> channel(binary_messenger_, channel_name, &GetCodec());
+  if (!echo_nullable_non_null_enum_list_channel_) {
+    echo_nullable_non_null_enum_list_channel_ =
+        std::make_shared<PigeonInternalFlutterMethodChannel>(
+            binary_messenger_,
+            "dev.flutter.pigeon.pigeon_integration_tests."
+            "FlutterIntegrationCoreApi.echoNullableNonNullEnumList" +
+                message_channel_suffix_,
+            &GetCodec());
+  }
   EncodableValue encoded_api_arguments = EncodableValue(EncodableList{
       enum_list_arg ? EncodableValue(*enum_list_arg) : EncodableValue(),
   });
-  channel.Send(
-      encoded_api_arguments, [channel_name, on_success = std::move(on_success),
-                              on_error = std::move(on_error)](
-                                 const uint8_t* reply, size_t reply_size) {
+  echo_nullable_non_null_enum_list_channel_->channel().Send(
+      encoded_api_arguments,
+      [channel = echo_nullable_non_null_enum_list_channel_,
+       on_success = std::move(on_success),
+       on_error = std::move(on_error)](
+          const uint8_t* reply, size_t reply_size) {
         std::unique_ptr<EncodableValue> response =
             GetCodec().DecodeMessage(reply, reply_size);
         const auto& encodable_return_value = *response;
@@ -10960,7 +13041,7 @@ void FlutterIntegrationCoreApi::EchoNullableNonNullEnumList(
             on_success(return_value);
           }
         } else {
-          on_error(CreateConnectionError(channel_name));
+          on_error(CreateConnectionError(channel->name()));
         }
       });
 }
@@ -10969,18 +13050,24 @@ void FlutterIntegrationCoreApi::EchoNullableNonNullClassList(
     const EncodableList* class_list_arg,
     std::function<void(const EncodableList*)>&& on_success,
     std::function<void(const FlutterError&)>&& on_error) {
-  const std::string channel_name =
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoNullableNonNullClassList" +
-      message_channel_suffix_;
-  BasicMessageChannel<> channel(binary_messenger_, channel_name, &GetCodec());
+  if (!echo_nullable_non_null_class_list_channel_) {
+    echo_nullable_non_null_class_list_channel_ =
+        std::make_shared<PigeonInternalFlutterMethodChannel>(
+            binary_messenger_,
+            "dev.flutter.pigeon.pigeon_integration_tests."
+            "FlutterIntegrationCoreApi.echoNullableNonNullClassList" +
+                message_channel_suffix_,
+            &GetCodec());
+  }
   EncodableValue encoded_api_arguments = EncodableValue(EncodableList{
       class_list_arg ? EncodableValue(*class_list_arg) : EncodableValue(),
   });
-  channel.Send(
-      encoded_api_arguments, [channel_name, on_success = std::move(on_success),
-                              on_error = std::move(on_error)](
-                                 const uint8_t* reply, size_t reply_size) {
+  echo_nullable_non_null_class_list_channel_->channel().Send(
+      encoded_api_arguments,
+      [channel = echo_nullable_non_null_class_list_channel_,
+       on_success = std::move(on_success),
+       on_error = std::move(on_error)](
+          const uint8_t* reply, size_t reply_size) {
         std::unique_ptr<EncodableValue> response =
             GetCodec().DecodeMessage(reply, reply_size);
         const auto& encodable_return_value = *response;
@@ -10998,7 +13085,7 @@ void FlutterIntegrationCoreApi::EchoNullableNonNullClassList(
             on_success(return_value);
           }
         } else {
-          on_error(CreateConnectionError(channel_name));
+          on_error(CreateConnectionError(channel->name()));
         }
       });
 }
@@ -11007,16 +13094,21 @@ void FlutterIntegrationCoreApi::EchoNullableMap(
     const EncodableMap* map_arg,
     std::function<void(const EncodableMap*)>&& on_success,
     std::function<void(const FlutterError&)>&& on_error) {
-  const std::string channel_name =
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoNullableMap" +
-      message_channel_suffix_;
-  BasicMessageChannel<> channel(binary_messenger_, channel_name, &GetCodec());
+  if (!echo_nullable_map_channel_) {
+    echo_nullable_map_channel_ =
+        std::make_shared<PigeonInternalFlutterMethodChannel>(
+            binary_messenger_,
+            "dev.flutter.pigeon.pigeon_integration_tests."
+            "FlutterIntegrationCoreApi.echoNullableMap" +
+                message_channel_suffix_,
+            &GetCodec());
+  }
   EncodableValue encoded_api_arguments = EncodableValue(EncodableList{
       map_arg ? EncodableValue(*map_arg) : EncodableValue(),
   });
-  channel.Send(
-      encoded_api_arguments, [channel_name, on_success = std::move(on_success),
+  echo_nullable_map_channel_->channel().Send(
+      encoded_api_arguments, [channel = echo_nullable_map_channel_,
+                              on_success = std::move(on_success),
                               on_error = std::move(on_error)](
                                  const uint8_t* reply, size_t reply_size) {
         std::unique_ptr<EncodableValue> response =
@@ -11036,7 +13128,7 @@ void FlutterIntegrationCoreApi::EchoNullableMap(
             on_success(return_value);
           }
         } else {
-          on_error(CreateConnectionError(channel_name));
+          on_error(CreateConnectionError(channel->name()));
         }
       });
 }
@@ -11045,16 +13137,21 @@ void FlutterIntegrationCoreApi::EchoNullableStringMap(
     const EncodableMap* string_map_arg,
     std::function<void(const EncodableMap*)>&& on_success,
     std::function<void(const FlutterError&)>&& on_error) {
-  const std::string channel_name =
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoNullableStringMap" +
-      message_channel_suffix_;
-  BasicMessageChannel<> channel(binary_messenger_, channel_name, &GetCodec());
+  if (!echo_nullable_string_map_channel_) {
+    echo_nullable_string_map_channel_ =
+        std::make_shared<PigeonInternalFlutterMethodChannel>(
+            binary_messenger_,
+            "dev.flutter.pigeon.pigeon_integration_tests."
+            "FlutterIntegrationCoreApi.echoNullableStringMap" +
+                message_channel_suffix_,
+            &GetCodec());
+  }
   EncodableValue encoded_api_arguments = EncodableValue(EncodableList{
       string_map_arg ? EncodableValue(*string_map_arg) : EncodableValue(),
   });
-  channel.Send(
-      encoded_api_arguments, [channel_name, on_success = std::move(on_success),
+  echo_nullable_string_map_channel_->channel().Send(
+      encoded_api_arguments, [channel = echo_nullable_string_map_channel_,
+                              on_success = std::move(on_success),
                               on_error = std::move(on_error)](
                                  const uint8_t* reply, size_t reply_size) {
         std::unique_ptr<EncodableValue> response =
@@ -11074,7 +13171,7 @@ void FlutterIntegrationCoreApi::EchoNullableStringMap(
             on_success(return_value);
           }
         } else {
-          on_error(CreateConnectionError(channel_name));
+          on_error(CreateConnectionError(channel->name()));
         }
       });
 }
@@ -11083,16 +13180,21 @@ void FlutterIntegrationCoreApi::EchoNullableIntMap(
     const EncodableMap* int_map_arg,
     std::function<void(const EncodableMap*)>&& on_success,
     std::function<void(const FlutterError&)>&& on_error) {
-  const std::string channel_name =
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoNullableIntMap" +
-      message_channel_suffix_;
-  BasicMessageChannel<> channel(binary_messenger_, channel_name, &GetCodec());
+  if (!echo_nullable_int_map_channel_) {
+    echo_nullable_int_map_channel_ =
+        std::make_shared<PigeonInternalFlutterMethodChannel>(
+            binary_messenger_,
+            "dev.flutter.pigeon.pigeon_integration_tests."
+            "FlutterIntegrationCoreApi.echoNullableIntMap" +
+                message_channel_suffix_,
+            &GetCodec());
+  }
   EncodableValue encoded_api_arguments = EncodableValue(EncodableList{
       int_map_arg ? EncodableValue(*int_map_arg) : EncodableValue(),
   });
-  channel.Send(
-      encoded_api_arguments, [channel_name, on_success = std::move(on_success),
+  echo_nullable_int_map_channel_->channel().Send(
+      encoded_api_arguments, [channel = echo_nullable_int_map_channel_,
+                              on_success = std::move(on_success),
                               on_error = std::move(on_error)](
                                  const uint8_t* reply, size_t reply_size) {
         std::unique_ptr<EncodableValue> response =
@@ -11112,7 +13214,7 @@ void FlutterIntegrationCoreApi::EchoNullableIntMap(
             on_success(return_value);
           }
         } else {
-          on_error(CreateConnectionError(channel_name));
+          on_error(CreateConnectionError(channel->name()));
         }
       });
 }
@@ -11121,16 +13223,21 @@ void FlutterIntegrationCoreApi::EchoNullableEnumMap(
     const EncodableMap* enum_map_arg,
     std::function<void(const EncodableMap*)>&& on_success,
     std::function<void(const FlutterError&)>&& on_error) {
-  const std::string channel_name =
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoNullableEnumMap" +
-      message_channel_suffix_;
-  BasicMessageChannel<> channel(binary_messenger_, channel_name, &GetCodec());
+  if (!echo_nullable_enum_map_channel_) {
+    echo_nullable_enum_map_channel_ =
+        std::make_shared<PigeonInternalFlutterMethodChannel>(
+            binary_messenger_,
+            "dev.flutter.pigeon.pigeon_integration_tests."
+            "FlutterIntegrationCoreApi.echoNullableEnumMap" +
+                message_channel_suffix_,
+            &GetCodec());
+  }
   EncodableValue encoded_api_arguments = EncodableValue(EncodableList{
       enum_map_arg ? EncodableValue(*enum_map_arg) : EncodableValue(),
   });
-  channel.Send(
-      encoded_api_arguments, [channel_name, on_success = std::move(on_success),
+  echo_nullable_enum_map_channel_->channel().Send(
+      encoded_api_arguments, [channel = echo_nullable_enum_map_channel_,
+                              on_success = std::move(on_success),
                               on_error = std::move(on_error)](
                                  const uint8_t* reply, size_t reply_size) {
         std::unique_ptr<EncodableValue> response =
@@ -11150,7 +13257,7 @@ void FlutterIntegrationCoreApi::EchoNullableEnumMap(
             on_success(return_value);
           }
         } else {
-          on_error(CreateConnectionError(channel_name));
+          on_error(CreateConnectionError(channel->name()));
         }
       });
 }
@@ -11159,16 +13266,21 @@ void FlutterIntegrationCoreApi::EchoNullableClassMap(
     const EncodableMap* class_map_arg,
     std::function<void(const EncodableMap*)>&& on_success,
     std::function<void(const FlutterError&)>&& on_error) {
-  const std::string channel_name =
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoNullableClassMap" +
-      message_channel_suffix_;
-  BasicMessageChannel<> channel(binary_messenger_, channel_name, &GetCodec());
+  if (!echo_nullable_class_map_channel_) {
+    echo_nullable_class_map_channel_ =
+        std::make_shared<PigeonInternalFlutterMethodChannel>(
+            binary_messenger_,
+            "dev.flutter.pigeon.pigeon_integration_tests."
+            "FlutterIntegrationCoreApi.echoNullableClassMap" +
+                message_channel_suffix_,
+            &GetCodec());
+  }
   EncodableValue encoded_api_arguments = EncodableValue(EncodableList{
       class_map_arg ? EncodableValue(*class_map_arg) : EncodableValue(),
   });
-  channel.Send(
-      encoded_api_arguments, [channel_name, on_success = std::move(on_success),
+  echo_nullable_class_map_channel_->channel().Send(
+      encoded_api_arguments, [channel = echo_nullable_class_map_channel_,
+                              on_success = std::move(on_success),
                               on_error = std::move(on_error)](
                                  const uint8_t* reply, size_t reply_size) {
         std::unique_ptr<EncodableValue> response =
@@ -11188,7 +13300,7 @@ void FlutterIntegrationCoreApi::EchoNullableClassMap(
             on_success(return_value);
           }
         } else {
-          on_error(CreateConnectionError(channel_name));
+          on_error(CreateConnectionError(channel->name()));
         }
       });
 }
@@ -11197,18 +13309,24 @@ void FlutterIntegrationCoreApi::EchoNullableNonNullStringMap(
     const EncodableMap* string_map_arg,
     std::function<void(const EncodableMap*)>&& on_success,
     std::function<void(const FlutterError&)>&& on_error) {
-  const std::string channel_name =
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoNullableNonNullStringMap" +
-      message_channel_suffix_;
-  BasicMessageChannel<> channel(binary_messenger_, channel_name, &GetCodec());
+  if (!echo_nullable_non_null_string_map_channel_) {
+    echo_nullable_non_null_string_map_channel_ =
+        std::make_shared<PigeonInternalFlutterMethodChannel>(
+            binary_messenger_,
+            "dev.flutter.pigeon.pigeon_integration_tests."
+            "FlutterIntegrationCoreApi.echoNullableNonNullStringMap" +
+                message_channel_suffix_,
+            &GetCodec());
+  }
   EncodableValue encoded_api_arguments = EncodableValue(EncodableList{
       string_map_arg ? EncodableValue(*string_map_arg) : EncodableValue(),
   });
-  channel.Send(
-      encoded_api_arguments, [channel_name, on_success = std::move(on_success),
-                              on_error = std::move(on_error)](
-                                 const uint8_t* reply, size_t reply_size) {
+  echo_nullable_non_null_string_map_channel_->channel().Send(
+      encoded_api_arguments,
+      [channel = echo_nullable_non_null_string_map_channel_,
+       on_success = std::move(on_success),
+       on_error = std::move(on_error)](
+          const uint8_t* reply, size_t reply_size) {
         std::unique_ptr<EncodableValue> response =
             GetCodec().DecodeMessage(reply, reply_size);
         const auto& encodable_return_value = *response;
@@ -11226,7 +13344,7 @@ void FlutterIntegrationCoreApi::EchoNullableNonNullStringMap(
             on_success(return_value);
           }
         } else {
-          on_error(CreateConnectionError(channel_name));
+          on_error(CreateConnectionError(channel->name()));
         }
       });
 }
@@ -11235,16 +13353,21 @@ void FlutterIntegrationCoreApi::EchoNullableNonNullIntMap(
     const EncodableMap* int_map_arg,
     std::function<void(const EncodableMap*)>&& on_success,
     std::function<void(const FlutterError&)>&& on_error) {
-  const std::string channel_name =
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoNullableNonNullIntMap" +
-      message_channel_suffix_;
-  BasicMessageChannel<> channel(binary_messenger_, channel_name, &GetCodec());
+  if (!echo_nullable_non_null_int_map_channel_) {
+    echo_nullable_non_null_int_map_channel_ =
+        std::make_shared<PigeonInternalFlutterMethodChannel>(
+            binary_messenger_,
+            "dev.flutter.pigeon.pigeon_integration_tests."
+            "FlutterIntegrationCoreApi.echoNullableNonNullIntMap" +
+                message_channel_suffix_,
+            &GetCodec());
+  }
   EncodableValue encoded_api_arguments = EncodableValue(EncodableList{
       int_map_arg ? EncodableValue(*int_map_arg) : EncodableValue(),
   });
-  channel.Send(
-      encoded_api_arguments, [channel_name, on_success = std::move(on_success),
+  echo_nullable_non_null_int_map_channel_->channel().Send(
+      encoded_api_arguments, [channel = echo_nullable_non_null_int_map_channel_,
+                              on_success = std::move(on_success),
                               on_error = std::move(on_error)](
                                  const uint8_t* reply, size_t reply_size) {
         std::unique_ptr<EncodableValue> response =
@@ -11264,7 +13387,7 @@ void FlutterIntegrationCoreApi::EchoNullableNonNullIntMap(
             on_success(return_value);
           }
         } else {
-          on_error(CreateConnectionError(channel_name));
+          on_error(CreateConnectionError(channel->name()));
         }
       });
 }
@@ -11273,18 +13396,24 @@ void FlutterIntegrationCoreApi::EchoNullableNonNullEnumMap(
     const EncodableMap* enum_map_arg,
     std::function<void(const EncodableMap*)>&& on_success,
     std::function<void(const FlutterError&)>&& on_error) {
-  const std::string channel_name =
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoNullableNonNullEnumMap" +
-      message_channel_suffix_;
-  BasicMessageChannel<> channel(binary_messenger_, channel_name, &GetCodec());
+  if (!echo_nullable_non_null_enum_map_channel_) {
+    echo_nullable_non_null_enum_map_channel_ =
+        std::make_shared<PigeonInternalFlutterMethodChannel>(
+            binary_messenger_,
+            "dev.flutter.pigeon.pigeon_integration_tests."
+            "FlutterIntegrationCoreApi.echoNullableNonNullEnumMap" +
+                message_channel_suffix_,
+            &GetCodec());
+  }
   EncodableValue encoded_api_arguments = EncodableValue(EncodableList{
       enum_map_arg ? EncodableValue(*enum_map_arg) : EncodableValue(),
   });
-  channel.Send(
-      encoded_api_arguments, [channel_name, on_success = std::move(on_success),
-                              on_error = std::move(on_error)](
-                                 const uint8_t* reply, size_t reply_size) {
+  echo_nullable_non_null_enum_map_channel_->channel().Send(
+      encoded_api_arguments,
+      [channel = echo_nullable_non_null_enum_map_channel_,
+       on_success = std::move(on_success),
+       on_error = std::move(on_error)](
+          const uint8_t* reply, size_t reply_size) {
         std::unique_ptr<EncodableValue> response =
             GetCodec().DecodeMessage(reply, reply_size);
         const auto& encodable_return_value = *response;
@@ -11302,7 +13431,7 @@ void FlutterIntegrationCoreApi::EchoNullableNonNullEnumMap(
             on_success(return_value);
           }
         } else {
-          on_error(CreateConnectionError(channel_name));
+          on_error(CreateConnectionError(channel->name()));
         }
       });
 }
@@ -11311,18 +13440,24 @@ void FlutterIntegrationCoreApi::EchoNullableNonNullClassMap(
     const EncodableMap* class_map_arg,
     std::function<void(const EncodableMap*)>&& on_success,
     std::function<void(const FlutterError&)>&& on_error) {
-  const std::string channel_name =
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoNullableNonNullClassMap" +
-      message_channel_suffix_;
-  BasicMessageChannel<> channel(binary_messenger_, channel_name, &GetCodec());
+  if (!echo_nullable_non_null_class_map_channel_) {
+    echo_nullable_non_null_class_map_channel_ =
+        std::make_shared<PigeonInternalFlutterMethodChannel>(
+            binary_messenger_,
+            "dev.flutter.pigeon.pigeon_integration_tests."
+            "FlutterIntegrationCoreApi.echoNullableNonNullClassMap" +
+                message_channel_suffix_,
+            &GetCodec());
+  }
   EncodableValue encoded_api_arguments = EncodableValue(EncodableList{
       class_map_arg ? EncodableValue(*class_map_arg) : EncodableValue(),
   });
-  channel.Send(
-      encoded_api_arguments, [channel_name, on_success = std::move(on_success),
-                              on_error = std::move(on_error)](
-                                 const uint8_t* reply, size_t reply_size) {
+  echo_nullable_non_null_class_map_channel_->channel().Send(
+      encoded_api_arguments,
+      [channel = echo_nullable_non_null_class_map_channel_,
+       on_success = std::move(on_success),
+       on_error = std::move(on_error)](
+          const uint8_t* reply, size_t reply_size) {
         std::unique_ptr<EncodableValue> response =
             GetCodec().DecodeMessage(reply, reply_size);
         const auto& encodable_return_value = *response;
@@ -11340,7 +13475,7 @@ void FlutterIntegrationCoreApi::EchoNullableNonNullClassMap(
             on_success(return_value);
           }
         } else {
-          on_error(CreateConnectionError(channel_name));
+          on_error(CreateConnectionError(channel->name()));
         }
       });
 }
@@ -11348,16 +13483,21 @@ void FlutterIntegrationCoreApi::EchoNullableNonNullClassMap(
 void FlutterIntegrationCoreApi::EchoNullableEnum(
     const AnEnum* an_enum_arg, std::function<void(const AnEnum*)>&& on_success,
     std::function<void(const FlutterError&)>&& on_error) {
-  const std::string channel_name =
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoNullableEnum" +
-      message_channel_suffix_;
-  BasicMessageChannel<> channel(binary_messenger_, channel_name, &GetCodec());
+  if (!echo_nullable_enum_channel_) {
+    echo_nullable_enum_channel_ =
+        std::make_shared<PigeonInternalFlutterMethodChannel>(
+            binary_messenger_,
+            "dev.flutter.pigeon.pigeon_integration_tests."
+            "FlutterIntegrationCoreApi.echoNullableEnum" +
+                message_channel_suffix_,
+            &GetCodec());
+  }
   EncodableValue encoded_api_arguments = EncodableValue(EncodableList{
       an_enum_arg ? CustomEncodableValue(*an_enum_arg) : EncodableValue(),
   });
-  channel.Send(
-      encoded_api_arguments, [channel_name, on_success = std::move(on_success),
+  echo_nullable_enum_channel_->channel().Send(
+      encoded_api_arguments, [channel = echo_nullable_enum_channel_,
+                              on_success = std::move(on_success),
                               on_error = std::move(on_error)](
                                  const uint8_t* reply, size_t reply_size) {
         std::unique_ptr<EncodableValue> response =
@@ -11382,7 +13522,7 @@ void FlutterIntegrationCoreApi::EchoNullableEnum(
             on_success(return_value);
           }
         } else {
-          on_error(CreateConnectionError(channel_name));
+          on_error(CreateConnectionError(channel->name()));
         }
       });
 }
@@ -11391,17 +13531,22 @@ void FlutterIntegrationCoreApi::EchoAnotherNullableEnum(
     const AnotherEnum* another_enum_arg,
     std::function<void(const AnotherEnum*)>&& on_success,
     std::function<void(const FlutterError&)>&& on_error) {
-  const std::string channel_name =
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoAnotherNullableEnum" +
-      message_channel_suffix_;
-  BasicMessageChannel<> channel(binary_messenger_, channel_name, &GetCodec());
+  if (!echo_another_nullable_enum_channel_) {
+    echo_another_nullable_enum_channel_ =
+        std::make_shared<PigeonInternalFlutterMethodChannel>(
+            binary_messenger_,
+            "dev.flutter.pigeon.pigeon_integration_tests."
+            "FlutterIntegrationCoreApi.echoAnotherNullableEnum" +
+                message_channel_suffix_,
+            &GetCodec());
+  }
   EncodableValue encoded_api_arguments = EncodableValue(EncodableList{
       another_enum_arg ? CustomEncodableValue(*another_enum_arg)
                        : EncodableValue(),
   });
-  channel.Send(
-      encoded_api_arguments, [channel_name, on_success = std::move(on_success),
+  echo_another_nullable_enum_channel_->channel().Send(
+      encoded_api_arguments, [channel = echo_another_nullable_enum_channel_,
+                              on_success = std::move(on_success),
                               on_error = std::move(on_error)](
                                  const uint8_t* reply, size_t reply_size) {
         std::unique_ptr<EncodableValue> response =
@@ -11426,7 +13571,7 @@ void FlutterIntegrationCoreApi::EchoAnotherNullableEnum(
             on_success(return_value);
           }
         } else {
-          on_error(CreateConnectionError(channel_name));
+          on_error(CreateConnectionError(channel->name()));
         }
       });
 }
@@ -11434,14 +13579,18 @@ void FlutterIntegrationCoreApi::EchoAnotherNullableEnum(
 void FlutterIntegrationCoreApi::NoopAsync(
     std::function<void(void)>&& on_success,
     std::function<void(const FlutterError&)>&& on_error) {
-  const std::string channel_name =
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "noopAsync" +
-      message_channel_suffix_;
-  BasicMessageChannel<> channel(binary_messenger_, channel_name, &GetCodec());
+  if (!noop_async_channel_) {
+    noop_async_channel_ = std::make_shared<PigeonInternalFlutterMethodChannel>(
+        binary_messenger_,
+        "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
+        "noopAsync" +
+            message_channel_suffix_,
+        &GetCodec());
+  }
   EncodableValue encoded_api_arguments = EncodableValue();
-  channel.Send(
-      encoded_api_arguments, [channel_name, on_success = std::move(on_success),
+  noop_async_channel_->channel().Send(
+      encoded_api_arguments, [channel = noop_async_channel_,
+                              on_success = std::move(on_success),
                               on_error = std::move(on_error)](
                                  const uint8_t* reply, size_t reply_size) {
         std::unique_ptr<EncodableValue> response =
@@ -11459,7 +13608,7 @@ void FlutterIntegrationCoreApi::NoopAsync(
             on_success();
           }
         } else {
-          on_error(CreateConnectionError(channel_name));
+          on_error(CreateConnectionError(channel->name()));
         }
       });
 }
@@ -11468,16 +13617,21 @@ void FlutterIntegrationCoreApi::EchoAsyncString(
     const std::string& a_string_arg,
     std::function<void(const std::string&)>&& on_success,
     std::function<void(const FlutterError&)>&& on_error) {
-  const std::string channel_name =
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterIntegrationCoreApi."
-      "echoAsyncString" +
-      message_channel_suffix_;
-  BasicMessageChannel<> channel(binary_messenger_, channel_name, &GetCodec());
+  if (!echo_async_string_channel_) {
+    echo_async_string_channel_ =
+        std::make_shared<PigeonInternalFlutterMethodChannel>(
+            binary_messenger_,
+            "dev.flutter.pigeon.pigeon_integration_tests."
+            "FlutterIntegrationCoreApi.echoAsyncString" +
+                message_channel_suffix_,
+            &GetCodec());
+  }
   EncodableValue encoded_api_arguments = EncodableValue(EncodableList{
       EncodableValue(a_string_arg),
   });
-  channel.Send(
-      encoded_api_arguments, [channel_name, on_success = std::move(on_success),
+  echo_async_string_channel_->channel().Send(
+      encoded_api_arguments, [channel = echo_async_string_channel_,
+                              on_success = std::move(on_success),
                               on_error = std::move(on_error)](
                                  const uint8_t* reply, size_t reply_size) {
         std::unique_ptr<EncodableValue> response =
@@ -11497,7 +13651,7 @@ void FlutterIntegrationCoreApi::EchoAsyncString(
             on_success(return_value);
           }
         } else {
-          on_error(CreateConnectionError(channel_name));
+          on_error(CreateConnectionError(channel->name()));
         }
       });
 }
@@ -11683,16 +13837,21 @@ void FlutterSmallApi::EchoWrappedList(
     const TestMessage& msg_arg,
     std::function<void(const TestMessage&)>&& on_success,
     std::function<void(const FlutterError&)>&& on_error) {
-  const std::string channel_name =
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterSmallApi."
-      "echoWrappedList" +
-      message_channel_suffix_;
-  BasicMessageChannel<> channel(binary_messenger_, channel_name, &GetCodec());
+  if (!echo_wrapped_list_channel_) {
+    echo_wrapped_list_channel_ =
+        std::make_shared<PigeonInternalFlutterMethodChannel>(
+            binary_messenger_,
+            "dev.flutter.pigeon.pigeon_integration_tests.FlutterSmallApi."
+            "echoWrappedList" +
+                message_channel_suffix_,
+            &GetCodec());
+  }
   EncodableValue encoded_api_arguments = EncodableValue(EncodableList{
       CustomEncodableValue(msg_arg),
   });
-  channel.Send(
-      encoded_api_arguments, [channel_name, on_success = std::move(on_success),
+  echo_wrapped_list_channel_->channel().Send(
+      encoded_api_arguments, [channel = echo_wrapped_list_channel_,
+                              on_success = std::move(on_success),
                               on_error = std::move(on_error)](
                                  const uint8_t* reply, size_t reply_size) {
         std::unique_ptr<EncodableValue> response =
@@ -11712,7 +13871,7 @@ void FlutterSmallApi::EchoWrappedList(
             on_success(return_value);
           }
         } else {
-          on_error(CreateConnectionError(channel_name));
+          on_error(CreateConnectionError(channel->name()));
         }
       });
 }
@@ -11721,15 +13880,20 @@ void FlutterSmallApi::EchoString(
     const std::string& a_string_arg,
     std::function<void(const std::string&)>&& on_success,
     std::function<void(const FlutterError&)>&& on_error) {
-  const std::string channel_name =
-      "dev.flutter.pigeon.pigeon_integration_tests.FlutterSmallApi.echoString" +
-      message_channel_suffix_;
-  BasicMessageChannel<> channel(binary_messenger_, channel_name, &GetCodec());
+  if (!echo_string_channel_) {
+    echo_string_channel_ = std::make_shared<PigeonInternalFlutterMethodChannel>(
+        binary_messenger_,
+        "dev.flutter.pigeon.pigeon_integration_tests.FlutterSmallApi."
+        "echoString" +
+            message_channel_suffix_,
+        &GetCodec());
+  }
   EncodableValue encoded_api_arguments = EncodableValue(EncodableList{
       EncodableValue(a_string_arg),
   });
-  channel.Send(
-      encoded_api_arguments, [channel_name, on_success = std::move(on_success),
+  echo_string_channel_->channel().Send(
+      encoded_api_arguments, [channel = echo_string_channel_,
+                              on_success = std::move(on_success),
                               on_error = std::move(on_error)](
                                  const uint8_t* reply, size_t reply_size) {
         std::unique_ptr<EncodableValue> response =
@@ -11749,7 +13913,7 @@ void FlutterSmallApi::EchoString(
             on_success(return_value);
           }
         } else {
-          on_error(CreateConnectionError(channel_name));
+          on_error(CreateConnectionError(channel->name()));
         }
       });
 }
@@ -12,10 +12,17 @@
 #include <flutter/encodable_value.h>
 #include <flutter/standard_message_codec.h>
 
+#include <condition_variable>
+#include <deque>
+#include <functional>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <ostream>
 #include <string>
+#include <thread>
+#include <utility>
 
 namespace core_tests_pigeontest {
 
@@ -66,6 +73,121 @@ class ErrorOr {
   std::variant<T, FlutterError> v_;
 };
 
+// Runs the handlers of host API methods that use a background task queue.
+//
+// Pass an implementation to the `SetUp` of an API to choose the thread its
+// methods are handled on; without one, they are handled on the platform
+// thread.
+class PigeonTaskQueue {
+ public:
+  virtual ~PigeonTaskQueue() = default;
+
+  // Runs |task| off the platform thread. Tasks must run one at a time, in the
+  // order they were posted.
+  virtual void Post(std::function<void()> task) = 0;
+
+  // Runs |send_reply|, which sends the reply to a message handled on this
+  // queue, on the platform thread. It is called from the thread the reply was
+  // created on, and the messenger only accepts replies on the platform thread.
+  virtual void PostReply(std::function<void()> send_reply) = 0;
+};
+
+// A PigeonTaskQueue that runs tasks in order on a worker thread that it owns,
+// and sends replies from a task posted through |post_to_platform_thread|, which
+// must run it on the platform thread.
+//
+// The tasks already posted when the queue is destroyed still run before the
+// worker thread exits.
+class PigeonSerialTaskQueue : public PigeonTaskQueue {
+ public:
+  explicit PigeonSerialTaskQueue(
+      std::function<void(std::function<void()> task)> post_to_platform_thread)
+      : state_(std::make_shared<State>()),
+        post_to_platform_thread_(std::move(post_to_platform_thread)) {
+    thread_ = std::thread([state = state_]() { Run(*state); });
+  }
+
+  ~PigeonSerialTaskQueue() override {
+    {
+      std::lock_guard<std::mutex> lock(state_->mutex);
+      state_->stopping = true;
+    }
+    state_->condition.notify_one();
+    // A task can release the last reference to the queue, and the worker
+    // thread can't join itself.
+    if (thread_.get_id() == std::this_thread::get_id()) {
+      thread_.detach();
+    } else {
+      thread_.join();
+    }
+  }
+
+  void Post(std::function<void()> task) override {
+    {
+      std::lock_guard<std::mutex> lock(state_->mutex);
+      state_->tasks.push_back(std::move(task));
+    }
+    state_->condition.notify_one();
+  }
+
+  void PostReply(std::function<void()> send_reply) override {
+    post_to_platform_thread_(std::move(send_reply));
+  }
+
+ private:
+  // The state shared with the worker thread, which outlives the queue if the
+  // thread is detached.
+  struct State {
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::deque<std::function<void()>> tasks;
+    bool stopping = false;
+  };
+
+  static void Run(State& state) {
+    std::unique_lock<std::mutex> lock(state.mutex);
+    while (true) {
+      state.condition.wait(
+          lock, [&state]() { return state.stopping || !state.tasks.empty(); });
+      if (state.tasks.empty()) {
+        return;
+      }
+      std::function<void()> task = std::move(state.tasks.front());
+      state.tasks.pop_front();
+      lock.unlock();
+      task();
+      // Releases the task's captures, which can include the queue, before
+      // taking the lock again.
+      task = nullptr;
+      lock.lock();
+    }
+  }
+
+  std::shared_ptr<State> state_;
+  std::function<void(std::function<void()> task)> post_to_platform_thread_;
+  std::thread thread_;
+};
+
+// The channel of a Flutter API method, which the API creates on the first call
+// to the method and reuses for the calls after it.
+//
+// It is shared with the replies to those calls, which use its name to report
+// connection errors.
+class PigeonInternalFlutterMethodChannel {
+ public:
+  PigeonInternalFlutterMethodChannel(
+      ::flutter::BinaryMessenger* binary_messenger, std::string name,
+      const ::flutter::MessageCodec<::flutter::EncodableValue>* codec)
+      : name_(std::move(name)), channel_(binary_messenger, name_, codec) {}
+
+  const std::string& name() const { return name_; }
+  ::flutter::BasicMessageChannel<>& channel() { return channel_; }
+
+ private:
+  std::string name_;
+  ::flutter::BasicMessageChannel<> channel_;
+};
+
 enum class AnEnum {
   kOne = 0,
   kTwo = 1,
@@ -88,6 +210,7 @@ class UnusedClass {
   const ::flutter::EncodableValue* a_field() const;
   void set_a_field(const ::flutter::EncodableValue* value_arg);
   void set_a_field(const ::flutter::EncodableValue& value_arg);
+  void set_a_field(::flutter::EncodableValue&& value_arg);
 
   bool operator==(const UnusedClass& other) const;
   bool operator!=(const UnusedClass& other) const;
@@ -99,6 +222,7 @@ class UnusedClass {
 
  private:
   static UnusedClass FromEncodableList(const ::flutter::EncodableList& list);
+  static UnusedClass FromEncodableList(::flutter::EncodableList&& list);
   ::flutter::EncodableList ToEncodableList() const;
   friend class HostIntegrationCoreApi;
   friend class FlutterIntegrationCoreApi;
@@ -140,6 +264,29 @@ class AllTypes {
                     const ::flutter::EncodableMap& object_map,
                     const ::flutter::EncodableMap& list_map,
                     const ::flutter::EncodableMap& map_map);
+  explicit AllTypes(bool a_bool, int64_t an_int, int64_t an_int64,
+                    double a_double, std::vector<uint8_t>&& a_byte_array,
+                    std::vector<int32_t>&& a4_byte_array,
+                    std::vector<int64_t>&& a8_byte_array,
+                    std::vector<double>&& a_float_array, const AnEnum& an_enum,
+                    const AnotherEnum& another_enum, std::string&& a_string,
+                    ::flutter::EncodableValue&& an_object,
+                    ::flutter::EncodableList&& list,
+                    ::flutter::EncodableList&& string_list,
+                    ::flutter::EncodableList&& int_list,
+                    ::flutter::EncodableList&& double_list,
+                    ::flutter::EncodableList&& bool_list,
+                    ::flutter::EncodableList&& enum_list,
+                    ::flutter::EncodableList&& object_list,
+                    ::flutter::EncodableList&& list_list,
+                    ::flutter::EncodableList&& map_list,
+                    ::flutter::EncodableMap&& map,
+                    ::flutter::EncodableMap&& string_map,
+                    ::flutter::EncodableMap&& int_map,
+                    ::flutter::EncodableMap&& enum_map,
+                    ::flutter::EncodableMap&& object_map,
+                    ::flutter::EncodableMap&& list_map,
+                    ::flutter::EncodableMap&& map_map);
 
   bool a_bool() const;
   void set_a_bool(bool value_arg);
@@ -155,15 +302,19 @@ class AllTypes {
 
   const std::vector<uint8_t>& a_byte_array() const;
   void set_a_byte_array(const std::vector<uint8_t>& value_arg);
+  void set_a_byte_array(std::vector<uint8_t>&& value_arg);
 
   const std::vector<int32_t>& a4_byte_array() const;
   void set_a4_byte_array(const std::vector<int32_t>& value_arg);
+  void set_a4_byte_array(std::vector<int32_t>&& value_arg);
 
   const std::vector<int64_t>& a8_byte_array() const;
   void set_a8_byte_array(const std::vector<int64_t>& value_arg);
+  void set_a8_byte_array(std::vector<int64_t>&& value_arg);
 
   const std::vector<double>& a_float_array() const;
   void set_a_float_array(const std::vector<double>& value_arg);
+  void set_a_float_array(std::vector<double>&& value_arg);
 
   const AnEnum& an_enum() const;
   void set_an_enum(const AnEnum& value_arg);
@@ -176,54 +327,71 @@ class AllTypes {
 
   const ::flutter::EncodableValue& an_object() const;
   void set_an_object(const ::flutter::EncodableValue& value_arg);
+  void set_an_object(::flutter::EncodableValue&& value_arg);
 
   const ::flutter::EncodableList& list() const;
   void set_list(const ::flutter::EncodableList& value_arg);
+  void set_list(::flutter::EncodableList&& value_arg);
 
   const ::flutter::EncodableList& string_list() const;
   void set_string_list(const ::flutter::EncodableList& value_arg);
+  void set_string_list(::flutter::EncodableList&& value_arg);
 
   const ::flutter::EncodableList& int_list() const;
   void set_int_list(const ::flutter::EncodableList& value_arg);
+  void set_int_list(::flutter::EncodableList&& value_arg);
 
   const ::flutter::EncodableList& double_list() const;
   void set_double_list(const ::flutter::EncodableList& value_arg);
+  void set_double_list(::flutter::EncodableList&& value_arg);
 
   const ::flutter::EncodableList& bool_list() const;
   void set_bool_list(const ::flutter::EncodableList& value_arg);
+  void set_bool_list(::flutter::EncodableList&& value_arg);
 
   const ::flutter::EncodableList& enum_list() const;
   void set_enum_list(const ::flutter::EncodableList& value_arg);
+  void set_enum_list(::flutter::EncodableList&& value_arg);
 
   const ::flutter::EncodableList& object_list() const;
   void set_object_list(const ::flutter::EncodableList& value_arg);
+  void set_object_list(::flutter::EncodableList&& value_arg);
 
   const ::flutter::EncodableList& list_list() const;
   void set_list_list(const ::flutter::EncodableList& value_arg);
+  void set_list_list(::flutter::EncodableList&& value_arg);
 
   const ::flutter::EncodableList& map_list() const;
   void set_map_list(const ::flutter::EncodableList& value_arg);
+  void set_map_list(::flutter::EncodableList&& value_arg);
 
   const ::flutter::EncodableMap& map() const;
   void set_map(const ::flutter::EncodableMap& value_arg);
+  void set_map(::flutter::EncodableMap&& value_arg);
 
   const ::flutter::EncodableMap& string_map() const;
   void set_string_map(const ::flutter::EncodableMap& value_arg);
+  void set_string_map(::flutter::EncodableMap&& value_arg);
 
   const ::flutter::EncodableMap& int_map() const;
   void set_int_map(const ::flutter::EncodableMap& value_arg);
+  void set_int_map(::flutter::EncodableMap&& value_arg);
 
   const ::flutter::EncodableMap& enum_map() const;
   void set_enum_map(const ::flutter::EncodableMap& value_arg);
+  void set_enum_map(::flutter::EncodableMap&& value_arg);
 
   const ::flutter::EncodableMap& object_map() const;
   void set_object_map(const ::flutter::EncodableMap& value_arg);
+  void set_object_map(::flutter::EncodableMap&& value_arg);
 
   const ::flutter::EncodableMap& list_map() const;
   void set_list_map(const ::flutter::EncodableMap& value_arg);
+  void set_list_map(::flutter::EncodableMap&& value_arg);
 
   const ::flutter::EncodableMap& map_map() const;
   void set_map_map(const ::flutter::EncodableMap& value_arg);
+  void set_map_map(::flutter::EncodableMap&& value_arg);
 
   bool operator==(const AllTypes& other) const;
   bool operator!=(const AllTypes& other) const;
@@ -234,7 +402,9 @@ class AllTypes {
   friend std::ostream& operator<<(std::ostream& os, const AllTypes& obj);
 
  private:
+  AllTypes() = default;
   static AllTypes FromEncodableList(const ::flutter::EncodableList& list);
+  static AllTypes FromEncodableList(::flutter::EncodableList&& list);
   ::flutter::EncodableList ToEncodableList() const;
   friend class AllClassesWrapper;
   friend class HostIntegrationCoreApi;
@@ -337,18 +507,22 @@ class AllNullableTypes {
   const std::vector<uint8_t>* a_nullable_byte_array() const;
   void set_a_nullable_byte_array(const std::vector<uint8_t>* value_arg);
   void set_a_nullable_byte_array(const std::vector<uint8_t>& value_arg);
+  void set_a_nullable_byte_array(std::vector<uint8_t>&& value_arg);
 
   const std::vector<int32_t>* a_nullable4_byte_array() const;
   void set_a_nullable4_byte_array(const std::vector<int32_t>* value_arg);
   void set_a_nullable4_byte_array(const std::vector<int32_t>& value_arg);
+  void set_a_nullable4_byte_array(std::vector<int32_t>&& value_arg);
 
   const std::vector<int64_t>* a_nullable8_byte_array() const;
   void set_a_nullable8_byte_array(const std::vector<int64_t>* value_arg);
   void set_a_nullable8_byte_array(const std::vector<int64_t>& value_arg);
+  void set_a_nullable8_byte_array(std::vector<int64_t>&& value_arg);
 
   const std::vector<double>* a_nullable_float_array() const;
   void set_a_nullable_float_array(const std::vector<double>* value_arg);
   void set_a_nullable_float_array(const std::vector<double>& value_arg);
+  void set_a_nullable_float_array(std::vector<double>&& value_arg);
 
   const AnEnum* a_nullable_enum() const;
   void set_a_nullable_enum(const AnEnum* value_arg);
@@ -365,82 +539,102 @@ class AllNullableTypes {
   const ::flutter::EncodableValue* a_nullable_object() const;
   void set_a_nullable_object(const ::flutter::EncodableValue* value_arg);
   void set_a_nullable_object(const ::flutter::EncodableValue& value_arg);
+  void set_a_nullable_object(::flutter::EncodableValue&& value_arg);
 
   const AllNullableTypes* all_nullable_types() const;
   void set_all_nullable_types(const AllNullableTypes* value_arg);
   void set_all_nullable_types(const AllNullableTypes& value_arg);
+  void set_all_nullable_types(AllNullableTypes&& value_arg);
 
   const ::flutter::EncodableList* list() const;
   void set_list(const ::flutter::EncodableList* value_arg);
   void set_list(const ::flutter::EncodableList& value_arg);
+  void set_list(::flutter::EncodableList&& value_arg);
 
   const ::flutter::EncodableList* string_list() const;
   void set_string_list(const ::flutter::EncodableList* value_arg);
   void set_string_list(const ::flutter::EncodableList& value_arg);
+  void set_string_list(::flutter::EncodableList&& value_arg);
 
   const ::flutter::EncodableList* int_list() const;
   void set_int_list(const ::flutter::EncodableList* value_arg);
   void set_int_list(const ::flutter::EncodableList& value_arg);
+  void set_int_list(::flutter::EncodableList&& value_arg);
 
   const ::flutter::EncodableList* double_list() const;
   void set_double_list(const ::flutter::EncodableList* value_arg);
   void set_double_list(const ::flutter::EncodableList& value_arg);
+  void set_double_list(::flutter::EncodableList&& value_arg);
 
   const ::flutter::EncodableList* bool_list() const;
   void set_bool_list(const ::flutter::EncodableList* value_arg);
   void set_bool_list(const ::flutter::EncodableList& value_arg);
+  void set_bool_list(::flutter::EncodableList&& value_arg);
 
   const ::flutter::EncodableList* enum_list() const;
   void set_enum_list(const ::flutter::EncodableList* value_arg);
   void set_enum_list(const ::flutter::EncodableList& value_arg);
+  void set_enum_list(::flutter::EncodableList&& value_arg);
 
   const ::flutter::EncodableList* object_list() const;
   void set_object_list(const ::flutter::EncodableList* value_arg);
   void set_object_list(const ::flutter::EncodableList& value_arg);
+  void set_object_list(::flutter::EncodableList&& value_arg);
 
   const ::flutter::EncodableList* list_list() const;
   void set_list_list(const ::flutter::EncodableList* value_arg);
   void set_list_list(const ::flutter::EncodableList& value_arg);
+  void set_list_list(::flutter::EncodableList&& value_arg);
 
   const ::flutter::EncodableList* map_list() const;
   void set_map_list(const ::flutter::EncodableList* value_arg);
   void set_map_list(const ::flutter::EncodableList& value_arg);
+  void set_map_list(::flutter::EncodableList&& value_arg);
 
   const ::flutter::EncodableList* recursive_class_list() const;
   void set_recursive_class_list(const ::flutter::EncodableList* value_arg);
   void set_recursive_class_list(const ::flutter::EncodableList& value_arg);
+  void set_recursive_class_list(::flutter::EncodableList&& value_arg);
 
   const ::flutter::EncodableMap* map() const;
   void set_map(const ::flutter::EncodableMap* value_arg);
   void set_map(const ::flutter::EncodableMap& value_arg);
+  void set_map(::flutter::EncodableMap&& value_arg);
 
   const ::flutter::EncodableMap* string_map() const;
   void set_string_map(const ::flutter::EncodableMap* value_arg);
   void set_string_map(const ::flutter::EncodableMap& value_arg);
+  void set_string_map(::flutter::EncodableMap&& value_arg);
 
   const ::flutter::EncodableMap* int_map() const;
   void set_int_map(const ::flutter::EncodableMap* value_arg);
   void set_int_map(const ::flutter::EncodableMap& value_arg);
+  void set_int_map(::flutter::EncodableMap&& value_arg);
 
   const ::flutter::EncodableMap* enum_map() const;
   void set_enum_map(const ::flutter::EncodableMap* value_arg);
   void set_enum_map(const ::flutter::EncodableMap& value_arg);
+  void set_enum_map(::flutter::EncodableMap&& value_arg);
 
   const ::flutter::EncodableMap* object_map() const;
   void set_object_map(const ::flutter::EncodableMap* value_arg);
   void set_object_map(const ::flutter::EncodableMap& value_arg);
+  void set_object_map(::flutter::EncodableMap&& value_arg);
 
   const ::flutter::EncodableMap* list_map() const;
   void set_list_map(const ::flutter::EncodableMap* value_arg);
   void set_list_map(const ::flutter::EncodableMap& value_arg);
+  void set_list_map(::flutter::EncodableMap&& value_arg);
 
   const ::flutter::EncodableMap* map_map() const;
   void set_map_map(const ::flutter::EncodableMap* value_arg);
   void set_map_map(const ::flutter::EncodableMap& value_arg);
+  void set_map_map(::flutter::EncodableMap&& value_arg);
 
   const ::flutter::EncodableMap* recursive_class_map() const;
   void set_recursive_class_map(const ::flutter::EncodableMap* value_arg);
   void set_recursive_class_map(const ::flutter::EncodableMap& value_arg);
+  void set_recursive_class_map(::flutter::EncodableMap&& value_arg);
 
   bool operator==(const AllNullableTypes& other) const;
   bool operator!=(const AllNullableTypes& other) const;
@@ -454,6 +648,7 @@ class AllNullableTypes {
  private:
   static AllNullableTypes FromEncodableList(
       const ::flutter::EncodableList& list);
+  static AllNullableTypes FromEncodableList(::flutter::EncodableList&& list);
   ::flutter::EncodableList ToEncodableList() const;
   friend class AllClassesWrapper;
   friend class HostIntegrationCoreApi;
@@ -553,18 +748,22 @@ class AllNullableTypesWithoutRecursion {
   const std::vector<uint8_t>* a_nullable_byte_array() const;
   void set_a_nullable_byte_array(const std::vector<uint8_t>* value_arg);
   void set_a_nullable_byte_array(const std::vector<uint8_t>& value_arg);
+  void set_a_nullable_byte_array(std::vector<uint8_t>&& value_arg);
 
   const std::vector<int32_t>* a_nullable4_byte_array() const;
   void set_a_nullable4_byte_array(const std::vector<int32_t>* value_arg);
   void set_a_nullable4_byte_array(const std::vector<int32_t>& value_arg);
+  void set_a_nullable4_byte_array(std::vector<int32_t>&& value_arg);
 
   const std::vector<int64_t>* a_nullable8_byte_array() const;
   void set_a_nullable8_byte_array(const std::vector<int64_t>* value_arg);
   void set_a_nullable8_byte_array(const std::vector<int64_t>& value_arg);
+  void set_a_nullable8_byte_array(std::vector<int64_t>&& value_arg);
 
   const std::vector<double>* a_nullable_float_array() const;
   void set_a_nullable_float_array(const std::vector<double>* value_arg);
   void set_a_nullable_float_array(const std::vector<double>& value_arg);
+  void set_a_nullable_float_array(std::vector<double>&& value_arg);
 
   const AnEnum* a_nullable_enum() const;
   void set_a_nullable_enum(const AnEnum* value_arg);
@@ -581,70 +780,87 @@ class AllNullableTypesWithoutRecursion {
   const ::flutter::EncodableValue* a_nullable_object() const;
   void set_a_nullable_object(const ::flutter::EncodableValue* value_arg);
   void set_a_nullable_object(const ::flutter::EncodableValue& value_arg);
+  void set_a_nullable_object(::flutter::EncodableValue&& value_arg);
 
   const ::flutter::EncodableList* list() const;
   void set_list(const ::flutter::EncodableList* value_arg);
   void set_list(const ::flutter::EncodableList& value_arg);
+  void set_list(::flutter::EncodableList&& value_arg);
 
   const ::flutter::EncodableList* string_list() const;
   void set_string_list(const ::flutter::EncodableList* value_arg);
   void set_string_list(const ::flutter::EncodableList& value_arg);
+  void set_string_list(::flutter::EncodableList&& value_arg);
 
   const ::flutter::EncodableList* int_list() const;
   void set_int_list(const ::flutter::EncodableList* value_arg);
   void set_int_list(const ::flutter::EncodableList& value_arg);
+  void set_int_list(::flutter::EncodableList&& value_arg);
 
   const ::flutter::EncodableList* double_list() const;
   void set_double_list(const ::flutter::EncodableList* value_arg);
   void set_double_list(const ::flutter::EncodableList& value_arg);
+  void set_double_list(::flutter::EncodableList&& value_arg);
 
   const ::flutter::EncodableList* bool_list() const;
   void set_bool_list(const ::flutter::EncodableList* value_arg);
   void set_bool_list(const ::flutter::EncodableList& value_arg);
+  void set_bool_list(::flutter::EncodableList&& value_arg);
 
   const ::flutter::EncodableList* enum_list() const;
   void set_enum_list(const ::flutter::EncodableList* value_arg);
   void set_enum_list(const ::flutter::EncodableList& value_arg);
+  void set_enum_list(::flutter::EncodableList&& value_arg);
 
   const ::flutter::EncodableList* object_list() const;
   void set_object_list(const ::flutter::EncodableList* value_arg);
   void set_object_list(const ::flutter::EncodableList& value_arg);
+  void set_object_list(::flutter::EncodableList&& value_arg);
 
   const ::flutter::EncodableList* list_list() const;
   void set_list_list(const ::flutter::EncodableList* value_arg);
   void set_list_list(const ::flutter::EncodableList& value_arg);
+  void set_list_list(::flutter::EncodableList&& value_arg);
 
   const ::flutter::EncodableList* map_list() const;
   void set_map_list(const ::flutter::EncodableList* value_arg);
   void set_map_list(const ::flutter::EncodableList& value_arg);
+  void set_map_list(::flutter::EncodableList&& value_arg);
 
   const ::flutter::EncodableMap* map() const;
   void set_map(const ::flutter::EncodableMap* value_arg);
   void set_map(const ::flutter::EncodableMap& value_arg);
+  void set_map(::flutter::EncodableMap&& value_arg);
 
   const ::flutter::EncodableMap* string_map() const;
   void set_string_map(const ::flutter::EncodableMap* value_arg);
   void set_string_map(const ::flutter::EncodableMap& value_arg);
+  void set_string_map(::flutter::EncodableMap&& value_arg);
 
   const ::flutter::EncodableMap* int_map() const;
   void set_int_map(const ::flutter::EncodableMap* value_arg);
   void set_int_map(const ::flutter::EncodableMap& value_arg);
+  void set_int_map(::flutter::EncodableMap&& value_arg);
 
   const ::flutter::EncodableMap* enum_map() const;
   void set_enum_map(const ::flutter::EncodableMap* value_arg);
   void set_enum_map(const ::flutter::EncodableMap& value_arg);
+  void set_enum_map(::flutter::EncodableMap&& value_arg);
 
   const ::flutter::EncodableMap* object_map() const;
   void set_object_map(const ::flutter::EncodableMap* value_arg);
   void set_object_map(const ::flutter::EncodableMap& value_arg);
+  void set_object_map(::flutter::EncodableMap&& value_arg);
 
   const ::flutter::EncodableMap* list_map() const;
   void set_list_map(const ::flutter::EncodableMap* value_arg);
   void set_list_map(const ::flutter::EncodableMap& value_arg);
+  void set_list_map(::flutter::EncodableMap&& value_arg);
 
   const ::flutter::EncodableMap* map_map() const;
   void set_map_map(const ::flutter::EncodableMap* value_arg);
   void set_map_map(const ::flutter::EncodableMap& value_arg);
+  void set_map_map(::flutter::EncodableMap&& value_arg);
 
   bool operator==(const AllNullableTypesWithoutRecursion& other) const;
   bool operator!=(const AllNullableTypesWithoutRecursion& other) const;
@@ -658,6 +874,8 @@ class AllNullableTypesWithoutRecursion {
  private:
   static AllNullableTypesWithoutRecursion FromEncodableList(
       const ::flutter::EncodableList& list);
+  static AllNullableTypesWithoutRecursion FromEncodableList(
+      ::flutter::EncodableList&& list);
   ::flutter::EncodableList ToEncodableList() const;
   friend class AllClassesWrapper;
   friend class HostIntegrationCoreApi;
@@ -710,6 +928,9 @@ class AllClassesWrapper {
   explicit AllClassesWrapper(const AllNullableTypes& all_nullable_types,
                              const ::flutter::EncodableList& class_list,
                              const ::flutter::EncodableMap& class_map);
+  explicit AllClassesWrapper(AllNullableTypes&& all_nullable_types,
+                             ::flutter::EncodableList&& class_list,
+                             ::flutter::EncodableMap&& class_map);
 
   // Constructs an object setting all fields.
   explicit AllClassesWrapper(
@@ -720,6 +941,14 @@ class AllClassesWrapper {
       const ::flutter::EncodableList* nullable_class_list,
       const ::flutter::EncodableMap& class_map,
       const ::flutter::EncodableMap* nullable_class_map);
+  explicit AllClassesWrapper(
+      AllNullableTypes&& all_nullable_types,
+      const AllNullableTypesWithoutRecursion*
+          all_nullable_types_without_recursion,
+      const AllTypes* all_types, ::flutter::EncodableList&& class_list,
+      const ::flutter::EncodableList* nullable_class_list,
+      ::flutter::EncodableMap&& class_map,
+      const ::flutter::EncodableMap* nullable_class_map);
 
   ~AllClassesWrapper() = default;
   AllClassesWrapper(const AllClassesWrapper& other);
@@ -728,6 +957,7 @@ class AllClassesWrapper {
   AllClassesWrapper& operator=(AllClassesWrapper&& other) noexcept = default;
   const AllNullableTypes& all_nullable_types() const;
   void set_all_nullable_types(const AllNullableTypes& value_arg);
+  void set_all_nullable_types(AllNullableTypes&& value_arg);
 
   const AllNullableTypesWithoutRecursion* all_nullable_types_without_recursion()
       const;
@@ -735,24 +965,31 @@ class AllClassesWrapper {
       const AllNullableTypesWithoutRecursion* value_arg);
   void set_all_nullable_types_without_recursion(
       const AllNullableTypesWithoutRecursion& value_arg);
+  void set_all_nullable_types_without_recursion(
+      AllNullableTypesWithoutRecursion&& value_arg);
 
   const AllTypes* all_types() const;
   void set_all_types(const AllTypes* value_arg);
   void set_all_types(const AllTypes& value_arg);
+  void set_all_types(AllTypes&& value_arg);
 
   const ::flutter::EncodableList& class_list() const;
   void set_class_list(const ::flutter::EncodableList& value_arg);
+  void set_class_list(::flutter::EncodableList&& value_arg);
 
   const ::flutter::EncodableList* nullable_class_list() const;
   void set_nullable_class_list(const ::flutter::EncodableList* value_arg);
   void set_nullable_class_list(const ::flutter::EncodableList& value_arg);
+  void set_nullable_class_list(::flutter::EncodableList&& value_arg);
 
   const ::flutter::EncodableMap& class_map() const;
   void set_class_map(const ::flutter::EncodableMap& value_arg);
+  void set_class_map(::flutter::EncodableMap&& value_arg);
 
   const ::flutter::EncodableMap* nullable_class_map() const;
   void set_nullable_class_map(const ::flutter::EncodableMap* value_arg);
   void set_nullable_class_map(const ::flutter::EncodableMap& value_arg);
+  void set_nullable_class_map(::flutter::EncodableMap&& value_arg);
 
   bool operator==(const AllClassesWrapper& other) const;
   bool operator!=(const AllClassesWrapper& other) const;
@@ -764,8 +1001,10 @@ class AllClassesWrapper {
                                   const AllClassesWrapper& obj);
 
  private:
+  AllClassesWrapper() = default;
   static AllClassesWrapper FromEncodableList(
       const ::flutter::EncodableList& list);
+  static AllClassesWrapper FromEncodableList(::flutter::EncodableList&& list);
   ::flutter::EncodableList ToEncodableList() const;
   friend class HostIntegrationCoreApi;
   friend class FlutterIntegrationCoreApi;
@@ -798,6 +1037,7 @@ class TestMessage {
   const ::flutter::EncodableList* test_list() const;
   void set_test_list(const ::flutter::EncodableList* value_arg);
   void set_test_list(const ::flutter::EncodableList& value_arg);
+  void set_test_list(::flutter::EncodableList&& value_arg);
 
   bool operator==(const TestMessage& other) const;
   bool operator!=(const TestMessage& other) const;
@@ -809,6 +1049,7 @@ class TestMessage {
 
  private:
   static TestMessage FromEncodableList(const ::flutter::EncodableList& list);
+  static TestMessage FromEncodableList(::flutter::EncodableList&& list);
   ::flutter::EncodableList ToEncodableList() const;
   friend class HostIntegrationCoreApi;
   friend class FlutterIntegrationCoreApi;
@@ -835,6 +1076,67 @@ class PigeonInternalCodecSerializer
  protected:
   ::flutter::EncodableValue ReadValueOfType(
       uint8_t type, ::flutter::ByteStreamReader* stream) const override;
+
+ private:
+  // Each of these reads a value that was written with the given type
+  // directly from the stream, without building an intermediate
+  // EncodableValue for it. Values written with any other type are
+  // read with ReadValueOfType and converted.
+  bool ReadEncodedFieldList(::flutter::ByteStreamReader* stream,
+                            size_t field_count,
+                            ::flutter::EncodableList* list) const;
+  bool ReadEncodedBool(uint8_t type, ::flutter::ByteStreamReader* stream) const;
+  int64_t ReadEncodedInt64(uint8_t type,
+                           ::flutter::ByteStreamReader* stream) const;
+  double ReadEncodedDouble(uint8_t type,
+                           ::flutter::ByteStreamReader* stream) const;
+  std::string ReadEncodedString(uint8_t type,
+                                ::flutter::ByteStreamReader* stream) const;
+  template <typename T>
+  std::vector<T> ReadEncodedTypedData(
+      uint8_t type, ::flutter::ByteStreamReader* stream) const;
+  UnusedClass ReadUnusedClass(uint8_t type,
+                              ::flutter::ByteStreamReader* stream) const;
+  AllTypes ReadAllTypes(uint8_t type,
+                        ::flutter::ByteStreamReader* stream) const;
+  AllNullableTypes ReadAllNullableTypes(
+      uint8_t type, ::flutter::ByteStreamReader* stream) const;
+  AllNullableTypesWithoutRecursion ReadAllNullableTypesWithoutRecursion(
+      uint8_t type, ::flutter::ByteStreamReader* stream) const;
+  AllClassesWrapper ReadAllClassesWrapper(
+      uint8_t type, ::flutter::ByteStreamReader* stream) const;
+  TestMessage ReadTestMessage(uint8_t type,
+                              ::flutter::ByteStreamReader* stream) const;
+
+  // Each of these writes a value directly to the stream, producing the
+  // same bytes as WriteValue would for the EncodableValue that it
+  // converts to.
+  void WriteEncodedBool(bool value, ::flutter::ByteStreamWriter* stream) const;
+  void WriteEncodedInt64(int64_t value,
+                         ::flutter::ByteStreamWriter* stream) const;
+  void WriteEncodedDouble(double value,
+                          ::flutter::ByteStreamWriter* stream) const;
+  void WriteEncodedString(const std::string& value,
+                          ::flutter::ByteStreamWriter* stream) const;
+  template <typename T>
+  void WriteEncodedTypedData(const std::vector<T>& value,
+                             ::flutter::ByteStreamWriter* stream) const;
+  void WriteEncodedList(const ::flutter::EncodableList& value,
+                        ::flutter::ByteStreamWriter* stream) const;
+  void WriteEncodedMap(const ::flutter::EncodableMap& value,
+                       ::flutter::ByteStreamWriter* stream) const;
+  void WriteFields(const UnusedClass& value,
+                   ::flutter::ByteStreamWriter* stream) const;
+  void WriteFields(const AllTypes& value,
+                   ::flutter::ByteStreamWriter* stream) const;
+  void WriteFields(const AllNullableTypes& value,
+                   ::flutter::ByteStreamWriter* stream) const;
+  void WriteFields(const AllNullableTypesWithoutRecursion& value,
+                   ::flutter::ByteStreamWriter* stream) const;
+  void WriteFields(const AllClassesWrapper& value,
+                   ::flutter::ByteStreamWriter* stream) const;
+  void WriteFields(const TestMessage& value,
+                   ::flutter::ByteStreamWriter* stream) const;
 };
 
 // The core interface that each host language plugin must implement in
@@ -1432,6 +1734,13 @@ class HostIntegrationCoreApi {
   static void SetUp(::flutter::BinaryMessenger* binary_messenger,
                     HostIntegrationCoreApi* api,
                     const std::string& message_channel_suffix);
+  // Sets up an instance of `HostIntegrationCoreApi` to handle messages through
+  // the `binary_messenger`, running the methods that use a background task
+  // queue on `task_queue`, or on the platform thread if it is null.
+  static void SetUp(::flutter::BinaryMessenger* binary_messenger,
+                    HostIntegrationCoreApi* api,
+                    const std::string& message_channel_suffix,
+                    std::shared_ptr<PigeonTaskQueue> task_queue);
   static ::flutter::EncodableValue WrapError(std::string_view error_message);
   static ::flutter::EncodableValue WrapError(const FlutterError& error);
 
@@ -1697,6 +2006,93 @@ class FlutterIntegrationCoreApi {
  private:
   ::flutter::BinaryMessenger* binary_messenger_;
   std::string message_channel_suffix_;
+  // The channel of each method, created on its first call.
+  std::shared_ptr<PigeonInternalFlutterMethodChannel> noop_channel_;
+  std::shared_ptr<PigeonInternalFlutterMethodChannel> throw_error_channel_;
+  std::shared_ptr<PigeonInternalFlutterMethodChannel>
+      throw_error_from_void_channel_;
+  std::shared_ptr<PigeonInternalFlutterMethodChannel> echo_all_types_channel_;
+  std::shared_ptr<PigeonInternalFlutterMethodChannel>
+      echo_all_nullable_types_channel_;
+  std::shared_ptr<PigeonInternalFlutterMethodChannel>
+      send_multiple_nullable_types_channel_;
+  std::shared_ptr<PigeonInternalFlutterMethodChannel>
+      echo_all_nullable_types_without_recursion_channel_;
+  std::shared_ptr<PigeonInternalFlutterMethodChannel>
+      send_multiple_nullable_types_without_recursion_channel_;
+  std::shared_ptr<PigeonInternalFlutterMethodChannel> echo_bool_channel_;
+  std::shared_ptr<PigeonInternalFlutterMethodChannel> echo_int_channel_;
+  std::shared_ptr<PigeonInternalFlutterMethodChannel> echo_double_channel_;
+  std::shared_ptr<PigeonInternalFlutterMethodChannel> echo_string_channel_;
+  std::shared_ptr<PigeonInternalFlutterMethodChannel> echo_uint8_list_channel_;
+  std::shared_ptr<PigeonInternalFlutterMethodChannel> echo_list_channel_;
+  std::shared_ptr<PigeonInternalFlutterMethodChannel> echo_enum_list_channel_;
+  std::shared_ptr<PigeonInternalFlutterMethodChannel> echo_class_list_channel_;
+  std::shared_ptr<PigeonInternalFlutterMethodChannel>
+      echo_non_null_enum_list_channel_;
+  std::shared_ptr<PigeonInternalFlutterMethodChannel>
+      echo_non_null_class_list_channel_;
+  std::shared_ptr<PigeonInternalFlutterMethodChannel> echo_map_channel_;
+  std::shared_ptr<PigeonInternalFlutterMethodChannel> echo_string_map_channel_;
+  std::shared_ptr<PigeonInternalFlutterMethodChannel> echo_int_map_channel_;
+  std::shared_ptr<PigeonInternalFlutterMethodChannel> echo_enum_map_channel_;
+  std::shared_ptr<PigeonInternalFlutterMethodChannel> echo_class_map_channel_;
+  std::shared_ptr<PigeonInternalFlutterMethodChannel>
+      echo_non_null_string_map_channel_;
+  std::shared_ptr<PigeonInternalFlutterMethodChannel>
+      echo_non_null_int_map_channel_;
+  std::shared_ptr<PigeonInternalFlutterMethodChannel>
+      echo_non_null_enum_map_channel_;
+  std::shared_ptr<PigeonInternalFlutterMethodChannel>
+      echo_non_null_class_map_channel_;
+  std::shared_ptr<PigeonInternalFlutterMethodChannel> echo_enum_channel_;
+  std::shared_ptr<PigeonInternalFlutterMethodChannel>
+      echo_another_enum_channel_;
+  std::shared_ptr<PigeonInternalFlutterMethodChannel>
+      echo_nullable_bool_channel_;
+  std::shared_ptr<PigeonInternalFlutterMethodChannel>
+      echo_nullable_int_channel_;
+  std::shared_ptr<PigeonInternalFlutterMethodChannel>
+      echo_nullable_double_channel_;
+  std::shared_ptr<PigeonInternalFlutterMethodChannel>
+      echo_nullable_string_channel_;
+  std::shared_ptr<PigeonInternalFlutterMethodChannel>
+      echo_nullable_uint8_list_channel_;
+  std::shared_ptr<PigeonInternalFlutterMethodChannel>
+      echo_nullable_list_channel_;
+  std::shared_ptr<PigeonInternalFlutterMethodChannel>
+      echo_nullable_enum_list_channel_;
+  std::shared_ptr<PigeonInternalFlutterMethodChannel>
+      echo_nullable_class_list_channel_;
+  std::shared_ptr<PigeonInternalFlutterMethodChannel>
+      echo_nullable_non_null_enum_list_channel_;
+  std::shared_ptr<PigeonInternalFlutterMethodChannel>
+      echo_nullable_non_null_class_list_channel_;
+  std::shared_ptr<PigeonInternalFlutterMethodChannel>
+      echo_nullable_map_channel_;
+  std::shared_ptr<PigeonInternalFlutterMethodChannel>
+      echo_nullable_string_map_channel_;
+  std::shared_ptr<PigeonInternalFlutterMethodChannel>
+      echo_nullable_int_map_channel_;
+  std::shared_ptr<PigeonInternalFlutterMethodChannel>
+      echo_nullable_enum_map_channel_;
+  std::shared_ptr<PigeonInternalFlutterMethodChannel>
+      echo_nullable_class_map_channel_;
+  std::shared_ptr<PigeonInternalFlutterMethodChannel>
+      echo_nullable_non_null_string_map_channel_;
+  std::shared_ptr<PigeonInternalFlutterMethodChannel>
+      echo_nullable_non_null_int_map_channel_;
+  std::shared_ptr<PigeonInternalFlutterMethodChannel>
+      echo_nullable_non_null_enum_map_channel_;
+  std::shared_ptr<PigeonInternalFlutterMethodChannel>
+      echo_nullable_non_null_class_map_channel_;
+  std::shared_ptr<PigeonInternalFlutterMethodChannel>
+      echo_nullable_enum_channel_;
+  std::shared_ptr<PigeonInternalFlutterMethodChannel>
+      echo_another_nullable_enum_channel_;
+  std::shared_ptr<PigeonInternalFlutterMethodChannel> noop_async_channel_;
+  std::shared_ptr<PigeonInternalFlutterMethodChannel>
+      echo_async_string_channel_;
 };
 
 // An API that can be implemented for minimal, compile-only tests.
@@ -1774,6 +2170,10 @@ class FlutterSmallApi {
  private:
   ::flutter::BinaryMessenger* binary_messenger_;
   std::string message_channel_suffix_;
+  // The channel of each method, created on its first call.
+  std::shared_ptr<PigeonInternalFlutterMethodChannel>
+      echo_wrapped_list_channel_;
+  std::shared_ptr<PigeonInternalFlutterMethodChannel> echo_string_channel_;
 };
 
 }  // namespace core_tests_pigeontest
@@ -0,0 +1,201 @@
+// Copyright 2013 The Flutter Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <flutter/encodable_value.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "pigeon/chunked_bytes.gen.h"
+#include "test/utils/fake_host_messenger.h"
+
+namespace chunked_bytes_pigeontest {
+
+namespace {
+using flutter::EncodableList;
+using flutter::EncodableValue;
+using testing::FakeHostMessenger;
+
+constexpr char kEchoBytesChannelName[] =
+    "dev.flutter.pigeon.pigeon_integration_tests.ChunkedBytesHostApi."
+    "echoBytes";
+constexpr char kCountBytesChannelName[] =
+    "dev.flutter.pigeon.pigeon_integration_tests.ChunkedBytesHostApi."
+    "countBytes";
+constexpr char kEchoBytesChunksChannelName[] =
+    "dev.flutter.pigeon.pigeon_integration_tests.ChunkedBytesHostApi."
+    "echoBytes.chunks";
+constexpr char kArgumentChunksChannelName[] = "argument.chunks";
+
+// The size of the chunks that the host reads its arguments in.
+constexpr size_t kHostChunkSize = 3;
+
+// Reads |reader| to the end, and calls |result| with the number of bytes read.
+void CountChunks(std::shared_ptr<ByteStreamReader> reader, int64_t count,
+                 std::function<void(ErrorOr<int64_t> reply)> result) {
+  reader->ReadChunk(
+      kHostChunkSize,
+      [reader, count, result](std::vector<uint8_t> chunk) {
+        if (chunk.empty()) {
+          result(count);
+          return;
+        }
+        CountChunks(reader, count + static_cast<int64_t>(chunk.size()),
+                    result);
+      },
+      [result](const FlutterError& error) { result(error); });
+}
+
+class TestHostApi : public ChunkedBytesHostApi {
+ public:
+  TestHostApi() {}
+  virtual ~TestHostApi() {}
+
+ protected:
+  void EchoBytes(std::unique_ptr<ByteStreamReader> data,
+                 std::function<void(ErrorOr<std::unique_ptr<ByteStreamReader>>
+                                        reply)>
+                     result) override {
+    // The argument is streamed straight back as it is read.
+    result(std::move(data));
+  }
+
+  void CountBytes(std::unique_ptr<ByteStreamReader> data,
+                  std::function<void(ErrorOr<int64_t> reply)> result) override {
+    CountChunks(std::move(data), 0, std::move(result));
+  }
+};
+
+// Acts as the Dart side of a streamed argument, serving |data| on
+// kArgumentChunksChannelName.
+class DartByteServer {
+ public:
+  explicit DartByteServer(std::vector<uint8_t> data) : data_(std::move(data)) {}
+
+  EncodableValue ServeChunk(const std::string& channel,
+                            const EncodableValue& message) {
+    EXPECT_EQ(channel, kArgumentChunksChannelName);
+    requests_++;
+    const size_t size = static_cast<size_t>(message.LongValue());
+    const size_t end = std::min(data_.size(), offset_ + size);
+    std::vector<uint8_t> chunk(data_.begin() + offset_, data_.begin() + end);
+    offset_ = end;
+    return EncodableValue(chunk);
+  }
+
+  int requests() const { return requests_; }
+
+ private:
+  std::vector<uint8_t> data_;
+  size_t offset_ = 0;
+  int requests_ = 0;
+};
+
+std::vector<uint8_t> TestBytes() {
+  std::vector<uint8_t> bytes;
+  for (uint8_t i = 0; i < 10; i++) {
+    bytes.push_back(i);
+  }
+  return bytes;
+}
+
+// Sends |message| to the host method on |channel|, and returns the reply.
+EncodableList SendMessage(FakeHostMessenger* messenger,
+                          const std::string& channel, EncodableValue message) {
+  std::optional<EncodableList> result;
+  messenger->SendHostMessage(channel, message,
+                             [&result](const EncodableValue& reply) {
+                               result = std::get<EncodableList>(reply);
+                             });
+  EXPECT_TRUE(result.has_value());
+  return result.value_or(EncodableList());
+}
+}  // namespace
+
+TEST(ChunkedBytes, HostApiReadsArgumentInChunks) {
+  FakeHostMessenger messenger(&ChunkedBytesHostApi::GetCodec());
+  DartByteServer server(TestBytes());
+  messenger.SetDartMessageResponder(
+      [&server](const std::string& channel, const EncodableValue& message) {
+        return server.ServeChunk(channel, message);
+      });
+  TestHostApi api;
+  ChunkedBytesHostApi::SetUp(&messenger, &api);
+
+  EncodableList reply = SendMessage(
+      &messenger, kCountBytesChannelName,
+      EncodableValue(EncodableList{EncodableValue(kArgumentChunksChannelName)}));
+
+  ASSERT_EQ(reply.size(), 1);
+  EXPECT_EQ(reply[0].LongValue(), 10);
+  // Four chunks of at most three bytes, and the empty chunk at the end.
+  EXPECT_EQ(server.requests(), 5);
+}
+
+TEST(ChunkedBytes, HostApiReturnsStream) {
+  FakeHostMessenger messenger(&ChunkedBytesHostApi::GetCodec());
+  DartByteServer server(TestBytes());
+  messenger.SetDartMessageResponder(
+      [&server](const std::string& channel, const EncodableValue& message) {
+        return server.ServeChunk(channel, message);
+      });
+  TestHostApi api;
+  ChunkedBytesHostApi::SetUp(&messenger, &api);
+
+  EncodableList reply = SendMessage(
+      &messenger, kEchoBytesChannelName,
+      EncodableValue(EncodableList{EncodableValue(kArgumentChunksChannelName)}));
+  ASSERT_EQ(reply.size(), 1);
+  const int64_t stream_id = reply[0].LongValue();
+
+  std::vector<uint8_t> echoed;
+  while (true) {
+    EncodableList chunk_reply =
+        SendMessage(&messenger, kEchoBytesChunksChannelName,
+                    EncodableValue(EncodableList{EncodableValue(stream_id),
+                                                 EncodableValue(4)}));
+    ASSERT_EQ(chunk_reply.size(), 1);
+    const auto& chunk = std::get<std::vector<uint8_t>>(chunk_reply[0]);
+    EXPECT_LE(chunk.size(), 4);
+    if (chunk.empty()) {
+      break;
+    }
+    echoed.insert(echoed.end(), chunk.begin(), chunk.end());
+  }
+  EXPECT_EQ(echoed, TestBytes());
+
+  // The stream is released once it has been read to the end.
+  EncodableList error_reply =
+      SendMessage(&messenger, kEchoBytesChunksChannelName,
+                  EncodableValue(EncodableList{EncodableValue(stream_id),
+                                               EncodableValue(4)}));
+  ASSERT_EQ(error_reply.size(), 3);
+  EXPECT_EQ(std::get<std::string>(error_reply[0]), "unknown-stream");
+}
+
+TEST(ChunkedBytes, ArgumentReadFailsWithoutReply) {
+  FakeHostMessenger messenger(&ChunkedBytesHostApi::GetCodec());
+  messenger.SetDartMessageResponder(
+      [](const std::string& channel, const EncodableValue& message) {
+        // Not a chunk, as if Dart had no handler for the channel.
+        return EncodableValue();
+      });
+  TestHostApi api;
+  ChunkedBytesHostApi::SetUp(&messenger, &api);
+
+  EncodableList reply = SendMessage(
+      &messenger, kCountBytesChannelName,
+      EncodableValue(EncodableList{EncodableValue(kArgumentChunksChannelName)}));
+
+  ASSERT_EQ(reply.size(), 3);
+  EXPECT_EQ(std::get<std::string>(reply[0]), "channel-error");
+}
+
+}  // namespace chunked_bytes_pigeontest
@@ -0,0 +1,209 @@
+// Copyright 2013 The Flutter Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <flutter/encodable_value.h>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "pigeon/columnar.gen.h"
+#include "test/utils/fake_host_messenger.h"
+
+namespace columnar_pigeontest {
+
+namespace {
+using flutter::EncodableList;
+using flutter::EncodableValue;
+using testing::FakeHostMessenger;
+
+constexpr char kEchoPointsChannelName[] =
+    "dev.flutter.pigeon.pigeon_integration_tests.ColumnarHostApi.echoPoints";
+constexpr char kSumValidValuesChannelName[] =
+    "dev.flutter.pigeon.pigeon_integration_tests.ColumnarHostApi."
+    "sumValidValues";
+constexpr char kEchoPointsAsyncChannelName[] =
+    "dev.flutter.pigeon.pigeon_integration_tests.ColumnarHostApi."
+    "echoPointsAsync";
+
+class TestHostApi : public ColumnarHostApi {
+ public:
+  TestHostApi() {}
+  virtual ~TestHostApi() {}
+
+ protected:
+  ErrorOr<TracePointColumns> EchoPoints(
+      const TracePointColumns& points) override {
+    return points;
+  }
+
+  ErrorOr<double> SumValidValues(const TracePointColumns& points) override {
+    const std::vector<double>& values = points.value();
+    const std::vector<uint8_t>& is_valid = points.is_valid();
+    double sum = 0.0;
+    for (size_t i = 0; i < points.size(); i++) {
+      if (is_valid[i]) {
+        sum += values[i];
+      }
+    }
+    return sum;
+  }
+
+  void EchoPointsAsync(
+      const TracePointColumns& points,
+      std::function<void(ErrorOr<TracePointColumns> reply)> result) override {
+    result(points);
+  }
+};
+
+// Returns the columns Dart sends for a list of three points.
+EncodableValue PointsColumns() {
+  return EncodableValue(EncodableList{
+      EncodableValue(std::vector<int64_t>{10, 20, 30}),
+      EncodableValue(std::vector<double>{0.5, 1.5, 2.5}),
+      EncodableValue(std::vector<uint8_t>{1, 0, 1}),
+      EncodableValue(EncodableList{EncodableValue("a"), EncodableValue("b"),
+                                   EncodableValue("c")}),
+  });
+}
+
+// Sends |columns| as the only argument of the host method on |channel|, and
+// returns the result of the reply.
+EncodableValue SendPoints(FakeHostMessenger* messenger,
+                          const std::string& channel, EncodableValue columns) {
+  std::optional<EncodableValue> result;
+  messenger->SendHostMessage(
+      channel, EncodableValue(EncodableList{std::move(columns)}),
+      [&result](const EncodableValue& reply) {
+        result = std::get<EncodableList>(reply)[0];
+      });
+  EXPECT_TRUE(result.has_value());
+  return result.value_or(EncodableValue());
+}
+}  // namespace
+
+TEST(Columnar, HostApiReadsColumns) {
+  FakeHostMessenger messenger(&ColumnarHostApi::GetCodec());
+  TestHostApi api;
+  ColumnarHostApi::SetUp(&messenger, &api);
+
+  EncodableValue result =
+      SendPoints(&messenger, kSumValidValuesChannelName, PointsColumns());
+
+  EXPECT_EQ(std::get<double>(result), 3.0);
+}
+
+TEST(Columnar, HostApiReturnsColumns) {
+  FakeHostMessenger messenger(&ColumnarHostApi::GetCodec());
+  TestHostApi api;
+  ColumnarHostApi::SetUp(&messenger, &api);
+
+  EXPECT_EQ(SendPoints(&messenger, kEchoPointsChannelName, PointsColumns()),
+            PointsColumns());
+  EXPECT_EQ(
+      SendPoints(&messenger, kEchoPointsAsyncChannelName, PointsColumns()),
+      PointsColumns());
+}
+
+TEST(Columnar, EmptyList) {
+  FakeHostMessenger messenger(&ColumnarHostApi::GetCodec());
+  TestHostApi api;
+  ColumnarHostApi::SetUp(&messenger, &api);
+
+  EncodableValue empty_columns(EncodableList{
+      EncodableValue(std::vector<int64_t>()),
+      EncodableValue(std::vector<double>()),
+      EncodableValue(std::vector<uint8_t>()),
+      EncodableValue(EncodableList()),
+  });
+  EXPECT_EQ(SendPoints(&messenger, kEchoPointsChannelName, empty_columns),
+            empty_columns);
+  EXPECT_EQ(std::get<double>(SendPoints(
+                &messenger, kSumValidValuesChannelName, empty_columns)),
+            0.0);
+}
+
+TEST(Columnar, MismatchedColumnsReplyWithError) {
+  FakeHostMessenger messenger(&ColumnarHostApi::GetCodec());
+  TestHostApi api;
+  ColumnarHostApi::SetUp(&messenger, &api);
+
+  EncodableValue short_column(EncodableList{
+      EncodableValue(std::vector<int64_t>{10, 20, 30}),
+      EncodableValue(std::vector<double>{0.5, 1.5, 2.5}),
+      EncodableValue(std::vector<uint8_t>{1, 0}),
+      EncodableValue(EncodableList{EncodableValue("a"), EncodableValue("b"),
+                                   EncodableValue("c")}),
+  });
+  EncodableValue wrong_type(EncodableList{
+      EncodableValue(std::vector<double>{10, 20, 30}),
+      EncodableValue(std::vector<double>{0.5, 1.5, 2.5}),
+      EncodableValue(std::vector<uint8_t>{1, 0, 1}),
+      EncodableValue(EncodableList{EncodableValue("a"), EncodableValue("b"),
+                                   EncodableValue("c")}),
+  });
+  EncodableValue missing_column(EncodableList{
+      EncodableValue(std::vector<int64_t>{10, 20, 30}),
+      EncodableValue(std::vector<double>{0.5, 1.5, 2.5}),
+      EncodableValue(std::vector<uint8_t>{1, 0, 1}),
+  });
+  for (const EncodableValue& columns :
+       {short_column, wrong_type, missing_column}) {
+    std::optional<EncodableList> reply;
+    messenger.SendHostMessage(
+        kSumValidValuesChannelName, EncodableValue(EncodableList{columns}),
+        [&reply](const EncodableValue& value) {
+          reply = std::get<EncodableList>(value);
+        });
+    ASSERT_TRUE(reply.has_value());
+    // Errors are sent as a list of the code, message and details.
+    EXPECT_EQ(reply->size(), 3);
+  }
+}
+
+TEST(Columnar, ConstructedColumns) {
+  TracePointColumns points(
+      std::vector<int64_t>{10, 20}, std::vector<double>{0.5, 1.5},
+      std::vector<uint8_t>{1, 0},
+      EncodableList{EncodableValue("a"), EncodableValue("b")});
+
+  EXPECT_EQ(points.size(), 2);
+  EXPECT_EQ(points.timestamp(), (std::vector<int64_t>{10, 20}));
+  EXPECT_EQ(points.value(), (std::vector<double>{0.5, 1.5}));
+  EXPECT_EQ(points.is_valid(), (std::vector<uint8_t>{1, 0}));
+  EXPECT_EQ(std::get<std::string>(points.label()[1]), "b");
+  EXPECT_EQ(TracePointColumns().size(), 0);
+}
+
+TEST(Columnar, FlutterApiSendsColumns) {
+  FakeHostMessenger messenger(&ColumnarFlutterApi::GetCodec());
+  std::optional<EncodableValue> sent_columns;
+  messenger.SetDartMessageHandler(
+      [&sent_columns](const std::string& channel, const uint8_t* message,
+                      size_t message_size) {
+        std::unique_ptr<EncodableValue> args =
+            ColumnarFlutterApi::GetCodec().DecodeMessage(message,
+                                                         message_size);
+        sent_columns = std::get<EncodableList>(*args)[0];
+      });
+  ColumnarFlutterApi api(&messenger);
+
+  api.EchoPoints(
+      TracePointColumns(
+          std::vector<int64_t>{10, 20, 30}, std::vector<double>{0.5, 1.5, 2.5},
+          std::vector<uint8_t>{1, 0, 1},
+          EncodableList{EncodableValue("a"), EncodableValue("b"),
+                        EncodableValue("c")}),
+      [](const TracePointColumns& points) {},
+      [](const FlutterError& error) {});
+
+  ASSERT_TRUE(sent_columns.has_value());
+  EXPECT_EQ(*sent_columns, PointsColumns());
+}
+
+}  // namespace columnar_pigeontest
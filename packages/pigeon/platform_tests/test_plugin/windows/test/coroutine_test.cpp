@@ -0,0 +1,218 @@
+// Copyright 2013 The Flutter Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <flutter/binary_messenger.h>
+#include <flutter/encodable_value.h>
+#include <gtest/gtest.h>
+
+#include <coroutine>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "pigeon/core_tests_coroutines.gen.h"
+#include "test/utils/fake_host_messenger.h"
+
+// Tests the APIs generated with CppOptions.coroutines.
+namespace core_tests_coroutines_pigeontest {
+
+namespace {
+using flutter::EncodableList;
+using flutter::EncodableValue;
+using testing::FakeHostMessenger;
+
+constexpr char kEchoChannelName[] =
+    "dev.flutter.pigeon.pigeon_integration_tests.HostSmallApi.echo";
+constexpr char kVoidVoidChannelName[] =
+    "dev.flutter.pigeon.pigeon_integration_tests.HostSmallApi.voidVoid";
+constexpr char kEchoStringChannelName[] =
+    "dev.flutter.pigeon.pigeon_integration_tests.FlutterSmallApi.echoString";
+
+// An awaitable that suspends the coroutine awaiting it until the test calls
+// Set.
+class ManualEvent {
+ public:
+  bool await_ready() const noexcept { return false; }
+  void await_suspend(std::coroutine_handle<> waiting) { waiting_ = waiting; }
+  void await_resume() const noexcept {}
+
+  bool has_waiter() const { return static_cast<bool>(waiting_); }
+
+  void Set() {
+    std::coroutine_handle<> waiting = waiting_;
+    waiting_ = nullptr;
+    waiting.resume();
+  }
+
+ private:
+  std::coroutine_handle<> waiting_;
+};
+
+class TestHostSmallApi : public HostSmallApi {
+ public:
+  ManualEvent& echo_event() { return echo_event_; }
+
+ protected:
+  PigeonTask<ErrorOr<std::string>> Echo(const std::string& a_string) override {
+    // The argument is only valid until the first co_await.
+    std::string value = a_string;
+    co_await echo_event_;
+    if (value.empty()) {
+      throw std::invalid_argument("empty string");
+    }
+    co_return value;
+  }
+
+  PigeonTask<std::optional<FlutterError>> VoidVoid() override {
+    co_return std::nullopt;
+  }
+
+ private:
+  ManualEvent echo_event_;
+};
+
+// A messenger that holds on to the reply of the last message sent to Dart
+// until the test sends it.
+class ManualReplyMessenger : public flutter::BinaryMessenger {
+ public:
+  bool has_pending_reply() const { return static_cast<bool>(reply_); }
+  const std::string& last_channel() const { return last_channel_; }
+
+  // Replies to the last message with |value|, encoded with the API's codec.
+  void Reply(const EncodableValue& value) {
+    std::unique_ptr<std::vector<uint8_t>> encoded =
+        FlutterSmallApi::GetCodec().EncodeMessage(value);
+    flutter::BinaryReply reply = std::move(reply_);
+    reply_ = nullptr;
+    reply(encoded->data(), encoded->size());
+  }
+
+  // Replies to the last message as the engine does when there is no handler.
+  void ReplyWithNothing() {
+    flutter::BinaryReply reply = std::move(reply_);
+    reply_ = nullptr;
+    reply(nullptr, 0);
+  }
+
+  // flutter::BinaryMessenger:
+  void Send(const std::string& channel, const uint8_t* message,
+            size_t message_size,
+            flutter::BinaryReply reply = nullptr) const override {
+    last_channel_ = channel;
+    reply_ = std::move(reply);
+  }
+  void SetMessageHandler(const std::string& channel,
+                         flutter::BinaryMessageHandler handler) override {}
+
+ private:
+  mutable std::string last_channel_;
+  mutable flutter::BinaryReply reply_;
+};
+
+PigeonTask<ErrorOr<std::string>> CallEchoString(FlutterSmallApi* api,
+                                                std::string value) {
+  co_return co_await api->EchoString(value);
+}
+}  // namespace
+
+TEST(Coroutines, HostMethodRepliesWhenTaskCompletes) {
+  FakeHostMessenger messenger(&HostSmallApi::GetCodec());
+  TestHostSmallApi api;
+  HostSmallApi::SetUp(&messenger, &api);
+
+  std::optional<EncodableValue> reply;
+  messenger.SendHostMessage(
+      kEchoChannelName, EncodableValue(EncodableList{EncodableValue("hello")}),
+      [&reply](const EncodableValue& value) { reply = value; });
+  EXPECT_TRUE(api.echo_event().has_waiter());
+  EXPECT_FALSE(reply.has_value());
+
+  api.echo_event().Set();
+
+  ASSERT_TRUE(reply.has_value());
+  EXPECT_EQ(*reply, EncodableValue(EncodableList{EncodableValue("hello")}));
+}
+
+TEST(Coroutines, HostMethodExceptionRepliesWithError) {
+  FakeHostMessenger messenger(&HostSmallApi::GetCodec());
+  TestHostSmallApi api;
+  HostSmallApi::SetUp(&messenger, &api);
+
+  std::optional<EncodableValue> reply;
+  messenger.SendHostMessage(
+      kEchoChannelName, EncodableValue(EncodableList{EncodableValue("")}),
+      [&reply](const EncodableValue& value) { reply = value; });
+  api.echo_event().Set();
+
+  ASSERT_TRUE(reply.has_value());
+  EXPECT_EQ(*reply, EncodableValue(EncodableList{EncodableValue("empty string"),
+                                                 EncodableValue("Error"),
+                                                 EncodableValue()}));
+}
+
+TEST(Coroutines, HostMethodCompletingWithoutSuspendingReplies) {
+  FakeHostMessenger messenger(&HostSmallApi::GetCodec());
+  TestHostSmallApi api;
+  HostSmallApi::SetUp(&messenger, &api);
+
+  std::optional<EncodableValue> reply;
+  messenger.SendHostMessage(
+      kVoidVoidChannelName, EncodableValue(),
+      [&reply](const EncodableValue& value) { reply = value; });
+
+  ASSERT_TRUE(reply.has_value());
+  EXPECT_EQ(*reply, EncodableValue(EncodableList{EncodableValue()}));
+}
+
+TEST(Coroutines, FlutterMethodResumesWithReply) {
+  ManualReplyMessenger messenger;
+  FlutterSmallApi api(&messenger);
+
+  PigeonTask<ErrorOr<std::string>> task = CallEchoString(&api, "hello");
+  EXPECT_FALSE(task.await_ready());
+  EXPECT_EQ(messenger.last_channel(), kEchoStringChannelName);
+
+  messenger.Reply(EncodableValue(EncodableList{EncodableValue("hello")}));
+
+  ASSERT_TRUE(task.await_ready());
+  ErrorOr<std::string> result = task.await_resume();
+  ASSERT_FALSE(result.has_error());
+  EXPECT_EQ(result.value(), "hello");
+}
+
+TEST(Coroutines, FlutterMethodResumesWithError) {
+  ManualReplyMessenger messenger;
+  FlutterSmallApi api(&messenger);
+
+  PigeonTask<ErrorOr<std::string>> task = CallEchoString(&api, "hello");
+  messenger.Reply(EncodableValue(
+      EncodableList{EncodableValue("code"), EncodableValue("message"),
+                    EncodableValue("details")}));
+
+  ASSERT_TRUE(task.await_ready());
+  ErrorOr<std::string> result = task.await_resume();
+  ASSERT_TRUE(result.has_error());
+  EXPECT_EQ(result.error().code(), "code");
+  EXPECT_EQ(result.error().message(), "message");
+  EXPECT_EQ(result.error().details(), EncodableValue("details"));
+}
+
+TEST(Coroutines, FlutterMethodResumesWithConnectionError) {
+  ManualReplyMessenger messenger;
+  FlutterSmallApi api(&messenger, "suffix");
+
+  PigeonTask<ErrorOr<std::string>> task = CallEchoString(&api, "hello");
+  EXPECT_EQ(messenger.last_channel(),
+            std::string(kEchoStringChannelName) + ".suffix");
+  messenger.ReplyWithNothing();
+
+  ASSERT_TRUE(task.await_ready());
+  ErrorOr<std::string> result = task.await_resume();
+  ASSERT_TRUE(result.has_error());
+  EXPECT_EQ(result.error().code(), "channel-error");
+}
+
+}  // namespace core_tests_coroutines_pigeontest
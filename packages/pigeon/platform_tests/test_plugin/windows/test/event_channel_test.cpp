@@ -0,0 +1,340 @@
+// Copyright 2013 The Flutter Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <flutter/encodable_value.h>
+#include <flutter/event_sink.h>
+#include <flutter/method_call.h>
+#include <flutter/standard_message_codec.h>
+#include <flutter/standard_method_codec.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "pigeon/event_channel_without_classes_tests.gen.h"
+#include "test/utils/fake_host_messenger.h"
+
+namespace event_channel_without_classes_tests_pigeontest {
+
+namespace {
+using flutter::EncodableList;
+using flutter::EncodableValue;
+using flutter::MethodCall;
+using flutter::StandardMessageCodec;
+using flutter::StandardMethodCodec;
+using testing::FakeHostMessenger;
+
+constexpr char kStreamIntsAgainChannelName[] =
+    "dev.flutter.pigeon.pigeon_integration_tests.EventChannelMethods."
+    "streamIntsAgain";
+
+class TestStreamHandler : public StreamIntsAgainStreamHandler {
+ public:
+  void OnListen(std::shared_ptr<PigeonEventSink<int64_t>> sink) override {
+    sink_ = std::move(sink);
+  }
+
+  void OnCancel() override {
+    cancel_count_++;
+    sink_ = nullptr;
+  }
+
+  std::shared_ptr<PigeonEventSink<int64_t>> sink() { return sink_; }
+  int cancel_count() const { return cancel_count_; }
+
+ private:
+  std::shared_ptr<PigeonEventSink<int64_t>> sink_;
+  int cancel_count_ = 0;
+};
+
+// The messages sent to the Dart side of an event channel.
+struct SentMessages {
+  std::vector<EncodableValue> events;
+  std::vector<std::string> error_codes;
+  bool end_of_stream = false;
+};
+
+// An EventSink that records what is sent through it.
+class RecordingEventSink : public flutter::EventSink<EncodableValue> {
+ public:
+  explicit RecordingEventSink(SentMessages* messages) : messages_(messages) {}
+
+ protected:
+  void SuccessInternal(const EncodableValue* event) override {
+    messages_->events.push_back(*event);
+  }
+
+  void ErrorInternal(const std::string& error_code,
+                     const std::string& error_message,
+                     const EncodableValue* error_details) override {
+    messages_->error_codes.push_back(error_code);
+  }
+
+  void EndOfStreamInternal() override { messages_->end_of_stream = true; }
+
+ private:
+  SentMessages* messages_;
+};
+
+// A post_to_platform_thread function whose tasks run when the test asks.
+class ManualPlatformThread {
+ public:
+  std::function<void(std::function<void()> task)> Poster() {
+    return [this](std::function<void()> task) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      tasks_.push_back(std::move(task));
+    };
+  }
+
+  void RunTasks() {
+    std::vector<std::function<void()>> tasks;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      tasks.swap(tasks_);
+    }
+    for (const std::function<void()>& task : tasks) {
+      task();
+    }
+  }
+
+ private:
+  std::mutex mutex_;
+  std::vector<std::function<void()>> tasks_;
+};
+
+const StandardMethodCodec& MethodCodec() {
+  return StandardMethodCodec::GetInstance(
+      &PigeonInternalCodecSerializer::GetInstance());
+}
+
+std::vector<uint8_t> EncodeMethodCall(const std::string& method_name) {
+  return *MethodCodec().EncodeMethodCall(
+      MethodCall<EncodableValue>(method_name, nullptr));
+}
+
+// Records the messages sent on |messenger| to the Dart side.
+void RecordDartMessages(FakeHostMessenger* messenger,
+                        SentMessages* messages) {
+  messenger->SetDartMessageHandler([messages](const std::string& channel,
+                                              const uint8_t* message,
+                                              size_t message_size) {
+    if (message_size == 0) {
+      messages->end_of_stream = true;
+      return;
+    }
+    // An envelope is a success or error byte followed by the encoded values.
+    const StandardMessageCodec& codec = StandardMessageCodec::GetInstance(
+        &PigeonInternalCodecSerializer::GetInstance());
+    std::unique_ptr<EncodableValue> value =
+        codec.DecodeMessage(message + 1, message_size - 1);
+    if (message[0] == 0) {
+      messages->events.push_back(*value);
+    } else {
+      messages->error_codes.push_back(std::get<std::string>(*value));
+    }
+  });
+}
+
+EncodableValue IntList(std::vector<int64_t> values) {
+  EncodableList list;
+  for (int64_t value : values) {
+    list.push_back(EncodableValue(value));
+  }
+  return EncodableValue(list);
+}
+
+// Creates a handler like the generated channels do, with |options|.
+std::unique_ptr<PigeonInternalEventStreamHandler<int64_t>> CreateHandler(
+    PigeonEventSinkOptions options,
+    std::shared_ptr<TestStreamHandler> stream_handler) {
+  return std::make_unique<PigeonInternalEventStreamHandler<int64_t>>(
+      std::move(options),
+      [](const int64_t& event) { return EncodableValue(event); },
+      std::move(stream_handler));
+}
+
+void Listen(PigeonInternalEventStreamHandler<int64_t>* handler,
+            SentMessages* messages) {
+  handler->OnListen(nullptr, std::make_unique<RecordingEventSink>(messages));
+}
+}  // namespace
+
+TEST(EventChannel, SendsFullBatchesAndFlushesPartialBatch) {
+  FakeHostMessenger messenger(&StandardMessageCodec::GetInstance());
+  SentMessages messages;
+  RecordDartMessages(&messenger, &messages);
+  auto handler = std::make_shared<TestStreamHandler>();
+  StreamIntsAgainStreamHandler::Register(&messenger, handler);
+
+  messenger.SendHostBytes(kStreamIntsAgainChannelName,
+                          EncodeMethodCall("listen"));
+  ASSERT_NE(handler->sink(), nullptr);
+  for (int64_t i = 1; i <= 9; i++) {
+    handler->sink()->Success(i);
+  }
+
+  EXPECT_EQ(messages.events,
+            (std::vector<EncodableValue>{IntList({1, 2, 3, 4}),
+                                         IntList({5, 6, 7, 8})}));
+
+  handler->sink()->Flush();
+
+  ASSERT_EQ(messages.events.size(), 3);
+  EXPECT_EQ(messages.events[2], IntList({9}));
+}
+
+TEST(EventChannel, ErrorAndEndOfStreamSendQueuedEventsFirst) {
+  FakeHostMessenger messenger(&StandardMessageCodec::GetInstance());
+  SentMessages messages;
+  RecordDartMessages(&messenger, &messages);
+  auto handler = std::make_shared<TestStreamHandler>();
+  StreamIntsAgainStreamHandler::Register(&messenger, handler);
+  messenger.SendHostBytes(kStreamIntsAgainChannelName,
+                          EncodeMethodCall("listen"));
+
+  handler->sink()->Success(1);
+  handler->sink()->Error("an-error");
+  EXPECT_EQ(messages.events, std::vector<EncodableValue>{IntList({1})});
+  EXPECT_EQ(messages.error_codes, std::vector<std::string>{"an-error"});
+
+  handler->sink()->Success(2);
+  handler->sink()->EndOfStream();
+  EXPECT_EQ(messages.events.size(), 2);
+  EXPECT_TRUE(messages.end_of_stream);
+
+  // Events added after the end of the stream are ignored.
+  handler->sink()->Success(3);
+  handler->sink()->Flush();
+  EXPECT_EQ(messages.events.size(), 2);
+}
+
+TEST(EventChannel, CancelStopsSendingEvents) {
+  FakeHostMessenger messenger(&StandardMessageCodec::GetInstance());
+  SentMessages messages;
+  RecordDartMessages(&messenger, &messages);
+  auto handler = std::make_shared<TestStreamHandler>();
+  StreamIntsAgainStreamHandler::Register(&messenger, handler, "instance");
+
+  messenger.SendHostBytes(std::string(kStreamIntsAgainChannelName) +
+                              ".instance",
+                          EncodeMethodCall("listen"));
+  std::shared_ptr<PigeonEventSink<int64_t>> sink = handler->sink();
+  ASSERT_NE(sink, nullptr);
+  messenger.SendHostBytes(std::string(kStreamIntsAgainChannelName) +
+                              ".instance",
+                          EncodeMethodCall("cancel"));
+
+  EXPECT_EQ(handler->cancel_count(), 1);
+  EXPECT_EQ(handler->sink(), nullptr);
+  sink->Success(1);
+  sink->Flush();
+  EXPECT_TRUE(messages.events.empty());
+}
+
+TEST(EventChannel, SendsEventsFromOtherThreadsOnPlatformThread) {
+  ManualPlatformThread platform_thread;
+  PigeonEventSinkOptions options;
+  options.max_batch_size = 4;
+  options.post_to_platform_thread = platform_thread.Poster();
+  auto stream_handler = std::make_shared<TestStreamHandler>();
+  auto handler = CreateHandler(options, stream_handler);
+  SentMessages messages;
+  Listen(handler.get(), &messages);
+
+  std::thread producer([sink = stream_handler->sink()]() {
+    for (int64_t i = 1; i <= 6; i++) {
+      sink->Success(i);
+    }
+  });
+  producer.join();
+  EXPECT_TRUE(messages.events.empty());
+
+  // A posted task sends all of the queued events, including a partial batch.
+  platform_thread.RunTasks();
+
+  EXPECT_EQ(messages.events, (std::vector<EncodableValue>{
+                                 IntList({1, 2, 3, 4}), IntList({5, 6})}));
+}
+
+TEST(EventChannel, DropsOldestEventsWhenQueueIsFull) {
+  PigeonEventSinkOptions options;
+  options.max_queued_events = 2;
+  options.overflow_policy = PigeonEventOverflowPolicy::kDropOldest;
+  auto stream_handler = std::make_shared<TestStreamHandler>();
+  auto handler = CreateHandler(options, stream_handler);
+  SentMessages messages;
+  Listen(handler.get(), &messages);
+
+  std::thread producer([sink = stream_handler->sink()]() {
+    for (int64_t i = 1; i <= 5; i++) {
+      sink->Success(i);
+    }
+  });
+  producer.join();
+  stream_handler->sink()->Flush();
+
+  EXPECT_EQ(messages.events,
+            (std::vector<EncodableValue>{EncodableValue(int64_t{4}),
+                                         EncodableValue(int64_t{5})}));
+  EXPECT_EQ(stream_handler->sink()->dropped_event_count(), 3);
+}
+
+TEST(EventChannel, BlocksProducerWhenQueueIsFull) {
+  PigeonEventSinkOptions options;
+  options.max_queued_events = 2;
+  options.overflow_policy = PigeonEventOverflowPolicy::kBlock;
+  auto stream_handler = std::make_shared<TestStreamHandler>();
+  auto handler = CreateHandler(options, stream_handler);
+  SentMessages messages;
+  Listen(handler.get(), &messages);
+
+  constexpr int64_t kEventCount = 100;
+  std::atomic<bool> done(false);
+  std::thread producer([sink = stream_handler->sink(), &done]() {
+    for (int64_t i = 1; i <= kEventCount; i++) {
+      sink->Success(i);
+    }
+    done = true;
+  });
+  // The producer can only finish once the platform thread makes room.
+  while (!done) {
+    stream_handler->sink()->Flush();
+    std::this_thread::yield();
+  }
+  producer.join();
+  stream_handler->sink()->Flush();
+
+  ASSERT_EQ(messages.events.size(), kEventCount);
+  for (int64_t i = 0; i < kEventCount; i++) {
+    EXPECT_EQ(messages.events[i], EncodableValue(i + 1));
+  }
+  EXPECT_EQ(stream_handler->sink()->dropped_event_count(), 0);
+}
+
+TEST(EventChannel, CancelWakesBlockedProducer) {
+  PigeonEventSinkOptions options;
+  options.max_queued_events = 1;
+  options.overflow_policy = PigeonEventOverflowPolicy::kBlock;
+  auto stream_handler = std::make_shared<TestStreamHandler>();
+  auto handler = CreateHandler(options, stream_handler);
+  SentMessages messages;
+  Listen(handler.get(), &messages);
+
+  // The producer blocks on its second event, since nothing sends the first.
+  std::thread producer([sink = stream_handler->sink()]() {
+    sink->Success(1);
+    sink->Success(2);
+  });
+  handler->OnCancel(nullptr);
+  producer.join();
+
+  EXPECT_TRUE(messages.events.empty());
+}
+
+}  // namespace event_channel_without_classes_tests_pigeontest
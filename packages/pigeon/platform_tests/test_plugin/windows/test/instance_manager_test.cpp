@@ -0,0 +1,333 @@
+// Copyright 2013 The Flutter Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <flutter/encodable_value.h>
+#include <flutter/standard_codec_serializer.h>
+#include <flutter/standard_message_codec.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "pigeon/proxy_api_tests.gen.h"
+#include "test/utils/fake_host_messenger.h"
+
+namespace proxy_api_tests_pigeontest {
+
+namespace {
+using flutter::CustomEncodableValue;
+using flutter::EncodableList;
+using flutter::EncodableValue;
+using flutter::StandardMessageCodec;
+using testing::FakeHostMessenger;
+
+constexpr char kRemoveStrongReferenceChannelName[] =
+    "dev.flutter.pigeon.pigeon_integration_tests."
+    "PigeonInternalInstanceManager.removeStrongReference";
+constexpr char kRemoveStrongReferencesChannelName[] =
+    "dev.flutter.pigeon.pigeon_integration_tests."
+    "PigeonInternalInstanceManager.removeStrongReferences";
+constexpr char kClearChannelName[] =
+    "dev.flutter.pigeon.pigeon_integration_tests."
+    "PigeonInternalInstanceManager.clear";
+constexpr char kDefaultConstructorChannelName[] =
+    "dev.flutter.pigeon.pigeon_integration_tests.ProxyApiSuperClass."
+    "pigeon_defaultConstructor";
+constexpr char kASuperMethodChannelName[] =
+    "dev.flutter.pigeon.pigeon_integration_tests.ProxyApiSuperClass."
+    "aSuperMethod";
+constexpr char kNewInstanceChannelName[] =
+    "dev.flutter.pigeon.pigeon_integration_tests.ProxyApiSuperClass."
+    "pigeon_newInstance";
+
+// A value that is sent the same way Dart sends an instance.
+struct DartInstance {
+  int64_t identifier;
+};
+
+// Encodes DartInstances as their identifier, the same way Dart does.
+class TestInstanceSerializer : public flutter::StandardCodecSerializer {
+ public:
+  void WriteValue(const EncodableValue& value,
+                  flutter::ByteStreamWriter* stream) const override {
+    if (const CustomEncodableValue* custom_value =
+            std::get_if<CustomEncodableValue>(&value)) {
+      if (custom_value->type() == typeid(DartInstance)) {
+        stream->WriteByte(128);
+        WriteValue(
+            EncodableValue(
+                std::any_cast<const DartInstance&>(*custom_value).identifier),
+            stream);
+        return;
+      }
+    }
+    flutter::StandardCodecSerializer::WriteValue(value, stream);
+  }
+};
+
+class TestProxyApiSuperClass : public ProxyApiSuperClass {
+ public:
+  using ProxyApiSuperClass::ProxyApiSuperClass;
+
+  ErrorOr<std::shared_ptr<void>> PigeonDefaultConstructor() override {
+    created_instance_ = std::make_shared<int>(0);
+    return created_instance_;
+  }
+
+  std::optional<FlutterError> ASuperMethod(
+      const std::shared_ptr<void>& pigeon_instance) override {
+    called_instance_ = pigeon_instance;
+    return std::nullopt;
+  }
+
+  std::shared_ptr<void> created_instance() { return created_instance_; }
+  std::shared_ptr<void> called_instance() { return called_instance_; }
+
+ private:
+  std::shared_ptr<void> created_instance_;
+  std::shared_ptr<void> called_instance_;
+};
+
+// The messages sent to Dart, by channel.
+struct SentMessages {
+  std::vector<int64_t> released;
+  // The number of messages the released identifiers were sent in.
+  size_t release_message_count = 0;
+  std::vector<int64_t> new_instances;
+};
+
+class InstanceManagerTest : public ::testing::Test {
+ protected:
+  InstanceManagerTest()
+      : codec_(StandardMessageCodec::GetInstance(&serializer_)),
+        messenger_(&codec_) {
+    messenger_.SetDartMessageHandler([this](const std::string& channel,
+                                            const uint8_t* message,
+                                            size_t message_size) {
+      std::unique_ptr<EncodableValue> value =
+          StandardMessageCodec::GetInstance().DecodeMessage(message,
+                                                            message_size);
+      const EncodableValue& argument = std::get<EncodableList>(*value)[0];
+      if (channel == kRemoveStrongReferencesChannelName) {
+        const auto& identifiers = std::get<std::vector<int64_t>>(argument);
+        sent_.released.insert(sent_.released.end(), identifiers.begin(),
+                              identifiers.end());
+        sent_.release_message_count++;
+      } else if (channel == kNewInstanceChannelName) {
+        sent_.new_instances.push_back(argument.LongValue());
+      }
+    });
+    instance_manager_ = std::make_shared<PigeonInstanceManager>(&messenger_);
+  }
+
+  // Sends |message| from Dart on |channel|, and returns the reply.
+  EncodableValue SendFromDart(const std::string& channel,
+                              const EncodableValue& message) {
+    EncodableValue result;
+    messenger_.SendHostMessage(
+        channel, message,
+        [&result](const EncodableValue& reply) { result = reply; });
+    return result;
+  }
+
+  TestInstanceSerializer serializer_;
+  const StandardMessageCodec& codec_;
+  FakeHostMessenger messenger_;
+  std::shared_ptr<PigeonInstanceManager> instance_manager_;
+  SentMessages sent_;
+};
+}  // namespace
+
+TEST_F(InstanceManagerTest, AddHostCreatedInstance) {
+  auto instance = std::make_shared<int>(0);
+  int64_t identifier = instance_manager_->AddHostCreatedInstance(instance);
+
+  EXPECT_GE(identifier, PigeonInstanceManager::kMinHostCreatedIdentifier);
+  EXPECT_EQ(instance_manager_->GetInstance(identifier), instance);
+  EXPECT_EQ(instance_manager_->GetIdentifier(instance.get()), identifier);
+  EXPECT_TRUE(instance_manager_->ContainsInstance(instance.get()));
+  // Adding the same instance again fails.
+  EXPECT_EQ(instance_manager_->AddHostCreatedInstance(instance), -1);
+}
+
+TEST_F(InstanceManagerTest, AddDartCreatedInstanceRejectsDuplicates) {
+  auto instance1 = std::make_shared<int>(1);
+  auto instance2 = std::make_shared<int>(2);
+
+  EXPECT_TRUE(instance_manager_->AddDartCreatedInstance(instance1, 0));
+  EXPECT_FALSE(instance_manager_->AddDartCreatedInstance(instance2, 0));
+  EXPECT_FALSE(instance_manager_->AddDartCreatedInstance(instance1, 1));
+}
+
+TEST_F(InstanceManagerTest, DestroyedInstancesAreReleasedInDartTogether) {
+  std::vector<int64_t> identifiers;
+  for (int i = 0; i < 3; i++) {
+    identifiers.push_back(
+        instance_manager_->AddHostCreatedInstance(std::make_shared<int>(i)));
+  }
+  for (int64_t identifier : identifiers) {
+    instance_manager_->Remove(identifier);
+    EXPECT_EQ(instance_manager_->GetInstance(identifier), nullptr);
+  }
+  EXPECT_TRUE(sent_.released.empty());
+
+  EXPECT_EQ(instance_manager_->ReleaseDestroyedInstances(), 3);
+
+  EXPECT_EQ(sent_.released, identifiers);
+  EXPECT_EQ(sent_.release_message_count, 1u);
+  EXPECT_EQ(instance_manager_->ReleaseDestroyedInstances(), 0);
+}
+
+TEST_F(InstanceManagerTest, InstancesInUseAreNotReleasedInDart) {
+  auto instance = std::make_shared<int>(0);
+  int64_t identifier = instance_manager_->AddHostCreatedInstance(instance);
+  instance_manager_->Remove(identifier);
+
+  EXPECT_EQ(instance_manager_->ReleaseDestroyedInstances(), 0);
+  EXPECT_EQ(instance_manager_->GetInstance(identifier), instance);
+
+  instance.reset();
+  EXPECT_EQ(instance_manager_->ReleaseDestroyedInstances(), 1);
+  EXPECT_EQ(sent_.released, std::vector<int64_t>{identifier});
+}
+
+TEST_F(InstanceManagerTest, InstanceSentAgainIsHeldUntilDartReleasesIt) {
+  auto instance = std::make_shared<int>(0);
+  int64_t identifier = instance_manager_->AddHostCreatedInstance(instance);
+  instance_manager_->Remove(identifier);
+
+  // Sending the instance to Dart again takes a strong reference.
+  EXPECT_EQ(instance_manager_->GetIdentifier(instance.get()), identifier);
+  std::weak_ptr<void> weak_instance = instance;
+  instance.reset();
+  EXPECT_EQ(instance_manager_->ReleaseDestroyedInstances(), 0);
+  EXPECT_FALSE(weak_instance.expired());
+
+  instance_manager_->Remove(identifier);
+  EXPECT_TRUE(weak_instance.expired());
+  EXPECT_EQ(instance_manager_->ReleaseDestroyedInstances(), 1);
+}
+
+TEST_F(InstanceManagerTest, RemoveStrongReferenceFromDart) {
+  auto instance = std::make_shared<int>(0);
+  std::weak_ptr<void> weak_instance = instance;
+  ASSERT_TRUE(instance_manager_->AddDartCreatedInstance(instance, 7));
+  instance.reset();
+
+  EncodableValue reply =
+      SendFromDart(kRemoveStrongReferenceChannelName,
+                   EncodableValue(EncodableList{EncodableValue(7)}));
+
+  EXPECT_EQ(std::get<EncodableList>(reply).size(), 1);
+  EXPECT_TRUE(weak_instance.expired());
+  // The destroyed instance is released in Dart straight away.
+  EXPECT_EQ(sent_.released, std::vector<int64_t>{7});
+}
+
+TEST_F(InstanceManagerTest, ClearFromDart) {
+  auto instance = std::make_shared<int>(0);
+  int64_t identifier = instance_manager_->AddHostCreatedInstance(instance);
+  instance_manager_->Remove(identifier);
+
+  EncodableValue reply =
+      SendFromDart(kClearChannelName, EncodableValue(EncodableList{}));
+
+  EXPECT_EQ(std::get<EncodableList>(reply).size(), 1);
+  EXPECT_FALSE(instance_manager_->ContainsInstance(instance.get()));
+  // Cleared instances are not released in Dart.
+  instance.reset();
+  EXPECT_EQ(instance_manager_->ReleaseDestroyedInstances(), 0);
+  EXPECT_TRUE(sent_.released.empty());
+}
+
+TEST_F(InstanceManagerTest, ProxyApiMethodHandlers) {
+  TestProxyApiSuperClass api(&messenger_, instance_manager_);
+  ProxyApiSuperClass::SetUp(&messenger_, &api);
+
+  EncodableValue constructor_reply =
+      SendFromDart(kDefaultConstructorChannelName,
+                   EncodableValue(EncodableList{EncodableValue(3)}));
+  EXPECT_EQ(std::get<EncodableList>(constructor_reply).size(), 1);
+  ASSERT_NE(api.created_instance(), nullptr);
+  EXPECT_EQ(instance_manager_->GetInstance(3), api.created_instance());
+
+  EncodableValue method_reply = SendFromDart(
+      kASuperMethodChannelName,
+      EncodableValue(EncodableList{CustomEncodableValue(DartInstance{3})}));
+  EXPECT_EQ(std::get<EncodableList>(method_reply).size(), 1);
+  EXPECT_EQ(api.called_instance(), api.created_instance());
+
+  // Dart can't create a second instance with the same identifier.
+  EncodableValue duplicate_reply =
+      SendFromDart(kDefaultConstructorChannelName,
+                   EncodableValue(EncodableList{EncodableValue(3)}));
+  EXPECT_EQ(std::get<EncodableList>(duplicate_reply).size(), 3);
+
+  ProxyApiSuperClass::SetUp(&messenger_, nullptr);
+}
+
+TEST_F(InstanceManagerTest, NewInstanceIsOnlySentOnce) {
+  TestProxyApiSuperClass api(&messenger_, instance_manager_);
+  auto instance = std::make_shared<int>(0);
+
+  int success_count = 0;
+  for (int i = 0; i < 2; i++) {
+    api.PigeonNewInstance(
+        instance, [&success_count]() { success_count++; },
+        [](const FlutterError& error) { FAIL() << error.message(); });
+  }
+
+  ASSERT_EQ(sent_.new_instances.size(), 1);
+  EXPECT_EQ(sent_.new_instances[0],
+            instance_manager_->GetIdentifier(instance.get()));
+  // The first call only completes when Dart replies, which the fake
+  // messenger never does.
+  EXPECT_EQ(success_count, 1);
+}
+
+TEST_F(InstanceManagerTest, ConcurrentUseFromManyThreads) {
+  constexpr int kThreadCount = 8;
+  constexpr int kInstancesPerThread = 2000;
+  std::atomic<bool> done(false);
+
+  // Each thread adds instances, looks them up in both directions and then
+  // releases them, while this thread sends the releases to Dart.
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreadCount; t++) {
+    threads.emplace_back([this]() {
+      for (int i = 0; i < kInstancesPerThread; i++) {
+        auto instance = std::make_shared<int>(i);
+        int64_t identifier =
+            instance_manager_->AddHostCreatedInstance(instance);
+        ASSERT_GE(identifier, PigeonInstanceManager::kMinHostCreatedIdentifier);
+        ASSERT_EQ(instance_manager_->GetInstance(identifier), instance);
+        ASSERT_EQ(instance_manager_->GetIdentifier(instance.get()), identifier);
+        instance_manager_->Remove(identifier);
+      }
+    });
+  }
+  std::thread platform_thread([this, &done]() {
+    while (!done) {
+      instance_manager_->ReleaseDestroyedInstances();
+      std::this_thread::yield();
+    }
+  });
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  done = true;
+  platform_thread.join();
+  instance_manager_->ReleaseDestroyedInstances();
+
+  ASSERT_EQ(sent_.released.size(), kThreadCount * kInstancesPerThread);
+  std::sort(sent_.released.begin(), sent_.released.end());
+  EXPECT_EQ(std::unique(sent_.released.begin(), sent_.released.end()),
+            sent_.released.end());
+}
+
+}  // namespace proxy_api_tests_pigeontest
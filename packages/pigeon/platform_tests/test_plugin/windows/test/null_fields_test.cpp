@@ -47,6 +47,12 @@ class NullFieldsTest : public ::testing::Test {
   NullFieldsSearchReply ReplyFromList(const EncodableList& list) {
     return NullFieldsSearchReply::FromEncodableList(list);
   }
+
+  // Wrapper for access to the private consuming NullFieldsSearchReply list
+  // constructor.
+  NullFieldsSearchReply ReplyFromMovedList(EncodableList&& list) {
+    return NullFieldsSearchReply::FromEncodableList(std::move(list));
+  }
   // Wrapper for access to private NullFieldsSearchRequest::ToEncodableList.
   EncodableList ListFromRequest(const NullFieldsSearchRequest& request) {
     return request.ToEncodableList();
@@ -149,6 +155,28 @@ TEST_F(NullFieldsTest, ReplyFromListWithNulls) {
   EXPECT_EQ(reply.type(), nullptr);
 }
 
+TEST_F(NullFieldsTest, ReplyFromMovedListWithValues) {
+  NullFieldsSearchRequest request(1);
+  request.set_query("hello");
+  EncodableList list{
+      EncodableValue("result"),
+      EncodableValue("error"),
+      EncodableValue(EncodableList({1, 2, 3})),
+      CustomEncodableValue(request),
+      CustomEncodableValue(NullFieldsSearchReplyType::kSuccess),
+  };
+  NullFieldsSearchReply reply = ReplyFromMovedList(std::move(list));
+
+  EXPECT_EQ(*reply.result(), "result");
+  EXPECT_EQ(*reply.error(), "error");
+  EXPECT_EQ(reply.indices()->size(), 3);
+  EXPECT_EQ(*reply.request()->query(), "hello");
+  EXPECT_EQ(reply.request()->identifier(), 1);
+  EXPECT_EQ(*reply.type(), NullFieldsSearchReplyType::kSuccess);
+  // The collection should have been moved out of the list rather than copied.
+  EXPECT_TRUE(std::get<EncodableList>(list[2]).empty());
+}
+
 TEST_F(NullFieldsTest, RequestToListWithValues) {
   NullFieldsSearchRequest request(1);
   request.set_query("hello");
@@ -0,0 +1,237 @@
+// Copyright 2013 The Flutter Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <flutter/encodable_value.h>
+#include <flutter/standard_message_codec.h>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <variant>
+#include <vector>
+
+#include "pigeon/core_tests.gen.h"
+#include "test/utils/core_tests_test.h"
+
+namespace test_plugin {
+namespace test {
+
+namespace {
+
+using core_tests_pigeontest::AllClassesWrapper;
+using core_tests_pigeontest::AllNullableTypes;
+using core_tests_pigeontest::AllNullableTypesWithoutRecursion;
+using core_tests_pigeontest::AllTypes;
+using core_tests_pigeontest::AnEnum;
+using core_tests_pigeontest::AnotherEnum;
+using core_tests_pigeontest::CoreTestsTest;
+using core_tests_pigeontest::PigeonInternalCodecSerializer;
+using flutter::CustomEncodableValue;
+using flutter::EncodableList;
+using flutter::EncodableMap;
+using flutter::EncodableValue;
+using flutter::StandardMessageCodec;
+
+const StandardMessageCodec& StreamCodec() {
+  return StandardMessageCodec::GetInstance(
+      &PigeonInternalCodecSerializer::GetInstance());
+}
+
+const StandardMessageCodec& ListCodec() {
+  return StandardMessageCodec::GetInstance(
+      &CoreTestsTest::ListDecodingSerializer::GetInstance());
+}
+
+const StandardMessageCodec& ListEncodingCodec() {
+  return StandardMessageCodec::GetInstance(
+      &CoreTestsTest::ListEncodingSerializer::GetInstance());
+}
+
+// Writes ints the way Dart does, which the C++ serializer never does.
+const StandardMessageCodec& Int32EncodingCodec() {
+  return StandardMessageCodec::GetInstance(
+      &CoreTestsTest::Int32EncodingSerializer::GetInstance());
+}
+
+std::vector<uint8_t> Encode(const EncodableValue& value) {
+  return *StreamCodec().EncodeMessage(value);
+}
+
+// Checks that writing the fields of |value| directly to the stream produces
+// exactly the same bytes as writing their EncodableList, and returns them.
+std::vector<uint8_t> EncodeAndCompareWithList(const EncodableValue& value) {
+  std::vector<uint8_t> message = Encode(value);
+  EXPECT_EQ(message, *ListEncodingCodec().EncodeMessage(value));
+  return message;
+}
+
+template <typename T>
+T Decode(const StandardMessageCodec& codec,
+         const std::vector<uint8_t>& message) {
+  std::unique_ptr<EncodableValue> value = codec.DecodeMessage(message);
+  return std::any_cast<T>(std::get<CustomEncodableValue>(*value));
+}
+
+// Checks that the objects decoded from |message| by reading the fields
+// directly from the stream and via an EncodableList both re-encode to exactly
+// the original bytes.
+//
+// The bytes are compared rather than the objects, since CustomEncodableValues
+// nested in collections only compare equal to themselves.
+template <typename T>
+void ExpectStreamDecodingMatchesListDecoding(
+    const std::vector<uint8_t>& message) {
+  T streamed = Decode<T>(StreamCodec(), message);
+  T listed = Decode<T>(ListCodec(), message);
+  EXPECT_EQ(Encode(CustomEncodableValue(streamed)), message);
+  EXPECT_EQ(Encode(CustomEncodableValue(listed)), message);
+}
+
+AllTypes CreateAllTypes() {
+  EncodableList string_list = {EncodableValue("a"), EncodableValue("b")};
+  EncodableMap string_map = {{EncodableValue("key"), EncodableValue("value")}};
+  return AllTypes(
+      true, 42, 0x7FFFFFFFFFFF, 3.5, std::vector<uint8_t>{1, 2, 3},
+      std::vector<int32_t>{4, 5}, std::vector<int64_t>{6},
+      std::vector<double>{7.5, 8.5}, AnEnum::kFortyTwo,
+      AnotherEnum::kJustInCase, "a string that doesn't fit inline",
+      EncodableValue(12), string_list, string_list, EncodableList(),
+      EncodableList(), EncodableList(), EncodableList(), string_list,
+      EncodableList(), EncodableList(), string_map, string_map, EncodableMap(),
+      EncodableMap(), string_map, EncodableMap(), EncodableMap());
+}
+
+AllNullableTypes CreateAllNullableTypes() {
+  AllNullableTypes nested;
+  nested.set_a_nullable_string("nested");
+
+  AllNullableTypes everything;
+  everything.set_a_nullable_bool(false);
+  everything.set_a_nullable_int(-1);
+  everything.set_a_nullable_int64(1);
+  everything.set_a_nullable_double(-0.5);
+  everything.set_a_nullable_byte_array(std::vector<uint8_t>{9});
+  everything.set_a_nullable4_byte_array(std::vector<int32_t>{10, 11, 12});
+  everything.set_a_nullable8_byte_array(std::vector<int64_t>());
+  everything.set_a_nullable_float_array(std::vector<double>{13.0});
+  everything.set_a_nullable_enum(AnEnum::kTwo);
+  everything.set_a_nullable_string("");
+  everything.set_a_nullable_object(EncodableValue("object"));
+  everything.set_all_nullable_types(nested);
+  everything.set_list(EncodableList{EncodableValue(1), EncodableValue()});
+  everything.set_recursive_class_list(
+      EncodableList{CustomEncodableValue(nested)});
+  everything.set_int_map(EncodableMap{{EncodableValue(1), EncodableValue(2)}});
+  return everything;
+}
+
+}  // namespace
+
+TEST(StreamCodecTests, AllTypes) {
+  ExpectStreamDecodingMatchesListDecoding<AllTypes>(
+      EncodeAndCompareWithList(CustomEncodableValue(CreateAllTypes())));
+}
+
+TEST(StreamCodecTests, AllTypesWithEmptyData) {
+  AllTypes value = CreateAllTypes();
+  value.set_a_string("");
+  value.set_a_byte_array(std::vector<uint8_t>());
+  value.set_a4_byte_array(std::vector<int32_t>());
+  value.set_a8_byte_array(std::vector<int64_t>());
+  value.set_a_float_array(std::vector<double>());
+  ExpectStreamDecodingMatchesListDecoding<AllTypes>(
+      EncodeAndCompareWithList(CustomEncodableValue(value)));
+}
+
+TEST(StreamCodecTests, AllNullableTypes) {
+  ExpectStreamDecodingMatchesListDecoding<AllNullableTypes>(
+      EncodeAndCompareWithList(CustomEncodableValue(CreateAllNullableTypes())));
+}
+
+TEST(StreamCodecTests, AllNullableTypesWithNullFields) {
+  ExpectStreamDecodingMatchesListDecoding<AllNullableTypes>(
+      EncodeAndCompareWithList(CustomEncodableValue(AllNullableTypes())));
+}
+
+TEST(StreamCodecTests, AllClassesWrapper) {
+  EncodableMap class_map = {
+      {EncodableValue(0), CustomEncodableValue(CreateAllTypes())}};
+  AllClassesWrapper wrapper(
+      CreateAllNullableTypes(),
+      EncodableList{CustomEncodableValue(CreateAllNullableTypes())}, class_map);
+  wrapper.set_all_types(CreateAllTypes());
+  ExpectStreamDecodingMatchesListDecoding<AllClassesWrapper>(
+      EncodeAndCompareWithList(CustomEncodableValue(wrapper)));
+}
+
+TEST(StreamCodecTests, ClassesNestedInCollections) {
+  EncodableList list = {CustomEncodableValue(CreateAllNullableTypes()),
+                        CustomEncodableValue(AnEnum::kThree)};
+  EncodableMap map = {
+      {EncodableValue("key"), CustomEncodableValue(CreateAllTypes())}};
+  EncodeAndCompareWithList(EncodableValue(list));
+  EncodeAndCompareWithList(EncodableValue(map));
+}
+
+TEST(StreamCodecTests, DecodesClassesNestedInCollections) {
+  EncodableList list = {CustomEncodableValue(CreateAllNullableTypes()),
+                        EncodableValue(), CustomEncodableValue(AnEnum::kThree),
+                        EncodableValue("string")};
+  EncodableMap map = {
+      {EncodableValue("key"), CustomEncodableValue(CreateAllTypes())},
+      {EncodableValue(1), EncodableValue(list)}};
+  std::vector<uint8_t> message = Encode(EncodableValue(map));
+
+  std::unique_ptr<EncodableValue> decoded = StreamCodec().DecodeMessage(message);
+
+  EXPECT_EQ(Encode(*decoded), message);
+  const auto& decoded_map = std::get<EncodableMap>(*decoded);
+  EXPECT_EQ(std::any_cast<const AllTypes&>(std::get<CustomEncodableValue>(
+                decoded_map.at(EncodableValue("key")))),
+            CreateAllTypes());
+}
+
+TEST(StreamCodecTests, FieldCountMismatchFallsBackToList) {
+  AllNullableTypesWithoutRecursion value;
+  value.set_a_nullable_string("hello");
+  // A message from a newer version of the class, with an extra field.
+  EncodableList fields = CoreTestsTest::ToList(value);
+  fields.push_back(EncodableValue("unknown"));
+  std::vector<uint8_t> message = Encode(EncodableValue(fields));
+  message.insert(message.begin(), 134);
+
+  EXPECT_EQ(Decode<AllNullableTypesWithoutRecursion>(StreamCodec(), message),
+            value);
+}
+
+TEST(StreamCodecTests, DecodesInt32EncodedInts) {
+  AllTypes value = CreateAllTypes();
+  value.set_an_int(1);
+  value.set_an_int64(-2);
+  std::vector<uint8_t> message =
+      *Int32EncodingCodec().EncodeMessage(CustomEncodableValue(value));
+
+  EXPECT_EQ(Decode<AllTypes>(StreamCodec(), message), value);
+}
+
+TEST(StreamCodecTests, FieldsThatAreNotAListFailToDecode) {
+  std::vector<uint8_t> message = Encode(EncodableValue());
+  message.insert(message.begin(), 134);
+
+  EXPECT_THROW(StreamCodec().DecodeMessage(message), std::bad_variant_access);
+}
+
+TEST(StreamCodecTests, MissingFieldsFailToDecode) {
+  EncodableList fields =
+      CoreTestsTest::ToList(AllNullableTypesWithoutRecursion());
+  fields.pop_back();
+  std::vector<uint8_t> message = Encode(EncodableValue(fields));
+  message.insert(message.begin(), 134);
+
+  EXPECT_THROW(StreamCodec().DecodeMessage(message), std::runtime_error);
+}
+
+}  // namespace test
+}  // namespace test_plugin
@@ -0,0 +1,216 @@
+// Copyright 2013 The Flutter Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <flutter/encodable_value.h>
+#include <gtest/gtest.h>
+
+#include <functional>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "pigeon/task_queue_table.gen.h"
+#include "test/utils/fake_host_messenger.h"
+
+// Tests the host API handlers generated with CppOptions.tableDrivenDispatch,
+// which must behave exactly like the per-method handlers in task_queue_test.
+namespace task_queue_table_pigeontest {
+
+namespace {
+using flutter::EncodableList;
+using flutter::EncodableValue;
+using testing::FakeHostMessenger;
+
+constexpr char kAddChannelName[] =
+    "dev.flutter.pigeon.pigeon_integration_tests.TaskQueueHostApi.add";
+constexpr char kEchoAsyncStringChannelName[] =
+    "dev.flutter.pigeon.pigeon_integration_tests.TaskQueueHostApi."
+    "echoAsyncString";
+constexpr char kSubtractChannelName[] =
+    "dev.flutter.pigeon.pigeon_integration_tests.TaskQueueHostApi.subtract";
+
+class TestHostApi : public TaskQueueHostApi {
+ public:
+  TestHostApi() {}
+  virtual ~TestHostApi() {}
+
+  std::thread::id add_thread_id() const { return add_thread_id_; }
+
+ protected:
+  ErrorOr<int64_t> Add(int64_t x, int64_t y) override {
+    add_thread_id_ = std::this_thread::get_id();
+    return x + y;
+  }
+
+  void EchoAsyncString(
+      const std::string& a_string,
+      std::function<void(ErrorOr<std::string> reply)> result) override {
+    if (a_string.empty()) {
+      result(FlutterError("empty", "The string is empty"));
+      return;
+    }
+    result(a_string);
+  }
+
+  ErrorOr<int64_t> Subtract(int64_t x, int64_t y) override {
+    if (x < y) {
+      throw std::invalid_argument("negative result");
+    }
+    return x - y;
+  }
+
+ private:
+  std::thread::id add_thread_id_;
+};
+
+// A task queue that runs its tasks when the test asks it to.
+class ManualTaskQueue : public PigeonTaskQueue {
+ public:
+  void Post(std::function<void()> task) override {
+    tasks_.push_back(std::move(task));
+  }
+
+  size_t task_count() const { return tasks_.size(); }
+
+  void RunTasks() {
+    std::vector<std::function<void()>> tasks = std::move(tasks_);
+    tasks_.clear();
+    for (const std::function<void()>& task : tasks) {
+      task();
+    }
+  }
+
+ private:
+  std::vector<std::function<void()>> tasks_;
+};
+
+EncodableValue Args(EncodableValue x, EncodableValue y) {
+  return EncodableValue(EncodableList{std::move(x), std::move(y)});
+}
+
+// Sends |message| on |channel| and returns the reply, which must be sent
+// before SendHostMessage returns.
+EncodableList SendMessage(FakeHostMessenger* messenger,
+                          const std::string& channel,
+                          const EncodableValue& message) {
+  EncodableList reply;
+  bool replied = false;
+  messenger->SendHostMessage(channel, message,
+                             [&reply, &replied](const EncodableValue& value) {
+                               reply = std::get<EncodableList>(value);
+                               replied = true;
+                             });
+  EXPECT_TRUE(replied);
+  return reply;
+}
+}  // namespace
+
+TEST(TableDispatch, RepliesWithResults) {
+  FakeHostMessenger messenger(&TaskQueueHostApi::GetCodec());
+  TestHostApi api;
+  TaskQueueHostApi::SetUp(&messenger, &api, "",
+                          std::make_shared<ManualTaskQueue>());
+
+  EXPECT_EQ(SendMessage(&messenger, kSubtractChannelName,
+                        Args(EncodableValue(30), EncodableValue(10))),
+            EncodableList{EncodableValue(int64_t{20})});
+}
+
+TEST(TableDispatch, RepliesWithErrors) {
+  FakeHostMessenger messenger(&TaskQueueHostApi::GetCodec());
+  TestHostApi api;
+  auto task_queue = std::make_shared<ManualTaskQueue>();
+  TaskQueueHostApi::SetUp(&messenger, &api, "", task_queue);
+
+  // A null argument.
+  EXPECT_EQ(SendMessage(&messenger, kSubtractChannelName,
+                        Args(EncodableValue(), EncodableValue(10))),
+            (EncodableList{EncodableValue("x_arg unexpectedly null."),
+                           EncodableValue("Error"), EncodableValue()}));
+  // An exception thrown by the method.
+  EXPECT_EQ(SendMessage(&messenger, kSubtractChannelName,
+                        Args(EncodableValue(1), EncodableValue(10))),
+            (EncodableList{EncodableValue("negative result"),
+                           EncodableValue("Error"), EncodableValue()}));
+  // A FlutterError returned by an async method.
+  EncodableList reply;
+  messenger.SendHostMessage(
+      kEchoAsyncStringChannelName,
+      EncodableValue(EncodableList{EncodableValue("")}),
+      [&reply](const EncodableValue& value) {
+        reply = std::get<EncodableList>(value);
+      });
+  task_queue->RunTasks();
+  EXPECT_EQ(reply, (EncodableList{EncodableValue("empty"),
+                                  EncodableValue("The string is empty"),
+                                  EncodableValue()}));
+}
+
+TEST(TableDispatch, TaskQueueMethodsRunOnTaskQueue) {
+  FakeHostMessenger messenger(&TaskQueueHostApi::GetCodec());
+  TestHostApi api;
+  auto task_queue = std::make_shared<ManualTaskQueue>();
+  TaskQueueHostApi::SetUp(&messenger, &api, "", task_queue);
+
+  EncodableList reply;
+  messenger.SendHostMessage(kAddChannelName,
+                            Args(EncodableValue(2), EncodableValue(3)),
+                            [&reply](const EncodableValue& value) {
+                              reply = std::get<EncodableList>(value);
+                            });
+  EXPECT_EQ(task_queue->task_count(), 1);
+  EXPECT_TRUE(reply.empty());
+
+  task_queue->RunTasks();
+
+  EXPECT_EQ(reply, EncodableList{EncodableValue(int64_t{5})});
+  EXPECT_EQ(api.add_thread_id(), std::this_thread::get_id());
+}
+
+TEST(TableDispatch, DefaultTaskQueueRunsOnBackgroundThread) {
+  FakeHostMessenger messenger(&TaskQueueHostApi::GetCodec());
+  TestHostApi api;
+  TaskQueueHostApi::SetUp(&messenger, &api);
+
+  std::promise<EncodableValue> reply;
+  messenger.SendHostMessage(kAddChannelName,
+                            Args(EncodableValue(2), EncodableValue(3)),
+                            [&reply](const EncodableValue& value) {
+                              reply.set_value(value);
+                            });
+
+  EXPECT_EQ(reply.get_future().get(),
+            EncodableValue(EncodableList{EncodableValue(int64_t{5})}));
+  EXPECT_NE(api.add_thread_id(), std::this_thread::get_id());
+  TaskQueueHostApi::SetUp(&messenger, nullptr);
+}
+
+TEST(TableDispatch, UsesMessageChannelSuffix) {
+  FakeHostMessenger messenger(&TaskQueueHostApi::GetCodec());
+  TestHostApi api;
+  TaskQueueHostApi::SetUp(&messenger, &api, "suffix",
+                          std::make_shared<ManualTaskQueue>());
+
+  EXPECT_EQ(SendMessage(&messenger, std::string(kSubtractChannelName) +
+                                        ".suffix",
+                        Args(EncodableValue(3), EncodableValue(1))),
+            EncodableList{EncodableValue(int64_t{2})});
+}
+
+TEST(TableDispatch, ClearingHandlersReleasesTaskQueue) {
+  FakeHostMessenger messenger(&TaskQueueHostApi::GetCodec());
+  TestHostApi api;
+  auto task_queue = std::make_shared<ManualTaskQueue>();
+  TaskQueueHostApi::SetUp(&messenger, &api, "", task_queue);
+  EXPECT_GT(task_queue.use_count(), 1);
+
+  TaskQueueHostApi::SetUp(&messenger, nullptr);
+
+  EXPECT_EQ(task_queue.use_count(), 1);
+}
+
+}  // namespace task_queue_table_pigeontest
@@ -0,0 +1,306 @@
+// Copyright 2013 The Flutter Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <flutter/encodable_value.h>
+#include <gtest/gtest.h>
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "pigeon/task_queue.gen.h"
+#include "test/utils/fake_host_messenger.h"
+
+namespace task_queue_pigeontest {
+
+namespace {
+using flutter::EncodableList;
+using flutter::EncodableValue;
+using testing::FakeHostMessenger;
+using testing::HostMessageReply;
+
+constexpr char kAddChannelName[] =
+    "dev.flutter.pigeon.pigeon_integration_tests.TaskQueueHostApi.add";
+constexpr char kEchoAsyncStringChannelName[] =
+    "dev.flutter.pigeon.pigeon_integration_tests.TaskQueueHostApi."
+    "echoAsyncString";
+constexpr char kSubtractChannelName[] =
+    "dev.flutter.pigeon.pigeon_integration_tests.TaskQueueHostApi.subtract";
+
+class TestHostApi : public TaskQueueHostApi {
+ public:
+  TestHostApi() {}
+  virtual ~TestHostApi() {}
+
+  // Returns the threads that the handlers ran on, in the order they ran.
+  std::vector<std::thread::id> handler_thread_ids() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return handler_thread_ids_;
+  }
+
+ protected:
+  ErrorOr<int64_t> Add(int64_t x, int64_t y) override {
+    RecordThread();
+    return x + y;
+  }
+
+  void EchoAsyncString(
+      const std::string& a_string,
+      std::function<void(ErrorOr<std::string> reply)> result) override {
+    RecordThread();
+    result(a_string);
+  }
+
+  ErrorOr<int64_t> Subtract(int64_t x, int64_t y) override {
+    RecordThread();
+    return x - y;
+  }
+
+ private:
+  void RecordThread() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    handler_thread_ids_.push_back(std::this_thread::get_id());
+  }
+
+  std::mutex mutex_;
+  std::vector<std::thread::id> handler_thread_ids_;
+};
+
+// A task queue that runs tasks and sends replies only when the test asks it
+// to, on the test's thread.
+class ManualTaskQueue : public PigeonTaskQueue {
+ public:
+  void Post(std::function<void()> task) override {
+    tasks_.push_back(std::move(task));
+  }
+
+  void PostReply(std::function<void()> send_reply) override {
+    replies_.push_back(std::move(send_reply));
+  }
+
+  size_t task_count() const { return tasks_.size(); }
+  size_t reply_count() const { return replies_.size(); }
+
+  void RunTasks() { RunAll(tasks_); }
+  void SendReplies() { RunAll(replies_); }
+
+ private:
+  static void RunAll(std::vector<std::function<void()>>& functions) {
+    std::vector<std::function<void()>> pending = std::move(functions);
+    functions.clear();
+    for (const std::function<void()>& function : pending) {
+      function();
+    }
+  }
+
+  std::vector<std::function<void()>> tasks_;
+  std::vector<std::function<void()>> replies_;
+};
+
+// Runs the tasks posted to the platform thread, which is the test's thread,
+// when the test asks it to.
+class FakePlatformThread {
+ public:
+  std::function<void(std::function<void()> task)> Poster() {
+    return [this](std::function<void()> task) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      tasks_.push_back(std::move(task));
+      condition_.notify_all();
+    };
+  }
+
+  // Waits for |count| tasks to be posted, and runs each of them.
+  void RunTasks(size_t count) {
+    for (size_t i = 0; i < count; i++) {
+      std::function<void()> task;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        condition_.wait(lock, [this]() { return !tasks_.empty(); });
+        task = std::move(tasks_.front());
+        tasks_.pop_front();
+      }
+      task();
+    }
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  std::deque<std::function<void()>> tasks_;
+};
+
+// Collects replies, which can arrive on any thread.
+class ReplyCollector {
+ public:
+  HostMessageReply Reply() {
+    return [this](const EncodableValue& reply) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      replies_.push_back(std::get<EncodableList>(reply)[0]);
+      thread_ids_.push_back(std::this_thread::get_id());
+      condition_.notify_all();
+    };
+  }
+
+  // Returns the threads that the replies were sent on.
+  std::vector<std::thread::id> thread_ids() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return thread_ids_;
+  }
+
+  // Waits for |count| replies, and returns the results they hold.
+  std::vector<EncodableValue> WaitForResults(size_t count) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    condition_.wait(lock, [this, count]() { return replies_.size() >= count; });
+    return replies_;
+  }
+
+  size_t count() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return replies_.size();
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  std::vector<EncodableValue> replies_;
+  std::vector<std::thread::id> thread_ids_;
+};
+
+EncodableValue AddMessage(int64_t x, int64_t y) {
+  return EncodableValue(EncodableList{EncodableValue(x), EncodableValue(y)});
+}
+}  // namespace
+
+TEST(TaskQueue, SerialQueueRunsHandlersInOrderOnOneBackgroundThread) {
+  FakePlatformThread platform_thread;
+  FakeHostMessenger messenger(&TaskQueueHostApi::GetCodec());
+  TestHostApi api;
+  TaskQueueHostApi::SetUp(
+      &messenger, &api, "",
+      std::make_shared<PigeonSerialTaskQueue>(platform_thread.Poster()));
+
+  ReplyCollector replies;
+  constexpr int64_t kMessageCount = 20;
+  for (int64_t i = 0; i < kMessageCount; i++) {
+    messenger.SendHostMessage(kAddChannelName, AddMessage(i, 1),
+                              replies.Reply());
+  }
+  messenger.SendHostMessage(
+      kEchoAsyncStringChannelName,
+      EncodableValue(EncodableList{EncodableValue("hello")}), replies.Reply());
+
+  // The replies are sent from tasks posted to the platform thread.
+  platform_thread.RunTasks(kMessageCount + 1);
+  std::vector<EncodableValue> results =
+      replies.WaitForResults(kMessageCount + 1);
+  for (int64_t i = 0; i < kMessageCount; i++) {
+    EXPECT_EQ(results[i].LongValue(), i + 1);
+  }
+  EXPECT_EQ(std::get<std::string>(results[kMessageCount]), "hello");
+
+  std::vector<std::thread::id> thread_ids = api.handler_thread_ids();
+  ASSERT_EQ(thread_ids.size(), kMessageCount + 1);
+  EXPECT_NE(thread_ids[0], std::this_thread::get_id());
+  for (const std::thread::id& id : thread_ids) {
+    EXPECT_EQ(id, thread_ids[0]);
+  }
+  for (const std::thread::id& id : replies.thread_ids()) {
+    EXPECT_EQ(id, std::this_thread::get_id());
+  }
+}
+
+TEST(TaskQueue, TaskQueueMethodsRunOnCallingThreadByDefault) {
+  FakeHostMessenger messenger(&TaskQueueHostApi::GetCodec());
+  TestHostApi api;
+  TaskQueueHostApi::SetUp(&messenger, &api);
+
+  ReplyCollector replies;
+  messenger.SendHostMessage(kAddChannelName, AddMessage(2, 3),
+                            replies.Reply());
+
+  // The reply is sent before SendHostMessage returns.
+  ASSERT_EQ(replies.count(), 1);
+  EXPECT_EQ(replies.WaitForResults(1)[0].LongValue(), 5);
+  EXPECT_EQ(api.handler_thread_ids(),
+            std::vector<std::thread::id>{std::this_thread::get_id()});
+}
+
+TEST(TaskQueue, MethodsWithoutTaskQueueRunOnCallingThread) {
+  FakeHostMessenger messenger(&TaskQueueHostApi::GetCodec());
+  TestHostApi api;
+  TaskQueueHostApi::SetUp(&messenger, &api);
+
+  ReplyCollector replies;
+  messenger.SendHostMessage(kSubtractChannelName, AddMessage(30, 10),
+                            replies.Reply());
+
+  // The reply is sent before SendHostMessage returns.
+  ASSERT_EQ(replies.count(), 1);
+  EXPECT_EQ(replies.WaitForResults(1)[0].LongValue(), 20);
+  EXPECT_EQ(api.handler_thread_ids(),
+            std::vector<std::thread::id>{std::this_thread::get_id()});
+}
+
+TEST(TaskQueue, CustomTaskQueueRunsHandlersAndSendsReplies) {
+  FakeHostMessenger messenger(&TaskQueueHostApi::GetCodec());
+  TestHostApi api;
+  auto task_queue = std::make_shared<ManualTaskQueue>();
+  TaskQueueHostApi::SetUp(&messenger, &api, "suffix", task_queue);
+
+  ReplyCollector replies;
+  messenger.SendHostMessage(std::string(kAddChannelName) + ".suffix",
+                            AddMessage(2, 3), replies.Reply());
+  EXPECT_EQ(task_queue->task_count(), 1);
+  EXPECT_TRUE(api.handler_thread_ids().empty());
+
+  task_queue->RunTasks();
+  EXPECT_EQ(api.handler_thread_ids().size(), 1);
+  EXPECT_EQ(task_queue->reply_count(), 1);
+  EXPECT_EQ(replies.count(), 0);
+
+  task_queue->SendReplies();
+  ASSERT_EQ(replies.count(), 1);
+  EXPECT_EQ(replies.WaitForResults(1)[0].LongValue(), 5);
+}
+
+TEST(TaskQueue, ClearingHandlersReleasesTaskQueue) {
+  FakeHostMessenger messenger(&TaskQueueHostApi::GetCodec());
+  TestHostApi api;
+  auto task_queue = std::make_shared<ManualTaskQueue>();
+  TaskQueueHostApi::SetUp(&messenger, &api, "", task_queue);
+  EXPECT_GT(task_queue.use_count(), 1);
+
+  TaskQueueHostApi::SetUp(&messenger, nullptr);
+
+  EXPECT_EQ(task_queue.use_count(), 1);
+}
+
+TEST(TaskQueue, SerialQueueRunsPostedTasksAfterHandlersAreCleared) {
+  FakePlatformThread platform_thread;
+  FakeHostMessenger messenger(&TaskQueueHostApi::GetCodec());
+  TestHostApi api;
+  TaskQueueHostApi::SetUp(
+      &messenger, &api, "",
+      std::make_shared<PigeonSerialTaskQueue>(platform_thread.Poster()));
+
+  ReplyCollector replies;
+  constexpr size_t kMessageCount = 5;
+  for (size_t i = 0; i < kMessageCount; i++) {
+    messenger.SendHostMessage(kAddChannelName, AddMessage(1, 1),
+                              replies.Reply());
+  }
+  // This releases the messenger's references to the queue, so the last
+  // posted task releases the queue on its own thread.
+  TaskQueueHostApi::SetUp(&messenger, nullptr);
+
+  platform_thread.RunTasks(kMessageCount);
+  EXPECT_EQ(replies.WaitForResults(kMessageCount).size(), kMessageCount);
+}
+
+}  // namespace task_queue_pigeontest
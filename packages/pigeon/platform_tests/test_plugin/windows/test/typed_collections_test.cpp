@@ -0,0 +1,140 @@
+// Copyright 2013 The Flutter Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <flutter/encodable_value.h>
+#include <flutter/standard_message_codec.h>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "pigeon/core_tests.gen.h"
+#include "pigeon/core_tests_typed.gen.h"
+#include "test/utils/core_tests_test.h"
+
+namespace test_plugin {
+namespace test {
+
+namespace {
+
+namespace typed = core_tests_typed_pigeontest;
+
+using core_tests_pigeontest::AllTypes;
+using flutter::CustomEncodableValue;
+using flutter::EncodableList;
+using flutter::EncodableMap;
+using flutter::EncodableValue;
+using flutter::StandardMessageCodec;
+
+const StandardMessageCodec& Codec() {
+  return StandardMessageCodec::GetInstance(
+      &core_tests_pigeontest::PigeonInternalCodecSerializer::GetInstance());
+}
+
+// Writes ints the way Dart does, which the C++ serializer never does.
+const StandardMessageCodec& Int32EncodingCodec() {
+  return StandardMessageCodec::GetInstance(
+      &core_tests_pigeontest::CoreTestsTest::Int32EncodingSerializer::
+          GetInstance());
+}
+
+const StandardMessageCodec& TypedCodec() {
+  return StandardMessageCodec::GetInstance(
+      &typed::PigeonInternalCodecSerializer::GetInstance());
+}
+
+template <typename T>
+T Decode(const StandardMessageCodec& codec,
+         const std::vector<uint8_t>& message) {
+  std::unique_ptr<EncodableValue> value = codec.DecodeMessage(message);
+  return std::any_cast<T>(std::get<CustomEncodableValue>(*value));
+}
+
+AllTypes CreateAllTypes() {
+  return AllTypes(
+      true, 1, 2, 3.5, std::vector<uint8_t>{1, 2}, std::vector<int32_t>{3},
+      std::vector<int64_t>{4}, std::vector<double>{5.5},
+      core_tests_pigeontest::AnEnum::kTwo,
+      core_tests_pigeontest::AnotherEnum::kJustInCase, "a string",
+      EncodableValue(6), EncodableList{EncodableValue("list")},
+      EncodableList{EncodableValue("a"), EncodableValue("b")},
+      EncodableList{EncodableValue(int64_t{1}), EncodableValue(int64_t{-2})},
+      EncodableList{EncodableValue(1.5), EncodableValue(-2.5)},
+      EncodableList{EncodableValue(true), EncodableValue(false)},
+      EncodableList(), EncodableList(), EncodableList(), EncodableList(),
+      EncodableMap{{EncodableValue("key"), EncodableValue("value")}},
+      EncodableMap{{EncodableValue("a"), EncodableValue("1")},
+                   {EncodableValue("b"), EncodableValue("2")}},
+      EncodableMap{{EncodableValue(int64_t{1}), EncodableValue(int64_t{10})},
+                   {EncodableValue(int64_t{2}), EncodableValue(int64_t{20})}},
+      EncodableMap(), EncodableMap(), EncodableMap(), EncodableMap());
+}
+
+void ExpectTypedFields(const typed::AllTypes& value) {
+  EXPECT_EQ(value.string_list(), (std::vector<std::string>{"a", "b"}));
+  EXPECT_EQ(value.int_list(), (std::vector<int64_t>{1, -2}));
+  EXPECT_EQ(value.double_list(), (std::vector<double>{1.5, -2.5}));
+  EXPECT_EQ(value.bool_list(), (std::vector<bool>{true, false}));
+  EXPECT_EQ(value.string_map(),
+            (std::unordered_map<std::string, std::string>{{"a", "1"},
+                                                          {"b", "2"}}));
+  EXPECT_EQ(value.int_map(),
+            (std::unordered_map<int64_t, int64_t>{{1, 10}, {2, 20}}));
+  // Collections with untyped elements are unchanged.
+  EXPECT_EQ(value.list(), EncodableList{EncodableValue("list")});
+}
+
+}  // namespace
+
+TEST(TypedCollections, DecodesIntoNativeContainers) {
+  std::vector<uint8_t> message =
+      *Codec().EncodeMessage(CustomEncodableValue(CreateAllTypes()));
+
+  ExpectTypedFields(Decode<typed::AllTypes>(TypedCodec(), message));
+}
+
+TEST(TypedCollections, DecodesInt32EncodedElements) {
+  std::vector<uint8_t> message =
+      *Int32EncodingCodec().EncodeMessage(CustomEncodableValue(CreateAllTypes()));
+
+  ExpectTypedFields(Decode<typed::AllTypes>(TypedCodec(), message));
+}
+
+TEST(TypedCollections, EncodesNativeContainers) {
+  std::vector<uint8_t> message =
+      *Codec().EncodeMessage(CustomEncodableValue(CreateAllTypes()));
+  typed::AllTypes decoded = Decode<typed::AllTypes>(TypedCodec(), message);
+
+  std::vector<uint8_t> reencoded =
+      *TypedCodec().EncodeMessage(CustomEncodableValue(decoded));
+  // Maps are compared after decoding, since unordered_map iteration order
+  // doesn't match the order of the original EncodableMap.
+  AllTypes untyped = Decode<AllTypes>(Codec(), reencoded);
+  EXPECT_EQ(untyped.string_list(), CreateAllTypes().string_list());
+  EXPECT_EQ(untyped.int_list(), CreateAllTypes().int_list());
+  EXPECT_EQ(untyped.double_list(), CreateAllTypes().double_list());
+  EXPECT_EQ(untyped.bool_list(), CreateAllTypes().bool_list());
+  EXPECT_EQ(untyped.string_map(), CreateAllTypes().string_map());
+  EXPECT_EQ(untyped.int_map(), CreateAllTypes().int_map());
+  ExpectTypedFields(Decode<typed::AllTypes>(TypedCodec(), reencoded));
+}
+
+TEST(TypedCollections, DataClassMethodsHandleNativeContainers) {
+  std::vector<uint8_t> message =
+      *Codec().EncodeMessage(CustomEncodableValue(CreateAllTypes()));
+  typed::AllTypes value = Decode<typed::AllTypes>(TypedCodec(), message);
+  typed::AllTypes copy = value;
+
+  EXPECT_EQ(value, copy);
+  EXPECT_EQ(value.Hash(), copy.Hash());
+
+  copy.set_int_map(std::unordered_map<int64_t, int64_t>{{1, 10}, {2, 21}});
+  EXPECT_NE(value, copy);
+}
+
+}  // namespace test
+}  // namespace test_plugin
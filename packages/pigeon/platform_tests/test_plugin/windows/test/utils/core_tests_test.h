@@ -0,0 +1,148 @@
+// Copyright 2013 The Flutter Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef PLATFORM_TESTS_TEST_PLUGIN_WINDOWS_TEST_UTILS_CORE_TESTS_TEST_H_
+#define PLATFORM_TESTS_TEST_PLUGIN_WINDOWS_TEST_UTILS_CORE_TESTS_TEST_H_
+
+#include <flutter/byte_streams.h>
+#include <flutter/encodable_value.h>
+
+#include <any>
+#include <cstdint>
+#include <limits>
+#include <utility>
+
+#include "pigeon/core_tests.gen.h"
+
+namespace core_tests_pigeontest {
+
+// The test fixture friend of the core_tests data classes, which gives tests
+// and benchmarks access to their private serialization methods.
+class CoreTestsTest {
+ public:
+  template <typename T>
+  static T FromList(const flutter::EncodableList& list) {
+    return T::FromEncodableList(list);
+  }
+
+  template <typename T>
+  static T FromList(flutter::EncodableList&& list) {
+    return T::FromEncodableList(std::move(list));
+  }
+
+  template <typename T>
+  static flutter::EncodableList ToList(const T& value) {
+    return value.ToEncodableList();
+  }
+
+  // A serializer that decodes data classes from an EncodableList of all of
+  // their fields, rather than reading the fields directly from the stream as
+  // PigeonInternalCodecSerializer does.
+  class ListDecodingSerializer : public PigeonInternalCodecSerializer {
+   public:
+    static const ListDecodingSerializer& GetInstance() {
+      static ListDecodingSerializer instance;
+      return instance;
+    }
+
+   protected:
+    flutter::EncodableValue ReadValueOfType(
+        uint8_t type, flutter::ByteStreamReader* stream) const override {
+      switch (type) {
+        case 131:
+          return DecodeFromList<UnusedClass>(stream);
+        case 132:
+          return DecodeFromList<AllTypes>(stream);
+        case 133:
+          return DecodeFromList<AllNullableTypes>(stream);
+        case 134:
+          return DecodeFromList<AllNullableTypesWithoutRecursion>(stream);
+        case 135:
+          return DecodeFromList<AllClassesWrapper>(stream);
+        case 136:
+          return DecodeFromList<TestMessage>(stream);
+        default:
+          return PigeonInternalCodecSerializer::ReadValueOfType(type, stream);
+      }
+    }
+
+   private:
+    template <typename T>
+    flutter::EncodableValue DecodeFromList(
+        flutter::ByteStreamReader* stream) const {
+      return flutter::CustomEncodableValue(
+          FromList<T>(std::get<flutter::EncodableList>(ReadValue(stream))));
+    }
+  };
+
+  // A serializer that encodes data classes by writing an EncodableList of all
+  // of their fields, rather than writing the fields directly to the stream as
+  // PigeonInternalCodecSerializer does.
+  class ListEncodingSerializer : public PigeonInternalCodecSerializer {
+   public:
+    static const ListEncodingSerializer& GetInstance() {
+      static ListEncodingSerializer instance;
+      return instance;
+    }
+
+    void WriteValue(const flutter::EncodableValue& value,
+                    flutter::ByteStreamWriter* stream) const override {
+      if (const flutter::CustomEncodableValue* custom_value =
+              std::get_if<flutter::CustomEncodableValue>(&value)) {
+        if (EncodeAsList<UnusedClass>(*custom_value, 131, stream) ||
+            EncodeAsList<AllTypes>(*custom_value, 132, stream) ||
+            EncodeAsList<AllNullableTypes>(*custom_value, 133, stream) ||
+            EncodeAsList<AllNullableTypesWithoutRecursion>(*custom_value, 134,
+                                                           stream) ||
+            EncodeAsList<AllClassesWrapper>(*custom_value, 135, stream) ||
+            EncodeAsList<TestMessage>(*custom_value, 136, stream)) {
+          return;
+        }
+      }
+      PigeonInternalCodecSerializer::WriteValue(value, stream);
+    }
+
+   private:
+    template <typename T>
+    bool EncodeAsList(const flutter::CustomEncodableValue& value, uint8_t type,
+                      flutter::ByteStreamWriter* stream) const {
+      if (value.type() != typeid(T)) {
+        return false;
+      }
+      stream->WriteByte(type);
+      const T& object = std::any_cast<const T&>(value);
+      WriteValue(flutter::EncodableValue(ToList(object)), stream);
+      return true;
+    }
+  };
+
+  // A serializer that writes data classes as ListEncodingSerializer does, and
+  // ints that fit in 32 bits as int32, as Dart's StandardMessageCodec does.
+  // PigeonInternalCodecSerializer always writes int64_t values as int64.
+  class Int32EncodingSerializer : public ListEncodingSerializer {
+   public:
+    static const Int32EncodingSerializer& GetInstance() {
+      static Int32EncodingSerializer instance;
+      return instance;
+    }
+
+    void WriteValue(const flutter::EncodableValue& value,
+                    flutter::ByteStreamWriter* stream) const override {
+      if (const int64_t* int_value = std::get_if<int64_t>(&value)) {
+        if (*int_value >= std::numeric_limits<int32_t>::min() &&
+            *int_value <= std::numeric_limits<int32_t>::max()) {
+          ListEncodingSerializer::WriteValue(
+              flutter::EncodableValue(static_cast<int32_t>(*int_value)),
+              stream);
+          return;
+        }
+      }
+      ListEncodingSerializer::WriteValue(value, stream);
+    }
+  };
+};
+
+}  // namespace core_tests_pigeontest
+
+#endif  // PLATFORM_TESTS_TEST_PLUGIN_WINDOWS_TEST_UTILS_CORE_TESTS_TEST_H_
@@ -34,9 +34,35 @@ void FakeHostMessenger::SendHostMessage(const std::string& channel,
   handlers_[channel](data->data(), data->size(), std::move(binary_handler));
 }
 
+void FakeHostMessenger::SendHostBytes(const std::string& channel,
+                                      const std::vector<uint8_t>& message) {
+  handlers_[channel](message.data(), message.size(),
+                     [](const uint8_t* reply_data, size_t reply_size) {});
+}
+
+void FakeHostMessenger::SetDartMessageHandler(DartMessageHandler handler) {
+  dart_message_handler_ = std::move(handler);
+}
+
+void FakeHostMessenger::SetDartMessageResponder(
+    DartMessageResponder responder) {
+  dart_message_responder_ = std::move(responder);
+}
+
 void FakeHostMessenger::Send(const std::string& channel, const uint8_t* message,
                              size_t message_size,
-                             flutter::BinaryReply reply) const {}
+                             flutter::BinaryReply reply) const {
+  if (dart_message_handler_) {
+    dart_message_handler_(channel, message, message_size);
+  }
+  if (dart_message_responder_ && reply) {
+    std::unique_ptr<flutter::EncodableValue> decoded =
+        codec_->DecodeMessage(message, message_size);
+    std::unique_ptr<std::vector<uint8_t>> response =
+        codec_->EncodeMessage(dart_message_responder_(channel, *decoded));
+    reply(response->data(), response->size());
+  }
+}
 
 void FakeHostMessenger::SetMessageHandler(
     const std::string& channel, flutter::BinaryMessageHandler handler) {
@@ -10,12 +10,21 @@
 #include <flutter/message_codec.h>
 
 #include <map>
+#include <vector>
 
 namespace testing {
 
 typedef std::function<void(const flutter::EncodableValue& reply)>
     HostMessageReply;
 
+typedef std::function<void(const std::string& channel, const uint8_t* message,
+                           size_t message_size)>
+    DartMessageHandler;
+
+typedef std::function<flutter::EncodableValue(
+    const std::string& channel, const flutter::EncodableValue& message)>
+    DartMessageResponder;
+
 // A BinaryMessenger that allows tests to act as the engine to call host APIs.
 class FakeHostMessenger : public flutter::BinaryMessenger {
  public:
@@ -34,6 +43,24 @@ class FakeHostMessenger : public flutter::BinaryMessenger {
                        const flutter::EncodableValue& message,
                        HostMessageReply reply_handler);
 
+  // Calls the registered handler for the given channel with an already
+  // encoded message, ignoring the response.
+  //
+  // This allows a test to send messages that are not encoded with the message
+  // codec, such as the method calls used by event channels.
+  void SendHostBytes(const std::string& channel,
+                     const std::vector<uint8_t>& message);
+
+  // Sets the function that is called with messages sent from the host to the
+  // Dart side, such as the events sent on an event channel.
+  void SetDartMessageHandler(DartMessageHandler handler);
+
+  // Sets the function that replies to messages sent from the host to the Dart
+  // side, such as the requests for the chunks of a streamed argument.
+  //
+  // The messages and replies are encoded with the messenger's codec.
+  void SetDartMessageResponder(DartMessageResponder responder);
+
   // flutter::BinaryMessenger:
   void Send(const std::string& channel, const uint8_t* message,
             size_t message_size,
@@ -44,6 +71,8 @@ class FakeHostMessenger : public flutter::BinaryMessenger {
  private:
   const flutter::MessageCodec<flutter::EncodableValue>* codec_;
   std::map<std::string, flutter::BinaryMessageHandler> handlers_;
+  DartMessageHandler dart_message_handler_;
+  DartMessageResponder dart_message_responder_;
 };
 
 }  // namespace testing
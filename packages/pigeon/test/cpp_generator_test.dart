@@ -6,6 +6,7 @@ import 'package:pigeon/src/ast.dart';
 import 'package:pigeon/src/cpp/cpp_generator.dart';
 import 'package:pigeon/src/generator_tools.dart';
 import 'package:pigeon/src/pigeon_lib.dart' show Error;
+import 'package:pigeon/src/types/task_queue.dart';
 import 'package:test/test.dart';
 
 const String DEFAULT_PACKAGE_NAME = 'test_package';
@@ -909,6 +910,631 @@ void main() {
     }
   });
 
+  test('data classes can take ownership of movable values', () {
+    final nestedClass = Class(
+      name: 'Nested',
+      fields: <NamedType>[
+        NamedType(
+          type: const TypeDeclaration(baseName: 'bool', isNullable: false),
+          name: 'nestedValue',
+        ),
+      ],
+    );
+    final root = Root(
+      apis: <Api>[],
+      classes: <Class>[
+        nestedClass,
+        Class(
+          name: 'Input',
+          fields: <NamedType>[
+            NamedType(
+              type: const TypeDeclaration(baseName: 'bool', isNullable: false),
+              name: 'aBool',
+            ),
+            NamedType(
+              type: const TypeDeclaration(baseName: 'String', isNullable: false),
+              name: 'aString',
+            ),
+            NamedType(
+              type: const TypeDeclaration(baseName: 'List', isNullable: false),
+              name: 'aList',
+            ),
+            NamedType(
+              type: TypeDeclaration(
+                baseName: 'Nested',
+                isNullable: false,
+                associatedClass: nestedClass,
+              ),
+              name: 'nested',
+            ),
+            NamedType(
+              type: const TypeDeclaration(baseName: 'Map', isNullable: true),
+              name: 'nullableMap',
+            ),
+          ],
+        ),
+      ],
+      enums: <Enum>[],
+    );
+    {
+      final sink = StringBuffer();
+      const generator = CppGenerator();
+      final generatorOptions = OutputFileOptions<InternalCppOptions>(
+        fileType: FileType.header,
+        languageOptions: const InternalCppOptions(
+          cppHeaderOut: '',
+          cppSourceOut: '',
+          headerIncludePath: '',
+        ),
+      );
+      generator.generate(generatorOptions, root, sink, dartPackageName: DEFAULT_PACKAGE_NAME);
+      final code = sink.toString();
+
+      // Constructors with movable values get an rvalue overload, in which POD
+      // and nullable values are passed as in the copying version.
+      expect(
+        code,
+        contains(
+          RegExp(
+            r'explicit Input\(\s*bool a_bool,\s*std::string&& a_string,\s*'
+            r'::flutter::EncodableList&& a_list,\s*Nested&& nested\)',
+          ),
+        ),
+      );
+      expect(
+        code,
+        contains(
+          RegExp(
+            r'explicit Input\(\s*bool a_bool,\s*std::string&& a_string,\s*'
+            r'::flutter::EncodableList&& a_list,\s*Nested&& nested,\s*'
+            r'const ::flutter::EncodableMap\* nullable_map\)',
+          ),
+        ),
+      );
+      // Constructors without movable values don't.
+      expect(code, isNot(contains('Nested(bool&&')));
+      // Setters take rvalues for movable types other than strings.
+      expect(code, contains('void set_a_list(::flutter::EncodableList&& value_arg)'));
+      expect(code, contains('void set_nested(Nested&& value_arg)'));
+      expect(code, contains('void set_nullable_map(::flutter::EncodableMap&& value_arg)'));
+      expect(code, isNot(contains('std::string&& value_arg')));
+      expect(code, isNot(contains('bool&& value_arg')));
+      // There is a consuming deserialization method.
+      expect(
+        code,
+        contains(RegExp(r'static Input FromEncodableList\(\s*::flutter::EncodableList&& list\)')),
+      );
+    }
+    {
+      final sink = StringBuffer();
+      const generator = CppGenerator();
+      final generatorOptions = OutputFileOptions<InternalCppOptions>(
+        fileType: FileType.source,
+        languageOptions: const InternalCppOptions(
+          cppHeaderOut: '',
+          cppSourceOut: '',
+          headerIncludePath: '',
+        ),
+      );
+      generator.generate(generatorOptions, root, sink, dartPackageName: DEFAULT_PACKAGE_NAME);
+      final code = sink.toString();
+
+      // The rvalue constructor moves the values into place.
+      expect(code, contains('a_string_(std::move(a_string))'));
+      expect(code, contains('nested_(std::make_unique<Nested>(std::move(nested)))'));
+      // The rvalue setters do the same.
+      expect(code, contains('a_list_ = std::move(value_arg);'));
+      expect(code, contains('nested_ = std::make_unique<Nested>(std::move(value_arg));'));
+      // The consuming deserialization method moves values out of the list.
+      expect(code, contains('Input Input::FromEncodableList(EncodableList&& list)'));
+      expect(code, contains('std::move(std::get<std::string>(list[1]))'));
+      expect(
+        code,
+        contains('std::move(std::any_cast<Nested&>(std::get<CustomEncodableValue>(list[3])))'),
+      );
+      expect(
+        code,
+        contains('decoded.nullable_map_ = std::move(std::get<EncodableMap>(encodable_nullable_map));'),
+      );
+    }
+  });
+
+  test('codec decodes data classes directly from the stream', () {
+    final nestedClass = Class(
+      name: 'Nested',
+      fields: <NamedType>[
+        NamedType(
+          type: const TypeDeclaration(baseName: 'bool', isNullable: false),
+          name: 'nestedValue',
+        ),
+      ],
+    );
+    final root = Root(
+      apis: <Api>[],
+      classes: <Class>[
+        nestedClass,
+        Class(
+          name: 'Input',
+          fields: <NamedType>[
+            NamedType(
+              type: const TypeDeclaration(baseName: 'String', isNullable: false),
+              name: 'aString',
+            ),
+            NamedType(
+              type: const TypeDeclaration(baseName: 'int', isNullable: true),
+              name: 'nullableInt',
+            ),
+            NamedType(
+              type: TypeDeclaration(
+                baseName: 'Nested',
+                isNullable: false,
+                associatedClass: nestedClass,
+              ),
+              name: 'nested',
+            ),
+            NamedType(
+              type: const TypeDeclaration(baseName: 'List', isNullable: true),
+              name: 'nullableList',
+            ),
+          ],
+        ),
+      ],
+      enums: <Enum>[],
+    );
+    {
+      final sink = StringBuffer();
+      const generator = CppGenerator();
+      final generatorOptions = OutputFileOptions<InternalCppOptions>(
+        fileType: FileType.header,
+        languageOptions: const InternalCppOptions(
+          cppHeaderOut: '',
+          cppSourceOut: '',
+          headerIncludePath: '',
+        ),
+      );
+      generator.generate(generatorOptions, root, sink, dartPackageName: DEFAULT_PACKAGE_NAME);
+      final code = sink.toString();
+
+      // Classes with required fields get a private default constructor for the
+      // codec to decode into.
+      expect(code, contains('Input() = default;'));
+      expect(code, contains('Nested() = default;'));
+      expect(
+        code,
+        contains(
+          RegExp(r'Input ReadInput\(\s*uint8_t type,\s*::flutter::ByteStreamReader\* stream\) const;'),
+        ),
+      );
+      expect(
+        code,
+        contains(
+          RegExp(r'Nested ReadNested\(\s*uint8_t type,\s*::flutter::ByteStreamReader\* stream\) const;'),
+        ),
+      );
+    }
+    {
+      final sink = StringBuffer();
+      const generator = CppGenerator();
+      final generatorOptions = OutputFileOptions<InternalCppOptions>(
+        fileType: FileType.source,
+        languageOptions: const InternalCppOptions(
+          cppHeaderOut: '',
+          cppSourceOut: '',
+          headerIncludePath: '',
+        ),
+      );
+      generator.generate(generatorOptions, root, sink, dartPackageName: DEFAULT_PACKAGE_NAME);
+      final code = sink.toString();
+
+      expect(code, contains('constexpr uint8_t kEncodedNull = 0;'));
+      expect(code, contains('PigeonInternalSetCustomValue(ReadInput(type, stream), &value);'));
+      // Fields that are read directly from the stream.
+      expect(code, contains('decoded.a_string_ = ReadEncodedString(stream->ReadByte(), stream);'));
+      expect(code, contains('if (field_type != kEncodedNull) {'));
+      expect(code, contains('decoded.nullable_int_ = ReadEncodedInt64(field_type, stream);'));
+      expect(
+        code,
+        contains(
+          'decoded.nested_ = std::make_unique<Nested>(ReadNested(stream->ReadByte(), stream));',
+        ),
+      );
+      // Other fields are read as an EncodableValue.
+      expect(code, contains('EncodableValue encodable_nullable_list = ReadValue(stream);'));
+      // Messages that don't match the class fall back to the list decoding.
+      expect(code, contains('if (!ReadEncodedFieldList(stream, 4, &list)) {'));
+      expect(code, contains('return Input::FromEncodableList(std::move(list));'));
+      // Values that aren't the fields of the class fail to decode.
+      expect(
+        code,
+        contains('*list = std::get<EncodableList>(ReadValueOfType(type, stream));'),
+      );
+      expect(code, contains('if (list->size() < field_count) {'));
+      expect(code, contains('throw std::runtime_error('));
+      expect(code, isNot(contains('std::cerr')));
+      // Ints are also accepted in the int32 encoding that Dart uses for
+      // small values.
+      expect(code, contains('if (type == kEncodedInt32) {'));
+      expect(code, contains('return ReadValueOfType(type, stream).LongValue();'));
+    }
+  });
+
+  test('moves data classes into encodable values instead of copying them', () {
+    final dataClass = Class(
+      name: 'Data',
+      fields: <NamedType>[
+        NamedType(
+          type: const TypeDeclaration(baseName: 'String', isNullable: false),
+          name: 'aString',
+        ),
+      ],
+    );
+    final root = Root(
+      apis: <Api>[
+        AstHostApi(
+          name: 'Api',
+          methods: <Method>[
+            Method(
+              name: 'echo',
+              location: ApiLocation.host,
+              returnType: TypeDeclaration(
+                baseName: 'Data',
+                isNullable: false,
+                associatedClass: dataClass,
+              ),
+              parameters: <Parameter>[],
+            ),
+            Method(
+              name: 'echoNullable',
+              location: ApiLocation.host,
+              returnType: TypeDeclaration(
+                baseName: 'Data',
+                isNullable: true,
+                associatedClass: dataClass,
+              ),
+              parameters: <Parameter>[],
+            ),
+          ],
+        ),
+      ],
+      classes: <Class>[dataClass],
+      enums: <Enum>[],
+    );
+    final sink = StringBuffer();
+    const generator = CppGenerator();
+    final generatorOptions = OutputFileOptions<InternalCppOptions>(
+      fileType: FileType.source,
+      languageOptions: const InternalCppOptions(
+        cppHeaderOut: '',
+        cppSourceOut: '',
+        headerIncludePath: '',
+      ),
+    );
+    generator.generate(generatorOptions, root, sink, dartPackageName: DEFAULT_PACKAGE_NAME);
+    final code = sink.toString();
+
+    expect(
+      code,
+      contains(
+        'void PigeonInternalSetCustomValue(T&& value, EncodableValue* encodable) {',
+      ),
+    );
+    expect(
+      code,
+      contains(
+        'void PigeonInternalMoveValue(EncodableValue&& source, EncodableValue* destination) {',
+      ),
+    );
+    // Decoding.
+    expect(code, contains('PigeonInternalSetCustomValue(ReadData(type, stream), &value);'));
+    expect(code, contains('case kEncodedList: {'));
+    expect(code, contains('PigeonInternalMoveValue(ReadValue(stream), &element);'));
+    expect(code, contains('case kEncodedMap: {'));
+    expect(code, contains('PigeonInternalMoveValue(std::move(value), &entry->second);'));
+    // Replies.
+    expect(
+      code,
+      contains(
+        'PigeonInternalSetCustomValue(std::move(output).TakeValue(), &wrapped.back());',
+      ),
+    );
+    expect(
+      code,
+      contains(
+        'PigeonInternalSetCustomValue(std::move(output_optional).value(), &wrapped.back());',
+      ),
+    );
+    expect(code, isNot(contains('wrapped.push_back(CustomEncodableValue(')));
+  });
+
+  test('codec encodes data classes directly to the stream', () {
+    final nestedClass = Class(
+      name: 'Nested',
+      fields: <NamedType>[
+        NamedType(
+          type: const TypeDeclaration(baseName: 'bool', isNullable: false),
+          name: 'nestedValue',
+        ),
+      ],
+    );
+    final anEnum = Enum(
+      name: 'AnEnum',
+      members: <EnumMember>[EnumMember(name: 'one'), EnumMember(name: 'two')],
+    );
+    final root = Root(
+      apis: <Api>[],
+      classes: <Class>[
+        nestedClass,
+        Class(
+          name: 'Input',
+          fields: <NamedType>[
+            NamedType(
+              type: const TypeDeclaration(baseName: 'String', isNullable: false),
+              name: 'aString',
+            ),
+            NamedType(
+              type: const TypeDeclaration(baseName: 'int', isNullable: true),
+              name: 'nullableInt',
+            ),
+            NamedType(
+              type: TypeDeclaration(
+                baseName: 'Nested',
+                isNullable: false,
+                associatedClass: nestedClass,
+              ),
+              name: 'nested',
+            ),
+            NamedType(
+              type: TypeDeclaration(baseName: 'AnEnum', isNullable: false, associatedEnum: anEnum),
+              name: 'anEnum',
+            ),
+            NamedType(
+              type: const TypeDeclaration(baseName: 'List', isNullable: true),
+              name: 'nullableList',
+            ),
+          ],
+        ),
+      ],
+      enums: <Enum>[anEnum],
+    );
+    {
+      final sink = StringBuffer();
+      const generator = CppGenerator();
+      final generatorOptions = OutputFileOptions<InternalCppOptions>(
+        fileType: FileType.header,
+        languageOptions: const InternalCppOptions(
+          cppHeaderOut: '',
+          cppSourceOut: '',
+          headerIncludePath: '',
+        ),
+      );
+      generator.generate(generatorOptions, root, sink, dartPackageName: DEFAULT_PACKAGE_NAME);
+      final code = sink.toString();
+
+      expect(
+        code,
+        contains(
+          RegExp(
+            r'void WriteFields\(\s*const Input& value,\s*::flutter::ByteStreamWriter\* stream\) const;',
+          ),
+        ),
+      );
+      expect(
+        code,
+        contains(
+          RegExp(
+            r'void WriteFields\(\s*const Nested& value,\s*::flutter::ByteStreamWriter\* stream\) const;',
+          ),
+        ),
+      );
+    }
+    {
+      final sink = StringBuffer();
+      const generator = CppGenerator();
+      final generatorOptions = OutputFileOptions<InternalCppOptions>(
+        fileType: FileType.source,
+        languageOptions: const InternalCppOptions(
+          cppHeaderOut: '',
+          cppSourceOut: '',
+          headerIncludePath: '',
+        ),
+      );
+      generator.generate(generatorOptions, root, sink, dartPackageName: DEFAULT_PACKAGE_NAME);
+      final code = sink.toString();
+
+      // The codec writes data classes without converting them to a list.
+      expect(code, contains('WriteFields(std::any_cast<const Input&>(*custom_value), stream);'));
+      expect(code, isNot(contains('std::any_cast<Input>(*custom_value).ToEncodableList()')));
+      // The fields are written in the format of the encodable list.
+      expect(code, contains('stream->WriteByte(kEncodedList);'));
+      expect(code, contains('WriteSize(5, stream);'));
+      expect(code, contains('WriteEncodedString(value.a_string_, stream);'));
+      expect(code, contains('if (value.nullable_int_) {'));
+      expect(code, contains('WriteEncodedInt64(*value.nullable_int_, stream);'));
+      expect(code, contains('stream->WriteByte(kEncodedNull);'));
+      expect(code, contains('WriteFields(*value.nested_, stream);'));
+      expect(code, contains('WriteValue(EncodableValue(static_cast<int>(value.an_enum_)), stream);'));
+      expect(code, contains('WriteEncodedList(*value.nullable_list_, stream);'));
+    }
+  });
+
+  test('typed collections use native containers', () {
+    final root = Root(
+      apis: <Api>[],
+      classes: <Class>[
+        Class(
+          name: 'Input',
+          fields: <NamedType>[
+            NamedType(
+              type: const TypeDeclaration(
+                baseName: 'List',
+                typeArguments: <TypeDeclaration>[
+                  TypeDeclaration(baseName: 'int', isNullable: false),
+                ],
+                isNullable: false,
+              ),
+              name: 'intList',
+            ),
+            NamedType(
+              type: const TypeDeclaration(
+                baseName: 'Map',
+                typeArguments: <TypeDeclaration>[
+                  TypeDeclaration(baseName: 'String', isNullable: false),
+                  TypeDeclaration(baseName: 'int', isNullable: false),
+                ],
+                isNullable: true,
+              ),
+              name: 'intMap',
+            ),
+            NamedType(
+              type: const TypeDeclaration(
+                baseName: 'List',
+                typeArguments: <TypeDeclaration>[
+                  TypeDeclaration(baseName: 'String', isNullable: true),
+                ],
+                isNullable: false,
+              ),
+              name: 'nullableStringList',
+            ),
+          ],
+        ),
+      ],
+      enums: <Enum>[],
+    );
+    String generate(FileType fileType, {required bool typedCollections}) {
+      final sink = StringBuffer();
+      const generator = CppGenerator();
+      final generatorOptions = OutputFileOptions<InternalCppOptions>(
+        fileType: fileType,
+        languageOptions: InternalCppOptions(
+          cppHeaderOut: '',
+          cppSourceOut: '',
+          headerIncludePath: '',
+          typedCollections: typedCollections,
+        ),
+      );
+      generator.generate(generatorOptions, root, sink, dartPackageName: DEFAULT_PACKAGE_NAME);
+      return sink.toString();
+    }
+
+    {
+      final String code = generate(FileType.header, typedCollections: true);
+      expect(code, contains('#include <unordered_map>'));
+      expect(code, contains('const std::vector<int64_t>& int_list() const;'));
+      expect(code, contains('std::vector<int64_t> int_list_;'));
+      expect(code, contains('const std::unordered_map<std::string, int64_t>* int_map() const;'));
+      expect(code, contains('std::optional<std::unordered_map<std::string, int64_t>> int_map_;'));
+      // Lists with nullable elements can't be typed.
+      expect(code, contains('::flutter::EncodableList nullable_string_list_;'));
+      expect(code, contains('std::vector<T> ReadEncodedVector('));
+      expect(code, contains('void WriteEncodedUnorderedMap('));
+    }
+    {
+      final String code = generate(FileType.source, typedCollections: true);
+      expect(code, contains('list.push_back(PigeonInternalToEncodableValue(int_list_));'));
+      expect(
+        code,
+        contains(
+          'list.push_back(int_map_ ? PigeonInternalToEncodableValue(*int_map_) : EncodableValue());',
+        ),
+      );
+      expect(code, contains('PigeonInternalVectorFromEncodable<int64_t>(list[0])'));
+      expect(
+        code,
+        contains(
+          'PigeonInternalUnorderedMapFromEncodable<std::string, int64_t>(encodable_int_map)',
+        ),
+      );
+      // The codec reads and writes them directly from and to the stream.
+      expect(
+        code,
+        contains('decoded.int_list_ = ReadEncodedVector<int64_t>(stream->ReadByte(), stream);'),
+      );
+      expect(
+        code,
+        contains(
+          'decoded.int_map_ = ReadEncodedUnorderedMap<std::string, int64_t>(field_type, stream);',
+        ),
+      );
+      expect(code, contains('WriteEncodedVector(value.int_list_, stream);'));
+      expect(code, contains('WriteEncodedUnorderedMap(*value.int_map_, stream);'));
+      expect(code, contains('WriteEncodedList(value.nullable_string_list_, stream);'));
+      expect(code, contains('PigeonInternalDeepHash(const std::unordered_map<K, V>& v)'));
+    }
+    {
+      // Without the option, the same fields use the encodable collections.
+      final String header = generate(FileType.header, typedCollections: false);
+      expect(header, isNot(contains('unordered_map')));
+      expect(header, contains('::flutter::EncodableList int_list_;'));
+      expect(header, contains('std::optional<::flutter::EncodableMap> int_map_;'));
+      final String source = generate(FileType.source, typedCollections: false);
+      expect(source, isNot(contains('unordered_map')));
+      expect(source, isNot(contains('PigeonInternalToEncodableValue')));
+    }
+  });
+
+  test('typed collections are only used for data class fields', () {
+    const intList = TypeDeclaration(
+      baseName: 'List',
+      typeArguments: <TypeDeclaration>[TypeDeclaration(baseName: 'int', isNullable: false)],
+      isNullable: false,
+    );
+    const intMap = TypeDeclaration(
+      baseName: 'Map',
+      typeArguments: <TypeDeclaration>[
+        TypeDeclaration(baseName: 'String', isNullable: false),
+        TypeDeclaration(baseName: 'int', isNullable: false),
+      ],
+      isNullable: false,
+    );
+    final root = Root(
+      apis: <Api>[
+        AstHostApi(
+          name: 'HostApi',
+          methods: <Method>[
+            Method(
+              name: 'sum',
+              location: ApiLocation.host,
+              parameters: <Parameter>[Parameter(name: 'intList', type: intList)],
+              returnType: intMap,
+            ),
+          ],
+        ),
+        AstFlutterApi(
+          name: 'FlutterApi',
+          methods: <Method>[
+            Method(
+              name: 'count',
+              location: ApiLocation.flutter,
+              parameters: <Parameter>[Parameter(name: 'intMap', type: intMap)],
+              returnType: intList,
+            ),
+          ],
+        ),
+      ],
+      classes: <Class>[],
+      enums: <Enum>[],
+    );
+    final sink = StringBuffer();
+    const generator = CppGenerator();
+    final generatorOptions = OutputFileOptions<InternalCppOptions>(
+      fileType: FileType.header,
+      languageOptions: const InternalCppOptions(
+        cppHeaderOut: '',
+        cppSourceOut: '',
+        headerIncludePath: '',
+        typedCollections: true,
+      ),
+    );
+    generator.generate(generatorOptions, root, sink, dartPackageName: DEFAULT_PACKAGE_NAME);
+    final code = sink.toString();
+    // API arguments and results are still passed as the encodable
+    // collections, which the handlers receive without converting them.
+    expect(code, contains('ErrorOr<::flutter::EncodableMap> Sum(const ::flutter::EncodableList& int_list)'));
+    expect(code, contains('const ::flutter::EncodableMap& int_map'));
+    expect(code, isNot(contains('std::vector<int64_t>')));
+    expect(code, isNot(contains('std::unordered_map<std::string, int64_t>')));
+  });
+
   test('host nullable return types map correctly', () {
     final root = Root(
       apis: <Api>[
@@ -1705,19 +2331,299 @@ void main() {
               location: ApiLocation.host,
               parameters: <Parameter>[
                 Parameter(
-                  name: 'anArg',
+                  name: 'anArg',
+                  type: const TypeDeclaration(baseName: 'int', isNullable: false),
+                ),
+              ],
+              returnType: const TypeDeclaration.voidDeclaration(),
+            ),
+          ],
+        ),
+      ],
+      classes: <Class>[],
+      enums: <Enum>[],
+    );
+
+    final sink = StringBuffer();
+    const generator = CppGenerator();
+    final generatorOptions = OutputFileOptions<InternalCppOptions>(
+      fileType: FileType.source,
+      languageOptions: const InternalCppOptions(
+        cppHeaderOut: '',
+        cppSourceOut: '',
+        headerIncludePath: '',
+      ),
+    );
+    generator.generate(generatorOptions, root, sink, dartPackageName: DEFAULT_PACKAGE_NAME);
+    final code = sink.toString();
+    // A bare 'auto' here would create a copy, not a reference, which is
+    // inefficient.
+    expect(code, contains('const auto& args = std::get<EncodableList>(message);'));
+    expect(code, contains('const auto& encodable_an_arg_arg = args.at(0);'));
+  });
+
+  test('enum argument', () {
+    final root = Root(
+      apis: <Api>[
+        AstHostApi(
+          name: 'Bar',
+          methods: <Method>[
+            Method(
+              name: 'bar',
+              location: ApiLocation.host,
+              returnType: const TypeDeclaration.voidDeclaration(),
+              parameters: <Parameter>[
+                Parameter(
+                  name: 'foo',
+                  type: TypeDeclaration(
+                    baseName: 'Foo',
+                    isNullable: false,
+                    associatedEnum: emptyEnum,
+                  ),
+                ),
+              ],
+            ),
+          ],
+        ),
+      ],
+      classes: <Class>[],
+      enums: <Enum>[
+        Enum(
+          name: 'Foo',
+          members: <EnumMember>[
+            EnumMember(name: 'one'),
+            EnumMember(name: 'two'),
+          ],
+        ),
+      ],
+    );
+    final List<Error> errors = validateCpp(
+      const InternalCppOptions(cppHeaderOut: '', cppSourceOut: '', headerIncludePath: ''),
+      root,
+    );
+    expect(errors.length, 1);
+  });
+
+  test('transfers documentation comments', () {
+    final comments = <String>[
+      ' api comment',
+      ' api method comment',
+      ' class comment',
+      ' class field comment',
+      ' enum comment',
+      ' enum member comment',
+    ];
+    var count = 0;
+
+    final unspacedComments = <String>['////////'];
+    var unspacedCount = 0;
+
+    final root = Root(
+      apis: <Api>[
+        AstFlutterApi(
+          name: 'Api',
+          documentationComments: <String>[comments[count++]],
+          methods: <Method>[
+            Method(
+              name: 'method',
+              location: ApiLocation.flutter,
+              returnType: const TypeDeclaration.voidDeclaration(),
+              documentationComments: <String>[comments[count++]],
+              parameters: <Parameter>[
+                Parameter(
+                  name: 'field',
+                  type: const TypeDeclaration(baseName: 'int', isNullable: true),
+                ),
+              ],
+            ),
+          ],
+        ),
+      ],
+      classes: <Class>[
+        Class(
+          name: 'class',
+          documentationComments: <String>[comments[count++]],
+          fields: <NamedType>[
+            NamedType(
+              documentationComments: <String>[comments[count++]],
+              type: const TypeDeclaration(
+                baseName: 'Map',
+                isNullable: true,
+                typeArguments: <TypeDeclaration>[
+                  TypeDeclaration(baseName: 'String', isNullable: true),
+                  TypeDeclaration(baseName: 'int', isNullable: true),
+                ],
+              ),
+              name: 'field1',
+            ),
+          ],
+        ),
+      ],
+      enums: <Enum>[
+        Enum(
+          name: 'enum',
+          documentationComments: <String>[comments[count++], unspacedComments[unspacedCount++]],
+          members: <EnumMember>[
+            EnumMember(name: 'one', documentationComments: <String>[comments[count++]]),
+            EnumMember(name: 'two'),
+          ],
+        ),
+      ],
+    );
+    final sink = StringBuffer();
+    const generator = CppGenerator();
+    final generatorOptions = OutputFileOptions<InternalCppOptions>(
+      fileType: FileType.header,
+      languageOptions: const InternalCppOptions(
+        headerIncludePath: 'foo',
+        cppHeaderOut: '',
+        cppSourceOut: '',
+      ),
+    );
+    generator.generate(generatorOptions, root, sink, dartPackageName: DEFAULT_PACKAGE_NAME);
+    final code = sink.toString();
+    for (final comment in comments) {
+      expect(code, contains('//$comment'));
+    }
+    expect(code, contains('// ///'));
+  });
+
+  test('creates custom codecs', () {
+    final root = Root(
+      apis: <Api>[
+        AstFlutterApi(
+          name: 'Api',
+          methods: <Method>[
+            Method(
+              name: 'doSomething',
+              location: ApiLocation.flutter,
+              parameters: <Parameter>[
+                Parameter(
+                  type: TypeDeclaration(
+                    baseName: 'Input',
+                    isNullable: false,
+                    associatedClass: emptyClass,
+                  ),
+                  name: '',
+                ),
+              ],
+              returnType: TypeDeclaration(
+                baseName: 'Output',
+                isNullable: false,
+                associatedClass: emptyClass,
+              ),
+              isAsynchronous: true,
+            ),
+          ],
+        ),
+      ],
+      classes: <Class>[
+        Class(
+          name: 'Input',
+          fields: <NamedType>[
+            NamedType(
+              type: const TypeDeclaration(baseName: 'String', isNullable: true),
+              name: 'input',
+            ),
+          ],
+        ),
+        Class(
+          name: 'Output',
+          fields: <NamedType>[
+            NamedType(
+              type: const TypeDeclaration(baseName: 'String', isNullable: true),
+              name: 'output',
+            ),
+          ],
+        ),
+      ],
+      enums: <Enum>[],
+    );
+    final sink = StringBuffer();
+    const generator = CppGenerator();
+    final generatorOptions = OutputFileOptions<InternalCppOptions>(
+      fileType: FileType.header,
+      languageOptions: const InternalCppOptions(
+        cppHeaderOut: '',
+        cppSourceOut: '',
+        headerIncludePath: '',
+      ),
+    );
+    generator.generate(generatorOptions, root, sink, dartPackageName: DEFAULT_PACKAGE_NAME);
+    final code = sink.toString();
+    expect(code, contains(' : public ::flutter::StandardCodecSerializer'));
+  });
+
+  test('Does not send unwrapped EncodableLists', () {
+    final root = Root(
+      apis: <Api>[
+        AstHostApi(
+          name: 'Api',
+          methods: <Method>[
+            Method(
+              name: 'doSomething',
+              location: ApiLocation.host,
+              parameters: <Parameter>[
+                Parameter(
+                  name: 'aBool',
+                  type: const TypeDeclaration(baseName: 'bool', isNullable: false),
+                ),
+                Parameter(
+                  name: 'anInt',
                   type: const TypeDeclaration(baseName: 'int', isNullable: false),
                 ),
+                Parameter(
+                  name: 'aString',
+                  type: const TypeDeclaration(baseName: 'String', isNullable: false),
+                ),
+                Parameter(
+                  name: 'aList',
+                  type: const TypeDeclaration(
+                    baseName: 'List',
+                    typeArguments: <TypeDeclaration>[
+                      TypeDeclaration(baseName: 'Object', isNullable: true),
+                    ],
+                    isNullable: false,
+                  ),
+                ),
+                Parameter(
+                  name: 'aMap',
+                  type: const TypeDeclaration(
+                    baseName: 'Map',
+                    typeArguments: <TypeDeclaration>[
+                      TypeDeclaration(baseName: 'String', isNullable: true),
+                      TypeDeclaration(baseName: 'Object', isNullable: true),
+                    ],
+                    isNullable: false,
+                  ),
+                ),
+                Parameter(
+                  name: 'anObject',
+                  type: TypeDeclaration(
+                    baseName: 'ParameterObject',
+                    isNullable: false,
+                    associatedClass: emptyClass,
+                  ),
+                ),
               ],
               returnType: const TypeDeclaration.voidDeclaration(),
             ),
           ],
         ),
       ],
-      classes: <Class>[],
+      classes: <Class>[
+        Class(
+          name: 'ParameterObject',
+          fields: <NamedType>[
+            NamedType(
+              type: const TypeDeclaration(baseName: 'bool', isNullable: false),
+              name: 'aValue',
+            ),
+          ],
+        ),
+      ],
       enums: <Enum>[],
     );
-
     final sink = StringBuffer();
     const generator = CppGenerator();
     final generatorOptions = OutputFileOptions<InternalCppOptions>(
@@ -1730,79 +2636,97 @@ void main() {
     );
     generator.generate(generatorOptions, root, sink, dartPackageName: DEFAULT_PACKAGE_NAME);
     final code = sink.toString();
-    // A bare 'auto' here would create a copy, not a reference, which is
-    // inefficient.
-    expect(code, contains('const auto& args = std::get<EncodableList>(message);'));
-    expect(code, contains('const auto& encodable_an_arg_arg = args.at(0);'));
+    expect(code, isNot(contains('reply(wrap')));
+    expect(code, contains('reply(EncodableValue('));
   });
 
-  test('enum argument', () {
+  test('does not keep unowned references in async handlers', () {
     final root = Root(
       apis: <Api>[
         AstHostApi(
-          name: 'Bar',
+          name: 'HostApi',
           methods: <Method>[
             Method(
-              name: 'bar',
+              name: 'noop',
               location: ApiLocation.host,
+              parameters: <Parameter>[],
               returnType: const TypeDeclaration.voidDeclaration(),
+              isAsynchronous: true,
+            ),
+            Method(
+              name: 'doSomething',
+              location: ApiLocation.host,
               parameters: <Parameter>[
                 Parameter(
-                  name: 'foo',
-                  type: TypeDeclaration(
-                    baseName: 'Foo',
-                    isNullable: false,
-                    associatedEnum: emptyEnum,
-                  ),
+                  type: const TypeDeclaration(baseName: 'int', isNullable: false),
+                  name: '',
                 ),
               ],
+              returnType: const TypeDeclaration(baseName: 'double', isNullable: false),
+              isAsynchronous: true,
             ),
           ],
         ),
-      ],
-      classes: <Class>[],
-      enums: <Enum>[
-        Enum(
-          name: 'Foo',
-          members: <EnumMember>[
-            EnumMember(name: 'one'),
-            EnumMember(name: 'two'),
+        AstFlutterApi(
+          name: 'FlutterApi',
+          methods: <Method>[
+            Method(
+              name: 'noop',
+              location: ApiLocation.flutter,
+              parameters: <Parameter>[],
+              returnType: const TypeDeclaration.voidDeclaration(),
+              isAsynchronous: true,
+            ),
+            Method(
+              name: 'doSomething',
+              location: ApiLocation.flutter,
+              parameters: <Parameter>[
+                Parameter(
+                  type: const TypeDeclaration(baseName: 'String', isNullable: false),
+                  name: '',
+                ),
+              ],
+              returnType: const TypeDeclaration(baseName: 'bool', isNullable: false),
+              isAsynchronous: true,
+            ),
           ],
         ),
       ],
+      classes: <Class>[],
+      enums: <Enum>[],
     );
-    final List<Error> errors = validateCpp(
-      const InternalCppOptions(cppHeaderOut: '', cppSourceOut: '', headerIncludePath: ''),
-      root,
+    final sink = StringBuffer();
+    const generator = CppGenerator();
+    final generatorOptions = OutputFileOptions<InternalCppOptions>(
+      fileType: FileType.source,
+      languageOptions: const InternalCppOptions(
+        cppHeaderOut: '',
+        cppSourceOut: '',
+        headerIncludePath: '',
+      ),
     );
-    expect(errors.length, 1);
+    generator.generate(generatorOptions, root, sink, dartPackageName: DEFAULT_PACKAGE_NAME);
+    final code = sink.toString();
+    // Nothing should be captured by reference for async handlers, since their
+    // lifetime is unknown (and expected to be longer than the stack's).
+    expect(code, isNot(contains('&reply')));
+    expect(code, isNot(contains('&wrapped')));
+    // Check for the exact capture format that is currently being used, to
+    // ensure that the negative tests above get updated if there are any
+    // changes to lambda capture.
+    expect(code, contains('[reply]('));
   });
 
-  test('transfers documentation comments', () {
-    final comments = <String>[
-      ' api comment',
-      ' api method comment',
-      ' class comment',
-      ' class field comment',
-      ' enum comment',
-      ' enum member comment',
-    ];
-    var count = 0;
-
-    final unspacedComments = <String>['////////'];
-    var unspacedCount = 0;
-
+  test('connection error contains channel name', () {
     final root = Root(
       apis: <Api>[
         AstFlutterApi(
           name: 'Api',
-          documentationComments: <String>[comments[count++]],
           methods: <Method>[
             Method(
               name: 'method',
               location: ApiLocation.flutter,
               returnType: const TypeDeclaration.voidDeclaration(),
-              documentationComments: <String>[comments[count++]],
               parameters: <Parameter>[
                 Parameter(
                   name: 'field',
@@ -1813,231 +2737,290 @@ void main() {
           ],
         ),
       ],
-      classes: <Class>[
-        Class(
-          name: 'class',
-          documentationComments: <String>[comments[count++]],
-          fields: <NamedType>[
-            NamedType(
-              documentationComments: <String>[comments[count++]],
-              type: const TypeDeclaration(
-                baseName: 'Map',
-                isNullable: true,
-                typeArguments: <TypeDeclaration>[
-                  TypeDeclaration(baseName: 'String', isNullable: true),
-                  TypeDeclaration(baseName: 'int', isNullable: true),
-                ],
-              ),
-              name: 'field1',
-            ),
-          ],
-        ),
-      ],
-      enums: <Enum>[
-        Enum(
-          name: 'enum',
-          documentationComments: <String>[comments[count++], unspacedComments[unspacedCount++]],
-          members: <EnumMember>[
-            EnumMember(name: 'one', documentationComments: <String>[comments[count++]]),
-            EnumMember(name: 'two'),
-          ],
-        ),
-      ],
+      classes: <Class>[],
+      enums: <Enum>[],
+      containsFlutterApi: true,
     );
     final sink = StringBuffer();
     const generator = CppGenerator();
     final generatorOptions = OutputFileOptions<InternalCppOptions>(
-      fileType: FileType.header,
+      fileType: FileType.source,
       languageOptions: const InternalCppOptions(
-        headerIncludePath: 'foo',
         cppHeaderOut: '',
         cppSourceOut: '',
+        headerIncludePath: '',
       ),
     );
     generator.generate(generatorOptions, root, sink, dartPackageName: DEFAULT_PACKAGE_NAME);
     final code = sink.toString();
-    for (final comment in comments) {
-      expect(code, contains('//$comment'));
-    }
-    expect(code, contains('// ///'));
+    expect(
+      code,
+      contains('"Unable to establish connection on channel: \'" + channel_name + "\'."'),
+    );
+    expect(code, contains('on_error(CreateConnectionError(channel->name()));'));
   });
 
-  test('creates custom codecs', () {
+  test('flutter api methods reuse a channel per method', () {
     final root = Root(
       apis: <Api>[
         AstFlutterApi(
           name: 'Api',
           methods: <Method>[
             Method(
-              name: 'doSomething',
+              name: 'method',
               location: ApiLocation.flutter,
+              returnType: const TypeDeclaration.voidDeclaration(),
               parameters: <Parameter>[
                 Parameter(
-                  type: TypeDeclaration(
-                    baseName: 'Input',
-                    isNullable: false,
-                    associatedClass: emptyClass,
-                  ),
-                  name: '',
+                  name: 'field',
+                  type: const TypeDeclaration(baseName: 'int', isNullable: true),
                 ),
               ],
-              returnType: TypeDeclaration(
-                baseName: 'Output',
-                isNullable: false,
-                associatedClass: emptyClass,
-              ),
-              isAsynchronous: true,
             ),
           ],
         ),
-      ],
-      classes: <Class>[
-        Class(
-          name: 'Input',
-          fields: <NamedType>[
-            NamedType(
-              type: const TypeDeclaration(baseName: 'String', isNullable: true),
-              name: 'input',
+      ],
+      classes: <Class>[],
+      enums: <Enum>[],
+    );
+    {
+      final sink = StringBuffer();
+      const generator = CppGenerator();
+      final generatorOptions = OutputFileOptions<InternalCppOptions>(
+        fileType: FileType.header,
+        languageOptions: const InternalCppOptions(
+          cppHeaderOut: '',
+          cppSourceOut: '',
+          headerIncludePath: '',
+        ),
+      );
+      generator.generate(generatorOptions, root, sink, dartPackageName: DEFAULT_PACKAGE_NAME);
+      final code = sink.toString();
+      expect(code, contains('class PigeonInternalFlutterMethodChannel {'));
+      expect(
+        code,
+        contains('std::shared_ptr<PigeonInternalFlutterMethodChannel> method_channel_;'),
+      );
+    }
+    {
+      final sink = StringBuffer();
+      const generator = CppGenerator();
+      final generatorOptions = OutputFileOptions<InternalCppOptions>(
+        fileType: FileType.source,
+        languageOptions: const InternalCppOptions(
+          cppHeaderOut: '',
+          cppSourceOut: '',
+          headerIncludePath: '',
+        ),
+      );
+      generator.generate(generatorOptions, root, sink, dartPackageName: DEFAULT_PACKAGE_NAME);
+      final code = sink.toString();
+      expect(code, contains('if (!method_channel_) {'));
+      expect(
+        code,
+        contains(
+          'method_channel_ = std::make_shared<PigeonInternalFlutterMethodChannel>(binary_messenger_, '
+          '"dev.flutter.pigeon.test_package.Api.method" + message_channel_suffix_, &GetCodec());',
+        ),
+      );
+      expect(
+        code,
+        contains(
+          'method_channel_->channel().Send(encoded_api_arguments, [channel = method_channel_, ',
+        ),
+      );
+      expect(code, isNot(contains('BasicMessageChannel<> channel(')));
+    }
+  });
+
+  test('runs task queue methods on a PigeonTaskQueue', () {
+    final root = Root(
+      apis: <Api>[
+        AstHostApi(
+          name: 'Api',
+          methods: <Method>[
+            Method(
+              name: 'background',
+              location: ApiLocation.host,
+              returnType: const TypeDeclaration.voidDeclaration(),
+              parameters: <Parameter>[],
+              taskQueueType: TaskQueueType.serialBackgroundThread,
             ),
-          ],
-        ),
-        Class(
-          name: 'Output',
-          fields: <NamedType>[
-            NamedType(
-              type: const TypeDeclaration(baseName: 'String', isNullable: true),
-              name: 'output',
+            Method(
+              name: 'main',
+              location: ApiLocation.host,
+              returnType: const TypeDeclaration.voidDeclaration(),
+              parameters: <Parameter>[],
             ),
           ],
         ),
       ],
+      classes: <Class>[],
       enums: <Enum>[],
     );
-    final sink = StringBuffer();
-    const generator = CppGenerator();
-    final generatorOptions = OutputFileOptions<InternalCppOptions>(
-      fileType: FileType.header,
-      languageOptions: const InternalCppOptions(
-        cppHeaderOut: '',
-        cppSourceOut: '',
-        headerIncludePath: '',
-      ),
-    );
-    generator.generate(generatorOptions, root, sink, dartPackageName: DEFAULT_PACKAGE_NAME);
-    final code = sink.toString();
-    expect(code, contains(' : public ::flutter::StandardCodecSerializer'));
+    String generate(FileType fileType) {
+      final sink = StringBuffer();
+      const generator = CppGenerator();
+      final generatorOptions = OutputFileOptions<InternalCppOptions>(
+        fileType: fileType,
+        languageOptions: const InternalCppOptions(
+          cppHeaderOut: '',
+          cppSourceOut: '',
+          headerIncludePath: '',
+        ),
+      );
+      generator.generate(generatorOptions, root, sink, dartPackageName: DEFAULT_PACKAGE_NAME);
+      return sink.toString();
+    }
+
+    {
+      final String code = generate(FileType.header);
+      expect(code, contains('class PigeonTaskQueue {'));
+      expect(code, contains('virtual void Post(std::function<void()> task) = 0;'));
+      // Replies must be sent on the platform thread, so there is no default.
+      expect(code, contains('virtual void PostReply(std::function<void()> send_reply) = 0;'));
+      expect(code, contains('std::shared_ptr<PigeonTaskQueue> task_queue);'));
+      expect(code, contains('#include <thread>'));
+      expect(code, contains('class PigeonSerialTaskQueue : public PigeonTaskQueue {'));
+      expect(code, contains('post_to_platform_thread_(std::move(send_reply));'));
+    }
+    {
+      final String code = generate(FileType.source);
+      // Without a queue, the methods are handled on the platform thread.
+      expect(code, contains('Api::SetUp(binary_messenger, api, message_channel_suffix, nullptr);'));
+      expect(code, isNot(contains('std::make_shared<PigeonSerialTaskQueue>')));
+      expect(code, contains('channel.SetMessageHandler(std::move(handler));'));
+      expect(
+        code,
+        contains(
+          'PigeonInternalSetTaskQueueMessageHandler(binary_messenger, channel_name, &GetCodec(), task_queue, [api]',
+        ),
+      );
+      expect(code, contains('binary_messenger->SetMessageHandler(channel_name, nullptr);'));
+      // Methods without a task queue are still handled on the platform thread.
+      expect(code, contains('channel.SetMessageHandler([api]'));
+    }
   });
 
-  test('Does not send unwrapped EncodableLists', () {
+  test('registers host methods from a table with tableDrivenDispatch', () {
     final root = Root(
       apis: <Api>[
         AstHostApi(
           name: 'Api',
           methods: <Method>[
             Method(
-              name: 'doSomething',
+              name: 'add',
               location: ApiLocation.host,
+              returnType: const TypeDeclaration(baseName: 'int', isNullable: false),
               parameters: <Parameter>[
                 Parameter(
-                  name: 'aBool',
-                  type: const TypeDeclaration(baseName: 'bool', isNullable: false),
-                ),
-                Parameter(
-                  name: 'anInt',
+                  name: 'x',
                   type: const TypeDeclaration(baseName: 'int', isNullable: false),
                 ),
-                Parameter(
-                  name: 'aString',
-                  type: const TypeDeclaration(baseName: 'String', isNullable: false),
-                ),
-                Parameter(
-                  name: 'aList',
-                  type: const TypeDeclaration(
-                    baseName: 'List',
-                    typeArguments: <TypeDeclaration>[
-                      TypeDeclaration(baseName: 'Object', isNullable: true),
-                    ],
-                    isNullable: false,
-                  ),
-                ),
-                Parameter(
-                  name: 'aMap',
-                  type: const TypeDeclaration(
-                    baseName: 'Map',
-                    typeArguments: <TypeDeclaration>[
-                      TypeDeclaration(baseName: 'String', isNullable: true),
-                      TypeDeclaration(baseName: 'Object', isNullable: true),
-                    ],
-                    isNullable: false,
-                  ),
-                ),
-                Parameter(
-                  name: 'anObject',
-                  type: TypeDeclaration(
-                    baseName: 'ParameterObject',
-                    isNullable: false,
-                    associatedClass: emptyClass,
-                  ),
-                ),
               ],
+            ),
+            Method(
+              name: 'background',
+              location: ApiLocation.host,
               returnType: const TypeDeclaration.voidDeclaration(),
+              parameters: <Parameter>[],
+              taskQueueType: TaskQueueType.serialBackgroundThread,
             ),
           ],
         ),
-      ],
-      classes: <Class>[
-        Class(
-          name: 'ParameterObject',
-          fields: <NamedType>[
-            NamedType(
-              type: const TypeDeclaration(baseName: 'bool', isNullable: false),
-              name: 'aValue',
+        AstHostApi(
+          name: 'OtherApi',
+          methods: <Method>[
+            Method(
+              name: 'noop',
+              location: ApiLocation.host,
+              returnType: const TypeDeclaration.voidDeclaration(),
+              parameters: <Parameter>[],
             ),
           ],
         ),
       ],
+      classes: <Class>[],
       enums: <Enum>[],
     );
-    final sink = StringBuffer();
-    const generator = CppGenerator();
-    final generatorOptions = OutputFileOptions<InternalCppOptions>(
-      fileType: FileType.source,
-      languageOptions: const InternalCppOptions(
-        cppHeaderOut: '',
-        cppSourceOut: '',
-        headerIncludePath: '',
-      ),
-    );
-    generator.generate(generatorOptions, root, sink, dartPackageName: DEFAULT_PACKAGE_NAME);
-    final code = sink.toString();
-    expect(code, isNot(contains('reply(wrap')));
-    expect(code, contains('reply(EncodableValue('));
+    String generate(FileType fileType) {
+      final sink = StringBuffer();
+      const generator = CppGenerator();
+      final generatorOptions = OutputFileOptions<InternalCppOptions>(
+        fileType: fileType,
+        languageOptions: const InternalCppOptions(
+          cppHeaderOut: '',
+          cppSourceOut: '',
+          headerIncludePath: '',
+          tableDrivenDispatch: true,
+        ),
+      );
+      generator.generate(generatorOptions, root, sink, dartPackageName: DEFAULT_PACKAGE_NAME);
+      return sink.toString();
+    }
+
+    {
+      final String code = generate(FileType.header);
+      expect(code, contains('static void PigeonInternalHandleAdd('));
+      expect(code, contains('static void PigeonInternalHandleBackground('));
+      expect(code, contains('static void PigeonInternalHandleNoop('));
+    }
+    {
+      final String code = generate(FileType.source);
+      expect(code, contains('struct PigeonInternalHostMethod {'));
+      expect(code, contains('void PigeonInternalSetUpHostMethods('));
+      expect(code, contains('static constexpr PigeonInternalHostMethod<Api> kMethods[] = {'));
+      expect(code, contains('{"add", &Api::PigeonInternalHandleAdd, false},'));
+      expect(code, contains('{"background", &Api::PigeonInternalHandleBackground, true},'));
+      expect(
+        code,
+        contains(
+          'PigeonInternalSetUpHostMethods(binary_messenger, api, "dev.flutter.pigeon.test_package.Api.", message_channel_suffix, kMethods, task_queue);',
+        ),
+      );
+      // APIs without task queue methods don't have a task queue to pass.
+      expect(
+        code,
+        contains(
+          'PigeonInternalSetUpHostMethods(binary_messenger, api, "dev.flutter.pigeon.test_package.OtherApi.", message_channel_suffix, kMethods, nullptr);',
+        ),
+      );
+      expect(code, contains('void Api::PigeonInternalHandleAdd('));
+      expect(code, contains('ErrorOr<int64_t> output = api->Add(x_arg);'));
+      // The handlers share one channel setup and exception handler.
+      expect(code, isNot(contains('channel.SetMessageHandler([api]')));
+      expect('catch (const std::exception& exception)'.allMatches(code).length, 1);
+    }
   });
 
-  test('does not keep unowned references in async handlers', () {
+  test('awaitable flutter methods and coroutine host methods with coroutines', () {
     final root = Root(
       apis: <Api>[
         AstHostApi(
           name: 'HostApi',
           methods: <Method>[
             Method(
-              name: 'noop',
+              name: 'echo',
               location: ApiLocation.host,
-              parameters: <Parameter>[],
-              returnType: const TypeDeclaration.voidDeclaration(),
+              returnType: const TypeDeclaration(baseName: 'String', isNullable: false),
+              parameters: <Parameter>[
+                Parameter(
+                  name: 'value',
+                  type: const TypeDeclaration(baseName: 'String', isNullable: false),
+                ),
+              ],
               isAsynchronous: true,
             ),
             Method(
-              name: 'doSomething',
+              name: 'add',
               location: ApiLocation.host,
+              returnType: const TypeDeclaration(baseName: 'int', isNullable: false),
               parameters: <Parameter>[
                 Parameter(
+                  name: 'x',
                   type: const TypeDeclaration(baseName: 'int', isNullable: false),
-                  name: '',
                 ),
               ],
-              returnType: const TypeDeclaration(baseName: 'double', isNullable: false),
-              isAsynchronous: true,
             ),
           ],
         ),
@@ -2045,23 +3028,15 @@ void main() {
           name: 'FlutterApi',
           methods: <Method>[
             Method(
-              name: 'noop',
-              location: ApiLocation.flutter,
-              parameters: <Parameter>[],
-              returnType: const TypeDeclaration.voidDeclaration(),
-              isAsynchronous: true,
-            ),
-            Method(
-              name: 'doSomething',
+              name: 'echo',
               location: ApiLocation.flutter,
+              returnType: const TypeDeclaration(baseName: 'String', isNullable: true),
               parameters: <Parameter>[
                 Parameter(
+                  name: 'value',
                   type: const TypeDeclaration(baseName: 'String', isNullable: false),
-                  name: '',
                 ),
               ],
-              returnType: const TypeDeclaration(baseName: 'bool', isNullable: false),
-              isAsynchronous: true,
             ),
           ],
         ),
@@ -2069,56 +3044,90 @@ void main() {
       classes: <Class>[],
       enums: <Enum>[],
     );
-    final sink = StringBuffer();
-    const generator = CppGenerator();
-    final generatorOptions = OutputFileOptions<InternalCppOptions>(
-      fileType: FileType.source,
-      languageOptions: const InternalCppOptions(
-        cppHeaderOut: '',
-        cppSourceOut: '',
-        headerIncludePath: '',
-      ),
-    );
-    generator.generate(generatorOptions, root, sink, dartPackageName: DEFAULT_PACKAGE_NAME);
-    final code = sink.toString();
-    // Nothing should be captured by reference for async handlers, since their
-    // lifetime is unknown (and expected to be longer than the stack's).
-    expect(code, isNot(contains('&reply')));
-    expect(code, isNot(contains('&wrapped')));
-    // Check for the exact capture format that is currently being used, to
-    // ensure that the negative tests above get updated if there are any
-    // changes to lambda capture.
-    expect(code, contains('[reply]('));
+    String generate(FileType fileType) {
+      final sink = StringBuffer();
+      const generator = CppGenerator();
+      final generatorOptions = OutputFileOptions<InternalCppOptions>(
+        fileType: fileType,
+        languageOptions: const InternalCppOptions(
+          cppHeaderOut: '',
+          cppSourceOut: '',
+          headerIncludePath: '',
+          coroutines: true,
+        ),
+      );
+      generator.generate(generatorOptions, root, sink, dartPackageName: DEFAULT_PACKAGE_NAME);
+      return sink.toString();
+    }
+
+    {
+      final String code = generate(FileType.header);
+      expect(code, contains('#include <coroutine>'));
+      expect(code, contains('class PigeonTask {'));
+      expect(code, contains('class PigeonFlutterApiCall {'));
+      expect(
+        code,
+        contains('virtual PigeonTask<ErrorOr<std::string>> Echo(const std::string& value) = 0;'),
+      );
+      // Synchronous methods are unchanged.
+      expect(code, contains('virtual ErrorOr<int64_t> Add(int64_t x) = 0;'));
+      // The callback overload is kept alongside the awaitable one.
+      expect(code, contains('std::function<void(const std::string*)>&& on_success'));
+      expect(
+        code,
+        contains(
+          'PigeonFlutterApiCall<ErrorOr<std::optional<std::string>>> Echo(const std::string& value);',
+        ),
+      );
+    }
+    {
+      final String code = generate(FileType.source);
+      expect(code, contains('PigeonInternalDetachedTask PigeonInternalReplyWhenDone('));
+      expect(
+        code,
+        contains(
+          'PigeonInternalReplyWhenDone(api->Echo(value_arg), [reply](ErrorOr<std::string>&& output) {',
+        ),
+      );
+      expect(code, contains('ErrorOr<int64_t> output = api->Add(x_arg);'));
+      expect(
+        code,
+        contains(
+          'PigeonFlutterApiCall<ErrorOr<std::optional<std::string>>> FlutterApi::Echo(const std::string& value_arg) {',
+        ),
+      );
+      expect(
+        code,
+        contains(
+          'return return_value ? std::optional<std::string>(*return_value) : std::nullopt;',
+        ),
+      );
+    }
   });
 
-  test('connection error contains channel name', () {
+  test('coroutines are off by default', () {
     final root = Root(
       apis: <Api>[
-        AstFlutterApi(
-          name: 'Api',
+        AstHostApi(
+          name: 'HostApi',
           methods: <Method>[
             Method(
-              name: 'method',
-              location: ApiLocation.flutter,
+              name: 'noop',
+              location: ApiLocation.host,
               returnType: const TypeDeclaration.voidDeclaration(),
-              parameters: <Parameter>[
-                Parameter(
-                  name: 'field',
-                  type: const TypeDeclaration(baseName: 'int', isNullable: true),
-                ),
-              ],
+              parameters: <Parameter>[],
+              isAsynchronous: true,
             ),
           ],
         ),
       ],
       classes: <Class>[],
       enums: <Enum>[],
-      containsFlutterApi: true,
     );
     final sink = StringBuffer();
     const generator = CppGenerator();
     final generatorOptions = OutputFileOptions<InternalCppOptions>(
-      fileType: FileType.source,
+      fileType: FileType.header,
       languageOptions: const InternalCppOptions(
         cppHeaderOut: '',
         cppSourceOut: '',
@@ -2127,53 +3136,194 @@ void main() {
     );
     generator.generate(generatorOptions, root, sink, dartPackageName: DEFAULT_PACKAGE_NAME);
     final code = sink.toString();
-    expect(
-      code,
-      contains('"Unable to establish connection on channel: \'" + channel_name + "\'."'),
+    expect(code, isNot(contains('#include <coroutine>')));
+    expect(code, isNot(contains('PigeonTask')));
+  });
+
+  test('event channel api', () {
+    final root = Root(
+      apis: <Api>[
+        AstEventChannelApi(
+          name: 'Api',
+          methods: <Method>[
+            Method(
+              name: 'streamInts',
+              location: ApiLocation.host,
+              returnType: const TypeDeclaration(baseName: 'int', isNullable: false),
+              parameters: <Parameter>[],
+            ),
+          ],
+          cppOptions: const CppEventChannelOptions(
+            maxBatchSize: 16,
+            maxQueuedEvents: 64,
+            overflowPolicy: CppEventOverflowPolicy.block,
+          ),
+        ),
+      ],
+      classes: <Class>[],
+      enums: <Enum>[],
+      containsEventChannel: true,
     );
-    expect(code, contains('on_error(CreateConnectionError(channel_name));'));
+    String generate(FileType fileType) {
+      final sink = StringBuffer();
+      const generator = CppGenerator();
+      final generatorOptions = OutputFileOptions<InternalCppOptions>(
+        fileType: fileType,
+        languageOptions: const InternalCppOptions(
+          cppHeaderOut: '',
+          cppSourceOut: '',
+          headerIncludePath: '',
+        ),
+      );
+      generator.generate(generatorOptions, root, sink, dartPackageName: DEFAULT_PACKAGE_NAME);
+      return sink.toString();
+    }
+
+    {
+      final String code = generate(FileType.header);
+      expect(code, contains('#include <flutter/event_stream_handler.h>'));
+      expect(code, contains('class PigeonEventSink {'));
+      expect(code, contains('void Success(const T& event)'));
+      expect(code, contains('class StreamIntsStreamHandler : public PigeonEventStreamHandler<int64_t> {'));
+      expect(code, contains('static void Register('));
+    }
+    {
+      final String code = generate(FileType.source);
+      expect(code, contains('#include <flutter/event_channel.h>'));
+      expect(code, contains('void StreamIntsStreamHandler::Register('));
+      expect(code, contains('channel_name += "." + instance_name;'));
+      expect(code, contains('options.max_batch_size = 16;'));
+      expect(code, contains('options.max_queued_events = 64;'));
+      expect(code, contains('options.overflow_policy = PigeonEventOverflowPolicy::kBlock;'));
+      expect(code, contains('PigeonInternalEventStreamHandler<int64_t>'));
+      expect(code, contains('return EncodableValue(event);'));
+    }
   });
 
-  test('stack allocates the message channel.', () {
+  test('proxy apis use an instance manager', () {
     final root = Root(
       apis: <Api>[
-        AstFlutterApi(
+        AstProxyApi(
           name: 'Api',
+          constructors: <Constructor>[Constructor(name: '', parameters: <Parameter>[])],
+          fields: <ApiField>[
+            ApiField(
+              name: 'someField',
+              type: const TypeDeclaration(baseName: 'int', isNullable: false),
+            ),
+          ],
           methods: <Method>[
             Method(
-              name: 'method',
+              name: 'doSomething',
+              location: ApiLocation.host,
+              parameters: <Parameter>[
+                Parameter(
+                  type: const TypeDeclaration(baseName: 'int', isNullable: false),
+                  name: 'input',
+                ),
+              ],
+              returnType: const TypeDeclaration(baseName: 'String', isNullable: false),
+            ),
+            Method(
+              name: 'onEvent',
               location: ApiLocation.flutter,
-              returnType: const TypeDeclaration.voidDeclaration(),
+              isRequired: false,
               parameters: <Parameter>[
                 Parameter(
-                  name: 'field',
-                  type: const TypeDeclaration(baseName: 'int', isNullable: true),
+                  type: const TypeDeclaration(baseName: 'int', isNullable: false),
+                  name: 'value',
                 ),
               ],
+              returnType: const TypeDeclaration.voidDeclaration(),
             ),
           ],
         ),
       ],
       classes: <Class>[],
       enums: <Enum>[],
+      containsProxyApi: true,
     );
-    final sink = StringBuffer();
-    const generator = CppGenerator();
-    final generatorOptions = OutputFileOptions<InternalCppOptions>(
-      fileType: FileType.source,
-      languageOptions: const InternalCppOptions(
-        cppHeaderOut: '',
-        cppSourceOut: '',
-        headerIncludePath: '',
-      ),
-    );
-    generator.generate(generatorOptions, root, sink, dartPackageName: DEFAULT_PACKAGE_NAME);
-    final code = sink.toString();
-    expect(
-      code,
-      contains('BasicMessageChannel<> channel(binary_messenger_, channel_name, &GetCodec());'),
-    );
-    expect(code, contains('channel.Send'));
+    String generate(FileType fileType) {
+      final sink = StringBuffer();
+      const generator = CppGenerator();
+      final generatorOptions = OutputFileOptions<InternalCppOptions>(
+        fileType: fileType,
+        languageOptions: const InternalCppOptions(
+          cppHeaderOut: '',
+          cppSourceOut: '',
+          headerIncludePath: '',
+        ),
+      );
+      generator.generate(generatorOptions, root, sink, dartPackageName: DEFAULT_PACKAGE_NAME);
+      return sink.toString();
+    }
+
+    {
+      final String code = generate(FileType.header);
+      expect(code, contains('#include <mutex>'));
+      expect(code, contains('class PigeonInstanceManager {'));
+      expect(code, contains('int64_t AddHostCreatedInstance(std::shared_ptr<void> instance);'));
+      expect(code, contains('size_t ReleaseDestroyedInstances();'));
+      expect(
+        code,
+        contains(
+          'class PigeonInternalProxyApiCodecSerializer : public PigeonInternalCodecSerializer {',
+        ),
+      );
+      expect(code, contains('friend class Api;'));
+      expect(
+        code,
+        contains(
+          'virtual ErrorOr<std::shared_ptr<void>> PigeonDefaultConstructor(int64_t some_field) = 0;',
+        ),
+      );
+      expect(code, contains('virtual ErrorOr<std::string> DoSomething('));
+      expect(code, contains('const std::shared_ptr<void>& pigeon_instance,'));
+      expect(code, contains('void PigeonNewInstance('));
+      expect(code, contains('void OnEvent('));
+      expect(code, contains('std::shared_ptr<PigeonInstanceManager> instance_manager_;'));
+    }
+    {
+      final String code = generate(FileType.source);
+      expect(code, contains('size_t PigeonInstanceManager::ReleaseDestroyedInstances() {'));
+      expect(
+        code,
+        contains(
+          'BasicMessageChannel<> channel(binary_messenger_, "dev.flutter.pigeon.$DEFAULT_PACKAGE_NAME.PigeonInternalInstanceManager.removeStrongReferences", &::flutter::StandardMessageCodec::GetInstance());',
+        ),
+      );
+      expect(
+        code,
+        contains(
+          '"dev.flutter.pigeon.$DEFAULT_PACKAGE_NAME.PigeonInternalInstanceManager.removeStrongReference"',
+        ),
+      );
+      expect(code, contains('if (type == 128) {'));
+      expect(
+        code,
+        contains('"dev.flutter.pigeon.$DEFAULT_PACKAGE_NAME.Api.pigeon_defaultConstructor"'),
+      );
+      expect(
+        code,
+        contains(
+          'reply(PigeonInternalNewInstanceReply(api->instance_manager_.get(), output, pigeon_identifier_arg));',
+        ),
+      );
+      expect(
+        code,
+        contains(
+          'const auto& pigeon_instance_arg = std::any_cast<const std::shared_ptr<void>&>(std::get<CustomEncodableValue>(encodable_pigeon_instance_arg));',
+        ),
+      );
+      expect(
+        code,
+        contains(
+          'const int64_t pigeon_identifier = instance_manager_->AddHostCreatedInstance(pigeon_instance);',
+        ),
+      );
+      expect(code, contains('if (!instance_manager_->ContainsInstance(pigeon_instance.get())) {'));
+      expect(code, contains('CustomEncodableValue(pigeon_instance),'));
+    }
   });
 
   test('data class equality', () {
@@ -2388,4 +3538,164 @@ void main() {
       expect(code, contains('size_t Input::Hash() const {'));
     }
   });
+
+  test('columnar lists are passed as a columns class', () {
+    final pointClass = Class(
+      name: 'Point',
+      isColumnar: true,
+      fields: <NamedType>[
+        NamedType(type: const TypeDeclaration(baseName: 'int', isNullable: false), name: 'x'),
+        NamedType(type: const TypeDeclaration(baseName: 'bool', isNullable: false), name: 'flag'),
+        NamedType(
+          type: const TypeDeclaration(baseName: 'String', isNullable: false),
+          name: 'label',
+        ),
+      ],
+    );
+    final pointsType = TypeDeclaration(
+      baseName: 'List',
+      isNullable: false,
+      isColumnar: true,
+      typeArguments: <TypeDeclaration>[
+        TypeDeclaration(baseName: 'Point', isNullable: false, associatedClass: pointClass),
+      ],
+    );
+    final root = Root(
+      apis: <Api>[
+        AstHostApi(
+          name: 'Api',
+          methods: <Method>[
+            Method(
+              name: 'echo',
+              location: ApiLocation.host,
+              parameters: <Parameter>[Parameter(type: pointsType, name: 'points')],
+              returnType: pointsType,
+            ),
+          ],
+        ),
+      ],
+      classes: <Class>[pointClass],
+      enums: <Enum>[],
+    );
+    {
+      final sink = StringBuffer();
+      const generator = CppGenerator();
+      final generatorOptions = OutputFileOptions<InternalCppOptions>(
+        fileType: FileType.header,
+        languageOptions: const InternalCppOptions(
+          cppHeaderOut: '',
+          cppSourceOut: '',
+          headerIncludePath: '',
+        ),
+      );
+      generator.generate(generatorOptions, root, sink, dartPackageName: DEFAULT_PACKAGE_NAME);
+      final code = sink.toString();
+      expect(code, contains('class PointColumns {'));
+      expect(code, contains('const std::vector<int64_t>& x() const;'));
+      expect(code, contains('const std::vector<uint8_t>& flag() const;'));
+      expect(code, contains('const ::flutter::EncodableList& label() const;'));
+      expect(code, contains('size_t size() const;'));
+      expect(code, contains('virtual ErrorOr<PointColumns> Echo(const PointColumns& points) = 0;'));
+    }
+    {
+      final sink = StringBuffer();
+      const generator = CppGenerator();
+      final generatorOptions = OutputFileOptions<InternalCppOptions>(
+        fileType: FileType.source,
+        languageOptions: const InternalCppOptions(
+          cppHeaderOut: '',
+          cppSourceOut: '',
+          headerIncludePath: '',
+        ),
+      );
+      generator.generate(generatorOptions, root, sink, dartPackageName: DEFAULT_PACKAGE_NAME);
+      final code = sink.toString();
+      expect(code, contains('return std::get<std::vector<uint8_t>>(columns_[1]);'));
+      expect(code, contains('columns_.emplace_back(std::move(label));'));
+      // The columns are moved out of the decoded message rather than copied.
+      expect(
+        code,
+        contains(
+          'PointColumns::FromEncodableList(std::move(std::get<EncodableList>(const_cast<EncodableValue&>(',
+        ),
+      );
+      expect(code, contains('columns.columns_ = std::move(list);'));
+      // Columns that don't match the class are reported.
+      expect(code, contains('if (list.size() != 3) {'));
+      expect(
+        code,
+        contains('const auto* flag_column = std::get_if<std::vector<uint8_t>>(&list[1]);'),
+      );
+      expect(code, contains('if (flag_column == nullptr || flag_column->size() != size) {'));
+      expect(
+        code,
+        contains('wrapped.push_back(EncodableValue(std::move(output).TakeValue().columns_));'),
+      );
+    }
+  });
+
+  test('chunked bytes are passed as byte stream readers', () {
+    const bytesType = TypeDeclaration(baseName: 'Uint8List', isNullable: false, isChunked: true);
+    final root = Root(
+      apis: <Api>[
+        AstHostApi(
+          name: 'Api',
+          methods: <Method>[
+            Method(
+              name: 'echo',
+              location: ApiLocation.host,
+              isAsynchronous: true,
+              chunkSize: 4,
+              parameters: <Parameter>[Parameter(type: bytesType, name: 'data')],
+              returnType: bytesType,
+            ),
+          ],
+        ),
+      ],
+      classes: <Class>[],
+      enums: <Enum>[],
+    );
+    {
+      final sink = StringBuffer();
+      const generator = CppGenerator();
+      final generatorOptions = OutputFileOptions<InternalCppOptions>(
+        fileType: FileType.header,
+        languageOptions: const InternalCppOptions(
+          cppHeaderOut: '',
+          cppSourceOut: '',
+          headerIncludePath: '',
+        ),
+      );
+      generator.generate(generatorOptions, root, sink, dartPackageName: DEFAULT_PACKAGE_NAME);
+      final code = sink.toString();
+      expect(code, contains('class ByteStreamReader {'));
+      expect(code, contains('std::unique_ptr<ByteStreamReader> data,'));
+      expect(code, contains('ErrorOr<std::unique_ptr<ByteStreamReader>> reply'));
+    }
+    {
+      final sink = StringBuffer();
+      const generator = CppGenerator();
+      final generatorOptions = OutputFileOptions<InternalCppOptions>(
+        fileType: FileType.source,
+        languageOptions: const InternalCppOptions(
+          cppHeaderOut: '',
+          cppSourceOut: '',
+          headerIncludePath: '',
+        ),
+      );
+      generator.generate(generatorOptions, root, sink, dartPackageName: DEFAULT_PACKAGE_NAME);
+      final code = sink.toString();
+      expect(code, contains('class PigeonInternalChannelByteStreamReader : public ByteStreamReader {'));
+      expect(code, contains('class PigeonInternalByteStreams'));
+      expect(
+        code,
+        contains(
+          'std::unique_ptr<ByteStreamReader> data_arg = std::make_unique<PigeonInternalChannelByteStreamReader>(binary_messenger, std::get<std::string>(encodable_data_arg));',
+        ),
+      );
+      expect(code, contains('auto streams = std::make_shared<PigeonInternalByteStreams>();'));
+      expect(code, contains('wrapped.push_back(EncodableValue(streams->Add('));
+      expect(code, contains('streams->ReadChunk(message, reply);'));
+    }
+  });
 }
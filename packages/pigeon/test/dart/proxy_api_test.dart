@@ -153,6 +153,18 @@ void main() {
         collapsedCode,
         contains('(instanceManager ?? PigeonInstanceManager.instance) .remove(arg_identifier);'),
       );
+      expect(
+        code,
+        contains(
+          'dev.flutter.pigeon.$DEFAULT_PACKAGE_NAME.PigeonInternalInstanceManager.removeStrongReferences',
+        ),
+      );
+      expect(
+        collapsedCode,
+        contains(
+          '(instanceManager ?? PigeonInstanceManager.instance) .removeAll(arg_identifiers);',
+        ),
+      );
 
       expect(code, contains('Future<void> clear()'));
       expect(
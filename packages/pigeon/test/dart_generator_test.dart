@@ -784,6 +784,150 @@ void main() {
     expect(code, matches('pigeonVar_sendFuture = pigeonVar_channel.send[(]null[)]'));
   });
 
+  test('multiplexed host api sends the method index on one channel', () {
+    final root = Root(
+      apis: <Api>[
+        AstHostApi(
+          name: 'Api',
+          multiplexChannel: true,
+          methods: <Method>[
+            Method(
+              name: 'doSomething',
+              location: ApiLocation.host,
+              parameters: <Parameter>[],
+              returnType: const TypeDeclaration.voidDeclaration(),
+            ),
+            Method(
+              name: 'doSomethingElse',
+              location: ApiLocation.host,
+              parameters: <Parameter>[
+                Parameter(
+                  type: const TypeDeclaration(baseName: 'int', isNullable: false),
+                  name: 'value',
+                ),
+              ],
+              returnType: const TypeDeclaration.voidDeclaration(),
+            ),
+          ],
+        ),
+      ],
+      classes: <Class>[],
+      enums: <Enum>[],
+    );
+    final sink = StringBuffer();
+    const generator = DartGenerator();
+    generator.generate(
+      const InternalDartOptions(ignoreLints: false),
+      root,
+      sink,
+      dartPackageName: DEFAULT_PACKAGE_NAME,
+    );
+    final code = sink.toString();
+    expect(code, contains(r"'dev.flutter.pigeon.test_package.Api$pigeonVar_messageChannelSuffix'"));
+    expect(code, isNot(contains('dev.flutter.pigeon.test_package.Api.doSomething')));
+    expect(code, contains('pigeonVar_channel.send(<Object?>[0])'));
+    expect(code, contains('pigeonVar_channel.send(<Object?>[1, value])'));
+  });
+
+  test('columnar lists are sent as one typed list per field', () {
+    final pointClass = Class(
+      name: 'Point',
+      isColumnar: true,
+      fields: <NamedType>[
+        NamedType(type: const TypeDeclaration(baseName: 'int', isNullable: false), name: 'x'),
+        NamedType(type: const TypeDeclaration(baseName: 'bool', isNullable: false), name: 'flag'),
+        NamedType(
+          type: const TypeDeclaration(baseName: 'String', isNullable: false),
+          name: 'label',
+        ),
+      ],
+    );
+    final pointsType = TypeDeclaration(
+      baseName: 'List',
+      isNullable: false,
+      isColumnar: true,
+      typeArguments: <TypeDeclaration>[
+        TypeDeclaration(baseName: 'Point', isNullable: false, associatedClass: pointClass),
+      ],
+    );
+    final root = Root(
+      apis: <Api>[
+        AstHostApi(
+          name: 'Api',
+          methods: <Method>[
+            Method(
+              name: 'echo',
+              location: ApiLocation.host,
+              parameters: <Parameter>[Parameter(type: pointsType, name: 'points')],
+              returnType: pointsType,
+            ),
+          ],
+        ),
+      ],
+      classes: <Class>[pointClass],
+      enums: <Enum>[],
+    );
+    final sink = StringBuffer();
+    const generator = DartGenerator();
+    generator.generate(
+      const InternalDartOptions(ignoreLints: false),
+      root,
+      sink,
+      dartPackageName: DEFAULT_PACKAGE_NAME,
+    );
+    final code = sink.toString();
+    expect(code, contains('List<Object?> _encodePointColumns(List<Point> rows) {'));
+    expect(code, contains('final Int64List xColumn = Int64List(rows.length);'));
+    expect(code, contains('flagColumn[index] = row.flag ? 1 : 0;'));
+    expect(code, contains("final List<String> labelColumn = List<String>.filled(rows.length, '');"));
+    expect(code, contains('return <Object?>[xColumn, flagColumn, labelColumn];'));
+    expect(code, contains('pigeonVar_channel.send(<Object?>[_encodePointColumns(points)])'));
+    expect(code, contains('List<Point> _decodePointColumns(Object? value) {'));
+    expect(code, contains('final Uint8List flagColumn = columns[1]! as Uint8List;'));
+    expect(code, contains('flag: flagColumn[index] != 0,'));
+    expect(code, contains('label: labelColumn[index]! as String,'));
+    expect(code, contains('return _decodePointColumns(pigeonVar_replyValue);'));
+  });
+
+  test('chunked bytes are streamed over chunk channels', () {
+    const bytesType = TypeDeclaration(baseName: 'Uint8List', isNullable: false, isChunked: true);
+    final root = Root(
+      apis: <Api>[
+        AstHostApi(
+          name: 'Api',
+          methods: <Method>[
+            Method(
+              name: 'echo',
+              location: ApiLocation.host,
+              isAsynchronous: true,
+              chunkSize: 4,
+              parameters: <Parameter>[Parameter(type: bytesType, name: 'data')],
+              returnType: bytesType,
+            ),
+          ],
+        ),
+      ],
+      classes: <Class>[],
+      enums: <Enum>[],
+    );
+    final sink = StringBuffer();
+    const generator = DartGenerator();
+    generator.generate(
+      const InternalDartOptions(ignoreLints: false),
+      root,
+      sink,
+      dartPackageName: DEFAULT_PACKAGE_NAME,
+    );
+    final code = sink.toString();
+    expect(code, contains('BasicMessageChannel<Object?> _serveChunks('));
+    expect(code, contains('Future<Uint8List> _readChunks('));
+    expect(code, contains('final builder = BytesBuilder(copy: false);'));
+    expect(code, contains('final BasicMessageChannel<Object?> pigeonVar_dataChunks = _serveChunks('));
+    expect(code, contains('pigeonVar_channel.send(<Object?>[pigeonVar_dataChunks.name])'));
+    expect(code, contains('return await _readChunks('));
+    expect(code, contains('pigeonVar_dataChunks.setMessageHandler(null);'));
+  });
+
   test('mock Dart handler', () {
     final root = Root(
       apis: <Api>[
@@ -5,6 +5,7 @@
 import 'package:pigeon/src/ast.dart';
 import 'package:pigeon/src/generator_tools.dart';
 import 'package:pigeon/src/gobject/gobject_generator.dart';
+import 'package:pigeon/src/types/task_queue.dart';
 import 'package:test/test.dart';
 
 const String DEFAULT_PACKAGE_NAME = 'test_package';
@@ -452,6 +453,169 @@ void main() {
     }
   });
 
+  test('data classes store nullable primitive fields inline', () {
+    final inputClass = Class(
+      name: 'Input',
+      fields: <NamedType>[
+        NamedType(
+          type: const TypeDeclaration(baseName: 'int', isNullable: true),
+          name: 'nullableInt',
+        ),
+        NamedType(
+          type: const TypeDeclaration(baseName: 'double', isNullable: true),
+          name: 'nullableDouble',
+        ),
+      ],
+    );
+    final root = Root(apis: <Api>[], classes: <Class>[inputClass], enums: <Enum>[]);
+    final sink = StringBuffer();
+    const generator = GObjectGenerator();
+    final generatorOptions = OutputFileOptions<InternalGObjectOptions>(
+      fileType: FileType.source,
+      languageOptions: const InternalGObjectOptions(
+        headerIncludePath: '',
+        gobjectHeaderOut: '',
+        gobjectSourceOut: '',
+      ),
+    );
+    generator.generate(generatorOptions, root, sink, dartPackageName: DEFAULT_PACKAGE_NAME);
+    final code = sink.toString();
+    expect(code, contains('int64_t nullable_int;'));
+    expect(code, contains('guint has_nullable_int : 1;'));
+    expect(code, contains('guint has_nullable_double : 1;'));
+    expect(code, contains('self->nullable_int = *nullable_int;'));
+    expect(code, contains('return self->has_nullable_int ? &self->nullable_int : nullptr;'));
+    expect(code, contains('if (!value->has_nullable_double) {'));
+    expect(code, isNot(contains('malloc(sizeof(int64_t))')));
+    expect(code, isNot(contains('g_clear_pointer(&self->nullable_int, g_free)')));
+  });
+
+  test('data classes cache their hash code', () {
+    final inputClass = Class(
+      name: 'Input',
+      fields: <NamedType>[
+        NamedType(
+          type: const TypeDeclaration(baseName: 'List', isNullable: true),
+          name: 'values',
+        ),
+      ],
+    );
+    final root = Root(apis: <Api>[], classes: <Class>[inputClass], enums: <Enum>[]);
+    final sink = StringBuffer();
+    const generator = GObjectGenerator();
+    final generatorOptions = OutputFileOptions<InternalGObjectOptions>(
+      fileType: FileType.source,
+      languageOptions: const InternalGObjectOptions(
+        headerIncludePath: '',
+        gobjectHeaderOut: '',
+        gobjectSourceOut: '',
+      ),
+    );
+    generator.generate(generatorOptions, root, sink, dartPackageName: DEFAULT_PACKAGE_NAME);
+    final code = sink.toString();
+    expect(code, contains('guint pigeon_hash;'));
+    expect(code, contains('if (g_atomic_int_get(&self->pigeon_hash_set)) {'));
+    expect(code, contains('g_atomic_int_set(&self->pigeon_hash_set, TRUE);'));
+    expect(
+      code,
+      contains(
+        'if (g_atomic_int_get(&a->pigeon_hash_set) && g_atomic_int_get(&b->pigeon_hash_set) && a->pigeon_hash != b->pigeon_hash) {',
+      ),
+    );
+  });
+
+  test('data classes can be created by taking ownership of their values', () {
+    final inputClass = Class(
+      name: 'Input',
+      fields: <NamedType>[
+        NamedType(
+          type: const TypeDeclaration(baseName: 'String', isNullable: false),
+          name: 'name',
+        ),
+        NamedType(
+          type: const TypeDeclaration(baseName: 'Uint8List', isNullable: true),
+          name: 'data',
+        ),
+        NamedType(
+          type: const TypeDeclaration(baseName: 'List', isNullable: true),
+          name: 'values',
+        ),
+      ],
+    );
+    final root = Root(apis: <Api>[], classes: <Class>[inputClass], enums: <Enum>[]);
+    const generator = GObjectGenerator();
+    {
+      final sink = StringBuffer();
+      final generatorOptions = OutputFileOptions<InternalGObjectOptions>(
+        fileType: FileType.header,
+        languageOptions: const InternalGObjectOptions(
+          headerIncludePath: '',
+          gobjectHeaderOut: '',
+          gobjectSourceOut: '',
+        ),
+      );
+      generator.generate(generatorOptions, root, sink, dartPackageName: DEFAULT_PACKAGE_NAME);
+      final code = sink.toString();
+      expect(
+        code,
+        contains(
+          'TestPackageInput* test_package_input_new_take(gchar* name, uint8_t* data, size_t data_length, FlValue* values);',
+        ),
+      );
+    }
+    {
+      final sink = StringBuffer();
+      final generatorOptions = OutputFileOptions<InternalGObjectOptions>(
+        fileType: FileType.source,
+        languageOptions: const InternalGObjectOptions(
+          headerIncludePath: '',
+          gobjectHeaderOut: '',
+          gobjectSourceOut: '',
+        ),
+      );
+      generator.generate(generatorOptions, root, sink, dartPackageName: DEFAULT_PACKAGE_NAME);
+      final code = sink.toString();
+      expect(code, contains('self->name = name;'));
+      expect(code, contains('g_clear_pointer(&self->data, g_free);'));
+      // A nullable value that is taken is stored without checking for null.
+      final String takeBody = code.substring(
+        code.indexOf('TestPackageInput* test_package_input_new_take('),
+        code.indexOf('test_package_input_get_name('),
+      );
+      expect(takeBody, contains('self->values = values;'));
+      expect(takeBody, isNot(contains('if (values != nullptr)')));
+      expect(code, isNot(contains('test_package_input_new_from_list')));
+      // Values after the known fields, from a newer version of the class, are
+      // skipped.
+      expect(
+        code,
+        contains('if (!flpigeon_read_list_header(codec, buffer, offset, 3, &n_values, error)) {'),
+      );
+      expect(code, contains('if (*length < min_length) {'));
+      expect(
+        code,
+        contains('if (!flpigeon_skip_values(codec, buffer, offset, n_values - 3, error)) {'),
+      );
+      expect(
+        code,
+        contains('if (!flpigeon_read_string(codec, buffer, offset, FALSE, &name, error)) {'),
+      );
+      expect(
+        code,
+        contains(
+          'if (!flpigeon_read_typed_list(codec, buffer, offset, 8, sizeof(uint8_t), TRUE, reinterpret_cast<gpointer*>(&data), &data_length, error)) {',
+        ),
+      );
+      expect(code, contains('values = fl_value_ref(value2);'));
+      expect(
+        code,
+        contains(
+          'return test_package_input_new_take(static_cast<gchar*>(g_steal_pointer(&name)), static_cast<uint8_t*>(g_steal_pointer(&data)), data_length, values);',
+        ),
+      );
+    }
+  });
+
   test('host non-nullable return types map correctly', () {
     final returnDataClass = Class(
       name: 'ReturnData',
@@ -696,6 +860,52 @@ void main() {
     }
   });
 
+  test('nullable typed list arguments keep empty lists distinct from null', () {
+    final root = Root(
+      apis: <Api>[
+        AstHostApi(
+          name: 'Api',
+          methods: <Method>[
+            Method(
+              name: 'doSomething',
+              location: ApiLocation.host,
+              parameters: <Parameter>[
+                Parameter(
+                  name: 'bytes',
+                  type: const TypeDeclaration(baseName: 'Uint8List', isNullable: true),
+                ),
+              ],
+              returnType: const TypeDeclaration.voidDeclaration(),
+            ),
+          ],
+        ),
+      ],
+      classes: <Class>[],
+      enums: <Enum>[],
+    );
+    final sink = StringBuffer();
+    const generator = GObjectGenerator();
+    final generatorOptions = OutputFileOptions<InternalGObjectOptions>(
+      fileType: FileType.source,
+      languageOptions: const InternalGObjectOptions(
+        headerIncludePath: '',
+        gobjectHeaderOut: '',
+        gobjectSourceOut: '',
+      ),
+    );
+    generator.generate(generatorOptions, root, sink, dartPackageName: DEFAULT_PACKAGE_NAME);
+    final code = sink.toString();
+    expect(code, contains('flpigeon_get_typed_list_data(gconstpointer data) {'));
+    expect(code, contains('if (fl_value_get_type(value0) != FL_VALUE_TYPE_NULL) {'));
+    expect(
+      code,
+      contains(
+        'bytes = static_cast<const uint8_t*>(flpigeon_get_typed_list_data(fl_value_get_uint8_list(value0)));',
+      ),
+    );
+    expect(code, contains('bytes_length = fl_value_get_length(value0);'));
+  });
+
   test('transfers documentation comments', () {
     final comments = <String>[
       ' api comment',
@@ -936,4 +1146,898 @@ void main() {
     expect(code, contains('gchar* test_package_input_to_string('));
     expect(code, contains('g_string_new("Input(");'));
   });
+
+  test('multiplexed host api registers a single channel', () {
+    final root = Root(
+      apis: <Api>[
+        AstHostApi(
+          name: 'Api',
+          multiplexChannel: true,
+          methods: <Method>[
+            Method(
+              name: 'doSomething',
+              parameters: <Parameter>[
+                Parameter(
+                  type: const TypeDeclaration(baseName: 'int', isNullable: false),
+                  name: 'value',
+                ),
+              ],
+              location: ApiLocation.host,
+              returnType: const TypeDeclaration(baseName: 'int', isNullable: false),
+            ),
+            Method(
+              name: 'doSomethingElse',
+              parameters: <Parameter>[],
+              location: ApiLocation.host,
+              returnType: const TypeDeclaration.voidDeclaration(),
+            ),
+          ],
+        ),
+      ],
+      classes: <Class>[],
+      enums: <Enum>[],
+    );
+    final sink = StringBuffer();
+    const generator = GObjectGenerator();
+    final generatorOptions = OutputFileOptions<InternalGObjectOptions>(
+      fileType: FileType.source,
+      languageOptions: const InternalGObjectOptions(
+        headerIncludePath: '',
+        gobjectHeaderOut: '',
+        gobjectSourceOut: '',
+      ),
+    );
+    generator.generate(generatorOptions, root, sink, dartPackageName: DEFAULT_PACKAGE_NAME);
+    final code = sink.toString();
+    expect(
+      code,
+      contains(
+        'g_autofree gchar* channel_name = g_strdup_printf("dev.flutter.pigeon.test_package.Api%s", dot_suffix);',
+      ),
+    );
+    expect(code, isNot(contains('dev.flutter.pigeon.test_package.Api.doSomething')));
+    expect(
+      code,
+      contains(
+        'fl_basic_message_channel_set_message_handler(channel, test_package_api_message_cb, g_object_ref(api_data), g_object_unref);',
+      ),
+    );
+    expect(code, contains('FlValue* value0 = fl_value_get_list_value(message_, 1);'));
+    expect(
+      code,
+      contains(
+        'test_package_api_do_something_else_cb(channel, message_, response_handle, user_data);',
+      ),
+    );
+    // Messages that can't be dispatched are answered with an error, so the
+    // Dart caller doesn't wait forever.
+    expect(
+      code,
+      contains(
+        'test_package_api_respond_message_error(channel, response_handle, "malformed-message", "Malformed message received for Api.");',
+      ),
+    );
+    expect(
+      code,
+      contains(
+        'test_package_api_respond_message_error(channel, response_handle, "unknown-method", error_message);',
+      ),
+    );
+  });
+
+  test('background task queue methods are handled off the main loop', () {
+    final root = Root(
+      apis: <Api>[
+        AstHostApi(
+          name: 'Api',
+          methods: <Method>[
+            Method(
+              name: 'doSomething',
+              parameters: <Parameter>[],
+              location: ApiLocation.host,
+              returnType: const TypeDeclaration(baseName: 'int', isNullable: false),
+              taskQueueType: TaskQueueType.serialBackgroundThread,
+            ),
+            Method(
+              name: 'doSomethingAsync',
+              parameters: <Parameter>[],
+              location: ApiLocation.host,
+              returnType: const TypeDeclaration(baseName: 'int', isNullable: false),
+              isAsynchronous: true,
+              taskQueueType: TaskQueueType.serialBackgroundThread,
+            ),
+            Method(
+              name: 'doSomethingElse',
+              parameters: <Parameter>[],
+              location: ApiLocation.host,
+              returnType: const TypeDeclaration.voidDeclaration(),
+            ),
+          ],
+        ),
+      ],
+      classes: <Class>[],
+      enums: <Enum>[],
+    );
+    final sink = StringBuffer();
+    const generator = GObjectGenerator();
+    final generatorOptions = OutputFileOptions<InternalGObjectOptions>(
+      fileType: FileType.source,
+      languageOptions: const InternalGObjectOptions(
+        headerIncludePath: '',
+        gobjectHeaderOut: '',
+        gobjectSourceOut: '',
+      ),
+    );
+    generator.generate(generatorOptions, root, sink, dartPackageName: DEFAULT_PACKAGE_NAME);
+    final code = sink.toString();
+    expect(
+      code,
+      contains(
+        'self->task_queue = g_thread_pool_new(test_package_api_task_run, nullptr, 1, FALSE, nullptr);',
+      ),
+    );
+    expect(
+      code,
+      contains(
+        'fl_binary_messenger_set_message_handler_on_channel(messenger, do_something_channel_name, test_package_api_do_something_queue_cb, g_object_ref(api_data), g_object_unref);',
+      ),
+    );
+    expect(
+      code,
+      contains(
+        'fl_basic_message_channel_set_message_handler(do_something_else_channel, test_package_api_do_something_else_cb, g_object_ref(api_data), g_object_unref);',
+      ),
+    );
+    expect(
+      code,
+      contains(
+        'g_autoptr(TestPackageApiResponseHandle) handle = test_package_api_response_handle_new_for_task(task);',
+      ),
+    );
+    expect(code, contains('test_package_api_task_respond(response_handle->task, response->value);'));
+    // All async methods use the task queue.
+    expect(code, isNot(contains('test_package_api_response_handle_new(')));
+  });
+
+  test('data classes are encoded without an intermediate list', () {
+    final innerClass = Class(
+      name: 'Inner',
+      fields: <NamedType>[
+        NamedType(
+          type: const TypeDeclaration(baseName: 'int', isNullable: true),
+          name: 'value',
+        ),
+      ],
+    );
+    final outerClass = Class(
+      name: 'Outer',
+      fields: <NamedType>[
+        NamedType(
+          type: TypeDeclaration(
+            baseName: 'Inner',
+            isNullable: true,
+            associatedClass: innerClass,
+          ),
+          name: 'inner',
+        ),
+        NamedType(
+          type: const TypeDeclaration(baseName: 'double', isNullable: false),
+          name: 'someDouble',
+        ),
+        NamedType(
+          type: const TypeDeclaration(baseName: 'Int64List', isNullable: false),
+          name: 'someInts',
+        ),
+      ],
+    );
+    final root = Root(
+      apis: <Api>[],
+      classes: <Class>[outerClass, innerClass],
+      enums: <Enum>[],
+    );
+    final sink = StringBuffer();
+    const generator = GObjectGenerator();
+    final generatorOptions = OutputFileOptions<InternalGObjectOptions>(
+      fileType: FileType.source,
+      languageOptions: const InternalGObjectOptions(
+        headerIncludePath: '',
+        gobjectHeaderOut: '',
+        gobjectSourceOut: '',
+      ),
+    );
+    generator.generate(generatorOptions, root, sink, dartPackageName: DEFAULT_PACKAGE_NAME);
+    final code = sink.toString();
+    expect(code, isNot(contains('_to_list(')));
+    expect(
+      code,
+      contains(
+        'static gboolean test_package_message_codec_write_test_package_inner(FlStandardMessageCodec* codec, GByteArray* buffer, TestPackageInner* value, GError** error);',
+      ),
+    );
+    expect(code, contains('flpigeon_write_list_header(codec, buffer, 3);'));
+    expect(
+      code,
+      contains(
+        '} else if (!test_package_message_codec_write_test_package_inner(codec, buffer, value->inner, error)) {',
+      ),
+    );
+    expect(code, contains('flpigeon_write_double(buffer, value->some_double);'));
+    expect(
+      code,
+      contains('flpigeon_write_int64_list(codec, buffer, value->some_ints, value->some_ints_length);'),
+    );
+    expect(code, contains('flpigeon_write_int(buffer, *value->value);'));
+  });
+
+  test('typed data fields can be stored in GBytes', () {
+    final inputClass = Class(
+      name: 'Input',
+      fields: <NamedType>[
+        NamedType(
+          type: const TypeDeclaration(baseName: 'Uint8List', isNullable: false),
+          name: 'someBytes',
+        ),
+        NamedType(
+          type: const TypeDeclaration(baseName: 'Float64List', isNullable: true),
+          name: 'someDoubles',
+        ),
+      ],
+    );
+    final root = Root(apis: <Api>[], classes: <Class>[inputClass], enums: <Enum>[]);
+    const generator = GObjectGenerator();
+    {
+      final sink = StringBuffer();
+      final generatorOptions = OutputFileOptions<InternalGObjectOptions>(
+        fileType: FileType.header,
+        languageOptions: const InternalGObjectOptions(
+          headerIncludePath: '',
+          gobjectHeaderOut: '',
+          gobjectSourceOut: '',
+          typedDataAsGBytes: true,
+        ),
+      );
+      generator.generate(generatorOptions, root, sink, dartPackageName: DEFAULT_PACKAGE_NAME);
+      final code = sink.toString();
+      expect(
+        code,
+        contains(
+          'TestPackageInput* test_package_input_new(const uint8_t* some_bytes, size_t some_bytes_length, const double* some_doubles, size_t some_doubles_length);',
+        ),
+      );
+      expect(
+        code,
+        contains('GBytes* test_package_input_get_some_bytes_bytes(TestPackageInput* object);'),
+      );
+      expect(
+        code,
+        contains('GBytes* test_package_input_get_some_doubles_bytes(TestPackageInput* object);'),
+      );
+    }
+    {
+      final sink = StringBuffer();
+      final generatorOptions = OutputFileOptions<InternalGObjectOptions>(
+        fileType: FileType.source,
+        languageOptions: const InternalGObjectOptions(
+          headerIncludePath: '',
+          gobjectHeaderOut: '',
+          gobjectSourceOut: '',
+          typedDataAsGBytes: true,
+        ),
+      );
+      generator.generate(generatorOptions, root, sink, dartPackageName: DEFAULT_PACKAGE_NAME);
+      final code = sink.toString();
+      expect(code, contains('GBytes* some_bytes_bytes;'));
+      expect(
+        code,
+        contains(
+          'return test_package_input_new_with_bytes(some_bytes != nullptr ? g_bytes_new(some_bytes, some_bytes_length * sizeof(uint8_t)) : nullptr,',
+        ),
+      );
+      expect(code, isNot(contains('test_package_input_new_from_list')));
+      expect(
+        code,
+        contains(
+          'if (!flpigeon_read_typed_data(codec, buffer, offset, 8, sizeof(uint8_t), FALSE, &some_bytes, error)) {',
+        ),
+      );
+      expect(
+        code,
+        contains(
+          'if (!flpigeon_read_typed_data(codec, buffer, offset, 11, sizeof(double), TRUE, &some_doubles, error)) {',
+        ),
+      );
+      expect(code, contains('if (value->some_doubles_bytes == nullptr) {'));
+    }
+  });
+
+  test('event channel api with sealed class events', () {
+    final parentClass = Class(name: 'PlatformEvent', fields: <NamedType>[], isSealed: true);
+    final childClass = Class(
+      name: 'IntEvent',
+      fields: <NamedType>[
+        NamedType(
+          type: const TypeDeclaration(baseName: 'int', isNullable: false),
+          name: 'value',
+        ),
+      ],
+      superClassName: 'PlatformEvent',
+      superClass: parentClass,
+    );
+    parentClass.children = <Class>[childClass];
+    final root = Root(
+      apis: <Api>[
+        AstEventChannelApi(
+          name: 'Api',
+          methods: <Method>[
+            Method(
+              name: 'streamEvents',
+              location: ApiLocation.host,
+              returnType: TypeDeclaration(
+                baseName: 'PlatformEvent',
+                isNullable: false,
+                associatedClass: parentClass,
+              ),
+              parameters: <Parameter>[],
+            ),
+          ],
+          gobjectOptions: const GObjectEventChannelOptions(
+            maxBatchSize: 16,
+            maxBatchLatencyMilliseconds: 4,
+          ),
+        ),
+      ],
+      classes: <Class>[childClass, parentClass],
+      enums: <Enum>[],
+    );
+    const generator = GObjectGenerator();
+    {
+      final sink = StringBuffer();
+      final generatorOptions = OutputFileOptions<InternalGObjectOptions>(
+        fileType: FileType.header,
+        languageOptions: const InternalGObjectOptions(
+          headerIncludePath: '',
+          gobjectHeaderOut: '',
+          gobjectSourceOut: '',
+        ),
+      );
+      generator.generate(generatorOptions, root, sink, dartPackageName: DEFAULT_PACKAGE_NAME);
+      final code = sink.toString();
+      // The sealed parent is declared before its subclasses.
+      expect(
+        code.indexOf('G_DECLARE_DERIVABLE_TYPE(TestPackagePlatformEvent'),
+        lessThan(code.indexOf('G_DECLARE_FINAL_TYPE(TestPackageIntEvent')),
+      );
+      expect(
+        code,
+        contains(
+          'G_DECLARE_FINAL_TYPE(TestPackageIntEvent, test_package_int_event, TEST_PACKAGE, INT_EVENT, TestPackagePlatformEvent)',
+        ),
+      );
+      expect(
+        code,
+        contains(
+          'void test_package_api_stream_events_event_sink_success(TestPackageApiStreamEventsEventSink* sink, TestPackagePlatformEvent* value);',
+        ),
+      );
+      expect(
+        code,
+        contains(
+          'void test_package_api_stream_events_event_sink_flush(TestPackageApiStreamEventsEventSink* sink);',
+        ),
+      );
+      expect(
+        code,
+        contains(
+          'void (*stream_events_on_listen)(TestPackageApiStreamEventsEventSink* sink, gpointer user_data);',
+        ),
+      );
+    }
+    {
+      final sink = StringBuffer();
+      final generatorOptions = OutputFileOptions<InternalGObjectOptions>(
+        fileType: FileType.source,
+        languageOptions: const InternalGObjectOptions(
+          headerIncludePath: '',
+          gobjectHeaderOut: '',
+          gobjectSourceOut: '',
+        ),
+      );
+      generator.generate(generatorOptions, root, sink, dartPackageName: DEFAULT_PACKAGE_NAME);
+      final code = sink.toString();
+      expect(
+        code,
+        contains(
+          'G_DEFINE_ABSTRACT_TYPE(TestPackagePlatformEvent, test_package_platform_event, G_TYPE_OBJECT)',
+        ),
+      );
+      expect(
+        code,
+        contains(
+          'G_DEFINE_TYPE(TestPackageIntEvent, test_package_int_event, test_package_platform_event_get_type())',
+        ),
+      );
+      expect(code, contains('return test_package_int_event_type_id;'));
+      expect(
+        code,
+        contains(
+          'test_package_api_stream_events_event_sink_add(self, fl_value_new_custom_object(test_package_platform_event_get_custom_type_id(value), G_OBJECT(value)));',
+        ),
+      );
+      expect(code, contains('if (fl_value_get_length(self->batch) >= 16) {'));
+      expect(
+        code,
+        contains(
+          'self->flush_source_id = g_timeout_add_full(G_PRIORITY_DEFAULT, 4, test_package_api_stream_events_event_sink_flush_cb, g_object_ref(self), g_object_unref);',
+        ),
+      );
+      // Cancelling the stream stops the pending flush and drops the batch.
+      expect(code, contains('g_set_object(&self->stream_events_sink, sink);'));
+      expect(
+        code,
+        contains('test_package_api_stream_events_event_sink_cancel(self->stream_events_sink);'),
+      );
+      final String cancelBody = code.substring(
+        code.indexOf('static void test_package_api_stream_events_event_sink_cancel('),
+        code.indexOf('static void test_package_api_stream_events_event_sink_add('),
+      );
+      expect(cancelBody, contains('g_clear_handle_id(&self->flush_source_id, g_source_remove);'));
+      expect(cancelBody, contains('g_clear_pointer(&self->batch, fl_value_unref);'));
+      expect(
+        code,
+        contains(
+          'fl_event_channel_set_stream_handlers(stream_events_channel, test_package_api_stream_events_listen_cb, test_package_api_stream_events_cancel_cb, g_object_ref(api_data), g_object_unref);',
+        ),
+      );
+    }
+  });
+
+  test('event channel sinks send events directly when not batched', () {
+    final root = Root(
+      apis: <Api>[
+        AstEventChannelApi(
+          name: 'Api',
+          methods: <Method>[
+            Method(
+              name: 'streamInts',
+              location: ApiLocation.host,
+              returnType: const TypeDeclaration(baseName: 'int', isNullable: false),
+              parameters: <Parameter>[],
+            ),
+          ],
+        ),
+      ],
+      classes: <Class>[],
+      enums: <Enum>[],
+    );
+    final sink = StringBuffer();
+    const generator = GObjectGenerator();
+    final generatorOptions = OutputFileOptions<InternalGObjectOptions>(
+      fileType: FileType.source,
+      languageOptions: const InternalGObjectOptions(
+        headerIncludePath: '',
+        gobjectHeaderOut: '',
+        gobjectSourceOut: '',
+      ),
+    );
+    generator.generate(generatorOptions, root, sink, dartPackageName: DEFAULT_PACKAGE_NAME);
+    final code = sink.toString();
+    expect(code, contains('g_autoptr(FlValue) event = fl_value_new_int(value);'));
+    expect(code, contains('test_package_api_stream_ints_event_sink_send(self, event);'));
+    expect(code, isNot(contains('_flush')));
+    // Without a batch there is nothing to stop when the stream is cancelled.
+    expect(code, isNot(contains('stream_ints_sink')));
+  });
+
+  test('proxy apis use an instance manager', () {
+    final root = Root(
+      apis: <Api>[
+        AstProxyApi(
+          name: 'Api',
+          constructors: <Constructor>[Constructor(name: '', parameters: <Parameter>[])],
+          fields: <ApiField>[
+            ApiField(
+              name: 'someField',
+              type: const TypeDeclaration(baseName: 'int', isNullable: false),
+            ),
+          ],
+          methods: <Method>[
+            Method(
+              name: 'doSomething',
+              location: ApiLocation.host,
+              parameters: <Parameter>[
+                Parameter(
+                  type: const TypeDeclaration(baseName: 'int', isNullable: false),
+                  name: 'input',
+                ),
+              ],
+              returnType: const TypeDeclaration(baseName: 'String', isNullable: false),
+            ),
+            Method(
+              name: 'onEvent',
+              location: ApiLocation.flutter,
+              parameters: <Parameter>[
+                Parameter(
+                  type: const TypeDeclaration(baseName: 'int', isNullable: false),
+                  name: 'value',
+                ),
+              ],
+              returnType: const TypeDeclaration.voidDeclaration(),
+            ),
+          ],
+        ),
+      ],
+      classes: <Class>[],
+      enums: <Enum>[],
+    );
+    {
+      final sink = StringBuffer();
+      const generator = GObjectGenerator();
+      final generatorOptions = OutputFileOptions<InternalGObjectOptions>(
+        fileType: FileType.header,
+        languageOptions: const InternalGObjectOptions(
+          headerIncludePath: '',
+          gobjectHeaderOut: '',
+          gobjectSourceOut: '',
+        ),
+      );
+      generator.generate(generatorOptions, root, sink, dartPackageName: DEFAULT_PACKAGE_NAME);
+      final code = sink.toString();
+      expect(
+        code,
+        contains(
+          'G_DECLARE_FINAL_TYPE(TestPackagePigeonInstanceManager, test_package_pigeon_instance_manager, TEST_PACKAGE, PIGEON_INSTANCE_MANAGER, GObject)',
+        ),
+      );
+      expect(code, contains('extern const int test_package_pigeon_instance_manager_type_id;'));
+      expect(
+        code,
+        contains(
+          'int64_t test_package_pigeon_instance_manager_add_host_created_instance(TestPackagePigeonInstanceManager* instance_manager, GObject* instance);',
+        ),
+      );
+      expect(code, contains('(int64_t some_field, GError** error, gpointer user_data);'));
+      expect(
+        code,
+        contains(
+          'TestPackageApiDoSomethingResponse* (*do_something)(GObject* pigeon_instance, int64_t input, gpointer user_data);',
+        ),
+      );
+      expect(
+        code,
+        contains(
+          'void test_package_api_set_method_handlers(FlBinaryMessenger* messenger, TestPackagePigeonInstanceManager* instance_manager, const TestPackageApiVTable* vtable, gpointer user_data, GDestroyNotify user_data_free_func);',
+        ),
+      );
+      expect(
+        code,
+        contains(
+          'void test_package_api_on_event(TestPackageApi* api, GObject* pigeon_instance, int64_t value, GCancellable* cancellable, GAsyncReadyCallback callback, gpointer user_data);',
+        ),
+      );
+    }
+    {
+      final sink = StringBuffer();
+      const generator = GObjectGenerator();
+      final generatorOptions = OutputFileOptions<InternalGObjectOptions>(
+        fileType: FileType.source,
+        languageOptions: const InternalGObjectOptions(
+          headerIncludePath: '',
+          gobjectHeaderOut: '',
+          gobjectSourceOut: '',
+        ),
+      );
+      generator.generate(generatorOptions, root, sink, dartPackageName: DEFAULT_PACKAGE_NAME);
+      final code = sink.toString();
+      expect(code, contains('const int test_package_pigeon_instance_manager_type_id = 128;'));
+      expect(code, contains('case test_package_pigeon_instance_manager_type_id:'));
+      expect(
+        code,
+        contains(
+          'fl_value_append_take(args, fl_value_new_custom_object(test_package_pigeon_instance_manager_type_id, pigeon_instance));',
+        ),
+      );
+      expect(
+        code,
+        contains(
+          '"dev.flutter.pigeon.test_package.PigeonInternalInstanceManager.removeStrongReference"',
+        ),
+      );
+      // Instances are only returned with a reference taken under the lock.
+      expect(
+        code,
+        contains(
+          'return entry != nullptr ? static_cast<GObject*>(g_weak_ref_get(&entry->instance_ref)) : nullptr;',
+        ),
+      );
+      expect(
+        code,
+        contains(
+          'fl_binary_messenger_send_on_channel(self->messenger, "dev.flutter.pigeon.test_package.PigeonInternalInstanceManager.removeStrongReferences", data, nullptr, nullptr, nullptr);',
+        ),
+      );
+      // Sending must not replace the host handler on the same channel.
+      expect(
+        code,
+        isNot(
+          contains(
+            'fl_basic_message_channel_new(self->messenger, "dev.flutter.pigeon.test_package.PigeonInternalInstanceManager.removeStrongReference"',
+          ),
+        ),
+      );
+    }
+  });
+
+  test('deep equals looks up map keys in a hash table', () {
+    final root = Root(
+      apis: <Api>[],
+      classes: <Class>[
+        Class(
+          name: 'Input',
+          fields: <NamedType>[
+            NamedType(
+              type: const TypeDeclaration(baseName: 'Map', isNullable: true),
+              name: 'map',
+            ),
+          ],
+        ),
+      ],
+      enums: <Enum>[],
+    );
+    final sink = StringBuffer();
+    const generator = GObjectGenerator();
+    final generatorOptions = OutputFileOptions<InternalGObjectOptions>(
+      fileType: FileType.source,
+      languageOptions: const InternalGObjectOptions(
+        headerIncludePath: '',
+        gobjectHeaderOut: '',
+        gobjectSourceOut: '',
+      ),
+    );
+    generator.generate(generatorOptions, root, sink, dartPackageName: DEFAULT_PACKAGE_NAME);
+    final code = sink.toString();
+    expect(
+      code,
+      contains(
+        'g_autoptr(GHashTable) b_entries = g_hash_table_new(flpigeon_deep_hash_cb, flpigeon_deep_equals_cb);',
+      ),
+    );
+    expect(
+      code.indexOf('flpigeon_deep_hash(FlValue* value) {'),
+      lessThan(code.indexOf('flpigeon_deep_equals(FlValue* a, FlValue* b) {')),
+    );
+  });
+
+  test('flutter api methods reuse the codec and a channel per method', () {
+    final root = Root(
+      apis: <Api>[
+        AstFlutterApi(
+          name: 'Api',
+          methods: <Method>[
+            Method(
+              name: 'doSomething',
+              parameters: <Parameter>[
+                Parameter(
+                  type: const TypeDeclaration(baseName: 'int', isNullable: false),
+                  name: 'value',
+                ),
+              ],
+              location: ApiLocation.flutter,
+              returnType: const TypeDeclaration.voidDeclaration(),
+            ),
+          ],
+        ),
+      ],
+      classes: <Class>[],
+      enums: <Enum>[],
+    );
+    final sink = StringBuffer();
+    const generator = GObjectGenerator();
+    final generatorOptions = OutputFileOptions<InternalGObjectOptions>(
+      fileType: FileType.source,
+      languageOptions: const InternalGObjectOptions(
+        headerIncludePath: '',
+        gobjectHeaderOut: '',
+        gobjectSourceOut: '',
+      ),
+    );
+    generator.generate(generatorOptions, root, sink, dartPackageName: DEFAULT_PACKAGE_NAME);
+    final code = sink.toString();
+    expect(code, contains('FlBasicMessageChannel* do_something_channel;'));
+    expect(code, contains('self->codec = test_package_message_codec_new();'));
+    expect(code, contains('g_clear_object(&self->do_something_channel);'));
+    expect(code, contains('if (self->do_something_channel == nullptr) {'));
+    expect(
+      code,
+      contains(
+        'self->do_something_channel = fl_basic_message_channel_new(self->messenger, channel_name, FL_MESSAGE_CODEC(self->codec));',
+      ),
+    );
+    // The codec is no longer created for each call.
+    expect('= test_package_message_codec_new();'.allMatches(code).length, 1);
+  });
+
+  test('columnar lists are passed as a columns object', () {
+    final pointClass = Class(
+      name: 'Point',
+      isColumnar: true,
+      fields: <NamedType>[
+        NamedType(type: const TypeDeclaration(baseName: 'int', isNullable: false), name: 'x'),
+        NamedType(type: const TypeDeclaration(baseName: 'bool', isNullable: false), name: 'flag'),
+        NamedType(
+          type: const TypeDeclaration(baseName: 'String', isNullable: false),
+          name: 'label',
+        ),
+      ],
+    );
+    final pointsType = TypeDeclaration(
+      baseName: 'List',
+      isNullable: false,
+      isColumnar: true,
+      typeArguments: <TypeDeclaration>[
+        TypeDeclaration(baseName: 'Point', isNullable: false, associatedClass: pointClass),
+      ],
+    );
+    final root = Root(
+      apis: <Api>[
+        AstHostApi(
+          name: 'Api',
+          methods: <Method>[
+            Method(
+              name: 'echo',
+              location: ApiLocation.host,
+              parameters: <Parameter>[Parameter(type: pointsType, name: 'points')],
+              returnType: pointsType,
+            ),
+          ],
+        ),
+      ],
+      classes: <Class>[pointClass],
+      enums: <Enum>[],
+    );
+    const generator = GObjectGenerator();
+    {
+      final sink = StringBuffer();
+      final generatorOptions = OutputFileOptions<InternalGObjectOptions>(
+        fileType: FileType.header,
+        languageOptions: const InternalGObjectOptions(
+          headerIncludePath: '',
+          gobjectHeaderOut: '',
+          gobjectSourceOut: '',
+        ),
+      );
+      generator.generate(generatorOptions, root, sink, dartPackageName: DEFAULT_PACKAGE_NAME);
+      final code = sink.toString();
+      expect(
+        code,
+        contains(
+          'G_DECLARE_FINAL_TYPE(TestPackagePointColumns, test_package_point_columns, TEST_PACKAGE, POINT_COLUMNS, GObject)',
+        ),
+      );
+      expect(
+        code,
+        contains(
+          'TestPackagePointColumns* test_package_point_columns_new(const int64_t* x, const uint8_t* flag, const gchar* const* label, size_t length);',
+        ),
+      );
+      expect(
+        code,
+        contains('const int64_t* test_package_point_columns_get_x(TestPackagePointColumns* object);'),
+      );
+      expect(
+        code,
+        contains(
+          'const gchar* test_package_point_columns_get_label(TestPackagePointColumns* object, size_t index);',
+        ),
+      );
+      expect(
+        code,
+        contains('TestPackageApiEchoResponse* (*echo)(TestPackagePointColumns* points, gpointer user_data);'),
+      );
+    }
+    {
+      final sink = StringBuffer();
+      final generatorOptions = OutputFileOptions<InternalGObjectOptions>(
+        fileType: FileType.source,
+        languageOptions: const InternalGObjectOptions(
+          headerIncludePath: '',
+          gobjectHeaderOut: '',
+          gobjectSourceOut: '',
+        ),
+      );
+      generator.generate(generatorOptions, root, sink, dartPackageName: DEFAULT_PACKAGE_NAME);
+      final code = sink.toString();
+      expect(code, contains('fl_value_append_take(self->columns, fl_value_new_uint8_list(flag, length));'));
+      expect(
+        code,
+        contains('fl_value_append_take(label_column, fl_value_new_string(label[i]));'),
+      );
+      expect(
+        code,
+        contains(
+          'g_autoptr(TestPackagePointColumns) points = test_package_point_columns_new_from_list(value0);',
+        ),
+      );
+      expect(
+        code,
+        contains(
+          'fl_value_append_take(self->value, fl_value_ref(test_package_point_columns_get_list(return_value)));',
+        ),
+      );
+      expect(
+        code,
+        contains('return fl_value_get_string(fl_value_get_list_value(column, index));'),
+      );
+    }
+  });
+
+  test('chunked bytes are passed as input streams', () {
+    const bytesType = TypeDeclaration(baseName: 'Uint8List', isNullable: false, isChunked: true);
+    final root = Root(
+      apis: <Api>[
+        AstHostApi(
+          name: 'Api',
+          methods: <Method>[
+            Method(
+              name: 'echo',
+              location: ApiLocation.host,
+              isAsynchronous: true,
+              chunkSize: 4,
+              parameters: <Parameter>[Parameter(type: bytesType, name: 'data')],
+              returnType: bytesType,
+            ),
+          ],
+        ),
+      ],
+      classes: <Class>[],
+      enums: <Enum>[],
+    );
+    const generator = GObjectGenerator();
+    {
+      final sink = StringBuffer();
+      final generatorOptions = OutputFileOptions<InternalGObjectOptions>(
+        fileType: FileType.header,
+        languageOptions: const InternalGObjectOptions(
+          headerIncludePath: '',
+          gobjectHeaderOut: '',
+          gobjectSourceOut: '',
+        ),
+      );
+      generator.generate(generatorOptions, root, sink, dartPackageName: DEFAULT_PACKAGE_NAME);
+      final code = sink.toString();
+      expect(code, contains('void (*echo)(GInputStream* data,'));
+      expect(
+        code,
+        contains(
+          'void test_package_api_respond_echo(TestPackageApiResponseHandle* response_handle, GInputStream* return_value);',
+        ),
+      );
+    }
+    {
+      final sink = StringBuffer();
+      final generatorOptions = OutputFileOptions<InternalGObjectOptions>(
+        fileType: FileType.source,
+        languageOptions: const InternalGObjectOptions(
+          headerIncludePath: '',
+          gobjectHeaderOut: '',
+          gobjectSourceOut: '',
+        ),
+      );
+      generator.generate(generatorOptions, root, sink, dartPackageName: DEFAULT_PACKAGE_NAME);
+      final code = sink.toString();
+      expect(
+        code,
+        contains(
+          'G_DECLARE_FINAL_TYPE(TestPackageChunkedInputStream, test_package_chunked_input_stream, TEST_PACKAGE, CHUNKED_INPUT_STREAM, GInputStream)',
+        ),
+      );
+      expect(
+        code,
+        contains(
+          'g_autoptr(GInputStream) data = G_INPUT_STREAM(test_package_chunked_input_stream_new(self->messenger, fl_value_get_string(value0)));',
+        ),
+      );
+      expect(code, contains('guint stream_id = response_handle->api->next_stream_id++;'));
+      expect(code, contains('_chunks_cb, g_object_ref(api_data), g_object_unref);'));
+    }
+  });
 }
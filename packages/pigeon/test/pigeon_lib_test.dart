@@ -6,6 +6,7 @@ import 'dart:async';
 import 'dart:io';
 
 import 'package:pigeon/src/ast.dart';
+import 'package:pigeon/src/cpp/cpp_generator.dart' show CppEventOverflowPolicy;
 import 'package:pigeon/src/generator_tools.dart';
 import 'package:pigeon/src/pigeon_lib.dart';
 import 'package:pigeon/src/pigeon_lib_internal.dart';
@@ -405,6 +406,50 @@ abstract class ApiWithMockDartClass {
     );
   });
 
+  test('multiplexChannel', () {
+    const code = '''
+@HostApi(multiplexChannel: true)
+abstract class MultiplexedApi {
+  void doit();
+}
+
+@HostApi()
+abstract class PerMethodApi {
+  void doit();
+}
+''';
+    final ParseResults results = parseSource(code);
+    expect(results.errors, isEmpty);
+    expect(results.root.apis, hasLength(2));
+    expect((results.root.apis[0] as AstHostApi).multiplexChannel, isTrue);
+    expect((results.root.apis[1] as AstHostApi).multiplexChannel, isFalse);
+  });
+
+  test('multiplexChannel cannot be combined with dartHostTestHandler', () {
+    const code = '''
+@HostApi(multiplexChannel: true, dartHostTestHandler: 'MultiplexedApiMock')
+abstract class MultiplexedApi {
+  void doit();
+}
+''';
+    final ParseResults results = parseSource(code);
+    expect(results.errors, hasLength(1));
+    expect(results.errors[0].message, contains('multiplexChannel'));
+  });
+
+  test('multiplexChannel cannot be combined with background task queues', () {
+    const code = '''
+@HostApi(multiplexChannel: true)
+abstract class MultiplexedApi {
+  @TaskQueue(type: TaskQueueType.serialBackgroundThread)
+  void doit();
+}
+''';
+    final ParseResults results = parseSource(code);
+    expect(results.errors, hasLength(1));
+    expect(results.errors[0].message, contains('serialBackgroundThread'));
+  });
+
   test('only visible from nesting', () {
     const code = '''
 class OnlyVisibleFromNesting {
@@ -1700,6 +1745,49 @@ abstract class EventChannelApi {
     });
   });
 
+  group('C++ event channel options', () {
+    test('are parsed', () {
+      const code = '''
+@EventChannelApi(
+  cppOptions: CppEventChannelOptions(
+    maxBatchSize: 8,
+    maxQueuedEvents: 32,
+    overflowPolicy: CppEventOverflowPolicy.block,
+  ),
+)
+abstract class EventChannelApi {
+  int streamInts();
+}
+''';
+      final ParseResults parseResult = parseSource(code);
+      expect(parseResult.errors, isEmpty);
+      final api = parseResult.root.apis.single as AstEventChannelApi;
+      expect(api.cppOptions?.maxBatchSize, 8);
+      expect(api.cppOptions?.maxQueuedEvents, 32);
+      expect(api.cppOptions?.overflowPolicy, CppEventOverflowPolicy.block);
+    });
+
+    test('queue must fit a batch', () {
+      const code = '''
+@EventChannelApi(
+  cppOptions: CppEventChannelOptions(maxBatchSize: 8, maxQueuedEvents: 4),
+)
+abstract class EventChannelApi {
+  int streamInts();
+}
+''';
+      final ParseResults parseResult = parseSource(code);
+      final List<Error> errors = const CppGeneratorAdapter().validate(
+        InternalPigeonOptions.fromPigeonOptions(
+          const PigeonOptions(cppHeaderOut: 'foo.h', cppSourceOut: 'foo.cpp'),
+        ),
+        parseResult.root,
+      );
+      expect(errors, hasLength(1));
+      expect(errors.single.message, contains('Invalid C++ event channel options for EventChannelApi'));
+    });
+  });
+
   group('sealed inheritance validation', () {
     test('super class must be sealed', () {
       const code = '''
@@ -1769,4 +1857,210 @@ abstract class Api {
       await completer.future;
     });
   });
+
+  group('columnar', () {
+    test('marks lists in host and flutter api methods', () {
+      const code = '''
+@Columnar()
+class Point {
+  Point(this.x, this.label);
+  double x;
+  String label;
+}
+
+class Holder {
+  Holder(this.points);
+  List<Point> points;
+}
+
+@HostApi()
+abstract class Api {
+  List<Point> echo(List<Point> points, Holder holder);
+}
+
+@FlutterApi()
+abstract class CallbackApi {
+  int count(List<Point> points);
+}
+''';
+      final ParseResults results = parseSource(code);
+      expect(results.errors, isEmpty);
+      final Class point = results.root.classes.firstWhere((Class x) => x.name == 'Point');
+      final Class holder = results.root.classes.firstWhere((Class x) => x.name == 'Holder');
+      expect(point.isColumnar, isTrue);
+      expect(holder.isColumnar, isFalse);
+      expect(holder.fields.single.type.isColumnar, isFalse);
+      final Method echo = results.root.apis[0].methods.single;
+      expect(echo.returnType.isColumnar, isTrue);
+      expect(echo.returnType.columnarClass, point);
+      expect(echo.parameters[0].type.isColumnar, isTrue);
+      expect(echo.parameters[1].type.isColumnar, isFalse);
+      expect(results.root.apis[1].methods.single.parameters.single.type.isColumnar, isTrue);
+    });
+
+    test('fields must be non-nullable primitives', () {
+      const code = '''
+@Columnar()
+class Point {
+  Point(this.x, this.tags);
+  double? x;
+  List<String> tags;
+}
+
+@HostApi()
+abstract class Api {
+  void send(List<Point> points);
+}
+''';
+      final ParseResults results = parseSource(code);
+      expect(results.errors, hasLength(2));
+      expect(
+        results.errors[0].message,
+        contains(
+          'Field "x" of @Columnar class "Point" must be a non-nullable bool, int, double or String.',
+        ),
+      );
+      expect(results.errors[1].message, contains('Field "tags"'));
+    });
+
+    test('lists must be non-nullable', () {
+      const code = '''
+@Columnar()
+class Point {
+  Point(this.x);
+  double x;
+}
+
+@HostApi()
+abstract class Api {
+  List<Point>? send(List<Point?> points);
+}
+''';
+      final ParseResults results = parseSource(code);
+      expect(results.errors, hasLength(2));
+      expect(
+        results.errors[0].message,
+        contains('Lists of @Columnar class "Point" must be non-nullable with non-nullable elements'),
+      );
+    });
+
+    test('is not supported by java', () {
+      const code = '''
+@Columnar()
+class Point {
+  Point(this.x);
+  double x;
+}
+
+@HostApi()
+abstract class Api {
+  void send(List<Point> points);
+}
+''';
+      final ParseResults parseResult = parseSource(code);
+      final List<Error> errors = const JavaGeneratorAdapter().validate(
+        InternalPigeonOptions.fromPigeonOptions(const PigeonOptions(javaOut: 'Foo.java')),
+        parseResult.root,
+      );
+      expect(errors, hasLength(1));
+      expect(errors.single.message, contains('does not support lists of @Columnar classes'));
+    });
+  });
+
+  group('chunked bytes', () {
+    test('marks the Uint8Lists of chunked methods', () {
+      const code = '''
+@HostApi()
+abstract class Api {
+  @async
+  @ChunkedBytes(chunkSize: 1024)
+  Uint8List echo(Uint8List data, int offset);
+
+  @async
+  Uint8List copy(Uint8List data);
+}
+''';
+      final ParseResults results = parseSource(code);
+      expect(results.errors, isEmpty);
+      final Method echo = results.root.apis.single.methods[0];
+      expect(echo.chunkSize, 1024);
+      expect(echo.returnType.isChunked, isTrue);
+      expect(echo.parameters[0].type.isChunked, isTrue);
+      expect(echo.parameters[1].type.isChunked, isFalse);
+      final Method copy = results.root.apis.single.methods[1];
+      expect(copy.chunkSize, isNull);
+      expect(copy.returnType.isChunked, isFalse);
+      expect(copy.parameters.single.type.isChunked, isFalse);
+    });
+
+    test('uses the default chunk size', () {
+      const code = '''
+@HostApi()
+abstract class Api {
+  @async
+  @ChunkedBytes()
+  int count(Uint8List data);
+}
+''';
+      final ParseResults results = parseSource(code);
+      expect(results.errors, isEmpty);
+      expect(results.root.apis.single.methods.single.chunkSize, 65536);
+    });
+
+    test('methods must be async and take or return a Uint8List', () {
+      const code = '''
+@HostApi()
+abstract class Api {
+  @ChunkedBytes()
+  Uint8List echo(Uint8List data);
+
+  @async
+  @ChunkedBytes()
+  int count(String data);
+}
+''';
+      final ParseResults results = parseSource(code);
+      expect(results.errors, hasLength(2));
+      expect(results.errors[0].message, contains('@ChunkedBytes methods must be @async'));
+      expect(
+        results.errors[1].message,
+        contains('@ChunkedBytes methods must take or return a Uint8List'),
+      );
+    });
+
+    test('is only supported on HostApis', () {
+      const code = '''
+@FlutterApi()
+abstract class Api {
+  @async
+  @ChunkedBytes()
+  Uint8List echo(Uint8List data);
+}
+''';
+      final ParseResults results = parseSource(code);
+      expect(results.errors, hasLength(1));
+      expect(
+        results.errors.single.message,
+        contains('@ChunkedBytes is only supported on HostApi methods'),
+      );
+    });
+
+    test('is not supported by swift', () {
+      const code = '''
+@HostApi()
+abstract class Api {
+  @async
+  @ChunkedBytes()
+  Uint8List echo(Uint8List data);
+}
+''';
+      final ParseResults parseResult = parseSource(code);
+      final List<Error> errors = const SwiftGeneratorAdapter().validate(
+        InternalPigeonOptions.fromPigeonOptions(const PigeonOptions(swiftOut: 'Foo.swift')),
+        parseResult.root,
+      );
+      expect(errors, hasLength(1));
+      expect(errors.single.message, contains('does not support @ChunkedBytes methods'));
+    });
+  });
 }
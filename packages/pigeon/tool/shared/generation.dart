@@ -16,23 +16,45 @@ enum GeneratorLanguage { cpp, dart, gobject, java, kotlin, objc, swift }
 // A map of pigeons/ files to the languages that they can't yet be generated
 // for due to limitations of that generator.
 const Map<String, Set<GeneratorLanguage>> _unsupportedFiles = <String, Set<GeneratorLanguage>>{
+  'chunked_bytes': <GeneratorLanguage>{
+    GeneratorLanguage.java,
+    GeneratorLanguage.kotlin,
+    GeneratorLanguage.objc,
+    GeneratorLanguage.swift,
+  },
+  'columnar': <GeneratorLanguage>{
+    GeneratorLanguage.java,
+    GeneratorLanguage.kotlin,
+    GeneratorLanguage.objc,
+    GeneratorLanguage.swift,
+  },
   'event_channel_tests': <GeneratorLanguage>{
     GeneratorLanguage.cpp,
-    GeneratorLanguage.gobject,
     GeneratorLanguage.java,
     GeneratorLanguage.objc,
   },
   'event_channel_without_classes_tests': <GeneratorLanguage>{
+    GeneratorLanguage.java,
+    GeneratorLanguage.objc,
+  },
+  'multiplexed_channel': <GeneratorLanguage>{
     GeneratorLanguage.cpp,
-    GeneratorLanguage.gobject,
     GeneratorLanguage.java,
+    GeneratorLanguage.kotlin,
     GeneratorLanguage.objc,
+    GeneratorLanguage.swift,
   },
   'proxy_api_tests': <GeneratorLanguage>{
-    GeneratorLanguage.cpp,
+    GeneratorLanguage.java,
+    GeneratorLanguage.objc,
+  },
+  // Only used by the C++ unit tests.
+  'task_queue': <GeneratorLanguage>{
     GeneratorLanguage.gobject,
     GeneratorLanguage.java,
+    GeneratorLanguage.kotlin,
     GeneratorLanguage.objc,
+    GeneratorLanguage.swift,
   },
 };
 
@@ -72,6 +94,8 @@ Future<int> generateTestPigeons({required String baseDir, bool includeOverflow =
   // TODO(stuartmorgan): Make this dynamic rather than hard-coded. Or eliminate
   // it entirely; see https://github.com/flutter/flutter/issues/115169.
   const inputs = <String>{
+    'chunked_bytes',
+    'columnar',
     'core_tests',
     'enum',
     'event_channel_tests',
@@ -79,11 +103,13 @@ Future<int> generateTestPigeons({required String baseDir, bool includeOverflow =
     'flutter_unittests', // Only for Dart unit tests in shared_test_plugin_code
     'message',
     'multiple_arity',
+    'multiplexed_channel',
     'non_null_fields',
     'null_fields',
     'nullable_returns',
     'primitive',
     'proxy_api_tests',
+    'task_queue',
   };
 
   const testPluginName = 'test_plugin';
@@ -201,6 +227,64 @@ Future<int> generateTestPigeons({required String baseDir, bool includeOverflow =
     return generateCodeWithAnnotation;
   }
 
+  // Test case for typedDataAsGBytes feature with core_tests
+  final int generateCodeWithGBytes = await runPigeon(
+    input: './pigeons/core_tests.dart',
+    gobjectHeaderOut: '$outputBase/linux/pigeon/core_tests_bytes.gen.h',
+    gobjectSourceOut: '$outputBase/linux/pigeon/core_tests_bytes.gen.cc',
+    gobjectModule: 'CoreTestsBytesPigeonTest',
+    gobjectTypedDataAsGBytes: true,
+    suppressVersion: true,
+    dartPackageName: 'pigeon_integration_tests',
+  );
+  if (generateCodeWithGBytes != 0) {
+    return generateCodeWithGBytes;
+  }
+
+  // Test case for typedCollections feature with core_tests
+  final int generateCodeWithTypedCollections = await runPigeon(
+    input: './pigeons/core_tests.dart',
+    cppHeaderOut: '$outputBase/windows/pigeon/core_tests_typed.gen.h',
+    cppSourceOut: '$outputBase/windows/pigeon/core_tests_typed.gen.cpp',
+    cppNamespace: 'core_tests_typed_pigeontest',
+    cppTypedCollections: true,
+    suppressVersion: true,
+    dartPackageName: 'pigeon_integration_tests',
+  );
+  if (generateCodeWithTypedCollections != 0) {
+    return generateCodeWithTypedCollections;
+  }
+
+  // Test cases for tableDrivenDispatch feature with core_tests and task_queue
+  for (final name in <String>['core_tests', 'task_queue']) {
+    final int generateCodeWithTableDispatch = await runPigeon(
+      input: './pigeons/$name.dart',
+      cppHeaderOut: '$outputBase/windows/pigeon/${name}_table.gen.h',
+      cppSourceOut: '$outputBase/windows/pigeon/${name}_table.gen.cpp',
+      cppNamespace: '${name}_table_pigeontest',
+      cppTableDrivenDispatch: true,
+      suppressVersion: true,
+      dartPackageName: 'pigeon_integration_tests',
+    );
+    if (generateCodeWithTableDispatch != 0) {
+      return generateCodeWithTableDispatch;
+    }
+  }
+
+  // Test case for coroutines feature with core_tests
+  final int generateCodeWithCoroutines = await runPigeon(
+    input: './pigeons/core_tests.dart',
+    cppHeaderOut: '$outputBase/windows/pigeon/core_tests_coroutines.gen.h',
+    cppSourceOut: '$outputBase/windows/pigeon/core_tests_coroutines.gen.cpp',
+    cppNamespace: 'core_tests_coroutines_pigeontest',
+    cppCoroutines: true,
+    suppressVersion: true,
+    dartPackageName: 'pigeon_integration_tests',
+  );
+  if (generateCodeWithCoroutines != 0) {
+    return generateCodeWithCoroutines;
+  }
+
   return 0;
 }
 
@@ -217,11 +301,15 @@ Future<int> runPigeon({
   String? cppHeaderOut,
   String? cppSourceOut,
   String? cppNamespace,
+  bool? cppTypedCollections,
+  bool? cppTableDrivenDispatch,
+  bool? cppCoroutines,
   String? dartOut,
   String? dartTestOut,
   String? gobjectHeaderOut,
   String? gobjectSourceOut,
   String? gobjectModule,
+  bool? gobjectTypedDataAsGBytes,
   String? javaOut,
   String? javaPackage,
   String? objcHeaderOut,
@@ -270,10 +358,20 @@ Future<int> runPigeon({
       dartOptions: const DartOptions(ignoreLints: false),
       cppHeaderOut: cppHeaderOut,
       cppSourceOut: cppSourceOut,
-      cppOptions: CppOptions(namespace: cppNamespace),
+      cppOptions: CppOptions(
+        namespace: cppNamespace,
+        typedCollections: cppTypedCollections,
+        tableDrivenDispatch: cppTableDrivenDispatch,
+        coroutines: cppCoroutines,
+      ),
       gobjectHeaderOut: injectOverflowTypes ? null : gobjectHeaderOut,
       gobjectSourceOut: injectOverflowTypes ? null : gobjectSourceOut,
-      gobjectOptions: injectOverflowTypes ? null : GObjectOptions(module: gobjectModule),
+      gobjectOptions: injectOverflowTypes
+          ? null
+          : GObjectOptions(
+              module: gobjectModule,
+              typedDataAsGBytes: gobjectTypedDataAsGBytes,
+            ),
       javaOut: javaOut,
       javaOptions: JavaOptions(package: javaPackage),
       kotlinOut: kotlinOut,